@@ -70,6 +70,46 @@ int arch_dcache_range(void *addr, size_t size, int op)
 	return 0;
 }
 
+#ifdef CONFIG_ARCH_HAS_DCACHE_RANGE_NOSYNC
+#ifndef __SCB_DCACHE_LINE_SIZE
+#define __SCB_DCACHE_LINE_SIZE 32U
+#endif
+
+/*
+ * Same as arch_dcache_range(), but without the barriers of the CMSIS
+ * functions, so that the maintenance of several ranges can be
+ * completed with a single arch_dcache_sync().
+ */
+int arch_dcache_range_nosync(void *addr, size_t size, int op)
+{
+	volatile uint32_t *reg;
+	uintptr_t line = (uintptr_t)addr & ~(__SCB_DCACHE_LINE_SIZE - 1U);
+	uintptr_t end = (uintptr_t)addr + size;
+
+	if (op == K_CACHE_INVD) {
+		reg = &SCB->DCIMVAC;
+	} else if (op == K_CACHE_WB) {
+		reg = &SCB->DCCMVAC;
+	} else if (op == K_CACHE_WB_INVD) {
+		reg = &SCB->DCCIMVAC;
+	} else {
+		return -ENOTSUP;
+	}
+
+	for (; line < end; line += __SCB_DCACHE_LINE_SIZE) {
+		*reg = line;
+	}
+
+	return 0;
+}
+
+void arch_dcache_sync(void)
+{
+	__DSB();
+	__ISB();
+}
+#endif /* CONFIG_ARCH_HAS_DCACHE_RANGE_NOSYNC */
+
 int arch_dcache_all(int op)
 {
 	if (op == K_CACHE_INVD) {
@@ -21,6 +21,57 @@ static void mpu_init(void)
 	/* No specific configuration at init for ARMv7-M MPU. */
 }
 
+#if !defined(CONFIG_CPU_AARCH32_CORTEX_R)
+/* Shadow copy of the programmed regions. The dynamic regions are
+ * reprogrammed at every context switch to a thread of another memory
+ * domain, and domains usually share most of their regions (stack
+ * guards, kernel partitions), so only the regions which changed are
+ * written to the MPU.
+ */
+#define MPU_SHADOW_REGIONS 16
+
+static struct {
+	uint32_t rbar;
+	uint32_t rasr;
+} mpu_shadow[MPU_SHADOW_REGIONS];
+
+/* Regions whose shadow copy matches the MPU */
+static uint32_t mpu_shadow_valid;
+
+static void region_write(const uint32_t index, uint32_t rbar, uint32_t rasr)
+{
+	if (index < MPU_SHADOW_REGIONS) {
+		if ((mpu_shadow_valid & BIT(index)) != 0U &&
+		    mpu_shadow[index].rbar == rbar &&
+		    mpu_shadow[index].rasr == rasr) {
+			return;
+		}
+
+		mpu_shadow[index].rbar = rbar;
+		mpu_shadow[index].rasr = rasr;
+		mpu_shadow_valid |= BIT(index);
+	}
+
+	MPU->RBAR = rbar | MPU_RBAR_VALID_Msk | index;
+	MPU->RASR = rasr;
+}
+
+static void region_clear(const uint32_t index)
+{
+	if (index < MPU_SHADOW_REGIONS) {
+		if ((mpu_shadow_valid & BIT(index)) != 0U &&
+		    mpu_shadow[index].rasr == 0U) {
+			return;
+		}
+
+		mpu_shadow[index].rasr = 0U;
+		mpu_shadow_valid |= BIT(index);
+	}
+
+	ARM_MPU_ClrRegion(index);
+}
+#endif /* !CONFIG_CPU_AARCH32_CORTEX_R */
+
 /* This internal function performs MPU region initialization.
  *
  * Note:
@@ -44,9 +95,8 @@ static void region_init(const uint32_t index,
 	set_region_attributes(region_conf->attr.rasr);
 	set_region_size(region_conf->size | MPU_RASR_ENABLE_Msk);
 #else
-	MPU->RBAR = (region_conf->base & MPU_RBAR_ADDR_Msk)
-				| MPU_RBAR_VALID_Msk | index;
-	MPU->RASR = region_conf->attr.rasr | MPU_RASR_ENABLE_Msk;
+	region_write(index, region_conf->base & MPU_RBAR_ADDR_Msk,
+		     region_conf->attr.rasr | MPU_RASR_ENABLE_Msk);
 	LOG_DBG("[%d] 0x%08x 0x%08x",
 		index, region_conf->base, region_conf->attr.rasr);
 #endif
@@ -262,7 +312,11 @@ static int mpu_configure_dynamic_mpu_regions(const struct z_arm_mpu_partition
 
 		/* Disable the non-programmed MPU regions. */
 		for (int i = mpu_reg_index; i < get_num_regions(); i++) {
+#if defined(CONFIG_CPU_AARCH32_CORTEX_R)
 			ARM_MPU_ClrRegion(i);
+#else
+			region_clear(i);
+#endif
 		}
 	}
 
@@ -52,6 +52,7 @@ struct adc_edma_config {
 	void (*irq_call_back)(void);
 	struct dma_config dma_cfg;
 	struct dma_block_config dma_block;
+	bool configured;
 };
 #endif
 
@@ -66,6 +67,11 @@ struct mcux_adc16_data {
 	uint16_t *repeat_buffer;
 	uint32_t channels;
 	uint8_t channel_id;
+#if defined(CONFIG_ADC_STREAM) && defined(CONFIG_ADC_MCUX_ADC16_ENABLE_EDMA)
+	struct adc_stream_config stream;
+	bool streaming;
+	uint8_t stream_half;
+#endif
 };
 
 #ifdef CONFIG_ADC_MCUX_ADC16_HW_TRIGGER
@@ -74,6 +80,48 @@ struct mcux_adc16_data {
 #endif
 
 #ifdef CONFIG_ADC_MCUX_ADC16_ENABLE_EDMA
+static void mcux_adc16_dma_load(struct mcux_adc16_data *data, void *buffer,
+				size_t size)
+{
+	data->adc_dma_config.dma_block.block_size = size;
+	data->adc_dma_config.dma_block.dest_address = (uint32_t)buffer;
+
+	/* The channel is configured once, later samplings only patch the
+	 * buffer address and size.
+	 */
+	if (!data->adc_dma_config.configured ||
+	    dma_reload(data->dev_dma, data->adc_dma_config.dma_channel,
+		       data->adc_dma_config.dma_block.source_address,
+		       data->adc_dma_config.dma_block.dest_address,
+		       data->adc_dma_config.dma_block.block_size) != 0) {
+		LOG_DBG("config dma");
+		data->adc_dma_config.dma_cfg.head_block =
+			&(data->adc_dma_config.dma_block);
+		dma_config(data->dev_dma, data->adc_dma_config.dma_channel,
+			   &data->adc_dma_config.dma_cfg);
+		data->adc_dma_config.configured = true;
+	}
+}
+
+#ifdef CONFIG_ADC_STREAM
+static void mcux_adc16_stream_next(const struct device *dev)
+{
+	struct mcux_adc16_data *data = dev->data;
+	uint32_t timestamp = k_cycle_get_32();
+	size_t half = data->stream.buffer_size / 2;
+	uint8_t *buffer = data->stream.buffer;
+	uint8_t *filled = buffer + data->stream_half * half;
+
+	/* Keep the converter fed with the other half first */
+	data->stream_half ^= 1U;
+	mcux_adc16_dma_load(data, buffer + data->stream_half * half, half);
+	dma_start(data->dev_dma, data->adc_dma_config.dma_channel);
+
+	data->stream.callback(dev, filled, half, timestamp,
+			      data->stream.user_data);
+}
+#endif
+
 static void adc_dma_callback(const struct device *dma_dev, void *callback_arg,
 			     uint32_t channel, int error_code)
 {
@@ -81,6 +129,14 @@ static void adc_dma_callback(const struct device *dma_dev, void *callback_arg,
 	struct mcux_adc16_data *data = dev->data;
 
 	LOG_DBG("DMA done");
+
+#ifdef CONFIG_ADC_STREAM
+	if (data->streaming) {
+		mcux_adc16_stream_next(dev);
+		return;
+	}
+#endif
+
 	adc_context_on_sampling_done(&data->ctx, dev);
 }
 #endif
@@ -134,18 +190,17 @@ static int mcux_adc16_channel_setup(const struct device *dev,
 	return 0;
 }
 
-static int start_read(const struct device *dev,
-		      const struct adc_sequence *sequence)
+static int mcux_adc16_set_resolution(const struct device *dev,
+				     uint8_t adc_resolution,
+				     uint8_t oversampling)
 {
 	const struct mcux_adc16_config *config = dev->config;
-	struct mcux_adc16_data *data = dev->data;
 	adc16_hardware_average_mode_t mode;
 	adc16_resolution_t resolution;
-	int error;
 	uint32_t tmp32;
 	ADC_Type *base = config->base;
 
-	switch (sequence->resolution) {
+	switch (adc_resolution) {
 	case 8:
 	case 9:
 		resolution = kADC16_Resolution8or9Bit;
@@ -173,7 +228,7 @@ static int start_read(const struct device *dev,
 	tmp32 |= ADC_CFG1_MODE(resolution);
 	base->CFG1 = tmp32;
 
-	switch (sequence->oversampling) {
+	switch (oversampling) {
 	case 0:
 		mode = kADC16_HardwareAverageDisabled;
 		break;
@@ -195,6 +250,21 @@ static int start_read(const struct device *dev,
 	}
 	ADC16_SetHardwareAverage(config->base, mode);
 
+	return 0;
+}
+
+static int start_read(const struct device *dev,
+		      const struct adc_sequence *sequence)
+{
+	struct mcux_adc16_data *data = dev->data;
+	int error;
+
+	error = mcux_adc16_set_resolution(dev, sequence->resolution,
+					  sequence->oversampling);
+	if (error) {
+		return error;
+	}
+
 	data->buffer = sequence->buffer;
 
 	adc_context_start_read(&data->ctx, sequence);
@@ -269,14 +339,8 @@ static void adc_context_start_sampling(struct adc_context *ctx)
 	data->repeat_buffer = data->buffer;
 
 #ifdef CONFIG_ADC_MCUX_ADC16_ENABLE_EDMA
-	LOG_DBG("config dma");
 	data->buffer = ctx->sequence.buffer;
-	data->adc_dma_config.dma_block.block_size = ctx->sequence.buffer_size;
-	data->adc_dma_config.dma_block.dest_address = (uint32_t)data->buffer;
-	data->adc_dma_config.dma_cfg.head_block =
-		&(data->adc_dma_config.dma_block);
-	dma_config(data->dev_dma, data->adc_dma_config.dma_channel,
-		   &data->adc_dma_config.dma_cfg);
+	mcux_adc16_dma_load(data, data->buffer, ctx->sequence.buffer_size);
 #endif
 
 	mcux_adc16_start_channel(data->dev);
@@ -293,6 +357,88 @@ static void adc_context_update_buffer_pointer(struct adc_context *ctx,
 	}
 }
 
+#if defined(CONFIG_ADC_STREAM) && defined(CONFIG_ADC_MCUX_ADC16_ENABLE_EDMA)
+static int mcux_adc16_stream_start(const struct device *dev,
+				   const struct adc_stream_config *stream)
+{
+	const struct mcux_adc16_config *config = dev->config;
+	struct mcux_adc16_data *data = dev->data;
+	int error;
+
+	/* Conversions must follow each other without software involvement */
+	if (!config->continuous_convert &&
+	    !IS_ENABLED(CONFIG_ADC_MCUX_ADC16_HW_TRIGGER)) {
+		LOG_ERR("Streaming requires continuous conversion or a hardware trigger");
+		return -ENOTSUP;
+	}
+
+	/* Channels are converted one at a time */
+	if (stream->channels == 0 ||
+	    (stream->channels & (stream->channels - 1)) != 0) {
+		LOG_ERR("Streaming supports a single channel");
+		return -ENOTSUP;
+	}
+
+	/* Each half holds whole samples, as transferred by the DMA */
+	if (stream->buffer == NULL || stream->callback == NULL ||
+	    stream->buffer_size == 0 ||
+	    (stream->buffer_size % (2 * data->adc_dma_config.dma_cfg.dest_data_size)) != 0) {
+		return -EINVAL;
+	}
+
+	if (data->streaming) {
+		return -EBUSY;
+	}
+
+	adc_context_lock(&data->ctx, false, NULL);
+
+	error = mcux_adc16_set_resolution(dev, stream->resolution,
+					  stream->oversampling);
+	if (error) {
+		adc_context_release(&data->ctx, error);
+		return error;
+	}
+
+	data->stream = *stream;
+	data->stream_half = 0U;
+	data->streaming = true;
+
+	mcux_adc16_dma_load(data, stream->buffer, stream->buffer_size / 2);
+
+	data->channels = stream->channels;
+	mcux_adc16_start_channel(dev);
+
+	return 0;
+}
+
+static int mcux_adc16_stream_stop(const struct device *dev)
+{
+	const struct mcux_adc16_config *config = dev->config;
+	struct mcux_adc16_data *data = dev->data;
+	adc16_channel_config_t channel_config = {
+		/* All ones selects no input, stopping conversions */
+		.channelNumber = ADC_SC1_ADCH_MASK >> ADC_SC1_ADCH_SHIFT,
+	};
+	unsigned int key;
+
+	if (!data->streaming) {
+		return -EALREADY;
+	}
+
+	/* Keep the DMA interrupt from starting the next half meanwhile */
+	key = irq_lock();
+	data->streaming = false;
+	dma_stop(data->dev_dma, data->adc_dma_config.dma_channel);
+	irq_unlock(key);
+
+	ADC16_SetChannelConfig(config->base, 0U, &channel_config);
+
+	adc_context_release(&data->ctx, 0);
+
+	return 0;
+}
+#endif
+
 #ifndef CONFIG_ADC_MCUX_ADC16_ENABLE_EDMA
 static void mcux_adc16_isr(const struct device *dev)
 {
@@ -431,6 +577,10 @@ static const struct adc_driver_api mcux_adc16_driver_api = {
 #ifdef CONFIG_ADC_ASYNC
 	.read_async = mcux_adc16_read_async,
 #endif
+#if defined(CONFIG_ADC_STREAM) && defined(CONFIG_ADC_MCUX_ADC16_ENABLE_EDMA)
+	.stream_start = mcux_adc16_stream_start,
+	.stream_stop = mcux_adc16_stream_stop,
+#endif
 };
 
 #ifdef CONFIG_ADC_MCUX_ADC16_ENABLE_EDMA
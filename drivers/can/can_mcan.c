@@ -611,6 +611,74 @@ void can_mcan_line_0_isr(const struct device *dev)
 			    CAN_MCAN_IR_TEFL | CAN_MCAN_IR_TEFN));
 }
 
+#if CONFIG_CAN_MCAN_SHARED_FILTERS > 0
+static bool can_mcan_filter_match(const struct can_filter *filter,
+				  const struct can_frame *frame)
+{
+	if (filter->id_type != frame->id_type) {
+		return false;
+	}
+
+	if (filter->rtr_mask && (filter->rtr != frame->rtr)) {
+		return false;
+	}
+
+	return ((filter->id ^ frame->id) & filter->id_mask) == 0U;
+}
+
+static bool can_mcan_is_shared(struct can_mcan_data *data, enum can_ide id_type,
+			       uint32_t elem)
+{
+	if (id_type == CAN_STANDARD_IDENTIFIER) {
+		return (data->std_filt_shared & BIT(elem)) != 0U;
+	} else {
+		return (data->ext_filt_shared & BIT(elem)) != 0U;
+	}
+}
+
+/* A shared element accepts the union of its filters, each of them is matched
+ * in software.
+ */
+static bool can_mcan_dispatch_shared(const struct device *dev,
+				     struct can_frame *frame, uint32_t elem)
+{
+	struct can_mcan_data *data = dev->data;
+	const struct can_filter *filter;
+	can_rx_callback_t cb;
+	void *cb_arg;
+
+	if (!can_mcan_is_shared(data, frame->id_type, elem)) {
+		return false;
+	}
+
+	if (frame->id_type == CAN_STANDARD_IDENTIFIER) {
+		cb = data->rx_cb_std[elem];
+		cb_arg = data->cb_arg_std[elem];
+		filter = &data->filt_std[elem];
+	} else {
+		cb = data->rx_cb_ext[elem];
+		cb_arg = data->cb_arg_ext[elem];
+		filter = &data->filt_ext[elem];
+	}
+
+	if (cb != NULL && can_mcan_filter_match(filter, frame)) {
+		cb(dev, frame, cb_arg);
+	}
+
+	for (int i = 0; i < CONFIG_CAN_MCAN_SHARED_FILTERS; i++) {
+		struct can_mcan_shared_filter *shared = &data->shared[i];
+
+		cb = shared->rx_cb;
+		if (cb != NULL && shared->elem == elem &&
+		    can_mcan_filter_match(&shared->filter, frame)) {
+			cb(dev, frame, shared->cb_arg);
+		}
+	}
+
+	return true;
+}
+#endif /* CONFIG_CAN_MCAN_SHARED_FILTERS > 0 */
+
 static void can_mcan_get_message(const struct device *dev,
 				 volatile struct can_mcan_rx_fifo *fifo,
 				 volatile uint32_t *fifo_status_reg,
@@ -677,6 +745,13 @@ static void can_mcan_get_message(const struct device *dev,
 			memcpy32_volatile(frame.data_32, fifo[get_idx].data_32,
 					  ROUND_UP(data_length, sizeof(uint32_t)));
 
+#if CONFIG_CAN_MCAN_SHARED_FILTERS > 0
+			if (can_mcan_dispatch_shared(dev, &frame, filt_idx)) {
+				*fifo_ack_reg = get_idx;
+				continue;
+			}
+#endif
+
 			if (frame.id_type == CAN_STANDARD_IDENTIFIER) {
 				LOG_DBG("Frame on filter %d, ID: 0x%x",
 					filt_idx, frame.id);
@@ -928,6 +1003,7 @@ int can_mcan_add_rx_filter_std(const struct device *dev,
 	filter_id = can_mcan_get_free_std(msg_ram->std_filt);
 
 	if (filter_id == -ENOSPC) {
+		k_mutex_unlock(&data->inst_mutex);
 		LOG_WRN("No free standard id filter left");
 		return -ENOSPC;
 	}
@@ -960,6 +1036,9 @@ int can_mcan_add_rx_filter_std(const struct device *dev,
 
 	data->rx_cb_std[filter_id] = callback;
 	data->cb_arg_std[filter_id] = user_data;
+#if CONFIG_CAN_MCAN_SHARED_FILTERS > 0
+	data->filt_std[filter_id] = *filter;
+#endif
 
 	return filter_id;
 }
@@ -992,6 +1071,7 @@ static int can_mcan_add_rx_filter_ext(const struct device *dev,
 	filter_id = can_mcan_get_free_ext(msg_ram->ext_filt);
 
 	if (filter_id == -ENOSPC) {
+		k_mutex_unlock(&data->inst_mutex);
 		LOG_WRN("No free extended id filter left");
 		return -ENOSPC;
 	}
@@ -1024,10 +1104,200 @@ static int can_mcan_add_rx_filter_ext(const struct device *dev,
 
 	data->rx_cb_ext[filter_id] = callback;
 	data->cb_arg_ext[filter_id] = user_data;
+#if CONFIG_CAN_MCAN_SHARED_FILTERS > 0
+	data->filt_ext[filter_id] = *filter;
+#endif
 
 	return filter_id;
 }
 
+#if CONFIG_CAN_MCAN_SHARED_FILTERS > 0
+static void can_mcan_merge_filter(const struct can_filter *filter, int count,
+				  uint32_t *id, uint32_t *mask)
+{
+	if (count == 0) {
+		*mask = filter->id_mask;
+	} else {
+		/* Bits on which the filters differ become don't care */
+		*mask &= filter->id_mask & ~(*id ^ filter->id);
+	}
+
+	*id = filter->id & *mask;
+}
+
+/* Compute the identifier and mask accepting all filters of an element,
+ * returns the number of filters.
+ */
+static int can_mcan_elem_filters(struct can_mcan_data *data, enum can_ide id_type,
+				 uint8_t elem, uint32_t *id, uint32_t *mask)
+{
+	int count = 0;
+
+	if (id_type == CAN_STANDARD_IDENTIFIER) {
+		if (data->rx_cb_std[elem] != NULL) {
+			can_mcan_merge_filter(&data->filt_std[elem], count++, id, mask);
+		}
+	} else {
+		if (data->rx_cb_ext[elem] != NULL) {
+			can_mcan_merge_filter(&data->filt_ext[elem], count++, id, mask);
+		}
+	}
+
+	for (int i = 0; i < CONFIG_CAN_MCAN_SHARED_FILTERS; i++) {
+		struct can_mcan_shared_filter *shared = &data->shared[i];
+
+		if (shared->rx_cb != NULL && shared->elem == elem &&
+		    shared->filter.id_type == id_type) {
+			can_mcan_merge_filter(&shared->filter, count++, id, mask);
+		}
+	}
+
+	return count;
+}
+
+/* Rewrite a hardware filter element after its filters changed. Must be
+ * called with the instance mutex held.
+ */
+static void can_mcan_update_elem(const struct device *dev, enum can_ide id_type,
+				 uint8_t elem)
+{
+	struct can_mcan_data *data = dev->data;
+	struct can_mcan_msg_sram *msg_ram = data->msg_ram;
+	bool shared = false;
+	uint32_t id, mask;
+	int count;
+
+	count = can_mcan_elem_filters(data, id_type, elem, &id, &mask);
+
+	for (int i = 0; i < CONFIG_CAN_MCAN_SHARED_FILTERS; i++) {
+		if (data->shared[i].rx_cb != NULL && data->shared[i].elem == elem &&
+		    data->shared[i].filter.id_type == id_type) {
+			shared = true;
+		}
+	}
+
+	if (id_type == CAN_STANDARD_IDENTIFIER) {
+		struct can_mcan_std_filter filter_element = {
+			.id1 = id,
+			.id2 = mask,
+			.sft = CAN_MCAN_SFT_MASKED,
+			.sfce = elem & 0x01 ? CAN_MCAN_FCE_FIFO1 : CAN_MCAN_FCE_FIFO0
+		};
+
+		if (count == 0) {
+			memset(&filter_element, 0, sizeof(filter_element));
+		}
+
+		/* RTR bits of a shared element are matched in software */
+		if (shared) {
+			data->std_filt_shared |= BIT(elem);
+			data->std_filt_rtr_mask &= ~BIT(elem);
+		} else {
+			data->std_filt_shared &= ~BIT(elem);
+			WRITE_BIT(data->std_filt_rtr_mask, elem, data->filt_std[elem].rtr_mask);
+		}
+
+		memcpy32_volatile(&msg_ram->std_filt[elem], &filter_element,
+				  sizeof(struct can_mcan_std_filter));
+		sys_cache_data_range((void *)&msg_ram->std_filt[elem],
+				     sizeof(struct can_mcan_std_filter),
+				     K_CACHE_WB);
+	} else {
+		struct can_mcan_ext_filter filter_element = {
+			.id2 = mask,
+			.id1 = id,
+			.eft = CAN_MCAN_EFT_MASKED,
+			.efce = elem & 0x01 ? CAN_MCAN_FCE_FIFO1 : CAN_MCAN_FCE_FIFO0
+		};
+
+		if (count == 0) {
+			memset(&filter_element, 0, sizeof(filter_element));
+		}
+
+		if (shared) {
+			data->ext_filt_shared |= BIT(elem);
+			data->ext_filt_rtr_mask &= ~BIT(elem);
+		} else {
+			data->ext_filt_shared &= ~BIT(elem);
+			WRITE_BIT(data->ext_filt_rtr_mask, elem, data->filt_ext[elem].rtr_mask);
+		}
+
+		memcpy32_volatile(&msg_ram->ext_filt[elem], &filter_element,
+				  sizeof(struct can_mcan_ext_filter));
+		sys_cache_data_range((void *)&msg_ram->ext_filt[elem],
+				     sizeof(struct can_mcan_ext_filter),
+				     K_CACHE_WB);
+	}
+}
+
+/* Merge a filter into the hardware filter element in use whose mask loses
+ * the fewest bits, so the fewest unwanted frames are accepted.
+ */
+static int can_mcan_add_shared_filter(const struct device *dev,
+				      can_rx_callback_t callback, void *user_data,
+				      const struct can_filter *filter)
+{
+	struct can_mcan_data *data = dev->data;
+	int num_elems = filter->id_type == CAN_STANDARD_IDENTIFIER ?
+			NUM_STD_FILTER_DATA : NUM_EXT_FILTER_DATA;
+	struct can_mcan_shared_filter *shared = NULL;
+	int best_cost = 0;
+	int best_elem = -1;
+	int slot;
+
+	k_mutex_lock(&data->inst_mutex, K_FOREVER);
+
+	for (slot = 0; slot < CONFIG_CAN_MCAN_SHARED_FILTERS; slot++) {
+		if (data->shared[slot].rx_cb == NULL) {
+			shared = &data->shared[slot];
+			break;
+		}
+	}
+
+	if (shared == NULL) {
+		k_mutex_unlock(&data->inst_mutex);
+		LOG_WRN("No free shared filter left");
+		return -ENOSPC;
+	}
+
+	for (int elem = 0; elem < num_elems; elem++) {
+		uint32_t id, mask, merged_mask;
+		int cost;
+
+		if (can_mcan_elem_filters(data, filter->id_type, elem, &id, &mask) == 0) {
+			continue;
+		}
+
+		merged_mask = mask;
+		can_mcan_merge_filter(filter, 1, &id, &merged_mask);
+		cost = popcount(mask) - popcount(merged_mask);
+
+		if (best_elem < 0 || cost < best_cost) {
+			best_cost = cost;
+			best_elem = elem;
+		}
+	}
+
+	if (best_elem < 0) {
+		k_mutex_unlock(&data->inst_mutex);
+		return -ENOSPC;
+	}
+
+	shared->filter = *filter;
+	shared->cb_arg = user_data;
+	shared->elem = best_elem;
+	shared->rx_cb = callback;
+
+	can_mcan_update_elem(dev, filter->id_type, best_elem);
+
+	k_mutex_unlock(&data->inst_mutex);
+
+	LOG_DBG("Shared filter %d merged into element %d", slot, best_elem);
+
+	return NUM_STD_FILTER_DATA + NUM_EXT_FILTER_DATA + slot;
+}
+#endif /* CONFIG_CAN_MCAN_SHARED_FILTERS > 0 */
+
 int can_mcan_add_rx_filter(const struct device *dev,
 			   can_rx_callback_t callback, void *user_data,
 			   const struct can_filter *filter)
@@ -1047,6 +1317,12 @@ int can_mcan_add_rx_filter(const struct device *dev,
 		}
 	}
 
+#if CONFIG_CAN_MCAN_SHARED_FILTERS > 0
+	if (filter_id == -ENOSPC) {
+		filter_id = can_mcan_add_shared_filter(dev, callback, user_data, filter);
+	}
+#endif
+
 	return filter_id;
 }
 
@@ -1056,9 +1332,44 @@ void can_mcan_remove_rx_filter(const struct device *dev, int filter_id)
 	struct can_mcan_msg_sram *msg_ram = data->msg_ram;
 
 	k_mutex_lock(&data->inst_mutex, K_FOREVER);
+#if CONFIG_CAN_MCAN_SHARED_FILTERS > 0
+	if (filter_id >= NUM_STD_FILTER_DATA + NUM_EXT_FILTER_DATA &&
+	    filter_id < NUM_STD_FILTER_DATA + NUM_EXT_FILTER_DATA +
+			CONFIG_CAN_MCAN_SHARED_FILTERS) {
+		struct can_mcan_shared_filter *shared =
+			&data->shared[filter_id - NUM_STD_FILTER_DATA - NUM_EXT_FILTER_DATA];
+
+		shared->rx_cb = NULL;
+		can_mcan_update_elem(dev, shared->filter.id_type, shared->elem);
+		k_mutex_unlock(&data->inst_mutex);
+		return;
+	}
+
+	/* The element stays in use for the filters merged into it */
+	if (filter_id < NUM_STD_FILTER_DATA &&
+	    can_mcan_is_shared(data, CAN_STANDARD_IDENTIFIER, filter_id)) {
+		data->rx_cb_std[filter_id] = NULL;
+		can_mcan_update_elem(dev, CAN_STANDARD_IDENTIFIER, filter_id);
+		k_mutex_unlock(&data->inst_mutex);
+		return;
+	}
+
+	if (filter_id >= NUM_STD_FILTER_DATA &&
+	    filter_id < NUM_STD_FILTER_DATA + NUM_EXT_FILTER_DATA &&
+	    can_mcan_is_shared(data, CAN_EXTENDED_IDENTIFIER,
+			       filter_id - NUM_STD_FILTER_DATA)) {
+		data->rx_cb_ext[filter_id - NUM_STD_FILTER_DATA] = NULL;
+		can_mcan_update_elem(dev, CAN_EXTENDED_IDENTIFIER,
+				     filter_id - NUM_STD_FILTER_DATA);
+		k_mutex_unlock(&data->inst_mutex);
+		return;
+	}
+#endif
+
 	if (filter_id >= NUM_STD_FILTER_DATA) {
 		filter_id -= NUM_STD_FILTER_DATA;
 		if (filter_id >= NUM_EXT_FILTER_DATA) {
+			k_mutex_unlock(&data->inst_mutex);
 			LOG_ERR("Wrong filter id");
 			return;
 		}
@@ -1068,12 +1379,14 @@ void can_mcan_remove_rx_filter(const struct device *dev, int filter_id)
 		sys_cache_data_range((void *)&msg_ram->ext_filt[filter_id],
 				     sizeof(struct can_mcan_ext_filter),
 				     K_CACHE_WB);
+		data->rx_cb_ext[filter_id] = NULL;
 	} else {
 		memset32_volatile(&msg_ram->std_filt[filter_id], 0,
 				  sizeof(struct can_mcan_std_filter));
 		sys_cache_data_range((void *)&msg_ram->std_filt[filter_id],
 				     sizeof(struct can_mcan_std_filter),
 				     K_CACHE_WB);
+		data->rx_cb_std[filter_id] = NULL;
 	}
 
 	k_mutex_unlock(&data->inst_mutex);
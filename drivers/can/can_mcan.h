@@ -165,6 +165,15 @@ struct can_mcan_msg_sram {
 	volatile struct can_mcan_tx_buffer tx_buffer[NUM_TX_BUF_ELEMENTS];
 } __packed __aligned(4);
 
+#if CONFIG_CAN_MCAN_SHARED_FILTERS > 0
+struct can_mcan_shared_filter {
+	struct can_filter filter;
+	can_rx_callback_t rx_cb;	/* NULL if unused */
+	void *cb_arg;
+	uint8_t elem;			/* Hardware filter element */
+};
+#endif
+
 struct can_mcan_data {
 	struct can_mcan_msg_sram *msg_ram;
 	struct k_mutex inst_mutex;
@@ -183,6 +192,13 @@ struct can_mcan_data {
 	uint32_t std_filt_rtr_mask;
 	uint8_t ext_filt_rtr;
 	uint8_t ext_filt_rtr_mask;
+#if CONFIG_CAN_MCAN_SHARED_FILTERS > 0
+	struct can_filter filt_std[NUM_STD_FILTER_DATA];
+	struct can_filter filt_ext[NUM_EXT_FILTER_DATA];
+	struct can_mcan_shared_filter shared[CONFIG_CAN_MCAN_SHARED_FILTERS];
+	uint32_t std_filt_shared;
+	uint8_t ext_filt_shared;
+#endif
 	struct can_mcan_mm mm;
 	bool started;
 	void *custom;
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define DT_DRV_COMPAT st_stm32_crc
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/clock_control.h>
+#include <zephyr/drivers/clock_control/stm32_clock_control.h>
+#include <zephyr/drivers/crc.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+
+#include <soc.h>
+#include <stm32_ll_crc.h>
+
+/* Series without input and output reversal cannot compute reflected CRCs */
+#if !defined(CRC_CR_REV_IN) || !defined(CRC_CR_REV_OUT)
+#error "CRC calculation unit of this series does not support reflection"
+#endif
+
+struct crc_stm32_config {
+	CRC_TypeDef *crc;
+	struct stm32_pclken pclken;
+};
+
+struct crc_stm32_data {
+	struct k_mutex lock;
+};
+
+static int crc_stm32_crc32_ieee_update(const struct device *dev, uint32_t crc,
+				       const uint8_t *data, size_t len,
+				       uint32_t *result)
+{
+	const struct crc_stm32_config *cfg = dev->config;
+	struct crc_stm32_data *dev_data = dev->data;
+	CRC_TypeDef *regs = cfg->crc;
+
+	k_mutex_lock(&dev_data->lock, K_FOREVER);
+
+	/* The unit shifts the non reflected CRC, so the reflected value
+	 * computed so far is loaded bit reversed.
+	 */
+	LL_CRC_SetInitialData(regs, __RBIT(~crc));
+	LL_CRC_SetInputDataReverseMode(regs, LL_CRC_INDATA_REVERSE_WORD);
+	LL_CRC_ResetCRCCalculationUnit(regs);
+
+	for (; len >= sizeof(uint32_t); len -= sizeof(uint32_t)) {
+		LL_CRC_FeedData32(regs, sys_get_le32(data));
+		data += sizeof(uint32_t);
+	}
+
+	LL_CRC_SetInputDataReverseMode(regs, LL_CRC_INDATA_REVERSE_BYTE);
+
+	for (; len > 0; len--) {
+		LL_CRC_FeedData8(regs, *data++);
+	}
+
+	*result = ~LL_CRC_ReadData32(regs);
+
+	k_mutex_unlock(&dev_data->lock);
+
+	return 0;
+}
+
+static const struct crc_driver_api crc_stm32_api = {
+	.crc32_ieee_update = crc_stm32_crc32_ieee_update,
+};
+
+static int crc_stm32_init(const struct device *dev)
+{
+	const struct crc_stm32_config *cfg = dev->config;
+	struct crc_stm32_data *dev_data = dev->data;
+	const struct device *clk = DEVICE_DT_GET(STM32_CLOCK_CONTROL_NODE);
+	int ret;
+
+	if (!device_is_ready(clk)) {
+		return -ENODEV;
+	}
+
+	ret = clock_control_on(clk, (clock_control_subsys_t *)&cfg->pclken);
+	if (ret < 0) {
+		return ret;
+	}
+
+	k_mutex_init(&dev_data->lock);
+
+#if defined(CRC_POL_POL)
+	/* Programmable polynomial, make sure the default one is used */
+	LL_CRC_SetPolynomialSize(cfg->crc, LL_CRC_POLYLENGTH_32B);
+	LL_CRC_SetPolynomialCoef(cfg->crc, LL_CRC_DEFAULT_CRC32_POLY);
+#endif
+	LL_CRC_SetOutputDataReverseMode(cfg->crc, LL_CRC_OUTDATA_REVERSE_BIT);
+
+	return 0;
+}
+
+#define CRC_STM32_INIT(inst)							\
+	static const struct crc_stm32_config crc_stm32_config_##inst = {	\
+		.crc = (CRC_TypeDef *)DT_INST_REG_ADDR(inst),			\
+		.pclken = {							\
+			.bus = DT_INST_CLOCKS_CELL(inst, bus),			\
+			.enr = DT_INST_CLOCKS_CELL(inst, bits),			\
+		},								\
+	};									\
+										\
+	static struct crc_stm32_data crc_stm32_data_##inst;			\
+										\
+	DEVICE_DT_INST_DEFINE(inst, crc_stm32_init, NULL,			\
+			      &crc_stm32_data_##inst, &crc_stm32_config_##inst,	\
+			      PRE_KERNEL_1, CONFIG_CRC_INIT_PRIORITY,		\
+			      &crc_stm32_api);
+
+DT_INST_FOREACH_STATUS_OKAY(CRC_STM32_INIT)
@@ -28,8 +28,13 @@ LOG_MODULE_REGISTER(crypto_stm32);
 #error No STM32 HW Crypto Accelerator in device tree
 #endif
 
+#if defined(CONFIG_CRYPTO_STM32_ASYNC)
+#define CRYP_SUPPORT (CAP_RAW_KEY | CAP_SEPARATE_IO_BUFS | CAP_SYNC_OPS | \
+		      CAP_ASYNC_OPS | CAP_NO_IV_PREFIX)
+#else
 #define CRYP_SUPPORT (CAP_RAW_KEY | CAP_SEPARATE_IO_BUFS | CAP_SYNC_OPS | \
 		      CAP_NO_IV_PREFIX)
+#endif
 #define BLOCK_LEN_BYTES 16
 #define BLOCK_LEN_WORDS (BLOCK_LEN_BYTES / sizeof(uint32_t))
 #define CRYPTO_MAX_SESSION CONFIG_CRYPTO_STM32_MAX_SESSION
@@ -50,6 +55,10 @@ LOG_MODULE_REGISTER(crypto_stm32);
 
 struct crypto_stm32_session crypto_stm32_sessions[CRYPTO_MAX_SESSION];
 
+#if defined(CONFIG_CRYPTO_STM32_ASYNC)
+K_KERNEL_STACK_DEFINE(crypto_stm32_stack, CONFIG_CRYPTO_STM32_THREAD_STACK_SIZE);
+#endif
+
 static void copy_reverse_words(uint8_t *dst_buf, int dst_len,
 			       uint8_t *src_buf, int src_len)
 {
@@ -64,6 +73,28 @@ static void copy_reverse_words(uint8_t *dst_buf, int dst_len,
 	}
 }
 
+/* Load the configuration of a session into the peripheral. The key and
+ * mode are only reloaded when another session used the peripheral last,
+ * the IV being the only parameter changing between packets of a session.
+ */
+static int crypto_stm32_configure(struct crypto_stm32_data *data,
+				  struct crypto_stm32_session *session)
+{
+	if (data->cur_session == session) {
+		data->hcryp.Init.pInitVect = session->config.pInitVect;
+		return 0;
+	}
+
+	if (HAL_CRYP_SetConfig(&data->hcryp, &session->config) != HAL_OK) {
+		data->cur_session = NULL;
+		return -EIO;
+	}
+
+	data->cur_session = session;
+
+	return 0;
+}
+
 static int do_encrypt(struct cipher_ctx *ctx, uint8_t *in_buf, int in_len,
 		      uint8_t *out_buf)
 {
@@ -74,8 +105,7 @@ static int do_encrypt(struct cipher_ctx *ctx, uint8_t *in_buf, int in_len,
 
 	k_sem_take(&data->device_sem, K_FOREVER);
 
-	status = HAL_CRYP_SetConfig(&data->hcryp, &session->config);
-	if (status != HAL_OK) {
+	if (crypto_stm32_configure(data, session) != 0) {
 		LOG_ERR("Configuration error");
 		k_sem_give(&data->device_sem);
 		return -EIO;
@@ -85,6 +115,8 @@ static int do_encrypt(struct cipher_ctx *ctx, uint8_t *in_buf, int in_len,
 				  (uint32_t *)out_buf, HAL_MAX_DELAY);
 	if (status != HAL_OK) {
 		LOG_ERR("Encryption error");
+		/* Let the next packet reset the peripheral state */
+		data->cur_session = NULL;
 		k_sem_give(&data->device_sem);
 		return -EIO;
 	}
@@ -104,8 +136,7 @@ static int do_decrypt(struct cipher_ctx *ctx, uint8_t *in_buf, int in_len,
 
 	k_sem_take(&data->device_sem, K_FOREVER);
 
-	status = HAL_CRYP_SetConfig(&data->hcryp, &session->config);
-	if (status != HAL_OK) {
+	if (crypto_stm32_configure(data, session) != 0) {
 		LOG_ERR("Configuration error");
 		k_sem_give(&data->device_sem);
 		return -EIO;
@@ -115,6 +146,8 @@ static int do_decrypt(struct cipher_ctx *ctx, uint8_t *in_buf, int in_len,
 				  (uint32_t *)out_buf, HAL_MAX_DELAY);
 	if (status != HAL_OK) {
 		LOG_ERR("Decryption error");
+		/* Let the next packet reset the peripheral state */
+		data->cur_session = NULL;
 		k_sem_give(&data->device_sem);
 		return -EIO;
 	}
@@ -258,6 +291,104 @@ static int crypto_stm32_ctr_decrypt(struct cipher_ctx *ctx,
 	return ret;
 }
 
+#if defined(CONFIG_CRYPTO_STM32_ASYNC)
+/* Queue a packet for the driver thread. The IV is copied, so the caller
+ * may reuse its buffer as soon as the packet is queued.
+ */
+static int crypto_stm32_queue(struct cipher_ctx *ctx, struct cipher_pkt *pkt,
+			      const uint8_t *iv, size_t iv_len)
+{
+	struct crypto_stm32_data *data = CRYPTO_STM32_DATA(ctx->device);
+	struct crypto_stm32_req req = {
+		.pkt = pkt,
+	};
+
+	if (iv != NULL) {
+		memcpy(req.iv, iv, MIN(iv_len, sizeof(req.iv)));
+	}
+
+	if (k_msgq_put(&data->queue, &req, K_NO_WAIT) != 0) {
+		return -EBUSY;
+	}
+
+	return 0;
+}
+
+static int crypto_stm32_block_queue(struct cipher_ctx *ctx,
+				    struct cipher_pkt *pkt)
+{
+	return crypto_stm32_queue(ctx, pkt, NULL, 0);
+}
+
+static int crypto_stm32_cbc_queue(struct cipher_ctx *ctx,
+				  struct cipher_pkt *pkt, uint8_t *iv)
+{
+	return crypto_stm32_queue(ctx, pkt, iv, BLOCK_LEN_BYTES);
+}
+
+static int crypto_stm32_ctr_queue(struct cipher_ctx *ctx,
+				  struct cipher_pkt *pkt, uint8_t *iv)
+{
+	int ivlen = ctx->keylen - (ctx->mode_params.ctr_info.ctr_len >> 3);
+
+	return crypto_stm32_queue(ctx, pkt, iv, ivlen);
+}
+
+/* Process the queued packets in order. Packets of the same session
+ * follow each other without reloading the key, see crypto_stm32_configure().
+ */
+static void crypto_stm32_thread(void *p1, void *p2, void *p3)
+{
+	const struct device *dev = p1;
+	struct crypto_stm32_data *data = CRYPTO_STM32_DATA(dev);
+	struct crypto_stm32_session *session;
+	struct crypto_stm32_req req;
+	struct cipher_ctx *ctx;
+	int ret;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (;;) {
+		(void)k_msgq_get(&data->queue, &req, K_FOREVER);
+
+		ctx = req.pkt->ctx;
+		session = CRYPTO_STM32_SESSN(ctx);
+
+		switch (ctx->ops.cipher_mode) {
+		case CRYPTO_CIPHER_MODE_ECB:
+			ret = session->ops.block_crypt_hndlr(ctx, req.pkt);
+			break;
+		case CRYPTO_CIPHER_MODE_CBC:
+			ret = session->ops.cbc_crypt_hndlr(ctx, req.pkt,
+							   (uint8_t *)req.iv);
+			break;
+		case CRYPTO_CIPHER_MODE_CTR:
+			ret = session->ops.ctr_crypt_hndlr(ctx, req.pkt,
+							   (uint8_t *)req.iv);
+			break;
+		default:
+			ret = -EINVAL;
+			break;
+		}
+
+		if (data->callback != NULL) {
+			data->callback(req.pkt, ret);
+		}
+	}
+}
+
+static int crypto_stm32_callback_set(const struct device *dev,
+				     cipher_completion_cb cb)
+{
+	struct crypto_stm32_data *data = CRYPTO_STM32_DATA(dev);
+
+	data->callback = cb;
+
+	return 0;
+}
+#endif /* CONFIG_CRYPTO_STM32_ASYNC */
+
 static int crypto_stm32_get_unused_session_index(const struct device *dev)
 {
 	int i;
@@ -401,6 +532,27 @@ static int crypto_stm32_session_setup(const struct device *dev,
 	session->config.DataType = CRYP_DATATYPE_8B;
 	session->config.DataWidthUnit = CRYP_DATAWIDTHUNIT_BYTE;
 
+#if defined(CONFIG_CRYPTO_STM32_ASYNC)
+	if (ctx->flags & CAP_ASYNC_OPS) {
+		/* The driver thread calls the synchronous handlers */
+		session->ops = ctx->ops;
+
+		switch (mode) {
+		case CRYPTO_CIPHER_MODE_ECB:
+			ctx->ops.block_crypt_hndlr = crypto_stm32_block_queue;
+			break;
+		case CRYPTO_CIPHER_MODE_CBC:
+			ctx->ops.cbc_crypt_hndlr = crypto_stm32_cbc_queue;
+			break;
+		case CRYPTO_CIPHER_MODE_CTR:
+			ctx->ops.ctr_crypt_hndlr = crypto_stm32_ctr_queue;
+			break;
+		default:
+			break;
+		}
+	}
+#endif
+
 	ctx->drv_sessn_state = session;
 	ctx->device = dev;
 
@@ -417,6 +569,13 @@ static int crypto_stm32_session_free(const struct device *dev,
 
 	session->in_use = false;
 
+	/* A new session may reuse the slot with another key */
+	k_sem_take(&data->device_sem, K_FOREVER);
+	if (data->cur_session == session) {
+		data->cur_session = NULL;
+	}
+	k_sem_give(&data->device_sem);
+
 	k_sem_take(&data->session_sem, K_FOREVER);
 
 	/* Disable peripheral only if there are no more active sessions. */
@@ -471,13 +630,27 @@ static int crypto_stm32_init(const struct device *dev)
 		return -EIO;
 	}
 
+#if defined(CONFIG_CRYPTO_STM32_ASYNC)
+	k_msgq_init(&data->queue, data->queue_buf, sizeof(struct crypto_stm32_req),
+		    CONFIG_CRYPTO_STM32_QUEUE_DEPTH);
+	k_thread_create(&data->thread, crypto_stm32_stack,
+			K_KERNEL_STACK_SIZEOF(crypto_stm32_stack),
+			crypto_stm32_thread, (void *)dev, NULL, NULL,
+			CONFIG_CRYPTO_STM32_THREAD_PRIORITY, 0, K_NO_WAIT);
+	k_thread_name_set(&data->thread, "crypto_stm32");
+#endif
+
 	return 0;
 }
 
 static struct crypto_driver_api crypto_enc_funcs = {
 	.cipher_begin_session = crypto_stm32_session_setup,
 	.cipher_free_session = crypto_stm32_session_free,
+#if defined(CONFIG_CRYPTO_STM32_ASYNC)
+	.cipher_async_callback_set = crypto_stm32_callback_set,
+#else
 	.cipher_async_callback_set = NULL,
+#endif
 	.query_hw_caps = crypto_stm32_query_caps,
 };
 
@@ -15,16 +15,38 @@ struct crypto_stm32_config {
 	struct stm32_pclken pclken;
 };
 
+/* Packet queued for the driver thread */
+struct crypto_stm32_req {
+	struct cipher_pkt *pkt;
+	/* IV or counter, one AES block */
+	uint32_t iv[4];
+};
+
+struct crypto_stm32_session;
+
 struct crypto_stm32_data {
 	CRYP_HandleTypeDef hcryp;
 	struct k_sem device_sem;
 	struct k_sem session_sem;
+	/* Session whose configuration is loaded in the peripheral */
+	struct crypto_stm32_session *cur_session;
+#if defined(CONFIG_CRYPTO_STM32_ASYNC)
+	struct k_msgq queue;
+	char __aligned(4) queue_buf[CONFIG_CRYPTO_STM32_QUEUE_DEPTH *
+				    sizeof(struct crypto_stm32_req)];
+	struct k_thread thread;
+	cipher_completion_cb callback;
+#endif
 };
 
 struct crypto_stm32_session {
 	CRYP_ConfigTypeDef config;
 	uint32_t key[CRYPTO_STM32_AES_MAX_KEY_LEN / sizeof(uint32_t)];
 	bool in_use;
+#if defined(CONFIG_CRYPTO_STM32_ASYNC)
+	/* Synchronous handlers of an asynchronous session */
+	struct cipher_ops ops;
+#endif
 };
 
 #define CRYPTO_STM32_CFG(dev) \
@@ -15,6 +15,9 @@
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(display_ili9xxx, CONFIG_DISPLAY_LOG_LEVEL);
 
+/* Maximum number of lines sent in a single SPI transfer */
+#define ILI9XXX_WRITE_BUFS_MAX 16U
+
 struct ili9xxx_data {
 	uint8_t bytes_per_pixel;
 	enum display_pixel_format pixel_format;
@@ -118,7 +121,7 @@ static int ili9xxx_write(const struct device *dev, const uint16_t x,
 
 	int r;
 	const uint8_t *write_data_start = (const uint8_t *)buf;
-	struct spi_buf tx_buf;
+	struct spi_buf tx_buf[ILI9XXX_WRITE_BUFS_MAX];
 	struct spi_buf_set tx_bufs;
 	uint16_t write_cnt;
 	uint16_t nbr_of_writes;
@@ -150,20 +153,26 @@ static int ili9xxx_write(const struct device *dev, const uint16_t x,
 		return r;
 	}
 
-	tx_bufs.buffers = &tx_buf;
-	tx_bufs.count = 1;
+	tx_bufs.buffers = tx_buf;
 
+	/* Remaining lines are gathered into a single transfer, so the bus is
+	 * set up once for all of them and DMA capable controllers can send
+	 * them back to back.
+	 */
 	write_data_start += desc->pitch * data->bytes_per_pixel;
-	for (write_cnt = 1U; write_cnt < nbr_of_writes; ++write_cnt) {
-		tx_buf.buf = (void *)write_data_start;
-		tx_buf.len = desc->width * data->bytes_per_pixel * write_h;
+	for (write_cnt = 1U; write_cnt < nbr_of_writes; write_cnt += tx_bufs.count) {
+		tx_bufs.count = MIN(nbr_of_writes - write_cnt, ARRAY_SIZE(tx_buf));
+
+		for (size_t i = 0; i < tx_bufs.count; i++) {
+			tx_buf[i].buf = (void *)write_data_start;
+			tx_buf[i].len = desc->width * data->bytes_per_pixel * write_h;
+			write_data_start += desc->pitch * data->bytes_per_pixel;
+		}
 
 		r = spi_write_dt(&config->spi, &tx_bufs);
 		if (r < 0) {
 			return r;
 		}
-
-		write_data_start += desc->pitch * data->bytes_per_pixel;
 	}
 
 	return 0;
@@ -59,6 +59,9 @@ struct st7789v_data {
 #define ST7789V_PIXEL_SIZE 3u
 #endif
 
+/* Maximum number of lines sent in a single SPI transfer */
+#define ST7789V_WRITE_BUFS_MAX 16U
+
 static void st7789v_set_lcd_margins(const struct device *dev,
 				    uint16_t x_offset, uint16_t y_offset)
 {
@@ -174,7 +177,10 @@ static int st7789v_write(const struct device *dev,
 			 const struct display_buffer_descriptor *desc,
 			 const void *buf)
 {
+	const struct st7789v_config *config = dev->config;
 	const uint8_t *write_data_start = (uint8_t *) buf;
+	struct spi_buf tx_buf[ST7789V_WRITE_BUFS_MAX];
+	struct spi_buf_set tx_bufs;
 	uint16_t nbr_of_writes;
 	uint16_t write_h;
 
@@ -194,11 +200,38 @@ static int st7789v_write(const struct device *dev,
 		nbr_of_writes = 1U;
 	}
 
-	for (uint16_t write_cnt = 0U; write_cnt < nbr_of_writes; ++write_cnt) {
-		st7789v_transmit(dev, write_cnt == 0U ? ST7789V_CMD_RAMWR : ST7789V_CMD_NONE,
-				(void *) write_data_start,
-				desc->width * ST7789V_PIXEL_SIZE * write_h);
-		write_data_start += (desc->pitch * ST7789V_PIXEL_SIZE);
+	if (config->cmd_data_gpio.port == NULL) {
+		for (uint16_t write_cnt = 0U; write_cnt < nbr_of_writes; ++write_cnt) {
+			st7789v_transmit(dev,
+					 write_cnt == 0U ? ST7789V_CMD_RAMWR : ST7789V_CMD_NONE,
+					 (void *) write_data_start,
+					 desc->width * ST7789V_PIXEL_SIZE * write_h);
+			write_data_start += (desc->pitch * ST7789V_PIXEL_SIZE);
+		}
+
+		return 0;
+	}
+
+	st7789v_transmit(dev, ST7789V_CMD_RAMWR, (void *) write_data_start,
+			 desc->width * ST7789V_PIXEL_SIZE * write_h);
+	write_data_start += (desc->pitch * ST7789V_PIXEL_SIZE);
+
+	/* Remaining lines are gathered into a single transfer, so the bus is
+	 * set up once for all of them and DMA capable controllers can send
+	 * them back to back.
+	 */
+	tx_bufs.buffers = tx_buf;
+	for (uint16_t write_cnt = 1U; write_cnt < nbr_of_writes;
+	     write_cnt += tx_bufs.count) {
+		tx_bufs.count = MIN(nbr_of_writes - write_cnt, ARRAY_SIZE(tx_buf));
+
+		for (size_t i = 0; i < tx_bufs.count; i++) {
+			tx_buf[i].buf = (void *) write_data_start;
+			tx_buf[i].len = desc->width * ST7789V_PIXEL_SIZE * write_h;
+			write_data_start += (desc->pitch * ST7789V_PIXEL_SIZE);
+		}
+
+		spi_write_dt(&config->bus, &tx_bufs);
 	}
 
 	return 0;
@@ -49,6 +49,7 @@ out:
 
 static const struct dma_driver_api dw_dma_driver_api = {
 	.config = dw_dma_config,
+	.reload = dw_dma_reload,
 	.start = dw_dma_start,
 	.stop = dw_dma_stop,
 };
@@ -413,6 +413,78 @@ out:
 	return ret;
 }
 
+int dw_dma_reload(const struct device *dev, uint32_t channel,
+		  uint32_t src, uint32_t dst, size_t size)
+{
+	struct dw_dma_dev_data *const dev_data = dev->data;
+	struct dma_block_config block_cfg = { 0 };
+	struct dw_dma_chan_data *chan_data;
+	struct dw_lli *lli_desc;
+	size_t block_size;
+
+	if (channel >= DW_MAX_CHAN) {
+		return -EINVAL;
+	}
+
+	chan_data = &dev_data->chan[channel];
+
+	if (chan_data->state != DW_DMA_IDLE && chan_data->state != DW_DMA_PREPARED) {
+		LOG_ERR("%s: dma %s channel %d must be inactive to reload, currently %d",
+			__func__, dev->name, channel, chan_data->state);
+		return -EBUSY;
+	}
+
+	if (chan_data->lli == NULL) {
+		return -EINVAL;
+	}
+
+	/* The descriptors prepared by dw_dma_config() are kept, only addresses
+	 * and sizes are patched. The buffer is split evenly over them, so a
+	 * cyclic list of two descriptors is a ping-pong buffer.
+	 */
+	block_size = size / chan_data->lli_count;
+	if (block_size * chan_data->lli_count != size ||
+	    block_size > DW_CTLH_BLOCK_TS_MASK) {
+		LOG_ERR("%s: dma %s channel %d invalid reload size %zu",
+			__func__, dev->name, channel, size);
+		return -EINVAL;
+	}
+
+	block_cfg.source_address = src;
+	block_cfg.dest_address = dst;
+
+	lli_desc = chan_data->lli;
+	for (int i = 0; i < chan_data->lli_count; i++) {
+		dw_dma_mask_address(&block_cfg, lli_desc, chan_data->direction);
+
+		lli_desc->ctrl_hi &= ~(DW_CTLH_BLOCK_TS_MASK | DW_CTLH_DONE(1));
+		lli_desc->ctrl_hi |= block_size;
+
+		/* Only the memory side of the transfer increments */
+		if (chan_data->direction != PERIPHERAL_TO_MEMORY) {
+			block_cfg.source_address += block_size;
+		}
+		if (chan_data->direction != MEMORY_TO_PERIPHERAL) {
+			block_cfg.dest_address += block_size;
+		}
+
+		lli_desc++;
+	}
+
+	chan_data->state = DW_DMA_PREPARED;
+	chan_data->lli_current = chan_data->lli;
+
+	chan_data->ptr_data.buffer_bytes = size;
+	chan_data->ptr_data.start_ptr = DW_DMA_LLI_ADDRESS(chan_data->lli,
+							 chan_data->direction);
+	chan_data->ptr_data.end_ptr = chan_data->ptr_data.start_ptr + size;
+	chan_data->ptr_data.current_ptr = chan_data->ptr_data.start_ptr;
+	chan_data->ptr_data.hw_ptr = chan_data->ptr_data.start_ptr;
+
+	/* ready to be started again */
+	return 0;
+}
+
 int dw_dma_start(const struct device *dev, uint32_t channel)
 {
 	const struct dw_dma_dev_cfg *const dev_cfg = dev->config;
@@ -200,7 +200,7 @@ static int dsa_ksz8xxx_write_static_mac_table(struct ksz8xxx_data *pdev,
 
 static int dsa_ksz8xxx_set_static_mac_table(struct ksz8xxx_data *pdev,
 					    const uint8_t *mac, uint8_t fw_port,
-					    uint16_t entry_idx)
+					    uint16_t entry_idx, bool valid)
 {
 	/*
 	 * The data in uint8_t buf[] buffer is stored in the little endian
@@ -218,7 +218,9 @@ static int dsa_ksz8xxx_set_static_mac_table(struct ksz8xxx_data *pdev,
 	buf[0] = mac[5];
 
 	buf[6] = fw_port;
-	buf[6] |= KSZ8XXX_STATIC_MAC_TABLE_VALID;
+	if (valid) {
+		buf[6] |= KSZ8XXX_STATIC_MAC_TABLE_VALID;
+	}
 	buf[6] |= KSZ8XXX_STATIC_MAC_TABLE_OVRD;
 
 	dsa_ksz8xxx_write_static_mac_table(pdev, entry_idx, buf);
@@ -776,7 +778,8 @@ static int dsa_ksz8xxx_sw_read_reg(const struct device *dev, uint16_t reg_addr,
  * @param mac The MAC address to be set in the table
  * @param fw_port Port number to forward packets
  * @param tbl_entry_idx The index of entry in the table
- * @param flags Flags to be set in the entry
+ * @param flags Flags to be set in the entry, DSA_MAC_TABLE_ENTRY_INVALID
+ *        to remove it
  *
  * @return 0 if ok, < 0 if error
  */
@@ -789,12 +792,12 @@ static int dsa_ksz8xxx_set_mac_table_entry(const struct device *dev,
 	struct dsa_context *data = dev->data;
 	struct ksz8xxx_data *pdev = PRV_DATA(data);
 
-	if (flags != 0) {
+	if (flags & ~DSA_MAC_TABLE_ENTRY_INVALID) {
 		return -EINVAL;
 	}
 
-	dsa_ksz8xxx_set_static_mac_table(pdev, mac, fw_port,
-						tbl_entry_idx);
+	dsa_ksz8xxx_set_static_mac_table(pdev, mac, fw_port, tbl_entry_idx,
+					 !(flags & DSA_MAC_TABLE_ENTRY_INVALID));
 
 	return 0;
 }
@@ -1013,15 +1016,55 @@ static void dsa_iface_init(struct net_if *iface)
 
 static enum ethernet_hw_caps dsa_port_get_capabilities(const struct device *dev)
 {
+	enum ethernet_hw_caps caps = ETHERNET_DSA_SLAVE_PORT |
+		ETHERNET_LINK_10BASE_T | ETHERNET_LINK_100BASE_T;
+
 	ARG_UNUSED(dev);
 
-	return ETHERNET_DSA_SLAVE_PORT | ETHERNET_LINK_10BASE_T |
-		ETHERNET_LINK_100BASE_T;
+	if (IS_ENABLED(CONFIG_NET_PROMISCUOUS_MODE)) {
+		caps |= ETHERNET_PROMISC_MODE;
+	}
+
+	return caps;
+}
+
+#if defined(CONFIG_NET_PROMISCUOUS_MODE)
+static int dsa_port_set_config(const struct device *dev,
+			       enum ethernet_config_type type,
+			       const struct ethernet_config *config)
+{
+	struct dsa_context *context = dev->data;
+	int ret;
+
+	switch (type) {
+	case ETHERNET_CONFIG_TYPE_PROMISC_MODE:
+		/*
+		 * The frames of all the slave ports are received through
+		 * the master port, which has to accept them all.
+		 */
+		if (context->iface_master == NULL) {
+			return -ENODEV;
+		}
+
+		ret = net_eth_promisc_mode(context->iface_master,
+					   config->promisc_mode);
+		return ret == -EALREADY ? 0 : ret;
+
+	default:
+		return -ENOTSUP;
+	}
 }
+#endif
 
 const struct ethernet_api dsa_eth_api_funcs = {
 	.iface_api.init		= dsa_iface_init,
 	.get_capabilities	= dsa_port_get_capabilities,
+#if defined(CONFIG_NET_PROMISCUOUS_MODE)
+	.set_config		= dsa_port_set_config,
+#endif
+#if defined(CONFIG_DSA_BRIDGE_FDB_OFFLOAD)
+	.bridge_fdb_update	= dsa_bridge_fdb_update,
+#endif
 	.send                   = dsa_tx,
 };
 
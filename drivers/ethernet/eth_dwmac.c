@@ -250,15 +250,16 @@ static void dwmac_tx_release(struct dwmac_priv *p)
 	p->tx_desc_tail = d_idx;
 }
 
-static void dwmac_receive(struct dwmac_priv *p)
+static int dwmac_receive(struct dwmac_priv *p, int budget)
 {
 	struct dwmac_dma_desc *d;
 	struct net_buf *frag;
 	unsigned int d_idx, bytes_so_far;
 	uint32_t des3_val;
+	int count = 0;
 
 	for (d_idx = p->rx_desc_tail;
-	     d_idx != p->rx_desc_head;
+	     d_idx != p->rx_desc_head && count < budget;
 	     INC_WRAP(d_idx, NB_RX_DESCS), k_sem_give(&p->free_rx_descs)) {
 
 		LOG_DBG("desc sem/tail/head=%d/%d/%d",
@@ -314,18 +315,44 @@ static void dwmac_receive(struct dwmac_priv *p)
 				LOG_DBG("pkt len/frags=%zd/%d",
 					net_pkt_get_len(p->rx_pkt),
 					net_pkt_get_nbfrags(p->rx_pkt));
+#ifdef CONFIG_NET_RX_POLL
+				net_rx_poll_recv(&p->rx_poll, p->rx_pkt);
+#else
 				net_recv_data(p->iface, p->rx_pkt);
+#endif
 			} else {
 				LOG_ERR("rx error (DES3 = 0x%08x)", des3_val);
 				eth_stats_update_errors_rx(p->iface);
 				net_pkt_unref(p->rx_pkt);
 			}
 			p->rx_pkt = NULL;
+			count++;
 		}
 	}
 	p->rx_desc_tail = d_idx;
+
+	return count;
 }
 
+#ifdef CONFIG_NET_RX_POLL
+static int dwmac_rx_poll(struct net_rx_poll *poll, int budget)
+{
+	struct dwmac_priv *p = CONTAINER_OF(poll, struct dwmac_priv, rx_poll);
+	int count;
+
+	count = dwmac_receive(p, budget);
+
+	/* done for now: unmask RX IRQ */
+	if (count < budget) {
+		REG_WRITE(DMA_CHn_IRQ_ENABLE(0),
+			  REG_READ(DMA_CHn_IRQ_ENABLE(0)) |
+			  DMA_CHn_IRQ_ENABLE_RIE);
+	}
+
+	return count;
+}
+#endif
+
 static void dwmac_rx_refill_thread(void *arg1, void *unused1, void *unused2)
 {
 	struct dwmac_priv *p = arg1;
@@ -409,7 +436,15 @@ static void dwmac_dma_irq(struct dwmac_priv *p, unsigned int ch)
 	}
 
 	if (status & DMA_CHn_STATUS_RI) {
-		dwmac_receive(p);
+#ifdef CONFIG_NET_RX_POLL
+		/* mask RX IRQ until polling is done */
+		REG_WRITE(DMA_CHn_IRQ_ENABLE(ch),
+			  REG_READ(DMA_CHn_IRQ_ENABLE(ch)) &
+			  ~DMA_CHn_IRQ_ENABLE_RIE);
+		net_rx_poll_schedule(&p->rx_poll);
+#else
+		dwmac_receive(p, INT_MAX);
+#endif
 	}
 }
 
@@ -539,6 +574,10 @@ static void dwmac_iface_init(struct net_if *iface)
 			0, K_PRIO_PREEMPT(0), K_NO_WAIT);
 	k_thread_name_set(&p->rx_refill_thread, "dwmac_rx_refill");
 
+#ifdef CONFIG_NET_RX_POLL
+	net_rx_poll_init(&p->rx_poll, iface, dwmac_rx_poll);
+#endif
+
 	/* start up TX/RX */
 	reg_val = REG_READ(DMA_CHn_TX_CTRL(0));
 	REG_WRITE(DMA_CHn_TX_CTRL(0), reg_val | DMA_CHn_TX_CTRL_St);
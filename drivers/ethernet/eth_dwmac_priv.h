@@ -65,6 +65,10 @@ struct dwmac_priv {
 	struct net_pkt *rx_pkt;
 	unsigned int rx_bytes;
 
+#ifdef CONFIG_NET_RX_POLL
+	struct net_rx_poll rx_poll;
+#endif
+
 	K_KERNEL_STACK_MEMBER(rx_refill_thread_stack, RX_REFILL_STACK_SIZE);
 	struct k_thread rx_refill_thread;
 };
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/drivers/flash.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(flash_async, CONFIG_FLASH_LOG_LEVEL);
+
+K_THREAD_STACK_DEFINE(flash_async_stack_area, CONFIG_FLASH_ASYNC_STACK_SIZE);
+static struct k_work_q flash_async_wq;
+
+static sys_slist_t flash_async_queue;
+static struct k_spinlock flash_async_lock;
+
+static struct flash_async_req *flash_async_get(void)
+{
+	k_spinlock_key_t key;
+	sys_snode_t *node;
+
+	key = k_spin_lock(&flash_async_lock);
+	node = sys_slist_get(&flash_async_queue);
+	k_spin_unlock(&flash_async_lock, key);
+
+	if (node == NULL) {
+		return NULL;
+	}
+
+	return CONTAINER_OF(node, struct flash_async_req, node);
+}
+
+static void flash_async_work_handler(struct k_work *work)
+{
+	struct flash_async_req *req;
+
+	ARG_UNUSED(work);
+
+	while ((req = flash_async_get()) != NULL) {
+		switch (req->op) {
+		case FLASH_ASYNC_OP_READ:
+			req->result = flash_read(req->dev, req->offset,
+						 req->data, req->size);
+			break;
+		case FLASH_ASYNC_OP_WRITE:
+			req->result = flash_write(req->dev, req->offset,
+						  req->data, req->size);
+			break;
+		case FLASH_ASYNC_OP_ERASE:
+			req->result = flash_erase(req->dev, req->offset,
+						  req->size);
+			break;
+		default:
+			req->result = -EINVAL;
+			break;
+		}
+
+		if (req->result != 0) {
+			LOG_DBG("%s op %d at 0x%lx failed: %d", req->dev->name,
+				req->op, (long)req->offset, req->result);
+		}
+
+		req->cb(req);
+	}
+}
+
+static K_WORK_DEFINE(flash_async_work, flash_async_work_handler);
+
+int flash_async_submit(struct flash_async_req *req)
+{
+	k_spinlock_key_t key;
+
+	if ((req == NULL) || (req->dev == NULL) || (req->cb == NULL) ||
+	    ((req->op != FLASH_ASYNC_OP_ERASE) && (req->data == NULL))) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&flash_async_lock);
+	sys_slist_append(&flash_async_queue, &req->node);
+	k_spin_unlock(&flash_async_lock, key);
+
+	(void)k_work_submit_to_queue(&flash_async_wq, &flash_async_work);
+
+	return 0;
+}
+
+static int flash_async_init(const struct device *d)
+{
+	ARG_UNUSED(d);
+
+	const struct k_work_queue_config cfg = {.name = "flash_async"};
+
+	k_work_queue_init(&flash_async_wq);
+
+	k_work_queue_start(&flash_async_wq, flash_async_stack_area,
+			   K_THREAD_STACK_SIZEOF(flash_async_stack_area),
+			   CONFIG_FLASH_ASYNC_PRIO, &cfg);
+
+	return 0;
+}
+
+SYS_INIT(flash_async_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
@@ -19,6 +19,29 @@ static int flash_get_page_info(const struct device *dev, off_t offs,
 
 	api->page_layout(dev, &layout, &layout_size);
 
+	/* Most devices have pages of a single size, the page is then found
+	 * without walking the layout.
+	 */
+	if (layout_size == 1) {
+		info->size = layout->pages_size;
+		if (offs != 0) {
+			if (offs < 0) {
+				return -EINVAL;
+			}
+
+			index = offs / info->size;
+		}
+
+		if (index >= layout->pages_count) {
+			return -EINVAL;
+		}
+
+		info->start_offset = index * info->size;
+		info->index = index;
+
+		return 0;
+	}
+
 	while (layout_size--) {
 		info->size = layout->pages_size;
 		if (offs == 0) {
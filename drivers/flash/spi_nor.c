@@ -146,6 +146,17 @@ struct spi_nor_data {
 #endif /* CONFIG_FLASH_PAGE_LAYOUT */
 #endif /* CONFIG_SPI_NOR_SFDP_RUNTIME */
 #endif /* CONFIG_SPI_NOR_SFDP_MINIMAL */
+
+#ifdef CONFIG_SPI_NOR_READ_CACHE
+	/* Recently read lines, replaced round-robin. A line with a
+	 * negative address holds no data.
+	 */
+	struct {
+		off_t addr;
+		uint8_t data[CONFIG_SPI_NOR_READ_CACHE_LINE_SIZE];
+	} read_cache[CONFIG_SPI_NOR_READ_CACHE_LINES];
+	uint8_t read_cache_next;
+#endif /* CONFIG_SPI_NOR_READ_CACHE */
 };
 
 #ifdef CONFIG_SPI_NOR_SFDP_MINIMAL
@@ -272,6 +283,11 @@ static inline void delay_until_exit_dpd_ok(const struct device *const dev)
  */
 #define NOR_ACCESS_32BIT_ADDR BIT(2)
 
+/* Indicates that the address is followed by one dummy byte (8 wait
+ * cycles), as required by the 1-1-1 Fast Read command.
+ */
+#define NOR_ACCESS_DUMMY_BYTE BIT(3)
+
 /* Indicates that an access command is performing a write.  If not
  * provided access is a read.
  */
@@ -297,7 +313,7 @@ static int spi_nor_access(const struct device *const dev,
 	struct spi_nor_data *const driver_data = dev->data;
 	bool is_addressed = (access & NOR_ACCESS_ADDRESSED) != 0U;
 	bool is_write = (access & NOR_ACCESS_WRITE) != 0U;
-	uint8_t buf[5] = { 0 };
+	uint8_t buf[6] = { 0 };
 	struct spi_buf spi_buf[2] = {
 		{
 			.buf = buf,
@@ -332,20 +348,42 @@ static int spi_nor_access(const struct device *const dev,
 		}
 	};
 
+	if ((access & NOR_ACCESS_DUMMY_BYTE) != 0U) {
+		spi_buf[0].len += 1;
+	}
+
+	if (is_write) {
+		const struct spi_buf_set tx_set = {
+			.buffers = spi_buf,
+			.count = (length != 0) ? 2 : 1,
+		};
+
+		return spi_write_dt(&driver_cfg->spi, &tx_set);
+	}
+
+	/* Only the command is transmitted and the bytes received while it
+	 * is clocked out are discarded, so the controller does not have to
+	 * stream the destination buffer back out during bulk (DMA) reads.
+	 */
+	struct spi_buf rx_buf[2] = {
+		{
+			.buf = NULL,
+			.len = spi_buf[0].len,
+		},
+		{
+			.buf = data,
+			.len = length,
+		}
+	};
 	const struct spi_buf_set tx_set = {
 		.buffers = spi_buf,
-		.count = (length != 0) ? 2 : 1,
+		.count = 1,
 	};
-
 	const struct spi_buf_set rx_set = {
-		.buffers = spi_buf,
+		.buffers = rx_buf,
 		.count = 2,
 	};
 
-	if (is_write) {
-		return spi_write_dt(&driver_cfg->spi, &tx_set);
-	}
-
 	return spi_transceive_dt(&driver_cfg->spi, &tx_set, &rx_set);
 }
 
@@ -359,6 +397,16 @@ static int spi_nor_access(const struct device *const dev,
 	spi_nor_access(dev, opcode, NOR_ACCESS_WRITE | NOR_ACCESS_ADDRESSED, \
 		       addr, (void *)src, length)
 
+#ifdef CONFIG_SPI_NOR_FAST_READ
+#define spi_nor_data_read(dev, addr, dest, length) \
+	spi_nor_access(dev, SPI_NOR_CMD_READ_FAST, \
+		       NOR_ACCESS_ADDRESSED | NOR_ACCESS_DUMMY_BYTE, \
+		       addr, dest, length)
+#else
+#define spi_nor_data_read(dev, addr, dest, length) \
+	spi_nor_cmd_addr_read(dev, SPI_NOR_CMD_READ, addr, dest, length)
+#endif /* CONFIG_SPI_NOR_FAST_READ */
+
 /**
  * @brief Wait until the flash is ready
  *
@@ -371,20 +419,37 @@ static int spi_nor_access(const struct device *const dev,
  * in the code.
  *
  * @param dev The device structure
+ * @param poll_period Time to sleep between status reads, K_NO_WAIT to poll
+ * continuously. Sleeping lets other threads run during long operations.
  * @return 0 on success, negative errno code otherwise
  */
-static int spi_nor_wait_until_ready(const struct device *dev)
+static int spi_nor_wait_until_ready(const struct device *dev,
+				    k_timeout_t poll_period)
 {
 	int ret;
 	uint8_t reg;
 
-	do {
+	while (true) {
 		ret = spi_nor_cmd_read(dev, SPI_NOR_CMD_RDSR, &reg, sizeof(reg));
-	} while (!ret && (reg & SPI_NOR_WIP_BIT));
+		if (ret || !(reg & SPI_NOR_WIP_BIT)) {
+			break;
+		}
+
+		if (!K_TIMEOUT_EQ(poll_period, K_NO_WAIT)) {
+			k_sleep(poll_period);
+		}
+	}
 
 	return ret;
 }
 
+/* Erase takes tens to hundreds of milliseconds, do not hog the CPU meanwhile */
+#if CONFIG_SPI_NOR_ERASE_POLL_PERIOD_US > 0
+#define SPI_NOR_ERASE_POLL_PERIOD K_USEC(CONFIG_SPI_NOR_ERASE_POLL_PERIOD_US)
+#else
+#define SPI_NOR_ERASE_POLL_PERIOD K_NO_WAIT
+#endif
+
 #if defined(CONFIG_SPI_NOR_SFDP_RUNTIME) || defined(CONFIG_FLASH_JESD216_API)
 /*
  * @brief Read content from the SFDP hierarchy
@@ -534,12 +599,98 @@ static int spi_nor_wrsr(const struct device *dev,
 	if (ret == 0) {
 		ret = spi_nor_access(dev, SPI_NOR_CMD_WRSR, NOR_ACCESS_WRITE, 0, &sr,
 				     sizeof(sr));
-		spi_nor_wait_until_ready(dev);
+		spi_nor_wait_until_ready(dev, K_NO_WAIT);
 	}
 
 	return ret;
 }
 
+#ifdef CONFIG_SPI_NOR_READ_CACHE
+
+#define READ_CACHE_LINE_SIZE CONFIG_SPI_NOR_READ_CACHE_LINE_SIZE
+
+BUILD_ASSERT((READ_CACHE_LINE_SIZE & (READ_CACHE_LINE_SIZE - 1)) == 0,
+	     "SPI NOR read cache line size must be a power of two");
+
+/* @note The device must be externally acquired before invoking this
+ * function.
+ */
+static void read_cache_invalidate(const struct device *dev, off_t addr,
+				  size_t size)
+{
+	struct spi_nor_data *const data = dev->data;
+
+	for (size_t i = 0; i < ARRAY_SIZE(data->read_cache); ++i) {
+		off_t line = data->read_cache[i].addr;
+
+		if ((line >= 0) && (line < (addr + (off_t)size))
+		    && ((line + READ_CACHE_LINE_SIZE) > addr)) {
+			data->read_cache[i].addr = -1;
+		}
+	}
+}
+
+/* @note The device must be externally acquired before invoking this
+ * function.
+ */
+static int read_cached(const struct device *dev, off_t addr, uint8_t *dest,
+		       size_t size)
+{
+	struct spi_nor_data *const data = dev->data;
+
+	while (size > 0) {
+		const off_t base = ROUND_DOWN(addr, READ_CACHE_LINE_SIZE);
+		const size_t offs = addr - base;
+		const size_t len = MIN(size, READ_CACHE_LINE_SIZE - offs);
+		uint8_t i;
+
+		for (i = 0; i < ARRAY_SIZE(data->read_cache); ++i) {
+			if (data->read_cache[i].addr == base) {
+				break;
+			}
+		}
+
+		if (i == ARRAY_SIZE(data->read_cache)) {
+			int ret;
+
+			i = data->read_cache_next;
+			data->read_cache_next = (i + 1) % ARRAY_SIZE(data->read_cache);
+
+			data->read_cache[i].addr = -1;
+			ret = spi_nor_data_read(dev, base, data->read_cache[i].data,
+						READ_CACHE_LINE_SIZE);
+			if (ret != 0) {
+				return ret;
+			}
+			data->read_cache[i].addr = base;
+		}
+
+		memcpy(dest, &data->read_cache[i].data[offs], len);
+		dest += len;
+		addr += len;
+		size -= len;
+	}
+
+	return 0;
+}
+
+#else /* CONFIG_SPI_NOR_READ_CACHE */
+
+#define READ_CACHE_LINE_SIZE 0
+
+static inline int read_cached(const struct device *dev, off_t addr,
+			      uint8_t *dest, size_t size)
+{
+	return -ENOTSUP;
+}
+
+static inline void read_cache_invalidate(const struct device *dev, off_t addr,
+					 size_t size)
+{
+}
+
+#endif /* CONFIG_SPI_NOR_READ_CACHE */
+
 static int spi_nor_read(const struct device *dev, off_t addr, void *dest,
 			size_t size)
 {
@@ -553,7 +704,15 @@ static int spi_nor_read(const struct device *dev, off_t addr, void *dest,
 
 	acquire_device(dev);
 
-	ret = spi_nor_cmd_addr_read(dev, SPI_NOR_CMD_READ, addr, dest, size);
+	/* Small reads, typically filesystem metadata, go through the cache;
+	 * bulk reads are issued directly into the caller's buffer.
+	 */
+	if (IS_ENABLED(CONFIG_SPI_NOR_READ_CACHE)
+	    && (size < READ_CACHE_LINE_SIZE)) {
+		ret = read_cached(dev, addr, dest, size);
+	} else {
+		ret = spi_nor_data_read(dev, addr, dest, size);
+	}
 
 	release_device(dev);
 	return ret;
@@ -573,6 +732,7 @@ static int spi_nor_write(const struct device *dev, off_t addr,
 	}
 
 	acquire_device(dev);
+	read_cache_invalidate(dev, addr, size);
 	ret = spi_nor_write_protection_set(dev, false);
 	if (ret == 0) {
 		while (size > 0) {
@@ -600,7 +760,7 @@ static int spi_nor_write(const struct device *dev, off_t addr,
 			src = (const uint8_t *)src + to_write;
 			addr += to_write;
 
-			spi_nor_wait_until_ready(dev);
+			spi_nor_wait_until_ready(dev, K_NO_WAIT);
 		}
 	}
 
@@ -635,6 +795,7 @@ static int spi_nor_erase(const struct device *dev, off_t addr, size_t size)
 	}
 
 	acquire_device(dev);
+	read_cache_invalidate(dev, addr, size);
 	ret = spi_nor_write_protection_set(dev, false);
 
 	while ((size > 0) && (ret == 0)) {
@@ -682,7 +843,7 @@ static int spi_nor_erase(const struct device *dev, off_t addr, size_t size)
 		 */
 		volatile int xcc_ret =
 #endif
-		spi_nor_wait_until_ready(dev);
+		spi_nor_wait_until_ready(dev, SPI_NOR_ERASE_POLL_PERIOD);
 	}
 
 	int ret2 = spi_nor_write_protection_set(dev, true);
@@ -1128,6 +1289,14 @@ static int spi_nor_init(const struct device *dev)
 		k_sem_init(&driver_data->sem, 1, K_SEM_MAX_LIMIT);
 	}
 
+#ifdef CONFIG_SPI_NOR_READ_CACHE
+	struct spi_nor_data *const data = dev->data;
+
+	for (size_t i = 0; i < ARRAY_SIZE(data->read_cache); ++i) {
+		data->read_cache[i].addr = -1;
+	}
+#endif /* CONFIG_SPI_NOR_READ_CACHE */
+
 	return spi_nor_configure(dev);
 }
 
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief RTIO IO device for I2C targets
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/i2c.h>
+#include <zephyr/rtio/rtio.h>
+
+static void i2c_iodev_complete(const struct device *dev, int result,
+			       void *userdata)
+{
+	struct i2c_iodev *iodev = userdata;
+	const struct rtio_sqe *sqe = iodev->sqe;
+
+	ARG_UNUSED(dev);
+
+	/* The next entry of a chain continues the transaction with a
+	 * repeated start.
+	 */
+	iodev->restart = (result == 0) && (sqe->flags & RTIO_SQE_CHAINED);
+
+	if (result < 0) {
+		rtio_sqe_err(iodev->r, sqe, result);
+	} else {
+		rtio_sqe_ok(iodev->r, sqe, result);
+	}
+}
+
+static void i2c_iodev_submit(const struct rtio_sqe *sqe, struct rtio *r)
+{
+	struct i2c_iodev *iodev = (struct i2c_iodev *)sqe->iodev;
+	int err;
+
+	iodev->sqe = sqe;
+	iodev->r = r;
+
+	switch (sqe->op) {
+	case RTIO_OP_TX:
+		iodev->msg.flags = I2C_MSG_WRITE;
+		break;
+	case RTIO_OP_RX:
+		iodev->msg.flags = I2C_MSG_READ;
+		break;
+	default:
+		i2c_iodev_complete(iodev->bus, -EINVAL, iodev);
+		return;
+	}
+
+	if (iodev->restart) {
+		iodev->msg.flags |= I2C_MSG_RESTART;
+	}
+
+	if (!(sqe->flags & RTIO_SQE_CHAINED)) {
+		iodev->msg.flags |= I2C_MSG_STOP;
+	}
+
+	iodev->msg.buf = sqe->buf;
+	iodev->msg.len = sqe->buf_len;
+
+	err = i2c_transfer_cb(iodev->bus, &iodev->msg, 1, iodev->addr,
+			      i2c_iodev_complete, iodev);
+	if (err < 0) {
+		i2c_iodev_complete(iodev->bus, err, iodev);
+	}
+}
+
+const struct rtio_iodev_api i2c_iodev_api = {
+	.submit = i2c_iodev_submit,
+};
@@ -76,6 +76,15 @@ struct stream {
 	bool last_block;
 	struct k_msgq in_queue;
 	struct k_msgq out_queue;
+#ifdef CONFIG_I2S_STREAM
+	struct i2s_stream_config periods;
+	uint32_t period_count;
+	/* Next period to complete */
+	uint32_t period_done;
+	/* Next period to load to the DMA */
+	uint32_t period_load;
+	bool periodic;
+#endif
 };
 
 struct i2s_mcux_config {
@@ -914,6 +923,247 @@ static int i2s_rx_stream_start(const struct device *dev)
 	return 0;
 }
 
+#ifdef CONFIG_I2S_STREAM
+static void *i2s_period_get(struct stream *strm, uint32_t idx)
+{
+	return (uint8_t *)strm->periods.buffer +
+	       idx * strm->periods.period_size;
+}
+
+/* Load the next period of the buffer to the DMA */
+static int i2s_period_load(const struct device *dev, struct stream *strm)
+{
+	struct i2s_dev_data *dev_data = dev->data;
+	const struct i2s_mcux_config *dev_cfg = dev->config;
+	I2S_Type *base = (I2S_Type *)dev_cfg->base;
+	uint32_t period = (uint32_t)i2s_period_get(strm, strm->period_load);
+	int ret;
+
+	if (strm == &dev_data->tx) {
+		ret = dma_reload(dev_data->dev_dma, strm->dma_channel, period,
+				 (uint32_t)&base->TDR[strm->start_channel],
+				 strm->periods.period_size);
+	} else {
+		ret = dma_reload(dev_data->dev_dma, strm->dma_channel,
+				 (uint32_t)&base->RDR[strm->start_channel],
+				 period, strm->periods.period_size);
+	}
+
+	strm->period_load = (strm->period_load + 1) % strm->period_count;
+
+	return ret;
+}
+
+static void i2s_dma_period_callback(const struct device *dma_dev,
+				    void *arg, uint32_t channel, int status)
+{
+	const struct device *dev = (struct device *)arg;
+	struct i2s_dev_data *dev_data = dev->data;
+	bool tx = (channel == dev_data->tx.dma_channel);
+	struct stream *strm = tx ? &dev_data->tx : &dev_data->rx;
+	uint32_t timestamp = k_cycle_get_32();
+	uint32_t idx = strm->period_done;
+	int ret;
+
+	if (strm->state != I2S_STATE_RUNNING) {
+		return;
+	}
+
+	if (status < 0) {
+		LOG_ERR("DMA error %d on channel %u", status, channel);
+		goto error;
+	}
+
+	strm->period_done = (idx + 1) % strm->period_count;
+	strm->periods.callback(dev, tx ? I2S_DIR_TX : I2S_DIR_RX,
+			       i2s_period_get(strm, idx),
+			       strm->periods.period_size, timestamp,
+			       strm->periods.user_data);
+
+	/* The callback may have stopped the stream */
+	if (strm->state != I2S_STATE_RUNNING) {
+		return;
+	}
+
+	/*
+	 * The completed period is loaded again once the periods queued
+	 * before it are transferred.
+	 */
+	ret = i2s_period_load(dev, strm);
+	if (ret != 0) {
+		LOG_ERR("dma_reload() failed with error 0x%x", ret);
+		goto error;
+	}
+
+	ret = dma_start(dev_data->dev_dma, strm->dma_channel);
+	if (ret < 0) {
+		LOG_ERR("dma_start failed (%d)", ret);
+		goto error;
+	}
+
+	return;
+
+error:
+	strm->state = I2S_STATE_ERROR;
+	if (tx) {
+		i2s_tx_stream_disable(dev, false);
+	} else {
+		i2s_rx_stream_disable(dev, false, false);
+	}
+}
+
+static int i2s_mcux_stream_start(const struct device *dev, enum i2s_dir dir,
+				 const struct i2s_stream_config *config)
+{
+	struct i2s_dev_data *dev_data = dev->data;
+	const struct device *dev_dma = dev_data->dev_dma;
+	const struct i2s_mcux_config *dev_cfg = dev->config;
+	I2S_Type *base = (I2S_Type *)dev_cfg->base;
+	struct dma_block_config *blk_cfg;
+	struct stream *strm;
+	unsigned int key;
+	int ret = 0;
+
+	if (dir == I2S_DIR_BOTH) {
+		return -ENOSYS;
+	}
+
+	/*
+	 * As many periods as DMA blocks prepared for RX are kept loaded, so
+	 * that the eDMA TCD coherency issue is avoided.
+	 */
+	if (config->callback == NULL || config->buffer == NULL ||
+	    config->period_size == 0 ||
+	    (config->buffer_size % config->period_size) != 0 ||
+	    (config->buffer_size / config->period_size) <
+	    NUM_DMA_BLOCKS_RX_PREP) {
+		return -EINVAL;
+	}
+
+	strm = (dir == I2S_DIR_TX) ? &dev_data->tx : &dev_data->rx;
+
+	key = irq_lock();
+	if (strm->state == I2S_STATE_RUNNING ||
+	    strm->state == I2S_STATE_STOPPING) {
+		ret = -EBUSY;
+		goto out;
+	}
+
+	if (strm->state != I2S_STATE_READY) {
+		LOG_ERR("stream start: invalid state %d", strm->state);
+		ret = -EIO;
+		goto out;
+	}
+
+	strm->periods = *config;
+	strm->period_count = config->buffer_size / config->period_size;
+	strm->period_done = 0;
+	strm->period_load = 0;
+
+	/* Configure the DMA with the first period */
+	blk_cfg = &strm->dma_block;
+	memset(blk_cfg, 0, sizeof(struct dma_block_config));
+
+	if (dir == I2S_DIR_TX) {
+		blk_cfg->dest_address =
+			(uint32_t)&base->TDR[strm->start_channel];
+		blk_cfg->source_address = (uint32_t)config->buffer;
+		blk_cfg->dest_scatter_en = 1;
+	} else {
+		blk_cfg->dest_address = (uint32_t)config->buffer;
+		blk_cfg->source_address =
+			(uint32_t)&base->RDR[strm->start_channel];
+		blk_cfg->source_gather_en = 1;
+	}
+	blk_cfg->block_size = config->period_size;
+
+	strm->dma_cfg.block_count = 1;
+	strm->dma_cfg.head_block = &strm->dma_block;
+	strm->dma_cfg.user_data = (void *)dev;
+	strm->dma_cfg.dma_callback = i2s_dma_period_callback;
+
+	ret = dma_config(dev_dma, strm->dma_channel, &strm->dma_cfg);
+	if (ret < 0) {
+		LOG_ERR("dma_config failed (%d)", ret);
+		goto restore;
+	}
+
+	strm->period_load = 1;
+	for (int i = 0; i < NUM_DMA_BLOCKS_RX_PREP - 1; i++) {
+		ret = i2s_period_load(dev, strm);
+		if (ret != 0) {
+			LOG_ERR("dma_reload() failed with error 0x%x", ret);
+			goto restore;
+		}
+	}
+
+	ret = dma_start(dev_dma, strm->dma_channel);
+	if (ret < 0) {
+		LOG_ERR("dma_start failed (%d)", ret);
+		goto restore;
+	}
+
+	strm->periodic = true;
+	strm->state = I2S_STATE_RUNNING;
+
+	if (dir == I2S_DIR_TX) {
+		SAI_TxEnableDMA(base, kSAI_FIFORequestDMAEnable, true);
+		base->TCR3 |= I2S_TCR3_TCE(1UL << strm->start_channel);
+		SAI_TxEnable(base, true);
+	} else {
+		SAI_RxEnableDMA(base, kSAI_FIFORequestDMAEnable, true);
+		base->RCR3 |= I2S_RCR3_RCE(1UL << strm->start_channel);
+		SAI_RxEnable(base, true);
+	}
+
+	goto out;
+
+restore:
+	strm->dma_cfg.dma_callback = (dir == I2S_DIR_TX) ?
+				     i2s_dma_tx_callback : i2s_dma_rx_callback;
+	ret = -EIO;
+out:
+	irq_unlock(key);
+	return ret;
+}
+
+static int i2s_mcux_stream_stop(const struct device *dev, enum i2s_dir dir)
+{
+	struct i2s_dev_data *dev_data = dev->data;
+	struct stream *strm;
+	unsigned int key;
+
+	if (dir == I2S_DIR_BOTH) {
+		return -ENOSYS;
+	}
+
+	strm = (dir == I2S_DIR_TX) ? &dev_data->tx : &dev_data->rx;
+
+	key = irq_lock();
+	if (!strm->periodic) {
+		irq_unlock(key);
+		return -EALREADY;
+	}
+
+	/* A stream stopped on error is already disabled */
+	if (strm->state == I2S_STATE_RUNNING) {
+		if (dir == I2S_DIR_TX) {
+			i2s_tx_stream_disable(dev, false);
+		} else {
+			i2s_rx_stream_disable(dev, false, false);
+		}
+	}
+
+	strm->periodic = false;
+	strm->dma_cfg.dma_callback = (dir == I2S_DIR_TX) ?
+				     i2s_dma_tx_callback : i2s_dma_rx_callback;
+	strm->state = I2S_STATE_READY;
+	irq_unlock(key);
+
+	return 0;
+}
+#endif /* CONFIG_I2S_STREAM */
+
 static int i2s_mcux_trigger(const struct device *dev, enum i2s_dir dir,
 			    enum i2s_trigger_cmd cmd)
 {
@@ -929,6 +1179,13 @@ static int i2s_mcux_trigger(const struct device *dev, enum i2s_dir dir,
 	strm = (dir == I2S_DIR_TX) ? &dev_data->tx : &dev_data->rx;
 
 	key = irq_lock();
+#ifdef CONFIG_I2S_STREAM
+	if (strm->periodic) {
+		LOG_ERR("trigger: period stream running");
+		irq_unlock(key);
+		return -EIO;
+	}
+#endif
 	switch (cmd) {
 	case I2S_TRIGGER_START:
 		if (strm->state != I2S_STATE_READY) {
@@ -1055,6 +1312,12 @@ static int i2s_mcux_write(const struct device *dev, void *mem_block,
 	int ret;
 
 	LOG_DBG("i2s_mcux_write");
+#ifdef CONFIG_I2S_STREAM
+	if (strm->periodic) {
+		LOG_ERR("period stream running");
+		return -EIO;
+	}
+#endif
 	if (strm->state != I2S_STATE_RUNNING &&
 	    strm->state != I2S_STATE_READY) {
 		LOG_ERR("invalid state (%d)", strm->state);
@@ -1232,6 +1495,10 @@ static const struct i2s_driver_api i2s_mcux_driver_api = {
 	.write = i2s_mcux_write,
 	.config_get = i2s_mcux_config_get,
 	.trigger = i2s_mcux_trigger,
+#ifdef CONFIG_I2S_STREAM
+	.stream_start = i2s_mcux_stream_start,
+	.stream_stop = i2s_mcux_stream_stop,
+#endif
 };
 
 #ifdef CONFIG_PINCTRL
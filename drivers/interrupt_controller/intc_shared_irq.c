@@ -29,11 +29,14 @@ struct shared_irq_config {
 struct shared_irq_client {
 	const struct device *isr_dev;
 	isr_t isr_func;
-	uint32_t enabled;
 };
 
 struct shared_irq_runtime {
 	struct shared_irq_client *const client;
+	/* Bit i is set when client i is enabled, so the ISR only visits
+	 * enabled clients.
+	 */
+	atomic_t enabled;
 };
 
 /**
@@ -73,7 +76,7 @@ static inline int enable(const struct device *dev,
 
 	for (i = 0U; i < config->client_count; i++) {
 		if (clients->client[i].isr_dev == isr_dev) {
-			clients->client[i].enabled = 1U;
+			(void)atomic_or(&clients->enabled, BIT(i));
 			irq_enable(config->irq_num);
 			return 0;
 		}
@@ -81,17 +84,6 @@ static inline int enable(const struct device *dev,
 	return -EIO;
 }
 
-static int last_enabled_isr(struct shared_irq_runtime *clients, int count)
-{
-	uint32_t i;
-
-	for (i = 0U; i < count; i++) {
-		if (clients->client[i].enabled) {
-			return 0;
-		}
-	}
-	return 1;
-}
 /**
  *  @brief Disable ISR for device
  *  @param dev Pointer to device structure for SHARED_IRQ driver instance.
@@ -106,8 +98,8 @@ static inline int disable(const struct device *dev,
 
 	for (i = 0U; i < config->client_count; i++) {
 		if (clients->client[i].isr_dev == isr_dev) {
-			clients->client[i].enabled = 0U;
-			if (last_enabled_isr(clients, config->client_count)) {
+			if (atomic_and(&clients->enabled, ~BIT(i)) == BIT(i)) {
+				/* That was the last enabled client */
 				irq_disable(config->irq_num);
 			}
 			return 0;
@@ -119,13 +111,13 @@ static inline int disable(const struct device *dev,
 void shared_irq_isr(const struct device *dev)
 {
 	struct shared_irq_runtime *clients = dev->data;
-	const struct shared_irq_config *config = dev->config;
+	uint32_t enabled = (uint32_t)atomic_get(&clients->enabled);
 	uint32_t i;
 
-	for (i = 0U; i < config->client_count; i++) {
-		if (clients->client[i].isr_dev) {
-			clients->client[i].isr_func(clients->client[i].isr_dev);
-		}
+	while (enabled != 0U) {
+		i = find_lsb_set(enabled) - 1;
+		enabled &= enabled - 1U;
+		clients->client[i].isr_func(clients->client[i].isr_dev);
 	}
 }
 
@@ -165,6 +157,8 @@ void shared_irq_config_func_##n(void)					\
 }
 
 #define SHARED_IRQ_INIT(n)						\
+	BUILD_ASSERT(INST_SUPPORTS_DEP_ORDS_CNT(n) <= 32,		\
+		     "at most 32 clients per shared IRQ");		\
 	SHARED_IRQ_CONFIG_FUNC(n)					\
 	struct shared_irq_client clients_##n[INST_SUPPORTS_DEP_ORDS_CNT(n)]; \
 	struct shared_irq_runtime shared_irq_data_##n = {		\
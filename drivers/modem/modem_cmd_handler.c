@@ -48,24 +48,23 @@ static void skipcrlf(struct modem_cmd_handler_data *data)
 static uint16_t findcrlf(struct modem_cmd_handler_data *data,
 		      struct net_buf **frag, uint16_t *offset)
 {
-	struct net_buf *buf = data->rx_buf;
-	uint16_t len = 0U, pos = 0U;
-
-	while (buf && buf->len && !is_crlf(*(buf->data + pos))) {
-		if (pos + 1 >= buf->len) {
-			len += buf->len;
-			buf = buf->frags;
-			pos = 0U;
-		} else {
-			pos++;
+	struct net_buf *buf;
+	uint16_t len = 0U, pos;
+
+	/* scan each fragment in a tight loop, lines of socket data can be
+	 * long
+	 */
+	for (buf = data->rx_buf; buf && buf->len; buf = buf->frags) {
+		for (pos = 0U; pos < buf->len; pos++) {
+			if (is_crlf(buf->data[pos])) {
+				len += pos;
+				*offset = pos;
+				*frag = buf;
+				return len;
+			}
 		}
-	}
 
-	if (buf && buf->len && is_crlf(*(buf->data + pos))) {
-		len += pos;
-		*offset = pos;
-		*frag = buf;
-		return len;
+		len += buf->len;
 	}
 
 	return 0;
@@ -111,7 +110,7 @@ static int parse_params(struct modem_cmd_handler_data *data,  size_t match_len,
 			uint8_t **argv, size_t argv_len, uint16_t *argc)
 {
 	int count = 0;
-	size_t begin, end, i;
+	size_t begin, end;
 
 	if (!data || !data->match_buf || !match_len || !cmd || !argv || !argc) {
 		return -EINVAL;
@@ -120,18 +119,17 @@ static int parse_params(struct modem_cmd_handler_data *data,  size_t match_len,
 	begin = cmd->cmd_len;
 	end = cmd->cmd_len;
 	while (end < match_len) {
-		for (i = 0; i < strlen(cmd->delim); i++) {
-			if (data->match_buf[end] == cmd->delim[i]) {
-				/* mark a parameter beginning */
-				argv[*argc] = &data->match_buf[begin];
-				/* end parameter with NUL char */
-				data->match_buf[end] = '\0';
-				/* bump begin */
-				begin = end + 1;
-				count += 1;
-				(*argc)++;
-				break;
-			}
+		/* strchr() would match the NUL ending the delimiters */
+		if (data->match_buf[end] != '\0' &&
+		    strchr(cmd->delim, data->match_buf[end])) {
+			/* mark a parameter beginning */
+			argv[*argc] = &data->match_buf[begin];
+			/* end parameter with NUL char */
+			data->match_buf[end] = '\0';
+			/* bump begin */
+			begin = end + 1;
+			count += 1;
+			(*argc)++;
 		}
 
 		if (count >= cmd->arg_count_max) {
@@ -224,8 +222,7 @@ static int process_cmd(const struct modem_cmd *cmd, size_t match_len,
 static const struct modem_cmd *find_cmd_match(
 		struct modem_cmd_handler_data *data)
 {
-	int j;
-	size_t i;
+	size_t i, j;
 
 	for (j = 0; j < ARRAY_SIZE(data->cmds); j++) {
 		if (!data->cmds[j] || data->cmds_len[j] == 0U) {
@@ -233,11 +230,17 @@ static const struct modem_cmd *find_cmd_match(
 		}
 
 		for (i = 0; i < data->cmds_len[j]; i++) {
-			/* match on "empty" cmd */
-			if (strlen(data->cmds[j][i].cmd) == 0 ||
-			    strncmp(data->match_buf, data->cmds[j][i].cmd,
-				    data->cmds[j][i].cmd_len) == 0) {
-				return &data->cmds[j][i];
+			const struct modem_cmd *cmd = &data->cmds[j][i];
+
+			/* match on "empty" cmd, compare the first character
+			 * before the whole prefix as most commands differ
+			 * there
+			 */
+			if (cmd->cmd_len == 0U ||
+			    (data->match_buf[0] == cmd->cmd[0] &&
+			     strncmp(data->match_buf, cmd->cmd,
+				     cmd->cmd_len) == 0)) {
+				return cmd;
 			}
 		}
 	}
@@ -581,7 +584,7 @@ int modem_cmd_handler_setup_cmds(struct modem_iface *iface,
 					     sem, timeout);
 		}
 
-		k_sleep(K_MSEC(50));
+		k_sleep(K_MSEC(CONFIG_MODEM_CMD_HANDLER_SETUP_CMD_DELAY));
 
 		if (ret < 0) {
 			LOG_ERR("command %s ret:%d",
@@ -616,7 +619,7 @@ int modem_cmd_handler_setup_cmds_nolock(struct modem_iface *iface,
 						    sem, timeout);
 		}
 
-		k_sleep(K_MSEC(50));
+		k_sleep(K_MSEC(CONFIG_MODEM_CMD_HANDLER_SETUP_CMD_DELAY));
 
 		if (ret < 0) {
 			LOG_ERR("command %s ret:%d",
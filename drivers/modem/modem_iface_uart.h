@@ -15,6 +15,10 @@
 
 #include <zephyr/kernel.h>
 
+#ifdef CONFIG_MODEM_IFACE_UART_ASYNC
+#include <zephyr/drivers/uart/uart_async_rx.h>
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -38,6 +42,9 @@ struct modem_iface_uart_data {
 	/* tx semaphore */
 	struct k_sem tx_sem;
 
+	/* rx buffers, using the ring buffer char buffer */
+	struct uart_async_rx async_rx;
+
 #endif /* CONFIG_MODEM_IFACE_UART_ASYNC */
 };
 
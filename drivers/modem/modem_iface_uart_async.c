@@ -8,56 +8,30 @@
 #include <zephyr/logging/log.h>
 #include <zephyr/kernel.h>
 #include <zephyr/drivers/uart.h>
+#include <zephyr/drivers/uart/uart_async_rx.h>
 
 #include "modem_context.h"
 #include "modem_iface_uart.h"
 
 LOG_MODULE_REGISTER(modem_iface_uart_async, CONFIG_MODEM_LOG_LEVEL);
 
-#define RX_BUFFER_SIZE CONFIG_MODEM_IFACE_UART_ASYNC_RX_BUFFER_SIZE
 #define RX_BUFFER_NUM CONFIG_MODEM_IFACE_UART_ASYNC_RX_NUM_BUFFERS
 
-K_MEM_SLAB_DEFINE(uart_modem_async_rx_slab, RX_BUFFER_SIZE, RX_BUFFER_NUM, 1);
-
 static void iface_uart_async_callback(const struct device *dev,
 				      struct uart_event *evt,
 				      void *user_data)
 {
 	struct modem_iface *iface = user_data;
 	struct modem_iface_uart_data *data = iface->iface_data;
-	uint32_t written;
-	void *buf;
-	int rc;
+
+	/* Received data stays in the RX buffers until it is read */
+	uart_async_rx_on_event(&data->async_rx, evt);
 
 	switch (evt->type) {
 	case UART_TX_DONE:
 		k_sem_give(&data->tx_sem);
 		break;
-	case UART_RX_BUF_REQUEST:
-		/* Allocate next RX buffer for UART driver */
-		rc = k_mem_slab_alloc(&uart_modem_async_rx_slab, (void **)&buf, K_NO_WAIT);
-		if (rc < 0) {
-			/* Major problems, UART_RX_BUF_RELEASED event is not being generated, or
-			 * CONFIG_MODEM_IFACE_UART_ASYNC_RX_NUM_BUFFERS is not large enough.
-			 */
-			LOG_ERR("RX buffer starvation");
-			break;
-		}
-		/* Provide the buffer to the UART driver */
-		uart_rx_buf_rsp(dev, buf, RX_BUFFER_SIZE);
-		break;
-	case UART_RX_BUF_RELEASED:
-		/* UART driver is done with memory, free it */
-		k_mem_slab_free(&uart_modem_async_rx_slab, (void **)&evt->data.rx_buf.buf);
-		break;
 	case UART_RX_RDY:
-		/* Place received data on the ring buffer */
-		written = ring_buf_put(&data->rx_rb,
-				       evt->data.rx.buf + evt->data.rx.offset,
-				       evt->data.rx.len);
-		if (written != evt->data.rx.len) {
-			LOG_WRN("Received bytes dropped from ring buf");
-		}
 		/* Notify upper layer that new data has arrived */
 		k_sem_give(&data->rx_sem);
 		break;
@@ -70,19 +44,28 @@ static int modem_iface_uart_async_read(struct modem_iface *iface,
 				       uint8_t *buf, size_t size, size_t *bytes_read)
 {
 	struct modem_iface_uart_data *data;
+	uint8_t *src;
+	size_t len;
 
 	if (!iface || !iface->iface_data) {
 		return -EINVAL;
 	}
 
-	if (size == 0) {
-		*bytes_read = 0;
-		return 0;
-	}
+	*bytes_read = 0;
 
-	/* Pull data off the ring buffer */
+	/* Copy data straight out of the RX buffers */
 	data = iface->iface_data;
-	*bytes_read = ring_buf_get(&data->rx_rb, buf, size);
+	while (*bytes_read < size) {
+		len = uart_async_rx_data_claim(&data->async_rx, &src, size - *bytes_read);
+		if (len == 0) {
+			break;
+		}
+
+		memcpy(buf + *bytes_read, src, len);
+		uart_async_rx_data_consume(&data->async_rx, len);
+		*bytes_read += len;
+	}
+
 	return 0;
 }
 
@@ -114,24 +97,39 @@ int modem_iface_uart_init_dev(struct modem_iface *iface,
 			      const struct device *dev)
 {
 	struct modem_iface_uart_data *data;
-	void *buf;
+	struct uart_async_rx_config config;
 	int rc;
 
 	if (!device_is_ready(dev)) {
 		return -ENODEV;
 	}
 
+	data = iface->iface_data;
+
 	/* Check if there's already a device inited to this iface. If so,
 	 * interrupts needs to be disabled on that too before switching to avoid
 	 * race conditions with modem_iface_uart_isr.
 	 */
 	if (iface->dev) {
 		LOG_WRN("Device %s already inited", iface->dev->name);
-		uart_rx_disable(iface->dev);
+		uart_async_rx_disable(&data->async_rx);
 	}
 
 	iface->dev = dev;
-	data = iface->iface_data;
+
+	/* The RX buffers handed over to the UART driver are carved out of the
+	 * memory of the interface ring buffer.
+	 */
+	config.buffer = (uint8_t *)data->rx_rb_buf;
+	config.length = data->rx_rb_buf_len;
+	config.buf_cnt = RX_BUFFER_NUM;
+	config.timeout = CONFIG_MODEM_IFACE_UART_ASYNC_RX_TIMEOUT_US;
+
+	rc = uart_async_rx_init(&data->async_rx, dev, &config);
+	if (rc < 0) {
+		LOG_ERR("RX buffer too small");
+		return rc;
+	}
 
 	/* Configure async UART callback */
 	rc = uart_callback_set(dev, iface_uart_async_callback, iface);
@@ -140,8 +138,7 @@ int modem_iface_uart_init_dev(struct modem_iface *iface,
 		return rc;
 	}
 	/* Enable reception permanently on the interface */
-	k_mem_slab_alloc(&uart_modem_async_rx_slab, (void **)&buf, K_FOREVER);
-	rc = uart_rx_enable(dev, buf, RX_BUFFER_SIZE, CONFIG_MODEM_IFACE_UART_ASYNC_RX_TIMEOUT_US);
+	rc = uart_async_rx_enable(&data->async_rx);
 	if (rc < 0) {
 		LOG_ERR("Failed to enable UART RX");
 	}
@@ -162,7 +159,6 @@ int modem_iface_uart_init(struct modem_iface *iface,
 	iface->read = modem_iface_uart_async_read;
 	iface->write = modem_iface_uart_async_write;
 
-	ring_buf_init(&data->rx_rb, data->rx_rb_buf_len, data->rx_rb_buf);
 	k_sem_init(&data->rx_sem, 0, 1);
 	k_sem_init(&data->tx_sem, 0, 1);
 
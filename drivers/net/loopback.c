@@ -118,8 +118,15 @@ static int loopback_send(const struct device *dev, struct net_pkt *pkt)
 	 * properly sent (which is always in this driver), then the packet
 	 * must be dropped. This is very much needed for TCP packets where
 	 * the packet is reference counted in various stages of sending.
+	 * The received packet references the sent data instead of copying
+	 * it whenever the buffer pools allow it.
 	 */
-	cloned = net_pkt_rx_clone(pkt, K_MSEC(100));
+	cloned = net_pkt_rx_clone_shared(pkt, K_MSEC(100));
+	if (!cloned) {
+		/* The data of fixed size buffers cannot be shared */
+		cloned = net_pkt_rx_clone(pkt, K_MSEC(100));
+	}
+
 	if (!cloned) {
 		res = -ENOMEM;
 		goto out;
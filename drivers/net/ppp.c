@@ -22,6 +22,7 @@ LOG_MODULE_REGISTER(net_ppp, LOG_LEVEL);
 #include <stdbool.h>
 #include <errno.h>
 #include <stddef.h>
+#include <string.h>
 #include <zephyr/net/ppp.h>
 #include <zephyr/net/buf.h>
 #include <zephyr/net/net_pkt.h>
@@ -29,6 +30,7 @@ LOG_MODULE_REGISTER(net_ppp, LOG_LEVEL);
 #include <zephyr/net/net_core.h>
 #include <zephyr/sys/ring_buffer.h>
 #include <zephyr/sys/crc.h>
+#include <zephyr/sys/byteorder.h>
 #include <zephyr/drivers/uart.h>
 #include <zephyr/drivers/console/uart_mux.h>
 #include <zephyr/random/rand32.h>
@@ -60,6 +62,9 @@ struct ppp_driver_context {
 	/* How much free space we have in the net_pkt */
 	size_t available;
 
+	/* FCS of the bytes saved in the net_pkt */
+	uint16_t rx_fcs;
+
 	/* ppp data is read into this buf */
 	uint8_t buf[UART_BUF_LEN];
 #if defined(CONFIG_NET_PPP_ASYNC_UART)
@@ -253,7 +258,8 @@ static void uart_recovery(struct k_work *work)
 }
 #endif
 
-static int ppp_save_byte(struct ppp_driver_context *ppp, uint8_t byte)
+static int ppp_save_data(struct ppp_driver_context *ppp, const uint8_t *data,
+			 size_t len)
 {
 	int ret;
 
@@ -270,39 +276,51 @@ static int ppp_save_byte(struct ppp_driver_context *ppp, uint8_t byte)
 		net_pkt_cursor_init(ppp->pkt);
 
 		ppp->available = net_pkt_available_buffer(ppp->pkt);
+		ppp->rx_fcs = 0xffff;
 	}
 
 	/* Extra debugging can be enabled separately if really
 	 * needed. Normally it would just print too much data.
 	 */
 	if (0) {
-		LOG_DBG("Saving byte %02x", byte);
+		LOG_HEXDUMP_DBG(data, len, "Saving");
 	}
 
-	/* This is not very intuitive but we must allocate new buffer
-	 * before we write a byte to last available cursor position.
-	 */
-	if (ppp->available == 1) {
-		ret = net_pkt_alloc_buffer(ppp->pkt,
-					   CONFIG_NET_BUF_DATA_SIZE,
-					   AF_UNSPEC, K_NO_WAIT);
-		if (ret < 0) {
-			LOG_ERR("[%p] cannot allocate new data buffer", ppp);
-			goto out_of_mem;
+	if (IS_ENABLED(CONFIG_NET_PPP_VERIFY_FCS)) {
+		ppp->rx_fcs = crc16_ccitt(ppp->rx_fcs, data, len);
+	}
+
+	while (len > 0) {
+		size_t chunk;
+
+		/* This is not very intuitive but we must allocate new buffer
+		 * before we write a byte to last available cursor position.
+		 */
+		if (ppp->available <= 1) {
+			ret = net_pkt_alloc_buffer(ppp->pkt,
+						   CONFIG_NET_BUF_DATA_SIZE,
+						   AF_UNSPEC, K_NO_WAIT);
+			if (ret < 0) {
+				LOG_ERR("[%p] cannot allocate new data buffer",
+					ppp);
+				goto out_of_mem;
+			}
+
+			ppp->available = net_pkt_available_buffer(ppp->pkt);
 		}
 
-		ppp->available = net_pkt_available_buffer(ppp->pkt);
-	}
+		chunk = MIN(len, ppp->available - 1);
 
-	if (ppp->available) {
-		ret = net_pkt_write_u8(ppp->pkt, byte);
+		ret = net_pkt_write(ppp->pkt, data, chunk);
 		if (ret < 0) {
 			LOG_ERR("[%p] Cannot write to pkt %p (%d)",
 				ppp, ppp->pkt, ret);
 			goto out_of_mem;
 		}
 
-		ppp->available--;
+		ppp->available -= chunk;
+		data += chunk;
+		len -= chunk;
 	}
 
 	return 0;
@@ -313,6 +331,11 @@ out_of_mem:
 	return -ENOMEM;
 }
 
+static int ppp_save_byte(struct ppp_driver_context *ppp, uint8_t byte)
+{
+	return ppp_save_data(ppp, &byte, 1);
+}
+
 static const char *ppp_driver_state_str(enum ppp_driver_state state)
 {
 #if (CONFIG_NET_PPP_LOG_LEVEL >= LOG_LEVEL_DBG)
@@ -389,10 +412,13 @@ static int ppp_send_flush(struct ppp_driver_context *ppp, int off)
 static int ppp_send_bytes(struct ppp_driver_context *ppp,
 			  const uint8_t *data, int len, int off)
 {
-	int i;
+	while (len > 0) {
+		int chunk = MIN(len, sizeof(ppp->send_buf) - off);
 
-	for (i = 0; i < len; i++) {
-		ppp->send_buf[off++] = data[i];
+		memcpy(&ppp->send_buf[off], data, chunk);
+		off += chunk;
+		data += chunk;
+		len -= chunk;
 
 		if (off >= sizeof(ppp->send_buf)) {
 			off = ppp_send_flush(ppp, off);
@@ -402,6 +428,51 @@ static int ppp_send_bytes(struct ppp_driver_context *ppp,
 	return off;
 }
 
+/* Bytes escaped when sent, RFC 1662 ch. 4.2: the flag and control escape
+ * bytes, and all the control characters as the async control character
+ * map is not negotiated.
+ */
+static const uint32_t ppp_escape_map[8] = {
+	[0] = 0xffffffff,
+	[0x7d >> 5] = BIT(0x7d & 0x1f) | BIT(0x7e & 0x1f),
+};
+
+static inline bool ppp_needs_escape(uint8_t byte)
+{
+	return ppp_escape_map[byte >> 5] & BIT(byte & 0x1f);
+}
+
+/* Send data escaping the bytes which need it. The bytes which do not are
+ * copied in runs.
+ */
+static int ppp_send_escaped(struct ppp_driver_context *ppp,
+			    const uint8_t *data, size_t len, int off)
+{
+	while (len > 0) {
+		uint8_t escaped[2];
+		size_t run = 0;
+
+		while (run < len && !ppp_needs_escape(data[run])) {
+			run++;
+		}
+
+		if (run > 0) {
+			off = ppp_send_bytes(ppp, data, run, off);
+			data += run;
+			len -= run;
+			continue;
+		}
+
+		escaped[0] = 0x7d;
+		escaped[1] = *data ^ 0x20;
+		off = ppp_send_bytes(ppp, escaped, sizeof(escaped), off);
+		data++;
+		len--;
+	}
+
+	return off;
+}
+
 #if defined(CONFIG_PPP_CLIENT_CLIENTSERVER)
 
 #define CLIENT "CLIENT"
@@ -528,25 +599,43 @@ static int ppp_input_byte(struct ppp_driver_context *ppp, uint8_t byte)
 	return ret;
 }
 
-static bool ppp_check_fcs(struct ppp_driver_context *ppp)
+/* Save the bytes of the frame being received up to the next flag or
+ * control escape byte at once, the other ones being handled by
+ * ppp_input_byte(). Returns the number of bytes consumed.
+ */
+static size_t ppp_input_run(struct ppp_driver_context *ppp,
+			    const uint8_t *data, size_t len)
 {
-	struct net_buf *buf;
-	uint16_t crc;
+	const uint8_t *end;
+	size_t run;
 
-	buf = ppp->pkt->buffer;
-	if (!buf) {
-		return false;
+	if (ppp->state != STATE_HDLC_FRAME_DATA || ppp->next_escaped) {
+		return 0;
 	}
 
-	crc = crc16_ccitt(0xffff, buf->data, buf->len);
+	end = memchr(data, 0x7e, len);
+	if (end) {
+		len = end - data;
+	}
 
-	buf = buf->frags;
+	end = memchr(data, 0x7d, len);
+	run = end ? end - data : len;
+	if (run == 0) {
+		return 0;
+	}
 
-	while (buf) {
-		crc = crc16_ccitt(crc, buf->data, buf->len);
-		buf = buf->frags;
+	if (ppp_save_data(ppp, data, run) < 0) {
+		ppp_change_state(ppp, STATE_HDLC_FRAME_START);
 	}
 
+	return run;
+}
+
+static bool ppp_check_fcs(struct ppp_driver_context *ppp)
+{
+	/* The FCS is computed while the bytes are saved */
+	uint16_t crc = ppp->rx_fcs;
+
 	if (crc != 0xf0b8) {
 		LOG_DBG("Invalid FCS (0x%x)", crc);
 #if defined(CONFIG_NET_STATISTICS_PPP)
@@ -610,9 +699,16 @@ static uint8_t *ppp_recv_cb(uint8_t *buf, size_t *off)
 {
 	struct ppp_driver_context *ppp =
 		CONTAINER_OF(buf, struct ppp_driver_context, buf);
-	size_t i, len = *off;
+	size_t i = 0, len = *off;
+	size_t run;
+
+	while (i < *off) {
+		run = ppp_input_run(ppp, &buf[i], *off - i);
+		if (run > 0) {
+			i += run;
+			continue;
+		}
 
-	for (i = 0; i < *off; i++) {
 		if (0) {
 			/* Extra debugging can be enabled separately if really
 			 * needed. Normally it would just print too much data.
@@ -627,6 +723,8 @@ static uint8_t *ppp_recv_cb(uint8_t *buf, size_t *off)
 				break;
 			}
 		}
+
+		i++;
 	}
 
 	if (i == *off) {
@@ -674,49 +772,6 @@ void ppp_driver_feed_data(uint8_t *data, int data_len)
 }
 #endif
 
-static bool calc_fcs(struct net_pkt *pkt, uint16_t *fcs, uint16_t protocol)
-{
-	struct net_buf *buf;
-	uint16_t crc;
-	uint16_t c;
-
-	buf = pkt->buffer;
-	if (!buf) {
-		return false;
-	}
-
-	/* HDLC Address and Control fields */
-	c = sys_cpu_to_be16(0xff << 8 | 0x03);
-
-	crc = crc16_ccitt(0xffff, (const uint8_t *)&c, sizeof(c));
-
-	if (protocol > 0) {
-		crc = crc16_ccitt(crc, (const uint8_t *)&protocol,
-				  sizeof(protocol));
-	}
-
-	while (buf) {
-		crc = crc16_ccitt(crc, buf->data, buf->len);
-		buf = buf->frags;
-	}
-
-	crc ^= 0xffff;
-	*fcs = crc;
-
-	return true;
-}
-
-static uint16_t ppp_escape_byte(uint8_t byte, int *offset)
-{
-	if (byte == 0x7e || byte == 0x7d || byte < 0x20) {
-		*offset = 0;
-		return (0x7d << 8) | (byte ^ 0x20);
-	}
-
-	*offset = 1;
-	return byte;
-}
-
 static int ppp_send(const struct device *dev, struct net_pkt *pkt)
 {
 	struct ppp_driver_context *ppp = dev->data;
@@ -724,9 +779,10 @@ static int ppp_send(const struct device *dev, struct net_pkt *pkt)
 	uint16_t protocol = 0;
 	int send_off = 0;
 	uint32_t sync_addr_ctrl;
-	uint16_t fcs, escaped;
+	uint16_t addr_ctrl;
+	uint16_t fcs;
+	uint8_t fcs_le[2];
 	uint8_t byte;
-	int i, offset;
 
 #if defined(CONFIG_NET_TEST)
 	return 0;
@@ -766,9 +822,10 @@ static int ppp_send(const struct device *dev, struct net_pkt *pkt)
 		}
 	}
 
-	if (!calc_fcs(pkt, &fcs, protocol)) {
-		return -ENOMEM;
-	}
+	/* The FCS is computed while the data is sent, as it comes last */
+	addr_ctrl = sys_cpu_to_be16(0xff << 8 | 0x03);
+	fcs = crc16_ccitt(0xffff, (const uint8_t *)&addr_ctrl,
+			  sizeof(addr_ctrl));
 
 	/* Sync, Address & Control fields */
 	sync_addr_ctrl = sys_cpu_to_be32(0x7e << 24 | 0xff << 16 |
@@ -777,15 +834,10 @@ static int ppp_send(const struct device *dev, struct net_pkt *pkt)
 				  sizeof(sync_addr_ctrl), send_off);
 
 	if (protocol > 0) {
-		escaped = htons(ppp_escape_byte(protocol, &offset));
-		send_off = ppp_send_bytes(ppp, (uint8_t *)&escaped + offset,
-					  offset ? 1 : 2,
-					  send_off);
-
-		escaped = htons(ppp_escape_byte(protocol >> 8, &offset));
-		send_off = ppp_send_bytes(ppp, (uint8_t *)&escaped + offset,
-					  offset ? 1 : 2,
-					  send_off);
+		fcs = crc16_ccitt(fcs, (const uint8_t *)&protocol,
+				  sizeof(protocol));
+		send_off = ppp_send_escaped(ppp, (const uint8_t *)&protocol,
+					    sizeof(protocol), send_off);
 	}
 
 	/* Note that we do not print the first four bytes and FCS bytes at the
@@ -797,27 +849,15 @@ static int ppp_send(const struct device *dev, struct net_pkt *pkt)
 	}
 
 	while (buf) {
-		for (i = 0; i < buf->len; i++) {
-			/* Escape illegal bytes */
-			escaped = htons(ppp_escape_byte(buf->data[i], &offset));
-			send_off = ppp_send_bytes(ppp,
-						  (uint8_t *)&escaped + offset,
-						  offset ? 1 : 2,
-						  send_off);
-		}
+		fcs = crc16_ccitt(fcs, buf->data, buf->len);
+		send_off = ppp_send_escaped(ppp, buf->data, buf->len, send_off);
 
 		buf = buf->frags;
 	}
 
-	escaped = htons(ppp_escape_byte(fcs, &offset));
-	send_off = ppp_send_bytes(ppp, (uint8_t *)&escaped + offset,
-				  offset ? 1 : 2,
-				  send_off);
-
-	escaped = htons(ppp_escape_byte(fcs >> 8, &offset));
-	send_off = ppp_send_bytes(ppp, (uint8_t *)&escaped + offset,
-				  offset ? 1 : 2,
-				  send_off);
+	fcs ^= 0xffff;
+	sys_put_le16(fcs, fcs_le);
+	send_off = ppp_send_escaped(ppp, fcs_le, sizeof(fcs_le), send_off);
 
 	byte = 0x7e;
 	send_off = ppp_send_bytes(ppp, &byte, 1, send_off);
@@ -831,7 +871,7 @@ static int ppp_send(const struct device *dev, struct net_pkt *pkt)
 static int ppp_consume_ringbuf(struct ppp_driver_context *ppp)
 {
 	uint8_t *data;
-	size_t len, tmp;
+	size_t len, tmp, run;
 	int ret;
 
 	len = ring_buf_get_claim(&ppp->rx_ringbuf, &data,
@@ -848,14 +888,23 @@ static int ppp_consume_ringbuf(struct ppp_driver_context *ppp)
 
 	tmp = len;
 
-	do {
+	while (tmp > 0) {
+		run = ppp_input_run(ppp, data, tmp);
+		if (run > 0) {
+			data += run;
+			tmp -= run;
+			continue;
+		}
+
 		if (ppp_input_byte(ppp, *data++) == 0) {
 			/* Ignore empty or too short frames */
 			if (ppp->pkt && net_pkt_get_len(ppp->pkt) > 3) {
 				ppp_process_msg(ppp);
 			}
 		}
-	} while (--tmp);
+
+		tmp--;
+	}
 
 	ret = ring_buf_get_finish(&ppp->rx_ringbuf, len);
 	if (ret < 0) {
@@ -326,6 +326,10 @@ static int adxl362_attr_set(const struct device *dev,
 
 		return adxl362_set_reg(dev, (timeout & 0x7FF), ADXL362_REG_TIME_INACT_L, 2);
 	}
+#if defined(CONFIG_ADXL362_STREAM)
+	case SENSOR_ATTR_FIFO_WATERMARK:
+		return adxl362_attr_set_watermark(dev, val);
+#endif
 	default:
 		/* Do nothing */
 		break;
@@ -351,22 +355,110 @@ static int adxl362_fifo_setup(const struct device *dev, uint8_t mode,
 	uint8_t write_val;
 	int ret;
 
+	/* The AH bit is the MSB of the 9-bit watermark level. */
 	write_val = ADXL362_FIFO_CTL_FIFO_MODE(mode) |
 		   (en_temp_read * ADXL362_FIFO_CTL_FIFO_TEMP) |
-		   ADXL362_FIFO_CTL_AH;
+		   ((water_mark_lvl > 0xFF) * ADXL362_FIFO_CTL_AH);
 	ret = adxl362_set_reg(dev, write_val, ADXL362_REG_FIFO_CTL, 1);
 	if (ret) {
 		return ret;
 	}
 
-	ret = adxl362_set_reg(dev, water_mark_lvl, ADXL362_REG_FIFO_SAMPLES, 1);
+	ret = adxl362_set_reg(dev, water_mark_lvl & 0xFF,
+			      ADXL362_REG_FIFO_SAMPLES, 1);
+	if (ret) {
+		return ret;
+	}
+
+	return 0;
+}
+
+#if defined(CONFIG_ADXL362_STREAM)
+int adxl362_fifo_entries_get(const struct device *dev, uint16_t *cnt)
+{
+	uint16_t buf;
+	int ret;
+
+	ret = adxl362_get_reg(dev, (uint8_t *)&buf, ADXL362_REG_FIFO_L, 2);
+	if (ret) {
+		return ret;
+	}
+
+	*cnt = sys_le16_to_cpu(buf) & 0x3FF;
+
+	return 0;
+}
+
+int adxl362_fifo_read(const struct device *dev, uint8_t *data, size_t length)
+{
+	const struct adxl362_config *cfg = dev->config;
+	uint8_t cmd = ADXL362_READ_FIFO;
+	const struct spi_buf buf[2] = {
+		{
+			.buf = &cmd,
+			.len = 1
+		},
+		{
+			.buf = data,
+			.len = length
+		}
+	};
+	const struct spi_buf_set tx = {
+		.buffers = buf,
+		.count = 1
+	};
+	const struct spi_buf_set rx = {
+		.buffers = buf,
+		.count = 2
+	};
+
+	return spi_transceive_dt(&cfg->bus, &tx, &rx);
+}
+
+int adxl362_fifo_watermark_set(const struct device *dev, uint16_t frames)
+{
+	struct adxl362_data *data = dev->data;
+	int ret;
+
+	/* Only X, Y and Z entries are stored, the temperature is not. */
+	ret = adxl362_fifo_setup(dev, ADXL362_FIFO_STREAM, frames * 3, 0);
 	if (ret) {
 		return ret;
 	}
 
+	data->fifo_watermark = frames;
+	data->fifo_enabled = true;
+
 	return 0;
 }
 
+static int adxl362_attr_set_watermark(const struct device *dev,
+				      const struct sensor_value *val)
+{
+	struct adxl362_data *data = dev->data;
+	const struct adxl362_config *config = dev->config;
+	int ret = 0;
+
+	if (!config->interrupt.port) {
+		return -ENOTSUP;
+	}
+
+	if (val->val1 < 1 || val->val1 > (ADXL362_FIFO_SIZE - 1) / 3) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&data->trigger_mutex, K_FOREVER);
+	if (data->fifo_enabled) {
+		ret = adxl362_fifo_watermark_set(dev, val->val1);
+	} else {
+		data->fifo_watermark = val->val1;
+	}
+	k_mutex_unlock(&data->trigger_mutex);
+
+	return ret;
+}
+#endif /* CONFIG_ADXL362_STREAM */
+
 static int adxl362_setup_activity_detection(const struct device *dev,
 					    uint8_t ref_or_abs,
 					    uint16_t threshold,
@@ -602,6 +694,10 @@ static const struct sensor_driver_api adxl362_api_funcs = {
 #ifdef CONFIG_ADXL362_TRIGGER
 	.trigger_set = adxl362_trigger_set,
 #endif
+#ifdef CONFIG_ADXL362_STREAM
+	.get_decoder = adxl362_get_decoder,
+	.stream_submit = adxl362_stream_submit,
+#endif
 };
 
 static int adxl362_chip_init(const struct device *dev)
@@ -732,6 +828,12 @@ static int adxl362_init(const struct device *dev)
 		return -ENODEV;
 	}
 
+#if defined(CONFIG_ADXL362_STREAM)
+	struct adxl362_data *data = dev->data;
+
+	data->fifo_watermark = CONFIG_ADXL362_STREAM_WATERMARK;
+#endif
+
 #if defined(CONFIG_ADXL362_TRIGGER)
 	if (config->interrupt.port) {
 		if (adxl362_init_interrupt(dev) < 0) {
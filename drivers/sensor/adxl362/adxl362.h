@@ -11,6 +11,7 @@
 #include <zephyr/device.h>
 #include <zephyr/drivers/gpio.h>
 #include <zephyr/drivers/spi.h>
+#include <zephyr/drivers/sensor.h>
 
 #define ADXL362_SLAVE_ID    1
 
@@ -18,6 +19,7 @@
 #define ADXL362_WRITE_REG           0x0A
 #define ADXL362_READ_REG            0x0B
 #define ADXL362_WRITE_FIFO          0x0D
+#define ADXL362_READ_FIFO           0x0D
 
 /* Registers */
 #define ADXL362_REG_DEVID_AD            0x00
@@ -166,6 +168,11 @@
 #define ADXL362_ACCEL_4G_LSB_PER_G	500
 #define ADXL362_ACCEL_8G_LSB_PER_G	235
 
+/* ADXL362 FIFO entries */
+#define ADXL362_FIFO_SIZE                   512
+#define ADXL362_FIFO_ENTRY_AXIS(x)          (((x) >> 14) & 0x3)
+#define ADXL362_FIFO_ENTRY_DATA(x)          ((int16_t)((x) << 2) >> 2)
+
 /* ADXL362 temperature sensor specifications */
 #define ADXL362_TEMP_MC_PER_LSB 65
 #define ADXL362_TEMP_BIAS_LSB 350
@@ -204,6 +211,13 @@ struct adxl362_data {
 	sensor_trigger_handler_t drdy_handler;
 	struct sensor_trigger drdy_trigger;
 
+#if defined(CONFIG_ADXL362_STREAM)
+	const struct rtio_sqe *stream_sqe;
+	struct rtio *stream_r;
+	uint16_t fifo_watermark;
+	bool fifo_enabled;
+#endif
+
 #if defined(CONFIG_ADXL362_TRIGGER_OWN_THREAD)
 	K_KERNEL_STACK_MEMBER(thread_stack, CONFIG_ADXL362_THREAD_STACK_SIZE);
 	struct k_sem gpio_sem;
@@ -257,4 +271,31 @@ int adxl362_set_interrupt_mode(const struct device *dev, uint8_t mode);
 int adxl362_clear_data_ready(const struct device *dev);
 #endif /* CONFIG_ADT7420_TRIGGER */
 
+#ifdef CONFIG_ADXL362_STREAM
+/* Header of the blocks of the sensor stream, followed by the FIFO entries
+ * as read from the sensor.
+ */
+struct adxl362_fifo_header {
+	uint8_t range;
+	uint8_t reserved;
+	uint16_t entry_cnt;
+} __packed;
+
+int adxl362_fifo_entries_get(const struct device *dev, uint16_t *cnt);
+
+int adxl362_fifo_read(const struct device *dev, uint8_t *buf, size_t len);
+
+int adxl362_fifo_watermark_set(const struct device *dev, uint16_t frames);
+
+void adxl362_trigger_kick(const struct device *dev);
+
+void adxl362_stream_fifo_handle(const struct device *dev);
+
+void adxl362_stream_submit(const struct device *dev,
+			   const struct rtio_sqe *sqe, struct rtio *r);
+
+int adxl362_get_decoder(const struct device *dev,
+			const struct sensor_decoder_api **decoder);
+#endif /* CONFIG_ADXL362_STREAM */
+
 #endif /* ZEPHYR_DRIVERS_SENSOR_ADXL362_ADXL362_H_ */
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/logging/log.h>
+
+#include "adxl362.h"
+
+LOG_MODULE_DECLARE(ADXL362, CONFIG_SENSOR_LOG_LEVEL);
+
+/* Value of one LSB in m/s^2, as a Q31 number scaled by 2^shift */
+#define ADXL362_LSB_Q31(lsb_per_g, shift) \
+	((int32_t)((SENSOR_G << (31 - (shift))) / ((lsb_per_g) * 1000000LL)))
+
+/* The shift of each range is the smallest one fitting the 12-bit samples. */
+static const struct {
+	int8_t shift;
+	int32_t lsb;
+} adxl362_accel_scale[] = {
+	[ADXL362_RANGE_2G] = { 5, ADXL362_LSB_Q31(ADXL362_ACCEL_2G_LSB_PER_G, 5) },
+	[ADXL362_RANGE_4G] = { 6, ADXL362_LSB_Q31(ADXL362_ACCEL_4G_LSB_PER_G, 6) },
+	[ADXL362_RANGE_8G] = { 7, ADXL362_LSB_Q31(ADXL362_ACCEL_8G_LSB_PER_G, 7) },
+};
+
+void adxl362_stream_fifo_handle(const struct device *dev)
+{
+	struct adxl362_data *data = dev->data;
+	const struct rtio_sqe *sqe = data->stream_sqe;
+	struct rtio *r = data->stream_r;
+	struct adxl362_fifo_header *hdr;
+	uint16_t max_cnt;
+	uint16_t cnt;
+	int ret;
+
+	if (sqe == NULL) {
+		return;
+	}
+
+	ret = adxl362_fifo_entries_get(dev, &cnt);
+	if (ret) {
+		goto error;
+	}
+
+	/* Only whole frames are read, so that every block starts with an X
+	 * entry.
+	 */
+	max_cnt = (sqe->buf_len - sizeof(*hdr)) / sizeof(uint16_t);
+	cnt = MIN(cnt, max_cnt);
+	cnt -= cnt % 3;
+	if (cnt == 0) {
+		return;
+	}
+
+	hdr = (struct adxl362_fifo_header *)sqe->buf;
+	ret = adxl362_fifo_read(dev, sqe->buf + sizeof(*hdr),
+				cnt * sizeof(uint16_t));
+	if (ret) {
+		goto error;
+	}
+
+	hdr->range = data->selected_range;
+	hdr->reserved = 0;
+	hdr->entry_cnt = sys_cpu_to_le16(cnt);
+
+	/* The completion may submit the next read right away. */
+	data->stream_sqe = NULL;
+	rtio_sqe_ok(r, sqe, sizeof(*hdr) + cnt * sizeof(uint16_t));
+
+	return;
+
+error:
+	LOG_ERR("Failed to read FIFO (err %d)", ret);
+	data->stream_sqe = NULL;
+	rtio_sqe_err(r, sqe, ret);
+}
+
+void adxl362_stream_submit(const struct device *dev,
+			   const struct rtio_sqe *sqe, struct rtio *r)
+{
+	struct adxl362_data *data = dev->data;
+	const struct adxl362_config *config = dev->config;
+	int ret = 0;
+
+	if (!config->interrupt.port) {
+		rtio_sqe_err(r, sqe, -ENOTSUP);
+		return;
+	}
+
+	if (sqe->buf_len <
+	    sizeof(struct adxl362_fifo_header) + 3 * sizeof(uint16_t)) {
+		rtio_sqe_err(r, sqe, -ENOMEM);
+		return;
+	}
+
+	k_mutex_lock(&data->trigger_mutex, K_FOREVER);
+	if (data->stream_sqe != NULL) {
+		ret = -EBUSY;
+	} else if (!data->fifo_enabled) {
+		ret = adxl362_fifo_watermark_set(dev, data->fifo_watermark);
+		if (ret == 0) {
+			ret = adxl362_reg_write_mask(dev, ADXL362_REG_INTMAP1,
+					ADXL362_INTMAP1_FIFO_WATERMARK,
+					ADXL362_INTMAP1_FIFO_WATERMARK);
+		}
+	}
+
+	if (ret == 0) {
+		data->stream_sqe = sqe;
+		data->stream_r = r;
+	}
+	k_mutex_unlock(&data->trigger_mutex);
+
+	if (ret < 0) {
+		rtio_sqe_err(r, sqe, ret);
+		return;
+	}
+
+	adxl362_trigger_kick(dev);
+}
+
+static int adxl362_decoder_get_frame_count(const uint8_t *buf, size_t len,
+					   uint16_t *frame_count)
+{
+	const struct adxl362_fifo_header *hdr =
+		(const struct adxl362_fifo_header *)buf;
+
+	if (len < sizeof(*hdr) ||
+	    len < sizeof(*hdr) + sys_le16_to_cpu(hdr->entry_cnt) * sizeof(uint16_t)) {
+		return -EINVAL;
+	}
+
+	*frame_count = sys_le16_to_cpu(hdr->entry_cnt) / 3;
+
+	return 0;
+}
+
+static int adxl362_decoder_decode(const uint8_t *buf, size_t len,
+				  enum sensor_channel chan,
+				  uint16_t first_frame, uint16_t max_count,
+				  int32_t *values, int8_t *shift)
+{
+	const struct adxl362_fifo_header *hdr =
+		(const struct adxl362_fifo_header *)buf;
+	const uint8_t *entries = buf + sizeof(*hdr);
+	uint16_t frame_count;
+	uint8_t axis_first;
+	uint8_t axis_cnt;
+	int32_t lsb;
+	int ret;
+
+	ret = adxl362_decoder_get_frame_count(buf, len, &frame_count);
+	if (ret) {
+		return ret;
+	}
+
+	if (hdr->range >= ARRAY_SIZE(adxl362_accel_scale)) {
+		return -EINVAL;
+	}
+
+	switch (chan) {
+	case SENSOR_CHAN_ACCEL_X:
+	case SENSOR_CHAN_ACCEL_Y:
+	case SENSOR_CHAN_ACCEL_Z:
+		axis_first = chan - SENSOR_CHAN_ACCEL_X;
+		axis_cnt = 1;
+		break;
+	case SENSOR_CHAN_ACCEL_XYZ:
+		axis_first = 0;
+		axis_cnt = 3;
+		break;
+	default:
+		return -ENOTSUP;
+	}
+
+	if (first_frame >= frame_count) {
+		return 0;
+	}
+
+	max_count = MIN(max_count, frame_count - first_frame);
+	lsb = adxl362_accel_scale[hdr->range].lsb;
+
+	for (uint16_t i = 0; i < max_count; i++) {
+		const uint8_t *frame = &entries[(first_frame + i) * 3 *
+						sizeof(uint16_t)];
+
+		for (uint8_t axis = axis_first; axis < axis_first + axis_cnt;
+		     axis++) {
+			uint16_t entry = sys_get_le16(&frame[axis *
+							    sizeof(uint16_t)]);
+
+			if (ADXL362_FIFO_ENTRY_AXIS(entry) != axis) {
+				return -EILSEQ;
+			}
+
+			*values++ = ADXL362_FIFO_ENTRY_DATA(entry) * lsb;
+		}
+	}
+
+	*shift = adxl362_accel_scale[hdr->range].shift;
+
+	return max_count;
+}
+
+static const struct sensor_decoder_api adxl362_decoder = {
+	.get_frame_count = adxl362_decoder_get_frame_count,
+	.decode = adxl362_decoder_decode,
+};
+
+int adxl362_get_decoder(const struct device *dev,
+			const struct sensor_decoder_api **decoder)
+{
+	ARG_UNUSED(dev);
+
+	*decoder = &adxl362_decoder;
+
+	return 0;
+}
@@ -45,6 +45,12 @@ static void adxl362_thread_cb(const struct device *dev)
 	    ADXL362_STATUS_CHECK_DATA_READY(status_buf)) {
 		drv_data->drdy_handler(dev, &drv_data->drdy_trigger);
 	}
+
+#if defined(CONFIG_ADXL362_STREAM)
+	if (status_buf & ADXL362_STATUS_FIFO_WATERMARK) {
+		adxl362_stream_fifo_handle(dev);
+	}
+#endif
 	k_mutex_unlock(&drv_data->trigger_mutex);
 }
 
@@ -79,6 +85,23 @@ static void adxl362_work_cb(struct k_work *work)
 }
 #endif
 
+#if defined(CONFIG_ADXL362_STREAM)
+/* Handle the status as if the interrupt fired, used when a stream read is
+ * submitted while the FIFO is already above its watermark: the interrupt
+ * line stays active then and no new edge is generated.
+ */
+void adxl362_trigger_kick(const struct device *dev)
+{
+	struct adxl362_data *drv_data = dev->data;
+
+#if defined(CONFIG_ADXL362_TRIGGER_OWN_THREAD)
+	k_sem_give(&drv_data->gpio_sem);
+#elif defined(CONFIG_ADXL362_TRIGGER_GLOBAL_THREAD)
+	k_work_submit(&drv_data->work);
+#endif
+}
+#endif /* CONFIG_ADXL362_STREAM */
+
 int adxl362_trigger_set(const struct device *dev,
 			const struct sensor_trigger *trig,
 			sensor_trigger_handler_t handler)
@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/rtio/rtio.h>
+
+static void sensor_stream_iodev_submit(const struct rtio_sqe *sqe,
+				       struct rtio *r)
+{
+	const struct sensor_stream_iodev *iodev =
+		(const struct sensor_stream_iodev *)sqe->iodev;
+	const struct sensor_driver_api *api =
+		(const struct sensor_driver_api *)iodev->sensor->api;
+
+	if (sqe->op != RTIO_OP_RX) {
+		rtio_sqe_err(r, sqe, -EINVAL);
+		return;
+	}
+
+	if (api->stream_submit == NULL) {
+		rtio_sqe_err(r, sqe, -ENOSYS);
+		return;
+	}
+
+	api->stream_submit(iodev->sensor, sqe, r);
+}
+
+const struct rtio_iodev_api sensor_stream_iodev_api = {
+	.submit = sensor_stream_iodev_submit,
+};
@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/uart/uart_async_rx.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(uart_async_rx, CONFIG_UART_LOG_LEVEL);
+
+static struct uart_async_rx_buf *get_buf(struct uart_async_rx *rx, uint8_t idx)
+{
+	size_t stride = rx->buf_len + UART_ASYNC_RX_BUF_OVERHEAD;
+
+	return (struct uart_async_rx_buf *)&rx->config.buffer[idx * stride];
+}
+
+static uint8_t next_idx(struct uart_async_rx *rx, uint8_t idx)
+{
+	return (idx + 1 == rx->config.buf_cnt) ? 0 : idx + 1;
+}
+
+/* Buffers are handed over to the driver in order, only called while the
+ * driver is requesting a buffer or reception is stopped.
+ */
+static uint8_t *buf_get(struct uart_async_rx *rx)
+{
+	struct uart_async_rx_buf *buf;
+
+	if (atomic_get(&rx->free_buf_cnt) == 0) {
+		return NULL;
+	}
+
+	buf = get_buf(rx, rx->drv_buf_idx);
+	rx->drv_buf_idx = next_idx(rx, rx->drv_buf_idx);
+	atomic_dec(&rx->free_buf_cnt);
+
+	return buf->data;
+}
+
+static void rx_restart(struct uart_async_rx *rx)
+{
+	struct uart_async_rx_buf *buf;
+	uint8_t *data;
+	int err;
+
+	/* Both the consumer freeing a buffer and the driver reporting that
+	 * reception stopped may restart it, only one of them does.
+	 */
+	while (!rx->disabled && atomic_cas(&rx->stopped, 1, 0)) {
+		data = buf_get(rx);
+		if (data != NULL) {
+			err = uart_rx_enable(rx->dev, data, rx->buf_len, rx->config.timeout);
+			if (err < 0) {
+				LOG_ERR("Failed to restart reception: %d", err);
+				buf = CONTAINER_OF(data, struct uart_async_rx_buf, data);
+				atomic_set(&buf->completed, 1);
+				atomic_set(&rx->stopped, 1);
+			}
+			return;
+		}
+
+		atomic_set(&rx->stopped, 1);
+
+		/* A buffer may have been freed before reception was marked as
+		 * stopped again.
+		 */
+		if (atomic_get(&rx->free_buf_cnt) == 0) {
+			return;
+		}
+	}
+}
+
+static void rd_buf_free(struct uart_async_rx *rx, struct uart_async_rx_buf *buf)
+{
+	atomic_set(&buf->wr_idx, 0);
+	atomic_set(&buf->completed, 0);
+
+	rx->rd_buf_idx = next_idx(rx, rx->rd_buf_idx);
+	rx->rd_idx = 0;
+	atomic_inc(&rx->free_buf_cnt);
+
+	rx_restart(rx);
+}
+
+int uart_async_rx_init(struct uart_async_rx *rx, const struct device *dev,
+		       const struct uart_async_rx_config *config)
+{
+	uint8_t *buffer = (uint8_t *)ROUND_UP((uintptr_t)config->buffer, sizeof(atomic_t));
+	size_t skip = buffer - config->buffer;
+	size_t stride;
+
+	if ((config->buf_cnt == 0) || (config->length < skip)) {
+		return -EINVAL;
+	}
+
+	stride = ROUND_DOWN((config->length - skip) / config->buf_cnt, sizeof(atomic_t));
+	if (stride <= UART_ASYNC_RX_BUF_OVERHEAD) {
+		return -EINVAL;
+	}
+
+	rx->dev = dev;
+	rx->config = *config;
+	rx->config.buffer = buffer;
+	rx->config.length -= skip;
+	rx->buf_len = stride - UART_ASYNC_RX_BUF_OVERHEAD;
+	atomic_set(&rx->pending_bytes, 0);
+	atomic_set(&rx->free_buf_cnt, config->buf_cnt);
+	atomic_set(&rx->stopped, 0);
+	rx->disabled = true;
+	rx->drv_buf_idx = 0;
+	rx->rd_buf_idx = 0;
+	rx->rd_idx = 0;
+
+	for (uint8_t i = 0; i < config->buf_cnt; i++) {
+		struct uart_async_rx_buf *buf = get_buf(rx, i);
+
+		atomic_set(&buf->wr_idx, 0);
+		atomic_set(&buf->completed, 0);
+	}
+
+	return 0;
+}
+
+int uart_async_rx_enable(struct uart_async_rx *rx)
+{
+	struct uart_async_rx_buf *buf;
+	uint8_t *data;
+	int err;
+
+	rx->disabled = false;
+
+	data = buf_get(rx);
+	if (data == NULL) {
+		atomic_set(&rx->stopped, 1);
+		return -ENOMEM;
+	}
+
+	err = uart_rx_enable(rx->dev, data, rx->buf_len, rx->config.timeout);
+	if (err < 0) {
+		rx->disabled = true;
+		buf = CONTAINER_OF(data, struct uart_async_rx_buf, data);
+		atomic_set(&buf->completed, 1);
+	}
+
+	return err;
+}
+
+int uart_async_rx_disable(struct uart_async_rx *rx)
+{
+	rx->disabled = true;
+	atomic_set(&rx->stopped, 0);
+
+	return uart_rx_disable(rx->dev);
+}
+
+void uart_async_rx_on_event(struct uart_async_rx *rx, const struct uart_event *evt)
+{
+	struct uart_async_rx_buf *buf;
+	uint8_t *data;
+
+	switch (evt->type) {
+	case UART_RX_RDY:
+		buf = CONTAINER_OF(evt->data.rx.buf, struct uart_async_rx_buf, data);
+		atomic_add(&buf->wr_idx, evt->data.rx.len);
+		atomic_add(&rx->pending_bytes, evt->data.rx.len);
+		break;
+	case UART_RX_BUF_REQUEST:
+		data = buf_get(rx);
+		if (data != NULL) {
+			(void)uart_rx_buf_rsp(rx->dev, data, rx->buf_len);
+		}
+		break;
+	case UART_RX_BUF_RELEASED:
+		buf = CONTAINER_OF(evt->data.rx_buf.buf, struct uart_async_rx_buf, data);
+		atomic_set(&buf->completed, 1);
+		break;
+	case UART_RX_DISABLED:
+		if (!rx->disabled) {
+			/* The driver ran out of buffers */
+			atomic_set(&rx->stopped, 1);
+			rx_restart(rx);
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+size_t uart_async_rx_data_claim(struct uart_async_rx *rx, uint8_t **data, size_t length)
+{
+	struct uart_async_rx_buf *buf;
+	size_t rem;
+	bool completed;
+
+	while (true) {
+		buf = get_buf(rx, rx->rd_buf_idx);
+
+		/* Once completed, the number of received bytes is final */
+		completed = atomic_get(&buf->completed);
+		rem = atomic_get(&buf->wr_idx) - rx->rd_idx;
+
+		if (rem > 0 || !completed) {
+			break;
+		}
+
+		rd_buf_free(rx, buf);
+	}
+
+	*data = &buf->data[rx->rd_idx];
+
+	return MIN(length, rem);
+}
+
+void uart_async_rx_data_consume(struct uart_async_rx *rx, size_t length)
+{
+	struct uart_async_rx_buf *buf = get_buf(rx, rx->rd_buf_idx);
+	bool completed = atomic_get(&buf->completed);
+
+	rx->rd_idx += length;
+	atomic_sub(&rx->pending_bytes, length);
+
+	if (completed && (rx->rd_idx == atomic_get(&buf->wr_idx))) {
+		rd_buf_free(rx, buf);
+	}
+}
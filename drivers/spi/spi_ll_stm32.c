@@ -53,12 +53,17 @@ LOG_MODULE_REGISTER(spi_ll_stm32);
  */
 uint32_t dummy_rx_tx_buffer;
 
+#ifdef CONFIG_SPI_ASYNC
+static void spi_stm32_dma_async_next(const struct device *dev);
+#endif /* CONFIG_SPI_ASYNC */
+
 /* This function is executed in the interrupt context */
 static void dma_callback(const struct device *dev, void *arg,
 			 uint32_t channel, int status)
 {
 	/* arg directly holds the spi device */
-	struct spi_stm32_data *data = arg;
+	const struct device *spi_dev = arg;
+	struct spi_stm32_data *data = spi_dev->data;
 
 	if (status != 0) {
 		LOG_ERR("DMA callback error with channel %d.", channel);
@@ -78,6 +83,13 @@ static void dma_callback(const struct device *dev, void *arg,
 		}
 	}
 
+#ifdef CONFIG_SPI_ASYNC
+	if (data->ctx.asynchronous) {
+		spi_stm32_dma_async_next(spi_dev);
+		return;
+	}
+#endif /* CONFIG_SPI_ASYNC */
+
 	k_sem_give(&data->status_sem);
 }
 
@@ -127,7 +139,7 @@ static int spi_stm32_dma_tx_load(const struct device *dev, const uint8_t *buf,
 	/* direction is given by the DT */
 	stream->dma_cfg.head_block = blk_cfg;
 	/* give the client dev as arg, as the callback comes from the dma */
-	stream->dma_cfg.user_data = data;
+	stream->dma_cfg.user_data = (void *)dev;
 	/* pass our client origin to the dma: data->dma_tx.dma_channel */
 	ret = dma_config(data->dma_tx.dma_dev, data->dma_tx.channel,
 			&stream->dma_cfg);
@@ -184,7 +196,7 @@ static int spi_stm32_dma_rx_load(const struct device *dev, uint8_t *buf,
 
 	/* direction is given by the DT */
 	stream->dma_cfg.head_block = blk_cfg;
-	stream->dma_cfg.user_data = data;
+	stream->dma_cfg.user_data = (void *)dev;
 
 
 	/* pass our client origin to the dma: data->dma_rx.channel */
@@ -379,13 +391,12 @@ static void spi_stm32_cs_control(const struct device *dev, bool on)
 #endif
 }
 
-static void spi_stm32_complete(const struct device *dev, int status)
+static void spi_stm32_stop(const struct device *dev)
 {
 	const struct spi_stm32_config *cfg = dev->config;
 	SPI_TypeDef *spi = cfg->spi;
-#ifdef CONFIG_SPI_STM32_INTERRUPT
-	struct spi_stm32_data *data = dev->data;
 
+#ifdef CONFIG_SPI_STM32_INTERRUPT
 	ll_func_disable_int_tx_empty(spi);
 	ll_func_disable_int_rx_not_empty(spi);
 	ll_func_disable_int_errors(spi);
@@ -411,6 +422,15 @@ static void spi_stm32_complete(const struct device *dev, int status)
 	}
 
 	ll_func_disable_spi(spi);
+}
+
+static void spi_stm32_complete(const struct device *dev, int status)
+{
+#ifdef CONFIG_SPI_STM32_INTERRUPT
+	struct spi_stm32_data *data = dev->data;
+#endif
+
+	spi_stm32_stop(dev);
 
 #ifdef CONFIG_SPI_STM32_INTERRUPT
 	spi_context_complete(&data->ctx, dev, status);
@@ -697,6 +717,114 @@ static int wait_dma_rx_tx_done(const struct device *dev)
 	return res;
 }
 
+/* Start a DMA transfer of the next segment of the current buffers */
+static int spi_stm32_dma_rxtx_load(const struct device *dev)
+{
+	struct spi_stm32_data *data = dev->data;
+	int ret;
+
+	if (data->ctx.rx_len == 0) {
+		data->dma_len = data->ctx.tx_len;
+	} else if (data->ctx.tx_len == 0) {
+		data->dma_len = data->ctx.rx_len;
+	} else {
+		data->dma_len = MIN(data->ctx.tx_len, data->ctx.rx_len);
+	}
+
+	data->status_flags = 0;
+
+	ret = spi_dma_move_buffers(dev, data->dma_len);
+	if (ret != 0) {
+		return ret;
+	}
+
+#if !DT_HAS_COMPAT_STATUS_OKAY(st_stm32h7_spi)
+	const struct spi_stm32_config *cfg = dev->config;
+
+	/* toggle the DMA request to restart the transfer */
+	LL_SPI_EnableDMAReq_RX(cfg->spi);
+	LL_SPI_EnableDMAReq_TX(cfg->spi);
+#endif /* ! st_stm32h7_spi */
+
+	return 0;
+}
+
+/* Finish the DMA transfer of the current segment */
+static void spi_stm32_dma_rxtx_done(const struct device *dev)
+{
+	const struct spi_stm32_config *cfg = dev->config;
+	struct spi_stm32_data *data = dev->data;
+	SPI_TypeDef *spi = cfg->spi;
+
+#ifdef SPI_SR_FTLVL
+	while (LL_SPI_GetTxFIFOLevel(spi) > 0) {
+	}
+#endif
+
+	/* wait until spi is no more busy (spi TX fifo is really empty) */
+	while (ll_func_spi_dma_busy(spi) == 0) {
+	}
+
+#if !DT_HAS_COMPAT_STATUS_OKAY(st_stm32h7_spi)
+	/* toggle the DMA transfer request */
+	LL_SPI_DisableDMAReq_TX(spi);
+	LL_SPI_DisableDMAReq_RX(spi);
+#endif /* ! st_stm32h7_spi */
+
+	spi_context_update_tx(&data->ctx, 1, data->dma_len);
+	spi_context_update_rx(&data->ctx, 1, data->dma_len);
+}
+
+static void spi_stm32_dma_stop(const struct device *dev)
+{
+	const struct spi_stm32_config *cfg = dev->config;
+	struct spi_stm32_data *data = dev->data;
+	SPI_TypeDef *spi = cfg->spi;
+
+	/* spi stop relies on SPI Status Reg which cannot be disabled */
+	spi_stm32_stop(dev);
+	/* disable spi instance after completion */
+	LL_SPI_Disable(spi);
+	/* The Config. Reg. on some mcus is write un-protected when SPI is disabled */
+	LL_SPI_DisableDMAReq_TX(spi);
+	LL_SPI_DisableDMAReq_RX(spi);
+
+	dma_stop(data->dma_rx.dma_dev, data->dma_rx.channel);
+	dma_stop(data->dma_tx.dma_dev, data->dma_tx.channel);
+}
+
+#ifdef CONFIG_SPI_ASYNC
+/* This function is executed in the interrupt context. Segments are chained
+ * from the DMA completion, so that an asynchronous transfer does not need
+ * a thread.
+ */
+static void spi_stm32_dma_async_next(const struct device *dev)
+{
+	struct spi_stm32_data *data = dev->data;
+	int ret = 0;
+
+	if (data->status_flags & SPI_STM32_DMA_ERROR_FLAG) {
+		ret = -EIO;
+	} else if ((data->status_flags & SPI_STM32_DMA_DONE_FLAG) !=
+		   SPI_STM32_DMA_DONE_FLAG) {
+		/* Waiting for the other channel */
+		return;
+	} else {
+		spi_stm32_dma_rxtx_done(dev);
+
+		if (data->ctx.rx_len > 0 || data->ctx.tx_len > 0) {
+			ret = spi_stm32_dma_rxtx_load(dev);
+			if (ret == 0) {
+				return;
+			}
+		}
+	}
+
+	spi_stm32_dma_stop(dev);
+	spi_context_complete(&data->ctx, dev, ret);
+}
+#endif /* CONFIG_SPI_ASYNC */
+
 static int transceive_dma(const struct device *dev,
 		      const struct spi_config *config,
 		      const struct spi_buf_set *tx_bufs,
@@ -714,10 +842,6 @@ static int transceive_dma(const struct device *dev,
 		return 0;
 	}
 
-	if (asynchronous) {
-		return -ENOTSUP;
-	}
-
 	spi_context_lock(&data->ctx, asynchronous, cb, userdata, config);
 
 	k_sem_reset(&data->status_sem);
@@ -743,68 +867,40 @@ static int transceive_dma(const struct device *dev,
 	LL_SPI_Enable(spi);
 #endif /* st_stm32h7_spi */
 
-	/* This is turned off in spi_stm32_complete(). */
+	/* This is turned off in spi_stm32_stop(). */
 	spi_stm32_cs_control(dev, true);
 
-	while (data->ctx.rx_len > 0 || data->ctx.tx_len > 0) {
-		size_t dma_len;
-
-		if (data->ctx.rx_len == 0) {
-			dma_len = data->ctx.tx_len;
-		} else if (data->ctx.tx_len == 0) {
-			dma_len = data->ctx.rx_len;
-		} else {
-			dma_len = MIN(data->ctx.tx_len, data->ctx.rx_len);
+	if (asynchronous) {
+		/* Following segments are loaded from the DMA callback */
+		if (data->ctx.rx_len > 0 || data->ctx.tx_len > 0) {
+			ret = spi_stm32_dma_rxtx_load(dev);
+			if (ret == 0) {
+				goto end;
+			}
 		}
 
-		data->status_flags = 0;
+		spi_stm32_dma_stop(dev);
+		if (ret == 0) {
+			spi_context_complete(&data->ctx, dev, 0);
+		}
+		goto end;
+	}
 
-		ret = spi_dma_move_buffers(dev, dma_len);
+	while (data->ctx.rx_len > 0 || data->ctx.tx_len > 0) {
+		ret = spi_stm32_dma_rxtx_load(dev);
 		if (ret != 0) {
 			break;
 		}
 
-#if !DT_HAS_COMPAT_STATUS_OKAY(st_stm32h7_spi)
-
-		/* toggle the DMA request to restart the transfer */
-		LL_SPI_EnableDMAReq_RX(spi);
-		LL_SPI_EnableDMAReq_TX(spi);
-#endif /* ! st_stm32h7_spi */
-
 		ret = wait_dma_rx_tx_done(dev);
 		if (ret != 0) {
 			break;
 		}
 
-#ifdef SPI_SR_FTLVL
-		while (LL_SPI_GetTxFIFOLevel(spi) > 0) {
-		}
-#endif
-
-		/* wait until spi is no more busy (spi TX fifo is really empty) */
-		while (ll_func_spi_dma_busy(spi) == 0) {
-		}
-
-#if !DT_HAS_COMPAT_STATUS_OKAY(st_stm32h7_spi)
-		/* toggle the DMA transfer request */
-		LL_SPI_DisableDMAReq_TX(spi);
-		LL_SPI_DisableDMAReq_RX(spi);
-#endif /* ! st_stm32h7_spi */
-
-		spi_context_update_tx(&data->ctx, 1, dma_len);
-		spi_context_update_rx(&data->ctx, 1, dma_len);
+		spi_stm32_dma_rxtx_done(dev);
 	}
 
-	/* spi complete relies on SPI Status Reg which cannot be disabled */
-	spi_stm32_complete(dev, ret);
-	/* disable spi instance after completion */
-	LL_SPI_Disable(spi);
-	/* The Config. Reg. on some mcus is write un-protected when SPI is disabled */
-	LL_SPI_DisableDMAReq_TX(spi);
-	LL_SPI_DisableDMAReq_RX(spi);
-
-	dma_stop(data->dma_rx.dma_dev, data->dma_rx.channel);
-	dma_stop(data->dma_tx.dma_dev, data->dma_tx.channel);
+	spi_stm32_dma_stop(dev);
 
 end:
 	spi_context_release(&data->ctx, ret);
@@ -838,6 +934,15 @@ static int spi_stm32_transceive_async(const struct device *dev,
 				      spi_callback_t cb,
 				      void *userdata)
 {
+#ifdef CONFIG_SPI_STM32_DMA
+	struct spi_stm32_data *data = dev->data;
+
+	if ((data->dma_tx.dma_dev != NULL)
+	 && (data->dma_rx.dma_dev != NULL)) {
+		return transceive_dma(dev, config, tx_bufs, rx_bufs,
+				      true, cb, userdata);
+	}
+#endif /* CONFIG_SPI_STM32_DMA */
 	return transceive(dev, config, tx_bufs, rx_bufs, true, cb, userdata);
 }
 #endif /* CONFIG_SPI_ASYNC */
@@ -62,6 +62,7 @@ struct spi_stm32_data {
 	volatile uint32_t status_flags;
 	struct stream dma_rx;
 	struct stream dma_tx;
+	size_t dma_len;
 #endif /* CONFIG_SPI_STM32_DMA */
 };
 
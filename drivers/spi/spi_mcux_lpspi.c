@@ -240,6 +240,10 @@ static int spi_mcux_configure(const struct device *dev,
 
 #ifdef CONFIG_SPI_MCUX_LPSPI_DMA
 
+#ifdef CONFIG_SPI_ASYNC
+static void spi_mcux_dma_async_next(const struct device *dev);
+#endif /* CONFIG_SPI_ASYNC */
+
 /* This function is executed in the interrupt context */
 static void spi_mcux_dma_callback(const struct device *dev, void *arg,
 			 uint32_t channel, int status)
@@ -267,6 +271,14 @@ static void spi_mcux_dma_callback(const struct device *dev, void *arg,
 			data->status_flags |= SPI_MCUX_LPSPI_DMA_ERROR_FLAG;
 		}
 	}
+
+#ifdef CONFIG_SPI_ASYNC
+	if (data->ctx.asynchronous) {
+		spi_mcux_dma_async_next(spi_dev);
+		return;
+	}
+#endif /* CONFIG_SPI_ASYNC */
+
 	spi_context_complete(&data->ctx, spi_dev, 0);
 }
 
@@ -377,6 +389,107 @@ static int wait_dma_rx_tx_done(const struct device *dev)
 	}
 }
 
+/* Start a DMA transfer of the next block of the current buffers */
+static int spi_mcux_dma_rxtx_load(const struct device *dev)
+{
+	const struct spi_mcux_config *config = dev->config;
+	struct spi_mcux_data *data = dev->data;
+	LPSPI_Type *base = config->base;
+	size_t dma_size;
+	int ret;
+
+	/* Clear status flags */
+	data->status_flags = 0U;
+	/* Load dma blocks of equal length */
+	dma_size = MIN(data->ctx.tx_len, data->ctx.rx_len);
+	if (dma_size == 0) {
+		dma_size = MAX(data->ctx.tx_len, data->ctx.rx_len);
+	}
+
+	data->transfer_len = dma_size;
+
+	ret = spi_mcux_dma_tx_load(dev, data->ctx.tx_buf, dma_size);
+	if (ret != 0) {
+		return ret;
+	}
+
+	ret = spi_mcux_dma_rx_load(dev, data->ctx.rx_buf, dma_size);
+	if (ret != 0) {
+		return ret;
+	}
+
+	/* Start DMA */
+	ret = dma_start(data->dma_tx.dma_dev, data->dma_tx.channel);
+	if (ret != 0) {
+		return ret;
+	}
+	ret = dma_start(data->dma_rx.dma_dev, data->dma_rx.channel);
+	if (ret != 0) {
+		return ret;
+	}
+
+	/* Enable DMA Requests */
+	LPSPI_EnableDMA(base, kLPSPI_TxDmaEnable | kLPSPI_RxDmaEnable);
+
+	return 0;
+}
+
+/* Finish the DMA transfer of the current block */
+static void spi_mcux_dma_rxtx_done(const struct device *dev)
+{
+	const struct spi_mcux_config *config = dev->config;
+	struct spi_mcux_data *data = dev->data;
+	LPSPI_Type *base = config->base;
+
+	while ((LPSPI_GetStatusFlags(base) & kLPSPI_ModuleBusyFlag)) {
+		/* wait until module is idle */
+	}
+
+	/* Disable DMA */
+	LPSPI_DisableDMA(base, kLPSPI_TxDmaEnable | kLPSPI_RxDmaEnable);
+
+	/* Update SPI contexts with amount of data we just sent */
+	spi_context_update_tx(&data->ctx, 1, data->transfer_len);
+	spi_context_update_rx(&data->ctx, 1, data->transfer_len);
+}
+
+#ifdef CONFIG_SPI_ASYNC
+/* This function is executed in the interrupt context. Blocks are chained
+ * from the DMA completion, so that an asynchronous transfer does not need
+ * a thread.
+ */
+static void spi_mcux_dma_async_next(const struct device *dev)
+{
+	const struct spi_mcux_config *config = dev->config;
+	struct spi_mcux_data *data = dev->data;
+	int ret = 0;
+
+	if (data->status_flags & SPI_MCUX_LPSPI_DMA_ERROR_FLAG) {
+		dma_stop(data->dma_tx.dma_dev, data->dma_tx.channel);
+		dma_stop(data->dma_rx.dma_dev, data->dma_rx.channel);
+		LPSPI_DisableDMA(config->base,
+				 kLPSPI_TxDmaEnable | kLPSPI_RxDmaEnable);
+		ret = -EIO;
+	} else if ((data->status_flags & SPI_MCUX_LPSPI_DMA_DONE_FLAG) !=
+		   SPI_MCUX_LPSPI_DMA_DONE_FLAG) {
+		/* Waiting for the other channel */
+		return;
+	} else {
+		spi_mcux_dma_rxtx_done(dev);
+
+		if (data->ctx.rx_len > 0 || data->ctx.tx_len > 0) {
+			ret = spi_mcux_dma_rxtx_load(dev);
+			if (ret == 0) {
+				return;
+			}
+		}
+	}
+
+	spi_context_cs_control(&data->ctx, false);
+	spi_context_complete(&data->ctx, dev, ret);
+}
+#endif /* CONFIG_SPI_ASYNC */
+
 static int transceive_dma(const struct device *dev,
 		      const struct spi_config *spi_cfg,
 		      const struct spi_buf_set *tx_bufs,
@@ -389,7 +502,6 @@ static int transceive_dma(const struct device *dev,
 	struct spi_mcux_data *data = dev->data;
 	LPSPI_Type *base = config->base;
 	int ret;
-	size_t dma_size;
 
 	spi_context_lock(&data->ctx, asynchronous, cb, userdata, spi_cfg);
 
@@ -405,54 +517,35 @@ static int transceive_dma(const struct device *dev,
 	/* DMA is fast enough watermarks are not required */
 	LPSPI_SetFifoWatermarks(base, 0U, 0U);
 
-	/* Send each spi buf via DMA, updating context as DMA completes */
-	while (data->ctx.rx_len > 0 || data->ctx.tx_len > 0) {
-		/* Clear status flags */
-		data->status_flags = 0U;
-		/* Load dma blocks of equal length */
-		dma_size = MIN(data->ctx.tx_len, data->ctx.rx_len);
-		if (dma_size == 0) {
-			dma_size = MAX(data->ctx.tx_len, data->ctx.rx_len);
-		}
-		ret = spi_mcux_dma_tx_load(dev, data->ctx.tx_buf, dma_size);
-		if (ret != 0) {
+	if (asynchronous) {
+		if (data->ctx.rx_len == 0 && data->ctx.tx_len == 0) {
+			spi_context_cs_control(&data->ctx, false);
+			spi_context_complete(&data->ctx, dev, 0);
 			goto out;
 		}
 
-		ret = spi_mcux_dma_rx_load(dev, data->ctx.rx_buf, dma_size);
+		/* Following blocks are loaded from the DMA callback */
+		ret = spi_mcux_dma_rxtx_load(dev);
 		if (ret != 0) {
-			goto out;
+			spi_context_cs_control(&data->ctx, false);
 		}
+		goto out;
+	}
 
-		/* Start DMA */
-		ret = dma_start(data->dma_tx.dma_dev, data->dma_tx.channel);
-		if (ret != 0) {
-			goto out;
-		}
-		ret = dma_start(data->dma_rx.dma_dev, data->dma_rx.channel);
+	/* Send each spi buf via DMA, updating context as DMA completes */
+	while (data->ctx.rx_len > 0 || data->ctx.tx_len > 0) {
+		ret = spi_mcux_dma_rxtx_load(dev);
 		if (ret != 0) {
 			goto out;
 		}
 
-		/* Enable DMA Requests */
-		LPSPI_EnableDMA(base, kLPSPI_TxDmaEnable | kLPSPI_RxDmaEnable);
-
 		/* Wait for DMA to finish */
 		ret = wait_dma_rx_tx_done(dev);
 		if (ret != 0) {
 			goto out;
 		}
 
-		while ((LPSPI_GetStatusFlags(base) & kLPSPI_ModuleBusyFlag)) {
-			/* wait until module is idle */
-		}
-
-		/* Disable DMA */
-		LPSPI_DisableDMA(base, kLPSPI_TxDmaEnable | kLPSPI_RxDmaEnable);
-
-		/* Update SPI contexts with amount of data we just sent */
-		spi_context_update_tx(&data->ctx, 1, dma_size);
-		spi_context_update_rx(&data->ctx, 1, dma_size);
+		spi_mcux_dma_rxtx_done(dev);
 	}
 
 	spi_context_cs_control(&data->ctx, false);
@@ -515,7 +608,11 @@ static int spi_mcux_transceive_async(const struct device *dev,
 				     spi_callback_t cb,
 				     void *userdata)
 {
+#ifdef CONFIG_SPI_MCUX_LPSPI_DMA
+	return transceive_dma(dev, spi_cfg, tx_bufs, rx_bufs, true, cb, userdata);
+#else
 	return transceive(dev, spi_cfg, tx_bufs, rx_bufs, true, cb, userdata);
+#endif /* CONFIG_SPI_MCUX_LPSPI_DMA */
 }
 #endif /* CONFIG_SPI_ASYNC */
 
@@ -345,8 +345,11 @@ static void transfer_next_chunk(const struct device *dev)
 
 	LOG_DBG("Transaction finished with status %d", error);
 
-	spi_context_complete(ctx, dev, error);
+	/* Cleared first, as the completion callback may start or release
+	 * the next transaction.
+	 */
 	dev_data->busy = false;
+	spi_context_complete(ctx, dev, error);
 }
 
 static void event_handler(const nrfx_spim_evt_t *p_event, void *p_context)
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief RTIO IO device for SPI peripherals
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/spi.h>
+#include <zephyr/rtio/rtio.h>
+
+static void spi_iodev_complete(const struct device *dev, int result,
+			       void *userdata)
+{
+	struct spi_iodev *iodev = userdata;
+	const struct rtio_sqe *sqe = iodev->sqe;
+	struct rtio *r = iodev->r;
+
+	/* The transaction ends with the first unchained entry. On error the
+	 * executor cancels the rest of the chain, so it ends as well.
+	 */
+	if (iodev->locked &&
+	    ((result < 0) || !(sqe->flags & RTIO_SQE_CHAINED))) {
+		iodev->locked = false;
+		iodev->config.operation &= ~SPI_HOLD_ON_CS;
+		(void)spi_release(dev, &iodev->config);
+	}
+
+	if (result < 0) {
+		rtio_sqe_err(r, sqe, result);
+	} else {
+		rtio_sqe_ok(r, sqe, result);
+	}
+}
+
+static void spi_iodev_start(struct spi_iodev *iodev,
+			    const struct rtio_sqe *sqe, struct rtio *r)
+{
+	const struct spi_buf_set *tx_bufs = NULL;
+	const struct spi_buf_set *rx_bufs = NULL;
+	int err;
+
+	iodev->sqe = sqe;
+	iodev->r = r;
+
+	iodev->buf.buf = sqe->buf;
+	iodev->buf.len = sqe->buf_len;
+	iodev->buf_set.buffers = &iodev->buf;
+	iodev->buf_set.count = 1;
+
+	switch (sqe->op) {
+	case RTIO_OP_TX:
+		tx_bufs = &iodev->buf_set;
+		break;
+	case RTIO_OP_RX:
+		rx_bufs = &iodev->buf_set;
+		break;
+	default:
+		spi_iodev_complete(iodev->bus, -EINVAL, iodev);
+		return;
+	}
+
+	/* The bus stays locked for the whole chain, so that the following
+	 * entries can be started from the completion interrupt. The chip
+	 * select is released by the driver after the last one.
+	 */
+	iodev->config.operation |= SPI_LOCK_ON;
+	if (sqe->flags & RTIO_SQE_CHAINED) {
+		iodev->config.operation |= SPI_HOLD_ON_CS;
+	} else {
+		iodev->config.operation &= ~SPI_HOLD_ON_CS;
+	}
+
+	iodev->locked = true;
+
+	err = spi_transceive_cb(iodev->bus, &iodev->config, tx_bufs, rx_bufs,
+				spi_iodev_complete, iodev);
+	if (err < 0) {
+		spi_iodev_complete(iodev->bus, err, iodev);
+	}
+}
+
+void z_spi_iodev_work_handler(struct k_work *work)
+{
+	struct spi_iodev *iodev = CONTAINER_OF(work, struct spi_iodev, work);
+
+	spi_iodev_start(iodev, iodev->sqe, iodev->r);
+}
+
+static void spi_iodev_submit(const struct rtio_sqe *sqe, struct rtio *r)
+{
+	struct spi_iodev *iodev = (struct spi_iodev *)sqe->iodev;
+
+	/* Locking the bus may block. Only entries continuing a chain, which
+	 * already holds the lock, are started from interrupt context.
+	 */
+	if (k_is_in_isr() && !iodev->locked) {
+		iodev->sqe = sqe;
+		iodev->r = r;
+		k_work_submit(&iodev->work);
+		return;
+	}
+
+	spi_iodev_start(iodev, sqe, r);
+}
+
+const struct rtio_iodev_api spi_iodev_api = {
+	.submit = spi_iodev_submit,
+};
@@ -271,7 +271,10 @@ static int sys_clock_driver_init(const struct device *dev)
 	ARG_UNUSED(dev);
 
 	NVIC_SetPriority(SysTick_IRQn, _IRQ_PRIO_OFFSET);
-	last_load = CYC_PER_TICK - 1;
+	/* A tick may be as short as one cycle when ticks are counted in
+	 * cycles, which would stop the counter.
+	 */
+	last_load = (TICKLESS ? MAX(CYC_PER_TICK, MIN_DELAY) : CYC_PER_TICK) - 1;
 	overflow_cyc = 0U;
 	SysTick->LOAD = last_load;
 	SysTick->VAL = 0; /* resets timer to last_load */
@@ -6,6 +6,9 @@
 #include <zephyr/kernel.h>
 
 #include <zephyr/drivers/video.h>
+#ifdef CONFIG_VIDEO_BUFFER_NET_BUF
+#include <zephyr/net/buf.h>
+#endif
 
 K_HEAP_DEFINE(video_buffer_pool,
 	      CONFIG_VIDEO_BUFFER_POOL_SZ_MAX *
@@ -13,23 +16,15 @@ K_HEAP_DEFINE(video_buffer_pool,
 
 static struct video_buffer video_buf[CONFIG_VIDEO_BUFFER_POOL_NUM_MAX];
 
-struct mem_block {
-	void *data;
-};
-
-static struct mem_block video_block[CONFIG_VIDEO_BUFFER_POOL_NUM_MAX];
-
 struct video_buffer *video_buffer_alloc(size_t size)
 {
 	struct video_buffer *vbuf = NULL;
-	struct mem_block *block;
 	int i;
 
-	/* find available video buffer */
+	/* find available video buffer, a buffer is free when unreferenced */
 	for (i = 0; i < ARRAY_SIZE(video_buf); i++) {
-		if (video_buf[i].buffer == NULL) {
+		if (atomic_cas(&video_buf[i].refcount, 0, 1)) {
 			vbuf = &video_buf[i];
-			block = &video_block[i];
 			break;
 		}
 	}
@@ -39,33 +34,63 @@ struct video_buffer *video_buffer_alloc(size_t size)
 	}
 
 	/* Alloc buffer memory */
-	block->data = k_heap_alloc(&video_buffer_pool, size, K_FOREVER);
-	if (block->data == NULL) {
+	vbuf->buffer = k_heap_alloc(&video_buffer_pool, size, K_FOREVER);
+	if (vbuf->buffer == NULL) {
+		atomic_set(&vbuf->refcount, 0);
 		return NULL;
 	}
 
-	vbuf->buffer = block->data;
 	vbuf->size = size;
 	vbuf->bytesused = 0;
+	vbuf->line_offset = 0;
 
 	return vbuf;
 }
 
+void video_buffer_ref(struct video_buffer *vbuf)
+{
+	atomic_inc(&vbuf->refcount);
+}
+
 void video_buffer_release(struct video_buffer *vbuf)
 {
-	struct mem_block *block = NULL;
-	int i;
+	/* The buffer may be allocated again as soon as it is unreferenced */
+	uint8_t *data = vbuf->buffer;
 
-	/* vbuf to block */
-	for (i = 0; i < ARRAY_SIZE(video_block); i++) {
-		if (video_block[i].data == vbuf->buffer) {
-			block = &video_block[i];
-			break;
-		}
+	if (atomic_dec(&vbuf->refcount) != 1) {
+		return;
 	}
 
-	vbuf->buffer = NULL;
-	if (block) {
-		k_heap_free(&video_buffer_pool, block->data);
+	k_heap_free(&video_buffer_pool, data);
+}
+
+#ifdef CONFIG_VIDEO_BUFFER_NET_BUF
+static void video_net_buf_destroy(struct net_buf *buf)
+{
+	struct video_buffer *vbuf = *(struct video_buffer **)net_buf_user_data(buf);
+
+	net_buf_destroy(buf);
+	video_buffer_release(vbuf);
+}
+
+/* Headers only, the data is the memory of a video buffer */
+NET_BUF_POOL_DEFINE(video_net_buf_pool, CONFIG_VIDEO_BUFFER_NET_BUF_COUNT,
+		    0, sizeof(struct video_buffer *), video_net_buf_destroy);
+
+struct net_buf *video_buffer_net_buf(struct video_buffer *vbuf,
+				     k_timeout_t timeout)
+{
+	struct net_buf *buf;
+
+	buf = net_buf_alloc_with_data(&video_net_buf_pool, vbuf->buffer,
+				      vbuf->bytesused, timeout);
+	if (buf == NULL) {
+		return NULL;
 	}
+
+	*(struct video_buffer **)net_buf_user_data(buf) = vbuf;
+	video_buffer_ref(vbuf);
+
+	return buf;
 }
+#endif /* CONFIG_VIDEO_BUFFER_NET_BUF */
@@ -18,6 +18,8 @@ struct video_sw_generator_data {
 	struct k_work_delayable buf_work;
 	struct k_work_sync work_sync;
 	int pattern;
+	/* First line of the next slice of the current frame */
+	uint32_t line_offset;
 	bool ctrl_hflip;
 	bool ctrl_vflip;
 	struct k_poll_signal *signal;
@@ -57,6 +59,8 @@ static int video_sw_generator_stream_start(const struct device *dev)
 {
 	struct video_sw_generator_data *data = dev->data;
 
+	data->line_offset = 0;
+
 	return k_work_schedule(&data->buf_work, K_MSEC(33));
 }
 
@@ -73,13 +77,19 @@ static int video_sw_generator_stream_stop(const struct device *dev)
 uint16_t rgb565_colorbar_value[] = { 0x0000, 0x001F, 0xF800, 0xF81F,
 				  0x07E0, 0x07FF, 0xFFE0, 0xFFFF };
 
+/* Fill as many lines of the frame as the buffer holds, buffers smaller than
+ * a frame get the frame in slices.
+ */
 static void __fill_buffer_colorbar(struct video_sw_generator_data *data,
 				   struct video_buffer *vbuf)
 {
 	int bw = data->fmt.width / 8;
+	uint32_t lines = vbuf->size / (data->fmt.width * 2);
 	int h, w, i = 0;
 
-	for (h = 0; h < data->fmt.height; h++) {
+	lines = MIN(lines, data->fmt.height - data->line_offset);
+
+	for (h = 0; h < lines; h++) {
 		for (w = 0; w < data->fmt.width; w++) {
 			int color_idx =  data->ctrl_vflip ? 7 - w / bw : w / bw;
 			if (data->fmt.pixelformat == VIDEO_PIX_FMT_RGB565) {
@@ -92,6 +102,12 @@ static void __fill_buffer_colorbar(struct video_sw_generator_data *data,
 
 	vbuf->timestamp = k_uptime_get_32();
 	vbuf->bytesused = i;
+	vbuf->line_offset = data->line_offset;
+
+	data->line_offset += lines;
+	if (data->line_offset >= data->fmt.height) {
+		data->line_offset = 0;
+	}
 }
 
 static void __buffer_work(struct k_work *work)
@@ -102,10 +118,10 @@ static void __buffer_work(struct k_work *work)
 
 	data = CONTAINER_OF(dwork, struct video_sw_generator_data, buf_work);
 
-	k_work_reschedule(&data->buf_work, K_MSEC(1000 / VIDEO_PATTERN_FPS));
-
 	vbuf = k_fifo_get(&data->fifo_in, K_NO_WAIT);
 	if (vbuf == NULL) {
+		k_work_reschedule(&data->buf_work,
+				  K_MSEC(1000 / VIDEO_PATTERN_FPS));
 		return;
 	}
 
@@ -115,6 +131,10 @@ static void __buffer_work(struct k_work *work)
 		break;
 	}
 
+	/* Slices of a frame are delivered back to back */
+	k_work_reschedule(&data->buf_work, data->line_offset ? K_NO_WAIT :
+			  K_MSEC(1000 / VIDEO_PATTERN_FPS));
+
 	k_fifo_put(&data->fifo_out, vbuf);
 
 	if (IS_ENABLED(CONFIG_POLL) && data->signal) {
@@ -327,6 +327,16 @@ static int esp32_wifi_connect(const struct device *dev,
 	wifi_config.sta.pmf_cfg.capable = true;
 	wifi_config.sta.pmf_cfg.required = false;
 
+	/* Probe the BSS directly if it is known, instead of scanning */
+	if (params->channel != WIFI_CHANNEL_ANY) {
+		wifi_config.sta.channel = params->channel;
+	}
+
+	if (params->bssid) {
+		memcpy(wifi_config.sta.bssid, params->bssid, WIFI_MAC_ADDR_LEN);
+		wifi_config.sta.bssid_set = true;
+	}
+
 	ret = esp_wifi_set_config(ESP_IF_WIFI_STA, &wifi_config);
 	ret |= esp_wifi_set_mode(ESP32_WIFI_MODE_STA);
 	ret |= esp_wifi_connect();
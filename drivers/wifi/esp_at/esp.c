@@ -876,6 +876,14 @@ static int esp_mgmt_connect(const struct device *dev,
 	len += snprintk(&data->conn_cmd[len], sizeof(data->conn_cmd) - len,
 			"\"");
 
+	/* Join the BSS directly if it is known, instead of scanning for it */
+	if (params->bssid) {
+		snprintk(&data->conn_cmd[len], sizeof(data->conn_cmd) - len,
+			 ",\"%02x:%02x:%02x:%02x:%02x:%02x\"",
+			 params->bssid[0], params->bssid[1], params->bssid[2],
+			 params->bssid[3], params->bssid[4], params->bssid[5]);
+	}
+
 	k_work_submit_to_queue(&data->workq, &data->connect_work);
 
 	return 0;
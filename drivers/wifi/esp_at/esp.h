@@ -76,7 +76,7 @@ extern "C" {
 #define _UART_CUR \
 	STRINGIFY(_UART_BAUD)",8,1,0,"_FLOW_CONTROL
 
-#define CONN_CMD_MAX_LEN (sizeof("AT+"_CWJAP"=\"\",\"\"") + \
+#define CONN_CMD_MAX_LEN (sizeof("AT+"_CWJAP"=\"\",\"\",\"xx:xx:xx:xx:xx:xx\"") + \
 			  WIFI_SSID_MAX_LEN + WIFI_PSK_MAX_LEN)
 
 #if defined(CONFIG_WIFI_ESP_AT_DNS_USE)
@@ -150,6 +150,7 @@
 #define MSTATUS_MPP_M   (3UL << 11)
 #define MSTATUS_MPIE_EN (1UL << 7)
 #define MSTATUS_FS_INIT (1UL << 13)
+#define MSTATUS_FS_CLEAN (2UL << 13)
 #define MSTATUS_FS_MASK ((1UL << 13) | (1UL << 14))
 
 
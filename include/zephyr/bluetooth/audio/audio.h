@@ -11,6 +11,7 @@
 #ifndef ZEPHYR_INCLUDE_BLUETOOTH_AUDIO_AUDIO_H_
 #define ZEPHYR_INCLUDE_BLUETOOTH_AUDIO_AUDIO_H_
 
+#include <zephyr/kernel.h>
 #include <zephyr/sys/atomic.h>
 #include <zephyr/bluetooth/buf.h>
 #include <zephyr/bluetooth/conn.h>
@@ -2061,6 +2062,130 @@ int bt_audio_stream_release(struct bt_audio_stream *stream, bool cache);
 int bt_audio_stream_send(struct bt_audio_stream *stream, struct net_buf *buf,
 			 uint32_t seq_num, uint32_t ts);
 
+struct bt_audio_pipeline;
+
+/** @brief Audio stream pipeline operations structure. */
+struct bt_audio_pipeline_ops {
+	/** @brief Encode frame callback
+	 *
+	 *  Called once per SDU interval from the pipeline work queue to
+	 *  produce the SDU that is sent in the next SDU interval.
+	 *
+	 *  If the SDU is produced synchronously the callback shall add the
+	 *  encoded data to @p buf and return 0. If the encoding is offloaded,
+	 *  e.g. to a DSP, the callback may instead return -EINPROGRESS and
+	 *  call bt_audio_pipeline_frame_done() once @p buf has been filled.
+	 *  Any other negative value drops the frame for this interval.
+	 *
+	 *  @param pipeline  Pipeline object.
+	 *  @param buf       Buffer to add the encoded SDU to.
+	 *  @param seq_num   Sequence number the SDU will be sent with.
+	 *  @param ts        Nominal time of the SDU in microseconds, relative
+	 *                   to the start of the pipeline.
+	 *
+	 *  @return 0 if the frame is ready, -EINPROGRESS if it will be
+	 *          completed later or another negative value on error.
+	 */
+	int (*encode)(struct bt_audio_pipeline *pipeline, struct net_buf *buf,
+		      uint32_t seq_num, uint32_t ts);
+};
+
+/** @brief Audio stream pipeline statistics. */
+struct bt_audio_pipeline_stats {
+	/** Number of SDUs sent. */
+	uint32_t sent;
+	/** Number of SDU intervals without a frame ready in time. */
+	uint32_t late;
+	/** Number of frames dropped by the encoder or the stream. */
+	uint32_t dropped;
+	/** Latency of the last encoded frame in microseconds. */
+	uint32_t encode_us_last;
+	/** Highest encoding latency in microseconds. */
+	uint32_t encode_us_max;
+	/** Highest delay of the SDU interval work in microseconds. */
+	uint32_t sched_us_max;
+};
+
+/** @brief Audio stream pipeline
+ *
+ *  A pipeline sends one SDU on an audio stream every SDU interval. The
+ *  frames are double buffered: while one frame is being sent the next one is
+ *  being encoded, so the encoder has a full SDU interval to complete.
+ *
+ *  The fields of this structure are internal to the pipeline and shall not
+ *  be accessed by the application.
+ */
+struct bt_audio_pipeline {
+	struct bt_audio_stream *stream;
+	const struct bt_audio_pipeline_ops *ops;
+	struct net_buf_pool *pool;
+	struct k_work_delayable work;
+	struct k_spinlock lock;
+	/* Frame encoded in the previous interval, sent in the current one */
+	struct net_buf *ready;
+	uint32_t ready_seq_num;
+	/* Frame being encoded, possibly asynchronously */
+	struct net_buf *pending;
+	uint32_t pending_seq_num;
+	uint32_t pending_start;
+	bool pending_late;
+	int64_t deadline;
+	uint32_t interval_us;
+	uint32_t seq_num;
+	bool running;
+	struct bt_audio_pipeline_stats stats;
+};
+
+/** @brief Start an audio stream pipeline
+ *
+ *  Start sending SDUs on @p stream every SDU interval of the stream QoS.
+ *  The first SDU is encoded immediately and sent one SDU interval later.
+ *  The stream shall be in the streaming state.
+ *
+ *  @param pipeline  Pipeline object.
+ *  @param stream    Stream to send the SDUs on.
+ *  @param ops       Pipeline operations.
+ *  @param pool      Buffer pool to allocate the SDUs from. It shall hold at
+ *                   least two buffers of @ref BT_ISO_SDU_BUF_SIZE of the
+ *                   stream SDU size.
+ *
+ *  @return 0 in case of success or negative value in case of error.
+ */
+int bt_audio_pipeline_start(struct bt_audio_pipeline *pipeline,
+			    struct bt_audio_stream *stream,
+			    const struct bt_audio_pipeline_ops *ops,
+			    struct net_buf_pool *pool);
+
+/** @brief Stop an audio stream pipeline
+ *
+ *  Stop sending SDUs and release any frame not yet sent. A frame being
+ *  encoded asynchronously is released when bt_audio_pipeline_frame_done()
+ *  is called for it.
+ *
+ *  @param pipeline  Pipeline object.
+ *
+ *  @return 0 in case of success or negative value in case of error.
+ */
+int bt_audio_pipeline_stop(struct bt_audio_pipeline *pipeline);
+
+/** @brief Complete an asynchronously encoded frame
+ *
+ *  Shall be called once for every encode callback that returned
+ *  -EINPROGRESS. May be called from any context, including ISRs.
+ *
+ *  @param pipeline  Pipeline object.
+ *  @param err       0 if the frame was encoded or negative value to drop it.
+ */
+void bt_audio_pipeline_frame_done(struct bt_audio_pipeline *pipeline, int err);
+
+/** @brief Get audio stream pipeline statistics
+ *
+ *  @param pipeline  Pipeline object.
+ *  @param stats     Statistics of the pipeline.
+ */
+void bt_audio_pipeline_stats_get(struct bt_audio_pipeline *pipeline,
+				 struct bt_audio_pipeline_stats *stats);
+
 /** @brief Parameter struct for the unicast group functions
  *
  * Parameter struct for the bt_audio_unicast_group_create() and
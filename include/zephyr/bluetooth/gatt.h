@@ -1104,6 +1104,33 @@ int bt_gatt_notify_multiple(struct bt_conn *conn,
 			    uint16_t num_params,
 			    struct bt_gatt_notify_params params[]);
 
+/** @brief Send a batch of notifications in as few PDUs as possible.
+ *
+ *  The notifications are packed, in order, into ATT_MULTIPLE_HANDLE_VALUE_NTF
+ *  PDUs as large as the largest MTU of the open ATT bearers. A new PDU is
+ *  started when the next notification does not fit or has another `func`,
+ *  `user_data` or channel option. The PDUs are sent on whichever bearer is
+ *  free, so they go out in parallel when Enhanced ATT bearers are open.
+ *
+ *  If the peer does not support ATT_MULTIPLE_HANDLE_VALUE_NTF, or if a PDU
+ *  would only hold one notification, the notifications are sent with
+ *  @ref bt_gatt_notify_cb instead.
+ *
+ *  Like @ref bt_gatt_notify_multiple, this API only accepts attribute
+ *  references and not UUIDs.
+ *
+ *  @param conn Target client.
+ *  @param num_params Element count of `params` array.
+ *  @param params Array of notification parameters. It is okay to free this
+ *    after calling this function.
+ *
+ *  @return 0 in case of success or negative value in case of error. On error
+ *    the notifications before the failing one may have been sent already.
+ */
+int bt_gatt_notify_batch(struct bt_conn *conn,
+			 uint16_t num_params,
+			 struct bt_gatt_notify_params params[]);
+
 /** @brief Notify attribute value change.
  *
  *  Send notification of attribute value change, if connection is NULL notify
@@ -138,6 +138,90 @@ static inline int z_impl_sys_cache_instr_range(void *addr, size_t size, int op)
 	return -ENOTSUP;
 }
 
+/**
+ * @brief Write-back / Invalidate d-cache lines without waiting for completion
+ *
+ * Same as sys_cache_data_range(), except that the operation may only be
+ * complete after the next sys_cache_data_sync(). Architectures without
+ * support for deferred completion perform the operation synchronously.
+ *
+ * @param addr Start address of the range.
+ * @param size Size of the range in bytes.
+ * @param op   Cache operation, K_CACHE_WB, K_CACHE_INVD or K_CACHE_WB_INVD.
+ *
+ * @retval 0 on success.
+ * @retval -ENOTSUP if the d-cache can not be managed.
+ */
+static inline int sys_cache_data_range_nosync(void *addr, size_t size, int op)
+{
+#if defined(CONFIG_CACHE_MANAGEMENT) && defined(CONFIG_DCACHE)
+#if defined(CONFIG_HAS_ARCH_CACHE) && defined(CONFIG_ARCH_HAS_DCACHE_RANGE_NOSYNC)
+	return arch_dcache_range_nosync(addr, size, op);
+#else
+	return cache_data_range(addr, size, op);
+#endif
+#endif
+	ARG_UNUSED(addr);
+	ARG_UNUSED(size);
+	ARG_UNUSED(op);
+
+	return -ENOTSUP;
+}
+
+/**
+ * @brief Wait for the completion of d-cache maintenance operations
+ *
+ * Completes the operations started with sys_cache_data_range_nosync(), and
+ * orders them after all preceding memory accesses.
+ */
+static inline void sys_cache_data_sync(void)
+{
+#if defined(CONFIG_CACHE_MANAGEMENT) && defined(CONFIG_DCACHE) && \
+	defined(CONFIG_HAS_ARCH_CACHE) && defined(CONFIG_ARCH_HAS_DCACHE_RANGE_NOSYNC)
+	arch_dcache_sync();
+#endif
+}
+
+/** Memory range for batched cache maintenance */
+struct sys_cache_range {
+	/** Start address of the range */
+	void *addr;
+	/** Size of the range in bytes */
+	size_t size;
+};
+
+/**
+ * @brief Write-back / Invalidate the d-cache lines of a list of ranges
+ *
+ * Performs the cache operation on all ranges, e.g. the buffers of a DMA
+ * scatter list, and waits for the completion only once for all of them.
+ *
+ * @param ranges Array of memory ranges.
+ * @param cnt    Number of ranges.
+ * @param op     Cache operation, K_CACHE_WB, K_CACHE_INVD or K_CACHE_WB_INVD.
+ *
+ * @retval 0 on success.
+ * @retval -ENOTSUP if the d-cache can not be managed.
+ */
+static inline int sys_cache_data_range_batch(const struct sys_cache_range *ranges,
+					     size_t cnt, int op)
+{
+	int ret = 0;
+
+	sys_cache_data_sync();
+
+	for (size_t i = 0; i < cnt; i++) {
+		ret = sys_cache_data_range_nosync(ranges[i].addr, ranges[i].size, op);
+		if (ret != 0) {
+			break;
+		}
+	}
+
+	sys_cache_data_sync();
+
+	return ret;
+}
+
 #ifdef CONFIG_LIBMETAL
 static inline void sys_cache_flush(void *addr, size_t size)
 {
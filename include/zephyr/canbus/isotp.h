@@ -202,6 +202,38 @@ int isotp_bind(struct isotp_recv_ctx *ctx, const struct device *can_dev,
 	       const struct isotp_fc_opts *opts,
 	       k_timeout_t timeout);
 
+#ifdef CONFIG_ISOTP_RX_USER_BUF
+/**
+ * @brief Bind an address to a receiving context using a caller buffer.
+ *
+ * This function is similar to isotp_bind, but multi-frame messages are
+ * reassembled in place into the given buffer instead of being copied into
+ * buffers of the internal pool. A message is delivered as a single net_buf
+ * pointing to the buffer, regardless of the block size. The buffer is used
+ * for the next message once this net_buf is unreferenced, so it must be
+ * unreferenced before calling isotp_unbind.
+ * Single frames are still received into the internal SF and FF buffers.
+ *
+ * @param ctx      Context to store the internal states.
+ * @param can_dev  The CAN device to be used for sending and receiving.
+ * @param rx_addr  Identifier for incoming data.
+ * @param tx_addr  Identifier for FC frames.
+ * @param opts     Flow control options.
+ * @param buf      Buffer messages are reassembled into.
+ * @param buf_size Size of the buffer, the largest message accepted.
+ * @param timeout  Timeout for FF SF buffer allocation.
+ *
+ * @retval ISOTP_N_OK on success
+ * @retval ISOTP_NO_FREE_FILTER if CAN device has no filters left.
+ */
+int isotp_bind_buf(struct isotp_recv_ctx *ctx, const struct device *can_dev,
+		   const struct isotp_msg_id *rx_addr,
+		   const struct isotp_msg_id *tx_addr,
+		   const struct isotp_fc_opts *opts,
+		   uint8_t *buf, size_t buf_size,
+		   k_timeout_t timeout);
+#endif
+
 /**
  * @brief Unbind a context from the interface
  *
@@ -422,6 +454,11 @@ struct isotp_recv_ctx {
 	uint8_t bs;
 	uint8_t wft;
 	uint8_t sn_expected : 4;
+#ifdef CONFIG_ISOTP_RX_USER_BUF
+	bool user_buf_busy;
+	uint8_t *user_buf;
+	size_t user_buf_size;
+#endif
 };
 
 /** @endcond */
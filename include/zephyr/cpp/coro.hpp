@@ -0,0 +1,613 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief C++20 coroutines scheduled on work queues
+ */
+
+#ifndef ZEPHYR_INCLUDE_CPP_CORO_HPP_
+#define ZEPHYR_INCLUDE_CPP_CORO_HPP_
+
+#include <coroutine>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/slist.h>
+#ifdef CONFIG_RTIO
+#include <zephyr/rtio/rtio.h>
+#endif
+
+/**
+ * @defgroup cpp_coro C++ coroutines
+ * @ingroup cpp
+ *
+ * Coroutines returning a @ref zephyr::coro::task are run by an
+ * @ref zephyr::coro::executor on the thread of a work queue. Awaiting a
+ * kernel object never blocks that thread: the coroutine is suspended and
+ * resumed once the object is ready, so any number of coroutines share the
+ * stack of the work queue.
+ *
+ * Coroutine frames are allocated from a dedicated heap sized with
+ * CONFIG_CPP_COROUTINES_HEAP_SIZE.
+ * @{
+ */
+
+extern "C" struct k_heap z_cpp_coro_heap;
+
+namespace zephyr::coro {
+
+class executor;
+
+template <typename T> class task;
+
+namespace detail {
+
+/* A coroutine waiting to be resumed by its executor */
+struct ready_node {
+	sys_snode_t node;
+	std::coroutine_handle<> handle;
+};
+
+struct promise_base {
+	executor *exec = nullptr;
+	std::coroutine_handle<> continuation;
+	ready_node start;
+	bool detached = false;
+
+	static void *operator new(size_t size) noexcept
+	{
+		return k_heap_alloc(&z_cpp_coro_heap, size, K_NO_WAIT);
+	}
+
+	static void operator delete(void *ptr) noexcept
+	{
+		k_heap_free(&z_cpp_coro_heap, ptr);
+	}
+
+	std::suspend_always initial_suspend() noexcept
+	{
+		return {};
+	}
+
+	struct final_awaiter {
+		bool await_ready() noexcept
+		{
+			return false;
+		}
+
+		template <typename P>
+		std::coroutine_handle<> await_suspend(std::coroutine_handle<P> h) noexcept
+		{
+			promise_base &p = h.promise();
+
+			if (p.continuation) {
+				return p.continuation;
+			}
+
+			if (p.detached) {
+				h.destroy();
+			}
+
+			return std::noop_coroutine();
+		}
+
+		void await_resume() noexcept
+		{
+		}
+	};
+
+	final_awaiter final_suspend() noexcept
+	{
+		return {};
+	}
+
+	void unhandled_exception() noexcept
+	{
+		k_panic();
+	}
+};
+
+template <typename T> struct promise_result {
+	std::optional<T> value;
+
+	template <typename U> void return_value(U &&v)
+	{
+		value.emplace(std::forward<U>(v));
+	}
+};
+
+template <> struct promise_result<void> {
+	void return_void() noexcept
+	{
+	}
+};
+
+} /* namespace detail */
+
+/**
+ * @brief Runs coroutines on a work queue
+ *
+ * An executor must outlive the coroutines it runs, and is usually a
+ * static object.
+ */
+class executor {
+public:
+	/**
+	 * @param queue Work queue the coroutines run on.
+	 */
+	explicit executor(struct k_work_q *queue = &k_sys_work_q) noexcept
+		: queue_(queue)
+	{
+		k_work_init(&work_, handler);
+		sys_slist_init(&ready_);
+	}
+
+	executor(const executor &) = delete;
+	executor &operator=(const executor &) = delete;
+
+	/**
+	 * @brief Start a task
+	 *
+	 * The task runs detached, its frame is freed when it returns.
+	 *
+	 * @param t Task to start.
+	 *
+	 * @retval 0 on success.
+	 * @retval -ENOMEM if the frame of the task could not be allocated.
+	 */
+	int spawn(task<void> &&t) noexcept;
+
+	/** @brief Queue a suspended coroutine for resumption, ISR safe */
+	void schedule(detail::ready_node &ready) noexcept
+	{
+		k_spinlock_key_t key = k_spin_lock(&lock_);
+
+		sys_slist_append(&ready_, &ready.node);
+		k_spin_unlock(&lock_, key);
+
+		(void)k_work_submit_to_queue(queue_, &work_);
+	}
+
+	/** @brief The work queue the coroutines run on */
+	struct k_work_q *queue() const noexcept
+	{
+		return queue_;
+	}
+
+private:
+	/* Coroutines are only resumed from this handler, and never from the
+	 * handler of a work item embedded in a coroutine frame, since the
+	 * work queue still accesses a work item after its handler returns
+	 * while a coroutine may free its frame when resumed.
+	 */
+	static void handler(struct k_work *work)
+	{
+		executor *self = CONTAINER_OF(work, executor, work_);
+		sys_slist_t batch;
+		sys_snode_t *node;
+		k_spinlock_key_t key = k_spin_lock(&self->lock_);
+
+		/* Coroutines scheduled while resuming these run on the next
+		 * submission, so that other work items get a chance to run.
+		 */
+		batch = self->ready_;
+		sys_slist_init(&self->ready_);
+		k_spin_unlock(&self->lock_, key);
+
+		while ((node = sys_slist_get(&batch)) != NULL) {
+			CONTAINER_OF(node, detail::ready_node, node)->handle.resume();
+		}
+	}
+
+	struct k_work work_;
+	struct k_work_q *queue_;
+	sys_slist_t ready_;
+	struct k_spinlock lock_;
+};
+
+/**
+ * @brief Coroutine type
+ *
+ * A task does not run until it is awaited by another task, or started
+ * with executor::spawn(). When the frame of a task cannot be allocated,
+ * the returned task is not valid().
+ *
+ * @tparam T Type of the value returned by the coroutine.
+ */
+template <typename T = void> class [[nodiscard]] task {
+public:
+	struct promise_type : detail::promise_base, detail::promise_result<T> {
+		task get_return_object() noexcept
+		{
+			return task(handle_type::from_promise(*this));
+		}
+
+		static task get_return_object_on_allocation_failure() noexcept
+		{
+			return task();
+		}
+	};
+
+	using handle_type = std::coroutine_handle<promise_type>;
+
+	task() noexcept = default;
+
+	task(task &&other) noexcept : handle_(std::exchange(other.handle_, nullptr))
+	{
+	}
+
+	task &operator=(task &&other) noexcept
+	{
+		if (this != &other) {
+			if (handle_) {
+				handle_.destroy();
+			}
+			handle_ = std::exchange(other.handle_, nullptr);
+		}
+
+		return *this;
+	}
+
+	~task()
+	{
+		if (handle_) {
+			handle_.destroy();
+		}
+	}
+
+	/** @brief Whether the frame of the task was allocated */
+	bool valid() const noexcept
+	{
+		return static_cast<bool>(handle_);
+	}
+
+	/** @brief Release ownership of the coroutine frame */
+	handle_type release() noexcept
+	{
+		return std::exchange(handle_, nullptr);
+	}
+
+	auto operator co_await() noexcept
+	{
+		return awaiter{handle_};
+	}
+
+private:
+	struct awaiter {
+		handle_type handle;
+
+		bool await_ready() const noexcept
+		{
+			return !handle || handle.done();
+		}
+
+		/* Run the task right away, on the executor of the caller */
+		template <typename P>
+		std::coroutine_handle<> await_suspend(std::coroutine_handle<P> caller) noexcept
+		{
+			handle.promise().exec = caller.promise().exec;
+			handle.promise().continuation = caller;
+
+			return handle;
+		}
+
+		T await_resume() noexcept
+		{
+			if constexpr (!std::is_void_v<T>) {
+				__ASSERT(handle, "task frame was not allocated");
+
+				return std::move(*handle.promise().value);
+			}
+		}
+	};
+
+	explicit task(handle_type h) noexcept : handle_(h)
+	{
+	}
+
+	handle_type handle_;
+};
+
+inline int executor::spawn(task<void> &&t) noexcept
+{
+	task<void>::handle_type h = t.release();
+
+	if (!h) {
+		return -ENOMEM;
+	}
+
+	detail::promise_base &p = h.promise();
+
+	p.exec = this;
+	p.detached = true;
+	p.start.handle = h;
+	schedule(p.start);
+
+	return 0;
+}
+
+namespace detail {
+
+/* Waits for a k_poll event with a triggered work item, then runs a non
+ * blocking attempt on the executor's work queue. The attempt fails when
+ * another thread got the object first, the wait is then re-armed for the
+ * remaining time.
+ */
+struct poll_wait {
+	using attempt_fn = bool (*)(poll_wait &w);
+
+	struct k_work_poll work;
+	struct k_poll_event event;
+	ready_node ready;
+	executor *exec;
+	attempt_fn attempt;
+	/* Argument and output of the attempt */
+	void *arg;
+	void *out;
+	k_timeout_t timeout;
+	int64_t end;
+	/* Result when the object is not available and timeout is K_NO_WAIT */
+	int busy;
+	int result;
+
+	poll_wait(uint32_t type, void *obj, k_timeout_t timeout, attempt_fn attempt,
+		  void *arg, int busy) noexcept
+		: exec(nullptr), attempt(attempt), arg(arg), out(nullptr),
+		  timeout(timeout), end(0), busy(busy), result(0)
+	{
+		k_poll_event_init(&event, type, K_POLL_MODE_NOTIFY_ONLY, obj);
+	}
+
+	poll_wait(const poll_wait &) = delete;
+	poll_wait &operator=(const poll_wait &) = delete;
+
+	bool await_ready() noexcept
+	{
+		if (attempt(*this)) {
+			result = 0;
+			return true;
+		}
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			result = busy;
+			return true;
+		}
+
+		return false;
+	}
+
+	template <typename P> void await_suspend(std::coroutine_handle<P> h) noexcept
+	{
+		exec = h.promise().exec;
+		ready.handle = h;
+
+		if (!K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+#ifdef CONFIG_TIMEOUT_64BIT
+			if (Z_TICK_ABS(timeout.ticks) >= 0) {
+				end = Z_TICK_ABS(timeout.ticks);
+			} else
+#endif
+			{
+				end = k_uptime_ticks() + timeout.ticks;
+			}
+		}
+
+		k_work_poll_init(&work, handler);
+		arm(timeout);
+	}
+
+	int await_resume() const noexcept
+	{
+		return result;
+	}
+
+	void arm(k_timeout_t t) noexcept
+	{
+		event.state = K_POLL_STATE_NOT_READY;
+		(void)k_work_poll_submit_to_queue(exec->queue(), &work, &event, 1, t);
+	}
+
+	static void handler(struct k_work *item)
+	{
+		struct k_work_poll *pw = CONTAINER_OF(item, struct k_work_poll, work);
+		poll_wait *w = CONTAINER_OF(pw, poll_wait, work);
+		int64_t now = k_uptime_ticks();
+
+		if (w->attempt(*w)) {
+			w->result = 0;
+		} else if (K_TIMEOUT_EQ(w->timeout, K_FOREVER)) {
+			w->arm(K_FOREVER);
+			return;
+		} else if (w->end > now) {
+			w->arm(K_TICKS(w->end - now));
+			return;
+		} else {
+			w->result = -EAGAIN;
+		}
+
+		w->exec->schedule(w->ready);
+	}
+};
+
+struct sleep_wait {
+	struct k_work_delayable work;
+	ready_node ready;
+	executor *exec;
+	k_timeout_t timeout;
+
+	explicit sleep_wait(k_timeout_t timeout) noexcept : exec(nullptr), timeout(timeout)
+	{
+	}
+
+	sleep_wait(const sleep_wait &) = delete;
+	sleep_wait &operator=(const sleep_wait &) = delete;
+
+	bool await_ready() const noexcept
+	{
+		return K_TIMEOUT_EQ(timeout, K_NO_WAIT);
+	}
+
+	template <typename P> void await_suspend(std::coroutine_handle<P> h) noexcept
+	{
+		exec = h.promise().exec;
+		ready.handle = h;
+		k_work_init_delayable(&work, handler);
+		(void)k_work_schedule_for_queue(exec->queue(), &work, timeout);
+	}
+
+	void await_resume() const noexcept
+	{
+	}
+
+	static void handler(struct k_work *item)
+	{
+		sleep_wait *w = CONTAINER_OF(k_work_delayable_from_work(item), sleep_wait, work);
+
+		w->exec->schedule(w->ready);
+	}
+};
+
+struct yield_wait {
+	ready_node ready;
+
+	yield_wait() noexcept = default;
+	yield_wait(const yield_wait &) = delete;
+	yield_wait &operator=(const yield_wait &) = delete;
+
+	bool await_ready() const noexcept
+	{
+		return false;
+	}
+
+	template <typename P> void await_suspend(std::coroutine_handle<P> h) noexcept
+	{
+		ready.handle = h;
+		h.promise().exec->schedule(ready);
+	}
+
+	void await_resume() const noexcept
+	{
+	}
+};
+
+} /* namespace detail */
+
+/**
+ * @brief Take a semaphore
+ *
+ * @code
+ * int ret = co_await zephyr::coro::sem_take(sem, K_MSEC(100));
+ * @endcode
+ *
+ * The awaited result is 0 once the semaphore is taken, -EBUSY if it is
+ * not available and @a timeout is K_NO_WAIT, or -EAGAIN on timeout.
+ */
+inline detail::poll_wait sem_take(struct k_sem &sem, k_timeout_t timeout = K_FOREVER) noexcept
+{
+	return detail::poll_wait(
+		K_POLL_TYPE_SEM_AVAILABLE, &sem, timeout,
+		[](detail::poll_wait &w) { return k_sem_take(w.event.sem, K_NO_WAIT) == 0; },
+		nullptr, -EBUSY);
+}
+
+/**
+ * @brief Receive a message from a message queue
+ *
+ * The awaited result is 0 once a message is copied to @a data, -ENOMSG
+ * if the queue is empty and @a timeout is K_NO_WAIT, or -EAGAIN on
+ * timeout.
+ */
+inline detail::poll_wait msgq_get(struct k_msgq &msgq, void *data,
+				  k_timeout_t timeout = K_FOREVER) noexcept
+{
+	return detail::poll_wait(
+		K_POLL_TYPE_MSGQ_DATA_AVAILABLE, &msgq, timeout,
+		[](detail::poll_wait &w) { return k_msgq_get(w.event.msgq, w.arg, K_NO_WAIT) == 0; },
+		data, -ENOMSG);
+}
+
+/**
+ * @brief Wait for a poll signal to be raised
+ *
+ * The signal is left raised, reset it with k_poll_signal_reset() before
+ * waiting for it again. The awaited result is 0 once the signal is
+ * raised, with its result stored in @a result, -EBUSY if it is not
+ * raised and @a timeout is K_NO_WAIT, or -EAGAIN on timeout.
+ */
+inline detail::poll_wait signal_wait(struct k_poll_signal &signal, int *result = nullptr,
+				     k_timeout_t timeout = K_FOREVER) noexcept
+{
+	return detail::poll_wait(
+		K_POLL_TYPE_SIGNAL, &signal, timeout,
+		[](detail::poll_wait &w) {
+			unsigned int signaled;
+			int res;
+
+			k_poll_signal_check(w.event.signal, &signaled, &res);
+			if (signaled != 0U && w.arg != nullptr) {
+				*static_cast<int *>(w.arg) = res;
+			}
+
+			return signaled != 0U;
+		},
+		result, -EBUSY);
+}
+
+/** @brief Suspend the coroutine for @a timeout */
+inline detail::sleep_wait sleep(k_timeout_t timeout) noexcept
+{
+	return detail::sleep_wait(timeout);
+}
+
+/** @brief Let the other work items and coroutines of the work queue run */
+inline detail::yield_wait yield() noexcept
+{
+	return detail::yield_wait();
+}
+
+#if defined(CONFIG_RTIO_CONSUME_SEM) || defined(__DOXYGEN__)
+namespace detail {
+
+struct rtio_wait : poll_wait {
+	using poll_wait::poll_wait;
+
+	struct rtio_cqe *await_resume() const noexcept
+	{
+		return (result == 0) ? static_cast<struct rtio_cqe *>(out) : nullptr;
+	}
+};
+
+} /* namespace detail */
+
+/**
+ * @brief Wait for an RTIO completion
+ *
+ * The awaited result is the consumed completion queue event, or NULL on
+ * timeout. Requires CONFIG_RTIO_CONSUME_SEM.
+ */
+inline detail::rtio_wait rtio_cqe_wait(struct rtio &r, k_timeout_t timeout = K_FOREVER) noexcept
+{
+	return detail::rtio_wait(
+		K_POLL_TYPE_SEM_AVAILABLE, r.consume_sem, timeout,
+		[](detail::poll_wait &w) {
+			/* Consume the wakeup, the queue is checked either way */
+			(void)k_sem_take(w.event.sem, K_NO_WAIT);
+			w.out = rtio_cqe_consume(static_cast<struct rtio *>(w.arg));
+
+			return w.out != nullptr;
+		},
+		&r, -EBUSY);
+}
+#endif /* CONFIG_RTIO_CONSUME_SEM */
+
+} /* namespace zephyr::coro */
+
+/** @} */
+
+#endif /* ZEPHYR_INCLUDE_CPP_CORO_HPP_ */
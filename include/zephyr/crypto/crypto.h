@@ -216,6 +216,13 @@ static inline int cipher_free_session(const struct device *dev,
  * cipher_do_op(). Based on crypto device hardware semantics, this is likely to
  * be invoked from an ISR context.
  *
+ * In sessions set up with CAP_ASYNC_OPS, the cipher_xxx_op() calls only queue
+ * the packet, so a driver may have several packets in flight, possibly from
+ * several sessions. The packets and the buffers they point to must then stay
+ * valid until their completion callback, and a session must not be freed
+ * while it has packets in flight. When its queue is full, a driver fails the
+ * cipher_xxx_op() call with -EBUSY.
+ *
  * @param  dev   Pointer to the device structure for the driver instance.
  * @param  cb    Pointer to application callback to be called by the driver.
  *
@@ -133,6 +133,55 @@ struct json_obj_descr {
 typedef int (*json_append_bytes_t)(const char *bytes, size_t len,
 				   void *data);
 
+/** Maximum nesting depth of objects and arrays in a streaming parse. */
+#define JSON_STREAM_MAX_DEPTH 32
+
+/**
+ * @brief Token returned by the streaming parser
+ *
+ * Strings are returned without their quotes and with escape sequences left
+ * as they appear in the input. Numbers and the true, false and null literals
+ * are returned as their textual representation. Object and array delimiters
+ * point to the delimiter character.
+ *
+ * The slice points into the chunk given to json_stream_feed(), unless the
+ * token spans several chunks, in which case it points into the buffer given
+ * to json_stream_init(). It remains valid until the next call to
+ * json_stream_next() or json_stream_feed().
+ */
+struct json_stream_token {
+	enum json_tokens type;
+	/** True if the token is the name of an object member. */
+	bool key;
+	const char *start;
+	size_t length;
+};
+
+/**
+ * @brief Streaming parser context
+ *
+ * The memory used by a streaming parse is this structure plus the buffer
+ * given to json_stream_init(), regardless of the size of the document.
+ * All fields are private.
+ */
+struct json_stream {
+	const char *pos;
+	const char *end;
+	char *buf;
+	size_t buf_size;
+	size_t buf_len;
+	/* One bit per nesting level, set if the level is an array. */
+	uint32_t stack;
+	uint8_t depth;
+	uint8_t expect;
+	/* Type of the incomplete token held in buf, or 0. */
+	uint8_t partial;
+	bool key;
+	bool escape;
+	bool last;
+	bool done;
+};
+
 #define Z_ALIGN_SHIFT(type)	(__alignof__(type) == 1 ? 0 : \
 				 __alignof__(type) == 2 ? 1 : \
 				 __alignof__(type) == 4 ? 2 : 3)
@@ -758,6 +807,99 @@ int json_obj_encode(const struct json_obj_descr *descr, size_t descr_len,
 int json_arr_encode(const struct json_obj_descr *descr, const void *val,
 		    json_append_bytes_t append_bytes, void *data);
 
+/**
+ * @brief Encodes an object using an arbitrary writer function, batching
+ * the output
+ *
+ * Unlike json_obj_encode(), which calls @p append_bytes for every token,
+ * the output is gathered in @p buffer and only handed to @p append_bytes
+ * once the buffer is full and at the end of the encoding.
+ *
+ * @param descr Pointer to the descriptor array
+ * @param descr_len Number of elements in the descriptor array
+ * @param val Struct holding the values
+ * @param append_bytes Function to append bytes to the output
+ * @param data Data pointer to be passed to the append_bytes callback
+ * function.
+ * @param buffer Buffer used to batch the output
+ * @param buf_size Size of buffer, in bytes
+ *
+ * @return 0 if object has been successfully encoded. A negative value
+ * indicates an error.
+ */
+int json_obj_encode_buffered(const struct json_obj_descr *descr, size_t descr_len,
+			     const void *val, json_append_bytes_t append_bytes,
+			     void *data, char *buffer, size_t buf_size);
+
+/**
+ * @brief Encodes an array using an arbitrary writer function, batching
+ * the output
+ *
+ * @param descr Pointer to the descriptor array
+ * @param val Struct holding the values
+ * @param append_bytes Function to append bytes to the output
+ * @param data Data pointer to be passed to the append_bytes callback
+ * function.
+ * @param buffer Buffer used to batch the output
+ * @param buf_size Size of buffer, in bytes
+ *
+ * @return 0 if array has been successfully encoded. A negative value
+ * indicates an error.
+ *
+ * @see json_obj_encode_buffered()
+ */
+int json_arr_encode_buffered(const struct json_obj_descr *descr, const void *val,
+			     json_append_bytes_t append_bytes, void *data,
+			     char *buffer, size_t buf_size);
+
+/**
+ * @brief Initializes a streaming parser
+ *
+ * The streaming parser reads a JSON document fed in chunks of arbitrary
+ * size, and returns its tokens one at a time, without requiring the whole
+ * document to be in memory.
+ *
+ * @param js Parser context
+ * @param buf Buffer holding tokens that span several chunks, or NULL if
+ * every chunk holds complete tokens
+ * @param buf_size Size of buf, in bytes. This bounds the length of a string,
+ * number or literal that may span several chunks.
+ */
+void json_stream_init(struct json_stream *js, char *buf, size_t buf_size);
+
+/**
+ * @brief Feeds the next chunk of input to a streaming parser
+ *
+ * The chunk must remain valid until json_stream_next() returns -EAGAIN or
+ * the parse ends, as returned tokens point into it.
+ *
+ * @param js Parser context
+ * @param data Chunk of the JSON document
+ * @param len Size of the chunk, in bytes
+ * @param last True if this is the last chunk of the document
+ *
+ * @return 0 on success, or -EBUSY if the previous chunk was not fully
+ * consumed yet.
+ */
+int json_stream_feed(struct json_stream *js, const char *data, size_t len,
+		     bool last);
+
+/**
+ * @brief Gets the next token from a streaming parser
+ *
+ * @param js Parser context
+ * @param tok Returned token
+ *
+ * @retval 0 if a token has been returned.
+ * @retval -EAGAIN if the chunk has been consumed and json_stream_feed() must
+ * be called with the next one.
+ * @retval -ENODATA if the document has been completely parsed.
+ * @retval -EINVAL if the document is malformed.
+ * @retval -ENOMEM if a token spanning several chunks does not fit in the
+ * buffer, or the document is nested deeper than JSON_STREAM_MAX_DEPTH.
+ */
+int json_stream_next(struct json_stream *js, struct json_stream_token *tok);
+
 #ifdef __cplusplus
 }
 #endif
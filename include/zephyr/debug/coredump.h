@@ -114,6 +114,16 @@ struct coredump_cmd_copy_arg {
 #define	COREDUMP_MEM_HDR_ID		'M'
 #define COREDUMP_MEM_HDR_VER		1
 
+/*
+ * Memory block whose content is run-length encoded: each control byte
+ * below 0x80 is followed by that many plus one literal bytes, and each
+ * other control byte is followed by one byte repeated the control byte
+ * minus 0x80 plus COREDUMP_RLE_MIN_RUN times. The encoded data decodes
+ * to exactly end - start bytes.
+ */
+#define COREDUMP_MEM_HDR_VER_RLE	2
+#define COREDUMP_RLE_MIN_RUN		3
+
 /* Target code */
 enum coredump_tgt_code {
 	COREDUMP_TGT_UNKNOWN = 0,
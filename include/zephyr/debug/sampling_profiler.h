@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_DEBUG_SAMPLING_PROFILER_H_
+#define ZEPHYR_INCLUDE_DEBUG_SAMPLING_PROFILER_H_
+
+#include <zephyr/kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @defgroup sampling_profiler Sampling profiler
+ *  @brief Statistical profiler sampling the interrupted context
+ *
+ *  A periodic kernel timer records the thread and, where the architecture
+ *  allows it, the program counter and link register of the context
+ *  interrupted by the system clock interrupt. Samples can be dumped and
+ *  converted to a flame graph on the host using
+ *  scripts/profiling/sampling_profiler.py.
+ *  @{
+ */
+
+/** @brief Profiler sample. */
+struct sampling_profiler_sample {
+	/** Interrupted thread. */
+	k_tid_t thread;
+	/** Interrupted program counter, 0 if not available. */
+	uintptr_t pc;
+	/** Interrupted link register, 0 if not available. */
+	uintptr_t lr;
+};
+
+/** @brief Sample callback function.
+ *
+ *  @param sample Sample.
+ *  @param user_data User data.
+ */
+typedef void (*sampling_profiler_cb)(const struct sampling_profiler_sample *sample,
+				     void *user_data);
+
+/** @brief Start sampling.
+ *
+ *  Samples are appended to already collected samples. Samples which do not
+ *  fit in the buffer are counted as dropped.
+ *
+ *  @param period Sampling period. It is rounded up to the system tick.
+ *
+ *  @retval 0 on success.
+ *  @retval -EALREADY if sampling is already active.
+ */
+int sampling_profiler_start(k_timeout_t period);
+
+/** @brief Stop sampling. */
+void sampling_profiler_stop(void);
+
+/** @brief Discard all collected samples. */
+void sampling_profiler_reset(void);
+
+/** @brief Iterate over collected samples.
+ *
+ *  Sampling must be stopped.
+ *
+ *  @param cb Callback called for each sample.
+ *  @param user_data User data passed to the callback.
+ *
+ *  @return Number of samples, or -EBUSY if sampling is active.
+ */
+int sampling_profiler_foreach(sampling_profiler_cb cb, void *user_data);
+
+/** @brief Get the number of samples dropped because the buffer was full.
+ *
+ *  @return Number of dropped samples.
+ */
+uint32_t sampling_profiler_dropped_get(void);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_DEBUG_SAMPLING_PROFILER_H_ */
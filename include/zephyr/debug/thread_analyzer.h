@@ -7,6 +7,7 @@
 #ifndef __STACK_SIZE_ANALYZER_H
 #define __STACK_SIZE_ANALYZER_H
 #include <stddef.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -25,6 +26,8 @@ struct thread_analyzer_info {
 	 * if name is not set.
 	 */
 	const char *name;
+	/** The analyzed thread */
+	const struct k_thread *thread;
 	/** The total size of the stack*/
 	size_t stack_size;
 	/** Stack size in used */
@@ -62,6 +65,33 @@ void thread_analyzer_run(thread_analyzer_cb cb);
  */
 void thread_analyzer_print(void);
 
+/** @brief Binary report of the periodic thread analysis */
+struct thread_analyzer_record {
+	/** The analyzed thread */
+	const struct k_thread *thread;
+	/** System uptime of the analysis, in milliseconds */
+	uint32_t uptime_ms;
+	/** The total size of the stack */
+	uint32_t stack_size;
+	/** Stack size in use */
+	uint32_t stack_used;
+	/** CPU utilization in percent, 0 if runtime stats are disabled */
+	uint32_t utilization;
+};
+
+/** @brief Fetch the oldest record of the periodic thread analysis
+ *
+ *  Only available with CONFIG_THREAD_ANALYZER_AUTO_RING_BUFFER, where the
+ *  periodic analysis stores one record per thread in a ring buffer
+ *  instead of printing it.
+ *
+ *  @param record Where to store the record.
+ *
+ *  @retval 0 on success.
+ *  @retval -EAGAIN if no record is available.
+ */
+int thread_analyzer_record_get(struct thread_analyzer_record *record);
+
 /** @} */
 
 #ifdef __cplusplus
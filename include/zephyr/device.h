@@ -126,7 +126,10 @@ typedef int16_t device_handle_t;
  */
 #define Z_DEVICE_STATE_DEFINE(node_id, dev_name)			\
 	static struct device_state Z_DEVICE_STATE_NAME(dev_name)	\
-	__attribute__((__section__(".z_devstate")));
+	__attribute__((__section__(".z_devstate"))) = {			\
+		.lazy = IS_ENABLED(CONFIG_DEVICE_LAZY_INIT) &&		\
+			DT_PROP_OR(node_id, zephyr_lazy_init, 0),	\
+	};
 
 /**
  * @brief Create a device object and set it up for boot time initialization.
@@ -429,6 +432,16 @@ struct device_state {
 	 * invoked.
 	 */
 	bool initialized : 1;
+
+	/** Indicates the device is initialized on first use instead of
+	 * at boot, see @kconfig{CONFIG_DEVICE_LAZY_INIT}.
+	 */
+	bool lazy : 1;
+
+	/** Indicates the device initialization function is running, see
+	 * @kconfig{CONFIG_DEVICE_INIT_PARALLEL}.
+	 */
+	bool init_started : 1;
 };
 
 struct pm_device;
@@ -756,6 +769,9 @@ int device_supported_foreach(const struct device *dev,
  * this case, set a breakpoint on your device driver's initialization
  * function.)
  *
+ * Devices initialized lazily (see @kconfig{CONFIG_DEVICE_LAZY_INIT}) are
+ * initialized by this function if needed.
+ *
  * @param name device name to search for. A null pointer, or a pointer
  * to an empty string, will cause NULL to be returned.
  *
@@ -800,6 +816,9 @@ bool z_device_is_ready(const struct device *dev);
  * does not include the readiness checks of device_get_binding(). At minimum
  * this means that the device has been successfully initialized.
  *
+ * Devices initialized lazily (see @kconfig{CONFIG_DEVICE_LAZY_INIT}) are
+ * initialized by this function if needed, unless called from an ISR.
+ *
  * @param dev pointer to the device in question.
  *
  * @retval true If the device is ready for use.
@@ -838,7 +857,10 @@ static inline bool z_impl_device_is_ready(const struct device *dev)
  */
 #define Z_DEVICE_STATE_DEFINE(node_id, dev_name)			\
 	static struct device_state Z_DEVICE_STATE_NAME(dev_name)	\
-	__attribute__((__section__(".z_devstate")));
+	__attribute__((__section__(".z_devstate"))) = {			\
+		.lazy = IS_ENABLED(CONFIG_DEVICE_LAZY_INIT) &&		\
+			DT_PROP_OR(node_id, zephyr_lazy_init, 0),	\
+	};
 
 /* Construct objects that are referenced from struct device. These
  * include power management and dependency handles.
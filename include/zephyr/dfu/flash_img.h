@@ -17,6 +17,15 @@
 
 #include <zephyr/storage/stream_flash.h>
 
+#ifdef CONFIG_IMG_STREAMING_CHECK
+#if defined(CONFIG_FLASH_AREA_CHECK_INTEGRITY_TC)
+#include <tinycrypt/constants.h>
+#include <tinycrypt/sha256.h>
+#else
+#include <mbedtls/sha256.h>
+#endif
+#endif /* CONFIG_IMG_STREAMING_CHECK */
+
 /**
  * @brief Abstraction layer to write firmware images to flash
  *
@@ -28,10 +37,45 @@
 extern "C" {
 #endif
 
+#ifdef CONFIG_IMG_DELTA
+/** Delta patch applier state, see @ref flash_img_delta_write. */
+struct flash_img_delta {
+	const struct flash_area *source; /* Image the patch applies to */
+	uint8_t hdr[12];	/* Partially received header or record */
+	uint8_t hdr_len;	/* Number of bytes in hdr */
+	uint8_t state;		/* Parser state */
+	size_t target_size;	/* Size of the rebuilt image */
+	size_t produced;	/* Bytes of the rebuilt image written so far */
+	size_t diff_left;	/* Diff bytes left in the current record */
+	size_t extra_left;	/* Extra bytes left in the current record */
+	int32_t seek;		/* Source adjustment ending the current record */
+	off_t src_off;		/* Current source offset */
+	uint8_t src_buf[CONFIG_IMG_DELTA_BUF_SIZE];
+};
+#endif
+
 struct flash_img_context {
 	uint8_t buf[CONFIG_IMG_BLOCK_BUF_SIZE];
+#ifdef CONFIG_IMG_BLOCK_BUF_ASYNC
+	uint8_t buf_alt[CONFIG_IMG_BLOCK_BUF_SIZE];
+#endif
 	const struct flash_area *flash_area;
 	struct stream_flash_ctx stream;
+#ifdef CONFIG_IMG_STREAMING_CHECK
+#if defined(CONFIG_FLASH_AREA_CHECK_INTEGRITY_TC)
+	struct tc_sha256_state_struct sha;
+#else
+	mbedtls_sha256_context sha;
+#endif
+	uint8_t hash[32];	/* Digest of the written image */
+	size_t hash_len;	/* Number of bytes hashed */
+	int hash_rc;		/* First hashing error, if any */
+	bool hash_done;		/* hash holds the digest of the image */
+	uint8_t area_id;	/* Flash area the image was written to */
+#endif
+#ifdef CONFIG_IMG_DELTA
+	struct flash_img_delta delta;
+#endif
 };
 
 /**
@@ -55,6 +99,24 @@ struct flash_img_check {
  */
 int flash_img_init_id(struct flash_img_context *ctx, uint8_t area_id);
 
+/**
+ * @brief Initialize context needed for resuming an interrupted image write.
+ *
+ * Data is written starting at @p offset in the partition, the content
+ * before it is left as is. The offset shall be aligned to a flash page.
+ *
+ * The streaming image check does not cover data written before the
+ * offset, so flash_img_check() reads the whole image back in this case.
+ *
+ * @param ctx     context to be initialized
+ * @param area_id flash area id of partition where the image should be written
+ * @param offset  offset in the partition at which writing resumes
+ *
+ * @return  0 on success, negative errno code on fail
+ */
+int flash_img_init_id_at(struct flash_img_context *ctx, uint8_t area_id,
+			 size_t offset);
+
 /**
  * @brief Initialize context needed for writing the image to the flash.
  *
@@ -67,6 +129,9 @@ int flash_img_init(struct flash_img_context *ctx);
 /**
  * @brief Read number of bytes of the image written to the flash.
  *
+ * For a context initialized with flash_img_init_id_at(), only the bytes
+ * written after the resume offset are counted.
+ *
  * @param ctx context
  *
  * @return Number of bytes written to the image flash.
@@ -93,12 +158,65 @@ size_t flash_img_bytes_written(struct flash_img_context *ctx);
 int flash_img_buffered_write(struct flash_img_context *ctx, const uint8_t *data,
 		    size_t len, bool flush);
 
+/**
+ * @brief Initialize context needed for writing an image from a delta patch.
+ *
+ * The patch is applied against the image in @p source_area_id, which must
+ * not be modified until the new image has been written.
+ *
+ * The function is enabled via CONFIG_IMG_DELTA Kconfig option.
+ *
+ * @param ctx            context to be initialized
+ * @param area_id        flash area id of partition where the image should be
+ *                       written
+ * @param source_area_id flash area id of partition holding the image the
+ *                       patch was created against
+ *
+ * @return  0 on success, negative errno code on fail
+ */
+int flash_img_delta_init(struct flash_img_context *ctx, uint8_t area_id,
+			 uint8_t source_area_id);
+
+/**
+ * @brief Process a delta patch in chunks of any size.
+ *
+ * The image rebuilt from the patch is written with
+ * @ref flash_img_buffered_write. The patch is a sequence of little endian
+ * fields:
+ *
+ * - header: the magic "ZDLT" and the uint32_t size of the new image;
+ * - records until the new image is complete: uint32_t diff length,
+ *   uint32_t extra length and int32_t seek, followed by diff length bytes
+ *   that are added bytewise to the source image at the current source
+ *   offset, and extra length bytes that are copied as they are. The source
+ *   offset advances by the diff length and then by seek.
+ *
+ * This is the bsdiff control scheme with the compression stage left out.
+ *
+ * The function is enabled via CONFIG_IMG_DELTA Kconfig option.
+ *
+ * @param ctx   context
+ * @param data  patch data
+ * @param len   Number of bytes of patch data
+ * @param flush when true the patch must be complete, and the new image is
+ *              flushed to flash
+ *
+ * @return  0 on success, -EINVAL on a malformed or truncated patch, other
+ * negative errno code on fail
+ */
+int flash_img_delta_write(struct flash_img_context *ctx, const uint8_t *data,
+			  size_t len, bool flush);
+
 /**
  * @brief  Verify flash memory length bytes integrity from a flash area. The
  * start point is indicated by an offset value.
  *
  * The function is enabled via CONFIG_IMG_ENABLE_IMAGE_CHECK Kconfig options.
  *
+ * With CONFIG_IMG_STREAMING_CHECK, when @p ctx is the context that wrote
+ * the complete image of @p fic clen bytes to @p area_id, the digest computed
+ * while writing is compared and the image is not read back.
+ *
  * @param[in] ctx context.
  * @param[in] fic flash img check data.
  * @param[in] area_id flash area id of partition where the image should be
@@ -246,6 +246,17 @@ int boot_request_upgrade(int permanent);
  */
 int boot_request_upgrade_multi(int image_index, int permanent);
 
+/**
+ * @brief Drop the cached image state.
+ *
+ * With CONFIG_MCUBOOT_IMG_STATE_CACHE the swap type and confirmation state
+ * are read from the image trailers once and cached. The routines in this
+ * API keep the cache up to date; code modifying an image slot by other
+ * means shall call this routine afterwards. It does nothing if the cache
+ * is disabled.
+ */
+void boot_img_state_invalidate(void);
+
 /**
  * @brief Erase the image Bank.
  *
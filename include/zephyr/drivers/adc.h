@@ -550,6 +550,53 @@ struct adc_sequence {
 	bool calibrate;
 };
 
+/**
+ * @brief Type definition of the callback function called with a filled half
+ *        of a stream buffer.
+ *
+ * The callback is called from interrupt context. The half of the buffer is
+ * owned by the callback until the other half is filled.
+ *
+ * @param dev        Pointer to the device structure for the driver instance.
+ * @param buffer     Pointer to the filled half of the buffer. Samples are
+ *                   stored in the same format as adc_read() writes them.
+ * @param size       Size of the filled half of the buffer, in bytes.
+ * @param timestamp  Value of k_cycle_get_32() when the last sample of the
+ *                   half was stored.
+ * @param user_data  User data provided in struct adc_stream_config.
+ */
+typedef void (*adc_stream_callback)(const struct device *dev, void *buffer,
+				    size_t size, uint32_t timestamp,
+				    void *user_data);
+
+/**
+ * @brief Structure defining a continuous sampling stream.
+ */
+struct adc_stream_config {
+	/** Bit-mask of the channels to sample, see struct adc_sequence. */
+	uint32_t channels;
+
+	/**
+	 * Buffer the samples are written to. The two halves of it are filled
+	 * in turn, for as long as the stream runs.
+	 */
+	void *buffer;
+
+	/** Size of the buffer, in bytes. */
+	size_t buffer_size;
+
+	/** ADC resolution, see struct adc_sequence. */
+	uint8_t resolution;
+
+	/** Oversampling setting, see struct adc_sequence. */
+	uint8_t oversampling;
+
+	/** Callback called with each filled half of the buffer. */
+	adc_stream_callback callback;
+
+	/** User data passed to the callback. */
+	void *user_data;
+};
 
 /**
  * @brief Type definition of ADC API function for configuring a channel.
@@ -574,6 +621,19 @@ typedef int (*adc_api_read_async)(const struct device *dev,
 				  const struct adc_sequence *sequence,
 				  struct k_poll_signal *async);
 
+/**
+ * @brief Type definition of ADC API function for starting a stream.
+ * See adc_stream_start() for argument descriptions.
+ */
+typedef int (*adc_api_stream_start)(const struct device *dev,
+				    const struct adc_stream_config *config);
+
+/**
+ * @brief Type definition of ADC API function for stopping a stream.
+ * See adc_stream_stop() for argument descriptions.
+ */
+typedef int (*adc_api_stream_stop)(const struct device *dev);
+
 /**
  * @brief ADC driver API
  *
@@ -584,6 +644,10 @@ __subsystem struct adc_driver_api {
 	adc_api_read          read;
 #ifdef CONFIG_ADC_ASYNC
 	adc_api_read_async    read_async;
+#endif
+#ifdef CONFIG_ADC_STREAM
+	adc_api_stream_start  stream_start;
+	adc_api_stream_stop   stream_stop;
 #endif
 	uint16_t ref_internal;	/* mV */
 };
@@ -700,6 +764,68 @@ static inline int z_impl_adc_read_async(const struct device *dev,
 }
 #endif /* CONFIG_ADC_ASYNC */
 
+#if defined(CONFIG_ADC_STREAM) || defined(__DOXYGEN__)
+/**
+ * @brief Start a continuous sampling stream.
+ *
+ * @note This function is available only if @kconfig{CONFIG_ADC_STREAM}
+ * is selected.
+ *
+ * The selected channels are sampled as fast as the converter and its
+ * trigger configuration allow, without involving the CPU per sample. The
+ * halves of the buffer are filled in turn, the callback being called with
+ * each filled half. The ADC cannot be used for other reads until the stream
+ * is stopped with adc_stream_stop().
+ *
+ * @param dev     Pointer to the device structure for the driver instance.
+ * @param config  Stream configuration.
+ *
+ * @retval 0        On success.
+ * @retval -EINVAL  If a parameter with an invalid value has been provided.
+ * @retval -EBUSY   If a stream is already running.
+ * @retval -ENOTSUP If streaming is not supported by the driver or with the
+ *                  requested configuration.
+ */
+static inline int adc_stream_start(const struct device *dev,
+				   const struct adc_stream_config *config)
+{
+	const struct adc_driver_api *api =
+				(const struct adc_driver_api *)dev->api;
+
+	if (api->stream_start == NULL) {
+		return -ENOTSUP;
+	}
+
+	return api->stream_start(dev, config);
+}
+
+/**
+ * @brief Stop a continuous sampling stream.
+ *
+ * @note This function is available only if @kconfig{CONFIG_ADC_STREAM}
+ * is selected.
+ *
+ * The callback is not called anymore once this function returns.
+ *
+ * @param dev     Pointer to the device structure for the driver instance.
+ *
+ * @retval 0        On success.
+ * @retval -EALREADY If no stream is running.
+ * @retval -ENOTSUP If streaming is not supported by the driver.
+ */
+static inline int adc_stream_stop(const struct device *dev)
+{
+	const struct adc_driver_api *api =
+				(const struct adc_driver_api *)dev->api;
+
+	if (api->stream_stop == NULL) {
+		return -ENOTSUP;
+	}
+
+	return api->stream_stop(dev);
+}
+#endif /* CONFIG_ADC_STREAM */
+
 /**
  * @brief Get the internal reference voltage.
  *
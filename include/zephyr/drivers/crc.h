@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Public API for CRC calculation unit drivers
+ */
+
+#ifndef ZEPHYR_INCLUDE_DRIVERS_CRC_H_
+#define ZEPHYR_INCLUDE_DRIVERS_CRC_H_
+
+/**
+ * @brief CRC calculation unit Interface
+ * @defgroup crc_interface CRC calculation unit Interface
+ * @ingroup io_interfaces
+ * @{
+ */
+
+#include <errno.h>
+#include <zephyr/device.h>
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @cond INTERNAL_HIDDEN
+ *
+ * For internal driver use only, skip these in public documentation.
+ */
+
+/**
+ * API template to update a CRC-32 (IEEE 802.3).
+ *
+ * @see crc_crc32_ieee_update
+ */
+typedef int (*crc_api_crc32_ieee_update)(const struct device *dev, uint32_t crc,
+					 const uint8_t *data, size_t len,
+					 uint32_t *result);
+
+__subsystem struct crc_driver_api {
+	crc_api_crc32_ieee_update crc32_ieee_update;
+};
+
+/**
+ * @endcond
+ */
+
+/**
+ * @brief Update a CRC-32 (IEEE 802.3) using a CRC calculation unit
+ *
+ * This computes the same value as crc32_ieee_update(). The call may block
+ * while another thread is using the calculation unit, so it must not be
+ * used from an interrupt context.
+ *
+ * @param dev CRC calculation unit device.
+ * @param crc CRC computed so far, 0 to start a new computation.
+ * @param data Input bytes.
+ * @param len Length of the input, in bytes.
+ * @param result Updated CRC.
+ *
+ * @retval 0 on success.
+ * @retval -ENOTSUP if the device does not support CRC-32 (IEEE 802.3).
+ * @retval -errno Other negative errno code on failure.
+ */
+static inline int crc_crc32_ieee_update(const struct device *dev, uint32_t crc,
+					const uint8_t *data, size_t len,
+					uint32_t *result)
+{
+	const struct crc_driver_api *api =
+		(const struct crc_driver_api *)dev->api;
+
+	if (api->crc32_ieee_update == NULL) {
+		return -ENOTSUP;
+	}
+
+	return api->crc32_ieee_update(dev, crc, data, len, result);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_DRIVERS_CRC_H_ */
@@ -75,6 +75,14 @@ struct disk_info {
 	const struct disk_operations *ops;
 	/** Device associated to this disk */
 	const struct device *dev;
+#if defined(CONFIG_DISK_ACCESS_CACHE) || defined(__DOXYGEN__)
+	/** Sector count, zero if the disk is not cached, internally used */
+	uint32_t cache_sector_cnt;
+	/** Sector following the last one read, internally used */
+	uint32_t cache_next_sector;
+	/** Disk geometry has been probed by the cache, internally used */
+	bool cache_probed;
+#endif
 };
 
 /**
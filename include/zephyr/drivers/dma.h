@@ -328,6 +328,10 @@ static inline int dma_config(const struct device *dev, uint32_t channel,
 /**
  * @brief Reload buffer(s) for a DMA channel
  *
+ * The channel keeps the configuration applied with dma_config(), only the
+ * addresses and size of the transfer are replaced. For repeated transfers
+ * this is much cheaper than configuring the channel again.
+ *
  * @param dev     Pointer to the device structure for the driver instance.
  * @param channel Numeric identification of the channel to configure
  *                selected channel
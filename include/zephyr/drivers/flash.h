@@ -420,6 +420,72 @@ static inline const struct flash_parameters *z_impl_flash_get_parameters(const s
 	return api->get_parameters(dev);
 }
 
+/** @brief Asynchronous flash request operations */
+enum flash_async_op {
+	/** Read from flash */
+	FLASH_ASYNC_OP_READ,
+	/** Write to flash */
+	FLASH_ASYNC_OP_WRITE,
+	/** Erase flash */
+	FLASH_ASYNC_OP_ERASE,
+};
+
+struct flash_async_req;
+
+/**
+ * @brief Asynchronous flash request completion callback
+ *
+ * Called from the flash request work queue once the request has completed.
+ * The request may be resubmitted from the callback.
+ *
+ * @param req Completed request, with @a result set
+ */
+typedef void (*flash_async_cb_t)(struct flash_async_req *req);
+
+/**
+ * @brief Asynchronous flash request
+ *
+ * The request is owned by the flash request queue from submission until its
+ * callback is called, and must not be modified in between.
+ */
+struct flash_async_req {
+	/** Internally used queue node */
+	sys_snode_t node;
+	/** Flash device */
+	const struct device *dev;
+	/** Requested operation */
+	enum flash_async_op op;
+	/** Offset within the flash device */
+	off_t offset;
+	/** Buffer to read to or write from, unused for erase */
+	void *data;
+	/** Number of bytes to read, write or erase */
+	size_t size;
+	/** Completion callback */
+	flash_async_cb_t cb;
+	/** Result of the request, 0 on success, negative errno code on fail */
+	int result;
+	/** Opaque user data, not used by the flash request queue */
+	void *user_data;
+};
+
+/**
+ * @brief Submit an asynchronous flash request
+ *
+ * Queues the request and returns immediately. Requests are executed in
+ * submission order by a dedicated work queue, using the regular, blocking
+ * flash API of the device. This lets the caller prepare data, or queue the
+ * erase of the next area, while earlier requests are in progress.
+ *
+ * @note Requires CONFIG_FLASH_ASYNC.
+ *
+ * @param req Request to submit
+ *
+ * @retval 0 on success
+ * @retval -EINVAL if the request is invalid
+ */
+int flash_async_submit(struct flash_async_req *req);
+
 #ifdef __cplusplus
 }
 #endif
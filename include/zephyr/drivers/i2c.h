@@ -21,6 +21,9 @@
 
 #include <zephyr/types.h>
 #include <zephyr/device.h>
+#ifdef CONFIG_I2C_RTIO
+#include <zephyr/rtio/rtio.h>
+#endif /* CONFIG_I2C_RTIO */
 
 #ifdef __cplusplus
 extern "C" {
@@ -737,6 +740,74 @@ static inline int i2c_transfer_signal(const struct device *dev,
 
 #endif /* CONFIG_I2C_CALLBACK */
 
+#if defined(CONFIG_I2C_RTIO) || defined(__DOXYGEN__)
+
+/**
+ * @brief RTIO IO device of an I2C target
+ *
+ * Each RTIO_OP_TX or RTIO_OP_RX submission queue entry is one I2C message,
+ * transferred with i2c_transfer_cb(). An entry chained with
+ * RTIO_SQE_CHAINED to an entry of the same IO device is not terminated by
+ * a stop condition, the next one starts with a repeated start, so that a
+ * register write followed by a read forms a single bus transaction.
+ *
+ * Entries are started from the completion callback of the previous one,
+ * so a queue of transactions to different targets of a bus is executed
+ * from the controller interrupt without thread wakeups. An entry submitted
+ * while the controller is busy with a transfer made outside of RTIO fails
+ * with -EWOULDBLOCK.
+ *
+ * An IO device serves one RTIO context at a time.
+ *
+ * @note This is available only if @kconfig{CONFIG_I2C_RTIO} is selected.
+ */
+struct i2c_iodev {
+	/** RTIO IO device, must be the first member */
+	struct rtio_iodev iodev;
+	/** I2C bus */
+	const struct device *bus;
+	/** Target address */
+	uint16_t addr;
+	/** @cond INTERNAL_HIDDEN */
+	const struct rtio_sqe *sqe;
+	struct rtio *r;
+	struct i2c_msg msg;
+	bool restart;
+	/** @endcond */
+};
+
+/** @cond INTERNAL_HIDDEN */
+extern const struct rtio_iodev_api i2c_iodev_api;
+/** @endcond */
+
+/**
+ * @brief Define a RTIO IO device for an I2C target
+ *
+ * @param name Name of the IO device.
+ * @param bus_ Pointer to the device structure of the I2C controller.
+ * @param addr_ Address of the target.
+ */
+#define I2C_IODEV_DEFINE(name, bus_, addr_)				\
+	static struct i2c_iodev name = {				\
+		.iodev = {						\
+			.api = &i2c_iodev_api,				\
+		},							\
+		.bus = (bus_),						\
+		.addr = (addr_),					\
+	}
+
+/**
+ * @brief Define a RTIO IO device for an I2C target from devicetree
+ *
+ * @param name Name of the IO device.
+ * @param node_id Devicetree node identifier of the I2C target.
+ */
+#define I2C_DT_IODEV_DEFINE(name, node_id)				\
+	I2C_IODEV_DEFINE(name, DEVICE_DT_GET(DT_BUS(node_id)),		\
+			 DT_REG_ADDR(node_id))
+
+#endif /* CONFIG_I2C_RTIO */
+
 /**
  * @brief Perform data transfer to another I2C device in controller mode.
  *
@@ -309,6 +309,50 @@ struct i2s_config {
 	int32_t timeout;
 };
 
+/**
+ * @brief Callback called by a period stream each time a period completes.
+ *
+ * The callback is called from interrupt context. For an RX stream, the
+ * period holds the received data. For a TX stream, the period was played
+ * and is to be filled with new data. The period is owned by the callback
+ * until the stream wraps around to it again.
+ *
+ * @param dev        Pointer to the device structure for the driver instance.
+ * @param dir        Stream direction, I2S_DIR_RX or I2S_DIR_TX.
+ * @param period     Pointer to the completed period.
+ * @param size       Size of the period, in bytes.
+ * @param timestamp  Value of k_cycle_get_32() when the period completed.
+ * @param user_data  User data provided in struct i2s_stream_config.
+ */
+typedef void (*i2s_stream_callback)(const struct device *dev,
+				    enum i2s_dir dir, void *period,
+				    size_t size, uint32_t timestamp,
+				    void *user_data);
+
+/**
+ * @brief Structure defining a period stream.
+ */
+struct i2s_stream_config {
+	/**
+	 * Buffer split into periods, transferred in turn for as long as the
+	 * stream runs. For a TX stream, it must hold valid data when the
+	 * stream starts.
+	 */
+	void *buffer;
+
+	/** Size of the buffer, a multiple of the period size, in bytes. */
+	size_t buffer_size;
+
+	/** Size of one period, in bytes. */
+	size_t period_size;
+
+	/** Callback called with each completed period. */
+	i2s_stream_callback callback;
+
+	/** User data passed to the callback. */
+	void *user_data;
+};
+
 /**
  * @cond INTERNAL_HIDDEN
  *
@@ -323,6 +367,11 @@ __subsystem struct i2s_driver_api {
 	int (*write)(const struct device *dev, void *mem_block, size_t size);
 	int (*trigger)(const struct device *dev, enum i2s_dir dir,
 		       enum i2s_trigger_cmd cmd);
+#ifdef CONFIG_I2S_STREAM
+	int (*stream_start)(const struct device *dev, enum i2s_dir dir,
+			    const struct i2s_stream_config *config);
+	int (*stream_stop)(const struct device *dev, enum i2s_dir dir);
+#endif
 };
 /**
  * @endcond
@@ -532,6 +581,76 @@ static inline int z_impl_i2s_trigger(const struct device *dev,
 	return api->trigger(dev, dir, cmd);
 }
 
+#if defined(CONFIG_I2S_STREAM) || defined(__DOXYGEN__)
+/**
+ * @brief Start a period stream.
+ *
+ * @note This function is available only if @kconfig{CONFIG_I2S_STREAM}
+ * is selected.
+ *
+ * The stream uses the settings given to i2s_configure(), except for the
+ * memory slab. Instead of queueing memory blocks, the periods of the
+ * buffer are transferred in turn by DMA, the callback being called from
+ * the DMA interrupt with each completed period. Data is never copied and
+ * the stream does not underrun as long as the callback keeps up with the
+ * periods. The direction cannot be triggered, read or written until the
+ * stream is stopped with i2s_stream_stop().
+ *
+ * @param dev     Pointer to the device structure for the driver instance.
+ * @param dir     Stream direction, I2S_DIR_RX or I2S_DIR_TX.
+ * @param config  Stream configuration.
+ *
+ * @retval 0        On success.
+ * @retval -EINVAL  If a parameter with an invalid value has been provided.
+ * @retval -EIO     If the direction is not configured.
+ * @retval -EBUSY   If the direction is already running.
+ * @retval -ENOSYS  If I2S_DIR_BOTH is given.
+ * @retval -ENOTSUP If streaming is not supported by the driver.
+ */
+static inline int i2s_stream_start(const struct device *dev,
+				   enum i2s_dir dir,
+				   const struct i2s_stream_config *config)
+{
+	const struct i2s_driver_api *api =
+		(const struct i2s_driver_api *)dev->api;
+
+	if (api->stream_start == NULL) {
+		return -ENOTSUP;
+	}
+
+	return api->stream_start(dev, dir, config);
+}
+
+/**
+ * @brief Stop a period stream.
+ *
+ * @note This function is available only if @kconfig{CONFIG_I2S_STREAM}
+ * is selected.
+ *
+ * The callback is not called anymore once this function returns and the
+ * direction is back in the READY state.
+ *
+ * @param dev     Pointer to the device structure for the driver instance.
+ * @param dir     Stream direction, I2S_DIR_RX or I2S_DIR_TX.
+ *
+ * @retval 0         On success.
+ * @retval -EALREADY If no stream is running in this direction.
+ * @retval -ENOSYS   If I2S_DIR_BOTH is given.
+ * @retval -ENOTSUP  If streaming is not supported by the driver.
+ */
+static inline int i2s_stream_stop(const struct device *dev, enum i2s_dir dir)
+{
+	const struct i2s_driver_api *api =
+		(const struct i2s_driver_api *)dev->api;
+
+	if (api->stream_stop == NULL) {
+		return -ENOTSUP;
+	}
+
+	return api->stream_stop(dev, dir);
+}
+#endif /* CONFIG_I2S_STREAM */
+
 /**
  * @}
  */
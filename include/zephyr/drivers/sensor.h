@@ -23,6 +23,10 @@
 #include <zephyr/device.h>
 #include <errno.h>
 
+#ifdef CONFIG_SENSOR_STREAM
+#include <zephyr/rtio/rtio.h>
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -312,6 +316,11 @@ enum sensor_attribute {
 	SENSOR_ATTR_FEATURE_MASK,
 	/** Alert threshold or alert enable/disable */
 	SENSOR_ATTR_ALERT,
+	/**
+	 * Number of frames buffered in the hardware FIFO before they are
+	 * delivered to the reader of a sensor stream.
+	 */
+	SENSOR_ATTR_FIFO_WATERMARK,
 
 	/**
 	 * Number of all common sensor attributes.
@@ -389,12 +398,86 @@ typedef int (*sensor_channel_get_t)(const struct device *dev,
 				    enum sensor_channel chan,
 				    struct sensor_value *val);
 
+#if defined(CONFIG_SENSOR_STREAM) || defined(__DOXYGEN__)
+/**
+ * @brief Decoder of the raw data blocks of a sensor stream
+ *
+ * A block holds consecutive frames, a frame being one sample of every
+ * channel enabled in the sensor FIFO. The layout of a block is private to
+ * the driver which produced it; it is only interpreted by the decoder of
+ * that driver. Decoded values are Q31 fixed point numbers in the unit of
+ * the channel, scaled by a power of two:
+ * value = q31 * 2^(shift - 31).
+ */
+struct sensor_decoder_api {
+	/**
+	 * @brief Get the number of frames in a block
+	 *
+	 * @param buf Block.
+	 * @param len Length of the block in bytes.
+	 * @param frame_count Where to store the number of frames.
+	 *
+	 * @return 0 if successful, negative errno code if the block is
+	 * malformed.
+	 */
+	int (*get_frame_count)(const uint8_t *buf, size_t len,
+			       uint16_t *frame_count);
+
+	/**
+	 * @brief Decode a channel of consecutive frames of a block
+	 *
+	 * Values of channels made of several axes, such as
+	 * @ref SENSOR_CHAN_ACCEL_XYZ, are stored interleaved, frame after
+	 * frame.
+	 *
+	 * @param buf Block.
+	 * @param len Length of the block in bytes.
+	 * @param chan Channel to decode.
+	 * @param first_frame Index of the first frame to decode.
+	 * @param max_count Maximum number of frames to decode.
+	 * @param values Where to store the decoded values.
+	 * @param shift Where to store the shift common to all values.
+	 *
+	 * @return Number of frames decoded, 0 past the last frame, or
+	 * negative errno code if failure.
+	 */
+	int (*decode)(const uint8_t *buf, size_t len, enum sensor_channel chan,
+		      uint16_t first_frame, uint16_t max_count, int32_t *values,
+		      int8_t *shift);
+};
+
+/**
+ * @typedef sensor_get_decoder_t
+ * @brief Callback API for getting the decoder of a sensor stream
+ *
+ * See sensor_get_decoder() for argument description
+ */
+typedef int (*sensor_get_decoder_t)(const struct device *dev,
+				    const struct sensor_decoder_api **decoder);
+
+/**
+ * @typedef sensor_stream_submit_t
+ * @brief Callback API for reading a block of a sensor stream
+ *
+ * The driver fills the buffer of the RTIO_OP_RX submission once its
+ * hardware FIFO reaches the watermark and completes the submission with
+ * the number of bytes written, using rtio_sqe_ok() or rtio_sqe_err().
+ */
+typedef void (*sensor_stream_submit_t)(const struct device *dev,
+				       const struct rtio_sqe *sqe,
+				       struct rtio *r);
+#endif /* CONFIG_SENSOR_STREAM || __DOXYGEN__ */
+
 __subsystem struct sensor_driver_api {
 	sensor_attr_set_t attr_set;
 	sensor_attr_get_t attr_get;
 	sensor_trigger_set_t trigger_set;
 	sensor_sample_fetch_t sample_fetch;
 	sensor_channel_get_t channel_get;
+#ifdef CONFIG_SENSOR_STREAM
+	sensor_get_decoder_t get_decoder;
+	sensor_stream_submit_t stream_submit;
+#endif
 };
 
 /**
@@ -691,6 +774,87 @@ static inline int sensor_value_from_double(struct sensor_value *val, double inp)
 	return 0;
 }
 
+#if defined(CONFIG_SENSOR_STREAM) || defined(__DOXYGEN__)
+/**
+ * @brief RTIO IO device streaming the hardware FIFO of a sensor
+ *
+ * Each RTIO_OP_RX submission to the IO device is completed with one block
+ * of raw frames, read from the sensor FIFO in a single bus transaction
+ * once the FIFO reaches its watermark (see
+ * @ref SENSOR_ATTR_FIFO_WATERMARK). The result of the completion is the
+ * number of bytes written to the buffer of the submission, which is
+ * decoded with the decoder returned by sensor_get_decoder().
+ *
+ * The sensor keeps buffering frames in its FIFO between completions, so
+ * no frame is lost as long as a new submission is made before the FIFO
+ * overflows.
+ */
+struct sensor_stream_iodev {
+	/** RTIO IO device, has to be the first member */
+	struct rtio_iodev iodev;
+
+	/** Sensor the blocks are read from */
+	const struct device *sensor;
+};
+
+/** @cond INTERNAL_HIDDEN */
+extern const struct rtio_iodev_api sensor_stream_iodev_api;
+/** @endcond */
+
+/**
+ * @brief Define an RTIO IO device streaming the FIFO of a sensor
+ *
+ * @param _name Name of the IO device.
+ * @param _sensor Pointer to the sensor device.
+ */
+#define SENSOR_STREAM_IODEV_DEFINE(_name, _sensor)			\
+	static struct sensor_stream_iodev _name = {			\
+		.iodev = {						\
+			.api = &sensor_stream_iodev_api,		\
+		},							\
+		.sensor = (_sensor),					\
+	}
+
+/**
+ * @brief Get the decoder of the stream of a sensor
+ *
+ * @funcprops \supervisor
+ *
+ * @param dev Pointer to the sensor device
+ * @param decoder Where to store the pointer to the decoder
+ *
+ * @return 0 if successful, -ENOSYS if the sensor does not support
+ * streaming.
+ */
+static inline int sensor_get_decoder(const struct device *dev,
+				     const struct sensor_decoder_api **decoder)
+{
+	const struct sensor_driver_api *api =
+		(const struct sensor_driver_api *)dev->api;
+
+	if (api->get_decoder == NULL) {
+		return -ENOSYS;
+	}
+
+	return api->get_decoder(dev, decoder);
+}
+
+/**
+ * @brief Helper function for converting a decoded value to float
+ *
+ * @param value Q31 value returned by a decoder.
+ * @param shift Shift returned along with the value.
+ *
+ * @return The value in the unit of the channel.
+ */
+static inline float sensor_q31_to_float(int32_t value, int8_t shift)
+{
+	float f = (float)value / 2147483648.0f;
+
+	return (shift >= 0) ? f * (float)BIT(shift) : f / (float)BIT(-shift);
+}
+#endif /* CONFIG_SENSOR_STREAM || __DOXYGEN__ */
+
 /**
  * @}
  */
@@ -24,6 +24,9 @@
 #include <zephyr/device.h>
 #include <zephyr/dt-bindings/spi/spi.h>
 #include <zephyr/drivers/gpio.h>
+#ifdef CONFIG_SPI_RTIO
+#include <zephyr/rtio/rtio.h>
+#endif /* CONFIG_SPI_RTIO */
 
 #ifdef __cplusplus
 extern "C" {
@@ -854,6 +857,65 @@ __deprecated static inline int spi_write_async(const struct device *dev,
 
 #endif /* CONFIG_SPI_ASYNC */
 
+#if defined(CONFIG_SPI_RTIO) || defined(__DOXYGEN__)
+
+/**
+ * @brief RTIO IO device of a SPI peripheral
+ *
+ * Each RTIO_OP_TX or RTIO_OP_RX submission queue entry is one SPI transfer.
+ * Entries chained with RTIO_SQE_CHAINED form a single transaction: the bus
+ * stays locked and the chip select asserted until the first unchained
+ * entry completes. Every entry of such a chain must target the same IO
+ * device. Entries following the first one of a chain are started from the
+ * completion interrupt of the previous one, without a thread wakeup.
+ *
+ * An IO device serves one RTIO context at a time.
+ *
+ * @note This is available only if @kconfig{CONFIG_SPI_RTIO} is selected.
+ */
+struct spi_iodev {
+	/** RTIO IO device, must be the first member */
+	struct rtio_iodev iodev;
+	/** SPI bus */
+	const struct device *bus;
+	/** Configuration of the transfers */
+	struct spi_config config;
+	/** @cond INTERNAL_HIDDEN */
+	const struct rtio_sqe *sqe;
+	struct rtio *r;
+	struct spi_buf buf;
+	struct spi_buf_set buf_set;
+	struct k_work work;
+	bool locked;
+	/** @endcond */
+};
+
+/** @cond INTERNAL_HIDDEN */
+extern const struct rtio_iodev_api spi_iodev_api;
+void z_spi_iodev_work_handler(struct k_work *work);
+/** @endcond */
+
+/**
+ * @brief Define a RTIO IO device for a SPI peripheral from devicetree
+ *
+ * @param name Name of the IO device.
+ * @param node_id Devicetree node identifier of the SPI peripheral.
+ * @param operation_ The @p operation field of the struct spi_config.
+ * @param delay_ The @p delay field of the struct spi_config's
+ *               spi_cs_control, if there is one.
+ */
+#define SPI_DT_IODEV_DEFINE(name, node_id, operation_, delay_)		\
+	static struct spi_iodev name = {				\
+		.iodev = {						\
+			.api = &spi_iodev_api,				\
+		},							\
+		.bus = DEVICE_DT_GET(DT_BUS(node_id)),			\
+		.config = SPI_CONFIG_DT(node_id, operation_, delay_),	\
+		.work = Z_WORK_INITIALIZER(z_spi_iodev_work_handler),	\
+	}
+
+#endif /* CONFIG_SPI_RTIO */
+
 /**
  * @brief Release the SPI device locked on and/or the CS by the current config
  *
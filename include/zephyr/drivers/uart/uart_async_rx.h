@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Helper for receiving data with the UART asynchronous API
+ */
+
+#ifndef ZEPHYR_INCLUDE_DRIVERS_UART_UART_ASYNC_RX_H_
+#define ZEPHYR_INCLUDE_DRIVERS_UART_UART_ASYNC_RX_H_
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/uart.h>
+#include <zephyr/sys/atomic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief UART asynchronous RX helper
+ * @defgroup uart_async_rx UART asynchronous RX helper
+ * @ingroup uart_interface
+ *
+ * The helper keeps reception enabled on a UART using the asynchronous API.
+ * A memory area is split into a number of buffers which are handed over to
+ * the driver, in order, on @ref UART_RX_BUF_REQUEST. Drivers typically
+ * receive into them with DMA and report data on the receiver timeout, so the
+ * CPU is only involved once per burst of data instead of once per byte.
+ *
+ * Received data is read in place with uart_async_rx_data_claim() and
+ * uart_async_rx_data_consume(). A buffer is given back to the pool once it is
+ * released by the driver and fully consumed. If the driver runs out of
+ * buffers, reception stops and is enabled again as soon as a buffer is
+ * consumed.
+ *
+ * Events are reported by the driver from interrupt context, data can be
+ * consumed by a single thread.
+ * @{
+ */
+
+/** @cond INTERNAL_HIDDEN */
+struct uart_async_rx_buf {
+	/* Number of bytes received in the buffer */
+	atomic_t wr_idx;
+	/* Set when the driver released the buffer */
+	atomic_t completed;
+	uint8_t data[];
+};
+/** @endcond */
+
+/**
+ * @brief Number of bytes of the memory area used by the helper per buffer
+ */
+#define UART_ASYNC_RX_BUF_OVERHEAD sizeof(struct uart_async_rx_buf)
+
+/** @brief Helper configuration. */
+struct uart_async_rx_config {
+	/** Memory area split into buffers. */
+	uint8_t *buffer;
+	/** Size of the memory area. */
+	size_t length;
+	/** Number of buffers, at least 2 to receive without gaps. */
+	uint8_t buf_cnt;
+	/** Receiver inactivity timeout in microseconds. */
+	int32_t timeout;
+};
+
+/** @brief Helper instance. */
+struct uart_async_rx {
+	/** @cond INTERNAL_HIDDEN */
+	const struct device *dev;
+	struct uart_async_rx_config config;
+	size_t buf_len;
+	atomic_t pending_bytes;
+	atomic_t free_buf_cnt;
+	atomic_t stopped;
+	bool disabled;
+	uint8_t drv_buf_idx;
+	uint8_t rd_buf_idx;
+	size_t rd_idx;
+	/** @endcond */
+};
+
+/**
+ * @brief Initialize the helper.
+ *
+ * @param rx Helper instance.
+ * @param dev UART device.
+ * @param config Configuration, copied into the instance.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if the memory area is too small for the number of buffers.
+ */
+int uart_async_rx_init(struct uart_async_rx *rx, const struct device *dev,
+		       const struct uart_async_rx_config *config);
+
+/**
+ * @brief Enable reception.
+ *
+ * @param rx Helper instance.
+ *
+ * @retval 0 on success.
+ * @retval -ENOMEM if no buffer is free.
+ * @return Other negative error code returned by uart_rx_enable().
+ */
+int uart_async_rx_enable(struct uart_async_rx *rx);
+
+/**
+ * @brief Disable reception.
+ *
+ * Data received so far can still be consumed.
+ *
+ * @param rx Helper instance.
+ *
+ * @return Result of uart_rx_disable().
+ */
+int uart_async_rx_disable(struct uart_async_rx *rx);
+
+/**
+ * @brief Handle a UART event.
+ *
+ * Must be called from the UART callback for every event. Events which are
+ * not related to reception are ignored, so the callback can handle them
+ * itself.
+ *
+ * @param rx Helper instance.
+ * @param evt UART event.
+ */
+void uart_async_rx_on_event(struct uart_async_rx *rx, const struct uart_event *evt);
+
+/**
+ * @brief Get the number of received bytes not consumed yet.
+ *
+ * @param rx Helper instance.
+ *
+ * @return Number of bytes.
+ */
+static inline size_t uart_async_rx_pending(struct uart_async_rx *rx)
+{
+	return (size_t)atomic_get(&rx->pending_bytes);
+}
+
+/**
+ * @brief Claim received data.
+ *
+ * Data is not copied, the returned pointer points to the buffer the driver
+ * received into. Data is contiguous only within a buffer, so fewer bytes than
+ * pending may be returned.
+ *
+ * @param rx Helper instance.
+ * @param data Set to the location of the data.
+ * @param length Maximum number of bytes to claim.
+ *
+ * @return Number of bytes claimed, 0 if there is no data.
+ */
+size_t uart_async_rx_data_claim(struct uart_async_rx *rx, uint8_t **data, size_t length);
+
+/**
+ * @brief Consume claimed data.
+ *
+ * @param rx Helper instance.
+ * @param length Number of bytes, at most the number of claimed bytes.
+ */
+void uart_async_rx_data_consume(struct uart_async_rx *rx, size_t length);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_DRIVERS_UART_UART_ASYNC_RX_H_ */
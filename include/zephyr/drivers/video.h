@@ -101,6 +101,11 @@ struct video_caps {
  * @param timestamp is a time reference in milliseconds at which the last data
  *        byte was actually received for input endpoints or to be consumed for
  *        output endpoints.
+ * @param line_offset is the index of the first frame line held by the buffer.
+ *        Drivers delivering frames in slices, when the buffer is smaller than
+ *        a frame, set it to locate the slice. It is 0 for full frames.
+ * @param refcount is the number of references to the buffer, see
+ *        video_buffer_ref().
  */
 struct video_buffer {
 	void *driver_data;
@@ -108,6 +113,8 @@ struct video_buffer {
 	uint32_t size;
 	uint32_t bytesused;
 	uint32_t timestamp;
+	uint16_t line_offset;
+	atomic_t refcount;
 };
 
 /**
@@ -548,13 +555,50 @@ static inline int video_set_signal(const struct device *dev,
  */
 struct video_buffer *video_buffer_alloc(size_t size);
 
+/**
+ * @brief Take a reference to a video buffer.
+ *
+ * A video buffer is allocated with one reference. Taking more lets the
+ * frame be handed over to other consumers, e.g. the network stack or a file
+ * system writer, without copying it. The buffer memory is freed once every
+ * reference is released.
+ *
+ * @param buf Pointer to the video buffer.
+ */
+void video_buffer_ref(struct video_buffer *buf);
+
 /**
  * @brief Release a video buffer.
  *
+ * Drops a reference, the buffer is freed once it is not referenced anymore.
+ *
  * @param buf Pointer to the video buffer to release.
  */
 void video_buffer_release(struct video_buffer *buf);
 
+#if defined(CONFIG_VIDEO_BUFFER_NET_BUF) || defined(__DOXYGEN__)
+struct net_buf;
+
+/**
+ * @brief Wrap the data of a video buffer in a network buffer.
+ *
+ * The returned network buffer points to the valid data of the video buffer
+ * and holds a reference to it, released when the network buffer is freed.
+ * It can be chained as a fragment or passed to network APIs taking net_buf
+ * without copying the frame.
+ *
+ * @note This function is available only if
+ * @kconfig{CONFIG_VIDEO_BUFFER_NET_BUF} is selected.
+ *
+ * @param buf Pointer to the video buffer.
+ * @param timeout Time to wait for a network buffer header.
+ *
+ * @retval pointer to the network buffer, NULL if none is available.
+ */
+struct net_buf *video_buffer_net_buf(struct video_buffer *buf,
+				     k_timeout_t timeout);
+#endif /* CONFIG_VIDEO_BUFFER_NET_BUF */
+
 
 /* fourcc - four-character-code */
 #define video_fourcc(a, b, c, d)\
@@ -129,6 +129,19 @@ struct fcb {
 	/**< The value flash takes when it is erased. This is read from
 	 * flash parameters and initialized upon call to fcb_init.
 	 */
+
+#ifdef CONFIG_FCB_READ_CACHE
+	uint8_t f_rd_cache[CONFIG_FCB_READ_CACHE_SIZE];
+	/**< Copy of a window of flash sector contents, internal state */
+
+	const struct flash_sector *f_rd_cache_sector;
+	/**< Sector the read cache holds data of, NULL if the cache is
+	 * empty, internal state
+	 */
+
+	off_t f_rd_cache_off; /**< Offset of the cached window, internal state */
+	uint16_t f_rd_cache_len; /**< Length of the cached window, internal state */
+#endif
 };
 
 /**
@@ -179,6 +192,23 @@ int fcb_append(struct fcb *fcb, uint16_t len, struct fcb_entry *loc);
  */
 int fcb_append_finish(struct fcb *fcb, struct fcb_entry *append_loc);
 
+/**
+ * Appends an entry to the FCB in a single operation.
+ *
+ * Unlike the fcb_append(), flash_area_write() and fcb_append_finish()
+ * sequence, the element header, the data and the CRC are combined in RAM and
+ * written in as few, write block aligned, flash writes as possible.
+ *
+ * @param[in] fcb FCB instance structure.
+ * @param[in] data Entry payload.
+ * @param[in] len Length of the entry payload.
+ * @param[out] loc entry location information, may be NULL.
+ *
+ * @return 0 on success, non-zero on failure.
+ */
+int fcb_append_write(struct fcb *fcb, const void *data, uint16_t len,
+		     struct fcb_entry *loc);
+
 /**
  * FCB Walk callback function type.
  *
@@ -31,6 +31,17 @@ extern "C" {
  * @{
  */
 
+/**
+ * @brief Non-volatile Storage lookup index entry
+ *
+ * @param addr Address of the most recent allocation table entry of the ID
+ * @param id NVS ID
+ */
+struct nvs_lookup_index_entry {
+	uint32_t addr;
+	uint16_t id;
+};
+
 /**
  * @brief Non-volatile Storage File system structure
  *
@@ -44,6 +55,15 @@ extern "C" {
  * @param nvs_lock Mutex
  * @param flash_device Flash Device runtime structure
  * @param flash_parameters Flash memory parameters structure
+ * @param lookup_index Lookup index entries, sorted by ID
+ * @param lookup_index_count Number of used lookup index entries
+ * @param lookup_index_complete Flag indicating that all IDs are in the lookup
+ * index, so that an ID missing from it does not exist
+ * @param gc_work Background incremental garbage collection work item
+ * @param gc_addr Address of the next allocation table entry to move by the
+ * incremental garbage collection
+ * @param gc_sector Sector processed by the incremental garbage collection
+ * @param gc_state State of the incremental garbage collection
  */
 struct nvs_fs {
 	off_t offset;
@@ -58,6 +78,19 @@ struct nvs_fs {
 #if CONFIG_NVS_LOOKUP_CACHE
 	uint32_t lookup_cache[CONFIG_NVS_LOOKUP_CACHE_SIZE];
 #endif
+#if CONFIG_NVS_LOOKUP_INDEX
+	struct nvs_lookup_index_entry lookup_index[CONFIG_NVS_LOOKUP_INDEX_SIZE];
+	uint16_t lookup_index_count;
+	bool lookup_index_complete;
+#endif
+#if CONFIG_NVS_GC_INCREMENTAL
+#if CONFIG_NVS_GC_INCREMENTAL_BACKGROUND
+	struct k_work_delayable gc_work;
+#endif
+	uint32_t gc_addr;
+	uint16_t gc_sector;
+	uint8_t gc_state;
+#endif
 };
 
 /**
@@ -168,6 +201,25 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len, ui
  */
 ssize_t nvs_calc_free_space(struct nvs_fs *fs);
 
+/**
+ * @brief nvs_gc_step
+ *
+ * Perform one bounded step of incremental garbage collection. A step either
+ * moves up to CONFIG_NVS_GC_INCREMENTAL_ATE_COUNT allocation table entries
+ * from the oldest sector into the current sector, or erases the oldest
+ * sector once all of its valid entries have been moved, so that the garbage
+ * collection done when the current sector is full has nothing left to do.
+ *
+ * With CONFIG_NVS_GC_INCREMENTAL_BACKGROUND the steps are done from the
+ * system work queue after every write and calling this is not needed.
+ *
+ * @param fs Pointer to file system
+ * @retval 1 More steps are needed
+ * @retval 0 Nothing left to do until the current sector is closed
+ * @retval -ERRNO errno code if error
+ */
+int nvs_gc_step(struct nvs_fs *fs);
+
 /**
  * @brief nvs_init
  *
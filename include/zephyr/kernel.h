@@ -771,6 +771,37 @@ __syscall void k_thread_priority_set(k_tid_t thread, int prio);
 __syscall void k_thread_deadline_set(k_tid_t thread, int deadline);
 #endif
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+/**
+ * @brief Attach a constant bandwidth server to a thread
+ *
+ * The thread may then run for at most @p budget ticks in every period of
+ * @p period ticks, and its deadline (see k_thread_deadline_set()) is kept
+ * at the end of the current period.  Once a thread has run for its whole
+ * budget it is throttled, i.e. not scheduled, until the end of the period,
+ * at which point the budget is replenished and the deadline moves to the
+ * end of the next period.  Budget is only consumed while the thread runs.
+ *
+ * The deadline ordering only applies between threads at the same static
+ * priority, so the threads sharing a CPU through servers should all use it.
+ *
+ * @note Budget is accounted in whole ticks when the thread is switched out
+ * or the tick is announced, so precision is bounded by the tick rate.
+ *
+ * @note You should enable @kconfig{CONFIG_SCHED_DEADLINE_CBS} in your
+ * project configuration.
+ *
+ * @param thread A valid, initialized thread
+ * @param budget Execution budget per period, in ticks, or 0 to detach the
+ *        server
+ * @param period Server period, in ticks, at least @p budget
+ *
+ * @retval 0 on success
+ * @retval -EINVAL if the parameters are invalid
+ */
+int k_thread_cbs_set(k_tid_t thread, int32_t budget, int32_t period);
+#endif
+
 #ifdef CONFIG_SCHED_CPU_MASK
 /**
  * @brief Sets all CPU enable masks to zero
@@ -2731,6 +2762,11 @@ struct k_mutex {
 	/** Original thread priority */
 	int owner_orig_prio;
 
+#ifdef CONFIG_MUTEX_FAST_PATH
+	/** Set when threads may be waiting, disabling the fast unlock */
+	bool contended;
+#endif
+
 	SYS_PORT_TRACING_TRACKING_FIELD(k_mutex)
 };
 
@@ -3317,6 +3353,98 @@ int k_work_queue_drain(struct k_work_q *queue, bool plug);
  */
 int k_work_queue_unplug(struct k_work_q *queue);
 
+#if defined(CONFIG_WORK_POOL) || defined(__DOXYGEN__)
+
+struct k_work_pool;
+struct k_work_pool_config;
+
+/** @brief Initialize a work pool structure.
+ *
+ * A work pool is a set of work queues sharing the load of the work
+ * items submitted to the pool: a worker that runs out of work takes
+ * queued items from a busy sibling.  Work items keep their usual
+ * semantics, and can be flushed or cancelled with the regular API.
+ *
+ * This must be invoked before starting a work pool for the first time.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param pool the pool structure to be initialized.
+ *
+ * @param workers array of @p num_workers work queue structures, owned by
+ *        the pool from now on.
+ *
+ * @param num_workers number of work queues in @p workers.
+ */
+void k_work_pool_init(struct k_work_pool *pool, struct k_work_q *workers,
+		      size_t num_workers);
+
+/** @brief Start the worker threads of a work pool.
+ *
+ * @param pool pointer to a pool initialized with k_work_pool_init().
+ *
+ * @param stacks array of stacks, one per worker, as defined by
+ *        K_THREAD_STACK_ARRAY_DEFINE().
+ *
+ * @param stack_size size of each stack of @p stacks, in bytes.
+ *
+ * @param prio initial priority of the worker threads.
+ *
+ * @param cfg optional additional configuration parameters.  Pass @c
+ * NULL if not required, to use the defaults documented in
+ * k_work_pool_config.
+ */
+void k_work_pool_start(struct k_work_pool *pool, k_thread_stack_t *stacks,
+		       size_t stack_size, int prio,
+		       const struct k_work_pool_config *cfg);
+
+/** @brief Submit a work item to a work pool.
+ *
+ * Work submitted from one of the pool workers goes to that worker,
+ * otherwise the worker pinned to the current CPU is used if there is
+ * one, and the workers are picked in turn if not.  If that worker is
+ * busy an idle one is woken to steal the item, as happens for any
+ * work submitted directly to a pool worker.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param pool pointer to the pool.
+ *
+ * @param work pointer to the work item.
+ *
+ * @return as for k_work_submit_to_queue().
+ */
+int k_work_pool_submit(struct k_work_pool *pool, struct k_work *work);
+
+/** @brief Wait until all the workers of a pool have drained.
+ *
+ * See k_work_queue_drain().  No work gets stolen from a worker while
+ * it is being drained.
+ *
+ * @param pool pointer to the pool.
+ *
+ * @param plug if true the workers will continue to block new
+ * submissions after all items have drained.
+ *
+ * @retval 1 if call had to wait for the drain to complete
+ * @retval 0 if call did not have to wait
+ * @retval negative if wait was interrupted or failed
+ */
+int k_work_pool_drain(struct k_work_pool *pool, bool plug);
+
+/** @brief Release the workers of a pool to accept new submissions.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param pool pointer to the pool.
+ *
+ * @retval 0 if successfully unplugged
+ * @retval -EALREADY if the pool was not plugged.
+ */
+int k_work_pool_unplug(struct k_work_pool *pool);
+
+#endif /* CONFIG_WORK_POOL */
+
 /** @brief Initialize a delayable work structure.
  *
  * This must be invoked before scheduling a delayable work structure for the
@@ -3610,6 +3738,12 @@ enum {
 	K_WORK_MASK = BIT(K_WORK_DELAYED_BIT) | BIT(K_WORK_QUEUED_BIT)
 		| BIT(K_WORK_RUNNING_BIT) | BIT(K_WORK_CANCELING_BIT),
 
+	/* Set while the item sits on a queue's lockless submission stack
+	 * rather than on its pending list.
+	 */
+	K_WORK_LOCKLESS_BIT = 4,
+	K_WORK_LOCKLESS = BIT(K_WORK_LOCKLESS_BIT),
+
 	/* Static work flags */
 	K_WORK_DELAYABLE_BIT = 8,
 	K_WORK_DELAYABLE = BIT(K_WORK_DELAYABLE_BIT),
@@ -3813,6 +3947,17 @@ struct k_work_q {
 	/* The thread that animates the work. */
 	struct k_thread thread;
 
+#ifdef CONFIG_WORK_QUEUE_LOCKLESS_SUBMIT
+	/* Items submitted without taking the work module spinlock,
+	 * pushed as a stack and collected by the queue thread.  These
+	 * two fields are only accessed through the atomic API.
+	 */
+	atomic_ptr_t lockless;
+
+	/* Set by the queue thread before it waits for work. */
+	atomic_t lockless_idle;
+#endif
+
 	/* All the following fields must be accessed only while the
 	 * work module spinlock is held.
 	 */
@@ -3828,8 +3973,60 @@ struct k_work_q {
 
 	/* Flags describing queue state. */
 	uint32_t flags;
+
+#ifdef CONFIG_WORK_POOL
+	/* Pool the queue is a worker of, if any. */
+	struct k_work_pool *pool;
+#endif
 };
 
+#if defined(CONFIG_WORK_POOL) || defined(__DOXYGEN__)
+/** @brief A structure holding optional configuration items for a work
+ * pool.
+ *
+ * This structure, and values it references, are not retained by
+ * k_work_pool_start().
+ */
+struct k_work_pool_config {
+	/** The name to be given to the worker threads.
+	 *
+	 * If left null the threads will not have a name.
+	 */
+	const char *name;
+
+	/** Control whether the workers should yield between items.
+	 *
+	 * See k_work_queue_config.
+	 */
+	bool no_yield;
+
+	/** Pin worker @c i to CPU <tt>i % CONFIG_MP_NUM_CPUS</tt>.
+	 *
+	 * Requires CONFIG_SCHED_CPU_MASK.
+	 */
+	bool pin_cpu;
+};
+
+/** @brief A set of work queues sharing the items submitted to them. */
+struct k_work_pool {
+	/* All the following fields must be accessed only while the
+	 * work module spinlock is held.
+	 */
+
+	/* Worker queues. */
+	struct k_work_q *workers;
+
+	/* Number of entries in workers. */
+	uint32_t num_workers;
+
+	/* Next worker to submit to from outside the pool. */
+	uint32_t next;
+
+	/* Whether worker i is pinned to CPU i. */
+	bool pinned;
+};
+#endif /* CONFIG_WORK_POOL */
+
 /* Provide the implementation for inline functions declared above */
 
 static inline bool k_work_is_pending(const struct k_work *work)
@@ -4254,6 +4451,8 @@ struct k_msgq {
 
 
 #define K_MSGQ_FLAG_ALLOC	BIT(0)
+#define K_MSGQ_FLAG_RESERVED	BIT(1)
+#define K_MSGQ_FLAG_CLAIMED	BIT(2)
 
 /**
  * @brief Message Queue Attributes
@@ -4368,6 +4567,7 @@ int k_msgq_cleanup(struct k_msgq *msgq);
  * @retval 0 Message sent.
  * @retval -ENOMSG Returned without waiting or queue purged.
  * @retval -EAGAIN Waiting period timed out.
+ * @retval -EBUSY A zero-copy reservation is outstanding.
  */
 __syscall int k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout);
 
@@ -4390,6 +4590,7 @@ __syscall int k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t time
  * @retval 0 Message received.
  * @retval -ENOMSG Returned without waiting.
  * @retval -EAGAIN Waiting period timed out.
+ * @retval -EBUSY A zero-copy claim is outstanding.
  */
 __syscall int k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout);
 
@@ -4409,6 +4610,99 @@ __syscall int k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout);
  */
 __syscall int k_msgq_peek(struct k_msgq *msgq, void *data);
 
+/**
+ * @brief Reserve a message slot for in-place writing.
+ *
+ * This routine reserves the slot at the tail of message queue @a msgq and
+ * returns its address, so the producer can build the message directly in
+ * the ring buffer instead of copying it in with k_msgq_put(). The message
+ * becomes visible to readers once k_msgq_commit() is called.
+ *
+ * Only one reservation can be outstanding at a time. While it is,
+ * k_msgq_put() and further calls to this routine fail with -EBUSY, and
+ * threads still blocked in k_msgq_put() when a blocked reservation is
+ * granted are woken with -EBUSY.
+ *
+ * @note The same restrictions as k_msgq_put() apply to the use from an ISR.
+ * A user mode caller must have write access to the queue's ring buffer.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param data Address of a pointer set to the reserved slot, which is
+ *        @a msg_size bytes long.
+ * @param timeout Waiting period to reserve a slot,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Slot reserved.
+ * @retval -ENOMSG Returned without waiting or queue purged.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EBUSY Another reservation is outstanding.
+ */
+__syscall int k_msgq_reserve(struct k_msgq *msgq, void **data,
+			     k_timeout_t timeout);
+
+/**
+ * @brief Commit a reserved message slot.
+ *
+ * This routine publishes the message written into the slot returned by
+ * k_msgq_reserve(). If a thread is waiting to receive a message it is
+ * handed the message directly.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ *
+ * @retval 0 Message committed.
+ * @retval -EINVAL No reservation is outstanding.
+ */
+__syscall int k_msgq_commit(struct k_msgq *msgq);
+
+/**
+ * @brief Claim the message at the head of a queue for in-place reading.
+ *
+ * This routine returns the address of the oldest message in message queue
+ * @a msgq without copying it out. The message remains in the queue, and its
+ * slot is not reused, until k_msgq_release() is called.
+ *
+ * Only one claim can be outstanding at a time. While it is, k_msgq_get()
+ * and further calls to this routine fail with -EBUSY, and threads still
+ * blocked in k_msgq_get() when a blocked claim is granted are woken with
+ * -EBUSY. k_msgq_purge() discards an outstanding claim.
+ *
+ * @note The same restrictions as k_msgq_get() apply to the use from an ISR.
+ * A user mode caller must have read access to the queue's ring buffer.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param data Address of a pointer set to the claimed message.
+ * @param timeout Waiting period to receive a message,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Message claimed.
+ * @retval -ENOMSG Returned without waiting or queue purged.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EBUSY Another claim is outstanding.
+ */
+__syscall int k_msgq_peek_claim(struct k_msgq *msgq, void **data,
+				k_timeout_t timeout);
+
+/**
+ * @brief Release a claimed message.
+ *
+ * This routine removes the message returned by k_msgq_peek_claim() from
+ * the queue and makes its slot available to writers.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ *
+ * @retval 0 Message released.
+ * @retval -EINVAL No claim is outstanding.
+ */
+__syscall int k_msgq_release(struct k_msgq *msgq);
+
 /**
  * @brief Purge a message queue.
  *
@@ -4446,7 +4740,9 @@ __syscall void  k_msgq_get_attrs(struct k_msgq *msgq,
 
 static inline uint32_t z_impl_k_msgq_num_free_get(struct k_msgq *msgq)
 {
-	return msgq->max_msgs - msgq->used_msgs;
+	uint32_t reserved = ((msgq->flags & K_MSGQ_FLAG_RESERVED) != 0U) ? 1U : 0U;
+
+	return msgq->max_msgs - msgq->used_msgs - reserved;
 }
 
 /**
@@ -4631,6 +4927,17 @@ extern void k_mbox_data_get(struct k_mbox_msg *rx_msg, void *buffer);
  * @{
  */
 
+/**
+ * @brief Pipe I/O segment
+ *
+ * Describes one contiguous buffer of a scatter-gather transfer with
+ * k_pipe_putv() or k_pipe_getv().
+ */
+struct k_pipe_iovec {
+	void   *iov_base;	/**< Start of the segment */
+	size_t  iov_len;	/**< Length of the segment in bytes */
+};
+
 /** Pipe Structure */
 struct k_pipe {
 	unsigned char *buffer;          /**< Pipe buffer: may be NULL */
@@ -4784,6 +5091,59 @@ __syscall int k_pipe_get(struct k_pipe *pipe, void *data,
 			 size_t bytes_to_read, size_t *bytes_read,
 			 size_t min_xfer, k_timeout_t timeout);
 
+/**
+ * @brief Write data from a list of segments to a pipe.
+ *
+ * This routine behaves like k_pipe_put(), gathering the data to write from
+ * the @a iov_cnt segments of @a iov in order. Readers waiting on the pipe
+ * are filled directly from the segments, without going through the pipe
+ * buffer.
+ *
+ * @param pipe Address of the pipe.
+ * @param iov Array of segments to write.
+ * @param iov_cnt Number of segments in @a iov.
+ * @param bytes_written Address of area to hold the number of bytes written.
+ * @param min_xfer Minimum number of bytes to write.
+ * @param timeout Waiting period to wait for the data to be written,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 At least @a min_xfer bytes of data were written.
+ * @retval -EINVAL invalid parameters supplied
+ * @retval -EIO Returned without waiting; zero data bytes were written.
+ * @retval -EAGAIN Waiting period timed out; between zero and @a min_xfer
+ *                 minus one data bytes were written.
+ */
+__syscall int k_pipe_putv(struct k_pipe *pipe,
+			  const struct k_pipe_iovec *iov, size_t iov_cnt,
+			  size_t *bytes_written, size_t min_xfer,
+			  k_timeout_t timeout);
+
+/**
+ * @brief Read data from a pipe into a list of segments.
+ *
+ * This routine behaves like k_pipe_get(), scattering the data read over
+ * the @a iov_cnt segments of @a iov in order. If the calling thread has to
+ * wait, writers fill the segments directly.
+ *
+ * @param pipe Address of the pipe.
+ * @param iov Array of segments to fill.
+ * @param iov_cnt Number of segments in @a iov.
+ * @param bytes_read Address of area to hold the number of bytes read.
+ * @param min_xfer Minimum number of data bytes to read.
+ * @param timeout Waiting period to wait for the data to be read,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 At least @a min_xfer bytes of data were read.
+ * @retval -EINVAL invalid parameters supplied
+ * @retval -EIO Returned without waiting; zero data bytes were read.
+ * @retval -EAGAIN Waiting period timed out; between zero and @a min_xfer
+ *                 minus one data bytes were read.
+ */
+__syscall int k_pipe_getv(struct k_pipe *pipe,
+			  const struct k_pipe_iovec *iov, size_t iov_cnt,
+			  size_t *bytes_read, size_t min_xfer,
+			  k_timeout_t timeout);
+
 /**
  * @brief Query the number of bytes that may be read from @a pipe.
  *
@@ -4835,6 +5195,27 @@ __syscall void k_pipe_buffer_flush(struct k_pipe *pipe);
  * @cond INTERNAL_HIDDEN
  */
 
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+struct z_mem_slab_cache {
+	struct k_spinlock lock;
+	char *free_list;
+	uint32_t count;
+};
+
+struct k_mem_slab;
+
+/* Number of blocks in use, excluding those held in per-CPU caches */
+extern uint32_t z_mem_slab_num_used(struct k_mem_slab *slab);
+#endif
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
 struct k_mem_slab {
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
@@ -4846,6 +5227,9 @@ struct k_mem_slab {
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	uint32_t max_used;
 #endif
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+	struct z_mem_slab_cache cache[CONFIG_MP_NUM_CPUS];
+#endif
 
 	SYS_PORT_TRACING_TRACKING_FIELD(k_mem_slab)
 };
@@ -4998,7 +5382,11 @@ extern void k_mem_slab_free(struct k_mem_slab *slab, void **mem);
  */
 static inline uint32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
 {
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+	return z_mem_slab_num_used(slab);
+#else
 	return slab->num_used;
+#endif
 }
 
 /**
@@ -5033,7 +5421,7 @@ static inline uint32_t k_mem_slab_max_used_get(struct k_mem_slab *slab)
  */
 static inline uint32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 {
-	return slab->num_blocks - slab->num_used;
+	return slab->num_blocks - k_mem_slab_num_used_get(slab);
 }
 
 /**
@@ -5150,10 +5538,42 @@ void *k_heap_alloc(struct k_heap *h, size_t bytes,
  */
 void k_heap_free(struct k_heap *h, void *mem);
 
-/* Hand-calculated minimum heap sizes needed to return a successful
- * 1-byte allocation.  See details in lib/os/heap.[ch]
+/* Size of struct z_heap, the metadata at the start of every heap.  A
+ * build assertion in lib/os/heap.c keeps it in sync with lib/os/heap.h.
+ */
+#define Z_HEAP_STRUCT_SIZE						\
+	(16U +								\
+	 COND_CODE_1(CONFIG_SYS_HEAP_RUNTIME_STATS,			\
+		     (3U * sizeof(size_t)), (0U)) +			\
+	 COND_CODE_1(CONFIG_SYS_HEAP_SIZE_CLASSES,			\
+		     (8U * ((CONFIG_SYS_HEAP_SIZE_CLASS_MAX_BYTES + 15U) / 8U)), \
+		     (0U)) +						\
+	 COND_CODE_1(CONFIG_SYS_HEAP_PROFILE,				\
+		     (sizeof(struct sys_heap_profile)), (0U)))
+
+/* Chunk header size of a heap small enough to be padded to the minimum */
+#define Z_HEAP_MIN_HDR_BYTES						\
+	((!IS_ENABLED(CONFIG_SYS_HEAP_SMALL_ONLY) &&			\
+	  (IS_ENABLED(CONFIG_SYS_HEAP_BIG_ONLY) || sizeof(void *) > 4)) ? 8U : 4U)
+
+/* Chunks holding struct z_heap followed by nb buckets */
+#define Z_HEAP_CHUNK0_UNITS(nb) ((Z_HEAP_STRUCT_SIZE + 4U * (nb) + 7U) / 8U)
+
+/* Upper bound of the number of buckets of a minimum heap, as computed
+ * by sys_heap_init() from the chunks left behind chunk 0
  */
-#define Z_HEAP_MIN_SIZE (sizeof(void *) > 4 ? 56 : 44)
+#define Z_HEAP_MIN_BUCKETS (32 - __builtin_clz(Z_HEAP_CHUNK0_UNITS(16U) + 1U))
+
+/* Minimum heap size needed to return a successful 1-byte allocation:
+ * chunk 0, the chunk of the allocation and the end marker header.  See
+ * details in lib/os/heap.[ch]
+ */
+#define Z_HEAP_MIN_SIZE							\
+	(8U * (Z_HEAP_CHUNK0_UNITS(Z_HEAP_MIN_BUCKETS) +		\
+	       (Z_HEAP_MIN_HDR_BYTES + 1U +				\
+		COND_CODE_1(CONFIG_SYS_HEAP_PROFILE,			\
+			    (sizeof(uintptr_t)), (0U)) + 7U) / 8U) +	\
+	 Z_HEAP_MIN_HDR_BYTES)
 
 /**
  * @brief Define a static k_heap in the specified linker section
@@ -5600,6 +6020,84 @@ __syscall void k_poll_signal_check(struct k_poll_signal *sig,
 
 __syscall int k_poll_signal_raise(struct k_poll_signal *sig, int result);
 
+/**
+ * @brief Poll set
+ *
+ * A poll set is a persistent group of poll events. Events are linked to
+ * their objects once, when added to the set, and an event becoming ready
+ * is moved to the set's ready list. Waiting on a set only costs in the
+ * number of ready events, not in the number of events in the set.
+ */
+struct k_poll_set {
+	/** events signaled and not yet returned by k_poll_set_wait() */
+	sys_dlist_t ready;
+
+	/** events returned by the last k_poll_set_wait(), to be re-armed */
+	sys_dlist_t rearm;
+
+	/** threads waiting on the set */
+	_wait_q_t wait_q;
+
+	/** poller shared by all the events of the set */
+	struct z_poller poller;
+};
+
+/**
+ * @brief Initialize a poll set.
+ *
+ * @param set Address of the poll set.
+ */
+extern void k_poll_set_init(struct k_poll_set *set);
+
+/**
+ * @brief Add an event to a poll set.
+ *
+ * The event, initialized with k_poll_event_init() or K_POLL_EVENT_INITIALIZER,
+ * stays registered with its object until removed with k_poll_set_remove().
+ * It must not be passed to k_poll() or k_work_poll_submit() meanwhile.
+ *
+ * @param set Address of the poll set.
+ * @param event Address of the event.
+ *
+ * @retval 0 Event added.
+ * @retval -EBUSY Event is already being polled.
+ */
+extern int k_poll_set_add(struct k_poll_set *set, struct k_poll_event *event);
+
+/**
+ * @brief Remove an event from a poll set.
+ *
+ * @param set Address of the poll set.
+ * @param event Address of the event.
+ *
+ * @retval 0 Event removed.
+ * @retval -EINVAL Event is not part of the set.
+ */
+extern int k_poll_set_remove(struct k_poll_set *set,
+			     struct k_poll_event *event);
+
+/**
+ * @brief Wait for events of a poll set to become ready.
+ *
+ * Stores up to @a max ready events in @a ready, oldest first. The state
+ * field of each returned event tells what condition was met.
+ *
+ * The returned events are checked again on the next call: an event whose
+ * condition still holds is reported again, others are re-armed. Polling
+ * is thus level-triggered, like with k_poll().
+ *
+ * @param set Address of the poll set.
+ * @param ready Array receiving the ready events.
+ * @param max Number of entries in @a ready.
+ * @param timeout Waiting period for an event to be ready,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of ready events stored in @a ready.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+extern int k_poll_set_wait(struct k_poll_set *set, struct k_poll_event **ready,
+			   int max, k_timeout_t timeout);
+
 /**
  * @internal
  */
@@ -5873,6 +6371,41 @@ extern void k_sys_runtime_stats_enable(void);
  */
 extern void k_sys_runtime_stats_disable(void);
 
+#ifdef CONFIG_THREAD_LATENCY_STATS
+/**
+ * @brief Get the latency histograms of a thread
+ *
+ * Latencies are only recorded while runtime statistics are enabled for
+ * the thread, see k_thread_runtime_stats_enable().
+ *
+ * @param thread ID of thread.
+ * @param stats Pointer to struct to copy the histograms into.
+ * @return -EINVAL if null pointers, otherwise 0
+ */
+int k_thread_latency_stats_get(k_tid_t thread,
+			       struct k_thread_latency_stats *stats);
+
+/**
+ * @brief Clear the latency histograms of a thread
+ *
+ * @param thread ID of thread.
+ * @return -EINVAL if invalid thread ID, otherwise 0
+ */
+int k_thread_latency_stats_reset(k_tid_t thread);
+#endif
+
+#ifdef CONFIG_IRQ_LATENCY_STATS
+/**
+ * @brief Get the handler duration histogram of an interrupt line
+ *
+ * @param irq Index of the line in the software ISR table.
+ * @param hist Pointer to struct to copy the histogram into.
+ * @return -EINVAL if @a irq is out of range or @a hist is NULL,
+ *         otherwise 0
+ */
+int k_irq_latency_stats_get(unsigned int irq, struct k_latency_hist *hist);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -57,4 +57,23 @@ struct _priq_mq {
 
 struct k_thread *z_priq_mq_best(struct _priq_mq *pq);
 
+/* Two-level bitmap queue.  Like the multi-queue above there is one
+ * list per priority, but it covers every configured priority (up to
+ * 32 * 32 of them) by indexing the per-word occupancy bitmaps with a
+ * second, summary word.  Add, remove and best are all a fixed number
+ * of find-first-set operations.  With deadline scheduling enabled,
+ * threads are kept sorted by deadline within each priority list.
+ */
+#define Z_PRIQ_BM_PRIOS (CONFIG_NUM_COOP_PRIORITIES + \
+			 CONFIG_NUM_PREEMPT_PRIORITIES + 1)
+#define Z_PRIQ_BM_WORDS DIV_ROUND_UP(Z_PRIQ_BM_PRIOS, 32)
+
+struct _priq_bm {
+	sys_dlist_t queues[Z_PRIQ_BM_PRIOS];
+	uint32_t bitmap[Z_PRIQ_BM_WORDS]; /* bit i%32 of word i/32 set if queues[i] non-empty */
+	uint32_t summary; /* bit w set if bitmap[w] is non-zero */
+};
+
+struct k_thread *z_priq_bm_best(struct _priq_bm *pq);
+
 #endif /* ZEPHYR_INCLUDE_SCHED_PRIQ_H_ */
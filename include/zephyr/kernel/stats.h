@@ -20,8 +20,35 @@ struct k_cycle_stats {
 	uint64_t  current;      /* # of cycles in current usage window */
 	uint64_t  longest;      /* # of cycles in longest usage window */
 	uint32_t  num_windows;  /* # of usage windows */
+#endif
+#ifdef CONFIG_SMP
+	uint32_t  migrations;   /* # of times switched in on a new CPU */
 #endif
 	bool      track_usage;  /* true if gathering usage stats */
 };
 
+#ifdef CONFIG_THREAD_LATENCY_STATS
+/**
+ * @brief Log2 histogram of durations, in cycles
+ *
+ * Bucket i counts durations of 2^i up to 2^(i+1) - 1 cycles (bucket 0
+ * also counts zero), the last bucket counts everything longer.  The
+ * cycles are those of the thread runtime statistics clock.
+ */
+struct k_latency_hist {
+	uint32_t buckets[CONFIG_THREAD_LATENCY_STATS_BUCKETS];
+	uint32_t max;           /* longest duration seen */
+};
+
+/**
+ * @brief Scheduling latency statistics of a thread
+ */
+struct k_thread_latency_stats {
+	/** From being made ready (woken, started, resumed) to running */
+	struct k_latency_hist ready;
+	/** Of each period the thread ran before being switched out */
+	struct k_latency_hist run;
+};
+#endif
+
 #endif
@@ -40,6 +40,7 @@ struct __thread_entry {
 #endif
 
 struct k_thread;
+struct k_pipe_iovec;
 
 /*
  * This _pipe_desc structure is used by the pipes kernel module when
@@ -49,8 +50,11 @@ struct k_thread;
 struct _pipe_desc {
 	sys_dnode_t      node;
 	unsigned char   *buffer;         /* Position in src/dest buffer */
-	size_t           bytes_to_xfer;  /* # bytes left to transfer */
+	size_t           bytes_to_xfer;  /* # bytes left in this segment */
 	struct k_thread *thread;         /* Back pointer to pended thread */
+	const struct k_pipe_iovec *iov;  /* Segments not yet started */
+	size_t           iov_cnt;        /* # segments not yet started */
+	size_t           iov_bytes;      /* # bytes in segments not started */
 };
 
 /* can be used for creating 'dummy' threads, e.g. for pending on objects */
@@ -110,7 +114,9 @@ struct _thread_base {
 	/* True for the per-CPU idle threads */
 	uint8_t is_idle;
 
-	/* CPU index on which thread was last run */
+	/* CPU index on which thread was last run, or
+	 * Z_THREAD_CPU_NONE if it has never run
+	 */
 	uint8_t cpu;
 
 	/* Recursive count of irq_lock() calls */
@@ -118,6 +124,13 @@ struct _thread_base {
 
 #endif
 
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	/* CPU whose run queue holds this thread, or on which it was
+	 * last selected to run
+	 */
+	uint8_t runq_cpu;
+#endif
+
 #ifdef CONFIG_SCHED_CPU_MASK
 	/* "May run on" bits for each CPU */
 	uint8_t cpu_mask;
@@ -137,9 +150,29 @@ struct _thread_base {
 	void *slice_data;
 #endif
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	/* constant bandwidth server parameters, in ticks, budget is 0 if
+	 * the thread has no server
+	 */
+	int32_t cbs_budget;
+	int32_t cbs_period;
+
+	/* budget left in the current server period */
+	int32_t cbs_remaining;
+
+	/* replenishes the budget of a throttled thread */
+	struct _timeout cbs_timeout;
+#endif
+
 #ifdef CONFIG_SCHED_THREAD_USAGE
 	struct k_cycle_stats  usage;   /* Track thread usage statistics */
 #endif
+
+#ifdef CONFIG_THREAD_LATENCY_STATS
+	uint32_t ready_stamp;  /* when made ready, 0 once running */
+	uint32_t run_stamp;    /* when last switched in */
+	struct k_thread_latency_stats latency;
+#endif
 };
 
 typedef struct _thread_base _thread_base_t;
@@ -166,6 +199,13 @@ struct _thread_stack_info {
 	 * is the initial stack pointer for a thread. May be 0.
 	 */
 	size_t delta;
+
+#ifdef CONFIG_THREAD_ANALYZER_WATERMARK
+	/* Lowest stack address the thread analyzer found used, or 0 if
+	 * the stack was not analyzed yet.
+	 */
+	uintptr_t watermark;
+#endif
 };
 
 typedef struct _thread_stack_info _thread_stack_info_t;
@@ -179,6 +219,17 @@ struct _mem_domain_info {
 	struct k_mem_domain *mem_domain;
 };
 
+#ifdef CONFIG_OBJ_VALIDATION_CACHE
+/* Kernel objects the thread recently passed to system calls */
+struct _obj_validation_cache {
+	const void *obj[CONFIG_OBJ_VALIDATION_CACHE_SIZE];
+	uint8_t type[CONFIG_OBJ_VALIDATION_CACHE_SIZE];
+	/* Flush generation the entries were validated in */
+	uint32_t gen;
+	uint8_t next;
+};
+#endif /* CONFIG_OBJ_VALIDATION_CACHE */
+
 #endif /* CONFIG_USERSPACE */
 
 #ifdef CONFIG_THREAD_USERSPACE_LOCAL_DATA
@@ -223,6 +274,15 @@ typedef struct k_thread_runtime_stats {
 	uint64_t idle_cycles;
 #endif
 
+#if defined(CONFIG_SCHED_THREAD_USAGE) && defined(CONFIG_SMP)
+	/*
+	 * Number of times the thread was switched in on a different CPU
+	 * than the one it last ran on. For CPU statistics, the number of
+	 * times a thread migrated to that CPU.
+	 */
+	uint64_t migrations;
+#endif
+
 #if defined(__cplusplus) && !defined(CONFIG_SCHED_THREAD_USAGE) &&                                 \
 	!defined(CONFIG_SCHED_THREAD_USAGE_ANALYSIS) && !defined(CONFIG_SCHED_THREAD_USAGE_ALL)
 	/* If none of the above Kconfig values are defined, this struct will have a size 0 in C
@@ -307,6 +367,10 @@ struct k_thread {
 	k_thread_stack_t *stack_obj;
 	/** current syscall frame pointer */
 	void *syscall_frame;
+#ifdef CONFIG_OBJ_VALIDATION_CACHE
+	/** recently validated kernel objects */
+	struct _obj_validation_cache obj_cache;
+#endif
 #endif /* CONFIG_USERSPACE */
 
 
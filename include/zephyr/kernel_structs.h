@@ -62,6 +62,9 @@ extern "C" {
 /* Thread is being aborted */
 #define _THREAD_ABORTING (BIT(5))
 
+/* Thread has exhausted its bandwidth server budget */
+#define _THREAD_THROTTLED (BIT(6))
+
 /* Thread is present in the ready queue */
 #define _THREAD_QUEUED (BIT(7))
 
@@ -92,6 +95,13 @@ struct _ready_q {
 	struct _priq_rb runq;
 #elif defined(CONFIG_SCHED_MULTIQ)
 	struct _priq_mq runq;
+#elif defined(CONFIG_SCHED_BITMAP)
+	struct _priq_bm runq;
+#endif
+
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	/* number of threads in runq, used to pick a CPU to steal from */
+	uint32_t nr_ready;
 #endif
 };
 
@@ -110,7 +120,7 @@ struct _cpu {
 	/* one assigned idle thread per CPU */
 	struct k_thread *idle_thread;
 
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#ifdef CONFIG_SCHED_CPU_READY_QUEUES
 	struct _ready_q ready_q;
 #endif
 
@@ -166,7 +176,7 @@ struct z_kernel {
 	 * ready queue: can be big, keep after small fields, since some
 	 * assembly (e.g. ARC) are limited in the encoding of the offset
 	 */
-#ifndef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#ifndef CONFIG_SCHED_CPU_READY_QUEUES
 	struct _ready_q ready_q;
 #endif
 
@@ -8,6 +8,7 @@
 
 #include <zephyr/logging/log_msg.h>
 #include <zephyr/logging/log_output.h>
+#include <zephyr/logging/log_output_dict.h>
 #include <zephyr/kernel.h>
 
 #ifdef __cplusplus
@@ -57,6 +58,27 @@ log_backend_std_dropped(const struct log_output *const output, uint32_t cnt)
 	log_output_dropped_process(output, cnt);
 }
 
+/** @brief Report dropped messages in the backend's current output format.
+ *
+ * Text and SyS-T outputs report them as a text line, dictionary output as
+ * a dropped messages record decoded by the host tooling.
+ *
+ * @param output	Log output instance.
+ * @param cnt		Number of dropped messages.
+ * @param log_type	Current output format (LOG_OUTPUT_XXX).
+ */
+static inline void
+log_backend_std_dropped_format(const struct log_output *const output,
+			       uint32_t cnt, uint32_t log_type)
+{
+	if (IS_ENABLED(CONFIG_LOG_DICTIONARY_SUPPORT) &&
+	    (log_type == LOG_OUTPUT_DICT)) {
+		log_dict_output_dropped_process(output, cnt);
+	} else {
+		log_backend_std_dropped(output, cnt);
+	}
+}
+
 /**
  * @}
  */
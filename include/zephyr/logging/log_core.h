@@ -191,6 +191,59 @@ static inline char z_log_minimal_level_to_char(int level)
 
 #define Z_LOG_INST(_inst) COND_CODE_1(CONFIG_LOG, (_inst), NULL)
 
+/** @internal
+ * @brief Rate limiting state of a logging call site.
+ */
+struct log_ratelimit {
+	uint32_t start;
+	uint32_t count;
+	uint32_t suppressed;
+};
+
+/** @internal
+ * @brief Check if a message from a call site may be logged.
+ *
+ * Counts messages of the call site in the current interval. Once the
+ * interval is over and messages were suppressed, a message reporting
+ * their number is logged on behalf of the call site.
+ *
+ * @param rl     Call site rate limiting state.
+ * @param level  Level of the message.
+ * @param source Source of the message.
+ *
+ * @return true if the message may be logged, false if it is suppressed.
+ */
+bool z_log_ratelimit_check(struct log_ratelimit *rl, uint8_t level,
+			   const void *source);
+
+#ifdef CONFIG_LOG_RATELIMIT
+/* Checked before the message is created, so that a suppressed message only
+ * costs incrementing a counter. User mode cannot write the call site state.
+ */
+#define Z_LOG_RATELIMIT(_level, _src) \
+	static struct log_ratelimit _log_rl; \
+	if (!k_is_user_context() && \
+	    !z_log_ratelimit_check(&_log_rl, _level, _src)) { \
+		break; \
+	}
+#else
+#define Z_LOG_RATELIMIT(_level, _src)
+#endif
+
+/** @internal
+ * @brief Check if a message is dropped by the runtime filter of its source.
+ *
+ * The filter word is checked first and the branch is hinted as not taken,
+ * so that a message costs one load and compare. Runtime filtering does not
+ * apply in user mode, the context is only checked for messages which
+ * would otherwise be dropped.
+ */
+#define Z_LOG_RUNTIME_FILTERED(_level, _dsource) \
+	(!IS_ENABLED(CONFIG_LOG_FRONTEND) && \
+	 IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) && \
+	 unlikely((_level) > Z_LOG_RUNTIME_FILTER((_dsource)->filters)) && \
+	 !k_is_user_context())
+
 /*****************************************************************************/
 /****************** Macros for standard logging ******************************/
 /*****************************************************************************/
@@ -227,16 +280,13 @@ static inline char z_log_minimal_level_to_char(int level)
 		} \
 	} \
 	\
-	bool is_user_context = k_is_user_context(); \
-	uint32_t filters = IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) ? \
-						(_dsource)->filters : 0;\
-	if (!IS_ENABLED(CONFIG_LOG_FRONTEND) && IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) && \
-	    !is_user_context && _level > Z_LOG_RUNTIME_FILTER(filters)) { \
+	if (Z_LOG_RUNTIME_FILTERED(_level, _dsource)) { \
 		break; \
 	} \
 	int _mode; \
 	void *_src = IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) ? \
 		(void *)_dsource : (void *)_source; \
+	Z_LOG_RATELIMIT(_level, _src) \
 	Z_LOG_MSG2_CREATE(UTIL_NOT(IS_ENABLED(CONFIG_USERSPACE)), _mode, \
 			  CONFIG_LOG_DOMAIN_ID, _src, _level, NULL,\
 			  0, __VA_ARGS__); \
@@ -296,18 +346,13 @@ static inline char z_log_minimal_level_to_char(int level)
 			break; \
 		} \
 	} \
-	bool is_user_context = k_is_user_context(); \
-	uint32_t filters = IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) ? \
-						(_dsource)->filters : 0;\
-	\
 	if (IS_ENABLED(CONFIG_LOG_MODE_MINIMAL)) { \
 		Z_LOG_TO_PRINTK(_level, "%s", _str); \
 		z_log_minimal_hexdump_print(_level, \
 					    (const char *)_data, _len);\
 		break; \
 	} \
-	if (!IS_ENABLED(CONFIG_LOG_FRONTEND) && IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) && \
-	    !is_user_context && _level > Z_LOG_RUNTIME_FILTER(filters)) { \
+	if (Z_LOG_RUNTIME_FILTERED(_level, _dsource)) { \
 		break; \
 	} \
 	int mode; \
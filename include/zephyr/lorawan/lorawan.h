@@ -16,6 +16,7 @@
  */
 
 #include <zephyr/device.h>
+#include <zephyr/kernel.h>
 #include <zephyr/sys/slist.h>
 
 #ifdef __cplusplus
@@ -222,6 +223,32 @@ int lorawan_start(void);
  */
 int lorawan_send(uint8_t port, uint8_t *data, uint8_t len, enum lorawan_message_type type);
 
+/**
+ * @brief Queue data for sending to the LoRaWAN network
+ *
+ * Queue data to be sent by the transmit queue thread. Payloads queued for
+ * the same port and message type are aggregated into one frame, each
+ * payload preceded by a length byte, as far as the maximum payload size
+ * of the current datarate allows. The receiving application has to split
+ * the frame accordingly. Sends that fail because of duty-cycle
+ * restrictions are retried later.
+ *
+ * @note Requires CONFIG_LORAWAN_TX_QUEUE.
+ *
+ * @param port       Port to be used for sending data, must not be 0.
+ * @param data       Data buffer to be queued, copied into the queue.
+ * @param len        Length of the buffer, at most
+ *                   CONFIG_LORAWAN_TX_QUEUE_RECORD_SIZE bytes.
+ * @param type       Specifies if the message shall be confirmed or unconfirmed.
+ *                   Must be one of @ref lorawan_message_type.
+ * @param timeout    Time to wait for space in the queue.
+ *
+ * @return 0 if queued, -EINVAL on invalid arguments, -ENOMSG or -EAGAIN
+ *         if the queue is full.
+ */
+int lorawan_send_queued(uint8_t port, const uint8_t *data, uint8_t len,
+			enum lorawan_message_type type, k_timeout_t timeout);
+
 /**
  * @brief Set the current device class
  *
@@ -33,6 +33,17 @@ struct cbor_nb_writer {
  */
 struct net_buf *mcumgr_buf_alloc(void);
 
+/**
+ * @brief Allocates a net_buf for holding an mcumgr response.
+ *
+ * Takes a buffer from the CONFIG_MCUMGR_BUF_RSP_COUNT reserved response
+ * buffers first, and from the shared pool when none of those is free.
+ *
+ * @return                      A newly-allocated buffer net_buf on success;
+ *                              NULL on failure.
+ */
+struct net_buf *mcumgr_buf_alloc_rsp(void);
+
 /**
  * @brief Frees an mcumgr net_buf
  *
@@ -58,4 +69,35 @@ void cbor_nb_writer_init(struct cbor_nb_writer *cnw,
 void cbor_nb_reader_init(struct cbor_nb_reader *cnr,
 			 struct net_buf *nb);
 
+/**
+ * @brief Reserves room for a CBOR byte string in the encoder output.
+ *
+ * Lets a caller produce byte string contents directly in the response buffer,
+ * e.g. by reading a file into it, instead of preparing them in a separate
+ * buffer that zcbor_bstr_encode_ptr() then copies. The reservation is
+ * completed with cbor_nb_bstr_commit(); nothing else may be encoded in
+ * between.
+ *
+ * @param zse                   The encoder state.
+ * @param len                   In: the wanted number of bytes; out: the
+ *                              number of bytes that fit, possibly fewer.
+ *
+ * @return                      Where to place the byte string contents;
+ *                              NULL if not even an empty byte string fits.
+ */
+uint8_t *cbor_nb_bstr_reserve(zcbor_state_t *zse, size_t *len);
+
+/**
+ * @brief Encodes a byte string previously reserved with
+ * cbor_nb_bstr_reserve().
+ *
+ * @param zse                   The encoder state.
+ * @param data                  The pointer returned by cbor_nb_bstr_reserve().
+ * @param len                   Number of bytes placed at @p data, not more
+ *                              than were reserved.
+ *
+ * @return                      true on success; false on failure.
+ */
+bool cbor_nb_bstr_commit(zcbor_state_t *zse, uint8_t *data, size_t len);
+
 #endif
@@ -79,6 +79,9 @@ struct zephyr_smp_transport {
 	/* FIFO containing incoming requests to be processed. */
 	struct k_fifo zst_fifo;
 
+	/* Work queue processing the requests of this transport. */
+	struct k_work_q *zst_work_queue;
+
 	zephyr_smp_transport_out_fn *zst_output;
 	zephyr_smp_transport_get_mtu_fn *zst_get_mtu;
 	zephyr_smp_transport_ud_copy_fn *zst_ud_copy;
@@ -31,6 +31,7 @@
 #define ZEPHYR_INCLUDE_MODBUS_H_
 
 #include <zephyr/drivers/uart.h>
+#include <zephyr/sys/byteorder.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -330,6 +331,51 @@ int modbus_write_holding_regs_fp(const int iface,
 				 float *const reg_buf,
 				 const uint16_t num_regs);
 
+/**
+ * @brief Register map served directly by the server
+ *
+ * The register values are kept in big-endian (wire) byte order, so that
+ * a read request within the map is answered with a single copy and
+ * without calling the register read callback. Use
+ * modbus_reg_map_set() and modbus_reg_map_get() to access the values.
+ * Write requests are still passed to the write callbacks.
+ */
+struct modbus_reg_map {
+	/** Address of the first register in the map */
+	uint16_t start_addr;
+	/** Number of registers in the map */
+	uint16_t num_regs;
+	/** Register values in big-endian byte order */
+	uint16_t *regs;
+};
+
+/**
+ * @brief Set register value in a register map
+ *
+ * @param map        Pointer to the register map
+ * @param addr       Register address, must be within the map
+ * @param reg        Register value
+ */
+static inline void modbus_reg_map_set(const struct modbus_reg_map *map,
+				      const uint16_t addr, const uint16_t reg)
+{
+	map->regs[addr - map->start_addr] = sys_cpu_to_be16(reg);
+}
+
+/**
+ * @brief Get register value from a register map
+ *
+ * @param map        Pointer to the register map
+ * @param addr       Register address, must be within the map
+ *
+ * @retval           Register value
+ */
+static inline uint16_t modbus_reg_map_get(const struct modbus_reg_map *map,
+					  const uint16_t addr)
+{
+	return sys_be16_to_cpu(map->regs[addr - map->start_addr]);
+}
+
 /** Modbus Server User Callback structure */
 struct modbus_user_callbacks {
 	/** Coil read callback */
@@ -358,6 +404,12 @@ struct modbus_user_callbacks {
 
 	/** Floating Point Holding Register write callback */
 	int (*holding_reg_wr_fp)(uint16_t addr, float reg);
+
+	/** Optional Input Register map, takes precedence over input_reg_rd */
+	const struct modbus_reg_map *input_reg_map;
+
+	/** Optional Holding Register map, takes precedence over holding_reg_rd */
+	const struct modbus_reg_map *holding_reg_map;
 };
 
 /**
@@ -521,6 +573,26 @@ void modbus_raw_get_header(struct modbus_adu *adu, const uint8_t *header);
  */
 void modbus_raw_set_server_failure(struct modbus_adu *adu);
 
+/**
+ * @brief Start the built-in Modbus TCP server
+ *
+ * Serves Modbus TCP requests arriving on @p port with an interface that
+ * has been configured as raw ADU server. Up to
+ * CONFIG_MODBUS_TCP_SERVER_MAX_CONNECTIONS clients are served by a single
+ * thread, and requests pipelined by a client are answered in order of
+ * arrival. The raw ADU callback of the interface is not used, and the
+ * interface must not be fed with modbus_raw_submit_rx() at the same time.
+ *
+ * @param iface      Modbus raw ADU server interface index
+ * @param port       TCP port to listen on, usually 502
+ *
+ * @retval           0 If the server was started
+ * @retval           -EALREADY If the server is already running
+ * @retval           -ENOTSUP If the interface is not a raw ADU server
+ * @retval           -errno Negative errno code on socket failure
+ */
+int modbus_tcp_server_start(const int iface, const uint16_t port);
+
 /**
  * @brief Use interface as backend to send and receive ADU
  *
@@ -12,6 +12,8 @@
 #ifndef ZEPHYR_INCLUDE_MULTI_HEAP_MANAGER_SMH_H_
 #define ZEPHYR_INCLUDE_MULTI_HEAP_MANAGER_SMH_H_
 
+#include <zephyr/sys/mem_stats.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -94,6 +96,13 @@ struct shared_multi_heap_region {
 
 	/** Memory heap size in bytes */
 	size_t size;
+
+	/**
+	 * Bitmask of the CPUs the region is local to. Allocations prefer the
+	 * regions local to the calling CPU. 0 if the region is equally close
+	 * to all CPUs.
+	 */
+	uint32_t cpu_mask;
 };
 
 /**
@@ -119,6 +128,10 @@ int shared_multi_heap_pool_init(void);
  * specified capability / attribute. The opaque attribute parameter is used
  * by the backend to select the correct heap to allocate memory from.
  *
+ * With CONFIG_SHARED_MULTI_HEAP_CACHE_LINE_ALIGN, blocks with the
+ * @ref SMH_REG_ATTR_CACHEABLE attribute are aligned and padded to the
+ * d-cache line size, so they can be used for DMA.
+ *
  * @param attr		capability / attribute requested for the memory block.
  * @param bytes		requested size of the allocation in bytes.
  *
@@ -171,6 +184,23 @@ void shared_multi_heap_free(void *block);
  */
 int shared_multi_heap_add(struct shared_multi_heap_region *region, void *user_data);
 
+/**
+ * @brief Get the runtime statistics of an attribute
+ *
+ * Sums up the runtime statistics of all the regions added with the
+ * attribute. The maximum allocated bytes are the sum of the maxima of the
+ * individual regions.
+ *
+ * @note Requires CONFIG_SYS_HEAP_RUNTIME_STATS.
+ *
+ * @param attr		capability / attribute of the regions.
+ * @param stats		pointer to the statistics to fill in.
+ *
+ * @retval 0		on success.
+ * @retval -EINVAL	when the attribute is out-of-bound or @p stats is NULL.
+ */
+int shared_multi_heap_stats_get(unsigned int attr, struct sys_memory_stats *stats);
+
 /**
  * @}
  */
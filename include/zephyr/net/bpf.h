@@ -0,0 +1,129 @@
+/** @file
+ * @brief Classic BPF program format
+ *
+ * Definitions of the classic Berkeley Packet Filter instruction set, binary
+ * compatible with the ones of other systems so that existing filter programs
+ * can be used as is.
+ */
+
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_BPF_H_
+#define ZEPHYR_INCLUDE_NET_BPF_H_
+
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Classic BPF program format
+ * @defgroup net_bpf Classic BPF
+ * @ingroup net_pkt_filter
+ * @{
+ */
+
+/** @brief One BPF instruction */
+struct sock_filter {
+	uint16_t code;	/**< Opcode */
+	uint8_t jt;	/**< Jump offset if true */
+	uint8_t jf;	/**< Jump offset if false */
+	uint32_t k;	/**< Generic field */
+};
+
+/** @brief BPF program, as given to SO_ATTACH_FILTER */
+struct sock_fprog {
+	unsigned short len;		/**< Number of instructions */
+	struct sock_filter *filter;	/**< Instructions */
+};
+
+/** Maximum number of instructions of a program */
+#define BPF_MAXINSNS 4096
+
+/** Number of words of the scratch memory */
+#define BPF_MEMWORDS 16
+
+/** @cond INTERNAL_HIDDEN */
+
+/* Instruction classes */
+#define BPF_CLASS(code) ((code) & 0x07)
+#define BPF_LD		0x00
+#define BPF_LDX		0x01
+#define BPF_ST		0x02
+#define BPF_STX		0x03
+#define BPF_ALU		0x04
+#define BPF_JMP		0x05
+#define BPF_RET		0x06
+#define BPF_MISC	0x07
+
+/* Load size */
+#define BPF_SIZE(code)	((code) & 0x18)
+#define BPF_W		0x00
+#define BPF_H		0x08
+#define BPF_B		0x10
+
+/* Load mode */
+#define BPF_MODE(code)	((code) & 0xe0)
+#define BPF_IMM		0x00
+#define BPF_ABS		0x20
+#define BPF_IND		0x40
+#define BPF_MEM		0x60
+#define BPF_LEN		0x80
+#define BPF_MSH		0xa0
+
+/* ALU and jump operations */
+#define BPF_OP(code)	((code) & 0xf0)
+#define BPF_ADD		0x00
+#define BPF_SUB		0x10
+#define BPF_MUL		0x20
+#define BPF_DIV		0x30
+#define BPF_OR		0x40
+#define BPF_AND		0x50
+#define BPF_LSH		0x60
+#define BPF_RSH		0x70
+#define BPF_NEG		0x80
+#define BPF_MOD		0x90
+#define BPF_XOR		0xa0
+
+#define BPF_JA		0x00
+#define BPF_JEQ		0x10
+#define BPF_JGT		0x20
+#define BPF_JGE		0x30
+#define BPF_JSET	0x40
+
+/* Operand source */
+#define BPF_SRC(code)	((code) & 0x08)
+#define BPF_K		0x00
+#define BPF_X		0x08
+
+/* Return value */
+#define BPF_RVAL(code)	((code) & 0x18)
+#define BPF_A		0x10
+
+/* Miscellaneous operations */
+#define BPF_MISCOP(code) ((code) & 0xf8)
+#define BPF_TAX		0x00
+#define BPF_TXA		0x80
+
+/** @endcond */
+
+/** Build a non jump instruction */
+#define BPF_STMT(_code, _k) \
+	{ (uint16_t)(_code), 0, 0, (_k) }
+
+/** Build a jump instruction */
+#define BPF_JUMP(_code, _k, _jt, _jf) \
+	{ (uint16_t)(_code), (_jt), (_jf), (_k) }
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_NET_BPF_H_ */
@@ -1005,6 +1005,14 @@ struct net_buf_pool {
 	const char *name;
 #endif /* CONFIG_NET_BUF_POOL_USAGE */
 
+#if defined(CONFIG_NET_BUF_POOL_LOCKFREE)
+	/** Bitmap of the buffers in use */
+	atomic_t *const used;
+
+	/** Number of threads waiting for a free buffer */
+	atomic_t waiters;
+#endif /* CONFIG_NET_BUF_POOL_LOCKFREE */
+
 	/** Optional destroy callback when buffer is freed. */
 	void (*const destroy)(struct net_buf *buf);
 
@@ -1016,6 +1024,15 @@ struct net_buf_pool {
 };
 
 /** @cond INTERNAL_HIDDEN */
+#if defined(CONFIG_NET_BUF_POOL_LOCKFREE)
+#define _NET_BUF_POOL_USED_DEFINE(_name, _count) \
+	static ATOMIC_DEFINE(_net_buf_used_##_name, _count);
+#define _NET_BUF_POOL_USED_INIT(_pool) .used = _net_buf_used_##_pool,
+#else
+#define _NET_BUF_POOL_USED_DEFINE(_name, _count)
+#define _NET_BUF_POOL_USED_INIT(_pool)
+#endif /* CONFIG_NET_BUF_POOL_LOCKFREE */
+
 #if defined(CONFIG_NET_BUF_POOL_USAGE)
 #define NET_BUF_POOL_INITIALIZER(_pool, _alloc, _bufs, _count, _ud_size, _destroy) \
 	{                                                                          \
@@ -1026,6 +1043,7 @@ struct net_buf_pool {
 		.user_data_size = _ud_size,                                        \
 		.avail_count = ATOMIC_INIT(_count),                                \
 		.name = STRINGIFY(_pool),                                          \
+		_NET_BUF_POOL_USED_INIT(_pool)                                     \
 		.destroy = _destroy,                                               \
 		.alloc = _alloc,                                                   \
 		.__bufs = (struct net_buf *)_bufs,                                 \
@@ -1038,6 +1056,7 @@ struct net_buf_pool {
 		.buf_count = _count,                                               \
 		.uninit_count = _count,                                            \
 		.user_data_size = _ud_size,                                        \
+		_NET_BUF_POOL_USED_INIT(_pool)                                     \
 		.destroy = _destroy,                                               \
 		.alloc = _alloc,                                                   \
 		.__bufs = (struct net_buf *)_bufs,                                 \
@@ -1055,6 +1074,7 @@ struct net_buf_pool {
 	BUILD_ASSERT(sizeof(struct _net_buf_##_name) ==					       \
 		     ROUND_UP(sizeof(struct net_buf) + _ud_size, __alignof__(struct net_buf)), \
 		     "Size cannot be determined");					       \
+	_NET_BUF_POOL_USED_DEFINE(_name, _count)					       \
 	static struct _net_buf_##_name _net_buf_##_name[_count] __noinit
 
 extern const struct net_buf_data_alloc net_buf_heap_alloc;
@@ -1269,6 +1289,25 @@ static inline struct net_buf * __must_check net_buf_alloc(struct net_buf_pool *p
 	return net_buf_alloc_fixed(pool, timeout);
 }
 
+/**
+ * @brief Allocate several fixed buffers from a pool at once.
+ *
+ * Does not wait for buffers to be freed. With
+ * @kconfig{CONFIG_NET_BUF_POOL_LOCKFREE}, the buffers are taken from the
+ * pool with as few atomic operations as possible, which makes this cheaper
+ * than as many net_buf_alloc_fixed() calls.
+ *
+ * @param pool Which pool to allocate the buffers from, it must be a
+ *        fixed-size pool.
+ * @param bufs Array receiving the buffers.
+ * @param count Number of buffers wanted.
+ *
+ * @return Number of buffers allocated, which may be less than @a count
+ *         if the pool is running out of buffers.
+ */
+int net_buf_alloc_batch(struct net_buf_pool *pool, struct net_buf **bufs,
+			int count);
+
 /**
  * @brief Allocate a new variable length buffer from a pool.
  *
@@ -1364,12 +1403,16 @@ struct net_buf * __must_check net_buf_get(struct k_fifo *fifo,
  *
  * @param buf Buffer to destroy.
  */
+#if defined(CONFIG_NET_BUF_POOL_LOCKFREE)
+void net_buf_destroy(struct net_buf *buf);
+#else
 static inline void net_buf_destroy(struct net_buf *buf)
 {
 	struct net_buf_pool *pool = net_buf_pool_get(buf->pool_id);
 
 	k_lifo_put(&pool->free, buf);
 }
+#endif
 
 /**
  * @brief Reset buffer
@@ -14,6 +14,8 @@
 #define ZEPHYR_INCLUDE_NET_CAPTURE_H_
 
 #include <zephyr/kernel.h>
+#include <string.h>
+#include <zephyr/net/net_ip.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -192,8 +194,164 @@ static inline int net_capture_send(const struct device *dev, struct net_if *ifac
 #endif
 }
 
+/**
+ * @typedef net_capture_filter_cb_t
+ * @brief Callback selecting the packets saved to the capture ring.
+ *
+ * It is called in the context of the network stack, so it must be short.
+ *
+ * @param iface Network interface the packet was captured on
+ * @param pkt The network packet captured
+ * @param user_data User data given in the ring parameters
+ *
+ * @return True if the packet is saved, false if it is skipped.
+ */
+typedef bool (*net_capture_filter_cb_t)(struct net_if *iface,
+					struct net_pkt *pkt,
+					void *user_data);
+
+/**
+ * @brief Parameters of a capture to the in-RAM ring.
+ */
+struct net_capture_ring_params {
+	/** Network interface where the packets are captured */
+	struct net_if *iface;
+
+	/** Maximum number of bytes saved of each packet, 0 for all */
+	uint32_t snaplen;
+
+	/** Only save the IP packets of this family, AF_UNSPEC for all the
+	 * packets.
+	 */
+	sa_family_t family;
+
+	/** Only save the IP packets of this protocol (IPPROTO_UDP, ...),
+	 * 0 for all.
+	 */
+	uint8_t proto;
+
+	/** Only save the UDP or TCP packets having this source or
+	 * destination port (in host byte order), 0 for all.
+	 */
+	uint16_t port;
+
+	/** Further filtering of the packets, may be NULL */
+	net_capture_filter_cb_t filter;
+
+	/** User data given to the filter */
+	void *user_data;
+
+	/** File the capture is written to, NULL if the application reads
+	 * it with net_capture_ring_read(). Requires CONFIG_FILE_SYSTEM.
+	 */
+	const char *file;
+};
+
+/**
+ * @brief Statistics of the capture to the in-RAM ring.
+ */
+struct net_capture_ring_stats {
+	/** Number of packets saved */
+	uint32_t saved;
+
+	/** Number of packets dropped as the ring was full */
+	uint32_t dropped;
+
+	/** Number of packets skipped by the filter */
+	uint32_t filtered;
+};
+
+/**
+ * @brief Start capturing packets to the in-RAM ring.
+ *
+ * @details The packets are saved with their timestamp in pcapng format,
+ * from the context of the network stack, without waiting. The ring starts
+ * with the pcapng section header, so what is read from it can be opened
+ * as is with Wireshark. If no file is given, the application has to read
+ * the ring with net_capture_ring_read() fast enough, else packets are
+ * dropped. Otherwise the ring is written to the file from the system work
+ * queue, every CONFIG_NET_CAPTURE_RING_FLUSH_PERIOD ms.
+ *
+ * @param params Parameters of the capture
+ *
+ * @return 0 if ok, -EALREADY if a capture is already started, <0 if error.
+ */
+#if defined(CONFIG_NET_CAPTURE_RING)
+int net_capture_ring_start(const struct net_capture_ring_params *params);
+#else
+static inline int net_capture_ring_start(const struct net_capture_ring_params *params)
+{
+	ARG_UNUSED(params);
+
+	return -ENOTSUP;
+}
+#endif
+
+/**
+ * @brief Stop capturing packets to the in-RAM ring.
+ *
+ * @details If the capture is written to a file, what remains in the ring
+ * is written to it and the file is closed. Otherwise the ring can still
+ * be read until the next capture is started.
+ *
+ * @return 0 if ok, <0 if error.
+ */
+#if defined(CONFIG_NET_CAPTURE_RING)
+int net_capture_ring_stop(void);
+#else
+static inline int net_capture_ring_stop(void)
+{
+	return -ENOTSUP;
+}
+#endif
+
+/**
+ * @brief Read the capture saved in the in-RAM ring.
+ *
+ * @param buf Buffer the data is copied to
+ * @param len Length of the buffer
+ *
+ * @return Number of bytes read, 0 if the ring is empty, -EBUSY if the
+ * capture is written to a file, <0 if error.
+ */
+#if defined(CONFIG_NET_CAPTURE_RING)
+int net_capture_ring_read(uint8_t *buf, size_t len);
+#else
+static inline int net_capture_ring_read(uint8_t *buf, size_t len)
+{
+	ARG_UNUSED(buf);
+	ARG_UNUSED(len);
+
+	return -ENOTSUP;
+}
+#endif
+
+/**
+ * @brief Get the statistics of the capture to the in-RAM ring.
+ *
+ * @param stats Statistics of the current or last capture
+ */
+#if defined(CONFIG_NET_CAPTURE_RING)
+void net_capture_ring_stats_get(struct net_capture_ring_stats *stats);
+#else
+static inline void net_capture_ring_stats_get(struct net_capture_ring_stats *stats)
+{
+	memset(stats, 0, sizeof(*stats));
+}
+#endif
+
 /** @cond INTERNAL_HIDDEN */
 
+#if defined(CONFIG_NET_CAPTURE_RING)
+void net_capture_ring_pkt(struct net_if *iface, struct net_pkt *pkt);
+#else
+static inline void net_capture_ring_pkt(struct net_if *iface, struct net_pkt *pkt)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(pkt);
+}
+#endif
+
 /**
  * @brief Check if the network packet needs to be captured or not.
  *        This is called for every network packet being sent.
@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** @file
+ *
+ * @brief CoAP block-wise transfer engine
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_COAP_TRANSFER_H_
+#define ZEPHYR_INCLUDE_NET_COAP_TRANSFER_H_
+
+/**
+ * @brief CoAP block-wise transfers
+ * @defgroup coap_transfer CoAP block-wise transfers
+ * @ingroup networking
+ * @{
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/coap.h>
+#include <zephyr/net/socket.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct coap_transfer;
+
+/**
+ * @typedef coap_transfer_data_cb_t
+ * @brief Callback receiving the body of a download, block after block.
+ *
+ * The blocks are given in order, even if they were received out of order.
+ *
+ * @param xfer Transfer the data belongs to
+ * @param offset Offset of the data in the body
+ * @param data Data of the block
+ * @param len Length of the data
+ * @param last True for the last block of the body
+ * @param user_data User data of the transfer
+ *
+ * @return 0 to go on with the transfer, <0 to abort it with that error.
+ */
+typedef int (*coap_transfer_data_cb_t)(struct coap_transfer *xfer,
+				       size_t offset, const uint8_t *data,
+				       size_t len, bool last, void *user_data);
+
+/**
+ * @typedef coap_transfer_read_cb_t
+ * @brief Callback providing the body of an upload, block after block.
+ *
+ * @param xfer Transfer the data belongs to
+ * @param offset Offset of the data in the body
+ * @param data Buffer to fill
+ * @param len Length of the buffer, i.e. the block size
+ * @param user_data User data of the transfer
+ *
+ * @return Number of bytes read, less than @p len for the last block, or <0
+ * to abort the transfer with that error.
+ */
+typedef int (*coap_transfer_read_cb_t)(struct coap_transfer *xfer,
+				       size_t offset, uint8_t *data,
+				       size_t len, void *user_data);
+
+/**
+ * @typedef coap_transfer_done_cb_t
+ * @brief Callback called once a transfer ended.
+ *
+ * @param xfer Transfer that ended
+ * @param result 0 if the transfer succeeded, <0 if error: -ETIMEDOUT if
+ * the server did not answer, -ECONNRESET if it reset the exchange,
+ * -EPROTO if it sent a response with an error code or an invalid block.
+ * @param code Code of the last response, 0 if none was received
+ * @param user_data User data of the transfer
+ */
+typedef void (*coap_transfer_done_cb_t)(struct coap_transfer *xfer,
+					int result, uint8_t code,
+					void *user_data);
+
+/** @cond INTERNAL_HIDDEN */
+enum coap_transfer_block_state {
+	COAP_TRANSFER_BLOCK_FREE,
+	COAP_TRANSFER_BLOCK_SENT,
+	COAP_TRANSFER_BLOCK_ACKED,
+	COAP_TRANSFER_BLOCK_RECEIVED,
+};
+
+/* Request of a block, whose buffer keeps the request until the response
+ * replaces it.
+ */
+struct coap_transfer_block {
+	sys_dnode_t node;
+	struct coap_transfer *xfer;
+	struct coap_pending pending;
+	uint32_t num;
+	uint16_t len;
+	uint8_t token[COAP_TOKEN_MAX_LEN];
+	uint8_t state;
+	bool more;
+	uint8_t buf[CONFIG_COAP_TRANSFER_BUF_SIZE];
+};
+/** @endcond */
+
+/**
+ * @brief Parameters of a transfer.
+ */
+struct coap_transfer_params {
+	/** Method of the request. COAP_METHOD_GET downloads the body of
+	 * the resource with Block2, COAP_METHOD_PUT and COAP_METHOD_POST
+	 * upload it with Block1.
+	 */
+	enum coap_method method;
+
+	/** Path of the resource, for example "fw/image.bin" */
+	const char *path;
+
+	/** Block size requested. The server can reduce it in its first
+	 * response.
+	 */
+	enum coap_block_size block_size;
+
+	/** Number of blocks requested at the same time by a download, at
+	 * most CONFIG_COAP_TRANSFER_MAX_INFLIGHT. Uploads always send one
+	 * block at a time, as servers handle Block1 atomically.
+	 */
+	uint8_t window;
+
+	/** Size of the body of an upload, given to the server with Size1.
+	 * 0 if not known.
+	 */
+	size_t total_size;
+
+	/** Callback receiving the body of a download */
+	coap_transfer_data_cb_t data_cb;
+
+	/** Callback providing the body of an upload */
+	coap_transfer_read_cb_t read_cb;
+
+	/** Callback called once the transfer ended, may be NULL */
+	coap_transfer_done_cb_t done_cb;
+
+	/** User data given to the callbacks */
+	void *user_data;
+};
+
+/**
+ * @brief Block-wise transfer with a CoAP server.
+ *
+ * The content of this structure is internal, the application only
+ * allocates it and uses the coap_transfer_*() functions.
+ */
+struct coap_transfer {
+	/** @cond INTERNAL_HIDDEN */
+	struct coap_transfer_params params;
+	struct k_mutex lock;
+	struct sockaddr addr;
+	socklen_t addrlen;
+	int sock;
+	size_t offset;
+	uint32_t next_num;
+	uint32_t deliver_num;
+	uint32_t last_num;
+	bool last_known;
+	bool size_fixed;
+	bool done;
+	int result;
+	uint8_t code;
+	struct coap_transfer_block blocks[CONFIG_COAP_TRANSFER_MAX_INFLIGHT];
+	uint8_t recv_buf[CONFIG_COAP_TRANSFER_BUF_SIZE];
+	/** @endcond */
+};
+
+/**
+ * @brief Start a block-wise transfer.
+ *
+ * The requests are sent with @p sock, which the application has to read
+ * the responses from and give them to coap_transfer_input(), or let
+ * coap_transfer_run() do it. Retransmissions are timed by a timer wheel
+ * shared by all the transfers, serviced from the system work queue.
+ *
+ * @param xfer Transfer to start
+ * @param sock UDP socket the requests are sent with
+ * @param addr Address of the server
+ * @param addrlen Length of the address
+ * @param params Parameters of the transfer, copied to @p xfer
+ *
+ * @return 0 if ok, <0 if error.
+ */
+int coap_transfer_start(struct coap_transfer *xfer, int sock,
+			const struct sockaddr *addr, socklen_t addrlen,
+			const struct coap_transfer_params *params);
+
+/**
+ * @brief Give a packet received on the socket of a transfer to it.
+ *
+ * @param xfer Transfer the packet may belong to
+ * @param data Data of the packet
+ * @param len Length of the packet
+ * @param from Sender of the packet
+ *
+ * @return 0 if the packet was handled, -ENOENT if it does not belong to
+ * the transfer, <0 if it is invalid.
+ */
+int coap_transfer_input(struct coap_transfer *xfer, uint8_t *data,
+			uint16_t len, const struct sockaddr *from);
+
+/**
+ * @brief Receive the responses of a transfer until it ended.
+ *
+ * @param xfer Transfer started with coap_transfer_start()
+ *
+ * @return Result of the transfer, as given to its done callback.
+ */
+int coap_transfer_run(struct coap_transfer *xfer);
+
+/**
+ * @brief Abort a transfer.
+ *
+ * The done callback is called with -ECANCELED, unless the transfer
+ * already ended.
+ *
+ * @param xfer Transfer to abort
+ */
+void coap_transfer_cancel(struct coap_transfer *xfer);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_NET_COAP_TRANSFER_H_ */
@@ -240,6 +240,17 @@ struct dns_resolve_context {
 		 * cannot be used to find correct pending query.
 		 */
 		uint16_t query_hash;
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+		/** Addresses received so far, cached when the query is done */
+		struct sockaddr cache_addrs[CONFIG_DNS_RESOLVER_CACHE_MAX_ADDRS];
+
+		/** Lowest time to live of the received addresses */
+		uint32_t cache_ttl;
+
+		/** Number of addresses in cache_addrs */
+		uint8_t cache_count;
+#endif
 	} queries[CONFIG_DNS_NUM_CONCUR_QUERIES];
 
 	/** Is this context in use */
@@ -377,6 +388,21 @@ int dns_resolve_name(struct dns_resolve_context *ctx,
 		     void *user_data,
 		     int32_t timeout);
 
+/**
+ * @brief Remove all the answers from the DNS cache.
+ *
+ * @details The names are then resolved by the DNS servers again. This is
+ * done automatically by dns_resolve_reconfigure(), and does nothing if
+ * CONFIG_DNS_RESOLVER_CACHE is not enabled.
+ */
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+void dns_resolve_cache_flush(void);
+#else
+static inline void dns_resolve_cache_flush(void)
+{
+}
+#endif
+
 /**
  * @brief Get default DNS context.
  *
@@ -24,6 +24,9 @@
 #define NET_DSA_PORT_MAX_COUNT 8
 #define DSA_STATUS_PERIOD_MS K_MSEC(1000)
 
+/** Flag of dsa_switch_set_mac_table_entry() invalidating the entry */
+#define DSA_MAC_TABLE_ENTRY_INVALID BIT(0)
+
 /*
  * Size of the DSA TAG:
  * - KSZ8794 - 1 byte
@@ -141,6 +144,11 @@ struct dsa_context {
 	/** Status of each port */
 	bool link_up[NET_DSA_PORT_MAX_COUNT];
 
+#if defined(CONFIG_DSA_BRIDGE_FDB_OFFLOAD)
+	/** MAC addresses programmed by the bridge, all zero if unused */
+	uint8_t fdb[CONFIG_DSA_BRIDGE_FDB_ENTRIES][6];
+#endif
+
 	/** Instance specific data */
 	void *prv_data;
 };
@@ -252,6 +260,24 @@ int dsa_switch_get_mac_table_entry(struct net_if *iface,
 					uint8_t *buf,
 					uint16_t tbl_entry_idx);
 
+/**
+ * @brief      Offload an address learned by the bridge to the switch
+ *
+ * Generic implementation of the bridge_fdb_update() Ethernet API for the
+ * slave ports, using the static MAC address table entries from
+ * CONFIG_DSA_BRIDGE_FDB_FIRST_ENTRY. The table is not VLAN aware, so
+ * only the addresses learned from untagged frames are offloaded.
+ *
+ * @param      dev   Slave port device
+ * @param[in]  mac   MAC address
+ * @param[in]  vlan  VLAN the address was learned in
+ * @param[in]  add   true to program the address, false to remove it
+ *
+ * @return     0 if successful, negative if error
+ */
+int dsa_bridge_fdb_update(const struct device *dev, const uint8_t *mac,
+			  uint16_t vlan, bool add);
+
 /**
  * @brief Structure to provide mac address for each LAN interface
  */
@@ -452,6 +452,24 @@ struct ethernet_api {
 
 	/** Send a network packet */
 	int (*send)(const struct device *dev, struct net_pkt *pkt);
+
+#if defined(CONFIG_NET_ETHERNET_BRIDGE_FDB_OFFLOAD)
+	/** Optional. The bridge calls this function when it learned that
+	 * a MAC address is reachable through this interface (add is true),
+	 * or when it forgot it (add is false). Switch drivers can then
+	 * forward the frames sent to it in hardware.
+	 */
+	int (*bridge_fdb_update)(const struct device *dev, const uint8_t *mac,
+				 uint16_t vlan, bool add);
+#endif
+
+#if defined(CONFIG_NET_TX_BATCH)
+	/** Start the transmission of the packets queued without starting
+	 * it, as they were flagged with net_pkt_tx_more(). Optional, the
+	 * packets are not flagged if the driver does not provide it.
+	 */
+	void (*tx_flush)(const struct device *dev);
+#endif
 };
 
 /* Make sure that the network interface API is properly setup inside
@@ -28,12 +28,37 @@ extern "C" {
  * @{
  */
 
+/**
+ * @brief Entry of the forwarding database of a bridge.
+ *
+ * It tells which bridged interface a MAC address was last seen on.
+ */
+struct eth_bridge_fdb_entry {
+	/** Interface the address was learned on, NULL if the entry is free */
+	struct net_if *iface;
+
+	/** Uptime (in ms) the address was last seen at */
+	uint32_t last_seen;
+
+	/** VLAN the address was learned in, 0 if untagged */
+	uint16_t vlan;
+
+	/** Learned MAC address */
+	uint8_t addr[6];
+
+	/** The entry was programmed into the hardware of the interface */
+	bool offloaded;
+};
+
 /** @cond INTERNAL_HIDDEN */
 
 struct eth_bridge {
 	struct k_mutex lock;
 	sys_slist_t interfaces;
 	sys_slist_t listeners;
+#if defined(CONFIG_NET_ETHERNET_BRIDGE)
+	struct eth_bridge_fdb_entry fdb[CONFIG_NET_ETHERNET_BRIDGE_FDB_SIZE];
+#endif
 };
 
 #define ETH_BRIDGE_INITIALIZER(obj) \
@@ -58,6 +83,9 @@ struct eth_bridge_iface_context {
 	sys_snode_t node;
 	struct eth_bridge *instance;
 	bool allow_tx;
+#if defined(CONFIG_NET_ETHERNET_BRIDGE_VLAN_FILTERING)
+	uint16_t vlans[CONFIG_NET_ETHERNET_BRIDGE_VLAN_COUNT];
+#endif
 };
 
 struct eth_bridge_listener {
@@ -113,6 +141,67 @@ int eth_bridge_iface_remove(struct eth_bridge *br, struct net_if *iface);
  */
 int eth_bridge_iface_allow_tx(struct net_if *iface, bool allow);
 
+/**
+ * @brief Allow a VLAN on a bridged interface
+ *
+ * As long as no VLAN is allowed on an interface, frames of all the VLANs
+ * are received from it and transmitted through it. Once VLANs are allowed,
+ * tagged frames of the other VLANs are dropped when received from it and
+ * not transmitted through it. Untagged frames are never filtered.
+ *
+ * Requires CONFIG_NET_ETHERNET_BRIDGE_VLAN_FILTERING.
+ *
+ * @param iface Bridged interface to configure
+ * @param vlan VLAN identifier, from 1 to 4094
+ *
+ * @return 0 if OK, negative error code otherwise.
+ */
+int eth_bridge_iface_vlan_add(struct net_if *iface, uint16_t vlan);
+
+/**
+ * @brief Stop allowing a VLAN on a bridged interface
+ *
+ * @param iface Bridged interface to configure
+ * @param vlan VLAN identifier previously given to eth_bridge_iface_vlan_add()
+ *
+ * @return 0 if OK, negative error code otherwise.
+ */
+int eth_bridge_iface_vlan_remove(struct net_if *iface, uint16_t vlan);
+
+/**
+ * @typedef eth_bridge_fdb_cb_t
+ * @brief Callback used while iterating over the forwarding database
+ *
+ * @param br Pointer to bridge instance
+ * @param entry Forwarding database entry
+ * @param user_data User supplied data
+ */
+typedef void (*eth_bridge_fdb_cb_t)(struct eth_bridge *br,
+				    const struct eth_bridge_fdb_entry *entry,
+				    void *user_data);
+
+/**
+ * @brief Go through the MAC addresses learned by a bridge
+ *
+ * Unicast frames sent to a learned address are only transmitted through
+ * the interface it was learned on. The other frames are flooded to all
+ * the bridged interfaces. Addresses not seen for
+ * CONFIG_NET_ETHERNET_BRIDGE_FDB_AGING_TIME seconds are forgotten.
+ *
+ * @param br A pointer to an initialized bridge object
+ * @param cb Callback to call for each learned address
+ * @param user_data User supplied data
+ */
+void eth_bridge_fdb_foreach(struct eth_bridge *br, eth_bridge_fdb_cb_t cb,
+			    void *user_data);
+
+/**
+ * @brief Forget all the MAC addresses learned by a bridge
+ *
+ * @param br A pointer to an initialized bridge object
+ */
+void eth_bridge_fdb_flush(struct eth_bridge *br);
+
 /**
  * @brief Add (register) a listener to the bridge
  *
@@ -0,0 +1,264 @@
+/** @file
+ * @brief HTTP server API
+ *
+ * An API for applications to serve HTTP/1.1 requests
+ */
+
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_HTTP_SERVER_H_
+#define ZEPHYR_INCLUDE_NET_HTTP_SERVER_H_
+
+/**
+ * @brief HTTP server API
+ * @defgroup http_server HTTP server API
+ * @ingroup networking
+ * @{
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/http_parser.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct http_server;
+struct http_server_conn;
+
+/**
+ * HTTP request given to a resource handler.
+ */
+struct http_server_req {
+	/** The HTTP method: GET, HEAD, POST, ... */
+	enum http_method method;
+
+	/** NUL terminated URL of the request, for example: /index.html */
+	const char *url;
+
+	/** Request body, NULL if there is none */
+	const uint8_t *body;
+
+	/** Length of the request body */
+	size_t body_len;
+};
+
+/**
+ * @typedef http_server_handler_t
+ * @brief Callback handling the requests of a resource.
+ *
+ * The handler has to send exactly one response with the
+ * http_server_send_*() functions before returning. It runs in the
+ * thread calling http_server_run().
+ *
+ * @param conn Connection the request was received on
+ * @param req HTTP request information
+ * @param user_data User data of the resource
+ *
+ * @return 0 if ok, <0 if the connection should be closed.
+ */
+typedef int (*http_server_handler_t)(struct http_server_conn *conn,
+				     const struct http_server_req *req,
+				     void *user_data);
+
+/**
+ * Resource served by the HTTP server.
+ */
+struct http_server_resource {
+	/** Path of the resource. If it ends with a '/', it matches all the
+	 * URLs starting with it.
+	 */
+	const char *path;
+
+	/** Handler of the requests, NULL to serve files from fs_root */
+	http_server_handler_t handler;
+
+	/** Directory the files are served from, the part of the URL after
+	 * the path being the file name. Only used if handler is NULL and
+	 * CONFIG_HTTP_SERVER_FS is enabled.
+	 */
+	const char *fs_root;
+
+	/** User data given to the handler */
+	void *user_data;
+};
+
+/** HTTP server connection internal data that the application should not
+ * touch
+ */
+struct http_server_conn {
+	/** Server the connection belongs to */
+	struct http_server *server;
+
+	/** HTTP parser context */
+	struct http_parser parser;
+
+	/** Time of the last activity, to close idle connections */
+	int64_t last_activity;
+
+	/** Connection socket, -1 if the connection is not used */
+	int sock;
+
+	/** URL of the request being received */
+	char url[CONFIG_HTTP_SERVER_URL_MAX_LEN + 1];
+
+	/** Length of the URL */
+	size_t url_len;
+
+	/** Body of the request being received */
+	uint8_t body[CONFIG_HTTP_SERVER_BODY_MAX_LEN];
+
+	/** Length of the body */
+	size_t body_len;
+
+	/** Request exceeding the buffers, answered with an error */
+	uint8_t overflow : 1;
+
+	/** Response currently sent with chunked transfer encoding */
+	uint8_t chunked : 1;
+
+	/** Response already sent for the current request */
+	uint8_t responded : 1;
+
+	/** Only headers are sent in the response, to a HEAD request */
+	uint8_t head : 1;
+
+	/** Keep the connection open after the response */
+	uint8_t keep_alive : 1;
+};
+
+/**
+ * HTTP server. This contains all the data the server needs, the
+ * application only provides the resources to http_server_init().
+ */
+struct http_server {
+	/** Resources served */
+	const struct http_server_resource *resources;
+
+	/** Number of resources */
+	size_t resource_count;
+
+	/** Listening socket */
+	int sock;
+
+	/** Set when http_server_stop() was called */
+	atomic_t stop;
+
+	/** Fixed pool of connections */
+	struct http_server_conn conns[CONFIG_HTTP_SERVER_MAX_CONNECTIONS];
+
+	/** Buffer received data is parsed from */
+	uint8_t recv_buf[CONFIG_HTTP_SERVER_BUF_SIZE];
+
+	/** Buffer responses are built in */
+	uint8_t send_buf[CONFIG_HTTP_SERVER_BUF_SIZE];
+};
+
+/**
+ * @brief Initialize a HTTP server, creating its listening socket.
+ *
+ * @param server HTTP server to initialize
+ * @param addr Address to listen on
+ * @param addrlen Length of the address
+ * @param resources Resources to serve, the first matching one is used
+ * @param resource_count Number of resources
+ *
+ * @return 0 if ok, <0 if error.
+ */
+int http_server_init(struct http_server *server, const struct sockaddr *addr,
+		     socklen_t addrlen,
+		     const struct http_server_resource *resources,
+		     size_t resource_count);
+
+/**
+ * @brief Serve the requests, until http_server_stop() is called.
+ *
+ * Requests are handled one at a time, in the order they are received on
+ * each connection, so pipelined requests get their responses in order.
+ * Connections stay open as long as the clients allow it, and are closed
+ * after CONFIG_HTTP_SERVER_IDLE_TIMEOUT ms without a request.
+ *
+ * @param server HTTP server
+ *
+ * @return 0 once stopped, <0 if error.
+ */
+int http_server_run(struct http_server *server);
+
+/**
+ * @brief Stop a HTTP server, from another thread.
+ *
+ * http_server_run() returns within CONFIG_HTTP_SERVER_POLL_PERIOD ms,
+ * after closing all the connections and the listening socket.
+ *
+ * @param server HTTP server
+ */
+void http_server_stop(struct http_server *server);
+
+/**
+ * @brief Send a response with its whole body.
+ *
+ * @param conn Connection the request was received on
+ * @param status HTTP status code, for example 200
+ * @param content_type Value of the Content-Type header, may be NULL
+ * @param body Body of the response, may be NULL if body_len is 0
+ * @param body_len Length of the body
+ *
+ * @return 0 if ok, <0 if error.
+ */
+int http_server_send_response(struct http_server_conn *conn, uint16_t status,
+			      const char *content_type, const void *body,
+			      size_t body_len);
+
+/**
+ * @brief Start a response which body is sent in chunks.
+ *
+ * The chunks are then sent with http_server_send_chunk(), the last call
+ * having a zero length.
+ *
+ * @param conn Connection the request was received on
+ * @param status HTTP status code, for example 200
+ * @param content_type Value of the Content-Type header, may be NULL
+ *
+ * @return 0 if ok, <0 if error.
+ */
+int http_server_send_chunked(struct http_server_conn *conn, uint16_t status,
+			     const char *content_type);
+
+/**
+ * @brief Send a chunk of a response started with http_server_send_chunked().
+ *
+ * @param conn Connection the request was received on
+ * @param data Data of the chunk
+ * @param len Length of the data, 0 to end the response
+ *
+ * @return 0 if ok, <0 if error.
+ */
+int http_server_send_chunk(struct http_server_conn *conn, const void *data,
+			   size_t len);
+
+/**
+ * @brief Send a file as the response, streaming it from the file system.
+ *
+ * The Content-Type is guessed from the extension of the file name.
+ *
+ * @param conn Connection the request was received on
+ * @param path Path of the file
+ *
+ * @return 0 if ok, -ENOENT if the file does not exist, <0 if error.
+ */
+int http_server_send_file(struct http_server_conn *conn, const char *path);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_NET_HTTP_SERVER_H_ */
@@ -77,6 +77,10 @@ struct ieee802154_context {
 #endif
 #ifdef CONFIG_NET_L2_IEEE802154_SECURITY
 	struct ieee802154_security_ctx sec_ctx;
+#endif
+#ifdef CONFIG_NET_L2_IEEE802154_TX_PIPELINE
+	struct k_sem tx_done;
+	atomic_t tx_status;
 #endif
 	int16_t tx_power;
 	uint8_t sequence;
@@ -328,6 +328,15 @@ struct ieee802154_radio_api {
 	int (*tx)(const struct device *dev, enum ieee802154_tx_mode mode,
 		  struct net_pkt *pkt, struct net_buf *frag);
 
+	/** Queue a packet fragment for transmission, without waiting for
+	 *  it to be sent. Optional, used with CONFIG_NET_L2_IEEE802154_TX_PIPELINE
+	 *  for radios doing CSMA-CA and ACK handling in hardware. The radio
+	 *  owns the fragment buffer if 0 is returned, and then reports the
+	 *  result of the transmission with ieee802154_tx_done().
+	 */
+	int (*tx_queue)(const struct device *dev, enum ieee802154_tx_mode mode,
+			struct net_pkt *pkt, struct net_buf *frag);
+
 	/** Start the device */
 	int (*start)(const struct device *dev);
 
@@ -397,6 +406,21 @@ static inline bool ieee802154_is_ar_flag_set(struct net_buf *frag)
 extern enum net_verdict ieee802154_radio_handle_ack(struct net_if *iface,
 						    struct net_pkt *pkt);
 
+/**
+ * @brief Radio driver function reporting the end of a queued transmission
+ *
+ * @details To be called by the hw drivers implementing the tx_queue() API,
+ *          once for each fragment it accepted, in the order they were
+ *          queued. The fragment buffer is released by this function.
+ *
+ * @param iface A valid pointer on the network interface the frame was sent on
+ * @param frag The fragment given to tx_queue()
+ * @param status 0 if the frame was sent (and acknowledged if requested),
+ *        negative value otherwise, as returned by the tx() API
+ */
+extern void ieee802154_tx_done(struct net_if *iface, struct net_buf *frag,
+			       int status);
+
 /**
  * @brief Initialize L2 stack for a given interface
  *
@@ -462,6 +462,11 @@ struct mqtt_internal {
 
 	/** Internal. Remaining payload length to read. */
 	uint32_t remaining_payload;
+
+	/** Internal. QoS 1 and QoS 2 PUBLISH messages not acknowledged yet,
+	 *  counted if CONFIG_MQTT_MAX_INFLIGHT is not 0.
+	 */
+	uint16_t inflight;
 };
 
 /**
@@ -597,10 +602,32 @@ int mqtt_connect(struct mqtt_client *client);
  *                  Shall not be NULL.
  *
  * @return 0 or a negative error code (errno.h) indicating reason of failure.
+ *         -EAGAIN if @kconfig{CONFIG_MQTT_MAX_INFLIGHT} QoS 1 and QoS 2
+ *         messages are already waiting for their acknowledgment.
  */
 int mqtt_publish(struct mqtt_client *client,
 		 const struct mqtt_publish_param *param);
 
+/**
+ * @brief API to publish several messages with a single transport write.
+ *
+ * The messages are encoded one after the other in the transmit buffer,
+ * while their payloads are referenced in place, and written at once. More
+ * writes are done only if the transmit buffer, or the batch size given by
+ * @kconfig{CONFIG_MQTT_PUBLISH_BATCH_MAX}, cannot hold all the messages.
+ *
+ * @param[in] client Client instance for which the procedure is requested.
+ *                   Shall not be NULL.
+ * @param[in] params Parameters of the publish messages. Shall not be NULL.
+ * @param[in] count Number of messages.
+ *
+ * @return Number of messages published, which is less than @p count if
+ *         the in-flight window is full, or a negative error code (errno.h)
+ *         indicating reason of failure if none was published.
+ */
+int mqtt_publish_batch(struct mqtt_client *client,
+		       const struct mqtt_publish_param *params, size_t count);
+
 /**
  * @brief API used by client to send acknowledgment on receiving QoS1 publish
  *        message. Should be called on reception of @ref MQTT_EVT_PUBLISH with
@@ -274,6 +274,11 @@ __net_socket struct net_context {
 		struct k_fifo accept_q;
 	};
 
+#if defined(CONFIG_NET_CONTEXT_RCVBUF)
+	/** Bytes of the datagrams waiting in recv_q */
+	atomic_t recv_q_len;
+#endif
+
 	struct {
 		/** Condition variable used when receiving data */
 		struct k_condvar recv;
@@ -292,6 +297,22 @@ __net_socket struct net_context {
 	int can_filter_id;
 #endif /* CONFIG_NET_SOCKETS_CAN */
 
+#if defined(CONFIG_NET_CONTEXT_PATH_CACHE)
+	/** Path last resolved to the remote of a connected UDP context */
+	struct {
+		/** Destination the path leads to */
+		struct in6_addr dst;
+		/** Source address selected */
+		struct in6_addr src;
+		/** Network interface the packets leave from */
+		struct net_if *iface;
+		/** Next hop neighbor */
+		struct net_nbr *nbr;
+		/** Generation of the IPv6 paths the path is valid for */
+		atomic_val_t gen;
+	} path_cache;
+#endif /* CONFIG_NET_CONTEXT_PATH_CACHE */
+
 	/** Option values */
 	struct {
 #if defined(CONFIG_NET_CONTEXT_PRIORITY)
@@ -996,6 +1017,38 @@ int net_context_sendmsg(struct net_context *context,
 			k_timeout_t timeout,
 			void *user_data);
 
+/**
+ * @brief Send network buffers to a TCP peer without copying them.
+ *
+ * @details The ownership of @a buf, and of the buffers chained to it, is
+ * handed over to the TCP stack, which keeps them to send and resend the
+ * data until the peer acknowledges it. The data must not be modified in
+ * the meantime. Take an extra reference with net_buf_ref() beforehand to
+ * use the buffers again afterwards. When the data can be shared, as with
+ * variable size buffer pools, it is not copied into the sent segments
+ * either.
+ *
+ * The callback is called once all the data is acknowledged, with its
+ * length as status, or with a negative status if the connection is closed
+ * before. It is called from the TCP or RX thread, with the connection
+ * locked, and must not block.
+ *
+ * Requires @kconfig{CONFIG_NET_TCP_SEND_ZC}.
+ *
+ * @param context The network context to use, connected with TCP.
+ * @param buf The buffer chain holding the data.
+ * @param cb Caller-supplied callback function.
+ * @param user_data Caller-supplied user data.
+ *
+ * @return 0 if the data was queued, a negative errno otherwise. The
+ *         caller still owns @a buf when -EAGAIN, the send window is full,
+ *         or -ENOBUFS is returned.
+ */
+int net_context_send_buf(struct net_context *context,
+			 struct net_buf *buf,
+			 net_context_send_cb_t cb,
+			 void *user_data);
+
 /**
  * @brief Receive network data from a peer specified by context.
  *
@@ -117,6 +117,87 @@ enum net_verdict {
  */
 int net_recv_data(struct net_if *iface, struct net_pkt *pkt);
 
+/**
+ * @brief Called by network device driver when a batch of network packets
+ * has been received. The packets are queued for processing with a single
+ * wake up per traffic class, instead of one per packet.
+ *
+ * @param iface Network interface where the packets were received.
+ * @param list List of network packets, linked through their fifo field.
+ *        The list is empty upon return, the stack owning the packets, unless
+ *        an error is returned.
+ *
+ * @return Number of packets passed to the stack if ok, <0 if error.
+ */
+int net_recv_data_list(struct net_if *iface, sys_slist_t *list);
+
+struct net_rx_poll;
+
+/**
+ * @typedef net_rx_poll_cb_t
+ * @brief Driver callback receiving packets in polling mode.
+ *
+ * @details The callback passes up to @p budget received packets to
+ * net_rx_poll_recv(). If it receives less than @p budget packets, the
+ * driver is done and re-enables its RX interrupt before returning.
+ * Otherwise it gets called again.
+ *
+ * @param poll RX poll context.
+ * @param budget Maximum number of packets to receive.
+ *
+ * @return Number of packets received.
+ */
+typedef int (*net_rx_poll_cb_t)(struct net_rx_poll *poll, int budget);
+
+/**
+ * @brief RX poll context of a network device driver.
+ */
+struct net_rx_poll {
+	/** @cond INTERNAL_HIDDEN */
+	struct k_work work;
+	struct net_if *iface;
+	net_rx_poll_cb_t cb;
+	sys_slist_t pkts;
+	/** @endcond */
+};
+
+/**
+ * @brief Initialize an RX poll context.
+ *
+ * @param poll RX poll context.
+ * @param iface Network interface the packets are received on.
+ * @param cb Driver callback receiving packets.
+ */
+void net_rx_poll_init(struct net_rx_poll *poll, struct net_if *iface,
+		      net_rx_poll_cb_t cb);
+
+/**
+ * @brief Schedule polling for received packets.
+ *
+ * @details Typically called from the RX interrupt handler, once the RX
+ * interrupt is masked. The driver callback then runs from the RX poll work
+ * queue, until it receives less packets than its budget of
+ * @kconfig{CONFIG_NET_RX_POLL_BUDGET}.
+ *
+ * @param poll RX poll context.
+ */
+void net_rx_poll_schedule(struct net_rx_poll *poll);
+
+/**
+ * @brief Pass a packet received in polling mode to the stack.
+ *
+ * @details Only to be called from the driver callback. The packets are
+ * handed to the stack with net_recv_data_list() when the callback returns.
+ *
+ * @param poll RX poll context.
+ * @param pkt Network packet.
+ */
+static inline void net_rx_poll_recv(struct net_rx_poll *poll,
+				    struct net_pkt *pkt)
+{
+	sys_slist_append(&poll->pkts, (sys_snode_t *)pkt);
+}
+
 /**
  * @brief Send data to network.
  *
@@ -97,7 +97,18 @@ struct net_if_mcast_addr {
 	/** Did we join to this group */
 	uint8_t is_joined : 1;
 
-	uint8_t _unused : 6;
+	/** Are the sources the only ones received from, or the ones not */
+	uint8_t is_include : 1;
+
+	uint8_t _unused : 5;
+
+#if defined(CONFIG_NET_IF_MCAST_SOURCE_FILTER)
+	/** Number of sources in the filter */
+	uint8_t num_sources;
+
+	/** Sources included or excluded, depending on is_include */
+	struct net_addr sources[CONFIG_NET_IF_MCAST_SOURCE_COUNT];
+#endif
 };
 
 /**
@@ -1150,6 +1161,64 @@ void net_if_mcast_mon_register(struct net_if_mcast_monitor *mon,
  */
 void net_if_mcast_mon_unregister(struct net_if_mcast_monitor *mon);
 
+/**
+ * @brief Set the source filter of a multicast group.
+ *
+ * An empty EXCLUDE filter, the default, receives the group from any
+ * source. The filter is reset when the group is removed.
+ *
+ * @param addr Multicast group
+ * @param include True to receive the group only from the sources, false
+ * to receive it from all but the sources.
+ * @param sources Source addresses, of the family of the group
+ * @param count Number of sources
+ *
+ * @return 0 if ok, -EINVAL if a source is not of the family of the group,
+ * -ENOMEM if there are too many sources, -ENOTSUP if source filtering is
+ * not enabled.
+ */
+#if defined(CONFIG_NET_IF_MCAST_SOURCE_FILTER)
+int net_if_mcast_set_sources(struct net_if_mcast_addr *addr, bool include,
+			     const struct net_addr *sources, size_t count);
+#else
+static inline int net_if_mcast_set_sources(struct net_if_mcast_addr *addr,
+					   bool include,
+					   const struct net_addr *sources,
+					   size_t count)
+{
+	ARG_UNUSED(addr);
+	ARG_UNUSED(include);
+	ARG_UNUSED(sources);
+	ARG_UNUSED(count);
+
+	return -ENOTSUP;
+}
+#endif
+
+/**
+ * @brief Check if a multicast group is received from a given source.
+ *
+ * @param addr Multicast group
+ * @param src Source address, a struct in_addr or a struct in6_addr
+ * depending on the family of the group
+ *
+ * @return True if packets from the source are to be received.
+ */
+#if defined(CONFIG_NET_IF_MCAST_SOURCE_FILTER)
+bool net_if_mcast_source_is_allowed(const struct net_if_mcast_addr *addr,
+				    const void *src);
+#else
+static inline bool net_if_mcast_source_is_allowed(
+					const struct net_if_mcast_addr *addr,
+					const void *src)
+{
+	ARG_UNUSED(addr);
+	ARG_UNUSED(src);
+
+	return true;
+}
+#endif
+
 /**
  * @brief Call registered multicast monitors
  *
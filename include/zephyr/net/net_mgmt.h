@@ -142,9 +142,10 @@ struct net_mgmt_event_callback {
 #endif
 
 	/** A mask of network events on which the above handler should be
-	 * called in case those events come. Such mask can be modified
-	 * whenever necessary by the owner, and thus will affect the handler
-	 * being called or not.
+	 * called in case those events come. The command part of such mask
+	 * can be modified whenever necessary by the owner, and thus will
+	 * affect the handler being called or not. The layer and layer code
+	 * must not be changed while the callback is added.
 	 */
 	union {
 		/** A mask of network events on which the above handler should
@@ -195,6 +196,24 @@ void net_mgmt_add_event_callback(struct net_mgmt_event_callback *cb);
 #define net_mgmt_add_event_callback(...)
 #endif
 
+/**
+ * @brief Add a user callback called directly by the code raising the events
+ *
+ * The handler is called from the context of the code raising the event,
+ * before the event is queued for the other callbacks, so it is notified
+ * without delay and whatever the load of the event queue. It must not
+ * block: the code raising the event may be holding locks of the network
+ * stack. The callbacks are serialized, and the info of the event is only
+ * valid while the handler runs.
+ *
+ * @param cb A valid pointer on user's callback to add.
+ */
+#ifdef CONFIG_NET_MGMT_EVENT_DIRECT
+void net_mgmt_add_event_callback_direct(struct net_mgmt_event_callback *cb);
+#else
+#define net_mgmt_add_event_callback_direct(...)
+#endif
+
 /**
  * @brief Delete a user callback
  * @param cb A valid pointer on user's callback to delete.
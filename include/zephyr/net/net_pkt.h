@@ -196,6 +196,13 @@ struct net_pkt {
 	uint8_t l2_processed : 1; /* Set to 1 if this packet has already been
 				   * processed by the L2
 				   */
+	uint8_t ip_reassembled : 1; /* Set to 1 if this packet was rebuilt
+				     * from IP fragments
+				     */
+	uint8_t tx_more : 1; /* Set to 1 if more packets to the same
+			      * interface are sent right after this one.
+			      * Used only if defined(CONFIG_NET_TX_BATCH)
+			      */
 
 #if defined(CONFIG_NET_IP)
 	union {
@@ -234,6 +241,13 @@ struct net_pkt {
 	uint16_t vlan_tci;
 #endif /* CONFIG_NET_VLAN */
 
+#if defined(CONFIG_NET_RX_STEERING)
+	/* Hardware RX queue the packet was received from plus one, set by
+	 * drivers having several RX queues. 0 if not set.
+	 */
+	uint8_t rx_queue;
+#endif /* CONFIG_NET_RX_STEERING */
+
 #if defined(CONFIG_NET_IPV6)
 	/* Where is the start of the last header before payload data
 	 * in IPv6 packet. This is offset value from start of the IPv6
@@ -394,6 +408,44 @@ static inline void net_pkt_set_l2_processed(struct net_pkt *pkt,
 	pkt->l2_processed = is_l2_processed;
 }
 
+static inline bool net_pkt_is_ip_reassembled(struct net_pkt *pkt)
+{
+	return !!(pkt->ip_reassembled);
+}
+
+static inline void net_pkt_set_ip_reassembled(struct net_pkt *pkt,
+					      bool is_ip_reassembled)
+{
+	pkt->ip_reassembled = is_ip_reassembled;
+}
+
+/**
+ * @brief Check if more packets are sent right after this one
+ *
+ * A driver can then queue the packet without starting the transmission,
+ * which is started once a packet not flagged this way is sent, or when
+ * the tx_flush function of the driver is called.
+ *
+ * @param pkt Network packet
+ *
+ * @return True if more packets follow, false otherwise
+ */
+static inline bool net_pkt_tx_more(struct net_pkt *pkt)
+{
+#if defined(CONFIG_NET_TX_BATCH)
+	return !!(pkt->tx_more);
+#else
+	ARG_UNUSED(pkt);
+
+	return false;
+#endif
+}
+
+static inline void net_pkt_set_tx_more(struct net_pkt *pkt, bool tx_more)
+{
+	pkt->tx_more = tx_more;
+}
+
 static inline uint8_t net_pkt_ip_hdr_len(struct net_pkt *pkt)
 {
 #if defined(CONFIG_NET_IP)
@@ -848,6 +900,45 @@ static inline void net_pkt_set_vlan_tci(struct net_pkt *pkt, uint16_t tci)
 }
 #endif
 
+/**
+ * @brief Get the hardware RX queue a packet was received from
+ *
+ * @param pkt Network packet
+ *
+ * @return RX queue index, or -1 if the driver did not report it.
+ */
+static inline int net_pkt_rx_queue(struct net_pkt *pkt)
+{
+#if defined(CONFIG_NET_RX_STEERING)
+	return (int)pkt->rx_queue - 1;
+#else
+	ARG_UNUSED(pkt);
+
+	return -1;
+#endif
+}
+
+/**
+ * @brief Report the hardware RX queue a packet was received from
+ *
+ * Drivers having several RX queues, with the hardware already
+ * distributing flows among them, call this before handing the packet to
+ * net_recv_data(). Packets of a given hardware queue are then processed
+ * by the same RX thread, instead of being hashed in software.
+ *
+ * @param pkt Network packet
+ * @param queue RX queue index, lower than 255
+ */
+static inline void net_pkt_set_rx_queue(struct net_pkt *pkt, uint8_t queue)
+{
+#if defined(CONFIG_NET_RX_STEERING)
+	pkt->rx_queue = queue + 1U;
+#else
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(queue);
+#endif
+}
+
 #if defined(CONFIG_NET_PKT_TIMESTAMP)
 static inline struct net_ptp_time *net_pkt_timestamp(struct net_pkt *pkt)
 {
@@ -1972,6 +2063,24 @@ struct net_pkt *net_pkt_clone(struct net_pkt *pkt, k_timeout_t timeout);
  */
 struct net_pkt *net_pkt_rx_clone(struct net_pkt *pkt, k_timeout_t timeout);
 
+/**
+ * @brief Clone pkt to the RX packet pool, sharing the data of its buffer.
+ *
+ * @details Unlike net_pkt_shallow_clone(), the clone has its own buffer
+ *          fragments, which reference the data of the original ones, so
+ *          that the clone can be consumed without affecting the original
+ *          packet. This needs buffer pools whose data can be shared, i.e.
+ *          variable size data pools.
+ *
+ * @param pkt Original pkt to be cloned
+ * @param timeout Timeout to wait for free packet and fragments
+ *
+ * @return NULL if error or if the data cannot be shared, cloned packet
+ *         otherwise.
+ */
+struct net_pkt *net_pkt_rx_clone_shared(struct net_pkt *pkt,
+					k_timeout_t timeout);
+
 /**
  * @brief Clone pkt and increase the refcount of its buffer.
  *
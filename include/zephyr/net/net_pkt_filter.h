@@ -19,6 +19,7 @@
 #include <zephyr/sys/slist.h>
 #include <zephyr/net/net_core.h>
 #include <zephyr/net/ethernet.h>
+#include <zephyr/net/bpf.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -462,6 +463,100 @@ extern npf_test_fn_t npf_eth_type_unmatch;
 
 /** @} */
 
+/**
+ * @defgroup npf_bpf_cond BPF Filter Conditions
+ * @ingroup net_pkt_filter
+ * @{
+ */
+
+/**
+ * @brief Check that a classic BPF program is safe to run
+ *
+ * Only programs passing this check can be given to npf_bpf_run() and
+ * npf_bpf_run_buf(): all instructions must be known, jumps must be forward
+ * and within the program, scratch memory accesses within bounds and the
+ * last instruction must be a return.
+ *
+ * @param prog Program instructions
+ * @param len Number of instructions
+ * @retval 0 if the program is valid, -EINVAL otherwise
+ */
+int npf_bpf_check(const struct sock_filter *prog, uint16_t len);
+
+/**
+ * @brief Run a classic BPF program on a network packet
+ *
+ * Offset 0 is the start of the packet data, i.e. the link layer header
+ * for received packets. Loads out of the packet end the program with
+ * a return value of 0.
+ *
+ * @param prog Program instructions, checked by npf_bpf_check()
+ * @param pkt Network packet
+ * @return Value returned by the program, 0 meaning the packet is rejected
+ */
+uint32_t npf_bpf_run(const struct sock_filter *prog, struct net_pkt *pkt);
+
+/**
+ * @brief Run a classic BPF program on a flat buffer
+ *
+ * Meant to be used by drivers on the frames they receive, so that the
+ * unwanted ones can be dropped before a network packet is allocated.
+ *
+ * @param prog Program instructions, checked by npf_bpf_check()
+ * @param data Frame data
+ * @param len Length of the frame
+ * @return Value returned by the program, 0 meaning the frame is rejected
+ */
+uint32_t npf_bpf_run_buf(const struct sock_filter *prog, const uint8_t *data,
+			 size_t len);
+
+/** @cond INTERNAL_HIDDEN */
+
+struct npf_test_bpf {
+	struct npf_test test;
+	const struct sock_filter *prog;
+	uint16_t len;
+	bool checked;
+	bool valid;
+};
+
+extern npf_test_fn_t npf_bpf_match;
+extern npf_test_fn_t npf_bpf_unmatch;
+
+/** @endcond */
+
+/**
+ * @brief Statically define a "BPF program match" packet filter condition
+ *
+ * The condition is true when the program returns a non zero value.
+ * The program is checked the first time the condition is evaluated, an
+ * invalid program never matches.
+ *
+ * @param _name Name of the condition
+ * @param _prog Array of <tt>struct sock_filter</tt> instructions
+ */
+#define NPF_BPF_MATCH(_name, _prog) \
+	struct npf_test_bpf _name = { \
+		.prog = (_prog), \
+		.len = ARRAY_SIZE(_prog), \
+		.test.fn = npf_bpf_match, \
+	}
+
+/**
+ * @brief Statically define a "BPF program unmatch" packet filter condition
+ *
+ * @param _name Name of the condition
+ * @param _prog Array of <tt>struct sock_filter</tt> instructions
+ */
+#define NPF_BPF_UNMATCH(_name, _prog) \
+	struct npf_test_bpf _name = { \
+		.prog = (_prog), \
+		.len = ARRAY_SIZE(_prog), \
+		.test.fn = npf_bpf_unmatch, \
+	}
+
+/** @} */
+
 #ifdef __cplusplus
 }
 #endif
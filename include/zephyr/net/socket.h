@@ -157,10 +157,14 @@ struct zsock_pollfd {
 /** Socket option to control TLS session caching on a socket. Accepted values:
  *  - 0 - Disabled.
  *  - 1 - Enabled.
+ *  Client sessions are cached by peer hostname if TLS_HOSTNAME is set, by
+ *  peer address otherwise. Servers also issue session tickets if
+ *  CONFIG_MBEDTLS_SSL_TICKET_C is enabled.
  */
 #define TLS_SESSION_CACHE 12
 /** Write-only socket option to purge session cache immediately.
- *  This option accepts any value.
+ *  The keys protecting the session tickets issued by servers are
+ *  regenerated as well. This option accepts any value.
  */
 #define TLS_SESSION_CACHE_PURGE 13
 
@@ -437,6 +441,118 @@ static inline ssize_t zsock_recv(int sock, void *buf, size_t max_len,
 	return zsock_recvfrom(sock, buf, max_len, flags, NULL, NULL);
 }
 
+/**
+ * @brief Message vector entry of zsock_sendmmsg() and zsock_recvmmsg()
+ */
+struct zsock_mmsghdr {
+	/** Message */
+	struct msghdr msg_hdr;
+	/** Number of bytes sent or received */
+	unsigned int msg_len;
+};
+
+/**
+ * @brief Send multiple messages on a socket
+ *
+ * @details
+ * Like calling zsock_sendmsg() for each message of @p msgvec, the number of
+ * bytes sent being stored in its @a msg_len field, except that native
+ * sockets only lock their context once for the whole vector.
+ * This function is also exposed as ``sendmmsg()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ *
+ * @param sock Socket.
+ * @param msgvec Messages to send.
+ * @param vlen Number of messages in @p msgvec.
+ * @param flags Flags, as for zsock_sendmsg().
+ *
+ * @return Number of messages sent, which can be less than @p vlen, or -1
+ * with errno set if none could be sent.
+ */
+__syscall int zsock_sendmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
+/**
+ * @brief Receive multiple datagrams from a socket
+ *
+ * @details
+ * Receives up to @p vlen datagrams in one call, each one in the buffers of
+ * a message of @p msgvec, the number of bytes received being stored in its
+ * @a msg_len field, and the source address in @a msg_name if not NULL.
+ * ZSOCK_MSG_TRUNC is set in @a msg_flags if the datagram didn't fit.
+ * Only waits for the first datagram, according to the socket blocking mode
+ * and @p flags, the other ones being received if already available.
+ * Ancillary data is not supported. Only native datagram sockets are
+ * supported.
+ * This function is also exposed as ``recvmmsg()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ *
+ * @param sock Socket.
+ * @param msgvec Messages to receive datagrams into.
+ * @param vlen Number of messages in @p msgvec.
+ * @param flags Flags, as for zsock_recvfrom().
+ *
+ * @return Number of datagrams received, or -1 with errno set if none could
+ * be received.
+ */
+__syscall int zsock_recvmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
+struct net_buf;
+struct net_pkt;
+struct net_context;
+
+/**
+ * @brief Data lent by zsock_recv_zc()
+ *
+ * The data starts at @a offset in @a buf and extends to the end of the
+ * fragment chain.
+ */
+struct zsock_zc_buf {
+	/** Fragment holding the first byte of data */
+	struct net_buf *buf;
+	/** Offset of the first byte of data in @a buf */
+	size_t offset;
+	/** Number of bytes of data */
+	size_t len;
+
+	/** @cond INTERNAL_HIDDEN */
+	struct net_pkt *pkt;
+	struct net_context *ctx;
+	/** @endcond */
+};
+
+/**
+ * @brief Receive data without copying it
+ *
+ * @details
+ * Like zsock_recv(), but instead of copying the data of the next received
+ * packet to a user buffer, lends the network buffers holding it to the
+ * caller, which parses the data in place and gives the buffers back with
+ * zsock_recv_zc_release(). For stream sockets, all the data of the next
+ * received segment is lent, the receive window being updated when released.
+ * For datagram sockets, a whole datagram is lent.
+ *
+ * Only supported on native sockets, not as a system call: the buffers are
+ * kernel memory. Requires @kconfig{CONFIG_NET_SOCKETS_RECV_ZC}.
+ *
+ * @param sock Socket.
+ * @param zc Filled with the lent data upon success.
+ * @param flags ZSOCK_MSG_DONTWAIT, other flags are not supported.
+ *
+ * @return Number of bytes of data lent, 0 on end of stream (nothing is
+ * lent then), -1 on error with errno set.
+ */
+ssize_t zsock_recv_zc(int sock, struct zsock_zc_buf *zc, int flags);
+
+/**
+ * @brief Give the buffers lent by zsock_recv_zc() back
+ *
+ * @param sock Socket the data was received on.
+ * @param zc Lent data.
+ */
+void zsock_recv_zc_release(int sock, struct zsock_zc_buf *zc);
+
 /**
  * @brief Control blocking/non-blocking mode of a socket
  *
@@ -684,6 +800,7 @@ int zsock_getnameinfo(const struct sockaddr *addr, socklen_t addrlen,
 #if defined(CONFIG_NET_SOCKETS_POSIX_NAMES)
 
 #define pollfd zsock_pollfd
+#define mmsghdr zsock_mmsghdr
 
 /** POSIX wrapper for @ref zsock_socket */
 static inline int socket(int family, int type, int proto)
@@ -778,6 +895,20 @@ static inline ssize_t sendmsg(int sock, const struct msghdr *message,
 	return zsock_sendmsg(sock, message, flags);
 }
 
+/** POSIX wrapper for @ref zsock_sendmmsg */
+static inline int sendmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			   unsigned int vlen, int flags)
+{
+	return zsock_sendmmsg(sock, msgvec, vlen, flags);
+}
+
+/** POSIX wrapper for @ref zsock_recvmmsg */
+static inline int recvmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			   unsigned int vlen, int flags)
+{
+	return zsock_recvmmsg(sock, msgvec, vlen, flags);
+}
+
 /** POSIX wrapper for @ref zsock_recvfrom */
 static inline ssize_t recvfrom(int sock, void *buf, size_t max_len, int flags,
 			       struct sockaddr *src_addr, socklen_t *addrlen)
@@ -966,6 +1097,13 @@ struct ifreq {
 /** sockopt: Bind a socket to an interface */
 #define SO_BINDTODEVICE	25
 
+/** sockopt: Attach a classic BPF program filtering received packets
+ *  (struct sock_fprog, packet sockets only)
+ */
+#define SO_ATTACH_FILTER 26
+/** sockopt: Detach the filter program of the socket */
+#define SO_DETACH_FILTER 27
+
 /** sockopt: Socket accepts incoming connections (ignored, for compatibility) */
 #define SO_ACCEPTCONN 30
 
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_SOCKET_RTIO_H_
+#define ZEPHYR_INCLUDE_NET_SOCKET_RTIO_H_
+
+/**
+ * @brief RTIO interface to sockets
+ * @defgroup bsd_sockets_rtio RTIO interface to sockets
+ * @ingroup bsd_sockets
+ * @{
+ */
+
+#include <zephyr/sys/slist.h>
+#include <zephyr/rtio/rtio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief RTIO IO device of a socket.
+ *
+ * RTIO_OP_RX submissions receive data from the socket into the buffer of
+ * the submission, RTIO_OP_TX ones send the buffer. The result of the
+ * completion is the number of bytes received or sent, or a negative errno
+ * value. Operations that would block are waited for by a single thread
+ * shared by all the sockets, so that the submitting thread never blocks.
+ *
+ * The socket has to be connected, or bound for datagram sockets. One
+ * operation is done at a time on a given IO device, a submission made
+ * while another one is pending fails with -EWOULDBLOCK.
+ */
+struct zsock_rtio_iodev {
+	/** RTIO IO device, has to be the first member */
+	struct rtio_iodev iodev;
+
+	/** Socket the operations are done on */
+	int sock;
+
+	/** @cond INTERNAL_HIDDEN */
+	sys_snode_t node;
+	const struct rtio_sqe *sqe;
+	struct rtio *r;
+	/** @endcond */
+};
+
+/**
+ * @brief Initialize the RTIO IO device of a socket.
+ *
+ * @param iodev IO device to initialize
+ * @param sock Socket the operations are done on
+ *
+ * @return 0 if ok, <0 if the thread waiting for the operations could not
+ * be started.
+ */
+int zsock_rtio_iodev_init(struct zsock_rtio_iodev *iodev, int sock);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_NET_SOCKET_RTIO_H_ */
@@ -36,6 +36,7 @@ enum net_request_wifi_cmd {
 	NET_REQUEST_WIFI_CMD_AP_ENABLE,
 	NET_REQUEST_WIFI_CMD_AP_DISABLE,
 	NET_REQUEST_WIFI_CMD_IFACE_STATUS,
+	NET_REQUEST_WIFI_CMD_SCAN_RESULTS,
 };
 
 #define NET_REQUEST_WIFI_SCAN					\
@@ -68,6 +69,11 @@ NET_MGMT_DEFINE_REQUEST_HANDLER(NET_REQUEST_WIFI_AP_DISABLE);
 
 NET_MGMT_DEFINE_REQUEST_HANDLER(NET_REQUEST_WIFI_IFACE_STATUS);
 
+#define NET_REQUEST_WIFI_SCAN_RESULTS				\
+	(_NET_WIFI_BASE | NET_REQUEST_WIFI_CMD_SCAN_RESULTS)
+
+NET_MGMT_DEFINE_REQUEST_HANDLER(NET_REQUEST_WIFI_SCAN_RESULTS);
+
 enum net_event_wifi_cmd {
 	NET_EVENT_WIFI_CMD_SCAN_RESULT = 1,
 	NET_EVENT_WIFI_CMD_SCAN_DONE,
@@ -109,6 +115,16 @@ struct wifi_scan_result {
 	uint8_t mac_length;
 };
 
+/* Results of the last scan, read at once with NET_REQUEST_WIFI_SCAN_RESULTS
+ * once NET_EVENT_WIFI_SCAN_DONE is received. Each BSS is reported once, and
+ * only the CONFIG_NET_L2_WIFI_MGMT_SCAN_RESULTS_MAX strongest ones are kept.
+ */
+struct wifi_scan_results {
+	struct wifi_scan_result *results; /* Filled by the request */
+	size_t max; /* Number of entries of results */
+	size_t count; /* Set to the number of entries filled */
+};
+
 struct wifi_connect_req_params {
 	const uint8_t *ssid;
 	uint8_t ssid_length; /* Max 32 */
@@ -124,6 +140,7 @@ struct wifi_connect_req_params {
 	enum wifi_security_type security;
 	enum wifi_mfp_options mfp;
 	int timeout; /* SYS_FOREVER_MS for no timeout */
+	const uint8_t *bssid; /* WIFI_MAC_ADDR_LEN bytes, NULL for any */
 };
 
 struct wifi_status {
@@ -9,6 +9,7 @@
 
 #include <zephyr/device.h>
 #include <zephyr/kernel.h>
+#include <zephyr/pm/policy.h>
 #include <zephyr/sys/atomic.h>
 
 #ifdef __cplusplus
@@ -117,6 +118,33 @@ typedef int (*pm_device_action_cb_t)(const struct device *dev,
 typedef bool (*pm_device_action_failed_cb_t)(const struct device *dev,
 					 int err);
 
+struct pm_device_runtime_cb;
+
+/**
+ * @brief Device runtime PM completion handler
+ *
+ * @param dev Device the operation was requested on.
+ * @param cb Callback the operation was requested with.
+ * @param result 0 on success, negative errno otherwise.
+ */
+typedef void (*pm_device_runtime_cb_handler_t)(const struct device *dev,
+					       struct pm_device_runtime_cb *cb,
+					       int result);
+
+/**
+ * @brief Device runtime PM completion callback
+ *
+ * Embed it in a structure to retrieve additional context with
+ * CONTAINER_OF() in the handler.
+ */
+struct pm_device_runtime_cb {
+	/** @cond INTERNAL_HIDDEN */
+	sys_snode_t node;
+	/** @endcond */
+	/** Completion handler */
+	pm_device_runtime_cb_handler_t handler;
+};
+
 /**
  * @brief Device PM info
  */
@@ -132,6 +160,20 @@ struct pm_device {
 	struct k_work_delayable work;
 	/** Event conditional var to listen to the sync request events */
 	struct k_condvar condvar;
+	/** Maximum CPU latency tolerated while the device is active, in us */
+	int32_t latency_us;
+	/** CPU latency request, added while the device is active */
+	struct pm_policy_latency_request latency_req;
+	/** Whether the CPU latency request is added */
+	bool latency_req_active;
+#if defined(CONFIG_PM_DEVICE_RUNTIME_ASYNC) || defined(__DOXYGEN__)
+	/** Work object for asynchronous resume */
+	struct k_work resume_work;
+	/** Callbacks waiting for the device to be resumed */
+	sys_slist_t resume_cbs;
+	/** Callback used to wait for the power domain to be resumed */
+	struct pm_device_runtime_cb domain_cb;
+#endif /* CONFIG_PM_DEVICE_RUNTIME_ASYNC */
 #endif /* CONFIG_PM_DEVICE_RUNTIME */
 #ifdef CONFIG_PM_DEVICE_POWER_DOMAIN
 	/** Power Domain it belongs */
@@ -148,7 +190,8 @@ struct pm_device {
 #ifdef CONFIG_PM_DEVICE_RUNTIME
 #define Z_PM_DEVICE_RUNTIME_INIT(obj)			\
 	.lock = Z_MUTEX_INITIALIZER(obj.lock),		\
-	.condvar = Z_CONDVAR_INITIALIZER(obj.condvar),
+	.condvar = Z_CONDVAR_INITIALIZER(obj.condvar),	\
+	.latency_us = SYS_FOREVER_US,
 #else
 #define Z_PM_DEVICE_RUNTIME_INIT(obj)
 #endif /* CONFIG_PM_DEVICE_RUNTIME */
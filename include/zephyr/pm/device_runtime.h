@@ -9,6 +9,7 @@
 #define ZEPHYR_INCLUDE_PM_DEVICE_RUNTIME_H_
 
 #include <zephyr/device.h>
+#include <zephyr/pm/device.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -66,8 +67,9 @@ int pm_device_runtime_disable(const struct device *dev);
  * be left unchanged. In all other cases, usage count will be incremented.
  *
  * If the device is still being suspended as a result of calling
- * pm_device_runtime_put_async(), this function will wait for the operation to
- * finish to then resume the device.
+ * pm_device_runtime_put_async(), the suspend is cancelled if it did not start
+ * yet. Otherwise this function will wait for the operation to finish to then
+ * resume the device.
  *
  * @funcprops \pre_kernel_ok
  *
@@ -142,6 +144,55 @@ int pm_device_runtime_put_async(const struct device *dev);
  */
 bool pm_device_runtime_is_enabled(const struct device *dev);
 
+/**
+ * @brief Set the CPU latency tolerated by a device while it is active.
+ *
+ * While the device is resumed through device runtime PM, the system will not
+ * enter any power state that would make the CPU exceed the given latency.
+ * The requirements of all active devices are aggregated with the other
+ * latency requests.
+ *
+ * @param dev Device instance.
+ * @param latency_us Maximum allowed latency in microseconds, SYS_FOREVER_US
+ * to remove the requirement.
+ *
+ * @retval 0 If it succeeds.
+ * @retval -ENOTSUP If the device does not support PM.
+ *
+ * @see pm_policy_latency_request_add()
+ */
+int pm_device_runtime_latency_set(const struct device *dev, int32_t latency_us);
+
+#if defined(CONFIG_PM_DEVICE_RUNTIME_ASYNC) || defined(__DOXYGEN__)
+/**
+ * @brief Resume a device based on usage count, asynchronously.
+ *
+ * Same as pm_device_runtime_get(), but the calling thread does not wait for
+ * the device, nor its power domain, to be resumed. The handler of @p cb is
+ * called once the device is active, or if resuming it failed, in which case
+ * the usage count is left unchanged. The handler is called from the calling
+ * thread if the device is already active, from a work queue otherwise.
+ *
+ * Devices sharing a power domain only wait for the domain once. Their resume
+ * actions then run in parallel if they are spread over several work queues,
+ * see @kconfig{CONFIG_PM_DEVICE_RUNTIME_WORKQ_COUNT}.
+ *
+ * @note This function is asynchronous only if
+ * @kconfig{CONFIG_PM_DEVICE_RUNTIME_ASYNC} is selected. Otherwise the device
+ * is resumed synchronously before calling the handler.
+ *
+ * @param dev Device instance.
+ * @param cb Completion callback, must remain valid until its handler is called.
+ *
+ * @retval 0 If the request is accepted (the handler will be called).
+ * @retval -ENOTSUP If the device does not support PM.
+ *
+ * @see pm_device_runtime_get()
+ */
+int pm_device_runtime_get_async(const struct device *dev,
+				struct pm_device_runtime_cb *cb);
+#endif /* CONFIG_PM_DEVICE_RUNTIME_ASYNC */
+
 #else
 static inline int pm_device_runtime_enable(const struct device *dev) { return -ENOSYS; }
 static inline int pm_device_runtime_disable(const struct device *dev) { return -ENOSYS; }
@@ -149,6 +200,26 @@ static inline int pm_device_runtime_get(const struct device *dev) { return 0; }
 static inline int pm_device_runtime_put(const struct device *dev) { return 0; }
 static inline int pm_device_runtime_put_async(const struct device *dev) { return 0; }
 static inline bool pm_device_runtime_is_enabled(const struct device *dev) { return false; }
+static inline int pm_device_runtime_latency_set(const struct device *dev, int32_t latency_us)
+{
+	return -ENOSYS;
+}
+#endif
+
+#ifndef CONFIG_PM_DEVICE_RUNTIME_ASYNC
+static inline int pm_device_runtime_get_async(const struct device *dev,
+					      struct pm_device_runtime_cb *cb)
+{
+	int ret = pm_device_runtime_get(dev);
+
+	if (ret == -ENOTSUP) {
+		return ret;
+	}
+
+	cb->handler(dev, cb, ret);
+
+	return 0;
+}
 #endif
 
 /** @} */
@@ -64,6 +64,21 @@ struct pm_policy_latency_request {
  */
 const struct pm_state_info *pm_policy_next_state(uint8_t cpu, int32_t ticks);
 
+/**
+ * @brief Report how long a CPU stayed in the state selected by the policy
+ *
+ * This function is called by the power subsystem when the CPU wakes up from a
+ * state returned by pm_policy_next_state(). The duration is used to predict
+ * the length of the next idle periods.
+ *
+ * @param cpu CPU index.
+ * @param idle_ticks The number of ticks the CPU stayed idle.
+ *
+ * @retval true if the selected state was the best fit for the idle duration.
+ * @retval false if a different state should have been selected.
+ */
+bool pm_policy_idle_update(uint8_t cpu, int64_t idle_ticks);
+
 /** @endcond */
 
 /** Special value for 'all substates'. */
@@ -19,6 +19,11 @@ extern "C" {
 
 typedef void *mqd_t;
 
+/* Number of message priorities, from 0 to MQ_PRIO_MAX - 1 */
+#ifndef MQ_PRIO_MAX
+#define MQ_PRIO_MAX 32
+#endif
+
 typedef struct mq_attr {
 	long mq_flags;
 	long mq_maxmsg;
@@ -51,6 +51,8 @@ typedef struct k_sem sem_t;
 
 /* Mutex */
 typedef struct pthread_mutex {
+	/* 0: unlocked, 1: locked, 2: locked with waiters */
+	atomic_t state;
 	pthread_t owner;
 	uint16_t lock_count;
 	int type;
@@ -64,6 +66,7 @@ typedef struct pthread_mutexattr {
 /* Condition variables */
 typedef struct pthread_cond {
 	_wait_q_t wait_q;
+	atomic_t waiters;
 } pthread_cond_t;
 
 typedef struct pthread_condattr {
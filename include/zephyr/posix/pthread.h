@@ -35,8 +35,8 @@ enum pthread_state {
 struct posix_thread {
 	struct k_thread thread;
 
-	/* List of keys that thread has called pthread_setspecific() on */
-	sys_slist_t key_list;
+	/* Values set with pthread_setspecific(), indexed by key */
+	pthread_thread_data key_data[CONFIG_MAX_PTHREAD_KEY_COUNT];
 
 	/* Exit status */
 	void *retval;
@@ -91,6 +91,7 @@ static inline int pthread_cond_init(pthread_cond_t *cv,
 {
 	ARG_UNUSED(att);
 	z_waitq_init(&cv->wait_q);
+	atomic_set(&cv->waiters, 0);
 	return 0;
 }
 
@@ -172,6 +173,7 @@ static inline int pthread_condattr_destroy(pthread_condattr_t *att)
 #define PTHREAD_MUTEX_DEFINE(name) \
 	struct pthread_mutex name = \
 	{ \
+		.state = ATOMIC_INIT(0), \
 		.lock_count = 0, \
 		.wait_q = Z_WAIT_Q_INIT(&name.wait_q),	\
 		.owner = NULL, \
@@ -8,7 +8,6 @@
 #define ZEPHYR_INCLUDE_POSIX_PTHREAD_KEY_H_
 
 #ifdef CONFIG_PTHREAD_IPC
-#include <zephyr/sys/slist.h>
 #include <zephyr/types.h>
 
 #ifdef __cplusplus
@@ -17,31 +16,26 @@ extern "C" {
 
 typedef uint32_t pthread_once_t;
 
-/* pthread_key */
-typedef void *pthread_key_t;
+/* pthread_key, index in the key table */
+typedef uint32_t pthread_key_t;
 
 typedef struct pthread_key_obj {
-	/* List of pthread_key_data objects that contain thread
-	 * specific data for the key
-	 */
-	sys_slist_t key_data_l;
-
 	/* Optional destructor that is passed to pthread_key_create() */
 	void (*destructor)(void *);
+
+	/* Bumped each time the key is created, 0 while it is free */
+	uint32_t generation;
 } pthread_key_obj;
 
 typedef struct pthread_thread_data {
-	sys_snode_t node;
-
-	/* Key and thread specific data passed to pthread_setspecific() */
-	pthread_key_obj *key;
+	/* Thread specific data passed to pthread_setspecific() */
 	void *spec_data;
-} pthread_thread_data;
 
-typedef struct pthread_key_data {
-	sys_snode_t node;
-	pthread_thread_data thread_data;
-} pthread_key_data;
+	/* Generation of the key the data was set for, data set for a
+	 * deleted key is thus never returned for a new one.
+	 */
+	uint32_t generation;
+} pthread_thread_data;
 
 #ifdef __cplusplus
 }
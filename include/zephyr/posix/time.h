@@ -92,6 +92,7 @@ int clock_settime(clockid_t clock_id, const struct timespec *ts);
 int timer_create(clockid_t clockId, struct sigevent *evp, timer_t *timerid);
 int timer_delete(timer_t timerid);
 int timer_gettime(timer_t timerid, struct itimerspec *its);
+int timer_getoverrun(timer_t timerid);
 int timer_settime(timer_t timerid, int flags, const struct itimerspec *value,
 		  struct itimerspec *ovalue);
 int nanosleep(const struct timespec *rqtp, struct timespec *rmtp);
@@ -99,6 +99,11 @@ struct rtio_iodev;
  */
 #define RTIO_SQE_CHAINED BIT(0)
 
+/**
+ * @brief The request was canceled, see rtio_sqe_cancel().
+ */
+#define RTIO_SQE_CANCELED BIT(1)
+
 /**
  * @}
  */
@@ -250,6 +255,11 @@ struct rtio {
 	 */
 	atomic_t xcqcnt;
 
+	/* Serializes producers of the submission queue using
+	 * rtio_sqe_copy_in()
+	 */
+	struct k_spinlock sq_lock;
+
 	/* Submission queue */
 	struct rtio_sq *sq;
 
@@ -414,6 +424,66 @@ static inline void rtio_sqe_prep_write(struct rtio_sqe *sqe,
 		.cq = (struct rtio_cq *const)&_cq_##name,					   \
 	}
 
+/**
+ * @brief Copy submissions into the submission queue of an RTIO context
+ *
+ * Unlike acquiring submission queue entries directly, this may be used
+ * concurrently by multiple threads and ISRs producing submissions to the
+ * same RTIO context. Either all entries are queued, or none. Chains must be
+ * copied in with a single call so that they are not interleaved with
+ * entries of other producers.
+ *
+ * The entries are made available to the executor, which still has to be
+ * kicked with rtio_submit(). Producers using this function must not
+ * acquire submission queue entries directly.
+ *
+ * @param r RTIO context
+ * @param sqes Array of prepared submission queue entries
+ * @param sqe_count Number of entries
+ *
+ * @retval 0 On success
+ * @retval -ENOMEM Not enough free entries in the submission queue
+ */
+static inline int rtio_sqe_copy_in(struct rtio *r,
+				   const struct rtio_sqe *sqes,
+				   size_t sqe_count)
+{
+	k_spinlock_key_t key = k_spin_lock(&r->sq_lock);
+	struct rtio_sqe *sqe;
+	unsigned long used;
+
+	used = atomic_get(&r->sq->_spsc.in) - atomic_get(&r->sq->_spsc.out);
+	if ((rtio_spsc_size(r->sq) - used) < sqe_count) {
+		k_spin_unlock(&r->sq_lock, key);
+		return -ENOMEM;
+	}
+
+	for (size_t i = 0; i < sqe_count; i++) {
+		sqe = rtio_spsc_acquire(r->sq);
+		*sqe = sqes[i];
+	}
+
+	rtio_spsc_produce_all(r->sq);
+
+	k_spin_unlock(&r->sq_lock, key);
+
+	return 0;
+}
+
+/**
+ * @brief Cancel a queued submission
+ *
+ * A canceled submission which has not been started by the executor yet
+ * completes with -ECANCELED, along with the rest of its chain, without being
+ * passed to its IO device. A submission already started completes normally.
+ *
+ * @param sqe Submission queue entry, in the submission queue
+ */
+static inline void rtio_sqe_cancel(struct rtio_sqe *sqe)
+{
+	sqe->flags |= RTIO_SQE_CANCELED;
+}
+
 /**
  * @brief Set the executor of the rtio context
  */
@@ -56,6 +56,12 @@ void rtio_simple_err(struct rtio *r, const struct rtio_sqe *sqe, int result);
  */
 struct rtio_simple_executor {
 	struct rtio_executor ctx;
+
+	/* Serializes starting submissions */
+	struct k_spinlock lock;
+
+	/* A submission is being executed */
+	bool active;
 };
 
 /**
@@ -49,6 +49,9 @@ static inline int shared_irq_isr_register(const struct device *dev,
 
 /**
  *  @brief Enable ISR for device
+ *
+ *  The shared interrupt only calls the ISRs of the enabled devices.
+ *
  *  @param dev Pointer to device structure for SHARED_IRQ driver instance.
  *  @param isr_dev Pointer to the device that will service the interrupt.
  */
@@ -821,6 +821,11 @@ struct shell_ctx {
 
 	struct k_mutex wr_mtx;
 	k_tid_t tid;
+
+#if defined CONFIG_SHELL_BULK_OUTPUT
+	/*!< Bulk output nesting level, accessed with wr_mtx held. */
+	uint8_t bulk_cnt;
+#endif
 };
 
 extern const struct log_backend_api log_backend_shell_api;
@@ -861,13 +866,27 @@ struct shell {
 
 extern void z_shell_print_stream(const void *user_ctx, const char *data,
 				 size_t data_len);
+/* When bulk output is supported formatted output uses a dedicated buffer,
+ * otherwise the buffer is shared with the log backend.
+ */
+#ifdef CONFIG_SHELL_BULK_OUTPUT
+#define Z_SHELL_FPRINTF_BUFFER_SIZE CONFIG_SHELL_BULK_OUTPUT_BUFF_SIZE
+#define Z_SHELL_FPRINTF_BUFFER_DEFINE(_name) \
+	static uint8_t _name##_fprintf_buffer[Z_SHELL_FPRINTF_BUFFER_SIZE]
+#define Z_SHELL_FPRINTF_BUFFER(_name) _name##_fprintf_buffer
+#else
+#define Z_SHELL_FPRINTF_BUFFER_SIZE CONFIG_SHELL_PRINTF_BUFF_SIZE
+#define Z_SHELL_FPRINTF_BUFFER_DEFINE(_name)
+#define Z_SHELL_FPRINTF_BUFFER(_name) _name##_out_buffer
+#endif
+
 /**
  * @brief Macro for defining a shell instance.
  *
  * @param[in] _name		Instance name.
  * @param[in] _prompt		Shell default prompt string.
  * @param[in] _transport_iface	Pointer to the transport interface.
- * @param[in] _log_queue_size	Logger processing queue size.
+ * @param[in] _log_queue_size	Logger processing buffer size in bytes.
  * @param[in] _log_timeout	Logger thread timeout in milliseconds on full
  *				log queue. If queue is full logger thread is
  *				blocked for given amount of time before log
@@ -883,8 +902,10 @@ extern void z_shell_print_stream(const void *user_ctx, const char *data,
 				 CONFIG_SHELL_PRINTF_BUFF_SIZE,		      \
 				 _log_queue_size, _log_timeout);	      \
 	Z_SHELL_HISTORY_DEFINE(_name##_history, CONFIG_SHELL_HISTORY_BUFFER); \
-	Z_SHELL_FPRINTF_DEFINE(_name##_fprintf, &_name, _name##_out_buffer,   \
-			     CONFIG_SHELL_PRINTF_BUFF_SIZE,		      \
+	Z_SHELL_FPRINTF_BUFFER_DEFINE(_name);				      \
+	Z_SHELL_FPRINTF_DEFINE(_name##_fprintf, &_name,			      \
+			     Z_SHELL_FPRINTF_BUFFER(_name),		      \
+			     Z_SHELL_FPRINTF_BUFFER_SIZE,		      \
 			     true, z_shell_print_stream);		      \
 	LOG_INSTANCE_REGISTER(shell, _name, CONFIG_SHELL_LOG_LEVEL);	      \
 	Z_SHELL_STATS_DEFINE(_name);					      \
@@ -1031,6 +1052,29 @@ void shell_hexdump_line(const struct shell *shell, unsigned int offset,
  */
 void shell_hexdump(const struct shell *shell, const uint8_t *data, size_t len);
 
+/**
+ * @brief Start bulk output.
+ *
+ * Until @ref shell_bulk_output_end is called, output printed by the calling
+ * thread is written to the transport only when the output buffer is full,
+ * and the command line is not erased and restored around each print.
+ * Output from other threads is blocked until bulk output ends.
+ *
+ * Calls may be nested. Requires @kconfig{CONFIG_SHELL_BULK_OUTPUT}.
+ *
+ * @param[in] sh	Pointer to the shell instance.
+ */
+void shell_bulk_output_begin(const struct shell *sh);
+
+/**
+ * @brief End bulk output.
+ *
+ * Flushes the remaining output and restores the command line.
+ *
+ * @param[in] sh	Pointer to the shell instance.
+ */
+void shell_bulk_output_end(const struct shell *sh);
+
 /**
  * @brief Print info message to the shell.
  *
@@ -57,8 +57,8 @@ int z_shell_log_backend_output_func(uint8_t *data, size_t length, void *ctx);
  *  @param _name	Shell name.
  *  @param _buf		Output buffer.
  *  @param _size	Output buffer size.
- *  @param _queue_size	Log message queue size.
- *  @param _timeout	Timeout in milliseconds for pending on queue full.
+ *  @param _queue_size	Log message buffer size in bytes.
+ *  @param _timeout	Timeout in milliseconds for pending on buffer full.
  *			Message is dropped on timeout.
  */
 /** @def Z_SHELL_LOG_BACKEND_PTR
@@ -72,13 +72,22 @@ int z_shell_log_backend_output_func(uint8_t *data, size_t length, void *ctx);
 	LOG_OUTPUT_DEFINE(_name##_log_output, z_shell_log_backend_output_func,\
 			  _buf, _size); \
 	static struct shell_log_backend_control_block _name##_control_block; \
-	static uint32_t __aligned(Z_LOG_MSG2_ALIGNMENT) _name##_buf[128]; \
+	static uint32_t __aligned(Z_LOG_MSG2_ALIGNMENT) \
+		_name##_buf[ceiling_fraction(_queue_size, sizeof(uint32_t))]; \
+	static void _name##_notify_drop(const struct mpsc_pbuf_buffer *buffer, \
+					const union mpsc_pbuf_generic *item) \
+	{ \
+		ARG_UNUSED(buffer); \
+		ARG_UNUSED(item); \
+		atomic_inc(&_name##_control_block.dropped_cnt); \
+	} \
 	const struct mpsc_pbuf_buffer_config _name##_mpsc_buffer_config = { \
 		.buf = _name##_buf, \
 		.size = ARRAY_SIZE(_name##_buf), \
-		.notify_drop = NULL, \
+		.notify_drop = _name##_notify_drop, \
 		.get_wlen = log_msg_generic_get_wlen, \
-		.flags = MPSC_PBUF_MODE_OVERWRITE, \
+		.flags = IS_ENABLED(CONFIG_SHELL_LOG_BACKEND_OVERFLOW_DROP_OLDEST) ? \
+			 MPSC_PBUF_MODE_OVERWRITE : 0, \
 	}; \
 	struct mpsc_pbuf_buffer _name##_mpsc_buffer; \
 	static const struct shell_log_backend _name##_log_backend = { \
@@ -65,6 +65,27 @@ extern "C" {
  */
 typedef void (*state_execution)(void *obj);
 
+struct smf_state;
+struct smf_ctx;
+
+/**
+ * @brief Callback reporting the time spent in a state
+ *
+ * Called at the end of each transition, with CONFIG_SMF_STATE_TIMING.
+ *
+ * @param ctx               State machine context
+ * @param state             State that was exited
+ * @param state_cycles      Cycles spent in @p state, from the end of the
+ *                          transition into it to the start of the
+ *                          transition out of it
+ * @param transition_cycles Cycles spent in the transition, including the
+ *                          exit and entry actions
+ */
+typedef void (*smf_timing_cb)(struct smf_ctx *ctx,
+			      const struct smf_state *state,
+			      uint32_t state_cycles,
+			      uint32_t transition_cycles);
+
 /** General state that can be used in multiple state machines. */
 struct smf_state {
 	/** Optional method that will be run when this state is entered */
@@ -107,6 +128,19 @@ struct smf_ctx {
 	 * used to track state machine context
 	 */
 	uint32_t internal;
+#if defined(CONFIG_SMF_EVENTS) || defined(__DOXYGEN__)
+	/**
+	 * Event being processed by smf_run_event() or smf_dispatch(), NULL
+	 * when the state machine is run with smf_run_state()
+	 */
+	const void *event;
+#endif
+#if defined(CONFIG_SMF_STATE_TIMING) || defined(__DOXYGEN__)
+	/** Cycle count when the current state was entered */
+	uint32_t entered;
+	/** Optional callback reporting state and transition times */
+	smf_timing_cb timing_cb;
+#endif
 };
 
 /**
@@ -147,6 +181,60 @@ void smf_set_terminate(struct smf_ctx *ctx, int32_t val);
  */
 int32_t smf_run_state(struct smf_ctx *ctx);
 
+#if defined(CONFIG_SMF_EVENTS) || defined(__DOXYGEN__)
+/**
+ * @brief Runs one iteration of a state machine for an event
+ *
+ * Same as smf_run_state(), with @p event available to the run actions
+ * through the event member of the context.
+ *
+ * @param ctx   State machine context
+ * @param event Event to process
+ * @return	Same as smf_run_state()
+ */
+int32_t smf_run_event(struct smf_ctx *ctx, const void *event);
+
+/**
+ * @brief Takes an event from a queue and runs a state machine for it
+ *
+ * The event is processed to completion, including the transitions it
+ * causes, before the next one can be taken. A non-zero termination value
+ * is available in the terminate_val member of the context.
+ *
+ * @param ctx     State machine context
+ * @param queue   Message queue holding the events
+ * @param buf     Buffer of the message size of @p queue for the event
+ * @param timeout Time to wait for an event
+ *
+ * @retval 0 An event was processed.
+ * @retval -ENOMSG Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+int smf_dispatch(struct smf_ctx *ctx, struct k_msgq *queue, void *buf,
+		 k_timeout_t timeout);
+#endif
+
+#if defined(CONFIG_SMF_STATE_TIMING) || defined(__DOXYGEN__)
+/**
+ * @brief Sets the callback reporting state and transition times
+ *
+ * @param ctx State machine context
+ * @param cb  Callback, or NULL to disable reporting
+ */
+void smf_set_timing_cb(struct smf_ctx *ctx, smf_timing_cb cb);
+
+/**
+ * @brief Returns the time spent in the current state
+ *
+ * @param ctx State machine context
+ * @return    Cycles elapsed since the current state was entered
+ */
+static inline uint32_t smf_state_cycles(const struct smf_ctx *ctx)
+{
+	return k_cycle_get_32() - ctx->entered;
+}
+#endif
+
 #ifdef __cplusplus
 }
 #endif
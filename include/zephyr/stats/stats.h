@@ -46,6 +46,12 @@
  *     s<stat-idx>
  *
  * E.g., "s0", "s1", etc.
+ *
+ * Groups updated concurrently from several CPUs can be declared per-CPU with
+ * STATS_SECT_PERCPU_END() and STATS_PERCPU_DECL().  Every CPU increments its
+ * own cache line aligned copy of the group with STATS_PERCPU_INC(), without
+ * atomic operations or locks shared between CPUs.  The copies are only summed
+ * up when the group is read with stats_get_value().
  */
 
 #ifndef ZEPHYR_INCLUDE_STATS_STATS_H_
@@ -53,6 +59,12 @@
 
 #include <stddef.h>
 #include <zephyr/types.h>
+#include <zephyr/toolchain.h>
+#include <zephyr/sys/util.h>
+#ifdef CONFIG_STATS
+#include <zephyr/arch/cpu.h>
+#include <zephyr/kernel_structs.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -67,7 +79,10 @@ struct stats_hdr {
 	const char *s_name;
 	uint8_t s_size;
 	uint16_t s_cnt;
-	uint8_t s_pad1;
+	/* Number of per-CPU copies of the entries, 1 for regular groups */
+	uint8_t s_pcpu_cnt;
+	/* Distance in bytes between the per-CPU copies */
+	uint16_t s_pcpu_stride;
 #ifdef CONFIG_STATS_NAMES
 	const struct stats_name_map *s_map;
 	int s_map_cnt;
@@ -88,6 +103,17 @@ struct stats_hdr {
  */
 #define STATS_SECT_END }
 
+/**
+ * @brief Declares the per-CPU copies of a stats group.
+ *
+ * The group must have been defined with STATS_SECT_PERCPU_END().
+ *
+ * @param group__               The stats group struct name.
+ * @param name__                The name of the variable to declare.
+ */
+#define STATS_PERCPU_DECL(group__, name__) \
+	STATS_SECT_DECL(group__) name__[CONFIG_MP_NUM_CPUS]
+
 /* The following macros depend on whether CONFIG_STATS is defined.  If it is
  * not defined, then invocations of these macros get compiled out.
  */
@@ -130,6 +156,15 @@ struct stats_hdr {
  */
 #define STATS_SECT_ENTRY64(var__) uint64_t var__;
 
+/**
+ * @brief Ends a per-CPU stats group struct definition.
+ *
+ * Every copy of the group is aligned to CONFIG_STATS_PERCPU_ALIGN, so that
+ * CPUs updating their copy do not share cache lines.
+ */
+#define STATS_SECT_PERCPU_END \
+	uint8_t s_end[0]; } __aligned(CONFIG_STATS_PERCPU_ALIGN)
+
 /**
  * @brief Increases a statistic entry by the specified amount.
  *
@@ -180,6 +215,35 @@ struct stats_hdr {
 #define STATS_CLEAR(group__, var__) \
 	((group__).var__ = 0)
 
+/**
+ * @brief Increases an entry of a per-CPU statistics group.
+ *
+ * Increases the entry in the copy of the group that belongs to the current
+ * CPU.  Interrupts are only masked on the local CPU, to keep the thread on
+ * its CPU while updating the entry.  Compiled out if CONFIG_STATS is not
+ * defined.
+ *
+ * @param group__               The per-CPU copies of the group.
+ * @param var__                 The statistic entry to increase.
+ * @param n__                   The amount to increase the statistic entry by.
+ */
+#define STATS_PERCPU_INCN(group__, var__, n__)			\
+	do {							\
+		unsigned int key__ = arch_irq_lock();		\
+								\
+		(group__)[_current_cpu->id].var__ += (n__);	\
+		arch_irq_unlock(key__);				\
+	} while (false)
+
+/**
+ * @brief Increments an entry of a per-CPU statistics group.
+ *
+ * @param group__               The per-CPU copies of the group.
+ * @param var__                 The statistic entry to increase.
+ */
+#define STATS_PERCPU_INC(group__, var__) \
+	STATS_PERCPU_INCN(group__, var__, 1)
+
 #define STATS_SIZE_16 (sizeof(uint16_t))
 #define STATS_SIZE_32 (sizeof(uint32_t))
 #define STATS_SIZE_64 (sizeof(uint64_t))
@@ -210,6 +274,29 @@ struct stats_hdr {
 		STATS_NAME_INIT_PARMS(group__),				 \
 		(name__))
 
+/**
+ * @brief Initializes and registers a per-CPU statistics group.
+ *
+ * @param group__               The per-CPU copies of the group to initialize
+ *                                  and register.
+ * @param size__                The size of each entry in the statistics group,
+ *                                  in bytes.  Must be one of: 2 (16-bits), 4
+ *                                  (32-bits) or 8 (64-bits).
+ * @param name__                The name of the statistics group to register.
+ *
+ * @return                      0 on success; negative error code on failure.
+ */
+#define STATS_PERCPU_INIT_AND_REG(group__, size__, name__)		   \
+	stats_init_and_reg_percpu(					   \
+		&(group__)[0].s_hdr,					   \
+		(size__),						   \
+		((uint8_t *)(group__)[0].s_end -			   \
+		 (uint8_t *)&(group__)[0] - sizeof(struct stats_hdr)) /   \
+		(size__),						   \
+		STATS_NAME_INIT_PARMS(group__),				   \
+		sizeof((group__)[0]), ARRAY_SIZE(group__),		   \
+		(name__))
+
 /**
  * @brief Initializes a statistics group.
  *
@@ -272,6 +359,42 @@ int stats_init_and_reg(struct stats_hdr *hdr, uint8_t size, uint16_t cnt,
 		       const struct stats_name_map *map, uint16_t map_cnt,
 		       const char *name);
 
+/**
+ * @brief Initializes and registers a per-CPU statistics group.
+ *
+ * Note: it is recommended to use the STATS_PERCPU_INIT_AND_REG macro instead
+ * of this function.
+ *
+ * @param hdr                   The header of the first copy of the group.
+ * @param size                  The size of each individual statistics
+ *                                  element, in bytes.
+ * @param cnt                   The number of elements in the stats group.
+ * @param map                   The mapping of stat offset to name.
+ * @param map_cnt               The number of items in the statistics map
+ * @param stride                The distance in bytes between the copies.
+ * @param pcpu_cnt              The number of copies.
+ * @param name                  The name of the statistics group to register.
+ *
+ * @return                      0 on success; negative error code on failure.
+ */
+int stats_init_and_reg_percpu(struct stats_hdr *hdr, uint8_t size,
+			      uint16_t cnt, const struct stats_name_map *map,
+			      uint16_t map_cnt, uint16_t stride,
+			      uint8_t pcpu_cnt, const char *name);
+
+/**
+ * @brief Reads the value of a statistic entry.
+ *
+ * For per-CPU groups, the entries of all copies are summed up.
+ *
+ * @param hdr                   The group containing the stat entry.
+ * @param off                   The offset of the entry, from `hdr`, as passed
+ *                                  to a @ref stats_walk_fn.
+ *
+ * @return                      The value of the entry.
+ */
+uint64_t stats_get_value(const struct stats_hdr *hdr, uint16_t off);
+
 /**
  * Zeroes the specified statistics group.
  *
@@ -358,13 +481,17 @@ struct stats_hdr *stats_group_find(const char *name);
 #define STATS_SECT_ENTRY16(var__)
 #define STATS_SECT_ENTRY32(var__)
 #define STATS_SECT_ENTRY64(var__)
+#define STATS_SECT_PERCPU_END }
 #define STATS_RESET(var__)
 #define STATS_SIZE_INIT_PARMS(group__, size__)
 #define STATS_INCN(group__, var__, n__)
 #define STATS_INC(group__, var__)
+#define STATS_PERCPU_INCN(group__, var__, n__)
+#define STATS_PERCPU_INC(group__, var__)
 #define STATS_SET(group__, var__)
 #define STATS_CLEAR(group__, var__)
 #define STATS_INIT_AND_REG(group__, size__, name__) (0)
+#define STATS_PERCPU_INIT_AND_REG(group__, size__, name__) (0)
 
 #endif /* !CONFIG_STATS */
 
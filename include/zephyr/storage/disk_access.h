@@ -100,6 +100,71 @@ int disk_access_write(const char *pdrv, const uint8_t *data_buf,
  */
 int disk_access_ioctl(const char *pdrv, uint8_t cmd, void *buff);
 
+/** @brief Asynchronous disk request operations */
+enum disk_access_op {
+	/** Read sectors from the disk */
+	DISK_ACCESS_OP_READ,
+	/** Write sectors to the disk */
+	DISK_ACCESS_OP_WRITE,
+};
+
+struct disk_access_req;
+
+/**
+ * @brief Asynchronous disk request completion callback
+ *
+ * Called from the disk access thread once the request has completed.
+ * The request may be resubmitted from the callback.
+ *
+ * @param[in] req           Completed request, with @a result set
+ */
+typedef void (*disk_access_req_cb_t)(struct disk_access_req *req);
+
+/**
+ * @brief Asynchronous disk request
+ *
+ * The request is owned by the disk access layer from submission until its
+ * callback is called, and must not be modified in between.
+ */
+struct disk_access_req {
+	/** Internally used queue node */
+	sys_snode_t node;
+	/** Disk name */
+	const char *pdrv;
+	/** Requested operation */
+	enum disk_access_op op;
+	/** Memory buffer to read to or write from */
+	uint8_t *data_buf;
+	/** Start disk sector */
+	uint32_t start_sector;
+	/** Number of disk sectors */
+	uint32_t num_sector;
+	/** Completion callback */
+	disk_access_req_cb_t cb;
+	/** Result of the request, 0 on success, negative errno code on fail */
+	int result;
+	/** Opaque user data, not used by the disk access layer */
+	void *user_data;
+};
+
+/**
+ * @brief Submit an asynchronous disk request
+ *
+ * Queues the request for the disk access thread and returns immediately,
+ * allowing the caller to prepare further requests while earlier ones are
+ * in progress. Requests are executed in submission order. Queued requests
+ * of the same operation, on adjacent sectors and with adjacent memory
+ * buffers, are merged into a single multi-sector disk transfer.
+ *
+ * @note Requires CONFIG_DISK_ACCESS_ASYNC.
+ *
+ * @param[in] req           Request to submit
+ *
+ * @retval 0 on success
+ * @retval -EINVAL if the request is invalid or the disk is not registered
+ */
+int disk_access_submit(struct disk_access_req *req);
+
 #ifdef __cplusplus
 }
 #endif
@@ -63,6 +63,14 @@ struct stream_flash_ctx {
 #ifdef CONFIG_STREAM_FLASH_ERASE
 	off_t last_erased_page_start_offset; /* Last erased offset */
 #endif
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	uint8_t *buf_alt; /* Buffer being programmed, NULL if synchronous */
+	size_t pending_bytes; /* Number of bytes in buf_alt */
+	size_t bytes_submitted; /* Number of bytes handed over for writing */
+	int async_rc; /* Result of the last asynchronous write */
+	struct k_sem async_done; /* Given when buf_alt may be reused */
+	struct k_work work; /* Asynchronous write work item */
+#endif
 };
 
 /**
@@ -84,6 +92,31 @@ struct stream_flash_ctx {
 int stream_flash_init(struct stream_flash_ctx *ctx, const struct device *fdev,
 		      uint8_t *buf, size_t buf_len, size_t offset, size_t size,
 		      stream_flash_callback_t cb);
+/**
+ * @brief Enable double buffered, asynchronous flash programming.
+ *
+ * Once enabled, a full write buffer is programmed from the stream flash work
+ * queue while the next one is being filled through
+ * @ref stream_flash_buffered_write, which then only blocks if the previous
+ * buffer is still being programmed. With CONFIG_STREAM_FLASH_ERASE the page
+ * following the write pointer is erased ahead of time as well. The flash
+ * write callback is invoked from the work queue.
+ *
+ * An error of an asynchronous write is reported by the next call to
+ * @ref stream_flash_buffered_write. A flush write returns only once all data
+ * has been written to flash.
+ *
+ * @note Requires CONFIG_STREAM_FLASH_ASYNC.
+ *
+ * @param ctx context, initialized with @ref stream_flash_init and, if used,
+ *            @ref stream_flash_progress_load, before any data is written.
+ * @param buf Second write buffer, of the length given to
+ *            @ref stream_flash_init.
+ *
+ * @return non-negative on success, negative errno code on fail
+ */
+int stream_flash_async_enable(struct stream_flash_ctx *ctx, uint8_t *buf);
+
 /**
  * @brief Read number of bytes written to the flash.
  *
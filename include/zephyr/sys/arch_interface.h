@@ -1045,6 +1045,26 @@ int arch_dcache_all(int op);
  */
 int arch_dcache_range(void *addr, size_t size, int op);
 
+#if defined(CONFIG_ARCH_HAS_DCACHE_RANGE_NOSYNC)
+/**
+ *
+ * @brief Start write-back / invalidate of d-cache lines without a barrier
+ *
+ * The operation is only guaranteed to be complete after arch_dcache_sync().
+ *
+ * @see sys_cache_data_range_nosync
+ */
+int arch_dcache_range_nosync(void *addr, size_t size, int op);
+
+/**
+ *
+ * @brief Wait for the completion of d-cache maintenance operations
+ *
+ * @see sys_cache_data_sync
+ */
+void arch_dcache_sync(void);
+#endif /* CONFIG_ARCH_HAS_DCACHE_RANGE_NOSYNC */
+
 #if defined(CONFIG_DCACHE_LINE_SIZE_DETECT)
 /**
  *
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief Arena (bump) allocator
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_ARENA_H_
+#define ZEPHYR_INCLUDE_SYS_ARENA_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup sys_arena_apis Arena Allocator APIs
+ * @ingroup memory_management
+ * @{
+ */
+
+struct k_heap;
+
+/**
+ * @brief Arena memory block
+ *
+ * Header at the start of every region an arena hands memory out of.
+ * Internal to the arena.
+ */
+struct sys_arena_block {
+	/** Previously used block, or NULL */
+	struct sys_arena_block *next;
+	/** End of the usable memory in this block */
+	uint8_t *end;
+};
+
+/**
+ * @brief Arena position
+ *
+ * Saved by sys_arena_mark() and restored by sys_arena_reset_to().
+ */
+struct sys_arena_mark {
+	struct sys_arena_block *block;
+	uint8_t *pos;
+};
+
+/**
+ * @brief Arena allocator
+ *
+ * An arena hands out memory by advancing a pointer through a block of
+ * memory.  Individual allocations are never freed: instead the arena
+ * is rewound to an earlier position, releasing everything allocated
+ * since in one step.  This suits processing where many short-lived
+ * objects are created for one request and are all dropped together
+ * at the end of it.
+ *
+ * An arena can use a fixed buffer, a k_heap from which it allocates
+ * growth blocks on demand, or both.  Growth blocks are chained and
+ * given back to the heap when the arena is rewound past them.
+ *
+ * Arenas are unsynchronized.  They are meant to be owned by a single
+ * thread, typically for the duration of one request.
+ */
+struct sys_arena {
+	/** Heap growth blocks are allocated from, or NULL */
+	struct k_heap *heap;
+	/** Minimum size of a growth block */
+	size_t block_size;
+	/** Current position */
+	struct sys_arena_mark cur;
+	/** Initial position */
+	struct sys_arena_mark start;
+};
+
+/**
+ * @brief Initialize an arena on a fixed buffer
+ *
+ * @param arena Arena to initialize
+ * @param buf Memory the arena allocates from
+ * @param size Size of @a buf in bytes
+ */
+void sys_arena_init(struct sys_arena *arena, void *buf, size_t size);
+
+/**
+ * @brief Let an arena grow from a heap
+ *
+ * When an allocation doesn't fit in the current block, a new block of
+ * at least @a block_size bytes is allocated from @a heap without
+ * waiting.  This may be called on an arena initialized with
+ * sys_arena_init() to let it overflow its buffer, or on an arena
+ * zeroed by the caller to use the heap alone.
+ *
+ * @param arena Arena
+ * @param heap Heap to allocate growth blocks from
+ * @param block_size Minimum growth block size in bytes
+ */
+void sys_arena_init_heap(struct sys_arena *arena, struct k_heap *heap,
+			 size_t block_size);
+
+/**
+ * @brief Allocate aligned memory from an arena
+ *
+ * @param arena Arena
+ * @param align Required alignment, a power of two, or zero
+ * @param bytes Number of bytes requested
+ * @return Pointer to the memory, or NULL if it couldn't be allocated
+ */
+void *sys_arena_aligned_alloc(struct sys_arena *arena, size_t align,
+			      size_t bytes);
+
+/**
+ * @brief Allocate memory from an arena
+ *
+ * The memory is aligned to the size of a pointer.
+ *
+ * @param arena Arena
+ * @param bytes Number of bytes requested
+ * @return Pointer to the memory, or NULL if it couldn't be allocated
+ */
+static inline void *sys_arena_alloc(struct sys_arena *arena, size_t bytes)
+{
+	return sys_arena_aligned_alloc(arena, sizeof(void *), bytes);
+}
+
+/**
+ * @brief Save the current position of an arena
+ *
+ * @param arena Arena
+ * @param mark Filled with the current position
+ */
+static inline void sys_arena_mark(struct sys_arena *arena,
+				  struct sys_arena_mark *mark)
+{
+	*mark = arena->cur;
+}
+
+/**
+ * @brief Rewind an arena to a saved position
+ *
+ * Everything allocated since @a mark was taken is released at once,
+ * and growth blocks allocated since are returned to the heap.  Marks
+ * taken after @a mark become invalid.
+ *
+ * @param arena Arena
+ * @param mark Position saved with sys_arena_mark()
+ */
+void sys_arena_reset_to(struct sys_arena *arena,
+			const struct sys_arena_mark *mark);
+
+/**
+ * @brief Rewind an arena to its initial position
+ *
+ * Releases all memory allocated from the arena and returns every
+ * growth block to the heap.
+ *
+ * @param arena Arena
+ */
+static inline void sys_arena_reset(struct sys_arena *arena)
+{
+	sys_arena_reset_to(arena, &arena->start);
+}
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_ARENA_H_ */
@@ -26,12 +26,33 @@ struct sys_bitarray {
 	/* Bundle of bits */
 	uint32_t *bundles;
 
+#ifdef CONFIG_SYS_BITARRAY_SUMMARY
+	/* One bit per bundle, set if all bits of the bundle are set */
+	uint32_t *summary;
+#endif
+
+#ifdef CONFIG_SYS_BITARRAY_NEXT_FIT
+	/* Bit to start searching from in the next allocation */
+	uint32_t hint;
+#endif
+
 	/* Spinlock guarding access to this bit array */
 	struct k_spinlock lock;
 };
 
 typedef struct sys_bitarray sys_bitarray_t;
 
+#ifdef CONFIG_SYS_BITARRAY_SUMMARY
+#define _SYS_BITARRAY_SUMMARY_DEFINE(name, total_bits, sba_mod)		\
+	sba_mod uint32_t _sys_bitarray_summary_##name			\
+		[((total_bits) + 32 * 32 - 1) / (32 * 32)] = {0};
+#define _SYS_BITARRAY_SUMMARY_INIT(name)				\
+	.summary = _sys_bitarray_summary_##name,
+#else
+#define _SYS_BITARRAY_SUMMARY_DEFINE(name, total_bits, sba_mod)
+#define _SYS_BITARRAY_SUMMARY_INIT(name)
+#endif
+
 /**
  * @brief Create a bitarray object.
  *
@@ -43,12 +64,14 @@ typedef struct sys_bitarray sys_bitarray_t;
 	sba_mod uint32_t _sys_bitarray_bundles_##name			\
 		[(((total_bits + 8 - 1) / 8) + sizeof(uint32_t) - 1)	\
 		 / sizeof(uint32_t)] = {0};				\
+	_SYS_BITARRAY_SUMMARY_DEFINE(name, total_bits, sba_mod)		\
 	sba_mod sys_bitarray_t name = {					\
 		.num_bits = total_bits,					\
 		.num_bundles = (((total_bits + 8 - 1) / 8)		\
 				+ sizeof(uint32_t) - 1)			\
 			       / sizeof(uint32_t),			\
 		.bundles = _sys_bitarray_bundles_##name,		\
+		_SYS_BITARRAY_SUMMARY_INIT(name)			\
 	}
 
 /**
@@ -140,6 +163,10 @@ int sys_bitarray_test_and_clear_bit(sys_bitarray_t *bitarray, size_t bit, int *p
  * marked as allocated and the offset to the start of this region is
  * returned via @p offset.
  *
+ * The lowest fitting region is allocated, unless
+ * CONFIG_SYS_BITARRAY_NEXT_FIT is enabled, in which case the search
+ * starts after the region allocated last and wraps around.
+ *
  * @param[in]  bitarray Bitarray struct
  * @param[in]  num_bits Number of bits to allocate
  * @param[out] offset   Offset to the start of allocated region if
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief B-tree data structure
+ *
+ * This implements an ordered B-tree of pointers to user items. Each tree
+ * node holds several items in a contiguous array, so a lookup touches
+ * O(log(N)) nodes of a few cache lines each instead of the O(log2(N))
+ * scattered nodes of a binary tree, which makes it better suited than
+ * struct rbtree to large sets that are mostly searched.
+ *
+ * Like the other data structures of this library, the tree never
+ * allocates memory: its nodes come from an array provided by the user,
+ * which must be large enough for the number of items the tree will hold,
+ * see SYS_BTREE_NODES(). Items are not modified by the tree and may be
+ * in several trees at once.
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_BTREE_H_
+#define ZEPHYR_INCLUDE_SYS_BTREE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup btree_apis B-tree
+ * @ingroup datastructure_apis
+ * @{
+ */
+
+/**
+ * Minimum degree of the tree. Every node other than the root holds
+ * between SYS_BTREE_MIN_DEGREE - 1 and 2 * SYS_BTREE_MIN_DEGREE - 1
+ * items, the default fits a node in 64 bytes with 32-bit pointers.
+ */
+#define SYS_BTREE_MIN_DEGREE 4
+
+/** Maximum number of items in a node */
+#define SYS_BTREE_MAX_ITEMS (2 * SYS_BTREE_MIN_DEGREE - 1)
+
+/**
+ * @brief Number of nodes needed by a tree
+ *
+ * @param n_items Maximum number of items in the tree.
+ */
+#define SYS_BTREE_NODES(n_items)						\
+	(DIV_ROUND_UP(n_items, SYS_BTREE_MIN_DEGREE - 1) + 1)
+
+/** @brief B-tree node, the content is private */
+struct sys_btree_node {
+	void *items[SYS_BTREE_MAX_ITEMS];
+	struct sys_btree_node *children[SYS_BTREE_MAX_ITEMS + 1];
+	uint8_t count;
+	bool leaf;
+};
+
+/**
+ * @typedef sys_btree_cmp_t
+ * @brief B-tree comparison function
+ *
+ * Compares a key with an item of the tree and returns a negative value,
+ * zero or a positive value if the key is respectively lower than, equal
+ * to or greater than the item. The key is the one passed to the lookup
+ * and removal functions, or the item being inserted.
+ */
+typedef int (*sys_btree_cmp_t)(const void *key, const void *item);
+
+/**
+ * @typedef sys_btree_visit_t
+ * @brief B-tree visitor function
+ *
+ * @return true to continue the iteration, false to stop it.
+ */
+typedef bool (*sys_btree_visit_t)(void *item, void *user_data);
+
+/** @brief B-tree */
+struct sys_btree {
+	struct sys_btree_node *root;
+	/* Unused nodes, linked through children[0] */
+	struct sys_btree_node *free;
+	sys_btree_cmp_t cmp;
+	size_t size;
+};
+
+/**
+ * @brief Define a B-tree and its nodes
+ *
+ * The tree must still be initialized with sys_btree_init() using the
+ * node array named @p name followed by _nodes.
+ *
+ * @param name Name of the tree.
+ * @param n_items Maximum number of items in the tree.
+ */
+#define SYS_BTREE_DEFINE(name, n_items)						\
+	static struct sys_btree_node						\
+		_CONCAT(name, _nodes)[SYS_BTREE_NODES(n_items)];		\
+	struct sys_btree name
+
+/**
+ * @brief Initialize a B-tree
+ *
+ * @param tree Tree.
+ * @param nodes Array of nodes used by the tree.
+ * @param n_nodes Number of nodes in the array.
+ * @param cmp Comparison function.
+ */
+void sys_btree_init(struct sys_btree *tree, struct sys_btree_node *nodes,
+		    size_t n_nodes, sys_btree_cmp_t cmp);
+
+/**
+ * @brief Get the number of items in a B-tree
+ */
+static inline size_t sys_btree_size(const struct sys_btree *tree)
+{
+	return tree->size;
+}
+
+/**
+ * @brief Insert an item into a B-tree
+ *
+ * @param tree Tree.
+ * @param item Item to insert.
+ *
+ * @retval 0 on success.
+ * @retval -EEXIST if an item with the same key is already in the tree.
+ * @retval -ENOMEM if the tree ran out of nodes.
+ */
+int sys_btree_insert(struct sys_btree *tree, void *item);
+
+/**
+ * @brief Remove an item from a B-tree
+ *
+ * @param tree Tree.
+ * @param key Key of the item.
+ *
+ * @return Removed item, or NULL if no item matches the key.
+ */
+void *sys_btree_remove(struct sys_btree *tree, const void *key);
+
+/**
+ * @brief Find an item in a B-tree
+ *
+ * @param tree Tree.
+ * @param key Key of the item.
+ *
+ * @return Matching item, or NULL if none is found.
+ */
+void *sys_btree_find(const struct sys_btree *tree, const void *key);
+
+/**
+ * @brief Find the lowest item greater than or equal to a key
+ *
+ * @param tree Tree.
+ * @param key Key.
+ *
+ * @return Matching item, or NULL if all items are lower than the key.
+ */
+void *sys_btree_find_ge(const struct sys_btree *tree, const void *key);
+
+/**
+ * @brief Get the lowest item of a B-tree
+ *
+ * @return Lowest item, or NULL if the tree is empty.
+ */
+void *sys_btree_min(const struct sys_btree *tree);
+
+/**
+ * @brief Get the greatest item of a B-tree
+ *
+ * @return Greatest item, or NULL if the tree is empty.
+ */
+void *sys_btree_max(const struct sys_btree *tree);
+
+/**
+ * @brief Visit the items of a B-tree in ascending order
+ *
+ * The tree must not be modified during the iteration.
+ *
+ * @param tree Tree.
+ * @param visit Function called for each item.
+ * @param user_data Pointer passed to @p visit.
+ */
+void sys_btree_foreach(const struct sys_btree *tree, sys_btree_visit_t visit,
+		       void *user_data);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_BTREE_H_ */
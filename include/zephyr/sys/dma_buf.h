@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief DMA buffers with ownership tracking
+ *
+ * A DMA buffer is owned either by the CPU or by a DMA capable device.
+ * Handing buffers over between both performs the cache maintenance the
+ * buffers need: dirty cache lines are written back before the device
+ * reads the buffer, and stale cache lines are invalidated before the CPU
+ * reads data written by the device. The buffers of a scatter list are
+ * handed over at once, waiting for the completion of the cache
+ * maintenance only once instead of once per buffer.
+ *
+ * Buffers in non-cacheable memory, or on systems without d-cache, need no
+ * cache maintenance at all. sys_dma_buf_alloc() allocates from
+ * non-cacheable memory when CONFIG_SYS_DMA_BUF_NOCACHE_HEAP_SIZE is set.
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_DMA_BUF_H_
+#define ZEPHYR_INCLUDE_SYS_DMA_BUF_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup dma_buf_apis DMA Buffers
+ * @ingroup datastructure_apis
+ * @{
+ */
+
+/** The buffer is coherent with DMA, no cache maintenance is needed. */
+#define SYS_DMA_BUF_COHERENT BIT(0)
+
+/** @brief Owner of a DMA buffer */
+enum sys_dma_buf_owner {
+	/** The CPU may access the buffer */
+	SYS_DMA_BUF_OWNER_CPU,
+	/** A device may access the buffer through DMA */
+	SYS_DMA_BUF_OWNER_DEVICE,
+};
+
+/** @brief DMA buffer */
+struct sys_dma_buf {
+	/** Start address of the buffer */
+	void *addr;
+	/** Size of the buffer in bytes */
+	size_t size;
+	/** Current owner of the buffer */
+	enum sys_dma_buf_owner owner;
+	/** Buffer flags, see SYS_DMA_BUF_COHERENT */
+	uint8_t flags;
+};
+
+/**
+ * @brief Initialize a DMA buffer for existing memory
+ *
+ * Unless @p flags contains @ref SYS_DMA_BUF_COHERENT, the start address
+ * and the size of the memory must be multiples of the d-cache line size,
+ * so that invalidating the buffer never discards data next to it. The
+ * buffer is initially owned by the CPU.
+ *
+ * @param buf   DMA buffer to initialize.
+ * @param addr  Start address of the memory.
+ * @param size  Size of the memory in bytes.
+ * @param flags Buffer flags.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if the memory is not aligned to d-cache lines.
+ */
+int sys_dma_buf_init(struct sys_dma_buf *buf, void *addr, size_t size,
+		     uint8_t flags);
+
+/**
+ * @brief Allocate a DMA buffer
+ *
+ * Allocates from the non-cacheable heap if configured, and falls back to
+ * the system heap, aligned and padded to d-cache lines. The buffer is
+ * initially owned by the CPU.
+ *
+ * @param buf  DMA buffer to initialize.
+ * @param size Size of the buffer in bytes.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if @p size is 0.
+ * @retval -ENOMEM if no memory is available.
+ */
+int sys_dma_buf_alloc(struct sys_dma_buf *buf, size_t size);
+
+/**
+ * @brief Free a DMA buffer allocated with sys_dma_buf_alloc()
+ *
+ * @param buf DMA buffer to free.
+ */
+void sys_dma_buf_free(struct sys_dma_buf *buf);
+
+/**
+ * @brief Hand DMA buffers over to the device
+ *
+ * Writes back the cache lines of all buffers, and waits for completion
+ * once. The buffers must not be accessed by the CPU until they are
+ * handed back with sys_dma_buf_to_cpu().
+ *
+ * @param bufs Array of DMA buffers, e.g. a scatter list.
+ * @param cnt  Number of buffers.
+ *
+ * @retval 0 on success.
+ * @retval -EBUSY if a buffer is already owned by the device, no buffer
+ *         has been handed over then.
+ * @retval -ENOTSUP if the d-cache can not be managed.
+ */
+int sys_dma_buf_to_device(struct sys_dma_buf *bufs, size_t cnt);
+
+/**
+ * @brief Hand DMA buffers back to the CPU
+ *
+ * Invalidates the cache lines of all buffers, and waits for completion
+ * once. Must be called after the device has finished accessing the
+ * buffers.
+ *
+ * @param bufs Array of DMA buffers, e.g. a scatter list.
+ * @param cnt  Number of buffers.
+ *
+ * @retval 0 on success.
+ * @retval -EBUSY if a buffer is already owned by the CPU, no buffer has
+ *         been handed back then.
+ * @retval -ENOTSUP if the d-cache can not be managed.
+ */
+int sys_dma_buf_to_cpu(struct sys_dma_buf *bufs, size_t cnt);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_DMA_BUF_H_ */
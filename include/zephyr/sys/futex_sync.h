@@ -0,0 +1,335 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief Futex-based user mode synchronization primitives.
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_FUTEX_SYNC_H_
+#define ZEPHYR_INCLUDE_SYS_FUTEX_SYNC_H_
+
+/*
+ * These primitives live in user memory and are built on k_futex, like
+ * sys_sem: their uncontended paths are atomic operations only, the kernel is
+ * only entered to wait or to wake waiters up.
+ *
+ * As every k_futex, they must be known to the kernel: define them statically
+ * with the SYS_*_DEFINE() macros, routing them to memory domains using
+ * K_APP_DMEM(), or allocate them at runtime with k_object_alloc() when
+ * dynamic objects are enabled.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup futex_sync_apis User mode futex synchronization APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/**
+ * sys_fmutex structure
+ */
+struct sys_fmutex {
+	/* 0: unlocked, 1: locked, 2: locked with waiters */
+	struct k_futex futex;
+	k_tid_t owner;
+	uint32_t lock_count;
+};
+
+/**
+ * sys_rwlock structure
+ */
+struct sys_rwlock {
+	/* Number of readers, plus writer and waiters flags */
+	struct k_futex futex;
+};
+
+/**
+ * sys_condvar structure
+ */
+struct sys_condvar {
+	/* Sequence number, bumped on each signal */
+	struct k_futex futex;
+	atomic_t waiters;
+};
+
+/**
+ * sys_barrier structure
+ */
+struct sys_barrier {
+	/* Generation number, bumped each time the barrier opens */
+	struct k_futex futex;
+	atomic_t count;
+	unsigned int parties;
+};
+
+/**
+ * sys_once structure
+ */
+struct sys_once {
+	/* 0: not run, 1: running, 2: running with waiters, 3: done */
+	struct k_futex futex;
+};
+
+/**
+ * @brief Statically define and initialize a sys_fmutex
+ *
+ * @param _name Name of the mutex.
+ */
+#define SYS_FMUTEX_DEFINE(_name) \
+	struct sys_fmutex _name = { 0 }
+
+/**
+ * @brief Statically define and initialize a sys_rwlock
+ *
+ * @param _name Name of the read/write lock.
+ */
+#define SYS_RWLOCK_DEFINE(_name) \
+	struct sys_rwlock _name = { 0 }
+
+/**
+ * @brief Statically define and initialize a sys_condvar
+ *
+ * @param _name Name of the condition variable.
+ */
+#define SYS_CONDVAR_DEFINE(_name) \
+	struct sys_condvar _name = { 0 }
+
+/**
+ * @brief Statically define and initialize a sys_barrier
+ *
+ * @param _name Name of the barrier.
+ * @param _parties Number of threads to wait for.
+ */
+#define SYS_BARRIER_DEFINE(_name, _parties) \
+	struct sys_barrier _name = { \
+		.parties = _parties \
+	}; \
+	BUILD_ASSERT((_parties) != 0)
+
+/**
+ * @brief Statically define and initialize a sys_once
+ *
+ * @param _name Name of the once control.
+ */
+#define SYS_ONCE_DEFINE(_name) \
+	struct sys_once _name = { 0 }
+
+/**
+ * @brief Initialize a mutex.
+ *
+ * Upon completion, the mutex is available and does not have an owner.
+ *
+ * @param mutex Address of the mutex.
+ */
+void sys_fmutex_init(struct sys_fmutex *mutex);
+
+/**
+ * @brief Lock a mutex.
+ *
+ * Behaves like sys_mutex_lock(), recursive locking included, except that
+ * there is no priority inheritance. Locking an available mutex does not
+ * enter the kernel. On SMP, a contended lock spins for a while before
+ * waiting, see @kconfig{CONFIG_SYS_FUTEX_SYNC_SPIN_COUNT}.
+ *
+ * The owner is identified with k_current_get(), enable
+ * @kconfig{CONFIG_THREAD_LOCAL_STORAGE} for it not to be a system call.
+ *
+ * @param mutex Address of the mutex.
+ * @param timeout Waiting period to lock the mutex,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Mutex locked.
+ * @retval -EBUSY Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EINVAL Mutex not recognized by the kernel.
+ */
+int sys_fmutex_lock(struct sys_fmutex *mutex, k_timeout_t timeout);
+
+/**
+ * @brief Unlock a mutex.
+ *
+ * Only enters the kernel if threads are waiting for the mutex.
+ *
+ * @param mutex Address of the mutex.
+ *
+ * @retval 0 Mutex unlocked.
+ * @retval -EINVAL Mutex wasn't locked.
+ * @retval -EPERM Caller does not own the mutex.
+ */
+int sys_fmutex_unlock(struct sys_fmutex *mutex);
+
+/**
+ * @brief Initialize a read/write lock.
+ *
+ * @param rwlock Address of the read/write lock.
+ */
+void sys_rwlock_init(struct sys_rwlock *rwlock);
+
+/**
+ * @brief Lock a read/write lock for reading.
+ *
+ * Any number of readers can hold the lock at the same time. Readers wait
+ * while a writer holds the lock, or while threads are waiting for it, so
+ * that writers are not starved.
+ *
+ * @param rwlock Address of the read/write lock.
+ * @param timeout Waiting period to lock the lock,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Lock held for reading.
+ * @retval -EBUSY Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EINVAL Lock not recognized by the kernel.
+ */
+int sys_rwlock_read_lock(struct sys_rwlock *rwlock, k_timeout_t timeout);
+
+/**
+ * @brief Unlock a read/write lock held for reading.
+ *
+ * @param rwlock Address of the read/write lock.
+ *
+ * @retval 0 Lock released.
+ * @retval -EINVAL Lock wasn't held for reading.
+ */
+int sys_rwlock_read_unlock(struct sys_rwlock *rwlock);
+
+/**
+ * @brief Lock a read/write lock for writing.
+ *
+ * @param rwlock Address of the read/write lock.
+ * @param timeout Waiting period to lock the lock,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Lock held for writing.
+ * @retval -EBUSY Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EINVAL Lock not recognized by the kernel.
+ */
+int sys_rwlock_write_lock(struct sys_rwlock *rwlock, k_timeout_t timeout);
+
+/**
+ * @brief Unlock a read/write lock held for writing.
+ *
+ * @param rwlock Address of the read/write lock.
+ *
+ * @retval 0 Lock released.
+ * @retval -EINVAL Lock wasn't held for writing.
+ */
+int sys_rwlock_write_unlock(struct sys_rwlock *rwlock);
+
+/**
+ * @brief Initialize a condition variable.
+ *
+ * @param condvar Address of the condition variable.
+ */
+void sys_condvar_init(struct sys_condvar *condvar);
+
+/**
+ * @brief Signal a thread waiting on a condition variable.
+ *
+ * Only enters the kernel if threads are waiting.
+ *
+ * @param condvar Address of the condition variable.
+ *
+ * @retval 0 Success.
+ */
+int sys_condvar_signal(struct sys_condvar *condvar);
+
+/**
+ * @brief Wake up all threads waiting on a condition variable.
+ *
+ * Only enters the kernel if threads are waiting.
+ *
+ * @param condvar Address of the condition variable.
+ *
+ * @retval 0 Success.
+ */
+int sys_condvar_broadcast(struct sys_condvar *condvar);
+
+/**
+ * @brief Wait on a condition variable.
+ *
+ * Atomically releases @a mutex, which must be held by the caller, and waits
+ * for the condition variable to be signaled. The mutex is locked again, with
+ * the same lock count, before returning whatever the outcome. As with any
+ * condition variable, spurious wake ups are possible and the caller has to
+ * check its condition again.
+ *
+ * @param condvar Address of the condition variable.
+ * @param mutex Address of the mutex.
+ * @param timeout Waiting period for the condition variable,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Woken up.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EPERM Caller does not own the mutex.
+ * @retval -EINVAL Condition variable not recognized by the kernel.
+ */
+int sys_condvar_wait(struct sys_condvar *condvar, struct sys_fmutex *mutex,
+		     k_timeout_t timeout);
+
+/**
+ * @brief Initialize a barrier.
+ *
+ * @param barrier Address of the barrier.
+ * @param parties Number of threads to wait for, not zero.
+ *
+ * @retval 0 Success.
+ * @retval -EINVAL Invalid number of threads.
+ */
+int sys_barrier_init(struct sys_barrier *barrier, unsigned int parties);
+
+/**
+ * @brief Wait on a barrier.
+ *
+ * Waits until the number of threads the barrier was initialized with have
+ * called this routine. The barrier is then reset for its next use.
+ *
+ * @param barrier Address of the barrier.
+ *
+ * @retval 1 Caller was the last thread to reach the barrier.
+ * @retval 0 Caller was woken up by the last thread.
+ * @retval -EINVAL Barrier not recognized by the kernel.
+ */
+int sys_barrier_wait(struct sys_barrier *barrier);
+
+/**
+ * @brief Initialize a once control.
+ *
+ * @param once Address of the once control.
+ */
+void sys_once_init(struct sys_once *once);
+
+/**
+ * @brief Call a routine once.
+ *
+ * The first caller runs @a fn, the others wait for it to complete. Once
+ * done, this routine returns without entering the kernel.
+ *
+ * @param once Address of the once control.
+ * @param fn Routine to call.
+ */
+void sys_once(struct sys_once *once, void (*fn)(void));
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_FUTEX_SYNC_H_ */
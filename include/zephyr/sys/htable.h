@@ -0,0 +1,281 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Hash table data structure
+ *
+ * This implements an intrusive chained hash table. The struct
+ * sys_htable_node handle is placed in the user structure the same way
+ * as a sys_dnode_t, and the table itself never allocates memory: the
+ * bucket array is provided by the user. The hash of each node is
+ * computed by the user when inserting it and is stored in the node, so
+ * lookups only call the comparison function on nodes with a matching
+ * hash, and the table can be moved to a larger bucket array with
+ * sys_htable_rehash() without hashing the keys again.
+ *
+ * Lookups, insertions and removals run in O(1) on average as long as
+ * the number of nodes stays in the order of the number of buckets.
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_HTABLE_H_
+#define ZEPHYR_INCLUDE_SYS_HTABLE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/sys/__assert.h>
+#include <zephyr/sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup htable_apis Hash Table
+ * @ingroup datastructure_apis
+ * @{
+ */
+
+/** @brief Hash table node, to be embedded in the user structure */
+struct sys_htable_node {
+	struct sys_htable_node *next;
+	uint32_t hash;
+};
+
+/** @brief Hash table */
+struct sys_htable {
+	struct sys_htable_node **buckets;
+	/* Number of buckets minus one, the number is a power of two */
+	uint32_t mask;
+	size_t size;
+};
+
+/**
+ * @typedef sys_htable_eq_t
+ * @brief Hash table key comparison predicate
+ *
+ * Returns true if the node matches the key passed to sys_htable_find().
+ */
+typedef bool (*sys_htable_eq_t)(const struct sys_htable_node *node,
+				const void *key);
+
+/**
+ * @brief Statically initialize a hash table
+ *
+ * @param bucket_array Array of pointers to struct sys_htable_node. Its
+ *	  number of elements must be a power of two.
+ */
+#define SYS_HTABLE_INIT(bucket_array)						\
+	{									\
+		.buckets = (bucket_array),					\
+		.mask = ARRAY_SIZE(bucket_array) - 1,				\
+		.size = 0,							\
+	}
+
+/**
+ * @brief Define a hash table and its buckets
+ *
+ * @param name Name of the hash table.
+ * @param n_buckets Number of buckets, must be a power of two.
+ */
+#define SYS_HTABLE_DEFINE(name, n_buckets)					\
+	BUILD_ASSERT(((n_buckets) & ((n_buckets) - 1)) == 0,			\
+		     "number of buckets must be a power of two");		\
+	static struct sys_htable_node *_CONCAT(name, _buckets)[n_buckets];	\
+	struct sys_htable name = SYS_HTABLE_INIT(_CONCAT(name, _buckets))
+
+/**
+ * @brief Initialize a hash table
+ *
+ * @param ht Hash table.
+ * @param buckets Bucket array, its content is overwritten.
+ * @param n_buckets Number of buckets, must be a power of two.
+ */
+static inline void sys_htable_init(struct sys_htable *ht,
+				   struct sys_htable_node **buckets,
+				   size_t n_buckets)
+{
+	__ASSERT(is_power_of_two(n_buckets),
+		 "number of buckets must be a power of two");
+
+	for (size_t i = 0; i < n_buckets; i++) {
+		buckets[i] = NULL;
+	}
+
+	ht->buckets = buckets;
+	ht->mask = n_buckets - 1;
+	ht->size = 0;
+}
+
+/**
+ * @brief Get the number of nodes in a hash table
+ */
+static inline size_t sys_htable_size(const struct sys_htable *ht)
+{
+	return ht->size;
+}
+
+/**
+ * @brief Insert a node into a hash table
+ *
+ * Nodes with equal keys may be inserted, sys_htable_find() returns the
+ * most recently inserted one.
+ *
+ * @param ht Hash table.
+ * @param node Node to insert, must not be in a table.
+ * @param hash Hash of the node key.
+ */
+static inline void sys_htable_insert(struct sys_htable *ht,
+				     struct sys_htable_node *node,
+				     uint32_t hash)
+{
+	struct sys_htable_node **bucket = &ht->buckets[hash & ht->mask];
+
+	node->hash = hash;
+	node->next = *bucket;
+	*bucket = node;
+	ht->size++;
+}
+
+/**
+ * @brief Remove a node from a hash table
+ *
+ * @param ht Hash table.
+ * @param node Node to remove.
+ *
+ * @return true if the node was removed, false if it was not in the table.
+ */
+static inline bool sys_htable_remove(struct sys_htable *ht,
+				     struct sys_htable_node *node)
+{
+	struct sys_htable_node **link = &ht->buckets[node->hash & ht->mask];
+
+	for (; *link != NULL; link = &(*link)->next) {
+		if (*link == node) {
+			*link = node->next;
+			node->next = NULL;
+			ht->size--;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * @brief Find a node in a hash table
+ *
+ * @param ht Hash table.
+ * @param hash Hash of the key.
+ * @param key Key, passed to @p eq.
+ * @param eq Comparison predicate, only called on nodes with the same hash.
+ *
+ * @return Matching node, or NULL if none is found.
+ */
+static inline struct sys_htable_node *sys_htable_find(const struct sys_htable *ht,
+						      uint32_t hash,
+						      const void *key,
+						      sys_htable_eq_t eq)
+{
+	struct sys_htable_node *node;
+
+	for (node = ht->buckets[hash & ht->mask]; node != NULL;
+	     node = node->next) {
+		if (node->hash == hash && eq(node, key)) {
+			return node;
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Move a hash table to a new bucket array
+ *
+ * This allows growing or shrinking a table, without hashing the keys
+ * again. The old bucket array is not used anymore once this returns.
+ *
+ * @param ht Hash table.
+ * @param buckets New bucket array, its content is overwritten.
+ * @param n_buckets Number of new buckets, must be a power of two.
+ */
+static inline void sys_htable_rehash(struct sys_htable *ht,
+				     struct sys_htable_node **buckets,
+				     size_t n_buckets)
+{
+	struct sys_htable_node **old = ht->buckets;
+	uint32_t old_mask = ht->mask;
+	size_t size = ht->size;
+
+	sys_htable_init(ht, buckets, n_buckets);
+
+	for (uint32_t i = 0; i <= old_mask; i++) {
+		struct sys_htable_node *node = old[i];
+
+		while (node != NULL) {
+			struct sys_htable_node *next = node->next;
+
+			sys_htable_insert(ht, node, node->hash);
+			node = next;
+		}
+	}
+
+	__ASSERT_NO_MSG(ht->size == size);
+	ARG_UNUSED(size);
+}
+
+/**
+ * @brief Compute the 32-bit FNV-1a hash of a buffer
+ *
+ * A small and fast hash suitable for short keys such as addresses or
+ * names. Hashes of several buffers can be chained by passing the result
+ * as @p hash, starting with SYS_HTABLE_HASH_INIT.
+ *
+ * @param hash Hash computed so far.
+ * @param data Buffer to hash.
+ * @param len Length of the buffer, in bytes.
+ *
+ * @return Updated hash.
+ */
+static inline uint32_t sys_htable_hash(uint32_t hash, const void *data,
+				       size_t len)
+{
+	const uint8_t *p = data;
+
+	for (size_t i = 0; i < len; i++) {
+		hash = (hash ^ p[i]) * 16777619U;
+	}
+
+	return hash;
+}
+
+/** Initial value of a hash computed with sys_htable_hash() */
+#define SYS_HTABLE_HASH_INIT 2166136261U
+
+/**
+ * @brief Iterate over the nodes of a hash table
+ *
+ * Nodes are visited in no particular order. The table must not be
+ * modified during the iteration.
+ *
+ * @param ht Hash table.
+ * @param idx Bucket index variable, of type uint32_t.
+ * @param node Node variable, of type struct sys_htable_node *.
+ */
+#define SYS_HTABLE_FOR_EACH(ht, idx, node)					\
+	for ((idx) = 0; (idx) <= (ht)->mask; (idx)++)				\
+		for ((node) = (ht)->buckets[idx]; (node) != NULL;		\
+		     (node) = (node)->next)
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_HTABLE_H_ */
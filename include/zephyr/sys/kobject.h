@@ -6,6 +6,7 @@
 #ifndef ZEPHYR_INCLUDE_SYS_KOBJECT_H
 #define ZEPHYR_INCLUDE_SYS_KOBJECT_H
 
+#include <errno.h>
 #include <stdint.h>
 #include <stddef.h>
 
@@ -45,6 +46,16 @@ enum k_objects {
  * @{
  */
 
+/** @brief System call request, see k_syscall_batch() */
+struct k_syscall_req {
+	/** System call ID, one of the K_SYSCALL_* values of syscall_list.h */
+	uintptr_t id;
+	/** Arguments, as passed by the user mode stub of the call */
+	uintptr_t args[6];
+	/** Return value, set by k_syscall_batch() */
+	uintptr_t ret;
+};
+
 #ifdef CONFIG_USERSPACE
 #ifdef CONFIG_GEN_PRIV_STACKS
 /* Metadata struct for K_OBJ_THREAD_STACK_ELEMENT */
@@ -190,6 +201,29 @@ __syscall void k_object_release(const void *object);
  */
 void k_object_access_all_grant(const void *object);
 
+/**
+ * @brief Make several system calls at once
+ *
+ * Runs the system calls of an array of requests in order, with a single
+ * privilege elevation. Each call is verified as if it had been made on
+ * its own, and a call failing its verification triggers a kernel oops
+ * as usual. The arguments of each request are the raw values the user
+ * mode stub of the call would pass, including a pointer to the 64-bit
+ * return value or to the extra arguments of calls which use one.
+ *
+ * This is meant for user threads making many short calls at a high rate.
+ * It requires CONFIG_SYSCALL_BATCH; supervisor threads are expected to
+ * call the functions directly.
+ *
+ * @param reqs Array of requests, the return value of each call is
+ *             written back to it.
+ * @param count Number of requests.
+ *
+ * @retval 0 on success.
+ * @retval -ENOTSUP if called from supervisor mode.
+ */
+__syscall int k_syscall_batch(struct k_syscall_req *reqs, size_t count);
+
 #else
 /* LCOV_EXCL_START */
 #define K_THREAD_ACCESS_GRANT(thread, ...)
@@ -234,6 +268,18 @@ static inline void k_object_access_all_grant(const void *object)
 {
 	ARG_UNUSED(object);
 }
+
+/**
+ * @internal
+ */
+static inline int z_impl_k_syscall_batch(struct k_syscall_req *reqs,
+					 size_t count)
+{
+	ARG_UNUSED(reqs);
+	ARG_UNUSED(count);
+
+	return -ENOTSUP;
+}
 /* LCOV_EXCL_STOP */
 #endif /* !CONFIG_USERSPACE */
 
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Lock-free multi-producer multi-consumer queue
+ *
+ * This implements a bounded FIFO of pointers following D. Vyukov's
+ * design: each cell of a power-of-two array carries a sequence number
+ * telling producers and consumers whose turn it is, so concurrent
+ * threads, CPUs and ISRs only contend on a compare-and-swap of the head
+ * or tail index and never take a lock.
+ *
+ * sys_mpmc_queue_try_put() and sys_mpmc_queue_try_get() never block and
+ * may be called from any context. sys_mpmc_queue_put() and
+ * sys_mpmc_queue_get() add blocking on an empty queue on top of them:
+ * consumers register as waiters before sleeping on a semaphore, and
+ * producers only give the semaphore, and so only enter the scheduler,
+ * when a consumer is waiting. Unlike k_fifo, the uncontended hand-off of
+ * an item never takes the scheduler lock.
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_MPMC_QUEUE_H_
+#define ZEPHYR_INCLUDE_SYS_MPMC_QUEUE_H_
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup mpmc_queue_apis Lock-free MPMC Queue
+ * @ingroup datastructure_apis
+ * @{
+ */
+
+/** @brief Queue cell, the content is private */
+struct sys_mpmc_cell {
+	/* Sequence number, minus the index of the cell so that a zeroed
+	 * array is a valid empty queue.
+	 */
+	atomic_t seq;
+	void *data;
+};
+
+/** @brief Lock-free MPMC queue */
+struct sys_mpmc_queue {
+	struct sys_mpmc_cell *cells;
+	/* Number of cells minus one, the number is a power of two */
+	uint32_t mask;
+	atomic_t head;
+	atomic_t tail;
+	atomic_t waiters;
+	struct k_sem sem;
+};
+
+/**
+ * @brief Statically define and initialize a queue
+ *
+ * @param name Name of the queue.
+ * @param n_cells Capacity of the queue, must be a power of two.
+ */
+#define SYS_MPMC_QUEUE_DEFINE(name, n_cells)					\
+	BUILD_ASSERT((n_cells) > 1 && ((n_cells) & ((n_cells) - 1)) == 0,	\
+		     "capacity must be a power of two");			\
+	static struct sys_mpmc_cell _CONCAT(name, _cells)[n_cells];		\
+	struct sys_mpmc_queue name = {						\
+		.cells = _CONCAT(name, _cells),					\
+		.mask = (n_cells) - 1,						\
+		.sem = Z_SEM_INITIALIZER(name.sem, 0, K_SEM_MAX_LIMIT),	\
+	}
+
+/**
+ * @brief Initialize a queue
+ *
+ * @param queue Queue.
+ * @param cells Cell array, its content is overwritten.
+ * @param n_cells Number of cells, must be a power of two.
+ */
+void sys_mpmc_queue_init(struct sys_mpmc_queue *queue,
+			 struct sys_mpmc_cell *cells, size_t n_cells);
+
+/**
+ * @brief Append an item to a queue without waking up consumers
+ *
+ * This is lock-free and may be called from any context. Consumers
+ * blocked in sys_mpmc_queue_get() are not woken up, use
+ * sys_mpmc_queue_put() when there may be some.
+ *
+ * @param queue Queue.
+ * @param data Item.
+ *
+ * @retval 0 on success.
+ * @retval -ENOBUFS if the queue is full.
+ */
+int sys_mpmc_queue_try_put(struct sys_mpmc_queue *queue, void *data);
+
+/**
+ * @brief Take the oldest item of a queue without waiting
+ *
+ * This is lock-free and may be called from any context.
+ *
+ * @param queue Queue.
+ * @param data Taken item.
+ *
+ * @retval 0 on success.
+ * @retval -EAGAIN if the queue is empty.
+ */
+int sys_mpmc_queue_try_get(struct sys_mpmc_queue *queue, void **data);
+
+/**
+ * @brief Append an item to a queue
+ *
+ * Wakes up a consumer blocked in sys_mpmc_queue_get(), only entering
+ * the scheduler if there is one. May be called from an ISR.
+ *
+ * @param queue Queue.
+ * @param data Item.
+ *
+ * @retval 0 on success.
+ * @retval -ENOBUFS if the queue is full.
+ */
+int sys_mpmc_queue_put(struct sys_mpmc_queue *queue, void *data);
+
+/**
+ * @brief Take the oldest item of a queue
+ *
+ * @param queue Queue.
+ * @param data Taken item.
+ * @param timeout Waiting period for an item,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 on success.
+ * @retval -EAGAIN if the queue is empty and the waiting period timed out.
+ */
+int sys_mpmc_queue_get(struct sys_mpmc_queue *queue, void **data,
+		       k_timeout_t timeout);
+
+/**
+ * @brief Check whether a queue is empty
+ *
+ * The result is only a snapshot when other threads use the queue.
+ */
+static inline bool sys_mpmc_queue_is_empty(struct sys_mpmc_queue *queue)
+{
+	return atomic_get(&queue->head) == atomic_get(&queue->tail);
+}
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_MPMC_QUEUE_H_ */
@@ -44,10 +44,14 @@
 #define ZEPHYR_INCLUDE_SYS_RB_H_
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 struct rbnode {
 	struct rbnode *children[2];
+#ifdef CONFIG_RBTREE_PARENT_POINTERS
+	struct rbnode *parent;
+#endif
 };
 
 /* Theoretical maximum depth of tree based on pointer size. If memory
@@ -125,6 +129,53 @@ static inline struct rbnode *rb_get_max(struct rbtree *tree)
 	return z_rb_get_minmax(tree, 1U);
 }
 
+/**
+ * @brief Build a tree from sorted nodes
+ *
+ * Replaces the content of the tree with the given nodes, which must
+ * be sorted in ascending order according to the tree's lessthan
+ * predicate.  This runs in O(N) and calls neither the predicate nor
+ * any rebalancing, so it is much faster than inserting the nodes one
+ * by one.  The resulting tree is perfectly balanced.
+ *
+ * @param tree Tree, its current nodes are dropped
+ * @param nodes Array of pointers to the nodes, in ascending order
+ * @param count Number of nodes in the array
+ */
+void rb_build(struct rbtree *tree, struct rbnode **nodes, size_t count);
+
+#if defined(CONFIG_RBTREE_PARENT_POINTERS) || defined(__DOXYGEN__)
+struct rbnode *z_rb_next(struct rbnode *node, uint8_t side);
+
+/**
+ * @brief Returns the node sorted right after the given one
+ *
+ * Runs in O(1) amortized time over a whole traversal.  Only available
+ * with CONFIG_RBTREE_PARENT_POINTERS.
+ *
+ * @param node A node in the tree
+ * @return The next node, or NULL if node is the highest-sorted one
+ */
+static inline struct rbnode *rb_next(struct rbnode *node)
+{
+	return z_rb_next(node, 1U);
+}
+
+/**
+ * @brief Returns the node sorted right before the given one
+ *
+ * Runs in O(1) amortized time over a whole traversal.  Only available
+ * with CONFIG_RBTREE_PARENT_POINTERS.
+ *
+ * @param node A node in the tree
+ * @return The previous node, or NULL if node is the lowest-sorted one
+ */
+static inline struct rbnode *rb_prev(struct rbnode *node)
+{
+	return z_rb_next(node, 0U);
+}
+#endif
+
 /**
  * @brief Returns true if the given node is part of the tree
  *
@@ -153,12 +204,22 @@ static inline void rb_walk(struct rbtree *tree, rb_visit_t visit_fn,
 #endif
 
 struct _rb_foreach {
+#ifdef CONFIG_RBTREE_PARENT_POINTERS
+	struct rbnode *current;
+#else
 	struct rbnode **stack;
 	uint8_t *is_left;
+#endif
 	int32_t top;
 };
 
-#ifdef CONFIG_MISRA_SANE
+#if defined(CONFIG_RBTREE_PARENT_POINTERS)
+/* Parent pointers let the iteration walk back up without a stack */
+#define _RB_FOREACH_INIT(tree, node) {					\
+	.current = NULL,						\
+	.top     = -1							\
+}
+#elif defined(CONFIG_MISRA_SANE)
 #define _RB_FOREACH_INIT(tree, node) {					\
 	.stack   = &(tree)->iter_stack[0],				\
 	.is_left = &(tree)->iter_left[0],				\
@@ -184,6 +245,9 @@ struct rbnode *z_rb_foreach_next(struct rbtree *tree, struct _rb_foreach *f);
  * non-recursive "foreach" loop that can iterate directly on the tree,
  * at a moderate cost in code size.
  *
+ * With CONFIG_RBTREE_PARENT_POINTERS the loop needs no stack and follows
+ * the parent pointers instead, see rb_next().
+ *
  * Note that the resulting loop is not safe against modifications to
  * the tree.  Changes to the tree structure during the loop will
  * produce incorrect results, as nodes may be skipped or duplicated.
@@ -91,6 +91,79 @@ int sys_heap_runtime_stats_reset_max(struct sys_heap *heap);
 
 #endif
 
+#ifdef CONFIG_SYS_HEAP_PROFILE
+
+/** Number of power-of-two bins in sys_heap profiling histograms */
+#define SYS_HEAP_PROFILE_BINS 16
+
+/** @brief Live allocations accounted to one call site */
+struct sys_heap_profile_site {
+	/** Return address of the sys_heap call that allocated */
+	uintptr_t site;
+	/** Bytes held by live allocations from this site */
+	size_t live_bytes;
+	/** Number of live allocations from this site */
+	uint32_t live_count;
+};
+
+/**
+ * @brief sys_heap profiling data
+ *
+ * Bin @a i of each histogram counts values in [2^i, 2^(i+1)), the
+ * first bin also counts zero and the last one everything above.
+ */
+struct sys_heap_profile {
+	/** Requested allocation sizes, in bytes */
+	uint32_t size_hist[SYS_HEAP_PROFILE_BINS];
+	/** Allocation durations, in cycles */
+	uint32_t alloc_cycles_hist[SYS_HEAP_PROFILE_BINS];
+	/** Free durations, in cycles */
+	uint32_t free_cycles_hist[SYS_HEAP_PROFILE_BINS];
+	/** Allocations that returned NULL */
+	uint32_t failed_allocs;
+	/** Live bytes from call sites that didn't fit in @a sites */
+	size_t other_live_bytes;
+	/** Live allocations per call site */
+	struct sys_heap_profile_site sites[CONFIG_SYS_HEAP_PROFILE_SITES];
+	/** Free bytes, computed by sys_heap_profile_get() */
+	size_t free_bytes;
+	/** Largest free block, computed by sys_heap_profile_get() */
+	size_t largest_free_bytes;
+	/**
+	 * Fragmentation in per mille: the share of free memory that is
+	 * not part of the largest free block.  Computed by
+	 * sys_heap_profile_get().
+	 */
+	uint32_t fragmentation;
+};
+
+/**
+ * @brief Get the profiling data of a sys_heap
+ *
+ * Copies the histograms and per call site counters and computes the
+ * free space and fragmentation by walking the free lists, so this
+ * takes time linear in the number of free blocks.
+ *
+ * @param heap Pointer to specified sys_heap
+ * @param profile Pointer to struct to copy the data into
+ * @return -EINVAL if null pointers, otherwise 0
+ */
+int sys_heap_profile_get(struct sys_heap *heap,
+			 struct sys_heap_profile *profile);
+
+/**
+ * @brief Reset the profiling histograms of a sys_heap
+ *
+ * Clears the histograms and the failed allocation count.  Per call
+ * site counters track live allocations and are left alone.
+ *
+ * @param heap Pointer to sys_heap
+ * @return -EINVAL if null pointer was passed, otherwise 0
+ */
+int sys_heap_profile_reset(struct sys_heap *heap);
+
+#endif
+
 /** @brief Initialize sys_heap
  *
  * Initializes a sys_heap struct to manage the specified memory.
@@ -445,11 +445,59 @@ static inline int z_obj_validation_check(struct z_object *ko,
 	return ret;
 }
 
+#ifdef CONFIG_OBJ_VALIDATION_CACHE
+/**
+ * Check whether the current thread recently validated an initialized
+ * kernel object of a given type
+ *
+ * @param obj Address of the kernel object
+ * @param otype Expected type of the object, or K_OBJ_ANY
+ * @return true if the object is in the validation cache of the thread
+ */
+bool z_object_cache_hit(const void *obj, enum k_objects otype);
+
+/**
+ * Add an initialized kernel object the current thread successfully
+ * validated to its validation cache
+ *
+ * @param obj Address of the kernel object
+ * @param ko Kernel object metadata
+ */
+void z_object_cache_add(const void *obj, struct z_object *ko);
+#endif
+
+static inline int z_obj_validation_lookup(const void *obj,
+					  enum k_objects otype,
+					  enum _obj_init_check init)
+{
+	struct z_object *ko;
+	int ret;
+
+#ifdef CONFIG_OBJ_VALIDATION_CACHE
+	/* Only objects which must be initialized are cached, the other
+	 * checks are done by init functions which are not hot paths.
+	 */
+	if (init == _OBJ_INIT_TRUE && z_object_cache_hit(obj, otype)) {
+		return 0;
+	}
+#endif
+
+	ko = z_object_find(obj);
+	ret = z_obj_validation_check(ko, obj, otype, init);
+
+#ifdef CONFIG_OBJ_VALIDATION_CACHE
+	if (ret == 0 && init == _OBJ_INIT_TRUE) {
+		z_object_cache_add(obj, ko);
+	}
+#endif
+
+	return ret;
+}
+
 #define Z_SYSCALL_IS_OBJ(ptr, type, init) \
-	Z_SYSCALL_VERIFY_MSG(z_obj_validation_check(			\
-				     z_object_find((const void *)ptr),	\
-				     (const void *)ptr,			\
-				     type, init) == 0, "access denied")
+	Z_SYSCALL_VERIFY_MSG(z_obj_validation_lookup((const void *)ptr,	\
+						     type, init) == 0,	\
+			     "access denied")
 
 /**
  * @brief Runtime check driver object pointer for presence of operation
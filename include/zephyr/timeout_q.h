@@ -22,9 +22,19 @@ extern "C" {
 
 #ifdef CONFIG_SYS_CLOCK_EXISTS
 
+#ifdef CONFIG_TIMEOUT_BATCH_EXPIRY
+/* dticks of a timeout unlinked by sys_clock_announce() whose handler
+ * has not been called yet
+ */
+#define Z_TIMEOUT_EXPIRED_DTICKS (-1)
+#endif
+
 static inline void z_init_timeout(struct _timeout *to)
 {
 	sys_dnode_init(&to->node);
+#ifdef CONFIG_TIMEOUT_BATCH_EXPIRY
+	to->dticks = 0;
+#endif
 }
 
 void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
@@ -34,6 +44,11 @@ int z_abort_timeout(struct _timeout *to);
 
 static inline bool z_is_inactive_timeout(const struct _timeout *to)
 {
+#ifdef CONFIG_TIMEOUT_BATCH_EXPIRY
+	if (to->dticks == Z_TIMEOUT_EXPIRED_DTICKS) {
+		return false;
+	}
+#endif
 	return !sys_dnode_is_linked(&to->node);
 }
 
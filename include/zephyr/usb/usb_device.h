@@ -356,6 +356,7 @@ typedef void (*usb_transfer_callback)(uint8_t ep, int tsize, void *priv);
 #define USB_TRANS_READ       BIT(0)   /** Read transfer flag */
 #define USB_TRANS_WRITE      BIT(1)   /** Write transfer flag */
 #define USB_TRANS_NO_ZLP     BIT(2)   /** No zero-length packet flag */
+#define USB_TRANS_QUEUE      BIT(3)   /** Queue behind ongoing transfers flag */
 
 /**
  * @brief Transfer management endpoint callback
@@ -372,6 +373,11 @@ void usb_transfer_ep_callback(uint8_t ep, enum usb_dc_ep_cb_status_code);
  * and can be executed in IRQ context. The provided callback will be called
  * on transfer completion (or error) in thread context.
  *
+ * With USB_TRANS_QUEUE, a transfer to an endpoint which is busy does not fail
+ * but is started as soon as the transfers submitted before it complete, ahead
+ * of their completion callbacks. Each queued transfer takes one of the
+ * CONFIG_USB_MAX_NUM_TRANSFERS slots.
+ *
  * @param[in]  ep           Endpoint address corresponding to the one
  *                          listed in the device configuration table
  * @param[in]  data         Pointer to data buffer to write-to/read-from
@@ -6,6 +6,7 @@
 
 #include <string.h>
 #include <zephyr/device.h>
+#include <zephyr/kernel.h>
 #include <zephyr/sys/atomic.h>
 #include <zephyr/syscall_handler.h>
 
@@ -40,6 +41,190 @@ void z_device_state_init(void)
 	}
 }
 
+#ifdef CONFIG_DEVICE_LAZY_INIT
+static int lazy_init_visitor(const struct device *dev, void *context)
+{
+	ARG_UNUSED(context);
+
+	(void)z_device_is_ready(dev);
+
+	return 0;
+}
+#endif
+
+/**
+ * @brief Run the initialization function of an init entry
+ *
+ * Lazily initialized devices required by the device are initialized
+ * first, as it needs them now.
+ *
+ * @param entry init entry to run.
+ */
+static void init_entry_run(const struct init_entry *entry)
+{
+	const struct device *dev = entry->dev;
+	int rc;
+
+#ifdef CONFIG_DEVICE_LAZY_INIT
+	if (dev != NULL) {
+		(void)device_required_foreach(dev, lazy_init_visitor, NULL);
+	}
+#endif
+
+	rc = entry->init(dev);
+
+	if (dev != NULL) {
+		/* Mark device initialized.  If initialization
+		 * failed, record the error condition.
+		 */
+		if (rc != 0) {
+			if (rc < 0) {
+				rc = -rc;
+			}
+			if (rc > UINT8_MAX) {
+				rc = UINT8_MAX;
+			}
+			dev->state->init_res = rc;
+		}
+		dev->state->initialized = true;
+	}
+}
+
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+#define INIT_THREADS CONFIG_DEVICE_INIT_PARALLEL_THREADS
+
+static K_THREAD_STACK_ARRAY_DEFINE(init_stacks, INIT_THREADS,
+				   CONFIG_DEVICE_INIT_PARALLEL_STACK_SIZE);
+static struct k_thread init_threads[INIT_THREADS];
+static K_MUTEX_DEFINE(init_lock);
+static K_CONDVAR_DEFINE(init_cond);
+
+/** Device init entries being run in parallel, protected by init_lock. */
+static const struct init_entry *init_batch_start;
+static const struct init_entry *init_batch_end;
+
+static const struct init_entry *init_batch_find(const struct device *dev)
+{
+	for (const struct init_entry *entry = init_batch_start;
+	     entry < init_batch_end; entry++) {
+		if (entry->dev == dev) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Check if a device of the batch can be initialized
+ *
+ * A device can be initialized once the devices it requires are, if they
+ * belong to the same batch. Other required devices are either initialized
+ * already, or lazily.
+ */
+static bool init_entry_ready(const struct init_entry *entry)
+{
+	const device_handle_t *handles;
+	size_t count = 0;
+
+	if (entry->dev->state->init_started || entry->dev->state->lazy) {
+		return false;
+	}
+
+	handles = device_required_handles_get(entry->dev, &count);
+	for (size_t i = 0; i < count; i++) {
+		const struct device *rdev = device_from_handle(handles[i]);
+
+		if ((rdev != NULL) && !rdev->state->initialized &&
+		    !rdev->state->lazy && (init_batch_find(rdev) != NULL)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/** @brief Initialize the devices of the batch, until all of them started. */
+static void init_batch_run(void)
+{
+	(void)k_mutex_lock(&init_lock, K_FOREVER);
+
+	while (true) {
+		const struct init_entry *next = NULL;
+		bool pending = false;
+
+		for (const struct init_entry *entry = init_batch_start;
+		     entry < init_batch_end; entry++) {
+			if (!entry->dev->state->init_started && !entry->dev->state->lazy) {
+				pending = true;
+				if (init_entry_ready(entry)) {
+					next = entry;
+					break;
+				}
+			}
+		}
+
+		if (!pending) {
+			break;
+		}
+
+		if (next == NULL) {
+			/* wait for a dependency to be initialized */
+			(void)k_condvar_wait(&init_cond, &init_lock, K_FOREVER);
+			continue;
+		}
+
+		next->dev->state->init_started = true;
+		k_mutex_unlock(&init_lock);
+
+		init_entry_run(next);
+
+		(void)k_mutex_lock(&init_lock, K_FOREVER);
+		(void)k_condvar_broadcast(&init_cond);
+	}
+
+	k_mutex_unlock(&init_lock);
+}
+
+static void init_thread(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	init_batch_run();
+}
+
+/**
+ * @brief Initialize consecutive device init entries in parallel
+ *
+ * @param start first device init entry.
+ * @param end entry following the last device init entry.
+ */
+static void init_batch(const struct init_entry *start,
+		       const struct init_entry *end)
+{
+	size_t threads = MIN((size_t)(end - start) - 1U, (size_t)INIT_THREADS);
+
+	init_batch_start = start;
+	init_batch_end = end;
+
+	for (size_t i = 0; i < threads; i++) {
+		k_thread_create(&init_threads[i], init_stacks[i],
+				K_THREAD_STACK_SIZEOF(init_stacks[i]),
+				init_thread, NULL, NULL, NULL,
+				CONFIG_MAIN_THREAD_PRIORITY, 0, K_NO_WAIT);
+		k_thread_name_set(&init_threads[i], "device_init");
+	}
+
+	init_batch_run();
+
+	for (size_t i = 0; i < threads; i++) {
+		(void)k_thread_join(&init_threads[i], K_FOREVER);
+	}
+}
+#endif /* CONFIG_DEVICE_INIT_PARALLEL */
+
 /**
  * @brief Execute all the init entry initialization functions at a given level
  *
@@ -68,25 +253,63 @@ void z_sys_init_run_level(int32_t level)
 
 	for (entry = levels[level]; entry < levels[level+1]; entry++) {
 		const struct device *dev = entry->dev;
-		int rc = entry->init(dev);
-
-		if (dev != NULL) {
-			/* Mark device initialized.  If initialization
-			 * failed, record the error condition.
-			 */
-			if (rc != 0) {
-				if (rc < 0) {
-					rc = -rc;
-				}
-				if (rc > UINT8_MAX) {
-					rc = UINT8_MAX;
-				}
-				dev->state->init_res = rc;
+
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+		if ((dev != NULL) && (level >= _SYS_INIT_LEVEL_POST_KERNEL)) {
+			const struct init_entry *end = entry;
+
+			/* other init functions are ordering barriers */
+			while ((end < levels[level+1]) && (end->dev != NULL)) {
+				end++;
+			}
+
+			if ((end - entry) > 1) {
+				init_batch(entry, end);
+				entry = end - 1;
+				continue;
+			}
+		}
+#endif
+
+		if ((dev != NULL) && dev->state->lazy) {
+			continue;
+		}
+
+		init_entry_run(entry);
+	}
+}
+
+#ifdef CONFIG_DEVICE_LAZY_INIT
+static K_MUTEX_DEFINE(lazy_init_lock);
+
+/**
+ * @brief Initialize a device on first use
+ *
+ * Devices it depends on are initialized first, by init_entry_run().
+ */
+static void device_lazy_init(const struct device *dev)
+{
+	bool locked = !k_is_pre_kernel();
+
+	if (locked) {
+		(void)k_mutex_lock(&lazy_init_lock, K_FOREVER);
+	}
+
+	if (!dev->state->initialized) {
+		for (const struct init_entry *entry = __init_start;
+		     entry < __init_end; entry++) {
+			if (entry->dev == dev) {
+				init_entry_run(entry);
+				break;
 			}
-			dev->state->initialized = true;
 		}
 	}
+
+	if (locked) {
+		k_mutex_unlock(&lazy_init_lock);
+	}
 }
+#endif /* CONFIG_DEVICE_LAZY_INIT */
 
 const struct device *z_impl_device_get_binding(const char *name)
 {
@@ -105,13 +328,13 @@ const struct device *z_impl_device_get_binding(const char *name)
 	 * performed. Reserve string comparisons for a fallback.
 	 */
 	for (dev = __device_start; dev != __device_end; dev++) {
-		if (z_device_is_ready(dev) && (dev->name == name)) {
+		if ((dev->name == name) && z_device_is_ready(dev)) {
 			return dev;
 		}
 	}
 
 	for (dev = __device_start; dev != __device_end; dev++) {
-		if (z_device_is_ready(dev) && (strcmp(name, dev->name) == 0)) {
+		if ((strcmp(name, dev->name) == 0) && z_device_is_ready(dev)) {
 			return dev;
 		}
 	}
@@ -158,6 +381,12 @@ bool z_device_is_ready(const struct device *dev)
 		return false;
 	}
 
+#ifdef CONFIG_DEVICE_LAZY_INIT
+	if (!dev->state->initialized && dev->state->lazy && !k_is_in_isr()) {
+		device_lazy_init(dev);
+	}
+#endif
+
 	return dev->state->initialized && (dev->state->init_res == 0U);
 }
 
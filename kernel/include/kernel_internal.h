@@ -197,6 +197,14 @@ struct gdb_ctx;
 extern int z_gdb_main_loop(struct gdb_ctx *ctx);
 #endif
 
+#ifdef CONFIG_IRQ_LATENCY_STATS
+/* Called by the arch layer around the handler of software ISR table
+ * entry @a irq, see k_irq_latency_stats_get()
+ */
+void z_irq_latency_enter(unsigned int irq);
+void z_irq_latency_exit(unsigned int irq);
+#endif
+
 #ifdef CONFIG_INSTRUMENT_THREAD_SWITCHING
 void z_thread_mark_switched_in(void);
 void z_thread_mark_switched_out(void);
@@ -46,7 +46,7 @@ GEN_OFFSET_SYM(_kernel_t, threads);
 GEN_OFFSET_SYM(_kernel_t, idle);
 #endif
 
-#ifndef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#ifndef CONFIG_SCHED_CPU_READY_QUEUES
 GEN_OFFSET_SYM(_kernel_t, ready_q);
 #endif
 
@@ -36,6 +36,16 @@ BUILD_ASSERT(K_LOWEST_APPLICATION_THREAD_PRIO
 #define Z_ASSERT_VALID_PRIO(prio, entry_point) __ASSERT((prio) == -1, "")
 #endif
 
+#ifdef CONFIG_SMP
+/* Value of _thread_base.cpu for a thread that has never run */
+#define Z_THREAD_CPU_NONE 0xffU
+#endif
+
+#ifdef CONFIG_SCHED_CPU_RUNQ
+/* Value of _thread_base.runq_cpu for a thread with no CPU affinity yet */
+#define Z_SCHED_RUNQ_CPU_NONE 0xffU
+#endif
+
 void z_sched_init(void);
 void z_move_thread_to_end_of_prio_q(struct k_thread *thread);
 int z_is_thread_time_slicing(struct k_thread *thread);
@@ -108,7 +118,8 @@ static inline bool z_is_thread_prevented_from_running(struct k_thread *thread)
 	uint8_t state = thread->base.thread_state;
 
 	return (state & (_THREAD_PENDING | _THREAD_PRESTART | _THREAD_DEAD |
-			 _THREAD_DUMMY | _THREAD_SUSPENDED)) != 0U;
+			 _THREAD_DUMMY | _THREAD_SUSPENDED |
+			 _THREAD_THROTTLED)) != 0U;
 
 }
 
@@ -396,9 +407,28 @@ void z_sched_cpu_usage(uint8_t core_id, struct k_thread_runtime_stats *stats);
 void z_sched_thread_usage(struct k_thread *thread,
 			  struct k_thread_runtime_stats *stats);
 
+#ifdef CONFIG_THREAD_LATENCY_STATS
+/**
+ * @brief Latency accounting for thread state changes
+ *
+ * z_sched_latency_ready() is called when @a thread is made ready.
+ * z_sched_latency_stop() and z_sched_latency_start() are called with
+ * interrupts masked when @a thread is switched out and in, respectively.
+ */
+void z_sched_latency_ready(struct k_thread *thread);
+void z_sched_latency_stop(struct k_thread *thread);
+void z_sched_latency_start(struct k_thread *thread);
+#endif
+
 static inline void z_sched_usage_switch(struct k_thread *thread)
 {
 	ARG_UNUSED(thread);
+#ifdef CONFIG_THREAD_LATENCY_STATS
+	if (thread != _current) {
+		z_sched_latency_stop(_current);
+		z_sched_latency_start(thread);
+	}
+#endif
 #ifdef CONFIG_SCHED_THREAD_USAGE
 	z_sched_usage_stop();
 	z_sched_usage_start(thread);
@@ -38,6 +38,14 @@ static int create_free_list(struct k_mem_slab *slab)
 	slab->free_list = NULL;
 	p = slab->buffer;
 
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+	for (j = 0U; j < CONFIG_MP_NUM_CPUS; j++) {
+		slab->cache[j].lock = (struct k_spinlock) {};
+		slab->cache[j].free_list = NULL;
+		slab->cache[j].count = 0U;
+	}
+#endif
+
 	for (j = 0U; j < slab->num_blocks; j++) {
 		*(char **)p = slab->free_list;
 		slab->free_list = p;
@@ -101,13 +109,201 @@ out:
 	return rc;
 }
 
-int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+/*
+ * Each CPU keeps a LIFO of free blocks per slab, linked through the blocks
+ * just like the shared free list. Blocks in a cache are counted in
+ * slab->num_used, since they are not on the shared list, and are subtracted
+ * again when the number of used blocks is reported.
+ *
+ * Lock order is cache lock, then slab lock. A cache is only accessed with
+ * interrupts locked, which keeps the caller on the CPU owning the cache.
+ * Blocks are only added to a cache with the slab lock held and no thread
+ * pending, and allocations check the caches again under the slab lock
+ * before pending, so that no thread waits while a cache holds a block.
+ */
+#define CACHE_BATCH (CONFIG_MEM_SLAB_PER_CPU_CACHE_SIZE / 2)
+
+static inline void cache_push(struct z_mem_slab_cache *cache, char *block)
+{
+	*(char **)block = cache->free_list;
+	cache->free_list = block;
+	cache->count++;
+}
+
+static inline char *cache_pop(struct z_mem_slab_cache *cache)
+{
+	char *block = cache->free_list;
+
+	if (block != NULL) {
+		cache->free_list = *(char **)block;
+		cache->count--;
+	}
+
+	return block;
+}
+
+/* Move a batch of blocks from the shared free list into @a cache */
+static void cache_refill(struct k_mem_slab *slab,
+			 struct z_mem_slab_cache *cache)
+{
+	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+
+	while ((cache->count < CACHE_BATCH) && (slab->free_list != NULL)) {
+		char *block = slab->free_list;
+
+		slab->free_list = *(char **)block;
+		slab->num_used++;
+		cache_push(cache, block);
+	}
+
+	k_spin_unlock(&slab->lock, key);
+}
+
+/* Move a batch of blocks from @a cache back to the shared free list.
+ * Must be called with the slab lock held and no thread pending.
+ */
+static void cache_flush(struct k_mem_slab *slab,
+			struct z_mem_slab_cache *cache)
+{
+	for (int i = 0; i < CACHE_BATCH; i++) {
+		char *block = cache_pop(cache);
+
+		*(char **)block = slab->free_list;
+		slab->free_list = block;
+		slab->num_used--;
+	}
+}
+
+/* Whether any CPU cache holds a free block. Must be called with the slab
+ * lock held: blocks are only added to a cache under the slab lock, so a
+ * block cached before the caller took the lock is always seen.
+ */
+static bool cache_any(struct k_mem_slab *slab)
+{
+	for (unsigned int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		if (*(volatile uint32_t *)&slab->cache[i].count != 0U) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static char *cache_alloc(struct k_mem_slab *slab)
+{
+	unsigned int irq_key = arch_irq_lock();
+	unsigned int cpu = _current_cpu->id;
+	struct z_mem_slab_cache *cache = &slab->cache[cpu];
+	k_spinlock_key_t key = k_spin_lock(&cache->lock);
+	char *block;
+
+	if (cache->free_list == NULL) {
+		cache_refill(slab, cache);
+	}
+	block = cache_pop(cache);
+
+	k_spin_unlock(&cache->lock, key);
+
+	/* The shared list is empty: take a block cached by another CPU
+	 * rather than failing or pending while free blocks exist.
+	 */
+	for (unsigned int i = 0; (block == NULL) && (i < CONFIG_MP_NUM_CPUS);
+	     i++) {
+		if (i == cpu) {
+			continue;
+		}
+		cache = &slab->cache[i];
+		key = k_spin_lock(&cache->lock);
+		block = cache_pop(cache);
+		k_spin_unlock(&cache->lock, key);
+	}
+
+	arch_irq_unlock(irq_key);
+
+	return block;
+}
+
+static bool cache_free(struct k_mem_slab *slab, char *block)
+{
+	unsigned int irq_key;
+	struct z_mem_slab_cache *cache;
+	k_spinlock_key_t key, slab_key;
+	bool cached = false;
+
+	/* Threads can only be pending while the shared list is empty. Frees
+	 * then go straight to the shared path so that they wake them up.
+	 */
+	if (*(char *volatile *)&slab->free_list == NULL) {
+		return false;
+	}
+
+	irq_key = arch_irq_lock();
+	cache = &slab->cache[_current_cpu->id];
+	key = k_spin_lock(&cache->lock);
+	slab_key = k_spin_lock(&slab->lock);
+
+	/* Check again under the slab lock: the shared list may have been
+	 * emptied meanwhile, and a thread pending now would never be woken
+	 * by a block sitting in a cache.
+	 */
+	if ((slab->free_list != NULL) && (z_waitq_head(&slab->wait_q) == NULL)) {
+		if (cache->count >= CONFIG_MEM_SLAB_PER_CPU_CACHE_SIZE) {
+			cache_flush(slab, cache);
+		}
+		cache_push(cache, block);
+		cached = true;
+	}
+
+	k_spin_unlock(&slab->lock, slab_key);
+	k_spin_unlock(&cache->lock, key);
+	arch_irq_unlock(irq_key);
+
+	return cached;
+}
+
+uint32_t z_mem_slab_num_used(struct k_mem_slab *slab)
 {
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	uint32_t num_used = slab->num_used;
+
+	for (unsigned int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		num_used -= slab->cache[i].count;
+	}
+
+	k_spin_unlock(&slab->lock, key);
+
+	return num_used;
+}
+#endif /* CONFIG_MEM_SLAB_PER_CPU_CACHE */
+
+int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
+{
+	k_spinlock_key_t key;
 	int result;
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
 
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+retry:
+	*mem = cache_alloc(slab);
+	if (*mem != NULL) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab,
+					       timeout, 0);
+		return 0;
+	}
+#endif
+
+	key = k_spin_lock(&slab->lock);
+
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+	/* A block was cached by another CPU since cache_alloc() looked */
+	if ((slab->free_list == NULL) && cache_any(slab)) {
+		k_spin_unlock(&slab->lock, key);
+		goto retry;
+	}
+#endif
+
 	if (slab->free_list != NULL) {
 		/* take a free block */
 		*mem = slab->free_list;
@@ -147,9 +343,18 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 
 void k_mem_slab_free(struct k_mem_slab *slab, void **mem)
 {
-	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	k_spinlock_key_t key;
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
+
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+	if (cache_free(slab, *mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+		return;
+	}
+#endif
+
+	key = k_spin_lock(&slab->lock);
 	if (slab->free_list == NULL && IS_ENABLED(CONFIG_MULTITHREADING)) {
 		struct k_thread *pending_thread = z_unpend_first_thread(&slab->wait_q);
 
@@ -179,8 +384,16 @@ int k_mem_slab_runtime_stats_get(struct k_mem_slab *slab, struct sys_memory_stat
 
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 
-	stats->allocated_bytes = slab->num_used * slab->block_size;
-	stats->free_bytes = (slab->num_blocks - slab->num_used) * slab->block_size;
+	uint32_t num_used = slab->num_used;
+
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+	for (unsigned int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		num_used -= slab->cache[i].count;
+	}
+#endif
+
+	stats->allocated_bytes = num_used * slab->block_size;
+	stats->free_bytes = (slab->num_blocks - num_used) * slab->block_size;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	stats->max_allocated_bytes = slab->max_used * slab->block_size;
 #else
@@ -1312,6 +1312,168 @@ static inline struct z_page_frame *do_eviction_select(bool *dirty)
 	return pf;
 }
 
+#ifdef CONFIG_DEMAND_PAGING_PAGER_THREAD
+/*
+ * The pager thread keeps a pool of clean free page frames, so that page
+ * faults rarely have to evict and write back a dirty page before they
+ * can page in. It is woken by page faults that leave fewer than
+ * CONFIG_DEMAND_PAGING_PAGER_FREE_FRAMES free page frames and evicts
+ * pages until the pool is full again.
+ */
+static K_SEM_DEFINE(pager_sem, 0, 1);
+static K_KERNEL_PINNED_STACK_DEFINE(pager_stack,
+				    CONFIG_DEMAND_PAGING_PAGER_STACK_SIZE);
+__pinned_bss static struct k_thread pager_thread;
+
+static inline bool pager_pool_low(void)
+{
+	return z_free_page_count < CONFIG_DEMAND_PAGING_PAGER_FREE_FRAMES;
+}
+
+/* Returns false once the pool is full or nothing can be evicted */
+static bool pager_evict_one(void)
+{
+	struct z_page_frame *pf;
+	uintptr_t location;
+	bool dirty = false;
+	bool result = false;
+	int key, ret;
+
+#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
+	k_sched_lock();
+#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
+	key = irq_lock();
+	if (!pager_pool_low()) {
+		goto out;
+	}
+
+	pf = do_eviction_select(&dirty);
+	if (pf == NULL) {
+		goto out;
+	}
+
+	ret = page_frame_prepare_locked(pf, &dirty, false, &location);
+	if (ret != 0) {
+		goto out;
+	}
+	paging_stats_eviction_inc(_current, dirty);
+
+#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
+	irq_unlock(key);
+#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
+	if (dirty) {
+		do_backing_store_page_out(location);
+	}
+#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
+	key = irq_lock();
+#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
+	page_frame_free_locked(pf);
+	result = true;
+out:
+	irq_unlock(key);
+#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
+	k_sched_unlock();
+#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
+
+	return result;
+}
+
+static void pager_thread_main(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		(void)k_sem_take(&pager_sem, K_FOREVER);
+
+		while (pager_evict_one()) {
+		}
+	}
+}
+
+static int pager_thread_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	k_thread_create(&pager_thread, pager_stack,
+			K_KERNEL_STACK_SIZEOF(pager_stack),
+			pager_thread_main, NULL, NULL, NULL,
+			CONFIG_DEMAND_PAGING_PAGER_THREAD_PRIORITY,
+			K_ESSENTIAL, K_NO_WAIT);
+	k_thread_name_set(&pager_thread, "pager");
+
+	/* Fill the pool with pages left over from boot */
+	k_sem_give(&pager_sem);
+
+	return 0;
+}
+
+SYS_INIT(pager_thread_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+#endif /* CONFIG_DEMAND_PAGING_PAGER_THREAD */
+
+#if CONFIG_DEMAND_PAGING_READ_AHEAD > 0
+/*
+ * Page in the data pages following a faulting page while we are at it.
+ * Only free page frames beyond the paging reserve are used, so reading
+ * ahead never evicts anything, and the first page already present ends
+ * the run.
+ *
+ * Called and returns with interrupts locked; *key is updated if they
+ * were unlocked around the transfers.
+ */
+static void do_read_ahead(void *addr, int *key)
+{
+	uint8_t *vaddr = addr;
+
+	for (int i = 0; i < CONFIG_DEMAND_PAGING_READ_AHEAD; i++) {
+		struct z_page_frame *pf;
+		uintptr_t page_in_location, page_out_location;
+		bool dirty = false;
+		int ret;
+
+		vaddr += CONFIG_MMU_PAGE_SIZE;
+		if (vaddr >= Z_VIRT_RAM_END || vaddr < (uint8_t *)addr) {
+			break;
+		}
+
+		if (arch_page_location_get(vaddr, &page_in_location) !=
+		    ARCH_PAGE_LOCATION_PAGED_OUT) {
+			break;
+		}
+
+		/* Leave the reserve to faults and anonymous mappings */
+		if (z_free_page_count <= CONFIG_DEMAND_PAGING_PAGE_FRAMES_RESERVE) {
+			break;
+		}
+
+		pf = free_page_frame_list_get();
+		if (pf == NULL) {
+			break;
+		}
+
+		ret = page_frame_prepare_locked(pf, &dirty, true,
+						&page_out_location);
+		__ASSERT(ret == 0, "failed to prepare page frame");
+		(void)ret;
+
+#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
+		irq_unlock(*key);
+#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
+		do_backing_store_page_in(page_in_location);
+#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
+		*key = irq_lock();
+		pf->flags &= ~Z_PAGE_FRAME_BUSY;
+#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
+		pf->flags |= Z_PAGE_FRAME_MAPPED;
+		pf->addr = vaddr;
+
+		arch_mem_page_in(vaddr, z_page_frame_to_phys(pf));
+		k_mem_paging_backing_store_page_finalize(pf, page_in_location);
+	}
+}
+#endif /* CONFIG_DEMAND_PAGING_READ_AHEAD > 0 */
+
 static bool do_page_fault(void *addr, bool pin)
 {
 	struct z_page_frame *pf;
@@ -1321,6 +1483,9 @@ static bool do_page_fault(void *addr, bool pin)
 	bool result;
 	bool dirty = false;
 	struct k_thread *faulting_thread = _current_cpu->current;
+#ifdef CONFIG_DEMAND_PAGING_PAGER_THREAD
+	bool wake_pager = false;
+#endif /* CONFIG_DEMAND_PAGING_PAGER_THREAD */
 
 	__ASSERT(page_frames_initialized, "page fault at %p happened too early",
 		 addr);
@@ -1431,11 +1596,25 @@ static bool do_page_fault(void *addr, bool pin)
 
 	arch_mem_page_in(addr, z_page_frame_to_phys(pf));
 	k_mem_paging_backing_store_page_finalize(pf, page_in_location);
+
+#if CONFIG_DEMAND_PAGING_READ_AHEAD > 0
+	if (!pin) {
+		do_read_ahead(pf->addr, &key);
+	}
+#endif /* CONFIG_DEMAND_PAGING_READ_AHEAD > 0 */
+#ifdef CONFIG_DEMAND_PAGING_PAGER_THREAD
+	wake_pager = pager_pool_low();
+#endif /* CONFIG_DEMAND_PAGING_PAGER_THREAD */
 out:
 	irq_unlock(key);
 #ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
 	k_sched_unlock();
 #endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
+#ifdef CONFIG_DEMAND_PAGING_PAGER_THREAD
+	if (wake_pager) {
+		k_sem_give(&pager_sem);
+	}
+#endif /* CONFIG_DEMAND_PAGING_PAGER_THREAD */
 
 	return result;
 }
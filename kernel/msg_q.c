@@ -32,6 +32,91 @@ static inline void handle_poll_events(struct k_msgq *msgq, uint32_t state)
 }
 #endif /* CONFIG_POLL */
 
+static inline void msgq_ptr_advance(struct k_msgq *msgq, char **ptr)
+{
+	*ptr += msgq->msg_size;
+	if (*ptr == msgq->buffer_end) {
+		*ptr = msgq->buffer_start;
+	}
+}
+
+/* Fail every thread still pending on the queue. Used by purge, and when a
+ * zero-copy reservation or claim is granted to a pended thread: the
+ * remaining waiters are then all of the same kind (writers or readers) and
+ * can no longer be served from the slot the grant just took.
+ */
+static void msgq_wake_all(struct k_msgq *msgq, int result)
+{
+	struct k_thread *pending_thread;
+
+	while ((pending_thread = z_unpend_first_thread(&msgq->wait_q)) != NULL) {
+		arch_thread_return_value_set(pending_thread, result);
+		z_ready_thread(pending_thread);
+	}
+}
+
+/* A slot has just been freed in the ring buffer: hand it to the first
+ * thread waiting to write, if any. Threads pended in k_msgq_reserve() have
+ * a NULL swap_data and receive the slot itself rather than a copy.
+ */
+static bool msgq_wake_writer(struct k_msgq *msgq)
+{
+	struct k_thread *pending_thread;
+
+	pending_thread = z_unpend_first_thread(&msgq->wait_q);
+	if (pending_thread == NULL) {
+		return false;
+	}
+
+	if (pending_thread->base.swap_data == NULL) {
+		msgq->flags |= K_MSGQ_FLAG_RESERVED;
+		msgq_wake_all(msgq, -EBUSY);
+	} else {
+		/* add thread's message to queue */
+		(void)memcpy(msgq->write_ptr, pending_thread->base.swap_data,
+		       msgq->msg_size);
+		msgq_ptr_advance(msgq, &msgq->write_ptr);
+		msgq->used_msgs++;
+	}
+
+	/* wake up waiting thread */
+	arch_thread_return_value_set(pending_thread, 0);
+	z_ready_thread(pending_thread);
+
+	return true;
+}
+
+/* The message at the write pointer is complete. Threads pended in
+ * k_msgq_peek_claim() have a NULL swap_data and are given the message in
+ * place; any other reader receives a copy. Returns true if a reader was
+ * woken.
+ */
+static bool msgq_wake_reader(struct k_msgq *msgq)
+{
+	struct k_thread *pending_thread;
+
+	pending_thread = z_unpend_first_thread(&msgq->wait_q);
+	if (pending_thread == NULL) {
+		return false;
+	}
+
+	if (pending_thread->base.swap_data == NULL) {
+		msgq_ptr_advance(msgq, &msgq->write_ptr);
+		msgq->used_msgs++;
+		msgq->flags |= K_MSGQ_FLAG_CLAIMED;
+		msgq_wake_all(msgq, -EBUSY);
+	} else {
+		(void)memcpy(pending_thread->base.swap_data, msgq->write_ptr,
+		       msgq->msg_size);
+	}
+
+	/* wake up waiting thread */
+	arch_thread_return_value_set(pending_thread, 0);
+	z_ready_thread(pending_thread);
+
+	return true;
+}
+
 void k_msgq_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
 		 uint32_t max_msgs)
 {
@@ -125,8 +210,22 @@ int z_impl_k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, put, msgq, timeout);
 
-	if (msgq->used_msgs < msgq->max_msgs) {
+	if ((msgq->flags & K_MSGQ_FLAG_RESERVED) != 0U) {
+		/* the write side is owned by a zero-copy reservation */
+		result = -EBUSY;
+	} else if (msgq->used_msgs < msgq->max_msgs) {
 		/* message queue isn't full */
+		pending_thread = z_waitq_head(&msgq->wait_q);
+		if ((pending_thread != NULL) &&
+		    (pending_thread->base.swap_data == NULL)) {
+			/* reader waiting in k_msgq_peek_claim() */
+			(void)memcpy(msgq->write_ptr, data, msgq->msg_size);
+			(void)msgq_wake_reader(msgq);
+			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put, msgq, timeout, 0);
+			z_reschedule(&msgq->lock, key);
+			return 0;
+		}
+
 		pending_thread = z_unpend_first_thread(&msgq->wait_q);
 		if (pending_thread != NULL) {
 			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put, msgq, timeout, 0);
@@ -142,10 +241,7 @@ int z_impl_k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout
 		} else {
 			/* put message in queue */
 			(void)memcpy(msgq->write_ptr, data, msgq->msg_size);
-			msgq->write_ptr += msgq->msg_size;
-			if (msgq->write_ptr == msgq->buffer_end) {
-				msgq->write_ptr = msgq->buffer_start;
-			}
+			msgq_ptr_advance(msgq, &msgq->write_ptr);
 			msgq->used_msgs++;
 #ifdef CONFIG_POLL
 			handle_poll_events(msgq, K_POLL_STATE_MSGQ_DATA_AVAILABLE);
@@ -208,39 +304,25 @@ int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
 
 	k_spinlock_key_t key;
-	struct k_thread *pending_thread;
 	int result;
 
 	key = k_spin_lock(&msgq->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, get, msgq, timeout);
 
-	if (msgq->used_msgs > 0U) {
+	if ((msgq->flags & K_MSGQ_FLAG_CLAIMED) != 0U) {
+		/* the read side is owned by a zero-copy claim */
+		result = -EBUSY;
+	} else if (msgq->used_msgs > 0U) {
 		/* take first available message from queue */
 		(void)memcpy(data, msgq->read_ptr, msgq->msg_size);
-		msgq->read_ptr += msgq->msg_size;
-		if (msgq->read_ptr == msgq->buffer_end) {
-			msgq->read_ptr = msgq->buffer_start;
-		}
+		msgq_ptr_advance(msgq, &msgq->read_ptr);
 		msgq->used_msgs--;
 
 		/* handle first thread waiting to write (if any) */
-		pending_thread = z_unpend_first_thread(&msgq->wait_q);
-		if (pending_thread != NULL) {
+		if (msgq_wake_writer(msgq)) {
 			SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, get, msgq, timeout);
 
-			/* add thread's message to queue */
-			(void)memcpy(msgq->write_ptr, pending_thread->base.swap_data,
-			       msgq->msg_size);
-			msgq->write_ptr += msgq->msg_size;
-			if (msgq->write_ptr == msgq->buffer_end) {
-				msgq->write_ptr = msgq->buffer_start;
-			}
-			msgq->used_msgs++;
-
-			/* wake up waiting thread */
-			arch_thread_return_value_set(pending_thread, 0);
-			z_ready_thread(pending_thread);
 			z_reschedule(&msgq->lock, key);
 
 			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get, msgq, timeout, 0);
@@ -315,21 +397,202 @@ static inline int z_vrfy_k_msgq_peek(struct k_msgq *msgq, void *data)
 #include <syscalls/k_msgq_peek_mrsh.c>
 #endif
 
+int z_impl_k_msgq_reserve(struct k_msgq *msgq, void **data,
+			  k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	k_spinlock_key_t key;
+	int result;
+
+	key = k_spin_lock(&msgq->lock);
+
+	if ((msgq->flags & K_MSGQ_FLAG_RESERVED) != 0U) {
+		result = -EBUSY;
+	} else if (msgq->used_msgs < msgq->max_msgs) {
+		/* a free slot means no writer can be pending */
+		msgq->flags |= K_MSGQ_FLAG_RESERVED;
+		*data = msgq->write_ptr;
+		result = 0;
+	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		/* don't wait for message space to become available */
+		result = -ENOMSG;
+	} else {
+		/* wait to be granted the next free slot */
+		_current->base.swap_data = NULL;
+
+		result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+		if (result == 0) {
+			/* the write pointer can't move while we own the
+			 * reservation
+			 */
+			*data = msgq->write_ptr;
+		}
+		return result;
+	}
+
+	k_spin_unlock(&msgq->lock, key);
+
+	return result;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_reserve(struct k_msgq *msgq, void **data,
+					k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(msgq, K_OBJ_MSGQ));
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(data, sizeof(*data)));
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(msgq->buffer_start,
+				      msgq->buffer_end - msgq->buffer_start));
+
+	return z_impl_k_msgq_reserve(msgq, data, timeout);
+}
+#include <syscalls/k_msgq_reserve_mrsh.c>
+#endif
+
+int z_impl_k_msgq_commit(struct k_msgq *msgq)
+{
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&msgq->lock);
+
+	if ((msgq->flags & K_MSGQ_FLAG_RESERVED) == 0U) {
+		k_spin_unlock(&msgq->lock, key);
+		return -EINVAL;
+	}
+
+	msgq->flags &= ~K_MSGQ_FLAG_RESERVED;
+
+	/* readers can only be pending on an empty queue */
+	if (msgq_wake_reader(msgq)) {
+		z_reschedule(&msgq->lock, key);
+		return 0;
+	}
+
+	msgq_ptr_advance(msgq, &msgq->write_ptr);
+	msgq->used_msgs++;
+#ifdef CONFIG_POLL
+	handle_poll_events(msgq, K_POLL_STATE_MSGQ_DATA_AVAILABLE);
+#endif /* CONFIG_POLL */
+
+	k_spin_unlock(&msgq->lock, key);
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_commit(struct k_msgq *msgq)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(msgq, K_OBJ_MSGQ));
+
+	return z_impl_k_msgq_commit(msgq);
+}
+#include <syscalls/k_msgq_commit_mrsh.c>
+#endif
+
+int z_impl_k_msgq_peek_claim(struct k_msgq *msgq, void **data,
+			     k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	k_spinlock_key_t key;
+	int result;
+
+	key = k_spin_lock(&msgq->lock);
+
+	if ((msgq->flags & K_MSGQ_FLAG_CLAIMED) != 0U) {
+		result = -EBUSY;
+	} else if (msgq->used_msgs > 0U) {
+		msgq->flags |= K_MSGQ_FLAG_CLAIMED;
+		*data = msgq->read_ptr;
+		result = 0;
+	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		/* don't wait for a message to become available */
+		result = -ENOMSG;
+	} else {
+		/* wait to be granted the next message in place */
+		_current->base.swap_data = NULL;
+
+		result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+		if (result == 0) {
+			/* the read pointer can't move while we own the
+			 * claim
+			 */
+			*data = msgq->read_ptr;
+		}
+		return result;
+	}
+
+	k_spin_unlock(&msgq->lock, key);
+
+	return result;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_peek_claim(struct k_msgq *msgq, void **data,
+					   k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(msgq, K_OBJ_MSGQ));
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(data, sizeof(*data)));
+	Z_OOPS(Z_SYSCALL_MEMORY_READ(msgq->buffer_start,
+				     msgq->buffer_end - msgq->buffer_start));
+
+	return z_impl_k_msgq_peek_claim(msgq, data, timeout);
+}
+#include <syscalls/k_msgq_peek_claim_mrsh.c>
+#endif
+
+int z_impl_k_msgq_release(struct k_msgq *msgq)
+{
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&msgq->lock);
+
+	if ((msgq->flags & K_MSGQ_FLAG_CLAIMED) == 0U) {
+		k_spin_unlock(&msgq->lock, key);
+		return -EINVAL;
+	}
+
+	msgq->flags &= ~K_MSGQ_FLAG_CLAIMED;
+	msgq_ptr_advance(msgq, &msgq->read_ptr);
+	msgq->used_msgs--;
+
+	/* handle first thread waiting to write (if any) */
+	if (msgq_wake_writer(msgq)) {
+		z_reschedule(&msgq->lock, key);
+		return 0;
+	}
+
+	k_spin_unlock(&msgq->lock, key);
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_release(struct k_msgq *msgq)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(msgq, K_OBJ_MSGQ));
+
+	return z_impl_k_msgq_release(msgq);
+}
+#include <syscalls/k_msgq_release_mrsh.c>
+#endif
+
 void z_impl_k_msgq_purge(struct k_msgq *msgq)
 {
 	k_spinlock_key_t key;
-	struct k_thread *pending_thread;
 
 	key = k_spin_lock(&msgq->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC(k_msgq, purge, msgq);
 
 	/* wake up any threads that are waiting to write */
-	while ((pending_thread = z_unpend_first_thread(&msgq->wait_q)) != NULL) {
-		arch_thread_return_value_set(pending_thread, -ENOMSG);
-		z_ready_thread(pending_thread);
-	}
+	msgq_wake_all(msgq, -ENOMSG);
 
+	/* an outstanding claim is discarded along with its message, while
+	 * an outstanding reservation stays valid at the write pointer
+	 */
+	msgq->flags &= ~K_MSGQ_FLAG_CLAIMED;
 	msgq->used_msgs = 0;
 	msgq->read_ptr = msgq->write_ptr;
 
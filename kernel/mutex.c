@@ -24,6 +24,15 @@
  * When releasing the mutex, thread A must release M2 before it releases M1.
  * Failure to follow this nested model may result in threads running at
  * unexpected priority levels (too high, or too low).
+ *
+ * Inheritance is transitive: if the owning thread is itself waiting on
+ * another mutex, the elevated priority is passed on to that mutex's owner,
+ * and so on up to CONFIG_MUTEX_PI_CHAIN_DEPTH owners.
+ *
+ * With CONFIG_MUTEX_FAST_PATH, locking a free mutex and unlocking a mutex
+ * nobody waits for are a single atomic operation on the owner field and
+ * do not take the spinlock.  A thread about to wait sets the "contended"
+ * flag first, which forces the owner's unlock into the locked slow path.
  */
 
 #include <zephyr/kernel.h>
@@ -50,6 +59,9 @@ int z_impl_k_mutex_init(struct k_mutex *mutex)
 {
 	mutex->owner = NULL;
 	mutex->lock_count = 0U;
+#ifdef CONFIG_MUTEX_FAST_PATH
+	mutex->contended = false;
+#endif
 
 	z_waitq_init(&mutex->wait_q);
 
@@ -69,6 +81,97 @@ static inline int z_vrfy_k_mutex_init(struct k_mutex *mutex)
 #include <syscalls/k_mutex_init_mrsh.c>
 #endif
 
+#ifdef CONFIG_MUTEX_FAST_PATH
+static inline struct k_thread *mutex_owner(struct k_mutex *mutex)
+{
+	return __atomic_load_n(&mutex->owner, __ATOMIC_SEQ_CST);
+}
+
+static inline void mutex_owner_set(struct k_mutex *mutex,
+				   struct k_thread *owner)
+{
+	__atomic_store_n(&mutex->owner, owner, __ATOMIC_SEQ_CST);
+}
+
+static inline bool mutex_owner_cas(struct k_mutex *mutex,
+				   struct k_thread *old_owner,
+				   struct k_thread *new_owner)
+{
+	return __atomic_compare_exchange_n(&mutex->owner, &old_owner,
+					   new_owner, false,
+					   __ATOMIC_SEQ_CST,
+					   __ATOMIC_SEQ_CST);
+}
+
+static inline bool mutex_contended(struct k_mutex *mutex)
+{
+	return __atomic_load_n(&mutex->contended, __ATOMIC_SEQ_CST);
+}
+
+/* The lock count is written after owner_orig_prio, and a non-zero count
+ * read under the spinlock means the owner's original priority is valid.
+ */
+static inline uint32_t mutex_lock_count(struct k_mutex *mutex)
+{
+	return __atomic_load_n(&mutex->lock_count, __ATOMIC_ACQUIRE);
+}
+
+static inline void mutex_lock_count_set(struct k_mutex *mutex, uint32_t count)
+{
+	__atomic_store_n(&mutex->lock_count, count, __ATOMIC_RELEASE);
+}
+
+static inline void mutex_contended_set(struct k_mutex *mutex, bool val)
+{
+	__atomic_store_n(&mutex->contended, val, __ATOMIC_SEQ_CST);
+}
+#else
+/* Without the fast path every update happens under the spinlock */
+static inline struct k_thread *mutex_owner(struct k_mutex *mutex)
+{
+	return mutex->owner;
+}
+
+static inline void mutex_owner_set(struct k_mutex *mutex,
+				   struct k_thread *owner)
+{
+	mutex->owner = owner;
+}
+
+static inline bool mutex_owner_cas(struct k_mutex *mutex,
+				   struct k_thread *old_owner,
+				   struct k_thread *new_owner)
+{
+	if (mutex->owner != old_owner) {
+		return false;
+	}
+	mutex->owner = new_owner;
+	return true;
+}
+
+static inline bool mutex_contended(struct k_mutex *mutex)
+{
+	ARG_UNUSED(mutex);
+	return true;
+}
+
+static inline uint32_t mutex_lock_count(struct k_mutex *mutex)
+{
+	return mutex->lock_count;
+}
+
+static inline void mutex_lock_count_set(struct k_mutex *mutex, uint32_t count)
+{
+	mutex->lock_count = count;
+}
+
+static inline void mutex_contended_set(struct k_mutex *mutex, bool val)
+{
+	ARG_UNUSED(mutex);
+	ARG_UNUSED(val);
+}
+#endif
+
 static int32_t new_prio_for_inheritance(int32_t target, int32_t limit)
 {
 	int new_prio = z_is_prio_higher(target, limit) ? target : limit;
@@ -78,46 +181,201 @@ static int32_t new_prio_for_inheritance(int32_t target, int32_t limit)
 	return new_prio;
 }
 
-static bool adjust_owner_prio(struct k_mutex *mutex, int32_t new_prio)
+static bool adjust_owner_prio(struct k_thread *owner, int32_t new_prio)
 {
-	if (mutex->owner->base.prio != new_prio) {
+	if (owner->base.prio != new_prio) {
 
 		LOG_DBG("%p (ready (y/n): %c) prio changed to %d (was %d)",
-			mutex->owner, z_is_thread_ready(mutex->owner) ?
+			owner, z_is_thread_ready(owner) ?
 			'y' : 'n',
-			new_prio, mutex->owner->base.prio);
+			new_prio, owner->base.prio);
 
-		return z_set_prio(mutex->owner, new_prio);
+		return z_set_prio(owner, new_prio);
 	}
 	return false;
 }
 
-int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
+/* Returns the mutex @a thread waits on, or NULL if it is not waiting on
+ * one.  A thread records the mutex in swap_data before pending on it, and
+ * nothing else stores a mutex pointer there, so the wait queue it pends
+ * on identifies which case we are in.
+ */
+static struct k_mutex *mutex_blocked_on(struct k_thread *thread)
+{
+	struct k_mutex *mutex = thread->base.swap_data;
+
+	if (!z_is_thread_pending(thread) || (mutex == NULL) ||
+	    (thread->base.pended_on != &mutex->wait_q)) {
+		return NULL;
+	}
+	return mutex;
+}
+
+/* Raises the owner of @a mutex to at least @a prio and passes it on
+ * along the chain of mutexes the owners are waiting on.
+ */
+static bool inherit_prio_chain(struct k_mutex *mutex, int32_t prio)
 {
-	int new_prio;
-	k_spinlock_key_t key;
 	bool resched = false;
 
-	__ASSERT(!arch_is_in_isr(), "mutexes cannot be used inside ISRs");
+	for (int depth = 0; (mutex != NULL) &&
+	     (depth < CONFIG_MUTEX_PI_CHAIN_DEPTH); depth++) {
+		struct k_thread *owner = mutex_owner(mutex);
 
-	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mutex, lock, mutex, timeout);
+		if (owner == NULL) {
+			break;
+		}
 
-	key = k_spin_lock(&lock);
+		int32_t new_prio = new_prio_for_inheritance(prio,
+							    owner->base.prio);
 
-	if (likely((mutex->lock_count == 0U) || (mutex->owner == _current))) {
+		if (!z_is_prio_higher(new_prio, owner->base.prio)) {
+			break;
+		}
 
-		mutex->owner_orig_prio = (mutex->lock_count == 0U) ?
-					_current->base.prio :
-					mutex->owner_orig_prio;
+		resched = adjust_owner_prio(owner, new_prio) || resched;
+		mutex = mutex_blocked_on(owner);
+	}
+
+	return resched;
+}
+
+/* Recomputes the priority of the owner of @a mutex after a waiter left,
+ * from its original priority and the remaining waiters, and likewise for
+ * the owners further up the chain.
+ */
+static bool restore_prio_chain(struct k_mutex *mutex)
+{
+	bool resched = false;
 
+	for (int depth = 0; (mutex != NULL) &&
+	     (depth < CONFIG_MUTEX_PI_CHAIN_DEPTH); depth++) {
+		struct k_thread *owner = mutex_owner(mutex);
+
+		/* A lock count of zero with an owner means the owner has
+		 * not recorded its original priority yet (fast path), so
+		 * it cannot have been raised on the mutex's behalf.
+		 */
+		if ((owner == NULL) || (mutex_lock_count(mutex) == 0U)) {
+			break;
+		}
+
+		struct k_thread *waiter = z_waitq_head(&mutex->wait_q);
+		int32_t new_prio = (waiter != NULL) ?
+			new_prio_for_inheritance(waiter->base.prio, mutex->owner_orig_prio) :
+			mutex->owner_orig_prio;
+
+		if (owner->base.prio == new_prio) {
+			break;
+		}
+
+		resched = adjust_owner_prio(owner, new_prio) || resched;
+		mutex = mutex_blocked_on(owner);
+	}
+
+	return resched;
+}
+
+/* Takes @a mutex if it is free or already held by the caller.  The fast
+ * path leaves mutexes with waiters to the slow path, so that a thread
+ * taking one is raised to its waiters' priority.
+ */
+static bool mutex_trylock(struct k_mutex *mutex, bool fast)
+{
+	int prio = _current->base.prio;
+
+	if (mutex_owner(mutex) == _current) {
 		mutex->lock_count++;
-		mutex->owner = _current;
+	} else if ((fast && mutex_contended(mutex)) ||
+		   !mutex_owner_cas(mutex, NULL, _current)) {
+		return false;
+	} else {
+		/* Read before taking ownership, so a waiter raising
+		 * our priority in between is not recorded as ours.
+		 */
+		mutex->owner_orig_prio = prio;
+		mutex_lock_count_set(mutex, 1U);
+	}
+
+	LOG_DBG("%p took mutex %p, count: %d, orig prio: %d",
+		_current, mutex, mutex->lock_count,
+		mutex->owner_orig_prio);
+
+	return true;
+}
+
+/* Gives @a mutex, owned by the caller, to its first waiter if any and
+ * releases the lock.
+ */
+static void mutex_handoff(struct k_mutex *mutex, k_spinlock_key_t key)
+{
+	struct k_thread *new_owner;
+
+	/* Get the new owner, if any */
+	new_owner = z_unpend_first_thread(&mutex->wait_q);
+
+	LOG_DBG("new owner of mutex %p: %p (prio: %d)",
+		mutex, new_owner, new_owner ? new_owner->base.prio : -1000);
+
+	if (z_waitq_head(&mutex->wait_q) == NULL) {
+		mutex_contended_set(mutex, false);
+	}
+
+	if (new_owner != NULL) {
+		/*
+		 * new owner is already of higher or equal prio than first
+		 * waiter since the wait queue is priority-based: no need to
+		 * adjust its priority
+		 */
+		mutex->owner_orig_prio = new_owner->base.prio;
+		mutex_lock_count_set(mutex, 1U);
+		mutex_owner_set(mutex, new_owner);
+		arch_thread_return_value_set(new_owner, 0);
+		z_ready_thread(new_owner);
+		z_reschedule(&lock, key);
+	} else {
+		mutex_lock_count_set(mutex, 0U);
+		mutex_owner_set(mutex, NULL);
+		k_spin_unlock(&lock, key);
+	}
+}
 
-		LOG_DBG("%p took mutex %p, count: %d, orig prio: %d",
-			_current, mutex, mutex->lock_count,
-			mutex->owner_orig_prio);
+/* Called with the lock held after taking @a mutex on the slow path, and
+ * releases the lock.  With the fast path the mutex may have been taken
+ * between an unlock and the hand off to a waiter, in which case the new
+ * owner inherits the waiter's priority.
+ */
+static void mutex_lock_taken(struct k_mutex *mutex, k_spinlock_key_t key)
+{
+	struct k_thread *waiter = z_waitq_head(&mutex->wait_q);
 
+	if (unlikely(waiter != NULL) &&
+	    inherit_prio_chain(mutex, waiter->base.prio)) {
+		z_reschedule(&lock, key);
+	} else {
 		k_spin_unlock(&lock, key);
+	}
+}
+
+int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
+{
+	k_spinlock_key_t key;
+	bool resched = false;
+
+	__ASSERT(!arch_is_in_isr(), "mutexes cannot be used inside ISRs");
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mutex, lock, mutex, timeout);
+
+	if (IS_ENABLED(CONFIG_MUTEX_FAST_PATH) && mutex_trylock(mutex, true)) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, 0);
+
+		return 0;
+	}
+
+	key = k_spin_lock(&lock);
+
+	if (likely(mutex_trylock(mutex, false))) {
+		mutex_lock_taken(mutex, key);
 
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, 0);
 
@@ -132,19 +390,35 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 		return -EBUSY;
 	}
 
-	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_mutex, lock, mutex, timeout);
+#ifdef CONFIG_MUTEX_FAST_PATH
+	/* Once this is visible the owner unlocks through the slow path,
+	 * so either it released the mutex before and we can take it now,
+	 * or it will find us in the wait queue.
+	 */
+	mutex_contended_set(mutex, true);
 
-	new_prio = new_prio_for_inheritance(_current->base.prio,
-					    mutex->owner->base.prio);
+	if (mutex_trylock(mutex, false)) {
+		mutex_lock_taken(mutex, key);
 
-	LOG_DBG("adjusting prio up on mutex %p", mutex);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, 0);
 
-	if (z_is_prio_higher(new_prio, mutex->owner->base.prio)) {
-		resched = adjust_owner_prio(mutex, new_prio);
+		return 0;
 	}
+#endif
+
+	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_mutex, lock, mutex, timeout);
+
+	LOG_DBG("adjusting prio up on mutex %p", mutex);
+
+	resched = inherit_prio_chain(mutex, _current->base.prio);
+
+	/* Lets threads waiting on a mutex we own pass their priority on */
+	_current->base.swap_data = mutex;
 
 	int got_mutex = z_pend_curr(&lock, key, &mutex->wait_q, timeout);
 
+	_current->base.swap_data = NULL;
+
 	LOG_DBG("on mutex %p got_mutex value: %d", mutex, got_mutex);
 
 	LOG_DBG("%p got mutex %p (y/n): %c", _current, mutex,
@@ -162,20 +436,12 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 	key = k_spin_lock(&lock);
 
 	/*
-	 * Check if mutex was unlocked after this thread was unpended.
-	 * If so, skip adjusting owner's priority down.
+	 * If the mutex was unlocked after this thread was unpended,
+	 * there is no owner priority to adjust down.
 	 */
-	if (likely(mutex->owner != NULL)) {
-		struct k_thread *waiter = z_waitq_head(&mutex->wait_q);
+	LOG_DBG("adjusting prio down on mutex %p", mutex);
 
-		new_prio = (waiter != NULL) ?
-			new_prio_for_inheritance(waiter->base.prio, mutex->owner_orig_prio) :
-			mutex->owner_orig_prio;
-
-		LOG_DBG("adjusting prio down on mutex %p", mutex);
-
-		resched = adjust_owner_prio(mutex, new_prio) || resched;
-	}
+	resched = restore_prio_chain(mutex) || resched;
 
 	if (resched) {
 		z_reschedule(&lock, key);
@@ -198,15 +464,64 @@ static inline int z_vrfy_k_mutex_lock(struct k_mutex *mutex,
 #include <syscalls/k_mutex_lock_mrsh.c>
 #endif
 
-int z_impl_k_mutex_unlock(struct k_mutex *mutex)
+#ifdef CONFIG_MUTEX_FAST_PATH
+/* Releases @a mutex without the spinlock if nobody waits on it and the
+ * caller's priority was not raised.  Returns false if the slow path must
+ * be used instead.
+ */
+static bool mutex_fast_unlock(struct k_mutex *mutex)
 {
-	struct k_thread *new_owner;
+	int orig_prio = mutex->owner_orig_prio;
+	k_spinlock_key_t key;
+
+	if (mutex_contended(mutex) || (_current->base.prio != orig_prio)) {
+		return false;
+	}
+
+	mutex_lock_count_set(mutex, 0U);
+	mutex_owner_set(mutex, NULL);
+
+	if (likely(!mutex_contended(mutex))) {
+		return true;
+	}
+
+	/* A thread started waiting while we released the mutex.  It may
+	 * have raised our priority, and nobody else is going to wake it:
+	 * take the mutex back to hand it off, unless another thread got
+	 * it first, in which case that one unlocks through the slow path.
+	 */
+	key = k_spin_lock(&lock);
+
+	bool resched = adjust_owner_prio(_current, orig_prio);
+
+	if (mutex_owner_cas(mutex, NULL, _current)) {
+		mutex_handoff(mutex, key);
+		return true;
+	}
+
+	struct k_thread *waiter = z_waitq_head(&mutex->wait_q);
 
+	if (waiter != NULL) {
+		resched = inherit_prio_chain(mutex, waiter->base.prio) || resched;
+	}
+
+	if (resched) {
+		z_reschedule(&lock, key);
+	} else {
+		k_spin_unlock(&lock, key);
+	}
+
+	return true;
+}
+#endif
+
+int z_impl_k_mutex_unlock(struct k_mutex *mutex)
+{
 	__ASSERT(!arch_is_in_isr(), "mutexes cannot be used inside ISRs");
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mutex, unlock, mutex);
 
-	CHECKIF(mutex->owner == NULL) {
+	CHECKIF(mutex_owner(mutex) == NULL) {
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, unlock, mutex, -EINVAL);
 
 		return -EINVAL;
@@ -214,7 +529,7 @@ int z_impl_k_mutex_unlock(struct k_mutex *mutex)
 	/*
 	 * The current thread does not own the mutex.
 	 */
-	CHECKIF(mutex->owner != _current) {
+	CHECKIF(mutex_owner(mutex) != _current) {
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, unlock, mutex, -EPERM);
 
 		return -EPERM;
@@ -239,33 +554,17 @@ int z_impl_k_mutex_unlock(struct k_mutex *mutex)
 		goto k_mutex_unlock_return;
 	}
 
-	k_spinlock_key_t key = k_spin_lock(&lock);
-
-	adjust_owner_prio(mutex, mutex->owner_orig_prio);
-
-	/* Get the new owner, if any */
-	new_owner = z_unpend_first_thread(&mutex->wait_q);
-
-	mutex->owner = new_owner;
+#ifdef CONFIG_MUTEX_FAST_PATH
+	if (mutex_fast_unlock(mutex)) {
+		goto k_mutex_unlock_return;
+	}
+#endif
 
-	LOG_DBG("new owner of mutex %p: %p (prio: %d)",
-		mutex, new_owner, new_owner ? new_owner->base.prio : -1000);
+	k_spinlock_key_t key = k_spin_lock(&lock);
 
-	if (new_owner != NULL) {
-		/*
-		 * new owner is already of higher or equal prio than first
-		 * waiter since the wait queue is priority-based: no need to
-		 * adjust its priority
-		 */
-		mutex->owner_orig_prio = new_owner->base.prio;
-		arch_thread_return_value_set(new_owner, 0);
-		z_ready_thread(new_owner);
-		z_reschedule(&lock, key);
-	} else {
-		mutex->lock_count = 0U;
-		k_spin_unlock(&lock, key);
-	}
+	adjust_owner_prio(_current, mutex->owner_orig_prio);
 
+	mutex_handoff(mutex, key);
 
 k_mutex_unlock_return:
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, unlock, mutex, 0);
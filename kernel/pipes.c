@@ -20,11 +20,12 @@
 #include <zephyr/syscall_handler.h>
 #include <kernel_internal.h>
 #include <zephyr/sys/check.h>
+#include <zephyr/sys/math_extras.h>
 
 static int pipe_get_internal(k_spinlock_key_t key, struct k_pipe *pipe,
-			     void *data, size_t bytes_to_read,
-			     size_t *bytes_read, size_t min_xfer,
-			     k_timeout_t timeout);
+			     const struct k_pipe_iovec *iov, size_t iov_cnt,
+			     size_t bytes_to_read, size_t *bytes_read,
+			     size_t min_xfer, k_timeout_t timeout);
 
 void k_pipe_init(struct k_pipe *pipe, unsigned char *buffer, size_t size)
 {
@@ -93,14 +94,15 @@ static inline void handle_poll_events(struct k_pipe *pipe)
 
 void z_impl_k_pipe_flush(struct k_pipe *pipe)
 {
+	struct k_pipe_iovec vec = { .iov_base = NULL, .iov_len = (size_t) -1 };
 	size_t  bytes_read;
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_pipe, flush, pipe);
 
 	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
 
-	(void) pipe_get_internal(key, pipe, NULL, (size_t) -1, &bytes_read, 0U,
-				 K_NO_WAIT);
+	(void) pipe_get_internal(key, pipe, &vec, 1U, vec.iov_len, &bytes_read,
+				 0U, K_NO_WAIT);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, flush, pipe);
 }
@@ -117,6 +119,7 @@ void z_vrfy_k_pipe_flush(struct k_pipe *pipe)
 
 void z_impl_k_pipe_buffer_flush(struct k_pipe *pipe)
 {
+	struct k_pipe_iovec vec = { .iov_base = NULL, .iov_len = pipe->size };
 	size_t  bytes_read;
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_pipe, buffer_flush, pipe);
@@ -124,7 +127,7 @@ void z_impl_k_pipe_buffer_flush(struct k_pipe *pipe)
 	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
 
 	if (pipe->buffer != NULL) {
-		(void) pipe_get_internal(key, pipe, NULL, pipe->size,
+		(void) pipe_get_internal(key, pipe, &vec, 1U, vec.iov_len,
 					 &bytes_read, 0U, K_NO_WAIT);
 	} else {
 		k_spin_unlock(&pipe->lock, key);
@@ -200,6 +203,52 @@ static size_t pipe_xfer(unsigned char *dest, size_t dest_size,
 	return num_bytes;
 }
 
+/**
+ * @brief Move a pipe descriptor on to its next segment once the current
+ * one has been transferred
+ *
+ * @return true if the descriptor has bytes left in its current segment
+ */
+static bool pipe_desc_segment_next(struct _pipe_desc *desc)
+{
+	while ((desc->bytes_to_xfer == 0U) && (desc->iov_cnt > 0U)) {
+		desc->buffer         = desc->iov->iov_base;
+		desc->bytes_to_xfer  = desc->iov->iov_len;
+		desc->iov_bytes     -= desc->iov->iov_len;
+		desc->iov++;
+		desc->iov_cnt--;
+	}
+
+	return desc->bytes_to_xfer != 0U;
+}
+
+/**
+ * @brief Point a pipe descriptor at a list of segments
+ *
+ * The first non-empty segment becomes the current one.
+ */
+static void pipe_desc_init(struct _pipe_desc *desc,
+			   const struct k_pipe_iovec *iov, size_t iov_cnt,
+			   size_t num_bytes)
+{
+	desc->buffer        = NULL;
+	desc->bytes_to_xfer = 0U;
+	desc->thread        = _current;
+	desc->iov           = iov;
+	desc->iov_cnt       = iov_cnt;
+	desc->iov_bytes     = num_bytes;
+
+	(void) pipe_desc_segment_next(desc);
+}
+
+/**
+ * @brief Total number of bytes a pipe descriptor has left to transfer
+ */
+static inline size_t pipe_desc_bytes(const struct _pipe_desc *desc)
+{
+	return desc->bytes_to_xfer + desc->iov_bytes;
+}
+
 /**
  * @brief Popluate pipe descriptors for copying to/from waiters' buffers
  *
@@ -222,7 +271,7 @@ static size_t pipe_waiter_list_populate(sys_dlist_t  *list,
 
 		sys_dlist_append(list, &curr->node);
 
-		num_bytes += curr->bytes_to_xfer;
+		num_bytes += pipe_desc_bytes(curr);
 		if (num_bytes >= bytes_to_xfer) {
 			break;
 		}
@@ -248,6 +297,8 @@ static size_t pipe_buffer_list_populate(sys_dlist_t         *list,
 
 	desc[0].thread = NULL;
 	desc[0].buffer = &buffer[start];
+	desc[0].iov_cnt = 0U;
+	desc[0].iov_bytes = 0U;
 
 	if (start < end) {
 		desc[0].bytes_to_xfer = end - start;
@@ -259,6 +310,8 @@ static size_t pipe_buffer_list_populate(sys_dlist_t         *list,
 	desc[1].thread = NULL;
 	desc[1].buffer = &buffer[0];
 	desc[1].bytes_to_xfer = end;
+	desc[1].iov_cnt = 0U;
+	desc[1].iov_bytes = 0U;
 
 	sys_dlist_append(list, &desc[1].node);
 
@@ -327,7 +380,7 @@ static size_t pipe_write(struct k_pipe *pipe, sys_dlist_t *src_list,
 			if (pipe->write_index >= pipe->size) {
 				pipe->write_index -= pipe->size;
 			}
-		} else if (dest->bytes_to_xfer == 0U) {
+		} else if (pipe_desc_bytes(dest) == 0U) {
 
 			/* A thread's read request has been satisfied. */
 
@@ -336,11 +389,11 @@ static size_t pipe_write(struct k_pipe *pipe, sys_dlist_t *src_list,
 			*reschedule = true;
 		}
 
-		if (src->bytes_to_xfer == 0U) {
+		if (!pipe_desc_segment_next(src)) {
 			src = (struct _pipe_desc *)sys_dlist_get(src_list);
 		}
 
-		if (dest->bytes_to_xfer == 0U) {
+		if (!pipe_desc_segment_next(dest)) {
 			dest = (struct _pipe_desc *)sys_dlist_get(dest_list);
 		}
 	}
@@ -348,9 +401,29 @@ static size_t pipe_write(struct k_pipe *pipe, sys_dlist_t *src_list,
 	return num_bytes_written;
 }
 
-int z_impl_k_pipe_put(struct k_pipe *pipe, void *data, size_t bytes_to_write,
-		     size_t *bytes_written, size_t min_xfer,
-		      k_timeout_t timeout)
+/**
+ * @brief Sum the lengths of a list of segments
+ *
+ * @return 0 on success, -EINVAL if the total overflows
+ */
+static int pipe_iovec_bytes(const struct k_pipe_iovec *iov, size_t iov_cnt,
+			    size_t *num_bytes)
+{
+	*num_bytes = 0U;
+
+	for (size_t i = 0; i < iov_cnt; i++) {
+		if (size_add_overflow(*num_bytes, iov[i].iov_len, num_bytes)) {
+			return -EINVAL;
+		}
+	}
+
+	return 0;
+}
+
+static int pipe_put_internal(struct k_pipe *pipe,
+			     const struct k_pipe_iovec *iov, size_t iov_cnt,
+			     size_t bytes_to_write, size_t *bytes_written,
+			     size_t min_xfer, k_timeout_t timeout)
 {
 	struct _pipe_desc  pipe_desc[2];
 	struct _pipe_desc *src_desc;
@@ -359,18 +432,6 @@ int z_impl_k_pipe_put(struct k_pipe *pipe, void *data, size_t bytes_to_write,
 	size_t             bytes_can_write;
 	bool               reschedule_needed = false;
 
-	__ASSERT(((arch_is_in_isr() == false) ||
-		  K_TIMEOUT_EQ(timeout, K_NO_WAIT)), "");
-
-	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_pipe, put, pipe, timeout);
-
-	CHECKIF((min_xfer > bytes_to_write) || bytes_written == NULL) {
-		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, put, pipe, timeout,
-					       -EINVAL);
-
-		return -EINVAL;
-	}
-
 	sys_dlist_init(&src_list);
 	sys_dlist_init(&dest_list);
 
@@ -410,9 +471,7 @@ int z_impl_k_pipe_put(struct k_pipe *pipe, void *data, size_t bytes_to_write,
 
 	src_desc = &_current->pipe_desc;
 
-	src_desc->buffer        = data;
-	src_desc->bytes_to_xfer = bytes_to_write;
-	src_desc->thread        = _current;
+	pipe_desc_init(src_desc, iov, iov_cnt, bytes_to_write);
 	sys_dlist_append(&src_list, &src_desc->node);
 
 	*bytes_written = pipe_write(pipe, &src_list,
@@ -457,9 +516,9 @@ int z_impl_k_pipe_put(struct k_pipe *pipe, void *data, size_t bytes_to_write,
 
 	z_sched_wait(&pipe->lock, key, &pipe->wait_q.writers, timeout, NULL);
 
-	*bytes_written = bytes_to_write - src_desc->bytes_to_xfer;
+	*bytes_written = bytes_to_write - pipe_desc_bytes(src_desc);
 
-	int ret = pipe_return_code(min_xfer, src_desc->bytes_to_xfer,
+	int ret = pipe_return_code(min_xfer, pipe_desc_bytes(src_desc),
 				   bytes_to_write);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, put, pipe, timeout, ret);
@@ -467,6 +526,29 @@ int z_impl_k_pipe_put(struct k_pipe *pipe, void *data, size_t bytes_to_write,
 	return ret;
 }
 
+int z_impl_k_pipe_put(struct k_pipe *pipe, void *data, size_t bytes_to_write,
+		     size_t *bytes_written, size_t min_xfer,
+		      k_timeout_t timeout)
+{
+	struct k_pipe_iovec vec = { .iov_base = data,
+				    .iov_len = bytes_to_write };
+
+	__ASSERT(((arch_is_in_isr() == false) ||
+		  K_TIMEOUT_EQ(timeout, K_NO_WAIT)), "");
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_pipe, put, pipe, timeout);
+
+	CHECKIF((min_xfer > bytes_to_write) || bytes_written == NULL) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, put, pipe, timeout,
+					       -EINVAL);
+
+		return -EINVAL;
+	}
+
+	return pipe_put_internal(pipe, &vec, 1U, bytes_to_write,
+				 bytes_written, min_xfer, timeout);
+}
+
 #ifdef CONFIG_USERSPACE
 int z_vrfy_k_pipe_put(struct k_pipe *pipe, void *data, size_t bytes_to_write,
 		     size_t *bytes_written, size_t min_xfer,
@@ -483,10 +565,92 @@ int z_vrfy_k_pipe_put(struct k_pipe *pipe, void *data, size_t bytes_to_write,
 #include <syscalls/k_pipe_put_mrsh.c>
 #endif
 
+int z_impl_k_pipe_putv(struct k_pipe *pipe, const struct k_pipe_iovec *iov,
+		       size_t iov_cnt, size_t *bytes_written, size_t min_xfer,
+		       k_timeout_t timeout)
+{
+	size_t bytes_to_write;
+	int ret;
+
+	__ASSERT(((arch_is_in_isr() == false) ||
+		  K_TIMEOUT_EQ(timeout, K_NO_WAIT)), "");
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_pipe, put, pipe, timeout);
+
+	ret = pipe_iovec_bytes(iov, iov_cnt, &bytes_to_write);
+
+	CHECKIF((ret != 0) || (min_xfer > bytes_to_write) ||
+		bytes_written == NULL) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, put, pipe, timeout,
+					       -EINVAL);
+
+		return -EINVAL;
+	}
+
+	return pipe_put_internal(pipe, iov, iov_cnt, bytes_to_write,
+				 bytes_written, min_xfer, timeout);
+}
+
+#ifdef CONFIG_USERSPACE
+/* The segment list is copied into kernel memory so it can't change while
+ * the caller is pended; each segment is then checked against the caller's
+ * memory domain.
+ */
+static struct k_pipe_iovec *pipe_iovec_copy(const struct k_pipe_iovec *iov,
+					    size_t iov_cnt, bool write)
+{
+	struct k_pipe_iovec *iov_copy;
+	size_t size;
+
+	Z_OOPS(Z_SYSCALL_VERIFY_MSG(!size_mul_overflow(iov_cnt, sizeof(*iov),
+						       &size),
+				    "iovec count %zu too large", iov_cnt));
+
+	if (size == 0U) {
+		return NULL;
+	}
+
+	iov_copy = z_user_alloc_from_copy(iov, size);
+	Z_OOPS(Z_SYSCALL_VERIFY_MSG(iov_copy != NULL,
+				    "no memory to copy iovec"));
+
+	for (size_t i = 0; i < iov_cnt; i++) {
+		if (Z_SYSCALL_MEMORY(iov_copy[i].iov_base, iov_copy[i].iov_len,
+				     write) != 0) {
+			k_free(iov_copy);
+			Z_OOPS(1);
+		}
+	}
+
+	return iov_copy;
+}
+
+int z_vrfy_k_pipe_putv(struct k_pipe *pipe, const struct k_pipe_iovec *iov,
+		       size_t iov_cnt, size_t *bytes_written, size_t min_xfer,
+		       k_timeout_t timeout)
+{
+	struct k_pipe_iovec *iov_copy;
+	int ret;
+
+	Z_OOPS(Z_SYSCALL_OBJ(pipe, K_OBJ_PIPE));
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(bytes_written, sizeof(*bytes_written)));
+
+	iov_copy = pipe_iovec_copy(iov, iov_cnt, false);
+
+	ret = z_impl_k_pipe_putv((struct k_pipe *)pipe, iov_copy, iov_cnt,
+				 bytes_written, min_xfer, timeout);
+
+	k_free(iov_copy);
+
+	return ret;
+}
+#include <syscalls/k_pipe_putv_mrsh.c>
+#endif
+
 static int pipe_get_internal(k_spinlock_key_t key, struct k_pipe *pipe,
-			     void *data, size_t bytes_to_read,
-			     size_t *bytes_read, size_t min_xfer,
-			     k_timeout_t timeout)
+			     const struct k_pipe_iovec *iov, size_t iov_cnt,
+			     size_t bytes_to_read, size_t *bytes_read,
+			     size_t min_xfer, k_timeout_t timeout)
 {
 	sys_dlist_t         src_list;
 	struct _pipe_desc   pipe_desc[2];
@@ -532,9 +696,7 @@ static int pipe_get_internal(k_spinlock_key_t key, struct k_pipe *pipe,
 
 	dest_desc = &_current->pipe_desc;
 
-	dest_desc->buffer = data;
-	dest_desc->bytes_to_xfer = bytes_to_read;
-	dest_desc->thread = _current;
+	pipe_desc_init(dest_desc, iov, iov_cnt, bytes_to_read);
 
 	src_desc = (struct _pipe_desc *)sys_dlist_get(&src_list);
 	while (src_desc != NULL) {
@@ -562,7 +724,7 @@ static int pipe_get_internal(k_spinlock_key_t key, struct k_pipe *pipe,
 			if (pipe->read_index >= pipe->size) {
 				pipe->read_index -= pipe->size;
 			}
-		} else if (src_desc->bytes_to_xfer == 0U) {
+		} else if (pipe_desc_bytes(src_desc) == 0U) {
 
 			/* The thread's write request has been satisfied. */
 
@@ -570,7 +732,17 @@ static int pipe_get_internal(k_spinlock_key_t key, struct k_pipe *pipe,
 
 			reschedule_needed = true;
 		}
-		src_desc = (struct _pipe_desc *)sys_dlist_get(&src_list);
+
+		/*
+		 * Stay on this source while both it and the receive
+		 * buffer have segments left.
+		 */
+
+		if (!pipe_desc_segment_next(dest_desc) ||
+		    !pipe_desc_segment_next(src_desc)) {
+			src_desc = (struct _pipe_desc *)
+				   sys_dlist_get(&src_list);
+		}
 	}
 
 	if (pipe->bytes_used != pipe->size) {
@@ -626,9 +798,9 @@ static int pipe_get_internal(k_spinlock_key_t key, struct k_pipe *pipe,
 
 	z_sched_wait(&pipe->lock, key, &pipe->wait_q.readers, timeout, NULL);
 
-	*bytes_read = bytes_to_read - dest_desc->bytes_to_xfer;
+	*bytes_read = bytes_to_read - pipe_desc_bytes(dest_desc);
 
-	int ret = pipe_return_code(min_xfer, dest_desc->bytes_to_xfer,
+	int ret = pipe_return_code(min_xfer, pipe_desc_bytes(dest_desc),
 				   bytes_to_read);
 
 	return ret;
@@ -637,6 +809,9 @@ static int pipe_get_internal(k_spinlock_key_t key, struct k_pipe *pipe,
 int z_impl_k_pipe_get(struct k_pipe *pipe, void *data, size_t bytes_to_read,
 		     size_t *bytes_read, size_t min_xfer, k_timeout_t timeout)
 {
+	struct k_pipe_iovec vec = { .iov_base = data,
+				    .iov_len = bytes_to_read };
+
 	__ASSERT(((arch_is_in_isr() == false) ||
 		  K_TIMEOUT_EQ(timeout, K_NO_WAIT)), "");
 
@@ -651,8 +826,8 @@ int z_impl_k_pipe_get(struct k_pipe *pipe, void *data, size_t bytes_to_read,
 
 	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
 
-	int ret = pipe_get_internal(key, pipe, data, bytes_to_read, bytes_read,
-				    min_xfer, timeout);
+	int ret = pipe_get_internal(key, pipe, &vec, 1U, bytes_to_read,
+				    bytes_read, min_xfer, timeout);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, get, pipe, timeout, ret);
 
@@ -674,6 +849,61 @@ int z_vrfy_k_pipe_get(struct k_pipe *pipe, void *data, size_t bytes_to_read,
 #include <syscalls/k_pipe_get_mrsh.c>
 #endif
 
+int z_impl_k_pipe_getv(struct k_pipe *pipe, const struct k_pipe_iovec *iov,
+		       size_t iov_cnt, size_t *bytes_read, size_t min_xfer,
+		       k_timeout_t timeout)
+{
+	size_t bytes_to_read;
+	int ret;
+
+	__ASSERT(((arch_is_in_isr() == false) ||
+		  K_TIMEOUT_EQ(timeout, K_NO_WAIT)), "");
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_pipe, get, pipe, timeout);
+
+	ret = pipe_iovec_bytes(iov, iov_cnt, &bytes_to_read);
+
+	CHECKIF((ret != 0) || (min_xfer > bytes_to_read) ||
+		bytes_read == NULL) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, get, pipe,
+					       timeout, -EINVAL);
+
+		return -EINVAL;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	ret = pipe_get_internal(key, pipe, iov, iov_cnt, bytes_to_read,
+				bytes_read, min_xfer, timeout);
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, get, pipe, timeout, ret);
+
+	return ret;
+}
+
+#ifdef CONFIG_USERSPACE
+int z_vrfy_k_pipe_getv(struct k_pipe *pipe, const struct k_pipe_iovec *iov,
+		       size_t iov_cnt, size_t *bytes_read, size_t min_xfer,
+		       k_timeout_t timeout)
+{
+	struct k_pipe_iovec *iov_copy;
+	int ret;
+
+	Z_OOPS(Z_SYSCALL_OBJ(pipe, K_OBJ_PIPE));
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(bytes_read, sizeof(*bytes_read)));
+
+	iov_copy = pipe_iovec_copy(iov, iov_cnt, true);
+
+	ret = z_impl_k_pipe_getv((struct k_pipe *)pipe, iov_copy, iov_cnt,
+				 bytes_read, min_xfer, timeout);
+
+	k_free(iov_copy);
+
+	return ret;
+}
+#include <syscalls/k_pipe_getv_mrsh.c>
+#endif
+
 size_t z_impl_k_pipe_read_avail(struct k_pipe *pipe)
 {
 	size_t res;
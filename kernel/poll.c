@@ -34,10 +34,11 @@
  */
 static struct k_spinlock lock;
 
-enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED };
+enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED, MODE_SET };
 
 static int signal_poller(struct k_poll_event *event, uint32_t state);
 static int signal_triggered_work(struct k_poll_event *event, uint32_t status);
+static void signal_poll_set(struct k_poll_event *event, uint32_t state);
 
 void k_poll_event_init(struct k_poll_event *event, uint32_t type,
 		       int mode, void *obj)
@@ -113,17 +114,25 @@ static inline void add_event(sys_dlist_t *events, struct k_poll_event *event,
 {
 	struct k_poll_event *pending;
 
+	/* Poll sets have no thread, hence no priority: they queue last */
+	if (poller->mode == MODE_SET) {
+		sys_dlist_append(events, &event->_node);
+		return;
+	}
+
 	pending = (struct k_poll_event *)sys_dlist_peek_tail(events);
 	if ((pending == NULL) ||
-		(z_sched_prio_cmp(poller_thread(pending->poller),
-							   poller_thread(poller)) > 0)) {
+		((pending->poller->mode != MODE_SET) &&
+		 (z_sched_prio_cmp(poller_thread(pending->poller),
+							   poller_thread(poller)) > 0))) {
 		sys_dlist_append(events, &event->_node);
 		return;
 	}
 
 	SYS_DLIST_FOR_EACH_CONTAINER(events, pending, _node) {
-		if (z_sched_prio_cmp(poller_thread(poller),
-					poller_thread(pending->poller)) > 0) {
+		if ((pending->poller->mode == MODE_SET) ||
+		    (z_sched_prio_cmp(poller_thread(poller),
+					poller_thread(pending->poller)) > 0)) {
 			sys_dlist_insert(&pending->_node, &event->_node);
 			return;
 		}
@@ -447,6 +456,11 @@ static int signal_poll_event(struct k_poll_event *event, uint32_t state)
 	int retcode = 0;
 
 	if (poller != NULL) {
+		if (poller->mode == MODE_SET) {
+			signal_poll_set(event, state);
+			return 0;
+		}
+
 		if (poller->mode == MODE_POLL) {
 			retcode = signal_poller(event, state);
 		} else if (poller->mode == MODE_TRIGGERED) {
@@ -813,3 +827,132 @@ int k_work_poll_cancel(struct k_work_poll *work)
 
 	return retval;
 }
+
+/* must be called with interrupts locked */
+static void signal_poll_set(struct k_poll_event *event, uint32_t state)
+{
+	struct k_poll_set *set = CONTAINER_OF(event->poller,
+					      struct k_poll_set, poller);
+
+	/* The event was unlinked from its object by the signaler, it stays
+	 * part of the set until harvested by k_poll_set_wait().
+	 */
+	event->state |= state;
+	sys_dlist_append(&set->ready, &event->_node);
+	(void) z_sched_wake(&set->wait_q, 0, NULL);
+}
+
+/* must be called with interrupts locked */
+static void poll_set_rearm(struct k_poll_set *set)
+{
+	struct k_poll_event *event;
+	uint32_t state;
+
+	while ((event = (struct k_poll_event *)sys_dlist_get(&set->rearm))
+	       != NULL) {
+		event->state = K_POLL_STATE_NOT_READY;
+		if (is_condition_met(event, &state)) {
+			event->state = state;
+			sys_dlist_append(&set->ready, &event->_node);
+		} else {
+			register_event(event, &set->poller);
+		}
+	}
+}
+
+void k_poll_set_init(struct k_poll_set *set)
+{
+	sys_dlist_init(&set->ready);
+	sys_dlist_init(&set->rearm);
+	z_waitq_init(&set->wait_q);
+	set->poller.is_polling = true;
+	set->poller.mode = MODE_SET;
+}
+
+int k_poll_set_add(struct k_poll_set *set, struct k_poll_event *event)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	uint32_t state;
+
+	if (event->poller != NULL) {
+		k_spin_unlock(&lock, key);
+		return -EBUSY;
+	}
+
+	event->state = K_POLL_STATE_NOT_READY;
+	if (!is_condition_met(event, &state)) {
+		register_event(event, &set->poller);
+		k_spin_unlock(&lock, key);
+		return 0;
+	}
+
+	event->poller = &set->poller;
+	signal_poll_set(event, state);
+	z_reschedule(&lock, key);
+
+	return 0;
+}
+
+int k_poll_set_remove(struct k_poll_set *set, struct k_poll_event *event)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (event->poller != &set->poller) {
+		k_spin_unlock(&lock, key);
+		return -EINVAL;
+	}
+
+	/* The event is linked either to its object, or to one of the lists
+	 * of the set.
+	 */
+	if (sys_dnode_is_linked(&event->_node)) {
+		sys_dlist_remove(&event->_node);
+	}
+	event->poller = NULL;
+
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+int k_poll_set_wait(struct k_poll_set *set, struct k_poll_event **ready,
+		    int max, k_timeout_t timeout)
+{
+	int64_t now, end = sys_clock_timeout_end_calc(timeout);
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct k_poll_event *event;
+	int num_ready = 0;
+
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+	__ASSERT(max > 0, "no room for ready events\n");
+
+	poll_set_rearm(set);
+
+	while (sys_dlist_is_empty(&set->ready)) {
+		if (!K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+			now = sys_clock_tick_get();
+			if ((end - now) <= 0) {
+				k_spin_unlock(&lock, key);
+				return -EAGAIN;
+			}
+			timeout = K_TICKS(end - now);
+		}
+
+		/* Another waiter may harvest the events first, check again */
+		(void) z_pend_curr(&lock, key, &set->wait_q, timeout);
+		key = k_spin_lock(&lock);
+	}
+
+	while (num_ready < max) {
+		event = (struct k_poll_event *)sys_dlist_get(&set->ready);
+		if (event == NULL) {
+			break;
+		}
+		sys_dlist_append(&set->rearm, &event->_node);
+		ready[num_ready++] = event;
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return num_ready;
+}
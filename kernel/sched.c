@@ -41,6 +41,14 @@ static ALWAYS_INLINE void z_priq_mq_add(struct _priq_mq *pq,
 					struct k_thread *thread);
 static ALWAYS_INLINE void z_priq_mq_remove(struct _priq_mq *pq,
 					   struct k_thread *thread);
+#elif defined(CONFIG_SCHED_BITMAP)
+#define _priq_run_add		z_priq_bm_add
+#define _priq_run_remove	z_priq_bm_remove
+#define _priq_run_best		z_priq_bm_best
+static ALWAYS_INLINE void z_priq_bm_add(struct _priq_bm *pq,
+					struct k_thread *thread);
+static ALWAYS_INLINE void z_priq_bm_remove(struct _priq_bm *pq,
+					   struct k_thread *thread);
 #endif
 
 #if defined(CONFIG_WAITQ_SCALABLE)
@@ -56,6 +64,8 @@ static ALWAYS_INLINE void z_priq_mq_remove(struct _priq_mq *pq,
 struct k_spinlock sched_spinlock;
 
 static void update_cache(int preempt_ok);
+static void ready_thread(struct k_thread *thread);
+static bool thread_active_elsewhere(struct k_thread *thread);
 static void end_thread(struct k_thread *thread);
 
 
@@ -210,6 +220,8 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 	cpu = m == 0 ? 0 : u32_count_trailing_zeros(m);
 
 	return &_kernel.cpus[cpu].ready_q.runq;
+#elif defined(CONFIG_SCHED_CPU_RUNQ)
+	return &_kernel.cpus[thread->base.runq_cpu].ready_q.runq;
 #else
 	return &_kernel.ready_q.runq;
 #endif
@@ -217,27 +229,172 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 
 static ALWAYS_INLINE void *curr_cpu_runq(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#ifdef CONFIG_SCHED_CPU_READY_QUEUES
 	return &arch_curr_cpu()->ready_q.runq;
 #else
 	return &_kernel.ready_q.runq;
 #endif
 }
 
+#ifdef CONFIG_SCHED_CPU_RUNQ
+static ALWAYS_INLINE bool runq_cpu_allowed(struct k_thread *thread, int cpu)
+{
+#ifdef CONFIG_SCHED_CPU_MASK
+	return (thread->base.cpu_mask & BIT(cpu)) != 0;
+#else
+	ARG_UNUSED(thread);
+	ARG_UNUSED(cpu);
+	return true;
+#endif
+}
+
+/* Queued threads plus one if the CPU is running something other
+ * than its idle thread
+ */
+static ALWAYS_INLINE uint32_t runq_cpu_load(int cpu)
+{
+	struct k_thread *curr = _kernel.cpus[cpu].current;
+	uint32_t load = _kernel.cpus[cpu].ready_q.nr_ready;
+
+	if ((curr != NULL) && !z_is_idle_thread_object(curr)) {
+		load++;
+	}
+	return load;
+}
+
+/* Selects the CPU whose run queue a thread becoming runnable goes
+ * to: the one it last ran on if still allowed, otherwise the least
+ * loaded allowed CPU.
+ */
+static ALWAYS_INLINE int runq_target_cpu(struct k_thread *thread)
+{
+	int cpu = thread->base.runq_cpu;
+	uint32_t load = UINT32_MAX;
+
+	if ((cpu != Z_SCHED_RUNQ_CPU_NONE) && runq_cpu_allowed(thread, cpu)) {
+		return cpu;
+	}
+
+	cpu = -1;
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		if (runq_cpu_allowed(thread, i) && (runq_cpu_load(i) < load)) {
+			cpu = i;
+			load = runq_cpu_load(i);
+		}
+	}
+
+	/* Legal per the API to ready a thread with an empty mask, see
+	 * the PIN_ONLY case in thread_runq()
+	 */
+	return cpu < 0 ? 0 : cpu;
+}
+#endif
+
 static ALWAYS_INLINE void runq_add(struct k_thread *thread)
 {
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	thread->base.runq_cpu = runq_target_cpu(thread);
+	_kernel.cpus[thread->base.runq_cpu].ready_q.nr_ready++;
+#endif
 	_priq_run_add(thread_runq(thread), thread);
 }
 
 static ALWAYS_INLINE void runq_remove(struct k_thread *thread)
 {
 	_priq_run_remove(thread_runq(thread), thread);
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	_kernel.cpus[thread->base.runq_cpu].ready_q.nr_ready--;
+#endif
+}
+
+#ifdef CONFIG_SCHED_SOFT_AFFINITY
+/* Given the best runnable thread, returns the first thread of the
+ * same priority behind it that last ran on this CPU, or the thread
+ * itself if there is none.  Only threads tied with the best one are
+ * candidates, so this never inverts priorities: a thread is moved
+ * off the CPU it last ran on only when this CPU has nothing at least
+ * as important of its own to run.
+ */
+static ALWAYS_INLINE struct k_thread *runq_affine(sys_dlist_t *pq,
+						  struct k_thread *best)
+{
+	struct k_thread *thread;
+	uint8_t cpu = _current_cpu->id;
+
+	if ((best == NULL) || (best->base.cpu == cpu)) {
+		return best;
+	}
+
+	for (thread = SYS_DLIST_PEEK_NEXT_CONTAINER(pq, best, base.qnode_dlist);
+	     (thread != NULL) && (z_sched_prio_cmp(thread, best) == 0);
+	     thread = SYS_DLIST_PEEK_NEXT_CONTAINER(pq, thread, base.qnode_dlist)) {
+		if (thread->base.cpu != cpu) {
+			continue;
+		}
+#ifdef CONFIG_SCHED_CPU_MASK
+		if ((thread->base.cpu_mask & BIT(cpu)) == 0) {
+			continue;
+		}
+#endif
+		return thread;
+	}
+	return best;
 }
+#endif
 
 static ALWAYS_INLINE struct k_thread *runq_best(void)
 {
+#ifdef CONFIG_SCHED_SOFT_AFFINITY
+	return runq_affine(curr_cpu_runq(), _priq_run_best(curr_cpu_runq()));
+#else
 	return _priq_run_best(curr_cpu_runq());
+#endif
+}
+
+#ifdef CONFIG_SCHED_CPU_RUNQ
+/* Called when the local run queue is empty: returns the best thread
+ * this CPU may run from the run queue of the busiest peer, or NULL.
+ * When the busiest peer has nothing this CPU may run (e.g. all its
+ * threads are pinned elsewhere), the remaining peers are tried in
+ * decreasing order of load.  The thread stays queued there until
+ * next_up() dequeues it.
+ */
+static struct k_thread *runq_steal(void)
+{
+	uint32_t tried = BIT(_current_cpu->id);
+
+	for (int n = 1; n < CONFIG_MP_NUM_CPUS; n++) {
+		struct _ready_q *busiest = NULL;
+		struct k_thread *thread;
+		int busiest_cpu = 0;
+
+		for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+			struct _ready_q *rq = &_kernel.cpus[i].ready_q;
+
+			if (((tried & BIT(i)) != 0U) || (rq->nr_ready == 0U)) {
+				continue;
+			}
+			if ((busiest == NULL) ||
+			    (rq->nr_ready > busiest->nr_ready)) {
+				busiest = rq;
+				busiest_cpu = i;
+			}
+		}
+
+		if (busiest == NULL) {
+			break;
+		}
+
+		thread = _priq_run_best(&busiest->runq);
+		if (thread != NULL) {
+			return thread;
+		}
+		tried |= BIT(busiest_cpu);
+	}
+
+	return NULL;
 }
+#endif
 
 /* _current is never in the run queue until context switch on
  * SMP configurations, see z_requeue_current()
@@ -313,6 +470,12 @@ static ALWAYS_INLINE struct k_thread *next_up(void)
 {
 	struct k_thread *thread = runq_best();
 
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	if (thread == NULL) {
+		thread = runq_steal();
+	}
+#endif
+
 #if (CONFIG_NUM_METAIRQ_PRIORITIES > 0) && (CONFIG_NUM_COOP_PRIORITIES > 0)
 	/* MetaIRQs must always attempt to return back to a
 	 * cooperative thread they preempted and not whatever happens
@@ -385,6 +548,11 @@ static ALWAYS_INLINE struct k_thread *next_up(void)
 		dequeue_thread(thread);
 	}
 
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	/* Whether local or stolen, the thread now belongs to this CPU */
+	thread->base.runq_cpu = _current_cpu->id;
+#endif
+
 	_current_cpu->swap_ok = false;
 	return thread;
 #endif
@@ -404,10 +572,43 @@ static void move_thread_to_end_of_prio_q(struct k_thread *thread)
 static int slice_ticks;
 static int slice_max_prio;
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+static inline bool is_cbs(struct k_thread *thread)
+{
+	return thread->base.cbs_budget != 0;
+}
+
+/* Thread whose server budget the slice counter of each CPU charges */
+static struct k_thread *cbs_charged[CONFIG_MP_NUM_CPUS];
+
+/* Save the budget left to the thread charged on this CPU, curr is
+ * about to be charged instead.
+ */
+static void cbs_switch(struct k_thread *curr)
+{
+	struct k_thread **charged = &cbs_charged[_current_cpu->id];
+
+	if (*charged != NULL) {
+		int32_t left = _current_cpu->slice_ticks - sys_clock_elapsed();
+
+		/* Not yet seen as exhausted: the pending tick does it */
+		(*charged)->base.cbs_remaining = MAX(1, left);
+	}
+
+	*charged = is_cbs(curr) ? curr : NULL;
+}
+#endif
+
 static inline int slice_time(struct k_thread *curr)
 {
 	int ret = slice_ticks;
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	if (is_cbs(curr)) {
+		return curr->base.cbs_remaining;
+	}
+#endif
+
 #ifdef CONFIG_TIMESLICE_PER_THREAD
 	if (curr->base.slice_ticks != 0) {
 		ret = curr->base.slice_ticks;
@@ -427,6 +628,10 @@ static struct k_thread *pending_current;
 
 void z_reset_time_slice(struct k_thread *curr)
 {
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	cbs_switch(curr);
+#endif
+
 	/* Add the elapsed time since the last announced tick to the
 	 * slice count, as we'll see those "expired" ticks arrive in a
 	 * FUTURE z_time_slice() call.
@@ -476,13 +681,121 @@ static inline bool sliceable(struct k_thread *thread)
 	ret |= thread->base.slice_ticks != 0;
 #endif
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	ret |= is_cbs(thread);
+#endif
+
 	return ret;
 }
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+/* Start a new server period, with a full budget */
+static void cbs_new_period(struct k_thread *thread, uint32_t start)
+{
+	thread->base.cbs_remaining = thread->base.cbs_budget;
+	thread->base.prio_deadline =
+		start + k_ticks_to_cyc_ceil32(thread->base.cbs_period);
+}
+
+static void cbs_replenish(struct _timeout *timeout)
+{
+	struct k_thread *thread = CONTAINER_OF(timeout, struct k_thread,
+					       base.cbs_timeout);
+
+	LOCKED(&sched_spinlock) {
+		uint32_t now = k_cycle_get_32();
+		uint32_t end = thread->base.prio_deadline;
+
+		/* The next period starts where the previous one ended,
+		 * unless replenishment comes late
+		 */
+		cbs_new_period(thread, ((int32_t)(end - now) > 0) ? end : now);
+		thread->base.thread_state &= ~_THREAD_THROTTLED;
+		ready_thread(thread);
+	}
+}
+
+/* Throttle a thread that exhausted its budget until its deadline,
+ * where the next period starts.
+ */
+static void cbs_throttle_locked(struct k_thread *thread)
+{
+	int32_t left = thread->base.prio_deadline - k_cycle_get_32();
+	k_ticks_t delay = (left > 0) ? k_cyc_to_ticks_ceil32(left) : 0;
+
+	thread->base.cbs_remaining = 0;
+	cbs_charged[_current_cpu->id] = NULL;
+
+	if (z_is_thread_queued(thread)) {
+		dequeue_thread(thread);
+	}
+	thread->base.thread_state |= _THREAD_THROTTLED;
+	z_add_timeout(&thread->base.cbs_timeout, cbs_replenish,
+		      K_TICKS(delay));
+	update_cache(thread == _current);
+}
+
+/* Classic CBS wakeup rule: a thread becoming runnable keeps its
+ * deadline and budget only if running the remaining budget before the
+ * deadline would not exceed the server bandwidth.
+ */
+static void cbs_wakeup_locked(struct k_thread *thread)
+{
+	uint32_t now = k_cycle_get_32();
+	int32_t left = thread->base.prio_deadline - now;
+
+	if ((left <= 0) ||
+	    ((int64_t)thread->base.cbs_remaining * thread->base.cbs_period >
+	     (int64_t)k_cyc_to_ticks_floor32(left) * thread->base.cbs_budget)) {
+		cbs_new_period(thread, now);
+	}
+}
+
+int k_thread_cbs_set(k_tid_t thread, int32_t budget, int32_t period)
+{
+	if ((budget < 0) || ((budget != 0) && (period < budget))) {
+		return -EINVAL;
+	}
+
+	LOCKED(&sched_spinlock) {
+		bool throttled = (thread->base.thread_state &
+				  _THREAD_THROTTLED) != 0U;
+
+		(void)z_abort_timeout(&thread->base.cbs_timeout);
+		thread->base.thread_state &= ~_THREAD_THROTTLED;
+
+		thread->base.cbs_budget = budget;
+		thread->base.cbs_period = period;
+		if (budget != 0) {
+			cbs_new_period(thread, k_cycle_get_32());
+		}
+
+		if (z_is_thread_queued(thread)) {
+			dequeue_thread(thread);
+			queue_thread(thread);
+		} else if (throttled && !thread_active_elsewhere(thread)) {
+			ready_thread(thread);
+		}
+		if (thread == _current) {
+			z_reset_time_slice(thread);
+		}
+	}
+
+	return 0;
+}
+#endif /* CONFIG_SCHED_DEADLINE_CBS */
+
 static k_spinlock_key_t slice_expired_locked(k_spinlock_key_t sched_lock_key)
 {
 	struct k_thread *curr = _current;
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	if (is_cbs(curr)) {
+		cbs_throttle_locked(curr);
+		return sched_lock_key;
+	}
+#endif
+
 #ifdef CONFIG_TIMESLICE_PER_THREAD
 	if (curr->base.slice_expired) {
 		k_spin_unlock(&sched_spinlock, sched_lock_key);
@@ -612,6 +925,35 @@ static void flag_ipi(void)
 #endif
 }
 
+/* True if readying this thread requires other CPUs to reschedule */
+static bool ipi_needed(struct k_thread *thread)
+{
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	int currcpu = _current_cpu->id;
+
+	/* Only the CPU owning the queue picks the thread up, unless a
+	 * peer sits idle and can steal it from us.
+	 */
+	if (thread->base.runq_cpu != currcpu) {
+		return true;
+	}
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct k_thread *curr = _kernel.cpus[i].current;
+
+		/* CPUs not yet started have no current thread */
+		if ((i != currcpu) && (curr != NULL) &&
+		    z_is_idle_thread_object(curr)) {
+			return true;
+		}
+	}
+	return false;
+#else
+	ARG_UNUSED(thread);
+	return true;
+#endif
+}
+
 static void ready_thread(struct k_thread *thread)
 {
 #ifdef CONFIG_KERNEL_COHERENCE
@@ -624,9 +966,19 @@ static void ready_thread(struct k_thread *thread)
 	if (!z_is_thread_queued(thread) && z_is_thread_ready(thread)) {
 		SYS_PORT_TRACING_OBJ_FUNC(k_thread, sched_ready, thread);
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+		if (is_cbs(thread) && (thread != _current)) {
+			cbs_wakeup_locked(thread);
+		}
+#endif
+#ifdef CONFIG_THREAD_LATENCY_STATS
+		z_sched_latency_ready(thread);
+#endif
 		queue_thread(thread);
 		update_cache(0);
-		flag_ipi();
+		if (ipi_needed(thread)) {
+			flag_ipi();
+		}
 	}
 }
 
@@ -899,6 +1251,17 @@ bool z_set_prio(struct k_thread *thread, int prio)
 				thread->base.prio = prio;
 			}
 			update_cache(1);
+		} else if (z_is_thread_pending(thread) &&
+			   (thread->base.pended_on != NULL)) {
+			/* Keep the wait queue sorted, e.g. so a mutex
+			 * owner hands off to the waiter whose priority
+			 * was most recently raised by inheritance.
+			 */
+			_wait_q_t *wait_q = thread->base.pended_on;
+
+			_priq_wait_remove(&wait_q->waitq, thread);
+			thread->base.prio = prio;
+			z_priq_wait_add(&wait_q->waitq, thread);
 		} else {
 			thread->base.prio = prio;
 		}
@@ -1017,6 +1380,9 @@ struct k_thread *z_swap_next_thread(void)
 static inline void set_current(struct k_thread *new_thread)
 {
 	z_thread_mark_switched_out();
+#ifdef CONFIG_SMP
+	new_thread->base.cpu = _current_cpu->id;
+#endif
 	_current_cpu->current = new_thread;
 }
 
@@ -1242,6 +1608,68 @@ struct k_thread *z_priq_mq_best(struct _priq_mq *pq)
 	return thread;
 }
 
+#ifdef CONFIG_SCHED_BITMAP
+BUILD_ASSERT(Z_PRIQ_BM_WORDS <= 32, "Too many priorities for bitmap scheduler");
+
+static ALWAYS_INLINE void z_priq_bm_add(struct _priq_bm *pq,
+					struct k_thread *thread)
+{
+	int idx = thread->base.prio - K_HIGHEST_THREAD_PRIO;
+	sys_dlist_t *l = &pq->queues[idx];
+	sys_dnode_t *succ = NULL;
+
+#ifdef CONFIG_SCHED_DEADLINE
+	struct k_thread *t;
+
+	/* All threads in the list share a static priority, so this
+	 * only orders them by deadline.
+	 */
+	SYS_DLIST_FOR_EACH_CONTAINER(l, t, base.qnode_dlist) {
+		if (z_sched_prio_cmp(thread, t) > 0) {
+			succ = &t->base.qnode_dlist;
+			break;
+		}
+	}
+#endif
+
+	if (succ != NULL) {
+		sys_dlist_insert(succ, &thread->base.qnode_dlist);
+	} else {
+		sys_dlist_append(l, &thread->base.qnode_dlist);
+	}
+
+	pq->bitmap[idx / 32] |= BIT(idx % 32);
+	pq->summary |= BIT(idx / 32);
+}
+
+static ALWAYS_INLINE void z_priq_bm_remove(struct _priq_bm *pq,
+					   struct k_thread *thread)
+{
+	int idx = thread->base.prio - K_HIGHEST_THREAD_PRIO;
+
+	sys_dlist_remove(&thread->base.qnode_dlist);
+	if (sys_dlist_is_empty(&pq->queues[idx])) {
+		pq->bitmap[idx / 32] &= ~BIT(idx % 32);
+		if (pq->bitmap[idx / 32] == 0U) {
+			pq->summary &= ~BIT(idx / 32);
+		}
+	}
+}
+
+struct k_thread *z_priq_bm_best(struct _priq_bm *pq)
+{
+	if (pq->summary == 0U) {
+		return NULL;
+	}
+
+	int word = __builtin_ctz(pq->summary);
+	int idx = (word * 32) + __builtin_ctz(pq->bitmap[word]);
+	sys_dnode_t *n = sys_dlist_peek_head_not_empty(&pq->queues[idx]);
+
+	return CONTAINER_OF(n, struct k_thread, base.qnode_dlist);
+}
+#endif
+
 int z_unpend_all(_wait_q_t *wait_q)
 {
 	int need_sched = 0;
@@ -1265,17 +1693,28 @@ void init_ready_q(struct _ready_q *rq)
 		}
 	};
 #elif defined(CONFIG_SCHED_MULTIQ)
-	for (int i = 0; i < ARRAY_SIZE(_kernel.ready_q.runq.queues); i++) {
+	for (int i = 0; i < ARRAY_SIZE(rq->runq.queues); i++) {
 		sys_dlist_init(&rq->runq.queues[i]);
 	}
+#elif defined(CONFIG_SCHED_BITMAP)
+	for (int i = 0; i < ARRAY_SIZE(rq->runq.queues); i++) {
+		sys_dlist_init(&rq->runq.queues[i]);
+	}
+	for (int i = 0; i < ARRAY_SIZE(rq->runq.bitmap); i++) {
+		rq->runq.bitmap[i] = 0U;
+	}
+	rq->runq.summary = 0U;
 #else
 	sys_dlist_init(&rq->runq);
 #endif
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	rq->nr_ready = 0U;
+#endif
 }
 
 void z_sched_init(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#ifdef CONFIG_SCHED_CPU_READY_QUEUES
 	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
 		init_ready_q(&_kernel.cpus[i].ready_q);
 	}
@@ -1688,6 +2127,9 @@ static void end_thread(struct k_thread *thread)
 			unpend_thread_no_timeout(thread);
 		}
 		(void)z_abort_thread_timeout(thread);
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+		(void)z_abort_timeout(&thread->base.cbs_timeout);
+#endif
 		unpend_all(&thread->join_queue);
 		update_cache(1);
 
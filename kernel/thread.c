@@ -275,8 +275,8 @@ const char *k_thread_state_str(k_tid_t thread_id, char *buf, size_t buf_size)
 	uint8_t     thread_state = thread_id->base.thread_state;
 	static const char  *states_str[8] = {"dummy", "pending", "prestart",
 					     "dead", "suspended", "aborting",
-					     "", "queued"};
-	static const size_t states_sz[8] = {5, 7, 8, 4, 9, 8, 0, 6};
+					     "throttled", "queued"};
+	static const size_t states_sz[8] = {5, 7, 8, 4, 9, 8, 9, 6};
 
 	if ((buf == NULL) || (buf_size == 0)) {
 		return "";
@@ -514,6 +514,9 @@ static char *setup_thread_stack(struct k_thread *new_thread,
 	new_thread->stack_info.start = (uintptr_t)stack_buf_start;
 	new_thread->stack_info.size = stack_buf_size;
 	new_thread->stack_info.delta = delta;
+#ifdef CONFIG_THREAD_ANALYZER_WATERMARK
+	new_thread->stack_info.watermark = 0U;
+#endif
 #endif
 	stack_ptr -= delta;
 
@@ -543,6 +546,9 @@ char *z_setup_new_thread(struct k_thread *new_thread,
 	z_object_init(stack);
 	new_thread->stack_obj = stack;
 	new_thread->syscall_frame = NULL;
+#ifdef CONFIG_OBJ_VALIDATION_CACHE
+	(void)memset(&new_thread->obj_cache, 0, sizeof(new_thread->obj_cache));
+#endif
 
 	/* Any given thread has access to itself */
 	k_object_access_grant(new_thread, new_thread);
@@ -607,6 +613,10 @@ char *z_setup_new_thread(struct k_thread *new_thread,
 		new_thread->base.cpu_mask = -1; /* allow all cpus */
 	}
 #endif
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	/* No affinity yet, first queueing picks the least loaded CPU */
+	new_thread->base.runq_cpu = Z_SCHED_RUNQ_CPU_NONE;
+#endif
 #ifdef CONFIG_ARCH_HAS_CUSTOM_SWAP_TO_MAIN
 	/* _current may be null if the dummy thread is not used */
 	if (!_current) {
@@ -632,6 +642,12 @@ char *z_setup_new_thread(struct k_thread *new_thread,
 		CONFIG_SCHED_THREAD_USAGE_AUTO_ENABLE;
 #endif
 
+#ifdef CONFIG_THREAD_LATENCY_STATS
+	new_thread->base.ready_stamp = 0U;
+	new_thread->base.run_stamp = 0U;
+	new_thread->base.latency = (struct k_thread_latency_stats) {};
+#endif
+
 	SYS_PORT_TRACING_OBJ_FUNC(k_thread, create, new_thread);
 
 	return stack_ptr;
@@ -802,6 +818,7 @@ void z_init_thread_base(struct _thread_base *thread_base, int priority,
 
 #ifdef CONFIG_SMP
 	thread_base->is_idle = 0;
+	thread_base->cpu = Z_THREAD_CPU_NONE;
 #endif
 
 #ifdef CONFIG_TIMESLICE_PER_THREAD
@@ -809,6 +826,11 @@ void z_init_thread_base(struct _thread_base *thread_base, int priority,
 	thread_base->slice_expired = NULL;
 #endif
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	thread_base->cbs_budget = 0;
+	z_init_timeout(&thread_base->cbs_timeout);
+#endif
+
 	/* swap_data does not need to be initialized */
 
 	z_init_thread_timeout(thread_base);
@@ -1045,6 +1067,9 @@ void z_thread_mark_switched_in(void)
 #if defined(CONFIG_SCHED_THREAD_USAGE) && !defined(CONFIG_USE_SWITCH)
 	z_sched_usage_start(_current);
 #endif
+#if defined(CONFIG_THREAD_LATENCY_STATS) && !defined(CONFIG_USE_SWITCH)
+	z_sched_latency_start(_current);
+#endif
 
 #ifdef CONFIG_TRACING
 	SYS_PORT_TRACING_FUNC(k_thread, switched_in);
@@ -1053,6 +1078,9 @@ void z_thread_mark_switched_in(void)
 
 void z_thread_mark_switched_out(void)
 {
+#if defined(CONFIG_THREAD_LATENCY_STATS) && !defined(CONFIG_USE_SWITCH)
+	z_sched_latency_stop(_current);
+#endif
 #if defined(CONFIG_SCHED_THREAD_USAGE) && !defined(CONFIG_USE_SWITCH)
 	z_sched_usage_stop();
 #endif
@@ -1105,6 +1133,9 @@ int k_thread_runtime_stats_all_get(k_thread_runtime_stats_t *stats)
 		stats->average_cycles   += tmp_stats.average_cycles;
 #endif
 		stats->idle_cycles      += tmp_stats.idle_cycles;
+#ifdef CONFIG_SMP
+		stats->migrations       += tmp_stats.migrations;
+#endif
 	}
 #endif
 
@@ -11,16 +11,35 @@
 #include <zephyr/syscall_handler.h>
 #include <zephyr/drivers/timer/system_timer.h>
 #include <zephyr/sys_clock.h>
+#include <zephyr/sys/math_extras.h>
+
+#ifdef CONFIG_SYS_CLOCK_TICKS_ARE_HW_CYCLES
+/* May be overridden by a SoC default for the tick rate */
+BUILD_ASSERT(CONFIG_SYS_CLOCK_TICKS_PER_SEC == CONFIG_SYS_CLOCK_HW_CYCLES_PER_SEC,
+	     "CONFIG_SYS_CLOCK_TICKS_PER_SEC must equal CONFIG_SYS_CLOCK_HW_CYCLES_PER_SEC");
+#endif
 
 static uint64_t curr_tick;
 
+#ifndef CONFIG_TIMEOUT_QUEUE_WHEEL
 static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
+#endif
 
 static struct k_spinlock timeout_lock;
 
 #define MAX_WAIT (IS_ENABLED(CONFIG_SYSTEM_CLOCK_SLOPPY_IDLE) \
 		  ? K_TICKS_FOREVER : INT_MAX)
 
+#ifdef CONFIG_TIMEOUT_BATCH_EXPIRY
+/* Most timeouts detached from the queue in one lock hold */
+#define EXPIRY_BATCH 16
+
+/* Set while sys_clock_announce() runs expired handlers, the timer
+ * gets reprogrammed once they are all done
+ */
+static bool announce_batching;
+#endif
+
 /* Cycles left to process in the currently-executing sys_clock_announce() */
 static int announce_remaining;
 
@@ -36,6 +55,345 @@ static inline int z_vrfy_sys_clock_hw_cycles_per_sec_runtime_get(void)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME */
 
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+/*
+ * Hierarchical timing wheel.  Level N has WHEEL_SLOTS slots each
+ * covering WHEEL_SLOTS^N ticks.  A queued timeout holds its absolute
+ * expiry in dticks and sits on the lowest level whose span covers its
+ * distance from wheel_tick.  When wheel_tick reaches the start of a
+ * slot's range the slot is cascaded, i.e. its timeouts move down to
+ * finer levels, so a level 0 slot only ever holds timeouts expiring
+ * at exactly that tick.  Timeouts too far out for the top level wait
+ * on an unsorted overflow list.
+ *
+ * Slot list heads are only valid while their bit is set in
+ * wheel_used, which is kept exact so the next event can be found
+ * with a bit scan instead of walking empty slots.
+ */
+#define WHEEL_BITS	6
+#define WHEEL_SLOTS	BIT(WHEEL_BITS)
+#define WHEEL_MASK	(WHEEL_SLOTS - 1)
+#define WHEEL_LEVELS	CONFIG_TIMEOUT_WHEEL_LEVELS
+#define WHEEL_SHIFT(lvl) ((lvl) * WHEEL_BITS)
+#define WHEEL_SPAN	((int64_t)BIT64(WHEEL_SHIFT(WHEEL_LEVELS)))
+
+static sys_dlist_t wheel[WHEEL_LEVELS][WHEEL_SLOTS];
+static uint64_t wheel_used[WHEEL_LEVELS];
+static sys_dlist_t wheel_overflow = SYS_DLIST_STATIC_INIT(&wheel_overflow);
+
+/* Soonest expiry on the overflow list, rescanned when invalid */
+static int64_t overflow_min;
+static bool overflow_min_valid;
+
+/* Tick up to which all cascades have been done, follows curr_tick */
+static int64_t wheel_tick;
+
+/* Cached soonest expiry over the whole wheel, when valid */
+static int64_t wheel_next;
+static bool wheel_next_valid;
+
+/* Returns the level * WHEEL_SLOTS + slot index of a wheel list head,
+ * or -1 if the node is not one
+ */
+static int wheel_head_index(sys_dnode_t *n)
+{
+	uintptr_t off = (uintptr_t)n - (uintptr_t)&wheel[0][0];
+
+	if (off >= sizeof(wheel)) {
+		return -1;
+	}
+	return off / sizeof(sys_dlist_t);
+}
+
+static void wheel_insert(struct _timeout *to)
+{
+	int64_t delta = to->dticks - wheel_tick;
+	sys_dlist_t *list;
+
+	if (delta >= WHEEL_SPAN) {
+		if (sys_dlist_is_empty(&wheel_overflow)) {
+			overflow_min = to->dticks;
+			overflow_min_valid = true;
+		} else if (to->dticks < overflow_min) {
+			overflow_min = to->dticks;
+		}
+		list = &wheel_overflow;
+	} else {
+		int lvl = (delta <= 0) ? 0 :
+			  (63 - u64_count_leading_zeros(delta)) / WHEEL_BITS;
+		int slot = (to->dticks >> WHEEL_SHIFT(lvl)) & WHEEL_MASK;
+
+		list = &wheel[lvl][slot];
+		if ((wheel_used[lvl] & BIT64(slot)) == 0U) {
+			sys_dlist_init(list);
+			wheel_used[lvl] |= BIT64(slot);
+		}
+	}
+
+	sys_dlist_append(list, &to->node);
+
+	if (wheel_next_valid && (to->dticks < wheel_next)) {
+		wheel_next = to->dticks;
+	}
+}
+
+static void remove_timeout(struct _timeout *t)
+{
+	/* Last entry of its list: both neighbours are the list head */
+	if (t->node.next == t->node.prev) {
+		int idx = wheel_head_index(t->node.next);
+
+		if (idx >= 0) {
+			wheel_used[idx / WHEEL_SLOTS] &=
+				~BIT64(idx % WHEEL_SLOTS);
+		}
+	}
+
+	if (t->dticks == wheel_next) {
+		wheel_next_valid = false;
+	}
+	if (t->dticks == overflow_min) {
+		overflow_min_valid = false;
+	}
+
+	sys_dlist_remove(&t->node);
+}
+
+/* Soonest expiry on the (non-empty) overflow list */
+static int64_t overflow_first(void)
+{
+	struct _timeout *t;
+
+	if (!overflow_min_valid) {
+		overflow_min = INT64_MAX;
+		SYS_DLIST_FOR_EACH_CONTAINER(&wheel_overflow, t, node) {
+			overflow_min = MIN(overflow_min, t->dticks);
+		}
+		overflow_min_valid = true;
+	}
+
+	return overflow_min;
+}
+
+/* Next tick after wheel_tick at which an used slot of the level gets
+ * visited, or -1 if the level is empty.
+ */
+static int64_t wheel_level_next(int lvl)
+{
+	uint64_t used = wheel_used[lvl];
+	int64_t granule = (wheel_tick >> WHEEL_SHIFT(lvl)) + 1;
+	unsigned int rot = granule & WHEEL_MASK;
+
+	if (used == 0U) {
+		return -1;
+	}
+
+	if (rot != 0U) {
+		used = (used >> rot) | (used << (WHEEL_SLOTS - rot));
+	}
+	granule += u64_count_trailing_zeros(used);
+
+	return granule << WHEEL_SHIFT(lvl);
+}
+
+/* Next tick after wheel_tick at which wheel_advance() has work to
+ * do, or -1 if the wheel is empty
+ */
+static int64_t wheel_next_event(void)
+{
+	int64_t ret = -1;
+
+	for (int lvl = 0; lvl < WHEEL_LEVELS; lvl++) {
+		int64_t t = wheel_level_next(lvl);
+
+		if ((t >= 0) && ((ret < 0) || (t < ret))) {
+			ret = t;
+		}
+	}
+
+	if (!sys_dlist_is_empty(&wheel_overflow)) {
+		int64_t t = MAX(overflow_first() - WHEEL_SPAN + 1,
+				wheel_tick + 1);
+
+		if ((ret < 0) || (t < ret)) {
+			ret = t;
+		}
+	}
+
+	return ret;
+}
+
+static void wheel_requeue(sys_dlist_t *list)
+{
+	sys_dlist_t pending;
+	sys_dnode_t *n;
+
+	/* Detach the whole list first, wheel_insert() may append to
+	 * the very same head when requeueing the overflow list
+	 */
+	sys_dlist_init(&pending);
+	while ((n = sys_dlist_get(list)) != NULL) {
+		sys_dlist_append(&pending, n);
+	}
+
+	while ((n = sys_dlist_get(&pending)) != NULL) {
+		wheel_insert(CONTAINER_OF(n, struct _timeout, node));
+	}
+}
+
+/* Moves wheel_tick forward to tick, which must not skip past an
+ * event, cascading slots whose range starts there.
+ */
+static void wheel_advance(int64_t tick)
+{
+	wheel_tick = tick;
+
+	/* Entries still out of range go back to the overflow list,
+	 * which recomputes its minimum
+	 */
+	if (!sys_dlist_is_empty(&wheel_overflow) &&
+	    (tick > overflow_first() - WHEEL_SPAN)) {
+		wheel_requeue(&wheel_overflow);
+	}
+
+	for (int lvl = WHEEL_LEVELS - 1; lvl > 0; lvl--) {
+		int slot = (tick >> WHEEL_SHIFT(lvl)) & WHEEL_MASK;
+
+		if (((tick & BIT64_MASK(WHEEL_SHIFT(lvl))) == 0U) &&
+		    ((wheel_used[lvl] & BIT64(slot)) != 0U)) {
+			wheel_used[lvl] &= ~BIT64(slot);
+			wheel_requeue(&wheel[lvl][slot]);
+		}
+	}
+}
+
+/* Removes and returns a timeout expiring at or before tick, advancing
+ * wheel_tick to its expiry.  Returns NULL with wheel_tick advanced to
+ * tick if there is none.
+ */
+static struct _timeout *wheel_pop(int64_t tick)
+{
+	for (;;) {
+		int slot = wheel_tick & WHEEL_MASK;
+
+		if ((wheel_used[0] & BIT64(slot)) != 0U) {
+			sys_dnode_t *n = sys_dlist_peek_head(&wheel[0][slot]);
+			struct _timeout *t = CONTAINER_OF(n, struct _timeout,
+							  node);
+
+			remove_timeout(t);
+			return t;
+		}
+
+		int64_t next = wheel_next_event();
+
+		if ((next < 0) || (next > tick)) {
+			wheel_tick = MAX(wheel_tick, tick);
+			return NULL;
+		}
+		wheel_advance(next);
+	}
+}
+
+#ifdef CONFIG_TIMEOUT_BATCH_EXPIRY
+/* Unlinks up to EXPIRY_BATCH timeouts expiring on the soonest tick, if
+ * that is within ticks of curr_tick, into batch and stores their number
+ * in count.  Returns the distance from curr_tick to that tick, or -1 if
+ * nothing is due.
+ */
+static int detach_expired(struct _timeout **batch, int *count, int32_t ticks)
+{
+	struct _timeout *t = wheel_pop(curr_tick + ticks);
+	int64_t expiry;
+	int n = 0;
+
+	if (t == NULL) {
+		return -1;
+	}
+
+	expiry = t->dticks;
+	do {
+		t->dticks = Z_TIMEOUT_EXPIRED_DTICKS;
+		batch[n++] = t;
+	} while ((n < EXPIRY_BATCH) && ((t = wheel_pop(expiry)) != NULL));
+
+	*count = n;
+
+	return expiry - curr_tick;
+}
+#endif
+
+/* Soonest expiry of a queued timeout, or -1 if there is none */
+static int64_t wheel_first_expiry(void)
+{
+	if (wheel_next_valid) {
+		return wheel_next;
+	}
+
+	wheel_next = -1;
+
+	/* Due right now, seen during sys_clock_announce() */
+	if ((wheel_used[0] & BIT64(wheel_tick & WHEEL_MASK)) != 0U) {
+		wheel_next = wheel_tick;
+	} else {
+		wheel_next = wheel_level_next(0);
+	}
+
+	/* Later slots of a level expire strictly after its first used
+	 * one, so only that one needs scanning
+	 */
+	for (int lvl = 1; lvl < WHEEL_LEVELS; lvl++) {
+		int64_t start = wheel_level_next(lvl);
+		struct _timeout *t;
+
+		if (start < 0) {
+			continue;
+		}
+
+		int slot = (start >> WHEEL_SHIFT(lvl)) & WHEEL_MASK;
+
+		SYS_DLIST_FOR_EACH_CONTAINER(&wheel[lvl][slot], t, node) {
+			if ((wheel_next < 0) || (t->dticks < wheel_next)) {
+				wheel_next = t->dticks;
+			}
+		}
+	}
+
+	if (!sys_dlist_is_empty(&wheel_overflow) &&
+	    ((wheel_next < 0) || (overflow_first() < wheel_next))) {
+		wheel_next = overflow_first();
+	}
+
+	wheel_next_valid = true;
+	return wheel_next;
+}
+
+/* Queues a timeout whose dticks is relative to curr_tick, returns true
+ * if it became the soonest one
+ */
+static bool insert_timeout(struct _timeout *to)
+{
+	to->dticks += curr_tick;
+	wheel_insert(to);
+
+	return wheel_first_expiry() == to->dticks;
+}
+
+/* Ticks from curr_tick to the soonest expiry, or -1 if there is none */
+static int64_t first_dticks(void)
+{
+	int64_t expiry = wheel_first_expiry();
+
+	return (expiry < 0) ? -1 : (expiry - (int64_t)curr_tick);
+}
+
+static k_ticks_t queued_dticks(const struct _timeout *timeout)
+{
+	return timeout->dticks - curr_tick;
+}
+
+#else /* !CONFIG_TIMEOUT_QUEUE_WHEEL */
+
 static struct _timeout *first(void)
 {
 	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
@@ -59,6 +417,86 @@ static void remove_timeout(struct _timeout *t)
 	sys_dlist_remove(&t->node);
 }
 
+/* Queues a timeout whose dticks is relative to curr_tick, returns true
+ * if it became the soonest one
+ */
+static bool insert_timeout(struct _timeout *to)
+{
+	struct _timeout *t;
+
+	for (t = first(); t != NULL; t = next(t)) {
+		if (t->dticks > to->dticks) {
+			t->dticks -= to->dticks;
+			sys_dlist_insert(&t->node, &to->node);
+			break;
+		}
+		to->dticks -= t->dticks;
+	}
+
+	if (t == NULL) {
+		sys_dlist_append(&timeout_list, &to->node);
+	}
+
+	return to == first();
+}
+
+/* Ticks from curr_tick to the soonest expiry, or -1 if there is none */
+static int64_t first_dticks(void)
+{
+	struct _timeout *to = first();
+
+	return (to == NULL) ? -1 : to->dticks;
+}
+
+#ifdef CONFIG_TIMEOUT_BATCH_EXPIRY
+/* Unlinks up to EXPIRY_BATCH timeouts expiring on the soonest tick, if
+ * that is within ticks of curr_tick, into batch and stores their number
+ * in count.  Returns the distance from curr_tick to that tick, or -1 if
+ * nothing is due.
+ */
+static int detach_expired(struct _timeout **batch, int *count, int32_t ticks)
+{
+	struct _timeout *t = first();
+	int dt;
+	int n = 0;
+
+	if ((t == NULL) || (t->dticks > ticks)) {
+		return -1;
+	}
+
+	dt = t->dticks;
+	do {
+		/* Leaves the following deltas relative to the expiry */
+		t->dticks = 0;
+		remove_timeout(t);
+
+		t->dticks = Z_TIMEOUT_EXPIRED_DTICKS;
+		batch[n++] = t;
+		t = first();
+	} while ((n < EXPIRY_BATCH) && (t != NULL) && (t->dticks == 0));
+
+	*count = n;
+
+	return dt;
+}
+#endif
+
+static k_ticks_t queued_dticks(const struct _timeout *timeout)
+{
+	k_ticks_t ticks = 0;
+
+	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
+		ticks += t->dticks;
+		if (timeout == t) {
+			break;
+		}
+	}
+
+	return ticks;
+}
+
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
+
 static int32_t elapsed(void)
 {
 	return announce_remaining == 0 ? sys_clock_elapsed() : 0U;
@@ -66,15 +504,15 @@ static int32_t elapsed(void)
 
 static int32_t next_timeout(void)
 {
-	struct _timeout *to = first();
+	int64_t dticks = first_dticks();
 	int32_t ticks_elapsed = elapsed();
 	int32_t ret;
 
-	if ((to == NULL) ||
-	    ((int64_t)(to->dticks - ticks_elapsed) > (int64_t)INT_MAX)) {
+	if ((dticks < 0) ||
+	    ((dticks - ticks_elapsed) > (int64_t)INT_MAX)) {
 		ret = MAX_WAIT;
 	} else {
-		ret = MAX(0, to->dticks - ticks_elapsed);
+		ret = MAX(0, dticks - ticks_elapsed);
 	}
 
 #ifdef CONFIG_TIMESLICING
@@ -100,8 +538,6 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 	to->fn = fn;
 
 	LOCKED(&timeout_lock) {
-		struct _timeout *t;
-
 		if (IS_ENABLED(CONFIG_TIMEOUT_64BIT) &&
 		    Z_TICK_ABS(timeout.ticks) >= 0) {
 			k_ticks_t ticks = Z_TICK_ABS(timeout.ticks) - curr_tick;
@@ -111,20 +547,13 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 			to->dticks = timeout.ticks + 1 + elapsed();
 		}
 
-		for (t = first(); t != NULL; t = next(t)) {
-			if (t->dticks > to->dticks) {
-				t->dticks -= to->dticks;
-				sys_dlist_insert(&t->node, &to->node);
-				break;
-			}
-			to->dticks -= t->dticks;
-		}
+		bool reprogram = insert_timeout(to);
 
-		if (t == NULL) {
-			sys_dlist_append(&timeout_list, &to->node);
-		}
+#ifdef CONFIG_TIMEOUT_BATCH_EXPIRY
+		reprogram = reprogram && !announce_batching;
+#endif
 
-		if (to == first()) {
+		if (reprogram) {
 #if CONFIG_TIMESLICING
 			/*
 			 * This is not ideal, since it does not
@@ -156,6 +585,13 @@ int z_abort_timeout(struct _timeout *to)
 			remove_timeout(to);
 			ret = 0;
 		}
+#ifdef CONFIG_TIMEOUT_BATCH_EXPIRY
+		if (to->dticks == Z_TIMEOUT_EXPIRED_DTICKS) {
+			/* Detached by sys_clock_announce(), which skips it */
+			to->dticks = 0;
+			ret = 0;
+		}
+#endif
 	}
 
 	return ret;
@@ -164,20 +600,17 @@ int z_abort_timeout(struct _timeout *to)
 /* must be locked */
 static k_ticks_t timeout_rem(const struct _timeout *timeout)
 {
-	k_ticks_t ticks = 0;
-
 	if (z_is_inactive_timeout(timeout)) {
 		return 0;
 	}
 
-	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
-		ticks += t->dticks;
-		if (timeout == t) {
-			break;
-		}
+#ifdef CONFIG_TIMEOUT_BATCH_EXPIRY
+	if (timeout->dticks == Z_TIMEOUT_EXPIRED_DTICKS) {
+		return 0;
 	}
+#endif
 
-	return ticks - elapsed();
+	return queued_dticks(timeout) - elapsed();
 }
 
 k_ticks_t z_timeout_remaining(const struct _timeout *timeout)
@@ -258,6 +691,57 @@ void sys_clock_announce(int32_t ticks)
 
 	announce_remaining = ticks;
 
+#if defined(CONFIG_TIMEOUT_BATCH_EXPIRY)
+	struct _timeout *batch[EXPIRY_BATCH];
+	int dt;
+	int n;
+
+	announce_batching = true;
+
+	while ((dt = detach_expired(batch, &n, announce_remaining)) >= 0) {
+		curr_tick += dt;
+
+		/* The whole batch runs without the lock.  An entry aborted
+		 * or re-armed by an earlier handler is no longer marked as
+		 * expired and is skipped.
+		 */
+		k_spin_unlock(&timeout_lock, key);
+
+		for (int i = 0; i < n; i++) {
+			struct _timeout *t = batch[i];
+
+			if (t->dticks == Z_TIMEOUT_EXPIRED_DTICKS) {
+				t->dticks = 0;
+				t->fn(t);
+			}
+		}
+
+		key = k_spin_lock(&timeout_lock);
+		announce_remaining -= dt;
+	}
+
+	announce_batching = false;
+
+#ifndef CONFIG_TIMEOUT_QUEUE_WHEEL
+	if (first() != NULL) {
+		first()->dticks -= announce_remaining;
+	}
+#endif
+#elif defined(CONFIG_TIMEOUT_QUEUE_WHEEL)
+	struct _timeout *t;
+
+	while ((t = wheel_pop(curr_tick + announce_remaining)) != NULL) {
+		int dt = t->dticks - curr_tick;
+
+		curr_tick += dt;
+		t->dticks = 0;
+
+		k_spin_unlock(&timeout_lock, key);
+		t->fn(t);
+		key = k_spin_lock(&timeout_lock);
+		announce_remaining -= dt;
+	}
+#else
 	while (first() != NULL && first()->dticks <= announce_remaining) {
 		struct _timeout *t = first();
 		int dt = t->dticks;
@@ -275,6 +759,7 @@ void sys_clock_announce(int32_t ticks)
 	if (first() != NULL) {
 		first()->dticks -= announce_remaining;
 	}
+#endif
 
 	curr_tick += announce_remaining;
 	announce_remaining = 0;
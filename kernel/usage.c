@@ -10,6 +10,7 @@
 #include <ksched.h>
 #include <zephyr/spinlock.h>
 #include <zephyr/sys/check.h>
+#include <zephyr/sys/math_extras.h>
 
 /* Need one of these for this to work */
 #if !defined(CONFIG_USE_SWITCH) && !defined(CONFIG_INSTRUMENT_THREAD_SWITCHING)
@@ -71,8 +72,37 @@ static void sched_thread_update_usage(struct k_thread *thread, uint32_t cycles)
 #endif
 }
 
+#ifdef CONFIG_SMP
+/* Called before thread->base.cpu is updated to the CPU it is being
+ * switched in on.  Both counters are only ever modified by the CPU
+ * they are switching to, with the scheduler lock held.
+ */
+static void sched_update_migrations(struct k_thread *thread)
+{
+	uint8_t last = thread->base.cpu;
+
+	if ((last == _current_cpu->id) || (last == Z_THREAD_CPU_NONE)) {
+		return;
+	}
+
+	if (thread->base.usage.track_usage) {
+		thread->base.usage.migrations++;
+	}
+
+#ifdef CONFIG_SCHED_THREAD_USAGE_ALL
+	if (_current_cpu->usage.track_usage) {
+		_current_cpu->usage.migrations++;
+	}
+#endif
+}
+#endif
+
 void z_sched_usage_start(struct k_thread *thread)
 {
+#ifdef CONFIG_SMP
+	sched_update_migrations(thread);
+#endif
+
 #ifdef CONFIG_SCHED_THREAD_USAGE_ANALYSIS
 	k_spinlock_key_t  key;
 
@@ -163,6 +193,10 @@ void z_sched_cpu_usage(uint8_t cpu_id, struct k_thread_runtime_stats *stats)
 
 	stats->execution_cycles = stats->total_cycles + stats->idle_cycles;
 
+#ifdef CONFIG_SMP
+	stats->migrations = _kernel.cpus[cpu_id].usage.migrations;
+#endif
+
 	k_spin_unlock(&usage_lock, key);
 }
 #endif
@@ -218,6 +252,10 @@ void z_sched_thread_usage(struct k_thread *thread,
 #endif
 	stats->execution_cycles = thread->base.usage.total;
 
+#ifdef CONFIG_SMP
+	stats->migrations = thread->base.usage.migrations;
+#endif
+
 	k_spin_unlock(&usage_lock, key);
 }
 
@@ -334,3 +372,129 @@ void k_sys_runtime_stats_disable(void)
 	k_spin_unlock(&usage_lock, key);
 }
 #endif
+
+#ifdef CONFIG_THREAD_LATENCY_STATS
+static void latency_hist_add(struct k_latency_hist *hist, uint32_t cycles)
+{
+	int bucket = (cycles == 0U) ? 0 : (31 - u32_count_leading_zeros(cycles));
+
+	bucket = MIN(bucket, CONFIG_THREAD_LATENCY_STATS_BUCKETS - 1);
+	hist->buckets[bucket]++;
+	hist->max = MAX(hist->max, cycles);
+}
+
+void z_sched_latency_ready(struct k_thread *thread)
+{
+	if (thread->base.usage.track_usage && (thread != _current)) {
+		thread->base.ready_stamp = usage_now();
+	}
+}
+
+void z_sched_latency_stop(struct k_thread *thread)
+{
+	k_spinlock_key_t key = k_spin_lock(&usage_lock);
+	uint32_t start = thread->base.run_stamp;
+
+	if (start != 0U) {
+		if (thread->base.usage.track_usage) {
+			latency_hist_add(&thread->base.latency.run,
+					 usage_now() - start);
+		}
+		thread->base.run_stamp = 0U;
+	}
+
+	k_spin_unlock(&usage_lock, key);
+}
+
+void z_sched_latency_start(struct k_thread *thread)
+{
+	k_spinlock_key_t key = k_spin_lock(&usage_lock);
+	uint32_t now = usage_now();
+
+	if (thread->base.usage.track_usage) {
+		if (thread->base.ready_stamp != 0U) {
+			latency_hist_add(&thread->base.latency.ready,
+					 now - thread->base.ready_stamp);
+		}
+		thread->base.run_stamp = now;
+	}
+	thread->base.ready_stamp = 0U;
+
+	k_spin_unlock(&usage_lock, key);
+}
+
+int k_thread_latency_stats_get(k_tid_t thread,
+			       struct k_thread_latency_stats *stats)
+{
+	k_spinlock_key_t key;
+
+	CHECKIF((thread == NULL) || (stats == NULL)) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&usage_lock);
+	*stats = thread->base.latency;
+	k_spin_unlock(&usage_lock, key);
+
+	return 0;
+}
+
+int k_thread_latency_stats_reset(k_tid_t thread)
+{
+	k_spinlock_key_t key;
+
+	CHECKIF(thread == NULL) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&usage_lock);
+	thread->base.latency = (struct k_thread_latency_stats) {};
+	k_spin_unlock(&usage_lock, key);
+
+	return 0;
+}
+#endif
+
+#ifdef CONFIG_IRQ_LATENCY_STATS
+static struct {
+	uint32_t start;
+	struct k_latency_hist hist;
+} irq_latency[CONFIG_NUM_IRQS];
+
+/* Called by the arch interrupt dispatch code around the handler of
+ * the software ISR table entry @a irq.  A line never nests with
+ * itself, so only the histogram update needs the lock.
+ */
+void z_irq_latency_enter(unsigned int irq)
+{
+	if (irq < ARRAY_SIZE(irq_latency)) {
+		irq_latency[irq].start = usage_now();
+	}
+}
+
+void z_irq_latency_exit(unsigned int irq)
+{
+	if (irq < ARRAY_SIZE(irq_latency)) {
+		uint32_t cycles = usage_now() - irq_latency[irq].start;
+		k_spinlock_key_t key = k_spin_lock(&usage_lock);
+
+		latency_hist_add(&irq_latency[irq].hist, cycles);
+		k_spin_unlock(&usage_lock, key);
+	}
+}
+
+int k_irq_latency_stats_get(unsigned int irq, struct k_latency_hist *hist)
+{
+	k_spinlock_key_t key;
+
+	CHECKIF((irq >= ARRAY_SIZE(irq_latency)) || (hist == NULL)) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&usage_lock);
+	*hist = irq_latency[irq].hist;
+	k_spin_unlock(&usage_lock, key);
+
+	return 0;
+}
+#endif
@@ -8,7 +8,7 @@
 #include <zephyr/kernel.h>
 #include <string.h>
 #include <zephyr/sys/math_extras.h>
-#include <zephyr/sys/rb.h>
+#include <zephyr/sys/slist.h>
 #include <zephyr/kernel_structs.h>
 #include <zephyr/sys/sys_io.h>
 #include <ksched.h>
@@ -47,7 +47,7 @@ LOG_MODULE_DECLARE(os, CONFIG_KERNEL_LOG_LEVEL);
  * not.
  */
 #ifdef CONFIG_DYNAMIC_OBJECTS
-static struct k_spinlock lists_lock;       /* kobj rbtree/dlist */
+static struct k_spinlock lists_lock;       /* kobj hash table/dlist */
 static struct k_spinlock objfree_lock;     /* k_object_free */
 #endif
 static struct k_spinlock obj_lock;         /* kobj struct data */
@@ -60,6 +60,61 @@ extern uint8_t _thread_idx_map[CONFIG_MAX_THREAD_BYTES];
 
 static void clear_perms_cb(struct z_object *ko, void *ctx_ptr);
 
+#ifdef CONFIG_OBJ_VALIDATION_CACHE
+/* Bumped whenever an object may lose a permission or its initialized
+ * state, or be freed, which invalidates the validation caches of all
+ * threads at once.
+ */
+static atomic_t obj_cache_gen;
+
+static inline void obj_cache_flush(void)
+{
+	(void)atomic_inc(&obj_cache_gen);
+}
+
+bool z_object_cache_hit(const void *obj, enum k_objects otype)
+{
+	struct _obj_validation_cache *cache = &_current->obj_cache;
+	uint32_t gen = (uint32_t)atomic_get(&obj_cache_gen);
+
+	if (cache->gen != gen) {
+		/* Entries added from now on are tagged with the generation
+		 * read before their validation, so a flush racing with it
+		 * still discards them.
+		 */
+		(void)memset(cache->obj, 0, sizeof(cache->obj));
+		cache->gen = gen;
+		return false;
+	}
+
+	if (obj == NULL) {
+		return false;
+	}
+
+	for (int i = 0; i < CONFIG_OBJ_VALIDATION_CACHE_SIZE; i++) {
+		if (cache->obj[i] == obj &&
+		    (otype == K_OBJ_ANY || cache->type[i] == otype)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void z_object_cache_add(const void *obj, struct z_object *ko)
+{
+	struct _obj_validation_cache *cache = &_current->obj_cache;
+
+	cache->obj[cache->next] = obj;
+	cache->type[cache->next] = ko->type;
+	cache->next = (cache->next + 1U) % CONFIG_OBJ_VALIDATION_CACHE_SIZE;
+}
+#else
+static inline void obj_cache_flush(void)
+{
+}
+#endif /* CONFIG_OBJ_VALIDATION_CACHE */
+
 const char *otype_to_str(enum k_objects otype)
 {
 	const char *ret;
@@ -136,8 +191,7 @@ uint8_t *z_priv_stack_find(k_thread_stack_t *stack)
 struct dyn_obj {
 	struct z_object kobj;
 	sys_dnode_t dobj_list;
-	struct rbnode node; /* must be immediately before data member */
-
+	sys_snode_t hash_node;
 	/* The object itself */
 	uint8_t data[] __aligned(DYN_OBJ_DATA_ALIGN_K_THREAD);
 };
@@ -146,15 +200,11 @@ extern struct z_object *z_object_gperf_find(const void *obj);
 extern void z_object_gperf_wordlist_foreach(_wordlist_cb_func_t func,
 					     void *context);
 
-static bool node_lessthan(struct rbnode *a, struct rbnode *b);
-
 /*
- * Red/black tree of allocated kernel objects, for reasonably fast lookups
- * based on object pointer values.
+ * Hash table of allocated kernel objects, for fast lookups based on
+ * object pointer values.
  */
-static struct rbtree obj_rb_tree = {
-	.lessthan_fn = node_lessthan
-};
+static sys_slist_t obj_hash[CONFIG_DYNAMIC_OBJECTS_HASH_BUCKETS];
 
 /*
  * Linked list of allocated kernel objects, for iteration over all allocated
@@ -162,10 +212,6 @@ static struct rbtree obj_rb_tree = {
  */
 static sys_dlist_t obj_list = SYS_DLIST_STATIC_INIT(&obj_list);
 
-/*
- * TODO: Write some hash table code that will replace both obj_rb_tree
- * and obj_list.
- */
 
 static size_t obj_size_get(enum k_objects otype)
 {
@@ -201,40 +247,34 @@ static size_t obj_align_get(enum k_objects otype)
 	return ret;
 }
 
-static bool node_lessthan(struct rbnode *a, struct rbnode *b)
+static inline sys_slist_t *obj_hash_bucket(const void *obj)
 {
-	return a < b;
-}
+	/* Objects are at least pointer aligned, drop the bits which are
+	 * always zero before spreading the others.
+	 */
+	uint32_t hash = (uint32_t)((uintptr_t)obj / sizeof(void *)) * 0x9E3779B1U;
 
-static inline struct dyn_obj *node_to_dyn_obj(struct rbnode *node)
-{
-	return CONTAINER_OF(node, struct dyn_obj, node);
+	return &obj_hash[(hash >> 16) % CONFIG_DYNAMIC_OBJECTS_HASH_BUCKETS];
 }
 
-static inline struct rbnode *dyn_obj_to_node(void *obj)
+static inline void obj_hash_remove(struct dyn_obj *dyn)
 {
-	struct dyn_obj *dobj = CONTAINER_OF(obj, struct dyn_obj, data);
-
-	return &dobj->node;
+	(void)sys_slist_find_and_remove(obj_hash_bucket(&dyn->data),
+					&dyn->hash_node);
 }
 
 static struct dyn_obj *dyn_object_find(void *obj)
 {
-	struct rbnode *node;
-	struct dyn_obj *ret;
-
-	/* For any dynamically allocated kernel object, the object
-	 * pointer is just a member of the containing struct dyn_obj,
-	 * so just a little arithmetic is necessary to locate the
-	 * corresponding struct rbnode
-	 */
-	node = dyn_obj_to_node(obj);
+	struct dyn_obj *dyn;
+	struct dyn_obj *ret = NULL;
 
 	k_spinlock_key_t key = k_spin_lock(&lists_lock);
-	if (rb_contains(&obj_rb_tree, node)) {
-		ret = node_to_dyn_obj(node);
-	} else {
-		ret = NULL;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(obj_hash_bucket(obj), dyn, hash_node) {
+		if ((void *)&dyn->data == obj) {
+			ret = dyn;
+			break;
+		}
 	}
 	k_spin_unlock(&lists_lock, key);
 
@@ -321,7 +361,7 @@ struct z_object *z_dynamic_object_aligned_create(size_t align, size_t size)
 
 	k_spinlock_key_t key = k_spin_lock(&lists_lock);
 
-	rb_insert(&obj_rb_tree, &dyn->node);
+	sys_slist_prepend(obj_hash_bucket(&dyn->data), &dyn->hash_node);
 	sys_dlist_append(&obj_list, &dyn->dobj_list);
 	k_spin_unlock(&lists_lock, key);
 
@@ -396,9 +436,10 @@ void k_object_free(void *obj)
 
 	k_spinlock_key_t key = k_spin_lock(&objfree_lock);
 
+	obj_cache_flush();
 	dyn = dyn_object_find(obj);
 	if (dyn != NULL) {
-		rb_remove(&obj_rb_tree, &dyn->node);
+		obj_hash_remove(dyn);
 		sys_dlist_remove(&dyn->dobj_list);
 
 		if (dyn->kobj.type == K_OBJ_THREAD) {
@@ -467,6 +508,7 @@ static void unref_check(struct z_object *ko, uintptr_t index)
 	k_spinlock_key_t key = k_spin_lock(&obj_lock);
 
 	sys_bitfield_clear_bit((mem_addr_t)&ko->perms, index);
+	obj_cache_flush();
 
 #ifdef CONFIG_DYNAMIC_OBJECTS
 	if ((ko->flags & K_OBJ_FLAG_ALLOC) == 0U) {
@@ -508,7 +550,7 @@ static void unref_check(struct z_object *ko, uintptr_t index)
 		break;
 	}
 
-	rb_remove(&obj_rb_tree, &dyn->node);
+	obj_hash_remove(dyn);
 	sys_dlist_remove(&dyn->dobj_list);
 	k_free(dyn);
 out:
@@ -722,6 +764,7 @@ void z_object_recycle(const void *obj)
 
 	if (ko != NULL) {
 		(void)memset(ko->perms, 0, sizeof(ko->perms));
+		obj_cache_flush();
 		z_thread_perms_set(ko, k_current_get());
 		ko->flags |= K_OBJ_FLAG_INITIALIZED;
 	}
@@ -738,6 +781,7 @@ void z_object_uninit(const void *obj)
 	}
 
 	ko->flags &= ~K_OBJ_FLAG_INITIALIZED;
+	obj_cache_flush();
 }
 
 /*
@@ -7,6 +7,8 @@
 #include <zephyr/kernel.h>
 #include <zephyr/syscall_handler.h>
 #include <zephyr/kernel_structs.h>
+#include <zephyr/sys/speculation.h>
+#include <string.h>
 
 static struct z_object *validate_any_object(const void *obj)
 {
@@ -65,3 +67,48 @@ static inline void *z_vrfy_k_object_alloc(enum k_objects otype)
 	return z_impl_k_object_alloc(otype);
 }
 #include <syscalls/k_object_alloc_mrsh.c>
+
+int z_impl_k_syscall_batch(struct k_syscall_req *reqs, size_t count)
+{
+	ARG_UNUSED(reqs);
+	ARG_UNUSED(count);
+
+	/* Supervisor threads call the implementations directly */
+	return -ENOTSUP;
+}
+
+#ifdef CONFIG_SYSCALL_BATCH
+static inline int z_vrfy_k_syscall_batch(struct k_syscall_req *reqs,
+					 size_t count)
+{
+	void *ssf = _current->syscall_frame;
+	struct k_syscall_req req;
+	uint32_t id;
+
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_WRITE(reqs, count, sizeof(*reqs)));
+
+	for (size_t i = 0; i < count; i++) {
+		/* Work on a copy, the user thread may change the request */
+		(void)memcpy(&req, &reqs[i], sizeof(req));
+
+		Z_OOPS(Z_SYSCALL_VERIFY_MSG(req.id < K_SYSCALL_LIMIT &&
+					    req.id != K_SYSCALL_K_SYSCALL_BATCH,
+					    "invalid system call ID %lu",
+					    (unsigned long)req.id));
+		id = k_array_index_sanitize((uint32_t)req.id, K_SYSCALL_LIMIT);
+
+		/* Each handler verifies its arguments and oopses at the
+		 * frame of this call, and clears the frame on return.
+		 */
+		req.ret = _k_syscall_table[id](req.args[0], req.args[1],
+					       req.args[2], req.args[3],
+					       req.args[4], req.args[5], ssf);
+		_current->syscall_frame = ssf;
+
+		reqs[i].ret = req.ret;
+	}
+
+	return 0;
+}
+#include <syscalls/k_syscall_batch_mrsh.c>
+#endif /* CONFIG_SYSCALL_BATCH */
@@ -18,43 +18,73 @@
 #include <ksched.h>
 #include <zephyr/sys/printk.h>
 
+/* With lockless submission work flags can change without the lock
+ * held, so updates made under it must be atomic too.
+ */
 static inline void flag_clear(uint32_t *flagp,
 			      uint32_t bit)
 {
+#ifdef CONFIG_WORK_QUEUE_LOCKLESS_SUBMIT
+	(void)__atomic_fetch_and(flagp, ~BIT(bit), __ATOMIC_SEQ_CST);
+#else
 	*flagp &= ~BIT(bit);
+#endif
 }
 
 static inline void flag_set(uint32_t *flagp,
 			    uint32_t bit)
 {
+#ifdef CONFIG_WORK_QUEUE_LOCKLESS_SUBMIT
+	(void)__atomic_fetch_or(flagp, BIT(bit), __ATOMIC_SEQ_CST);
+#else
 	*flagp |= BIT(bit);
+#endif
 }
 
 static inline bool flag_test(const uint32_t *flagp,
 			     uint32_t bit)
 {
+#ifdef CONFIG_WORK_QUEUE_LOCKLESS_SUBMIT
+	return (__atomic_load_n(flagp, __ATOMIC_SEQ_CST) & BIT(bit)) != 0U;
+#else
 	return (*flagp & BIT(bit)) != 0U;
+#endif
 }
 
 static inline bool flag_test_and_clear(uint32_t *flagp,
 				       int bit)
 {
+#ifdef CONFIG_WORK_QUEUE_LOCKLESS_SUBMIT
+	uint32_t old = __atomic_fetch_and(flagp, ~BIT(bit),
+					  __ATOMIC_SEQ_CST);
+
+	return (old & BIT(bit)) != 0U;
+#else
 	bool ret = flag_test(flagp, bit);
 
 	flag_clear(flagp, bit);
 
 	return ret;
+#endif
 }
 
 static inline void flags_set(uint32_t *flagp,
 			     uint32_t flags)
 {
+#ifdef CONFIG_WORK_QUEUE_LOCKLESS_SUBMIT
+	__atomic_store_n(flagp, flags, __ATOMIC_SEQ_CST);
+#else
 	*flagp = flags;
+#endif
 }
 
 static inline uint32_t flags_get(const uint32_t *flagp)
 {
+#ifdef CONFIG_WORK_QUEUE_LOCKLESS_SUBMIT
+	return __atomic_load_n(flagp, __ATOMIC_SEQ_CST);
+#else
 	return *flagp;
+#endif
 }
 
 /* Lock to protect the internal state of all work items, work queues,
@@ -203,6 +233,14 @@ static inline void queue_remove_locked(struct k_work_q *queue,
 				       struct k_work *work)
 {
 	if (flag_test_and_clear(&work->flags, K_WORK_QUEUED_BIT)) {
+#ifdef CONFIG_WORK_QUEUE_LOCKLESS_SUBMIT
+		/* Not on the pending list yet, it gets dropped when
+		 * collected
+		 */
+		if (flag_test(&work->flags, K_WORK_LOCKLESS_BIT)) {
+			return;
+		}
+#endif
 		(void)sys_slist_find_and_remove(&queue->pending, &work->node);
 	}
 }
@@ -229,6 +267,229 @@ static inline bool notify_queue_locked(struct k_work_q *queue)
 	return rv;
 }
 
+#ifdef CONFIG_WORK_QUEUE_LOCKLESS_SUBMIT
+/* Move the items submitted to a queue without the lock to its pending
+ * list, in submission order.
+ *
+ * Items cancelled since their submission are dropped.  An item only
+ * becomes eligible for a new lockless submission once its LOCKLESS
+ * flag is cleared, which is thus the last access made to it here.
+ *
+ * Invoked with work lock held.
+ *
+ * @param queue the queue whose lockless stack is collected.
+ */
+static void lockless_collect_locked(struct k_work_q *queue)
+{
+	sys_snode_t *node = atomic_ptr_clear(&queue->lockless);
+	sys_snode_t *fifo = NULL;
+
+	/* The stack is LIFO, reverse it */
+	while (node != NULL) {
+		sys_snode_t *next = node->next;
+
+		node->next = fifo;
+		fifo = node;
+		node = next;
+	}
+
+	while (fifo != NULL) {
+		struct k_work *work = CONTAINER_OF(fifo, struct k_work, node);
+
+		fifo = fifo->next;
+		if (flag_test(&work->flags, K_WORK_QUEUED_BIT)) {
+			sys_slist_append(&queue->pending, &work->node);
+		}
+		flag_clear(&work->flags, K_WORK_LOCKLESS_BIT);
+	}
+}
+
+/* Wait for a lockless submission of the item to reach its queue's
+ * pending list.
+ *
+ * The submitter publishes the item without the lock, so this only
+ * spins across the few instructions between it claiming the item and
+ * pushing it, which run with interrupts locked on its CPU.
+ *
+ * Invoked with work lock held.
+ *
+ * @param work a queued work item.
+ */
+static void lockless_settle_locked(struct k_work *work)
+{
+	while (flag_test(&work->flags, K_WORK_LOCKLESS_BIT)) {
+		struct k_work_q *queue = work->queue;
+
+		if (queue != NULL) {
+			lockless_collect_locked(queue);
+		}
+	}
+}
+
+/* Try to submit an idle work item to a queue without taking the lock.
+ *
+ * Only applies to non-delayable items that are neither queued, running
+ * nor being cancelled, and to started queues that are not draining,
+ * plugged or part of a work pool.  Everything else goes through the
+ * locked path.
+ *
+ * @param queue the queue to which work should be submitted.
+ * @param work to be submitted
+ *
+ * @retval true if the work was queued to @p queue
+ * @retval false if the locked path must be used.
+ */
+static bool lockless_submit(struct k_work_q *queue, struct k_work *work)
+{
+	uint32_t state = K_WORK_QUEUED | K_WORK_LOCKLESS;
+	uint32_t flags;
+	unsigned int key;
+
+	if ((queue == NULL)
+	    || ((flags_get(&queue->flags)
+		 & (K_WORK_QUEUE_STARTED | K_WORK_QUEUE_DRAIN
+		    | K_WORK_QUEUE_PLUGGED)) != K_WORK_QUEUE_STARTED)) {
+		return false;
+	}
+
+#ifdef CONFIG_WORK_POOL
+	if (queue->pool != NULL) {
+		return false;
+	}
+#endif
+
+	flags = flags_get(&work->flags);
+	if ((flags & (K_WORK_MASK | K_WORK_DELAYABLE | K_WORK_LOCKLESS)) != 0U) {
+		return false;
+	}
+
+	/* Keep the window between claiming the item and publishing it
+	 * short, see lockless_settle_locked().
+	 */
+	key = arch_irq_lock();
+
+	if (!__atomic_compare_exchange_n(&work->flags, &flags, flags | state,
+					 false, __ATOMIC_SEQ_CST,
+					 __ATOMIC_SEQ_CST)) {
+		arch_irq_unlock(key);
+		return false;
+	}
+
+	work->queue = queue;
+
+	do {
+		work->node.next = atomic_ptr_get(&queue->lockless);
+	} while (!atomic_ptr_cas(&queue->lockless, work->node.next,
+				 &work->node));
+
+	arch_irq_unlock(key);
+
+	/* The queue thread rechecks the stack after setting this flag,
+	 * then waits with the lock held: whoever clears it can wake the
+	 * thread by taking the lock.
+	 */
+	if (atomic_cas(&queue->lockless_idle, 1, 0)) {
+		k_spinlock_key_t lkey = k_spin_lock(&lock);
+
+		(void)notify_queue_locked(queue);
+		k_spin_unlock(&lock, lkey);
+	}
+
+	return true;
+}
+#endif /* CONFIG_WORK_QUEUE_LOCKLESS_SUBMIT */
+
+#ifdef CONFIG_WORK_POOL
+/* Take a work item from a busy sibling of an idle pool worker.
+ *
+ * Work is only taken from the head of a sibling's pending list, along
+ * with the flushers queued right behind it, so flush completion still
+ * follows the item it waits for.  A flusher at the head waits for an
+ * item running on the sibling and is left alone, as are queues being
+ * drained.
+ *
+ * Invoked with work lock held.
+ *
+ * @param queue the idle worker, with an empty pending list.
+ *
+ * @return the stolen work node, or null if nothing could be taken.
+ */
+static sys_snode_t *pool_steal_locked(struct k_work_q *queue)
+{
+	struct k_work_pool *pool = queue->pool;
+
+	if ((pool == NULL)
+	    || flag_test(&queue->flags, K_WORK_QUEUE_DRAIN_BIT)) {
+		return NULL;
+	}
+
+	size_t self = queue - pool->workers;
+
+	for (size_t i = 1; i < pool->num_workers; i++) {
+		struct k_work_q *victim =
+			&pool->workers[(self + i) % pool->num_workers];
+		sys_snode_t *node = sys_slist_peek_head(&victim->pending);
+		struct k_work *work;
+
+		if ((node == NULL)
+		    || !flag_test(&victim->flags, K_WORK_QUEUE_BUSY_BIT)
+		    || flag_test(&victim->flags, K_WORK_QUEUE_DRAIN_BIT)) {
+			continue;
+		}
+
+		work = CONTAINER_OF(node, struct k_work, node);
+		if (work->handler == handle_flush) {
+			continue;
+		}
+
+		(void)sys_slist_get(&victim->pending);
+		work->queue = queue;
+
+		while ((node = sys_slist_peek_head(&victim->pending)) != NULL) {
+			struct k_work *wn = CONTAINER_OF(node, struct k_work,
+							 node);
+
+			if (wn->handler != handle_flush) {
+				break;
+			}
+
+			(void)sys_slist_get(&victim->pending);
+			sys_slist_append(&queue->pending, node);
+		}
+
+		return &work->node;
+	}
+
+	return NULL;
+}
+
+/* Wake an idle sibling of a busy pool worker so it can steal work.
+ *
+ * Invoked with work lock held.
+ *
+ * @param queue the worker that has just been given work.
+ */
+static void pool_notify_locked(struct k_work_q *queue)
+{
+	struct k_work_pool *pool = queue->pool;
+
+	if ((pool == NULL)
+	    || !flag_test(&queue->flags, K_WORK_QUEUE_BUSY_BIT)) {
+		return;
+	}
+
+	for (size_t i = 0; i < pool->num_workers; i++) {
+		struct k_work_q *sibling = &pool->workers[i];
+
+		if ((sibling != queue)
+		    && !flag_test(&sibling->flags, K_WORK_QUEUE_BUSY_BIT)
+		    && notify_queue_locked(sibling)) {
+			break;
+		}
+	}
+}
+#endif /* CONFIG_WORK_POOL */
+
 /* Submit an work item to a queue if queue state allows new work.
  *
  * Submission is rejected if no queue is provided, or if the queue is
@@ -277,6 +538,9 @@ static inline int queue_submit_locked(struct k_work_q *queue,
 		sys_slist_append(&queue->pending, &work->node);
 		ret = 1;
 		(void)notify_queue_locked(queue);
+#ifdef CONFIG_WORK_POOL
+		pool_notify_locked(queue);
+#endif
 	}
 
 	return ret;
@@ -316,6 +580,17 @@ static int submit_to_queue_locked(struct k_work *work,
 	if (flag_test(&work->flags, K_WORK_CANCELING_BIT)) {
 		/* Disallowed */
 		ret = -EBUSY;
+#ifdef CONFIG_WORK_QUEUE_LOCKLESS_SUBMIT
+	} else if (flag_test(&work->flags, K_WORK_LOCKLESS_BIT)
+		   && !flag_test(&work->flags, K_WORK_QUEUED_BIT)) {
+		/* Cancelled while still on the lockless stack of the
+		 * queue it was submitted to.  Requeue it there, the item
+		 * can't be linked anywhere else until collected.
+		 */
+		flag_set(&work->flags, K_WORK_QUEUED_BIT);
+		*queuep = work->queue;
+		ret = 1;
+#endif
 	} else if (!flag_test(&work->flags, K_WORK_QUEUED_BIT)) {
 		/* Not currently queued */
 		ret = 1;
@@ -371,6 +646,12 @@ int z_work_submit_to_queue(struct k_work_q *queue,
 {
 	__ASSERT_NO_MSG(work != NULL);
 
+#ifdef CONFIG_WORK_QUEUE_LOCKLESS_SUBMIT
+	if (lockless_submit(queue, work)) {
+		return 1;
+	}
+#endif
+
 	k_spinlock_key_t key = k_spin_lock(&lock);
 
 	int ret = submit_to_queue_locked(work, &queue);
@@ -438,6 +719,9 @@ static bool work_flush_locked(struct k_work *work,
 
 		__ASSERT_NO_MSG(queue != NULL);
 
+#ifdef CONFIG_WORK_QUEUE_LOCKLESS_SUBMIT
+		lockless_settle_locked(work);
+#endif
 		queue_flusher_locked(queue, work, flusher);
 		notify_queue_locked(queue);
 	}
@@ -608,7 +892,15 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 		bool yield;
 
 		/* Check for and prepare any new work. */
+#ifdef CONFIG_WORK_QUEUE_LOCKLESS_SUBMIT
+		lockless_collect_locked(queue);
+#endif
 		node = sys_slist_get(&queue->pending);
+#ifdef CONFIG_WORK_POOL
+		if (node == NULL) {
+			node = pool_steal_locked(queue);
+		}
+#endif
 		if (node != NULL) {
 			/* Mark that there's some work active that's
 			 * not on the pending list.
@@ -657,8 +949,23 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 			 * work thread will be woken and we can check again.
 			 */
 
+#ifdef CONFIG_WORK_QUEUE_LOCKLESS_SUBMIT
+			/* Lockless submitters only wake us once this is
+			 * set, catch those that came before.
+			 */
+			atomic_set(&queue->lockless_idle, 1);
+			if (atomic_ptr_get(&queue->lockless) != NULL) {
+				atomic_clear(&queue->lockless_idle);
+				k_spin_unlock(&lock, key);
+				continue;
+			}
+#endif
+
 			(void)z_sched_wait(&lock, key, &queue->notifyq,
 					   K_FOREVER, NULL);
+#ifdef CONFIG_WORK_QUEUE_LOCKLESS_SUBMIT
+			atomic_clear(&queue->lockless_idle);
+#endif
 			continue;
 		}
 
@@ -703,19 +1010,21 @@ void k_work_queue_init(struct k_work_q *queue)
 	SYS_PORT_TRACING_OBJ_INIT(k_work_queue, queue);
 }
 
-void k_work_queue_start(struct k_work_q *queue,
-			k_thread_stack_t *stack,
-			size_t stack_size,
-			int prio,
-			const struct k_work_queue_config *cfg)
+/* Set up a work queue and create its thread, without starting it.
+ *
+ * See k_work_queue_start().
+ */
+static void work_queue_create(struct k_work_q *queue,
+			      k_thread_stack_t *stack,
+			      size_t stack_size,
+			      int prio,
+			      const struct k_work_queue_config *cfg)
 {
 	__ASSERT_NO_MSG(queue);
 	__ASSERT_NO_MSG(stack);
 	__ASSERT_NO_MSG(!flag_test(&queue->flags, K_WORK_QUEUE_STARTED_BIT));
 	uint32_t flags = K_WORK_QUEUE_STARTED;
 
-	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work_queue, start, queue);
-
 	sys_slist_init(&queue->pending);
 	z_waitq_init(&queue->notifyq);
 	z_waitq_init(&queue->drainq);
@@ -737,7 +1046,17 @@ void k_work_queue_start(struct k_work_q *queue,
 	if ((cfg != NULL) && (cfg->name != NULL)) {
 		k_thread_name_set(&queue->thread, cfg->name);
 	}
+}
+
+void k_work_queue_start(struct k_work_q *queue,
+			k_thread_stack_t *stack,
+			size_t stack_size,
+			int prio,
+			const struct k_work_queue_config *cfg)
+{
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work_queue, start, queue);
 
+	work_queue_create(queue, stack, stack_size, prio, cfg);
 	k_thread_start(&queue->thread);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, start, queue);
@@ -754,6 +1073,10 @@ int k_work_queue_drain(struct k_work_q *queue,
 	int ret = 0;
 	k_spinlock_key_t key = k_spin_lock(&lock);
 
+#ifdef CONFIG_WORK_QUEUE_LOCKLESS_SUBMIT
+	lockless_collect_locked(queue);
+#endif
+
 	if (((flags_get(&queue->flags)
 	      & (K_WORK_QUEUE_BUSY | K_WORK_QUEUE_DRAIN)) != 0U)
 	    || plug
@@ -795,6 +1118,151 @@ int k_work_queue_unplug(struct k_work_q *queue)
 	return ret;
 }
 
+#ifdef CONFIG_WORK_POOL
+
+void k_work_pool_init(struct k_work_pool *pool, struct k_work_q *workers,
+		      size_t num_workers)
+{
+	__ASSERT_NO_MSG(pool != NULL);
+	__ASSERT_NO_MSG(workers != NULL);
+	__ASSERT_NO_MSG(num_workers > 0);
+
+	*pool = (struct k_work_pool) {
+		.workers = workers,
+		.num_workers = num_workers,
+	};
+
+	for (size_t i = 0; i < num_workers; i++) {
+		k_work_queue_init(&workers[i]);
+		workers[i].pool = pool;
+	}
+}
+
+void k_work_pool_start(struct k_work_pool *pool, k_thread_stack_t *stacks,
+		       size_t stack_size, int prio,
+		       const struct k_work_pool_config *cfg)
+{
+	__ASSERT_NO_MSG(pool != NULL);
+	__ASSERT_NO_MSG(stacks != NULL);
+
+	struct k_work_queue_config qcfg = {
+		.name = (cfg != NULL) ? cfg->name : NULL,
+		.no_yield = (cfg != NULL) && cfg->no_yield,
+	};
+	bool pin = (cfg != NULL) && cfg->pin_cpu;
+	uintptr_t ssz = K_THREAD_STACK_LEN(stack_size);
+
+	__ASSERT(!pin || IS_ENABLED(CONFIG_SCHED_CPU_MASK),
+		 "pinning workers requires CONFIG_SCHED_CPU_MASK");
+	pool->pinned = pin && IS_ENABLED(CONFIG_SCHED_CPU_MASK);
+
+	for (size_t i = 0; i < pool->num_workers; i++) {
+		struct k_work_q *queue = &pool->workers[i];
+
+		work_queue_create(queue, &stacks[ssz * i], stack_size,
+				  prio, &qcfg);
+#ifdef CONFIG_SCHED_CPU_MASK
+		if (pool->pinned) {
+			(void)k_thread_cpu_pin(&queue->thread,
+					       i % CONFIG_MP_NUM_CPUS);
+		}
+#endif
+		k_thread_start(&queue->thread);
+	}
+}
+
+/* Pick the worker a submission from the current context goes to.
+ *
+ * Invoked with work lock held.
+ */
+static struct k_work_q *pool_select_locked(struct k_work_pool *pool)
+{
+	if (!k_is_in_isr()) {
+		for (size_t i = 0; i < pool->num_workers; i++) {
+			if (_current == &pool->workers[i].thread) {
+				return &pool->workers[i];
+			}
+		}
+	}
+
+	if (pool->pinned && (_current_cpu->id < pool->num_workers)) {
+		return &pool->workers[_current_cpu->id];
+	}
+
+	struct k_work_q *queue = &pool->workers[pool->next];
+
+	pool->next = (pool->next + 1) % pool->num_workers;
+
+	return queue;
+}
+
+int k_work_pool_submit(struct k_work_pool *pool, struct k_work *work)
+{
+	__ASSERT_NO_MSG(pool != NULL);
+	__ASSERT_NO_MSG(work != NULL);
+
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct k_work_q *queue = pool_select_locked(pool);
+	int ret = submit_to_queue_locked(work, &queue);
+
+	k_spin_unlock(&lock, key);
+
+	if (ret > 0) {
+		z_reschedule_unlocked();
+	}
+
+	return ret;
+}
+
+int k_work_pool_drain(struct k_work_pool *pool, bool plug)
+{
+	__ASSERT_NO_MSG(pool != NULL);
+	__ASSERT_NO_MSG(!k_is_in_isr());
+
+	int ret = 0;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	/* Mark every worker first, so none can steal back work from a
+	 * sibling that is still being drained.
+	 */
+	for (size_t i = 0; i < pool->num_workers; i++) {
+		struct k_work_q *queue = &pool->workers[i];
+
+		flag_set(&queue->flags, K_WORK_QUEUE_DRAIN_BIT);
+		if (plug) {
+			flag_set(&queue->flags, K_WORK_QUEUE_PLUGGED_BIT);
+		}
+		notify_queue_locked(queue);
+	}
+
+	k_spin_unlock(&lock, key);
+
+	for (size_t i = 0; (i < pool->num_workers) && (ret >= 0); i++) {
+		int rc = k_work_queue_drain(&pool->workers[i], plug);
+
+		ret = (rc < 0) ? rc : MAX(ret, rc);
+	}
+
+	return ret;
+}
+
+int k_work_pool_unplug(struct k_work_pool *pool)
+{
+	__ASSERT_NO_MSG(pool != NULL);
+
+	int ret = -EALREADY;
+
+	for (size_t i = 0; i < pool->num_workers; i++) {
+		if (k_work_queue_unplug(&pool->workers[i]) == 0) {
+			ret = 0;
+		}
+	}
+
+	return ret;
+}
+
+#endif /* CONFIG_WORK_POOL */
+
 #ifdef CONFIG_SYS_CLOCK_EXISTS
 
 /* Timeout handler for delayable work.
@@ -10,6 +10,17 @@
 #include <stdint.h>
 #include <sys/types.h>
 
+#if !defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE)
+#define WORD_MASK (sizeof(mem_word_t) - 1)
+
+/* 0x01 and 0x80 repeated in each byte of a word */
+#define WORD_ONES ((mem_word_t)-1 / 0xFF)
+#define WORD_HIGHS (WORD_ONES << 7)
+
+/* Non-zero if any byte of the word is zero */
+#define WORD_HAS_ZERO(w) (((w) - WORD_ONES) & ~(w) & WORD_HIGHS)
+#endif
+
 /**
  *
  * @brief Copy a string
@@ -106,14 +117,37 @@ char *strrchr(const char *s, int c)
 
 size_t strlen(const char *s)
 {
-	size_t n = 0;
+	const char *p = s;
 
-	while (*s != '\0') {
-		s++;
-		n++;
+#if !defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE)
+	const mem_word_t *p_word;
+
+	/* do byte-sized checks until word-aligned */
+
+	while (((uintptr_t)p) & WORD_MASK) {
+		if (*p == '\0') {
+			return p - s;
+		}
+		p++;
 	}
 
-	return n;
+	/* do word-sized checks until the word holding the terminator, an
+	 * aligned word never crosses a page or memory region boundary
+	 */
+
+	p_word = (const mem_word_t *)p;
+	while (!WORD_HAS_ZERO(*p_word)) {
+		p_word++;
+	}
+
+	p = (const char *)p_word;
+#endif
+
+	while (*p != '\0') {
+		p++;
+	}
+
+	return p - s;
 }
 
 /**
@@ -238,8 +272,40 @@ char *strncat(char *ZRESTRICT dest, const char *ZRESTRICT src,
  */
 int memcmp(const void *m1, const void *m2, size_t n)
 {
-	const char *c1 = m1;
-	const char *c2 = m2;
+	const unsigned char *c1 = m1;
+	const unsigned char *c2 = m2;
+
+#if !defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE)
+	/* attempt word-sized comparison only if areas have identical alignment */
+
+	if ((((uintptr_t)c1 ^ (uintptr_t)c2) & WORD_MASK) == 0) {
+		const mem_word_t *w1, *w2;
+
+		/* do byte-sized comparison until word-aligned */
+
+		while ((((uintptr_t)c1) & WORD_MASK) && (n > 0)) {
+			if (*c1 != *c2) {
+				return *c1 - *c2;
+			}
+			c1++;
+			c2++;
+			n--;
+		}
+
+		/* skip equal words, the first differing one is compared below */
+
+		w1 = (const mem_word_t *)c1;
+		w2 = (const mem_word_t *)c2;
+		while ((n >= sizeof(mem_word_t)) && (*w1 == *w2)) {
+			w1++;
+			w2++;
+			n -= sizeof(mem_word_t);
+		}
+
+		c1 = (const unsigned char *)w1;
+		c2 = (const unsigned char *)w2;
+	}
+#endif
 
 	if (!n) {
 		return 0;
@@ -317,11 +383,29 @@ void *memcpy(void *ZRESTRICT d, const void *ZRESTRICT s, size_t n)
 			n--;
 		}
 
-		/* do word-sized copying as long as possible */
+		/* do word-sized copying as long as possible, four words at a
+		 * time first so that multiple load/store instructions can be
+		 * used
+		 */
 
 		mem_word_t *d_word = (mem_word_t *)d_byte;
 		const mem_word_t *s_word = (const mem_word_t *)s_byte;
 
+		while (n >= 4 * sizeof(mem_word_t)) {
+			mem_word_t w0 = s_word[0];
+			mem_word_t w1 = s_word[1];
+			mem_word_t w2 = s_word[2];
+			mem_word_t w3 = s_word[3];
+
+			d_word[0] = w0;
+			d_word[1] = w1;
+			d_word[2] = w2;
+			d_word[3] = w3;
+			d_word += 4;
+			s_word += 4;
+			n -= 4 * sizeof(mem_word_t);
+		}
+
 		while (n >= sizeof(mem_word_t)) {
 			*(d_word++) = *(s_word++);
 			n -= sizeof(mem_word_t);
@@ -376,6 +460,15 @@ void *memset(void *buf, int c, size_t n)
 	c_word |= c_word << 32;
 #endif
 
+	while (n >= 4 * sizeof(mem_word_t)) {
+		d_word[0] = c_word;
+		d_word[1] = c_word;
+		d_word[2] = c_word;
+		d_word[3] = c_word;
+		d_word += 4;
+		n -= 4 * sizeof(mem_word_t);
+	}
+
 	while (n >= sizeof(mem_word_t)) {
 		*(d_word++) = c_word;
 		n -= sizeof(mem_word_t);
@@ -403,15 +496,40 @@ void *memset(void *buf, int c, size_t n)
 
 void *memchr(const void *s, int c, size_t n)
 {
-	if (n != 0) {
-		const unsigned char *p = s;
+	const unsigned char *p = s;
+	unsigned char c_byte = (unsigned char)c;
 
-		do {
-			if (*p++ == (unsigned char)c) {
-				return ((void *)(p - 1));
-			}
+#if !defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE)
+	const mem_word_t *p_word;
+	mem_word_t c_word = WORD_ONES * c_byte;
 
-		} while (--n != 0);
+	/* do byte-sized search until word-aligned */
+
+	while ((((uintptr_t)p) & WORD_MASK) && (n > 0)) {
+		if (*p == c_byte) {
+			return (void *)p;
+		}
+		p++;
+		n--;
+	}
+
+	/* skip words not holding the byte */
+
+	p_word = (const mem_word_t *)p;
+	while ((n >= sizeof(mem_word_t)) && !WORD_HAS_ZERO(*p_word ^ c_word)) {
+		p_word++;
+		n -= sizeof(mem_word_t);
+	}
+
+	p = (const unsigned char *)p_word;
+#endif
+
+	while (n > 0) {
+		if (*p == c_byte) {
+			return (void *)p;
+		}
+		p++;
+		n--;
 	}
 
 	return NULL;
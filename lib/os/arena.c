@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/arena.h>
+#include <zephyr/sys/util.h>
+
+static uint8_t *block_mem(struct sys_arena_block *block)
+{
+	return (uint8_t *)(block + 1);
+}
+
+void sys_arena_init(struct sys_arena *arena, void *buf, size_t size)
+{
+	uintptr_t start = ROUND_UP(buf, sizeof(void *));
+	struct sys_arena_block *block = (struct sys_arena_block *)start;
+
+	__ASSERT((uint8_t *)buf + size > block_mem(block),
+		 "arena buffer is too small");
+
+	block->next = NULL;
+	block->end = (uint8_t *)buf + size;
+
+	arena->heap = NULL;
+	arena->block_size = 0;
+	arena->cur.block = block;
+	arena->cur.pos = block_mem(block);
+	arena->start = arena->cur;
+}
+
+void sys_arena_init_heap(struct sys_arena *arena, struct k_heap *heap,
+			 size_t block_size)
+{
+	arena->heap = heap;
+	arena->block_size = block_size;
+}
+
+static void *block_alloc(struct sys_arena_mark *cur, size_t align,
+			 size_t bytes)
+{
+	if (cur->block == NULL) {
+		return NULL;
+	}
+
+	uint8_t *mem = (uint8_t *)ROUND_UP(cur->pos, align);
+
+	if (mem > cur->block->end || bytes > (size_t)(cur->block->end - mem)) {
+		return NULL;
+	}
+
+	cur->pos = mem + bytes;
+
+	return mem;
+}
+
+void *sys_arena_aligned_alloc(struct sys_arena *arena, size_t align,
+			      size_t bytes)
+{
+	struct sys_arena_block *block;
+	size_t size;
+	void *mem;
+
+	if (align == 0U) {
+		align = 1U;
+	}
+	__ASSERT((align & (align - 1)) == 0, "align must be a power of 2");
+
+	mem = block_alloc(&arena->cur, align, bytes);
+	if (mem != NULL || arena->heap == NULL) {
+		return mem;
+	}
+
+	/* Grow: chain a block big enough for this allocation */
+	if (bytes > SIZE_MAX - sizeof(*block) - align) {
+		return NULL;
+	}
+	size = MAX(arena->block_size, sizeof(*block) + align + bytes);
+
+	block = k_heap_alloc(arena->heap, size, K_NO_WAIT);
+	if (block == NULL) {
+		return NULL;
+	}
+
+	block->next = arena->cur.block;
+	block->end = (uint8_t *)block + size;
+	arena->cur.block = block;
+	arena->cur.pos = block_mem(block);
+
+	return block_alloc(&arena->cur, align, bytes);
+}
+
+void sys_arena_reset_to(struct sys_arena *arena,
+			const struct sys_arena_mark *mark)
+{
+	while (arena->cur.block != mark->block &&
+	       arena->cur.block != arena->start.block) {
+		struct sys_arena_block *block = arena->cur.block;
+
+		__ASSERT_NO_MSG(arena->heap != NULL);
+
+		arena->cur.block = block->next;
+		k_heap_free(arena->heap, block);
+	}
+
+	__ASSERT(arena->cur.block == mark->block, "invalid arena mark");
+
+	arena->cur.pos = mark->pos;
+}
@@ -45,6 +45,81 @@ static void setup_bundle_data(sys_bitarray_t *bitarray,
 	}
 }
 
+#ifdef CONFIG_SYS_BITARRAY_SUMMARY
+/*
+ * Update the summary bits of the bundles from sidx to eidx after
+ * they have been modified.
+ */
+static void update_summary(sys_bitarray_t *bitarray, size_t sidx, size_t eidx)
+{
+	size_t idx;
+
+	for (idx = sidx; idx <= eidx; idx++) {
+		if (~bitarray->bundles[idx] == 0U) {
+			bitarray->summary[idx / 32] |= BIT(idx % 32);
+		} else {
+			bitarray->summary[idx / 32] &= ~BIT(idx % 32);
+		}
+	}
+}
+#else
+#define update_summary(bitarray, sidx, eidx) do { } while (false)
+#endif
+
+/*
+ * Find the first cleared bit at or after a bit location, one bundle at
+ * a time. Bundles known to be fully set from the summary bitmap are
+ * skipped without reading them.
+ *
+ * @param bitarray Bitarray struct
+ * @param bit      Bit location to start searching from
+ *
+ * @return Offset of the first cleared bit, or a value not less than
+ *         the number of bits in the bitarray if there is none.
+ */
+static size_t find_next_clear(sys_bitarray_t *bitarray, size_t bit)
+{
+	size_t idx;
+	uint32_t bundle;
+#ifdef CONFIG_SYS_BITARRAY_SUMMARY
+	uint32_t summary;
+#endif
+
+	if (bit >= bitarray->num_bits) {
+		return bitarray->num_bits;
+	}
+
+	idx = bit / bundle_bitness(bitarray);
+	bundle = ~bitarray->bundles[idx] &
+		 ~(BIT(bit % bundle_bitness(bitarray)) - 1);
+
+	while (bundle == 0U) {
+		idx++;
+
+#ifdef CONFIG_SYS_BITARRAY_SUMMARY
+		while (idx < bitarray->num_bundles) {
+			summary = ~bitarray->summary[idx / 32] &
+				  ~(BIT(idx % 32) - 1);
+			if (summary != 0U) {
+				idx = ROUND_DOWN(idx, 32) +
+				      find_lsb_set(summary) - 1;
+				break;
+			}
+
+			idx = ROUND_DOWN(idx, 32) + 32;
+		}
+#endif
+
+		if (idx >= bitarray->num_bundles) {
+			return bitarray->num_bits;
+		}
+
+		bundle = ~bitarray->bundles[idx];
+	}
+
+	return idx * bundle_bitness(bitarray) + find_lsb_set(bundle) - 1;
+}
+
 /*
  * Find out if the bits in a region is all set or all clear.
  *
@@ -132,7 +207,7 @@ static bool match_region(sys_bitarray_t *bitarray, size_t offset,
 
 		if (bundle != 0U) {
 			/* Bits in "between bundles" do not match */
-			mismatch_bundle = ~bundle;
+			mismatch_bundle = bundle;
 			mismatch_bundle_idx = idx;
 			goto mismatch;
 		}
@@ -208,6 +283,8 @@ static void set_region(sys_bitarray_t *bitarray, size_t offset,
 			}
 		}
 	}
+
+	update_summary(bitarray, bd->sidx, bd->eidx);
 }
 
 int sys_bitarray_set_bit(sys_bitarray_t *bitarray, size_t bit)
@@ -230,6 +307,7 @@ int sys_bitarray_set_bit(sys_bitarray_t *bitarray, size_t bit)
 	off = bit % bundle_bitness(bitarray);
 
 	bitarray->bundles[idx] |= BIT(off);
+	update_summary(bitarray, idx, idx);
 
 	ret = 0;
 
@@ -258,6 +336,7 @@ int sys_bitarray_clear_bit(sys_bitarray_t *bitarray, size_t bit)
 	off = bit % bundle_bitness(bitarray);
 
 	bitarray->bundles[idx] &= ~BIT(off);
+	update_summary(bitarray, idx, idx);
 
 	ret = 0;
 
@@ -334,6 +413,7 @@ int sys_bitarray_test_and_set_bit(sys_bitarray_t *bitarray, size_t bit, int *pre
 	}
 
 	bitarray->bundles[idx] |= BIT(off);
+	update_summary(bitarray, idx, idx);
 
 	ret = 0;
 
@@ -373,6 +453,7 @@ int sys_bitarray_test_and_clear_bit(sys_bitarray_t *bitarray, size_t bit, int *p
 	}
 
 	bitarray->bundles[idx] &= ~BIT(off);
+	update_summary(bitarray, idx, idx);
 
 	ret = 0;
 
@@ -385,10 +466,10 @@ int sys_bitarray_alloc(sys_bitarray_t *bitarray, size_t num_bits,
 		       size_t *offset)
 {
 	k_spinlock_key_t key;
-	uint32_t bit_idx;
+	size_t bit_idx;
 	int ret;
 	struct bundle_data bd;
-	size_t off_start, off_end;
+	size_t search_start, off_end;
 	size_t mismatch;
 
 	__ASSERT_NO_MSG(bitarray != NULL);
@@ -406,33 +487,32 @@ int sys_bitarray_alloc(sys_bitarray_t *bitarray, size_t num_bits,
 		goto out;
 	}
 
-	bit_idx = 0;
-
-	/* Find the first non-allocated bit by looking at bundles
-	 * instead of individual bits.
-	 *
-	 * On RISC-V 64-bit, it complains about undefined reference to `ffs`.
-	 * So don't use this on RISCV64.
-	 */
-	for (ret = 0; ret < bitarray->num_bundles; ret++) {
-		if (~bitarray->bundles[ret] == 0U) {
-			/* bundle is all 1s => all allocated, skip */
-			bit_idx += bundle_bitness(bitarray);
-			continue;
-		}
-
-		if (bitarray->bundles[ret] != 0U) {
-			/* Find the first free bit in bundle if not all free */
-			off_start = find_lsb_set(~bitarray->bundles[ret]) - 1;
-			bit_idx += off_start;
-		}
+	off_end = bitarray->num_bits - num_bits;
 
-		break;
+#ifdef CONFIG_SYS_BITARRAY_NEXT_FIT
+	search_start = bitarray->hint;
+	if (search_start > off_end) {
+		search_start = 0;
 	}
+#else
+	search_start = 0;
+#endif
 
-	off_end = bitarray->num_bits - num_bits;
 	ret = -ENOSPC;
-	while (bit_idx <= off_end) {
+	bit_idx = find_next_clear(bitarray, search_start);
+	while (true) {
+		if (bit_idx > off_end) {
+			if (search_start == 0) {
+				break;
+			}
+
+			/* Wrap around to the regions before the hint */
+			off_end = MIN(off_end, search_start - 1);
+			search_start = 0;
+			bit_idx = find_next_clear(bitarray, 0);
+			continue;
+		}
+
 		if (match_region(bitarray, bit_idx, num_bits, false,
 				 &bd, &mismatch)) {
 			set_region(bitarray, bit_idx, num_bits, true, &bd);
@@ -442,11 +522,17 @@ int sys_bitarray_alloc(sys_bitarray_t *bitarray, size_t num_bits,
 			break;
 		}
 
-		/* Fast-forward to the bit just after
+		/* Fast-forward to the first free bit after
 		 * the mismatched bit.
 		 */
-		bit_idx = mismatch + 1;
+		bit_idx = find_next_clear(bitarray, mismatch + 1);
+	}
+
+#ifdef CONFIG_SYS_BITARRAY_NEXT_FIT
+	if (ret == 0) {
+		bitarray->hint = bit_idx + num_bits;
 	}
+#endif
 
 out:
 	k_spin_unlock(&bitarray->lock, key);
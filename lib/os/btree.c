@@ -0,0 +1,457 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* The algorithms follow the classic top-down formulation of Cormen et
+ * al., "Introduction to Algorithms": full nodes are split on the way
+ * down when inserting, and nodes with the minimum number of items are
+ * refilled on the way down when removing, so no operation ever has to
+ * walk back up the tree and no parent pointer is needed.
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/sys/btree.h>
+
+#define BTREE_DEG SYS_BTREE_MIN_DEGREE
+
+enum remove_mode {
+	REMOVE_KEY,
+	REMOVE_MIN,
+	REMOVE_MAX,
+};
+
+static struct sys_btree_node *node_alloc(struct sys_btree *tree, bool leaf)
+{
+	struct sys_btree_node *node = tree->free;
+
+	if (node != NULL) {
+		tree->free = node->children[0];
+		node->count = 0U;
+		node->leaf = leaf;
+	}
+
+	return node;
+}
+
+static void node_free(struct sys_btree *tree, struct sys_btree_node *node)
+{
+	node->children[0] = tree->free;
+	tree->free = node;
+}
+
+/* Index of the first item not lower than the key */
+static size_t node_search(const struct sys_btree *tree,
+			  const struct sys_btree_node *node, const void *key,
+			  bool *found)
+{
+	size_t lo = 0;
+	size_t hi = node->count;
+
+	while (lo < hi) {
+		size_t mid = (lo + hi) / 2;
+		int ret = tree->cmp(key, node->items[mid]);
+
+		if (ret == 0) {
+			*found = true;
+			return mid;
+		}
+
+		if (ret < 0) {
+			hi = mid;
+		} else {
+			lo = mid + 1;
+		}
+	}
+
+	*found = false;
+
+	return lo;
+}
+
+/* Split the full child i of a non-full node around its median item */
+static int split_child(struct sys_btree *tree, struct sys_btree_node *node,
+		       size_t i)
+{
+	struct sys_btree_node *left = node->children[i];
+	struct sys_btree_node *right = node_alloc(tree, left->leaf);
+
+	if (right == NULL) {
+		return -ENOMEM;
+	}
+
+	memcpy(right->items, &left->items[BTREE_DEG], (BTREE_DEG - 1) * sizeof(void *));
+	if (!left->leaf) {
+		memcpy(right->children, &left->children[BTREE_DEG],
+		       BTREE_DEG * sizeof(struct sys_btree_node *));
+	}
+	right->count = BTREE_DEG - 1;
+	left->count = BTREE_DEG - 1;
+
+	memmove(&node->items[i + 1], &node->items[i],
+		(node->count - i) * sizeof(void *));
+	memmove(&node->children[i + 2], &node->children[i + 1],
+		(node->count - i) * sizeof(struct sys_btree_node *));
+	node->items[i] = left->items[BTREE_DEG - 1];
+	node->children[i + 1] = right;
+	node->count++;
+
+	return 0;
+}
+
+/* Merge child i + 1 and item i into child i, both children having the
+ * minimum number of items.
+ */
+static void merge_children(struct sys_btree *tree, struct sys_btree_node *node,
+			   size_t i)
+{
+	struct sys_btree_node *left = node->children[i];
+	struct sys_btree_node *right = node->children[i + 1];
+
+	left->items[left->count] = node->items[i];
+	memcpy(&left->items[left->count + 1], right->items,
+	       right->count * sizeof(void *));
+	if (!left->leaf) {
+		memcpy(&left->children[left->count + 1], right->children,
+		       (right->count + 1) * sizeof(struct sys_btree_node *));
+	}
+	left->count += right->count + 1;
+
+	memmove(&node->items[i], &node->items[i + 1],
+		(node->count - i - 1) * sizeof(void *));
+	memmove(&node->children[i + 1], &node->children[i + 2],
+		(node->count - i - 1) * sizeof(struct sys_btree_node *));
+	node->count--;
+
+	node_free(tree, right);
+}
+
+/* Move an item from a sibling of child i, or merge it with one, so that
+ * it holds at least BTREE_DEG items. Returns the index of the child to descend.
+ */
+static size_t fill_child(struct sys_btree *tree, struct sys_btree_node *node,
+			 size_t i)
+{
+	struct sys_btree_node *child = node->children[i];
+	struct sys_btree_node *sibling;
+
+	if (i > 0 && node->children[i - 1]->count >= BTREE_DEG) {
+		sibling = node->children[i - 1];
+
+		memmove(&child->items[1], child->items,
+			child->count * sizeof(void *));
+		if (!child->leaf) {
+			memmove(&child->children[1], child->children,
+				(child->count + 1) *
+				sizeof(struct sys_btree_node *));
+			child->children[0] = sibling->children[sibling->count];
+		}
+		child->items[0] = node->items[i - 1];
+		child->count++;
+
+		node->items[i - 1] = sibling->items[sibling->count - 1];
+		sibling->count--;
+	} else if (i < node->count && node->children[i + 1]->count >= BTREE_DEG) {
+		sibling = node->children[i + 1];
+
+		child->items[child->count] = node->items[i];
+		if (!child->leaf) {
+			child->children[child->count + 1] = sibling->children[0];
+			memmove(sibling->children, &sibling->children[1],
+				sibling->count *
+				sizeof(struct sys_btree_node *));
+		}
+		child->count++;
+
+		node->items[i] = sibling->items[0];
+		memmove(sibling->items, &sibling->items[1],
+			(sibling->count - 1) * sizeof(void *));
+		sibling->count--;
+	} else if (i < node->count) {
+		merge_children(tree, node, i);
+	} else {
+		merge_children(tree, node, --i);
+	}
+
+	return i;
+}
+
+/* Drop the root once a merge took its last item */
+static struct sys_btree_node *shrink_root(struct sys_btree *tree,
+					  struct sys_btree_node *node)
+{
+	struct sys_btree_node *child = node->children[0];
+
+	if (node == tree->root && node->count == 0U) {
+		tree->root = child;
+		node_free(tree, node);
+	}
+
+	return child;
+}
+
+static void *node_remove(struct sys_btree *tree, struct sys_btree_node *node,
+			 const void *key, enum remove_mode mode)
+{
+	void *item;
+	bool found;
+	size_t i;
+
+	for (;;) {
+		if (mode == REMOVE_KEY) {
+			i = node_search(tree, node, key, &found);
+		} else {
+			found = node->leaf;
+			i = (mode == REMOVE_MIN) ? 0 : node->count - found;
+		}
+
+		if (found && node->leaf) {
+			item = node->items[i];
+			memmove(&node->items[i], &node->items[i + 1],
+				(node->count - i - 1) * sizeof(void *));
+			node->count--;
+
+			return item;
+		}
+
+		if (found) {
+			/* Replace the item by its predecessor or successor,
+			 * taken from a child that can spare one.
+			 */
+			item = node->items[i];
+
+			if (node->children[i]->count >= BTREE_DEG) {
+				node->items[i] = node_remove(tree, node->children[i],
+							     NULL, REMOVE_MAX);
+				return item;
+			}
+
+			if (node->children[i + 1]->count >= BTREE_DEG) {
+				node->items[i] = node_remove(tree, node->children[i + 1],
+							     NULL, REMOVE_MIN);
+				return item;
+			}
+
+			/* The item moves down into the merged child */
+			merge_children(tree, node, i);
+			node = (node->count == 0U) ? shrink_root(tree, node) :
+						     node->children[i];
+			continue;
+		}
+
+		if (node->leaf) {
+			return NULL;
+		}
+
+		if (node->children[i]->count < BTREE_DEG) {
+			i = fill_child(tree, node, i);
+			if (node->count == 0U) {
+				node = shrink_root(tree, node);
+				continue;
+			}
+		}
+
+		node = node->children[i];
+	}
+}
+
+void sys_btree_init(struct sys_btree *tree, struct sys_btree_node *nodes,
+		    size_t n_nodes, sys_btree_cmp_t cmp)
+{
+	tree->root = NULL;
+	tree->free = NULL;
+	tree->cmp = cmp;
+	tree->size = 0;
+
+	for (size_t i = 0; i < n_nodes; i++) {
+		node_free(tree, &nodes[i]);
+	}
+}
+
+int sys_btree_insert(struct sys_btree *tree, void *item)
+{
+	struct sys_btree_node *node = tree->root;
+	bool found;
+	size_t i;
+	int ret;
+
+	if (node == NULL) {
+		node = node_alloc(tree, true);
+		if (node == NULL) {
+			return -ENOMEM;
+		}
+
+		tree->root = node;
+	} else if (node->count == SYS_BTREE_MAX_ITEMS) {
+		node = node_alloc(tree, false);
+		if (node == NULL) {
+			return -ENOMEM;
+		}
+
+		node->children[0] = tree->root;
+		ret = split_child(tree, node, 0);
+		if (ret < 0) {
+			node_free(tree, node);
+			return ret;
+		}
+
+		tree->root = node;
+	}
+
+	for (;;) {
+		i = node_search(tree, node, item, &found);
+		if (found) {
+			return -EEXIST;
+		}
+
+		if (node->leaf) {
+			break;
+		}
+
+		if (node->children[i]->count == SYS_BTREE_MAX_ITEMS) {
+			ret = split_child(tree, node, i);
+			if (ret < 0) {
+				return ret;
+			}
+
+			ret = tree->cmp(item, node->items[i]);
+			if (ret == 0) {
+				return -EEXIST;
+			}
+
+			if (ret > 0) {
+				i++;
+			}
+		}
+
+		node = node->children[i];
+	}
+
+	memmove(&node->items[i + 1], &node->items[i],
+		(node->count - i) * sizeof(void *));
+	node->items[i] = item;
+	node->count++;
+	tree->size++;
+
+	return 0;
+}
+
+void *sys_btree_remove(struct sys_btree *tree, const void *key)
+{
+	void *item;
+
+	if (tree->root == NULL) {
+		return NULL;
+	}
+
+	item = node_remove(tree, tree->root, key, REMOVE_KEY);
+	if (item != NULL) {
+		tree->size--;
+	}
+
+	if (tree->root->count == 0U) {
+		/* Only an empty leaf root can be left without items */
+		node_free(tree, tree->root);
+		tree->root = NULL;
+	}
+
+	return item;
+}
+
+void *sys_btree_find(const struct sys_btree *tree, const void *key)
+{
+	const struct sys_btree_node *node = tree->root;
+	bool found;
+	size_t i;
+
+	while (node != NULL) {
+		i = node_search(tree, node, key, &found);
+		if (found) {
+			return node->items[i];
+		}
+
+		node = node->leaf ? NULL : node->children[i];
+	}
+
+	return NULL;
+}
+
+void *sys_btree_find_ge(const struct sys_btree *tree, const void *key)
+{
+	const struct sys_btree_node *node = tree->root;
+	void *candidate = NULL;
+	bool found;
+	size_t i;
+
+	while (node != NULL) {
+		i = node_search(tree, node, key, &found);
+		if (found) {
+			return node->items[i];
+		}
+
+		if (i < node->count) {
+			candidate = node->items[i];
+		}
+
+		node = node->leaf ? NULL : node->children[i];
+	}
+
+	return candidate;
+}
+
+void *sys_btree_min(const struct sys_btree *tree)
+{
+	const struct sys_btree_node *node = tree->root;
+
+	if (node == NULL) {
+		return NULL;
+	}
+
+	while (!node->leaf) {
+		node = node->children[0];
+	}
+
+	return node->items[0];
+}
+
+void *sys_btree_max(const struct sys_btree *tree)
+{
+	const struct sys_btree_node *node = tree->root;
+
+	if (node == NULL) {
+		return NULL;
+	}
+
+	while (!node->leaf) {
+		node = node->children[node->count];
+	}
+
+	return node->items[node->count - 1];
+}
+
+static bool node_foreach(const struct sys_btree_node *node,
+			 sys_btree_visit_t visit, void *user_data)
+{
+	for (size_t i = 0; i <= node->count; i++) {
+		if (!node->leaf &&
+		    !node_foreach(node->children[i], visit, user_data)) {
+			return false;
+		}
+
+		if (i < node->count && !visit(node->items[i], user_data)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void sys_btree_foreach(const struct sys_btree *tree, sys_btree_visit_t visit,
+		       void *user_data)
+{
+	if (tree->root != NULL) {
+		(void)node_foreach(tree->root, visit, user_data);
+	}
+}
@@ -15,6 +15,13 @@
 #include <zephyr/sys/util.h>
 #include <zephyr/sys/__assert.h>
 
+#if defined(CONFIG_CBPRINTF_PACKAGE_FMT_CACHE) && \
+	!defined(CBPRINTF_VIA_UNIT_TEST)
+#define FMT_CACHE_ENABLED 1
+#include <zephyr/spinlock.h>
+#include <zephyr/syscall.h>
+#endif
+
 #if defined(CONFIG_CBPRINTF_PACKAGE_SUPPORT_TAGGED_ARGUMENTS) && \
 	!Z_C_GENERIC
 #error "CONFIG_CBPRINTF_PACKAGE_SUPPORT_TAGGED_ARGUMENTS " \
@@ -40,6 +47,99 @@ static inline bool ptr_in_rodata(const char *addr)
 #endif
 }
 
+#ifdef FMT_CACHE_ENABLED
+/*
+ * Argument layout cache. Format strings located in read only memory cannot
+ * change so the size, alignment and type of their arguments can be reused
+ * instead of parsing the format string again on each packaging.
+ */
+enum fmt_arg_type {
+	FMT_ARG_VAL,
+	FMT_ARG_STR,
+	FMT_ARG_DOUBLE,
+	FMT_ARG_LONG_DOUBLE,
+};
+
+struct fmt_arg {
+	uint8_t type;
+	uint8_t size;
+	uint8_t align;
+};
+
+struct fmt_desc {
+	const char *fmt;
+	uint8_t arg_cnt;
+	struct fmt_arg args[CONFIG_CBPRINTF_PACKAGE_FMT_CACHE_ARGS];
+};
+
+static struct fmt_desc fmt_cache[CONFIG_CBPRINTF_PACKAGE_FMT_CACHE_SIZE];
+static struct k_spinlock fmt_cache_lock;
+
+static inline struct fmt_desc *fmt_cache_slot(const char *fmt)
+{
+	return &fmt_cache[((uintptr_t)fmt / sizeof(int)) % ARRAY_SIZE(fmt_cache)];
+}
+
+static bool fmt_cache_usable(const char *fmt, uint32_t flags)
+{
+	if ((flags & CBPRINTF_PACKAGE_ARGS_ARE_TAGGED) ==
+	    CBPRINTF_PACKAGE_ARGS_ARE_TAGGED) {
+		return false;
+	}
+
+	if (IS_ENABLED(CONFIG_USERSPACE) && k_is_user_context()) {
+		return false;
+	}
+
+	return ptr_in_rodata(fmt);
+}
+
+static bool fmt_cache_get(const char *fmt, struct fmt_desc *desc)
+{
+	struct fmt_desc *entry = fmt_cache_slot(fmt);
+	k_spinlock_key_t key = k_spin_lock(&fmt_cache_lock);
+	bool hit = (entry->fmt == fmt);
+
+	if (hit) {
+		desc->fmt = fmt;
+		desc->arg_cnt = entry->arg_cnt;
+		memcpy(desc->args, entry->args,
+		       entry->arg_cnt * sizeof(struct fmt_arg));
+	}
+	k_spin_unlock(&fmt_cache_lock, key);
+
+	return hit;
+}
+
+static void fmt_cache_put(const struct fmt_desc *desc)
+{
+	struct fmt_desc *entry = fmt_cache_slot(desc->fmt);
+	k_spinlock_key_t key = k_spin_lock(&fmt_cache_lock);
+
+	entry->fmt = desc->fmt;
+	entry->arg_cnt = desc->arg_cnt;
+	memcpy(entry->args, desc->args, desc->arg_cnt * sizeof(struct fmt_arg));
+	k_spin_unlock(&fmt_cache_lock, key);
+}
+
+/* Returns false if argument does not fit and format cannot be cached. */
+static inline bool fmt_desc_add(struct fmt_desc *desc, uint8_t type,
+				unsigned int size, unsigned int align)
+{
+	if (desc->arg_cnt == ARRAY_SIZE(desc->args)) {
+		return false;
+	}
+
+	desc->args[desc->arg_cnt++] = (struct fmt_arg){
+		.type = type,
+		.size = size,
+		.align = align
+	};
+
+	return true;
+}
+#endif /* FMT_CACHE_ENABLED */
+
 /*
  * va_list creation
  */
@@ -264,6 +364,12 @@ int cbvprintf_package(void *packaged, size_t len, uint32_t flags,
 	int fros_cnt = 1 + Z_CBPRINTF_PACKAGE_FIRST_RO_STR_CNT_GET(flags);
 	bool is_str_arg = false;
 	union cbprintf_package_hdr *pkg_hdr = packaged;
+#ifdef FMT_CACHE_ENABLED
+	struct fmt_desc desc;       /* cached or recorded argument layout */
+	bool desc_cached = false;   /* arguments are taken from desc */
+	bool desc_record = false;   /* arguments are recorded into desc */
+	unsigned int desc_idx = 0;  /* index into desc.args[] */
+#endif
 
 	/* Buffer must be aligned at least to size of a pointer. */
 	if ((uintptr_t)packaged % sizeof(void *)) {
@@ -331,6 +437,17 @@ int cbvprintf_package(void *packaged, size_t len, uint32_t flags,
 	 * reason for the post-decrement on fmt as it will be incremented
 	 * prior to the next (actually first) round of that loop.
 	 */
+#ifdef FMT_CACHE_ENABLED
+	if (fmt_cache_usable(fmt, flags)) {
+		desc_cached = fmt_cache_get(fmt, &desc);
+		if (!desc_cached) {
+			desc.fmt = fmt;
+			desc.arg_cnt = 0;
+			desc_record = true;
+		}
+	}
+#endif
+
 	s = fmt--;
 	align = VA_STACK_ALIGN(char *);
 	size = sizeof(char *);
@@ -459,6 +576,49 @@ int cbvprintf_package(void *packaged, size_t len, uint32_t flags,
 
 		} else
 #endif /* CONFIG_CBPRINTF_PACKAGE_SUPPORT_TAGGED_ARGUMENTS */
+#ifdef FMT_CACHE_ENABLED
+		if (desc_cached) {
+			const struct fmt_arg *arg;
+
+			if (desc_idx == desc.arg_cnt) {
+				/* End of arguments */
+				break;
+			}
+
+			arg = &desc.args[desc_idx++];
+			if (arg->type == FMT_ARG_DOUBLE ||
+			    arg->type == FMT_ARG_LONG_DOUBLE) {
+				union { double d; long double ld; } v;
+
+				if (arg->type == FMT_ARG_LONG_DOUBLE) {
+					v.ld = va_arg(ap, long double);
+				} else {
+					v.d = va_arg(ap, double);
+				}
+				/* align destination buffer location */
+				buf = (void *) ROUND_UP(buf, arg->align);
+				if (buf0 != NULL) {
+					/* make sure it fits */
+					if (BUF_OFFSET + arg->size > len) {
+						return -ENOSPC;
+					}
+					if (Z_CBPRINTF_VA_STACK_LL_DBL_MEMCPY) {
+						memcpy(buf, &v, arg->size);
+					} else if (arg->type == FMT_ARG_LONG_DOUBLE) {
+						*(long double *)buf = v.ld;
+					} else {
+						*(double *)buf = v.d;
+					}
+				}
+				buf += arg->size;
+				continue;
+			}
+
+			is_str_arg = (arg->type == FMT_ARG_STR);
+			align = arg->align;
+			size = arg->size;
+		} else
+#endif /* FMT_CACHE_ENABLED */
 		{
 			/* Scan the format string */
 			if (*++fmt == '\0') {
@@ -569,6 +729,14 @@ int cbvprintf_package(void *packaged, size_t len, uint32_t flags,
 					align = VA_STACK_ALIGN(double);
 					size = sizeof(double);
 				}
+#ifdef FMT_CACHE_ENABLED
+				if (desc_record) {
+					desc_record = fmt_desc_add(&desc,
+						(fmt[-1] == 'L') ? FMT_ARG_LONG_DOUBLE :
+								   FMT_ARG_DOUBLE,
+						size, align);
+				}
+#endif
 				/* align destination buffer location */
 				buf = (void *) ROUND_UP(buf, align);
 				if (buf0 != NULL) {
@@ -603,6 +771,14 @@ int cbvprintf_package(void *packaged, size_t len, uint32_t flags,
 			return -ENOSPC;
 		}
 
+#ifdef FMT_CACHE_ENABLED
+		if (desc_record) {
+			desc_record = fmt_desc_add(&desc,
+					is_str_arg ? FMT_ARG_STR : FMT_ARG_VAL,
+					size, align);
+		}
+#endif
+
 		/* copy va_list data over to our buffer */
 		if (is_str_arg) {
 			s = va_arg(ap, char *);
@@ -709,6 +885,12 @@ process_string:
 		return -EINVAL;
 	}
 
+#ifdef FMT_CACHE_ENABLED
+	if (desc_record) {
+		fmt_cache_put(&desc);
+	}
+#endif
+
 	/*
 	 * If all we wanted was to count required buffer size
 	 * then we have it now.
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <zephyr/kernel.h>
+#include <zephyr/cache.h>
+#include <zephyr/sys/dma_buf.h>
+
+/* Where an allocated buffer came from */
+#define DMA_BUF_FROM_NOCACHE_HEAP	BIT(6)
+#define DMA_BUF_FROM_SYSTEM_HEAP	BIT(7)
+
+#if CONFIG_SYS_DMA_BUF_NOCACHE_HEAP_SIZE > 0
+K_HEAP_DEFINE_NOCACHE(dma_buf_nocache_heap, CONFIG_SYS_DMA_BUF_NOCACHE_HEAP_SIZE);
+#endif
+
+static size_t dma_buf_align(void)
+{
+	return MAX(sys_cache_data_line_size_get(), sizeof(void *));
+}
+
+static bool dma_buf_needs_maintenance(const struct sys_dma_buf *buf)
+{
+	return IS_ENABLED(CONFIG_DCACHE) && (buf->flags & SYS_DMA_BUF_COHERENT) == 0;
+}
+
+int sys_dma_buf_init(struct sys_dma_buf *buf, void *addr, size_t size,
+		     uint8_t flags)
+{
+	size_t line_size = sys_cache_data_line_size_get();
+
+	if (IS_ENABLED(CONFIG_DCACHE) && (flags & SYS_DMA_BUF_COHERENT) == 0 &&
+	    line_size > 0 &&
+	    ((uintptr_t)addr % line_size != 0 || size % line_size != 0)) {
+		return -EINVAL;
+	}
+
+	buf->addr = addr;
+	buf->size = size;
+	buf->owner = SYS_DMA_BUF_OWNER_CPU;
+	buf->flags = flags & SYS_DMA_BUF_COHERENT;
+
+	return 0;
+}
+
+int sys_dma_buf_alloc(struct sys_dma_buf *buf, size_t size)
+{
+	void *addr;
+
+	if (size == 0) {
+		return -EINVAL;
+	}
+
+#if CONFIG_SYS_DMA_BUF_NOCACHE_HEAP_SIZE > 0
+	addr = k_heap_alloc(&dma_buf_nocache_heap, size, K_NO_WAIT);
+	if (addr != NULL) {
+		(void)sys_dma_buf_init(buf, addr, size, SYS_DMA_BUF_COHERENT);
+		buf->flags |= DMA_BUF_FROM_NOCACHE_HEAP;
+		return 0;
+	}
+#endif
+
+#if CONFIG_HEAP_MEM_POOL_SIZE > 0
+	size = ROUND_UP(size, dma_buf_align());
+	addr = k_aligned_alloc(dma_buf_align(), size);
+	if (addr != NULL) {
+		(void)sys_dma_buf_init(buf, addr, size, 0);
+		buf->flags |= DMA_BUF_FROM_SYSTEM_HEAP;
+		return 0;
+	}
+#endif
+
+	ARG_UNUSED(addr);
+
+	return -ENOMEM;
+}
+
+void sys_dma_buf_free(struct sys_dma_buf *buf)
+{
+	__ASSERT(buf->owner == SYS_DMA_BUF_OWNER_CPU, "DMA buffer owned by device");
+
+#if CONFIG_SYS_DMA_BUF_NOCACHE_HEAP_SIZE > 0
+	if ((buf->flags & DMA_BUF_FROM_NOCACHE_HEAP) != 0) {
+		k_heap_free(&dma_buf_nocache_heap, buf->addr);
+	}
+#endif
+
+#if CONFIG_HEAP_MEM_POOL_SIZE > 0
+	if ((buf->flags & DMA_BUF_FROM_SYSTEM_HEAP) != 0) {
+		k_free(buf->addr);
+	}
+#endif
+
+	buf->addr = NULL;
+	buf->size = 0;
+	buf->flags = 0;
+}
+
+/*
+ * Hand all buffers over to a new owner, performing the cache operation
+ * on the buffers that need it and waiting for completion only once.
+ */
+static int dma_buf_hand_over(struct sys_dma_buf *bufs, size_t cnt,
+			     enum sys_dma_buf_owner owner, int op)
+{
+	bool maintenance = false;
+	int ret = 0;
+
+	/* Check all buffers first, so that none is handed over on error */
+	for (size_t i = 0; i < cnt; i++) {
+		if (bufs[i].owner == owner) {
+			return -EBUSY;
+		}
+
+		maintenance |= dma_buf_needs_maintenance(&bufs[i]);
+	}
+
+	if (maintenance) {
+		sys_cache_data_sync();
+
+		for (size_t i = 0; i < cnt; i++) {
+			if (!dma_buf_needs_maintenance(&bufs[i])) {
+				continue;
+			}
+
+			ret = sys_cache_data_range_nosync(bufs[i].addr,
+							  bufs[i].size, op);
+			if (ret != 0) {
+				return ret;
+			}
+		}
+
+		sys_cache_data_sync();
+	}
+
+	for (size_t i = 0; i < cnt; i++) {
+		bufs[i].owner = owner;
+	}
+
+	return 0;
+}
+
+int sys_dma_buf_to_device(struct sys_dma_buf *bufs, size_t cnt)
+{
+	return dma_buf_hand_over(bufs, cnt, SYS_DMA_BUF_OWNER_DEVICE, K_CACHE_WB);
+}
+
+int sys_dma_buf_to_cpu(struct sys_dma_buf *bufs, size_t cnt)
+{
+	return dma_buf_hand_over(bufs, cnt, SYS_DMA_BUF_OWNER_CPU, K_CACHE_INVD);
+}
@@ -0,0 +1,394 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/sys/futex_sync.h>
+
+#define FMUTEX_UNLOCKED		0
+#define FMUTEX_LOCKED		1
+#define FMUTEX_CONTENDED	2
+
+#define RWLOCK_READERS		0x1fffffff
+#define RWLOCK_WAITERS		0x20000000
+#define RWLOCK_WRITER		0x40000000
+
+#define ONCE_INIT		0
+#define ONCE_RUNNING		1
+#define ONCE_CONTENDED		2
+#define ONCE_DONE		3
+
+/* Wait for the futex to change from @a expected. Returns 0 when the caller
+ * shall check the futex again, or the error to return.
+ */
+static int futex_wait(struct k_futex *futex, atomic_val_t expected,
+		      k_timeout_t timeout)
+{
+	int ret = k_futex_wait(futex, expected, timeout);
+
+	if (ret == -ETIMEDOUT) {
+		return -EAGAIN;
+	}
+
+	/* -EAGAIN: the value changed before we could wait */
+	return (ret == -EAGAIN) ? 0 : ret;
+}
+
+/* Remaining part of @a timeout, whose absolute expiry @a end was computed
+ * once with sys_clock_timeout_end_calc(), so that looping over futex_wait()
+ * does not restart the full timeout on every spurious wakeup.
+ */
+static k_timeout_t timeout_remaining(k_timeout_t timeout, uint64_t end)
+{
+	int64_t remaining;
+
+	if (K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+		return K_FOREVER;
+	}
+
+	remaining = (int64_t)(end - sys_clock_tick_get());
+
+	return (remaining > 0) ? K_TICKS(remaining) : K_NO_WAIT;
+}
+
+void sys_fmutex_init(struct sys_fmutex *mutex)
+{
+	atomic_set(&mutex->futex.val, FMUTEX_UNLOCKED);
+	mutex->owner = NULL;
+	mutex->lock_count = 0U;
+}
+
+static int fmutex_lock_contended(struct sys_fmutex *mutex,
+				 k_timeout_t timeout)
+{
+	uint64_t end = sys_clock_timeout_end_calc(timeout);
+	int ret;
+
+	/* Owner might be about to unlock on another CPU */
+	for (int i = 0; i < CONFIG_SYS_FUTEX_SYNC_SPIN_COUNT; i++) {
+		if (atomic_get(&mutex->futex.val) == FMUTEX_UNLOCKED &&
+		    atomic_cas(&mutex->futex.val, FMUTEX_UNLOCKED,
+			       FMUTEX_LOCKED)) {
+			return 0;
+		}
+	}
+
+	/* Marking the mutex contended, even if we end up taking it, tells
+	 * the owner to wake up waiters on unlock.
+	 */
+	while (atomic_set(&mutex->futex.val, FMUTEX_CONTENDED) !=
+	       FMUTEX_UNLOCKED) {
+		ret = futex_wait(&mutex->futex, FMUTEX_CONTENDED,
+				 timeout_remaining(timeout, end));
+		if (ret != 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+int sys_fmutex_lock(struct sys_fmutex *mutex, k_timeout_t timeout)
+{
+	k_tid_t self = k_current_get();
+	int ret;
+
+	if (mutex->owner == self) {
+		mutex->lock_count++;
+		return 0;
+	}
+
+	if (!atomic_cas(&mutex->futex.val, FMUTEX_UNLOCKED, FMUTEX_LOCKED)) {
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			return -EBUSY;
+		}
+
+		ret = fmutex_lock_contended(mutex, timeout);
+		if (ret != 0) {
+			return ret;
+		}
+	}
+
+	mutex->owner = self;
+	mutex->lock_count = 1U;
+
+	return 0;
+}
+
+int sys_fmutex_unlock(struct sys_fmutex *mutex)
+{
+	int ret = 0;
+
+	if (mutex->lock_count == 0U) {
+		return -EINVAL;
+	}
+
+	if (mutex->owner != k_current_get()) {
+		return -EPERM;
+	}
+
+	mutex->lock_count--;
+	if (mutex->lock_count > 0U) {
+		return 0;
+	}
+
+	mutex->owner = NULL;
+	if (atomic_dec(&mutex->futex.val) != FMUTEX_LOCKED) {
+		atomic_set(&mutex->futex.val, FMUTEX_UNLOCKED);
+		ret = k_futex_wake(&mutex->futex, false);
+	}
+
+	return ret < 0 ? ret : 0;
+}
+
+void sys_rwlock_init(struct sys_rwlock *rwlock)
+{
+	atomic_set(&rwlock->futex.val, 0);
+}
+
+/* Flag the lock as waited for, then wait for it to change */
+static int rwlock_wait(struct sys_rwlock *rwlock, atomic_val_t value,
+		       k_timeout_t timeout)
+{
+	if ((value & RWLOCK_WAITERS) == 0 &&
+	    !atomic_cas(&rwlock->futex.val, value, value | RWLOCK_WAITERS)) {
+		return 0;
+	}
+
+	return futex_wait(&rwlock->futex, value | RWLOCK_WAITERS, timeout);
+}
+
+int sys_rwlock_read_lock(struct sys_rwlock *rwlock, k_timeout_t timeout)
+{
+	uint64_t end = sys_clock_timeout_end_calc(timeout);
+	atomic_val_t value;
+	int ret;
+
+	for (;;) {
+		value = atomic_get(&rwlock->futex.val);
+		if ((value & (RWLOCK_WRITER | RWLOCK_WAITERS)) == 0) {
+			if (atomic_cas(&rwlock->futex.val, value, value + 1)) {
+				return 0;
+			}
+			continue;
+		}
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			return -EBUSY;
+		}
+
+		ret = rwlock_wait(rwlock, value,
+				  timeout_remaining(timeout, end));
+		if (ret != 0) {
+			return ret;
+		}
+	}
+}
+
+int sys_rwlock_read_unlock(struct sys_rwlock *rwlock)
+{
+	atomic_val_t value;
+	int ret;
+
+	for (;;) {
+		value = atomic_get(&rwlock->futex.val);
+		if ((value & RWLOCK_READERS) == 0 ||
+		    (value & RWLOCK_WRITER) != 0) {
+			return -EINVAL;
+		}
+
+		if ((value & RWLOCK_READERS) > 1 ||
+		    (value & RWLOCK_WAITERS) == 0) {
+			if (atomic_cas(&rwlock->futex.val, value, value - 1)) {
+				return 0;
+			}
+			continue;
+		}
+
+		/* Last reader out, with threads waiting */
+		if (atomic_cas(&rwlock->futex.val, value, 0)) {
+			ret = k_futex_wake(&rwlock->futex, true);
+			return ret < 0 ? ret : 0;
+		}
+	}
+}
+
+int sys_rwlock_write_lock(struct sys_rwlock *rwlock, k_timeout_t timeout)
+{
+	uint64_t end = sys_clock_timeout_end_calc(timeout);
+	atomic_val_t value;
+	int ret;
+
+	for (;;) {
+		value = atomic_get(&rwlock->futex.val);
+		if (value == 0) {
+			if (atomic_cas(&rwlock->futex.val, 0, RWLOCK_WRITER)) {
+				return 0;
+			}
+			continue;
+		}
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			return -EBUSY;
+		}
+
+		ret = rwlock_wait(rwlock, value,
+				  timeout_remaining(timeout, end));
+		if (ret != 0) {
+			return ret;
+		}
+	}
+}
+
+int sys_rwlock_write_unlock(struct sys_rwlock *rwlock)
+{
+	atomic_val_t value;
+	int ret = 0;
+
+	if ((atomic_get(&rwlock->futex.val) & RWLOCK_WRITER) == 0) {
+		return -EINVAL;
+	}
+
+	value = atomic_set(&rwlock->futex.val, 0);
+	if ((value & RWLOCK_WAITERS) != 0) {
+		ret = k_futex_wake(&rwlock->futex, true);
+	}
+
+	return ret < 0 ? ret : 0;
+}
+
+void sys_condvar_init(struct sys_condvar *condvar)
+{
+	atomic_set(&condvar->futex.val, 0);
+	atomic_set(&condvar->waiters, 0);
+}
+
+static int condvar_wake(struct sys_condvar *condvar, bool wake_all)
+{
+	int ret = 0;
+
+	atomic_inc(&condvar->futex.val);
+	if (atomic_get(&condvar->waiters) > 0) {
+		ret = k_futex_wake(&condvar->futex, wake_all);
+	}
+
+	return ret < 0 ? ret : 0;
+}
+
+int sys_condvar_signal(struct sys_condvar *condvar)
+{
+	return condvar_wake(condvar, false);
+}
+
+int sys_condvar_broadcast(struct sys_condvar *condvar)
+{
+	return condvar_wake(condvar, true);
+}
+
+int sys_condvar_wait(struct sys_condvar *condvar, struct sys_fmutex *mutex,
+		     k_timeout_t timeout)
+{
+	k_tid_t self = k_current_get();
+	uint32_t lock_count;
+	atomic_val_t seq;
+	int ret;
+
+	if (mutex->lock_count == 0U || mutex->owner != self) {
+		return -EPERM;
+	}
+
+	/* Registering as a waiter before sampling the sequence number, the
+	 * mutex still held, guarantees a signal sent once the mutex is
+	 * released is not missed.
+	 */
+	atomic_inc(&condvar->waiters);
+	seq = atomic_get(&condvar->futex.val);
+
+	lock_count = mutex->lock_count;
+	mutex->lock_count = 1U;
+	(void)sys_fmutex_unlock(mutex);
+
+	ret = futex_wait(&condvar->futex, seq, timeout);
+	atomic_dec(&condvar->waiters);
+
+	if (!atomic_cas(&mutex->futex.val, FMUTEX_UNLOCKED, FMUTEX_LOCKED)) {
+		(void)fmutex_lock_contended(mutex, K_FOREVER);
+	}
+	mutex->owner = self;
+	mutex->lock_count = lock_count;
+
+	return ret;
+}
+
+int sys_barrier_init(struct sys_barrier *barrier, unsigned int parties)
+{
+	if (parties == 0U || parties > INT_MAX) {
+		return -EINVAL;
+	}
+
+	atomic_set(&barrier->futex.val, 0);
+	atomic_set(&barrier->count, 0);
+	barrier->parties = parties;
+
+	return 0;
+}
+
+int sys_barrier_wait(struct sys_barrier *barrier)
+{
+	atomic_val_t generation = atomic_get(&barrier->futex.val);
+	int ret;
+
+	if ((atomic_inc(&barrier->count) + 1) < (atomic_val_t)barrier->parties) {
+		do {
+			ret = futex_wait(&barrier->futex, generation,
+					 K_FOREVER);
+			if (ret != 0) {
+				return ret;
+			}
+		} while (atomic_get(&barrier->futex.val) == generation);
+
+		return 0;
+	}
+
+	/* Reset the count before opening, for waiters to reuse the
+	 * barrier right away.
+	 */
+	atomic_set(&barrier->count, 0);
+	atomic_inc(&barrier->futex.val);
+	ret = k_futex_wake(&barrier->futex, true);
+
+	return ret < 0 ? ret : 1;
+}
+
+void sys_once_init(struct sys_once *once)
+{
+	atomic_set(&once->futex.val, ONCE_INIT);
+}
+
+void sys_once(struct sys_once *once, void (*fn)(void))
+{
+	atomic_val_t value;
+	int ret;
+
+	if (atomic_get(&once->futex.val) == ONCE_DONE) {
+		return;
+	}
+
+	if (atomic_cas(&once->futex.val, ONCE_INIT, ONCE_RUNNING)) {
+		fn();
+		if (atomic_set(&once->futex.val, ONCE_DONE) == ONCE_CONTENDED) {
+			(void)k_futex_wake(&once->futex, true);
+		}
+		return;
+	}
+
+	while ((value = atomic_get(&once->futex.val)) != ONCE_DONE) {
+		if (value == ONCE_RUNNING &&
+		    !atomic_cas(&once->futex.val, ONCE_RUNNING, ONCE_CONTENDED)) {
+			continue;
+		}
+		ret = k_futex_wait(&once->futex, ONCE_CONTENDED, K_FOREVER);
+		__ASSERT(ret == 0 || ret == -EAGAIN, "invalid once control");
+	}
+}
@@ -6,6 +6,7 @@
 #include <zephyr/sys/sys_heap.h>
 #include <zephyr/sys/util.h>
 #include <zephyr/kernel.h>
+#include <string.h>
 #include "heap.h"
 
 /* White-box sys_heap validation code.  Uses internal data structures.
@@ -68,6 +69,28 @@ static inline void check_nexts(struct z_heap *h, int bidx)
 	}
 }
 
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+/* Parked chunks must be in use, of their list's size, and each list
+ * must hold exactly as many chunks as its count says.
+ */
+static bool valid_size_classes(struct z_heap *h)
+{
+	for (int i = 0; i < ARRAY_SIZE(h->classes); i++) {
+		struct z_heap_class *cl = &h->classes[i];
+		uint32_t n = 0;
+
+		for (chunkid_t c = cl->next; c != 0; c = next_free_chunk(h, c)) {
+			VALIDATE(n++ < cl->count);
+			VALIDATE(in_bounds(h, c));
+			VALIDATE(chunk_used(h, c));
+			VALIDATE(size_class(h, chunk_size(h, c)) == cl);
+		}
+		VALIDATE(n == cl->count);
+	}
+	return true;
+}
+#endif
+
 static void get_alloc_info(struct z_heap *h, size_t *alloc_bytes,
 			   size_t *free_bytes)
 {
@@ -83,6 +106,16 @@ static void get_alloc_info(struct z_heap *h, size_t *alloc_bytes,
 			*free_bytes += chunksz_to_bytes(h, chunk_size(h, c));
 		}
 	}
+
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	/* Parked chunks look used but are accounted as free */
+	for (int i = 0; i < ARRAY_SIZE(h->classes); i++) {
+		for (c = h->classes[i].next; c != 0; c = next_free_chunk(h, c)) {
+			*alloc_bytes -= chunksz_to_bytes(h, chunk_size(h, c));
+			*free_bytes += chunksz_to_bytes(h, chunk_size(h, c));
+		}
+	}
+#endif
 }
 
 bool sys_heap_validate(struct sys_heap *heap)
@@ -102,6 +135,12 @@ bool sys_heap_validate(struct sys_heap *heap)
 		return false;  /* Should have exactly consumed the buffer */
 	}
 
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	if (!valid_size_classes(h)) {
+		return false;
+	}
+#endif
+
 #ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
 	/*
 	 * Validate sys_heap_runtime_stats_get API.
@@ -439,3 +478,68 @@ int sys_heap_runtime_stats_reset_max(struct sys_heap *heap)
 }
 
 #endif
+
+#ifdef CONFIG_SYS_HEAP_PROFILE
+
+int sys_heap_profile_get(struct sys_heap *heap,
+			 struct sys_heap_profile *profile)
+{
+	if ((heap == NULL) || (profile == NULL)) {
+		return -EINVAL;
+	}
+
+	struct z_heap *h = heap->heap;
+	size_t free_bytes = 0, largest = 0;
+
+	*profile = h->profile;
+
+	for (int b = 0; b <= bucket_idx(h, h->end_chunk); b++) {
+		chunkid_t first = h->buckets[b].next, c = first;
+
+		if (first == 0) {
+			continue;
+		}
+		do {
+			size_t bytes = chunksz_to_bytes(h, chunk_size(h, c));
+
+			free_bytes += bytes;
+			largest = MAX(largest, bytes);
+			c = next_free_chunk(h, c);
+		} while (c != first);
+	}
+
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	/* Parked chunks are free, though not for bigger allocations */
+	for (int i = 0; i < ARRAY_SIZE(h->classes); i++) {
+		for (chunkid_t c = h->classes[i].next; c != 0;
+		     c = next_free_chunk(h, c)) {
+			free_bytes += chunksz_to_bytes(h, chunk_size(h, c));
+		}
+	}
+#endif
+
+	profile->free_bytes = free_bytes;
+	profile->largest_free_bytes = largest;
+	profile->fragmentation = (free_bytes == 0U) ? 0U :
+		1000U - (uint32_t)(((uint64_t)largest * 1000U) / free_bytes);
+
+	return 0;
+}
+
+int sys_heap_profile_reset(struct sys_heap *heap)
+{
+	if (heap == NULL) {
+		return -EINVAL;
+	}
+
+	struct sys_heap_profile *p = &heap->heap->profile;
+
+	(void)memset(p->size_hist, 0, sizeof(p->size_hist));
+	(void)memset(p->alloc_cycles_hist, 0, sizeof(p->alloc_cycles_hist));
+	(void)memset(p->free_cycles_hist, 0, sizeof(p->free_cycles_hist));
+	p->failed_allocs = 0;
+
+	return 0;
+}
+
+#endif
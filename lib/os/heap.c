@@ -13,6 +13,10 @@
 #include <sanitizer/msan_interface.h>
 #endif
 
+/* Z_HEAP_MIN_SIZE in kernel.h is derived from this size */
+BUILD_ASSERT(sizeof(struct z_heap) == Z_HEAP_STRUCT_SIZE,
+	     "Z_HEAP_STRUCT_SIZE does not match struct z_heap");
+
 #ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
 static inline void increase_allocated_bytes(struct z_heap *h, size_t num_bytes)
 {
@@ -160,7 +164,76 @@ static chunkid_t mem_to_chunkid(struct z_heap *h, void *p)
 	return (mem - chunk_header_bytes(h) - base) / CHUNK_UNIT;
 }
 
-void sys_heap_free(struct sys_heap *heap, void *mem)
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+/* Parks a chunk that was just freed on its size class list.  It keeps
+ * its used bit so it can't be merged with its neighbours, but it is
+ * accounted as free memory by the runtime stats.
+ */
+static void size_class_push(struct z_heap *h, struct z_heap_class *cl,
+			    chunkid_t c)
+{
+	set_next_free_chunk(h, c, cl->next);
+	cl->next = c;
+	cl->count++;
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	h->free_bytes += chunksz_to_bytes(h, chunk_size(h, c));
+#endif
+}
+
+static chunkid_t size_class_pop(struct z_heap *h, struct z_heap_class *cl)
+{
+	chunkid_t c = cl->next;
+
+	if (c != 0U) {
+		CHECK(chunk_used(h, c));
+		CHECK(size_class(h, chunk_size(h, c)) == cl);
+
+		cl->next = next_free_chunk(h, c);
+		cl->count--;
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+		h->free_bytes -= chunksz_to_bytes(h, chunk_size(h, c));
+#endif
+	}
+
+	return c;
+}
+
+/* Returns up to "count" parked chunks of a class to the heap proper */
+static bool size_class_flush(struct z_heap *h, struct z_heap_class *cl,
+			     uint32_t count)
+{
+	bool flushed = false;
+
+	while (count-- > 0U) {
+		chunkid_t c = size_class_pop(h, cl);
+
+		if (c == 0U) {
+			break;
+		}
+
+		set_chunk_used(h, c, false);
+		free_chunk(h, c);
+		flushed = true;
+	}
+
+	return flushed;
+}
+
+static bool size_class_flush_all(struct z_heap *h)
+{
+	bool flushed = false;
+
+	for (int i = 0; i < ARRAY_SIZE(h->classes); i++) {
+		flushed |= size_class_flush(h, &h->classes[i], UINT32_MAX);
+	}
+
+	return flushed;
+}
+#endif
+
+static void heap_free(struct sys_heap *heap, void *mem)
 {
 	if (mem == NULL) {
 		return; /* ISO C free() semantics */
@@ -184,7 +257,6 @@ void sys_heap_free(struct sys_heap *heap, void *mem)
 		 "corrupted heap bounds (buffer overflow?) for memory at %p",
 		 mem);
 
-	set_chunk_used(h, c, false);
 #ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
 	h->allocated_bytes -= chunksz_to_bytes(h, chunk_size(h, c));
 #endif
@@ -194,6 +266,21 @@ void sys_heap_free(struct sys_heap *heap, void *mem)
 				  chunksz_to_bytes(h, chunk_size(h, c)));
 #endif
 
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	struct z_heap_class *cl = size_class(h, chunk_size(h, c));
+
+	if (cl != NULL) {
+		/* Make room by giving half of a full class back in bulk */
+		if (cl->count >= CONFIG_SYS_HEAP_SIZE_CLASS_DEPTH) {
+			size_class_flush(h, cl,
+					 CONFIG_SYS_HEAP_SIZE_CLASS_DEPTH / 2);
+		}
+		size_class_push(h, cl, c);
+		return;
+	}
+#endif
+
+	set_chunk_used(h, c, false);
 	free_chunk(h, c);
 }
 
@@ -205,7 +292,7 @@ size_t sys_heap_usable_size(struct sys_heap *heap, void *mem)
 	size_t chunk_base = (size_t)&chunk_buf(h)[c];
 	size_t chunk_sz = chunk_size(h, c) * CHUNK_UNIT;
 
-	return chunk_sz - (addr - chunk_base);
+	return chunk_sz - (addr - chunk_base) - HEAP_PROFILE_TAG_BYTES;
 }
 
 static chunkid_t alloc_chunk(struct z_heap *h, chunksz_t sz)
@@ -257,10 +344,17 @@ static chunkid_t alloc_chunk(struct z_heap *h, chunksz_t sz)
 		return c;
 	}
 
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	/* Last resort: merge the parked small chunks back and retry */
+	if (size_class_flush_all(h)) {
+		return alloc_chunk(h, sz);
+	}
+#endif
+
 	return 0;
 }
 
-void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
+static void *heap_alloc(struct sys_heap *heap, size_t bytes)
 {
 	struct z_heap *h = heap->heap;
 	void *mem;
@@ -270,18 +364,30 @@ void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
 	}
 
 	chunksz_t chunk_sz = bytes_to_chunksz(h, bytes);
-	chunkid_t c = alloc_chunk(h, chunk_sz);
-	if (c == 0U) {
-		return NULL;
-	}
+	chunkid_t c = 0U;
+
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	struct z_heap_class *cl = size_class(h, chunk_sz);
 
-	/* Split off remainder if any */
-	if (chunk_size(h, c) > chunk_sz) {
-		split_chunks(h, c, c + chunk_sz);
-		free_list_add(h, c + chunk_sz);
+	if (cl != NULL) {
+		c = size_class_pop(h, cl);
 	}
+#endif
 
-	set_chunk_used(h, c, true);
+	if (c == 0U) {
+		c = alloc_chunk(h, chunk_sz);
+		if (c == 0U) {
+			return NULL;
+		}
+
+		/* Split off remainder if any */
+		if (chunk_size(h, c) > chunk_sz) {
+			split_chunks(h, c, c + chunk_sz);
+			free_list_add(h, c + chunk_sz);
+		}
+
+		set_chunk_used(h, c, true);
+	}
 
 	mem = chunk_mem(h, c);
 
@@ -298,7 +404,8 @@ void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
 	return mem;
 }
 
-void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes)
+static void *heap_aligned_alloc(struct sys_heap *heap, size_t align,
+				size_t bytes)
 {
 	struct z_heap *h = heap->heap;
 	size_t gap, rew;
@@ -316,7 +423,7 @@ void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes)
 		gap = MIN(rew, chunk_header_bytes(h));
 	} else {
 		if (align <= chunk_header_bytes(h)) {
-			return sys_heap_alloc(heap, bytes);
+			return heap_alloc(heap, bytes);
 		}
 		rew = 0;
 		gap = chunk_header_bytes(h);
@@ -376,17 +483,17 @@ void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes)
 	return mem;
 }
 
-void *sys_heap_aligned_realloc(struct sys_heap *heap, void *ptr,
-			       size_t align, size_t bytes)
+static void *heap_aligned_realloc(struct sys_heap *heap, void *ptr,
+				  size_t align, size_t bytes)
 {
 	struct z_heap *h = heap->heap;
 
 	/* special realloc semantics */
 	if (ptr == NULL) {
-		return sys_heap_aligned_alloc(heap, align, bytes);
+		return heap_aligned_alloc(heap, align, bytes);
 	}
 	if (bytes == 0) {
-		sys_heap_free(heap, ptr);
+		heap_free(heap, ptr);
 		return NULL;
 	}
 
@@ -471,16 +578,197 @@ void *sys_heap_aligned_realloc(struct sys_heap *heap, void *ptr,
 	 * The calls to allocation and free functions generate
 	 * notification already, so there is no need to those here.
 	 */
-	void *ptr2 = sys_heap_aligned_alloc(heap, align, bytes);
+	void *ptr2 = heap_aligned_alloc(heap, align, bytes);
 
 	if (ptr2 != NULL) {
 		size_t prev_size = chunksz_to_bytes(h, chunk_size(h, c)) - align_gap;
 
 		memcpy(ptr2, ptr, MIN(prev_size, bytes));
+		heap_free(heap, ptr);
+	}
+	return ptr2;
+}
+
+#ifdef CONFIG_SYS_HEAP_PROFILE
+/* Every allocation is padded with a word at the end of its chunk that
+ * holds the call site it is accounted to, or 0 when the site table
+ * was full.
+ */
+static uintptr_t *profile_tag(struct z_heap *h, void *mem)
+{
+	chunkid_t c = mem_to_chunkid(h, mem);
+
+	return (uintptr_t *)&chunk_buf(h)[right_chunk(h, c)] - 1;
+}
+
+static size_t profile_bytes(struct z_heap *h, void *mem)
+{
+	return chunksz_to_bytes(h, chunk_size(h, mem_to_chunkid(h, mem)));
+}
+
+static unsigned int profile_bin(size_t val)
+{
+	unsigned int bin = 0;
+
+	while (val > 1U && bin < SYS_HEAP_PROFILE_BINS - 1) {
+		val >>= 1;
+		bin++;
+	}
+
+	return bin;
+}
+
+static void profile_track(struct z_heap *h, void *mem, uintptr_t site)
+{
+	struct sys_heap_profile *p = &h->profile;
+	struct sys_heap_profile_site *slot = NULL;
+	size_t bytes = profile_bytes(h, mem);
+
+	for (int i = 0; i < ARRAY_SIZE(p->sites); i++) {
+		if (p->sites[i].site == site) {
+			slot = &p->sites[i];
+			break;
+		}
+		if (slot == NULL && p->sites[i].live_count == 0U) {
+			slot = &p->sites[i];
+		}
+	}
+
+	if (slot != NULL) {
+		slot->site = site;
+		slot->live_bytes += bytes;
+		slot->live_count++;
+	} else {
+		p->other_live_bytes += bytes;
+		site = 0;
+	}
+
+	*profile_tag(h, mem) = site;
+}
+
+static void profile_untrack(struct z_heap *h, void *mem)
+{
+	struct sys_heap_profile *p = &h->profile;
+	uintptr_t site = *profile_tag(h, mem);
+	size_t bytes = profile_bytes(h, mem);
+
+	if (site == 0U) {
+		p->other_live_bytes -= bytes;
+		return;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(p->sites); i++) {
+		if (p->sites[i].site == site && p->sites[i].live_count != 0U) {
+			p->sites[i].live_bytes -= bytes;
+			p->sites[i].live_count--;
+			return;
+		}
+	}
+
+	__ASSERT(false, "untracked heap block (corrupted?) at %p", mem);
+}
+
+static void *profile_alloc(struct sys_heap *heap, size_t align, size_t bytes,
+			   uintptr_t site)
+{
+	struct z_heap *h = heap->heap;
+	uint32_t start = k_cycle_get_32();
+	void *mem = NULL;
+
+	if (bytes == 0U || bytes > SIZE_MAX - HEAP_PROFILE_TAG_BYTES) {
+		return NULL;
+	}
+
+	mem = heap_aligned_alloc(heap, align, bytes + HEAP_PROFILE_TAG_BYTES);
+	if (mem != NULL) {
+		profile_track(h, mem, site);
+	} else {
+		h->profile.failed_allocs++;
+	}
+
+	h->profile.size_hist[profile_bin(bytes)]++;
+	h->profile.alloc_cycles_hist[profile_bin(k_cycle_get_32() - start)]++;
+
+	return mem;
+}
+
+void sys_heap_free(struct sys_heap *heap, void *mem)
+{
+	struct z_heap *h = heap->heap;
+	uint32_t start = k_cycle_get_32();
+
+	if (mem == NULL) {
+		return; /* ISO C free() semantics */
+	}
+
+	profile_untrack(h, mem);
+	heap_free(heap, mem);
+
+	h->profile.free_cycles_hist[profile_bin(k_cycle_get_32() - start)]++;
+}
+
+void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
+{
+	return profile_alloc(heap, 0, bytes,
+			     (uintptr_t)__builtin_return_address(0));
+}
+
+void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes)
+{
+	return profile_alloc(heap, align, bytes,
+			     (uintptr_t)__builtin_return_address(0));
+}
+
+void *sys_heap_aligned_realloc(struct sys_heap *heap, void *ptr,
+			       size_t align, size_t bytes)
+{
+	uintptr_t site = (uintptr_t)__builtin_return_address(0);
+	struct z_heap *h = heap->heap;
+	void *ptr2;
+
+	if (ptr == NULL) {
+		return profile_alloc(heap, align, bytes, site);
+	}
+	if (bytes == 0) {
 		sys_heap_free(heap, ptr);
+		return NULL;
+	}
+	if (bytes > SIZE_MAX - HEAP_PROFILE_TAG_BYTES) {
+		return NULL;
 	}
+
+	/* The tag moves with the end of the chunk, retag whatever is
+	 * left allocated.
+	 */
+	profile_untrack(h, ptr);
+	ptr2 = heap_aligned_realloc(heap, ptr, align,
+				    bytes + HEAP_PROFILE_TAG_BYTES);
+	profile_track(h, ptr2 != NULL ? ptr2 : ptr, site);
+
 	return ptr2;
 }
+#else
+void sys_heap_free(struct sys_heap *heap, void *mem)
+{
+	heap_free(heap, mem);
+}
+
+void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
+{
+	return heap_alloc(heap, bytes);
+}
+
+void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes)
+{
+	return heap_aligned_alloc(heap, align, bytes);
+}
+
+void *sys_heap_aligned_realloc(struct sys_heap *heap, void *ptr,
+			       size_t align, size_t bytes)
+{
+	return heap_aligned_realloc(heap, ptr, align, bytes);
+}
+#endif
 
 void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 {
@@ -527,6 +815,17 @@ void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 		h->buckets[i].next = 0;
 	}
 
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	for (int i = 0; i < ARRAY_SIZE(h->classes); i++) {
+		h->classes[i].next = 0;
+		h->classes[i].count = 0;
+	}
+#endif
+
+#ifdef CONFIG_SYS_HEAP_PROFILE
+	(void)memset(&h->profile, 0, sizeof(h->profile));
+#endif
+
 	/* chunk containing our struct z_heap */
 	set_chunk_size(h, 0, chunk0_size);
 	set_left_chunk_size(h, 0, 0);
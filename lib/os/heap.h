@@ -65,6 +65,28 @@ struct z_heap_bucket {
 	chunkid_t next;
 };
 
+/* Bytes appended to every allocation to hold its profiling tag */
+#ifdef CONFIG_SYS_HEAP_PROFILE
+#define HEAP_PROFILE_TAG_BYTES sizeof(uintptr_t)
+#else
+#define HEAP_PROFILE_TAG_BYTES 0
+#endif
+
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+/* One size class per chunk size, up to the size needed for
+ * CONFIG_SYS_HEAP_SIZE_CLASS_MAX_BYTES behind a big heap header.
+ * Chunks parked on a class list stay marked used and are singly
+ * linked through their FREE_NEXT field.
+ */
+#define HEAP_SIZE_CLASSES \
+	((CONFIG_SYS_HEAP_SIZE_CLASS_MAX_BYTES + 8U + CHUNK_UNIT - 1U) / CHUNK_UNIT)
+
+struct z_heap_class {
+	chunkid_t next;
+	uint32_t count;
+};
+#endif
+
 struct z_heap {
 	chunkid_t chunk0_hdr[2];
 	chunkid_t end_chunk;
@@ -73,6 +95,12 @@ struct z_heap {
 	size_t free_bytes;
 	size_t allocated_bytes;
 	size_t max_allocated_bytes;
+#endif
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	struct z_heap_class classes[HEAP_SIZE_CLASSES];
+#endif
+#ifdef CONFIG_SYS_HEAP_PROFILE
+	struct sys_heap_profile profile;
 #endif
 	struct z_heap_bucket buckets[0];
 };
@@ -262,6 +290,13 @@ static inline bool size_too_big(struct z_heap *h, size_t bytes)
 	return (bytes / CHUNK_UNIT) >= h->end_chunk;
 }
 
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+static inline struct z_heap_class *size_class(struct z_heap *h, chunksz_t sz)
+{
+	return (sz <= HEAP_SIZE_CLASSES) ? &h->classes[sz - 1] : NULL;
+}
+#endif
+
 /* For debugging */
 void heap_print_info(struct z_heap *h, bool dump_chunks);
 
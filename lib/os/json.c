@@ -1096,3 +1096,443 @@ ssize_t json_calc_encoded_len(const struct json_obj_descr *descr,
 
 	return total;
 }
+
+struct buffered_appender {
+	json_append_bytes_t append_bytes;
+	void *data;
+	char *buffer;
+	size_t used;
+	size_t size;
+};
+
+static int buffered_flush(struct buffered_appender *appender)
+{
+	int ret = 0;
+
+	if (appender->used > 0) {
+		ret = appender->append_bytes(appender->buffer, appender->used,
+					     appender->data);
+		appender->used = 0;
+	}
+
+	return ret;
+}
+
+static int append_bytes_buffered(const char *bytes, size_t len, void *data)
+{
+	struct buffered_appender *appender = data;
+	int ret;
+
+	if (len > appender->size - appender->used) {
+		ret = buffered_flush(appender);
+		if (ret < 0) {
+			return ret;
+		}
+
+		/* Too large to be batched, pass it through */
+		if (len >= appender->size) {
+			return appender->append_bytes(bytes, len, appender->data);
+		}
+	}
+
+	memcpy(appender->buffer + appender->used, bytes, len);
+	appender->used += len;
+
+	return 0;
+}
+
+int json_obj_encode_buffered(const struct json_obj_descr *descr, size_t descr_len,
+			     const void *val, json_append_bytes_t append_bytes,
+			     void *data, char *buffer, size_t buf_size)
+{
+	struct buffered_appender appender = {
+		.append_bytes = append_bytes,
+		.data = data,
+		.buffer = buffer,
+		.size = buf_size,
+	};
+	int ret;
+
+	ret = json_obj_encode(descr, descr_len, val, append_bytes_buffered,
+			      &appender);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return buffered_flush(&appender);
+}
+
+int json_arr_encode_buffered(const struct json_obj_descr *descr, const void *val,
+			     json_append_bytes_t append_bytes, void *data,
+			     char *buffer, size_t buf_size)
+{
+	struct buffered_appender appender = {
+		.append_bytes = append_bytes,
+		.data = data,
+		.buffer = buffer,
+		.size = buf_size,
+	};
+	int ret;
+
+	ret = json_arr_encode(descr, val, append_bytes_buffered, &appender);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return buffered_flush(&appender);
+}
+
+enum json_stream_expect {
+	STREAM_EXPECT_VALUE,
+	STREAM_EXPECT_VALUE_OR_END,
+	STREAM_EXPECT_KEY,
+	STREAM_EXPECT_KEY_OR_END,
+	STREAM_EXPECT_COLON,
+	STREAM_EXPECT_COMMA_OR_END,
+};
+
+void json_stream_init(struct json_stream *js, char *buf, size_t buf_size)
+{
+	*js = (struct json_stream) {
+		.buf = buf,
+		.buf_size = buf_size,
+		.expect = STREAM_EXPECT_VALUE,
+	};
+}
+
+int json_stream_feed(struct json_stream *js, const char *data, size_t len,
+		     bool last)
+{
+	if (js->pos != js->end) {
+		return -EBUSY;
+	}
+
+	js->pos = data;
+	js->end = data + len;
+	js->last = last;
+
+	return 0;
+}
+
+static bool stream_in_array(const struct json_stream *js)
+{
+	return (js->stack & BIT(js->depth - 1)) != 0U;
+}
+
+static void stream_value_done(struct json_stream *js)
+{
+	if (js->depth == 0U) {
+		js->done = true;
+	} else {
+		js->expect = STREAM_EXPECT_COMMA_OR_END;
+	}
+}
+
+static int stream_save(struct json_stream *js, const char *bytes, size_t len)
+{
+	if (len > js->buf_size - js->buf_len) {
+		return -ENOMEM;
+	}
+
+	memcpy(js->buf + js->buf_len, bytes, len);
+	js->buf_len += len;
+
+	return 0;
+}
+
+static bool stream_number_valid(const char *num, size_t len)
+{
+	const char *end = num + len;
+	bool digits = false;
+
+	if (num < end && *num == '-') {
+		num++;
+	}
+
+	while (num < end && isdigit((unsigned char)*num)) {
+		digits = true;
+		num++;
+	}
+
+	if (num < end && *num == '.') {
+		digits = false;
+		for (num++; num < end && isdigit((unsigned char)*num); num++) {
+			digits = true;
+		}
+	}
+
+	if (digits && num < end && (*num == 'e' || *num == 'E')) {
+		num++;
+		if (num < end && (*num == '+' || *num == '-')) {
+			num++;
+		}
+
+		digits = false;
+		while (num < end && isdigit((unsigned char)*num)) {
+			digits = true;
+			num++;
+		}
+	}
+
+	return digits && num == end;
+}
+
+static bool stream_literal_valid(enum json_tokens type, const char *lit,
+				 size_t len)
+{
+	const char *expected;
+
+	switch (type) {
+	case JSON_TOK_TRUE:
+		expected = "true";
+		break;
+	case JSON_TOK_FALSE:
+		expected = "false";
+		break;
+	case JSON_TOK_NULL:
+		expected = "null";
+		break;
+	case JSON_TOK_NUMBER:
+		return stream_number_valid(lit, len);
+	default:
+		return false;
+	}
+
+	return len == strlen(expected) && !memcmp(lit, expected, len);
+}
+
+static bool stream_string_scan(struct json_stream *js, const char **pos,
+			       int *err)
+{
+	const char *p;
+
+	for (p = *pos; p < js->end; p++) {
+		if (js->escape) {
+			if (*p == '\0' || !strchr("\"\\/bfnrtu", *p)) {
+				*err = -EINVAL;
+				return false;
+			}
+			js->escape = false;
+		} else if (*p == '\\') {
+			js->escape = true;
+		} else if (*p == '"') {
+			*pos = p;
+			return true;
+		} else if ((unsigned char)*p < 0x20) {
+			*err = -EINVAL;
+			return false;
+		}
+	}
+
+	*pos = p;
+
+	return false;
+}
+
+static int stream_scalar(struct json_stream *js, enum json_tokens type,
+			 struct json_stream_token *tok)
+{
+	const char *start = js->pos;
+	const char *p = start;
+	bool complete;
+	int ret = 0;
+
+	if (type == JSON_TOK_STRING) {
+		complete = stream_string_scan(js, &p, &ret);
+		if (ret < 0) {
+			return ret;
+		}
+	} else {
+		while (p < js->end && (isalnum((unsigned char)*p) ||
+				       *p == '-' || *p == '+' || *p == '.')) {
+			p++;
+		}
+		complete = p < js->end || js->last;
+	}
+
+	if (!complete) {
+		if (js->last) {
+			return -EINVAL;
+		}
+
+		/* Keep what we have until the rest of the token arrives */
+		ret = stream_save(js, start, p - start);
+		if (ret < 0) {
+			return ret;
+		}
+
+		js->partial = type;
+		js->pos = p;
+
+		return -EAGAIN;
+	}
+
+	if (js->partial) {
+		ret = stream_save(js, start, p - start);
+		if (ret < 0) {
+			return ret;
+		}
+
+		tok->start = js->buf;
+		tok->length = js->buf_len;
+		js->buf_len = 0;
+		js->partial = 0;
+	} else {
+		tok->start = start;
+		tok->length = p - start;
+	}
+
+	if (type == JSON_TOK_STRING) {
+		p++;
+	} else if (!stream_literal_valid(type, tok->start, tok->length)) {
+		return -EINVAL;
+	}
+
+	js->pos = p;
+	tok->type = type;
+	tok->key = js->key;
+
+	if (js->key) {
+		js->key = false;
+		js->expect = STREAM_EXPECT_COLON;
+	} else {
+		stream_value_done(js);
+	}
+
+	return 0;
+}
+
+static void stream_delim(struct json_stream *js, enum json_tokens type,
+			 struct json_stream_token *tok)
+{
+	tok->type = type;
+	tok->key = false;
+	tok->start = js->pos;
+	tok->length = 1;
+	js->pos++;
+}
+
+static int stream_open(struct json_stream *js, char c,
+		       struct json_stream_token *tok)
+{
+	if (js->depth == JSON_STREAM_MAX_DEPTH) {
+		return -ENOMEM;
+	}
+
+	if (c == '[') {
+		js->stack |= BIT(js->depth);
+		js->expect = STREAM_EXPECT_VALUE_OR_END;
+	} else {
+		js->stack &= ~BIT(js->depth);
+		js->expect = STREAM_EXPECT_KEY_OR_END;
+	}
+
+	js->depth++;
+	stream_delim(js, (enum json_tokens)c, tok);
+
+	return 0;
+}
+
+static int stream_close(struct json_stream *js, char c,
+			struct json_stream_token *tok)
+{
+	if (c != (stream_in_array(js) ? ']' : '}')) {
+		return -EINVAL;
+	}
+
+	js->depth--;
+	stream_delim(js, (enum json_tokens)c, tok);
+	stream_value_done(js);
+
+	return 0;
+}
+
+static int stream_value(struct json_stream *js, char c,
+			struct json_stream_token *tok)
+{
+	switch (c) {
+	case '{':
+	case '[':
+		return stream_open(js, c, tok);
+	case '"':
+		js->pos++;
+		return stream_scalar(js, JSON_TOK_STRING, tok);
+	case 't':
+		return stream_scalar(js, JSON_TOK_TRUE, tok);
+	case 'f':
+		return stream_scalar(js, JSON_TOK_FALSE, tok);
+	case 'n':
+		return stream_scalar(js, JSON_TOK_NULL, tok);
+	default:
+		if (c == '-' || isdigit((unsigned char)c)) {
+			return stream_scalar(js, JSON_TOK_NUMBER, tok);
+		}
+
+		return -EINVAL;
+	}
+}
+
+int json_stream_next(struct json_stream *js, struct json_stream_token *tok)
+{
+	char c;
+
+	if (js->partial) {
+		return stream_scalar(js, js->partial, tok);
+	}
+
+	while (!js->done) {
+		while (js->pos < js->end && isspace((unsigned char)*js->pos)) {
+			js->pos++;
+		}
+
+		if (js->pos == js->end) {
+			return js->last ? -EINVAL : -EAGAIN;
+		}
+
+		c = *js->pos;
+
+		switch (js->expect) {
+		case STREAM_EXPECT_COLON:
+			if (c != ':') {
+				return -EINVAL;
+			}
+
+			js->pos++;
+			js->expect = STREAM_EXPECT_VALUE;
+			break;
+		case STREAM_EXPECT_COMMA_OR_END:
+			if (c != ',') {
+				return stream_close(js, c, tok);
+			}
+
+			js->pos++;
+			js->expect = stream_in_array(js) ? STREAM_EXPECT_VALUE :
+							   STREAM_EXPECT_KEY;
+			break;
+		case STREAM_EXPECT_KEY_OR_END:
+			if (c == '}') {
+				return stream_close(js, c, tok);
+			}
+
+			__fallthrough;
+		case STREAM_EXPECT_KEY:
+			if (c != '"') {
+				return -EINVAL;
+			}
+
+			js->pos++;
+			js->key = true;
+			return stream_scalar(js, JSON_TOK_STRING, tok);
+		case STREAM_EXPECT_VALUE_OR_END:
+			if (c == ']') {
+				return stream_close(js, c, tok);
+			}
+
+			__fallthrough;
+		default:
+			return stream_value(js, c, tok);
+		}
+	}
+
+	return -ENODATA;
+}
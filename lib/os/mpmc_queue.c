@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <zephyr/sys/mpmc_queue.h>
+
+/* Positions only ever increase and wrap around, they are compared as
+ * 32-bit differences so that the wrap of a long is never reached.
+ */
+static inline atomic_val_t pos_add(atomic_val_t pos, uint32_t n)
+{
+	return (atomic_val_t)((unsigned long)pos + n);
+}
+
+static inline int32_t pos_diff(atomic_val_t a, atomic_val_t b)
+{
+	return (int32_t)((uint32_t)a - (uint32_t)b);
+}
+
+void sys_mpmc_queue_init(struct sys_mpmc_queue *queue,
+			 struct sys_mpmc_cell *cells, size_t n_cells)
+{
+	__ASSERT(n_cells > 1 && is_power_of_two(n_cells),
+		 "capacity must be a power of two");
+
+	for (size_t i = 0; i < n_cells; i++) {
+		atomic_set(&cells[i].seq, 0);
+		cells[i].data = NULL;
+	}
+
+	queue->cells = cells;
+	queue->mask = n_cells - 1;
+	atomic_set(&queue->head, 0);
+	atomic_set(&queue->tail, 0);
+	atomic_set(&queue->waiters, 0);
+	k_sem_init(&queue->sem, 0, K_SEM_MAX_LIMIT);
+}
+
+/*
+ * A cell at index i is free for the producer at position pos when its
+ * sequence number is pos, and holds an item for the consumer at
+ * position pos when it is pos + 1. Taking the item makes it free for the
+ * producer one lap later, pos + mask + 1. Sequence numbers are stored
+ * minus i, see struct sys_mpmc_cell.
+ */
+
+int sys_mpmc_queue_try_put(struct sys_mpmc_queue *queue, void *data)
+{
+	atomic_val_t pos = atomic_get(&queue->tail);
+	struct sys_mpmc_cell *cell;
+	uint32_t idx;
+	int32_t diff;
+
+	for (;;) {
+		idx = (uint32_t)pos & queue->mask;
+		cell = &queue->cells[idx];
+		diff = pos_diff(pos_add(atomic_get(&cell->seq), idx), pos);
+
+		if (diff == 0) {
+			if (atomic_cas(&queue->tail, pos, pos_add(pos, 1))) {
+				break;
+			}
+			pos = atomic_get(&queue->tail);
+		} else if (diff < 0) {
+			/* The consumer of the previous lap is not done */
+			return -ENOBUFS;
+		} else {
+			/* Another producer took this position */
+			pos = atomic_get(&queue->tail);
+		}
+	}
+
+	cell->data = data;
+	/* Publishes the data, atomic_set() is a full barrier */
+	atomic_set(&cell->seq, pos_add(pos, 1U - idx));
+
+	return 0;
+}
+
+int sys_mpmc_queue_try_get(struct sys_mpmc_queue *queue, void **data)
+{
+	atomic_val_t pos = atomic_get(&queue->head);
+	struct sys_mpmc_cell *cell;
+	uint32_t idx;
+	int32_t diff;
+
+	for (;;) {
+		idx = (uint32_t)pos & queue->mask;
+		cell = &queue->cells[idx];
+		diff = pos_diff(pos_add(atomic_get(&cell->seq), idx),
+				pos_add(pos, 1));
+
+		if (diff == 0) {
+			if (atomic_cas(&queue->head, pos, pos_add(pos, 1))) {
+				break;
+			}
+			pos = atomic_get(&queue->head);
+		} else if (diff < 0) {
+			/* The producer of this position is not done */
+			return -EAGAIN;
+		} else {
+			/* Another consumer took this position */
+			pos = atomic_get(&queue->head);
+		}
+	}
+
+	*data = cell->data;
+	atomic_set(&cell->seq, pos_add(pos, queue->mask + 1U - idx));
+
+	return 0;
+}
+
+int sys_mpmc_queue_put(struct sys_mpmc_queue *queue, void *data)
+{
+	int ret = sys_mpmc_queue_try_put(queue, data);
+
+	/* Consumers register before checking the queue a last time, so
+	 * either they see the item or we see them.
+	 */
+	if (ret == 0 && atomic_get(&queue->waiters) > 0) {
+		k_sem_give(&queue->sem);
+	}
+
+	return ret;
+}
+
+int sys_mpmc_queue_get(struct sys_mpmc_queue *queue, void **data,
+		       k_timeout_t timeout)
+{
+	uint64_t end;
+	int64_t now;
+	int ret;
+
+	ret = sys_mpmc_queue_try_get(queue, data);
+	if (ret == 0 || K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		return ret;
+	}
+
+	end = sys_clock_timeout_end_calc(timeout);
+	atomic_inc(&queue->waiters);
+
+	for (;;) {
+		ret = sys_mpmc_queue_try_get(queue, data);
+		if (ret == 0) {
+			break;
+		}
+
+		if (K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+			(void)k_sem_take(&queue->sem, K_FOREVER);
+			continue;
+		}
+
+		now = sys_clock_tick_get();
+		if ((int64_t)(end - now) <= 0) {
+			break;
+		}
+
+		/* A give may be left over from a put whose item was taken
+		 * by another consumer, hence the loop.
+		 */
+		(void)k_sem_take(&queue->sem, K_TICKS(end - now));
+	}
+
+	atomic_dec(&queue->waiters);
+
+	return ret;
+}
@@ -42,6 +42,23 @@ static void set_child(struct rbnode *n, uint8_t side, void *val)
 
 		n->children[0] = (void *) (new | (old & 1UL));
 	}
+
+#ifdef CONFIG_RBTREE_PARENT_POINTERS
+	if (val != NULL) {
+		((struct rbnode *)val)->parent = n;
+	}
+#endif
+}
+
+static void set_root(struct rbtree *tree, struct rbnode *n)
+{
+	tree->root = n;
+
+#ifdef CONFIG_RBTREE_PARENT_POINTERS
+	if (n != NULL) {
+		n->parent = NULL;
+	}
+#endif
 }
 
 static enum rb_color get_color(struct rbnode *n)
@@ -220,7 +237,7 @@ void rb_insert(struct rbtree *tree, struct rbnode *node)
 	set_child(node, 1U, NULL);
 
 	if (tree->root == NULL) {
-		tree->root = node;
+		set_root(tree, node);
 		tree->max_depth = 1;
 		set_color(node, BLACK);
 		return;
@@ -249,7 +266,7 @@ void rb_insert(struct rbtree *tree, struct rbnode *node)
 	}
 
 	/* We may have rotated up into the root! */
-	tree->root = stack[0];
+	set_root(tree, stack[0]);
 	CHECK(is_black(tree->root));
 }
 
@@ -417,7 +434,7 @@ void rb_remove(struct rbtree *tree, struct rbnode *node)
 		if (hiparent != NULL) {
 			set_child(hiparent, get_side(hiparent, node), node2);
 		} else {
-			tree->root = node2;
+			set_root(tree, node2);
 		}
 
 		if (loparent == node) {
@@ -454,7 +471,7 @@ void rb_remove(struct rbtree *tree, struct rbnode *node)
 
 	/* Removing the root */
 	if (stacksz < 2) {
-		tree->root = child;
+		set_root(tree, child);
 		if (child != NULL) {
 			set_color(child, BLACK);
 		} else {
@@ -490,7 +507,7 @@ void rb_remove(struct rbtree *tree, struct rbnode *node)
 	}
 
 	/* We may have rotated up into the root! */
-	tree->root = stack[0];
+	set_root(tree, stack[0]);
 }
 
 #ifndef CONFIG_MISRA_SANE
@@ -525,6 +542,122 @@ bool rb_contains(struct rbtree *tree, struct rbnode *node)
 	return n == node;
 }
 
+/* Pending right subtree while building a tree: the nodes in [lo, hi)
+ * become the right subtree of nodes[lo - 1].
+ */
+struct rb_build_range {
+	size_t lo;
+	size_t hi;
+	uint8_t depth;
+};
+
+void rb_build(struct rbtree *tree, struct rbnode **nodes, size_t count)
+{
+	struct rb_build_range pending[Z_PBITS(size_t)];
+	int npending = 0;
+	size_t lo = 0;
+	size_t hi = count;
+	struct rbnode *parent = NULL;
+	uint8_t side = 0U;
+	uint8_t depth = 0U;
+	uint8_t max_depth = 0U;
+
+	set_root(tree, NULL);
+	tree->max_depth = 0;
+
+	if (count == 0) {
+		return;
+	}
+
+	/* Splitting every range at its middle puts all leaves on the
+	 * last two levels.  Everything above the last level is black
+	 * and the last level is red, so every path has the same number
+	 * of black nodes.
+	 */
+	while ((count >> (max_depth + 1U)) != 0U) {
+		max_depth++;
+	}
+
+	for (;;) {
+		size_t mid = lo + (hi - lo) / 2U;
+		struct rbnode *node = nodes[mid];
+
+		set_child(node, 0U, NULL);
+		set_child(node, 1U, NULL);
+		set_color(node, ((depth == max_depth) && (depth > 0U)) ?
+			  RED : BLACK);
+
+		if (parent == NULL) {
+			set_root(tree, node);
+		} else {
+			set_child(parent, side, node);
+		}
+
+		if ((mid + 1U) < hi) {
+			CHECK(npending < ARRAY_SIZE(pending));
+			pending[npending].lo = mid + 1U;
+			pending[npending].hi = hi;
+			pending[npending].depth = depth + 1U;
+			npending++;
+		}
+
+		if (lo < mid) {
+			/* Left subtree next */
+			parent = node;
+			side = 0U;
+			hi = mid;
+			depth++;
+		} else if (npending > 0) {
+			npending--;
+			lo = pending[npending].lo;
+			hi = pending[npending].hi;
+			depth = pending[npending].depth;
+			parent = nodes[lo - 1U];
+			side = 1U;
+		} else {
+			break;
+		}
+	}
+
+	tree->max_depth = max_depth + 1;
+}
+
+#ifdef CONFIG_RBTREE_PARENT_POINTERS
+struct rbnode *z_rb_next(struct rbnode *node, uint8_t side)
+{
+	struct rbnode *n = get_child(node, side);
+	uint8_t other = (side == 0U) ? 1U : 0U;
+
+	/* The next node is the closest one in the subtree on that
+	 * side if there is one...
+	 */
+	if (n != NULL) {
+		while (get_child(n, other) != NULL) {
+			n = get_child(n, other);
+		}
+		return n;
+	}
+
+	/* ...otherwise the first ancestor we reach from the other side */
+	while ((node->parent != NULL) && (get_child(node->parent, side) == node)) {
+		node = node->parent;
+	}
+
+	return node->parent;
+}
+
+struct rbnode *z_rb_foreach_next(struct rbtree *tree, struct _rb_foreach *f)
+{
+	if (f->top == -1) {
+		f->top = 0;
+		f->current = rb_get_min(tree);
+	} else if (f->current != NULL) {
+		f->current = rb_next(f->current);
+	}
+
+	return f->current;
+}
+#else
 /* Pushes the node and its chain of left-side children onto the stack
  * in the foreach struct, returning the last node, which is the next
  * node to iterate.  By construction node will always be a right child
@@ -597,3 +730,4 @@ struct rbnode *z_rb_foreach_next(struct rbtree *tree, struct _rb_foreach *f)
 	f->top--;
 	return (f->top >= 0) ? f->stack[f->top] : NULL;
 }
+#endif /* CONFIG_RBTREE_PARENT_POINTERS */
@@ -6,20 +6,45 @@
 
 #include <zephyr/kernel.h>
 #include <zephyr/device.h>
+#include <zephyr/cache.h>
 #include <zephyr/sys/sys_heap.h>
 #include <zephyr/sys/multi_heap.h>
 
 #include <zephyr/multi_heap/shared_multi_heap.h>
 
+/*
+ * Every region has its own lock, so that allocations from different
+ * regions do not contend with each other.
+ */
+struct smh_heap {
+	struct sys_heap heap;
+	struct k_spinlock lock;
+	uint32_t cpu_mask;
+};
+
 static struct sys_multi_heap shared_multi_heap;
-static struct sys_heap heap_pool[MAX_SHARED_MULTI_HEAP_ATTR][MAX_MULTI_HEAPS];
+static struct smh_heap heap_pool[MAX_SHARED_MULTI_HEAP_ATTR][MAX_MULTI_HEAPS];
 
 static unsigned int attr_cnt[MAX_SHARED_MULTI_HEAP_ATTR];
 
+static void *smh_heap_alloc(struct smh_heap *h, size_t align, size_t size)
+{
+	k_spinlock_key_t key;
+	void *block;
+
+	key = k_spin_lock(&h->lock);
+	block = sys_heap_aligned_alloc(&h->heap, align, size);
+	k_spin_unlock(&h->lock, key);
+
+	return block;
+}
+
 static void *smh_choice(struct sys_multi_heap *mheap, void *cfg, size_t align, size_t size)
 {
-	struct sys_heap *h;
+	struct smh_heap *h;
 	unsigned int attr;
+	uint32_t cpu_bit;
+	size_t line_size;
 	void *block;
 
 	attr = (unsigned int)(long) cfg;
@@ -28,17 +53,59 @@ static void *smh_choice(struct sys_multi_heap *mheap, void *cfg, size_t align, s
 		return NULL;
 	}
 
+	/*
+	 * Cacheable regions are not coherent with DMA masters, make sure that
+	 * invalidating or flushing the cache lines of a block does not affect
+	 * its neighbors.
+	 */
+	if (IS_ENABLED(CONFIG_SHARED_MULTI_HEAP_CACHE_LINE_ALIGN) &&
+	    attr == SMH_REG_ATTR_CACHEABLE) {
+		line_size = sys_cache_data_line_size_get();
+		if (line_size > 0) {
+			align = MAX(align, line_size);
+			size = ROUND_UP(size, line_size);
+		}
+	}
+
+#ifdef CONFIG_SMP
+	/*
+	 * The CPU may change when the thread migrates, which only results in
+	 * a less optimal placement.
+	 */
+	cpu_bit = BIT(arch_curr_cpu()->id);
+#else
+	cpu_bit = BIT(0);
+#endif
+
 	/* Set in case the user requested a non-existing attr */
 	block = NULL;
 
+	/* Try the regions local to the CPU first */
+	for (size_t hdx = 0; hdx < attr_cnt[attr]; hdx++) {
+		h = &heap_pool[attr][hdx];
+
+		if ((h->cpu_mask & cpu_bit) == 0) {
+			continue;
+		}
+
+		block = smh_heap_alloc(h, align, size);
+		if (block != NULL) {
+			return block;
+		}
+	}
+
 	for (size_t hdx = 0; hdx < attr_cnt[attr]; hdx++) {
 		h = &heap_pool[attr][hdx];
 
-		if (h->heap == NULL) {
+		if (h->heap.heap == NULL) {
 			return NULL;
 		}
 
-		block = sys_heap_aligned_alloc(h, align, size);
+		if ((h->cpu_mask & cpu_bit) != 0) {
+			continue;
+		}
+
+		block = smh_heap_alloc(h, align, size);
 		if (block != NULL) {
 			break;
 		}
@@ -50,7 +117,7 @@ static void *smh_choice(struct sys_multi_heap *mheap, void *cfg, size_t align, s
 int shared_multi_heap_add(struct shared_multi_heap_region *region, void *user_data)
 {
 	static int n_heaps;
-	struct sys_heap *h;
+	struct smh_heap *h;
 	unsigned int slot;
 
 	if (region->attr >= MAX_SHARED_MULTI_HEAP_ATTR) {
@@ -65,8 +132,9 @@ int shared_multi_heap_add(struct shared_multi_heap_region *region, void *user_da
 	slot = attr_cnt[region->attr];
 	h = &heap_pool[region->attr][slot];
 
-	sys_heap_init(h, (void *) region->addr, region->size);
-	sys_multi_heap_add_heap(&shared_multi_heap, h, user_data);
+	h->cpu_mask = region->cpu_mask;
+	sys_heap_init(&h->heap, (void *) region->addr, region->size);
+	sys_multi_heap_add_heap(&shared_multi_heap, &h->heap, user_data);
 
 	attr_cnt[region->attr]++;
 
@@ -75,7 +143,20 @@ int shared_multi_heap_add(struct shared_multi_heap_region *region, void *user_da
 
 void shared_multi_heap_free(void *block)
 {
-	sys_multi_heap_free(&shared_multi_heap, block);
+	const struct sys_multi_heap_rec *rec;
+	struct smh_heap *h;
+	k_spinlock_key_t key;
+
+	if (block == NULL) {
+		return;
+	}
+
+	rec = sys_multi_heap_get_heap(&shared_multi_heap, block);
+	h = CONTAINER_OF(rec->heap, struct smh_heap, heap);
+
+	key = k_spin_lock(&h->lock);
+	sys_heap_free(&h->heap, block);
+	k_spin_unlock(&h->lock, key);
 }
 
 void *shared_multi_heap_alloc(unsigned int attr, size_t bytes)
@@ -97,6 +178,37 @@ void *shared_multi_heap_aligned_alloc(unsigned int attr, size_t align, size_t by
 					    align, bytes);
 }
 
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+int shared_multi_heap_stats_get(unsigned int attr, struct sys_memory_stats *stats)
+{
+	struct sys_memory_stats heap_stats;
+	struct smh_heap *h;
+	k_spinlock_key_t key;
+
+	if (attr >= MAX_SHARED_MULTI_HEAP_ATTR || stats == NULL) {
+		return -EINVAL;
+	}
+
+	stats->free_bytes = 0;
+	stats->allocated_bytes = 0;
+	stats->max_allocated_bytes = 0;
+
+	for (size_t hdx = 0; hdx < attr_cnt[attr]; hdx++) {
+		h = &heap_pool[attr][hdx];
+
+		key = k_spin_lock(&h->lock);
+		(void)sys_heap_runtime_stats_get(&h->heap, &heap_stats);
+		k_spin_unlock(&h->lock, key);
+
+		stats->free_bytes += heap_stats.free_bytes;
+		stats->allocated_bytes += heap_stats.allocated_bytes;
+		stats->max_allocated_bytes += heap_stats.max_allocated_bytes;
+	}
+
+	return 0;
+}
+#endif /* CONFIG_SYS_HEAP_RUNTIME_STATS */
+
 int shared_multi_heap_pool_init(void)
 {
 	static atomic_t state;
@@ -4,19 +4,44 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 #include <zephyr/kernel.h>
+#include <ksched.h>
+#include <zephyr/wait_q.h>
 #include <errno.h>
 #include <string.h>
 #include <zephyr/sys/atomic.h>
+#include <zephyr/sys/htable.h>
+#include <zephyr/sys/math_extras.h>
 #include <zephyr/posix/time.h>
 #include <zephyr/posix/mqueue.h>
 
+/* Message slot, followed by the message data */
+struct mq_msg {
+	sys_snode_t node;
+	size_t len;
+	unsigned int prio;
+};
+
+/*
+ * Queued messages are kept in one FIFO list per priority, with a bitmap
+ * of the non-empty lists, so that sending and receiving are O(1) at any
+ * priority. When a receiver is blocked the queue is empty and a sender
+ * copies its message straight into the receiver's buffer; likewise a
+ * receiver freeing a slot stores the message of a blocked sender in it.
+ */
 typedef struct mqueue_object {
-	sys_snode_t snode;
-	char *mem_buffer;
-	char *mem_obj;
-	struct k_msgq queue;
+	struct sys_htable_node hnode;
+	struct k_spinlock lock;
+	_wait_q_t send_q;
+	_wait_q_t recv_q;
+	sys_slist_t free_l;
+	sys_slist_t prio_l[MQ_PRIO_MAX];
+	uint32_t prio_map;
+	long max_msgs;
+	long used_msgs;
+	size_t msg_size;
 	atomic_t ref_count;
-	char *name;
+	bool unlinked;
+	char name[CONFIG_MQUEUE_NAMELEN_MAX];
 } mqueue_object;
 
 typedef struct mqueue_desc {
@@ -25,17 +50,29 @@ typedef struct mqueue_desc {
 	uint32_t  flags;
 } mqueue_desc;
 
+/* Message of a thread blocked in mq_send() or mq_receive(), handed over
+ * through the swap data of the thread.
+ */
+struct mq_xfer {
+	char *buf;
+	size_t len;
+	unsigned int prio;
+};
+
+BUILD_ASSERT(MQ_PRIO_MAX <= 32, "priorities must fit in prio_map");
+
 K_SEM_DEFINE(mq_sem, 1, 1);
 
-/* Initialize the list */
-sys_slist_t mq_list = SYS_SLIST_STATIC_INIT(&mq_list);
+/* Open message queues, by name */
+static struct sys_htable_node *mq_buckets[16];
+static struct sys_htable mq_table = SYS_HTABLE_INIT(mq_buckets);
 
 int64_t timespec_to_timeoutms(const struct timespec *abstime);
-static mqueue_object *find_in_list(const char *name);
+static mqueue_object *find_mq(const char *name);
 static int32_t send_message(mqueue_desc *mqd, const char *msg_ptr, size_t msg_len,
-			  k_timeout_t timeout);
-static int receive_message(mqueue_desc *mqd, char *msg_ptr, size_t msg_len,
-			   k_timeout_t timeout);
+			    unsigned int msg_prio, k_timeout_t timeout);
+static int32_t receive_message(mqueue_desc *mqd, char *msg_ptr, size_t msg_len,
+			       unsigned int *msg_prio, k_timeout_t timeout);
 static void remove_mq(mqueue_object *msg_queue);
 
 #if defined(__sparc__)
@@ -65,7 +102,8 @@ mqd_t mq_open(const char *name, int oflags, ...)
 	long msg_size = 0U, max_msgs = 0U;
 	mqueue_object *msg_queue;
 	mqueue_desc *msg_queue_desc = NULL, *mqd = (mqueue_desc *)(-1);
-	char *mq_desc_ptr, *mq_obj_ptr, *mq_buf_ptr, *mq_name_ptr;
+	char *mq_desc_ptr, *mq_obj_ptr;
+	size_t slot_size, obj_size;
 
 	va_start(va, oflags);
 	if ((oflags & O_CREAT) != 0) {
@@ -90,96 +128,96 @@ mqd_t mq_open(const char *name, int oflags, ...)
 		return (mqd_t)mqd;
 	}
 
-	/* Check if queue already exists */
+	mq_desc_ptr = k_malloc(sizeof(struct mqueue_desc));
+	if (mq_desc_ptr != NULL) {
+		(void)memset(mq_desc_ptr, 0, sizeof(struct mqueue_desc));
+		msg_queue_desc = (struct mqueue_desc *)mq_desc_ptr;
+		msg_queue_desc->mem_desc = mq_desc_ptr;
+	} else {
+		errno = ENOSPC;
+		return (mqd_t)mqd;
+	}
+
+	/* Look up and create under the same lock, so that two threads
+	 * opening the same new name get the same queue.
+	 */
 	k_sem_take(&mq_sem, K_FOREVER);
-	msg_queue = find_in_list(name);
-	k_sem_give(&mq_sem);
+	msg_queue = find_mq(name);
 
 	if ((msg_queue != NULL) && (oflags & O_CREAT) != 0 &&
 	    (oflags & O_EXCL) != 0) {
 		/* Message queue has already been opened and O_EXCL is set */
 		errno = EEXIST;
-		return (mqd_t)mqd;
+		goto free_mq_desc;
 	}
 
 	if ((msg_queue == NULL) && (oflags & O_CREAT) == 0) {
 		errno = ENOENT;
-		return (mqd_t)mqd;
-	}
-
-	mq_desc_ptr = k_malloc(sizeof(struct mqueue_desc));
-	if (mq_desc_ptr != NULL) {
-		(void)memset(mq_desc_ptr, 0, sizeof(struct mqueue_desc));
-		msg_queue_desc = (struct mqueue_desc *)mq_desc_ptr;
-		msg_queue_desc->mem_desc = mq_desc_ptr;
-	} else {
 		goto free_mq_desc;
 	}
 
-
 	/* Allocate mqueue object for new message queue */
 	if (msg_queue == NULL) {
 
 		/* Check for message quantity and size in message queue */
-		if (attrs->mq_msgsize > CONFIG_MSG_SIZE_MAX &&
-		    attrs->mq_maxmsg > CONFIG_MSG_COUNT_MAX) {
+		if (msg_size > CONFIG_MSG_SIZE_MAX ||
+		    max_msgs > CONFIG_MSG_COUNT_MAX) {
+			errno = EINVAL;
 			goto free_mq_desc;
 		}
 
-		mq_obj_ptr = k_malloc(sizeof(mqueue_object));
-		if (mq_obj_ptr != NULL) {
-			(void)memset(mq_obj_ptr, 0, sizeof(mqueue_object));
-			msg_queue = (mqueue_object *)mq_obj_ptr;
-			msg_queue->mem_obj = mq_obj_ptr;
-
-		} else {
-			goto free_mq_object;
+		/* Object and message slots in a single allocation */
+		slot_size = ROUND_UP(sizeof(struct mq_msg) + msg_size,
+				     sizeof(void *));
+		if (size_mul_overflow(slot_size, max_msgs, &obj_size) ||
+		    size_add_overflow(obj_size, sizeof(mqueue_object),
+				      &obj_size)) {
+			errno = ENOSPC;
+			goto free_mq_desc;
 		}
 
-		mq_name_ptr = k_malloc(strlen(name) + 1);
-		if (mq_name_ptr != NULL) {
-			(void)memset(mq_name_ptr, 0, strlen(name) + 1);
-			msg_queue->name = mq_name_ptr;
-
-		} else {
-			goto free_mq_name;
+		mq_obj_ptr = k_malloc(obj_size);
+		if (mq_obj_ptr == NULL) {
+			errno = ENOSPC;
+			goto free_mq_desc;
 		}
 
+		(void)memset(mq_obj_ptr, 0, sizeof(mqueue_object));
+		msg_queue = (mqueue_object *)mq_obj_ptr;
 		strcpy(msg_queue->name, name);
+		msg_queue->msg_size = msg_size;
+		msg_queue->max_msgs = max_msgs;
+		z_waitq_init(&msg_queue->send_q);
+		z_waitq_init(&msg_queue->recv_q);
+
+		sys_slist_init(&msg_queue->free_l);
+		for (long i = 0; i < max_msgs; i++) {
+			sys_slist_append(&msg_queue->free_l,
+					 (sys_snode_t *)(mq_obj_ptr +
+							 sizeof(mqueue_object) +
+							 i * slot_size));
+		}
 
-		mq_buf_ptr = k_malloc(msg_size * max_msgs * sizeof(uint8_t));
-		if (mq_buf_ptr != NULL) {
-			(void)memset(mq_buf_ptr, 0,
-				     msg_size * max_msgs * sizeof(uint8_t));
-			msg_queue->mem_buffer = mq_buf_ptr;
-		} else {
-			goto free_mq_buffer;
+		for (int i = 0; i < MQ_PRIO_MAX; i++) {
+			sys_slist_init(&msg_queue->prio_l[i]);
 		}
 
 		(void)atomic_set(&msg_queue->ref_count, 1);
-		/* initialize zephyr message queue */
-		k_msgq_init(&msg_queue->queue, msg_queue->mem_buffer, msg_size,
-			    max_msgs);
-		k_sem_take(&mq_sem, K_FOREVER);
-		sys_slist_append(&mq_list, (sys_snode_t *)&(msg_queue->snode));
-		k_sem_give(&mq_sem);
-
+		sys_htable_insert(&mq_table, &msg_queue->hnode,
+				  sys_htable_hash(SYS_HTABLE_HASH_INIT, name,
+						  strlen(name)));
 	} else {
 		atomic_inc(&msg_queue->ref_count);
 	}
+	k_sem_give(&mq_sem);
 
 	msg_queue_desc->mqueue = msg_queue;
 	msg_queue_desc->flags = (oflags & O_NONBLOCK) != 0 ? O_NONBLOCK : 0;
 	return (mqd_t)msg_queue_desc;
 
-free_mq_buffer:
-	k_free(mq_name_ptr);
-free_mq_name:
-	k_free(mq_obj_ptr);
-free_mq_object:
-	k_free(mq_desc_ptr);
 free_mq_desc:
-	errno = ENOSPC;
+	k_sem_give(&mq_sem);
+	k_free(mq_desc_ptr);
 	return (mqd_t)mqd;
 }
 
@@ -197,12 +235,14 @@ int mq_close(mqd_t mqdes)
 		return -1;
 	}
 
+	k_sem_take(&mq_sem, K_FOREVER);
 	atomic_dec(&mqd->mqueue->ref_count);
 
 	/* remove mq if marked for unlink */
-	if (mqd->mqueue->name == NULL) {
+	if (mqd->mqueue->unlinked) {
 		remove_mq(mqd->mqueue);
 	}
+	k_sem_give(&mq_sem);
 
 	k_free(mqd->mem_desc);
 	return 0;
@@ -218,7 +258,7 @@ int mq_unlink(const char *name)
 	mqueue_object *msg_queue;
 
 	k_sem_take(&mq_sem, K_FOREVER);
-	msg_queue = find_in_list(name);
+	msg_queue = find_mq(name);
 
 	if (msg_queue == NULL) {
 		k_sem_give(&mq_sem);
@@ -226,18 +266,19 @@ int mq_unlink(const char *name)
 		return -1;
 	}
 
-	k_free(msg_queue->name);
-	msg_queue->name = NULL;
-	k_sem_give(&mq_sem);
+	/* The name is free for a new queue right away, the queue itself
+	 * lives on until its last descriptor is closed.
+	 */
+	(void)sys_htable_remove(&mq_table, &msg_queue->hnode);
+	msg_queue->unlinked = true;
 	remove_mq(msg_queue);
+	k_sem_give(&mq_sem);
 	return 0;
 }
 
 /**
  * @brief Send a message to a message queue.
  *
- * All messages in message queue are of equal priority.
- *
  * See IEEE 1003.1
  */
 int mq_send(mqd_t mqdes, const char *msg_ptr, size_t msg_len,
@@ -245,14 +286,12 @@ int mq_send(mqd_t mqdes, const char *msg_ptr, size_t msg_len,
 {
 	mqueue_desc *mqd = (mqueue_desc *)mqdes;
 
-	return send_message(mqd, msg_ptr, msg_len, K_FOREVER);
+	return send_message(mqd, msg_ptr, msg_len, msg_prio, K_FOREVER);
 }
 
 /**
  * @brief Send message to a message queue within abstime time.
  *
- * All messages in message queue are of equal priority.
- *
  * See IEEE 1003.1
  */
 int mq_timedsend(mqd_t mqdes, const char *msg_ptr, size_t msg_len,
@@ -261,13 +300,13 @@ int mq_timedsend(mqd_t mqdes, const char *msg_ptr, size_t msg_len,
 	mqueue_desc *mqd = (mqueue_desc *)mqdes;
 	int32_t timeout = (int32_t) timespec_to_timeoutms(abstime);
 
-	return send_message(mqd, msg_ptr, msg_len, K_MSEC(timeout));
+	return send_message(mqd, msg_ptr, msg_len, msg_prio, K_MSEC(timeout));
 }
 
 /**
  * @brief Receive a message from a message queue.
  *
- * All messages in message queue are of equal priority.
+ * The oldest message of the highest priority is received.
  *
  * See IEEE 1003.1
  */
@@ -276,13 +315,13 @@ int mq_receive(mqd_t mqdes, char *msg_ptr, size_t msg_len,
 {
 	mqueue_desc *mqd = (mqueue_desc *)mqdes;
 
-	return receive_message(mqd, msg_ptr, msg_len, K_FOREVER);
+	return receive_message(mqd, msg_ptr, msg_len, msg_prio, K_FOREVER);
 }
 
 /**
  * @brief Receive message from a message queue within abstime time.
  *
- * All messages in message queue are of equal priority.
+ * The oldest message of the highest priority is received.
  *
  * See IEEE 1003.1
  */
@@ -292,7 +331,8 @@ int mq_timedreceive(mqd_t mqdes, char *msg_ptr, size_t msg_len,
 	mqueue_desc *mqd = (mqueue_desc *)mqdes;
 	int32_t timeout = (int32_t) timespec_to_timeoutms(abstime);
 
-	return receive_message(mqd, msg_ptr, msg_len, K_MSEC(timeout));
+	return receive_message(mqd, msg_ptr, msg_len, msg_prio,
+			       K_MSEC(timeout));
 }
 
 /**
@@ -303,20 +343,19 @@ int mq_timedreceive(mqd_t mqdes, char *msg_ptr, size_t msg_len,
 int mq_getattr(mqd_t mqdes, struct mq_attr *mqstat)
 {
 	mqueue_desc *mqd = (mqueue_desc *)mqdes;
-	struct k_msgq_attrs attrs;
+	k_spinlock_key_t key;
 
 	if (mqd == NULL) {
 		errno = EBADF;
 		return -1;
 	}
 
-	k_sem_take(&mq_sem, K_FOREVER);
-	k_msgq_get_attrs(&mqd->mqueue->queue, &attrs);
+	key = k_spin_lock(&mqd->mqueue->lock);
 	mqstat->mq_flags = mqd->flags;
-	mqstat->mq_maxmsg = attrs.max_msgs;
-	mqstat->mq_msgsize = attrs.msg_size;
-	mqstat->mq_curmsgs = attrs.used_msgs;
-	k_sem_give(&mq_sem);
+	mqstat->mq_maxmsg = mqd->mqueue->max_msgs;
+	mqstat->mq_msgsize = mqd->mqueue->msg_size;
+	mqstat->mq_curmsgs = mqd->mqueue->used_msgs;
+	k_spin_unlock(&mqd->mqueue->lock, key);
 	return 0;
 }
 
@@ -352,28 +391,58 @@ int mq_setattr(mqd_t mqdes, const struct mq_attr *mqstat,
 }
 
 /* Internal functions */
-static mqueue_object *find_in_list(const char *name)
+static bool mq_name_eq(const struct sys_htable_node *node, const void *key)
 {
-	sys_snode_t *mq;
-	mqueue_object *msg_queue;
+	const mqueue_object *msg_queue =
+		CONTAINER_OF(node, mqueue_object, hnode);
+
+	return strcmp(msg_queue->name, key) == 0;
+}
 
-	mq = mq_list.head;
+/* Called with mq_sem held */
+static mqueue_object *find_mq(const char *name)
+{
+	struct sys_htable_node *node;
 
-	while (mq != NULL) {
-		msg_queue = (mqueue_object *)mq;
-		if (strcmp(msg_queue->name, name) == 0) {
-			return msg_queue;
-		}
+	node = sys_htable_find(&mq_table,
+			       sys_htable_hash(SYS_HTABLE_HASH_INIT, name,
+					       strlen(name)),
+			       name, mq_name_eq);
 
-		mq = mq->next;
+	return (node == NULL) ? NULL :
+	       CONTAINER_OF(node, mqueue_object, hnode);
+}
+
+static void msg_store(mqueue_object *mq, struct mq_msg *msg,
+		      const char *data, size_t len, unsigned int prio)
+{
+	(void)memcpy(msg + 1, data, len);
+	msg->len = len;
+	msg->prio = prio;
+	sys_slist_append(&mq->prio_l[prio], &msg->node);
+	mq->prio_map |= BIT(prio);
+}
+
+static struct mq_msg *msg_take(mqueue_object *mq)
+{
+	unsigned int prio = find_msb_set(mq->prio_map) - 1U;
+	struct mq_msg *msg =
+		(struct mq_msg *)sys_slist_get_not_empty(&mq->prio_l[prio]);
+
+	if (sys_slist_is_empty(&mq->prio_l[prio])) {
+		mq->prio_map &= ~BIT(prio);
 	}
 
-	return NULL;
+	return msg;
 }
 
 static int32_t send_message(mqueue_desc *mqd, const char *msg_ptr, size_t msg_len,
-			  k_timeout_t timeout)
+			    unsigned int msg_prio, k_timeout_t timeout)
 {
+	struct mq_xfer xfer;
+	struct k_thread *thread;
+	mqueue_object *mq;
+	k_spinlock_key_t key;
 	int32_t ret = -1;
 
 	if (mqd == NULL) {
@@ -385,13 +454,55 @@ static int32_t send_message(mqueue_desc *mqd, const char *msg_ptr, size_t msg_le
 		timeout = K_NO_WAIT;
 	}
 
-	if (msg_len >  mqd->mqueue->queue.msg_size) {
+	mq = mqd->mqueue;
+
+	if (msg_len > mq->msg_size) {
 		errno = EMSGSIZE;
 		return ret;
 	}
 
-	if (k_msgq_put(&mqd->mqueue->queue, (void *)msg_ptr, timeout) != 0) {
-		errno = K_TIMEOUT_EQ(timeout, K_NO_WAIT) ? EAGAIN : ETIMEDOUT;
+	if (msg_prio >= MQ_PRIO_MAX) {
+		errno = EINVAL;
+		return ret;
+	}
+
+	key = k_spin_lock(&mq->lock);
+
+	/* A blocked receiver means the queue is empty, hand it over */
+	thread = z_unpend_first_thread(&mq->recv_q);
+	if (thread != NULL) {
+		struct mq_xfer *rx = thread->base.swap_data;
+
+		(void)memcpy(rx->buf, msg_ptr, msg_len);
+		rx->len = msg_len;
+		rx->prio = msg_prio;
+		arch_thread_return_value_set(thread, 0);
+		z_ready_thread(thread);
+		z_reschedule(&mq->lock, key);
+		return 0;
+	}
+
+	if (mq->used_msgs < mq->max_msgs) {
+		msg_store(mq, (struct mq_msg *)sys_slist_get_not_empty(&mq->free_l),
+			  msg_ptr, msg_len, msg_prio);
+		mq->used_msgs++;
+		k_spin_unlock(&mq->lock, key);
+		return 0;
+	}
+
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		k_spin_unlock(&mq->lock, key);
+		errno = EAGAIN;
+		return ret;
+	}
+
+	/* The receiver freeing a slot stores the message for us */
+	xfer.buf = (char *)msg_ptr;
+	xfer.len = msg_len;
+	xfer.prio = msg_prio;
+	_current->base.swap_data = &xfer;
+	if (z_pend_curr(&mq->lock, key, &mq->send_q, timeout) != 0) {
+		errno = ETIMEDOUT;
 		return ret;
 	}
 
@@ -399,8 +510,13 @@ static int32_t send_message(mqueue_desc *mqd, const char *msg_ptr, size_t msg_le
 }
 
 static int32_t receive_message(mqueue_desc *mqd, char *msg_ptr, size_t msg_len,
-			     k_timeout_t timeout)
+			       unsigned int *msg_prio, k_timeout_t timeout)
 {
+	struct mq_xfer xfer;
+	struct k_thread *thread;
+	struct mq_msg *msg;
+	mqueue_object *mq;
+	k_spinlock_key_t key;
 	int ret = -1;
 
 	if (mqd == NULL) {
@@ -408,7 +524,9 @@ static int32_t receive_message(mqueue_desc *mqd, char *msg_ptr, size_t msg_len,
 		return ret;
 	}
 
-	if (msg_len < mqd->mqueue->queue.msg_size) {
+	mq = mqd->mqueue;
+
+	if (msg_len < mq->msg_size) {
 		errno = EMSGSIZE;
 		return ret;
 	}
@@ -417,24 +535,60 @@ static int32_t receive_message(mqueue_desc *mqd, char *msg_ptr, size_t msg_len,
 		timeout = K_NO_WAIT;
 	}
 
-	if (k_msgq_get(&mqd->mqueue->queue, (void *)msg_ptr, timeout) != 0) {
-		errno = K_TIMEOUT_EQ(timeout, K_NO_WAIT) ? EAGAIN : ETIMEDOUT;
-	} else {
-		ret = mqd->mqueue->queue.msg_size;
+	key = k_spin_lock(&mq->lock);
+
+	if (mq->used_msgs > 0) {
+		msg = msg_take(mq);
+		(void)memcpy(msg_ptr, msg + 1, msg->len);
+		ret = msg->len;
+		if (msg_prio != NULL) {
+			*msg_prio = msg->prio;
+		}
+
+		/* Reuse the slot for the message of a blocked sender */
+		thread = z_unpend_first_thread(&mq->send_q);
+		if (thread != NULL) {
+			struct mq_xfer *tx = thread->base.swap_data;
+
+			msg_store(mq, msg, tx->buf, tx->len, tx->prio);
+			arch_thread_return_value_set(thread, 0);
+			z_ready_thread(thread);
+			z_reschedule(&mq->lock, key);
+			return ret;
+		}
+
+		sys_slist_prepend(&mq->free_l, &msg->node);
+		mq->used_msgs--;
+		k_spin_unlock(&mq->lock, key);
+		return ret;
+	}
+
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		k_spin_unlock(&mq->lock, key);
+		errno = EAGAIN;
+		return ret;
 	}
 
-	return ret;
+	/* A sender copies its message straight into our buffer */
+	xfer.buf = msg_ptr;
+	_current->base.swap_data = &xfer;
+	if (z_pend_curr(&mq->lock, key, &mq->recv_q, timeout) != 0) {
+		errno = ETIMEDOUT;
+		return ret;
+	}
+
+	if (msg_prio != NULL) {
+		*msg_prio = xfer.prio;
+	}
+
+	return xfer.len;
 }
 
+/* Called with mq_sem held */
 static void remove_mq(mqueue_object *msg_queue)
 {
-	if (atomic_cas(&msg_queue->ref_count, 0, 0)) {
-		k_sem_take(&mq_sem, K_FOREVER);
-		sys_slist_find_and_remove(&mq_list, (sys_snode_t *) msg_queue);
-		k_sem_give(&mq_sem);
-
-		/* Free mq buffer and pbject */
-		k_free(msg_queue->mem_buffer);
-		k_free(msg_queue->mem_obj);
+	if (atomic_get(&msg_queue->ref_count) == 0) {
+		/* Object and message slots were allocated together */
+		k_free(msg_queue);
 	}
 }
@@ -6,6 +6,7 @@
 
 #include <zephyr/kernel.h>
 #include <stdio.h>
+#include <string.h>
 #include <zephyr/sys/atomic.h>
 #include <ksched.h>
 #include <zephyr/wait_q.h>
@@ -19,6 +20,8 @@
 
 PTHREAD_MUTEX_DEFINE(pthread_key_lock);
 
+void z_pthread_key_data_destroy(struct posix_thread *thread);
+
 static const pthread_attr_t init_pthread_attrs = {
 	.priority = LOWEST_POSIX_THREAD_PRIORITY,
 	.stack = NULL,
@@ -181,7 +184,7 @@ int pthread_create(pthread_t *newthread, const pthread_attr_t *attr,
 	pthread_mutex_unlock(&thread->state_lock);
 
 	pthread_cond_init(&thread->state_cond, &cond_attr);
-	sys_slist_init(&thread->key_list);
+	(void)memset(thread->key_data, 0, sizeof(thread->key_data));
 
 	*newthread = (pthread_t) k_thread_create(&thread->thread, attr->stack,
 						 attr->stacksize,
@@ -355,9 +358,6 @@ int pthread_once(pthread_once_t *once, void (*init_func)(void))
 void pthread_exit(void *retval)
 {
 	struct posix_thread *self = (struct posix_thread *)pthread_self();
-	pthread_key_obj *key_obj;
-	pthread_thread_data *thread_spec_data;
-	sys_snode_t *node_l;
 
 	/* Make a thread as cancelable before exiting */
 	pthread_mutex_lock(&self->cancel_lock);
@@ -377,15 +377,7 @@ void pthread_exit(void *retval)
 		self->state = PTHREAD_TERMINATED;
 	}
 
-	SYS_SLIST_FOR_EACH_NODE(&self->key_list, node_l) {
-		thread_spec_data = (pthread_thread_data *)node_l;
-		if (thread_spec_data != NULL) {
-			key_obj = thread_spec_data->key;
-			if (key_obj->destructor != NULL) {
-				(key_obj->destructor)(thread_spec_data->spec_data);
-			}
-		}
-	}
+	z_pthread_key_data_destroy(self);
 
 	pthread_mutex_unlock(&self->state_lock);
 	k_thread_abort((k_tid_t)self);
@@ -12,6 +12,7 @@
 extern struct k_spinlock z_pthread_spinlock;
 
 int64_t timespec_to_timeoutms(const struct timespec *abstime);
+bool z_pthread_mutex_release(pthread_mutex_t *m);
 
 static int cond_wait(pthread_cond_t *cv, pthread_mutex_t *mut,
 		     k_timeout_t timeout)
@@ -21,11 +22,17 @@ static int cond_wait(pthread_cond_t *cv, pthread_mutex_t *mut,
 	int ret;
 	k_spinlock_key_t key = k_spin_lock(&z_pthread_spinlock);
 
-	mut->lock_count = 0U;
-	mut->owner = NULL;
-	_ready_one_thread(&mut->wait_q);
+	/* Registering as a waiter with the mutex still held guarantees
+	 * that a thread signaling after changing the predicate, which
+	 * requires the mutex, sees us.
+	 */
+	atomic_inc(&cv->waiters);
+
+	(void)z_pthread_mutex_release(mut);
 	ret = z_sched_wait(&z_pthread_spinlock, key, &cv->wait_q, timeout, NULL);
 
+	atomic_dec(&cv->waiters);
+
 	/* FIXME: this extra lock (and the potential context switch it
 	 * can cause) could be optimized out.  At the point of the
 	 * signal/broadcast, it's possible to detect whether or not we
@@ -39,15 +46,22 @@ static int cond_wait(pthread_cond_t *cv, pthread_mutex_t *mut,
 	return ret == -EAGAIN ? ETIMEDOUT : ret;
 }
 
+/* Signaling without waiters does not enter the scheduler */
 int pthread_cond_signal(pthread_cond_t *cv)
 {
-	z_sched_wake(&cv->wait_q, 0, NULL);
+	if (atomic_get(&cv->waiters) > 0) {
+		z_sched_wake(&cv->wait_q, 0, NULL);
+	}
+
 	return 0;
 }
 
 int pthread_cond_broadcast(pthread_cond_t *cv)
 {
-	z_sched_wake_all(&cv->wait_q, 0, NULL);
+	if (atomic_get(&cv->waiters) > 0) {
+		z_sched_wake_all(&cv->wait_q, 0, NULL);
+	}
+
 	return 0;
 }
 
@@ -11,6 +11,16 @@ struct k_sem pthread_key_sem;
 
 K_SEM_DEFINE(pthread_key_sem, 1, 1);
 
+static pthread_key_obj key_table[CONFIG_MAX_PTHREAD_KEY_COUNT];
+static uint32_t last_generation;
+
+/* Generation of a key, or 0 if the key does not exist */
+static inline uint32_t key_generation_get(pthread_key_t key)
+{
+	return (key < CONFIG_MAX_PTHREAD_KEY_COUNT) ?
+	       key_table[key].generation : 0U;
+}
+
 /**
  * @brief Create a key for thread-specific data
  *
@@ -19,22 +29,33 @@ K_SEM_DEFINE(pthread_key_sem, 1, 1);
 int pthread_key_create(pthread_key_t *key,
 		void (*destructor)(void *))
 {
-	pthread_key_obj *new_key;
+	int retval = EAGAIN;
+
+	k_sem_take(&pthread_key_sem, K_FOREVER);
 
-	*key = NULL;
+	for (pthread_key_t i = 0; i < CONFIG_MAX_PTHREAD_KEY_COUNT; i++) {
+		if (key_table[i].generation != 0U) {
+			continue;
+		}
 
-	new_key = k_malloc(sizeof(pthread_key_obj));
+		/* A new generation makes the values that threads set for
+		 * a previous key in this slot read as NULL.
+		 */
+		last_generation++;
+		if (last_generation == 0U) {
+			last_generation++;
+		}
 
-	if (new_key == NULL) {
-		return ENOMEM;
+		key_table[i].destructor = destructor;
+		key_table[i].generation = last_generation;
+		*key = i;
+		retval = 0;
+		break;
 	}
 
-	sys_slist_init(&(new_key->key_data_l));
-
-	new_key->destructor = destructor;
-	*key = (void *)new_key;
+	k_sem_give(&pthread_key_sem);
 
-	return 0;
+	return retval;
 }
 
 /**
@@ -44,29 +65,20 @@ int pthread_key_create(pthread_key_t *key,
  */
 int pthread_key_delete(pthread_key_t key)
 {
-	pthread_key_obj *key_obj = (pthread_key_obj *)key;
-	pthread_key_data *key_data;
-	sys_snode_t *node_l, *next_node_l;
+	int retval = 0;
 
 	k_sem_take(&pthread_key_sem, K_FOREVER);
 
-	/* Delete thread-specific elements associated with the key */
-	SYS_SLIST_FOR_EACH_NODE_SAFE(&(key_obj->key_data_l),
-			node_l, next_node_l) {
-
-		/* Remove the object from the list key_data_l */
-		key_data = (pthread_key_data *)
-			sys_slist_get(&(key_obj->key_data_l));
-
-		/* Deallocate the object's memory */
-		k_free((void *)key_data);
+	if (key_generation_get(key) == 0U) {
+		retval = EINVAL;
+	} else {
+		key_table[key].generation = 0U;
+		key_table[key].destructor = NULL;
 	}
 
-	k_free((void *)key_obj);
-
 	k_sem_give(&pthread_key_sem);
 
-	return 0;
+	return retval;
 }
 
 /**
@@ -76,59 +88,18 @@ int pthread_key_delete(pthread_key_t key)
  */
 int pthread_setspecific(pthread_key_t key, const void *value)
 {
-	pthread_key_obj *key_obj = (pthread_key_obj *)key;
 	struct posix_thread *thread = (struct posix_thread *)pthread_self();
-	pthread_key_data *key_data;
-	pthread_thread_data *thread_spec_data;
-	sys_snode_t *node_l;
-	int retval = 0;
-
-	/* Traverse the list of keys set by the thread, looking for key.
-	 * If the key is already in the list, re-assign its value.
-	 * Else add the key to the thread's list.
-	 */
-	k_sem_take(&pthread_key_sem, K_FOREVER);
-
-	SYS_SLIST_FOR_EACH_NODE(&(thread->key_list), node_l) {
-
-			thread_spec_data = (pthread_thread_data *)node_l;
+	uint32_t generation = key_generation_get(key);
 
-			if (thread_spec_data->key == key_obj) {
-
-				/* Key is already present so
-				 * associate thread specific data
-				 */
-				thread_spec_data->spec_data = (void *)value;
-				goto out;
-			}
+	if (generation == 0U) {
+		return EINVAL;
 	}
 
-	if (node_l == NULL) {
-		key_data = k_malloc(sizeof(pthread_key_data));
-
-		if (key_data == NULL) {
-			retval = ENOMEM;
-			goto out;
-
-		} else {
-			/* Associate thread specific data, initialize new key */
-			key_data->thread_data.key = key;
-			key_data->thread_data.spec_data = (void *)value;
-
-			/* Append new thread key data to thread's key list */
-			sys_slist_append((&thread->key_list),
-				(sys_snode_t *)(&key_data->thread_data));
+	/* Only the calling thread accesses its own slots */
+	thread->key_data[key].spec_data = (void *)value;
+	thread->key_data[key].generation = generation;
 
-			/* Append new key data to the key object's list */
-			sys_slist_append(&(key_obj->key_data_l),
-					(sys_snode_t *)key_data);
-		}
-	}
-
-out:
-	k_sem_give(&pthread_key_sem);
-
-	return retval;
+	return 0;
 }
 
 /**
@@ -138,28 +109,42 @@ out:
  */
 void *pthread_getspecific(pthread_key_t key)
 {
-	pthread_key_obj *key_obj = (pthread_key_obj *)key;
 	struct posix_thread *thread = (struct posix_thread *)pthread_self();
-	pthread_thread_data *thread_spec_data;
-	void *value = NULL;
-	sys_snode_t *node_l;
+	uint32_t generation = key_generation_get(key);
 
-	k_sem_take(&pthread_key_sem, K_FOREVER);
+	if (generation == 0U ||
+	    thread->key_data[key].generation != generation) {
+		return NULL;
+	}
 
-	node_l = sys_slist_peek_head(&(thread->key_list));
+	return thread->key_data[key].spec_data;
+}
+
+/* Run the destructors of the non-NULL values of an exiting thread */
+void z_pthread_key_data_destroy(struct posix_thread *thread)
+{
+	pthread_thread_data *data;
+	void (*destructor)(void *);
+	void *value;
 
-	/* Traverse the list of keys set by the thread, looking for key */
+	for (pthread_key_t key = 0; key < CONFIG_MAX_PTHREAD_KEY_COUNT; key++) {
+		data = &thread->key_data[key];
 
-	SYS_SLIST_FOR_EACH_NODE(&(thread->key_list), node_l) {
-		thread_spec_data = (pthread_thread_data *)node_l;
-		if (thread_spec_data->key == key_obj) {
-			/* Key is present, so get the set thread data */
-			value = thread_spec_data->spec_data;
-			break;
+		k_sem_take(&pthread_key_sem, K_FOREVER);
+		if (data->generation == 0U ||
+		    data->generation != key_table[key].generation) {
+			destructor = NULL;
+		} else {
+			destructor = key_table[key].destructor;
 		}
-	}
+		k_sem_give(&pthread_key_sem);
 
-	k_sem_give(&pthread_key_sem);
+		value = data->spec_data;
+		data->spec_data = NULL;
+		data->generation = 0U;
 
-	return value;
+		if (destructor != NULL && value != NULL) {
+			destructor(value);
+		}
+	}
 }
@@ -22,18 +22,24 @@ static const pthread_mutexattr_t def_attr = {
 	.type = PTHREAD_MUTEX_DEFAULT,
 };
 
+/*
+ * The state word makes the uncontended lock and unlock a single atomic
+ * operation, like a futex: z_pthread_spinlock and the wait queue are
+ * only used once a thread has to wait. A mutex is handed over to the
+ * first waiter on unlock, so woken up threads never have to retry.
+ */
+#define MUTEX_UNLOCKED		0
+#define MUTEX_LOCKED		1
+#define MUTEX_CONTENDED		2
+
 static int acquire_mutex(pthread_mutex_t *m, k_timeout_t timeout)
 {
-	int rc = 0;
-	k_spinlock_key_t key = k_spin_lock(&z_pthread_spinlock);
+	pthread_t self = pthread_self();
+	k_spinlock_key_t key;
+	int rc;
 
-	if (m->lock_count == 0U && m->owner == NULL) {
-		m->lock_count++;
-		m->owner = pthread_self();
-
-		k_spin_unlock(&z_pthread_spinlock, key);
-		return 0;
-	} else if (m->owner == pthread_self()) {
+	/* Only the calling thread can have made itself the owner */
+	if (m->owner == self) {
 		if (m->type == PTHREAD_MUTEX_RECURSIVE &&
 		    m->lock_count < MUTEX_MAX_REC_LOCK) {
 			m->lock_count++;
@@ -44,13 +50,29 @@ static int acquire_mutex(pthread_mutex_t *m, k_timeout_t timeout)
 			rc = EINVAL;
 		}
 
-		k_spin_unlock(&z_pthread_spinlock, key);
 		return rc;
 	}
 
+	if (atomic_cas(&m->state, MUTEX_UNLOCKED, MUTEX_LOCKED)) {
+		m->owner = self;
+		m->lock_count = 1U;
+		return 0;
+	}
+
 	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		return EBUSY;
+	}
+
+	key = k_spin_lock(&z_pthread_spinlock);
+
+	/* Marking the mutex contended, even if we end up taking it, makes
+	 * the owner hand it over on unlock.
+	 */
+	if (atomic_set(&m->state, MUTEX_CONTENDED) == MUTEX_UNLOCKED) {
+		m->owner = self;
+		m->lock_count = 1U;
 		k_spin_unlock(&z_pthread_spinlock, key);
-		return EINVAL;
+		return 0;
 	}
 
 	rc = z_pend_curr(&z_pthread_spinlock, key, &m->wait_q, timeout);
@@ -61,6 +83,44 @@ static int acquire_mutex(pthread_mutex_t *m, k_timeout_t timeout)
 	return rc;
 }
 
+/* Hand a contended mutex over to its first waiter, or unlock it if all
+ * waiters timed out. Called with z_pthread_spinlock held, returns true
+ * if a thread was made ready.
+ */
+static bool mutex_handoff(pthread_mutex_t *m)
+{
+	struct k_thread *thread = z_unpend_first_thread(&m->wait_q);
+
+	if (thread == NULL) {
+		atomic_set(&m->state, MUTEX_UNLOCKED);
+		return false;
+	}
+
+	m->owner = (pthread_t)thread;
+	m->lock_count = 1U;
+	if (z_waitq_head(&m->wait_q) == NULL) {
+		atomic_set(&m->state, MUTEX_LOCKED);
+	}
+
+	arch_thread_return_value_set(thread, 0);
+	z_ready_thread(thread);
+
+	return true;
+}
+
+/* Release a mutex held once by the caller, for condition variables.
+ * Called with z_pthread_spinlock held, returns true if a thread was
+ * made ready.
+ */
+bool z_pthread_mutex_release(pthread_mutex_t *m)
+{
+	m->lock_count = 0U;
+	m->owner = NULL;
+
+	return !atomic_cas(&m->state, MUTEX_LOCKED, MUTEX_UNLOCKED) &&
+	       mutex_handoff(m);
+}
+
 /**
  * @brief Lock POSIX mutex with non-blocking call.
  *
@@ -94,6 +154,7 @@ int pthread_mutex_init(pthread_mutex_t *m,
 {
 	const pthread_mutexattr_t *mattr;
 
+	atomic_set(&m->state, MUTEX_UNLOCKED);
 	m->owner = NULL;
 	m->lock_count = 0U;
 
@@ -124,36 +185,33 @@ int pthread_mutex_lock(pthread_mutex_t *m)
  */
 int pthread_mutex_unlock(pthread_mutex_t *m)
 {
-	k_spinlock_key_t key = k_spin_lock(&z_pthread_spinlock);
-
-	k_tid_t thread;
+	k_spinlock_key_t key;
 
 	if (m->owner != pthread_self()) {
-		k_spin_unlock(&z_pthread_spinlock, key);
 		return EPERM;
 	}
 
 	if (m->lock_count == 0U) {
-		k_spin_unlock(&z_pthread_spinlock, key);
 		return EINVAL;
 	}
 
 	m->lock_count--;
+	if (m->lock_count > 0U) {
+		return 0;
+	}
 
-	if (m->lock_count == 0U) {
-		thread = z_unpend_first_thread(&m->wait_q);
-		if (thread) {
-			m->owner = (pthread_t)thread;
-			m->lock_count++;
-			arch_thread_return_value_set(thread, 0);
-			z_ready_thread(thread);
-			z_reschedule(&z_pthread_spinlock, key);
-			return 0;
-		}
-		m->owner = NULL;
+	m->owner = NULL;
+	if (atomic_cas(&m->state, MUTEX_LOCKED, MUTEX_UNLOCKED)) {
+		return 0;
+	}
 
+	key = k_spin_lock(&z_pthread_spinlock);
+	if (mutex_handoff(m)) {
+		z_reschedule(&z_pthread_spinlock, key);
+	} else {
+		k_spin_unlock(&z_pthread_spinlock, key);
 	}
-	k_spin_unlock(&z_pthread_spinlock, key);
+
 	return 0;
 }
 
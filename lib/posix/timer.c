@@ -5,6 +5,7 @@
  */
 #include <zephyr/kernel.h>
 #include <errno.h>
+#include <limits.h>
 #include <string.h>
 #include <zephyr/sys/printk.h>
 #include <zephyr/posix/time.h>
@@ -21,6 +22,11 @@ struct timer_obj {
 	struct timespec interval;	/* Reload value */
 	uint32_t reload;			/* Reload value in ms */
 	uint32_t status;
+	int sigev_notify;
+	/* SIGEV_THREAD notification, run from the system work queue */
+	struct k_work work;
+	atomic_t pending_overruns;
+	int overrun;			/* Returned by timer_getoverrun() */
 };
 
 K_MEM_SLAB_DEFINE(posix_timer_slab, sizeof(struct timer_obj),
@@ -36,14 +42,35 @@ static void zephyr_timer_wrapper(struct k_timer *ztimer)
 		timer->status = NOT_ACTIVE;
 	}
 
+	if (timer->sigev_notify == SIGEV_THREAD) {
+		/* Expirations happening while the notification is still
+		 * queued are coalesced into it and counted as overruns,
+		 * rather than queueing one notification each.
+		 */
+		if (k_work_submit(&timer->work) == 0) {
+			atomic_inc(&timer->pending_overruns);
+		}
+		return;
+	}
+
+	(timer->sigev_notify_function)(timer->val);
+}
+
+static void timer_work_handler(struct k_work *work)
+{
+	struct timer_obj *timer = CONTAINER_OF(work, struct timer_obj, work);
+
+	timer->overrun = MIN(atomic_set(&timer->pending_overruns, 0),
+			     INT_MAX);
 	(timer->sigev_notify_function)(timer->val);
 }
 
 /**
  * @brief Create a per-process timer.
  *
- * This API does not accept SIGEV_THREAD as valid signal event notification
- * type.
+ * SIGEV_SIGNAL notification functions are called from the timer interrupt.
+ * SIGEV_THREAD notification functions are called from the system work queue,
+ * its attributes are ignored.
  *
  * See IEEE 1003.1
  */
@@ -53,7 +80,8 @@ int timer_create(clockid_t clockid, struct sigevent *evp, timer_t *timerid)
 
 	if (clockid != CLOCK_MONOTONIC || evp == NULL ||
 	    (evp->sigev_notify != SIGEV_NONE &&
-	     evp->sigev_notify != SIGEV_SIGNAL)) {
+	     evp->sigev_notify != SIGEV_SIGNAL &&
+	     evp->sigev_notify != SIGEV_THREAD)) {
 		errno = EINVAL;
 		return -1;
 	}
@@ -71,6 +99,11 @@ int timer_create(clockid_t clockid, struct sigevent *evp, timer_t *timerid)
 	timer->interval.tv_nsec = 0;
 	timer->reload = 0U;
 	timer->status = NOT_ACTIVE;
+	timer->sigev_notify = evp->sigev_notify;
+
+	if (evp->sigev_notify == SIGEV_THREAD) {
+		k_work_init(&timer->work, timer_work_handler);
+	}
 
 	if (evp->sigev_notify == SIGEV_NONE) {
 		k_timer_init(&timer->ztimer, NULL, NULL);
@@ -178,6 +211,26 @@ int timer_settime(timer_t timerid, int flags, const struct itimerspec *value,
 	return 0;
 }
 
+/**
+ * @brief Get the overrun count of a per-process timer.
+ *
+ * Returns the number of expirations that were coalesced into the last
+ * SIGEV_THREAD notification.
+ *
+ * See IEEE 1003.1
+ */
+int timer_getoverrun(timer_t timerid)
+{
+	struct timer_obj *timer = (struct timer_obj *)timerid;
+
+	if (timer == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	return timer->overrun;
+}
+
 /**
  * @brief Delete a per-process timer.
  *
@@ -197,6 +250,12 @@ int timer_delete(timer_t timerid)
 		k_timer_stop(&timer->ztimer);
 	}
 
+	if (timer->sigev_notify == SIGEV_THREAD) {
+		struct k_work_sync sync;
+
+		(void)k_work_cancel_sync(&timer->work, &sync);
+	}
+
 	k_mem_slab_free(&posix_timer_slab, (void *) &timer);
 
 	return 0;
@@ -20,50 +20,49 @@ struct internal_ctx {
 	bool exit      : 1;
 };
 
-static bool share_paren(const struct smf_state *test_state,
-			const struct smf_state *target_state)
+__unused static unsigned int get_depth(const struct smf_state *state)
 {
-	for (const struct smf_state *state = test_state;
-	     state != NULL;
-	     state = state->parent) {
-		if (target_state == state) {
-			return true;
-		}
+	unsigned int depth = 0;
+
+	for (; state != NULL; state = state->parent) {
+		depth++;
 	}
 
-	return false;
+	return depth;
 }
 
-static bool last_state_share_paren(struct smf_ctx *const ctx,
-				   const struct smf_state *state)
+__unused static const struct smf_state *get_ancestor(
+		const struct smf_state *state, unsigned int n)
 {
-	/* Get parent state of previous state */
-	if (!ctx->previous) {
-		return false;
+	for (; n > 0; n--) {
+		state = state->parent;
 	}
 
-	return share_paren(ctx->previous->parent, state);
+	return state;
 }
 
-static const struct smf_state *get_child_of(const struct smf_state *states,
-					    const struct smf_state *parent)
+/*
+ * Find the lowest common ancestor of two states, either of which may be
+ * NULL, in a single walk up from states at the same depth.
+ */
+__unused static const struct smf_state *get_lca(
+		const struct smf_state *a, const struct smf_state *b)
 {
-	for (const struct smf_state *tmp = states; ; tmp = tmp->parent) {
-		if (tmp->parent == parent) {
-			return tmp;
-		}
+	unsigned int depth_a = get_depth(a);
+	unsigned int depth_b = get_depth(b);
 
-		if (tmp->parent == NULL) {
-			return NULL;
-		}
+	if (depth_a > depth_b) {
+		a = get_ancestor(a, depth_a - depth_b);
+	} else {
+		b = get_ancestor(b, depth_b - depth_a);
 	}
 
-	return NULL;
-}
+	while (a != b) {
+		a = a->parent;
+		b = b->parent;
+	}
 
-static const struct smf_state *get_last_of(const struct smf_state *states)
-{
-	return get_child_of(states, NULL);
+	return a;
 }
 
 /**
@@ -71,18 +70,22 @@ static const struct smf_state *get_last_of(const struct smf_state *states)
  *
  * @param ctx State machine context
  * @param target The entry actions of this target's ancestors are executed
+ * @param lca Common ancestor of the previous state and target, whose
+ *	      entry action and the ones of its ancestors are not executed
  * @return true if the state machine should terminate, else false
  */
 __unused static bool smf_execute_ancestor_entry_actions(
-		struct smf_ctx *const ctx, const struct smf_state *target)
+		struct smf_ctx *const ctx, const struct smf_state *target,
+		const struct smf_state *lca)
 {
 	struct internal_ctx * const internal = (void *) &ctx->internal;
 
-	for (const struct smf_state *to_execute = get_last_of(target);
-	     to_execute != NULL && to_execute != target;
-	     to_execute = get_child_of(target, to_execute)) {
-		/* Execute parent state's entry */
-		if (!last_state_share_paren(ctx, to_execute) && to_execute->entry) {
+	/* Entry actions are executed from the outermost state inward */
+	for (unsigned int n = get_depth(target->parent) - get_depth(lca);
+	     n > 0; n--) {
+		const struct smf_state *to_execute = get_ancestor(target, n);
+
+		if (to_execute->entry) {
 			to_execute->entry(ctx);
 
 			/* No need to continue if terminate was set */
@@ -146,20 +149,21 @@ __unused static bool smf_execute_ancestor_run_actions(struct smf_ctx *ctx)
  * @brief Execute all ancestor exit actions
  *
  * @param ctx State machine context
- * @param target The exit actions of this target's ancestors are executed
+ * @param lca Common ancestor of the current and target states, whose exit
+ *	      action and the ones of its ancestors are not executed
  * @return true if the state machine should terminate, else false
  */
 __unused static bool smf_execute_ancestor_exit_actions(
-		struct smf_ctx *const ctx, const struct smf_state *target)
+		struct smf_ctx *const ctx, const struct smf_state *lca)
 {
 	struct internal_ctx * const internal = (void *) &ctx->internal;
 
 	/* Execute all parent exit actions in reverse order */
 
 	for (const struct smf_state *tmp_state = ctx->current->parent;
-	     tmp_state != NULL;
+	     tmp_state != lca;
 	     tmp_state = tmp_state->parent) {
-		if (!share_paren(target->parent, tmp_state) && tmp_state->exit) {
+		if (tmp_state->exit) {
 			tmp_state->exit(ctx);
 
 			/* No need to continue if terminate was set */
@@ -180,11 +184,17 @@ void smf_set_initial(struct smf_ctx *ctx, const struct smf_state *init_state)
 	ctx->current = init_state;
 	ctx->previous = NULL;
 	ctx->terminate_val = 0;
+#ifdef CONFIG_SMF_EVENTS
+	ctx->event = NULL;
+#endif
+#ifdef CONFIG_SMF_STATE_TIMING
+	ctx->entered = k_cycle_get_32();
+#endif
 
 	if (IS_ENABLED(CONFIG_SMF_ANCESTOR_SUPPORT)) {
 		internal->new_state = false;
 
-		if (smf_execute_ancestor_entry_actions(ctx, init_state)) {
+		if (smf_execute_ancestor_entry_actions(ctx, init_state, NULL)) {
 			return;
 		}
 	}
@@ -198,6 +208,10 @@ void smf_set_initial(struct smf_ctx *ctx, const struct smf_state *init_state)
 void smf_set_state(struct smf_ctx *const ctx, const struct smf_state *target)
 {
 	struct internal_ctx * const internal = (void *) &ctx->internal;
+	__unused const struct smf_state *lca = NULL;
+#ifdef CONFIG_SMF_STATE_TIMING
+	uint32_t start = k_cycle_get_32();
+#endif
 
 	/*
 	 * It does not make sense to call set_state in an exit phase of a state
@@ -225,9 +239,14 @@ void smf_set_state(struct smf_ctx *const ctx, const struct smf_state *target)
 	}
 
 	if (IS_ENABLED(CONFIG_SMF_ANCESTOR_SUPPORT)) {
+		/*
+		 * The ancestors shared by the current and target states
+		 * are neither exited nor entered.
+		 */
+		lca = get_lca(ctx->current->parent, target->parent);
 		internal->new_state = true;
 
-		if (smf_execute_ancestor_exit_actions(ctx, target)) {
+		if (smf_execute_ancestor_exit_actions(ctx, lca)) {
 			return;
 		}
 	}
@@ -239,7 +258,7 @@ void smf_set_state(struct smf_ctx *const ctx, const struct smf_state *target)
 	ctx->current = target;
 
 	if (IS_ENABLED(CONFIG_SMF_ANCESTOR_SUPPORT)) {
-		if (smf_execute_ancestor_entry_actions(ctx, target)) {
+		if (smf_execute_ancestor_entry_actions(ctx, target, lca)) {
 			return;
 		}
 	}
@@ -252,6 +271,16 @@ void smf_set_state(struct smf_ctx *const ctx, const struct smf_state *target)
 		 * smf_run_state function
 		 */
 	}
+
+#ifdef CONFIG_SMF_STATE_TIMING
+	uint32_t now = k_cycle_get_32();
+
+	if (ctx->timing_cb != NULL) {
+		ctx->timing_cb(ctx, ctx->previous, start - ctx->entered,
+			       now - start);
+	}
+	ctx->entered = now;
+#endif
 }
 
 void smf_set_terminate(struct smf_ctx *ctx, int32_t val)
@@ -283,3 +312,35 @@ int32_t smf_run_state(struct smf_ctx *const ctx)
 
 	return 0;
 }
+
+#ifdef CONFIG_SMF_EVENTS
+int32_t smf_run_event(struct smf_ctx *const ctx, const void *event)
+{
+	int32_t ret;
+
+	ctx->event = event;
+	ret = smf_run_state(ctx);
+	ctx->event = NULL;
+
+	return ret;
+}
+
+int smf_dispatch(struct smf_ctx *const ctx, struct k_msgq *queue, void *buf,
+		 k_timeout_t timeout)
+{
+	int ret = k_msgq_get(queue, buf, timeout);
+
+	if (ret == 0) {
+		(void)smf_run_event(ctx, buf);
+	}
+
+	return ret;
+}
+#endif /* CONFIG_SMF_EVENTS */
+
+#ifdef CONFIG_SMF_STATE_TIMING
+void smf_set_timing_cb(struct smf_ctx *ctx, smf_timing_cb cb)
+{
+	ctx->timing_cb = cb;
+}
+#endif /* CONFIG_SMF_STATE_TIMING */
@@ -165,6 +165,10 @@
 #define MBEDTLS_GCM_C
 #endif
 
+#if defined(CONFIG_MBEDTLS_GCM_ALT_CRYPTO_DRIVER)
+#define MBEDTLS_GCM_ALT
+#endif
+
 #if defined(CONFIG_MBEDTLS_CIPHER_MODE_XTS_ENABLED)
 #define MBEDTLS_CIPHER_MODE_XTS
 #endif
@@ -446,6 +450,14 @@
 #define MBEDTLS_SSL_CACHE_DEFAULT_MAX_ENTRIES CONFIG_MBEDTLS_SSL_CACHE_DEFAULT_MAX_ENTRIES
 #endif
 
+#if defined(CONFIG_MBEDTLS_SSL_SESSION_TICKETS)
+#define MBEDTLS_SSL_SESSION_TICKETS
+#endif
+
+#if defined(CONFIG_MBEDTLS_SSL_TICKET_C)
+#define MBEDTLS_SSL_TICKET_C
+#endif
+
 #if defined(CONFIG_MBEDTLS_SSL_EXTENDED_MASTER_SECRET)
 #define MBEDTLS_SSL_EXTENDED_MASTER_SECRET
 #endif
@@ -0,0 +1,261 @@
+/** @file
+ * @brief AES-GCM implementation of mbed TLS using a crypto driver
+ *
+ * Only the one-shot operations, the ones used to protect TLS records and
+ * session tickets, are offloaded. The streaming ones are not supported by
+ * the crypto driver API and fail.
+ */
+
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <limits.h>
+#include <string.h>
+#include <zephyr/device.h>
+#include <zephyr/crypto/crypto.h>
+#include <zephyr/logging/log.h>
+
+#if !defined(CONFIG_MBEDTLS_CFG_FILE)
+#include "mbedtls/config.h"
+#else
+#include CONFIG_MBEDTLS_CFG_FILE
+#endif /* CONFIG_MBEDTLS_CFG_FILE */
+
+#include <mbedtls/gcm.h>
+#include <mbedtls/platform_util.h>
+
+LOG_MODULE_REGISTER(mbedtls_gcm_alt, CONFIG_MBEDTLS_LOG_LEVEL);
+
+#define GCM_CAPS_REQUIRED (CAP_RAW_KEY | CAP_SYNC_OPS)
+
+static const struct device *const crypto_dev =
+	DEVICE_DT_GET(DT_CHOSEN(zephyr_crypto));
+
+static void gcm_session_close(struct zephyr_gcm_session *session)
+{
+	if (session->open) {
+		cipher_free_session(crypto_dev, &session->ctx);
+		session->open = false;
+	}
+}
+
+static int gcm_session_get(mbedtls_gcm_context *ctx,
+			   struct zephyr_gcm_session *session,
+			   enum cipher_op op, size_t iv_len, size_t tag_len)
+{
+	struct gcm_params *params = &session->ctx.mode_params.gcm_info;
+	int caps;
+	int ret;
+
+	if (ctx->keylen == 0U) {
+		return MBEDTLS_ERR_GCM_BAD_INPUT;
+	}
+
+	/* The sizes are fixed for the lifetime of a driver session, but
+	 * do not change for a given TLS transform.
+	 */
+	if (session->open && params->nonce_len == iv_len &&
+	    params->tag_len == tag_len) {
+		return 0;
+	}
+
+	gcm_session_close(session);
+
+	if (!device_is_ready(crypto_dev)) {
+		return MBEDTLS_ERR_GCM_BAD_INPUT;
+	}
+
+	caps = crypto_query_hwcaps(crypto_dev);
+	if ((caps & GCM_CAPS_REQUIRED) != GCM_CAPS_REQUIRED) {
+		LOG_ERR("Crypto driver lacks raw keys or synchronous ops");
+		return MBEDTLS_ERR_GCM_BAD_INPUT;
+	}
+
+	memset(&session->ctx, 0, sizeof(session->ctx));
+	session->ctx.key.bit_stream = ctx->key;
+	session->ctx.keylen = ctx->keylen;
+	session->ctx.flags = GCM_CAPS_REQUIRED |
+		((caps & CAP_SEPARATE_IO_BUFS) ? CAP_SEPARATE_IO_BUFS :
+						 CAP_INPLACE_OPS);
+	params->nonce_len = iv_len;
+	params->tag_len = tag_len;
+
+	ret = cipher_begin_session(crypto_dev, &session->ctx,
+				   CRYPTO_CIPHER_ALGO_AES,
+				   CRYPTO_CIPHER_MODE_GCM, op);
+	if (ret < 0) {
+		LOG_ERR("Cannot begin GCM session (%d)", ret);
+		return MBEDTLS_ERR_GCM_BAD_INPUT;
+	}
+
+	session->open = true;
+
+	return 0;
+}
+
+static int gcm_crypt(mbedtls_gcm_context *ctx, enum cipher_op op,
+		     size_t length, const unsigned char *iv, size_t iv_len,
+		     const unsigned char *add, size_t add_len,
+		     const unsigned char *input, unsigned char *output,
+		     size_t tag_len, unsigned char *tag)
+{
+	struct zephyr_gcm_session *session =
+		op == CRYPTO_CIPHER_OP_ENCRYPT ? &ctx->enc : &ctx->dec;
+	struct cipher_pkt pkt = { 0 };
+	struct cipher_aead_pkt aead = { 0 };
+	int ret;
+
+	if (length > INT_MAX || add_len > UINT32_MAX) {
+		return MBEDTLS_ERR_GCM_BAD_INPUT;
+	}
+
+	ret = gcm_session_get(ctx, session, op, iv_len, tag_len);
+	if (ret != 0) {
+		return ret;
+	}
+
+	if (session->ctx.flags & CAP_SEPARATE_IO_BUFS) {
+		pkt.in_buf = (uint8_t *)input;
+	} else {
+		/* The operation is done in place, on the output buffer */
+		if (output != input) {
+			memmove(output, input, length);
+		}
+
+		pkt.in_buf = output;
+	}
+
+	pkt.in_len = length;
+	pkt.out_buf = output;
+	pkt.out_buf_max = length;
+
+	aead.pkt = &pkt;
+	aead.ad = (uint8_t *)add;
+	aead.ad_len = add_len;
+	aead.tag = tag;
+
+	ret = cipher_gcm_op(&session->ctx, &aead, (uint8_t *)iv);
+	if (ret < 0) {
+		if (op == CRYPTO_CIPHER_OP_DECRYPT) {
+			/* Do not leak unauthenticated plaintext */
+			mbedtls_platform_zeroize(output, length);
+			return MBEDTLS_ERR_GCM_AUTH_FAILED;
+		}
+
+		return MBEDTLS_ERR_GCM_BAD_INPUT;
+	}
+
+	return 0;
+}
+
+void mbedtls_gcm_init(mbedtls_gcm_context *ctx)
+{
+	memset(ctx, 0, sizeof(*ctx));
+}
+
+int mbedtls_gcm_setkey(mbedtls_gcm_context *ctx, mbedtls_cipher_id_t cipher,
+		       const unsigned char *key, unsigned int keybits)
+{
+	if (cipher != MBEDTLS_CIPHER_ID_AES ||
+	    (keybits != 128U && keybits != 192U && keybits != 256U)) {
+		return MBEDTLS_ERR_GCM_BAD_INPUT;
+	}
+
+	gcm_session_close(&ctx->enc);
+	gcm_session_close(&ctx->dec);
+
+	memcpy(ctx->key, key, keybits / 8U);
+	ctx->keylen = keybits / 8U;
+
+	return 0;
+}
+
+int mbedtls_gcm_crypt_and_tag(mbedtls_gcm_context *ctx, int mode,
+			      size_t length, const unsigned char *iv,
+			      size_t iv_len, const unsigned char *add,
+			      size_t add_len, const unsigned char *input,
+			      unsigned char *output, size_t tag_len,
+			      unsigned char *tag)
+{
+	return gcm_crypt(ctx, mode == MBEDTLS_GCM_ENCRYPT ?
+			 CRYPTO_CIPHER_OP_ENCRYPT : CRYPTO_CIPHER_OP_DECRYPT,
+			 length, iv, iv_len, add, add_len, input, output,
+			 tag_len, tag);
+}
+
+int mbedtls_gcm_auth_decrypt(mbedtls_gcm_context *ctx, size_t length,
+			     const unsigned char *iv, size_t iv_len,
+			     const unsigned char *add, size_t add_len,
+			     const unsigned char *tag, size_t tag_len,
+			     const unsigned char *input, unsigned char *output)
+{
+	return gcm_crypt(ctx, CRYPTO_CIPHER_OP_DECRYPT, length, iv, iv_len,
+			 add, add_len, input, output, tag_len,
+			 (unsigned char *)tag);
+}
+
+int mbedtls_gcm_starts(mbedtls_gcm_context *ctx, int mode,
+		       const unsigned char *iv, size_t iv_len)
+{
+	ARG_UNUSED(ctx);
+	ARG_UNUSED(mode);
+	ARG_UNUSED(iv);
+	ARG_UNUSED(iv_len);
+
+	return MBEDTLS_ERR_GCM_BAD_INPUT;
+}
+
+int mbedtls_gcm_update_ad(mbedtls_gcm_context *ctx,
+			  const unsigned char *add, size_t add_len)
+{
+	ARG_UNUSED(ctx);
+	ARG_UNUSED(add);
+	ARG_UNUSED(add_len);
+
+	return MBEDTLS_ERR_GCM_BAD_INPUT;
+}
+
+int mbedtls_gcm_update(mbedtls_gcm_context *ctx,
+		       const unsigned char *input, size_t input_length,
+		       unsigned char *output, size_t output_size,
+		       size_t *output_length)
+{
+	ARG_UNUSED(ctx);
+	ARG_UNUSED(input);
+	ARG_UNUSED(input_length);
+	ARG_UNUSED(output);
+	ARG_UNUSED(output_size);
+	ARG_UNUSED(output_length);
+
+	return MBEDTLS_ERR_GCM_BAD_INPUT;
+}
+
+int mbedtls_gcm_finish(mbedtls_gcm_context *ctx,
+		       unsigned char *output, size_t output_size,
+		       size_t *output_length,
+		       unsigned char *tag, size_t tag_len)
+{
+	ARG_UNUSED(ctx);
+	ARG_UNUSED(output);
+	ARG_UNUSED(output_size);
+	ARG_UNUSED(output_length);
+	ARG_UNUSED(tag);
+	ARG_UNUSED(tag_len);
+
+	return MBEDTLS_ERR_GCM_BAD_INPUT;
+}
+
+void mbedtls_gcm_free(mbedtls_gcm_context *ctx)
+{
+	if (ctx == NULL) {
+		return;
+	}
+
+	gcm_session_close(&ctx->enc);
+	gcm_session_close(&ctx->dec);
+
+	mbedtls_platform_zeroize(ctx, sizeof(*ctx));
+}
@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_MODULES_MBEDTLS_GCM_ALT_H_
+#define ZEPHYR_MODULES_MBEDTLS_GCM_ALT_H_
+
+#include <stdbool.h>
+#include <zephyr/crypto/crypto.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Crypto driver session used for one direction */
+struct zephyr_gcm_session {
+	struct cipher_ctx ctx;
+	bool open;
+};
+
+/* GCM context implemented with the chosen crypto driver. The sessions are
+ * opened on first use, so that a context only encrypting or decrypting,
+ * like the ones of TLS records, takes a single driver session.
+ */
+typedef struct mbedtls_gcm_context {
+	uint8_t key[32];
+	uint16_t keylen;
+	struct zephyr_gcm_session enc;
+	struct zephyr_gcm_session dec;
+} mbedtls_gcm_context;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_MODULES_MBEDTLS_GCM_ALT_H_ */
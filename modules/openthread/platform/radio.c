@@ -378,12 +378,25 @@ static inline void handle_tx_done(otInstance *aInstance)
 static void openthread_handle_received_frame(otInstance *instance,
 					     struct net_pkt *pkt)
 {
+	static uint8_t rx_psdu[OT_RADIO_FRAME_MAX_SIZE];
 	otRadioFrame recv_frame;
 	memset(&recv_frame, 0, sizeof(otRadioFrame));
 
-	recv_frame.mPsdu = net_buf_frag_last(pkt->buffer)->data;
 	/* Length inc. CRC. */
 	recv_frame.mLength = net_buf_frags_len(pkt->buffer);
+
+	/*
+	 * The frame is handed to OpenThread in the driver's buffer, unless
+	 * the driver had to split it over several fragments.
+	 */
+	if (pkt->buffer->frags == NULL) {
+		recv_frame.mPsdu = pkt->buffer->data;
+	} else {
+		recv_frame.mLength = net_buf_linearize(rx_psdu, sizeof(rx_psdu),
+						       pkt->buffer, 0,
+						       recv_frame.mLength);
+		recv_frame.mPsdu = rx_psdu;
+	}
 	recv_frame.mChannel = platformRadioChannelGet(instance);
 	recv_frame.mInfo.mRxInfo.mLqi = net_pkt_ieee802154_lqi(pkt);
 	recv_frame.mInfo.mRxInfo.mRssi = net_pkt_ieee802154_rssi(pkt);
@@ -485,6 +498,20 @@ void platformRadioProcess(otInstance *aInstance)
 {
 	bool event_pending = false;
 
+	/*
+	 * Received frames hold buffers of the radio driver's RX pool, so they
+	 * are handed to OpenThread before IPv6 packets from the host are
+	 * converted, to keep the pool available for bursts.
+	 */
+	if (is_pending_event_set(PENDING_EVENT_FRAME_RECEIVED)) {
+		struct net_pkt *rx_pkt;
+
+		reset_pending_event(PENDING_EVENT_FRAME_RECEIVED);
+		while ((rx_pkt = (struct net_pkt *) k_fifo_get(&rx_pkt_fifo, K_NO_WAIT)) != NULL) {
+			openthread_handle_received_frame(aInstance, rx_pkt);
+		}
+	}
+
 	if (is_pending_event_set(PENDING_EVENT_FRAME_TO_SEND)) {
 		struct net_pkt *tx_pkt;
 
@@ -498,15 +525,6 @@ void platformRadioProcess(otInstance *aInstance)
 		}
 	}
 
-	if (is_pending_event_set(PENDING_EVENT_FRAME_RECEIVED)) {
-		struct net_pkt *rx_pkt;
-
-		reset_pending_event(PENDING_EVENT_FRAME_RECEIVED);
-		while ((rx_pkt = (struct net_pkt *) k_fifo_get(&rx_pkt_fifo, K_NO_WAIT)) != NULL) {
-			openthread_handle_received_frame(aInstance, rx_pkt);
-		}
-	}
-
 	if (is_pending_event_set(PENDING_EVENT_RX_FAILED)) {
 		reset_pending_event(PENDING_EVENT_RX_FAILED);
 		if (IS_ENABLED(CONFIG_OPENTHREAD_DIAG) && otPlatDiagModeGet()) {
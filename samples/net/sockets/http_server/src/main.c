@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_http_server_sample, LOG_LEVEL_DBG);
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/http_server.h>
+
+#define BIND_PORT 8080
+
+static const char hello[] = "Hello from Zephyr!\n";
+
+static struct http_server server;
+
+static int hello_handler(struct http_server_conn *conn,
+			 const struct http_server_req *req, void *user_data)
+{
+	ARG_UNUSED(req);
+	ARG_UNUSED(user_data);
+
+	return http_server_send_response(conn, 200, "text/plain", hello,
+					 sizeof(hello) - 1);
+}
+
+static int uptime_handler(struct http_server_conn *conn,
+			  const struct http_server_req *req, void *user_data)
+{
+	char buf[32];
+	int len;
+	int ret;
+
+	ARG_UNUSED(req);
+	ARG_UNUSED(user_data);
+
+	ret = http_server_send_chunked(conn, 200, "text/plain");
+	if (ret < 0) {
+		return ret;
+	}
+
+	len = snprintk(buf, sizeof(buf), "Uptime: %lld ms\n", k_uptime_get());
+
+	ret = http_server_send_chunk(conn, buf, len);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return http_server_send_chunk(conn, NULL, 0);
+}
+
+static const struct http_server_resource resources[] = {
+	{ .path = "/uptime", .handler = uptime_handler },
+	{ .path = "/", .handler = hello_handler },
+};
+
+void main(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(BIND_PORT),
+	};
+	int ret;
+
+	ret = http_server_init(&server, (struct sockaddr *)&addr, sizeof(addr),
+			       resources, ARRAY_SIZE(resources));
+	if (ret < 0) {
+		LOG_ERR("Cannot initialize the server (%d)", ret);
+		return;
+	}
+
+	LOG_INF("Serving on port %d", BIND_PORT);
+
+	ret = http_server_run(&server);
+	if (ret < 0) {
+		LOG_ERR("Server stopped (%d)", ret);
+	}
+}
@@ -20,6 +20,8 @@ LOG_ARCH_HDR_SIZE = struct.calcsize(LOG_ARCH_HDR_STRUCT)
 
 COREDUMP_MEM_HDR_ID = b'M'
 COREDUMP_MEM_HDR_VER = 1
+COREDUMP_MEM_HDR_VER_RLE = 2
+COREDUMP_RLE_MIN_RUN = 3
 LOG_MEM_HDR_STRUCT = "<cH"
 LOG_MEM_HDR_SIZE = struct.calcsize(LOG_MEM_HDR_STRUCT)
 
@@ -85,7 +87,7 @@ class CoredumpLogFile:
         hdr = self.fd.read(LOG_MEM_HDR_SIZE)
         _, hdr_ver = struct.unpack(LOG_MEM_HDR_STRUCT, hdr)
 
-        if hdr_ver != COREDUMP_MEM_HDR_VER:
+        if hdr_ver not in (COREDUMP_MEM_HDR_VER, COREDUMP_MEM_HDR_VER_RLE):
             logger.error(f"Memory block version: {hdr_ver}, expected {COREDUMP_MEM_HDR_VER}!")
             return False
 
@@ -103,7 +105,12 @@ class CoredumpLogFile:
 
         size = eaddr - saddr
 
-        data = self.fd.read(size)
+        if hdr_ver == COREDUMP_MEM_HDR_VER_RLE:
+            data = self.read_rle(size)
+            if data is None:
+                return False
+        else:
+            data = self.fd.read(size)
 
         mem = {"start": saddr, "end": eaddr, "data": data}
         self.memory_regions.append(mem)
@@ -113,6 +120,28 @@ class CoredumpLogFile:
 
         return True
 
+    def read_rle(self, size):
+        # Keep sync with rle_memory_output() in coredump_core.c
+        data = bytearray()
+
+        while len(data) < size:
+            ctrl = self.fd.read(1)
+            if not ctrl:
+                logger.error("Truncated compressed memory block")
+                return None
+
+            ctrl = ctrl[0]
+            if ctrl < 0x80:
+                data += self.fd.read(ctrl + 1)
+            else:
+                data += self.fd.read(1) * (ctrl - 0x80 + COREDUMP_RLE_MIN_RUN)
+
+        if len(data) != size:
+            logger.error("Compressed memory block does not match its size")
+            return None
+
+        return bytes(data)
+
     def parse(self):
         if self.fd is None:
             self.open()
@@ -0,0 +1,115 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2022 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: Apache-2.0
+"""
+Convert the output of the "profiler dump" shell command to folded stacks.
+
+Enable CONFIG_SAMPLING_PROFILER, then on the target run:
+
+    uart:~$ profiler start
+    uart:~$ profiler stop
+    uart:~$ profiler dump
+
+Save the console output to a file and resolve the samples against the ELF
+file of the application:
+
+    ./scripts/profiling/sampling_profiler.py -e build/zephyr/zephyr.elf \\
+        -i dump.txt > profile.folded
+
+Each output line is "thread;caller;function count" which can be rendered
+by flamegraph.pl or loaded into speedscope. The caller frame is derived
+from the sampled link register and is omitted when it resolves to the
+sampled function itself.
+"""
+
+import argparse
+import bisect
+import collections
+import re
+import sys
+
+from elftools.elf.elffile import ELFFile
+from elftools.elf.sections import SymbolTableSection
+
+THREAD_RE = re.compile(r"thread (0x[0-9a-fA-F]+) ?(.*)$")
+SAMPLE_RE = re.compile(r"sample (0x[0-9a-fA-F]+) (0x[0-9a-fA-F]+) (0x[0-9a-fA-F]+)")
+
+
+class Symbols:
+    def __init__(self, elf_path):
+        funcs = []
+        with open(elf_path, "rb") as f:
+            elf = ELFFile(f)
+            for section in elf.iter_sections():
+                if not isinstance(section, SymbolTableSection):
+                    continue
+                for sym in section.iter_symbols():
+                    if sym["st_info"]["type"] != "STT_FUNC":
+                        continue
+                    # Clear the Thumb bit.
+                    addr = sym["st_value"] & ~1
+                    funcs.append((addr, max(sym["st_size"], 1), sym.name))
+        funcs.sort()
+        self.addrs = [func[0] for func in funcs]
+        self.funcs = funcs
+
+    def lookup(self, addr):
+        addr &= ~1
+        i = bisect.bisect_right(self.addrs, addr) - 1
+        if i >= 0:
+            start, size, name = self.funcs[i]
+            if addr < start + size:
+                return name
+        return f"0x{addr:x}"
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("-e", "--elf", required=True,
+                        help="ELF file of the profiled application")
+    parser.add_argument("-i", "--input", default="-",
+                        help="profiler dump output (default: stdin)")
+    return parser.parse_args()
+
+
+def main():
+    args = parse_args()
+    symbols = Symbols(args.elf)
+    threads = {}
+    stacks = collections.Counter()
+
+    f = sys.stdin if args.input == "-" else open(args.input, "r")
+    for line in f:
+        m = SAMPLE_RE.search(line)
+        if m:
+            thread = int(m.group(1), 16)
+            pc = int(m.group(2), 16)
+            lr = int(m.group(3), 16)
+            stack = [threads.get(thread) or f"thread_0x{thread:x}"]
+            if pc:
+                func = symbols.lookup(pc)
+                caller = symbols.lookup(lr) if lr else None
+                if caller and caller != func:
+                    stack.append(caller)
+                stack.append(func)
+            stacks[";".join(stack)] += 1
+            continue
+
+        m = THREAD_RE.search(line)
+        if m:
+            name = m.group(2).strip()
+            threads[int(m.group(1), 16)] = name or None
+
+    if f is not sys.stdin:
+        f.close()
+
+    for stack, count in sorted(stacks.items()):
+        print(f"{stack} {count}")
+
+
+if __name__ == "__main__":
+    main()
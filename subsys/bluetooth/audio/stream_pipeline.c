@@ -0,0 +1,316 @@
+/*  Bluetooth Audio Stream pipeline */
+
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/sys/check.h>
+
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/iso.h>
+#include <zephyr/bluetooth/audio/audio.h>
+
+#define BT_DBG_ENABLED IS_ENABLED(CONFIG_BT_AUDIO_DEBUG_STREAM)
+#define LOG_MODULE_NAME bt_audio_pipeline
+#include "common/log.h"
+
+K_THREAD_STACK_DEFINE(pipeline_stack_area,
+		      CONFIG_BT_AUDIO_STREAM_PIPELINE_STACK_SIZE);
+static struct k_work_q pipeline_wq;
+
+static void encode_stats_update(struct bt_audio_pipeline *pipeline,
+				uint32_t start)
+{
+	uint32_t us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+
+	pipeline->stats.encode_us_last = us;
+	pipeline->stats.encode_us_max = MAX(pipeline->stats.encode_us_max, us);
+}
+
+static void pipeline_send(struct bt_audio_pipeline *pipeline,
+			  struct net_buf *buf, uint32_t seq_num)
+{
+	k_spinlock_key_t key;
+	int err;
+
+	/* The host has no reference to the controller clock, so the SDUs are
+	 * queued in order and the controller assigns them to the next free
+	 * SDU interval.
+	 */
+	err = bt_audio_stream_send(pipeline->stream, buf, seq_num,
+				   BT_ISO_TIMESTAMP_NONE);
+
+	key = k_spin_lock(&pipeline->lock);
+	if (err < 0) {
+		BT_DBG("pipeline %p seq_num %u send failed (err %d)",
+		       pipeline, seq_num, err);
+		pipeline->stats.dropped++;
+	} else {
+		pipeline->stats.sent++;
+	}
+	k_spin_unlock(&pipeline->lock, key);
+
+	if (err < 0) {
+		net_buf_unref(buf);
+	}
+}
+
+static void pipeline_encode(struct bt_audio_pipeline *pipeline,
+			    uint32_t seq_num)
+{
+	k_spinlock_key_t key;
+	struct net_buf *buf;
+	uint32_t start;
+	uint32_t ts;
+	int err;
+
+	buf = net_buf_alloc(pipeline->pool, K_NO_WAIT);
+	if (buf == NULL) {
+		BT_DBG("pipeline %p no buffer for seq_num %u", pipeline,
+		       seq_num);
+
+		key = k_spin_lock(&pipeline->lock);
+		pipeline->stats.dropped++;
+		k_spin_unlock(&pipeline->lock, key);
+		return;
+	}
+
+	net_buf_reserve(buf, BT_ISO_CHAN_SEND_RESERVE);
+
+	start = k_cycle_get_32();
+	ts = seq_num * pipeline->interval_us;
+
+	/* The frame is marked as pending before calling the encoder, as an
+	 * offloaded encoder may complete it before the callback returns.
+	 */
+	key = k_spin_lock(&pipeline->lock);
+	pipeline->pending = buf;
+	pipeline->pending_seq_num = seq_num;
+	pipeline->pending_start = start;
+	pipeline->pending_late = false;
+	k_spin_unlock(&pipeline->lock, key);
+
+	err = pipeline->ops->encode(pipeline, buf, seq_num, ts);
+	if (err == -EINPROGRESS) {
+		return;
+	}
+
+	key = k_spin_lock(&pipeline->lock);
+	if (pipeline->pending != buf) {
+		/* Completed by bt_audio_pipeline_frame_done() */
+		k_spin_unlock(&pipeline->lock, key);
+		return;
+	}
+
+	pipeline->pending = NULL;
+
+	if (err == 0 && pipeline->running) {
+		encode_stats_update(pipeline, start);
+		pipeline->ready = buf;
+		pipeline->ready_seq_num = seq_num;
+		buf = NULL;
+	} else if (err != 0) {
+		BT_DBG("pipeline %p seq_num %u encode failed (err %d)",
+		       pipeline, seq_num, err);
+		pipeline->stats.dropped++;
+	}
+	k_spin_unlock(&pipeline->lock, key);
+
+	if (buf != NULL) {
+		net_buf_unref(buf);
+	}
+}
+
+static void pipeline_work_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct bt_audio_pipeline *pipeline;
+	k_spinlock_key_t key;
+	struct net_buf *buf;
+	uint32_t send_seq_num;
+	uint32_t seq_num;
+	bool can_encode;
+	int64_t now;
+
+	pipeline = CONTAINER_OF(dwork, struct bt_audio_pipeline, work);
+
+	key = k_spin_lock(&pipeline->lock);
+	if (!pipeline->running) {
+		k_spin_unlock(&pipeline->lock, key);
+		return;
+	}
+
+	now = k_uptime_ticks();
+	if (now > pipeline->deadline) {
+		uint32_t us = k_ticks_to_us_floor32(now - pipeline->deadline);
+
+		pipeline->stats.sched_us_max = MAX(pipeline->stats.sched_us_max,
+						   us);
+	}
+
+	/* Deadlines are kept absolute so that scheduling jitter does not
+	 * accumulate into drift relative to the SDU interval.
+	 */
+	pipeline->deadline += k_us_to_ticks_ceil64(pipeline->interval_us);
+	(void)k_work_reschedule_for_queue(&pipeline_wq, dwork,
+					  K_TICKS(MAX(pipeline->deadline - now,
+						      0)));
+
+	buf = pipeline->ready;
+	send_seq_num = pipeline->ready_seq_num;
+	pipeline->ready = NULL;
+
+	/* A frame still being encoded has missed its SDU interval. It is
+	 * dropped once completed, and no new frame is started until then.
+	 */
+	can_encode = pipeline->pending == NULL;
+	if (!can_encode && !pipeline->pending_late) {
+		pipeline->pending_late = true;
+		pipeline->stats.late++;
+	}
+
+	/* The sequence number shall be incremented every SDU interval, even
+	 * when no SDU is sent.
+	 */
+	seq_num = pipeline->seq_num++;
+	k_spin_unlock(&pipeline->lock, key);
+
+	if (buf != NULL) {
+		pipeline_send(pipeline, buf, send_seq_num);
+	}
+
+	if (can_encode) {
+		pipeline_encode(pipeline, seq_num);
+	}
+}
+
+int bt_audio_pipeline_start(struct bt_audio_pipeline *pipeline,
+			    struct bt_audio_stream *stream,
+			    const struct bt_audio_pipeline_ops *ops,
+			    struct net_buf_pool *pool)
+{
+	CHECKIF(pipeline == NULL || stream == NULL || ops == NULL ||
+		ops->encode == NULL || pool == NULL) {
+		BT_DBG("Invalid parameters");
+		return -EINVAL;
+	}
+
+	if (stream->ep == NULL || stream->qos == NULL ||
+	    stream->qos->interval == 0U) {
+		BT_DBG("stream %p not configured", stream);
+		return -EINVAL;
+	}
+
+	if (pipeline->running) {
+		return -EALREADY;
+	}
+
+	BT_DBG("pipeline %p stream %p interval %u us", pipeline, stream,
+	       stream->qos->interval);
+
+	pipeline->stream = stream;
+	pipeline->ops = ops;
+	pipeline->pool = pool;
+	pipeline->ready = NULL;
+	pipeline->pending = NULL;
+	pipeline->interval_us = stream->qos->interval;
+	pipeline->seq_num = 0U;
+	pipeline->stats = (struct bt_audio_pipeline_stats){ 0 };
+	pipeline->deadline = k_uptime_ticks();
+	pipeline->running = true;
+
+	k_work_init_delayable(&pipeline->work, pipeline_work_handler);
+
+	return k_work_schedule_for_queue(&pipeline_wq, &pipeline->work,
+					 K_NO_WAIT) < 0 ? -EIO : 0;
+}
+
+int bt_audio_pipeline_stop(struct bt_audio_pipeline *pipeline)
+{
+	k_spinlock_key_t key;
+	struct net_buf *buf;
+
+	CHECKIF(pipeline == NULL) {
+		BT_DBG("pipeline is NULL");
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&pipeline->lock);
+	if (!pipeline->running) {
+		k_spin_unlock(&pipeline->lock, key);
+		return -EALREADY;
+	}
+
+	pipeline->running = false;
+	buf = pipeline->ready;
+	pipeline->ready = NULL;
+	k_spin_unlock(&pipeline->lock, key);
+
+	(void)k_work_cancel_delayable(&pipeline->work);
+
+	if (buf != NULL) {
+		net_buf_unref(buf);
+	}
+
+	return 0;
+}
+
+void bt_audio_pipeline_frame_done(struct bt_audio_pipeline *pipeline, int err)
+{
+	k_spinlock_key_t key;
+	struct net_buf *buf;
+
+	key = k_spin_lock(&pipeline->lock);
+	buf = pipeline->pending;
+	if (buf == NULL) {
+		k_spin_unlock(&pipeline->lock, key);
+		return;
+	}
+
+	pipeline->pending = NULL;
+
+	if (err != 0) {
+		pipeline->stats.dropped++;
+	} else if (pipeline->running && !pipeline->pending_late) {
+		encode_stats_update(pipeline, pipeline->pending_start);
+		pipeline->ready = buf;
+		pipeline->ready_seq_num = pipeline->pending_seq_num;
+		buf = NULL;
+	}
+	k_spin_unlock(&pipeline->lock, key);
+
+	if (buf != NULL) {
+		net_buf_unref(buf);
+	}
+}
+
+void bt_audio_pipeline_stats_get(struct bt_audio_pipeline *pipeline,
+				 struct bt_audio_pipeline_stats *stats)
+{
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&pipeline->lock);
+	*stats = pipeline->stats;
+	k_spin_unlock(&pipeline->lock, key);
+}
+
+static int pipeline_wq_init(const struct device *d)
+{
+	ARG_UNUSED(d);
+
+	const struct k_work_queue_config cfg = {.name = "BT_AUDIO_PIPE"};
+
+	k_work_queue_init(&pipeline_wq);
+
+	k_work_queue_start(&pipeline_wq, pipeline_stack_area,
+			   K_THREAD_STACK_SIZEOF(pipeline_stack_area),
+			   CONFIG_BT_AUDIO_STREAM_PIPELINE_PRIO, &cfg);
+
+	return 0;
+}
+
+SYS_INIT(pipeline_wq_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
@@ -2392,6 +2392,12 @@ static void rx_demux(void *param)
 {
 	memq_link_t *link;
 
+#if defined(CONFIG_BT_TICKER_JOB_BATCH)
+	/* Process the ticker operations of all demuxed events in one job */
+	ticker_job_batch_begin(TICKER_INSTANCE_ID_CTLR,
+			       TICKER_USER_ID_ULL_HIGH);
+#endif /* CONFIG_BT_TICKER_JOB_BATCH */
+
 #if !defined(CONFIG_BT_CTLR_LOW_LAT_ULL)
 	do {
 #endif /* CONFIG_BT_CTLR_LOW_LAT_ULL */
@@ -2453,6 +2459,10 @@ static void rx_demux(void *param)
 #if !defined(CONFIG_BT_CTLR_LOW_LAT_ULL)
 	} while (link);
 #endif /* CONFIG_BT_CTLR_LOW_LAT_ULL */
+
+#if defined(CONFIG_BT_TICKER_JOB_BATCH)
+	ticker_job_batch_end(TICKER_INSTANCE_ID_CTLR, TICKER_USER_ID_ULL_HIGH);
+#endif /* CONFIG_BT_TICKER_JOB_BATCH */
 }
 
 #if defined(CONFIG_BT_CTLR_LOW_LAT_ULL)
@@ -268,6 +268,17 @@ struct ticker_instance {
 					 * ticker_worker at end of job, if
 					 * requested
 					 */
+#if defined(CONFIG_BT_TICKER_JOB_BATCH)
+	uint8_t  job_batch;		/* Bitmask of users batching their
+					 * operations, for which ticker_job
+					 * is not scheduled per operation
+					 */
+#endif /* CONFIG_BT_TICKER_JOB_BATCH */
+#if defined(CONFIG_BT_TICKER_JOB_STATS)
+	struct ticker_job_stats job_stats; /* ticker_job execution
+					    * statistics
+					    */
+#endif /* CONFIG_BT_TICKER_JOB_STATS */
 
 	ticker_caller_id_get_cb_t caller_id_get_cb; /* Function for retrieving
 						     * the caller id from user
@@ -2436,6 +2447,41 @@ static inline void ticker_job_compare_update(struct ticker_instance *instance,
 		  ticker_ticks_diff_get(cc, ctr));
 }
 
+/**
+ * @brief Schedule ticker job for a user operation
+ *
+ * @details Schedules the ticker_job to process a user operation just queued,
+ * unless the user is batching its operations and has free user operation
+ * slots left.
+ *
+ * @param instance Pointer to ticker instance
+ * @param user_id  Ticker user id of the queued operation
+ *
+ * @internal
+ */
+static void ticker_job_op_sched(struct ticker_instance *instance,
+				uint8_t user_id)
+{
+#if defined(CONFIG_BT_TICKER_JOB_BATCH)
+	if (instance->job_batch & BIT(user_id)) {
+		struct ticker_user *user = &instance->users[user_id];
+		uint8_t last;
+
+		last = user->last + 1;
+		if (last >= user->count_user_op) {
+			last = 0U;
+		}
+
+		if (last != user->first) {
+			return;
+		}
+	}
+#endif /* CONFIG_BT_TICKER_JOB_BATCH */
+
+	instance->sched_cb(instance->caller_id_get_cb(user_id),
+			   TICKER_CALL_ID_JOB, 0, instance);
+}
+
 /**
  * @brief Ticker job
  *
@@ -2460,6 +2506,10 @@ void ticker_job(void *param)
 	uint8_t flag_elapsed;
 	uint8_t pending;
 	uint8_t flag_compare_update;
+#if defined(CONFIG_BT_TICKER_JOB_STATS)
+	uint32_t ticks_job_start;
+	uint32_t ticks_job;
+#endif /* CONFIG_BT_TICKER_JOB_STATS */
 
 	DEBUG_TICKER_JOB(1);
 
@@ -2477,6 +2527,10 @@ void ticker_job(void *param)
 	}
 	instance->job_guard = 1U;
 
+#if defined(CONFIG_BT_TICKER_JOB_STATS)
+	ticks_job_start = cntr_cnt_get();
+#endif /* CONFIG_BT_TICKER_JOB_STATS */
+
 	/* Back up the previous known tick */
 	ticks_previous = instance->ticks_current;
 
@@ -2556,6 +2610,16 @@ void ticker_job(void *param)
 		ticker_job_compare_update(instance, ticker_id_old_head);
 	}
 
+#if defined(CONFIG_BT_TICKER_JOB_STATS)
+	ticks_job = ticker_ticks_diff_get(cntr_cnt_get(), ticks_job_start);
+	instance->job_stats.count++;
+	instance->job_stats.ticks_last = ticks_job;
+	instance->job_stats.ticks_total += ticks_job;
+	if (ticks_job > instance->job_stats.ticks_max) {
+		instance->job_stats.ticks_max = ticks_job;
+	}
+#endif /* CONFIG_BT_TICKER_JOB_STATS */
+
 	/* Permit worker to run */
 	instance->job_guard = 0U;
 
@@ -2786,8 +2850,7 @@ uint32_t ticker_start(uint8_t instance_index, uint8_t user_id, uint8_t ticker_id
 
 	user->last = last;
 
-	instance->sched_cb(instance->caller_id_get_cb(user_id),
-			   TICKER_CALL_ID_JOB, 0, instance);
+	ticker_job_op_sched(instance, user_id);
 
 	return user_op->status;
 }
@@ -2883,8 +2946,7 @@ uint32_t ticker_update_ext(uint8_t instance_index, uint8_t user_id,
 
 	user->last = last;
 
-	instance->sched_cb(instance->caller_id_get_cb(user_id),
-			   TICKER_CALL_ID_JOB, 0, instance);
+	ticker_job_op_sched(instance, user_id);
 
 	return user_op->status;
 }
@@ -2938,8 +3000,7 @@ uint32_t ticker_yield_abs(uint8_t instance_index, uint8_t user_id,
 
 	user->last = last;
 
-	instance->sched_cb(instance->caller_id_get_cb(user_id),
-			   TICKER_CALL_ID_JOB, 0, instance);
+	ticker_job_op_sched(instance, user_id);
 
 	return user_op->status;
 }
@@ -2990,8 +3051,7 @@ uint32_t ticker_stop(uint8_t instance_index, uint8_t user_id, uint8_t ticker_id,
 
 	user->last = last;
 
-	instance->sched_cb(instance->caller_id_get_cb(user_id),
-			   TICKER_CALL_ID_JOB, 0, instance);
+	ticker_job_op_sched(instance, user_id);
 
 	return user_op->status;
 }
@@ -3045,8 +3105,7 @@ uint32_t ticker_stop_abs(uint8_t instance_index, uint8_t user_id,
 
 	user->last = last;
 
-	instance->sched_cb(instance->caller_id_get_cb(user_id),
-			   TICKER_CALL_ID_JOB, 0, instance);
+	ticker_job_op_sched(instance, user_id);
 
 	return user_op->status;
 }
@@ -3138,8 +3197,7 @@ uint32_t ticker_next_slot_get_ext(uint8_t instance_index, uint8_t user_id,
 
 	user->last = last;
 
-	instance->sched_cb(instance->caller_id_get_cb(user_id),
-			   TICKER_CALL_ID_JOB, 0, instance);
+	ticker_job_op_sched(instance, user_id);
 
 	return user_op->status;
 }
@@ -3190,8 +3248,7 @@ uint32_t ticker_job_idle_get(uint8_t instance_index, uint8_t user_id,
 
 	user->last = last;
 
-	instance->sched_cb(instance->caller_id_get_cb(user_id),
-			   TICKER_CALL_ID_JOB, 0, instance);
+	ticker_job_op_sched(instance, user_id);
 
 	return user_op->status;
 }
@@ -3249,8 +3306,7 @@ uint32_t ticker_priority_set(uint8_t instance_index, uint8_t user_id, uint8_t ti
 
 	user->last = last;
 
-	instance->sched_cb(instance->caller_id_get_cb(user_id),
-			   TICKER_CALL_ID_JOB, 0, instance);
+	ticker_job_op_sched(instance, user_id);
 
 	return user_op->status;
 }
@@ -3272,6 +3328,72 @@ void ticker_job_sched(uint8_t instance_index, uint8_t user_id)
 			   TICKER_CALL_ID_JOB, 0, instance);
 }
 
+#if defined(CONFIG_BT_TICKER_JOB_BATCH)
+/**
+ * @brief Begin batching of user operations
+ *
+ * @details User operations requested until ticker_job_batch_end is called
+ * do not schedule the ticker_job, unless the user operation queue of the user
+ * fills up. Shall be called from the execution context of the user.
+ *
+ * @param instance_index Index of ticker instance
+ * @param user_id	 Ticker user id
+ */
+void ticker_job_batch_begin(uint8_t instance_index, uint8_t user_id)
+{
+	struct ticker_instance *instance = &_instance[instance_index];
+
+	LL_ASSERT(user_id < 8U);
+
+	instance->job_batch |= BIT(user_id);
+}
+
+/**
+ * @brief End batching of user operations
+ *
+ * @details Schedules the ticker_job to process the user operations requested
+ * since ticker_job_batch_begin was called.
+ *
+ * @param instance_index Index of ticker instance
+ * @param user_id	 Ticker user id
+ */
+void ticker_job_batch_end(uint8_t instance_index, uint8_t user_id)
+{
+	struct ticker_instance *instance = &_instance[instance_index];
+	struct ticker_user *user = &instance->users[user_id];
+
+	instance->job_batch &= ~BIT(user_id);
+
+	if (user->first != user->last) {
+		ticker_job_op_sched(instance, user_id);
+	}
+}
+#endif /* CONFIG_BT_TICKER_JOB_BATCH */
+
+#if defined(CONFIG_BT_TICKER_JOB_STATS)
+/**
+ * @brief Get ticker job execution statistics
+ *
+ * @param instance_index Index of ticker instance
+ * @param stats		 Pointer to statistics to be filled in
+ */
+void ticker_job_stats_get(uint8_t instance_index,
+			  struct ticker_job_stats *stats)
+{
+	*stats = _instance[instance_index].job_stats;
+}
+
+/**
+ * @brief Reset ticker job execution statistics
+ *
+ * @param instance_index Index of ticker instance
+ */
+void ticker_job_stats_reset(uint8_t instance_index)
+{
+	_instance[instance_index].job_stats = (struct ticker_job_stats){ 0 };
+}
+#endif /* CONFIG_BT_TICKER_JOB_STATS */
+
 /**
  * @brief Get current absolute tick count
  *
@@ -168,6 +168,26 @@ void ticker_job_sched(uint8_t instance_index, uint8_t user_id);
 uint32_t ticker_ticks_now_get(void);
 uint32_t ticker_ticks_diff_get(uint32_t ticks_now, uint32_t ticks_old);
 
+#if defined(CONFIG_BT_TICKER_JOB_BATCH)
+void ticker_job_batch_begin(uint8_t instance_index, uint8_t user_id);
+void ticker_job_batch_end(uint8_t instance_index, uint8_t user_id);
+#endif /* CONFIG_BT_TICKER_JOB_BATCH */
+
+#if defined(CONFIG_BT_TICKER_JOB_STATS)
+/** \brief Timer job execution statistics.
+ */
+struct ticker_job_stats {
+	uint32_t count;       /* Number of ticker_job executions */
+	uint32_t ticks_last;  /* Duration of the last execution */
+	uint32_t ticks_max;   /* Longest execution duration */
+	uint32_t ticks_total; /* Accumulated execution duration */
+};
+
+void ticker_job_stats_get(uint8_t instance_index,
+			  struct ticker_job_stats *stats);
+void ticker_job_stats_reset(uint8_t instance_index);
+#endif /* CONFIG_BT_TICKER_JOB_STATS */
+
 #if !defined(CONFIG_BT_TICKER_LOW_LAT) && \
 	!defined(CONFIG_BT_TICKER_SLOT_AGNOSTIC)
 uint32_t ticker_priority_set(uint8_t instance_index, uint8_t user_id,
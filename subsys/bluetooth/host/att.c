@@ -301,8 +301,12 @@ static struct net_buf *get_first_buf_matching_chan(struct k_fifo *fifo, struct b
 		k_fifo_init(&skipped);
 
 		while ((buf = net_buf_get(fifo, K_NO_WAIT))) {
+			/* Leave the PDUs that exceed the MTU of the channel to
+			 * the bearers that can carry them.
+			 */
 			if (!ret &&
-			    att_chan_matches_chan_opt(chan, bt_att_tx_meta_data(buf)->chan_opt)) {
+			    att_chan_matches_chan_opt(chan, bt_att_tx_meta_data(buf)->chan_opt) &&
+			    buf->len <= chan->chan.tx.mtu) {
 				ret = buf;
 			} else {
 				net_buf_put(&skipped, buf);
@@ -664,23 +668,26 @@ static void att_send_process(struct bt_att *att)
 	struct bt_att_chan *chan, *tmp, *prev = NULL;
 	int err = 0;
 
+	/* Offer the queue to every channel, so that queued PDUs are sent in
+	 * parallel on all the Enhanced ATT bearers that are free.
+	 */
 	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&att->chans, chan, tmp, node) {
+		if (k_fifo_is_empty(&att->tx_queue)) {
+			return;
+		}
+
 		if (err == -ENOENT && prev &&
 		    (atomic_test_bit(chan->flags, ATT_ENHANCED) ==
-		     atomic_test_bit(prev->flags, ATT_ENHANCED))) {
+		     atomic_test_bit(prev->flags, ATT_ENHANCED)) &&
+		    chan->chan.tx.mtu <= prev->chan.tx.mtu) {
 			/* If there was nothing to send for the previous channel and the current
-			 * channel has the same "enhancedness", there will be nothing to send for
-			 * this channel either.
+			 * channel has the same "enhancedness" and no larger MTU, there will be
+			 * nothing to send for this channel either.
 			 */
 			continue;
 		}
 
 		err = process_queue(chan, &att->tx_queue);
-		if (!err) {
-			/* Success */
-			return;
-		}
-
 		prev = chan;
 	}
 }
@@ -497,8 +497,11 @@ static int send_iso(struct bt_conn *conn, struct net_buf *buf, uint8_t flags)
 	return bt_send(buf);
 }
 
-static bool send_frag(struct bt_conn *conn, struct net_buf *buf, uint8_t flags,
-		      bool always_consume)
+/* Send a packet to the controller, for which a controller buffer has been
+ * taken already. The controller buffer is given back if sending fails.
+ */
+static bool conn_send_frag(struct bt_conn *conn, struct net_buf *buf,
+			   uint8_t flags, bool always_consume)
 {
 	struct bt_conn_tx *tx = tx_data(buf)->tx;
 	uint32_t *pending_no_cb;
@@ -508,9 +511,6 @@ static bool send_frag(struct bt_conn *conn, struct net_buf *buf, uint8_t flags,
 	BT_DBG("conn %p buf %p len %u flags 0x%02x", conn, buf, buf->len,
 	       flags);
 
-	/* Wait until the controller can accept ACL packets */
-	k_sem_take(bt_conn_get_pkts(conn), K_FOREVER);
-
 	/* Check for disconnection while waiting for pkts_sem */
 	if (conn->state != BT_CONN_CONNECTED) {
 		goto fail;
@@ -556,6 +556,10 @@ static bool send_frag(struct bt_conn *conn, struct net_buf *buf, uint8_t flags,
 		goto fail;
 	}
 
+#if defined(CONFIG_BT_CONN_TX_SCHED)
+	atomic_inc(&conn->tx_sched_inflight);
+#endif /* CONFIG_BT_CONN_TX_SCHED */
+
 	return true;
 
 fail:
@@ -574,6 +578,15 @@ fail:
 	return false;
 }
 
+static bool send_frag(struct bt_conn *conn, struct net_buf *buf, uint8_t flags,
+		      bool always_consume)
+{
+	/* Wait until the controller can accept ACL packets */
+	k_sem_take(bt_conn_get_pkts(conn), K_FOREVER);
+
+	return conn_send_frag(conn, buf, flags, always_consume);
+}
+
 static inline uint16_t conn_mtu(struct bt_conn *conn)
 {
 #if defined(CONFIG_BT_BREDR)
@@ -593,6 +606,29 @@ static inline uint16_t conn_mtu(struct bt_conn *conn)
 #endif /* CONFIG_BT_CONN */
 }
 
+/* Remove len bytes from the front of a buffer chain, releasing the emptied
+ * fragments but keeping the head buffer.
+ */
+static void pull_chain(struct net_buf *buf, size_t len)
+{
+	size_t pull_len = MIN(len, buf->len);
+
+	net_buf_pull(buf, pull_len);
+	len -= pull_len;
+
+	while (buf->frags && (len || !buf->frags->len)) {
+		struct net_buf *frag = buf->frags;
+
+		pull_len = MIN(len, frag->len);
+		net_buf_pull(frag, pull_len);
+		len -= pull_len;
+
+		if (!frag->len) {
+			net_buf_frag_del(buf, frag);
+		}
+	}
+}
+
 static struct net_buf *create_frag(struct bt_conn *conn, struct net_buf *buf)
 {
 	struct net_buf *frag;
@@ -623,12 +659,48 @@ static struct net_buf *create_frag(struct bt_conn *conn, struct net_buf *buf)
 
 	frag_len = MIN(conn_mtu(conn), net_buf_tailroom(frag));
 
+	if (buf->frags) {
+		frag_len = net_buf_linearize(net_buf_tail(frag), frag_len, buf,
+					     0, frag_len);
+		net_buf_add(frag, frag_len);
+		pull_chain(buf, frag_len);
+		return frag;
+	}
+
 	net_buf_add_mem(frag, buf->data, frag_len);
 	net_buf_pull(buf, frag_len);
 
 	return frag;
 }
 
+/* Send what is left of a packet chained over several buffers, for which a
+ * controller buffer has been taken already. The controller needs contiguous
+ * data, so it is copied into a fragment that takes over the TX context of the
+ * packet.
+ */
+static bool send_chain_end(struct bt_conn *conn, struct net_buf *buf,
+			   uint8_t flags)
+{
+	struct net_buf *frag;
+
+	frag = create_frag(conn, buf);
+	if (!frag) {
+		k_sem_give(bt_conn_get_pkts(conn));
+		return false;
+	}
+
+	tx_data(frag)->tx = tx_data(buf)->tx;
+	tx_data(buf)->tx = NULL;
+
+	if (!conn_send_frag(conn, frag, flags, true)) {
+		return false;
+	}
+
+	net_buf_unref(buf);
+
+	return true;
+}
+
 static bool send_buf(struct bt_conn *conn, struct net_buf *buf)
 {
 	struct net_buf *frag;
@@ -636,10 +708,15 @@ static bool send_buf(struct bt_conn *conn, struct net_buf *buf)
 	BT_DBG("conn %p buf %p len %u", conn, buf, buf->len);
 
 	/* Send directly if the packet fits the ACL MTU */
-	if (buf->len <= conn_mtu(conn)) {
+	if (buf->len <= conn_mtu(conn) && !buf->frags) {
 		return send_frag(conn, buf, FRAG_SINGLE, false);
 	}
 
+	if (net_buf_frags_len(buf) <= conn_mtu(conn)) {
+		k_sem_take(bt_conn_get_pkts(conn), K_FOREVER);
+		return send_chain_end(conn, buf, FRAG_SINGLE);
+	}
+
 	/* Create & enqueue first fragment */
 	frag = create_frag(conn, buf);
 	if (!frag) {
@@ -654,7 +731,7 @@ static bool send_buf(struct bt_conn *conn, struct net_buf *buf)
 	 * Send the fragments. For the last one simply use the original
 	 * buffer (which works since we've used net_buf_pull on it.
 	 */
-	while (buf->len > conn_mtu(conn)) {
+	while (net_buf_frags_len(buf) > conn_mtu(conn)) {
 		frag = create_frag(conn, buf);
 		if (!frag) {
 			return false;
@@ -665,29 +742,46 @@ static bool send_buf(struct bt_conn *conn, struct net_buf *buf)
 		}
 	}
 
+	if (buf->frags) {
+		k_sem_take(bt_conn_get_pkts(conn), K_FOREVER);
+		return send_chain_end(conn, buf, FRAG_END);
+	}
+
 	return send_frag(conn, buf, FRAG_END, false);
 }
 
 static struct k_poll_signal conn_change =
 		K_POLL_SIGNAL_INITIALIZER(conn_change);
 
+static void tx_buf_destroy(struct bt_conn *conn, struct net_buf *buf)
+{
+	struct bt_conn_tx *tx = tx_data(buf)->tx;
+
+	tx_data(buf)->tx = NULL;
+
+	/* destroy the buffer */
+	net_buf_unref(buf);
+
+	/* destroy the tx context (and any associated meta-data) */
+	if (tx) {
+		conn_tx_destroy(conn, tx);
+	}
+}
+
 static void conn_cleanup(struct bt_conn *conn)
 {
 	struct net_buf *buf;
 
+#if defined(CONFIG_BT_CONN_TX_SCHED)
+	if (conn->tx_sched_buf) {
+		tx_buf_destroy(conn, conn->tx_sched_buf);
+		conn->tx_sched_buf = NULL;
+	}
+#endif /* CONFIG_BT_CONN_TX_SCHED */
+
 	/* Give back any allocated buffers */
 	while ((buf = net_buf_get(&conn->tx_queue, K_NO_WAIT))) {
-		struct bt_conn_tx *tx = tx_data(buf)->tx;
-
-		tx_data(buf)->tx = NULL;
-
-		/* destroy the buffer */
-		net_buf_unref(buf);
-
-		/* destroy the tx context (and any associated meta-data) */
-		if (tx) {
-			conn_tx_destroy(conn, tx);
-		}
+		tx_buf_destroy(conn, buf);
 	}
 
 	__ASSERT(sys_slist_is_empty(&conn->tx_pending), "Pending TX packets");
@@ -698,6 +792,238 @@ static void conn_cleanup(struct bt_conn *conn)
 	k_work_reschedule(&conn->deferred_work, K_NO_WAIT);
 }
 
+#if defined(CONFIG_BT_CONN_TX_SCHED)
+#if defined(CONFIG_BT_ISO)
+#define TX_SCHED_CONNS (ARRAY_SIZE(acl_conns) + ARRAY_SIZE(iso_conns))
+#else
+#define TX_SCHED_CONNS ARRAY_SIZE(acl_conns)
+#endif /* CONFIG_BT_ISO */
+
+/* Connection whose turn it is, and whether it got its quantum already */
+static uint8_t tx_sched_cur;
+static bool tx_sched_granted;
+
+static struct bt_conn *tx_sched_conn(uint8_t index)
+{
+#if defined(CONFIG_BT_ISO)
+	if (index >= ARRAY_SIZE(acl_conns)) {
+		return &iso_conns[index - ARRAY_SIZE(acl_conns)];
+	}
+#endif /* CONFIG_BT_ISO */
+
+	return &acl_conns[index];
+}
+
+static bool tx_sched_backlogged(struct bt_conn *conn)
+{
+	return conn->tx_sched_buf || !k_fifo_is_empty(&conn->tx_queue);
+}
+
+static bool tx_sched_held(struct bt_conn *conn)
+{
+	return CONFIG_BT_CONN_TX_SCHED_MAX_INFLIGHT > 0 &&
+	       atomic_get(&conn->tx_sched_inflight) >=
+	       CONFIG_BT_CONN_TX_SCHED_MAX_INFLIGHT;
+}
+
+static bool tx_sched_ready(struct bt_conn *conn)
+{
+	return atomic_get(&conn->ref) && conn->state == BT_CONN_CONNECTED &&
+	       bt_conn_get_pkts(conn) && !tx_sched_held(conn);
+}
+
+void bt_conn_tx_sched_done(struct bt_conn *conn)
+{
+	/* Wake up the TX thread if the connection was held back by the
+	 * in-flight limit, as it does not wait for controller buffers then.
+	 */
+	if (atomic_dec(&conn->tx_sched_inflight) ==
+	    CONFIG_BT_CONN_TX_SCHED_MAX_INFLIGHT) {
+		k_poll_signal_raise(&conn_change, 0);
+	}
+}
+
+static int tx_sched_prepare_events(struct k_poll_event events[])
+{
+	struct k_sem *pkts[BT_CONN_TX_SCHED_EV_COUNT];
+	int count = 0;
+
+	for (uint8_t i = 0; i < TX_SCHED_CONNS; i++) {
+		struct bt_conn *conn = tx_sched_conn(i);
+		struct k_sem *sem;
+		int j;
+
+		if (!tx_sched_ready(conn) || !tx_sched_backlogged(conn)) {
+			continue;
+		}
+
+		sem = bt_conn_get_pkts(conn);
+		for (j = 0; j < count; j++) {
+			if (pkts[j] == sem) {
+				break;
+			}
+		}
+
+		if (j < count || count == ARRAY_SIZE(pkts)) {
+			continue;
+		}
+
+		pkts[count] = sem;
+		k_poll_event_init(&events[count], K_POLL_TYPE_SEM_AVAILABLE,
+				  K_POLL_MODE_NOTIFY_ONLY, sem);
+		events[count].tag = BT_EVENT_CONN_TX_PKTS;
+		count++;
+	}
+
+	return count;
+}
+
+/* Send the next controller packet of the current buffer of the connection,
+ * segmenting it only now that a controller buffer has been taken for it.
+ * Return the length of the packet, or a negative value if the buffer had
+ * to be dropped.
+ */
+static int tx_sched_send(struct bt_conn *conn)
+{
+	struct net_buf *buf = conn->tx_sched_buf;
+	struct net_buf *frag;
+	int len;
+
+	if (net_buf_frags_len(buf) <= conn_mtu(conn)) {
+		conn->tx_sched_buf = NULL;
+		len = net_buf_frags_len(buf);
+
+		if (buf->frags) {
+			if (!send_chain_end(conn, buf, conn->tx_sched_started ?
+					    FRAG_END : FRAG_SINGLE)) {
+				tx_buf_destroy(conn, buf);
+				return -EIO;
+			}
+
+			return len;
+		}
+
+		if (!conn_send_frag(conn, buf, conn->tx_sched_started ?
+				    FRAG_END : FRAG_SINGLE, false)) {
+			tx_buf_destroy(conn, buf);
+			return -EIO;
+		}
+
+		return len;
+	}
+
+	frag = create_frag(conn, buf);
+	if (!frag) {
+		k_sem_give(bt_conn_get_pkts(conn));
+		goto drop;
+	}
+
+	len = frag->len;
+
+	if (!conn_send_frag(conn, frag, conn->tx_sched_started ?
+			    FRAG_CONT : FRAG_START, true)) {
+		goto drop;
+	}
+
+	conn->tx_sched_started = true;
+
+	return len;
+
+drop:
+	conn->tx_sched_buf = NULL;
+	tx_buf_destroy(conn, buf);
+
+	return -EIO;
+}
+
+/* Serve the turn of a connection: return 0 if it sent data, -ENOENT if it
+ * had nothing to send and -EAGAIN if the controller ran out of buffers.
+ */
+static int tx_sched_turn(struct bt_conn *conn)
+{
+	bool sent = false;
+	int len;
+
+	if (conn->state == BT_CONN_DISCONNECTED &&
+	    atomic_test_and_clear_bit(conn->flags, BT_CONN_CLEANUP)) {
+		BT_DBG("handle %u disconnected - cleaning up", conn->handle);
+		conn_cleanup(conn);
+		return -ENOENT;
+	}
+
+	if (!tx_sched_ready(conn)) {
+		return -ENOENT;
+	}
+
+	if (!tx_sched_granted) {
+		if (!tx_sched_backlogged(conn)) {
+			conn->tx_sched_deficit = 0;
+			return -ENOENT;
+		}
+
+		/* A quantum of one full controller packet per turn */
+		conn->tx_sched_deficit += conn_mtu(conn);
+		tx_sched_granted = true;
+	}
+
+	while (!tx_sched_held(conn)) {
+		if (!conn->tx_sched_buf) {
+			conn->tx_sched_buf = net_buf_get(&conn->tx_queue,
+							 K_NO_WAIT);
+			if (!conn->tx_sched_buf) {
+				conn->tx_sched_deficit = 0;
+				break;
+			}
+
+			conn->tx_sched_started = false;
+		}
+
+		/* Wait for the next turn if the packet is larger than what is
+		 * left of the quantum.
+		 */
+		if (MIN(net_buf_frags_len(conn->tx_sched_buf), conn_mtu(conn)) >
+		    conn->tx_sched_deficit) {
+			break;
+		}
+
+		if (k_sem_take(bt_conn_get_pkts(conn), K_NO_WAIT)) {
+			return -EAGAIN;
+		}
+
+		len = tx_sched_send(conn);
+		if (len > 0) {
+			conn->tx_sched_deficit -= len;
+		}
+
+		sent = true;
+	}
+
+	return sent ? 0 : -ENOENT;
+}
+
+void bt_conn_tx_schedule(void)
+{
+	uint8_t idle = 0U;
+
+	/* Go round the connections until none of them has anything to send,
+	 * or until the controller runs out of buffers, in which case the turn
+	 * of the current connection goes on once buffers are available.
+	 */
+	while (idle < TX_SCHED_CONNS) {
+		int err;
+
+		err = tx_sched_turn(tx_sched_conn(tx_sched_cur));
+		if (err == -EAGAIN) {
+			return;
+		}
+
+		idle = err ? idle + 1U : 0U;
+		tx_sched_cur = (tx_sched_cur + 1U) % TX_SCHED_CONNS;
+		tx_sched_granted = false;
+	}
+}
+#endif /* CONFIG_BT_CONN_TX_SCHED */
+
 static int conn_prepare_events(struct bt_conn *conn,
 			       struct k_poll_event *events)
 {
@@ -715,6 +1041,15 @@ static int conn_prepare_events(struct bt_conn *conn,
 		return -ENOTCONN;
 	}
 
+#if defined(CONFIG_BT_CONN_TX_SCHED)
+	/* The scheduler waits for controller buffers for the connections
+	 * already having data to send.
+	 */
+	if (tx_sched_backlogged(conn)) {
+		return -EAGAIN;
+	}
+#endif /* CONFIG_BT_CONN_TX_SCHED */
+
 	BT_DBG("Adding conn %p to poll list", conn);
 
 	k_poll_event_init(&events[0],
@@ -758,6 +1093,10 @@ int bt_conn_prepare_events(struct k_poll_event events[])
 	}
 #endif
 
+#if defined(CONFIG_BT_CONN_TX_SCHED)
+	ev_count += tx_sched_prepare_events(&events[ev_count]);
+#endif /* CONFIG_BT_CONN_TX_SCHED */
+
 	return ev_count;
 }
 
@@ -778,17 +1117,7 @@ void bt_conn_process_tx(struct bt_conn *conn)
 	buf = net_buf_get(&conn->tx_queue, K_NO_WAIT);
 	BT_ASSERT(buf);
 	if (!send_buf(conn, buf)) {
-		struct bt_conn_tx *tx = tx_data(buf)->tx;
-
-		tx_data(buf)->tx = NULL;
-
-		/* destroy the buffer */
-		net_buf_unref(buf);
-
-		/* destroy the tx context (and any associated meta-data) */
-		if (tx) {
-			conn_tx_destroy(conn, tx);
-		}
+		tx_buf_destroy(conn, buf);
 	}
 }
 
@@ -805,6 +1134,7 @@ static void process_unack_tx(struct bt_conn *conn)
 		if (conn->pending_no_cb) {
 			conn->pending_no_cb--;
 			irq_unlock(key);
+			bt_conn_tx_sched_done(conn);
 			k_sem_give(bt_conn_get_pkts(conn));
 			continue;
 		}
@@ -825,6 +1155,7 @@ static void process_unack_tx(struct bt_conn *conn)
 
 		conn_tx_destroy(conn, tx);
 
+		bt_conn_tx_sched_done(conn);
 		k_sem_give(bt_conn_get_pkts(conn));
 	}
 }
@@ -901,6 +1232,11 @@ void bt_conn_set_state(struct bt_conn *conn, bt_conn_state_t state)
 			break;
 		}
 		k_fifo_init(&conn->tx_queue);
+#if defined(CONFIG_BT_CONN_TX_SCHED)
+		conn->tx_sched_buf = NULL;
+		conn->tx_sched_deficit = 0;
+		atomic_set(&conn->tx_sched_inflight, 0);
+#endif /* CONFIG_BT_CONN_TX_SCHED */
 		k_poll_signal_raise(&conn_change, 0);
 
 		if (IS_ENABLED(CONFIG_BT_ISO) &&
@@ -210,6 +210,17 @@ struct bt_conn {
 	/* Queue for outgoing ACL data */
 	struct k_fifo		tx_queue;
 
+#if defined(CONFIG_BT_CONN_TX_SCHED)
+	/* Buffer being segmented into controller packets */
+	struct net_buf		*tx_sched_buf;
+	/* Number of bytes the connection may still send in its turn */
+	int32_t			tx_sched_deficit;
+	/* Controller packets sent and not completed yet */
+	atomic_t		tx_sched_inflight;
+	/* The first controller packet of tx_sched_buf has been sent */
+	bool			tx_sched_started;
+#endif /* CONFIG_BT_CONN_TX_SCHED */
+
 	/* Active L2CAP channels */
 	sys_slist_t		channels;
 
@@ -426,3 +437,19 @@ struct k_sem *bt_conn_get_pkts(struct bt_conn *conn);
 /* k_poll related helpers for the TX thread */
 int bt_conn_prepare_events(struct k_poll_event events[]);
 void bt_conn_process_tx(struct bt_conn *conn);
+
+#if defined(CONFIG_BT_CONN_TX_SCHED)
+/* Controller buffer semaphores the TX thread may wait for, one per type of
+ * controller buffers: LE ACL, BR/EDR ACL and ISO.
+ */
+#define BT_CONN_TX_SCHED_EV_COUNT 3
+
+void bt_conn_tx_sched_done(struct bt_conn *conn);
+#else
+#define BT_CONN_TX_SCHED_EV_COUNT 0
+
+static inline void bt_conn_tx_sched_done(struct bt_conn *conn) {}
+#endif /* CONFIG_BT_CONN_TX_SCHED */
+
+/* Send the pending data of the connections, in turn */
+void bt_conn_tx_schedule(void);
@@ -87,6 +87,147 @@ static sys_slist_t db;
 static atomic_t init;
 static atomic_t service_init;
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+#define ATTR_INDEX_UUID_BITS	5
+#define ATTR_INDEX_UUID_BUCKETS	BIT(ATTR_INDEX_UUID_BITS)
+
+/* Attributes of the database, static ones first, in ascending handle order */
+struct attr_index_entry {
+	const struct bt_gatt_attr *attr;
+	uint16_t handle;
+};
+
+static struct {
+	struct attr_index_entry attrs[CONFIG_BT_GATT_ATTR_INDEX_SIZE];
+	/* Positions in attrs grouped by UUID bucket, in ascending handle
+	 * order within a bucket. Bucket b holds positions
+	 * uuid_order[uuid_start[b]] up to uuid_order[uuid_start[b + 1] - 1].
+	 */
+	uint16_t uuid_order[CONFIG_BT_GATT_ATTR_INDEX_SIZE];
+	uint16_t uuid_start[ATTR_INDEX_UUID_BUCKETS + 1];
+	uint16_t count;
+	bool valid;
+} attr_index;
+
+/* UUIDs that compare equal with bt_uuid_cmp() shall hash the same: the
+ * 16-bit and 32-bit aliases of a 128-bit UUID are stored in its bytes 12-15.
+ */
+static uint8_t attr_index_uuid_hash(const struct bt_uuid *uuid)
+{
+	uint32_t key;
+
+	switch (uuid->type) {
+	case BT_UUID_TYPE_16:
+		key = BT_UUID_16(uuid)->val;
+		break;
+	case BT_UUID_TYPE_32:
+		key = BT_UUID_32(uuid)->val;
+		break;
+	default:
+		key = sys_get_le32(&BT_UUID_128(uuid)->val[12]);
+		break;
+	}
+
+	return (key * 2654435761U) >> (32 - ATTR_INDEX_UUID_BITS);
+}
+
+static bool attr_index_add(const struct bt_gatt_attr *attr, uint16_t handle)
+{
+	if (attr_index.count == ARRAY_SIZE(attr_index.attrs)) {
+		return false;
+	}
+
+	attr_index.attrs[attr_index.count].attr = attr;
+	attr_index.attrs[attr_index.count].handle = handle;
+	attr_index.count++;
+
+	return true;
+}
+
+/* Must be called with the scheduler locked, whenever the database changes */
+static void attr_index_build(void)
+{
+	uint16_t pos[ATTR_INDEX_UUID_BUCKETS];
+	uint16_t handle = 1;
+	uint16_t i;
+#if defined(CONFIG_BT_GATT_DYNAMIC_DB)
+	struct bt_gatt_service *svc;
+#endif /* CONFIG_BT_GATT_DYNAMIC_DB */
+
+	attr_index.valid = false;
+	attr_index.count = 0U;
+
+	STRUCT_SECTION_FOREACH(bt_gatt_service_static, static_svc) {
+		for (i = 0; i < static_svc->attr_count; i++, handle++) {
+			if (!attr_index_add(&static_svc->attrs[i], handle)) {
+				goto overflow;
+			}
+		}
+	}
+
+#if defined(CONFIG_BT_GATT_DYNAMIC_DB)
+	SYS_SLIST_FOR_EACH_CONTAINER(&db, svc, node) {
+		for (i = 0; i < svc->attr_count; i++) {
+			if (!attr_index_add(&svc->attrs[i],
+					    svc->attrs[i].handle)) {
+				goto overflow;
+			}
+		}
+	}
+#endif /* CONFIG_BT_GATT_DYNAMIC_DB */
+
+	/* Counting sort of the positions by UUID bucket, which keeps them
+	 * in handle order within each bucket.
+	 */
+	(void)memset(pos, 0, sizeof(pos));
+
+	for (i = 0; i < attr_index.count; i++) {
+		pos[attr_index_uuid_hash(attr_index.attrs[i].attr->uuid)]++;
+	}
+
+	attr_index.uuid_start[0] = 0U;
+	for (i = 0; i < ATTR_INDEX_UUID_BUCKETS; i++) {
+		attr_index.uuid_start[i + 1] = attr_index.uuid_start[i] +
+					       pos[i];
+		pos[i] = attr_index.uuid_start[i];
+	}
+
+	for (i = 0; i < attr_index.count; i++) {
+		uint8_t b = attr_index_uuid_hash(attr_index.attrs[i].attr->uuid);
+
+		attr_index.uuid_order[pos[b]++] = i;
+	}
+
+	attr_index.valid = true;
+
+	return;
+
+overflow:
+	BT_WARN("More than %u attributes, lookups are not indexed",
+		CONFIG_BT_GATT_ATTR_INDEX_SIZE);
+}
+
+/* Position of the first attribute whose handle is at least handle */
+static uint16_t attr_index_lower_bound(const uint16_t *order, uint16_t lo,
+				       uint16_t hi, uint16_t handle)
+{
+	while (lo < hi) {
+		uint16_t mid = lo + (hi - lo) / 2U;
+		uint16_t p = order ? order[mid] : mid;
+
+		if (attr_index.attrs[p].handle < handle) {
+			lo = mid + 1U;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return lo;
+}
+#else
+static inline void attr_index_build(void) {}
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
+
 static ssize_t read_name(struct bt_conn *conn, const struct bt_gatt_attr *attr,
 			 void *buf, uint16_t len, uint16_t offset)
 {
@@ -338,7 +479,7 @@ static void sc_store(struct gatt_sc_cfg *cfg)
 				       &cfg->peer, NULL);
 	}
 
-	err = settings_save_one(key, (char *)&cfg->data, sizeof(cfg->data));
+	err = bt_settings_store(key, (char *)&cfg->data, sizeof(cfg->data));
 	if (err) {
 		BT_ERR("failed to store SC (err %d)", err);
 		return;
@@ -379,7 +520,7 @@ static int bt_gatt_clear_sc(uint8_t id, const bt_addr_le_t *addr)
 					       &cfg->peer, NULL);
 		}
 
-		err = settings_delete(key);
+		err = bt_settings_delete(key);
 		if (err) {
 			BT_ERR("failed to delete SC (err %d)", err);
 		} else {
@@ -765,7 +906,7 @@ static void db_hash_store(void)
 {
 	int err;
 
-	err = settings_save_one("bt/hash", &db_hash.hash, sizeof(db_hash.hash));
+	err = bt_settings_store("bt/hash", &db_hash.hash, sizeof(db_hash.hash));
 	if (err) {
 		BT_ERR("Failed to save Database Hash (err %d)", err);
 	}
@@ -952,7 +1093,7 @@ static int bt_gatt_store_cf(struct bt_conn *conn)
 				       &conn->le.dst, NULL);
 	}
 
-	err = settings_save_one(key, str, len);
+	err = bt_settings_store(key, str, len);
 	if (err) {
 		BT_ERR("Failed to store Client Features (err %d)", err);
 		return err;
@@ -1127,6 +1268,7 @@ populate:
 	}
 
 	gatt_insert(svc, last_handle);
+	attr_index_build();
 
 	return 0;
 }
@@ -1294,6 +1436,8 @@ static void bt_gatt_service_init(void)
 	STRUCT_SECTION_FOREACH(bt_gatt_service_static, svc) {
 		last_static_handle += svc->attr_count;
 	}
+
+	attr_index_build();
 }
 
 void bt_gatt_init(void)
@@ -1462,6 +1606,8 @@ static int gatt_unregister(struct bt_gatt_service *svc)
 		return -ENOENT;
 	}
 
+	attr_index_build();
+
 	for (uint16_t i = 0; i < svc->attr_count; i++) {
 		struct bt_gatt_attr *attr = &svc->attrs[i];
 
@@ -1816,6 +1962,49 @@ static void foreach_attr_type_dyndb(uint16_t start_handle, uint16_t end_handle,
 #endif /* CONFIG_BT_GATT_DYNAMIC_DB */
 }
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+static void foreach_attr_type_index(uint16_t start_handle, uint16_t end_handle,
+				    const struct bt_uuid *uuid,
+				    const void *attr_data, uint16_t num_matches,
+				    bt_gatt_attr_func_t func, void *user_data)
+{
+	const struct attr_index_entry *entry;
+	const uint16_t *order = NULL;
+	uint16_t i, end = attr_index.count;
+
+	if (uuid) {
+		uint8_t b = attr_index_uuid_hash(uuid);
+
+		order = attr_index.uuid_order;
+		i = attr_index.uuid_start[b];
+		end = attr_index.uuid_start[b + 1];
+	} else if (start_handle > 0 && start_handle <= end &&
+		   attr_index.attrs[start_handle - 1].handle == start_handle) {
+		/* Handles are contiguous up to the first dynamic service
+		 * registered with handles of its own.
+		 */
+		i = start_handle - 1;
+		goto iterate;
+	} else {
+		i = 0U;
+	}
+
+	i = attr_index_lower_bound(order, i, end, start_handle);
+
+iterate:
+	for (; i < end; i++) {
+		entry = &attr_index.attrs[order ? order[i] : i];
+
+		if (gatt_foreach_iter(entry->attr, entry->handle, start_handle,
+				      end_handle, uuid, attr_data,
+				      &num_matches, func, user_data) ==
+		    BT_GATT_ITER_STOP) {
+			return;
+		}
+	}
+}
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
+
 void bt_gatt_foreach_attr_type(uint16_t start_handle, uint16_t end_handle,
 			       const struct bt_uuid *uuid,
 			       const void *attr_data, uint16_t num_matches,
@@ -1827,6 +2016,15 @@ void bt_gatt_foreach_attr_type(uint16_t start_handle, uint16_t end_handle,
 		num_matches = UINT16_MAX;
 	}
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+	if (attr_index.valid) {
+		foreach_attr_type_index(start_handle, end_handle, uuid,
+					attr_data, num_matches, func,
+					user_data);
+		return;
+	}
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
+
 	if (start_handle <= last_static_handle) {
 		uint16_t handle = 1;
 
@@ -2181,6 +2379,8 @@ static int gatt_notify_mult(struct bt_conn *conn, uint16_t handle,
 	 * the existing buffer and proceed to create a new one
 	 */
 	if (*buf && ((net_buf_tailroom(*buf) < sizeof(struct bt_att_notify_mult) + params->len) ||
+	    ((*buf)->len + sizeof(struct bt_att_notify_mult) + params->len >
+	     bt_att_get_mtu(conn)) ||
 	    !bt_att_tx_meta_data_match(*buf, params->func, params->user_data,
 				       BT_ATT_CHAN_OPT(params)))) {
 		int ret;
@@ -2708,8 +2908,8 @@ static int gatt_notify_multiple_verify_params(struct bt_conn *conn,
 					     uint16_t num_params, size_t *total_len)
 {
 	for (uint16_t i = 0; i < num_params; i++) {
-		/* Compute the total data length. */
-		*total_len += params[i].len;
+		/* Compute the total length, each value has its own header. */
+		*total_len += sizeof(struct bt_att_notify_mult) + params[i].len;
 
 		/* Confirm that the connection has the correct level of security. */
 		if (bt_gatt_check_perm(conn, params[i].attr,
@@ -2751,8 +2951,7 @@ static int gatt_notify_multiple_verify_params(struct bt_conn *conn,
 	}
 
 	/* Check there is a bearer with a high enough MTU. */
-	if (bt_att_get_mtu(conn) <
-	    (sizeof(struct bt_att_notify_mult) + *total_len)) {
+	if (bt_att_get_mtu(conn) < sizeof(uint8_t) + *total_len) {
 		return -ERANGE;
 	}
 
@@ -2787,8 +2986,7 @@ int bt_gatt_notify_multiple(struct bt_conn *conn,
 	gatt_notify_flush(conn);
 
 	/* Build the PDU */
-	buf = bt_att_create_pdu(conn, BT_ATT_OP_NOTIFY_MULT,
-				sizeof(struct bt_att_notify_mult) + total_len);
+	buf = bt_att_create_pdu(conn, BT_ATT_OP_NOTIFY_MULT, total_len);
 	if (!buf) {
 		return -ENOMEM;
 	}
@@ -2817,6 +3015,74 @@ int bt_gatt_notify_multiple(struct bt_conn *conn,
 	/* Send the buffer. */
 	return gatt_notify_mult_send(conn, buf);
 }
+
+static int gatt_notify_batch_send(struct bt_conn *conn, uint16_t num_params,
+				  struct bt_gatt_notify_params params[])
+{
+	if (num_params == 1U) {
+		return bt_gatt_notify_cb(conn, params);
+	}
+
+	return bt_gatt_notify_multiple(conn, num_params, params);
+}
+
+int bt_gatt_notify_batch(struct bt_conn *conn,
+			 uint16_t num_params,
+			 struct bt_gatt_notify_params params[])
+{
+	uint16_t first = 0U;
+	size_t len = 0;
+	uint16_t mtu;
+	int err;
+
+	CHECKIF(conn == NULL) {
+		return -EINVAL;
+	}
+
+	if (!gatt_cf_notify_multi(conn)) {
+		for (uint16_t i = 0; i < num_params; i++) {
+			err = bt_gatt_notify_cb(conn, &params[i]);
+			if (err) {
+				return err;
+			}
+		}
+
+		return 0;
+	}
+
+	mtu = bt_att_get_mtu(conn);
+
+	for (uint16_t i = 0; i < num_params; i++) {
+		size_t item = sizeof(struct bt_att_notify_mult) + params[i].len;
+
+		/* Flush the pending notifications if this one cannot join
+		 * them in the same PDU.
+		 */
+		if (i > first &&
+		    ((sizeof(uint8_t) + len + item > mtu) ||
+		     (params[i].func != params[first].func) ||
+		     (params[i].user_data != params[first].user_data) ||
+		     (BT_ATT_CHAN_OPT(&params[i]) !=
+		      BT_ATT_CHAN_OPT(&params[first])))) {
+			err = gatt_notify_batch_send(conn, i - first,
+						     &params[first]);
+			if (err) {
+				return err;
+			}
+
+			first = i;
+			len = 0;
+		}
+
+		len += item;
+	}
+
+	if (first == num_params) {
+		return 0;
+	}
+
+	return gatt_notify_batch_send(conn, num_params - first, &params[first]);
+}
 #endif /* CONFIG_BT_GATT_NOTIFY_MULTIPLE */
 
 int bt_gatt_indicate(struct bt_conn *conn,
@@ -5685,7 +5951,7 @@ int bt_gatt_store_ccc(uint8_t id, const bt_addr_le_t *addr)
 		len = 0;
 	}
 
-	err = settings_save_one(key, str, len);
+	err = bt_settings_store(key, str, len);
 	if (err) {
 		BT_ERR("Failed to store CCCs (err %d)", err);
 		return err;
@@ -5953,7 +6219,7 @@ static int bt_gatt_clear_ccc(uint8_t id, const bt_addr_le_t *addr)
 					       addr, NULL);
 		}
 
-		return settings_delete(key);
+		return bt_settings_delete(key);
 	}
 
 	return 0;
@@ -5982,7 +6248,7 @@ static int bt_gatt_clear_cf(uint8_t id, const bt_addr_le_t *addr)
 					       addr, NULL);
 		}
 
-		return settings_delete(key);
+		return bt_settings_delete(key);
 	}
 
 	return 0;
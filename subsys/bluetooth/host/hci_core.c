@@ -449,6 +449,7 @@ static void hci_num_completed_packets(struct net_buf *buf)
 			if (conn->pending_no_cb) {
 				conn->pending_no_cb--;
 				irq_unlock(key);
+				bt_conn_tx_sched_done(conn);
 				k_sem_give(bt_conn_get_pkts(conn));
 				continue;
 			}
@@ -470,6 +471,7 @@ static void hci_num_completed_packets(struct net_buf *buf)
 			irq_unlock(key);
 
 			k_work_submit(&conn->tx_complete_work);
+			bt_conn_tx_sched_done(conn);
 			k_sem_give(bt_conn_get_pkts(conn));
 		}
 
@@ -2453,7 +2455,11 @@ static void process_events(struct k_poll_event *ev, int count)
 				   IS_ENABLED(CONFIG_BT_ISO)) {
 				struct bt_conn *conn;
 
-				if (ev->tag == BT_EVENT_CONN_TX_QUEUE) {
+				/* The scheduler serves all the connections
+				 * once the events are processed.
+				 */
+				if (ev->tag == BT_EVENT_CONN_TX_QUEUE &&
+				    !IS_ENABLED(CONFIG_BT_CONN_TX_SCHED)) {
 					conn = CONTAINER_OF(ev->fifo,
 							    struct bt_conn,
 							    tx_queue);
@@ -2461,6 +2467,9 @@ static void process_events(struct k_poll_event *ev, int count)
 				}
 			}
 			break;
+		case K_POLL_STATE_SEM_AVAILABLE:
+			/* Controller buffers for the TX scheduler */
+			break;
 		case K_POLL_STATE_NOT_READY:
 			break;
 		default:
@@ -2472,11 +2481,14 @@ static void process_events(struct k_poll_event *ev, int count)
 
 #if defined(CONFIG_BT_CONN)
 #if defined(CONFIG_BT_ISO)
-/* command FIFO + conn_change signal + MAX_CONN + ISO_MAX_CHAN */
-#define EV_COUNT (2 + CONFIG_BT_MAX_CONN + CONFIG_BT_ISO_MAX_CHAN)
+/* command FIFO + conn_change signal + MAX_CONN + ISO_MAX_CHAN +
+ * controller buffers
+ */
+#define EV_COUNT (2 + CONFIG_BT_MAX_CONN + CONFIG_BT_ISO_MAX_CHAN + \
+		  BT_CONN_TX_SCHED_EV_COUNT)
 #else
-/* command FIFO + conn_change signal + MAX_CONN */
-#define EV_COUNT (2 + CONFIG_BT_MAX_CONN)
+/* command FIFO + conn_change signal + MAX_CONN + controller buffers */
+#define EV_COUNT (2 + CONFIG_BT_MAX_CONN + BT_CONN_TX_SCHED_EV_COUNT)
 #endif /* CONFIG_BT_ISO */
 #else
 #if defined(CONFIG_BT_ISO)
@@ -2516,6 +2528,10 @@ static void hci_tx_thread(void *p1, void *p2, void *p3)
 
 		process_events(events, ev_count);
 
+		if (IS_ENABLED(CONFIG_BT_CONN_TX_SCHED)) {
+			bt_conn_tx_schedule();
+		}
+
 		/* Make sure we don't hog the CPU if there's all the time
 		 * some ready events.
 		 */
@@ -3749,6 +3765,11 @@ int bt_disable(void)
 		return -EALREADY;
 	}
 
+	if (IS_ENABLED(CONFIG_BT_SETTINGS)) {
+		/* Write settings that are still pending */
+		bt_settings_store_flush();
+	}
+
 	/* Clear BT_DEV_READY before disabling HCI link */
 	atomic_clear_bit(bt_dev.flags, BT_DEV_READY);
 
@@ -3820,7 +3841,7 @@ int bt_set_name(const char *name)
 	bt_dev.name[len] = '\0';
 
 	if (IS_ENABLED(CONFIG_BT_SETTINGS)) {
-		err = settings_save_one("bt/name", bt_dev.name, len);
+		err = bt_settings_store("bt/name", bt_dev.name, len);
 		if (err) {
 			BT_WARN("Unable to store name");
 		}
@@ -3855,7 +3876,7 @@ int bt_set_appearance(uint16_t appearance)
 {
 	if (bt_dev.appearance != appearance) {
 		if (IS_ENABLED(CONFIG_BT_SETTINGS)) {
-			int err = settings_save_one("bt/appearance", &appearance,
+			int err = bt_settings_store("bt/appearance", &appearance,
 					sizeof(appearance));
 
 			if (err) {
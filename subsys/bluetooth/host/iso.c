@@ -571,6 +571,34 @@ struct net_buf *bt_iso_get_rx(k_timeout_t timeout)
 	return buf;
 }
 
+/* Append a continuation or end fragment to the SDU being received, consuming
+ * the fragment buffer.
+ */
+static bool iso_rx_append(struct bt_conn *iso, struct net_buf *buf)
+{
+	iso->rx_len -= buf->len;
+
+#if defined(CONFIG_BT_ISO_RX_SDU_CHAIN)
+	if (buf->len) {
+		net_buf_frag_add(iso->rx, buf);
+	} else {
+		net_buf_unref(buf);
+	}
+#else
+	if (buf->len > net_buf_tailroom(iso->rx)) {
+		BT_ERR("Not enough buffer space for ISO data");
+		bt_conn_reset_rx_state(iso);
+		net_buf_unref(buf);
+		return false;
+	}
+
+	net_buf_add_mem(iso->rx, buf->data, buf->len);
+	net_buf_unref(buf);
+#endif /* CONFIG_BT_ISO_RX_SDU_CHAIN */
+
+	return true;
+}
+
 void bt_iso_recv(struct bt_conn *iso, struct net_buf *buf, uint8_t flags)
 {
 	struct bt_hci_iso_data_hdr *hdr;
@@ -664,16 +692,7 @@ void bt_iso_recv(struct bt_conn *iso, struct net_buf *buf, uint8_t flags)
 
 		BT_DBG("Cont, len %u rx_len %u", buf->len, iso->rx_len);
 
-		if (buf->len > net_buf_tailroom(iso->rx)) {
-			BT_ERR("Not enough buffer space for ISO data");
-			bt_conn_reset_rx_state(iso);
-			net_buf_unref(buf);
-			return;
-		}
-
-		net_buf_add_mem(iso->rx, buf->data, buf->len);
-		iso->rx_len -= buf->len;
-		net_buf_unref(buf);
+		iso_rx_append(iso, buf);
 		return;
 
 	case BT_ISO_END:
@@ -688,17 +707,10 @@ void bt_iso_recv(struct bt_conn *iso, struct net_buf *buf, uint8_t flags)
 			return;
 		}
 
-		if (buf->len > net_buf_tailroom(iso->rx)) {
-			BT_ERR("Not enough buffer space for ISO data");
-			bt_conn_reset_rx_state(iso);
-			net_buf_unref(buf);
+		if (!iso_rx_append(iso, buf)) {
 			return;
 		}
 
-		(void)net_buf_add_mem(iso->rx, buf->data, buf->len);
-		iso->rx_len -= buf->len;
-		net_buf_unref(buf);
-
 		break;
 	default:
 		BT_ERR("Unexpected ISO pb flags (0x%02x)", pb);
@@ -792,9 +804,9 @@ int bt_iso_chan_send(struct bt_iso_chan *chan, struct net_buf *buf,
 	}
 
 	max_data_len = iso_chan_max_data_len(chan, ts);
-	if (buf->len > max_data_len) {
-		BT_DBG("Cannot send %u octets, maximum %u",
-		       buf->len, max_data_len);
+	if (net_buf_frags_len(buf) > max_data_len) {
+		BT_DBG("Cannot send %zu octets, maximum %u",
+		       net_buf_frags_len(buf), max_data_len);
 		return -EMSGSIZE;
 	}
 
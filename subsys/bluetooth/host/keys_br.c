@@ -103,7 +103,7 @@ void bt_keys_link_key_clear(struct bt_keys_link_key *link_key)
 		bt_addr_copy(&le_addr.a, &link_key->addr);
 		bt_settings_encode_key(key, sizeof(key), "link_key",
 				       &le_addr, NULL);
-		settings_delete(key);
+		bt_settings_delete(key);
 	}
 
 	BT_DBG("%s", bt_addr_str(&link_key->addr));
@@ -141,7 +141,7 @@ void bt_keys_link_key_store(struct bt_keys_link_key *link_key)
 		bt_settings_encode_key(key, sizeof(key), "link_key",
 				       &le_addr, NULL);
 
-		err = settings_save_one(key, link_key->storage_start,
+		err = bt_settings_store(key, link_key->storage_start,
 					BT_KEYS_LINK_KEY_STORAGE_LEN);
 		if (err) {
 			BT_ERR("Failed to save link key (err %d)", err);
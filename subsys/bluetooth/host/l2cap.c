@@ -647,7 +647,7 @@ int bt_l2cap_send_cb(struct bt_conn *conn, uint16_t cid, struct net_buf *buf,
 	BT_DBG("conn %p cid %u len %zu", conn, cid, net_buf_frags_len(buf));
 
 	hdr = net_buf_push(buf, sizeof(*hdr));
-	hdr->len = sys_cpu_to_le16(buf->len - sizeof(*hdr));
+	hdr->len = sys_cpu_to_le16(net_buf_frags_len(buf) - sizeof(*hdr));
 	hdr->cid = sys_cpu_to_le16(cid);
 
 	return bt_conn_send_cb(conn, buf, cb, user_data);
@@ -1789,6 +1789,39 @@ static inline struct net_buf *l2cap_alloc_seg(struct net_buf *buf)
 	return bt_l2cap_create_pdu_timeout(NULL, 0, K_NO_WAIT);
 }
 
+#if defined(CONFIG_BT_L2CAP_SEG_REF)
+static void seg_ref_destroy(struct net_buf *buf)
+{
+	struct net_buf *sdu = *(struct net_buf **)net_buf_user_data(buf);
+
+	net_buf_destroy(buf);
+	net_buf_unref(sdu);
+}
+
+/* Buffers pointing to SDU data, each holding a reference to the SDU buffer
+ * which is stored in its user data.
+ */
+NET_BUF_POOL_FIXED_DEFINE(seg_ref_pool, CONFIG_BT_L2CAP_SEG_REF_COUNT, 0,
+			  sizeof(struct net_buf *), seg_ref_destroy);
+
+static bool l2cap_seg_ref_add(struct net_buf *seg, struct net_buf *buf,
+			      uint16_t len)
+{
+	struct net_buf *ref;
+
+	ref = net_buf_alloc_with_data(&seg_ref_pool, buf->data, len,
+				      K_NO_WAIT);
+	if (!ref) {
+		return false;
+	}
+
+	*(struct net_buf **)net_buf_user_data(ref) = net_buf_ref(buf);
+	net_buf_frag_add(seg, ref);
+
+	return true;
+}
+#endif /* CONFIG_BT_L2CAP_SEG_REF */
+
 static struct net_buf *l2cap_chan_create_seg(struct bt_l2cap_le_chan *ch,
 					     struct net_buf *buf,
 					     size_t sdu_hdr_len)
@@ -1826,9 +1859,23 @@ segment:
 	}
 
 	/* Don't send more that TX MPS including SDU length */
-	len = MIN(net_buf_tailroom(seg), ch->tx.mps - sdu_hdr_len);
+	len = ch->tx.mps - sdu_hdr_len;
 	/* Limit if original buffer is smaller than the segment */
 	len = MIN(buf->len, len);
+
+#if defined(CONFIG_BT_L2CAP_SEG_REF)
+	/* Chain the data after the headers, copy it only if out of
+	 * reference buffers.
+	 */
+	if (l2cap_seg_ref_add(seg, buf, len)) {
+		net_buf_pull(buf, len);
+		BT_DBG("ch %p seg %p len %zu", ch, seg,
+		       net_buf_frags_len(seg));
+		return seg;
+	}
+#endif /* CONFIG_BT_L2CAP_SEG_REF */
+
+	len = MIN(net_buf_tailroom(seg), len);
 	net_buf_add_mem(seg, buf->data, len);
 	net_buf_pull(buf, len);
 
@@ -1951,10 +1998,10 @@ static int l2cap_chan_le_send(struct bt_l2cap_le_chan *ch,
 		return -EAGAIN;
 	}
 
-	BT_DBG("ch %p cid 0x%04x len %u credits %lu", ch, ch->tx.cid,
-	       seg->len, atomic_get(&ch->tx.credits));
+	BT_DBG("ch %p cid 0x%04x len %zu credits %lu", ch, ch->tx.cid,
+	       net_buf_frags_len(seg), atomic_get(&ch->tx.credits));
 
-	len = seg->len - sdu_hdr_len;
+	len = net_buf_frags_len(seg) - sdu_hdr_len;
 
 	/* Set a callback if there is no data left in the buffer */
 	if (buf == seg || !buf->len) {
@@ -2339,6 +2386,7 @@ int bt_l2cap_chan_recv_complete(struct bt_l2cap_chan *chan, struct net_buf *buf)
 	return 0;
 }
 
+#if !defined(CONFIG_BT_L2CAP_RX_SEG_CHAIN)
 static struct net_buf *l2cap_alloc_frag(k_timeout_t timeout, void *user_data)
 {
 	struct bt_l2cap_le_chan *chan = user_data;
@@ -2353,6 +2401,7 @@ static struct net_buf *l2cap_alloc_frag(k_timeout_t timeout, void *user_data)
 
 	return frag;
 }
+#endif /* !CONFIG_BT_L2CAP_RX_SEG_CHAIN */
 
 static void l2cap_chan_le_recv_sdu(struct bt_l2cap_le_chan *chan,
 				   struct net_buf *buf, uint16_t seg)
@@ -2404,6 +2453,14 @@ static void l2cap_chan_le_recv_seg(struct bt_l2cap_le_chan *chan,
 
 	BT_DBG("chan %p seg %d len %zu", chan, seg, net_buf_frags_len(buf));
 
+#if defined(CONFIG_BT_L2CAP_RX_SEG_CHAIN)
+	/* Append received segment to SDU, the caller releases its own
+	 * reference.
+	 */
+	if (buf->len) {
+		net_buf_frag_add(chan->_sdu, net_buf_ref(buf));
+	}
+#else
 	/* Append received segment to SDU */
 	len = net_buf_append_bytes(chan->_sdu, buf->len, buf->data, K_NO_WAIT,
 				   l2cap_alloc_frag, chan);
@@ -2412,6 +2469,7 @@ static void l2cap_chan_le_recv_seg(struct bt_l2cap_le_chan *chan,
 		bt_l2cap_chan_disconnect(&chan->chan);
 		return;
 	}
+#endif /* CONFIG_BT_L2CAP_RX_SEG_CHAIN */
 
 	if (net_buf_frags_len(chan->_sdu) < chan->_sdu_len) {
 		/* Give more credits if remote has run out of them, this
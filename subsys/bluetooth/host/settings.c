@@ -17,6 +17,7 @@
 #include "common/log.h"
 
 #include "hci_core.h"
+#include "long_wq.h"
 #include "settings.h"
 
 #if defined(CONFIG_BT_SETTINGS_USE_PRINTK)
@@ -228,6 +229,167 @@ static int set(const char *name, size_t len_rd, settings_read_cb read_cb,
 	return -ENOENT;
 }
 
+#if defined(CONFIG_BT_SETTINGS_DELAYED_STORE)
+struct delayed_store {
+	/* Empty key marks a free slot */
+	char key[BT_SETTINGS_KEY_MAX];
+	uint16_t len;
+	bool delete;
+	uint8_t val[CONFIG_BT_SETTINGS_DELAYED_STORE_VAL_MAX];
+};
+
+static struct delayed_store delayed_store[CONFIG_BT_SETTINGS_DELAYED_STORE_COUNT];
+static K_MUTEX_DEFINE(delayed_store_lock);
+
+/* Only used from delayed_store_flush(), with store_flush_lock held */
+static struct delayed_store store_flush_slot;
+static K_MUTEX_DEFINE(store_flush_lock);
+
+static void delayed_store_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(delayed_store_work, delayed_store_work_handler);
+
+static struct delayed_store *delayed_store_find(const char *key)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(delayed_store); i++) {
+		if (!strncmp(delayed_store[i].key, key, BT_SETTINGS_KEY_MAX)) {
+			return &delayed_store[i];
+		}
+	}
+
+	return NULL;
+}
+
+static void delayed_store_flush(void)
+{
+	k_mutex_lock(&store_flush_lock, K_FOREVER);
+
+	for (size_t i = 0; i < ARRAY_SIZE(delayed_store); i++) {
+		int err;
+
+		/* Move the value out of the slot, so that it can be updated
+		 * again while it is being written.
+		 */
+		k_mutex_lock(&delayed_store_lock, K_FOREVER);
+		if (delayed_store[i].key[0] == '\0') {
+			k_mutex_unlock(&delayed_store_lock);
+			continue;
+		}
+
+		store_flush_slot = delayed_store[i];
+		delayed_store[i].key[0] = '\0';
+		k_mutex_unlock(&delayed_store_lock);
+
+		if (store_flush_slot.delete) {
+			err = settings_delete(store_flush_slot.key);
+		} else {
+			err = settings_save_one(store_flush_slot.key,
+						store_flush_slot.val,
+						store_flush_slot.len);
+		}
+
+		if (err) {
+			BT_ERR("Failed to store %s (err %d)",
+			       store_flush_slot.key, err);
+		} else {
+			BT_DBG("Stored %s", store_flush_slot.key);
+		}
+	}
+
+	k_mutex_unlock(&store_flush_lock);
+}
+
+static void delayed_store_work_handler(struct k_work *work)
+{
+	delayed_store_flush();
+}
+
+int bt_settings_store(const char *key, const void *value, size_t len)
+{
+	struct delayed_store *slot;
+
+	if (len > sizeof(slot->val) ||
+	    strlen(key) >= sizeof(slot->key)) {
+		/* Drop any pending value of the key so that it does not
+		 * overwrite this one later.
+		 */
+		k_mutex_lock(&delayed_store_lock, K_FOREVER);
+		slot = delayed_store_find(key);
+		if (slot) {
+			slot->key[0] = '\0';
+		}
+		k_mutex_unlock(&delayed_store_lock);
+
+		/* Wait for a write of the key that may be in progress */
+		k_mutex_lock(&store_flush_lock, K_FOREVER);
+		k_mutex_unlock(&store_flush_lock);
+
+		return settings_save_one(key, value, len);
+	}
+
+	k_mutex_lock(&delayed_store_lock, K_FOREVER);
+
+	slot = delayed_store_find(key);
+	if (!slot) {
+		slot = delayed_store_find("");
+	}
+
+	if (!slot) {
+		k_mutex_unlock(&delayed_store_lock);
+
+		BT_DBG("No free slot, writing pending settings");
+		delayed_store_flush();
+
+		k_mutex_lock(&delayed_store_lock, K_FOREVER);
+		slot = delayed_store_find(key);
+		if (!slot) {
+			slot = delayed_store_find("");
+		}
+
+		if (!slot) {
+			k_mutex_unlock(&delayed_store_lock);
+			return -ENOMEM;
+		}
+	}
+
+	strcpy(slot->key, key);
+	slot->delete = (value == NULL && len == 0);
+	slot->len = len;
+	if (len) {
+		(void)memcpy(slot->val, value, len);
+	}
+
+	k_mutex_unlock(&delayed_store_lock);
+
+	BT_DBG("Pending %s len %zu", key, len);
+
+	(void)bt_long_wq_schedule(&delayed_store_work,
+				  K_MSEC(CONFIG_BT_SETTINGS_DELAYED_STORE_MS));
+
+	return 0;
+}
+
+void bt_settings_store_flush(void)
+{
+	(void)k_work_cancel_delayable(&delayed_store_work);
+
+	delayed_store_flush();
+}
+#else
+int bt_settings_store(const char *key, const void *value, size_t len)
+{
+	return settings_save_one(key, value, len);
+}
+
+void bt_settings_store_flush(void)
+{
+}
+#endif /* CONFIG_BT_SETTINGS_DELAYED_STORE */
+
+int bt_settings_delete(const char *key)
+{
+	return bt_settings_store(key, NULL, 0);
+}
+
 #define ID_DATA_LEN(array) (bt_dev.id_count * sizeof(array[0]))
 
 static void save_id(struct k_work *work)
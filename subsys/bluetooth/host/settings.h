@@ -17,4 +17,14 @@ int bt_settings_decode_key(const char *key, bt_addr_le_t *addr);
 
 void bt_settings_save_id(void);
 
+/* Write a value to storage, or record it to be written later if
+ * CONFIG_BT_SETTINGS_DELAYED_STORE is enabled. A NULL value of length 0
+ * deletes the key.
+ */
+int bt_settings_store(const char *key, const void *value, size_t len);
+int bt_settings_delete(const char *key);
+
+/* Write all pending values to storage */
+void bt_settings_store_flush(void);
+
 int bt_settings_init(void);
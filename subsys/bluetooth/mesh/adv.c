@@ -227,6 +227,46 @@ int bt_mesh_adv_gatt_send(void)
 	return -ENOTSUP;
 }
 
+#if defined(CONFIG_BT_MESH_ADV_EXT_RELAY_LOAD)
+#define RX_LOAD_WINDOW_MS 1000
+
+static struct {
+	int64_t window_start;
+	uint16_t count;
+	uint16_t rate;
+} rx_load;
+
+static void rx_load_count(void)
+{
+	int64_t elapsed = k_uptime_get() - rx_load.window_start;
+
+	if (elapsed >= RX_LOAD_WINDOW_MS) {
+		/* A window that ended long ago says nothing about the
+		 * current load.
+		 */
+		rx_load.rate = elapsed < 2 * RX_LOAD_WINDOW_MS ?
+			       rx_load.count : 0U;
+		rx_load.count = 0U;
+		rx_load.window_start += elapsed - (elapsed % RX_LOAD_WINDOW_MS);
+	}
+
+	rx_load.count++;
+}
+
+uint16_t bt_mesh_adv_rx_load(void)
+{
+	int64_t elapsed = k_uptime_get() - rx_load.window_start;
+
+	if (elapsed >= 2 * RX_LOAD_WINDOW_MS) {
+		return 0U;
+	} else if (elapsed >= RX_LOAD_WINDOW_MS) {
+		return rx_load.count;
+	}
+
+	return MAX(rx_load.rate, rx_load.count);
+}
+#endif /* CONFIG_BT_MESH_ADV_EXT_RELAY_LOAD */
+
 static void bt_mesh_scan_cb(const bt_addr_le_t *addr, int8_t rssi,
 			    uint8_t adv_type, struct net_buf_simple *buf)
 {
@@ -259,6 +299,9 @@ static void bt_mesh_scan_cb(const bt_addr_le_t *addr, int8_t rssi,
 
 		switch (type) {
 		case BT_DATA_MESH_MESSAGE:
+#if defined(CONFIG_BT_MESH_ADV_EXT_RELAY_LOAD)
+			rx_load_count();
+#endif
 			bt_mesh_net_recv(buf, rssi, BT_MESH_NET_IF_ADV);
 			break;
 #if defined(CONFIG_BT_MESH_PB_ADV)
@@ -161,6 +161,18 @@ static int adv_start(struct bt_mesh_ext_adv *adv,
 	return err;
 }
 
+#if defined(CONFIG_BT_MESH_ADV_EXT_RELAY_LOAD)
+#define RELAY_LOAD_STEPS_MAX 3
+
+static uint16_t relay_int_adapt(uint16_t adv_int)
+{
+	uint16_t steps = bt_mesh_adv_rx_load() /
+			 CONFIG_BT_MESH_ADV_EXT_RELAY_LOAD_THRESHOLD;
+
+	return adv_int * (1 + MIN(steps, RELAY_LOAD_STEPS_MAX));
+}
+#endif /* CONFIG_BT_MESH_ADV_EXT_RELAY_LOAD */
+
 static int buf_send(struct bt_mesh_ext_adv *adv, struct net_buf *buf)
 {
 	struct bt_le_ext_adv_start_param start = {
@@ -173,6 +185,12 @@ static int buf_send(struct bt_mesh_ext_adv *adv, struct net_buf *buf)
 
 	adv_int = MAX(ADV_INT_FAST_MS,
 		      BT_MESH_TRANSMIT_INT(BT_MESH_ADV(buf)->xmit));
+#if defined(CONFIG_BT_MESH_ADV_EXT_RELAY_LOAD)
+	if (BT_MESH_ADV(buf)->tag == BT_MESH_RELAY_ADV) {
+		adv_int = relay_int_adapt(adv_int);
+	}
+#endif /* CONFIG_BT_MESH_ADV_EXT_RELAY_LOAD */
+
 	/* Upper boundary estimate: */
 	duration = start.num_events * (adv_int + 10);
 
@@ -321,6 +339,11 @@ void bt_mesh_adv_buf_relay_ready(void)
 			return;
 		}
 	}
+
+	/* The main advertising set also serves the relay queue, after the
+	 * local messages. Use it if all the relay sets are busy.
+	 */
+	(void)schedule_send(&adv_main);
 }
 
 void bt_mesh_adv_init(void)
@@ -83,6 +83,13 @@ static struct {
 } msg_cache[CONFIG_BT_MESH_MSG_CACHE_SIZE];
 static uint16_t msg_cache_next;
 
+/* Hash chains over the message cache, so that a lookup does not have to
+ * search every entry. Both arrays hold an entry index + 1, with 0 marking
+ * the end of a chain.
+ */
+static uint16_t msg_cache_head[CONFIG_BT_MESH_MSG_CACHE_HASH_SIZE];
+static uint16_t msg_cache_chain[CONFIG_BT_MESH_MSG_CACHE_SIZE];
+
 /* Singleton network context (the implementation only supports one) */
 struct bt_mesh_net bt_mesh = {
 	.local_queue = SYS_SLIST_STATIC_INIT(&bt_mesh.local_queue),
@@ -131,13 +138,49 @@ static bool check_dup(struct net_buf_simple *data)
 	return false;
 }
 
+static uint16_t *msg_cache_bucket(uint16_t src, uint32_t seq)
+{
+	seq &= BIT_MASK(17);
+
+	return &msg_cache_head[(src ^ seq ^ (seq >> 16)) %
+			       ARRAY_SIZE(msg_cache_head)];
+}
+
+static void msg_cache_unlink(uint16_t idx)
+{
+	uint16_t *next;
+
+	if (msg_cache[idx].src == BT_MESH_ADDR_UNASSIGNED) {
+		return;
+	}
+
+	next = msg_cache_bucket(msg_cache[idx].src, msg_cache[idx].seq);
+	while (*next) {
+		if (*next == idx + 1) {
+			*next = msg_cache_chain[idx];
+			return;
+		}
+
+		next = &msg_cache_chain[*next - 1];
+	}
+}
+
+static void msg_cache_reset(void)
+{
+	(void)memset(msg_cache, 0, sizeof(msg_cache));
+	(void)memset(msg_cache_head, 0, sizeof(msg_cache_head));
+	msg_cache_next = 0U;
+}
+
 static bool msg_cache_match(struct net_buf_simple *pdu)
 {
+	uint16_t src = SRC(pdu->data);
+	uint32_t seq = SEQ(pdu->data) & BIT_MASK(17);
 	uint16_t i;
 
-	for (i = 0U; i < ARRAY_SIZE(msg_cache); i++) {
-		if (msg_cache[i].src == SRC(pdu->data) &&
-		    msg_cache[i].seq == (SEQ(pdu->data) & BIT_MASK(17))) {
+	for (i = *msg_cache_bucket(src, seq); i; i = msg_cache_chain[i - 1]) {
+		if (msg_cache[i - 1].src == src &&
+		    msg_cache[i - 1].seq == seq) {
 			return true;
 		}
 	}
@@ -147,10 +190,17 @@ static bool msg_cache_match(struct net_buf_simple *pdu)
 
 static void msg_cache_add(struct bt_mesh_net_rx *rx)
 {
+	uint16_t *head;
+
 	rx->msg_cache_idx = msg_cache_next++;
+	msg_cache_unlink(rx->msg_cache_idx);
 	msg_cache[rx->msg_cache_idx].src = rx->ctx.addr;
 	msg_cache[rx->msg_cache_idx].seq = rx->seq;
 	msg_cache_next %= ARRAY_SIZE(msg_cache);
+
+	head = msg_cache_bucket(rx->ctx.addr, rx->seq);
+	msg_cache_chain[rx->msg_cache_idx] = *head;
+	*head = rx->msg_cache_idx + 1;
 }
 
 static void store_iv(bool only_duration)
@@ -193,8 +243,7 @@ int bt_mesh_net_create(uint16_t idx, uint8_t flags, const uint8_t key[16],
 		return err;
 	}
 
-	(void)memset(msg_cache, 0, sizeof(msg_cache));
-	msg_cache_next = 0U;
+	msg_cache_reset();
 
 	bt_mesh.iv_index = iv_index;
 	atomic_set_bit_to(bt_mesh.flags, BT_MESH_IVU_IN_PROGRESS,
@@ -653,6 +702,59 @@ static bool relay_to_adv(enum bt_mesh_net_if net_if)
 	}
 }
 
+#if defined(CONFIG_BT_MESH_RELAY_DEDUP)
+/* Relayed messages that are queued but have not started advertising yet,
+ * indexed by the advertising buffer holding them.
+ */
+static struct relay_queued {
+	uint16_t src;
+	uint32_t seq;
+} relay_queued[CONFIG_BT_MESH_ADV_BUF_COUNT];
+
+static void relay_started(uint16_t duration, int err, void *cb_data)
+{
+	struct relay_queued *entry = cb_data;
+
+	entry->src = BT_MESH_ADDR_UNASSIGNED;
+}
+
+static const struct bt_mesh_send_cb relay_send_cb = {
+	.start = relay_started,
+};
+
+static bool relay_is_queued(struct bt_mesh_net_rx *rx)
+{
+	for (int i = 0; i < ARRAY_SIZE(relay_queued); i++) {
+		if (relay_queued[i].src == rx->ctx.addr &&
+		    relay_queued[i].seq == rx->seq) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void relay_send(struct net_buf *buf, struct bt_mesh_net_rx *rx)
+{
+	struct relay_queued *entry = &relay_queued[net_buf_id(buf)];
+
+	entry->src = rx->ctx.addr;
+	entry->seq = rx->seq;
+
+	bt_mesh_adv_send(buf, &relay_send_cb, entry);
+}
+#else
+static inline bool relay_is_queued(struct bt_mesh_net_rx *rx)
+{
+	return false;
+}
+
+static inline void relay_send(struct net_buf *buf, struct bt_mesh_net_rx *rx)
+{
+	bt_mesh_adv_send(buf, NULL, NULL);
+}
+#endif /* CONFIG_BT_MESH_RELAY_DEDUP */
+
 static void bt_mesh_net_relay(struct net_buf_simple *sbuf,
 			      struct bt_mesh_net_rx *rx)
 {
@@ -674,6 +776,12 @@ static void bt_mesh_net_relay(struct net_buf_simple *sbuf,
 	BT_DBG("TTL %u CTL %u dst 0x%04x", rx->ctx.recv_ttl, rx->ctl,
 	       rx->ctx.recv_dst);
 
+	if (relay_is_queued(rx)) {
+		BT_DBG("Relay of src 0x%04x seq 0x%06x already queued",
+		       rx->ctx.addr, rx->seq);
+		return;
+	}
+
 	/* The Relay Retransmit state is only applied to adv-adv relaying.
 	 * Anything else (like GATT to adv, or locally originated packets)
 	 * use the Network Transmit state.
@@ -727,7 +835,7 @@ static void bt_mesh_net_relay(struct net_buf_simple *sbuf,
 	}
 
 	if (relay_to_adv(rx->net_if) || rx->friend_cred) {
-		bt_mesh_adv_send(buf, NULL, NULL);
+		relay_send(buf, rx);
 	}
 
 done:
@@ -848,6 +956,7 @@ void bt_mesh_net_recv(struct net_buf_simple *data, int8_t rssi,
 	 */
 	if (bt_mesh_trans_recv(&buf, &rx) == -EAGAIN) {
 		BT_WARN("Removing rejected message from Network Message Cache");
+		msg_cache_unlink(rx.msg_cache_idx);
 		msg_cache[rx.msg_cache_idx].src = BT_MESH_ADDR_UNASSIGNED;
 		/* Rewind the next index now that we're not using this entry */
 		msg_cache_next = rx.msg_cache_idx;
@@ -39,11 +39,95 @@ static struct bt_mesh_rpl replay_list[CONFIG_BT_MESH_CRPL];
 static ATOMIC_DEFINE(store, CONFIG_BT_MESH_CRPL);
 static atomic_t clear;
 
+/* Hash chains over the replay list, keyed by source address. Both arrays
+ * hold an entry index + 1, with 0 marking the end of a chain.
+ */
+static uint16_t rpl_head[CONFIG_BT_MESH_RPL_HASH_SIZE];
+static uint16_t rpl_chain[CONFIG_BT_MESH_CRPL];
+
 static inline int rpl_idx(const struct bt_mesh_rpl *rpl)
 {
 	return rpl - &replay_list[0];
 }
 
+static uint16_t *rpl_bucket(uint16_t src)
+{
+	return &rpl_head[src % ARRAY_SIZE(rpl_head)];
+}
+
+static void rpl_hash_add(struct bt_mesh_rpl *rpl)
+{
+	uint16_t *head = rpl_bucket(rpl->src);
+
+	rpl_chain[rpl_idx(rpl)] = *head;
+	*head = rpl_idx(rpl) + 1;
+}
+
+static void rpl_hash_del(struct bt_mesh_rpl *rpl)
+{
+	uint16_t *next;
+
+	if (!rpl->src) {
+		return;
+	}
+
+	for (next = rpl_bucket(rpl->src); *next; next = &rpl_chain[*next - 1]) {
+		if (*next == rpl_idx(rpl) + 1) {
+			*next = rpl_chain[rpl_idx(rpl)];
+			return;
+		}
+	}
+}
+
+static void rpl_hash_rebuild(void)
+{
+	(void)memset(rpl_head, 0, sizeof(rpl_head));
+
+	for (int i = 0; i < ARRAY_SIZE(replay_list); i++) {
+		if (replay_list[i].src) {
+			rpl_hash_add(&replay_list[i]);
+		}
+	}
+}
+
+static struct bt_mesh_rpl *bt_mesh_rpl_find(uint16_t src)
+{
+	uint16_t i;
+
+	for (i = *rpl_bucket(src); i; i = rpl_chain[i - 1]) {
+		if (replay_list[i - 1].src == src) {
+			return &replay_list[i - 1];
+		}
+	}
+
+	return NULL;
+}
+
+static struct bt_mesh_rpl *rpl_free_find(void)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
+		if (!replay_list[i].src) {
+			return &replay_list[i];
+		}
+	}
+
+	return NULL;
+}
+
+static struct bt_mesh_rpl *bt_mesh_rpl_alloc(uint16_t src)
+{
+	struct bt_mesh_rpl *rpl = rpl_free_find();
+
+	if (rpl) {
+		rpl->src = src;
+		rpl_hash_add(rpl);
+	}
+
+	return rpl;
+}
+
 static void clear_rpl(struct bt_mesh_rpl *rpl)
 {
 	int err;
@@ -61,6 +145,7 @@ static void clear_rpl(struct bt_mesh_rpl *rpl)
 		BT_DBG("Cleared RPL");
 	}
 
+	rpl_hash_del(rpl);
 	(void)memset(rpl, 0, sizeof(*rpl));
 	atomic_clear_bit(store, rpl_idx(rpl));
 }
@@ -88,7 +173,12 @@ void bt_mesh_rpl_update(struct bt_mesh_rpl *rpl,
 		rpl->seg = 0;
 	}
 
-	rpl->src = rx->ctx.addr;
+	if (rpl->src != rx->ctx.addr) {
+		rpl_hash_del(rpl);
+		rpl->src = rx->ctx.addr;
+		rpl_hash_add(rpl);
+	}
+
 	rpl->seq = rx->seq;
 	rpl->old_iv = rx->old_iv;
 
@@ -105,7 +195,7 @@ void bt_mesh_rpl_update(struct bt_mesh_rpl *rpl,
 bool bt_mesh_rpl_check(struct bt_mesh_net_rx *rx,
 		struct bt_mesh_rpl **match)
 {
-	int i;
+	struct bt_mesh_rpl *rpl;
 
 	/* Don't bother checking messages from ourselves */
 	if (rx->net_if == BT_MESH_NET_IF_LOCAL) {
@@ -117,11 +207,15 @@ bool bt_mesh_rpl_check(struct bt_mesh_net_rx *rx,
 		return false;
 	}
 
-	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
-		struct bt_mesh_rpl *rpl = &replay_list[i];
+	/* Existing slot for given address */
+	rpl = bt_mesh_rpl_find(rx->ctx.addr);
+	if (rpl) {
+		if (rx->old_iv && !rpl->old_iv) {
+			return true;
+		}
 
-		/* Empty slot */
-		if (!rpl->src) {
+		if ((!rx->old_iv && rpl->old_iv) ||
+		    rpl->seq < rx->seq) {
 			if (match) {
 				*match = rpl;
 			} else {
@@ -129,27 +223,21 @@ bool bt_mesh_rpl_check(struct bt_mesh_net_rx *rx,
 			}
 
 			return false;
+		} else {
+			return true;
 		}
+	}
 
-		/* Existing slot for given address */
-		if (rpl->src == rx->ctx.addr) {
-			if (rx->old_iv && !rpl->old_iv) {
-				return true;
-			}
-
-			if ((!rx->old_iv && rpl->old_iv) ||
-			    rpl->seq < rx->seq) {
-				if (match) {
-					*match = rpl;
-				} else {
-					bt_mesh_rpl_update(rpl, rx);
-				}
-
-				return false;
-			} else {
-				return true;
-			}
+	/* Empty slot */
+	rpl = rpl_free_find();
+	if (rpl) {
+		if (match) {
+			*match = rpl;
+		} else {
+			bt_mesh_rpl_update(rpl, rx);
 		}
+
+		return false;
 	}
 
 	BT_ERR("RPL is full!");
@@ -162,6 +250,7 @@ void bt_mesh_rpl_clear(void)
 
 	if (!IS_ENABLED(CONFIG_BT_SETTINGS)) {
 		(void)memset(replay_list, 0, sizeof(replay_list));
+		(void)memset(rpl_head, 0, sizeof(rpl_head));
 		return;
 	}
 
@@ -170,38 +259,14 @@ void bt_mesh_rpl_clear(void)
 	bt_mesh_settings_store_schedule(BT_MESH_SETTINGS_RPL_PENDING);
 }
 
-static struct bt_mesh_rpl *bt_mesh_rpl_find(uint16_t src)
-{
-	int i;
-
-	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
-		if (replay_list[i].src == src) {
-			return &replay_list[i];
-		}
-	}
-
-	return NULL;
-}
-
-static struct bt_mesh_rpl *bt_mesh_rpl_alloc(uint16_t src)
-{
-	int i;
-
-	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
-		if (!replay_list[i].src) {
-			replay_list[i].src = src;
-			return &replay_list[i];
-		}
-	}
-
-	return NULL;
-}
-
 void bt_mesh_rpl_reset(void)
 {
 	int shift = 0;
 	int last = 0;
 
+	/* Entries are moved below, so the hash chains are rebuilt afterwards */
+	(void)memset(rpl_head, 0, sizeof(rpl_head));
+
 	/* Discard "old old" IV Index entries from RPL and flag
 	 * any other ones (which are valid) as old.
 	 */
@@ -234,6 +299,8 @@ void bt_mesh_rpl_reset(void)
 	}
 
 	(void) memset(&replay_list[last - shift + 1], 0, sizeof(struct bt_mesh_rpl) * shift);
+
+	rpl_hash_rebuild();
 }
 
 static int rpl_set(const char *name, size_t len_rd,
@@ -255,6 +322,7 @@ static int rpl_set(const char *name, size_t len_rd,
 	if (len_rd == 0) {
 		BT_DBG("val (null)");
 		if (entry) {
+			rpl_hash_del(entry);
 			(void)memset(entry, 0, sizeof(*entry));
 		} else {
 			BT_WARN("Unable to find RPL entry for 0x%04x", src);
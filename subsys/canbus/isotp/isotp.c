@@ -21,6 +21,9 @@ K_MEM_SLAB_DEFINE(ctx_slab, sizeof(struct isotp_send_ctx),
 
 static void receive_pool_free(struct net_buf *buf);
 static void receive_ff_sf_pool_free(struct net_buf *buf);
+#ifdef CONFIG_ISOTP_RX_USER_BUF
+static void receive_user_pool_free(struct net_buf *buf);
+#endif
 
 NET_BUF_POOL_DEFINE(isotp_rx_pool, CONFIG_ISOTP_RX_BUF_COUNT,
 		    CONFIG_ISOTP_RX_BUF_SIZE, sizeof(uint32_t),
@@ -29,6 +32,19 @@ NET_BUF_POOL_DEFINE(isotp_rx_pool, CONFIG_ISOTP_RX_BUF_COUNT,
 NET_BUF_POOL_DEFINE(isotp_rx_sf_ff_pool, CONFIG_ISOTP_RX_SF_FF_BUF_COUNT,
 		    ISOTP_CAN_DL, sizeof(uint32_t), receive_ff_sf_pool_free);
 
+#ifdef CONFIG_ISOTP_RX_USER_BUF
+/* User data of buffers pointing to a caller buffer */
+struct isotp_user_buf_ud {
+	/* Remaining length, as for the other RX buffers */
+	uint32_t rem_len;
+	struct isotp_recv_ctx *ctx;
+};
+
+/* Headers only, the data is the caller buffer of the context */
+NET_BUF_POOL_DEFINE(isotp_rx_user_pool, CONFIG_ISOTP_RX_USER_BUF_COUNT,
+		    0, sizeof(struct isotp_user_buf_ud), receive_user_pool_free);
+#endif
+
 static struct isotp_global_ctx global_ctx = {
 	.alloc_list = SYS_SLIST_STATIC_INIT(&global_ctx.alloc_list),
 	.ff_sf_alloc_list = SYS_SLIST_STATIC_INIT(&global_ctx.ff_sf_alloc_list)
@@ -57,6 +73,18 @@ static void receive_pool_free(struct net_buf *buf)
 	}
 }
 
+#ifdef CONFIG_ISOTP_RX_USER_BUF
+static void receive_user_pool_free(struct net_buf *buf)
+{
+	struct isotp_user_buf_ud *ud = net_buf_user_data(buf);
+
+	/* The context can reassemble the next message into its buffer */
+	ud->ctx->user_buf_busy = false;
+
+	receive_pool_free(buf);
+}
+#endif
+
 static void receive_ff_sf_pool_free(struct net_buf *buf)
 {
 	struct isotp_recv_ctx *ctx;
@@ -189,6 +217,50 @@ static inline struct net_buf *receive_alloc_buffer_chain(uint32_t len)
 	return buf;
 }
 
+#ifdef CONFIG_ISOTP_RX_USER_BUF
+static struct net_buf *receive_alloc_user_buffer(struct isotp_recv_ctx *ctx)
+{
+	struct isotp_user_buf_ud *ud;
+	struct net_buf *buf;
+
+	/* The previous message is still held by the application */
+	if (ctx->user_buf_busy) {
+		return NULL;
+	}
+
+	buf = net_buf_alloc_with_data(&isotp_rx_user_pool, ctx->user_buf,
+				      ctx->user_buf_size, K_NO_WAIT);
+	if (!buf) {
+		return NULL;
+	}
+
+	net_buf_simple_reset(&buf->b);
+	ud = net_buf_user_data(buf);
+	ud->ctx = ctx;
+	ctx->user_buf_busy = true;
+
+	/* Take over the FF payload, so the message is contiguous */
+	net_buf_add_mem(buf, ctx->buf->data, ctx->buf->len);
+
+	return buf;
+}
+
+static inline bool receive_uses_user_buf(struct isotp_recv_ctx *ctx)
+{
+	return ctx->user_buf != NULL;
+}
+#else
+static inline struct net_buf *receive_alloc_user_buffer(struct isotp_recv_ctx *ctx)
+{
+	return NULL;
+}
+
+static inline bool receive_uses_user_buf(struct isotp_recv_ctx *ctx)
+{
+	return false;
+}
+#endif
+
 static void receive_timeout_handler(struct _timeout *to)
 {
 	struct isotp_recv_ctx *ctx = CONTAINER_OF(to, struct isotp_recv_ctx,
@@ -212,7 +284,9 @@ static int receive_alloc_buffer(struct isotp_recv_ctx *ctx)
 {
 	struct net_buf *buf = NULL;
 
-	if (ctx->opts.bs == 0) {
+	if (receive_uses_user_buf(ctx)) {
+		buf = receive_alloc_user_buffer(ctx);
+	} else if (ctx->opts.bs == 0) {
 		/* Alloc all buffers because we can't wait during reception */
 		buf = receive_alloc_buffer_chain(ctx->length);
 	} else {
@@ -245,7 +319,11 @@ static int receive_alloc_buffer(struct isotp_recv_ctx *ctx)
 					  &ctx->alloc_node);
 	}
 
-	if (ctx->opts.bs != 0) {
+	if (receive_uses_user_buf(ctx)) {
+		/* The FF payload was copied, release its buffer */
+		net_buf_unref(ctx->buf);
+		ctx->buf = buf;
+	} else if (ctx->opts.bs != 0) {
 		ctx->buf = buf;
 	} else {
 		net_buf_frag_insert(ctx->buf, buf);
@@ -275,7 +353,18 @@ static void receive_state_machine(struct isotp_recv_ctx *ctx)
 		ctx->length = receive_get_ff_length(ctx->buf);
 		LOG_DBG("SM process FF. Length: %d", ctx->length);
 		ctx->length -= ctx->buf->len;
-		if (ctx->opts.bs == 0 &&
+#ifdef CONFIG_ISOTP_RX_USER_BUF
+		if (receive_uses_user_buf(ctx) &&
+		    ctx->length + ctx->buf->len > ctx->user_buf_size) {
+			LOG_ERR("Pkt length is %d but buffer has only %zu bytes",
+				ctx->length + ctx->buf->len,
+				ctx->user_buf_size);
+			receive_report_error(ctx, ISOTP_N_BUFFER_OVERFLW);
+			receive_state_machine(ctx);
+			break;
+		}
+#endif
+		if (ctx->opts.bs == 0 && !receive_uses_user_buf(ctx) &&
 		    ctx->length > CONFIG_ISOTP_RX_BUF_COUNT *
 		    CONFIG_ISOTP_RX_BUF_SIZE) {
 			LOG_ERR("Pkt length is %d but buffer has only %d bytes",
@@ -287,8 +376,8 @@ static void receive_state_machine(struct isotp_recv_ctx *ctx)
 			break;
 		}
 
-		if (ctx->opts.bs) {
-			ctx->bs = ctx->opts.bs;
+		ctx->bs = ctx->opts.bs;
+		if (ctx->opts.bs && !receive_uses_user_buf(ctx)) {
 			ud_rem_len = net_buf_user_data(ctx->buf);
 			*ud_rem_len = ctx->length;
 			net_buf_put(&ctx->fifo, ctx->buf);
@@ -519,8 +608,15 @@ static void process_cf(struct isotp_recv_ctx *ctx, struct can_frame *frame)
 	}
 
 	if (ctx->opts.bs && !--ctx->bs) {
-		LOG_DBG("Block is complete. Allocate new buffer");
 		ctx->bs = ctx->opts.bs;
+
+		if (receive_uses_user_buf(ctx)) {
+			LOG_DBG("Block is complete. Continue in place");
+			ctx->state = ISOTP_RX_STATE_SEND_FC;
+			return;
+		}
+
+		LOG_DBG("Block is complete. Allocate new buffer");
 		*ud_rem_len = ctx->length;
 		net_buf_put(&ctx->fifo, ctx->buf);
 		ctx->state = ISOTP_RX_STATE_TRY_ALLOC;
@@ -588,11 +684,11 @@ static inline int attach_ff_filter(struct isotp_recv_ctx *ctx)
 	return 0;
 }
 
-int isotp_bind(struct isotp_recv_ctx *ctx, const struct device *can_dev,
-	       const struct isotp_msg_id *rx_addr,
-	       const struct isotp_msg_id *tx_addr,
-	       const struct isotp_fc_opts *opts,
-	       k_timeout_t timeout)
+static int receive_bind(struct isotp_recv_ctx *ctx, const struct device *can_dev,
+			const struct isotp_msg_id *rx_addr,
+			const struct isotp_msg_id *tx_addr,
+			const struct isotp_fc_opts *opts,
+			k_timeout_t timeout)
 {
 	int ret;
 
@@ -636,6 +732,39 @@ int isotp_bind(struct isotp_recv_ctx *ctx, const struct device *can_dev,
 	return ISOTP_N_OK;
 }
 
+int isotp_bind(struct isotp_recv_ctx *ctx, const struct device *can_dev,
+	       const struct isotp_msg_id *rx_addr,
+	       const struct isotp_msg_id *tx_addr,
+	       const struct isotp_fc_opts *opts,
+	       k_timeout_t timeout)
+{
+#ifdef CONFIG_ISOTP_RX_USER_BUF
+	ctx->user_buf = NULL;
+	ctx->user_buf_size = 0;
+	ctx->user_buf_busy = false;
+#endif
+
+	return receive_bind(ctx, can_dev, rx_addr, tx_addr, opts, timeout);
+}
+
+#ifdef CONFIG_ISOTP_RX_USER_BUF
+int isotp_bind_buf(struct isotp_recv_ctx *ctx, const struct device *can_dev,
+		   const struct isotp_msg_id *rx_addr,
+		   const struct isotp_msg_id *tx_addr,
+		   const struct isotp_fc_opts *opts,
+		   uint8_t *buf, size_t buf_size,
+		   k_timeout_t timeout)
+{
+	__ASSERT(buf, "buf is NULL");
+
+	ctx->user_buf = buf;
+	ctx->user_buf_size = buf_size;
+	ctx->user_buf_busy = false;
+
+	return receive_bind(ctx, can_dev, rx_addr, tx_addr, opts, timeout);
+}
+#endif
+
 void isotp_unbind(struct isotp_recv_ctx *ctx)
 {
 	struct net_buf *buf;
@@ -0,0 +1,10 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+
+/* Frames of the coroutines of <zephyr/cpp/coro.hpp> */
+K_HEAP_DEFINE(z_cpp_coro_heap, CONFIG_CPP_COROUTINES_HEAP_SIZE);
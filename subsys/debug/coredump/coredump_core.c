@@ -5,6 +5,7 @@
  */
 
 #include <errno.h>
+#include <string.h>
 #include <kernel_internal.h>
 #include <zephyr/toolchain.h>
 #include <zephyr/debug/coredump.h>
@@ -55,6 +56,118 @@ static void dump_header(unsigned int reason)
 	backend_api->buffer_output((uint8_t *)&hdr, sizeof(hdr));
 }
 
+#ifdef CONFIG_DEBUG_COREDUMP_COMPRESSION
+/* Longest literal and repeated runs a control byte can describe */
+#define RLE_MAX_LITERAL		128
+#define RLE_MAX_RUN		(127 + COREDUMP_RLE_MIN_RUN)
+
+/* Encoded data is staged so the backend gets large buffers */
+#define RLE_OUT_SIZE		256
+
+static struct {
+	/* Control byte followed by the pending literal bytes */
+	uint8_t literal[1 + RLE_MAX_LITERAL];
+	size_t literal_len;
+
+	uint8_t out[RLE_OUT_SIZE];
+	size_t out_len;
+} rle;
+
+static void rle_emit(const uint8_t *buf, size_t len)
+{
+	if (rle.out_len + len > sizeof(rle.out)) {
+		coredump_buffer_output(rle.out, rle.out_len);
+		rle.out_len = 0;
+	}
+
+	(void)memcpy(&rle.out[rle.out_len], buf, len);
+	rle.out_len += len;
+}
+
+static void rle_flush_literal(void)
+{
+	if (rle.literal_len > 0) {
+		rle.literal[0] = (uint8_t)(rle.literal_len - 1);
+		rle_emit(rle.literal, 1 + rle.literal_len);
+		rle.literal_len = 0;
+	}
+}
+
+/*
+ * Each byte of the region is read once and copied, so the encoded data
+ * is a consistent snapshot even if the memory changes meanwhile (e.g.
+ * the stack of this thread).
+ */
+static void rle_memory_output(const uint8_t *src, size_t len)
+{
+	uint8_t token[2];
+	size_t i = 0;
+	size_t run;
+	uint8_t b;
+
+	rle.literal_len = 0;
+	rle.out_len = 0;
+
+	while (i < len) {
+		b = src[i];
+		run = 1;
+
+		while ((i + run < len) && (run < RLE_MAX_RUN) &&
+		       (src[i + run] == b)) {
+			run++;
+		}
+
+		if (run >= COREDUMP_RLE_MIN_RUN) {
+			rle_flush_literal();
+			token[0] = (uint8_t)(0x80 | (run - COREDUMP_RLE_MIN_RUN));
+			token[1] = b;
+			rle_emit(token, sizeof(token));
+		} else {
+			for (size_t j = 0; j < run; j++) {
+				rle.literal[1 + rle.literal_len] = b;
+				rle.literal_len++;
+				if (rle.literal_len == RLE_MAX_LITERAL) {
+					rle_flush_literal();
+				}
+			}
+		}
+
+		i += run;
+	}
+
+	rle_flush_literal();
+	coredump_buffer_output(rle.out, rle.out_len);
+}
+#endif /* CONFIG_DEBUG_COREDUMP_COMPRESSION */
+
+#ifdef CONFIG_DEBUG_COREDUMP_MEMORY_DUMP_THREADS
+static void dump_thread_memory(struct k_thread *thread)
+{
+	coredump_memory_dump(POINTER_TO_UINT(thread),
+			     POINTER_TO_UINT(thread) + sizeof(*thread));
+
+	coredump_memory_dump(thread->stack_info.start,
+			     thread->stack_info.start + thread->stack_info.size);
+}
+
+/*
+ * The kernel structure and the thread list let the debugger find every
+ * thread, so all of them can be examined without dumping the whole RAM.
+ */
+static void dump_all_threads(void)
+{
+	struct k_thread *thread;
+
+	coredump_memory_dump(POINTER_TO_UINT(&_kernel),
+			     POINTER_TO_UINT(&_kernel) + sizeof(_kernel));
+
+	for (thread = _kernel.threads; thread != NULL;
+	     thread = thread->next_thread) {
+		dump_thread_memory(thread);
+	}
+}
+#endif /* CONFIG_DEBUG_COREDUMP_MEMORY_DUMP_THREADS */
+
 static void dump_thread(struct k_thread *thread)
 {
 #ifdef CONFIG_DEBUG_COREDUMP_MEMORY_DUMP_MIN
@@ -108,6 +221,10 @@ void process_memory_region_list(void)
 	}
 #endif
 
+#ifdef CONFIG_DEBUG_COREDUMP_MEMORY_DUMP_THREADS
+	dump_all_threads();
+#endif
+
 #if defined(CONFIG_COREDUMP_DEVICE)
 #define MY_FN(inst) process_coredump_dev_memory(DEVICE_DT_INST_GET(inst));
 	DT_INST_FOREACH_STATUS_OKAY(MY_FN)
@@ -171,7 +288,8 @@ void coredump_memory_dump(uintptr_t start_addr, uintptr_t end_addr)
 	len = end_addr - start_addr;
 
 	m.id = COREDUMP_MEM_HDR_ID;
-	m.hdr_version = COREDUMP_MEM_HDR_VER;
+	m.hdr_version = IS_ENABLED(CONFIG_DEBUG_COREDUMP_COMPRESSION) ?
+			COREDUMP_MEM_HDR_VER_RLE : COREDUMP_MEM_HDR_VER;
 
 	if (sizeof(uintptr_t) == 8) {
 		m.start	= sys_cpu_to_le64(start_addr);
@@ -183,7 +301,11 @@ void coredump_memory_dump(uintptr_t start_addr, uintptr_t end_addr)
 
 	coredump_buffer_output((uint8_t *)&m, sizeof(m));
 
+#ifdef CONFIG_DEBUG_COREDUMP_COMPRESSION
+	rle_memory_output((const uint8_t *)start_addr, len);
+#else
 	coredump_buffer_output((uint8_t *)start_addr, len);
+#endif
 }
 
 int coredump_query(enum coredump_query_id query_id, void *arg)
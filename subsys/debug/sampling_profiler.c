@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/debug/sampling_profiler.h>
+#include <zephyr/shell/shell.h>
+#include <stdlib.h>
+
+#if defined(CONFIG_CPU_CORTEX_M)
+#include <zephyr/arch/arm/aarch32/cortex_m/cmsis.h>
+#endif
+
+static struct sampling_profiler_sample samples[CONFIG_SAMPLING_PROFILER_BUFFER_SIZE];
+static uint32_t sample_cnt;
+static uint32_t dropped_cnt;
+static bool active;
+static struct k_spinlock lock;
+
+static void sample_context(struct sampling_profiler_sample *sample)
+{
+	sample->thread = k_current_get();
+
+#if defined(CONFIG_CPU_CORTEX_M)
+	/* Threads run on the process stack, on exception entry the hardware
+	 * stacks r0-r3, r12, lr, pc and xpsr there. If the timer interrupt
+	 * preempted another interrupt, the sample is attributed to the
+	 * thread which was running before that interrupt.
+	 */
+	uint32_t *frame = (uint32_t *)__get_PSP();
+
+	sample->lr = frame[5];
+	sample->pc = frame[6];
+#else
+	sample->lr = 0;
+	sample->pc = 0;
+#endif
+}
+
+static void sample_timer_expiry(struct k_timer *timer)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (sample_cnt < ARRAY_SIZE(samples)) {
+		sample_context(&samples[sample_cnt++]);
+	} else {
+		dropped_cnt++;
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+static K_TIMER_DEFINE(sample_timer, sample_timer_expiry, NULL);
+
+int sampling_profiler_start(k_timeout_t period)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (active) {
+		k_spin_unlock(&lock, key);
+		return -EALREADY;
+	}
+
+	active = true;
+	k_spin_unlock(&lock, key);
+
+	k_timer_start(&sample_timer, period, period);
+
+	return 0;
+}
+
+void sampling_profiler_stop(void)
+{
+	k_timer_stop(&sample_timer);
+	active = false;
+}
+
+void sampling_profiler_reset(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	sample_cnt = 0;
+	dropped_cnt = 0;
+	k_spin_unlock(&lock, key);
+}
+
+int sampling_profiler_foreach(sampling_profiler_cb cb, void *user_data)
+{
+	if (active) {
+		return -EBUSY;
+	}
+
+	for (uint32_t i = 0; i < sample_cnt; i++) {
+		cb(&samples[i], user_data);
+	}
+
+	return sample_cnt;
+}
+
+uint32_t sampling_profiler_dropped_get(void)
+{
+	return dropped_cnt;
+}
+
+#if defined(CONFIG_SAMPLING_PROFILER_SHELL)
+static int cmd_start(const struct shell *sh, size_t argc, char **argv)
+{
+	uint32_t period_ms = CONFIG_SAMPLING_PROFILER_PERIOD_MS;
+	int err;
+
+	if (argc > 1) {
+		period_ms = strtoul(argv[1], NULL, 10);
+		if (period_ms == 0) {
+			shell_error(sh, "Invalid period: %s", argv[1]);
+			return -EINVAL;
+		}
+	}
+
+	err = sampling_profiler_start(K_MSEC(period_ms));
+	if (err < 0) {
+		shell_error(sh, "Sampling already active");
+		return err;
+	}
+
+	return 0;
+}
+
+static int cmd_stop(const struct shell *sh, size_t argc, char **argv)
+{
+	sampling_profiler_stop();
+
+	return 0;
+}
+
+static int cmd_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	sampling_profiler_reset();
+
+	return 0;
+}
+
+static void thread_print(const struct k_thread *thread, void *user_data)
+{
+	const struct shell *sh = user_data;
+	const char *name = k_thread_name_get((k_tid_t)thread);
+
+	shell_print(sh, "thread %p %s", thread, (name != NULL) ? name : "");
+}
+
+static void sample_print(const struct sampling_profiler_sample *sample,
+			 void *user_data)
+{
+	const struct shell *sh = user_data;
+
+	shell_print(sh, "sample %p 0x%lx 0x%lx", sample->thread,
+		    (unsigned long)sample->pc, (unsigned long)sample->lr);
+}
+
+/* The output is parsed by scripts/profiling/sampling_profiler.py. */
+static int cmd_dump(const struct shell *sh, size_t argc, char **argv)
+{
+	int cnt;
+
+	if (active) {
+		shell_error(sh, "Stop sampling first");
+		return -EBUSY;
+	}
+
+	k_thread_foreach(thread_print, (void *)sh);
+	cnt = sampling_profiler_foreach(sample_print, (void *)sh);
+	shell_print(sh, "samples %d dropped %u", cnt,
+		    sampling_profiler_dropped_get());
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_profiler,
+	SHELL_CMD_ARG(start, NULL, "Start sampling [period_ms]", cmd_start, 1, 1),
+	SHELL_CMD_ARG(stop, NULL, "Stop sampling", cmd_stop, 1, 0),
+	SHELL_CMD_ARG(reset, NULL, "Discard samples", cmd_reset, 1, 0),
+	SHELL_CMD_ARG(dump, NULL, "Print threads and samples", cmd_dump, 1, 0),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(profiler, &sub_profiler, "Sampling profiler", NULL);
+#endif /* CONFIG_SAMPLING_PROFILER_SHELL */
@@ -14,6 +14,7 @@
 #include <zephyr/debug/stack.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
+#include <zephyr/sys/ring_buffer.h>
 #include <stdio.h>
 
 LOG_MODULE_REGISTER(thread_analyzer, CONFIG_THREAD_ANALYZER_LOG_LEVEL);
@@ -36,6 +37,58 @@ LOG_MODULE_REGISTER(thread_analyzer, CONFIG_THREAD_ANALYZER_LOG_LEVEL);
  */
 #define PTR_STR_MAXLEN (sizeof(void *) * 2 + 2)
 
+#ifdef CONFIG_THREAD_ANALYZER_WATERMARK
+/* Number of analyzer runs, to schedule the full scans */
+static uint32_t run_count;
+
+/* The fill pattern is only ever overwritten, so the stack usage of a
+ * thread can only grow down from the lowest address previously found in
+ * use. Scan downward from there until enough untouched bytes are seen.
+ */
+static int stack_watermark_get(struct k_thread *thread, size_t *unused_ptr)
+{
+	uintptr_t start = thread->stack_info.start;
+	uintptr_t end = start + thread->stack_info.size;
+	uintptr_t mark = thread->stack_info.watermark;
+	size_t clean = 0;
+	int err;
+
+	if (IS_ENABLED(CONFIG_STACK_SENTINEL)) {
+		/* See z_stack_space_get() */
+		start += 4;
+	}
+
+	/* The stack bounds of a thread entering user mode may have changed
+	 * since its last scan, and the unused part of the stack we run on
+	 * may not be readable, fall back to a full scan in these cases.
+	 */
+	if ((mark < start) || (mark > end) || (thread == k_current_get()) ||
+	    ((CONFIG_THREAD_ANALYZER_WATERMARK_FULL_SCAN != 0) &&
+	     ((run_count % CONFIG_THREAD_ANALYZER_WATERMARK_FULL_SCAN) == 0U))) {
+		err = k_thread_stack_space_get(thread, unused_ptr);
+		if (err == 0) {
+			thread->stack_info.watermark = start + *unused_ptr;
+		}
+
+		return err;
+	}
+
+	for (uintptr_t p = mark; p > start; p--) {
+		if (*(const uint8_t *)(p - 1) != 0xaaU) {
+			mark = p - 1;
+			clean = 0;
+		} else if (++clean == CONFIG_THREAD_ANALYZER_WATERMARK_GUARD) {
+			break;
+		}
+	}
+
+	thread->stack_info.watermark = mark;
+	*unused_ptr = mark - start;
+
+	return 0;
+}
+#endif /* CONFIG_THREAD_ANALYZER_WATERMARK */
+
 static void thread_print_cb(struct thread_analyzer_info *info)
 {
 	size_t pcnt = (info->stack_used * 100U) / info->stack_size;
@@ -86,15 +139,17 @@ static void thread_analyze_cb(const struct k_thread *cthread, void *user_data)
 	size_t unused;
 	int err;
 
-
-
 	name = k_thread_name_get((k_tid_t)thread);
 	if (!name || name[0] == '\0') {
 		name = hexname;
 		snprintk(hexname, sizeof(hexname), "%p", (void *)thread);
 	}
 
+#ifdef CONFIG_THREAD_ANALYZER_WATERMARK
+	err = stack_watermark_get(thread, &unused);
+#else
 	err = k_thread_stack_space_get(thread, &unused);
+#endif
 	if (err) {
 		THREAD_ANALYZER_PRINT(
 			THREAD_ANALYZER_FMT(
@@ -105,6 +160,7 @@ static void thread_analyze_cb(const struct k_thread *cthread, void *user_data)
 	}
 
 	info.name = name;
+	info.thread = thread;
 	info.stack_size = size;
 	info.stack_used = size - unused;
 
@@ -150,6 +206,10 @@ static void isr_stacks(void)
 
 void thread_analyzer_run(thread_analyzer_cb cb)
 {
+#ifdef CONFIG_THREAD_ANALYZER_WATERMARK
+	run_count++;
+#endif
+
 	if (IS_ENABLED(CONFIG_THREAD_ANALYZER_RUN_UNLOCKED)) {
 		k_thread_foreach_unlocked(thread_analyze_cb, cb);
 	} else {
@@ -167,12 +227,59 @@ void thread_analyzer_print(void)
 	thread_analyzer_run(thread_print_cb);
 }
 
+#ifdef CONFIG_THREAD_ANALYZER_AUTO_RING_BUFFER
+
+RING_BUF_DECLARE(record_buf, CONFIG_THREAD_ANALYZER_AUTO_RING_BUFFER_SIZE);
+static struct k_spinlock record_lock;
+
+BUILD_ASSERT(CONFIG_THREAD_ANALYZER_AUTO_RING_BUFFER_SIZE >=
+	     sizeof(struct thread_analyzer_record),
+	     "Ring buffer too small to hold a record");
+
+static void thread_record_cb(struct thread_analyzer_info *info)
+{
+	struct thread_analyzer_record record = {
+		.thread = info->thread,
+		.uptime_ms = k_uptime_get_32(),
+		.stack_size = info->stack_size,
+		.stack_used = info->stack_used,
+#ifdef CONFIG_THREAD_RUNTIME_STATS
+		.utilization = info->utilization,
+#endif
+	};
+	k_spinlock_key_t key = k_spin_lock(&record_lock);
+
+	/* Make room by dropping the oldest record */
+	if (ring_buf_space_get(&record_buf) < sizeof(record)) {
+		(void)ring_buf_get(&record_buf, NULL, sizeof(record));
+	}
+
+	(void)ring_buf_put(&record_buf, (const uint8_t *)&record, sizeof(record));
+	k_spin_unlock(&record_lock, key);
+}
+
+int thread_analyzer_record_get(struct thread_analyzer_record *record)
+{
+	k_spinlock_key_t key = k_spin_lock(&record_lock);
+	uint32_t len = ring_buf_get(&record_buf, (uint8_t *)record, sizeof(*record));
+
+	k_spin_unlock(&record_lock, key);
+
+	return (len == sizeof(*record)) ? 0 : -EAGAIN;
+}
+
+#endif /* CONFIG_THREAD_ANALYZER_AUTO_RING_BUFFER */
+
 #if IS_ENABLED(CONFIG_THREAD_ANALYZER_AUTO)
 
 void thread_analyzer_auto(void)
 {
 	for (;;) {
+#ifdef CONFIG_THREAD_ANALYZER_AUTO_RING_BUFFER
+		thread_analyzer_run(thread_record_cb);
+#else
 		thread_analyzer_print();
+#endif
 		k_sleep(K_SECONDS(CONFIG_THREAD_ANALYZER_AUTO_INTERVAL));
 	}
 }
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Clock (second chance) eviction algorithm for demand paging
+ */
+#include <zephyr/kernel.h>
+#include <mmu.h>
+#include <kernel_arch_interface.h>
+#include <zephyr/init.h>
+
+/* The page frames form a circular list swept by a "hand". When a page
+ * frame needs to be evicted, the hand advances until it finds a frame
+ * whose accessed bit is clear. Accessed frames the hand passes over
+ * have the bit cleared, which gives them a second chance: they are
+ * only evicted if not touched again before the hand comes around.
+ *
+ * No periodic scan is needed. The hand clears accessed bits as it
+ * goes, so a selection inspects at most two full turns of the page
+ * frames, and in steady state only a few frames each time.
+ */
+static size_t clock_hand;
+
+struct z_page_frame *k_mem_paging_eviction_select(bool *dirty_ptr)
+{
+	struct z_page_frame *pf;
+	uintptr_t flags;
+
+	/* Two turns: the first may only clear accessed bits */
+	for (size_t n = 0; n < 2U * Z_NUM_PAGE_FRAMES; n++) {
+		pf = &z_page_frames[clock_hand];
+		clock_hand = (clock_hand + 1U) % Z_NUM_PAGE_FRAMES;
+
+		if (!z_page_frame_is_evictable(pf)) {
+			continue;
+		}
+
+		flags = arch_page_info_get(pf->addr, NULL, true);
+
+		/* Implies a mismatch with page frame ontology and page
+		 * tables
+		 */
+		__ASSERT((flags & ARCH_DATA_PAGE_LOADED) != 0U,
+			 "non-present page, %s",
+			 ((flags & ARCH_DATA_PAGE_NOT_MAPPED) != 0U) ?
+			 "un-mapped" : "paged out");
+
+		if ((flags & ARCH_DATA_PAGE_ACCESSED) == 0UL) {
+			*dirty_ptr = (flags & ARCH_DATA_PAGE_DIRTY) != 0UL;
+			return pf;
+		}
+	}
+
+	/* Shouldn't ever happen unless every page is pinned */
+	__ASSERT(false, "no page to evict");
+
+	return NULL;
+}
+
+void k_mem_paging_eviction_init(void)
+{
+}
@@ -57,6 +57,23 @@ struct mcuboot_v1_raw_header {
  * End of strict defines
  */
 
+#ifdef CONFIG_MCUBOOT_IMG_STATE_CACHE
+/*
+ * The image trailers only change through this API or through a slot erase,
+ * so the swap type and confirmation state are read from flash once and
+ * kept until one of those happens.
+ */
+struct img_state {
+	int swap_type;
+	bool swap_type_valid;
+};
+
+static struct img_state img_states[CONFIG_UPDATEABLE_IMAGE_NUMBER];
+static bool img_confirmed;
+static bool img_confirmed_valid;
+static K_MUTEX_DEFINE(img_state_lock);
+#endif /* CONFIG_MCUBOOT_IMG_STATE_CACHE */
+
 static int boot_read_v1_header(uint8_t area_id,
 			       struct mcuboot_v1_raw_header *v1_raw)
 {
@@ -144,15 +161,52 @@ int boot_read_bank_header(uint8_t area_id,
 	return 0;
 }
 
+void boot_img_state_invalidate(void)
+{
+#ifdef CONFIG_MCUBOOT_IMG_STATE_CACHE
+	k_mutex_lock(&img_state_lock, K_FOREVER);
+	for (int i = 0; i < ARRAY_SIZE(img_states); i++) {
+		img_states[i].swap_type_valid = false;
+	}
+	img_confirmed_valid = false;
+	k_mutex_unlock(&img_state_lock);
+#endif
+}
+
 int mcuboot_swap_type_multi(int image_index)
 {
+#ifdef CONFIG_MCUBOOT_IMG_STATE_CACHE
+	struct img_state *state;
+	int swap_type;
+
+	if (image_index < 0 || image_index >= ARRAY_SIZE(img_states)) {
+		return boot_swap_type_multi(image_index);
+	}
+
+	state = &img_states[image_index];
+
+	k_mutex_lock(&img_state_lock, K_FOREVER);
+	if (!state->swap_type_valid) {
+		state->swap_type = boot_swap_type_multi(image_index);
+		state->swap_type_valid = true;
+	}
+	swap_type = state->swap_type;
+	k_mutex_unlock(&img_state_lock);
+
+	return swap_type;
+#else
 	return boot_swap_type_multi(image_index);
+#endif
 }
 
 int mcuboot_swap_type(void)
 {
 #ifdef FLASH_AREA_IMAGE_SECONDARY
+#ifdef CONFIG_MCUBOOT_IMG_STATE_CACHE
+	return mcuboot_swap_type_multi(0);
+#else
 	return boot_swap_type();
+#endif
 #else
 	return BOOT_SWAP_TYPE_NONE;
 #endif
@@ -165,6 +219,7 @@ int boot_request_upgrade(int permanent)
 	int rc;
 
 	rc = boot_set_pending(permanent);
+	boot_img_state_invalidate();
 	if (rc) {
 		return -EFAULT;
 	}
@@ -177,13 +232,14 @@ int boot_request_upgrade_multi(int image_index, int permanent)
 	int rc;
 
 	rc = boot_set_pending_multi(image_index, permanent);
+	boot_img_state_invalidate();
 	if (rc) {
 		return -EFAULT;
 	}
 	return 0;
 }
 
-bool boot_is_img_confirmed(void)
+static bool boot_read_img_confirmed(void)
 {
 	const struct flash_area *fa;
 	int rc;
@@ -202,11 +258,40 @@ bool boot_is_img_confirmed(void)
 	return flag_val == BOOT_FLAG_SET;
 }
 
+bool boot_is_img_confirmed(void)
+{
+#ifdef CONFIG_MCUBOOT_IMG_STATE_CACHE
+	bool confirmed;
+
+	k_mutex_lock(&img_state_lock, K_FOREVER);
+	if (!img_confirmed_valid) {
+		img_confirmed = boot_read_img_confirmed();
+		img_confirmed_valid = true;
+	}
+	confirmed = img_confirmed;
+	k_mutex_unlock(&img_state_lock);
+
+	return confirmed;
+#else
+	return boot_read_img_confirmed();
+#endif
+}
+
 int boot_write_img_confirmed(void)
 {
 	int rc;
 
+#ifdef CONFIG_MCUBOOT_IMG_STATE_CACHE
+	/* Confirming an image that is already confirmed is a no-op, which
+	 * the cached state can answer without touching the trailer.
+	 */
+	if (boot_is_img_confirmed()) {
+		return 0;
+	}
+#endif
+
 	rc = boot_set_confirmed();
+	boot_img_state_invalidate();
 	if (rc) {
 		return -EIO;
 	}
@@ -219,6 +304,7 @@ int boot_write_img_confirmed_multi(int image_index)
 	int rc;
 
 	rc = boot_set_confirmed_multi(image_index);
+	boot_img_state_invalidate();
 	if (rc) {
 		return -EIO;
 	}
@@ -237,6 +323,7 @@ int boot_erase_img_bank(uint8_t area_id)
 	}
 
 	rc = flash_area_erase(fa, 0, fa->fa_size);
+	boot_img_state_invalidate();
 
 	flash_area_close(fa);
 
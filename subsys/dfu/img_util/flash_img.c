@@ -13,7 +13,8 @@
 #include <zephyr/storage/flash_map.h>
 #include <zephyr/storage/stream_flash.h>
 
-#ifdef CONFIG_IMG_ERASE_PROGRESSIVELY
+#if defined(CONFIG_IMG_ERASE_PROGRESSIVELY) || \
+	defined(CONFIG_MCUBOOT_IMG_STATE_CACHE)
 #include <zephyr/dfu/mcuboot.h>
 #endif
 
@@ -42,12 +43,103 @@ BUILD_ASSERT((CONFIG_IMG_BLOCK_BUF_SIZE % FLASH_WRITE_BLOCK_SIZE == 0),
 	     "FLASH_WRITE_BLOCK_SIZE");
 #endif
 
+#ifdef CONFIG_IMG_STREAMING_CHECK
+#define SHA256_DIGEST_SIZE 32
+
+static void img_hash_start(struct flash_img_context *ctx)
+{
+	ctx->hash_len = 0;
+	ctx->hash_done = false;
+
+#if defined(CONFIG_FLASH_AREA_CHECK_INTEGRITY_TC)
+	ctx->hash_rc = (tc_sha256_init(&ctx->sha) == TC_CRYPTO_SUCCESS) ?
+		       0 : -ESRCH;
+#else
+	mbedtls_sha256_init(&ctx->sha);
+	ctx->hash_rc = (mbedtls_sha256_starts(&ctx->sha, 0) == 0) ? 0 : -ESRCH;
+#endif
+}
+
+static void img_hash_update(struct flash_img_context *ctx, const uint8_t *data,
+			    size_t len)
+{
+	if ((ctx->hash_rc != 0) || (len == 0)) {
+		return;
+	}
+
+#if defined(CONFIG_FLASH_AREA_CHECK_INTEGRITY_TC)
+	if (tc_sha256_update(&ctx->sha, data, len) != TC_CRYPTO_SUCCESS) {
+		ctx->hash_rc = -ESRCH;
+	}
+#else
+	if (mbedtls_sha256_update(&ctx->sha, data, len) != 0) {
+		ctx->hash_rc = -ESRCH;
+	}
+#endif
+
+	ctx->hash_len += len;
+}
+
+static void img_hash_finish(struct flash_img_context *ctx, int write_rc)
+{
+	if (ctx->hash_rc == 0) {
+#if defined(CONFIG_FLASH_AREA_CHECK_INTEGRITY_TC)
+		if (tc_sha256_final(ctx->hash, &ctx->sha) != TC_CRYPTO_SUCCESS) {
+			ctx->hash_rc = -ESRCH;
+		}
+#else
+		if (mbedtls_sha256_finish(&ctx->sha, ctx->hash) != 0) {
+			ctx->hash_rc = -ESRCH;
+		}
+#endif
+	}
+
+#if !defined(CONFIG_FLASH_AREA_CHECK_INTEGRITY_TC)
+	mbedtls_sha256_free(&ctx->sha);
+#endif
+
+	ctx->hash_done = (ctx->hash_rc == 0) && (write_rc == 0);
+}
+
+#ifdef CONFIG_IMG_STREAMING_CHECK_READBACK
+/* The stream flash callback carries no context, the image being written is
+ * tracked here instead.
+ */
+static struct flash_img_context *readback_ctx;
+
+static int img_hash_readback_cb(uint8_t *buf, size_t len, size_t offset)
+{
+	ARG_UNUSED(offset);
+
+	img_hash_update(readback_ctx, buf, len);
+
+	return readback_ctx->hash_rc;
+}
+#define IMG_STREAM_CB img_hash_readback_cb
+#endif /* CONFIG_IMG_STREAMING_CHECK_READBACK */
+#endif /* CONFIG_IMG_STREAMING_CHECK */
+
+#ifndef IMG_STREAM_CB
+#define IMG_STREAM_CB NULL
+#endif
+
 int flash_img_buffered_write(struct flash_img_context *ctx, const uint8_t *data,
 			     size_t len, bool flush)
 {
 	int rc;
 
 	rc = stream_flash_buffered_write(&ctx->stream, data, len, flush);
+
+#if defined(CONFIG_IMG_STREAMING_CHECK)
+	if (!IS_ENABLED(CONFIG_IMG_STREAMING_CHECK_READBACK) && (rc == 0)) {
+		img_hash_update(ctx, data, len);
+	}
+
+	if (flush) {
+		img_hash_finish(ctx, rc);
+	}
+#endif
+
 	if (!flush) {
 		return rc;
 	}
@@ -61,6 +153,11 @@ int flash_img_buffered_write(struct flash_img_context *ctx, const uint8_t *data,
 	}
 #endif
 
+#ifdef CONFIG_MCUBOOT_IMG_STATE_CACHE
+	/* The slot trailer may have been overwritten by the new image */
+	boot_img_state_invalidate();
+#endif
+
 	flash_area_close(ctx->flash_area);
 	ctx->flash_area = NULL;
 
@@ -72,10 +169,12 @@ size_t flash_img_bytes_written(struct flash_img_context *ctx)
 	return stream_flash_bytes_written(&ctx->stream);
 }
 
-int flash_img_init_id(struct flash_img_context *ctx, uint8_t area_id)
+int flash_img_init_id_at(struct flash_img_context *ctx, uint8_t area_id,
+			 size_t offset)
 {
 	int rc;
 	const struct device *flash_dev;
+	struct flash_pages_info page;
 
 	rc = flash_area_open(area_id,
 			       (const struct flash_area **)&(ctx->flash_area));
@@ -85,9 +184,63 @@ int flash_img_init_id(struct flash_img_context *ctx, uint8_t area_id)
 
 	flash_dev = flash_area_get_device(ctx->flash_area);
 
-	return stream_flash_init(&ctx->stream, flash_dev, ctx->buf,
-			CONFIG_IMG_BLOCK_BUF_SIZE, ctx->flash_area->fa_off,
-			ctx->flash_area->fa_size, NULL);
+	if (offset >= ctx->flash_area->fa_size) {
+		rc = -EINVAL;
+		goto error;
+	}
+
+	/* Writing erases whole pages, so resuming in the middle of a page
+	 * would destroy the data already written to it.
+	 */
+	rc = flash_get_page_info_by_offs(flash_dev,
+					 ctx->flash_area->fa_off + offset,
+					 &page);
+	if (rc) {
+		goto error;
+	}
+
+	if (page.start_offset != ctx->flash_area->fa_off + offset) {
+		rc = -EINVAL;
+		goto error;
+	}
+
+#ifdef CONFIG_IMG_STREAMING_CHECK
+	ctx->area_id = area_id;
+	img_hash_start(ctx);
+	if (offset != 0) {
+		/* The data before the offset is not seen, the image can only be
+		 * checked by reading it back.
+		 */
+		ctx->hash_rc = -ENOTSUP;
+	}
+#ifdef CONFIG_IMG_STREAMING_CHECK_READBACK
+	readback_ctx = ctx;
+#endif
+#endif
+
+	rc = stream_flash_init(&ctx->stream, flash_dev, ctx->buf,
+			CONFIG_IMG_BLOCK_BUF_SIZE,
+			ctx->flash_area->fa_off + offset,
+			ctx->flash_area->fa_size - offset, IMG_STREAM_CB);
+
+#ifdef CONFIG_IMG_BLOCK_BUF_ASYNC
+	if (rc == 0) {
+		rc = stream_flash_async_enable(&ctx->stream, ctx->buf_alt);
+	}
+#endif
+
+	return rc;
+
+error:
+	flash_area_close(ctx->flash_area);
+	ctx->flash_area = NULL;
+
+	return rc;
+}
+
+int flash_img_init_id(struct flash_img_context *ctx, uint8_t area_id)
+{
+	return flash_img_init_id_at(ctx, area_id, 0);
 }
 
 int flash_img_init(struct flash_img_context *ctx)
@@ -107,6 +260,14 @@ int flash_img_check(struct flash_img_context *ctx,
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_IMG_STREAMING_CHECK
+	if (ctx->hash_done && (ctx->area_id == area_id) &&
+	    (fic->match != NULL) && (fic->clen == ctx->hash_len)) {
+		return memcmp(ctx->hash, fic->match, SHA256_DIGEST_SIZE) ?
+		       -EILSEQ : 0;
+	}
+#endif
+
 	rc = flash_area_open(area_id,
 			     (const struct flash_area **)&(ctx->flash_area));
 	if (rc) {
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/dfu/flash_img.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_REGISTER(flash_img_delta, CONFIG_IMG_MANAGER_LOG_LEVEL);
+
+#define DELTA_MAGIC		0x544c445aU	/* "ZDLT" */
+#define DELTA_HEADER_LEN	8
+#define DELTA_RECORD_LEN	12
+
+enum delta_state {
+	DELTA_HEADER,
+	DELTA_RECORD,
+	DELTA_DIFF,
+	DELTA_EXTRA,
+	DELTA_DONE,
+};
+
+/* Move on once the diff and extra data of a record have been consumed. */
+static void delta_record_done(struct flash_img_delta *d)
+{
+	d->src_off += d->seek;
+	d->state = (d->produced == d->target_size) ? DELTA_DONE : DELTA_RECORD;
+}
+
+static int delta_parse_header(struct flash_img_context *ctx)
+{
+	struct flash_img_delta *d = &ctx->delta;
+
+	if (sys_get_le32(&d->hdr[0]) != DELTA_MAGIC) {
+		LOG_ERR("Bad patch magic");
+		return -EINVAL;
+	}
+
+	d->target_size = sys_get_le32(&d->hdr[4]);
+	if (d->target_size > ctx->flash_area->fa_size) {
+		LOG_ERR("Image of %zu bytes does not fit", d->target_size);
+		return -EINVAL;
+	}
+
+	d->state = (d->target_size == 0) ? DELTA_DONE : DELTA_RECORD;
+
+	return 0;
+}
+
+static int delta_parse_record(struct flash_img_delta *d)
+{
+	d->diff_left = sys_get_le32(&d->hdr[0]);
+	d->extra_left = sys_get_le32(&d->hdr[4]);
+	d->seek = (int32_t)sys_get_le32(&d->hdr[8]);
+
+	if ((d->diff_left + d->extra_left) > (d->target_size - d->produced)) {
+		LOG_ERR("Record exceeds image size");
+		return -EINVAL;
+	}
+
+	if ((d->src_off < 0) ||
+	    ((d->src_off + d->diff_left) > d->source->fa_size)) {
+		LOG_ERR("Record exceeds source image");
+		return -EINVAL;
+	}
+
+	if (d->diff_left != 0) {
+		d->state = DELTA_DIFF;
+	} else if (d->extra_left != 0) {
+		d->state = DELTA_EXTRA;
+	} else {
+		delta_record_done(d);
+	}
+
+	return 0;
+}
+
+int flash_img_delta_init(struct flash_img_context *ctx, uint8_t area_id,
+			 uint8_t source_area_id)
+{
+	struct flash_img_delta *d = &ctx->delta;
+	int rc;
+
+	/* The source must stay intact while the new image is written */
+	if (area_id == source_area_id) {
+		return -EINVAL;
+	}
+
+	rc = flash_img_init_id(ctx, area_id);
+	if (rc) {
+		return rc;
+	}
+
+	memset(d, 0, sizeof(*d));
+	d->state = DELTA_HEADER;
+
+	return flash_area_open(source_area_id, &d->source);
+}
+
+int flash_img_delta_write(struct flash_img_context *ctx, const uint8_t *data,
+			  size_t len, bool flush)
+{
+	struct flash_img_delta *d = &ctx->delta;
+	size_t need;
+	size_t n;
+	int rc = 0;
+
+	while ((len > 0) && (rc == 0)) {
+		switch (d->state) {
+		case DELTA_HEADER:
+		case DELTA_RECORD:
+			need = (d->state == DELTA_HEADER) ?
+			       DELTA_HEADER_LEN : DELTA_RECORD_LEN;
+			n = MIN(len, need - d->hdr_len);
+			memcpy(&d->hdr[d->hdr_len], data, n);
+			d->hdr_len += n;
+
+			if (d->hdr_len == need) {
+				d->hdr_len = 0;
+				rc = (d->state == DELTA_HEADER) ?
+				     delta_parse_header(ctx) :
+				     delta_parse_record(d);
+			}
+			break;
+		case DELTA_DIFF:
+			n = MIN(len, MIN(d->diff_left, sizeof(d->src_buf)));
+			rc = flash_area_read(d->source, d->src_off, d->src_buf,
+					     n);
+			if (rc) {
+				break;
+			}
+
+			for (size_t i = 0; i < n; i++) {
+				d->src_buf[i] += data[i];
+			}
+
+			rc = flash_img_buffered_write(ctx, d->src_buf, n, false);
+			d->src_off += n;
+			d->diff_left -= n;
+			d->produced += n;
+
+			if (d->diff_left == 0) {
+				if (d->extra_left != 0) {
+					d->state = DELTA_EXTRA;
+				} else {
+					delta_record_done(d);
+				}
+			}
+			break;
+		case DELTA_EXTRA:
+			n = MIN(len, d->extra_left);
+			rc = flash_img_buffered_write(ctx, data, n, false);
+			d->extra_left -= n;
+			d->produced += n;
+
+			if (d->extra_left == 0) {
+				delta_record_done(d);
+			}
+			break;
+		default:
+			LOG_ERR("Data past the end of the patch");
+			rc = -EINVAL;
+			n = len;
+			break;
+		}
+
+		data += n;
+		len -= n;
+	}
+
+	if (!flush) {
+		return rc;
+	}
+
+	if ((rc == 0) && (d->state != DELTA_DONE)) {
+		LOG_ERR("Patch is truncated");
+		rc = -EINVAL;
+	}
+
+	if (rc == 0) {
+		rc = flash_img_buffered_write(ctx, d->src_buf, 0, true);
+	}
+
+	flash_area_close(d->source);
+	d->source = NULL;
+
+	return rc;
+}
@@ -23,6 +23,341 @@ static sys_dlist_t disk_access_list;
 /* lock to protect storage layer registration */
 static struct k_mutex mutex;
 
+#ifdef CONFIG_DISK_ACCESS_CACHE
+#define CACHE_SECTOR_SIZE CONFIG_DISK_ACCESS_CACHE_SECTOR_SIZE
+#define CACHE_XFER_SECTORS CONFIG_DISK_ACCESS_CACHE_READ_AHEAD
+
+BUILD_ASSERT(CONFIG_DISK_ACCESS_CACHE_READ_AHEAD <=
+	     CONFIG_DISK_ACCESS_CACHE_SECTORS,
+	     "Read-ahead must not exceed the number of cached sectors");
+
+struct disk_cache_entry {
+	sys_dnode_t node;
+	/* Disk the sector belongs to, NULL if the entry is unused */
+	struct disk_info *disk;
+	uint32_t sector;
+	bool dirty;
+	uint8_t data[CACHE_SECTOR_SIZE] __aligned(4);
+};
+
+static struct disk_cache_entry cache_entries[CONFIG_DISK_ACCESS_CACHE_SECTORS];
+
+/* Most recently used entries first, unused entries at the tail */
+static sys_dlist_t cache_lru;
+
+/* Bounce buffer for multi-sector transfers to and from the cache */
+static uint8_t cache_xfer[CACHE_XFER_SECTORS * CACHE_SECTOR_SIZE] __aligned(4);
+
+/* lock to protect the cache, also serializes access to cached disks */
+static struct k_mutex cache_mutex;
+
+static bool disk_cache_usable(struct disk_info *disk)
+{
+	uint32_t sector_size;
+	uint32_t sector_cnt;
+
+	if (disk->cache_probed) {
+		return disk->cache_sector_cnt != 0U;
+	}
+
+	disk->cache_probed = true;
+	disk->cache_sector_cnt = 0U;
+	disk->cache_next_sector = UINT32_MAX;
+
+	if ((disk->ops->ioctl == NULL) ||
+	    (disk->ops->ioctl(disk, DISK_IOCTL_GET_SECTOR_SIZE,
+			      &sector_size) != 0) ||
+	    (sector_size != CACHE_SECTOR_SIZE) ||
+	    (disk->ops->ioctl(disk, DISK_IOCTL_GET_SECTOR_COUNT,
+			      &sector_cnt) != 0)) {
+		LOG_DBG("disk(%s) not cached", disk->name);
+		return false;
+	}
+
+	disk->cache_sector_cnt = sector_cnt;
+
+	return true;
+}
+
+static struct disk_cache_entry *disk_cache_find(struct disk_info *disk,
+						uint32_t sector)
+{
+	struct disk_cache_entry *entry;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&cache_lru, entry, node) {
+		if ((entry->disk == disk) && (entry->sector == sector)) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+static void disk_cache_touch(struct disk_cache_entry *entry)
+{
+	sys_dlist_remove(&entry->node);
+	sys_dlist_prepend(&cache_lru, &entry->node);
+}
+
+static void disk_cache_drop(struct disk_cache_entry *entry)
+{
+	entry->disk = NULL;
+	entry->dirty = false;
+	sys_dlist_remove(&entry->node);
+	sys_dlist_append(&cache_lru, &entry->node);
+}
+
+/*
+ * Writes all dirty sectors of the disk, in ascending order, combining runs of
+ * adjacent sectors into a single disk write.
+ */
+static int disk_cache_flush(struct disk_info *disk)
+{
+	struct disk_cache_entry *entry;
+	struct disk_cache_entry *first;
+	uint32_t sector;
+	uint32_t cnt;
+	int rc;
+
+	while (true) {
+		first = NULL;
+		SYS_DLIST_FOR_EACH_CONTAINER(&cache_lru, entry, node) {
+			if (entry->dirty && (entry->disk == disk) &&
+			    ((first == NULL) || (entry->sector < first->sector))) {
+				first = entry;
+			}
+		}
+
+		if (first == NULL) {
+			return 0;
+		}
+
+		sector = first->sector;
+		cnt = 0U;
+		entry = first;
+		do {
+			memcpy(&cache_xfer[cnt * CACHE_SECTOR_SIZE], entry->data,
+			       CACHE_SECTOR_SIZE);
+			entry->dirty = false;
+			cnt++;
+			entry = disk_cache_find(disk, sector + cnt);
+		} while ((cnt < CACHE_XFER_SECTORS) && (entry != NULL) &&
+			 entry->dirty);
+
+		rc = disk->ops->write(disk, cache_xfer, sector, cnt);
+		if (rc != 0) {
+			LOG_ERR("disk(%s) sector %u write back failed (%d)",
+				disk->name, sector, rc);
+			while (cnt-- > 0U) {
+				disk_cache_find(disk, sector + cnt)->dirty = true;
+			}
+			return rc;
+		}
+	}
+}
+
+static void disk_cache_invalidate(struct disk_info *disk)
+{
+	struct disk_cache_entry *entry;
+	struct disk_cache_entry *next;
+
+	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&cache_lru, entry, next, node) {
+		if (entry->disk == disk) {
+			disk_cache_drop(entry);
+		}
+	}
+
+	disk->cache_probed = false;
+}
+
+/* Takes the least recently used entry into use, writing it back if dirty */
+static int disk_cache_alloc(struct disk_info *disk, uint32_t sector,
+			    struct disk_cache_entry **entryp)
+{
+	struct disk_cache_entry *entry;
+	int rc;
+
+	entry = SYS_DLIST_PEEK_TAIL_CONTAINER(&cache_lru, entry, node);
+	if (entry->dirty) {
+		rc = disk_cache_flush(entry->disk);
+		if (rc != 0) {
+			return rc;
+		}
+	}
+
+	entry->disk = disk;
+	entry->sector = sector;
+	entry->dirty = false;
+	disk_cache_touch(entry);
+	*entryp = entry;
+
+	return 0;
+}
+
+static int disk_cache_fill(struct disk_info *disk, uint32_t sector,
+			   uint32_t cnt)
+{
+	struct disk_cache_entry *entries[CACHE_XFER_SECTORS];
+	uint32_t i;
+	int rc = 0;
+
+	/* Entries are taken first, as writing back evicted ones uses cache_xfer */
+	for (i = 0U; (i < cnt) && (rc == 0); i++) {
+		rc = disk_cache_alloc(disk, sector + i, &entries[i]);
+	}
+
+	if (rc == 0) {
+		rc = disk->ops->read(disk, cache_xfer, sector, cnt);
+	}
+
+	while (i-- > 0U) {
+		if (rc == 0) {
+			memcpy(entries[i]->data, &cache_xfer[i * CACHE_SECTOR_SIZE],
+			       CACHE_SECTOR_SIZE);
+		} else {
+			disk_cache_drop(entries[i]);
+		}
+	}
+
+	return rc;
+}
+
+static int disk_cache_read(struct disk_info *disk, uint8_t *data_buf,
+			   uint32_t start_sector, uint32_t num_sector)
+{
+	struct disk_cache_entry *entry;
+	uint32_t end = start_sector + num_sector;
+	uint32_t sector = start_sector;
+	bool sequential;
+	uint32_t cnt;
+	int rc;
+
+	if ((end > disk->cache_sector_cnt) || (end < start_sector)) {
+		/* Let the driver report out of bounds access */
+		return disk->ops->read(disk, data_buf, start_sector, num_sector);
+	}
+
+	sequential = (start_sector == disk->cache_next_sector);
+	disk->cache_next_sector = end;
+
+	while (sector < end) {
+		entry = disk_cache_find(disk, sector);
+		if (entry != NULL) {
+			memcpy(data_buf, entry->data, CACHE_SECTOR_SIZE);
+			disk_cache_touch(entry);
+			data_buf += CACHE_SECTOR_SIZE;
+			sector++;
+			continue;
+		}
+
+		cnt = 1U;
+		while ((sector + cnt < end) &&
+		       (disk_cache_find(disk, sector + cnt) == NULL)) {
+			cnt++;
+		}
+
+		if (cnt > CACHE_XFER_SECTORS) {
+			/* None of these sectors are cached, read them directly */
+			rc = disk->ops->read(disk, data_buf, sector, cnt);
+			if (rc != 0) {
+				return rc;
+			}
+			data_buf += cnt * CACHE_SECTOR_SIZE;
+			sector += cnt;
+			continue;
+		}
+
+		if (sequential) {
+			/* Read ahead up to the next cached sector */
+			while ((cnt < CACHE_XFER_SECTORS) &&
+			       (sector + cnt < disk->cache_sector_cnt) &&
+			       (disk_cache_find(disk, sector + cnt) == NULL)) {
+				cnt++;
+			}
+		}
+
+		rc = disk_cache_fill(disk, sector, cnt);
+		if (rc != 0) {
+			return rc;
+		}
+
+		cnt = MIN(cnt, end - sector);
+		memcpy(data_buf, cache_xfer, cnt * CACHE_SECTOR_SIZE);
+		data_buf += cnt * CACHE_SECTOR_SIZE;
+		sector += cnt;
+	}
+
+	return 0;
+}
+
+static int disk_cache_write(struct disk_info *disk, const uint8_t *data_buf,
+			    uint32_t start_sector, uint32_t num_sector)
+{
+	struct disk_cache_entry *entry;
+	struct disk_cache_entry *next;
+	uint32_t end = start_sector + num_sector;
+	uint32_t i;
+	int rc;
+
+	if (!IS_ENABLED(CONFIG_DISK_ACCESS_CACHE_WRITE_BACK) ||
+	    (num_sector > CACHE_XFER_SECTORS) ||
+	    (end > disk->cache_sector_cnt) || (end < start_sector)) {
+		rc = disk->ops->write(disk, data_buf, start_sector, num_sector);
+
+		/* Keep cached copies coherent, they are superseded if dirty */
+		SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&cache_lru, entry, next, node) {
+			if ((entry->disk != disk) || (entry->sector < start_sector) ||
+			    (entry->sector >= end)) {
+				continue;
+			}
+
+			if (rc != 0) {
+				disk_cache_drop(entry);
+				continue;
+			}
+
+			memcpy(entry->data,
+			       &data_buf[(entry->sector - start_sector) *
+					 CACHE_SECTOR_SIZE],
+			       CACHE_SECTOR_SIZE);
+			entry->dirty = false;
+		}
+
+		return rc;
+	}
+
+	for (i = 0U; i < num_sector; i++) {
+		entry = disk_cache_find(disk, start_sector + i);
+		if (entry == NULL) {
+			rc = disk_cache_alloc(disk, start_sector + i, &entry);
+			if (rc != 0) {
+				return rc;
+			}
+		} else {
+			disk_cache_touch(entry);
+		}
+
+		memcpy(entry->data, &data_buf[i * CACHE_SECTOR_SIZE],
+		       CACHE_SECTOR_SIZE);
+		entry->dirty = true;
+	}
+
+	return 0;
+}
+
+static void disk_cache_init(void)
+{
+	int i;
+
+	k_mutex_init(&cache_mutex);
+	sys_dlist_init(&cache_lru);
+
+	for (i = 0; i < ARRAY_SIZE(cache_entries); i++) {
+		sys_dlist_append(&cache_lru, &cache_entries[i].node);
+	}
+}
+#endif /* CONFIG_DISK_ACCESS_CACHE */
+
 struct disk_info *disk_access_get_di(const char *name)
 {
 	struct disk_info *disk = NULL, *itr;
@@ -60,6 +395,13 @@ int disk_access_init(const char *pdrv)
 
 	if ((disk != NULL) && (disk->ops != NULL) &&
 				(disk->ops->init != NULL)) {
+#ifdef CONFIG_DISK_ACCESS_CACHE
+		/* The media may have changed, start over with an empty cache */
+		k_mutex_lock(&cache_mutex, K_FOREVER);
+		(void)disk_cache_flush(disk);
+		disk_cache_invalidate(disk);
+		k_mutex_unlock(&cache_mutex);
+#endif
 		rc = disk->ops->init(disk);
 	}
 
@@ -87,7 +429,19 @@ int disk_access_read(const char *pdrv, uint8_t *data_buf,
 
 	if ((disk != NULL) && (disk->ops != NULL) &&
 				(disk->ops->read != NULL)) {
+#ifdef CONFIG_DISK_ACCESS_CACHE
+		k_mutex_lock(&cache_mutex, K_FOREVER);
+		if (disk_cache_usable(disk)) {
+			rc = disk_cache_read(disk, data_buf, start_sector,
+					     num_sector);
+		} else {
+			rc = disk->ops->read(disk, data_buf, start_sector,
+					     num_sector);
+		}
+		k_mutex_unlock(&cache_mutex);
+#else
 		rc = disk->ops->read(disk, data_buf, start_sector, num_sector);
+#endif
 	}
 
 	return rc;
@@ -101,7 +455,19 @@ int disk_access_write(const char *pdrv, const uint8_t *data_buf,
 
 	if ((disk != NULL) && (disk->ops != NULL) &&
 				(disk->ops->write != NULL)) {
+#ifdef CONFIG_DISK_ACCESS_CACHE
+		k_mutex_lock(&cache_mutex, K_FOREVER);
+		if (disk_cache_usable(disk)) {
+			rc = disk_cache_write(disk, data_buf, start_sector,
+					      num_sector);
+		} else {
+			rc = disk->ops->write(disk, data_buf, start_sector,
+					      num_sector);
+		}
+		k_mutex_unlock(&cache_mutex);
+#else
 		rc = disk->ops->write(disk, data_buf, start_sector, num_sector);
+#endif
 	}
 
 	return rc;
@@ -114,12 +480,151 @@ int disk_access_ioctl(const char *pdrv, uint8_t cmd, void *buf)
 
 	if ((disk != NULL) && (disk->ops != NULL) &&
 				(disk->ops->ioctl != NULL)) {
+#ifdef CONFIG_DISK_ACCESS_CACHE
+		if (cmd == DISK_IOCTL_CTRL_SYNC) {
+			k_mutex_lock(&cache_mutex, K_FOREVER);
+			rc = disk_cache_flush(disk);
+			k_mutex_unlock(&cache_mutex);
+			if (rc != 0) {
+				return rc;
+			}
+		}
+#endif
 		rc = disk->ops->ioctl(disk, cmd, buf);
 	}
 
 	return rc;
 }
 
+#ifdef CONFIG_DISK_ACCESS_ASYNC
+static sys_slist_t async_queue;
+static struct k_spinlock async_lock;
+static K_SEM_DEFINE(async_sem, 0, K_SEM_MAX_LIMIT);
+
+static bool disk_access_req_adjacent(const struct disk_access_req *req,
+				     const struct disk_access_req *next,
+				     uint32_t num_sector)
+{
+	return (next->op == req->op) &&
+	       (strcmp(next->pdrv, req->pdrv) == 0) &&
+	       (next->start_sector == req->start_sector + num_sector) &&
+	       (num_sector + next->num_sector <=
+		CONFIG_DISK_ACCESS_ASYNC_MAX_SECTORS);
+}
+
+/*
+ * Takes the oldest request off the queue, together with the queued requests
+ * that directly follow it on the disk and in memory.
+ */
+static uint32_t disk_access_async_get(sys_slist_t *batch,
+				      uint32_t *sector_size)
+{
+	struct disk_access_req *req;
+	struct disk_access_req *next;
+	k_spinlock_key_t key;
+	uint32_t num_sector;
+
+	k_sem_take(&async_sem, K_FOREVER);
+
+	key = k_spin_lock(&async_lock);
+	req = CONTAINER_OF(sys_slist_get_not_empty(&async_queue),
+			   struct disk_access_req, node);
+	k_spin_unlock(&async_lock, key);
+
+	sys_slist_append(batch, &req->node);
+	num_sector = req->num_sector;
+
+	if (disk_access_ioctl(req->pdrv, DISK_IOCTL_GET_SECTOR_SIZE,
+			      sector_size) != 0) {
+		return num_sector;
+	}
+
+	key = k_spin_lock(&async_lock);
+	while (true) {
+		next = SYS_SLIST_PEEK_HEAD_CONTAINER(&async_queue, next, node);
+		if ((next == NULL) ||
+		    !disk_access_req_adjacent(req, next, num_sector) ||
+		    (next->data_buf != req->data_buf + num_sector * *sector_size) ||
+		    (k_sem_take(&async_sem, K_NO_WAIT) != 0)) {
+			break;
+		}
+
+		(void)sys_slist_get_not_empty(&async_queue);
+		sys_slist_append(batch, &next->node);
+		num_sector += next->num_sector;
+	}
+	k_spin_unlock(&async_lock, key);
+
+	return num_sector;
+}
+
+static void disk_access_async_thread(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	struct disk_access_req *req;
+	sys_slist_t batch;
+	uint32_t sector_size;
+	uint32_t num_sector;
+	int rc;
+
+	while (true) {
+		sys_slist_init(&batch);
+		num_sector = disk_access_async_get(&batch, &sector_size);
+
+		req = SYS_SLIST_PEEK_HEAD_CONTAINER(&batch, req, node);
+		if (num_sector != req->num_sector) {
+			LOG_DBG("disk(%s) merged %u sectors from %u",
+				req->pdrv, num_sector, req->start_sector);
+		}
+
+		if (req->op == DISK_ACCESS_OP_READ) {
+			rc = disk_access_read(req->pdrv, req->data_buf,
+					      req->start_sector, num_sector);
+		} else {
+			rc = disk_access_write(req->pdrv, req->data_buf,
+					       req->start_sector, num_sector);
+		}
+
+		while ((req = SYS_SLIST_CONTAINER(sys_slist_get(&batch), req,
+						  node)) != NULL) {
+			req->result = rc;
+			req->cb(req);
+		}
+	}
+}
+
+K_THREAD_DEFINE(disk_access_async, CONFIG_DISK_ACCESS_ASYNC_STACK_SIZE,
+		disk_access_async_thread, NULL, NULL, NULL,
+		CONFIG_DISK_ACCESS_ASYNC_PRIO, 0, 0);
+
+int disk_access_submit(struct disk_access_req *req)
+{
+	k_spinlock_key_t key;
+
+	if ((req == NULL) || (req->pdrv == NULL) || (req->cb == NULL) ||
+	    (req->data_buf == NULL) || (req->num_sector == 0U) ||
+	    ((req->op != DISK_ACCESS_OP_READ) &&
+	     (req->op != DISK_ACCESS_OP_WRITE))) {
+		return -EINVAL;
+	}
+
+	if (disk_access_get_di(req->pdrv) == NULL) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&async_lock);
+	sys_slist_append(&async_queue, &req->node);
+	k_spin_unlock(&async_lock, key);
+
+	k_sem_give(&async_sem);
+
+	return 0;
+}
+#endif /* CONFIG_DISK_ACCESS_ASYNC */
+
 int disk_access_register(struct disk_info *disk)
 {
 	int rc = 0;
@@ -161,6 +666,12 @@ int disk_access_unregister(struct disk_info *disk)
 		rc = -EINVAL;
 		goto unreg_err;
 	}
+#ifdef CONFIG_DISK_ACCESS_CACHE
+	k_mutex_lock(&cache_mutex, K_FOREVER);
+	(void)disk_cache_flush(disk);
+	disk_cache_invalidate(disk);
+	k_mutex_unlock(&cache_mutex);
+#endif
 	/* remove disk node from the list */
 	sys_dlist_remove(&disk->node);
 	LOG_DBG("disk interface(%s) unregistered", disk->name);
@@ -175,6 +686,9 @@ static int disk_init(const struct device *dev)
 
 	k_mutex_init(&mutex);
 	sys_dlist_init(&disk_access_list);
+#ifdef CONFIG_DISK_ACCESS_CACHE
+	disk_cache_init();
+#endif
 	return 0;
 }
 
@@ -23,10 +23,21 @@ static inline uint8_t byte_reverse(uint8_t b)
 	return b;
 }
 
+/** Columns of a tile row modified since the last finalize, [x0, x1) */
+struct cfb_dirty_span {
+	uint16_t x0;
+	uint16_t x1;
+};
+
 struct char_framebuffer {
 	/** Pointer to a buffer in RAM */
 	uint8_t *buf;
 
+#ifdef CONFIG_CHARACTER_FRAMEBUFFER_PARTIAL_UPDATE
+	/** Dirty columns of each tile row */
+	struct cfb_dirty_span *dirty;
+#endif
+
 	/** Size of the framebuffer */
 	uint32_t size;
 
@@ -63,6 +74,36 @@ struct char_framebuffer {
 
 static struct char_framebuffer char_fb;
 
+#ifdef CONFIG_CHARACTER_FRAMEBUFFER_PARTIAL_UPDATE
+/*
+ * Modified areas are merged into the dirty span of each tile row they
+ * cover, a tile row being contiguous in the vertically tiled framebuffer.
+ */
+static void cfb_mark_dirty(const struct char_framebuffer *fb, uint16_t x,
+			   uint16_t y, uint16_t width, uint16_t height)
+{
+	uint16_t x1 = MIN(x + width, fb->x_res);
+	uint16_t row_end = DIV_ROUND_UP(MIN(y + height, fb->y_res), fb->ppt);
+
+	for (uint16_t row = y / fb->ppt; row < row_end; row++) {
+		struct cfb_dirty_span *span = &fb->dirty[row];
+
+		if (span->x0 >= span->x1) {
+			span->x0 = x;
+			span->x1 = x1;
+		} else {
+			span->x0 = MIN(span->x0, x);
+			span->x1 = MAX(span->x1, x1);
+		}
+	}
+}
+#else
+static inline void cfb_mark_dirty(const struct char_framebuffer *fb, uint16_t x,
+				  uint16_t y, uint16_t width, uint16_t height)
+{
+}
+#endif
+
 static inline uint8_t *get_glyph_ptr(const struct cfb_font *fptr, char c)
 {
 	return (uint8_t *)fptr->data +
@@ -104,6 +145,8 @@ static uint8_t draw_char_vtmono(const struct char_framebuffer *fb,
 		return 0;
 	}
 
+	cfb_mark_dirty(fb, x, y, fptr->width, fptr->height);
+
 	for (size_t g_x = 0; g_x < fptr->width; g_x++) {
 		uint32_t y_segment = y / 8U;
 
@@ -187,6 +230,8 @@ int cfb_invert_area(const struct device *dev, uint16_t x, uint16_t y,
 			}
 		}
 
+		cfb_mark_dirty(fb, x, y, width, height);
+
 		return 0;
 	}
 
@@ -194,15 +239,6 @@ int cfb_invert_area(const struct device *dev, uint16_t x, uint16_t y,
 	return -EINVAL;
 }
 
-static int cfb_invert(const struct char_framebuffer *fb)
-{
-	for (size_t i = 0; i < fb->x_res * fb->y_res / 8U; i++) {
-		fb->buf[i] = ~fb->buf[i];
-	}
-
-	return 0;
-}
-
 int cfb_framebuffer_clear(const struct device *dev, bool clear_display)
 {
 	const struct char_framebuffer *fb = &char_fb;
@@ -217,6 +253,7 @@ int cfb_framebuffer_clear(const struct device *dev, bool clear_display)
 	desc.height = fb->y_res;
 	desc.pitch = fb->x_res;
 	memset(fb->buf, 0, fb->size);
+	cfb_mark_dirty(fb, 0, 0, fb->x_res, fb->y_res);
 
 	return 0;
 }
@@ -231,20 +268,109 @@ int cfb_framebuffer_invert(const struct device *dev)
 	}
 
 	fb->inverted = !fb->inverted;
+	cfb_mark_dirty(fb, 0, 0, fb->x_res, fb->y_res);
 
 	return 0;
 }
 
-int cfb_framebuffer_finalize(const struct device *dev)
+#ifdef CONFIG_CHARACTER_FRAMEBUFFER_PARTIAL_UPDATE
+static void cfb_invert_rows(const struct char_framebuffer *fb, uint16_t row,
+			    uint16_t x0, uint16_t x1, uint16_t rows)
+{
+	for (uint16_t r = row; r < row + rows; r++) {
+		for (uint16_t i = x0; i < x1; i++) {
+			fb->buf[r * fb->x_res + i] = ~fb->buf[r * fb->x_res + i];
+		}
+	}
+}
+
+/*
+ * Only the dirty span of each tile row is written. Rows dirty across the
+ * whole width are contiguous in the framebuffer and written at once.
+ */
+static int cfb_framebuffer_write_dirty(const struct device *dev)
 {
 	const struct display_driver_api *api = dev->api;
 	const struct char_framebuffer *fb = &char_fb;
+	bool invert = !(fb->pixel_format & PIXEL_FORMAT_MONO10) != !(fb->inverted);
+	uint16_t numof_rows = fb->y_res / fb->ppt;
 	struct display_buffer_descriptor desc;
+	uint16_t row = 0U;
+	int err;
+
+	while (row < numof_rows) {
+		struct cfb_dirty_span *span = &fb->dirty[row];
+		uint16_t rows = 1U;
+
+		if (span->x0 >= span->x1) {
+			row++;
+			continue;
+		}
+
+		if (span->x0 == 0U && span->x1 == fb->x_res) {
+			while (row + rows < numof_rows &&
+			       fb->dirty[row + rows].x0 == 0U &&
+			       fb->dirty[row + rows].x1 == fb->x_res) {
+				rows++;
+			}
+		}
+
+		desc.width = span->x1 - span->x0;
+		desc.height = rows * fb->ppt;
+		desc.pitch = desc.width;
+		desc.buf_size = desc.width * rows;
+
+		/* The framebuffer itself is kept in the non-inverted format */
+		if (invert) {
+			cfb_invert_rows(fb, row, span->x0, span->x1, rows);
+		}
+
+		err = api->write(dev, span->x0, row * fb->ppt, &desc,
+				 &fb->buf[row * fb->x_res + span->x0]);
+
+		if (invert) {
+			cfb_invert_rows(fb, row, span->x0, span->x1, rows);
+		}
+
+		if (err) {
+			return err;
+		}
+
+		for (uint16_t r = row; r < row + rows; r++) {
+			fb->dirty[r].x0 = 0U;
+			fb->dirty[r].x1 = 0U;
+		}
+
+		row += rows;
+	}
+
+	return 0;
+}
+#else
+static int cfb_invert(const struct char_framebuffer *fb)
+{
+	for (size_t i = 0; i < fb->x_res * fb->y_res / 8U; i++) {
+		fb->buf[i] = ~fb->buf[i];
+	}
+
+	return 0;
+}
+#endif
+
+int cfb_framebuffer_finalize(const struct device *dev)
+{
+	const struct char_framebuffer *fb = &char_fb;
 
 	if (!fb || !fb->buf) {
 		return -ENODEV;
 	}
 
+#ifdef CONFIG_CHARACTER_FRAMEBUFFER_PARTIAL_UPDATE
+	return cfb_framebuffer_write_dirty(dev);
+#else
+	const struct display_driver_api *api = dev->api;
+	struct display_buffer_descriptor desc;
+
 	desc.buf_size = fb->size;
 	desc.width = fb->x_res;
 	desc.height = fb->y_res;
@@ -255,6 +381,7 @@ int cfb_framebuffer_finalize(const struct device *dev)
 	}
 
 	return api->write(dev, 0, 0, &desc, fb->buf);
+#endif
 }
 
 int cfb_get_display_parameter(const struct device *dev,
@@ -358,5 +485,17 @@ int cfb_framebuffer_init(const struct device *dev)
 
 	memset(fb->buf, 0, fb->size);
 
+#ifdef CONFIG_CHARACTER_FRAMEBUFFER_PARTIAL_UPDATE
+	fb->dirty = k_malloc((fb->y_res / fb->ppt) * sizeof(fb->dirty[0]));
+	if (!fb->dirty) {
+		k_free(fb->buf);
+		fb->buf = NULL;
+		return -ENOMEM;
+	}
+
+	/* The display content is unknown, write everything first */
+	cfb_mark_dirty(fb, 0, 0, fb->x_res, fb->y_res);
+#endif
+
 	return 0;
 }
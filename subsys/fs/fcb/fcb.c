@@ -73,6 +73,47 @@ int fcb_flash_write(const struct fcb *fcb, const struct flash_sector *sector,
 	return 0;
 }
 
+#ifdef CONFIG_FCB_READ_CACHE
+/*
+ * Reads through the per FCB read cache. Small reads, like the element
+ * headers and CRCs read while walking, are served from a window of the sector
+ * that is filled with a single flash read; reads that do not fit the cache
+ * go to flash directly.
+ */
+int fcb_flash_read_cached(struct fcb *fcb, const struct flash_sector *sector,
+			  off_t off, void *dst, size_t len)
+{
+	size_t fill;
+	int rc;
+
+	if (off + len > sector->fs_size) {
+		return -EINVAL;
+	}
+
+	if (len > sizeof(fcb->f_rd_cache)) {
+		return fcb_flash_read(fcb, sector, off, dst, len);
+	}
+
+	if (fcb->f_rd_cache_sector != sector || off < fcb->f_rd_cache_off ||
+	    off + len > fcb->f_rd_cache_off + fcb->f_rd_cache_len) {
+		fill = MIN(sizeof(fcb->f_rd_cache), sector->fs_size - off);
+
+		fcb_read_cache_invalidate(fcb);
+		rc = fcb_flash_read(fcb, sector, off, fcb->f_rd_cache, fill);
+		if (rc) {
+			return rc;
+		}
+		fcb->f_rd_cache_sector = sector;
+		fcb->f_rd_cache_off = off;
+		fcb->f_rd_cache_len = fill;
+	}
+
+	memcpy(dst, &fcb->f_rd_cache[off - fcb->f_rd_cache_off], len);
+
+	return 0;
+}
+#endif /* CONFIG_FCB_READ_CACHE */
+
 int
 fcb_erase_sector(const struct fcb *fcb, const struct flash_sector *sector)
 {
@@ -112,6 +153,8 @@ fcb_init(int f_area_id, struct fcb *fcb)
 		return -EINVAL;
 	}
 
+	fcb_read_cache_invalidate(fcb);
+
 	fparam = flash_get_parameters(fcb->fap->fa_dev);
 	fcb->f_erase_value = fparam->erase_value;
 
@@ -266,6 +309,7 @@ fcb_sector_hdr_init(struct fcb *fcb, struct flash_sector *sector, uint16_t id)
 	fda._pad = fcb->f_erase_value;
 	fda.fd_id = id;
 
+	fcb_read_cache_invalidate(fcb);
 	rc = fcb_flash_write(fcb, sector, 0, &fda, sizeof(fda));
 	if (rc != 0) {
 		return -EIO;
@@ -8,6 +8,8 @@
 #include <stddef.h>
 #include <string.h>
 
+#include <zephyr/sys/crc.h>
+
 #include <zephyr/fs/fcb.h>
 #include "fcb_priv.h"
 
@@ -56,10 +58,45 @@ fcb_append_to_scratch(struct fcb *fcb)
 	return 0;
 }
 
+/*
+ * Reserves room for an element of cnt header bytes and len data and CRC bytes,
+ * both already in flash length, switching to a new sector when the active one
+ * is full. Must be called with f_mtx held.
+ */
+static int
+fcb_append_reserve(struct fcb *fcb, int cnt, uint16_t len,
+		   struct fcb_entry *append_loc)
+{
+	struct flash_sector *sector;
+	struct fcb_entry *active;
+	int rc;
+
+	active = &fcb->f_active;
+	if (active->fe_elem_off + len + cnt > active->fe_sector->fs_size) {
+		sector = fcb_new_sector(fcb, fcb->f_scratch_cnt);
+		if (!sector || (sector->fs_size <
+			fcb_len_in_flash(fcb, sizeof(struct fcb_disk_area)) + len + cnt)) {
+			return -ENOSPC;
+		}
+		rc = fcb_sector_hdr_init(fcb, sector, fcb->f_active_id + 1);
+		if (rc) {
+			return rc;
+		}
+		fcb->f_active.fe_sector = sector;
+		fcb->f_active.fe_elem_off = fcb_len_in_flash(fcb, sizeof(struct fcb_disk_area));
+		fcb->f_active_id++;
+	}
+
+	append_loc->fe_sector = active->fe_sector;
+	append_loc->fe_elem_off = active->fe_elem_off;
+	append_loc->fe_data_off = active->fe_elem_off + cnt;
+
+	return 0;
+}
+
 int
 fcb_append(struct fcb *fcb, uint16_t len, struct fcb_entry *append_loc)
 {
-	struct flash_sector *sector;
 	struct fcb_entry *active;
 	int cnt;
 	int rc;
@@ -82,30 +119,17 @@ fcb_append(struct fcb *fcb, uint16_t len, struct fcb_entry *append_loc)
 		return -EINVAL;
 	}
 	active = &fcb->f_active;
-	if (active->fe_elem_off + len + cnt > active->fe_sector->fs_size) {
-		sector = fcb_new_sector(fcb, fcb->f_scratch_cnt);
-		if (!sector || (sector->fs_size <
-			fcb_len_in_flash(fcb, sizeof(struct fcb_disk_area)) + len + cnt)) {
-			rc = -ENOSPC;
-			goto err;
-		}
-		rc = fcb_sector_hdr_init(fcb, sector, fcb->f_active_id + 1);
-		if (rc) {
-			goto err;
-		}
-		fcb->f_active.fe_sector = sector;
-		fcb->f_active.fe_elem_off = fcb_len_in_flash(fcb, sizeof(struct fcb_disk_area));
-		fcb->f_active_id++;
+	rc = fcb_append_reserve(fcb, cnt, len, append_loc);
+	if (rc) {
+		goto err;
 	}
 
+	fcb_read_cache_invalidate(fcb);
 	rc = fcb_flash_write(fcb, active->fe_sector, active->fe_elem_off, tmp_str, cnt);
 	if (rc) {
 		rc = -EIO;
 		goto err;
 	}
-	append_loc->fe_sector = active->fe_sector;
-	append_loc->fe_elem_off = active->fe_elem_off;
-	append_loc->fe_data_off = active->fe_elem_off + cnt;
 
 	active->fe_elem_off = append_loc->fe_data_off + len;
 
@@ -126,15 +150,197 @@ fcb_append_finish(struct fcb *fcb, struct fcb_entry *loc)
 
 	(void)memset(crc8, 0xFF, sizeof(crc8));
 
+	rc = k_mutex_lock(&fcb->f_mtx, K_FOREVER);
+	if (rc) {
+		return -EINVAL;
+	}
+
+	/* The data has been written behind the back of the read cache */
+	fcb_read_cache_invalidate(fcb);
+
 	rc = fcb_elem_crc8(fcb, loc, &crc8[0]);
 	if (rc) {
-		return rc;
+		goto out;
 	}
 	off = loc->fe_data_off + fcb_len_in_flash(fcb, loc->fe_data_len);
 
+	fcb_read_cache_invalidate(fcb);
 	rc = fcb_flash_write(fcb, loc->fe_sector, off, crc8, fcb->f_align);
+	if (rc) {
+		rc = -EIO;
+	}
+out:
+	k_mutex_unlock(&fcb->f_mtx);
+	return rc;
+}
+
+/*
+ * Write combining buffer used by fcb_append_write(). Data is collected in
+ * blocks of whole flash write units; the write offset is always aligned.
+ */
+struct fcb_wbuf {
+	struct fcb *fcb;
+	const struct flash_sector *sector;
+	off_t off;
+	uint8_t *buf;
+	size_t size;
+	size_t used;
+};
+
+static int
+fcb_wbuf_flush(struct fcb_wbuf *wb)
+{
+	int rc;
+
+	if (wb->used == 0U) {
+		return 0;
+	}
+
+	rc = fcb_flash_write(wb->fcb, wb->sector, wb->off, wb->buf, wb->used);
 	if (rc) {
 		return -EIO;
 	}
+	wb->off += wb->used;
+	wb->used = 0U;
+
+	return 0;
+}
+
+static int
+fcb_wbuf_put(struct fcb_wbuf *wb, const uint8_t *src, size_t len)
+{
+	size_t n;
+	int rc;
+
+	while (len > 0U) {
+		if (wb->used == wb->size) {
+			rc = fcb_wbuf_flush(wb);
+			if (rc) {
+				return rc;
+			}
+		}
+
+		if (wb->used == 0U && len >= wb->size) {
+			/* Write the aligned bulk straight from the caller's buffer */
+			n = len - (len % wb->fcb->f_align);
+			rc = fcb_flash_write(wb->fcb, wb->sector, wb->off, src, n);
+			if (rc) {
+				return -EIO;
+			}
+			wb->off += n;
+		} else {
+			n = MIN(len, wb->size - wb->used);
+			memcpy(&wb->buf[wb->used], src, n);
+			wb->used += n;
+		}
+		src += n;
+		len -= n;
+	}
+
 	return 0;
 }
+
+static int
+fcb_wbuf_fill(struct fcb_wbuf *wb, uint8_t value, size_t len)
+{
+	int rc = 0;
+
+	while (len-- > 0U && rc == 0) {
+		rc = fcb_wbuf_put(wb, &value, 1);
+	}
+
+	return rc;
+}
+
+int
+fcb_append_write(struct fcb *fcb, const void *data, uint16_t len,
+		 struct fcb_entry *loc)
+{
+	uint8_t buf[CONFIG_FCB_WRITE_BUF_SIZE];
+	struct fcb_entry entry;
+	struct fcb_wbuf wb;
+	uint8_t crc8;
+	int cnt;
+	int rc;
+
+	if (loc == NULL) {
+		loc = &entry;
+	}
+
+	if (fcb->f_align > sizeof(buf)) {
+		/* Write block does not fit the buffer, do it the long way */
+		rc = fcb_append(fcb, len, loc);
+		if (rc) {
+			return rc;
+		}
+		rc = fcb_flash_write(fcb, loc->fe_sector, loc->fe_data_off,
+				     data, len);
+		if (rc) {
+			return -EIO;
+		}
+		loc->fe_data_len = len;
+		return fcb_append_finish(fcb, loc);
+	}
+
+	/* Ensure defined value of padding bytes */
+	memset(buf, fcb->f_erase_value, sizeof(buf));
+
+	cnt = fcb_put_len(fcb, buf, len);
+	if (cnt < 0) {
+		return cnt;
+	}
+
+	crc8 = CRC8_CCITT_INITIAL_VALUE;
+	crc8 = crc8_ccitt(crc8, buf, cnt);
+	crc8 = crc8_ccitt(crc8, data, len);
+
+	rc = k_mutex_lock(&fcb->f_mtx, K_FOREVER);
+	if (rc) {
+		return -EINVAL;
+	}
+
+	rc = fcb_append_reserve(fcb, fcb_len_in_flash(fcb, cnt),
+				fcb_len_in_flash(fcb, len) +
+				fcb_len_in_flash(fcb, FCB_CRC_SZ), loc);
+	if (rc) {
+		goto out;
+	}
+	loc->fe_data_len = len;
+
+	wb.fcb = fcb;
+	wb.sector = loc->fe_sector;
+	wb.off = loc->fe_elem_off;
+	wb.buf = buf;
+	wb.size = sizeof(buf) - (sizeof(buf) % fcb->f_align);
+	/* The header is already in place, padded with the erase value */
+	wb.used = fcb_len_in_flash(fcb, cnt);
+
+	fcb_read_cache_invalidate(fcb);
+
+	rc = fcb_wbuf_put(&wb, data, len);
+	if (rc == 0) {
+		rc = fcb_wbuf_fill(&wb, fcb->f_erase_value,
+				   fcb_len_in_flash(fcb, len) - len);
+	}
+	if (rc == 0) {
+		rc = fcb_wbuf_put(&wb, &crc8, sizeof(crc8));
+	}
+	if (rc == 0) {
+		rc = fcb_wbuf_fill(&wb, 0xFF,
+				   fcb_len_in_flash(fcb, FCB_CRC_SZ) - FCB_CRC_SZ);
+	}
+	if (rc == 0) {
+		rc = fcb_wbuf_flush(&wb);
+	}
+
+	/*
+	 * The space is consumed even if the write failed, the element then
+	 * fails its CRC check and is skipped.
+	 */
+	fcb->f_active.fe_elem_off = loc->fe_data_off +
+				    fcb_len_in_flash(fcb, len) +
+				    fcb_len_in_flash(fcb, FCB_CRC_SZ);
+out:
+	k_mutex_unlock(&fcb->f_mtx);
+	return rc;
+}
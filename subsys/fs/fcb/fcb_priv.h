@@ -61,6 +61,30 @@ static inline int fcb_len_in_flash(struct fcb *fcb, uint16_t len)
 }
 
 const struct flash_area *fcb_open_flash(const struct fcb *fcb);
+
+#ifdef CONFIG_FCB_READ_CACHE
+int fcb_flash_read_cached(struct fcb *fcb, const struct flash_sector *sector,
+			  off_t off, void *dst, size_t len);
+
+static inline void fcb_read_cache_invalidate(struct fcb *fcb)
+{
+	fcb->f_rd_cache_sector = NULL;
+	fcb->f_rd_cache_len = 0U;
+}
+#else
+static inline int fcb_flash_read_cached(struct fcb *fcb,
+					const struct flash_sector *sector,
+					off_t off, void *dst, size_t len)
+{
+	return fcb_flash_read(fcb, sector, off, dst, len);
+}
+
+static inline void fcb_read_cache_invalidate(struct fcb *fcb)
+{
+	ARG_UNUSED(fcb);
+}
+#endif
+
 uint8_t fcb_get_align(const struct fcb *fcb);
 int fcb_erase_sector(const struct fcb *fcb, const struct flash_sector *sector);
 
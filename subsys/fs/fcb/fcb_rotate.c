@@ -19,6 +19,7 @@ fcb_rotate(struct fcb *fcb)
 		return -EINVAL;
 	}
 
+	fcb_read_cache_invalidate(fcb);
 	rc = fcb_erase_sector(fcb, fcb->f_oldest);
 	if (rc) {
 		rc = -EIO;
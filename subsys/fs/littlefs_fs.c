@@ -49,10 +49,22 @@ K_MEM_SLAB_DEFINE_STATIC(lfs_dir_pool, sizeof(struct lfs_dir),
 
 #if (CONFIG_FS_LITTLEFS_FC_HEAP_SIZE - 0) <= 0
 BUILD_ASSERT((CONFIG_FS_LITTLEFS_HEAP_PER_ALLOC_OVERHEAD_SIZE % 8) == 0);
+
+/* The size of this union is the largest file cache size required by the
+ * default configuration or by any of the devicetree defined mounts.
+ */
+#define FC_DT_CACHE_SIZE(node_id) \
+	uint8_t DT_CAT(cache_, node_id)[DT_PROP(node_id, cache_size)];
+
+union fc_cache_size_max {
+	uint8_t cache_default[CONFIG_FS_LITTLEFS_CACHE_SIZE];
+	DT_FOREACH_STATUS_OKAY(zephyr_fstab_littlefs, FC_DT_CACHE_SIZE)
+};
+
 /* Auto-generate heap size from cache size and number of files */
 #undef CONFIG_FS_LITTLEFS_FC_HEAP_SIZE
 #define CONFIG_FS_LITTLEFS_FC_HEAP_SIZE						\
-	((CONFIG_FS_LITTLEFS_CACHE_SIZE + FC_HEAP_PER_ALLOC_OVERHEAD) *		\
+	((sizeof(union fc_cache_size_max) + FC_HEAP_PER_ALLOC_OVERHEAD) *	\
 	CONFIG_FS_LITTLEFS_NUM_FILES)
 #endif /* CONFIG_FS_LITTLEFS_FC_HEAP_SIZE */
 
@@ -927,6 +939,7 @@ static struct fs_littlefs fs_data_##inst = { \
 		.prog_size = DT_INST_PROP(inst, prog_size), \
 		.cache_size = DT_INST_PROP(inst, cache_size), \
 		.lookahead_size = DT_INST_PROP(inst, lookahead_size), \
+		.block_cycles = DT_INST_PROP(inst, block_cycles), \
 		.read_buffer = read_buffer_##inst, \
 		.prog_buffer = prog_buffer_##inst, \
 		.lookahead_buffer = lookahead_buffer_##inst, \
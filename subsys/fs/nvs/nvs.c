@@ -18,6 +18,11 @@ LOG_MODULE_REGISTER(fs_nvs, CONFIG_NVS_LOG_LEVEL);
 
 static int nvs_prev_ate(struct nvs_fs *fs, uint32_t *addr, struct nvs_ate *ate);
 static int nvs_ate_valid(struct nvs_fs *fs, const struct nvs_ate *entry);
+static int nvs_flash_rd(struct nvs_fs *fs, uint32_t addr, void *data,
+			size_t len);
+static int nvs_flash_ate_rd(struct nvs_fs *fs, uint32_t addr,
+			    struct nvs_ate *entry);
+static inline size_t nvs_al_size(struct nvs_fs *fs, size_t len);
 
 #ifdef CONFIG_NVS_LOOKUP_CACHE
 
@@ -88,6 +93,250 @@ static void nvs_lookup_cache_invalidate(struct nvs_fs *fs, uint32_t sector)
 
 #endif /* CONFIG_NVS_LOOKUP_CACHE */
 
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+
+/* Position of id in the lookup index, or the position where it would be
+ * inserted if it is not in the index.
+ */
+static size_t nvs_lookup_index_pos(struct nvs_fs *fs, uint16_t id)
+{
+	size_t lo = 0, hi = fs->lookup_index_count;
+
+	while (lo < hi) {
+		size_t mid = (lo + hi) / 2;
+
+		if (fs->lookup_index[mid].id < id) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return lo;
+}
+
+/* Find the address of the most recent ate of id. Returns false if the index
+ * cannot tell and the ate's have to be scanned. Otherwise *addr is set to the
+ * ate address, or to NVS_LOOKUP_INDEX_NO_ADDR if id does not exist.
+ */
+static bool nvs_lookup_index_find(struct nvs_fs *fs, uint16_t id,
+				  uint32_t *addr)
+{
+	size_t pos = nvs_lookup_index_pos(fs, id);
+
+	if ((pos < fs->lookup_index_count) &&
+	    (fs->lookup_index[pos].id == id)) {
+		*addr = fs->lookup_index[pos].addr;
+		return true;
+	}
+
+	*addr = NVS_LOOKUP_INDEX_NO_ADDR;
+	return fs->lookup_index_complete;
+}
+
+static void nvs_lookup_index_set(struct nvs_fs *fs, uint16_t id, uint32_t addr)
+{
+	size_t pos = nvs_lookup_index_pos(fs, id);
+
+	if ((pos < fs->lookup_index_count) &&
+	    (fs->lookup_index[pos].id == id)) {
+		fs->lookup_index[pos].addr = addr;
+		return;
+	}
+
+	if (fs->lookup_index_count == CONFIG_NVS_LOOKUP_INDEX_SIZE) {
+		/* Out of index memory, the ID is looked up by scanning */
+		fs->lookup_index_complete = false;
+		return;
+	}
+
+	memmove(&fs->lookup_index[pos + 1], &fs->lookup_index[pos],
+		(fs->lookup_index_count - pos) * sizeof(fs->lookup_index[0]));
+	fs->lookup_index[pos].id = id;
+	fs->lookup_index[pos].addr = addr;
+	fs->lookup_index_count++;
+}
+
+static void nvs_lookup_index_reset(struct nvs_fs *fs)
+{
+	fs->lookup_index_count = 0U;
+	fs->lookup_index_complete = false;
+}
+
+#ifdef CONFIG_NVS_LOOKUP_INDEX_SUMMARY
+
+/* Add the entries of the lookup index summary with the ate at ate_addr to the
+ * index being rebuilt. Returns 0 if the summary was used, 1 if it is corrupt,
+ * errcode if error.
+ */
+static int nvs_lookup_index_summary_load(struct nvs_fs *fs, uint32_t ate_addr,
+					 const struct nvs_ate *ate,
+					 bool *complete)
+{
+	int rc;
+	struct nvs_index_summary summary;
+	struct nvs_lookup_index_entry entry;
+	struct nvs_ate entry_ate;
+	uint32_t data_addr, entry_addr, latest_addr;
+	size_t hdr_size;
+	uint16_t crc, i;
+
+	hdr_size = nvs_al_size(fs, sizeof(summary));
+	data_addr = (ate_addr & ADDR_SECT_MASK) + ate->offset;
+
+	rc = nvs_flash_rd(fs, data_addr, &summary, sizeof(summary));
+	if (rc) {
+		return rc;
+	}
+
+	if (ate->len != hdr_size + summary.count * sizeof(entry)) {
+		return 1;
+	}
+
+	data_addr += hdr_size;
+
+	/* Check the whole summary first, so that a corrupt one does not
+	 * leave a partially updated index behind.
+	 */
+	crc = 0xffff;
+	for (i = 0; i < summary.count; i++) {
+		rc = nvs_flash_rd(fs, data_addr + i * sizeof(entry), &entry,
+				  sizeof(entry));
+		if (rc) {
+			return rc;
+		}
+
+		crc = crc16_ccitt(crc, (const uint8_t *)&entry, sizeof(entry));
+	}
+
+	if (crc != summary.crc) {
+		LOG_WRN("Corrupt lookup index summary at %x", ate_addr);
+		return 1;
+	}
+
+	for (i = 0; i < summary.count; i++) {
+		rc = nvs_flash_rd(fs, data_addr + i * sizeof(entry), &entry,
+				  sizeof(entry));
+		if (rc) {
+			return rc;
+		}
+
+		/* Written after the summary */
+		if (nvs_lookup_index_find(fs, entry.id, &latest_addr)) {
+			continue;
+		}
+
+		/* The ate may have been erased by gc since, which is only the
+		 * case for deleted items as other items have been copied.
+		 */
+		entry_addr = entry.addr;
+		rc = nvs_flash_ate_rd(fs, entry_addr, &entry_ate);
+		if (rc) {
+			return rc;
+		}
+
+		if ((entry_ate.id != entry.id) ||
+		    !nvs_ate_valid(fs, &entry_ate)) {
+			continue;
+		}
+
+		if (fs->lookup_index_count == CONFIG_NVS_LOOKUP_INDEX_SIZE) {
+			*complete = false;
+			break;
+		}
+
+		nvs_lookup_index_set(fs, entry.id, entry_addr);
+	}
+
+	LOG_DBG("Lookup index summary at %x loaded", ate_addr);
+
+	return 0;
+}
+
+#endif /* CONFIG_NVS_LOOKUP_INDEX_SUMMARY */
+
+static int nvs_lookup_index_rebuild(struct nvs_fs *fs)
+{
+	int rc;
+	uint32_t addr, ate_addr, latest_addr;
+	struct nvs_ate ate;
+	bool complete = true;
+
+	nvs_lookup_index_reset(fs);
+	addr = fs->ate_wra;
+
+	while (true) {
+		/* Make a copy of 'addr' as it will be advanced by nvs_prev_ate() */
+		ate_addr = addr;
+		rc = nvs_prev_ate(fs, &addr, &ate);
+
+		if (rc) {
+			nvs_lookup_index_reset(fs);
+			return rc;
+		}
+
+		/* The ate's are walked from the newest, so only the first
+		 * valid ate of each id is added.
+		 */
+		if (ate.id != 0xFFFF && nvs_ate_valid(fs, &ate) &&
+		    !nvs_lookup_index_find(fs, ate.id, &latest_addr)) {
+			if (fs->lookup_index_count == CONFIG_NVS_LOOKUP_INDEX_SIZE) {
+				complete = false;
+			} else {
+				nvs_lookup_index_set(fs, ate.id, ate_addr);
+			}
+		}
+
+#ifdef CONFIG_NVS_LOOKUP_INDEX_SUMMARY
+		/* All older ate's are covered by the most recent summary */
+		if ((ate.id == 0xFFFF) && (ate.part == NVS_INDEX_SUMMARY_PART) &&
+		    ate.len && nvs_ate_valid(fs, &ate)) {
+			rc = nvs_lookup_index_summary_load(fs, ate_addr, &ate,
+							   &complete);
+			if (rc < 0) {
+				nvs_lookup_index_reset(fs);
+				return rc;
+			}
+
+			if (!rc) {
+				break;
+			}
+		}
+#endif
+
+		if (addr == fs->ate_wra) {
+			break;
+		}
+	}
+
+	fs->lookup_index_complete = complete;
+
+	return 0;
+}
+
+static void nvs_lookup_index_invalidate(struct nvs_fs *fs, uint32_t sector)
+{
+	size_t i, n = 0;
+
+	for (i = 0; i < fs->lookup_index_count; i++) {
+		if ((fs->lookup_index[i].addr >> ADDR_SECT_SHIFT) != sector) {
+			fs->lookup_index[n++] = fs->lookup_index[i];
+		}
+	}
+
+	fs->lookup_index_count = n;
+}
+
+#else
+
+static inline bool nvs_lookup_index_find(struct nvs_fs *fs, uint16_t id,
+					 uint32_t *addr)
+{
+	return false;
+}
+
+#endif /* CONFIG_NVS_LOOKUP_INDEX */
+
 /* basic routines */
 /* nvs_al_size returns size aligned to fs->write_block_size */
 static inline size_t nvs_al_size(struct nvs_fs *fs, size_t len)
@@ -167,6 +416,11 @@ static int nvs_flash_ate_wrt(struct nvs_fs *fs, const struct nvs_ate *entry)
 
 	rc = nvs_flash_al_wrt(fs, fs->ate_wra, entry,
 			       sizeof(struct nvs_ate));
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+	if (!rc && entry->id != 0xFFFF) {
+		nvs_lookup_index_set(fs, entry->id, fs->ate_wra);
+	}
+#endif
 #ifdef CONFIG_NVS_LOOKUP_CACHE
 	/* 0xFFFF is a special-purpose identifier. Exclude it from the cache */
 	if (entry->id != 0xFFFF) {
@@ -305,6 +559,9 @@ static int nvs_flash_erase_sector(struct nvs_fs *fs, uint32_t addr)
 
 #ifdef CONFIG_NVS_LOOKUP_CACHE
 	nvs_lookup_cache_invalidate(fs, addr >> ADDR_SECT_SHIFT);
+#endif
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+	nvs_lookup_index_invalidate(fs, addr >> ADDR_SECT_SHIFT);
 #endif
 	rc = flash_erase(fs->flash_device, offset, fs->sector_size);
 
@@ -576,59 +833,78 @@ static int nvs_add_gc_done_ate(struct nvs_fs *fs)
 	return nvs_flash_ate_wrt(fs, &gc_done_ate);
 }
 
-/* garbage collection: the address ate_wra has been updated to the new sector
- * that has just been started. The data to gc is in the sector after this new
- * sector.
+#ifdef CONFIG_NVS_LOOKUP_INDEX_SUMMARY
+
+/* Store the lookup index at the start of the sector opened by gc, so that it
+ * does not have to be rebuilt from all ate's on mount.
  */
-static int nvs_gc(struct nvs_fs *fs)
+static int nvs_lookup_index_summary_write(struct nvs_fs *fs)
 {
 	int rc;
-	struct nvs_ate close_ate, gc_ate, wlk_ate;
-	uint32_t sec_addr, gc_addr, gc_prev_addr, wlk_addr, wlk_prev_addr,
-	      data_addr, stop_addr;
-	size_t ate_size;
+	struct nvs_index_summary summary;
+	struct nvs_ate entry;
+	size_t ate_size, hdr_size, len;
 
-	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+	if (!fs->lookup_index_complete) {
+		/* IDs missing from the index would have to be scanned anyway */
+		return 0;
+	}
 
-	sec_addr = (fs->ate_wra & ADDR_SECT_MASK);
-	nvs_sector_advance(fs, &sec_addr);
-	gc_addr = sec_addr + fs->sector_size - ate_size;
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+	hdr_size = nvs_al_size(fs, sizeof(summary));
+	len = fs->lookup_index_count * sizeof(fs->lookup_index[0]);
 
-	/* if the sector is not closed don't do gc */
-	rc = nvs_flash_ate_rd(fs, gc_addr, &close_ate);
-	if (rc < 0) {
-		/* flash error */
-		return rc;
+	/* Keep at least half of the free space for the writes that follow */
+	if ((fs->ate_wra - fs->data_wra) <
+	    2 * (hdr_size + nvs_al_size(fs, len) + ate_size)) {
+		LOG_DBG("No space for lookup index summary");
+		return 0;
 	}
 
-	rc = nvs_ate_cmp_const(&close_ate, fs->flash_parameters->erase_value);
-	if (!rc) {
-		goto gc_done;
-	}
+	summary.count = fs->lookup_index_count;
+	summary.crc = crc16_ccitt(0xffff, (const uint8_t *)fs->lookup_index,
+				  len);
 
-	stop_addr = gc_addr - ate_size;
+	entry.id = 0xFFFF;
+	entry.offset = (uint16_t)(fs->data_wra & ADDR_OFFS_MASK);
+	entry.len = (uint16_t)(hdr_size + len);
+	entry.part = NVS_INDEX_SUMMARY_PART;
 
-	if (nvs_close_ate_valid(fs, &close_ate)) {
-		gc_addr &= ADDR_SECT_MASK;
-		gc_addr += close_ate.offset;
-	} else {
-		rc = nvs_recover_last_ate(fs, &gc_addr);
-		if (rc) {
-			return rc;
-		}
+	nvs_ate_crc8_update(&entry);
+
+	rc = nvs_flash_data_wrt(fs, &summary, sizeof(summary));
+	if (rc) {
+		return rc;
 	}
 
-	do {
-		gc_prev_addr = gc_addr;
-		rc = nvs_prev_ate(fs, &gc_addr, &gc_ate);
+	if (len) {
+		rc = nvs_flash_data_wrt(fs, fs->lookup_index, len);
 		if (rc) {
 			return rc;
 		}
+	}
 
-		if (!nvs_ate_valid(fs, &gc_ate)) {
-			continue;
-		}
+	return nvs_flash_ate_wrt(fs, &entry);
+}
 
+#endif /* CONFIG_NVS_LOOKUP_INDEX_SUMMARY */
+
+/* nvs_gc_ate_live checks if the ate at gc_prev_addr in the sector that is
+ * garbage collected is the most recent valid entry of its id, so it needs to
+ * be copied. returns 1 if copy is needed, 0 if not, errcode if error
+ */
+static int nvs_gc_ate_live(struct nvs_fs *fs, uint32_t gc_prev_addr,
+			   const struct nvs_ate *gc_ate)
+{
+	int rc;
+	struct nvs_ate wlk_ate;
+	uint32_t wlk_addr, wlk_prev_addr;
+
+	if (!nvs_ate_valid(fs, gc_ate)) {
+		return 0;
+	}
+
+	if (!nvs_lookup_index_find(fs, gc_ate->id, &wlk_prev_addr)) {
 		wlk_addr = fs->ate_wra;
 		do {
 			wlk_prev_addr = wlk_addr;
@@ -641,31 +917,135 @@ static int nvs_gc(struct nvs_fs *fs)
 			 * have been written that has the same ate but is
 			 * invalid, don't consider these as a match.
 			 */
-			if ((wlk_ate.id == gc_ate.id) &&
+			if ((wlk_ate.id == gc_ate->id) &&
 			    (nvs_ate_valid(fs, &wlk_ate))) {
 				break;
 			}
 		} while (wlk_addr != fs->ate_wra);
+	}
 
-		/* if walk has reached the same address as gc_addr copy is
-		 * needed unless it is a deleted item.
-		 */
-		if ((wlk_prev_addr == gc_prev_addr) && gc_ate.len) {
-			/* copy needed */
-			LOG_DBG("Moving %d, len %d", gc_ate.id, gc_ate.len);
+	/* if walk has reached the same address as gc_addr copy is
+	 * needed unless it is a deleted item.
+	 */
+	return (wlk_prev_addr == gc_prev_addr) && gc_ate->len;
+}
 
-			data_addr = (gc_prev_addr & ADDR_SECT_MASK);
-			data_addr += gc_ate.offset;
+/* nvs_gc_ate_copy copies the entry of the ate at gc_prev_addr to the current
+ * write position.
+ */
+static int nvs_gc_ate_copy(struct nvs_fs *fs, uint32_t gc_prev_addr,
+			   struct nvs_ate *gc_ate)
+{
+	int rc;
+	uint32_t data_addr;
 
-			gc_ate.offset = (uint16_t)(fs->data_wra & ADDR_OFFS_MASK);
-			nvs_ate_crc8_update(&gc_ate);
+	LOG_DBG("Moving %d, len %d", gc_ate->id, gc_ate->len);
 
-			rc = nvs_flash_block_move(fs, data_addr, gc_ate.len);
-			if (rc) {
-				return rc;
-			}
+	data_addr = (gc_prev_addr & ADDR_SECT_MASK);
+	data_addr += gc_ate->offset;
+
+	gc_ate->offset = (uint16_t)(fs->data_wra & ADDR_OFFS_MASK);
+	nvs_ate_crc8_update(gc_ate);
+
+	rc = nvs_flash_block_move(fs, data_addr, gc_ate->len);
+	if (rc) {
+		return rc;
+	}
+
+	return nvs_flash_ate_wrt(fs, gc_ate);
+}
+
+/* nvs_gc_first_ate finds the last written ate of the sector at sec_addr, which
+ * is the first one to garbage collect. returns 1 and sets addr if the sector
+ * is closed, 0 if it is not closed, errcode if error
+ */
+static int nvs_gc_first_ate(struct nvs_fs *fs, uint32_t sec_addr,
+			    uint32_t *addr)
+{
+	int rc;
+	struct nvs_ate close_ate;
+	size_t ate_size;
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+
+	*addr = sec_addr + fs->sector_size - ate_size;
 
-			rc = nvs_flash_ate_wrt(fs, &gc_ate);
+	rc = nvs_flash_ate_rd(fs, *addr, &close_ate);
+	if (rc < 0) {
+		/* flash error */
+		return rc;
+	}
+
+	rc = nvs_ate_cmp_const(&close_ate, fs->flash_parameters->erase_value);
+	if (!rc) {
+		return 0;
+	}
+
+	if (nvs_close_ate_valid(fs, &close_ate)) {
+		*addr &= ADDR_SECT_MASK;
+		*addr += close_ate.offset;
+	} else {
+		rc = nvs_recover_last_ate(fs, addr);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	return 1;
+}
+
+/* garbage collection: the address ate_wra has been updated to the new sector
+ * that has just been started. The data to gc is in the sector after this new
+ * sector.
+ */
+static int nvs_gc(struct nvs_fs *fs)
+{
+	int rc;
+	struct nvs_ate gc_ate;
+	uint32_t sec_addr, gc_addr, gc_prev_addr, stop_addr;
+	size_t ate_size;
+	bool erased = false;
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+
+	sec_addr = (fs->ate_wra & ADDR_SECT_MASK);
+	nvs_sector_advance(fs, &sec_addr);
+
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	if ((fs->gc_state == NVS_GC_ERASED) &&
+	    (fs->gc_sector == (sec_addr >> ADDR_SECT_SHIFT))) {
+		/* Already done by the incremental garbage collection */
+		erased = true;
+		goto gc_done;
+	}
+#endif
+
+	/* if the sector is not closed don't do gc */
+	rc = nvs_gc_first_ate(fs, sec_addr, &gc_addr);
+	if (rc < 0) {
+		return rc;
+	}
+
+	if (!rc) {
+		goto gc_done;
+	}
+
+	stop_addr = sec_addr + fs->sector_size - 2 * ate_size;
+
+	do {
+		gc_prev_addr = gc_addr;
+		rc = nvs_prev_ate(fs, &gc_addr, &gc_ate);
+		if (rc) {
+			return rc;
+		}
+
+		rc = nvs_gc_ate_live(fs, gc_prev_addr, &gc_ate);
+		if (rc < 0) {
+			return rc;
+		}
+
+		if (rc) {
+			rc = nvs_gc_ate_copy(fs, gc_prev_addr, &gc_ate);
 			if (rc) {
 				return rc;
 			}
@@ -687,6 +1067,10 @@ gc_done:
 		}
 	}
 
+	if (erased) {
+		return 0;
+	}
+
 	/* Erase the gc'ed sector */
 	rc = nvs_flash_erase_sector(fs, sec_addr);
 	if (rc) {
@@ -695,6 +1079,148 @@ gc_done:
 	return 0;
 }
 
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+
+/* incremental garbage collection: the valid entries of the sector that will
+ * be garbage collected when the current sector is closed, which is the
+ * sector after the empty one following the current sector, are copied to the
+ * current sector a few at a time. Once all are copied the sector is erased,
+ * leaving nothing to do for nvs_gc().
+ */
+static int nvs_gc_incremental(struct nvs_fs *fs)
+{
+	int rc;
+	struct nvs_ate gc_ate;
+	uint32_t sec_addr, gc_addr, gc_prev_addr, stop_addr;
+	size_t ate_size, data_size;
+	uint16_t i;
+
+	if (fs->sector_count < 3) {
+		/* there is no sector to gc apart from the current one */
+		return 0;
+	}
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+
+	sec_addr = (fs->ate_wra & ADDR_SECT_MASK);
+	nvs_sector_advance(fs, &sec_addr);
+	nvs_sector_advance(fs, &sec_addr);
+
+	/* start over when the current sector has been closed */
+	if ((sec_addr >> ADDR_SECT_SHIFT) != fs->gc_sector) {
+		fs->gc_sector = sec_addr >> ADDR_SECT_SHIFT;
+		fs->gc_state = NVS_GC_IDLE;
+	}
+
+	switch (fs->gc_state) {
+	case NVS_GC_IDLE:
+		rc = nvs_gc_first_ate(fs, sec_addr, &fs->gc_addr);
+		if (rc < 0) {
+			return rc;
+		}
+
+		if (rc) {
+			fs->gc_state = NVS_GC_MOVING;
+			return 1;
+		}
+
+		/* a sector that is not closed is empty, unless erasing it was
+		 * interrupted.
+		 */
+		rc = nvs_flash_cmp_const(fs, sec_addr,
+					 fs->flash_parameters->erase_value,
+					 fs->sector_size);
+		if (rc < 0) {
+			return rc;
+		}
+
+		fs->gc_state = rc ? NVS_GC_ERASING : NVS_GC_ERASED;
+		return rc;
+	case NVS_GC_MOVING:
+		break;
+	case NVS_GC_ERASING:
+		LOG_DBG("Erasing sector %d ahead of gc", fs->gc_sector);
+		rc = nvs_flash_erase_sector(fs, sec_addr);
+		if (rc) {
+			return rc;
+		}
+
+		fs->gc_state = NVS_GC_ERASED;
+		return 0;
+	default:
+		return 0;
+	}
+
+	stop_addr = sec_addr + fs->sector_size - 2 * ate_size;
+
+	for (i = 0; i < CONFIG_NVS_GC_INCREMENTAL_ATE_COUNT; i++) {
+		gc_addr = fs->gc_addr;
+		gc_prev_addr = gc_addr;
+		rc = nvs_prev_ate(fs, &gc_addr, &gc_ate);
+		if (rc) {
+			return rc;
+		}
+
+		rc = nvs_gc_ate_live(fs, gc_prev_addr, &gc_ate);
+		if (rc < 0) {
+			return rc;
+		}
+
+		if (rc) {
+			/* leave space for delete ate, like nvs_write() */
+			data_size = nvs_al_size(fs, gc_ate.len);
+			if (fs->ate_wra < (fs->data_wra + data_size + ate_size)) {
+				/* the rest is done by nvs_gc() */
+				fs->gc_state = NVS_GC_BLOCKED;
+				return 0;
+			}
+
+			rc = nvs_gc_ate_copy(fs, gc_prev_addr, &gc_ate);
+			if (rc) {
+				return rc;
+			}
+		}
+
+		fs->gc_addr = gc_addr;
+
+		if (gc_prev_addr == stop_addr) {
+			fs->gc_state = NVS_GC_ERASING;
+			break;
+		}
+	}
+
+	return 1;
+}
+
+#endif /* CONFIG_NVS_GC_INCREMENTAL */
+
+#ifdef CONFIG_NVS_GC_INCREMENTAL_BACKGROUND
+
+static void nvs_gc_work_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct nvs_fs *fs = CONTAINER_OF(dwork, struct nvs_fs, gc_work);
+	int rc;
+
+	rc = nvs_gc_step(fs);
+	if (rc < 0) {
+		LOG_ERR("Incremental gc failed (err %d)", rc);
+	} else if (rc) {
+		(void)k_work_schedule(dwork,
+				      K_MSEC(CONFIG_NVS_GC_INCREMENTAL_INTERVAL_MS));
+	}
+}
+
+#endif /* CONFIG_NVS_GC_INCREMENTAL_BACKGROUND */
+
+static inline void nvs_gc_schedule(struct nvs_fs *fs)
+{
+#ifdef CONFIG_NVS_GC_INCREMENTAL_BACKGROUND
+	(void)k_work_schedule(&fs->gc_work,
+			      K_MSEC(CONFIG_NVS_GC_INCREMENTAL_INTERVAL_MS));
+#endif
+}
+
 static int nvs_startup(struct nvs_fs *fs)
 {
 	int rc;
@@ -710,6 +1236,14 @@ static int nvs_startup(struct nvs_fs *fs)
 
 	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
 
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+	/* Until it is rebuilt, ID's are looked up by scanning */
+	nvs_lookup_index_reset(fs);
+#endif
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	fs->gc_state = NVS_GC_IDLE;
+#endif
+
 	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
 	/* step through the sectors to find a open sector following
 	 * a closed sector, this is where NVS can write.
@@ -900,6 +1434,12 @@ end:
 
 		rc = nvs_add_gc_done_ate(fs);
 	}
+
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+	if (!rc) {
+		rc = nvs_lookup_index_rebuild(fs);
+	}
+#endif
 	k_mutex_unlock(&fs->nvs_lock);
 	return rc;
 }
@@ -908,12 +1448,19 @@ int nvs_clear(struct nvs_fs *fs)
 {
 	int rc;
 	uint32_t addr;
+#ifdef CONFIG_NVS_GC_INCREMENTAL_BACKGROUND
+	struct k_work_sync sync;
+#endif
 
 	if (!fs->ready) {
 		LOG_ERR("NVS not initialized");
 		return -EACCES;
 	}
 
+#ifdef CONFIG_NVS_GC_INCREMENTAL_BACKGROUND
+	(void)k_work_cancel_delayable_sync(&fs->gc_work, &sync);
+#endif
+
 	for (uint16_t i = 0; i < fs->sector_count; i++) {
 		addr = i << ADDR_SECT_SHIFT;
 		rc = nvs_flash_erase_sector(fs, addr);
@@ -935,6 +1482,17 @@ int nvs_mount(struct nvs_fs *fs)
 	struct flash_pages_info info;
 	size_t write_block_size;
 
+#ifdef CONFIG_NVS_GC_INCREMENTAL_BACKGROUND
+	if (fs->ready) {
+		struct k_work_sync sync;
+
+		/* mounted again, stop the gc of the previous mount */
+		(void)k_work_cancel_delayable_sync(&fs->gc_work, &sync);
+	}
+
+	k_work_init_delayable(&fs->gc_work, nvs_gc_work_handler);
+#endif
+
 	k_mutex_init(&fs->nvs_lock);
 
 	fs->flash_parameters = flash_get_parameters(fs->flash_device);
@@ -976,6 +1534,8 @@ int nvs_mount(struct nvs_fs *fs)
 	/* nvs is ready for use */
 	fs->ready = true;
 
+	nvs_gc_schedule(fs);
+
 	LOG_INF("%d Sectors of %d bytes", fs->sector_count, fs->sector_size);
 	LOG_INF("alloc wra: %d, %x",
 		(fs->ate_wra >> ADDR_SECT_SHIFT),
@@ -1014,21 +1574,32 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 	}
 
 	/* find latest entry with same id */
-	wlk_addr = fs->ate_wra;
-	rd_addr = wlk_addr;
-
-	while (1) {
-		rd_addr = wlk_addr;
-		rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
-		if (rc) {
-			return rc;
-		}
-		if ((wlk_ate.id == id) && (nvs_ate_valid(fs, &wlk_ate))) {
+	if (nvs_lookup_index_find(fs, id, &rd_addr)) {
+		if (rd_addr != NVS_LOOKUP_INDEX_NO_ADDR) {
+			rc = nvs_flash_ate_rd(fs, rd_addr, &wlk_ate);
+			if (rc) {
+				return rc;
+			}
 			prev_found = true;
-			break;
 		}
-		if (wlk_addr == fs->ate_wra) {
-			break;
+	} else {
+		wlk_addr = fs->ate_wra;
+		rd_addr = wlk_addr;
+
+		while (1) {
+			rd_addr = wlk_addr;
+			rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
+			if (rc) {
+				return rc;
+			}
+			if ((wlk_ate.id == id) &&
+			    (nvs_ate_valid(fs, &wlk_ate))) {
+				prev_found = true;
+				break;
+			}
+			if (wlk_addr == fs->ate_wra) {
+				break;
+			}
 		}
 	}
 
@@ -1097,9 +1668,18 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 		if (rc) {
 			goto end;
 		}
+
+#ifdef CONFIG_NVS_LOOKUP_INDEX_SUMMARY
+		rc = nvs_lookup_index_summary_write(fs);
+		if (rc) {
+			goto end;
+		}
+#endif
 		gc_count++;
 	}
 	rc = len;
+
+	nvs_gc_schedule(fs);
 end:
 	k_mutex_unlock(&fs->nvs_lock);
 	return rc;
@@ -1139,6 +1719,18 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
 		rc = -ENOENT;
 		goto err;
 	}
+#elif defined(CONFIG_NVS_LOOKUP_INDEX)
+	/* The index is reordered by writes */
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+	if (!nvs_lookup_index_find(fs, id, &wlk_addr)) {
+		wlk_addr = fs->ate_wra;
+	}
+	k_mutex_unlock(&fs->nvs_lock);
+
+	if (wlk_addr == NVS_LOOKUP_INDEX_NO_ADDR) {
+		rc = -ENOENT;
+		goto err;
+	}
 #else
 	wlk_addr = fs->ate_wra;
 #endif
@@ -1238,3 +1830,25 @@ ssize_t nvs_calc_free_space(struct nvs_fs *fs)
 	}
 	return free_space;
 }
+
+int nvs_gc_step(struct nvs_fs *fs)
+{
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	int rc;
+
+	if (!fs->ready) {
+		LOG_ERR("NVS not initialized");
+		return -EACCES;
+	}
+
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+	rc = nvs_gc_incremental(fs);
+	k_mutex_unlock(&fs->nvs_lock);
+
+	return rc;
+#else
+	ARG_UNUSED(fs);
+
+	return -ENOTSUP;
+#endif
+}
@@ -29,6 +29,25 @@ extern "C" {
 #define NVS_BLOCK_SIZE 32
 
 #define NVS_LOOKUP_CACHE_NO_ADDR 0xFFFFFFFF
+#define NVS_LOOKUP_INDEX_NO_ADDR 0xFFFFFFFF
+
+/*
+ * Incremental garbage collection states
+ */
+#define NVS_GC_IDLE 0
+#define NVS_GC_MOVING 1
+#define NVS_GC_BLOCKED 2
+#define NVS_GC_ERASING 3
+#define NVS_GC_ERASED 4
+
+/* part of the ate of a lookup index summary */
+#define NVS_INDEX_SUMMARY_PART 0xfe
+
+/* Header of a lookup index summary, followed by the index entries */
+struct nvs_index_summary {
+	uint16_t count;	/* number of index entries */
+	uint16_t crc;	/* crc16 check of the index entries */
+} __packed;
 
 /* Allocation Table Entry */
 struct nvs_ate {
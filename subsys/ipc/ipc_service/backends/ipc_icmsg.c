@@ -13,20 +13,72 @@
 #include "ipc_icmsg.h"
 
 #define DT_DRV_COMPAT	zephyr_ipc_icmsg
-#define CB_BUF_SIZE	CONFIG_IPC_SERVICE_BACKEND_ICMSG_CB_BUF_SIZE
+
+#ifdef CONFIG_IPC_SERVICE_BACKEND_ICMSG_MULTI_EP
+#define NUM_EP		CONFIG_IPC_SERVICE_BACKEND_ICMSG_NUM_EP
+#define HDR_SIZE	sizeof(struct msg_hdr)
+#else
+#define NUM_EP		1
+#define HDR_SIZE	0
+#endif
 
 static const uint8_t magic[] = {0x45, 0x6d, 0x31, 0x6c, 0x31, 0x4b,
 				0x30, 0x72, 0x6e, 0x33, 0x6c, 0x69, 0x34};
-BUILD_ASSERT(sizeof(magic) <= CB_BUF_SIZE);
-BUILD_ASSERT(CB_BUF_SIZE <= UINT16_MAX);
+
+#ifdef CONFIG_IPC_SERVICE_BACKEND_ICMSG_MULTI_EP
+enum msg_type {
+	MSG_DATA,
+	/* Payload is the name of the sending endpoint */
+	MSG_BIND,
+	MSG_BIND_ACK,
+};
+
+/* Word sized, so that payloads stay word aligned in the shared memory */
+struct msg_hdr {
+	/* Address of the endpoint on the receiving side */
+	uint8_t dst;
+	/* Address of the endpoint on the sending side */
+	uint8_t src;
+	uint8_t type;
+	uint8_t reserved;
+};
+#endif
+
+struct backend_ept {
+	/* Backend ops for an endpoint, set once registered. */
+	const struct ipc_ept_cfg *cfg;
+#ifdef CONFIG_IPC_SERVICE_BACKEND_ICMSG_MULTI_EP
+	uint8_t addr;
+	uint8_t remote_addr;
+	bool bound;
+#endif
+};
 
 struct backend_data_t {
+	const struct device *instance;
+
 	/* Tx/Rx buffers. */
 	struct spsc_pbuf *tx_ib;
 	struct spsc_pbuf *rx_ib;
 
-	/* Backend ops for an endpoint. */
-	const struct ipc_ept_cfg *cfg;
+	/* Endpoints sharing the buffers. */
+	struct backend_ept epts[NUM_EP];
+	atomic_t ept_count;
+
+	/* A single message is written at a time. It is held from
+	 * get_tx_buffer() until the buffer is sent or dropped.
+	 */
+	struct k_sem tx_sem;
+	char *tx_buf;
+	uint16_t tx_len;
+	struct backend_ept *tx_ept;
+
+	/* Message being passed to a receive callback. Messages are freed in
+	 * order, so reception stops while one is held.
+	 */
+	char *rx_data;
+	uint16_t rx_len;
+	bool rx_held;
 
 	/* General */
 	struct k_work mbox_work;
@@ -42,49 +94,240 @@ struct backend_config_t {
 	struct mbox_channel mbox_rx;
 };
 
+static void tx_release(struct backend_data_t *dev_data)
+{
+	dev_data->tx_buf = NULL;
+	dev_data->tx_ept = NULL;
+	k_sem_give(&dev_data->tx_sem);
+}
+
+/* Allocate a message of len bytes, header excluded */
+static int tx_alloc(struct backend_data_t *dev_data, struct backend_ept *ept,
+		    uint16_t len, k_timeout_t wait)
+{
+	char *buf;
+	int ret;
+
+	if (k_sem_take(&dev_data->tx_sem, wait) < 0) {
+		return -ENOBUFS;
+	}
+
+	ret = spsc_pbuf_alloc(dev_data->tx_ib, len + HDR_SIZE, &buf);
+	if (ret <= (int)HDR_SIZE) {
+		k_sem_give(&dev_data->tx_sem);
+		return ret < 0 ? ret : -ENOBUFS;
+	}
+
+	dev_data->tx_buf = buf + HDR_SIZE;
+	dev_data->tx_len = ret - HDR_SIZE;
+	dev_data->tx_ept = ept;
+
+	return 0;
+}
+
+static int tx_commit(const struct device *instance, uint8_t type, uint16_t len)
+{
+	const struct backend_config_t *conf = instance->config;
+	struct backend_data_t *dev_data = instance->data;
+
+#ifdef CONFIG_IPC_SERVICE_BACKEND_ICMSG_MULTI_EP
+	struct msg_hdr *hdr = (struct msg_hdr *)(dev_data->tx_buf - HDR_SIZE);
+
+	hdr->dst = dev_data->tx_ept->remote_addr;
+	hdr->src = dev_data->tx_ept->addr;
+	hdr->type = type;
+	hdr->reserved = 0;
+#endif
+
+	spsc_pbuf_commit(dev_data->tx_ib, len + HDR_SIZE);
+	tx_release(dev_data);
+
+	__ASSERT_NO_MSG(conf->mbox_tx.dev != NULL);
+
+	return mbox_send(&conf->mbox_tx, NULL);
+}
+
+static int tx_write(const struct device *instance, struct backend_ept *ept,
+		    uint8_t type, const void *msg, size_t len)
+{
+	struct backend_data_t *dev_data = instance->data;
+	int ret;
+
+	if (len + HDR_SIZE >= SPSC_PBUF_MAX_LEN) {
+		return -EINVAL;
+	}
+
+	ret = tx_alloc(dev_data, ept, len,
+		       k_is_in_isr() ? K_NO_WAIT : K_FOREVER);
+	if (ret < 0) {
+		return ret == -ENOBUFS ? -ENOMEM : ret;
+	}
+
+	if (dev_data->tx_len < len) {
+		tx_release(dev_data);
+		return -ENOMEM;
+	}
+
+	memcpy(dev_data->tx_buf, msg, len);
+
+	return tx_commit(instance, type, len);
+}
+
+#ifdef CONFIG_IPC_SERVICE_BACKEND_ICMSG_MULTI_EP
+static int send_bind(const struct device *instance, struct backend_ept *ept,
+		     uint8_t type)
+{
+	return tx_write(instance, ept, type, ept->cfg->name,
+			strlen(ept->cfg->name));
+}
+
+static void bind_all(const struct device *instance)
+{
+	struct backend_data_t *dev_data = instance->data;
+	int count = MIN(atomic_get(&dev_data->ept_count), NUM_EP);
+
+	for (int i = 0; i < count; i++) {
+		if (dev_data->epts[i].cfg != NULL) {
+			(void)send_bind(instance, &dev_data->epts[i], MSG_BIND);
+		}
+	}
+}
+
+static struct backend_ept *ept_find(struct backend_data_t *dev_data,
+				    const char *name, size_t len)
+{
+	int count = MIN(atomic_get(&dev_data->ept_count), NUM_EP);
+
+	for (int i = 0; i < count; i++) {
+		struct backend_ept *ept = &dev_data->epts[i];
+
+		if (ept->cfg != NULL && strlen(ept->cfg->name) == len &&
+		    memcmp(ept->cfg->name, name, len) == 0) {
+			return ept;
+		}
+	}
+
+	return NULL;
+}
+
+/* Get the endpoint a received message is addressed to. Endpoints are bound
+ * by name: each side sends a bind message for its endpoints once both sides
+ * are ready, or once registered, and acknowledges the binds it receives.
+ */
+static struct backend_ept *rx_ept(const struct device *instance,
+				  const char *buf, uint16_t len)
+{
+	struct backend_data_t *dev_data = instance->data;
+	const struct msg_hdr *hdr = (const struct msg_hdr *)buf;
+	struct backend_ept *ept;
+
+	if (len < HDR_SIZE) {
+		return NULL;
+	}
+
+	if (hdr->type == MSG_DATA) {
+		if (hdr->dst == 0 || hdr->dst > NUM_EP) {
+			return NULL;
+		}
+
+		ept = &dev_data->epts[hdr->dst - 1];
+
+		return ept->bound ? ept : NULL;
+	}
+
+	ept = ept_find(dev_data, buf + HDR_SIZE, len - HDR_SIZE);
+	if (ept == NULL) {
+		/* Bound once registered on this side */
+		return NULL;
+	}
+
+	ept->remote_addr = hdr->src;
+
+	if (hdr->type == MSG_BIND) {
+		(void)send_bind(instance, ept, MSG_BIND_ACK);
+	}
+
+	if (!ept->bound) {
+		ept->bound = true;
+		if (ept->cfg->cb.bound) {
+			ept->cfg->cb.bound(ept->cfg->priv);
+		}
+	}
+
+	return NULL;
+}
+#else
+static struct backend_ept *rx_ept(const struct device *instance,
+				  const char *buf, uint16_t len)
+{
+	struct backend_data_t *dev_data = instance->data;
+
+	return &dev_data->epts[0];
+}
+#endif /* CONFIG_IPC_SERVICE_BACKEND_ICMSG_MULTI_EP */
 
 static void mbox_callback_process(struct k_work *item)
 {
 	struct backend_data_t *dev_data = CONTAINER_OF(item, struct backend_data_t, mbox_work);
-	uint8_t cb_buffer[CB_BUF_SIZE] __aligned(4);
+	const struct device *instance = dev_data->instance;
+	struct backend_ept *ept;
+	char *buf;
+	uint16_t len;
 
 	atomic_t state = atomic_get(&dev_data->state);
-	int len = spsc_pbuf_read(dev_data->rx_ib, cb_buffer, CB_BUF_SIZE);
 
-	__ASSERT_NO_MSG(len <= CB_BUF_SIZE);
-
-	if (len == -EAGAIN) {
-		__ASSERT_NO_MSG(false);
-		(void)k_work_submit(&dev_data->mbox_work);
+	/* Reception resumes once the held message is released */
+	if (dev_data->rx_held) {
 		return;
-	} else if (len <= 0) {
+	}
+
+	/* Messages are passed in place, without copying them out of the
+	 * shared memory.
+	 */
+	len = spsc_pbuf_claim(dev_data->rx_ib, &buf);
+	if (len == 0) {
 		return;
 	}
 
 	if (state == ICMSG_STATE_READY) {
-		if (dev_data->cfg->cb.received) {
-			dev_data->cfg->cb.received(cb_buffer, len, dev_data->cfg->priv);
-		}
-
-		/* Reading with NULL buffer to know if there are data in the
-		 * buffer to be read.
-		 */
-		len = spsc_pbuf_read(dev_data->rx_ib, NULL, 0);
-		if (len > 0) {
-			(void)k_work_submit(&dev_data->mbox_work);
+		ept = rx_ept(instance, buf, len);
+		if (ept != NULL && ept->cfg->cb.received) {
+			dev_data->rx_data = buf + HDR_SIZE;
+			dev_data->rx_len = len;
+			ept->cfg->cb.received(dev_data->rx_data, len - HDR_SIZE,
+					      ept->cfg->priv);
+
+			if (dev_data->rx_held) {
+				return;
+			}
+
+			dev_data->rx_data = NULL;
 		}
 	} else {
 		__ASSERT_NO_MSG(state == ICMSG_STATE_BUSY);
-		if (len != sizeof(magic) || memcmp(magic, cb_buffer, len)) {
+		if (len != sizeof(magic) || memcmp(magic, buf, len)) {
 			__ASSERT_NO_MSG(false);
 			return;
 		}
 
-		if (dev_data->cfg->cb.bound) {
-			dev_data->cfg->cb.bound(dev_data->cfg->priv);
+		atomic_set(&dev_data->state, ICMSG_STATE_READY);
+
+#ifdef CONFIG_IPC_SERVICE_BACKEND_ICMSG_MULTI_EP
+		bind_all(instance);
+#else
+		if (dev_data->epts[0].cfg->cb.bound) {
+			dev_data->epts[0].cfg->cb.bound(dev_data->epts[0].cfg->priv);
 		}
+#endif
+	}
 
-		atomic_set(&dev_data->state, ICMSG_STATE_READY);
+	spsc_pbuf_free(dev_data->rx_ib, len);
+
+	/* Reading with NULL buffer to know if there are data in the
+	 * buffer to be read.
+	 */
+	if (spsc_pbuf_read(dev_data->rx_ib, NULL, 0) > 0) {
+		(void)k_work_submit(&dev_data->mbox_work);
 	}
 }
 
@@ -112,22 +355,12 @@ static int mbox_init(const struct device *instance)
 	return mbox_set_enabled(&conf->mbox_rx, 1);
 }
 
-static int register_ept(const struct device *instance, void **token,
-			const struct ipc_ept_cfg *cfg)
+static int icmsg_open(const struct device *instance)
 {
 	const struct backend_config_t *conf = instance->config;
 	struct backend_data_t *dev_data = instance->data;
-	struct ipc_ept *ep = (struct ipc_ept *)token;
 	int ret;
 
-	if (!atomic_cas(&dev_data->state, ICMSG_STATE_OFF, ICMSG_STATE_BUSY)) {
-		/* Already registered. This backend supports single ep. */
-		return -EALREADY;
-	}
-
-	ep->instance = instance;
-	dev_data->cfg = cfg;
-
 	ret = mbox_init(instance);
 	if (ret) {
 		return ret;
@@ -152,37 +385,214 @@ static int register_ept(const struct device *instance, void **token,
 	return 0;
 }
 
+static int register_ept(const struct device *instance, void **token,
+			const struct ipc_ept_cfg *cfg)
+{
+	struct backend_data_t *dev_data = instance->data;
+	struct backend_ept *ept;
+	atomic_val_t idx;
+
+	idx = atomic_inc(&dev_data->ept_count);
+	if (idx >= NUM_EP) {
+		atomic_dec(&dev_data->ept_count);
+		/* This backend supports NUM_EP endpoints. */
+		return -EALREADY;
+	}
+
+	ept = &dev_data->epts[idx];
+#ifdef CONFIG_IPC_SERVICE_BACKEND_ICMSG_MULTI_EP
+	if (cfg->name == NULL) {
+		atomic_dec(&dev_data->ept_count);
+		return -EINVAL;
+	}
+
+	ept->addr = idx + 1;
+#endif
+	ept->cfg = cfg;
+	*token = ept;
+
+	/* The first endpoint opens the instance */
+	if (atomic_cas(&dev_data->state, ICMSG_STATE_OFF, ICMSG_STATE_BUSY)) {
+		return icmsg_open(instance);
+	}
+
+#ifdef CONFIG_IPC_SERVICE_BACKEND_ICMSG_MULTI_EP
+	if (atomic_get(&dev_data->state) == ICMSG_STATE_READY) {
+		return send_bind(instance, ept, MSG_BIND);
+	}
+#endif
+
+	return 0;
+}
+
 static int send(const struct device *instance, void *token,
 		const void *msg, size_t len)
 {
-	const struct backend_config_t *conf = instance->config;
 	struct backend_data_t *dev_data = instance->data;
-	int ret;
 
 	if (atomic_get(&dev_data->state) != ICMSG_STATE_READY) {
 		return -EBUSY;
 	}
 
+#ifdef CONFIG_IPC_SERVICE_BACKEND_ICMSG_MULTI_EP
+	if (!((struct backend_ept *)token)->bound) {
+		return -EBUSY;
+	}
+#endif
+
 	/* Empty message is not allowed */
 	if (len == 0) {
 		return -ENODATA;
 	}
 
-	ret = spsc_pbuf_write(dev_data->tx_ib, msg, len);
+#ifdef CONFIG_IPC_SERVICE_BACKEND_ICMSG_MULTI_EP
+	return tx_write(instance, token, MSG_DATA, msg, len);
+#else
+	return tx_write(instance, token, 0, msg, len);
+#endif
+}
+
+static int get_tx_buffer_size(const struct device *instance, void *token)
+{
+	struct backend_data_t *dev_data = instance->data;
+
+	/* Largest message fitting an empty buffer, after its length field */
+	return MIN(spsc_pbuf_capacity(dev_data->tx_ib) - sizeof(uint32_t),
+		   SPSC_PBUF_MAX_LEN - 1) - HDR_SIZE;
+}
+
+static int get_tx_buffer(const struct device *instance, void *token,
+			 void **data, uint32_t *size, k_timeout_t wait)
+{
+	struct backend_data_t *dev_data = instance->data;
+	uint32_t max = get_tx_buffer_size(instance, token);
+	int ret;
+
+	if (!data || !size) {
+		return -EINVAL;
+	}
+
+	if (atomic_get(&dev_data->state) != ICMSG_STATE_READY) {
+		return -EBUSY;
+	}
+
+	if (dev_data->tx_ept == token) {
+		return -EALREADY;
+	}
+
+	if (*size > max) {
+		*size = max;
+		return -ENOMEM;
+	}
+
+	/* Waiting applies to other writers only, not to the remote freeing
+	 * space in the buffer, which is not signaled.
+	 */
+	ret = tx_alloc(dev_data, token, *size ? *size : max, wait);
 	if (ret < 0) {
 		return ret;
-	} else if (ret < len) {
+	}
+
+	if (dev_data->tx_len < *size) {
+		tx_release(dev_data);
+		return -ENOBUFS;
+	}
+
+	*data = dev_data->tx_buf;
+	*size = dev_data->tx_len;
+
+	return 0;
+}
+
+static int drop_tx_buffer(const struct device *instance, void *token,
+			  const void *data)
+{
+	struct backend_data_t *dev_data = instance->data;
+
+	if (dev_data->tx_ept != token) {
+		return -EALREADY;
+	}
+
+	if (data != dev_data->tx_buf) {
+		return -ENXIO;
+	}
+
+	/* Nothing is committed, the allocation is reused by the next one */
+	tx_release(dev_data);
+
+	return 0;
+}
+
+static int send_nocopy(const struct device *instance, void *token,
+		       const void *data, size_t len)
+{
+	struct backend_data_t *dev_data = instance->data;
+
+	if (dev_data->tx_ept != token || data != dev_data->tx_buf) {
+		return -EINVAL;
+	}
+
+	if (len == 0 || len > dev_data->tx_len) {
 		return -EBADMSG;
 	}
 
-	__ASSERT_NO_MSG(conf->mbox_tx.dev != NULL);
+#ifdef CONFIG_IPC_SERVICE_BACKEND_ICMSG_MULTI_EP
+	return tx_commit(instance, MSG_DATA, len);
+#else
+	return tx_commit(instance, 0, len);
+#endif
+}
 
-	return mbox_send(&conf->mbox_tx, NULL);
+static int hold_rx_buffer(const struct device *instance, void *token,
+			  void *data)
+{
+	struct backend_data_t *dev_data = instance->data;
+
+	if (dev_data->rx_held) {
+		return -EALREADY;
+	}
+
+	/* Only the message passed to the running receive callback */
+	if (data == NULL || data != dev_data->rx_data) {
+		return -EINVAL;
+	}
+
+	dev_data->rx_held = true;
+
+	return 0;
+}
+
+static int release_rx_buffer(const struct device *instance, void *token,
+			     void *data)
+{
+	struct backend_data_t *dev_data = instance->data;
+
+	if (!dev_data->rx_held) {
+		return -EALREADY;
+	}
+
+	if (data != dev_data->rx_data) {
+		return -ENXIO;
+	}
+
+	spsc_pbuf_free(dev_data->rx_ib, dev_data->rx_len);
+	dev_data->rx_data = NULL;
+	dev_data->rx_held = false;
+
+	(void)k_work_submit(&dev_data->mbox_work);
+
+	return 0;
 }
 
 const static struct ipc_service_backend backend_ops = {
 	.register_endpoint = register_ept,
 	.send = send,
+	.get_tx_buffer_size = get_tx_buffer_size,
+	.get_tx_buffer = get_tx_buffer,
+	.drop_tx_buffer = drop_tx_buffer,
+	.send_nocopy = send_nocopy,
+	.hold_rx_buffer = hold_rx_buffer,
+	.release_rx_buffer = release_rx_buffer,
 };
 
 static int backend_init(const struct device *instance)
@@ -192,6 +602,9 @@ static int backend_init(const struct device *instance)
 
 	__ASSERT_NO_MSG(conf->tx_shm_size > sizeof(struct spsc_pbuf));
 
+	dev_data->instance = instance;
+	k_sem_init(&dev_data->tx_sem, 1, 1);
+
 	dev_data->tx_ib = spsc_pbuf_init((void *)conf->tx_shm_addr,
 					 conf->tx_shm_size,
 					 SPSC_PBUF_CACHE);
@@ -42,6 +42,10 @@ struct backend_data_t {
 	struct k_work mbox_work;
 	struct k_work_q mbox_wq;
 
+	/* Coalesced notifications of the remote */
+	struct k_work_delayable notify_work;
+	const struct mbox_channel *mbox_tx;
+
 	/* General */
 	unsigned int role;
 	atomic_t state;
@@ -249,13 +253,33 @@ static int vr_shm_configure(struct ipc_static_vrings *vr, const struct backend_c
 	return 0;
 }
 
+static void notify_process(struct k_work *item)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(item);
+	struct backend_data_t *data = CONTAINER_OF(dwork, struct backend_data_t, notify_work);
+
+	mbox_send(data->mbox_tx, NULL);
+}
+
 static void virtio_notify_cb(struct virtqueue *vq, void *priv)
 {
-	struct backend_config_t *conf = priv;
+	struct backend_data_t *data = priv;
 
-	if (conf->mbox_tx.dev) {
-		mbox_send(&conf->mbox_tx, NULL);
+	if (data->mbox_tx->dev == NULL) {
+		return;
 	}
+
+	if (CONFIG_IPC_SERVICE_BACKEND_RPMSG_NOTIFY_DELAY_US > 0) {
+		/*
+		 * The window starts with the first buffer, buffers sent before
+		 * it ends are notified at once.
+		 */
+		k_work_schedule_for_queue(&data->mbox_wq, &data->notify_work,
+				K_USEC(CONFIG_IPC_SERVICE_BACKEND_RPMSG_NOTIFY_DELAY_US));
+		return;
+	}
+
+	mbox_send(data->mbox_tx, NULL);
 }
 
 static void mbox_callback_process(struct k_work *item)
@@ -266,6 +290,11 @@ static void mbox_callback_process(struct k_work *item)
 	data = CONTAINER_OF(item, struct backend_data_t, mbox_work);
 	vq_id = (data->role == ROLE_HOST) ? VIRTQUEUE_ID_HOST : VIRTQUEUE_ID_REMOTE;
 
+	/*
+	 * All the buffers available are processed. Notifications received
+	 * meanwhile only resubmit the work once, so a burst of messages is
+	 * handled in a single run.
+	 */
 	virtqueue_notification(data->vr.vq[vq_id]);
 }
 
@@ -495,8 +524,11 @@ static int open(const struct device *instance)
 		goto error;
 	}
 
+	data->mbox_tx = &conf->mbox_tx;
+	k_work_init_delayable(&data->notify_work, notify_process);
+
 	data->vr.notify_cb = virtio_notify_cb;
-	data->vr.priv = (void *) conf;
+	data->vr.priv = (void *) data;
 
 	err = ipc_static_vrings_init(&data->vr, conf->role);
 	if (err != 0) {
@@ -45,7 +45,14 @@ static void virtio_set_status(struct virtio_device *p_vdev, unsigned char status
 
 static uint32_t virtio_get_features(struct virtio_device *vdev)
 {
-	return BIT(VIRTIO_RPMSG_F_NS);
+	uint32_t features = BIT(VIRTIO_RPMSG_F_NS);
+
+	/* The event index fields are always part of the VRINGs layout */
+	if (IS_ENABLED(CONFIG_IPC_SERVICE_STATIC_VRINGS_EVENT_IDX)) {
+		features |= VIRTIO_RING_F_EVENT_IDX;
+	}
+
+	return features;
 }
 
 static unsigned char virtio_get_status(struct virtio_device *p_vdev)
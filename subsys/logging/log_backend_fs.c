@@ -11,6 +11,11 @@
 #include <zephyr/logging/log_backend_std.h>
 #include <assert.h>
 #include <zephyr/fs/fs.h>
+#include <zephyr/sys/byteorder.h>
+
+#ifdef CONFIG_LOG_BACKEND_FS_COMPRESS_LZ4
+#include <lz4.h>
+#endif
 
 #define MAX_PATH_LEN 256
 #define MAX_FLASH_WRITE_SIZE 256
@@ -452,7 +457,115 @@ BUILD_ASSERT(!IS_ENABLED(CONFIG_LOG_MODE_IMMEDIATE),
 #ifndef CONFIG_LOG_BACKEND_FS_TESTSUITE
 
 static uint8_t __aligned(4) buf[MAX_FLASH_WRITE_SIZE];
+
+#if CONFIG_LOG_BACKEND_FS_BLOCK_SIZE > 0
+/* Output is collected into blocks, so that the file system is written and
+ * synced once per block instead of once per message.
+ */
+BUILD_ASSERT(CONFIG_LOG_BACKEND_FS_BLOCK_SIZE <= CONFIG_LOG_BACKEND_FS_FILE_SIZE,
+	     "Write block larger than log file");
+
+static uint8_t __aligned(4) block[CONFIG_LOG_BACKEND_FS_BLOCK_SIZE];
+static size_t block_len;
+static int64_t block_flush_time;
+
+#ifdef CONFIG_LOG_BACKEND_FS_COMPRESS_LZ4
+#define BLOCK_HDR_LEN (2 * sizeof(uint32_t))
+
+static LZ4_stream_t lz4_state;
+static uint8_t __aligned(4) lz4_block[BLOCK_HDR_LEN +
+				      LZ4_COMPRESSBOUND(CONFIG_LOG_BACKEND_FS_BLOCK_SIZE)];
+#endif
+
+static void file_write_all(uint8_t *data, size_t len)
+{
+	int rc;
+
+	/* Same contract as for log_output, a zero return means retry */
+	while (len > 0) {
+		rc = write_log_to_file(data, len, NULL);
+		if (rc < 0) {
+			break;
+		}
+
+		data += rc;
+		len -= rc;
+	}
+}
+
+static void block_flush(void)
+{
+	if (block_len == 0) {
+		return;
+	}
+
+#ifdef CONFIG_LOG_BACKEND_FS_COMPRESS_LZ4
+	int clen;
+
+	/* Each block is stored as its raw length, its compressed length (0 if
+	 * stored uncompressed) and the data, all lengths little endian.
+	 */
+	clen = LZ4_compress_fast_extState(&lz4_state, (const char *)block,
+					  (char *)&lz4_block[BLOCK_HDR_LEN],
+					  block_len,
+					  sizeof(lz4_block) - BLOCK_HDR_LEN, 1);
+	if ((clen <= 0) || (clen >= block_len)) {
+		clen = 0;
+		memcpy(&lz4_block[BLOCK_HDR_LEN], block, block_len);
+	}
+
+	sys_put_le32(block_len, &lz4_block[0]);
+	sys_put_le32(clen, &lz4_block[sizeof(uint32_t)]);
+	file_write_all(lz4_block,
+		       BLOCK_HDR_LEN + ((clen > 0) ? clen : block_len));
+#else
+	file_write_all(block, block_len);
+#endif
+
+	block_len = 0;
+	block_flush_time = k_uptime_get();
+}
+
+static int block_write(uint8_t *data, size_t length, void *ctx)
+{
+	size_t len = MIN(length, sizeof(block) - block_len);
+
+	ARG_UNUSED(ctx);
+
+	memcpy(&block[block_len], data, len);
+	block_len += len;
+
+	if (block_len == sizeof(block)) {
+		block_flush();
+	}
+
+	return len;
+}
+
+static void notify(const struct log_backend *const backend,
+		   enum log_backend_evt event,
+		   union log_backend_evt_arg *arg)
+{
+	ARG_UNUSED(backend);
+	ARG_UNUSED(arg);
+
+	/* A partially filled block is written once the log thread is idle
+	 * and the flush interval has elapsed.
+	 */
+	if ((event == LOG_BACKEND_EVT_PROCESS_THREAD_DONE) &&
+	    ((k_uptime_get() - block_flush_time) >=
+	     CONFIG_LOG_BACKEND_FS_FLUSH_INTERVAL_MS)) {
+		block_flush();
+	}
+}
+
+LOG_OUTPUT_DEFINE(log_output, block_write, buf, MAX_FLASH_WRITE_SIZE);
+#else
+#define block_len 0
+#define block_flush()
+
 LOG_OUTPUT_DEFINE(log_output, write_log_to_file, buf, MAX_FLASH_WRITE_SIZE);
+#endif /* CONFIG_LOG_BACKEND_FS_BLOCK_SIZE > 0 */
 
 static void log_backend_fs_init(const struct log_backend *const backend)
 {
@@ -460,6 +573,9 @@ static void log_backend_fs_init(const struct log_backend *const backend)
 
 static void panic(struct log_backend const *const backend)
 {
+	log_output_flush(&log_output);
+	block_flush();
+
 	/* In case of panic deinitialize backend. It is better to keep
 	 * current data rather than log new and risk of failure.
 	 */
@@ -470,10 +586,33 @@ static void dropped(const struct log_backend *const backend, uint32_t cnt)
 {
 	ARG_UNUSED(backend);
 
-	if (IS_ENABLED(CONFIG_LOG_BACKEND_FS_OUTPUT_DICTIONARY)) {
-		log_dict_output_dropped_process(&log_output, cnt);
-	} else {
-		log_backend_std_dropped(&log_output, cnt);
+	log_backend_std_dropped_format(&log_output, cnt, log_format_current);
+}
+
+/* Dictionary records are only decodable when complete, so a new file is
+ * started before a record which would not fit in the current one rather
+ * than splitting it across files.
+ */
+static void dict_file_rotate(struct log_msg *msg)
+{
+	size_t len = sizeof(struct log_dict_output_normal_msg_hdr_t) +
+		     msg->hdr.desc.package_len + msg->hdr.desc.data_len;
+	off_t size;
+
+	if (backend_state != BACKEND_FS_OK) {
+		return;
+	}
+
+	size = fs_tell(&file);
+	if ((size + block_len + len) > CONFIG_LOG_BACKEND_FS_FILE_SIZE) {
+		block_flush();
+		size = fs_tell(&file);
+	}
+
+	if ((size > 0) && ((size + len) > CONFIG_LOG_BACKEND_FS_FILE_SIZE)) {
+		if (allocate_new_file(&file) < 0) {
+			backend_state = BACKEND_FS_CORRUPTED;
+		}
 	}
 }
 
@@ -482,6 +621,11 @@ static void process(const struct log_backend *const backend,
 {
 	uint32_t flags = log_backend_std_get_flags();
 
+	if (IS_ENABLED(CONFIG_LOG_DICTIONARY_SUPPORT) &&
+	    (log_format_current == LOG_OUTPUT_DICT)) {
+		dict_file_rotate(&msg->log);
+	}
+
 	log_format_func_t log_output_func = log_format_func_t_get(log_format_current);
 
 	log_output_func(&log_output, &msg->log, flags);
@@ -499,6 +643,9 @@ static const struct log_backend_api log_backend_fs_api = {
 	.init = log_backend_fs_init,
 	.dropped = dropped,
 	.format_set = format_set,
+#if CONFIG_LOG_BACKEND_FS_BLOCK_SIZE > 0
+	.notify = notify,
+#endif
 };
 
 LOG_BACKEND_DEFINE(log_backend_fs, log_backend_fs_api, true);
@@ -281,7 +281,7 @@ static void dropped(const struct log_backend *const backend, uint32_t cnt)
 {
 	ARG_UNUSED(backend);
 
-	log_backend_std_dropped(&log_output_rtt, cnt);
+	log_backend_std_dropped_format(&log_output_rtt, cnt, log_format_current);
 }
 
 static void process(const struct log_backend *const backend,
@@ -61,7 +61,7 @@ static void dropped(const struct log_backend *const backend, uint32_t cnt)
 {
 	ARG_UNUSED(backend);
 
-	log_backend_std_dropped(&log_output_spinel, cnt);
+	log_backend_std_dropped_format(&log_output_spinel, cnt, log_format_current);
 }
 
 static int write(uint8_t *data, size_t length, void *ctx)
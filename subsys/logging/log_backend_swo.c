@@ -138,7 +138,7 @@ static void dropped(const struct log_backend *const backend, uint32_t cnt)
 {
 	ARG_UNUSED(backend);
 
-	log_backend_std_dropped(&log_output_swo, cnt);
+	log_backend_std_dropped_format(&log_output_swo, cnt, log_format_current);
 }
 
 const struct log_backend_api log_backend_swo_api = {
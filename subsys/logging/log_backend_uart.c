@@ -146,11 +146,7 @@ static void dropped(const struct log_backend *const backend, uint32_t cnt)
 {
 	ARG_UNUSED(backend);
 
-	if (IS_ENABLED(CONFIG_LOG_BACKEND_UART_OUTPUT_DICTIONARY)) {
-		log_dict_output_dropped_process(&log_output_uart, cnt);
-	} else {
-		log_backend_std_dropped(&log_output_uart, cnt);
-	}
+	log_backend_std_dropped_format(&log_output_uart, cnt, log_format_current);
 }
 
 const struct log_backend_api log_backend_uart_api = {
@@ -91,16 +91,32 @@ static struct k_timer log_process_thread_timer;
 static log_timestamp_t dummy_timestamp(void);
 static log_timestamp_get_t timestamp_func = dummy_timestamp;
 
+#ifdef CONFIG_LOG_BUFFER_PER_CPU
+#define LOG_BUFFER_CNT CONFIG_MP_NUM_CPUS
+#else
+#define LOG_BUFFER_CNT 1
+#endif
+
+#define LOG_BUFFER_WLEN (CONFIG_LOG_BUFFER_SIZE / sizeof(int) / LOG_BUFFER_CNT)
+
 struct mpsc_pbuf_buffer log_buffer;
 static uint32_t __aligned(Z_LOG_MSG2_ALIGNMENT)
-	buf32[CONFIG_LOG_BUFFER_SIZE / sizeof(int)];
+	buf32[LOG_BUFFER_CNT][LOG_BUFFER_WLEN];
+
+#ifdef CONFIG_LOG_BUFFER_PER_CPU
+/* Buffers of the CPUs other than the first one, which uses log_buffer. */
+static struct mpsc_pbuf_buffer log_buffers_cpu[LOG_BUFFER_CNT - 1];
+
+/* Message claimed from each buffer, held until it is the oldest one. */
+static union log_msg_generic *log_buffer_head[LOG_BUFFER_CNT];
+#endif
 
 static void notify_drop(const struct mpsc_pbuf_buffer *buffer,
 			const union mpsc_pbuf_generic *item);
 
 static const struct mpsc_pbuf_buffer_config mpsc_config = {
-	.buf = (uint32_t *)buf32,
-	.size = ARRAY_SIZE(buf32),
+	.buf = (uint32_t *)buf32[0],
+	.size = LOG_BUFFER_WLEN,
 	.notify_drop = notify_drop,
 	.get_wlen = log_msg_generic_get_wlen,
 	.flags = (IS_ENABLED(CONFIG_LOG_MODE_OVERFLOW) ?
@@ -535,18 +551,65 @@ static void notify_drop(const struct mpsc_pbuf_buffer *buffer,
 	z_log_dropped(true);
 }
 
+static struct mpsc_pbuf_buffer *log_buffer_get(int idx)
+{
+#ifdef CONFIG_LOG_BUFFER_PER_CPU
+	return (idx == 0) ? &log_buffer : &log_buffers_cpu[idx - 1];
+#else
+	ARG_UNUSED(idx);
+
+	return &log_buffer;
+#endif
+}
+
+#ifdef CONFIG_LOG_BUFFER_PER_CPU
+/* The thread may migrate between allocation and commit, so the buffer
+ * holding a message is found from its address.
+ */
+static struct mpsc_pbuf_buffer *log_buffer_of(const void *msg)
+{
+	int idx = ((uintptr_t)msg - (uintptr_t)buf32) / sizeof(buf32[0]);
+
+	__ASSERT_NO_MSG((idx >= 0) && (idx < LOG_BUFFER_CNT));
+
+	return log_buffer_get(idx);
+}
+#else
+#define log_buffer_of(msg) (&log_buffer)
+#endif
+
 void z_log_msg_init(void)
 {
 	mpsc_pbuf_init(&log_buffer, &mpsc_config);
+
+#ifdef CONFIG_LOG_BUFFER_PER_CPU
+	for (int i = 1; i < LOG_BUFFER_CNT; i++) {
+		struct mpsc_pbuf_buffer_config config = mpsc_config;
+
+		config.buf = buf32[i];
+		mpsc_pbuf_init(log_buffer_get(i), &config);
+		log_buffer_head[i] = NULL;
+	}
+	log_buffer_head[0] = NULL;
+#endif
 }
 
 struct log_msg *z_log_msg_alloc(uint32_t wlen)
 {
+	struct mpsc_pbuf_buffer *buffer = &log_buffer;
+
 	if (!IS_ENABLED(CONFIG_LOG_MODE_DEFERRED)) {
 		return NULL;
 	}
 
-	return (struct log_msg *)mpsc_pbuf_alloc(&log_buffer, wlen,
+#ifdef CONFIG_LOG_BUFFER_PER_CPU
+	/* Reading the CPU id unlocked is fine, migrating only costs some
+	 * contention on the other CPU's buffer.
+	 */
+	buffer = log_buffer_get(arch_curr_cpu()->id);
+#endif
+
+	return (struct log_msg *)mpsc_pbuf_alloc(buffer, wlen,
 				K_MSEC(CONFIG_LOG_BLOCK_IN_THREAD_TIMEOUT_MS));
 }
 
@@ -562,25 +625,103 @@ void z_log_msg_commit(struct log_msg *msg)
 		return;
 	}
 
-	mpsc_pbuf_commit(&log_buffer, &m->buf);
+	mpsc_pbuf_commit(log_buffer_of(msg), &m->buf);
 	z_log_msg_post_finalize();
 }
 
 union log_msg_generic *z_log_msg_claim(void)
 {
+#ifdef CONFIG_LOG_BUFFER_PER_CPU
+	union log_msg_generic *msg;
+	int oldest = -1;
+
+	/* Messages within a buffer are in order, merging the buffers only
+	 * requires picking the oldest of their first messages.
+	 */
+	for (int i = 0; i < LOG_BUFFER_CNT; i++) {
+		if (log_buffer_head[i] == NULL) {
+			log_buffer_head[i] = (union log_msg_generic *)
+				mpsc_pbuf_claim(log_buffer_get(i));
+		}
+
+		if ((log_buffer_head[i] != NULL) &&
+		    ((oldest < 0) ||
+		     (log_buffer_head[i]->log.hdr.timestamp <
+		      log_buffer_head[oldest]->log.hdr.timestamp))) {
+			oldest = i;
+		}
+	}
+
+	if (oldest < 0) {
+		return NULL;
+	}
+
+	msg = log_buffer_head[oldest];
+	log_buffer_head[oldest] = NULL;
+
+	return msg;
+#else
 	return (union log_msg_generic *)mpsc_pbuf_claim(&log_buffer);
+#endif
 }
 
 void z_log_msg_free(union log_msg_generic *msg)
 {
-	mpsc_pbuf_free(&log_buffer, (union mpsc_pbuf_generic *)msg);
+	mpsc_pbuf_free(log_buffer_of(msg), (union mpsc_pbuf_generic *)msg);
 }
 
 bool z_log_msg_pending(void)
 {
+#ifdef CONFIG_LOG_BUFFER_PER_CPU
+	for (int i = 0; i < LOG_BUFFER_CNT; i++) {
+		if ((log_buffer_head[i] != NULL) ||
+		    mpsc_pbuf_is_pending(log_buffer_get(i))) {
+			return true;
+		}
+	}
+
+	return false;
+#else
 	return mpsc_pbuf_is_pending(&log_buffer);
+#endif
 }
 
+#ifdef CONFIG_LOG_RATELIMIT
+bool z_log_ratelimit_check(struct log_ratelimit *rl, uint8_t level,
+			   const void *source)
+{
+	uint32_t now = k_uptime_get_32();
+	uint32_t suppressed;
+
+	/* Call sites may race here, the counters are only approximate then
+	 * which is fine for rate limiting.
+	 */
+	if ((now - rl->start) < CONFIG_LOG_RATELIMIT_INTERVAL_MS) {
+		if (rl->count < CONFIG_LOG_RATELIMIT_BURST) {
+			rl->count++;
+			return true;
+		}
+
+		rl->suppressed++;
+		return false;
+	}
+
+	suppressed = rl->suppressed;
+	rl->start = now;
+	rl->count = 1;
+	rl->suppressed = 0;
+
+	if (suppressed > 0) {
+		z_log_msg_runtime_create(CONFIG_LOG_DOMAIN_ID, source, level,
+					 NULL, 0, 0,
+					 "%u similar messages suppressed",
+					 suppressed);
+	}
+
+	return true;
+}
+#endif /* CONFIG_LOG_RATELIMIT */
+
 const char *z_log_get_tag(void)
 {
 	return CONFIG_LOG_TAG_MAX_LEN > 0 ? tag : NULL;
@@ -619,7 +760,16 @@ int log_mem_get_usage(uint32_t *buf_size, uint32_t *usage)
 		return -EINVAL;
 	}
 
-	mpsc_pbuf_get_utilization(&log_buffer, buf_size, usage);
+	*buf_size = 0;
+	*usage = 0;
+
+	for (int i = 0; i < LOG_BUFFER_CNT; i++) {
+		uint32_t size, used;
+
+		mpsc_pbuf_get_utilization(log_buffer_get(i), &size, &used);
+		*buf_size += size;
+		*usage += used;
+	}
 
 	return 0;
 }
@@ -632,7 +782,21 @@ int log_mem_get_max_usage(uint32_t *max)
 		return -EINVAL;
 	}
 
-	return mpsc_pbuf_get_max_utilization(&log_buffer, max);
+	*max = 0;
+
+	for (int i = 0; i < LOG_BUFFER_CNT; i++) {
+		uint32_t buf_max;
+		int rc;
+
+		rc = mpsc_pbuf_get_max_utilization(log_buffer_get(i), &buf_max);
+		if (rc) {
+			return rc;
+		}
+
+		*max += buf_max;
+	}
+
+	return 0;
 }
 
 static void log_backend_notify_all(enum log_backend_evt event,
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/lorawan/lorawan.h>
+
+#define LOG_LEVEL CONFIG_LORAWAN_LOG_LEVEL
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(lorawan_txq);
+
+/* Largest application payload of any region and datarate */
+#define LORAWAN_TXQ_FRAME_SIZE 242
+
+struct lorawan_txq_record {
+	uint8_t port;
+	uint8_t type;
+	uint8_t len;
+	uint8_t data[CONFIG_LORAWAN_TX_QUEUE_RECORD_SIZE];
+};
+
+K_MSGQ_DEFINE(lorawan_txq, sizeof(struct lorawan_txq_record),
+	      CONFIG_LORAWAN_TX_QUEUE_DEPTH, 1);
+
+/*
+ * Records taken from the queue but not sent yet, every record is stored
+ * as length byte followed by the data.
+ */
+static uint8_t frame[LORAWAN_TXQ_FRAME_SIZE];
+static size_t frame_len;
+static uint8_t frame_port;
+static enum lorawan_message_type frame_type;
+
+int lorawan_send_queued(uint8_t port, const uint8_t *data, uint8_t len,
+			enum lorawan_message_type type, k_timeout_t timeout)
+{
+	struct lorawan_txq_record record;
+
+	if (data == NULL || port == 0 || len == 0 ||
+	    len > CONFIG_LORAWAN_TX_QUEUE_RECORD_SIZE) {
+		return -EINVAL;
+	}
+
+	record.port = port;
+	record.type = type;
+	record.len = len;
+	memcpy(record.data, data, len);
+
+	return k_msgq_put(&lorawan_txq, &record, timeout);
+}
+
+/* Number of bytes of the leading records of the frame that fit in limit */
+static size_t frame_fit(size_t limit)
+{
+	size_t len = 0;
+
+	while (len < frame_len && len + 1 + frame[len] <= limit) {
+		len += 1 + frame[len];
+	}
+
+	return len;
+}
+
+static void frame_consume(size_t len)
+{
+	frame_len -= len;
+	memmove(frame, &frame[len], frame_len);
+}
+
+/*
+ * Move queued records with the port and type of the frame into the
+ * frame, as long as they fit into the largest payload of the current
+ * datarate.
+ */
+static void frame_fill(size_t limit)
+{
+	struct lorawan_txq_record record;
+
+	while (k_msgq_peek(&lorawan_txq, &record) == 0) {
+		if (record.port != frame_port || record.type != frame_type ||
+		    frame_len + 1 + record.len > limit) {
+			break;
+		}
+
+		(void)k_msgq_get(&lorawan_txq, &record, K_NO_WAIT);
+		frame[frame_len++] = record.len;
+		memcpy(&frame[frame_len], record.data, record.len);
+		frame_len += record.len;
+	}
+}
+
+static void lorawan_txq_thread(void *p1, void *p2, void *p3)
+{
+	uint32_t backoff = CONFIG_LORAWAN_TX_QUEUE_BACKOFF_MIN_MS;
+	struct lorawan_txq_record record;
+	uint8_t max_next;
+	uint8_t max;
+	size_t len;
+	int ret;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		if (frame_len == 0) {
+			/*
+			 * Wait for the first record, then give the
+			 * application some time to queue more.
+			 */
+			(void)k_msgq_get(&lorawan_txq, &record, K_FOREVER);
+			frame_port = record.port;
+			frame_type = record.type;
+			frame[0] = record.len;
+			memcpy(&frame[1], record.data, record.len);
+			frame_len = 1 + record.len;
+
+			k_sleep(K_MSEC(CONFIG_LORAWAN_TX_QUEUE_DELAY_MS));
+		}
+
+		/* The payload sizes follow datarate changes by ADR */
+		lorawan_get_payload_sizes(&max_next, &max);
+		frame_fill(MIN(max, sizeof(frame)));
+
+		len = frame_fit(max_next);
+		if (len == 0 && max_next == max) {
+			LOG_ERR("Record of %u bytes exceeds payload size %u",
+				frame[0], max);
+			frame_consume(1 + frame[0]);
+			continue;
+		}
+
+		/*
+		 * If pending MAC commands leave no room for the first record,
+		 * lorawan_send() sends them with an empty frame and returns
+		 * -EAGAIN.
+		 */
+		if (len == 0) {
+			len = frame_len;
+		}
+
+		ret = lorawan_send(frame_port, frame, len, frame_type);
+		switch (ret) {
+		case 0:
+			LOG_DBG("Sent %zu bytes on port %u", len, frame_port);
+			frame_consume(len);
+			backoff = CONFIG_LORAWAN_TX_QUEUE_BACKOFF_MIN_MS;
+			break;
+		case -EAGAIN:
+		case -EMSGSIZE:
+			/* Payload size changed, pack the frame again */
+			break;
+		case -ECONNREFUSED:
+		case -ENOTCONN:
+		case -EBUSY:
+			/* Duty-cycle restricted, not joined or MAC busy */
+			LOG_DBG("Send deferred (%d), retry in %u ms", ret,
+				backoff);
+			k_sleep(K_MSEC(backoff));
+			backoff = MIN(backoff * 2,
+				      CONFIG_LORAWAN_TX_QUEUE_BACKOFF_MAX_MS);
+			break;
+		default:
+			LOG_WRN("Dropped %zu bytes on port %u (%d)", len,
+				frame_port, ret);
+			frame_consume(len);
+			break;
+		}
+	}
+}
+
+K_THREAD_DEFINE(lorawan_txq_tid, CONFIG_LORAWAN_TX_QUEUE_STACK_SIZE,
+		lorawan_txq_thread, NULL, NULL, NULL,
+		CONFIG_LORAWAN_TX_QUEUE_THREAD_PRIORITY, 0, 0);
@@ -39,6 +39,7 @@ LOG_MODULE_REGISTER(hawkbit, CONFIG_HAWKBIT_LOG_LEVEL);
 #endif
 
 #define ADDRESS_ID 1
+#define DOWNLOAD_PROGRESS_ID 2
 
 #define CANCEL_BASE_SIZE 50
 #define RECV_BUFFER_SIZE 640
@@ -48,12 +49,15 @@ LOG_MODULE_REGISTER(hawkbit, CONFIG_HAWKBIT_LOG_LEVEL);
 #define DOWNLOAD_HTTP_SIZE 200
 #define DEPLOYMENT_BASE_SIZE 50
 #define RESPONSE_BUFFER_SIZE 1100
+#define RANGE_HEADER_SIZE 40
 #define HAWKBIT_RECV_TIMEOUT (300 * MSEC_PER_SEC)
 
 #define HTTP_HEADER_CONTENT_TYPE_JSON "application/json;charset=UTF-8"
 
 #define SLOT1_LABEL slot1_partition
 #define SLOT1_SIZE FIXED_PARTITION_SIZE(SLOT1_LABEL)
+#define SLOT1_DEV FIXED_PARTITION_DEVICE(SLOT1_LABEL)
+#define SLOT1_OFFSET FIXED_PARTITION_OFFSET(SLOT1_LABEL)
 
 #define STORAGE_LABEL storage_partition
 #define STORAGE_DEV FIXED_PARTITION_DEVICE(STORAGE_LABEL)
@@ -72,9 +76,19 @@ struct hawkbit_download {
 	int download_progress;
 	size_t downloaded_size;
 	size_t http_content_size;
+	size_t resume_offset;
+	size_t saved_size;
 	uint8_t file_hash[SHA256_HASH_SIZE];
 };
 
+/* Download progress stored in NVS, allowing to resume the download of
+ * the artifact of the same action after a failure or a reboot.
+ */
+struct hawkbit_download_progress {
+	int32_t action_id;
+	uint32_t offset;
+};
+
 static struct hawkbit_context {
 	int sock;
 	int32_t action_id;
@@ -624,6 +638,75 @@ int hawkbit_init(void)
 	return ret;
 }
 
+#ifdef CONFIG_HAWKBIT_DOWNLOAD_RESUME
+static void hawkbit_download_progress_clear(void)
+{
+	(void)nvs_delete(&fs, DOWNLOAD_PROGRESS_ID);
+}
+
+static void hawkbit_download_progress_save(void)
+{
+	struct hawkbit_download_progress progress;
+	struct flash_pages_info page;
+	ssize_t rc;
+
+	if ((hb_context.dl.downloaded_size - hb_context.dl.saved_size) <
+	    CONFIG_HAWKBIT_DOWNLOAD_RESUME_INTERVAL) {
+		return;
+	}
+
+	/* Only the pages before the one being written are complete, writing
+	 * the current page again erases it first.
+	 */
+	rc = flash_get_page_info_by_offs(SLOT1_DEV, SLOT1_OFFSET + hb_context.dl.downloaded_size,
+					 &page);
+	if (rc) {
+		return;
+	}
+
+	progress.action_id = hb_context.json_action_id;
+	progress.offset = page.start_offset - SLOT1_OFFSET;
+
+	rc = nvs_write(&fs, DOWNLOAD_PROGRESS_ID, &progress, sizeof(progress));
+	if (rc < 0) {
+		LOG_WRN("Unable to save download progress: %d", (int)rc);
+		return;
+	}
+
+	hb_context.dl.saved_size = hb_context.dl.downloaded_size;
+}
+
+static int hawkbit_download_init(int32_t file_size)
+{
+	struct hawkbit_download_progress progress;
+	size_t offset = 0;
+	ssize_t rc;
+
+	rc = nvs_read(&fs, DOWNLOAD_PROGRESS_ID, &progress, sizeof(progress));
+	if ((rc == sizeof(progress)) && (progress.action_id == hb_context.json_action_id) &&
+	    (progress.offset < file_size)) {
+		offset = progress.offset;
+	}
+
+	rc = flash_img_init_id_at(&hb_context.flash_ctx, FIXED_PARTITION_ID(SLOT1_LABEL), offset);
+	if (rc && offset) {
+		LOG_WRN("Unable to resume download at %zu: %d", offset, (int)rc);
+		offset = 0;
+		rc = flash_img_init_id_at(&hb_context.flash_ctx, FIXED_PARTITION_ID(SLOT1_LABEL),
+					  offset);
+	}
+
+	if (offset) {
+		LOG_INF("Resuming download at %zu bytes", offset);
+	}
+
+	hb_context.dl.resume_offset = offset;
+	hb_context.dl.saved_size = offset;
+
+	return rc;
+}
+#endif /* CONFIG_HAWKBIT_DOWNLOAD_RESUME */
+
 static int enum_for_http_req_string(char *userdata)
 {
 	int i = 0;
@@ -750,8 +833,22 @@ static void response_cb(struct http_response *rsp, enum http_final_call final_da
 		break;
 
 	case HAWKBIT_DOWNLOAD:
+#ifdef CONFIG_HAWKBIT_DOWNLOAD_RESUME
+		if ((hb_context.dl.resume_offset != 0) && (rsp->http_status_code != 206)) {
+			if (hb_context.code_status != HAWKBIT_DOWNLOAD_ERROR) {
+				LOG_ERR("Range request refused (%u), restarting download",
+					rsp->http_status_code);
+				hawkbit_download_progress_clear();
+				hb_context.code_status = HAWKBIT_DOWNLOAD_ERROR;
+			}
+
+			break;
+		}
+#endif
+
 		if (hb_context.dl.http_content_size == 0) {
-			hb_context.dl.http_content_size = rsp->content_length;
+			hb_context.dl.http_content_size =
+				hb_context.dl.resume_offset + rsp->content_length;
 		}
 
 		if (rsp->body_found) {
@@ -767,7 +864,12 @@ static void response_cb(struct http_response *rsp, enum http_final_call final_da
 			}
 		}
 
-		hb_context.dl.downloaded_size = flash_img_bytes_written(&hb_context.flash_ctx);
+		hb_context.dl.downloaded_size =
+			hb_context.dl.resume_offset + flash_img_bytes_written(&hb_context.flash_ctx);
+
+#ifdef CONFIG_HAWKBIT_DOWNLOAD_RESUME
+		hawkbit_download_progress_save();
+#endif
 
 		downloaded = hb_context.dl.downloaded_size * 100 / hb_context.dl.http_content_size;
 
@@ -806,6 +908,11 @@ static bool send_request(enum http_method method, enum hawkbit_http_request type
 		NULL
 	};
 #endif /* CONFIG_HAWKBIT_DDI_NO_SECURITY */
+#ifdef CONFIG_HAWKBIT_DOWNLOAD_RESUME
+	char range_header[RANGE_HEADER_SIZE];
+	const char *download_headers[3] = { NULL };
+	int n = 0;
+#endif
 
 	if (!hawkbit_get_device_identity(device_id, DEVICE_ID_HEX_MAX_SIZE)) {
 		hb_context.code_status = HAWKBIT_METADATA_ERROR;
@@ -946,6 +1053,18 @@ static bool send_request(enum http_method method, enum hawkbit_http_request type
 		break;
 
 	case HAWKBIT_DOWNLOAD:
+#ifdef CONFIG_HAWKBIT_DOWNLOAD_RESUME
+		if (hb_context.dl.resume_offset != 0) {
+#ifndef CONFIG_HAWKBIT_DDI_NO_SECURITY
+			download_headers[n++] = headers[0];
+#endif
+			snprintk(range_header, sizeof(range_header), "Range: bytes=%zu-\r\n",
+				 hb_context.dl.resume_offset);
+			download_headers[n++] = range_header;
+			hb_context.http_req.header_fields = download_headers;
+		}
+#endif
+
 		ret = http_client_req(hb_context.sock, &hb_context.http_req, HAWKBIT_RECV_TIMEOUT,
 				      "HAWKBIT_DOWNLOAD");
 		if (ret < 0) {
@@ -1137,7 +1256,15 @@ enum hawkbit_response hawkbit_probe(void)
 
 	snprintk(hb_context.url_buffer, hb_context.url_buffer_size, "%s", download_http);
 
+#ifdef CONFIG_HAWKBIT_DOWNLOAD_RESUME
+	if (hawkbit_download_init(file_size)) {
+		LOG_ERR("Unable to initialize the image writer");
+		hb_context.code_status = HAWKBIT_DOWNLOAD_ERROR;
+		goto cleanup;
+	}
+#else
 	flash_img_init(&hb_context.flash_ctx);
+#endif
 
 	ret = (int)send_request(HTTP_GET, HAWKBIT_DOWNLOAD,
 			  HAWKBIT_STATUS_FINISHED_NONE,
@@ -1166,9 +1293,16 @@ enum hawkbit_response hawkbit_probe(void)
 	if (flash_img_check(&hb_context.flash_ctx, &fic, FIXED_PARTITION_ID(SLOT1_LABEL))) {
 		LOG_ERR("Firmware - flash validation has failed");
 		hb_context.code_status = HAWKBIT_DOWNLOAD_ERROR;
+#ifdef CONFIG_HAWKBIT_DOWNLOAD_RESUME
+		hawkbit_download_progress_clear();
+#endif
 		goto cleanup;
 	}
 
+#ifdef CONFIG_HAWKBIT_DOWNLOAD_RESUME
+	hawkbit_download_progress_clear();
+#endif
+
 	/* Request mcuboot to upgrade */
 	if (boot_request_upgrade(BOOT_UPGRADE_TEST)) {
 		LOG_ERR("Failed to mark the image in slot 1 as pending");
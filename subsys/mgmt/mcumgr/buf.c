@@ -16,12 +16,31 @@
 NET_BUF_POOL_DEFINE(pkt_pool, CONFIG_MCUMGR_BUF_COUNT, CONFIG_MCUMGR_BUF_SIZE,
 		    CONFIG_MCUMGR_BUF_USER_DATA_SIZE, NULL);
 
+#if CONFIG_MCUMGR_BUF_RSP_COUNT > 0
+NET_BUF_POOL_DEFINE(rsp_pool, CONFIG_MCUMGR_BUF_RSP_COUNT, CONFIG_MCUMGR_BUF_SIZE,
+		    CONFIG_MCUMGR_BUF_USER_DATA_SIZE, NULL);
+#endif
+
 struct net_buf *
 mcumgr_buf_alloc(void)
 {
 	return net_buf_alloc(&pkt_pool, K_NO_WAIT);
 }
 
+struct net_buf *
+mcumgr_buf_alloc_rsp(void)
+{
+#if CONFIG_MCUMGR_BUF_RSP_COUNT > 0
+	struct net_buf *nb = net_buf_alloc(&rsp_pool, K_NO_WAIT);
+
+	if (nb != NULL) {
+		return nb;
+	}
+#endif
+
+	return net_buf_alloc(&pkt_pool, K_NO_WAIT);
+}
+
 void
 mcumgr_buf_free(struct net_buf *nb)
 {
@@ -40,6 +59,75 @@ cbor_nb_reader_init(struct cbor_nb_reader *cnr,
 			       cnr->nb->len, 1);
 }
 
+/* Size of the CBOR byte string header for a string of len bytes */
+static size_t
+cbor_bstr_hdr_len(size_t len)
+{
+	if (len < 24) {
+		return 1;
+	} else if (len <= UINT8_MAX) {
+		return 2;
+	} else if (len <= UINT16_MAX) {
+		return 3;
+	}
+
+	return 5;
+}
+
+uint8_t *
+cbor_nb_bstr_reserve(zcbor_state_t *zse, size_t *len)
+{
+	size_t room = zse->payload_end - zse->payload_mut;
+	size_t hdr_len = cbor_bstr_hdr_len(*len);
+
+	if (room < hdr_len) {
+		hdr_len = cbor_bstr_hdr_len(0);
+		if (room < hdr_len) {
+			return NULL;
+		}
+	}
+
+	*len = MIN(*len, room - hdr_len);
+
+	return zse->payload_mut + hdr_len;
+}
+
+bool
+cbor_nb_bstr_commit(zcbor_state_t *zse, uint8_t *data, size_t len)
+{
+	size_t hdr_len = cbor_bstr_hdr_len(len);
+	uint8_t *hdr = zse->payload_mut;
+
+	if ((data < hdr + hdr_len) || ((data + len) > zse->payload_end)) {
+		return false;
+	}
+
+	/* The header was sized for the reserved length; a shorter string may
+	 * need a shorter header.
+	 */
+	if (data != hdr + hdr_len) {
+		memmove(hdr + hdr_len, data, len);
+	}
+
+	if (hdr_len == 1) {
+		hdr[0] = 0x40 | len;
+	} else if (hdr_len == 2) {
+		hdr[0] = 0x58;
+		hdr[1] = len;
+	} else if (hdr_len == 3) {
+		hdr[0] = 0x59;
+		sys_put_be16(len, &hdr[1]);
+	} else {
+		hdr[0] = 0x5a;
+		sys_put_be32(len, &hdr[1]);
+	}
+
+	zse->payload_mut += hdr_len + len;
+	zse->elem_count++;
+
+	return true;
+}
+
 void
 cbor_nb_writer_init(struct cbor_nb_writer *cnw, struct net_buf *nb)
 {
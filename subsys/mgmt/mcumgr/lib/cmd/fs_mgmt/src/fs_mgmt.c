@@ -94,8 +94,9 @@ fs_mgmt_file_rsp(zcbor_state_t *zse, int rc, uint64_t off)
 static int
 fs_mgmt_file_download(struct mgmt_ctxt *ctxt)
 {
-	uint8_t file_data[FS_MGMT_DL_CHUNK_SIZE];
 	char path[CONFIG_FS_MGMT_PATH_SIZE + 1];
+	uint8_t *file_data;
+	size_t chunk_len;
 	uint64_t off = ULLONG_MAX;
 	size_t bytes_read;
 	size_t file_len;
@@ -142,17 +143,25 @@ fs_mgmt_file_download(struct mgmt_ctxt *ctxt)
 		}
 	}
 
-	/* Read the requested chunk from the file. */
-	rc = fs_mgmt_impl_read(path, off, FS_MGMT_DL_CHUNK_SIZE,
-						   file_data, &bytes_read);
+	ok = fs_mgmt_file_rsp(zse, MGMT_ERR_EOK, off)				&&
+	     zcbor_tstr_put_lit(zse, "data");
+	if (!ok) {
+		return MGMT_ERR_EMSGSIZE;
+	}
+
+	/* Read the requested chunk straight into the response buffer. */
+	chunk_len = FS_MGMT_DL_CHUNK_SIZE;
+	file_data = cbor_nb_bstr_reserve(zse, &chunk_len);
+	if (file_data == NULL) {
+		return MGMT_ERR_EMSGSIZE;
+	}
+
+	rc = fs_mgmt_impl_read(path, off, chunk_len, file_data, &bytes_read);
 	if (rc != 0) {
 		return rc;
 	}
 
-	/* Encode the response. */
-	ok = fs_mgmt_file_rsp(zse, MGMT_ERR_EOK, off)				&&
-	     zcbor_tstr_put_lit(zse, "data")					&&
-	     zcbor_bstr_encode_ptr(zse, file_data, bytes_read)			&&
+	ok = cbor_nb_bstr_commit(zse, file_data, bytes_read)			&&
 	     ((off != 0)							||
 		(zcbor_tstr_put_lit(zse, "len") && zcbor_uint64_put(zse, file_len)));
 
@@ -274,6 +274,7 @@ img_mgmt_impl_erase_slot(int slot)
 
 	if (!empty && rc == 0) {
 		rc = flash_area_erase(fa, 0, fa->fa_size);
+		boot_img_state_invalidate();
 	}
 
 	flash_area_close(fa);
@@ -446,6 +447,7 @@ img_mgmt_impl_erase_image_data(unsigned int off, unsigned int num_bytes)
 	size_t erase_size = page.start_offset + page.size - fa->fa_off;
 
 	rc = flash_area_erase(fa, 0, erase_size);
+	boot_img_state_invalidate();
 
 	if (rc != 0) {
 		LOG_ERR("image slot erase of 0x%zx bytes failed (err %d)", erase_size,
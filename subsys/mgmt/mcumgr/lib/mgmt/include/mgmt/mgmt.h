@@ -8,6 +8,7 @@
 #define H_MGMT_MGMT_
 
 #include <inttypes.h>
+#include <zephyr/kernel.h>
 #include <zephyr/sys/slist.h>
 #include <zephyr/mgmt/mcumgr/buf.h>
 
@@ -192,6 +193,13 @@ struct mgmt_group {
 
 	/* The numeric ID of this group. */
 	uint16_t mg_group_id;
+
+#if CONFIG_MCUMGR_SMP_WORKQUEUE_COUNT > 1
+	/* Serializes the handlers of the group when requests are processed
+	 * concurrently.
+	 */
+	struct k_mutex mg_lock;
+#endif
 };
 
 /**
@@ -243,6 +251,24 @@ void mgmt_unregister_group(struct mgmt_group *group);
  */
 const struct mgmt_handler *mgmt_find_handler(uint16_t group_id, uint16_t command_id);
 
+/**
+ * @brief Locks a command group against concurrent execution of its handlers.
+ *
+ * Handlers keep state shared across the commands of their group, so when
+ * SMP requests are processed on several work queues only one handler of a
+ * group runs at a time. A no-op with a single SMP work queue.
+ *
+ * @param group_id	The group to lock.
+ */
+void mgmt_group_lock(uint16_t group_id);
+
+/**
+ * @brief Unlocks a command group locked with mgmt_group_lock().
+ *
+ * @param group_id	The group to unlock.
+ */
+void mgmt_group_unlock(uint16_t group_id);
+
 /**
  * @brief Encodes a response status into the specified management context.
  *
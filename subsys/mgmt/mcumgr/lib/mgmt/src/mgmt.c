@@ -62,9 +62,53 @@ mgmt_find_handler(uint16_t group_id, uint16_t command_id)
 void
 mgmt_register_group(struct mgmt_group *group)
 {
+#if CONFIG_MCUMGR_SMP_WORKQUEUE_COUNT > 1
+	k_mutex_init(&group->mg_lock);
+#endif
 	sys_slist_append(&mgmt_group_list, &group->node);
 }
 
+#if CONFIG_MCUMGR_SMP_WORKQUEUE_COUNT > 1
+/* Groups sharing an ID share the lock of the first one registered. */
+static struct mgmt_group *
+mgmt_find_group(uint16_t group_id)
+{
+	struct mgmt_group *group;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&mgmt_group_list, group, node) {
+		if (group->mg_group_id == group_id) {
+			return group;
+		}
+	}
+
+	return NULL;
+}
+#endif
+
+void
+mgmt_group_lock(uint16_t group_id)
+{
+#if CONFIG_MCUMGR_SMP_WORKQUEUE_COUNT > 1
+	struct mgmt_group *group = mgmt_find_group(group_id);
+
+	if (group != NULL) {
+		(void)k_mutex_lock(&group->mg_lock, K_FOREVER);
+	}
+#endif
+}
+
+void
+mgmt_group_unlock(uint16_t group_id)
+{
+#if CONFIG_MCUMGR_SMP_WORKQUEUE_COUNT > 1
+	struct mgmt_group *group = mgmt_find_group(group_id);
+
+	if (group != NULL) {
+		(void)k_mutex_unlock(&group->mg_lock);
+	}
+#endif
+}
+
 int
 mgmt_write_rsp_status(struct mgmt_ctxt *ctxt, int errcode)
 {
@@ -133,7 +133,9 @@ smp_handle_single_payload(struct mgmt_ctxt *cbuf, const struct mgmt_hdr *req_hdr
 		mgmt_evt(MGMT_EVT_OP_CMD_RECV, req_hdr->nh_group, req_hdr->nh_id, NULL);
 
 		MGMT_CTXT_SET_RC_RSN(cbuf, NULL);
+		mgmt_group_lock(req_hdr->nh_group);
 		rc = handler_fn(cbuf);
+		mgmt_group_unlock(req_hdr->nh_group);
 
 		/* End response payload. */
 		if (!zcbor_map_end_encode(cbuf->cnbe->zs, CONFIG_MGMT_MAX_MAIN_MAP_ENTRIES) &&
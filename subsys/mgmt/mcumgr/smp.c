@@ -26,9 +26,10 @@ LOG_MODULE_REGISTER(mcumgr_smp, CONFIG_MCUMGR_SMP_LOG_LEVEL);
 #define WEAK
 #endif
 
-K_THREAD_STACK_DEFINE(smp_work_queue_stack, CONFIG_MCUMGR_SMP_WORKQUEUE_STACK_SIZE);
+K_THREAD_STACK_ARRAY_DEFINE(smp_work_queue_stacks, CONFIG_MCUMGR_SMP_WORKQUEUE_COUNT,
+			    CONFIG_MCUMGR_SMP_WORKQUEUE_STACK_SIZE);
 
-static struct k_work_q smp_work_queue;
+static struct k_work_q smp_work_queues[CONFIG_MCUMGR_SMP_WORKQUEUE_COUNT];
 
 static const struct k_work_queue_config smp_work_queue_config = {
 	.name = "mcumgr smp"
@@ -54,7 +55,7 @@ void *zephyr_smp_alloc_rsp(const void *req, void *arg)
 
 	req_nb = req;
 
-	rsp_nb = mcumgr_buf_alloc();
+	rsp_nb = mcumgr_buf_alloc_rsp();
 	if (rsp_nb == NULL) {
 		return NULL;
 	}
@@ -149,6 +150,8 @@ zephyr_smp_transport_init(struct zephyr_smp_transport *zst,
 			  zephyr_smp_transport_ud_copy_fn *ud_copy_func,
 			  zephyr_smp_transport_ud_free_fn *ud_free_func)
 {
+	static atomic_t transport_cnt;
+
 	*zst = (struct zephyr_smp_transport) {
 		.zst_output = output_func,
 		.zst_get_mtu = get_mtu_func,
@@ -156,6 +159,10 @@ zephyr_smp_transport_init(struct zephyr_smp_transport *zst,
 		.zst_ud_free = ud_free_func,
 	};
 
+	/* Spread the transports over the available work queues */
+	zst->zst_work_queue = &smp_work_queues[atomic_inc(&transport_cnt) %
+					       ARRAY_SIZE(smp_work_queues)];
+
 #ifdef CONFIG_MCUMGR_SMP_REASSEMBLY
 	zephyr_smp_reassembly_init(zst);
 #endif
@@ -177,16 +184,19 @@ WEAK void
 zephyr_smp_rx_req(struct zephyr_smp_transport *zst, struct net_buf *nb)
 {
 	net_buf_put(&zst->zst_fifo, nb);
-	k_work_submit_to_queue(&smp_work_queue, &zst->zst_work);
+	k_work_submit_to_queue(zst->zst_work_queue, &zst->zst_work);
 }
 
 static int zephyr_smp_init(const struct device *dev)
 {
-	k_work_queue_init(&smp_work_queue);
+	for (size_t i = 0; i < ARRAY_SIZE(smp_work_queues); i++) {
+		k_work_queue_init(&smp_work_queues[i]);
 
-	k_work_queue_start(&smp_work_queue, smp_work_queue_stack,
-			   K_THREAD_STACK_SIZEOF(smp_work_queue_stack),
-			   CONFIG_MCUMGR_SMP_WORKQUEUE_THREAD_PRIO, &smp_work_queue_config);
+		k_work_queue_start(&smp_work_queues[i], smp_work_queue_stacks[i],
+				   K_THREAD_STACK_SIZEOF(smp_work_queue_stacks[i]),
+				   CONFIG_MCUMGR_SMP_WORKQUEUE_THREAD_PRIO,
+				   &smp_work_queue_config);
+	}
 
 	return 0;
 }
@@ -91,8 +91,15 @@ struct modbus_serial_config {
 	struct gpio_dt_spec *de;
 	/* Pointer to receiver enable (nRE) pin config */
 	struct gpio_dt_spec *re;
+#ifdef CONFIG_MODBUS_SERIAL_ASYNC
+	/* Reception is enabled, frames reported by the driver are valid */
+	bool rx_active;
+	/* Enable reception again once the driver reports UART_RX_DISABLED */
+	bool rx_restart;
+#else
 	/* RTU timer to detect frame end point */
 	struct k_timer rtu_timer;
+#endif
 	/* Number of bytes received or to send */
 	uint16_t uart_buf_ctr;
 	/* Storage of received characters or characters to send */
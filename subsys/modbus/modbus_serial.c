@@ -29,6 +29,134 @@ LOG_MODULE_REGISTER(modbus_serial, CONFIG_MODBUS_LOG_LEVEL);
 #include <zephyr/sys/crc.h>
 #include <modbus_internal.h>
 
+#ifdef CONFIG_MODBUS_CRC16_TABLE
+/* CRC-16/MODBUS (reflected polynomial 0xA001), one entry per input byte */
+static const uint16_t modbus_crc16_table[256] = {
+	0x0000, 0xC0C1, 0xC181, 0x0140, 0xC301, 0x03C0, 0x0280, 0xC241,
+	0xC601, 0x06C0, 0x0780, 0xC741, 0x0500, 0xC5C1, 0xC481, 0x0440,
+	0xCC01, 0x0CC0, 0x0D80, 0xCD41, 0x0F00, 0xCFC1, 0xCE81, 0x0E40,
+	0x0A00, 0xCAC1, 0xCB81, 0x0B40, 0xC901, 0x09C0, 0x0880, 0xC841,
+	0xD801, 0x18C0, 0x1980, 0xD941, 0x1B00, 0xDBC1, 0xDA81, 0x1A40,
+	0x1E00, 0xDEC1, 0xDF81, 0x1F40, 0xDD01, 0x1DC0, 0x1C80, 0xDC41,
+	0x1400, 0xD4C1, 0xD581, 0x1540, 0xD701, 0x17C0, 0x1680, 0xD641,
+	0xD201, 0x12C0, 0x1380, 0xD341, 0x1100, 0xD1C1, 0xD081, 0x1040,
+	0xF001, 0x30C0, 0x3180, 0xF141, 0x3300, 0xF3C1, 0xF281, 0x3240,
+	0x3600, 0xF6C1, 0xF781, 0x3740, 0xF501, 0x35C0, 0x3480, 0xF441,
+	0x3C00, 0xFCC1, 0xFD81, 0x3D40, 0xFF01, 0x3FC0, 0x3E80, 0xFE41,
+	0xFA01, 0x3AC0, 0x3B80, 0xFB41, 0x3900, 0xF9C1, 0xF881, 0x3840,
+	0x2800, 0xE8C1, 0xE981, 0x2940, 0xEB01, 0x2BC0, 0x2A80, 0xEA41,
+	0xEE01, 0x2EC0, 0x2F80, 0xEF41, 0x2D00, 0xEDC1, 0xEC81, 0x2C40,
+	0xE401, 0x24C0, 0x2580, 0xE541, 0x2700, 0xE7C1, 0xE681, 0x2640,
+	0x2200, 0xE2C1, 0xE381, 0x2340, 0xE101, 0x21C0, 0x2080, 0xE041,
+	0xA001, 0x60C0, 0x6180, 0xA141, 0x6300, 0xA3C1, 0xA281, 0x6240,
+	0x6600, 0xA6C1, 0xA781, 0x6740, 0xA501, 0x65C0, 0x6480, 0xA441,
+	0x6C00, 0xACC1, 0xAD81, 0x6D40, 0xAF01, 0x6FC0, 0x6E80, 0xAE41,
+	0xAA01, 0x6AC0, 0x6B80, 0xAB41, 0x6900, 0xA9C1, 0xA881, 0x6840,
+	0x7800, 0xB8C1, 0xB981, 0x7940, 0xBB01, 0x7BC0, 0x7A80, 0xBA41,
+	0xBE01, 0x7EC0, 0x7F80, 0xBF41, 0x7D00, 0xBDC1, 0xBC81, 0x7C40,
+	0xB401, 0x74C0, 0x7580, 0xB541, 0x7700, 0xB7C1, 0xB681, 0x7640,
+	0x7200, 0xB2C1, 0xB381, 0x7340, 0xB101, 0x71C0, 0x7080, 0xB041,
+	0x5000, 0x90C1, 0x9181, 0x5140, 0x9301, 0x53C0, 0x5280, 0x9241,
+	0x9601, 0x56C0, 0x5780, 0x9741, 0x5500, 0x95C1, 0x9481, 0x5440,
+	0x9C01, 0x5CC0, 0x5D80, 0x9D41, 0x5F00, 0x9FC1, 0x9E81, 0x5E40,
+	0x5A00, 0x9AC1, 0x9B81, 0x5B40, 0x9901, 0x59C0, 0x5880, 0x9841,
+	0x8801, 0x48C0, 0x4980, 0x8941, 0x4B00, 0x8BC1, 0x8A81, 0x4A40,
+	0x4E00, 0x8EC1, 0x8F81, 0x4F40, 0x8D01, 0x4DC0, 0x4C80, 0x8C41,
+	0x4400, 0x84C1, 0x8581, 0x4540, 0x8701, 0x47C0, 0x4680, 0x8641,
+	0x8201, 0x42C0, 0x4380, 0x8341, 0x4100, 0x81C1, 0x8081, 0x4040,
+};
+
+static uint16_t modbus_crc16(const uint8_t *src, size_t len)
+{
+	uint16_t crc = 0xFFFF;
+
+	while (len-- > 0) {
+		crc = (crc >> 8) ^ modbus_crc16_table[(crc ^ *src++) & 0xFF];
+	}
+
+	return crc;
+}
+#else
+static uint16_t modbus_crc16(const uint8_t *src, size_t len)
+{
+	return crc16_ansi(src, len);
+}
+#endif
+
+#ifdef CONFIG_MODBUS_SERIAL_ASYNC
+static void modbus_serial_rx_on(struct modbus_context *ctx);
+
+static void modbus_serial_tx_on(struct modbus_context *ctx)
+{
+	struct modbus_serial_config *cfg = ctx->cfg;
+	int err;
+
+	if (cfg->de != NULL) {
+		gpio_pin_set(cfg->de->port, cfg->de->pin, 1);
+	}
+
+	/* The whole ADU is handed to the driver, the next event is TX_DONE */
+	err = uart_tx(cfg->dev, cfg->uart_buf, cfg->uart_buf_ctr,
+		      SYS_FOREVER_US);
+	if (err != 0) {
+		LOG_ERR("Failed to start transmission, %d", err);
+		if (cfg->de != NULL) {
+			gpio_pin_set(cfg->de->port, cfg->de->pin, 0);
+		}
+
+		modbus_serial_rx_on(ctx);
+	}
+}
+
+static void modbus_serial_tx_off(struct modbus_context *ctx)
+{
+	struct modbus_serial_config *cfg = ctx->cfg;
+
+	if (cfg->de != NULL) {
+		gpio_pin_set(cfg->de->port, cfg->de->pin, 0);
+	}
+}
+
+static void modbus_serial_rx_on(struct modbus_context *ctx)
+{
+	struct modbus_serial_config *cfg = ctx->cfg;
+	int err;
+
+	if (cfg->re != NULL) {
+		gpio_pin_set(cfg->re->port, cfg->re->pin, 1);
+	}
+
+	cfg->uart_buf_ctr = 0;
+	cfg->uart_buf_ptr = &cfg->uart_buf[0];
+	cfg->rx_active = true;
+
+	/*
+	 * Every frame is received at the start of the buffer. The driver
+	 * reports the frame with UART_RX_RDY once the line has been idle
+	 * for the RTU timeout.
+	 */
+	err = uart_rx_enable(cfg->dev, cfg->uart_buf, CONFIG_MODBUS_BUFFER_SIZE,
+			     cfg->rtu_timeout);
+	if (err == -EBUSY) {
+		/* Previous reception is still being disabled */
+		cfg->rx_restart = true;
+	} else if (err != 0) {
+		LOG_ERR("Failed to enable reception, %d", err);
+	}
+}
+
+static void modbus_serial_rx_off(struct modbus_context *ctx)
+{
+	struct modbus_serial_config *cfg = ctx->cfg;
+
+	cfg->rx_active = false;
+	cfg->rx_restart = false;
+	(void)uart_rx_disable(cfg->dev);
+	if (cfg->re != NULL) {
+		gpio_pin_set(cfg->re->port, cfg->re->pin, 0);
+	}
+}
+#else
 static void modbus_serial_tx_on(struct modbus_context *ctx)
 {
 	struct modbus_serial_config *cfg = ctx->cfg;
@@ -71,6 +199,8 @@ static void modbus_serial_rx_off(struct modbus_context *ctx)
 	}
 }
 
+#endif
+
 #ifdef CONFIG_MODBUS_ASCII_MODE
 /* The function calculates an 8-bit Longitudinal Redundancy Check. */
 static uint8_t modbus_ascii_get_lrc(uint8_t *src, size_t length)
@@ -266,8 +396,8 @@ static int modbus_rtu_rx_adu(struct modbus_context *ctx)
 
 	ctx->rx_adu.crc = sys_get_le16(&cfg->uart_buf[crc_idx]);
 	/* Calculate CRC over address, function code, and payload */
-	calc_crc = crc16_ansi(&cfg->uart_buf[0],
-			      cfg->uart_buf_ctr - sizeof(ctx->rx_adu.crc));
+	calc_crc = modbus_crc16(&cfg->uart_buf[0],
+				cfg->uart_buf_ctr - sizeof(ctx->rx_adu.crc));
 
 	if (ctx->rx_adu.crc != calc_crc) {
 		LOG_WRN("Calculated CRC does not match received CRC");
@@ -290,7 +420,7 @@ static void rtu_tx_adu(struct modbus_context *ctx)
 
 	memcpy(data_ptr, ctx->tx_adu.data, ctx->tx_adu.length);
 
-	ctx->tx_adu.crc = crc16_ansi(&cfg->uart_buf[0], ctx->tx_adu.length + 2);
+	ctx->tx_adu.crc = modbus_crc16(&cfg->uart_buf[0], ctx->tx_adu.length + 2);
 	sys_put_le16(ctx->tx_adu.crc,
 		     &cfg->uart_buf[ctx->tx_adu.length + 2]);
 	tx_bytes += 2;
@@ -304,6 +434,56 @@ static void rtu_tx_adu(struct modbus_context *ctx)
 	modbus_serial_tx_on(ctx);
 }
 
+#ifdef CONFIG_MODBUS_SERIAL_ASYNC
+static void uart_async_handler(const struct device *dev,
+			       struct uart_event *evt, void *user_data)
+{
+	struct modbus_context *ctx = (struct modbus_context *)user_data;
+	struct modbus_serial_config *cfg;
+
+	if (ctx == NULL) {
+		LOG_ERR("Modbus hardware is not properly initialized");
+		return;
+	}
+
+	cfg = ctx->cfg;
+
+	switch (evt->type) {
+	case UART_TX_DONE:
+	case UART_TX_ABORTED:
+		cfg->uart_buf_ptr = &cfg->uart_buf[0];
+		modbus_serial_tx_off(ctx);
+		modbus_serial_rx_on(ctx);
+		break;
+	case UART_RX_RDY:
+		/* Data reported after reception was turned off is dropped */
+		if (!cfg->rx_active) {
+			break;
+		}
+
+		cfg->uart_buf_ctr = evt->data.rx.offset + evt->data.rx.len;
+		cfg->uart_buf_ptr = &cfg->uart_buf[cfg->uart_buf_ctr];
+		k_work_submit(&ctx->server_work);
+		break;
+	case UART_RX_STOPPED:
+		LOG_WRN("Reception stopped, reason %d",
+			evt->data.rx_stop.reason);
+		break;
+	case UART_RX_DISABLED:
+		if (cfg->rx_restart) {
+			cfg->rx_restart = false;
+			modbus_serial_rx_on(ctx);
+		}
+		break;
+	default:
+		/*
+		 * No further buffer is provided on UART_RX_BUF_REQUEST,
+		 * the largest ADU fits into the single receive buffer.
+		 */
+		break;
+	}
+}
+#else
 /*
  * A byte has been received from a serial port. We just store it in the buffer
  * for processing when a complete packet has been received.
@@ -416,6 +596,8 @@ static void rtu_tmr_handler(struct k_timer *t_id)
 	k_work_submit(&ctx->server_work);
 }
 
+#endif
+
 static int configure_gpio(struct modbus_context *ctx)
 {
 	struct modbus_serial_config *cfg = ctx->cfg;
@@ -578,9 +760,18 @@ int modbus_serial_init(struct modbus_context *ctx,
 	cfg->uart_buf_ctr = 0;
 	cfg->uart_buf_ptr = &cfg->uart_buf[0];
 
+#ifdef CONFIG_MODBUS_SERIAL_ASYNC
+	cfg->rx_active = false;
+	cfg->rx_restart = false;
+	if (uart_callback_set(cfg->dev, uart_async_handler, ctx) != 0) {
+		LOG_ERR("UART does not support the asynchronous API");
+		return -ENOTSUP;
+	}
+#else
 	uart_irq_callback_user_data_set(cfg->dev, uart_cb_handler, ctx);
 	k_timer_init(&cfg->rtu_timer, rtu_tmr_handler, NULL);
 	k_timer_user_data_set(&cfg->rtu_timer, ctx);
+#endif
 
 	modbus_serial_rx_on(ctx);
 	LOG_INF("RTU timeout %u us", cfg->rtu_timeout);
@@ -590,7 +781,12 @@ int modbus_serial_init(struct modbus_context *ctx,
 
 void modbus_serial_disable(struct modbus_context *ctx)
 {
+#ifdef CONFIG_MODBUS_SERIAL_ASYNC
+	(void)uart_tx_abort(ctx->cfg->dev);
+#endif
 	modbus_serial_tx_off(ctx);
 	modbus_serial_rx_off(ctx);
+#ifndef CONFIG_MODBUS_SERIAL_ASYNC
 	k_timer_stop(&ctx->cfg->rtu_timer);
+#endif
 }
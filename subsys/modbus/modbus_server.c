@@ -291,6 +291,34 @@ static bool mbs_fc02_di_read(struct modbus_context *ctx)
 	return true;
 }
 
+/*
+ * Serve a register read from a register map. The registers are stored
+ * in wire byte order, a request within the map is answered with a
+ * single copy. Returns false if the request is not covered by the map.
+ */
+static bool mbs_reg_map_read(struct modbus_context *ctx,
+			     const struct modbus_reg_map *map,
+			     uint16_t reg_addr, uint16_t reg_qty)
+{
+	const uint16_t regs_limit = 125;
+	uint16_t num_bytes;
+
+	if (map == NULL || reg_qty == 0 || reg_qty > regs_limit ||
+	    reg_addr < map->start_addr ||
+	    ((uint32_t)reg_addr + reg_qty) >
+	    ((uint32_t)map->start_addr + map->num_regs)) {
+		return false;
+	}
+
+	num_bytes = reg_qty * sizeof(uint16_t);
+	ctx->tx_adu.length = num_bytes + 1;
+	ctx->tx_adu.data[0] = (uint8_t)num_bytes;
+	memcpy(&ctx->tx_adu.data[1], &map->regs[reg_addr - map->start_addr],
+	       num_bytes);
+
+	return true;
+}
+
 /*
  * 03 (0x03) Read Holding Registers
  *
@@ -322,6 +350,10 @@ static bool mbs_fc03_hreg_read(struct modbus_context *ctx)
 	reg_addr = sys_get_be16(&ctx->rx_adu.data[0]);
 	reg_qty = sys_get_be16(&ctx->rx_adu.data[2]);
 
+	if (mbs_reg_map_read(ctx, ctx->mbs_user_cb->holding_reg_map, reg_addr, reg_qty)) {
+		return true;
+	}
+
 	if ((reg_addr < MODBUS_FP_EXTENSIONS_ADDR) ||
 	    !IS_ENABLED(CONFIG_MODBUS_FP_EXTENSIONS)) {
 		/* Read integer register */
@@ -432,6 +464,10 @@ static bool mbs_fc04_inreg_read(struct modbus_context *ctx)
 	reg_addr = sys_get_be16(&ctx->rx_adu.data[0]);
 	reg_qty = sys_get_be16(&ctx->rx_adu.data[2]);
 
+	if (mbs_reg_map_read(ctx, ctx->mbs_user_cb->input_reg_map, reg_addr, reg_qty)) {
+		return true;
+	}
+
 	if ((reg_addr < MODBUS_FP_EXTENSIONS_ADDR) ||
 	    !IS_ENABLED(CONFIG_MODBUS_FP_EXTENSIONS)) {
 		/* Read integer register */
@@ -0,0 +1,305 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(modbus_tcp_server, CONFIG_MODBUS_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/sys/byteorder.h>
+#include <modbus_internal.h>
+
+#define MODBUS_TCP_MAX_CONN		CONFIG_MODBUS_TCP_SERVER_MAX_CONNECTIONS
+/* The MBAP length field counts the unit ID and all following bytes */
+#define MODBUS_TCP_LENGTH_OFFSET	4
+#define MODBUS_TCP_LENGTH_MIN		2
+#define MODBUS_TCP_LENGTH_MAX		CONFIG_MODBUS_BUFFER_SIZE
+#define MODBUS_TCP_FRAME_MAX		(MODBUS_MBAP_LENGTH - 1 + \
+					 MODBUS_TCP_LENGTH_MAX)
+/* Responses to pipelined requests are sent in batches */
+#define MODBUS_TCP_TX_BUF_SIZE		(2 * MODBUS_TCP_FRAME_MAX)
+
+struct modbus_tcp_conn {
+	int sock;
+	uint16_t rx_len;
+	uint8_t rx_buf[MODBUS_TCP_FRAME_MAX];
+};
+
+static struct modbus_tcp_conn conns[MODBUS_TCP_MAX_CONN];
+static struct zsock_pollfd fds[MODBUS_TCP_MAX_CONN + 1];
+static uint8_t tx_buf[MODBUS_TCP_TX_BUF_SIZE];
+static struct modbus_context *server_ctx;
+static int server_sock = -1;
+
+static K_KERNEL_STACK_DEFINE(server_stack, CONFIG_MODBUS_TCP_SERVER_STACK_SIZE);
+static struct k_thread server_thread;
+
+static int send_all(int sock, const uint8_t *buf, size_t len)
+{
+	while (len > 0) {
+		ssize_t n = zsock_send(sock, buf, len, 0);
+
+		if (n < 0) {
+			return -errno;
+		}
+
+		buf += n;
+		len -= n;
+	}
+
+	return 0;
+}
+
+static void conn_close(struct modbus_tcp_conn *conn)
+{
+	LOG_DBG("Close connection %d", conn->sock);
+	(void)zsock_close(conn->sock);
+	conn->sock = -1;
+	conn->rx_len = 0;
+}
+
+/*
+ * Let the server handle one request frame, and append the response
+ * to the transmit buffer. Returns the new transmit buffer length.
+ */
+static size_t handle_frame(struct modbus_tcp_conn *conn,
+			   const uint8_t *frame, size_t tx_len)
+{
+	struct modbus_context *ctx = server_ctx;
+	size_t rsp_len;
+	bool respond;
+
+	k_mutex_lock(&ctx->iface_lock, K_FOREVER);
+
+	modbus_raw_get_header(&ctx->rx_adu, frame);
+	memcpy(ctx->rx_adu.data, &frame[MODBUS_MBAP_AND_FC_LENGTH],
+	       MIN(ctx->rx_adu.length, sizeof(ctx->rx_adu.data)));
+	ctx->rx_adu_err = modbus_raw_rx_adu(ctx);
+
+	respond = modbus_server_handler(ctx);
+	if (respond) {
+		rsp_len = MODBUS_MBAP_AND_FC_LENGTH + ctx->tx_adu.length;
+
+		if (tx_len + rsp_len > sizeof(tx_buf)) {
+			if (send_all(conn->sock, tx_buf, tx_len) != 0) {
+				LOG_WRN("Failed to send responses");
+			}
+
+			tx_len = 0;
+		}
+
+		modbus_raw_put_header(&ctx->tx_adu, &tx_buf[tx_len]);
+		memcpy(&tx_buf[tx_len + MODBUS_MBAP_AND_FC_LENGTH],
+		       ctx->tx_adu.data, ctx->tx_adu.length);
+		tx_len += rsp_len;
+	}
+
+	k_mutex_unlock(&ctx->iface_lock);
+
+	return tx_len;
+}
+
+/*
+ * Handle all complete frames in the receive buffer of the connection.
+ * A client may send further requests before it has received the
+ * response to the previous one, responses are sent in request order.
+ */
+static int conn_process(struct modbus_tcp_conn *conn)
+{
+	size_t offset = 0;
+	size_t tx_len = 0;
+	int err = 0;
+
+	while (conn->rx_len - offset >= MODBUS_MBAP_AND_FC_LENGTH) {
+		const uint8_t *frame = &conn->rx_buf[offset];
+		uint16_t length;
+
+		length = sys_get_be16(&frame[MODBUS_TCP_LENGTH_OFFSET]);
+		if (length < MODBUS_TCP_LENGTH_MIN ||
+		    length > MODBUS_TCP_LENGTH_MAX) {
+			/* Frame boundaries are lost, drop the connection */
+			LOG_WRN("Invalid MBAP length %u", length);
+			err = -EMSGSIZE;
+			break;
+		}
+
+		if (conn->rx_len - offset < MODBUS_MBAP_LENGTH - 1 + length) {
+			break;
+		}
+
+		tx_len = handle_frame(conn, frame, tx_len);
+		offset += MODBUS_MBAP_LENGTH - 1 + length;
+	}
+
+	if (tx_len > 0 && send_all(conn->sock, tx_buf, tx_len) != 0) {
+		LOG_WRN("Failed to send responses");
+		err = -EIO;
+	}
+
+	conn->rx_len -= offset;
+	memmove(conn->rx_buf, &conn->rx_buf[offset], conn->rx_len);
+
+	return err;
+}
+
+static void conn_receive(struct modbus_tcp_conn *conn)
+{
+	ssize_t n;
+
+	n = zsock_recv(conn->sock, &conn->rx_buf[conn->rx_len],
+		       sizeof(conn->rx_buf) - conn->rx_len, 0);
+	if (n <= 0) {
+		conn_close(conn);
+		return;
+	}
+
+	conn->rx_len += n;
+	if (conn_process(conn) != 0) {
+		conn_close(conn);
+	}
+}
+
+static void server_accept(void)
+{
+	int sock;
+
+	sock = zsock_accept(server_sock, NULL, NULL);
+	if (sock < 0) {
+		LOG_ERR("Failed to accept connection, %d", errno);
+		return;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(conns); i++) {
+		if (conns[i].sock < 0) {
+			LOG_DBG("New connection %d", sock);
+			conns[i].sock = sock;
+			conns[i].rx_len = 0;
+			return;
+		}
+	}
+
+	LOG_WRN("No free connection slot");
+	(void)zsock_close(sock);
+}
+
+static void server_thread_fn(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		int nfds = 1;
+		int ret;
+
+		fds[0].fd = server_sock;
+		fds[0].events = ZSOCK_POLLIN;
+
+		for (int i = 0; i < ARRAY_SIZE(conns); i++) {
+			fds[i + 1].fd = conns[i].sock;
+			fds[i + 1].events = ZSOCK_POLLIN;
+			fds[i + 1].revents = 0;
+			if (conns[i].sock >= 0) {
+				nfds = i + 2;
+			}
+		}
+
+		ret = zsock_poll(fds, nfds, -1);
+		if (ret < 0) {
+			LOG_ERR("Poll failed, %d", errno);
+			k_sleep(K_MSEC(100));
+			continue;
+		}
+
+		for (int i = 0; i < ARRAY_SIZE(conns); i++) {
+			if (conns[i].sock < 0 || fds[i + 1].revents == 0) {
+				continue;
+			}
+
+			if (fds[i + 1].revents & ZSOCK_POLLIN) {
+				conn_receive(&conns[i]);
+			} else {
+				conn_close(&conns[i]);
+			}
+		}
+
+		if (fds[0].revents & ZSOCK_POLLIN) {
+			server_accept();
+		}
+	}
+}
+
+int modbus_tcp_server_start(const int iface, const uint16_t port)
+{
+	struct sockaddr_storage addr = { 0 };
+	socklen_t addrlen;
+	struct modbus_context *ctx;
+	int sock;
+
+	if (server_ctx != NULL) {
+		return -EALREADY;
+	}
+
+	ctx = modbus_get_context(iface);
+	if (ctx == NULL) {
+		LOG_ERR("Interface %d not available", iface);
+		return -ENODEV;
+	}
+
+	if (ctx->mode != MODBUS_MODE_RAW || ctx->client) {
+		LOG_ERR("Interface %d is not a raw ADU server", iface);
+		return -ENOTSUP;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV4)) {
+		struct sockaddr_in *addr4 = (struct sockaddr_in *)&addr;
+
+		addr4->sin_family = AF_INET;
+		addr4->sin_addr.s_addr = htonl(INADDR_ANY);
+		addr4->sin_port = htons(port);
+		addrlen = sizeof(*addr4);
+	} else {
+		struct sockaddr_in6 *addr6 = (struct sockaddr_in6 *)&addr;
+
+		addr6->sin6_family = AF_INET6;
+		addr6->sin6_addr = in6addr_any;
+		addr6->sin6_port = htons(port);
+		addrlen = sizeof(*addr6);
+	}
+
+	sock = zsock_socket(addr.ss_family, SOCK_STREAM, IPPROTO_TCP);
+	if (sock < 0) {
+		LOG_ERR("Failed to create socket, %d", errno);
+		return -errno;
+	}
+
+	if (zsock_bind(sock, (struct sockaddr *)&addr, addrlen) < 0 ||
+	    zsock_listen(sock, MODBUS_TCP_MAX_CONN) < 0) {
+		int err = -errno;
+
+		LOG_ERR("Failed to listen on port %u, %d", port, err);
+		(void)zsock_close(sock);
+		return err;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(conns); i++) {
+		conns[i].sock = -1;
+		conns[i].rx_len = 0;
+	}
+
+	server_sock = sock;
+	server_ctx = ctx;
+
+	k_thread_create(&server_thread, server_stack,
+			K_KERNEL_STACK_SIZEOF(server_stack),
+			server_thread_fn, NULL, NULL, NULL,
+			CONFIG_MODBUS_TCP_SERVER_THREAD_PRIORITY, 0, K_NO_WAIT);
+	k_thread_name_set(&server_thread, "modbus_tcp");
+
+	LOG_INF("Modbus TCP server listening on port %u", port);
+
+	return 0;
+}
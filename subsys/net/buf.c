@@ -17,6 +17,7 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 #include <stddef.h>
 #include <string.h>
 #include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/math_extras.h>
 
 #include <zephyr/net/buf.h>
 
@@ -65,6 +66,7 @@ int net_buf_id(struct net_buf *buf)
 	return offset / struct_size;
 }
 
+#if !defined(CONFIG_NET_BUF_POOL_LOCKFREE)
 static inline struct net_buf *pool_get_uninit(struct net_buf_pool *pool,
 					      uint16_t uninit_count)
 {
@@ -80,6 +82,115 @@ static inline struct net_buf *pool_get_uninit(struct net_buf_pool *pool,
 
 	return buf;
 }
+#endif /* !CONFIG_NET_BUF_POOL_LOCKFREE */
+
+#if defined(CONFIG_NET_BUF_POOL_LOCKFREE)
+static inline struct net_buf *pool_get_buf(struct net_buf_pool *pool, int id)
+{
+	size_t struct_size = ROUND_UP(sizeof(struct net_buf) + pool->user_data_size,
+				__alignof__(struct net_buf));
+	struct net_buf *buf;
+
+	buf = (struct net_buf *)(((uint8_t *)pool->__bufs) + id * struct_size);
+
+	buf->pool_id = pool_id(pool);
+	buf->user_data_size = pool->user_data_size;
+
+	return buf;
+}
+
+/* Take up to count free buffers, marking them as used in the bitmap with
+ * one atomic operation per bitmap word.
+ */
+static int pool_take(struct net_buf_pool *pool, struct net_buf **bufs,
+		     int count)
+{
+	int words = ATOMIC_BITMAP_SIZE(pool->buf_count);
+	int n = 0;
+
+	for (int i = 0; i < words && n < count; i++) {
+		unsigned long mask = ~0UL;
+
+		if (i == words - 1 && (pool->buf_count % ATOMIC_BITS)) {
+			mask = BIT_MASK(pool->buf_count % ATOMIC_BITS);
+		}
+
+		while (true) {
+			atomic_val_t used = atomic_get(&pool->used[i]);
+			unsigned long avail = ~(unsigned long)used & mask;
+			unsigned long take = 0UL;
+
+			for (int k = n; avail && k < count; k++) {
+				take |= avail & -avail;
+				avail &= avail - 1UL;
+			}
+
+			if (!take) {
+				break;
+			}
+
+			if (!atomic_cas(&pool->used[i], used, used | take)) {
+				continue;
+			}
+
+			for ( ; take; take &= take - 1UL) {
+				bufs[n++] = pool_get_buf(pool, i * ATOMIC_BITS +
+						 u64_count_trailing_zeros(take));
+			}
+
+			break;
+		}
+	}
+
+	return n;
+}
+
+static struct net_buf *pool_alloc(struct net_buf_pool *pool,
+				  k_timeout_t timeout)
+{
+	struct net_buf *buf;
+
+	if (pool_take(pool, &buf, 1)) {
+		return buf;
+	}
+
+	/* Buffers handed over to waiters that since gave up */
+	buf = k_lifo_get(&pool->free, K_NO_WAIT);
+	if (buf || K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		return buf;
+	}
+
+	/* From now on freed buffers are passed through the LIFO, look again
+	 * in case one was freed before that.
+	 */
+	atomic_inc(&pool->waiters);
+
+	if (!pool_take(pool, &buf, 1)) {
+		buf = k_lifo_get(&pool->free, timeout);
+	}
+
+	atomic_dec(&pool->waiters);
+
+	return buf;
+}
+
+void net_buf_destroy(struct net_buf *buf)
+{
+	struct net_buf_pool *pool = net_buf_pool_get(buf->pool_id);
+	int id = net_buf_id(buf);
+	atomic_t *used = ATOMIC_ELEM(pool->used, id);
+	atomic_val_t bit = ATOMIC_MASK(id);
+
+	(void)atomic_and(used, ~bit);
+
+	/* A thread may have started waiting without seeing the buffer free:
+	 * take it back, unless someone else already did, and hand it over.
+	 */
+	if (atomic_get(&pool->waiters) > 0 && !(atomic_or(used, bit) & bit)) {
+		k_lifo_put(&pool->free, buf);
+	}
+}
+#endif /* CONFIG_NET_BUF_POOL_LOCKFREE */
 
 void net_buf_reset(struct net_buf *buf)
 {
@@ -239,16 +350,18 @@ struct net_buf *net_buf_alloc_len(struct net_buf_pool *pool, size_t size,
 {
 	uint64_t end = sys_clock_timeout_end_calc(timeout);
 	struct net_buf *buf;
-	k_spinlock_key_t key;
 
 	__ASSERT_NO_MSG(pool);
 
 	NET_BUF_DBG("%s():%d: pool %p size %zu", func, line, pool, size);
 
+#if defined(CONFIG_NET_BUF_POOL_LOCKFREE)
+	buf = pool_alloc(pool, timeout);
+#else
 	/* We need to prevent race conditions
 	 * when accessing pool->uninit_count.
 	 */
-	key = k_spin_lock(&pool->lock);
+	k_spinlock_key_t key = k_spin_lock(&pool->lock);
 
 	/* If there are uninitialized buffers we're guaranteed to succeed
 	 * with the allocation one way or another.
@@ -306,12 +419,15 @@ struct net_buf *net_buf_alloc_len(struct net_buf_pool *pool, size_t size,
 #else
 	buf = k_lifo_get(&pool->free, timeout);
 #endif
+#endif /* CONFIG_NET_BUF_POOL_LOCKFREE */
 	if (!buf) {
 		NET_BUF_ERR("%s():%d: Failed to get free buffer", func, line);
 		return NULL;
 	}
 
+#if !defined(CONFIG_NET_BUF_POOL_LOCKFREE)
 success:
+#endif
 	NET_BUF_DBG("allocated buf %p", buf);
 
 	if (size) {
@@ -377,6 +493,53 @@ struct net_buf *net_buf_alloc_fixed(struct net_buf_pool *pool,
 }
 #endif
 
+int net_buf_alloc_batch(struct net_buf_pool *pool, struct net_buf **bufs,
+			int count)
+{
+	int n;
+
+	__ASSERT_NO_MSG(pool->alloc->cb == &net_buf_fixed_cb);
+
+#if defined(CONFIG_NET_BUF_POOL_LOCKFREE)
+	n = pool_take(pool, bufs, count);
+
+	while (n < count) {
+		bufs[n] = k_lifo_get(&pool->free, K_NO_WAIT);
+		if (!bufs[n]) {
+			break;
+		}
+
+		n++;
+	}
+
+	for (int i = 0; i < n; i++) {
+		struct net_buf *buf = bufs[i];
+		size_t size = SIZE_MAX;
+
+		buf->__buf = data_alloc(buf, &size, K_NO_WAIT);
+		buf->ref   = 1U;
+		buf->flags = 0U;
+		buf->frags = NULL;
+		buf->size  = size;
+		net_buf_reset(buf);
+
+#if defined(CONFIG_NET_BUF_POOL_USAGE)
+		atomic_dec(&pool->avail_count);
+		__ASSERT_NO_MSG(atomic_get(&pool->avail_count) >= 0);
+#endif
+	}
+#else
+	for (n = 0; n < count; n++) {
+		bufs[n] = net_buf_alloc_fixed(pool, K_NO_WAIT);
+		if (!bufs[n]) {
+			break;
+		}
+	}
+#endif /* CONFIG_NET_BUF_POOL_LOCKFREE */
+
+	return n;
+}
+
 #if defined(CONFIG_NET_BUF_LOG)
 struct net_buf *net_buf_alloc_with_data_debug(struct net_buf_pool *pool,
 					      void *data, size_t size,
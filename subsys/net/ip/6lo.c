@@ -22,6 +22,8 @@ LOG_MODULE_REGISTER(net_6lo, CONFIG_NET_6LO_LOG_LEVEL);
 #include "6lo.h"
 #include "6lo_private.h"
 
+struct net_6lo_context;
+
 #if defined(CONFIG_NET_6LO_CONTEXT)
 struct net_6lo_context {
 	struct in6_addr prefix;
@@ -155,6 +157,145 @@ static inline bool net_6lo_maddr_48_bit_compressible(struct in6_addr *addr)
 		 (addr->s6_addr[10] == 0x00));
 }
 
+#if CONFIG_NET_6LO_COMPRESS_CACHE_SIZE > 0
+/* Compressed destination address, which depends on the IPv6 and the link
+ * layer destination addresses, and on the 6lowpan contexts.
+ */
+struct net_6lo_da_cache_entry {
+	struct net_if *iface;
+#if defined(CONFIG_NET_6LO_CONTEXT)
+	struct net_6lo_context *ctx;
+#endif
+	struct in6_addr addr;
+	uint8_t lladdr[8];
+	uint8_t lladdr_len;
+	/* IPHC bits set by the address compression */
+	uint16_t iphc;
+	uint8_t inline_len;
+	uint8_t inline_data[sizeof(struct in6_addr)];
+};
+
+static struct net_6lo_da_cache_entry da_cache[CONFIG_NET_6LO_COMPRESS_CACHE_SIZE];
+static uint8_t da_cache_next;
+static struct k_spinlock da_cache_lock;
+
+static inline void da_cache_flush(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&da_cache_lock);
+
+	for (int i = 0; i < ARRAY_SIZE(da_cache); i++) {
+		da_cache[i].iface = NULL;
+	}
+
+	k_spin_unlock(&da_cache_lock, key);
+}
+
+static struct net_6lo_da_cache_entry *da_cache_find(struct net_pkt *pkt,
+						    struct net_ipv6_hdr *ipv6)
+{
+	struct net_linkaddr *lladdr = net_pkt_lladdr_dst(pkt);
+
+	for (int i = 0; i < ARRAY_SIZE(da_cache); i++) {
+		struct net_6lo_da_cache_entry *entry = &da_cache[i];
+
+		if (entry->iface == net_pkt_iface(pkt) &&
+		    entry->lladdr_len == lladdr->len &&
+		    net_ipv6_addr_cmp_raw(entry->addr.s6_addr, ipv6->dst) &&
+		    (!lladdr->len ||
+		     !memcmp(entry->lladdr, lladdr->addr, lladdr->len))) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+/* Write the compressed destination address of the packet if it is cached */
+static bool da_cache_lookup(struct net_pkt *pkt, struct net_ipv6_hdr *ipv6,
+			    uint8_t **inline_pos, uint16_t *iphc,
+			    struct net_6lo_context **dst_ctx)
+{
+	struct net_6lo_da_cache_entry *entry;
+	k_spinlock_key_t key;
+
+	if (!net_pkt_iface(pkt)) {
+		return false;
+	}
+
+	key = k_spin_lock(&da_cache_lock);
+
+	entry = da_cache_find(pkt, ipv6);
+	if (entry) {
+		*inline_pos -= entry->inline_len;
+		memmove(*inline_pos, entry->inline_data, entry->inline_len);
+		*iphc |= entry->iphc;
+#if defined(CONFIG_NET_6LO_CONTEXT)
+		*dst_ctx = entry->ctx;
+#else
+		ARG_UNUSED(dst_ctx);
+#endif
+	}
+
+	k_spin_unlock(&da_cache_lock, key);
+
+	return entry != NULL;
+}
+
+static void da_cache_add(struct net_pkt *pkt, struct net_ipv6_hdr *ipv6,
+			 const uint8_t *inline_pos, uint8_t inline_len,
+			 uint16_t iphc, struct net_6lo_context *dst_ctx)
+{
+	struct net_linkaddr *lladdr = net_pkt_lladdr_dst(pkt);
+	struct net_6lo_da_cache_entry *entry;
+	k_spinlock_key_t key;
+
+	if (!net_pkt_iface(pkt) || lladdr->len > sizeof(entry->lladdr) ||
+	    inline_len > sizeof(entry->inline_data)) {
+		return;
+	}
+
+	key = k_spin_lock(&da_cache_lock);
+
+	entry = &da_cache[da_cache_next];
+	da_cache_next = (da_cache_next + 1) % ARRAY_SIZE(da_cache);
+
+	entry->iface = net_pkt_iface(pkt);
+#if defined(CONFIG_NET_6LO_CONTEXT)
+	entry->ctx = dst_ctx;
+#else
+	ARG_UNUSED(dst_ctx);
+#endif
+	net_ipv6_addr_copy_raw(entry->addr.s6_addr, ipv6->dst);
+	entry->lladdr_len = lladdr->len;
+	if (lladdr->len) {
+		memcpy(entry->lladdr, lladdr->addr, lladdr->len);
+	}
+
+	entry->iphc = iphc;
+	entry->inline_len = inline_len;
+	memcpy(entry->inline_data, inline_pos, inline_len);
+
+	k_spin_unlock(&da_cache_lock, key);
+}
+#else
+static inline void da_cache_flush(void) { }
+
+static inline bool da_cache_lookup(struct net_pkt *pkt,
+				   struct net_ipv6_hdr *ipv6,
+				   uint8_t **inline_pos, uint16_t *iphc,
+				   struct net_6lo_context **dst_ctx)
+{
+	return false;
+}
+
+static inline void da_cache_add(struct net_pkt *pkt,
+				struct net_ipv6_hdr *ipv6,
+				const uint8_t *inline_pos, uint8_t inline_len,
+				uint16_t iphc, struct net_6lo_context *dst_ctx)
+{
+}
+#endif /* CONFIG_NET_6LO_COMPRESS_CACHE_SIZE > 0 */
+
 #if defined(CONFIG_NET_6LO_CONTEXT)
 /* RFC 6775, 4.2, 5.4.2, 5.4.3 and 7.2*/
 static inline void set_6lo_context(struct net_if *iface, uint8_t index,
@@ -178,6 +319,9 @@ void net_6lo_set_context(struct net_if *iface,
 	int unused = -1;
 	uint8_t i;
 
+	/* Cached destination addresses may be compressed with the context */
+	da_cache_flush();
+
 	/* If the context information already exists, update or remove
 	 * as per data.
 	 */
@@ -729,13 +873,15 @@ static inline int compress_IPHC_header(struct net_pkt *pkt)
 {
 #if defined(CONFIG_NET_6LO_CONTEXT)
 	struct net_6lo_context *src_ctx = NULL;
-	struct net_6lo_context *dst_ctx = NULL;
 #endif
+	struct net_6lo_context *dst_ctx = NULL;
 	uint8_t compressed = 0;
 	uint16_t iphc = (NET_6LO_DISPATCH_IPHC << 8);
+	uint16_t da_iphc;
 	struct net_ipv6_hdr *ipv6 = NET_IPV6_HDR(pkt);
 	struct net_udp_hdr *udp;
 	uint8_t *inline_pos;
+	uint8_t *da_pos;
 
 	if (pkt->frags->len < NET_IPV6H_LEN) {
 		NET_ERR("Invalid length %d, min %d",
@@ -759,6 +905,13 @@ static inline int compress_IPHC_header(struct net_pkt *pkt)
 		inline_pos = compress_nh_udp(udp, inline_pos, false);
 	}
 
+	da_pos = inline_pos;
+	da_iphc = iphc;
+
+	if (da_cache_lookup(pkt, ipv6, &inline_pos, &iphc, &dst_ctx)) {
+		goto da_cached;
+	}
+
 	if (net_6lo_ll_prefix_padded_with_zeros((struct in6_addr *)ipv6->dst)) {
 		inline_pos = compress_da(ipv6, pkt, inline_pos, &iphc);
 		goto da_end;
@@ -780,6 +933,9 @@ static inline int compress_IPHC_header(struct net_pkt *pkt)
 #endif
 	inline_pos = set_da_inline(ipv6, inline_pos, &iphc);
 da_end:
+	da_cache_add(pkt, ipv6, inline_pos, da_pos - inline_pos,
+		     iphc & ~da_iphc, dst_ctx);
+da_cached:
 
 	if (net_6lo_ll_prefix_padded_with_zeros((struct in6_addr *)ipv6->src)) {
 		inline_pos = compress_sa(ipv6, pkt, inline_pos, &iphc);
@@ -1387,7 +1543,15 @@ static bool uncompress_IPHC_header(struct net_pkt *pkt)
 		return false;
 	}
 
-	if (net_buf_tailroom(pkt->buffer) >= diff) {
+	if (net_buf_headroom(pkt->buffer) >= diff) {
+		NET_DBG("Enough headroom. Uncompress inplace");
+		/* The compressed header is kept where it is, the headers
+		 * are uncompressed in front of it.
+		 */
+		frag = pkt->buffer;
+		cursor = frag->data;
+		net_buf_push(frag, diff);
+	} else if (net_buf_tailroom(pkt->buffer) >= diff) {
 		NET_DBG("Enough tailroom. Uncompress inplace");
 		frag = pkt->buffer;
 		net_buf_add(frag, diff);
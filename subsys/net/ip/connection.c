@@ -64,6 +64,32 @@ static struct net_conn conns[CONFIG_NET_MAX_CONN];
 static sys_slist_t conn_unused;
 static sys_slist_t conn_used;
 
+#if defined(CONFIG_NET_CONN_HASH_BITS)
+#define CONN_HASH_BITS CONFIG_NET_CONN_HASH_BITS
+#else
+#define CONN_HASH_BITS 0
+#endif
+
+#define CONN_HASH_SIZE BIT(CONN_HASH_BITS)
+
+/* Connection handlers with a local port are hashed by protocol and ports,
+ * the other ones are wildcards, all lists being in registration order,
+ * newest first, like conn_used.
+ */
+static sys_slist_t conn_hash[CONN_HASH_SIZE];
+static sys_slist_t conn_wildcard;
+static uint32_t conn_seq;
+
+/* Iterates over conn_used or, for UDP and TCP packets, over the merged
+ * lists of the handlers that can possibly match the packet ports, keeping
+ * the order of conn_used for the ranking rules to give the same results.
+ */
+struct conn_iter {
+	sys_snode_t *next[3];
+	uint8_t count;
+	bool hashed;
+};
+
 #if (CONFIG_NET_CONN_LOG_LEVEL >= LOG_LEVEL_DBG)
 static inline
 void conn_register_debug(struct net_conn *conn,
@@ -128,11 +154,109 @@ static struct net_conn *conn_get_unused(void)
 	return CONTAINER_OF(node, struct net_conn, node);
 }
 
+static inline uint32_t conn_hash_idx(uint16_t proto, uint16_t local_port,
+				     uint16_t remote_port)
+{
+#if CONN_HASH_BITS > 0
+	uint32_t key = ((uint32_t)local_port << 16 | remote_port) ^ proto;
+
+	/* Knuth multiplicative hashing */
+	key *= 2654435761U;
+
+	return key >> (32 - CONN_HASH_BITS);
+#else
+	ARG_UNUSED(proto);
+	ARG_UNUSED(local_port);
+	ARG_UNUSED(remote_port);
+
+	return 0;
+#endif
+}
+
+static sys_slist_t *conn_hash_list(struct net_conn *conn)
+{
+	/* Ports are in network byte order, as in packet headers */
+	uint16_t local_port = net_sin(&conn->local_addr)->sin_port;
+	uint16_t remote_port = net_sin(&conn->remote_addr)->sin_port;
+
+	if (!(conn->family == AF_INET || conn->family == AF_INET6 ||
+	      conn->family == AF_UNSPEC) || local_port == 0U) {
+		return &conn_wildcard;
+	}
+
+	return &conn_hash[conn_hash_idx(conn->proto, local_port, remote_port)];
+}
+
 static void conn_set_used(struct net_conn *conn)
 {
 	conn->flags |= NET_CONN_IN_USE;
+	conn->seq = conn_seq++;
 
 	sys_slist_prepend(&conn_used, &conn->node);
+	sys_slist_prepend(conn_hash_list(conn), &conn->hash_node);
+}
+
+static void conn_iter_init(struct conn_iter *it, uint8_t family,
+			   uint8_t proto, uint16_t src_port,
+			   uint16_t dst_port)
+{
+	uint32_t idx_local, idx_remote;
+
+	if (!((family == AF_INET || family == AF_INET6) &&
+	      (proto == IPPROTO_UDP || proto == IPPROTO_TCP))) {
+		it->next[0] = sys_slist_peek_head(&conn_used);
+		it->count = 1U;
+		it->hashed = false;
+		return;
+	}
+
+	idx_local = conn_hash_idx(proto, dst_port, 0U);
+	idx_remote = conn_hash_idx(proto, dst_port, src_port);
+
+	it->next[0] = sys_slist_peek_head(&conn_wildcard);
+	it->next[1] = sys_slist_peek_head(&conn_hash[idx_local]);
+	it->count = 2U;
+	if (idx_remote != idx_local) {
+		it->next[it->count++] = sys_slist_peek_head(&conn_hash[idx_remote]);
+	}
+
+	it->hashed = true;
+}
+
+static struct net_conn *conn_iter_next(struct conn_iter *it)
+{
+	struct net_conn *best = NULL;
+	struct net_conn *conn;
+	int best_i = 0;
+
+	if (!it->hashed) {
+		if (it->next[0] == NULL) {
+			return NULL;
+		}
+
+		conn = CONTAINER_OF(it->next[0], struct net_conn, node);
+		it->next[0] = sys_slist_peek_next(it->next[0]);
+
+		return conn;
+	}
+
+	for (int i = 0; i < it->count; i++) {
+		if (it->next[i] == NULL) {
+			continue;
+		}
+
+		conn = CONTAINER_OF(it->next[i], struct net_conn, hash_node);
+		if (best == NULL || (int32_t)(conn->seq - best->seq) > 0) {
+			best = conn;
+			best_i = i;
+		}
+	}
+
+	if (best != NULL) {
+		it->next[best_i] = sys_slist_peek_next(it->next[best_i]);
+	}
+
+	return best;
 }
 
 static void conn_set_unused(struct net_conn *conn)
@@ -381,6 +505,7 @@ int net_conn_unregister(struct net_conn_handle *handle)
 	NET_DBG("Connection handler %p removed", conn);
 
 	sys_slist_find_and_remove(&conn_used, &conn->node);
+	sys_slist_find_and_remove(conn_hash_list(conn), &conn->hash_node);
 
 	conn_set_unused(conn);
 
@@ -600,6 +725,7 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 	bool raw_pkt_delivered = false;
 	bool raw_pkt_continue = false;
 	struct net_conn *conn;
+	struct conn_iter it;
 
 	if (IS_ENABLED(CONFIG_NET_IP)) {
 		/* If we receive a packet with multicast destination address, we might
@@ -617,7 +743,9 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		}
 	}
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
+	conn_iter_init(&it, pkt_family, proto, src_port, dst_port);
+
+	while ((conn = conn_iter_next(&it)) != NULL) {
 		/* Is the candidate connection matching the packet's interface? */
 		if (conn->context != NULL &&
 		    net_context_is_bound_to_iface(conn->context) &&
@@ -836,6 +964,11 @@ void net_conn_init(void)
 
 	sys_slist_init(&conn_unused);
 	sys_slist_init(&conn_used);
+	sys_slist_init(&conn_wildcard);
+
+	for (i = 0; i < CONN_HASH_SIZE; i++) {
+		sys_slist_init(&conn_hash[i]);
+	}
 
 	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
 		sys_slist_prepend(&conn_unused, &conns[i].node);
@@ -54,6 +54,9 @@ struct net_conn {
 	/** Internal slist node */
 	sys_snode_t node;
 
+	/** Internal slist node of the lookup hash table */
+	sys_snode_t hash_node;
+
 	/** Remote socket address */
 	struct sockaddr remote_addr;
 
@@ -79,6 +82,9 @@ struct net_conn {
 
 	/** Flags for the connection */
 	uint8_t flags;
+
+	/** Registration order, newer connections are matched first */
+	uint32_t seq;
 };
 
 /**
@@ -304,6 +304,19 @@ enum net_verdict net_ipv4_input(struct net_pkt *pkt)
 		goto drop;
 	}
 
+	if (IS_ENABLED(CONFIG_NET_IF_MCAST_SOURCE_FILTER) &&
+	    net_ipv4_is_addr_mcast((struct in_addr *)hdr->dst)) {
+		struct net_if *iface = net_pkt_iface(pkt);
+		struct net_if_mcast_addr *maddr;
+
+		maddr = net_if_ipv4_maddr_lookup((struct in_addr *)hdr->dst,
+						 &iface);
+		if (maddr && !net_if_mcast_source_is_allowed(maddr, hdr->src)) {
+			NET_DBG("DROP: multicast source filtered");
+			goto drop;
+		}
+	}
+
 	net_pkt_acknowledge_data(pkt, &ipv4_access);
 
 	if (opts_len) {
@@ -318,6 +331,17 @@ enum net_verdict net_ipv4_input(struct net_pkt *pkt)
 
 	net_pkt_set_family(pkt, PF_INET);
 
+	if ((((uint16_t)hdr->offset[0] << 8) | hdr->offset[1]) &
+	    (NET_IPV4_FRAGH_MF | NET_IPV4_FRAGH_OFFSET_MASK)) {
+		/* Without reassembly support fragments are dropped */
+		verdict = net_ipv4_handle_fragment(pkt, hdr);
+		if (verdict == NET_DROP) {
+			goto drop;
+		}
+
+		return verdict;
+	}
+
 	NET_DBG("IPv4 packet received from %s to %s",
 		net_sprint_ipv4_addr(&hdr->src),
 		net_sprint_ipv4_addr(&hdr->dst));
@@ -40,6 +40,10 @@
 #define NET_IPV4_MF BIT(0) /* More fragments  */
 #define NET_IPV4_DF BIT(1) /* Do not fragment */
 
+/* Fragment offset field, the flags being in its upper bits */
+#define NET_IPV4_FRAGH_MF          0x2000
+#define NET_IPV4_FRAGH_OFFSET_MASK 0x1fff
+
 #define NET_IPV4_IGMP_QUERY     0x11 /* Membership query     */
 #define NET_IPV4_IGMP_REPORT_V1 0x12 /* v1 Membership report */
 #define NET_IPV4_IGMP_REPORT_V2 0x16 /* v2 Membership report */
@@ -204,4 +208,29 @@ static inline int net_ipv4_parse_hdr_options(struct net_pkt *pkt,
 }
 #endif
 
+/**
+ * @brief Handle a received IPv4 fragment.
+ *
+ * The payload is added to the reassembly of its datagram, which is passed
+ * to the IP stack again once complete.
+ *
+ * @param pkt Network packet, the cursor being at the start of the payload.
+ * @param hdr IPv4 header of the fragment.
+ *
+ * @return NET_OK if the fragment was consumed, NET_DROP otherwise.
+ */
+#if defined(CONFIG_NET_IPV4_FRAGMENT)
+enum net_verdict net_ipv4_handle_fragment(struct net_pkt *pkt,
+					  struct net_ipv4_hdr *hdr);
+#else
+static inline enum net_verdict net_ipv4_handle_fragment(struct net_pkt *pkt,
+							struct net_ipv4_hdr *hdr)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(hdr);
+
+	return NET_DROP;
+}
+#endif
+
 #endif /* __IPV4_H */
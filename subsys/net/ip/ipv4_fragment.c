@@ -0,0 +1,126 @@
+/** @file
+ * @brief IPv4 Fragment related functions
+ */
+
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_ipv4, CONFIG_NET_IPV4_LOG_LEVEL);
+
+#include <errno.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/net_stats.h>
+#include "net_private.h"
+#include "icmpv4.h"
+#include "ipv4.h"
+#include "reassembly.h"
+
+#define IPV4_REASSEMBLY_TIMEOUT K_SECONDS(CONFIG_NET_IPV4_FRAGMENT_TIMEOUT)
+
+/* Room for the IPv4 header and its options */
+#define IPV4_REASSEMBLY_HDR_MAX (sizeof(struct net_ipv4_hdr) + \
+				 NET_IPV4_HDR_OPTNS_MAX_LEN)
+
+static int reassembly_save_hdr(struct net_reass *reass, struct net_pkt *pkt,
+			       uint8_t *hdr)
+{
+	uint16_t hdr_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ipv4_opts_len(pkt);
+
+	if (net_pkt_read(pkt, hdr, hdr_len)) {
+		return -ENOBUFS;
+	}
+
+	return hdr_len;
+}
+
+static void reassembly_finish_hdr(struct net_reass *reass, uint8_t *hdr)
+{
+	struct net_ipv4_hdr *ipv4_hdr = (struct net_ipv4_hdr *)hdr;
+	uint32_t sum = 0U;
+	uint16_t i;
+
+	ipv4_hdr->len = htons(reass->hdr_len + reass->len);
+	ipv4_hdr->offset[0] &= ~((NET_IPV4_FRAGH_MF |
+				  NET_IPV4_FRAGH_OFFSET_MASK) >> 8);
+	ipv4_hdr->offset[1] = 0U;
+	ipv4_hdr->chksum = 0U;
+
+	for (i = 0U; i < reass->hdr_len; i += 2U) {
+		sum += ((uint16_t)hdr[i] << 8) | hdr[i + 1];
+	}
+
+	while (sum >> 16) {
+		sum = (sum & 0xffff) + (sum >> 16);
+	}
+
+	ipv4_hdr->chksum = htons(~sum & 0xffff);
+}
+
+static void reassembly_expired(struct net_reass *reass)
+{
+	struct net_pkt *pkt;
+
+	NET_DBG("Reassembly cancelled id 0x%x src %s dst %s", reass->id,
+		net_sprint_ipv4_addr(&reass->src.in_addr),
+		net_sprint_ipv4_addr(&reass->dst.in_addr));
+
+	/* Fragment reassembly time exceeded, only if the first fragment
+	 * was received (RFC 792).
+	 */
+	if (!reass->range_count || reass->ranges[0].start != 0U) {
+		return;
+	}
+
+	pkt = net_reass_pkt(reass, reass->ranges[0].end);
+	if (pkt) {
+		net_icmpv4_send_error(pkt, NET_ICMPV4_TIME_EXCEEDED,
+				      NET_ICMPV4_TIME_EXCEEDED_FRAGMENT);
+		net_pkt_unref(pkt);
+	}
+}
+
+NET_REASS_TABLE_DEFINE(reassembly, CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT,
+		       CONFIG_NET_IPV4_FRAGMENT_MAX_PKT,
+		       IPV4_REASSEMBLY_HDR_MAX,
+		       CONFIG_NET_IP_REASSEMBLY_MAX_SIZE,
+		       IPV4_REASSEMBLY_TIMEOUT, false, reassembly_save_hdr,
+		       reassembly_finish_hdr, reassembly_expired);
+
+enum net_verdict net_ipv4_handle_fragment(struct net_pkt *pkt,
+					  struct net_ipv4_hdr *hdr)
+{
+	uint16_t field = ((uint16_t)hdr->offset[0] << 8) | hdr->offset[1];
+	uint16_t id = ((uint16_t)hdr->id[0] << 8) | hdr->id[1];
+	bool more = (field & NET_IPV4_FRAGH_MF) != 0U;
+	struct net_addr src, dst;
+	int ret;
+
+	if (more && net_pkt_remaining_data(pkt) % 8) {
+		NET_DBG("DROP: fragment length not multiple of 8");
+		return NET_DROP;
+	}
+
+	src.family = AF_INET;
+	net_ipv4_addr_copy_raw((uint8_t *)&src.in_addr, hdr->src);
+	dst.family = AF_INET;
+	net_ipv4_addr_copy_raw((uint8_t *)&dst.in_addr, hdr->dst);
+
+	/* Fragments are told apart by the protocol too (RFC 791) */
+	ret = net_reass_input(&reassembly, &src, &dst,
+			      ((uint32_t)hdr->proto << 16) | id,
+			      pkt, (field & NET_IPV4_FRAGH_OFFSET_MASK) * 8U, more);
+	if (ret < 0) {
+		NET_DBG("Reassembly of id 0x%x failed (%d), dropping pkt %p",
+			id, ret, pkt);
+		return NET_DROP;
+	}
+
+	net_pkt_unref(pkt);
+
+	return NET_OK;
+}
@@ -50,6 +50,22 @@ BUILD_ASSERT(sizeof(struct in6_addr) == NET_IPV6_ADDR_SIZE);
  */
 #define MAX_REACHABLE_TIME 3600000
 
+/* Generation of the resolved paths, see net_ipv6_path_changed() */
+static atomic_t path_gen = ATOMIC_INIT(1);
+
+void net_ipv6_path_changed(void)
+{
+	/* Skip 0 when wrapping around, it marks empty cache entries */
+	if (atomic_inc(&path_gen) == -1) {
+		atomic_inc(&path_gen);
+	}
+}
+
+atomic_val_t net_ipv6_path_gen(void)
+{
+	return atomic_get(&path_gen);
+}
+
 int net_ipv6_create(struct net_pkt *pkt,
 		    const struct in6_addr *src,
 		    const struct in6_addr *dst)
@@ -290,6 +306,25 @@ static enum net_verdict ipv6_route_packet(struct net_pkt *pkt,
 	struct in6_addr *nexthop;
 	bool found;
 
+	/* Packets of a flow already forwarded go the same way. Packets
+	 * from link local addresses must not be routed, RFC 4291 ch 2.5.6,
+	 * leave them to the checks below.
+	 */
+	if (IS_ENABLED(CONFIG_NET_ROUTE_FLOW_CACHE) &&
+	    !(IS_ENABLED(CONFIG_NET_ROUTING) &&
+	      net_ipv6_is_ll_addr((struct in6_addr *)hdr->src))) {
+		int ret;
+
+		ret = net_route_flow_packet(pkt, (struct in6_addr *)hdr->dst);
+		if (ret == 0) {
+			return NET_OK;
+		} else if (ret != -ENOENT) {
+			NET_DBG("Cannot re-route pkt %p at iface %p (%d)",
+				pkt, net_pkt_iface(pkt), ret);
+			goto drop;
+		}
+	}
+
 	/* Check if the packet can be routed */
 	if (IS_ENABLED(CONFIG_NET_ROUTING)) {
 		found = net_route_get_info(NULL, (struct in6_addr *)hdr->dst,
@@ -564,6 +599,11 @@ enum net_verdict net_ipv6_input(struct net_pkt *pkt, bool is_loopback)
 			NET_DBG("DROP: packet for unjoined multicast address");
 			goto drop;
 		}
+
+		if (!net_if_mcast_source_is_allowed(if_mcast_addr, hdr->src)) {
+			NET_DBG("DROP: multicast source filtered");
+			goto drop;
+		}
 	}
 
 	net_pkt_acknowledge_data(pkt, &ipv6_access);
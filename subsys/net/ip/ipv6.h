@@ -14,6 +14,7 @@
 #define __IPV6_H
 
 #include <zephyr/types.h>
+#include <zephyr/sys/atomic.h>
 
 #include <zephyr/net/net_ip.h>
 #include <zephyr/net/net_pkt.h>
@@ -80,6 +81,11 @@ const char *net_ipv6_nbr_state2str(enum net_ipv6_nbr_state state);
  * @brief IPv6 neighbor information.
  */
 struct net_ipv6_nbr_data {
+#if defined(CONFIG_NET_IPV6_NBR_CACHE)
+	/** Link in the neighbor hash table. */
+	sys_snode_t node;
+#endif
+
 	/** Any pending packet waiting ND to finish. */
 	struct net_pkt *pending;
 
@@ -236,6 +242,41 @@ net_ipv6_mld_leave(struct net_if *iface, const struct in6_addr *addr)
 }
 #endif /* CONFIG_NET_IPV6_MLD */
 
+/**
+ * @brief Set the sources a joined multicast group is received from.
+ *
+ * The filter is set with net_if_mcast_set_sources() and the change is
+ * reported to the routers.
+ *
+ * @param iface Network interface where the report is sent
+ * @param addr Joined multicast group
+ * @param include True to receive the group only from the sources, false
+ * to receive it from all but the sources.
+ * @param sources IPv6 source addresses
+ * @param count Number of sources
+ *
+ * @return Return 0 if the filter was set, <0 otherwise.
+ */
+#if defined(CONFIG_NET_IPV6_MLD)
+int net_ipv6_mld_set_sources(struct net_if *iface, const struct in6_addr *addr,
+			     bool include, const struct net_addr *sources,
+			     size_t count);
+#else
+static inline int
+net_ipv6_mld_set_sources(struct net_if *iface, const struct in6_addr *addr,
+			 bool include, const struct net_addr *sources,
+			 size_t count)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(addr);
+	ARG_UNUSED(include);
+	ARG_UNUSED(sources);
+	ARG_UNUSED(count);
+
+	return -ENOTSUP;
+}
+#endif /* CONFIG_NET_IPV6_MLD */
+
 /**
  * @typedef net_nbr_cb_t
  * @brief Callback used while iterating over neighbors.
@@ -398,31 +439,38 @@ static inline void net_ipv6_nbr_set_reachable_timer(struct net_if *iface,
 }
 #endif
 
-#if defined(CONFIG_NET_IPV6_FRAGMENT)
-/** Store pending IPv6 fragment information that is needed for reassembly. */
-struct net_ipv6_reassembly {
-	/** IPv6 source address of the fragment */
-	struct in6_addr src;
-
-	/** IPv6 destination address of the fragment */
-	struct in6_addr dst;
-
-	/**
-	 * Timeout for cancelling the reassembly. The timer is used
-	 * also to detect if this reassembly slot is used or not.
-	 */
-	struct k_work_delayable timer;
-
-	/** Pointers to pending fragments */
-	struct net_pkt *pkt[CONFIG_NET_IPV6_FRAGMENT_MAX_PKT];
+/**
+ * @brief Tell that the resolved IPv6 paths may have changed.
+ *
+ * Has to be called when a route, a router, a neighbor or an address
+ * changes. The caches of resolved paths remember the generation they were
+ * filled at and are not used anymore once it changes.
+ */
+#if defined(CONFIG_NET_NATIVE_IPV6)
+void net_ipv6_path_changed(void);
+#else
+static inline void net_ipv6_path_changed(void)
+{
+}
+#endif
 
-	/** IPv6 fragment identification */
-	uint32_t id;
-};
+/**
+ * @brief Get the current generation of the resolved IPv6 paths.
+ *
+ * @return Generation, never 0 so that 0 can mark an empty cache entry.
+ */
+#if defined(CONFIG_NET_NATIVE_IPV6)
+atomic_val_t net_ipv6_path_gen(void);
 #else
-struct net_ipv6_reassembly;
+static inline atomic_val_t net_ipv6_path_gen(void)
+{
+	return 0;
+}
 #endif
 
+/* Pending IPv6 reassemblies, see reassembly.h */
+struct net_reass;
+
 /**
  * @typedef net_ipv6_frag_cb_t
  * @brief Callback used while iterating over pending IPv6 fragments.
@@ -430,7 +478,7 @@ struct net_ipv6_reassembly;
  * @param reass IPv6 fragment reassembly struct
  * @param user_data A valid pointer on some user data or NULL
  */
-typedef void (*net_ipv6_frag_cb_t)(struct net_ipv6_reassembly *reass,
+typedef void (*net_ipv6_frag_cb_t)(struct net_reass *reass,
 				   void *user_data);
 
 /**
@@ -27,6 +27,7 @@ LOG_MODULE_DECLARE(net_ipv6, CONFIG_NET_IPV6_LOG_LEVEL);
 #include "nbr.h"
 #include "6lo.h"
 #include "route.h"
+#include "reassembly.h"
 #include "net_stats.h"
 
 /* Timeout for various buffer allocations in this file. */
@@ -40,11 +41,10 @@ LOG_MODULE_DECLARE(net_ipv6, CONFIG_NET_IPV6_LOG_LEVEL);
 
 #define FRAG_BUF_WAIT K_MSEC(10) /* how long to max wait for a buffer */
 
-static void reassembly_timeout(struct k_work *work);
-static bool reassembly_init_done;
-
-static struct net_ipv6_reassembly
-reassembly[CONFIG_NET_IPV6_FRAGMENT_MAX_COUNT];
+/* Room for the IPv6 header and the extension headers preceding the
+ * fragment header.
+ */
+#define IPV6_REASSEMBLY_HDR_MAX CONFIG_NET_IPV6_FRAGMENT_HDR_MAX
 
 int net_ipv6_find_last_ext_hdr(struct net_pkt *pkt, uint16_t *next_hdr_off,
 			       uint16_t *last_hdr_off)
@@ -120,364 +120,85 @@ fail:
 	return -EINVAL;
 }
 
-static struct net_ipv6_reassembly *reassembly_get(uint32_t id,
-						  struct in6_addr *src,
-						  struct in6_addr *dst)
+/* Copy the unfragmentable part of the first fragment, the fragment header
+ * being left out.
+ */
+static int reassembly_save_hdr(struct net_reass *reass, struct net_pkt *pkt,
+			       uint8_t *hdr)
 {
-	int i, avail = -1;
-
-	for (i = 0; i < CONFIG_NET_IPV6_FRAGMENT_MAX_COUNT; i++) {
-		if (k_work_delayable_remaining_get(&reassembly[i].timer) &&
-		    reassembly[i].id == id &&
-		    net_ipv6_addr_cmp(src, &reassembly[i].src) &&
-		    net_ipv6_addr_cmp(dst, &reassembly[i].dst)) {
-			return &reassembly[i];
-		}
-
-		if (k_work_delayable_remaining_get(&reassembly[i].timer)) {
-			continue;
-		}
-
-		if (avail < 0) {
-			avail = i;
-		}
-	}
+	uint16_t frag_start = net_pkt_ipv6_fragment_start(pkt);
+	uint16_t prev = net_pkt_ipv6_hdr_prev(pkt);
+	uint8_t next_hdr;
 
-	if (avail < 0) {
-		return NULL;
+	if (frag_start > IPV6_REASSEMBLY_HDR_MAX || prev >= frag_start) {
+		NET_DBG("Unfragmentable part too long (%u bytes)", frag_start);
+		return -EMSGSIZE;
 	}
 
-	k_work_reschedule(&reassembly[avail].timer, IPV6_REASSEMBLY_TIMEOUT);
-
-	net_ipaddr_copy(&reassembly[avail].src, src);
-	net_ipaddr_copy(&reassembly[avail].dst, dst);
-
-	reassembly[avail].id = id;
-
-	return &reassembly[avail];
-}
-
-static bool reassembly_cancel(uint32_t id,
-			      struct in6_addr *src,
-			      struct in6_addr *dst)
-{
-	int i, j;
-
-	NET_DBG("Cancel 0x%x", id);
-
-	for (i = 0; i < CONFIG_NET_IPV6_FRAGMENT_MAX_COUNT; i++) {
-		int32_t remaining;
-
-		if (reassembly[i].id != id ||
-		    !net_ipv6_addr_cmp(src, &reassembly[i].src) ||
-		    !net_ipv6_addr_cmp(dst, &reassembly[i].dst)) {
-			continue;
-		}
-
-		remaining = k_ticks_to_ms_ceil32(
-			k_work_delayable_remaining_get(&reassembly[i].timer));
-		k_work_cancel_delayable(&reassembly[i].timer);
-
-		NET_DBG("IPv6 reassembly id 0x%x remaining %d ms",
-			reassembly[i].id, remaining);
-
-		reassembly[i].id = 0U;
-
-		for (j = 0; j < CONFIG_NET_IPV6_FRAGMENT_MAX_PKT; j++) {
-			if (!reassembly[i].pkt[j]) {
-				continue;
-			}
-
-			NET_DBG("[%d] IPv6 reassembly pkt %p %zd bytes data",
-				j, reassembly[i].pkt[j],
-				net_pkt_get_len(reassembly[i].pkt[j]));
-
-			net_pkt_unref(reassembly[i].pkt[j]);
-			reassembly[i].pkt[j] = NULL;
-		}
-
-		return true;
+	if (net_pkt_read(pkt, hdr, frag_start) ||
+	    net_pkt_read_u8(pkt, &next_hdr)) {
+		return -ENOBUFS;
 	}
 
-	return false;
-}
+	/* The header before the fragment header now points to the one
+	 * following it.
+	 */
+	hdr[prev] = next_hdr;
 
-static void reassembly_info(char *str, struct net_ipv6_reassembly *reass)
-{
-	NET_DBG("%s id 0x%x src %s dst %s remain %d ms", str, reass->id,
-		net_sprint_ipv6_addr(&reass->src),
-		net_sprint_ipv6_addr(&reass->dst),
-		k_ticks_to_ms_ceil32(
-			k_work_delayable_remaining_get(&reass->timer)));
+	return frag_start;
 }
 
-static void reassembly_timeout(struct k_work *work)
+static void reassembly_finish_hdr(struct net_reass *reass, uint8_t *hdr)
 {
-	struct net_ipv6_reassembly *reass =
-		CONTAINER_OF(work, struct net_ipv6_reassembly, timer);
+	struct net_ipv6_hdr *ipv6_hdr = (struct net_ipv6_hdr *)hdr;
 
-	reassembly_info("Reassembly cancelled", reass);
-
-	/* Send a ICMPv6 Time Exceeded only if we received the first fragment (RFC 2460 Sec. 5) */
-	if (reass->pkt[0] && net_pkt_ipv6_fragment_offset(reass->pkt[0]) == 0) {
-		net_icmpv6_send_error(reass->pkt[0], NET_ICMPV6_TIME_EXCEEDED, 1, 0);
-	}
-
-	reassembly_cancel(reass->id, &reass->src, &reass->dst);
+	/* Fix the total length of the IPv6 packet. */
+	ipv6_hdr->len = htons(reass->hdr_len - sizeof(struct net_ipv6_hdr) +
+			      reass->len);
 }
 
-static void reassemble_packet(struct net_ipv6_reassembly *reass)
+static void reassembly_expired(struct net_reass *reass)
 {
-	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv6_access, struct net_ipv6_hdr);
-	NET_PKT_DATA_ACCESS_DEFINE(frag_access, struct net_ipv6_frag_hdr);
-	union {
-		struct net_ipv6_hdr *hdr;
-		struct net_ipv6_frag_hdr *frag_hdr;
-	} ipv6;
-
 	struct net_pkt *pkt;
-	struct net_buf *last;
-	uint8_t next_hdr;
-	int i, len;
-
-	k_work_cancel_delayable(&reass->timer);
 
-	NET_ASSERT(reass->pkt[0]);
+	NET_DBG("Reassembly cancelled id 0x%x src %s dst %s", reass->id,
+		net_sprint_ipv6_addr(&reass->src.in6_addr),
+		net_sprint_ipv6_addr(&reass->dst.in6_addr));
 
-	last = net_buf_frag_last(reass->pkt[0]->buffer);
-
-	/* We start from 2nd packet which is then appended to
-	 * the first one.
+	/* Send a ICMPv6 Time Exceeded only if we received the first fragment
+	 * (RFC 2460 Sec. 5), quoting what we have from its start.
 	 */
-	for (i = 1; i < CONFIG_NET_IPV6_FRAGMENT_MAX_PKT; i++) {
-		int removed_len;
-
-		pkt = reass->pkt[i];
-		if (!pkt) {
-			break;
-		}
-
-		net_pkt_cursor_init(pkt);
-
-		/* Get rid of IPv6 and fragment header which are at
-		 * the beginning of the fragment.
-		 */
-		removed_len = net_pkt_ipv6_fragment_start(pkt) +
-			      sizeof(struct net_ipv6_frag_hdr);
-
-		NET_DBG("Removing %d bytes from start of pkt %p",
-			removed_len, pkt->buffer);
-
-		if (net_pkt_pull(pkt, removed_len)) {
-			NET_ERR("Failed to pull headers");
-			reassembly_cancel(reass->id, &reass->src, &reass->dst);
-			return;
-		}
-
-		/* Attach the data to previous pkt */
-		last->frags = pkt->buffer;
-		last = net_buf_frag_last(pkt->buffer);
-
-		pkt->buffer = NULL;
-		reass->pkt[i] = NULL;
-
-		net_pkt_unref(pkt);
-	}
-
-	pkt = reass->pkt[0];
-	reass->pkt[0] = NULL;
-
-	/* Next we need to strip away the fragment header from the first packet
-	 * and set the various pointers and values in packet.
-	 */
-	net_pkt_cursor_init(pkt);
-
-	if (net_pkt_skip(pkt, net_pkt_ipv6_fragment_start(pkt))) {
-		NET_ERR("Failed to move to fragment header");
-		goto error;
-	}
-
-	ipv6.frag_hdr = (struct net_ipv6_frag_hdr *)net_pkt_get_data(
-							pkt, &frag_access);
-	if (!ipv6.frag_hdr) {
-		NET_ERR("Failed to get fragment header");
-		goto error;
-	}
-
-	next_hdr = ipv6.frag_hdr->nexthdr;
-
-	if (net_pkt_pull(pkt, sizeof(struct net_ipv6_frag_hdr))) {
-		NET_ERR("Failed to remove fragment header");
-		goto error;
-	}
-
-	/* This one updates the previous header's nexthdr value */
-	if (net_pkt_skip(pkt, net_pkt_ipv6_hdr_prev(pkt)) ||
-	    net_pkt_write_u8(pkt, next_hdr)) {
-		goto error;
-	}
-
-	net_pkt_cursor_init(pkt);
-
-	ipv6.hdr = (struct net_ipv6_hdr *)net_pkt_get_data(pkt, &ipv6_access);
-	if (!ipv6.hdr) {
-		goto error;
-	}
-
-	/* Fix the total length of the IPv6 packet. */
-	len = net_pkt_ipv6_ext_len(pkt);
-	if (len > 0) {
-		NET_DBG("Old pkt %p IPv6 ext len is %d bytes", pkt, len);
-		net_pkt_set_ipv6_ext_len(pkt,
-				len - sizeof(struct net_ipv6_frag_hdr));
-	}
-
-	len = net_pkt_get_len(pkt) - sizeof(struct net_ipv6_hdr);
-
-	ipv6.hdr->len = htons(len);
-
-	net_pkt_set_data(pkt, &ipv6_access);
-
-	NET_DBG("New pkt %p IPv6 len is %d bytes", pkt,
-		len + NET_IPV6H_LEN);
-
-	/* We need to use the queue when feeding the packet back into the
-	 * IP stack as we might run out of stack if we call processing_data()
-	 * directly. As the packet does not contain link layer header, we
-	 * MUST NOT pass it to L2 so there will be a special check for that
-	 * in process_data() when handling the packet.
-	 */
-	if (net_recv_data(net_pkt_iface(pkt), pkt) >= 0) {
+	if (!reass->range_count || reass->ranges[0].start != 0U) {
 		return;
 	}
-error:
-	net_pkt_unref(pkt);
-}
 
-void net_ipv6_frag_foreach(net_ipv6_frag_cb_t cb, void *user_data)
-{
-	int i;
-
-	for (i = 0; reassembly_init_done &&
-		     i < CONFIG_NET_IPV6_FRAGMENT_MAX_COUNT; i++) {
-		if (!k_work_delayable_remaining_get(&reassembly[i].timer)) {
-			continue;
-		}
-
-		cb(&reassembly[i], user_data);
+	pkt = net_reass_pkt(reass, reass->ranges[0].end);
+	if (pkt) {
+		net_icmpv6_send_error(pkt, NET_ICMPV6_TIME_EXCEEDED, 1, 0);
+		net_pkt_unref(pkt);
 	}
 }
 
-/* Verify that we have all the fragments received and in correct order.
- * Return:
- * - a negative value if the fragments are erroneous and must be dropped
- * - zero if we are expecting more fragments
- * - a positive value if we can proceed with the reassembly
- */
-static int fragments_are_ready(struct net_ipv6_reassembly *reass)
-{
-	unsigned int expected_offset = 0;
-	bool more = true;
-	int i;
-
-	/* Fragments can arrive in any order, for example in reverse order:
-	 *   1 -> Fragment3(M=0, offset=x2)
-	 *   2 -> Fragment2(M=1, offset=x1)
-	 *   3 -> Fragment1(M=1, offset=0)
-	 * We have to test several requirements before proceeding with the reassembly:
-	 * - We received the first fragment (Fragment Offset is 0)
-	 * - All intermediate fragments are contiguous
-	 * - The More bit of the last fragment is 0
-	 */
-	for (i = 0; i < CONFIG_NET_IPV6_FRAGMENT_MAX_PKT; i++) {
-		struct net_pkt *pkt = reass->pkt[i];
-		unsigned int offset;
-		int payload_len;
-
-		if (!pkt) {
-			break;
-		}
-
-		offset = net_pkt_ipv6_fragment_offset(pkt);
-
-		if (offset < expected_offset) {
-			/* Overlapping or duplicated
-			 * According to RFC8200 we can drop it
-			 */
-			return -EBADMSG;
-		} else if (offset != expected_offset) {
-			/* Not contiguous, let's wait for fragments */
-			return 0;
-		}
-
-		payload_len = net_pkt_get_len(pkt) - net_pkt_ipv6_fragment_start(pkt);
-		payload_len -= sizeof(struct net_ipv6_frag_hdr);
-		if (payload_len < 0) {
-			return -EBADMSG;
-		}
+NET_REASS_TABLE_DEFINE(reassembly, CONFIG_NET_IPV6_FRAGMENT_MAX_COUNT,
+		       CONFIG_NET_IPV6_FRAGMENT_MAX_PKT,
+		       IPV6_REASSEMBLY_HDR_MAX,
+		       CONFIG_NET_IP_REASSEMBLY_MAX_SIZE,
+		       IPV6_REASSEMBLY_TIMEOUT, true, reassembly_save_hdr,
+		       reassembly_finish_hdr, reassembly_expired);
 
-		expected_offset += payload_len;
-		more = net_pkt_ipv6_fragment_more(pkt);
-	}
-
-	if (more) {
-		return 0;
-	}
-
-	return 1;
-}
-
-static int shift_packets(struct net_ipv6_reassembly *reass, int pos)
+void net_ipv6_frag_foreach(net_ipv6_frag_cb_t cb, void *user_data)
 {
-	int i;
-
-	for (i = pos + 1; i < CONFIG_NET_IPV6_FRAGMENT_MAX_PKT; i++) {
-		if (!reass->pkt[i]) {
-			NET_DBG("Moving [%d] %p (offset 0x%x) to [%d]",
-				pos, reass->pkt[pos],
-				net_pkt_ipv6_fragment_offset(reass->pkt[pos]),
-				pos + 1);
-
-			/* pkt[i] is free, so shift everything between
-			 * [pos] and [i - 1] by one element
-			 */
-			memmove(&reass->pkt[pos + 1], &reass->pkt[pos],
-				sizeof(void *) * (i - pos));
-
-			/* pkt[pos] is now free */
-			reass->pkt[pos] = NULL;
-
-			return 0;
-		}
-	}
-
-	/* We do not have free space left in the array */
-	return -ENOMEM;
+	net_reass_foreach(&reassembly, cb, user_data);
 }
 
 enum net_verdict net_ipv6_handle_fragment_hdr(struct net_pkt *pkt,
 					      struct net_ipv6_hdr *hdr,
 					      uint8_t nexthdr)
 {
-	struct net_ipv6_reassembly *reass = NULL;
+	struct net_addr src, dst;
 	uint16_t flag;
-	bool found;
-	uint8_t more;
 	uint32_t id;
 	int ret;
-	int i;
-
-	if (!reassembly_init_done) {
-		/* Static initializing does not work here because of the array
-		 * so we must do it at runtime.
-		 */
-		for (i = 0; i < CONFIG_NET_IPV6_FRAGMENT_MAX_COUNT; i++) {
-			k_work_init_delayable(&reassembly[i].timer,
-					      reassembly_timeout);
-		}
-
-		reassembly_init_done = true;
-	}
 
 	/* Each fragment has a fragment header, however since we already
 	 * read the nexthdr part of it, we are not going to use
@@ -487,99 +208,41 @@ enum net_verdict net_ipv6_handle_fragment_hdr(struct net_pkt *pkt,
 	if (net_pkt_skip(pkt, 1) || /* reserved */
 	    net_pkt_read_be16(pkt, &flag) ||
 	    net_pkt_read_be32(pkt, &id)) {
-		goto drop;
-	}
-
-	reass = reassembly_get(id, (struct in6_addr *)hdr->src,
-			       (struct in6_addr *)hdr->dst);
-	if (!reass) {
-		NET_DBG("Cannot get reassembly slot, dropping pkt %p", pkt);
-		goto drop;
+		return NET_DROP;
 	}
 
-	more = flag & 0x01;
 	net_pkt_set_ipv6_fragment_flags(pkt, flag);
 
-	if (more && net_pkt_get_len(pkt) % 8) {
+	if (net_pkt_ipv6_fragment_more(pkt) && net_pkt_get_len(pkt) % 8) {
 		/* Fragment length is not multiple of 8, discard
 		 * the packet and send parameter problem error with the
 		 * offset of the "Payload Length" field in the IPv6 header.
 		 */
 		net_icmpv6_send_error(pkt, NET_ICMPV6_PARAM_PROBLEM,
 				      NET_ICMPV6_PARAM_PROB_HEADER, NET_IPV6H_LENGTH_OFFSET);
-		goto drop;
-	}
-
-	/* The fragments might come in wrong order so place them
-	 * in reassembly chain in correct order.
-	 */
-	for (i = 0, found = false; i < CONFIG_NET_IPV6_FRAGMENT_MAX_PKT; i++) {
-		if (reass->pkt[i]) {
-			if (net_pkt_ipv6_fragment_offset(reass->pkt[i]) <
-			    net_pkt_ipv6_fragment_offset(pkt)) {
-				continue;
-			}
-
-			/* Make room for this fragment. If there is no room,
-			 * then it will discard the whole reassembly.
-			 */
-			if (shift_packets(reass, i)) {
-				break;
-			}
-		}
-
-		NET_DBG("Storing pkt %p to slot %d offset %d",
-			pkt, i, net_pkt_ipv6_fragment_offset(pkt));
-		reass->pkt[i] = pkt;
-		found = true;
-
-		break;
+		return NET_DROP;
 	}
 
-	if (!found) {
-		/* We could not add this fragment into our saved fragment
-		 * list. We must discard the whole packet at this point.
-		 */
-		NET_DBG("No slots available for 0x%x", reass->id);
-		net_pkt_unref(pkt);
-		goto drop;
-	}
+	src.family = AF_INET6;
+	net_ipv6_addr_copy_raw((uint8_t *)&src.in6_addr, hdr->src);
+	dst.family = AF_INET6;
+	net_ipv6_addr_copy_raw((uint8_t *)&dst.in6_addr, hdr->dst);
 
-	ret = fragments_are_ready(reass);
+	/* The payload is copied to the reassembly buffer, so the fragment
+	 * itself is not needed anymore.
+	 */
+	ret = net_reass_input(&reassembly, &src, &dst, id, pkt,
+			      net_pkt_ipv6_fragment_offset(pkt),
+			      net_pkt_ipv6_fragment_more(pkt));
 	if (ret < 0) {
-		NET_DBG("Reassembled IPv6 verify failed, dropping id %u",
-			reass->id);
-
-		/* Let the caller release the already inserted pkt */
-		if (i < CONFIG_NET_IPV6_FRAGMENT_MAX_PKT) {
-			reass->pkt[i] = NULL;
-		}
-
-		net_pkt_unref(pkt);
-		goto drop;
-	} else if (ret == 0) {
-		reassembly_info("Reassembly nth pkt", reass);
-
-		NET_DBG("More fragments to be received");
-		goto accept;
+		NET_DBG("Reassembly of id 0x%x failed (%d), dropping pkt %p",
+			id, ret, pkt);
+		return NET_DROP;
 	}
 
-	reassembly_info("Reassembly last pkt", reass);
-
-	/* The last fragment received, reassemble the packet */
-	reassemble_packet(reass);
+	net_pkt_unref(pkt);
 
-accept:
 	return NET_OK;
-
-drop:
-	if (reass) {
-		if (reassembly_cancel(reass->id, &reass->src, &reass->dst)) {
-			return NET_OK;
-		}
-	}
-
-	return NET_DROP;
 }
 
 #define BUF_ALLOC_TIMEOUT K_MSEC(100)
@@ -61,14 +61,36 @@ static int mld_create(struct net_pkt *pkt,
 		return -ENOBUFS;
 	}
 
-	if (num_sources > 0) {
-		/* All source addresses, RFC 3810 ch 3 */
-		if (net_pkt_write(pkt,
-				  net_ipv6_unspecified_address()->s6_addr,
+	return 0;
+}
+
+static inline uint16_t mld_num_sources(struct net_if_mcast_addr *maddr)
+{
+#if defined(CONFIG_NET_IF_MCAST_SOURCE_FILTER)
+	return maddr->num_sources;
+#else
+	return 0;
+#endif
+}
+
+/* Record of a group followed by the sources of its filter */
+static int mld_create_record(struct net_pkt *pkt,
+			     struct net_if_mcast_addr *maddr,
+			     uint8_t record_type)
+{
+	if (mld_create(pkt, &maddr->address.in6_addr, record_type,
+		       mld_num_sources(maddr))) {
+		return -ENOBUFS;
+	}
+
+#if defined(CONFIG_NET_IF_MCAST_SOURCE_FILTER)
+	for (int i = 0; i < maddr->num_sources; i++) {
+		if (net_pkt_write(pkt, &maddr->sources[i].in6_addr,
 				  sizeof(struct in6_addr))) {
 			return -ENOBUFS;
 		}
 	}
+#endif
 
 	return 0;
 }
@@ -158,8 +180,11 @@ static int mld_send_generic(struct net_if *iface,
 		return -ENOMEM;
 	}
 
+	/* All source addresses, RFC 3810 ch 3 */
 	if (mld_create_packet(pkt, 1) ||
-	    mld_create(pkt, addr, mode, 1)) {
+	    mld_create(pkt, addr, mode, 1) ||
+	    net_pkt_write(pkt, net_ipv6_unspecified_address()->s6_addr,
+			  sizeof(struct in6_addr))) {
 		ret = -ENOBUFS;
 		goto drop;
 	}
@@ -238,10 +263,61 @@ int net_ipv6_mld_leave(struct net_if *iface, const struct in6_addr *addr)
 	return ret;
 }
 
+int net_ipv6_mld_set_sources(struct net_if *iface, const struct in6_addr *addr,
+			     bool include, const struct net_addr *sources,
+			     size_t count)
+{
+	struct net_if_mcast_addr *maddr;
+	struct net_pkt *pkt;
+	int ret;
+
+	maddr = net_if_ipv6_maddr_lookup(addr, &iface);
+	if (!maddr || !net_if_ipv6_maddr_is_joined(maddr)) {
+		return -ENOENT;
+	}
+
+	ret = net_if_mcast_set_sources(maddr, include, sources, count);
+	if (ret < 0) {
+		return ret;
+	}
+
+	pkt = net_pkt_alloc_with_buffer(iface, IPV6_OPT_HDR_ROUTER_ALERT_LEN +
+					NET_ICMPV6_UNUSED_LEN +
+					MLDv2_MCAST_RECORD_LEN +
+					count * sizeof(struct in6_addr),
+					AF_INET6, IPPROTO_ICMPV6,
+					PKT_WAIT_TIME);
+	if (!pkt) {
+		return -ENOMEM;
+	}
+
+	/* Filter mode change record, RFC 3810 ch 6.1 */
+	if (mld_create_packet(pkt, 1) ||
+	    mld_create_record(pkt, maddr,
+			      include ? NET_IPV6_MLDv2_CHANGE_TO_INCLUDE_MODE :
+			      NET_IPV6_MLDv2_CHANGE_TO_EXCLUDE_MODE)) {
+		ret = -ENOBUFS;
+		goto drop;
+	}
+
+	ret = mld_send(pkt);
+	if (ret) {
+		goto drop;
+	}
+
+	return 0;
+
+drop:
+	net_pkt_unref(pkt);
+
+	return ret;
+}
+
 static void send_mld_report(struct net_if *iface)
 {
 	struct net_if_ipv6 *ipv6 = iface->config.ip.ipv6;
 	struct net_pkt *pkt;
+	size_t len = 0;
 	int i, count = 0;
 
 	NET_ASSERT(ipv6);
@@ -251,12 +327,14 @@ static void send_mld_report(struct net_if *iface)
 			continue;
 		}
 
+		len += MLDv2_MCAST_RECORD_LEN +
+			mld_num_sources(&ipv6->mcast[i]) *
+			sizeof(struct in6_addr);
 		count++;
 	}
 
 	pkt = net_pkt_alloc_with_buffer(iface, IPV6_OPT_HDR_ROUTER_ALERT_LEN +
-					NET_ICMPV6_UNUSED_LEN +
-					count * MLDv2_MCAST_RECORD_LEN,
+					NET_ICMPV6_UNUSED_LEN + len,
 					AF_INET6, IPPROTO_ICMPV6,
 					PKT_WAIT_TIME);
 	if (!pkt) {
@@ -272,8 +350,10 @@ static void send_mld_report(struct net_if *iface)
 			continue;
 		}
 
-		if (!mld_create(pkt, &ipv6->mcast[i].address.in6_addr,
-				NET_IPV6_MLDv2_MODE_IS_EXCLUDE, 0)) {
+		if (mld_create_record(pkt, &ipv6->mcast[i],
+				      ipv6->mcast[i].is_include ?
+				      NET_IPV6_MLDv2_MODE_IS_INCLUDE :
+				      NET_IPV6_MLDv2_MODE_IS_EXCLUDE)) {
 			goto drop;
 		}
 	}
@@ -97,6 +97,10 @@ NET_NBR_TABLE_INIT(NET_NBR_GLOBAL,
 		   net_neighbor_pool,
 		   net_neighbor_table_clear);
 
+/* Neighbors in use, hashed by IPv6 address */
+static sys_slist_t nbr_hash[CONFIG_NET_IPV6_NBR_HASH_SIZE];
+static struct k_spinlock nbr_hash_lock;
+
 const char *net_ipv6_nbr_state2str(enum net_ipv6_nbr_state state)
 {
 	switch (state) {
@@ -149,6 +153,11 @@ static void ipv6_nbr_set_state(struct net_nbr *nbr,
 		net_ipv6_nbr_state2str(net_ipv6_nbr_data(nbr)->state),
 		net_ipv6_nbr_state2str(new_state));
 
+	/* The cached paths only use reachable neighbors */
+	if (net_ipv6_nbr_data(nbr)->state == NET_IPV6_NBR_STATE_REACHABLE) {
+		net_ipv6_path_changed();
+	}
+
 	net_ipv6_nbr_data(nbr)->state = new_state;
 
 	if (net_ipv6_nbr_data(nbr)->state == NET_IPV6_NBR_STATE_STALE) {
@@ -254,29 +263,70 @@ void nbr_print(void)
 #define nbr_print(...)
 #endif
 
+static inline sys_slist_t *nbr_bucket(const struct in6_addr *addr)
+{
+	/* Neighbors usually share their prefix, so hash the interface
+	 * identifier only.
+	 */
+	uint32_t hash = UNALIGNED_GET(&addr->s6_addr32[2]) ^
+			UNALIGNED_GET(&addr->s6_addr32[3]);
+
+	hash ^= hash >> 16;
+	hash ^= hash >> 8;
+
+	return &nbr_hash[hash % CONFIG_NET_IPV6_NBR_HASH_SIZE];
+}
+
+static void nbr_hash_add(struct net_nbr *nbr)
+{
+	struct net_ipv6_nbr_data *data = net_ipv6_nbr_data(nbr);
+	k_spinlock_key_t key = k_spin_lock(&nbr_hash_lock);
+
+	sys_slist_prepend(nbr_bucket(&data->addr), &data->node);
+
+	k_spin_unlock(&nbr_hash_lock, key);
+}
+
+static void nbr_hash_del(struct net_nbr *nbr)
+{
+	struct net_ipv6_nbr_data *data = net_ipv6_nbr_data(nbr);
+	k_spinlock_key_t key = k_spin_lock(&nbr_hash_lock);
+
+	(void)sys_slist_find_and_remove(nbr_bucket(&data->addr), &data->node);
+
+	k_spin_unlock(&nbr_hash_lock, key);
+}
+
 static struct net_nbr *nbr_lookup(struct net_nbr_table *table,
 				  struct net_if *iface,
 				  const struct in6_addr *addr)
 {
-	int i;
+	struct net_ipv6_nbr_data *data;
+	struct net_nbr *found = NULL;
+	k_spinlock_key_t key;
 
-	for (i = 0; i < CONFIG_NET_IPV6_MAX_NEIGHBORS; i++) {
-		struct net_nbr *nbr = get_nbr(i);
+	ARG_UNUSED(table);
 
-		if (!nbr->ref) {
-			continue;
-		}
+	key = k_spin_lock(&nbr_hash_lock);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(nbr_bucket(addr), data, node) {
+		/* The data of a neighbor is stored right after it */
+		struct net_nbr *nbr = CONTAINER_OF((uint8_t *)data,
+						   struct net_nbr, __nbr);
 
 		if (iface && nbr->iface != iface) {
 			continue;
 		}
 
-		if (net_ipv6_addr_cmp(&net_ipv6_nbr_data(nbr)->addr, addr)) {
-			return nbr;
+		if (net_ipv6_addr_cmp(&data->addr, addr)) {
+			found = nbr;
+			break;
 		}
 	}
 
-	return NULL;
+	k_spin_unlock(&nbr_hash_lock, key);
+
+	return found;
 }
 
 static inline void nbr_clear_ns_pending(struct net_ipv6_nbr_data *data)
@@ -300,6 +350,8 @@ static inline void nbr_free(struct net_nbr *nbr)
 
 	net_nbr_unref(nbr);
 	net_nbr_unlink(nbr, NULL);
+
+	net_ipv6_path_changed();
 }
 
 bool net_ipv6_nbr_rm(struct net_if *iface, struct in6_addr *addr)
@@ -415,6 +467,8 @@ static void nbr_init(struct net_nbr *nbr, struct net_if *iface,
 	net_ipv6_nbr_data(nbr)->reachable = 0;
 	net_ipv6_nbr_data(nbr)->reachable_timeout = 0;
 #endif
+
+	nbr_hash_add(nbr);
 }
 
 static struct net_nbr *nbr_new(struct net_if *iface,
@@ -608,6 +662,7 @@ struct net_nbr *net_ipv6_nbr_add(struct net_if *iface,
 
 			net_linkaddr_set(cached_lladdr, lladdr->addr,
 					 lladdr->len);
+			net_ipv6_path_changed();
 
 			ipv6_nbr_set_state(nbr, NET_IPV6_NBR_STATE_STALE);
 		} else if (net_ipv6_nbr_data(nbr)->state ==
@@ -649,7 +704,7 @@ void net_neighbor_data_remove(struct net_nbr *nbr)
 {
 	NET_DBG("Neighbor %p removed", nbr);
 
-	return;
+	nbr_hash_del(nbr);
 }
 
 void net_neighbor_table_clear(struct net_nbr_table *table)
@@ -772,10 +827,14 @@ enum net_verdict net_ipv6_prepare_for_send(struct net_pkt *pkt)
 	struct net_if *iface = NULL;
 	struct net_ipv6_hdr *ip_hdr;
 	struct net_nbr *nbr;
+	atomic_val_t gen;
 	int ret;
 
 	NET_ASSERT(pkt && pkt->buffer);
 
+	/* Read before resolving the path, in case it changes meanwhile */
+	gen = net_ipv6_path_gen();
+
 	ip_hdr = (struct net_ipv6_hdr *)net_pkt_get_data(pkt, &ipv6_access);
 	if (!ip_hdr) {
 		return NET_DROP;
@@ -926,6 +985,13 @@ try_send:
 							DELAY_FIRST_PROBE_TIME);
 		}
 #endif
+		if (net_ipv6_nbr_data(nbr)->state ==
+		    NET_IPV6_NBR_STATE_REACHABLE ||
+		    net_ipv6_nbr_data(nbr)->state ==
+		    NET_IPV6_NBR_STATE_STATIC) {
+			net_context_path_cache_set(pkt, ip_hdr, nbr, gen);
+		}
+
 		return NET_OK;
 	}
 
@@ -1420,9 +1486,14 @@ static void ipv6_nd_reachable_timeout(struct k_work *work)
 	int64_t current = k_uptime_get();
 	struct net_nbr *nbr = NULL;
 	struct net_ipv6_nbr_data *data = NULL;
+	int64_t next = 0;
 	int ret;
 	int i;
 
+	/* All the neighbors are aged in one pass, the timer being armed
+	 * once at the end for the earliest pending expiry.
+	 */
+
 	for (i = 0; i < CONFIG_NET_IPV6_MAX_NEIGHBORS; i++) {
 		int64_t remaining;
 
@@ -1442,7 +1513,10 @@ static void ipv6_nd_reachable_timeout(struct k_work *work)
 
 		remaining = data->reachable + data->reachable_timeout - current;
 		if (remaining > 0) {
-			ipv6_nd_restart_reachable_timer(NULL, remaining);
+			if (!next || remaining < next) {
+				next = remaining;
+			}
+
 			continue;
 		}
 
@@ -1473,6 +1547,7 @@ static void ipv6_nd_reachable_timeout(struct k_work *work)
 
 		case NET_IPV6_NBR_STATE_REACHABLE:
 			data->state = NET_IPV6_NBR_STATE_STALE;
+			net_ipv6_path_changed();
 
 			NET_DBG("nbr %p moving %s state to STALE (%d)",
 				nbr,
@@ -1521,6 +1596,10 @@ static void ipv6_nd_reachable_timeout(struct k_work *work)
 			break;
 		}
 	}
+
+	if (next) {
+		ipv6_nd_restart_reachable_timer(NULL, next);
+	}
 }
 
 void net_ipv6_nbr_set_reachable_timer(struct net_if *iface,
@@ -1622,6 +1701,7 @@ static inline bool handle_na_neighbor(struct net_pkt *pkt,
 
 			net_linkaddr_set(cached_lladdr, lladdr.addr,
 					 cached_lladdr->len);
+			net_ipv6_path_changed();
 		}
 
 		if (na_hdr->flags & NET_ICMPV6_NA_FLAG_SOLICITED) {
@@ -1667,6 +1747,7 @@ static inline bool handle_na_neighbor(struct net_pkt *pkt,
 
 			net_linkaddr_set(cached_lladdr, lladdr.addr,
 					 cached_lladdr->len);
+			net_ipv6_path_changed();
 		}
 
 		if (na_hdr->flags & NET_ICMPV6_NA_FLAG_SOLICITED) {
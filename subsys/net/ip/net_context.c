@@ -938,6 +938,63 @@ int net_context_create_ipv6_new(struct net_context *context,
 }
 #endif /* CONFIG_NET_IPV6 */
 
+#if defined(CONFIG_NET_CONTEXT_PATH_CACHE)
+void net_context_path_cache_set(struct net_pkt *pkt,
+				struct net_ipv6_hdr *ip_hdr,
+				struct net_nbr *nbr, atomic_val_t gen)
+{
+	struct net_context *context = net_pkt_context(pkt);
+
+	if (!context || net_context_get_proto(context) != IPPROTO_UDP ||
+	    net_context_get_family(context) != AF_INET6 ||
+	    !(context->flags & NET_CONTEXT_REMOTE_ADDR_SET) ||
+	    !net_ipv6_addr_cmp_raw(ip_hdr->dst,
+				   net_sin6(&context->remote)->sin6_addr.s6_addr)) {
+		return;
+	}
+
+	/* The packet might be sent later, after the neighbor is resolved,
+	 * from another thread than the one sending it.
+	 */
+	k_mutex_lock(&context->lock, K_FOREVER);
+
+	net_ipv6_addr_copy_raw(context->path_cache.dst.s6_addr, ip_hdr->dst);
+	net_ipv6_addr_copy_raw(context->path_cache.src.s6_addr, ip_hdr->src);
+	context->path_cache.iface = net_pkt_iface(pkt);
+	context->path_cache.nbr = nbr;
+	context->path_cache.gen = gen;
+
+	k_mutex_unlock(&context->lock);
+}
+
+/* Reuse the path last resolved to dst, if it is still valid. The source
+ * address to use is returned, NULL if the path has to be resolved again.
+ */
+static const struct in6_addr *context_path_cache_get(struct net_context *context,
+						     struct net_pkt *pkt,
+						     const struct in6_addr *dst)
+{
+	struct net_linkaddr_storage *lladdr;
+
+	/* The generation changes with the routes, the neighbors and the
+	 * addresses, and when the neighbor is not reachable anymore.
+	 */
+	if (context->path_cache.gen != net_ipv6_path_gen() ||
+	    !net_ipv6_addr_cmp(&context->path_cache.dst, dst) ||
+	    context->path_cache.nbr->idx == NET_NBR_LLADDR_UNKNOWN) {
+		return NULL;
+	}
+
+	lladdr = net_nbr_get_lladdr(context->path_cache.nbr->idx);
+
+	net_pkt_set_iface(pkt, context->path_cache.iface);
+	net_pkt_lladdr_dst(pkt)->addr = lladdr->addr;
+	net_pkt_lladdr_dst(pkt)->len = lladdr->len;
+
+	return &context->path_cache.src;
+}
+#endif /* CONFIG_NET_CONTEXT_PATH_CACHE */
+
 int net_context_connect(struct net_context *context,
 			const struct sockaddr *addr,
 			socklen_t addrlen,
@@ -1324,11 +1381,16 @@ static int context_setup_udp_packet(struct net_context *context,
 	if (IS_ENABLED(CONFIG_NET_IPV6) &&
 	    net_context_get_family(context) == AF_INET6) {
 		struct sockaddr_in6 *addr6 = (struct sockaddr_in6 *)dst_addr;
+		const struct in6_addr *src = NULL;
 
 		dst_port = addr6->sin6_port;
 
+#if defined(CONFIG_NET_CONTEXT_PATH_CACHE)
+		src = context_path_cache_get(context, pkt, &addr6->sin6_addr);
+#endif
+
 		ret = net_context_create_ipv6_new(context, pkt,
-						  NULL, &addr6->sin6_addr);
+						  src, &addr6->sin6_addr);
 	} else if (IS_ENABLED(CONFIG_NET_IPV4) &&
 		   net_context_get_family(context) == AF_INET) {
 		struct sockaddr_in *addr4 = (struct sockaddr_in *)dst_addr;
@@ -1846,6 +1908,28 @@ int net_context_sendmsg(struct net_context *context,
 	return ret;
 }
 
+#if defined(CONFIG_NET_TCP_SEND_ZC)
+int net_context_send_buf(struct net_context *context,
+			 struct net_buf *buf,
+			 net_context_send_cb_t cb,
+			 void *user_data)
+{
+	int ret;
+
+	if (net_context_get_proto(context) != IPPROTO_TCP) {
+		return -EPROTOTYPE;
+	}
+
+	k_mutex_lock(&context->lock, K_FOREVER);
+
+	ret = net_tcp_queue_buf(context, buf, cb, user_data);
+
+	k_mutex_unlock(&context->lock);
+
+	return ret;
+}
+#endif /* CONFIG_NET_TCP_SEND_ZC */
+
 int net_context_sendto(struct net_context *context,
 		       const void *buf,
 		       size_t len,
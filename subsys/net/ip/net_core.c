@@ -72,10 +72,10 @@ static inline enum net_verdict process_data(struct net_pkt *pkt,
 	}
 
 	/* If the packet is routed back to us when we have reassembled
-	 * an IPv6 packet, then do not pass it to L2 as the packet does
+	 * an IP packet, then do not pass it to L2 as the packet does
 	 * not have link layer headers in it.
 	 */
-	if (IS_ENABLED(CONFIG_NET_IPV6_FRAGMENT) && net_pkt_ipv6_fragment_start(pkt)) {
+	if (IS_ENABLED(CONFIG_NET_IP_REASSEMBLY) && net_pkt_is_ip_reassembled(pkt)) {
 		locally_routed = true;
 	}
 
@@ -188,6 +188,11 @@ static void net_post_init(void)
 
 static void init_rx_queues(void)
 {
+	/* Drivers might schedule RX polling as soon as their interface is
+	 * initialized.
+	 */
+	net_rx_poll_queue_init();
+
 	/* Starting TX side. The ordering is important here and the TX
 	 * can only be started when RX side is ready to receive packets.
 	 */
@@ -383,7 +388,216 @@ void net_process_rx_packet(struct net_pkt *pkt)
 	net_rx(net_pkt_iface(pkt), pkt);
 }
 
-static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
+#if defined(CONFIG_NET_GRO)
+#define GRO_TCP_PSH	BIT(3)
+#define GRO_TCP_ACK	BIT(4)
+
+struct gro_seg {
+	struct net_pkt *pkt;
+	uint8_t *l3;
+	uint8_t *tcp;
+	uint16_t hdr_len;
+	uint16_t data_len;
+	uint8_t count;
+};
+
+/* Check whether the packet is a plain TCP segment, destined to us, that can
+ * be coalesced. The headers must all be in the first fragment.
+ */
+static bool gro_parse(struct net_pkt *pkt, struct gro_seg *seg)
+{
+	struct net_if *iface = net_pkt_iface(pkt);
+	struct net_buf *frag = pkt->frags;
+	uint16_t l3_len, ip_len;
+	uint8_t *l3;
+
+	if (net_if_l2(iface) != &NET_L2_GET_NAME(ETHERNET) ||
+	    net_if_need_calc_rx_checksum(iface) ||
+	    frag->len < sizeof(struct net_eth_hdr)) {
+		return false;
+	}
+
+	l3 = frag->data + sizeof(struct net_eth_hdr);
+
+	switch (sys_get_be16(frag->data + offsetof(struct net_eth_hdr, type))) {
+	case NET_ETH_PTYPE_IP: {
+		struct in_addr dst;
+
+		if (!IS_ENABLED(CONFIG_NET_IPV4)) {
+			return false;
+		}
+
+		l3_len = NET_IPV4H_LEN;
+		if (frag->len < sizeof(struct net_eth_hdr) + NET_IPV4TCPH_LEN) {
+			return false;
+		}
+
+		/* No options, no fragments */
+		if (l3[0] != 0x45 || l3[9] != IPPROTO_TCP ||
+		    (sys_get_be16(&l3[6]) & 0x3fff) != 0U) {
+			return false;
+		}
+
+		memcpy(&dst, &l3[16], sizeof(dst));
+		if (!net_ipv4_is_my_addr(&dst)) {
+			return false;
+		}
+
+		ip_len = sys_get_be16(&l3[2]);
+		break;
+	}
+	case NET_ETH_PTYPE_IPV6: {
+		struct in6_addr dst;
+
+		if (!IS_ENABLED(CONFIG_NET_IPV6)) {
+			return false;
+		}
+
+		l3_len = NET_IPV6H_LEN;
+		if (frag->len < sizeof(struct net_eth_hdr) + NET_IPV6TCPH_LEN) {
+			return false;
+		}
+
+		/* No extension headers */
+		if ((l3[0] & 0xf0) != 0x60 || l3[6] != IPPROTO_TCP) {
+			return false;
+		}
+
+		memcpy(&dst, &l3[24], sizeof(dst));
+		if (!net_ipv6_is_my_addr(&dst)) {
+			return false;
+		}
+
+		ip_len = NET_IPV6H_LEN + sys_get_be16(&l3[4]);
+		break;
+	}
+	default:
+		return false;
+	}
+
+	seg->tcp = l3 + l3_len;
+
+	/* No options, and no flags other than ACK and PSH */
+	if ((seg->tcp[12] >> 4) != (NET_TCPH_LEN / 4) ||
+	    (seg->tcp[13] & ~GRO_TCP_PSH) != GRO_TCP_ACK) {
+		return false;
+	}
+
+	/* Padded frames would need trimming */
+	if (ip_len <= l3_len + NET_TCPH_LEN ||
+	    sizeof(struct net_eth_hdr) + ip_len != net_pkt_get_len(pkt)) {
+		return false;
+	}
+
+	seg->pkt = pkt;
+	seg->l3 = l3;
+	seg->hdr_len = sizeof(struct net_eth_hdr) + l3_len + NET_TCPH_LEN;
+	seg->data_len = ip_len - l3_len - NET_TCPH_LEN;
+	seg->count = 1U;
+
+	return true;
+}
+
+/* Append the payload of @a seg to @a head if @a seg is the next segment of
+ * the same connection.
+ */
+static bool gro_merge(struct gro_seg *head, struct gro_seg *seg)
+{
+	struct net_pkt *pkt = seg->pkt;
+	bool ipv4 = (head->l3[0] & 0xf0) == 0x40;
+	struct net_buf *buf;
+
+	if (head->count >= CONFIG_NET_GRO_MAX_SEGS ||
+	    (head->tcp[13] & GRO_TCP_PSH) ||
+	    net_pkt_iface(head->pkt) != net_pkt_iface(pkt) ||
+	    head->hdr_len != seg->hdr_len ||
+	    (head->l3[0] & 0xf0) != (seg->l3[0] & 0xf0) ||
+	    head->data_len + seg->data_len >
+	    UINT16_MAX - (head->hdr_len - sizeof(struct net_eth_hdr))) {
+		return false;
+	}
+
+	/* Same ports, addresses and acknowledgment number, in order */
+	if (memcmp(head->tcp, seg->tcp, 4) != 0 ||
+	    memcmp(head->tcp + 8, seg->tcp + 8, 4) != 0 ||
+	    (ipv4 ? memcmp(head->l3 + 12, seg->l3 + 12, 8) :
+		    memcmp(head->l3 + 8, seg->l3 + 8, 32)) != 0 ||
+	    sys_get_be32(seg->tcp + 4) !=
+	    sys_get_be32(head->tcp + 4) + head->data_len) {
+		return false;
+	}
+
+	head->tcp[13] |= seg->tcp[13];
+	memcpy(head->tcp + 14, seg->tcp + 14, 2);
+
+	buf = pkt->buffer;
+	net_buf_pull(buf, seg->hdr_len);
+	if (buf->len == 0U) {
+		buf = net_buf_frag_del(NULL, buf);
+	}
+
+	pkt->buffer = NULL;
+	net_pkt_unref(pkt);
+
+	if (buf) {
+		net_pkt_append_buffer(head->pkt, buf);
+	}
+
+	head->data_len += seg->data_len;
+	head->count++;
+
+	/* The checksums are not updated: they are not verified on interfaces
+	 * offloading RX checksums, the only ones coalescing is done for.
+	 */
+	if (ipv4) {
+		sys_put_be16(NET_IPV4TCPH_LEN + head->data_len, head->l3 + 2);
+	} else {
+		sys_put_be16(NET_TCPH_LEN + head->data_len, head->l3 + 4);
+	}
+
+	return true;
+}
+
+/* Process @a pkt, and the packets already queued in @a fifo, coalescing
+ * consecutive segments of the same TCP connection.
+ */
+void net_process_rx_batch(struct net_pkt *pkt, struct k_fifo *fifo)
+{
+	struct gro_seg head = { 0 };
+	struct gro_seg seg;
+	int i = 0;
+
+	do {
+		if (!gro_parse(pkt, &seg)) {
+			if (head.pkt) {
+				net_process_rx_packet(head.pkt);
+				head.pkt = NULL;
+			}
+
+			net_process_rx_packet(pkt);
+			continue;
+		}
+
+		if (head.pkt && gro_merge(&head, &seg)) {
+			continue;
+		}
+
+		if (head.pkt) {
+			net_process_rx_packet(head.pkt);
+		}
+
+		head = seg;
+	} while (++i < CONFIG_NET_GRO_BATCH_SIZE &&
+		 (pkt = k_fifo_get(fifo, K_NO_WAIT)) != NULL);
+
+	if (head.pkt) {
+		NET_DBG("Coalesced %u segments in pkt %p", head.count, head.pkt);
+		net_process_rx_packet(head.pkt);
+	}
+}
+#endif /* CONFIG_NET_GRO */
+
+static uint8_t net_rx_classify(struct net_if *iface, struct net_pkt *pkt)
 {
 	uint8_t prio = net_pkt_priority(pkt);
 	uint8_t tc = net_rx_priority2tc(prio);
@@ -398,6 +612,13 @@ static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
 	NET_DBG("TC %d with prio %d pkt %p", tc, prio, pkt);
 #endif
 
+	return tc;
+}
+
+static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
+{
+	uint8_t tc = net_rx_classify(iface, pkt);
+
 	if (NET_TC_RX_COUNT == 0) {
 		net_process_rx_packet(pkt);
 	} else {
@@ -405,6 +626,30 @@ static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
 	}
 }
 
+/* Returns false if the packet was filtered out and dropped */
+static bool net_recv_prepare(struct net_if *iface, struct net_pkt *pkt)
+{
+	net_pkt_set_overwrite(pkt, true);
+	net_pkt_cursor_init(pkt);
+
+	NET_DBG("prio %d iface %p pkt %p len %zu", net_pkt_priority(pkt),
+		iface, pkt, net_pkt_get_len(pkt));
+
+	if (IS_ENABLED(CONFIG_NET_ROUTING)) {
+		net_pkt_set_orig_iface(pkt, iface);
+	}
+
+	net_pkt_set_iface(pkt, iface);
+
+	if (!net_pkt_filter_recv_ok(pkt)) {
+		/* silently drop the packet */
+		net_pkt_unref(pkt);
+		return false;
+	}
+
+	return true;
+}
+
 /* Called by driver when a packet has been received */
 int net_recv_data(struct net_if *iface, struct net_pkt *pkt)
 {
@@ -420,26 +665,67 @@ int net_recv_data(struct net_if *iface, struct net_pkt *pkt)
 		return -ENETDOWN;
 	}
 
-	net_pkt_set_overwrite(pkt, true);
-	net_pkt_cursor_init(pkt);
+	if (net_recv_prepare(iface, pkt)) {
+		net_queue_rx(iface, pkt);
+	}
 
-	NET_DBG("prio %d iface %p pkt %p len %zu", net_pkt_priority(pkt),
-		iface, pkt, net_pkt_get_len(pkt));
+	return 0;
+}
 
-	if (IS_ENABLED(CONFIG_NET_ROUTING)) {
-		net_pkt_set_orig_iface(pkt, iface);
+/* Called by driver when a batch of packets has been received */
+int net_recv_data_list(struct net_if *iface, sys_slist_t *list)
+{
+#if NET_TC_RX_COUNT > 0
+	sys_slist_t tc_lists[NET_TC_RX_COUNT];
+#endif
+	struct net_pkt *pkt;
+	int count = 0;
+	uint8_t tc;
+
+	if (!list || !iface) {
+		return -EINVAL;
 	}
 
-	net_pkt_set_iface(pkt, iface);
+	if (!net_if_flag_is_set(iface, NET_IF_UP)) {
+		return -ENETDOWN;
+	}
 
-	if (!net_pkt_filter_recv_ok(pkt)) {
-		/* silently drop the packet */
-		net_pkt_unref(pkt);
-	} else {
-		net_queue_rx(iface, pkt);
+#if NET_TC_RX_COUNT > 0
+	for (tc = 0U; tc < NET_TC_RX_COUNT; tc++) {
+		sys_slist_init(&tc_lists[tc]);
 	}
+#endif
 
-	return 0;
+	while ((pkt = (struct net_pkt *)sys_slist_get(list)) != NULL) {
+		if (net_pkt_is_empty(pkt)) {
+			net_pkt_unref(pkt);
+			continue;
+		}
+
+		if (!net_recv_prepare(iface, pkt)) {
+			continue;
+		}
+
+		count++;
+		tc = net_rx_classify(iface, pkt);
+
+#if NET_TC_RX_COUNT > 0
+		sys_slist_append(&tc_lists[tc], (sys_snode_t *)pkt);
+#else
+		ARG_UNUSED(tc);
+		net_process_rx_packet(pkt);
+#endif
+	}
+
+#if NET_TC_RX_COUNT > 0
+	for (tc = 0U; tc < NET_TC_RX_COUNT; tc++) {
+		if (!sys_slist_is_empty(&tc_lists[tc])) {
+			net_tc_submit_list_to_rx_queue(tc, &tc_lists[tc]);
+		}
+	}
+#endif
+
+	return count;
 }
 
 static inline void l3_init(void)
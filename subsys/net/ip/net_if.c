@@ -24,6 +24,7 @@ LOG_MODULE_REGISTER(net_if, CONFIG_NET_IF_LOG_LEVEL);
 
 #include "net_private.h"
 #include "ipv6.h"
+#include "route.h"
 #include "ipv4_autoconf_internal.h"
 
 #include "net_stats.h"
@@ -334,6 +335,61 @@ void net_process_tx_packet(struct net_pkt *pkt)
 #endif
 }
 
+#if defined(CONFIG_NET_TX_BATCH)
+static const struct ethernet_api *tx_batch_api(struct net_if *iface)
+{
+	const struct ethernet_api *api;
+
+	if (net_if_l2(iface) != &NET_L2_GET_NAME(ETHERNET)) {
+		return NULL;
+	}
+
+	api = net_if_get_device(iface)->api;
+	if (!api->tx_flush) {
+		return NULL;
+	}
+
+	return api;
+}
+
+/* Process @a pkt, and the packets already queued in @a fifo, letting the
+ * driver start the transmission once for consecutive packets sent to the
+ * same interface.
+ */
+void net_process_tx_batch(struct net_pkt *pkt, struct k_fifo *fifo)
+{
+	const struct ethernet_api *api;
+	struct net_pkt *next;
+	struct net_if *iface;
+	bool deferred = false;
+	int i = 1;
+
+	do {
+		next = i++ < CONFIG_NET_TX_BATCH_SIZE ?
+			k_fifo_get(fifo, K_NO_WAIT) : NULL;
+
+		iface = net_pkt_iface(pkt);
+		api = tx_batch_api(iface);
+
+		net_pkt_set_tx_more(pkt, api && next &&
+				    net_pkt_iface(next) == iface);
+		if (net_pkt_tx_more(pkt)) {
+			deferred = true;
+		}
+
+		net_process_tx_packet(pkt);
+
+		/* The last packet of the run might not have reached the
+		 * driver, so the transmission is started explicitly.
+		 */
+		if (deferred && !(next && net_pkt_iface(next) == iface)) {
+			api->tx_flush(net_if_get_device(iface));
+			deferred = false;
+		}
+	} while ((pkt = next) != NULL);
+}
+#endif /* CONFIG_NET_TX_BATCH */
+
 void net_if_queue_tx(struct net_if *iface, struct net_pkt *pkt)
 {
 	if (!net_pkt_filter_send_ok(pkt)) {
@@ -342,6 +398,11 @@ void net_if_queue_tx(struct net_if *iface, struct net_pkt *pkt)
 		return;
 	}
 
+	if (IS_ENABLED(CONFIG_NET_TX_BATCH)) {
+		/* Only set when taken from a TX queue */
+		net_pkt_set_tx_more(pkt, false);
+	}
+
 	uint8_t prio = net_pkt_priority(pkt);
 	uint8_t tc = net_tx_priority2tc(prio);
 
@@ -705,6 +766,8 @@ static void iface_router_notify_deletion(struct net_if_router *router,
 			net_sprint_ipv6_addr(net_if_router_ipv6(router)),
 			delete_reason);
 
+		net_ipv6_path_changed();
+
 		net_mgmt_event_notify_with_info(NET_EVENT_IPV6_ROUTER_DEL,
 						router->iface,
 						&router->address.in6_addr,
@@ -832,6 +895,7 @@ static struct net_if_router *iface_router_add(struct net_if *iface,
 		if (IS_ENABLED(CONFIG_NET_IPV6) && family == AF_INET6) {
 			memcpy(net_if_router_ipv6(&routers[i]), addr,
 			       sizeof(struct in6_addr));
+			net_ipv6_path_changed();
 			net_mgmt_event_notify_with_info(
 					NET_EVENT_IPV6_ROUTER_ADD, iface,
 					&routers[i].address.in6_addr,
@@ -987,6 +1051,65 @@ void net_if_mcast_monitor(struct net_if *iface,
 
 	k_mutex_unlock(&lock);
 }
+
+static inline void mcast_filter_clear(struct net_if_mcast_addr *addr)
+{
+	addr->is_include = false;
+#if defined(CONFIG_NET_IF_MCAST_SOURCE_FILTER)
+	addr->num_sources = 0U;
+#endif
+}
+
+#if defined(CONFIG_NET_IF_MCAST_SOURCE_FILTER)
+int net_if_mcast_set_sources(struct net_if_mcast_addr *addr, bool include,
+			     const struct net_addr *sources, size_t count)
+{
+	size_t i;
+
+	NET_ASSERT(addr);
+
+	if (count > CONFIG_NET_IF_MCAST_SOURCE_COUNT) {
+		return -ENOMEM;
+	}
+
+	for (i = 0; i < count; i++) {
+		if (sources[i].family != addr->address.family) {
+			return -EINVAL;
+		}
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	addr->is_include = include;
+	addr->num_sources = count;
+	memcpy(addr->sources, sources, count * sizeof(struct net_addr));
+
+	k_mutex_unlock(&lock);
+
+	return 0;
+}
+
+bool net_if_mcast_source_is_allowed(const struct net_if_mcast_addr *addr,
+				    const void *src)
+{
+	bool found = false;
+	uint8_t i;
+
+	for (i = 0U; i < addr->num_sources && !found; i++) {
+		if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		    addr->address.family == AF_INET6) {
+			found = net_ipv6_addr_cmp(&addr->sources[i].in6_addr,
+						  src);
+		} else if (IS_ENABLED(CONFIG_NET_IPV4) &&
+			   addr->address.family == AF_INET) {
+			found = net_ipv4_addr_cmp(&addr->sources[i].in_addr,
+						  src);
+		}
+	}
+
+	return found == addr->is_include;
+}
+#endif /* CONFIG_NET_IF_MCAST_SOURCE_FILTER */
 #endif
 
 #if defined(CONFIG_NET_NATIVE_IPV6)
@@ -1171,6 +1294,7 @@ static void dad_timeout(struct k_work *work)
 			net_sprint_ipv6_addr(&ifaddr->address.in6_addr));
 
 		ifaddr->addr_state = NET_ADDR_PREFERRED;
+		net_ipv6_path_changed();
 
 		/* Because we do not know the interface at this point,
 		 * we need to lookup for it.
@@ -1551,6 +1675,7 @@ static void address_expired(struct net_if_addr *ifaddr)
 		net_sprint_ipv6_addr(&ifaddr->address.in6_addr));
 
 	ifaddr->addr_state = NET_ADDR_DEPRECATED;
+	net_ipv6_path_changed();
 
 	sys_slist_find_and_remove(&active_address_lifetime_timers,
 				  &ifaddr->lifetime.node);
@@ -1730,6 +1855,8 @@ struct net_if_addr *net_if_ipv6_addr_add(struct net_if *iface,
 			ipv6->unicast[i].addr_state = NET_ADDR_PREFERRED;
 		}
 
+		net_ipv6_path_changed();
+
 		net_mgmt_event_notify_with_info(
 			NET_EVENT_IPV6_ADDR_ADD, iface,
 			&ipv6->unicast[i].address.in6_addr,
@@ -1790,6 +1917,8 @@ bool net_if_ipv6_addr_rm(struct net_if *iface, const struct in6_addr *addr)
 
 		net_if_ipv6_maddr_rm(iface, &maddr);
 
+		net_ipv6_path_changed();
+
 		NET_DBG("[%d] interface %p address %s type %s removed",
 			i, iface, net_sprint_ipv6_addr(addr),
 			net_addr_type2str(ipv6->unicast[i].addr_type));
@@ -1921,6 +2050,7 @@ struct net_if_mcast_addr *net_if_ipv6_maddr_add(struct net_if *iface,
 		ipv6->mcast[i].is_used = true;
 		ipv6->mcast[i].address.family = AF_INET6;
 		memcpy(&ipv6->mcast[i].address.in6_addr, addr, 16);
+		mcast_filter_clear(&ipv6->mcast[i]);
 
 		NET_DBG("[%d] interface %p address %s added", i, iface,
 			net_sprint_ipv6_addr(addr));
@@ -3701,6 +3831,7 @@ struct net_if_mcast_addr *net_if_ipv4_maddr_add(struct net_if *iface,
 		maddr->is_used = true;
 		maddr->address.family = AF_INET;
 		maddr->address.in_addr.s4_addr32[0] = addr->s4_addr32[0];
+		mcast_filter_clear(maddr);
 
 		NET_DBG("interface %p address %s added", iface,
 			net_sprint_ipv4_addr(addr));
@@ -33,20 +33,49 @@ struct mgmt_event_wait {
 	struct net_if *iface;
 };
 
+/* The callbacks are spread in lists by layer and layer code, so that an
+ * event is only matched against the callbacks of its layer code most of
+ * the time.
+ */
+#define MGMT_CB_BUCKETS 8
+
 static K_SEM_DEFINE(network_event, 0, K_SEM_MAX_LIMIT);
+
+/* Protects the callback lists, held while the callbacks run */
 static K_MUTEX_DEFINE(net_mgmt_lock);
 
+/* Protects the event queue, never held while running callbacks, so that
+ * raising an event does not wait for the callbacks of previous events.
+ */
+static struct k_spinlock event_lock;
+
 K_KERNEL_STACK_DEFINE(mgmt_stack, CONFIG_NET_MGMT_EVENT_STACK_SIZE);
 static struct k_thread mgmt_thread_data;
 static struct mgmt_event_entry events[CONFIG_NET_MGMT_EVENT_QUEUE_SIZE];
-static uint32_t global_event_mask;
-static sys_slist_t event_callbacks = SYS_SLIST_STATIC_INIT(&event_callbacks);
+static struct mgmt_event_entry current_event;
+static uint32_t event_masks[MGMT_CB_BUCKETS];
+static sys_slist_t event_callbacks[MGMT_CB_BUCKETS];
 static int16_t in_event;
 static int16_t out_event;
 
+#if defined(CONFIG_NET_MGMT_EVENT_DIRECT)
+static K_MUTEX_DEFINE(direct_lock);
+static uint32_t direct_event_masks[MGMT_CB_BUCKETS];
+static sys_slist_t direct_callbacks[MGMT_CB_BUCKETS];
+#endif
+
+static inline int mgmt_bucket(uint32_t mgmt_event)
+{
+	uint32_t code = NET_MGMT_GET_LAYER_CODE(mgmt_event);
+
+	return (code ^ (code >> 4) ^ (NET_MGMT_GET_LAYER(mgmt_event) << 2)) &
+		(MGMT_CB_BUCKETS - 1);
+}
+
 static inline void mgmt_push_event(uint32_t mgmt_event, struct net_if *iface,
 				   const void *info, size_t length)
 {
+	k_spinlock_key_t key;
 	int16_t i_idx;
 
 #ifndef CONFIG_NET_MGMT_EVENT_INFO
@@ -54,7 +83,16 @@ static inline void mgmt_push_event(uint32_t mgmt_event, struct net_if *iface,
 	ARG_UNUSED(length);
 #endif /* CONFIG_NET_MGMT_EVENT_INFO */
 
-	(void)k_mutex_lock(&net_mgmt_lock, K_FOREVER);
+#ifdef CONFIG_NET_MGMT_EVENT_INFO
+	if (info && length > NET_EVENT_INFO_MAX_SIZE) {
+		NET_ERR("Event info length %zu > max size %zu",
+			length, NET_EVENT_INFO_MAX_SIZE);
+
+		return;
+	}
+#endif /* CONFIG_NET_MGMT_EVENT_INFO */
+
+	key = k_spin_lock(&event_lock);
 
 	i_idx = in_event + 1;
 	if (i_idx == CONFIG_NET_MGMT_EVENT_QUEUE_SIZE) {
@@ -63,16 +101,8 @@ static inline void mgmt_push_event(uint32_t mgmt_event, struct net_if *iface,
 
 #ifdef CONFIG_NET_MGMT_EVENT_INFO
 	if (info && length) {
-		if (length <= NET_EVENT_INFO_MAX_SIZE) {
-			memcpy(events[i_idx].info, info, length);
-			events[i_idx].info_length = length;
-		} else {
-			NET_ERR("Event info length %zu > max size %zu",
-				length, NET_EVENT_INFO_MAX_SIZE);
-			(void)k_mutex_unlock(&net_mgmt_lock);
-
-			return;
-		}
+		memcpy(events[i_idx].info, info, length);
+		events[i_idx].info_length = length;
 	} else {
 		events[i_idx].info_length = 0;
 	}
@@ -97,7 +127,7 @@ static inline void mgmt_push_event(uint32_t mgmt_event, struct net_if *iface,
 
 	in_event = i_idx;
 
-	(void)k_mutex_unlock(&net_mgmt_lock);
+	k_spin_unlock(&event_lock, key);
 }
 
 static inline struct mgmt_event_entry *mgmt_pop_event(void)
@@ -127,54 +157,62 @@ static inline void mgmt_clean_event(struct mgmt_event_entry *mgmt_event)
 	mgmt_event->iface = NULL;
 }
 
-static inline void mgmt_add_event_mask(uint32_t event_mask)
+static inline void mgmt_rebuild_event_mask(uint32_t *masks,
+					   sys_slist_t *lists, int bucket)
 {
-	global_event_mask |= event_mask;
-}
-
-static inline void mgmt_rebuild_global_event_mask(void)
-{
-	struct net_mgmt_event_callback *cb, *tmp;
+	struct net_mgmt_event_callback *cb;
 
-	global_event_mask = 0U;
+	masks[bucket] = 0U;
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&event_callbacks, cb, tmp, node) {
-		mgmt_add_event_mask(cb->event_mask);
+	SYS_SLIST_FOR_EACH_CONTAINER(&lists[bucket], cb, node) {
+		masks[bucket] |= cb->event_mask;
 	}
 }
 
-static inline bool mgmt_is_event_handled(uint32_t mgmt_event)
+static inline bool mgmt_is_event_handled(uint32_t *masks, uint32_t mgmt_event)
 {
+	uint32_t event_mask = masks[mgmt_bucket(mgmt_event)];
+
 	return (((NET_MGMT_GET_LAYER(mgmt_event) &
-		  NET_MGMT_GET_LAYER(global_event_mask)) ==
+		  NET_MGMT_GET_LAYER(event_mask)) ==
 		 NET_MGMT_GET_LAYER(mgmt_event)) &&
 		((NET_MGMT_GET_LAYER_CODE(mgmt_event) &
-		  NET_MGMT_GET_LAYER_CODE(global_event_mask)) ==
+		  NET_MGMT_GET_LAYER_CODE(event_mask)) ==
 		 NET_MGMT_GET_LAYER_CODE(mgmt_event)) &&
 		((NET_MGMT_GET_COMMAND(mgmt_event) &
-		  NET_MGMT_GET_COMMAND(global_event_mask)) ==
+		  NET_MGMT_GET_COMMAND(event_mask)) ==
 		 NET_MGMT_GET_COMMAND(mgmt_event)));
 }
 
+static inline bool mgmt_cb_matches(struct net_mgmt_event_callback *cb,
+				   uint32_t mgmt_event)
+{
+	return (NET_MGMT_GET_LAYER(mgmt_event) ==
+		NET_MGMT_GET_LAYER(cb->event_mask)) &&
+	       (NET_MGMT_GET_LAYER_CODE(mgmt_event) ==
+		NET_MGMT_GET_LAYER_CODE(cb->event_mask)) &&
+	       (!NET_MGMT_GET_COMMAND(mgmt_event) ||
+		!NET_MGMT_GET_COMMAND(cb->event_mask) ||
+		(NET_MGMT_GET_COMMAND(mgmt_event) &
+		 NET_MGMT_GET_COMMAND(cb->event_mask)));
+}
+
 static inline void mgmt_run_callbacks(struct mgmt_event_entry *mgmt_event)
 {
-	sys_snode_t *prev = NULL;
+	int bucket = mgmt_bucket(mgmt_event->event);
+	sys_slist_t *list = &event_callbacks[bucket];
 	struct net_mgmt_event_callback *cb, *tmp;
+	sys_snode_t *prev = NULL;
+	bool removed = false;
 
 	NET_DBG("Event layer %u code %u cmd %u",
 		NET_MGMT_GET_LAYER(mgmt_event->event),
 		NET_MGMT_GET_LAYER_CODE(mgmt_event->event),
 		NET_MGMT_GET_COMMAND(mgmt_event->event));
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&event_callbacks, cb, tmp, node) {
-		if (!(NET_MGMT_GET_LAYER(mgmt_event->event) ==
-		      NET_MGMT_GET_LAYER(cb->event_mask)) ||
-		    !(NET_MGMT_GET_LAYER_CODE(mgmt_event->event) ==
-		      NET_MGMT_GET_LAYER_CODE(cb->event_mask)) ||
-		    (NET_MGMT_GET_COMMAND(mgmt_event->event) &&
-		     NET_MGMT_GET_COMMAND(cb->event_mask) &&
-		     !(NET_MGMT_GET_COMMAND(mgmt_event->event) &
-		       NET_MGMT_GET_COMMAND(cb->event_mask)))) {
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(list, cb, tmp, node) {
+		if (!mgmt_cb_matches(cb, mgmt_event->event)) {
+			prev = &cb->node;
 			continue;
 		}
 
@@ -195,6 +233,7 @@ static inline void mgmt_run_callbacks(struct mgmt_event_entry *mgmt_event)
 
 			if (sync_data->iface &&
 			    sync_data->iface != mgmt_event->iface) {
+				prev = &cb->node;
 				continue;
 			}
 
@@ -203,7 +242,8 @@ static inline void mgmt_run_callbacks(struct mgmt_event_entry *mgmt_event)
 			cb->raised_event = mgmt_event->event;
 			sync_data->iface = mgmt_event->iface;
 
-			sys_slist_remove(&event_callbacks, prev, &cb->node);
+			sys_slist_remove(list, prev, &cb->node);
+			removed = true;
 
 			k_sem_give(cb->sync_call);
 		} else {
@@ -215,6 +255,10 @@ static inline void mgmt_run_callbacks(struct mgmt_event_entry *mgmt_event)
 		}
 	}
 
+	if (removed) {
+		mgmt_rebuild_event_mask(event_masks, event_callbacks, bucket);
+	}
+
 #ifdef CONFIG_NET_DEBUG_MGMT_EVENT_STACK
 	log_stack_usage(&mgmt_thread_data);
 #endif
@@ -223,10 +267,11 @@ static inline void mgmt_run_callbacks(struct mgmt_event_entry *mgmt_event)
 static void mgmt_thread(void)
 {
 	struct mgmt_event_entry *mgmt_event;
+	k_spinlock_key_t key;
 
 	while (1) {
 		k_sem_take(&network_event, K_FOREVER);
-		(void)k_mutex_lock(&net_mgmt_lock, K_FOREVER);
+		key = k_spin_lock(&event_lock);
 
 		NET_DBG("Handling events, forwarding it relevantly");
 
@@ -240,15 +285,30 @@ static void mgmt_thread(void)
 				k_sem_count_get(&network_event));
 
 			k_sem_init(&network_event, 0, K_SEM_MAX_LIMIT);
-			(void)k_mutex_unlock(&net_mgmt_lock);
+			k_spin_unlock(&event_lock, key);
 
 			continue;
 		}
 
-		mgmt_run_callbacks(mgmt_event);
+		/* The event is copied so that the callbacks run without
+		 * holding up the code raising the next ones.
+		 */
+		current_event.event = mgmt_event->event;
+		current_event.iface = mgmt_event->iface;
+#ifdef CONFIG_NET_MGMT_EVENT_INFO
+		memcpy(current_event.info, mgmt_event->info,
+		       mgmt_event->info_length);
+		current_event.info_length = mgmt_event->info_length;
+#endif /* CONFIG_NET_MGMT_EVENT_INFO */
 
 		mgmt_clean_event(mgmt_event);
 
+		k_spin_unlock(&event_lock, key);
+
+		(void)k_mutex_lock(&net_mgmt_lock, K_FOREVER);
+
+		mgmt_run_callbacks(&current_event);
+
 		(void)k_mutex_unlock(&net_mgmt_lock);
 
 		k_yield();
@@ -282,6 +342,8 @@ static int mgmt_event_wait_call(struct net_if *iface,
 
 	ret = k_sem_take(sync.sync_call, timeout);
 	if (ret == -EAGAIN) {
+		/* The callback lives on the stack, it must not stay listed */
+		net_mgmt_del_event_callback(&sync);
 		ret = -ETIMEDOUT;
 	} else {
 		if (!ret) {
@@ -314,9 +376,10 @@ void net_mgmt_add_event_callback(struct net_mgmt_event_callback *cb)
 
 	(void)k_mutex_lock(&net_mgmt_lock, K_FOREVER);
 
-	sys_slist_prepend(&event_callbacks, &cb->node);
+	sys_slist_prepend(&event_callbacks[mgmt_bucket(cb->event_mask)],
+			  &cb->node);
 
-	mgmt_add_event_mask(cb->event_mask);
+	event_masks[mgmt_bucket(cb->event_mask)] |= cb->event_mask;
 
 	(void)k_mutex_unlock(&net_mgmt_lock);
 }
@@ -327,17 +390,98 @@ void net_mgmt_del_event_callback(struct net_mgmt_event_callback *cb)
 
 	(void)k_mutex_lock(&net_mgmt_lock, K_FOREVER);
 
-	sys_slist_find_and_remove(&event_callbacks, &cb->node);
-
-	mgmt_rebuild_global_event_mask();
+	/* The mask may have been changed by the owner, or be the raised
+	 * event of a synchronous wait, so all the lists are looked into.
+	 */
+	for (int i = 0; i < MGMT_CB_BUCKETS; i++) {
+		if (sys_slist_find_and_remove(&event_callbacks[i],
+					      &cb->node)) {
+			mgmt_rebuild_event_mask(event_masks, event_callbacks,
+						i);
+			break;
+		}
+	}
 
 	(void)k_mutex_unlock(&net_mgmt_lock);
+
+#if defined(CONFIG_NET_MGMT_EVENT_DIRECT)
+	(void)k_mutex_lock(&direct_lock, K_FOREVER);
+
+	for (int i = 0; i < MGMT_CB_BUCKETS; i++) {
+		if (sys_slist_find_and_remove(&direct_callbacks[i],
+					      &cb->node)) {
+			mgmt_rebuild_event_mask(direct_event_masks,
+						direct_callbacks, i);
+			break;
+		}
+	}
+
+	(void)k_mutex_unlock(&direct_lock);
+#endif
+}
+
+#if defined(CONFIG_NET_MGMT_EVENT_DIRECT)
+void net_mgmt_add_event_callback_direct(struct net_mgmt_event_callback *cb)
+{
+	NET_DBG("Adding direct event callback %p", cb);
+
+	__ASSERT(!NET_MGMT_EVENT_SYNCHRONOUS(cb->event_mask),
+		 "Synchronous waits cannot be direct");
+
+	(void)k_mutex_lock(&direct_lock, K_FOREVER);
+
+	sys_slist_prepend(&direct_callbacks[mgmt_bucket(cb->event_mask)],
+			  &cb->node);
+
+	direct_event_masks[mgmt_bucket(cb->event_mask)] |= cb->event_mask;
+
+	(void)k_mutex_unlock(&direct_lock);
+}
+
+static void mgmt_run_direct_callbacks(uint32_t mgmt_event,
+				      struct net_if *iface,
+				      const void *info, size_t length)
+{
+	struct net_mgmt_event_callback *cb, *tmp;
+
+	(void)k_mutex_lock(&direct_lock, K_FOREVER);
+
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(
+		&direct_callbacks[mgmt_bucket(mgmt_event)], cb, tmp, node) {
+		if (!mgmt_cb_matches(cb, mgmt_event)) {
+			continue;
+		}
+
+#ifdef CONFIG_NET_MGMT_EVENT_INFO
+		if (info && length) {
+			cb->info = info;
+			cb->info_length = length;
+		} else {
+			cb->info = NULL;
+			cb->info_length = 0;
+		}
+#else
+		ARG_UNUSED(info);
+		ARG_UNUSED(length);
+#endif /* CONFIG_NET_MGMT_EVENT_INFO */
+
+		cb->handler(cb, mgmt_event, iface);
+	}
+
+	(void)k_mutex_unlock(&direct_lock);
 }
+#endif /* CONFIG_NET_MGMT_EVENT_DIRECT */
 
 void net_mgmt_event_notify_with_info(uint32_t mgmt_event, struct net_if *iface,
 				     const void *info, size_t length)
 {
-	if (mgmt_is_event_handled(mgmt_event)) {
+#if defined(CONFIG_NET_MGMT_EVENT_DIRECT)
+	if (mgmt_is_event_handled(direct_event_masks, mgmt_event)) {
+		mgmt_run_direct_callbacks(mgmt_event, iface, info, length);
+	}
+#endif
+
+	if (mgmt_is_event_handled(event_masks, mgmt_event)) {
 		NET_DBG("Notifying Event layer %u code %u type %u",
 			NET_MGMT_GET_LAYER(mgmt_event),
 			NET_MGMT_GET_LAYER_CODE(mgmt_event),
@@ -861,14 +861,34 @@ static struct net_buf *pkt_alloc_buffer(struct net_buf_pool *pool,
 					size_t size, k_timeout_t timeout)
 #endif
 {
+	const struct net_buf_pool_fixed *fixed = pool->alloc->alloc_data;
 	uint64_t end = sys_clock_timeout_end_calc(timeout);
 	struct net_buf *first = NULL;
 	struct net_buf *current = NULL;
+	struct net_buf *batch[8];
+	int batched = 0;
+	int next = 0;
 
 	while (size) {
 		struct net_buf *new;
 
-		new = net_buf_alloc_fixed(pool, timeout);
+		/* Take the buffers that are readily available at once, and
+		 * only wait for the missing ones.
+		 */
+		if (next == batched) {
+			batched = net_buf_alloc_batch(
+				pool, batch,
+				MIN(DIV_ROUND_UP(size, fixed->data_size),
+				    ARRAY_SIZE(batch)));
+			next = 0;
+		}
+
+		if (next < batched) {
+			new = batch[next++];
+		} else {
+			new = net_buf_alloc_fixed(pool, timeout);
+		}
+
 		if (!new) {
 			goto error;
 		}
@@ -908,6 +928,11 @@ static struct net_buf *pkt_alloc_buffer(struct net_buf_pool *pool,
 #endif
 	}
 
+	/* Left over when timing out */
+	while (next < batched) {
+		net_buf_unref(batch[next++]);
+	}
+
 	return first;
 error:
 	if (first) {
@@ -972,6 +997,11 @@ static size_t pkt_buffer_length(struct net_pkt *pkt,
 
 		max_len = MAX(max_len, NET_IPV6_MTU);
 	} else if (IS_ENABLED(CONFIG_NET_IPV4) && family == AF_INET) {
+		if (IS_ENABLED(CONFIG_NET_IPV4_FRAGMENT) && (size > max_len)) {
+			/* Reassembled packets can be larger than the MTU */
+			max_len = size;
+		}
+
 		max_len = MAX(max_len, NET_IPV4_MTU);
 	} else { /* family == AF_UNSPEC */
 #if defined (CONFIG_NET_L2_ETHERNET)
@@ -1775,6 +1805,7 @@ static void clone_pkt_attributes(struct net_pkt *pkt, struct net_pkt *clone_pkt)
 	net_pkt_set_captured(clone_pkt, net_pkt_is_captured(pkt));
 	net_pkt_set_l2_bridged(clone_pkt, net_pkt_is_l2_bridged(pkt));
 	net_pkt_set_l2_processed(clone_pkt, net_pkt_is_l2_processed(pkt));
+	net_pkt_set_ip_reassembled(clone_pkt, net_pkt_is_ip_reassembled(pkt));
 	net_pkt_set_ll_proto_type(clone_pkt, net_pkt_ll_proto_type(pkt));
 
 	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
@@ -1879,6 +1910,66 @@ struct net_pkt *net_pkt_rx_clone(struct net_pkt *pkt, k_timeout_t timeout)
 	return net_pkt_clone_internal(pkt, &rx_pkts, timeout);
 }
 
+struct net_pkt *net_pkt_rx_clone_shared(struct net_pkt *pkt,
+					k_timeout_t timeout)
+{
+	size_t cursor_offset = net_pkt_get_current_offset(pkt);
+	struct net_pkt *clone_pkt;
+	struct net_buf *buf;
+
+	for (buf = pkt->buffer; buf; buf = buf->frags) {
+		struct net_buf_pool *pool = net_buf_pool_get(buf->pool_id);
+
+		if (!pool->alloc->cb->ref ||
+		    (buf->flags & NET_BUF_EXTERNAL_DATA)) {
+			return NULL;
+		}
+	}
+
+#if NET_LOG_LEVEL >= LOG_LEVEL_DBG
+	clone_pkt = pkt_alloc(&rx_pkts, timeout, __func__, __LINE__);
+#else
+	clone_pkt = pkt_alloc(&rx_pkts, timeout);
+#endif
+	if (!clone_pkt) {
+		return NULL;
+	}
+
+	net_pkt_set_iface(clone_pkt, net_pkt_iface(pkt));
+
+	for (buf = pkt->buffer; buf; buf = buf->frags) {
+		struct net_buf *frag = net_buf_clone(buf, timeout);
+
+		if (!frag) {
+			net_pkt_unref(clone_pkt);
+			return NULL;
+		}
+
+		net_pkt_append_buffer(clone_pkt, frag);
+	}
+
+	if (clone_pkt->buffer) {
+		/* The shared data is the same, so are the link addresses */
+		memcpy(&clone_pkt->lladdr_src, &pkt->lladdr_src,
+		       sizeof(clone_pkt->lladdr_src));
+		memcpy(&clone_pkt->lladdr_dst, &pkt->lladdr_dst,
+		       sizeof(clone_pkt->lladdr_dst));
+	}
+
+	clone_pkt_attributes(pkt, clone_pkt);
+
+	net_pkt_cursor_init(clone_pkt);
+
+	if (cursor_offset) {
+		net_pkt_set_overwrite(clone_pkt, true);
+		net_pkt_skip(clone_pkt, cursor_offset);
+	}
+
+	NET_DBG("Cloned %p to %p sharing its data", pkt, clone_pkt);
+
+	return clone_pkt;
+}
+
 struct net_pkt *net_pkt_shallow_clone(struct net_pkt *pkt, k_timeout_t timeout)
 {
 	struct net_pkt *clone_pkt;
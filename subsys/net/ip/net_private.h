@@ -49,6 +49,8 @@ extern void net_if_stats_reset(struct net_if *iface);
 extern void net_if_stats_reset_all(void);
 extern void net_process_rx_packet(struct net_pkt *pkt);
 extern void net_process_tx_packet(struct net_pkt *pkt);
+extern void net_process_rx_batch(struct net_pkt *pkt, struct k_fifo *fifo);
+extern void net_process_tx_batch(struct net_pkt *pkt, struct k_fifo *fifo);
 
 #if defined(CONFIG_NET_NATIVE) || defined(CONFIG_NET_OFFLOAD)
 extern void net_context_init(void);
@@ -68,6 +70,12 @@ static inline const char *net_context_state(struct net_context *context)
 }
 #endif
 
+#if defined(CONFIG_NET_RX_POLL)
+extern void net_rx_poll_queue_init(void);
+#else
+static inline void net_rx_poll_queue_init(void) { }
+#endif
+
 #if defined(CONFIG_NET_NATIVE)
 enum net_verdict net_ipv4_input(struct net_pkt *pkt);
 enum net_verdict net_ipv6_input(struct net_pkt *pkt, bool is_loopback);
@@ -90,6 +98,7 @@ static inline enum net_verdict net_ipv6_input(struct net_pkt *pkt,
 #endif
 extern bool net_tc_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt);
 extern void net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt);
+extern void net_tc_submit_list_to_rx_queue(uint8_t tc, sys_slist_t *list);
 extern enum net_verdict net_promisc_mode_input(struct net_pkt *pkt);
 
 char *net_sprint_addr(sa_family_t af, const void *addr);
@@ -163,6 +172,37 @@ enum net_verdict net_context_packet_received(struct net_conn *conn,
 					     union net_proto_header *proto_hdr,
 					     void *user_data);
 
+struct net_nbr;
+
+/**
+ * @brief Remember the path resolved for a packet of a connected UDP context.
+ *
+ * Only packets sent to the remote of their context are considered, the
+ * path is then reused for the following packets as long as the generation
+ * of the IPv6 paths stays the same.
+ *
+ * @param pkt		Network packet, its interface being the one it leaves
+ * @param ip_hdr	Pointer to the IPv6 header of the packet
+ * @param nbr		Next hop neighbor, reachable
+ * @param gen		Generation of the IPv6 paths before resolving the path
+ */
+#if defined(CONFIG_NET_CONTEXT_PATH_CACHE)
+void net_context_path_cache_set(struct net_pkt *pkt,
+				struct net_ipv6_hdr *ip_hdr,
+				struct net_nbr *nbr, atomic_val_t gen);
+#else
+static inline void net_context_path_cache_set(struct net_pkt *pkt,
+					      struct net_ipv6_hdr *ip_hdr,
+					      struct net_nbr *nbr,
+					      atomic_val_t gen)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(ip_hdr);
+	ARG_UNUSED(nbr);
+	ARG_UNUSED(gen);
+}
+#endif /* CONFIG_NET_CONTEXT_PATH_CACHE */
+
 #if defined(CONFIG_NET_IPV4)
 extern uint16_t net_calc_chksum_ipv4(struct net_pkt *pkt);
 #endif /* CONFIG_NET_IPV4 */
@@ -0,0 +1,72 @@
+/** @file
+ * @brief Polled RX for network device drivers
+ */
+
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_core, CONFIG_NET_CORE_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+
+#include "net_private.h"
+
+#if defined(CONFIG_NET_TC_THREAD_COOPERATIVE)
+/* Highest priority cooperative thread, above the RX traffic class threads */
+#define THREAD_PRIORITY K_PRIO_COOP(0)
+#else
+#define THREAD_PRIORITY K_PRIO_PREEMPT(0)
+#endif
+
+static K_KERNEL_STACK_DEFINE(rx_poll_stack, CONFIG_NET_RX_POLL_STACK_SIZE);
+static struct k_work_q rx_poll_queue;
+
+static void rx_poll_handler(struct k_work *work)
+{
+	struct net_rx_poll *poll = CONTAINER_OF(work, struct net_rx_poll, work);
+	int count;
+
+	count = poll->cb(poll, CONFIG_NET_RX_POLL_BUDGET);
+
+	if (net_recv_data_list(poll->iface, &poll->pkts) < 0) {
+		struct net_pkt *pkt;
+
+		while ((pkt = (struct net_pkt *)sys_slist_get(&poll->pkts))) {
+			net_pkt_unref(pkt);
+		}
+	}
+
+	/* Let the other drivers go first if there is more to receive */
+	if (count >= CONFIG_NET_RX_POLL_BUDGET) {
+		(void)k_work_submit_to_queue(&rx_poll_queue, work);
+	}
+}
+
+void net_rx_poll_init(struct net_rx_poll *poll, struct net_if *iface,
+		      net_rx_poll_cb_t cb)
+{
+	k_work_init(&poll->work, rx_poll_handler);
+	sys_slist_init(&poll->pkts);
+	poll->iface = iface;
+	poll->cb = cb;
+}
+
+void net_rx_poll_schedule(struct net_rx_poll *poll)
+{
+	(void)k_work_submit_to_queue(&rx_poll_queue, &poll->work);
+}
+
+void net_rx_poll_queue_init(void)
+{
+	k_work_queue_start(&rx_poll_queue, rx_poll_stack,
+			   K_KERNEL_STACK_SIZEOF(rx_poll_stack),
+			   THREAD_PRIORITY, NULL);
+	k_thread_name_set(&rx_poll_queue.thread, "net_rx_poll");
+}
@@ -40,6 +40,10 @@ LOG_MODULE_REGISTER(net_shell, LOG_LEVEL_DBG);
 
 #include "ipv6.h"
 
+#if defined(CONFIG_NET_IP_REASSEMBLY)
+#include "reassembly.h"
+#endif
+
 #if defined(CONFIG_NET_ARP)
 #include "ethernet/arp.h"
 #endif
@@ -1557,7 +1561,7 @@ static void tcp_sent_list_cb(struct tcp *conn, void *user_data)
 #endif /* TCP */
 
 #if defined(CONFIG_NET_IPV6_FRAGMENT)
-static void ipv6_frag_cb(struct net_ipv6_reassembly *reass,
+static void ipv6_frag_cb(struct net_reass *reass,
 			 void *user_data)
 {
 	struct net_shell_user_data *data = user_data;
@@ -1571,29 +1575,16 @@ static void ipv6_frag_cb(struct net_ipv6_reassembly *reass,
 		   "Src             \tDst\n");
 	}
 
-	snprintk(src, ADDR_LEN, "%s", net_sprint_ipv6_addr(&reass->src));
+	snprintk(src, ADDR_LEN, "%s",
+		 net_sprint_ipv6_addr(&reass->src.in6_addr));
 
 	PR("%p      0x%08x  %5d %16s\t%16s\n", reass, reass->id,
 	   k_ticks_to_ms_ceil32(k_work_delayable_remaining_get(&reass->timer)),
-	   src, net_sprint_ipv6_addr(&reass->dst));
-
-	for (i = 0; i < CONFIG_NET_IPV6_FRAGMENT_MAX_PKT; i++) {
-		if (reass->pkt[i]) {
-			struct net_buf *frag = reass->pkt[i]->frags;
-
-			PR("[%d] pkt %p->", i, reass->pkt[i]);
-
-			while (frag) {
-				PR("%p", frag);
-
-				frag = frag->frags;
-				if (frag) {
-					PR("->");
-				}
-			}
+	   src, net_sprint_ipv6_addr(&reass->dst.in6_addr));
 
-			PR("\n");
-		}
+	for (i = 0; i < reass->range_count; i++) {
+		PR("[%d] bytes %u-%u\n", i, reass->ranges[i].start,
+		   reass->ranges[i].end);
 	}
 
 	(*count)++;
@@ -3306,6 +3297,24 @@ static int cmd_net_gptp(const struct shell *shell, size_t argc, char *argv[])
 		PR("\tThe local clock has expired    : %s\n",
 		   domain->state.clk_master_sync_receive.rcvd_local_clock_tick
 							       ? "yes" : "no");
+
+#if defined(CONFIG_NET_GPTP_USE_DEFAULT_CLOCK_UPDATE)
+		struct gptp_servo *servo = &domain->global_ds.servo;
+
+		PR("Local clock servo:\n");
+		PR("\tLast offset from master (ns)   : %" PRId64 "\n",
+		   servo->last_offset);
+		PR("\tMean absolute offset (ns)      : %u\n",
+		   servo->mean_abs_offset);
+		PR("\tJitter (ns)                    : %u\n", servo->jitter);
+		PR("\tFrequency correction (ppb)     : %f\n",
+		   servo->freq_ppb);
+		PR("\tSamples since clock was set    : %u\n", servo->samples);
+		PR("\tOutliers discarded             : %u\n",
+		   servo->outlier_count);
+		PR("\tTimes the clock was set        : %u\n",
+		   servo->step_count);
+#endif
 	}
 #else
 	ARG_UNUSED(argc);
@@ -8,28 +8,39 @@
 LOG_MODULE_REGISTER(net_tc, CONFIG_NET_TC_LOG_LEVEL);
 
 #include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
 #include <string.h>
 
 #include <zephyr/net/net_core.h>
 #include <zephyr/net/net_pkt.h>
 #include <zephyr/net/net_stats.h>
+#include <zephyr/net/ethernet.h>
 
 #include "net_private.h"
 #include "net_stats.h"
 #include "net_tc_mapping.h"
+#include "ipv4.h"
 
 /* Template for thread name. The "xx" is either "TX" denoting transmit thread,
  * or "RX" denoting receive thread. The "q[y]" denotes the traffic class queue
  * where y indicates the traffic class id. The value of y can be from 0 to 7.
+ * With RX steering, "q[y.zz]" denotes the zz'th RX queue of traffic class y.
  */
-#define MAX_NAME_LEN sizeof("xx_q[y]")
+#define MAX_NAME_LEN sizeof("xx_q[y.zz]")
+
+/* Number of RX queues, and threads, per traffic class */
+#if defined(CONFIG_NET_RX_STEERING)
+#define NET_RX_QUEUES CONFIG_NET_RX_STEERING_QUEUES
+#else
+#define NET_RX_QUEUES 1
+#endif
 
 /* Stacks for TX work queue */
 K_KERNEL_STACK_ARRAY_DEFINE(tx_stack, NET_TC_TX_COUNT,
 			    CONFIG_NET_TX_STACK_SIZE);
 
 /* Stacks for RX work queue */
-K_KERNEL_STACK_ARRAY_DEFINE(rx_stack, NET_TC_RX_COUNT,
+K_KERNEL_STACK_ARRAY_DEFINE(rx_stack, NET_TC_RX_COUNT * NET_RX_QUEUES,
 			    CONFIG_NET_RX_STACK_SIZE);
 
 #if NET_TC_TX_COUNT > 0
@@ -37,9 +48,168 @@ static struct net_traffic_class tx_classes[NET_TC_TX_COUNT];
 #endif
 
 #if NET_TC_RX_COUNT > 0
-static struct net_traffic_class rx_classes[NET_TC_RX_COUNT];
+/* The RX queues of traffic class tc are rx_classes[tc * NET_RX_QUEUES] to
+ * rx_classes[tc * NET_RX_QUEUES + NET_RX_QUEUES - 1].
+ */
+static struct net_traffic_class rx_classes[NET_TC_RX_COUNT * NET_RX_QUEUES];
 #endif
 
+#if defined(CONFIG_NET_RX_STEERING)
+static inline uint32_t rx_flow_mix(uint32_t hash, uint32_t val)
+{
+	return (hash ^ val) * 0x9e3779b1U;
+}
+
+static uint32_t rx_flow_mix_bytes(uint32_t hash, const uint8_t *data,
+				  size_t len)
+{
+	for (size_t i = 0; i < len; i += sizeof(uint32_t)) {
+		hash = rx_flow_mix(hash, sys_get_be32(&data[i]));
+	}
+
+	return hash;
+}
+
+/* Hash the IP addresses and, unless the packet is a fragment, the TCP or
+ * UDP ports of a received packet. The L2 header is not parsed yet at this
+ * point, so look at the raw frame. Like GRO, only the first fragment is
+ * looked at, packets having their headers split are all steered to the
+ * first queue, as are non IP packets.
+ */
+static uint32_t rx_flow_hash(struct net_pkt *pkt)
+{
+	struct net_buf *frag = pkt->frags;
+	uint16_t type = 0U;
+	size_t off = 0;
+	uint32_t hash;
+	size_t l4 = 0;
+	uint8_t *hdr;
+	size_t len;
+
+	if (frag == NULL) {
+		return 0U;
+	}
+
+	hdr = frag->data;
+	len = frag->len;
+
+#if defined(CONFIG_NET_L2_ETHERNET)
+	if (net_if_l2(net_pkt_iface(pkt)) == &NET_L2_GET_NAME(ETHERNET)) {
+		if (len < sizeof(struct net_eth_hdr)) {
+			return 0U;
+		}
+
+		type = sys_get_be16(&hdr[offsetof(struct net_eth_hdr, type)]);
+		off = sizeof(struct net_eth_hdr);
+
+		if (type == NET_ETH_PTYPE_VLAN) {
+			if (len < sizeof(struct net_eth_vlan_hdr)) {
+				return 0U;
+			}
+
+			type = sys_get_be16(
+				&hdr[offsetof(struct net_eth_vlan_hdr, type)]);
+			off = sizeof(struct net_eth_vlan_hdr);
+		}
+	} else
+#endif
+	if (len > 0) {
+		/* Other L2s hand us IP packets directly */
+		if ((hdr[0] & 0xf0) == 0x40) {
+			type = NET_ETH_PTYPE_IP;
+		} else if ((hdr[0] & 0xf0) == 0x60) {
+			type = NET_ETH_PTYPE_IPV6;
+		}
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && type == NET_ETH_PTYPE_IP) {
+		struct net_ipv4_hdr *ip;
+
+		if (len < off + sizeof(struct net_ipv4_hdr)) {
+			return 0U;
+		}
+
+		ip = (struct net_ipv4_hdr *)&hdr[off];
+		hash = rx_flow_mix_bytes(0U, ip->src, 2 * sizeof(ip->src));
+
+		/* All the fragments of a datagram go to the same queue */
+		if ((sys_get_be16(ip->offset) & 0x3fff) == 0U &&
+		    (ip->proto == IPPROTO_TCP || ip->proto == IPPROTO_UDP)) {
+			l4 = off + (ip->vhl & NET_IPV4_IHL_MASK) * 4U;
+		}
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) && type == NET_ETH_PTYPE_IPV6) {
+		struct net_ipv6_hdr *ip;
+
+		if (len < off + sizeof(struct net_ipv6_hdr)) {
+			return 0U;
+		}
+
+		ip = (struct net_ipv6_hdr *)&hdr[off];
+		hash = rx_flow_mix_bytes(0U, ip->src, 2 * sizeof(ip->src));
+
+		/* Packets having extension headers are only hashed by
+		 * address, so that fragments stay together.
+		 */
+		if (ip->nexthdr == IPPROTO_TCP || ip->nexthdr == IPPROTO_UDP) {
+			l4 = off + sizeof(struct net_ipv6_hdr);
+		}
+	} else {
+		return 0U;
+	}
+
+	/* Source and destination ports are first in both TCP and UDP */
+	if (l4 > 0 && len >= l4 + sizeof(uint32_t)) {
+		hash = rx_flow_mix(hash, sys_get_be32(&hdr[l4]));
+	}
+
+	return hash ^ (hash >> 16);
+}
+
+static uint8_t rx_flow_queue(struct net_pkt *pkt)
+{
+	int queue = net_pkt_rx_queue(pkt);
+
+	if (queue >= 0) {
+		return queue % NET_RX_QUEUES;
+	}
+
+	return ((uint64_t)rx_flow_hash(pkt) * NET_RX_QUEUES) >> 32;
+}
+
+/* Split a list of packets of one traffic class per RX queue, keeping the
+ * order of each queue's packets.
+ */
+static void rx_steer_list(uint8_t tc, sys_slist_t *list)
+{
+	sys_slist_t queues[NET_RX_QUEUES];
+	sys_snode_t *node;
+	int i;
+
+	for (i = 0; i < NET_RX_QUEUES; i++) {
+		sys_slist_init(&queues[i]);
+	}
+
+	while ((node = sys_slist_get(list)) != NULL) {
+		sys_slist_append(&queues[rx_flow_queue((struct net_pkt *)node)],
+				 node);
+	}
+
+	for (i = 0; i < NET_RX_QUEUES; i++) {
+		if (!sys_slist_is_empty(&queues[i])) {
+			k_fifo_put_slist(&rx_classes[tc * NET_RX_QUEUES + i].fifo,
+					 &queues[i]);
+		}
+	}
+}
+#else
+static inline uint8_t rx_flow_queue(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0U;
+}
+#endif /* CONFIG_NET_RX_STEERING */
+
 #if NET_TC_RX_COUNT > 0 || NET_TC_TX_COUNT > 0
 static void submit_to_queue(struct k_fifo *queue, struct net_pkt *pkt)
 {
@@ -65,13 +235,35 @@ void net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt)
 #if NET_TC_RX_COUNT > 0
 	net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
 
-	submit_to_queue(&rx_classes[tc].fifo, pkt);
+	submit_to_queue(&rx_classes[tc * NET_RX_QUEUES +
+				    rx_flow_queue(pkt)].fifo, pkt);
 #else
 	ARG_UNUSED(tc);
 	ARG_UNUSED(pkt);
 #endif
 }
 
+void net_tc_submit_list_to_rx_queue(uint8_t tc, sys_slist_t *list)
+{
+#if NET_TC_RX_COUNT > 0
+	uint32_t tick = k_cycle_get_32();
+	sys_snode_t *node;
+
+	SYS_SLIST_FOR_EACH_NODE(list, node) {
+		net_pkt_set_rx_stats_tick((struct net_pkt *)node, tick);
+	}
+
+#if defined(CONFIG_NET_RX_STEERING)
+	rx_steer_list(tc, list);
+#else
+	k_fifo_put_slist(&rx_classes[tc].fifo, list);
+#endif
+#else
+	ARG_UNUSED(tc);
+	ARG_UNUSED(list);
+#endif
+}
+
 int net_tx_priority2tc(enum net_priority prio)
 {
 #if NET_TC_TX_COUNT > 0
@@ -247,7 +439,11 @@ static void tc_rx_handler(struct k_fifo *fifo)
 			continue;
 		}
 
+#if defined(CONFIG_NET_GRO)
+		net_process_rx_batch(pkt, fifo);
+#else
 		net_process_rx_packet(pkt);
+#endif
 	}
 }
 #endif
@@ -263,7 +459,11 @@ static void tc_tx_handler(struct k_fifo *fifo)
 			continue;
 		}
 
+#if defined(CONFIG_NET_TX_BATCH)
+		net_process_tx_batch(pkt, fifo);
+#else
 		net_process_tx_packet(pkt);
+#endif
 	}
 }
 #endif
@@ -343,12 +543,13 @@ void net_tc_rx_init(void)
 	net_if_foreach(net_tc_rx_stats_priority_setup, NULL);
 #endif
 
-	for (i = 0; i < NET_TC_RX_COUNT; i++) {
+	for (i = 0; i < ARRAY_SIZE(rx_classes); i++) {
+		uint8_t tc = i / NET_RX_QUEUES;
 		uint8_t thread_priority;
 		int priority;
 		k_tid_t tid;
 
-		thread_priority = rx_tc2thread(i);
+		thread_priority = rx_tc2thread(tc);
 
 		priority = IS_ENABLED(CONFIG_NET_TC_THREAD_COOPERATIVE) ?
 			K_PRIO_COOP(thread_priority) :
@@ -378,10 +579,24 @@ void net_tc_rx_init(void)
 		if (IS_ENABLED(CONFIG_THREAD_NAME)) {
 			char name[MAX_NAME_LEN];
 
-			snprintk(name, sizeof(name), "rx_q[%d]", i);
+			if (NET_RX_QUEUES > 1) {
+				snprintk(name, sizeof(name), "rx_q[%d.%d]", tc,
+					 i % NET_RX_QUEUES);
+			} else {
+				snprintk(name, sizeof(name), "rx_q[%d]", i);
+			}
+
 			k_thread_name_set(tid, name);
 		}
 
+#if defined(CONFIG_NET_RX_STEERING) && defined(CONFIG_SCHED_CPU_MASK)
+		/* Spread the queues of each traffic class over the CPUs */
+		if (k_thread_cpu_pin(tid, (i % NET_RX_QUEUES) %
+					  CONFIG_MP_NUM_CPUS) < 0) {
+			NET_WARN("Cannot pin RX handler thread %d", i);
+		}
+#endif
+
 		k_thread_start(tid);
 	}
 #endif
@@ -0,0 +1,430 @@
+/** @file
+ * @brief IP datagram reassembly
+ */
+
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_reass, CONFIG_NET_IP_REASSEMBLY_LOG_LEVEL);
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_pkt.h>
+
+#include "net_private.h"
+#include "reassembly.h"
+
+/* Timeout for the allocation of the reassembled packet */
+#define REASS_BUF_TIMEOUT K_MSEC(50)
+
+static inline bool reass_in_use(struct net_reass *reass)
+{
+	return k_work_delayable_remaining_get(&reass->timer) != 0;
+}
+
+static bool addr_cmp(const struct net_addr *a, const struct net_addr *b)
+{
+	if (a->family != b->family) {
+		return false;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && a->family == AF_INET6) {
+		return net_ipv6_addr_cmp(&a->in6_addr, &b->in6_addr);
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && a->family == AF_INET) {
+		return net_ipv4_addr_cmp(&a->in_addr, &b->in_addr);
+	}
+
+	return false;
+}
+
+static void reass_release(struct net_reass *reass)
+{
+	NET_DBG("Release %p id 0x%x", reass, reass->id);
+
+	k_work_cancel_delayable(&reass->timer);
+
+	reass->id = 0U;
+	reass->iface = NULL;
+	reass->hdr_len = 0U;
+	reass->len = 0U;
+	reass->range_count = 0U;
+}
+
+static void reass_timeout(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct net_reass *reass = CONTAINER_OF(dwork, struct net_reass, timer);
+	struct net_reass_table *table = reass->table;
+
+	k_mutex_lock(table->lock, K_FOREVER);
+
+	/* The slot might have been reused while we were waiting */
+	if (!reass_in_use(reass) && reass->iface) {
+		NET_DBG("Reassembly %p id 0x%x timed out", reass, reass->id);
+
+		if (table->expired) {
+			table->expired(reass);
+		}
+
+		reass_release(reass);
+	}
+
+	k_mutex_unlock(table->lock);
+}
+
+static void table_init(struct net_reass_table *table)
+{
+	int i;
+
+	for (i = 0; i < table->count; i++) {
+		struct net_reass *reass = &table->slots[i];
+
+		k_work_init_delayable(&reass->timer, reass_timeout);
+		reass->table = table;
+		reass->ranges = &table->ranges[i * table->max_ranges];
+		reass->buf = &table->bufs[i * (table->hdr_max + table->max_len)];
+	}
+
+	table->init_done = true;
+}
+
+static struct net_reass *reass_get(struct net_reass_table *table,
+				   const struct net_addr *src,
+				   const struct net_addr *dst, uint32_t id)
+{
+	struct net_reass *avail = NULL, *oldest = NULL, *src_oldest = NULL;
+	struct net_reass *reass;
+	int src_count = 0;
+	int i;
+
+	for (i = 0; i < table->count; i++) {
+		reass = &table->slots[i];
+
+		if (!reass_in_use(reass)) {
+			if (!avail) {
+				avail = reass;
+			}
+
+			continue;
+		}
+
+		if (reass->id == id && addr_cmp(src, &reass->src) &&
+		    addr_cmp(dst, &reass->dst)) {
+			return reass;
+		}
+
+		if (!oldest || k_work_delayable_remaining_get(&reass->timer) <
+			       k_work_delayable_remaining_get(&oldest->timer)) {
+			oldest = reass;
+		}
+
+		if (!addr_cmp(src, &reass->src)) {
+			continue;
+		}
+
+		src_count++;
+
+		if (!src_oldest ||
+		    k_work_delayable_remaining_get(&reass->timer) <
+		    k_work_delayable_remaining_get(&src_oldest->timer)) {
+			src_oldest = reass;
+		}
+	}
+
+	/* Evict early rather than dropping the new datagram: when a source
+	 * holds too many slots it gives up its own oldest one, otherwise the
+	 * one closest to timing out goes.
+	 */
+	if (src_count >= CONFIG_NET_IP_REASSEMBLY_MAX_PER_SRC) {
+		avail = src_oldest;
+	} else if (!avail) {
+		avail = oldest;
+	}
+
+	if (!avail) {
+		return NULL;
+	}
+
+	if (reass_in_use(avail)) {
+		NET_DBG("Evicting %p id 0x%x", avail, avail->id);
+	}
+
+	/* The slot might also have timed out without its timeout handler
+	 * having run yet, start from a clean one.
+	 */
+	reass_release(avail);
+
+	k_work_reschedule(&avail->timer, table->timeout);
+
+	memcpy(&avail->src, src, sizeof(avail->src));
+	memcpy(&avail->dst, dst, sizeof(avail->dst));
+	avail->id = id;
+
+	return avail;
+}
+
+/* Add [start, end) to the ranges received, merging it with the ranges it
+ * touches. Nothing is changed on error.
+ */
+static int range_add(struct net_reass *reass, uint16_t start, uint16_t end)
+{
+	struct net_reass_range *ranges = reass->ranges;
+	int count = reass->range_count;
+	int i, j;
+
+	for (i = 0; i < count && ranges[i].end < start; i++) {
+	}
+
+	for (j = i; j < count && ranges[j].start <= end; j++) {
+		if (reass->table->reject_overlap &&
+		    ranges[j].start < end && ranges[j].end > start) {
+			return -EBADMSG;
+		}
+
+		start = MIN(start, ranges[j].start);
+		end = MAX(end, ranges[j].end);
+	}
+
+	if (i == j) {
+		if (count == reass->table->max_ranges) {
+			return -ENOMEM;
+		}
+
+		memmove(&ranges[i + 1], &ranges[i],
+			(count - i) * sizeof(ranges[0]));
+		reass->range_count++;
+	} else {
+		/* Ranges i to j - 1 are merged into the ith one */
+		memmove(&ranges[i + 1], &ranges[j],
+			(count - j) * sizeof(ranges[0]));
+		reass->range_count -= j - i - 1;
+	}
+
+	ranges[i].start = start;
+	ranges[i].end = end;
+
+	return 0;
+}
+
+static inline bool reass_complete(struct net_reass *reass)
+{
+	return reass->hdr_len && reass->len && reass->range_count == 1U &&
+		reass->ranges[0].start == 0U &&
+		reass->ranges[0].end == reass->len;
+}
+
+struct net_pkt *net_reass_pkt(struct net_reass *reass, uint16_t len)
+{
+	struct net_linkaddr_storage *ll_src = &reass->lladdr_src;
+	struct net_linkaddr_storage *ll_dst = &reass->lladdr_dst;
+	struct net_pkt *pkt;
+
+	if (!reass->hdr_len || !reass->range_count ||
+	    reass->ranges[0].start != 0U || len > reass->ranges[0].end) {
+		return NULL;
+	}
+
+	pkt = net_pkt_rx_alloc_with_buffer(reass->iface,
+					   ll_src->len + ll_dst->len +
+					   reass->hdr_len + len,
+					   reass->src.family, 0,
+					   REASS_BUF_TIMEOUT);
+	if (!pkt) {
+		return NULL;
+	}
+
+	/* Keep the link layer addresses in the headroom of the packet, as
+	 * the slot is reused while the packet is being processed.
+	 */
+	if (net_pkt_write(pkt, ll_src->addr, ll_src->len) ||
+	    net_pkt_write(pkt, ll_dst->addr, ll_dst->len) ||
+	    net_pkt_write(pkt, reass->buf, reass->hdr_len) ||
+	    net_pkt_write(pkt, reass->buf + reass->table->hdr_max, len)) {
+		net_pkt_unref(pkt);
+		return NULL;
+	}
+
+	net_pkt_lladdr_src(pkt)->addr = pkt->buffer->data;
+	net_pkt_lladdr_src(pkt)->len = ll_src->len;
+	net_pkt_lladdr_src(pkt)->type = ll_src->type;
+	net_pkt_lladdr_dst(pkt)->addr = pkt->buffer->data + ll_src->len;
+	net_pkt_lladdr_dst(pkt)->len = ll_dst->len;
+	net_pkt_lladdr_dst(pkt)->type = ll_dst->type;
+
+	net_buf_pull(pkt->buffer, ll_src->len + ll_dst->len);
+	net_pkt_cursor_init(pkt);
+
+	net_pkt_set_ip_reassembled(pkt, true);
+
+	return pkt;
+}
+
+static int reass_save_hdr(struct net_reass *reass, struct net_pkt *pkt)
+{
+	struct net_linkaddr *lladdr;
+	struct net_pkt_cursor backup;
+	int ret;
+
+	net_pkt_cursor_backup(pkt, &backup);
+	net_pkt_cursor_init(pkt);
+
+	ret = reass->table->save_hdr(reass, pkt, reass->buf);
+
+	net_pkt_cursor_restore(pkt, &backup);
+
+	if (ret <= 0 || ret > reass->table->hdr_max) {
+		return -EINVAL;
+	}
+
+	reass->hdr_len = ret;
+
+	lladdr = net_pkt_lladdr_src(pkt);
+	if (!lladdr->addr || net_linkaddr_set(&reass->lladdr_src, lladdr->addr,
+					      lladdr->len)) {
+		reass->lladdr_src.len = 0U;
+	}
+
+	reass->lladdr_src.type = lladdr->type;
+
+	lladdr = net_pkt_lladdr_dst(pkt);
+	if (!lladdr->addr || net_linkaddr_set(&reass->lladdr_dst, lladdr->addr,
+					      lladdr->len)) {
+		reass->lladdr_dst.len = 0U;
+	}
+
+	reass->lladdr_dst.type = lladdr->type;
+
+	return 0;
+}
+
+int net_reass_input(struct net_reass_table *table,
+		    const struct net_addr *src, const struct net_addr *dst,
+		    uint32_t id, struct net_pkt *pkt, uint16_t offset,
+		    bool more)
+{
+	size_t len = net_pkt_remaining_data(pkt);
+	uint32_t end = (uint32_t)offset + len;
+	struct net_pkt *reassembled = NULL;
+	struct net_reass *reass;
+	int ret;
+
+	k_mutex_lock(table->lock, K_FOREVER);
+
+	if (!table->init_done) {
+		table_init(table);
+	}
+
+	reass = reass_get(table, src, dst, id);
+	if (!reass) {
+		NET_DBG("Cannot get reassembly slot, dropping pkt %p", pkt);
+		ret = -ENOMEM;
+		goto out;
+	}
+
+	if (!reass->iface) {
+		reass->iface = net_pkt_iface(pkt);
+	}
+
+	if (end > table->max_len || (reass->len && end > reass->len)) {
+		NET_DBG("Datagram 0x%x too long (%u bytes)", id, end);
+		ret = -EMSGSIZE;
+		goto cancel;
+	}
+
+	if (!more) {
+		/* The last fragment tells the length of the datagram */
+		if ((reass->len && reass->len != end) ||
+		    (reass->range_count &&
+		     reass->ranges[reass->range_count - 1].end > end)) {
+			ret = -EBADMSG;
+			goto cancel;
+		}
+
+		reass->len = end;
+	}
+
+	if (len) {
+		ret = range_add(reass, offset, end);
+		if (ret < 0) {
+			NET_DBG("Cannot add %u-%u to 0x%x (%d)", offset, end,
+				id, ret);
+			goto cancel;
+		}
+
+		ret = net_pkt_read(pkt, reass->buf + table->hdr_max + offset,
+				   len);
+		if (ret < 0) {
+			goto cancel;
+		}
+	}
+
+	if (offset == 0U && !reass->hdr_len) {
+		ret = reass_save_hdr(reass, pkt);
+		if (ret < 0) {
+			goto cancel;
+		}
+	}
+
+	if (!reass_complete(reass)) {
+		NET_DBG("Reassembly %p id 0x%x, %u ranges pending", reass, id,
+			reass->range_count);
+		ret = 0;
+		goto out;
+	}
+
+	table->finish_hdr(reass, reass->buf);
+
+	reassembled = net_reass_pkt(reass, reass->len);
+	if (!reassembled) {
+		ret = -ENOMEM;
+		goto cancel;
+	}
+
+	NET_DBG("Reassembled pkt %p id 0x%x, %u bytes payload", reassembled,
+		id, reass->len);
+
+	ret = 0;
+
+cancel:
+	reass_release(reass);
+out:
+	k_mutex_unlock(table->lock);
+
+	if (reassembled) {
+		/* We need to use the queue when feeding the packet back into
+		 * the IP stack as we might run out of stack if we process it
+		 * directly. As the packet does not contain link layer header,
+		 * it is not passed to L2 again, see process_data().
+		 */
+		if (net_recv_data(net_pkt_iface(reassembled), reassembled) < 0) {
+			net_pkt_unref(reassembled);
+		}
+	}
+
+	return ret;
+}
+
+void net_reass_foreach(struct net_reass_table *table, net_reass_cb_t cb,
+		       void *user_data)
+{
+	int i;
+
+	k_mutex_lock(table->lock, K_FOREVER);
+
+	for (i = 0; table->init_done && i < table->count; i++) {
+		if (!reass_in_use(&table->slots[i])) {
+			continue;
+		}
+
+		cb(&table->slots[i], user_data);
+	}
+
+	k_mutex_unlock(table->lock);
+}
@@ -0,0 +1,250 @@
+/** @file
+ * @brief IP datagram reassembly
+ *
+ * This is not to be included by the application.
+ */
+
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __REASSEMBLY_H
+#define __REASSEMBLY_H
+
+#include <zephyr/kernel.h>
+#include <zephyr/types.h>
+
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/net_linkaddr.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct net_reass_table;
+
+/**
+ * @brief Block of contiguous payload data received for a datagram.
+ */
+struct net_reass_range {
+	/** Offset of the first byte */
+	uint16_t start;
+
+	/** Offset following the last byte */
+	uint16_t end;
+};
+
+/**
+ * @brief Datagram being reassembled.
+ *
+ * The fragments are copied into the buffer of the slot as they arrive, the
+ * unfragmentable headers of the first fragment at its start, the payload
+ * after them at its offset in the datagram. The ranges of payload received
+ * are kept sorted and merged, so a datagram received in order only ever
+ * uses one of them.
+ */
+struct net_reass {
+	/**
+	 * Timeout for cancelling the reassembly. The timer is used
+	 * also to detect if this reassembly slot is used or not.
+	 */
+	struct k_work_delayable timer;
+
+	/** Table the slot belongs to */
+	struct net_reass_table *table;
+
+	/** Source address of the fragments */
+	struct net_addr src;
+
+	/** Destination address of the fragments */
+	struct net_addr dst;
+
+	/** Interface the fragments are received on */
+	struct net_if *iface;
+
+	/** Link layer addresses of the first fragment */
+	struct net_linkaddr_storage lladdr_src;
+	struct net_linkaddr_storage lladdr_dst;
+
+	/** Payload ranges received, ordered by offset */
+	struct net_reass_range *ranges;
+
+	/** Headers followed by the payload */
+	uint8_t *buf;
+
+	/** Fragment identification */
+	uint32_t id;
+
+	/** Length of the headers, 0 until the first fragment is received */
+	uint16_t hdr_len;
+
+	/** Length of the payload, 0 until the last fragment is received */
+	uint16_t len;
+
+	/** Number of ranges in use */
+	uint8_t range_count;
+};
+
+/**
+ * @brief Set of reassembly slots used by one protocol family.
+ */
+struct net_reass_table {
+	/** Reassembly slots */
+	struct net_reass *slots;
+
+	/** Storage of the ranges, max_ranges per slot */
+	struct net_reass_range *ranges;
+
+	/** Storage of the buffers, hdr_max + max_len bytes per slot */
+	uint8_t *bufs;
+
+	/**
+	 * Copy the headers of the first fragment, cursor at its start,
+	 * to hdr, at most hdr_max bytes. The headers are to be stored
+	 * as they shall appear in the reassembled datagram.
+	 *
+	 * @return Length of the headers, negative errno otherwise.
+	 */
+	int (*save_hdr)(struct net_reass *reass, struct net_pkt *pkt,
+			uint8_t *hdr);
+
+	/** Update the headers once the payload length is known */
+	void (*finish_hdr)(struct net_reass *reass, uint8_t *hdr);
+
+	/** Called when a reassembly times out, before it is released */
+	void (*expired)(struct net_reass *reass);
+
+	/** Time allowed to receive all the fragments */
+	k_timeout_t timeout;
+
+	/** Mutex protecting the slots */
+	struct k_mutex *lock;
+
+	/** Number of slots */
+	uint8_t count;
+
+	/** Maximum number of disjoint payload ranges pending per slot */
+	uint8_t max_ranges;
+
+	/** Drop the datagram if fragments overlap, RFC 5722 */
+	bool reject_overlap;
+
+	/** Maximum length of the headers */
+	uint16_t hdr_max;
+
+	/** Maximum length of the payload */
+	uint16_t max_len;
+
+	/** Have the timers been initialized */
+	bool init_done;
+};
+
+/**
+ * @brief Statically define a reassembly table.
+ *
+ * @param _name Name of the table.
+ * @param _count Number of datagrams reassembled simultaneously.
+ * @param _max_ranges Maximum number of disjoint payload ranges pending.
+ * @param _hdr_max Maximum length of the headers.
+ * @param _max_len Maximum length of the payload.
+ * @param _timeout Time allowed to receive all the fragments.
+ * @param _reject_overlap Drop datagrams with overlapping fragments.
+ * @param _save_hdr Routine storing the headers of the first fragment.
+ * @param _finish_hdr Routine updating the headers when complete.
+ * @param _expired Routine called when a reassembly times out, or NULL.
+ */
+#define NET_REASS_TABLE_DEFINE(_name, _count, _max_ranges, _hdr_max,	\
+			       _max_len, _timeout, _reject_overlap,	\
+			       _save_hdr, _finish_hdr, _expired)	\
+	static K_MUTEX_DEFINE(_name##_lock);				\
+	static struct net_reass _name##_slots[_count];			\
+	static struct net_reass_range					\
+		_name##_ranges[(_count) * (_max_ranges)];		\
+	static uint8_t __aligned(4)					\
+		_name##_bufs[(_count) * ((_hdr_max) + (_max_len))];	\
+	static struct net_reass_table _name = {				\
+		.slots = _name##_slots,					\
+		.ranges = _name##_ranges,				\
+		.bufs = _name##_bufs,					\
+		.save_hdr = _save_hdr,					\
+		.finish_hdr = _finish_hdr,				\
+		.expired = _expired,					\
+		.timeout = _timeout,					\
+		.lock = &_name##_lock,					\
+		.count = _count,					\
+		.max_ranges = _max_ranges,				\
+		.reject_overlap = _reject_overlap,			\
+		.hdr_max = _hdr_max,					\
+		.max_len = _max_len,					\
+	}
+
+/**
+ * @brief Add a fragment to the datagram it belongs to.
+ *
+ * The payload of the fragment, from the cursor of @a pkt onwards, is copied
+ * to the reassembly slot of the datagram, allocated if needed. Once all the
+ * fragments are received, the datagram is passed to the IP stack again with
+ * net_recv_data(). The caller keeps the ownership of @a pkt.
+ *
+ * When all the slots are in use, the reassembly closest to timing out is
+ * given up to make room for the new one. A source can only hold up to
+ * @kconfig{CONFIG_NET_IP_REASSEMBLY_MAX_PER_SRC} slots, its own oldest
+ * reassembly is given up beyond that.
+ *
+ * @param table Reassembly table of the protocol family.
+ * @param src Source address of the fragment.
+ * @param dst Destination address of the fragment.
+ * @param id Fragment identification.
+ * @param pkt Fragment, the cursor being at the start of the payload.
+ * @param offset Offset of the payload in the datagram.
+ * @param more More fragments follow this one.
+ *
+ * @return 0 if the fragment was stored, negative errno otherwise in which
+ * case the whole datagram is dropped.
+ */
+int net_reass_input(struct net_reass_table *table,
+		    const struct net_addr *src, const struct net_addr *dst,
+		    uint32_t id, struct net_pkt *pkt, uint16_t offset,
+		    bool more);
+
+/**
+ * @brief Build a packet holding the headers and the start of the payload.
+ *
+ * Meant to quote the datagram in ICMP errors, from the expired routine.
+ *
+ * @param reass Reassembly slot.
+ * @param len Length of the payload to copy, at most the end of the first
+ * range received.
+ *
+ * @return Network packet, NULL if the first fragment was not received or
+ * no packet could be allocated.
+ */
+struct net_pkt *net_reass_pkt(struct net_reass *reass, uint16_t len);
+
+/**
+ * @typedef net_reass_cb_t
+ * @brief Callback used while iterating over pending reassemblies.
+ *
+ * @param reass Reassembly slot.
+ * @param user_data A valid pointer on some user data or NULL
+ */
+typedef void (*net_reass_cb_t)(struct net_reass *reass, void *user_data);
+
+/**
+ * @brief Go through all the pending reassemblies of a table.
+ *
+ * @param table Reassembly table.
+ * @param cb Callback to call for each pending reassembly.
+ * @param user_data User specified data or NULL.
+ */
+void net_reass_foreach(struct net_reass_table *table, net_reass_cb_t cb,
+		       void *user_data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __REASSEMBLY_H */
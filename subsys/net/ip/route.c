@@ -14,8 +14,10 @@ LOG_MODULE_REGISTER(net_route, CONFIG_NET_ROUTE_LOG_LEVEL);
 
 #include <zephyr/kernel.h>
 #include <limits.h>
+#include <string.h>
 #include <zephyr/types.h>
 #include <zephyr/sys/slist.h>
+#include <zephyr/sys/dlist.h>
 
 #include <zephyr/net/net_pkt.h>
 #include <zephyr/net/net_core.h>
@@ -36,7 +38,7 @@ LOG_MODULE_REGISTER(net_route, CONFIG_NET_ROUTE_LOG_LEVEL);
 /* We keep track of the routes in a separate list so that we can remove
  * the oldest routes (at tail) if needed.
  */
-static sys_slist_t routes;
+static sys_dlist_t routes = SYS_DLIST_STATIC_INIT(&routes);
 
 /* Track currently active route lifetime timers */
 static sys_slist_t active_route_lifetime_timers;
@@ -276,19 +278,293 @@ static int nbr_nexthop_put(struct net_nbr *nbr)
 /* Route was accessed, so place it in front of the routes list */
 static inline void update_route_access(struct net_route_entry *route)
 {
-	sys_slist_find_and_remove(&routes, &route->node);
-	sys_slist_prepend(&routes, &route->node);
+	sys_dlist_remove(&route->node);
+	sys_dlist_prepend(&routes, &route->node);
 }
 
-struct net_route_entry *net_route_lookup(struct net_if *iface,
-					 struct in6_addr *dst)
+#if defined(CONFIG_NET_ROUTE_TRIE)
+/* The routes are indexed by prefix in a path compressed binary trie. The
+ * children of a node hold longer prefixes, split on the bit following the
+ * prefix of the node. Nodes without routes only exist where two subtries
+ * branch, so the trie never needs more than two nodes per route.
+ */
+struct route_trie_node {
+	struct route_trie_node *parent;
+	struct route_trie_node *child[2];
+
+	/* Routes having this prefix, on different interfaces */
+	sys_slist_t routes;
+
+	struct in6_addr prefix;
+	uint8_t len;
+	bool in_use;
+};
+
+static struct route_trie_node trie_nodes[2 * CONFIG_NET_MAX_ROUTES];
+static struct route_trie_node *trie_root;
+
+static inline int addr_bit(const struct in6_addr *addr, uint8_t bit)
+{
+	return (addr->s6_addr[bit / 8] >> (7 - bit % 8)) & 1;
+}
+
+/* Length of the common prefix of two addresses, at most max_len */
+static uint8_t common_prefix_len(const struct in6_addr *a,
+				 const struct in6_addr *b, uint8_t max_len)
+{
+	uint8_t len = 0U;
+	int i;
+
+	for (i = 0; i < sizeof(struct in6_addr) && len < max_len; i++) {
+		uint8_t diff = a->s6_addr[i] ^ b->s6_addr[i];
+
+		if (diff) {
+			while (!(diff & 0x80)) {
+				diff <<= 1;
+				len++;
+			}
+
+			break;
+		}
+
+		len += 8U;
+	}
+
+	return MIN(len, max_len);
+}
+
+static struct route_trie_node *trie_node_new(const struct in6_addr *prefix,
+					     uint8_t len)
+{
+	struct route_trie_node *node;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(trie_nodes); i++) {
+		node = &trie_nodes[i];
+
+		if (node->in_use) {
+			continue;
+		}
+
+		memset(node, 0, sizeof(*node));
+		node->in_use = true;
+		node->len = len;
+
+		/* Only keep the prefix bits */
+		memcpy(node->prefix.s6_addr, prefix->s6_addr, len / 8U);
+		if (len % 8U) {
+			node->prefix.s6_addr[len / 8U] = prefix->s6_addr[len / 8U] &
+				(uint8_t)(0xff << (8U - len % 8U));
+		}
+
+		return node;
+	}
+
+	return NULL;
+}
+
+/* Replace the link from the parent of old to old by a link to new */
+static void trie_relink(struct route_trie_node *old,
+			struct route_trie_node *new)
+{
+	struct route_trie_node *parent = old->parent;
+
+	if (!parent) {
+		trie_root = new;
+	} else {
+		parent->child[parent->child[1] == old] = new;
+	}
+
+	if (new) {
+		new->parent = parent;
+	}
+}
+
+/* Find or create the node of a prefix */
+static struct route_trie_node *trie_insert(const struct in6_addr *prefix,
+					   uint8_t len)
+{
+	struct route_trie_node *parent = NULL, *node = trie_root;
+	struct route_trie_node *branch, *leaf;
+	uint8_t common;
+
+	while (node) {
+		common = common_prefix_len(prefix, &node->prefix,
+					   MIN(len, node->len));
+		if (common < node->len) {
+			break;
+		}
+
+		if (node->len == len) {
+			return node;
+		}
+
+		parent = node;
+		node = node->child[addr_bit(prefix, node->len)];
+	}
+
+	leaf = trie_node_new(prefix, len);
+	if (!leaf) {
+		return NULL;
+	}
+
+	if (!node) {
+		/* Empty spot below parent */
+		leaf->parent = parent;
+
+		if (!parent) {
+			trie_root = leaf;
+		} else {
+			parent->child[addr_bit(prefix, parent->len)] = leaf;
+		}
+
+		return leaf;
+	}
+
+	if (common == len) {
+		/* The new prefix sits between parent and node */
+		trie_relink(node, leaf);
+		leaf->child[addr_bit(&node->prefix, len)] = node;
+		node->parent = leaf;
+
+		return leaf;
+	}
+
+	/* The prefixes diverge, add a node where they branch */
+	branch = trie_node_new(prefix, common);
+	if (!branch) {
+		leaf->in_use = false;
+		return NULL;
+	}
+
+	trie_relink(node, branch);
+	branch->child[addr_bit(&node->prefix, common)] = node;
+	branch->child[addr_bit(prefix, common)] = leaf;
+	node->parent = branch;
+	leaf->parent = branch;
+
+	return leaf;
+}
+
+/* Remove nodes which are neither holding routes nor branching anymore */
+static void trie_prune(struct route_trie_node *node)
+{
+	struct route_trie_node *child;
+
+	while (node && sys_slist_is_empty(&node->routes) &&
+	       !(node->child[0] && node->child[1])) {
+		child = node->child[0] ? node->child[0] : node->child[1];
+
+		trie_relink(node, child);
+		node->in_use = false;
+
+		/* The parent lost a child only if there was none to take
+		 * the place of the node.
+		 */
+		node = child ? NULL : node->parent;
+	}
+}
+
+static int trie_add_route(struct net_route_entry *route)
+{
+	struct route_trie_node *node;
+
+	node = trie_insert(&route->addr, route->prefix_len);
+	if (!node) {
+		return -ENOMEM;
+	}
+
+	sys_slist_append(&node->routes, &route->prefix_node);
+	route->trie = node;
+
+	return 0;
+}
+
+static void trie_del_route(struct net_route_entry *route)
+{
+	struct route_trie_node *node = route->trie;
+
+	if (!node) {
+		return;
+	}
+
+	sys_slist_find_and_remove(&node->routes, &route->prefix_node);
+	route->trie = NULL;
+
+	trie_prune(node);
+}
+
+/* Walk down the trie along dst, remembering the deepest route found */
+static struct net_route_entry *trie_lookup(struct net_if *iface,
+					   struct in6_addr *dst)
+{
+	struct route_trie_node *node = trie_root;
+	struct net_route_entry *route, *found = NULL;
+
+	while (node && common_prefix_len(dst, &node->prefix,
+					 node->len) == node->len) {
+		SYS_SLIST_FOR_EACH_CONTAINER(&node->routes, route,
+					     prefix_node) {
+			if (!iface || route->iface == iface) {
+				found = route;
+				break;
+			}
+		}
+
+		if (node->len == 128U) {
+			break;
+		}
+
+		node = node->child[addr_bit(dst, node->len)];
+	}
+
+	return found;
+}
+#endif /* CONFIG_NET_ROUTE_TRIE */
+
+/* The interface identifier varies the most between destinations */
+static inline uint32_t addr_hash(struct in6_addr *addr)
+{
+	uint32_t hash = UNALIGNED_GET(&addr->s6_addr32[2]) ^
+			UNALIGNED_GET(&addr->s6_addr32[3]);
+
+	return hash ^ (hash >> 16);
+}
+
+#if CONFIG_NET_ROUTE_CACHE_SIZE > 0
+struct route_cache_entry {
+	struct in6_addr dst;
+	struct net_if *iface;
+	struct net_route_entry *route;
+};
+
+static struct route_cache_entry route_cache[CONFIG_NET_ROUTE_CACHE_SIZE];
+
+static inline struct route_cache_entry *route_cache_slot(struct in6_addr *dst)
+{
+	return &route_cache[addr_hash(dst) % CONFIG_NET_ROUTE_CACHE_SIZE];
+}
+
+static inline void route_cache_flush(void)
+{
+	memset(route_cache, 0, sizeof(route_cache));
+	net_ipv6_path_changed();
+}
+#else
+static inline void route_cache_flush(void)
+{
+	net_ipv6_path_changed();
+}
+#endif /* CONFIG_NET_ROUTE_CACHE_SIZE > 0 */
+
+#if !defined(CONFIG_NET_ROUTE_TRIE)
+static struct net_route_entry *table_lookup(struct net_if *iface,
+					    struct in6_addr *dst)
 {
 	struct net_route_entry *route, *found = NULL;
 	uint8_t longest_match = 0U;
 	int i;
 
-	k_mutex_lock(&lock, K_FOREVER);
-
 	for (i = 0; i < CONFIG_NET_MAX_ROUTES && longest_match < 128; i++) {
 		struct net_nbr *nbr = get_nbr(i);
 
@@ -311,6 +587,43 @@ struct net_route_entry *net_route_lookup(struct net_if *iface,
 		}
 	}
 
+	return found;
+}
+#endif /* !CONFIG_NET_ROUTE_TRIE */
+
+struct net_route_entry *net_route_lookup(struct net_if *iface,
+					 struct in6_addr *dst)
+{
+	struct net_route_entry *found;
+#if CONFIG_NET_ROUTE_CACHE_SIZE > 0
+	struct route_cache_entry *slot = route_cache_slot(dst);
+#endif
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+#if CONFIG_NET_ROUTE_CACHE_SIZE > 0
+	if (slot->route && slot->iface == iface &&
+	    net_ipv6_addr_cmp(&slot->dst, dst)) {
+		found = slot->route;
+		goto out;
+	}
+#endif
+
+#if defined(CONFIG_NET_ROUTE_TRIE)
+	found = trie_lookup(iface, dst);
+#else
+	found = table_lookup(iface, dst);
+#endif
+
+#if CONFIG_NET_ROUTE_CACHE_SIZE > 0
+	if (found) {
+		net_ipaddr_copy(&slot->dst, dst);
+		slot->iface = iface;
+		slot->route = found;
+	}
+
+out:
+#endif
 	if (found) {
 		net_route_info("Found", found, dst);
 
@@ -408,9 +721,9 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 	nbr = nbr_new(iface, addr, prefix_len);
 	if (!nbr) {
 		/* Remove the oldest route and try again */
-		sys_snode_t *last = sys_slist_peek_tail(&routes);
+		sys_dnode_t *last = sys_dlist_peek_tail(&routes);
 
-		sys_slist_find_and_remove(&routes, last);
+		sys_dlist_remove(last);
 
 		route = CONTAINER_OF(last,
 				     struct net_route_entry,
@@ -459,7 +772,19 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 
 	net_route_update_lifetime(route, lifetime);
 
-	sys_slist_prepend(&routes, &route->node);
+#if defined(CONFIG_NET_ROUTE_TRIE)
+	if (trie_add_route(route) < 0) {
+		NET_ERR("No trie node available!");
+		release_nexthop_route(nexthop_route);
+		nbr_free(nbr);
+		route = NULL;
+		goto exit;
+	}
+#endif
+
+	route_cache_flush();
+
+	sys_dlist_prepend(&routes, &route->node);
 
 	tmp = nbr_nexthop_get(iface, nexthop);
 
@@ -601,7 +926,15 @@ int net_route_del(struct net_route_entry *route)
 		}
 	}
 
-	sys_slist_find_and_remove(&routes, &route->node);
+	if (sys_dnode_is_linked(&route->node)) {
+		sys_dlist_remove(&route->node);
+	}
+
+#if defined(CONFIG_NET_ROUTE_TRIE)
+	trie_del_route(route);
+#endif
+
+	route_cache_flush();
 
 	nbr = net_route_get_nbr(route);
 	if (!nbr) {
@@ -1001,28 +1334,15 @@ exit:
 	return ret;
 }
 
-int net_route_packet(struct net_pkt *pkt, struct in6_addr *nexthop)
+/* Set the packet up to be sent to the neighbor */
+static int route_packet_nbr(struct net_pkt *pkt, struct net_nbr *nbr)
 {
 	struct net_linkaddr_storage *lladdr;
-	struct net_nbr *nbr;
-	int err;
-
-	k_mutex_lock(&lock, K_FOREVER);
-
-	nbr = net_ipv6_nbr_lookup(NULL, nexthop);
-	if (!nbr) {
-		NET_DBG("Cannot find %s neighbor",
-			net_sprint_ipv6_addr(nexthop));
-		err = -ENOENT;
-		goto error;
-	}
 
 	lladdr = net_nbr_get_lladdr(nbr->idx);
 	if (!lladdr) {
-		NET_DBG("Cannot find %s neighbor link layer address.",
-			net_sprint_ipv6_addr(nexthop));
-		err = -ESRCH;
-		goto error;
+		NET_DBG("Cannot find neighbor %p link layer address.", nbr);
+		return -ESRCH;
 	}
 
 #if defined(CONFIG_NET_L2_DUMMY)
@@ -1038,8 +1358,7 @@ int net_route_packet(struct net_pkt *pkt, struct in6_addr *nexthop)
 #endif
 			if (!net_pkt_lladdr_src(pkt)->addr) {
 				NET_DBG("Link layer source address not set");
-				err = -EINVAL;
-				goto error;
+				return -EINVAL;
 			}
 
 			/* Sanitycheck: If src and dst ll addresses are going
@@ -1049,8 +1368,7 @@ int net_route_packet(struct net_pkt *pkt, struct in6_addr *nexthop)
 			if (!memcmp(net_pkt_lladdr_src(pkt)->addr, lladdr->addr,
 				    lladdr->len)) {
 				NET_ERR("Src ll and Dst ll are same");
-				err = -EINVAL;
-				goto error;
+				return -EINVAL;
 			}
 #if defined(CONFIG_NET_L2_PPP)
 		}
@@ -1074,6 +1392,104 @@ int net_route_packet(struct net_pkt *pkt, struct in6_addr *nexthop)
 
 	net_pkt_set_iface(pkt, nbr->iface);
 
+	return 0;
+}
+
+#if defined(CONFIG_NET_ROUTE_FLOW_CACHE)
+/* Next hop of the last flows forwarded. An entry is valid as long as its
+ * generation is the current one of the IPv6 paths, so that flushing the
+ * cache does not need to take the routing lock.
+ */
+struct route_flow {
+	struct in6_addr dst;
+	struct net_if *iface;
+	struct net_nbr *nbr;
+	atomic_val_t gen;
+};
+
+static struct route_flow flows[CONFIG_NET_ROUTE_FLOW_CACHE_SIZE];
+
+static inline struct route_flow *flow_slot(struct net_if *iface,
+					   struct in6_addr *dst)
+{
+	uint32_t hash = addr_hash(dst) ^ (uint32_t)(uintptr_t)iface;
+
+	return &flows[hash % CONFIG_NET_ROUTE_FLOW_CACHE_SIZE];
+}
+
+int net_route_flow_packet(struct net_pkt *pkt, struct in6_addr *dst)
+{
+	struct net_if *iface = net_pkt_iface(pkt);
+	struct route_flow *flow = flow_slot(iface, dst);
+	int err = -ENOENT;
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	if (flow->gen != net_ipv6_path_gen() || flow->iface != iface ||
+	    !net_ipv6_addr_cmp(&flow->dst, dst) || !flow->nbr->ref) {
+		goto out;
+	}
+
+	/* The link layer source address is the one of the outgoing
+	 * interface, as on the slow path.
+	 */
+	net_pkt_set_orig_iface(pkt, iface);
+	net_pkt_set_iface(pkt, flow->nbr->iface);
+
+	if (route_packet_nbr(pkt, flow->nbr) < 0) {
+		/* Let the slow path sort it out */
+		net_pkt_set_iface(pkt, iface);
+		flow->gen = 0;
+		goto out;
+	}
+
+	err = 0;
+
+out:
+	k_mutex_unlock(&lock);
+
+	if (err < 0) {
+		return err;
+	}
+
+	return net_send_data(pkt);
+}
+#endif /* CONFIG_NET_ROUTE_FLOW_CACHE */
+
+int net_route_packet(struct net_pkt *pkt, struct in6_addr *nexthop)
+{
+	struct net_nbr *nbr;
+	int err;
+#if defined(CONFIG_NET_ROUTE_FLOW_CACHE)
+	atomic_val_t gen = net_ipv6_path_gen();
+	struct route_flow *flow;
+#endif
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	nbr = net_ipv6_nbr_lookup(NULL, nexthop);
+	if (!nbr) {
+		NET_DBG("Cannot find %s neighbor",
+			net_sprint_ipv6_addr(nexthop));
+		err = -ENOENT;
+		goto error;
+	}
+
+	err = route_packet_nbr(pkt, nbr);
+	if (err < 0) {
+		goto error;
+	}
+
+#if defined(CONFIG_NET_ROUTE_FLOW_CACHE)
+	/* The packet was received on the original interface */
+	flow = flow_slot(net_pkt_orig_iface(pkt),
+			 (struct in6_addr *)NET_IPV6_HDR(pkt)->dst);
+	net_ipaddr_copy(&flow->dst, (struct in6_addr *)NET_IPV6_HDR(pkt)->dst);
+	flow->iface = net_pkt_orig_iface(pkt);
+	flow->nbr = nbr;
+	flow->gen = gen;
+#endif
+
 	k_mutex_unlock(&lock);
 	return net_send_data(pkt);
 
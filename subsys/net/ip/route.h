@@ -15,6 +15,7 @@
 
 #include <zephyr/kernel.h>
 #include <zephyr/sys/slist.h>
+#include <zephyr/sys/dlist.h>
 
 #include <zephyr/net/net_ip.h>
 #include <zephyr/net/net_timeout.h>
@@ -38,6 +39,8 @@ struct net_route_nexthop {
 	struct net_nbr *nbr;
 };
 
+struct route_trie_node;
+
 /**
  * @brief Route entry to a specific neighbor.
  */
@@ -47,11 +50,19 @@ struct net_route_entry {
 	 * we can remove it if we run out of available routes.
 	 * The oldest one is the last entry in the list.
 	 */
-	sys_snode_t node;
+	sys_dnode_t node;
 
 	/** List of neighbors that the routes go through. */
 	sys_slist_t nexthop;
 
+#if defined(CONFIG_NET_ROUTE_TRIE)
+	/** Node in the list of routes having the same prefix. */
+	sys_snode_t prefix_node;
+
+	/** Trie node holding the prefix of the route. */
+	struct route_trie_node *trie;
+#endif
+
 	/** Network interface for the route. */
 	struct net_if *iface;
 
@@ -319,6 +330,31 @@ int net_route_packet(struct net_pkt *pkt, struct in6_addr *nexthop);
  */
 int net_route_packet_if(struct net_pkt *pkt, struct net_if *iface);
 
+#if defined(CONFIG_NET_ROUTE_FLOW_CACHE)
+/**
+ * @brief Forward the network packet the way its flow was last forwarded.
+ *
+ * The flow is identified by the destination address and the interface the
+ * packet was received on. Flows are remembered by net_route_packet().
+ *
+ * @param pkt Network packet to forward.
+ * @param dst Destination IPv6 address of the packet.
+ *
+ * @return 0 if the packet was sent, -ENOENT if the flow is not known and
+ * the packet was not touched, other <0 value if it could not be sent.
+ */
+int net_route_flow_packet(struct net_pkt *pkt, struct in6_addr *dst);
+#else
+static inline int net_route_flow_packet(struct net_pkt *pkt,
+					struct in6_addr *dst)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(dst);
+
+	return -ENOENT;
+}
+#endif /* CONFIG_NET_ROUTE_FLOW_CACHE */
+
 #if defined(CONFIG_NET_ROUTE) && defined(CONFIG_NET_NATIVE)
 void net_route_init(void);
 #else
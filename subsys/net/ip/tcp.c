@@ -10,6 +10,7 @@ LOG_MODULE_REGISTER(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
 #include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <limits.h>
 #include <zephyr/kernel.h>
 #include <zephyr/random/rand32.h>
 
@@ -25,6 +26,9 @@ LOG_MODULE_REGISTER(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
 #include "net_stats.h"
 #include "net_private.h"
 #include "tcp_internal.h"
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+#include "tcp_cc.h"
+#endif
 
 #define ACK_TIMEOUT_MS CONFIG_NET_TCP_ACK_TIMEOUT
 #define ACK_TIMEOUT K_MSEC(ACK_TIMEOUT_MS)
@@ -55,12 +59,29 @@ static K_MUTEX_DEFINE(tcp_lock);
 K_MEM_SLAB_DEFINE_STATIC(tcp_conns_slab, sizeof(struct tcp),
 				CONFIG_NET_MAX_CONTEXTS, 4);
 
+#if defined(CONFIG_NET_TCP_SEND_ZC)
+/* Completion of data queued with net_tcp_queue_buf() */
+struct tcp_send_zc {
+	sys_snode_t node;
+	net_context_send_cb_t cb;
+	void *user_data;
+	uint32_t seq; /* sequence number following the data */
+	uint32_t len;
+};
+
+K_MEM_SLAB_DEFINE_STATIC(tcp_send_zc_slab, sizeof(struct tcp_send_zc),
+			 CONFIG_NET_TCP_SEND_ZC_COUNT, 4);
+#endif
+
 static struct k_work_q tcp_work_q;
 static K_KERNEL_STACK_DEFINE(work_q_stack, CONFIG_NET_TCP_WORKQ_STACK_SIZE);
 
 static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt);
 static bool is_destination_local(struct net_pkt *pkt);
 static void tcp_out(struct tcp *conn, uint8_t flags);
+#if defined(CONFIG_NET_TCP_SEND_ZC)
+static void tcp_send_zc_done(struct tcp *conn, bool closing);
+#endif
 
 int (*tcp_send_cb)(struct net_pkt *pkt) = NULL;
 size_t (*tcp_recv_cb)(struct tcp *conn, struct net_pkt *pkt) = NULL;
@@ -445,6 +466,10 @@ static int tcp_conn_unref(struct tcp *conn, int status)
 				       status, conn->recv_user_data);
 	}
 
+#if defined(CONFIG_NET_TCP_SEND_ZC)
+	tcp_send_zc_done(conn, true);
+#endif
+
 	conn->context->tcp = NULL;
 
 	net_context_unref(conn->context);
@@ -663,6 +688,10 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 
 	recv_options->mss_found = false;
 	recv_options->wnd_found = false;
+	recv_options->sack_perm_found = false;
+#if defined(CONFIG_NET_TCP_SACK)
+	recv_options->sack_count = 0U;
+#endif
 
 	for ( ; options && len >= 1; options += opt_len, len -= opt_len) {
 		opt = options[0];
@@ -708,9 +737,36 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 				goto end;
 			}
 
-			recv_options->window = opt;
+			recv_options->window = MIN(options[2],
+						   NET_TCP_MAX_WINDOW_SCALE);
 			recv_options->wnd_found = true;
 			break;
+		case NET_TCP_SACK_PERM_OPT:
+			if (opt_len != NET_TCP_SACK_PERM_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->sack_perm_found = true;
+			break;
+#if defined(CONFIG_NET_TCP_SACK)
+		case NET_TCP_SACK_OPT:
+			if ((opt_len - 2) % NET_TCP_SACK_BLOCK_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			for (int i = 2; i < opt_len &&
+			     recv_options->sack_count < NET_TCP_MAX_SACK_BLOCKS;
+			     i += NET_TCP_SACK_BLOCK_SIZE) {
+				struct tcp_sack_block *block =
+					&recv_options->sack[recv_options->sack_count++];
+
+				block->left = sys_get_be32(options + i);
+				block->right = sys_get_be32(options + i + 4);
+			}
+			break;
+#endif
 		default:
 			continue;
 		}
@@ -749,8 +805,8 @@ static int tcp_update_recv_wnd(struct tcp *conn, int32_t delta)
 	bool short_win_before;
 	bool short_win_after;
 
-	new_win = conn->recv_win + delta;
-	if (new_win < 0 || new_win > UINT16_MAX) {
+	new_win = (int32_t)conn->recv_win + delta;
+	if (new_win < 0 || new_win > (int32_t)NET_TCP_MAX_WIN) {
 		return -EINVAL;
 	}
 
@@ -882,8 +938,23 @@ static int tcp_finalize_pkt(struct net_pkt *pkt)
 	return -EINVAL;
 }
 
+/* Window to advertise in a segment */
+static uint16_t tcp_adv_win(struct tcp *conn, uint8_t flags)
+{
+	uint32_t win = conn->recv_win;
+
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	/* The window of a SYN segment is never scaled, RFC 7323 ch 2.2 */
+	if (!(flags & SYN)) {
+		win >>= conn->rcv_wscale;
+	}
+#endif
+
+	return MIN(win, UINT16_MAX);
+}
+
 static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
-			  uint32_t seq)
+			  uint32_t seq, size_t opts_len)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct tcphdr *th;
@@ -897,14 +968,10 @@ static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 
 	UNALIGNED_PUT(conn->src.sin.sin_port, &th->th_sport);
 	UNALIGNED_PUT(conn->dst.sin.sin_port, &th->th_dport);
-	th->th_off = 5;
-
-	if (conn->send_options.mss_found) {
-		th->th_off++;
-	}
+	th->th_off = 5 + opts_len / 4;
 
 	UNALIGNED_PUT(flags, &th->th_flags);
-	UNALIGNED_PUT(htons(conn->recv_win), &th->th_win);
+	UNALIGNED_PUT(htons(tcp_adv_win(conn, flags)), &th->th_win);
 	UNALIGNED_PUT(htonl(seq), &th->th_seq);
 
 	if (ACK & flags) {
@@ -962,23 +1029,89 @@ static int get_tcp_nodelay(struct tcp *conn, void *value, size_t *len)
 	return 0;
 }
 
-static int net_tcp_set_mss_opt(struct tcp *conn, struct net_pkt *pkt)
+/* Write the options of a segment to opts, which must hold 40 bytes.
+ * Returns their length, a multiple of 4 bytes.
+ */
+static size_t tcp_options_build(struct tcp *conn, uint8_t flags, uint8_t *opts)
 {
-	NET_PKT_DATA_ACCESS_DEFINE(mss_opt_access, struct tcp_mss_option);
-	struct tcp_mss_option *mss;
-	uint32_t recv_mss;
+	size_t len = 0;
 
-	mss = net_pkt_get_data(pkt, &mss_opt_access);
-	if (!mss) {
-		return -ENOBUFS;
+	if (conn->send_options.mss_found) {
+		uint32_t recv_mss = net_tcp_get_supported_mss(conn);
+
+		recv_mss |= (NET_TCP_MSS_OPT << 24) | (NET_TCP_MSS_SIZE << 16);
+		sys_put_be32(recv_mss, &opts[len]);
+		len += NET_TCP_MSS_SIZE;
 	}
 
-	recv_mss = net_tcp_get_supported_mss(conn);
-	recv_mss |= (NET_TCP_MSS_OPT << 24) | (NET_TCP_MSS_SIZE << 16);
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	if ((flags & SYN) && conn->wscale_ok) {
+		opts[len++] = NET_TCP_NOP_OPT;
+		opts[len++] = NET_TCP_WINDOW_SCALE_OPT;
+		opts[len++] = NET_TCP_WINDOW_SCALE_SIZE;
+		opts[len++] = conn->rcv_wscale;
+	}
+#endif
 
-	UNALIGNED_PUT(htonl(recv_mss), (uint32_t *)mss);
+#if defined(CONFIG_NET_TCP_SACK)
+	if ((flags & SYN) && conn->sack_ok) {
+		opts[len++] = NET_TCP_NOP_OPT;
+		opts[len++] = NET_TCP_NOP_OPT;
+		opts[len++] = NET_TCP_SACK_PERM_OPT;
+		opts[len++] = NET_TCP_SACK_PERM_SIZE;
+	} else if ((flags & ACK) && conn->sack_ok &&
+		   CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT &&
+		   !net_pkt_is_empty(conn->queue_recv_data)) {
+		/* Report the out-of-order data we queued. The queue never
+		 * has holes, so it is a single block.
+		 */
+		uint32_t left = tcp_get_seq(conn->queue_recv_data->buffer);
 
-	return net_pkt_set_data(pkt, &mss_opt_access);
+		opts[len++] = NET_TCP_NOP_OPT;
+		opts[len++] = NET_TCP_NOP_OPT;
+		opts[len++] = NET_TCP_SACK_OPT;
+		opts[len++] = 2 + NET_TCP_SACK_BLOCK_SIZE;
+		sys_put_be32(left, &opts[len]);
+		sys_put_be32(left + net_pkt_get_len(conn->queue_recv_data),
+			     &opts[len + 4]);
+		len += NET_TCP_SACK_BLOCK_SIZE;
+	}
+#endif
+
+	return len;
+}
+
+/* Decide which options the SYN segments carry and, when the peer's SYN
+ * was received, which ones are in use on the connection.
+ */
+static void tcp_options_negotiate(struct tcp *conn, bool peer_syn)
+{
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	/* Smallest shift that lets the whole receive window be advertised */
+	conn->rcv_wscale = 0U;
+	while (conn->rcv_wscale < NET_TCP_MAX_WINDOW_SCALE &&
+	       (conn->recv_win_max >> conn->rcv_wscale) > UINT16_MAX) {
+		conn->rcv_wscale++;
+	}
+
+	conn->snd_wscale = 0U;
+	conn->wscale_ok = true;
+
+	/* Both sides must send the option for scaling to be used */
+	if (peer_syn) {
+		conn->wscale_ok = conn->recv_options.wnd_found;
+		if (conn->wscale_ok) {
+			conn->snd_wscale = conn->recv_options.window;
+		} else {
+			conn->rcv_wscale = 0U;
+		}
+	}
+#endif
+
+#if defined(CONFIG_NET_TCP_SACK)
+	conn->sack_ok = !peer_syn || conn->recv_options.sack_perm_found;
+	conn->sacked_count = 0U;
+#endif
 }
 
 static bool is_destination_local(struct net_pkt *pkt)
@@ -1007,14 +1140,12 @@ static bool is_destination_local(struct net_pkt *pkt)
 static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		       uint32_t seq)
 {
-	size_t alloc_len = sizeof(struct tcphdr);
+	uint8_t opts[40]; /* TCP header max options size is 40 */
+	size_t opts_len = tcp_options_build(conn, flags, opts);
+	size_t alloc_len = sizeof(struct tcphdr) + opts_len;
 	struct net_pkt *pkt;
 	int ret = 0;
 
-	if (conn->send_options.mss_found) {
-		alloc_len += sizeof(uint32_t);
-	}
-
 	pkt = tcp_pkt_alloc(conn, alloc_len);
 	if (!pkt) {
 		ret = -ENOBUFS;
@@ -1033,14 +1164,14 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		goto out;
 	}
 
-	ret = tcp_header_add(conn, pkt, flags, seq);
+	ret = tcp_header_add(conn, pkt, flags, seq, opts_len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
 		goto out;
 	}
 
-	if (conn->send_options.mss_found) {
-		ret = net_tcp_set_mss_opt(conn, pkt);
+	if (opts_len > 0) {
+		ret = net_pkt_write(pkt, opts, opts_len);
 		if (ret < 0) {
 			tcp_pkt_unref(pkt);
 			goto out;
@@ -1113,6 +1244,212 @@ static int tcp_pkt_peek(struct net_pkt *to, struct net_pkt *from, size_t pos,
 	return net_pkt_copy(to, from, len);
 }
 
+#if defined(CONFIG_NET_TCP_SEND_ZC)
+static bool tcp_buf_can_share(struct net_buf *buf)
+{
+	struct net_buf_pool *pool = net_buf_pool_get(buf->pool_id);
+
+	return pool->alloc->cb->ref && !(buf->flags & NET_BUF_EXTERNAL_DATA);
+}
+
+/* Get a packet referencing len bytes at pos in from, without copying them.
+ * This needs pools whose data can be shared, e.g. variable size pools.
+ */
+static struct net_pkt *tcp_pkt_share(struct tcp *conn, struct net_pkt *from,
+				     size_t pos, size_t len)
+{
+	struct net_buf *frag, *clone;
+	struct net_pkt *pkt;
+	size_t chunk;
+
+	for (frag = from->buffer; frag && pos >= frag->len; frag = frag->frags) {
+		pos -= frag->len;
+	}
+
+	for (clone = frag, chunk = pos + len; clone && clone->len < chunk;
+	     clone = clone->frags) {
+		if (!tcp_buf_can_share(clone)) {
+			return NULL;
+		}
+
+		chunk -= clone->len;
+	}
+
+	if (!clone || !tcp_buf_can_share(clone)) {
+		return NULL;
+	}
+
+	pkt = tcp_pkt_alloc(conn, 0);
+	if (!pkt) {
+		return NULL;
+	}
+
+	for ( ; len > 0; frag = frag->frags, pos = 0) {
+		clone = net_buf_clone(frag, K_NO_WAIT);
+		if (!clone) {
+			tcp_pkt_unref(pkt);
+			return NULL;
+		}
+
+		chunk = MIN(len, frag->len - pos);
+		net_buf_pull(clone, pos);
+		net_buf_remove_mem(clone, clone->len - chunk);
+		net_pkt_append_buffer(pkt, clone);
+		len -= chunk;
+	}
+
+	return pkt;
+}
+
+/* Report the data that was acknowledged, or everything if the connection
+ * is going away.
+ */
+static void tcp_send_zc_done(struct tcp *conn, bool closing)
+{
+	struct tcp_send_zc *zc;
+	sys_snode_t *node;
+
+	while ((node = sys_slist_peek_head(&conn->send_zc)) != NULL) {
+		zc = CONTAINER_OF(node, struct tcp_send_zc, node);
+
+		if (net_tcp_seq_cmp(conn->seq, zc->seq) >= 0) {
+			zc->cb(conn->context, zc->len, zc->user_data);
+		} else if (closing) {
+			zc->cb(conn->context, -ECONNABORTED, zc->user_data);
+		} else {
+			break;
+		}
+
+		(void)sys_slist_get_not_empty(&conn->send_zc);
+		k_mem_slab_free(&tcp_send_zc_slab, (void **)&zc);
+	}
+}
+#endif /* CONFIG_NET_TCP_SEND_ZC */
+
+#if defined(CONFIG_NET_TCP_SACK)
+/* Add a block to the scoreboard, which is kept sorted and without
+ * overlapping blocks. When full, the highest block is forgotten, the data
+ * it covers is then just sent again.
+ */
+static void tcp_sack_insert(struct tcp *conn, struct tcp_sack_block *block)
+{
+	struct tcp_sack_block *sb = conn->sacked;
+	int n = conn->sacked_count;
+	int i, j;
+
+	for (i = 0; i < n && net_tcp_seq_cmp(sb[i].right, block->left) < 0;
+	     i++) {
+	}
+
+	/* Merge the blocks the new one overlaps or touches */
+	for (j = i; j < n && net_tcp_seq_cmp(sb[j].left, block->right) <= 0;
+	     j++) {
+		if (net_tcp_seq_cmp(sb[j].left, block->left) < 0) {
+			block->left = sb[j].left;
+		}
+
+		if (net_tcp_seq_cmp(sb[j].right, block->right) > 0) {
+			block->right = sb[j].right;
+		}
+	}
+
+	if (j == i) {
+		if (n == ARRAY_SIZE(conn->sacked)) {
+			if (i == n) {
+				return;
+			}
+
+			n--;
+		}
+
+		memmove(&sb[i + 1], &sb[i], (n - i) * sizeof(*sb));
+		n++;
+	} else {
+		memmove(&sb[i + 1], &sb[j], (n - j) * sizeof(*sb));
+		n -= j - i - 1;
+	}
+
+	sb[i] = *block;
+	conn->sacked_count = n;
+}
+
+/* Update the scoreboard from an ACK acknowledging up to ack */
+static void tcp_sack_update(struct tcp *conn, uint32_t ack)
+{
+	struct tcp_sack_block *sb = conn->sacked;
+	uint32_t end = conn->seq + conn->send_data_total;
+	int i, j;
+
+	/* Forget what is now acknowledged */
+	for (i = 0, j = 0; i < conn->sacked_count; i++) {
+		if (net_tcp_seq_cmp(sb[i].right, ack) <= 0) {
+			continue;
+		}
+
+		if (net_tcp_seq_cmp(sb[i].left, ack) < 0) {
+			sb[i].left = ack;
+		}
+
+		sb[j++] = sb[i];
+	}
+
+	conn->sacked_count = j;
+
+	for (i = 0; i < conn->recv_options.sack_count; i++) {
+		struct tcp_sack_block *block = &conn->recv_options.sack[i];
+
+		/* Skip D-SACKs and blocks not matching data we sent */
+		if (net_tcp_seq_cmp(block->left, ack) <= 0 ||
+		    net_tcp_seq_cmp(block->right, block->left) <= 0 ||
+		    net_tcp_seq_cmp(block->right, end) > 0) {
+			continue;
+		}
+
+		tcp_sack_insert(conn, block);
+	}
+}
+
+/* Move unacked_len past the SACKed data it points to, and return how much
+ * can be sent from there before reaching SACKed data again.
+ */
+static int tcp_sack_skip(struct tcp *conn)
+{
+	uint32_t pos;
+
+	for (int i = 0; i < conn->sacked_count; i++) {
+		pos = conn->seq + conn->unacked_len;
+
+		if (net_tcp_seq_cmp(pos, conn->sacked[i].left) < 0) {
+			return conn->sacked[i].left - pos;
+		}
+
+		if (net_tcp_seq_cmp(pos, conn->sacked[i].right) < 0) {
+			conn->unacked_len = conn->sacked[i].right - conn->seq;
+		}
+	}
+
+	return INT_MAX;
+}
+
+/* Offset of the first hole in the SACKed data from seq, or -1 if there is
+ * none, i.e. no data known to be lost.
+ */
+static int tcp_sack_next_hole(struct tcp *conn, uint32_t seq)
+{
+	for (int i = 0; i < conn->sacked_count; i++) {
+		if (net_tcp_seq_cmp(seq, conn->sacked[i].left) < 0) {
+			return seq - conn->seq;
+		}
+
+		if (net_tcp_seq_cmp(seq, conn->sacked[i].right) < 0) {
+			seq = conn->sacked[i].right;
+		}
+	}
+
+	return -1;
+}
+#endif /* CONFIG_NET_TCP_SACK */
+
 static bool tcp_window_full(struct tcp *conn)
 {
 	bool window_full = (conn->send_data_total >= conn->send_win);
@@ -1122,8 +1459,23 @@ static bool tcp_window_full(struct tcp *conn)
 	return window_full;
 }
 
+/* How much data can be in flight: the peer's window, further limited by
+ * the congestion window. The latter is only checked before sending a
+ * segment, so that a window which is not a whole number of segments does
+ * not lead to sending small segments.
+ */
+static uint32_t tcp_send_win(struct tcp *conn)
+{
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	return MIN(conn->send_win, conn->cwnd);
+#else
+	return conn->send_win;
+#endif
+}
+
 static int tcp_unsent_len(struct tcp *conn)
 {
+	uint32_t send_win = tcp_send_win(conn);
 	int unsent_len;
 
 	if (conn->unacked_len > conn->send_data_total) {
@@ -1134,10 +1486,10 @@ static int tcp_unsent_len(struct tcp *conn)
 	}
 
 	unsent_len = conn->send_data_total - conn->unacked_len;
-	if (conn->unacked_len >= conn->send_win) {
+	if (conn->unacked_len >= send_win) {
 		unsent_len = 0;
 	} else {
-		unsent_len = MIN(unsent_len, conn->send_win - conn->unacked_len);
+		unsent_len = MIN(unsent_len, send_win - conn->unacked_len);
 	}
  out:
 	NET_DBG("unsent_len=%d", unsent_len);
@@ -1149,17 +1501,30 @@ static int tcp_send_data(struct tcp *conn)
 {
 	int ret = 0;
 	int len;
+	int max_len = INT_MAX;
 	struct net_pkt *pkt;
 
-	len = MIN3(conn->send_data_total - conn->unacked_len,
-		   conn->send_win - conn->unacked_len,
-		   conn_mss(conn));
-	if (len == 0) {
+#if defined(CONFIG_NET_TCP_SACK)
+	/* Do not send again what the peer already has */
+	max_len = tcp_sack_skip(conn);
+#endif
+
+	len = MIN3((int)(conn->send_data_total - conn->unacked_len),
+		   (int)conn->send_win - conn->unacked_len,
+		   MIN(conn_mss(conn), max_len));
+	if (len <= 0) {
 		NET_DBG("conn: %p no data to send", conn);
 		ret = -ENODATA;
 		goto out;
 	}
 
+#if defined(CONFIG_NET_TCP_SEND_ZC)
+	pkt = tcp_pkt_share(conn, conn->send_data, conn->unacked_len, len);
+	if (pkt) {
+		goto send;
+	}
+#endif
+
 	pkt = tcp_pkt_alloc(conn, len);
 	if (!pkt) {
 		NET_ERR("conn: %p packet allocation failed, len=%d", conn, len);
@@ -1174,10 +1539,24 @@ static int tcp_send_data(struct tcp *conn)
 		goto out;
 	}
 
+#if defined(CONFIG_NET_TCP_SEND_ZC)
+send:
+#endif
+
 	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + conn->unacked_len);
 	if (ret == 0) {
 		conn->unacked_len += len;
 
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+		/* Time one segment per RTT */
+		if (!conn->rtt_pending &&
+		    conn->data_mode == TCP_DATA_MODE_SEND) {
+			conn->rtt_pending = true;
+			conn->rtt_seq = conn->seq + conn->unacked_len;
+			conn->rtt_start = k_uptime_get_32();
+		}
+#endif
+
 		if (conn->data_mode == TCP_DATA_MODE_RESEND) {
 			net_stats_update_tcp_resent(conn->iface, len);
 			net_stats_update_tcp_seg_rexmit(conn->iface);
@@ -1199,6 +1578,152 @@ static int tcp_send_data(struct tcp *conn)
 	return ret;
 }
 
+#if defined(CONFIG_NET_TCP_FAST_RETRANSMIT)
+/* Send again one segment from offset in the unacknowledged data, leaving
+ * the ongoing transmission alone. Returns the offset following the sent
+ * data, or a negative error.
+ */
+static int tcp_send_data_at(struct tcp *conn, int offset)
+{
+	int unacked_len = conn->unacked_len;
+	int ret;
+
+	conn->unacked_len = offset;
+
+	ret = tcp_send_data(conn);
+	offset = conn->unacked_len;
+
+	conn->unacked_len = MAX(unacked_len, conn->unacked_len);
+
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	/* Karn's algorithm: ACKs of retransmitted data are ambiguous */
+	conn->rtt_pending = false;
+#endif
+
+	return ret < 0 ? ret : offset;
+}
+#endif /* CONFIG_NET_TCP_FAST_RETRANSMIT */
+
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+static void tcp_cc_init(struct tcp *conn)
+{
+	uint32_t mss = conn_mss(conn);
+
+	/* Initial window, RFC 3390 */
+	conn->cwnd = MIN(4U * mss, MAX(2U * mss, 4380U));
+	conn->ssthresh = NET_TCP_MAX_WIN;
+	conn->in_recovery = false;
+	conn->rtt_pending = false;
+	conn->srtt = 0U;
+	conn->cc = TCP_CC_DEFAULT;
+	conn->cc->init(conn);
+}
+
+/* Retransmit the next segment considered lost during fast recovery:
+ * the next hole in the SACKed data, or the first unacknowledged segment
+ * without SACK (NewReno, RFC 6582).
+ */
+static void tcp_cc_rexmit(struct tcp *conn)
+{
+	int offset = 0;
+
+#if defined(CONFIG_NET_TCP_SACK)
+	if (conn->sacked_count > 0) {
+		uint32_t from = net_tcp_seq_greater(conn->high_rxt, conn->seq) ?
+			conn->high_rxt : conn->seq;
+
+		offset = tcp_sack_next_hole(conn, from);
+		if (offset < 0) {
+			return;
+		}
+	}
+#endif
+
+	offset = tcp_send_data_at(conn, offset);
+	if (offset >= 0) {
+		conn->high_rxt = conn->seq + offset;
+	}
+}
+
+/* Three duplicate ACKs: start fast recovery, RFC 5681 ch 3.2 */
+static void tcp_cc_fast_retransmit(struct tcp *conn)
+{
+	if (conn->in_recovery) {
+		return;
+	}
+
+	conn->cc->loss(conn, TCP_CC_EVENT_FAST_RETRANSMIT);
+	conn->cwnd = conn->ssthresh + 3U * conn_mss(conn);
+	conn->recover = conn->seq + conn->unacked_len;
+	conn->high_rxt = conn->seq;
+	conn->in_recovery = true;
+
+	tcp_cc_rexmit(conn);
+}
+
+/* Further duplicate ACK during fast recovery: a segment left the network */
+static void tcp_cc_dup_ack(struct tcp *conn)
+{
+	if (!conn->in_recovery) {
+		return;
+	}
+
+	conn->cwnd += conn_mss(conn);
+
+	if (IS_ENABLED(CONFIG_NET_TCP_SACK) && conn->sack_ok) {
+		tcp_cc_rexmit(conn);
+	}
+}
+
+/* acked bytes were acknowledged, conn->seq was already moved past them */
+static void tcp_cc_ack(struct tcp *conn, uint32_t acked)
+{
+	uint32_t mss = conn_mss(conn);
+
+	if (conn->rtt_pending &&
+	    net_tcp_seq_cmp(conn->seq, conn->rtt_seq) >= 0) {
+		uint32_t rtt = k_uptime_get_32() - conn->rtt_start;
+
+		conn->srtt = conn->srtt ?
+			conn->srtt - (conn->srtt >> 3) + (rtt >> 3) : rtt;
+		conn->rtt_pending = false;
+	}
+
+	if (!conn->in_recovery) {
+		conn->cc->ack(conn, acked);
+		conn->cwnd = MIN(conn->cwnd, NET_TCP_MAX_WIN);
+		return;
+	}
+
+	if (net_tcp_seq_cmp(conn->seq, conn->recover) >= 0) {
+		/* Full acknowledgment, recovery is over */
+		conn->in_recovery = false;
+		conn->cwnd = conn->ssthresh;
+		return;
+	}
+
+	/* Partial acknowledgment: deflate the window by the amount of data
+	 * acknowledged, and send the next lost segment.
+	 */
+	conn->cwnd -= MIN(conn->cwnd, acked);
+	conn->cwnd += mss;
+
+	tcp_cc_rexmit(conn);
+}
+
+/* Retransmission timeout, RFC 5681 ch 3.1 */
+static void tcp_cc_timeout(struct tcp *conn)
+{
+	if (conn->send_data_retries == 0) {
+		conn->cc->loss(conn, TCP_CC_EVENT_TIMEOUT);
+	}
+
+	conn->cwnd = conn_mss(conn);
+	conn->in_recovery = false;
+	conn->rtt_pending = false;
+}
+#endif /* CONFIG_NET_TCP_CONGESTION_CONTROL */
+
 /* Send all queued but unsent data from the send_data packet by packet
  * until the receiver's window is full. */
 static int tcp_send_queued_data(struct tcp *conn)
@@ -1282,6 +1807,12 @@ static void tcp_resend_data(struct k_work *work)
 		goto out;
 	}
 
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	if (conn->state == TCP_ESTABLISHED) {
+		tcp_cc_timeout(conn);
+	}
+#endif
+
 	conn->data_mode = TCP_DATA_MODE_RESEND;
 	conn->unacked_len = 0;
 
@@ -1471,6 +2002,7 @@ static struct tcp *tcp_conn_alloc(struct net_context *context)
 		}
 	}
 
+	conn->recv_win_max = MIN(conn->recv_win_max, NET_TCP_MAX_WIN);
 	conn->recv_win = conn->recv_win_max;
 
 	/* The ISN value will be set when we get the connection attempt or
@@ -1479,6 +2011,9 @@ static struct tcp *tcp_conn_alloc(struct net_context *context)
 	conn->seq = 0U;
 
 	sys_slist_init(&conn->send_queue);
+#if defined(CONFIG_NET_TCP_SEND_ZC)
+	sys_slist_init(&conn->send_zc);
+#endif
 
 	k_work_init_delayable(&conn->send_timer, tcp_send_process);
 	k_work_init_delayable(&conn->timewait_timer, tcp_timewait_timeout);
@@ -2075,6 +2610,10 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		goto next_state;
 	}
 
+#if defined(CONFIG_NET_TCP_SACK)
+	conn->recv_options.sack_count = 0U;
+#endif
+
 	if (tcp_options_len && !tcp_options_check(&conn->recv_options, pkt,
 						  tcp_options_len)) {
 		NET_DBG("DROP: Invalid TCP option list");
@@ -2103,6 +2642,12 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		size_t max_win;
 
 		conn->send_win = ntohs(th_win(th));
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+		/* The window of a SYN segment is never scaled, RFC 7323 ch 2.2 */
+		if (!FL(&fl, &, SYN)) {
+			conn->send_win <<= conn->snd_wscale;
+		}
+#endif
 
 #if defined(CONFIG_NET_TCP_MAX_SEND_WINDOW_SIZE)
 		if (CONFIG_NET_TCP_MAX_SEND_WINDOW_SIZE) {
@@ -2153,6 +2698,8 @@ next_state:
 	switch (conn->state) {
 	case TCP_LISTEN:
 		if (FL(&fl, ==, SYN)) {
+			tcp_options_negotiate(conn, true);
+
 			/* Make sure our MSS is also sent in the ACK */
 			conn->send_options.mss_found = true;
 			conn_ack(conn, th_seq(th) + 1); /* capture peer's isn */
@@ -2167,6 +2714,8 @@ next_state:
 						    &conn->establish_timer,
 						    ACK_TIMEOUT);
 		} else {
+			tcp_options_negotiate(conn, false);
+
 			conn->send_options.mss_found = true;
 			tcp_out(conn, SYN);
 			conn->send_options.mss_found = false;
@@ -2179,6 +2728,9 @@ next_state:
 				th_seq(th) == conn->ack)) {
 			k_work_cancel_delayable(&conn->establish_timer);
 			tcp_send_timer_cancel(conn);
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+			tcp_cc_init(conn);
+#endif
 			next = TCP_ESTABLISHED;
 			net_context_set_state(conn->context,
 					      NET_CONTEXT_CONNECTED);
@@ -2212,6 +2764,10 @@ next_state:
 		 */
 		if (FL(&fl, &, SYN | ACK, th && th_ack(th) == conn->seq)) {
 			tcp_send_timer_cancel(conn);
+			tcp_options_negotiate(conn, true);
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+			tcp_cc_init(conn);
+#endif
 			conn_ack(conn, th_seq(th) + 1);
 			if (len) {
 				verdict = tcp_data_get(conn, pkt, &len);
@@ -2279,19 +2835,34 @@ next_state:
 				conn->dup_ack_cnt = 0;
 			}
 
+#if defined(CONFIG_NET_TCP_SACK)
+			if (conn->sack_ok) {
+				tcp_sack_update(conn, th_ack(th));
+			}
+#endif
+
 			/* Only do fast retransmit when not already in a resend state */
 			if ((conn->data_mode == TCP_DATA_MODE_SEND) &&
 			    (conn->dup_ack_cnt == DUPLICATE_ACK_RETRANSMIT_TRHESHOLD)) {
 				/* Apply a fast retransmit */
-				int temp_unacked_len = conn->unacked_len;
-
-				conn->unacked_len = 0;
-
-				(void)tcp_send_data(conn);
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+				tcp_cc_fast_retransmit(conn);
+#else
+				(void)tcp_send_data_at(conn, 0);
+#endif
+			}
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+			else if ((conn->data_mode == TCP_DATA_MODE_SEND) &&
+				 (len == 0) && (conn->dup_ack_cnt >
+						DUPLICATE_ACK_RETRANSMIT_TRHESHOLD)) {
+				tcp_cc_dup_ack(conn);
+			}
 
-				/* Restore the current transmission */
-				conn->unacked_len = temp_unacked_len;
+			/* The inflated window may allow new data */
+			if (conn->in_recovery) {
+				(void)tcp_send_queued_data(conn);
 			}
+#endif
 		}
 #endif
 
@@ -2332,6 +2903,21 @@ next_state:
 			conn_seq(conn, + len_acked);
 			net_stats_update_tcp_seg_recv(conn->iface);
 
+#if defined(CONFIG_NET_TCP_SEND_ZC)
+			tcp_send_zc_done(conn, false);
+#endif
+
+#if defined(CONFIG_NET_TCP_SACK)
+			if (conn->sack_ok) {
+				tcp_sack_update(conn, th_ack(th));
+			}
+#endif
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+			if (conn->data_mode == TCP_DATA_MODE_SEND) {
+				tcp_cc_ack(conn, len_acked);
+			}
+#endif
+
 			conn_send_data_dump(conn);
 
 			if (!k_work_delayable_remaining_get(
@@ -2727,6 +3313,55 @@ out:
 	return ret;
 }
 
+#if defined(CONFIG_NET_TCP_SEND_ZC)
+int net_tcp_queue_buf(struct net_context *context, struct net_buf *buf,
+		      net_context_send_cb_t cb, void *user_data)
+{
+	struct tcp *conn = context->tcp;
+	struct tcp_send_zc *zc;
+	struct net_pkt *pkt;
+	int ret;
+
+	if (!conn || conn->state != TCP_ESTABLISHED) {
+		return -ENOTCONN;
+	}
+
+	if (k_mem_slab_alloc(&tcp_send_zc_slab, (void **)&zc, K_NO_WAIT)) {
+		return -ENOBUFS;
+	}
+
+	pkt = tcp_pkt_alloc(conn, 0);
+	if (!pkt) {
+		k_mem_slab_free(&tcp_send_zc_slab, (void **)&zc);
+		return -ENOBUFS;
+	}
+
+	net_pkt_append_buffer(pkt, buf);
+	zc->cb = cb;
+	zc->user_data = user_data;
+	zc->len = net_pkt_get_len(pkt);
+
+	k_mutex_lock(&conn->lock, K_FOREVER);
+
+	ret = net_tcp_queue_data(context, pkt);
+	if (ret < 0) {
+		/* If the data was not queued, the buffers are still in the
+		 * pkt and go back to the caller.
+		 */
+		pkt->buffer = NULL;
+		tcp_pkt_unref(pkt);
+		k_mem_slab_free(&tcp_send_zc_slab, (void **)&zc);
+	} else {
+		zc->seq = conn->seq + conn->send_data_total;
+		sys_slist_append(&conn->send_zc, &zc->node);
+	}
+
+	k_mutex_unlock(&conn->lock);
+
+	return ret;
+}
+#endif /* CONFIG_NET_TCP_SEND_ZC */
+
 /* net context is about to send out queued data - inform caller only */
 int net_tcp_send_data(struct net_context *context, net_context_send_cb_t cb,
 		      void *user_data)
@@ -0,0 +1,72 @@
+/** @file
+ @brief TCP congestion control
+
+ This is not to be included by the application.
+ */
+
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __TCP_CC_H
+#define __TCP_CC_H
+
+#include <zephyr/types.h>
+
+#include "tcp_internal.h"
+
+/* Events reducing the congestion window */
+enum tcp_cc_event {
+	/* Three duplicate ACKs were received, fast recovery starts */
+	TCP_CC_EVENT_FAST_RETRANSMIT,
+	/* The retransmission timer expired */
+	TCP_CC_EVENT_TIMEOUT,
+};
+
+/*
+ * A congestion control algorithm. The TCP core owns the loss recovery:
+ * it sets the congestion window to ssthresh + 3 * MSS when entering fast
+ * recovery, inflates it with each further duplicate ACK, sets it back to
+ * ssthresh when recovery ends and to one MSS on retransmission timeout.
+ * The algorithm decides how the window grows and what ssthresh becomes.
+ */
+struct tcp_cc_ops {
+	const char *name;
+
+	/* Set up the algorithm state once the connection is established,
+	 * cwnd and ssthresh are already set to their initial values.
+	 */
+	void (*init)(struct tcp *conn);
+
+	/* Data was acknowledged outside of loss recovery, grow cwnd */
+	void (*ack)(struct tcp *conn, uint32_t acked);
+
+	/* Loss was detected, set ssthresh. unacked_len still holds the
+	 * amount of data in flight.
+	 */
+	void (*loss)(struct tcp *conn, enum tcp_cc_event event);
+};
+
+#if defined(CONFIG_NET_TCP_CC_NEWRENO)
+extern const struct tcp_cc_ops tcp_cc_newreno;
+#define TCP_CC_DEFAULT (&tcp_cc_newreno)
+#elif defined(CONFIG_NET_TCP_CC_CUBIC)
+extern const struct tcp_cc_ops tcp_cc_cubic;
+#define TCP_CC_DEFAULT (&tcp_cc_cubic)
+#endif
+
+/* Slow start with appropriate byte counting, RFC 5681 and RFC 3465 */
+static inline void tcp_cc_slow_start(struct tcp *conn, uint32_t acked)
+{
+	conn->cwnd += MIN(acked, 2U * conn_mss(conn));
+}
+
+/* Slow start threshold after a loss, RFC 5681 ch 3.1 */
+static inline uint32_t tcp_cc_half_flight(struct tcp *conn)
+{
+	return MAX((uint32_t)conn->unacked_len / 2U, 2U * conn_mss(conn));
+}
+
+#endif /* __TCP_CC_H */
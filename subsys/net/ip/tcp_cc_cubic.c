@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* CUBIC congestion control, RFC 8312 */
+
+#include <zephyr/kernel.h>
+#include <string.h>
+
+#include "tcp_cc.h"
+
+/* Constants are scaled by 1024 */
+#define CUBIC_SCALE	1024U
+#define CUBIC_BETA	717U	/* 0.7, multiplicative decrease factor */
+#define CUBIC_C		410U	/* 0.4, scaling constant */
+#define CUBIC_ALPHA	542U	/* 3 * (1 - beta) / (1 + beta) */
+
+/* Limit the distance to the plateau so that the window computation fits
+ * in 64 bits.
+ */
+#define CUBIC_MAX_T_MS	(1U << 19)
+
+static uint32_t cubic_root(uint64_t a)
+{
+	uint64_t y = 0U;
+	uint64_t b;
+
+	/* Bitwise integer cube root, from Hacker's Delight */
+	for (int s = 63; s >= 0; s -= 3) {
+		y <<= 1;
+		b = 3U * y * (y + 1U) + 1U;
+		if ((a >> s) >= b) {
+			a -= b << s;
+			y++;
+		}
+	}
+
+	return (uint32_t)y;
+}
+
+static void cubic_init(struct tcp *conn)
+{
+	memset(&conn->cc_state.cubic, 0, sizeof(conn->cc_state.cubic));
+}
+
+/* Start a new epoch: compute when the curve goes back to w_max */
+static void cubic_epoch_start(struct tcp *conn, uint32_t now)
+{
+	uint32_t mss = conn_mss(conn);
+
+	conn->cc_state.cubic.epoch_start = now ? now : 1U;
+	conn->cc_state.cubic.w_est = conn->cwnd;
+
+	if (conn->cwnd < conn->cc_state.cubic.w_max) {
+		/* K = cbrt((w_max - cwnd) / C), here in ms */
+		uint64_t segs = ((uint64_t)(conn->cc_state.cubic.w_max -
+					    conn->cwnd) *
+				 CUBIC_SCALE * MSEC_PER_SEC) / (CUBIC_C * mss);
+
+		conn->cc_state.cubic.k = cubic_root(segs * USEC_PER_SEC);
+		conn->cc_state.cubic.origin = conn->cc_state.cubic.w_max;
+	} else {
+		conn->cc_state.cubic.k = 0U;
+		conn->cc_state.cubic.origin = conn->cwnd;
+	}
+}
+
+/* Window given by the cubic function t ms after the start of the epoch */
+static uint32_t cubic_window(struct tcp *conn, uint32_t t)
+{
+	uint32_t mss = conn_mss(conn);
+	uint32_t origin = conn->cc_state.cubic.origin;
+	uint32_t k = conn->cc_state.cubic.k;
+	uint64_t d = (t > k) ? t - k : k - t;
+	uint64_t delta;
+
+	d = MIN(d, CUBIC_MAX_T_MS);
+
+	/* C * d^3 segments, d in ms */
+	delta = ((d * d * d) / USEC_PER_SEC) * CUBIC_C * mss /
+		(CUBIC_SCALE * MSEC_PER_SEC);
+
+	if (t > k) {
+		return MIN(origin + delta, NET_TCP_MAX_WIN);
+	}
+
+	return (delta < origin) ? origin - delta : 0U;
+}
+
+static void cubic_ack(struct tcp *conn, uint32_t acked)
+{
+	uint32_t now = k_uptime_get_32();
+	uint32_t mss = conn_mss(conn);
+	uint32_t target;
+
+	if (conn->cwnd < conn->ssthresh) {
+		tcp_cc_slow_start(conn, acked);
+		return;
+	}
+
+	if (conn->cc_state.cubic.epoch_start == 0U) {
+		cubic_epoch_start(conn, now);
+	}
+
+	/* Aim at the window the curve reaches one RTT from now */
+	target = cubic_window(conn, now - conn->cc_state.cubic.epoch_start +
+			      conn->srtt);
+
+	/* The TCP friendly region: do not grow slower than Reno would */
+	conn->cc_state.cubic.w_est += (uint32_t)(((uint64_t)acked * mss *
+						  CUBIC_ALPHA) /
+						 (CUBIC_SCALE * conn->cwnd));
+	target = MAX(target, conn->cc_state.cubic.w_est);
+
+	/* No more than 1.5 times the window per RTT, RFC 8312 ch 4.1 */
+	target = MIN(target, conn->cwnd + conn->cwnd / 2U);
+
+	if (target > conn->cwnd) {
+		conn->cwnd += MAX((uint32_t)(((uint64_t)(target - conn->cwnd) *
+					      acked) / conn->cwnd), 1U);
+	}
+}
+
+static void cubic_loss(struct tcp *conn, enum tcp_cc_event event)
+{
+	uint32_t cwnd = conn->cwnd;
+
+	ARG_UNUSED(event);
+
+	/* Fast convergence, RFC 8312 ch 4.6: release bandwidth for new
+	 * flows when the window keeps shrinking.
+	 */
+	if (cwnd < conn->cc_state.cubic.w_max) {
+		conn->cc_state.cubic.w_max = (uint32_t)(((uint64_t)cwnd *
+							 (CUBIC_SCALE +
+							  CUBIC_BETA)) /
+							(2U * CUBIC_SCALE));
+	} else {
+		conn->cc_state.cubic.w_max = cwnd;
+	}
+
+	conn->ssthresh = MAX((uint32_t)(((uint64_t)cwnd * CUBIC_BETA) /
+					CUBIC_SCALE),
+			     2U * conn_mss(conn));
+	conn->cc_state.cubic.epoch_start = 0U;
+}
+
+const struct tcp_cc_ops tcp_cc_cubic = {
+	.name = "cubic",
+	.init = cubic_init,
+	.ack = cubic_ack,
+	.loss = cubic_loss,
+};
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* NewReno congestion control, RFC 5681 and RFC 6582 */
+
+#include <zephyr/kernel.h>
+
+#include "tcp_cc.h"
+
+static void newreno_init(struct tcp *conn)
+{
+	conn->cc_state.newreno.bytes_acked = 0U;
+}
+
+static void newreno_ack(struct tcp *conn, uint32_t acked)
+{
+	uint32_t *bytes_acked = &conn->cc_state.newreno.bytes_acked;
+
+	if (conn->cwnd < conn->ssthresh) {
+		tcp_cc_slow_start(conn, acked);
+		return;
+	}
+
+	/* Congestion avoidance: grow by one MSS per window of data
+	 * acknowledged.
+	 */
+	*bytes_acked += acked;
+	if (*bytes_acked >= conn->cwnd) {
+		*bytes_acked -= conn->cwnd;
+		conn->cwnd += conn_mss(conn);
+	}
+}
+
+static void newreno_loss(struct tcp *conn, enum tcp_cc_event event)
+{
+	ARG_UNUSED(event);
+
+	conn->ssthresh = tcp_cc_half_flight(conn);
+	conn->cc_state.newreno.bytes_acked = 0U;
+}
+
+const struct tcp_cc_ops tcp_cc_newreno = {
+	.name = "newreno",
+	.init = newreno_init,
+	.ack = newreno_ack,
+	.loss = newreno_loss,
+};
@@ -319,6 +319,38 @@ static inline int net_tcp_queue_data(struct net_context *context,
 }
 #endif
 
+/**
+ * @brief Enqueue application buffers for transmission without copy
+ *
+ * The stack takes over the reference to @a buf and sends the data from it,
+ * as long as it needs it for retransmissions. Once the peer ACKs all of it,
+ * @a cb is called with the number of bytes.
+ *
+ * @param context TCP context
+ * @param buf Buffer chain holding the data
+ * @param cb Called when the data is acknowledged, or with a negative error
+ *           if the connection is closed before
+ * @param user_data User data given to @a cb
+ *
+ * @return 0 if ok, < 0 if error. The caller still owns @a buf on -EAGAIN
+ *         and -ENOBUFS.
+ */
+#if defined(CONFIG_NET_TCP_SEND_ZC)
+int net_tcp_queue_buf(struct net_context *context, struct net_buf *buf,
+		      net_context_send_cb_t cb, void *user_data);
+#else
+static inline int net_tcp_queue_buf(struct net_context *context,
+				    struct net_buf *buf,
+				    net_context_send_cb_t cb, void *user_data)
+{
+	ARG_UNUSED(context);
+	ARG_UNUSED(buf);
+	ARG_UNUSED(cb);
+	ARG_UNUSED(user_data);
+	return -ENOTSUP;
+}
+#endif
+
 /**
  * @brief Update TCP receive window
  *
@@ -128,7 +128,7 @@
 #define conn_send_data_dump(_conn)                                             \
 	({                                                                     \
 		NET_DBG("conn: %p total=%zd, unacked_len=%d, "                 \
-			"send_win=%hu, mss=%hu",                               \
+			"send_win=%u, mss=%hu",                                \
 			(_conn), net_pkt_get_len((_conn)->send_data),          \
 			_conn->unacked_len, _conn->send_win,                   \
 			(uint16_t)conn_mss((_conn)));                          \
@@ -175,10 +175,6 @@ enum th_flags {
 	CWR = BIT(7),
 };
 
-struct tcp_mss_option {
-	uint32_t option;
-};
-
 enum tcp_state {
 	TCP_LISTEN = 1,
 	TCP_SYN_SENT,
@@ -209,20 +205,70 @@ union tcp_endpoint {
 #define NET_TCP_NOP_OPT          1
 #define NET_TCP_MSS_OPT          2
 #define NET_TCP_WINDOW_SCALE_OPT 3
+#define NET_TCP_SACK_PERM_OPT    4
+#define NET_TCP_SACK_OPT         5
 
 /* TCP Option sizes */
 #define NET_TCP_END_SIZE          1
 #define NET_TCP_NOP_SIZE          1
 #define NET_TCP_MSS_SIZE          4
 #define NET_TCP_WINDOW_SCALE_SIZE 3
+#define NET_TCP_SACK_PERM_SIZE    2
+#define NET_TCP_SACK_BLOCK_SIZE   8
+
+/* Largest window scale shift, RFC 7323 ch 2.3 */
+#define NET_TCP_MAX_WINDOW_SCALE 14
+
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+#define NET_TCP_MAX_WIN ((uint32_t)UINT16_MAX << NET_TCP_MAX_WINDOW_SCALE)
+#else
+#define NET_TCP_MAX_WIN UINT16_MAX
+#endif
+
+/* Number of SACK blocks fitting in the options of an ACK, also the size
+ * of the scoreboard of SACKed data.
+ */
+#define NET_TCP_MAX_SACK_BLOCKS 4
+
+struct tcp_sack_block {
+	uint32_t left;	/* First sequence number of the block */
+	uint32_t right;	/* Sequence number following the block */
+};
 
 struct tcp_options {
 	uint16_t mss;
-	uint16_t window;
+	uint16_t window;	/* Window scale shift */
 	bool mss_found : 1;
 	bool wnd_found : 1;
+	bool sack_perm_found : 1;
+#if defined(CONFIG_NET_TCP_SACK)
+	uint8_t sack_count;
+	struct tcp_sack_block sack[NET_TCP_MAX_SACK_BLOCKS];
+#endif
 };
 
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+struct tcp_cc_ops;
+
+/* Private state of the congestion control algorithms */
+union tcp_cc_state {
+#if defined(CONFIG_NET_TCP_CC_NEWRENO)
+	struct {
+		uint32_t bytes_acked;	/* Appropriate byte counting */
+	} newreno;
+#endif
+#if defined(CONFIG_NET_TCP_CC_CUBIC)
+	struct {
+		uint32_t epoch_start;	/* Start of the epoch, in ms, 0 if none */
+		uint32_t k;		/* Time to reach w_max, in ms */
+		uint32_t origin;	/* Window at the plateau of the curve */
+		uint32_t w_max;		/* Window before the last reduction */
+		uint32_t w_est;		/* Window following Reno, RFC 8312 4.2 */
+	} cubic;
+#endif
+};
+#endif /* CONFIG_NET_TCP_CONGESTION_CONTROL */
+
 struct tcp { /* TCP connection */
 	sys_snode_t next;
 	struct net_context *context;
@@ -231,6 +277,9 @@ struct tcp { /* TCP connection */
 	struct net_if *iface;
 	void *recv_user_data;
 	sys_slist_t send_queue;
+#if defined(CONFIG_NET_TCP_SEND_ZC)
+	sys_slist_t send_zc; /* buffers queued without copy, waiting for ACK */
+#endif
 	union {
 		net_tcp_accept_cb_t accept_cb;
 		struct tcp *accepted_conn;
@@ -266,9 +315,28 @@ struct tcp { /* TCP connection */
 	enum tcp_data_mode data_mode;
 	uint32_t seq;
 	uint32_t ack;
-	uint16_t recv_win_max;
-	uint16_t recv_win;
-	uint16_t send_win;
+	uint32_t recv_win_max;
+	uint32_t recv_win;
+	uint32_t send_win;
+#ifdef CONFIG_NET_TCP_CONGESTION_CONTROL
+	const struct tcp_cc_ops *cc;
+	union tcp_cc_state cc_state;
+	uint32_t cwnd;		/* Congestion window */
+	uint32_t ssthresh;	/* Slow start threshold */
+	uint32_t recover;	/* Highest seq sent when entering recovery */
+	uint32_t high_rxt;	/* Next seq to retransmit during recovery */
+	uint32_t rtt_seq;	/* Seq whose acknowledgment ends the RTT sample */
+	uint32_t rtt_start;	/* Start time of the RTT sample, in ms */
+	uint32_t srtt;		/* Smoothed RTT in ms, 0 if not measured yet */
+#endif
+#ifdef CONFIG_NET_TCP_SACK
+	struct tcp_sack_block sacked[NET_TCP_MAX_SACK_BLOCKS]; /* Scoreboard */
+	uint8_t sacked_count;
+#endif
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+	uint8_t rcv_wscale;	/* Shift of the window we advertise */
+	uint8_t snd_wscale;	/* Shift of the window the peer advertises */
+#endif
 #ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
 	uint16_t rto;
 #endif
@@ -281,6 +349,12 @@ struct tcp { /* TCP connection */
 	bool in_connect : 1;
 	bool in_close : 1;
 	bool tcp_nodelay : 1;
+	bool wscale_ok : 1;	/* Window scaling offered or negotiated */
+	bool sack_ok : 1;	/* SACK offered or negotiated */
+#ifdef CONFIG_NET_TCP_CONGESTION_CONTROL
+	bool in_recovery : 1;
+	bool rtt_pending : 1;
+#endif
 };
 
 #define _flags(_fl, _op, _mask, _cond)					\
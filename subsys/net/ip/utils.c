@@ -486,29 +486,58 @@ int z_vrfy_net_addr_pton(sa_family_t family, const char *src,
 #include <syscalls/net_addr_pton_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+/* Sum the data 32 bits at a time in native byte order and fold the result
+ * at the end. The one's complement sum does not depend on the byte order,
+ * RFC 1071 ch 2 (B), so it only needs swapping once to be added to the
+ * big endian sum of the caller.
+ */
 static uint16_t calc_chksum(uint16_t sum, const uint8_t *data, size_t len)
 {
-	const uint8_t *end;
+	uint64_t acc = 0U;
 	uint16_t tmp;
 
-	end = data + len - 1;
+	while (len >= 16U) {
+		acc += UNALIGNED_GET((const uint32_t *)data);
+		acc += UNALIGNED_GET((const uint32_t *)(data + 4));
+		acc += UNALIGNED_GET((const uint32_t *)(data + 8));
+		acc += UNALIGNED_GET((const uint32_t *)(data + 12));
 
-	while (data < end) {
-		tmp = (data[0] << 8) + data[1];
-		sum += tmp;
-		if (sum < tmp) {
-			sum++;
-		}
+		data += 16;
+		len -= 16U;
+	}
+
+	while (len >= 4U) {
+		acc += UNALIGNED_GET((const uint32_t *)data);
+
+		data += 4;
+		len -= 4U;
+	}
+
+	if (len >= 2U) {
+		acc += UNALIGNED_GET((const uint16_t *)data);
 
 		data += 2;
+		len -= 2U;
 	}
 
-	if (data == end) {
-		tmp = data[0] << 8;
-		sum += tmp;
-		if (sum < tmp) {
-			sum++;
-		}
+	if (len) {
+		/* The last byte is the high byte of a big endian word */
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+		acc += data[0];
+#else
+		acc += (uint16_t)data[0] << 8;
+#endif
+	}
+
+	acc = (acc & 0xffffffff) + (acc >> 32);
+	acc = (acc & 0xffffffff) + (acc >> 32);
+	acc = (acc & 0xffff) + (acc >> 16);
+	acc = (acc & 0xffff) + (acc >> 16);
+
+	tmp = ntohs((uint16_t)acc);
+	sum += tmp;
+	if (sum < tmp) {
+		sum++;
 	}
 
 	return sum;
@@ -22,32 +22,45 @@ LOG_MODULE_REGISTER(net_arp, CONFIG_NET_ARP_LOG_LEVEL);
 
 #define NET_BUF_TIMEOUT K_MSEC(100)
 #define ARP_REQUEST_TIMEOUT (2 * MSEC_PER_SEC)
+#define ARP_TABLE_BUCKETS (CONFIG_NET_ARP_TABLE_SIZE / 4 + 1)
 
 static bool arp_cache_initialized;
 static struct arp_entry arp_entries[CONFIG_NET_ARP_TABLE_SIZE];
 
 static sys_slist_t arp_free_entries;
 static sys_slist_t arp_pending_entries;
-static sys_slist_t arp_table;
+static sys_slist_t arp_table[ARP_TABLE_BUCKETS];
 
 struct k_work_delayable arp_request_timer;
 
+static inline sys_slist_t *arp_table_bucket(struct in_addr *addr)
+{
+	uint32_t hash = UNALIGNED_GET(&addr->s_addr) * 2654435761U;
+
+	return &arp_table[(hash >> 16) % ARP_TABLE_BUCKETS];
+}
+
 static void arp_entry_cleanup(struct arp_entry *entry, bool pending)
 {
 	NET_DBG("%p", entry);
 
 	if (pending) {
-		NET_DBG("Releasing pending pkt %p (ref %ld)",
-			entry->pending,
-			atomic_get(&entry->pending->atomic_ref) - 1);
-		net_pkt_unref(entry->pending);
-		entry->pending = NULL;
+		for (int i = 0; i < ARRAY_SIZE(entry->pending); i++) {
+			if (!entry->pending[i]) {
+				break;
+			}
+
+			NET_DBG("Releasing pending pkt %p (ref %ld)",
+				entry->pending[i],
+				atomic_get(&entry->pending[i]->atomic_ref) - 1);
+			net_pkt_unref(entry->pending[i]);
+		}
 	}
 
 	entry->iface = NULL;
 
 	(void)memset(&entry->ip, 0, sizeof(struct in_addr));
-	(void)memset(&entry->eth, 0, sizeof(struct net_eth_addr));
+	(void)memset(entry->pending, 0, sizeof(entry->pending));
 }
 
 static struct arp_entry *arp_entry_find(sys_slist_t *list,
@@ -77,22 +90,25 @@ static struct arp_entry *arp_entry_find(sys_slist_t *list,
 static inline struct arp_entry *arp_entry_find_move_first(struct net_if *iface,
 							  struct in_addr *dst)
 {
+	sys_slist_t *bucket = arp_table_bucket(dst);
 	sys_snode_t *prev = NULL;
 	struct arp_entry *entry;
 
 	NET_DBG("dst %s", net_sprint_ipv4_addr(dst));
 
-	entry = arp_entry_find(&arp_table, iface, dst, &prev);
+	entry = arp_entry_find(bucket, iface, dst, &prev);
 	if (entry) {
 		/* Let's assume the target is going to be accessed
 		 * more than once here in a short time frame. So we
-		 * place the entry first in position into the table
+		 * place the entry first in position into its bucket
 		 * in order to reduce subsequent find.
 		 */
-		if (&entry->node != sys_slist_peek_head(&arp_table)) {
-			sys_slist_remove(&arp_table, prev, &entry->node);
-			sys_slist_prepend(&arp_table, &entry->node);
+		if (&entry->node != sys_slist_peek_head(bucket)) {
+			sys_slist_remove(bucket, prev, &entry->node);
+			sys_slist_prepend(bucket, &entry->node);
 		}
+
+		entry->req_start = k_uptime_get_32();
 	}
 
 	return entry;
@@ -145,23 +161,32 @@ static struct arp_entry *arp_entry_get_free(void)
 
 static struct arp_entry *arp_entry_get_last_from_table(void)
 {
-	sys_snode_t *node;
+	struct arp_entry *entry, *oldest = NULL;
+	sys_slist_t *oldest_bucket = NULL;
 
-	/* We assume last entry is the oldest one,
-	 * so is the preferred one to be taken out.
+	/* The least recently used entry is the preferred one to be
+	 * taken out. This only happens when the table is full.
 	 */
+	for (int i = 0; i < ARRAY_SIZE(arp_table); i++) {
+		SYS_SLIST_FOR_EACH_CONTAINER(&arp_table[i], entry, node) {
+			if (!oldest ||
+			    (int32_t)(entry->req_start - oldest->req_start) < 0) {
+				oldest = entry;
+				oldest_bucket = &arp_table[i];
+			}
+		}
+	}
 
-	node = sys_slist_peek_tail(&arp_table);
-	if (!node) {
+	if (!oldest) {
 		return NULL;
 	}
 
-	sys_slist_find_and_remove(&arp_table, node);
+	sys_slist_find_and_remove(oldest_bucket, &oldest->node);
+	arp_entry_cleanup(oldest, false);
 
-	return CONTAINER_OF(node, struct arp_entry, node);
+	return oldest;
 }
 
-
 static void arp_entry_register_pending(struct arp_entry *entry)
 {
 	NET_DBG("dst %s", net_sprint_ipv4_addr(&entry->ip));
@@ -177,6 +202,24 @@ static void arp_entry_register_pending(struct arp_entry *entry)
 	}
 }
 
+/* Queue a packet to send once the address of a pending entry is resolved */
+static bool arp_entry_add_pending(struct arp_entry *entry,
+				  struct net_pkt *pkt)
+{
+	for (int i = 0; i < ARRAY_SIZE(entry->pending); i++) {
+		if (entry->pending[i] == pkt) {
+			return true;
+		}
+
+		if (!entry->pending[i]) {
+			entry->pending[i] = net_pkt_ref(pkt);
+			return true;
+		}
+	}
+
+	return false;
+}
+
 static void arp_request_timeout(struct k_work *work)
 {
 	uint32_t current = k_uptime_get_32();
@@ -271,7 +314,8 @@ static inline struct net_pkt *arp_prepare(struct net_if *iface,
 	 * request and we want to send it again.
 	 */
 	if (entry) {
-		entry->pending = net_pkt_ref(pending);
+		(void)memset(entry->pending, 0, sizeof(entry->pending));
+		entry->pending[0] = net_pkt_ref(pending);
 		entry->iface = net_pkt_iface(pkt);
 
 		net_ipaddr_copy(&entry->ip, next_addr);
@@ -369,7 +413,14 @@ struct net_pkt *net_arp_prepare(struct net_pkt *pkt,
 				entry = arp_entry_get_last_from_table();
 			}
 		} else {
-			/* There is a pending already */
+			/* There is a pending already, the packet is sent
+			 * with the others once the reply is received.
+			 */
+			if (!current_ip && !arp_entry_add_pending(entry, pkt)) {
+				NET_DBG("Too many pending pkts for %s",
+					net_sprint_ipv4_addr(addr));
+			}
+
 			entry = NULL;
 		}
 
@@ -377,9 +428,8 @@ struct net_pkt *net_arp_prepare(struct net_pkt *pkt,
 				  current_ip);
 
 		if (!entry) {
-			/* We cannot send the packet, the ARP cache is full
-			 * or there is already a pending query to this IP
-			 * address, so this packet must be discarded.
+			/* The ARP cache is full or there is already a
+			 * pending query to this IP address.
 			 */
 			NET_DBG("Resending ARP %p", req);
 		}
@@ -406,10 +456,9 @@ static void arp_gratuitous(struct net_if *iface,
 			   struct in_addr *src,
 			   struct net_eth_addr *hwaddr)
 {
-	sys_snode_t *prev = NULL;
 	struct arp_entry *entry;
 
-	entry = arp_entry_find(&arp_table, iface, src, &prev);
+	entry = arp_entry_find(arp_table_bucket(src), iface, src, NULL);
 	if (entry) {
 		NET_DBG("Gratuitous ARP hwaddr %s -> %s",
 			net_sprint_ll_addr((const uint8_t *)&entry->eth,
@@ -418,6 +467,7 @@ static void arp_gratuitous(struct net_if *iface,
 					   sizeof(struct net_eth_addr)));
 
 		memcpy(&entry->eth, hwaddr, sizeof(struct net_eth_addr));
+		entry->req_start = k_uptime_get_32();
 	}
 }
 
@@ -427,6 +477,7 @@ static void arp_update(struct net_if *iface,
 		       bool gratuitous,
 		       bool force)
 {
+	struct net_pkt *pending[CONFIG_NET_ARP_PENDING_COUNT];
 	struct arp_entry *entry;
 	struct net_pkt *pkt;
 
@@ -439,13 +490,14 @@ static void arp_update(struct net_if *iface,
 		}
 
 		if (force) {
-			sys_snode_t *prev = NULL;
 			struct arp_entry *entry;
 
-			entry = arp_entry_find(&arp_table, iface, src, &prev);
+			entry = arp_entry_find(arp_table_bucket(src), iface,
+					       src, NULL);
 			if (entry) {
 				memcpy(&entry->eth, hwaddr,
 				       sizeof(struct net_eth_addr));
+				entry->req_start = k_uptime_get_32();
 			} else {
 				/* Add new entry as it was not found and force
 				 * was set.
@@ -461,7 +513,8 @@ static void arp_update(struct net_if *iface,
 					entry->iface = iface;
 					net_ipaddr_copy(&entry->ip, src);
 					memcpy(&entry->eth, hwaddr, sizeof(entry->eth));
-					sys_slist_prepend(&arp_table, &entry->node);
+					sys_slist_prepend(arp_table_bucket(src),
+							  &entry->node);
 				}
 			}
 		}
@@ -469,24 +522,29 @@ static void arp_update(struct net_if *iface,
 		return;
 	}
 
-	/* Set the dst in the pending packet */
-	net_pkt_lladdr_dst(entry->pending)->len = sizeof(struct net_eth_addr);
-	net_pkt_lladdr_dst(entry->pending)->addr =
-		(uint8_t *) &NET_ETH_HDR(entry->pending)->dst.addr;
-
-	NET_DBG("dst %s pending %p frag %p",
-		net_sprint_ipv4_addr(&entry->ip),
-		entry->pending, entry->pending->frags);
-
-	pkt = entry->pending;
-	entry->pending = NULL;
+	/* The pending packets share their storage with the hwaddr */
+	memcpy(pending, entry->pending, sizeof(pending));
 
 	memcpy(&entry->eth, hwaddr, sizeof(struct net_eth_addr));
+	entry->req_start = k_uptime_get_32();
 
 	/* Inserting entry into the table */
-	sys_slist_prepend(&arp_table, &entry->node);
+	sys_slist_prepend(arp_table_bucket(src), &entry->node);
+
+	for (int i = 0; i < ARRAY_SIZE(pending) && pending[i]; i++) {
+		pkt = pending[i];
+
+		/* Set the dst in the pending packet */
+		net_pkt_lladdr_dst(pkt)->len = sizeof(struct net_eth_addr);
+		net_pkt_lladdr_dst(pkt)->addr =
+			(uint8_t *) &NET_ETH_HDR(pkt)->dst.addr;
+
+		NET_DBG("dst %s pending %p frag %p",
+			net_sprint_ipv4_addr(&entry->ip),
+			pkt, pkt->frags);
 
-	net_if_queue_tx(iface, pkt);
+		net_if_queue_tx(iface, pkt);
+	}
 }
 
 static inline struct net_pkt *arp_prepare_reply(struct net_if *iface,
@@ -676,16 +734,21 @@ void net_arp_clear_cache(struct net_if *iface)
 
 	NET_DBG("Flushing ARP table");
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&arp_table, entry, next, node) {
-		if (iface && iface != entry->iface) {
-			prev = &entry->node;
-			continue;
-		}
+	for (int i = 0; i < ARRAY_SIZE(arp_table); i++) {
+		prev = NULL;
 
-		arp_entry_cleanup(entry, false);
+		SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&arp_table[i], entry, next,
+						  node) {
+			if (iface && iface != entry->iface) {
+				prev = &entry->node;
+				continue;
+			}
 
-		sys_slist_remove(&arp_table, prev, &entry->node);
-		sys_slist_prepend(&arp_free_entries, &entry->node);
+			arp_entry_cleanup(entry, false);
+
+			sys_slist_remove(&arp_table[i], prev, &entry->node);
+			sys_slist_prepend(&arp_free_entries, &entry->node);
+		}
 	}
 
 	prev = NULL;
@@ -715,9 +778,11 @@ int net_arp_foreach(net_arp_cb_t cb, void *user_data)
 	int ret = 0;
 	struct arp_entry *entry;
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&arp_table, entry, node) {
-		ret++;
-		cb(entry, user_data);
+	for (int i = 0; i < ARRAY_SIZE(arp_table); i++) {
+		SYS_SLIST_FOR_EACH_CONTAINER(&arp_table[i], entry, node) {
+			ret++;
+			cb(entry, user_data);
+		}
 	}
 
 	return ret;
@@ -733,7 +798,9 @@ void net_arp_init(void)
 
 	sys_slist_init(&arp_free_entries);
 	sys_slist_init(&arp_pending_entries);
-	sys_slist_init(&arp_table);
+	for (i = 0; i < ARRAY_SIZE(arp_table); i++) {
+		sys_slist_init(&arp_table[i]);
+	}
 
 	for (i = 0; i < CONFIG_NET_ARP_TABLE_SIZE; i++) {
 		/* Inserting entry as free */
@@ -51,11 +51,14 @@ enum net_verdict net_arp_input(struct net_pkt *pkt,
 
 struct arp_entry {
 	sys_snode_t node;
+	/* Time the request was sent if the entry is pending, else the time
+	 * the entry was last used or refreshed.
+	 */
 	uint32_t req_start;
 	struct net_if *iface;
 	struct in_addr ip;
 	union {
-		struct net_pkt *pending;
+		struct net_pkt *pending[CONFIG_NET_ARP_PENDING_COUNT];
 		struct net_eth_addr eth;
 	};
 };
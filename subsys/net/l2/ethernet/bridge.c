@@ -15,8 +15,24 @@ LOG_MODULE_REGISTER(net_eth_bridge, CONFIG_NET_ETHERNET_BRIDGE_LOG_LEVEL);
 
 #include <zephyr/sys/slist.h>
 
+#include <string.h>
+
+#include "net_private.h"
 #include "bridge.h"
 
+/* Each bucket of the forwarding database is a set of FDB_WAYS entries */
+#define FDB_WAYS 4
+#define FDB_BUCKETS (CONFIG_NET_ETHERNET_BRIDGE_FDB_SIZE / FDB_WAYS)
+#define FDB_AGING_TIME_MS (CONFIG_NET_ETHERNET_BRIDGE_FDB_AGING_TIME * \
+			   MSEC_PER_SEC)
+#define FDB_AGING_PERIOD_MS (FDB_AGING_TIME_MS / 4)
+
+BUILD_ASSERT((CONFIG_NET_ETHERNET_BRIDGE_FDB_SIZE % FDB_WAYS) == 0,
+	     "The FDB size must be a multiple of 4");
+
+static void fdb_aging_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(fdb_aging_work, fdb_aging_handler);
+
 extern struct eth_bridge _eth_bridge_list_start[];
 extern struct eth_bridge _eth_bridge_list_end[];
 
@@ -50,6 +66,203 @@ struct eth_bridge *eth_bridge_get_by_index(int index)
 	return &_eth_bridge_list_start[index - 1];
 }
 
+static uint32_t fdb_hash(const uint8_t *addr, uint16_t vlan)
+{
+	/* FNV-1a */
+	uint32_t hash = 2166136261U;
+
+	for (int i = 0; i < sizeof(struct net_eth_addr); i++) {
+		hash = (hash ^ addr[i]) * 16777619U;
+	}
+
+	hash = (hash ^ vlan) * 16777619U;
+
+	return hash % FDB_BUCKETS;
+}
+
+static inline bool fdb_entry_expired(struct eth_bridge_fdb_entry *entry,
+				     uint32_t now)
+{
+	return (uint32_t)(now - entry->last_seen) >= FDB_AGING_TIME_MS;
+}
+
+static void fdb_offload(struct eth_bridge_fdb_entry *entry, bool add)
+{
+#if defined(CONFIG_NET_ETHERNET_BRIDGE_FDB_OFFLOAD)
+	const struct device *dev = net_if_get_device(entry->iface);
+	const struct ethernet_api *api = dev->api;
+	int ret;
+
+	if (api->bridge_fdb_update == NULL || entry->offloaded == add) {
+		return;
+	}
+
+	ret = api->bridge_fdb_update(dev, entry->addr, entry->vlan, add);
+	if (ret < 0) {
+		NET_DBG("iface %p cannot %s %s vlan %d (%d)", entry->iface,
+			add ? "offload" : "remove",
+			net_sprint_ll_addr(entry->addr, sizeof(entry->addr)),
+			entry->vlan, ret);
+		return;
+	}
+
+	entry->offloaded = add;
+#endif
+}
+
+/* Must be invoked with bridge lock held */
+static void fdb_entry_remove(struct eth_bridge_fdb_entry *entry)
+{
+	fdb_offload(entry, false);
+	entry->iface = NULL;
+	entry->offloaded = false;
+}
+
+/* Must be invoked with bridge lock held */
+static struct eth_bridge_fdb_entry *fdb_lookup(struct eth_bridge *br,
+					       const uint8_t *addr,
+					       uint16_t vlan)
+{
+	struct eth_bridge_fdb_entry *bucket =
+		&br->fdb[fdb_hash(addr, vlan) * FDB_WAYS];
+
+	for (int i = 0; i < FDB_WAYS; i++) {
+		if (bucket[i].iface != NULL && bucket[i].vlan == vlan &&
+		    memcmp(bucket[i].addr, addr, sizeof(bucket[i].addr)) == 0) {
+			return &bucket[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Must be invoked with bridge lock held */
+static void fdb_learn(struct eth_bridge *br, struct net_if *iface,
+		      const uint8_t *addr, uint16_t vlan)
+{
+	struct eth_bridge_fdb_entry *bucket, *entry;
+	uint32_t now = k_uptime_get_32();
+
+	entry = fdb_lookup(br, addr, vlan);
+	if (entry != NULL) {
+		entry->last_seen = now;
+
+		if (entry->iface == iface) {
+			return;
+		}
+
+		/* The station moved to another interface */
+		fdb_offload(entry, false);
+		entry->offloaded = false;
+		entry->iface = iface;
+		fdb_offload(entry, true);
+		return;
+	}
+
+	/* Use a free or expired entry of the bucket, else replace the
+	 * least recently seen one.
+	 */
+	bucket = &br->fdb[fdb_hash(addr, vlan) * FDB_WAYS];
+	entry = &bucket[0];
+
+	for (int i = 0; i < FDB_WAYS; i++) {
+		if (bucket[i].iface == NULL ||
+		    fdb_entry_expired(&bucket[i], now)) {
+			entry = &bucket[i];
+			break;
+		}
+
+		if ((int32_t)(bucket[i].last_seen - entry->last_seen) < 0) {
+			entry = &bucket[i];
+		}
+	}
+
+	if (entry->iface != NULL) {
+		fdb_entry_remove(entry);
+	}
+
+	memcpy(entry->addr, addr, sizeof(entry->addr));
+	entry->vlan = vlan;
+	entry->iface = iface;
+	entry->last_seen = now;
+	fdb_offload(entry, true);
+
+	NET_DBG("learned %s vlan %d on iface %p",
+		net_sprint_ll_addr(addr, sizeof(entry->addr)), vlan, iface);
+
+	k_work_schedule(&fdb_aging_work,
+			K_MSEC(FDB_AGING_PERIOD_MS));
+}
+
+/* Must be invoked with bridge lock held */
+static void fdb_flush_iface(struct eth_bridge *br, struct net_if *iface)
+{
+	for (int i = 0; i < ARRAY_SIZE(br->fdb); i++) {
+		if (br->fdb[i].iface != NULL &&
+		    (iface == NULL || br->fdb[i].iface == iface)) {
+			fdb_entry_remove(&br->fdb[i]);
+		}
+	}
+}
+
+/* Forget the expired addresses, so that they are also removed from
+ * the hardware they were offloaded to.
+ */
+static void fdb_aging_handler(struct k_work *work)
+{
+	uint32_t now = k_uptime_get_32();
+	bool pending = false;
+
+	ARG_UNUSED(work);
+
+	STRUCT_SECTION_FOREACH(eth_bridge, br) {
+		k_mutex_lock(&br->lock, K_FOREVER);
+
+		for (int i = 0; i < ARRAY_SIZE(br->fdb); i++) {
+			if (br->fdb[i].iface == NULL) {
+				continue;
+			}
+
+			if (fdb_entry_expired(&br->fdb[i], now)) {
+				fdb_entry_remove(&br->fdb[i]);
+			} else {
+				pending = true;
+			}
+		}
+
+		k_mutex_unlock(&br->lock);
+	}
+
+	if (pending) {
+		k_work_schedule(&fdb_aging_work,
+				K_MSEC(FDB_AGING_PERIOD_MS));
+	}
+}
+
+void eth_bridge_fdb_foreach(struct eth_bridge *br, eth_bridge_fdb_cb_t cb,
+			    void *user_data)
+{
+	uint32_t now = k_uptime_get_32();
+
+	k_mutex_lock(&br->lock, K_FOREVER);
+
+	for (int i = 0; i < ARRAY_SIZE(br->fdb); i++) {
+		if (br->fdb[i].iface != NULL &&
+		    !fdb_entry_expired(&br->fdb[i], now)) {
+			cb(br, &br->fdb[i], user_data);
+		}
+	}
+
+	k_mutex_unlock(&br->lock);
+}
+
+void eth_bridge_fdb_flush(struct eth_bridge *br)
+{
+	k_mutex_lock(&br->lock, K_FOREVER);
+	fdb_flush_iface(br, NULL);
+	k_mutex_unlock(&br->lock);
+}
+
 int eth_bridge_iface_add(struct eth_bridge *br, struct net_if *iface)
 {
 	struct ethernet_context *ctx = net_if_l2_data(iface);
@@ -68,6 +281,9 @@ int eth_bridge_iface_add(struct eth_bridge *br, struct net_if *iface)
 
 	ctx->bridge.instance = br;
 	ctx->bridge.allow_tx = false;
+#if defined(CONFIG_NET_ETHERNET_BRIDGE_VLAN_FILTERING)
+	memset(ctx->bridge.vlans, 0, sizeof(ctx->bridge.vlans));
+#endif
 	sys_slist_append(&br->interfaces, &ctx->bridge.node);
 
 	k_mutex_unlock(&br->lock);
@@ -101,6 +317,7 @@ int eth_bridge_iface_remove(struct eth_bridge *br, struct net_if *iface)
 
 	sys_slist_find_and_remove(&br->interfaces, &ctx->bridge.node);
 	ctx->bridge.instance = NULL;
+	fdb_flush_iface(br, iface);
 
 	k_mutex_unlock(&br->lock);
 
@@ -137,6 +354,136 @@ int eth_bridge_listener_remove(struct eth_bridge *br, struct eth_bridge_listener
 	return 0;
 }
 
+#if defined(CONFIG_NET_ETHERNET_BRIDGE_VLAN_FILTERING)
+static bool vlan_allowed(struct ethernet_context *ctx, uint16_t vlan)
+{
+	bool filtered = false;
+
+	if (vlan == 0) {
+		return true;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(ctx->bridge.vlans); i++) {
+		if (ctx->bridge.vlans[i] == vlan) {
+			return true;
+		}
+
+		if (ctx->bridge.vlans[i] != 0) {
+			filtered = true;
+		}
+	}
+
+	return !filtered;
+}
+
+int eth_bridge_iface_vlan_add(struct net_if *iface, uint16_t vlan)
+{
+	struct ethernet_context *ctx = net_if_l2_data(iface);
+	struct eth_bridge *br;
+	int ret = -ENOMEM;
+
+	if (net_if_l2(iface) != &NET_L2_GET_NAME(ETHERNET) ||
+	    ctx->bridge.instance == NULL || vlan == 0 ||
+	    vlan >= NET_VLAN_TAG_UNSPEC) {
+		return -EINVAL;
+	}
+
+	br = ctx->bridge.instance;
+	k_mutex_lock(&br->lock, K_FOREVER);
+
+	for (int i = 0; i < ARRAY_SIZE(ctx->bridge.vlans); i++) {
+		if (ctx->bridge.vlans[i] == vlan) {
+			ret = -EALREADY;
+			goto out;
+		}
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(ctx->bridge.vlans); i++) {
+		if (ctx->bridge.vlans[i] == 0) {
+			ctx->bridge.vlans[i] = vlan;
+			ret = 0;
+			break;
+		}
+	}
+
+out:
+	k_mutex_unlock(&br->lock);
+
+	return ret;
+}
+
+int eth_bridge_iface_vlan_remove(struct net_if *iface, uint16_t vlan)
+{
+	struct ethernet_context *ctx = net_if_l2_data(iface);
+	struct eth_bridge *br;
+	int ret = -ENOENT;
+
+	if (net_if_l2(iface) != &NET_L2_GET_NAME(ETHERNET) ||
+	    ctx->bridge.instance == NULL || vlan == 0) {
+		return -EINVAL;
+	}
+
+	br = ctx->bridge.instance;
+	k_mutex_lock(&br->lock, K_FOREVER);
+
+	for (int i = 0; i < ARRAY_SIZE(ctx->bridge.vlans); i++) {
+		if (ctx->bridge.vlans[i] == vlan) {
+			ctx->bridge.vlans[i] = 0;
+			ret = 0;
+			break;
+		}
+	}
+
+	if (ret == 0) {
+		for (int i = 0; i < ARRAY_SIZE(br->fdb); i++) {
+			if (br->fdb[i].iface == iface &&
+			    br->fdb[i].vlan == vlan) {
+				fdb_entry_remove(&br->fdb[i]);
+			}
+		}
+	}
+
+	k_mutex_unlock(&br->lock);
+
+	return ret;
+}
+#else
+static inline bool vlan_allowed(struct ethernet_context *ctx, uint16_t vlan)
+{
+	return true;
+}
+
+int eth_bridge_iface_vlan_add(struct net_if *iface, uint16_t vlan)
+{
+	return -ENOTSUP;
+}
+
+int eth_bridge_iface_vlan_remove(struct net_if *iface, uint16_t vlan)
+{
+	return -ENOTSUP;
+}
+#endif /* CONFIG_NET_ETHERNET_BRIDGE_VLAN_FILTERING */
+
+/* VLAN of a received frame, 0 if it is untagged or priority tagged */
+static uint16_t get_vlan(struct net_pkt *pkt)
+{
+	struct net_eth_hdr *hdr = NET_ETH_HDR(pkt);
+	uint16_t vlan;
+
+	if (ntohs(hdr->type) == NET_ETH_PTYPE_VLAN &&
+	    pkt->buffer->len >= sizeof(struct net_eth_vlan_hdr)) {
+		struct net_eth_vlan_hdr *hdr_vlan =
+			(struct net_eth_vlan_hdr *)hdr;
+
+		vlan = net_eth_vlan_get_vid(ntohs(hdr_vlan->vlan.tci));
+	} else {
+		/* The tag may have been stripped by the driver */
+		vlan = net_pkt_vlan_tag(pkt);
+	}
+
+	return vlan == NET_VLAN_TAG_UNSPEC ? 0 : vlan;
+}
+
 static inline bool is_link_local_addr(struct net_eth_addr *addr)
 {
 	if (addr->addr[0] == 0x01 &&
@@ -155,20 +502,42 @@ enum net_verdict net_eth_bridge_input(struct ethernet_context *ctx,
 				      struct net_pkt *pkt)
 {
 	struct eth_bridge *br = ctx->bridge.instance;
+	uint8_t *dst = net_pkt_lladdr_dst(pkt)->addr;
+	uint8_t *src = net_pkt_lladdr_src(pkt)->addr;
+	struct eth_bridge_fdb_entry *entry = NULL;
+	uint16_t vlan = get_vlan(pkt);
 	sys_snode_t *node;
 
 	NET_DBG("new pkt %p", pkt);
 
 	/* Drop all link-local packets for now. */
-	if (is_link_local_addr((struct net_eth_addr *)net_pkt_lladdr_dst(pkt))) {
+	if (is_link_local_addr((struct net_eth_addr *)dst)) {
+		return NET_DROP;
+	}
+
+	if (!vlan_allowed(ctx, vlan)) {
+		NET_DBG("pkt %p vlan %d filtered", pkt, vlan);
 		return NET_DROP;
 	}
 
 	k_mutex_lock(&br->lock, K_FOREVER);
 
+	/* Group addresses are never the source of a frame */
+	if (!(src[0] & 0x01)) {
+		fdb_learn(br, ctx->iface, src, vlan);
+	}
+
+	if (!(dst[0] & 0x01)) {
+		entry = fdb_lookup(br, dst, vlan);
+		if (entry != NULL &&
+		    fdb_entry_expired(entry, k_uptime_get_32())) {
+			entry = NULL;
+		}
+	}
+
 	/*
-	 * Send packet to all registered interfaces for now.
-	 * Eventually we could get smarter with a MAC address cache.
+	 * Send the packet only via the interface its destination was
+	 * learned on, or else to all registered interfaces.
 	 */
 	SYS_SLIST_FOR_EACH_NODE(&br->interfaces, node) {
 		struct ethernet_context *out_ctx;
@@ -181,11 +550,21 @@ enum net_verdict net_eth_bridge_input(struct ethernet_context *ctx,
 			continue;
 		}
 
+		/* Skip it if the destination is known to be elsewhere */
+		if (entry != NULL && entry->iface != out_ctx->iface) {
+			continue;
+		}
+
 		/* Skip it if not allowed to transmit */
 		if (!out_ctx->bridge.allow_tx) {
 			continue;
 		}
 
+		/* Skip it if the VLAN is filtered */
+		if (!vlan_allowed(out_ctx, vlan)) {
+			continue;
+		}
+
 		/* Skip it if not up */
 		if (!net_if_flag_is_set(out_ctx->iface, NET_IF_UP)) {
 			continue;
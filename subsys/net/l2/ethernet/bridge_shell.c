@@ -5,6 +5,7 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 #include <zephyr/shell/shell.h>
 #include <zephyr/net/net_if.h>
 #include <zephyr/net/ethernet.h>
@@ -201,6 +202,91 @@ static int cmd_bridge_show(const struct shell *sh, size_t argc, char *argv[])
 	return 0;
 }
 
+static void fdb_entry_show(struct eth_bridge *br,
+			   const struct eth_bridge_fdb_entry *entry,
+			   void *data)
+{
+	const struct shell *sh = data;
+	uint32_t age = (k_uptime_get_32() - entry->last_seen) / MSEC_PER_SEC;
+
+	shell_fprintf(sh, SHELL_NORMAL,
+		      "%-10d%02x:%02x:%02x:%02x:%02x:%02x %-6d%-10d%-6u%s\n",
+		      eth_bridge_get_index(br),
+		      entry->addr[0], entry->addr[1], entry->addr[2],
+		      entry->addr[3], entry->addr[4], entry->addr[5],
+		      entry->vlan, net_if_get_by_iface(entry->iface), age,
+		      entry->offloaded ? "*" : "");
+}
+
+static void bridge_fdb_show(struct eth_bridge *br, void *data)
+{
+	eth_bridge_fdb_foreach(br, fdb_entry_show, data);
+}
+
+static int cmd_bridge_fdb(const struct shell *sh, size_t argc, char *argv[])
+{
+	int br_idx;
+	struct eth_bridge *br = NULL;
+
+	if (argc == 2) {
+		br_idx = get_idx(sh, argv[1]);
+		if (br_idx < 0) {
+			return br_idx;
+		}
+		br = eth_bridge_get_by_index(br_idx);
+		if (br == NULL) {
+			shell_warn(sh, "Bridge %d not found\n", br_idx);
+			return -ENOENT;
+		}
+	}
+
+	shell_fprintf(sh, SHELL_NORMAL,
+		      "bridge    address           vlan  iface     age   offloaded\n");
+
+	if (br != NULL) {
+		bridge_fdb_show(br, (void *)sh);
+	} else {
+		net_eth_bridge_foreach(bridge_fdb_show, (void *)sh);
+	}
+
+	return 0;
+}
+
+static int cmd_bridge_vlan(const struct shell *sh, size_t argc, char *argv[])
+{
+	int if_idx, vlan, ret;
+	struct net_if *iface;
+
+	if_idx = get_idx(sh, argv[1]);
+	if (if_idx < 0) {
+		return if_idx;
+	}
+	vlan = get_idx(sh, argv[3]);
+	if (vlan < 0) {
+		return vlan;
+	}
+	iface = net_if_get_by_index(if_idx);
+	if (iface == NULL) {
+		shell_warn(sh, "Interface %d not found\n", if_idx);
+		return -ENOENT;
+	}
+
+	if (!strcmp(argv[2], "add")) {
+		ret = eth_bridge_iface_vlan_add(iface, vlan);
+	} else if (!strcmp(argv[2], "del")) {
+		ret = eth_bridge_iface_vlan_remove(iface, vlan);
+	} else {
+		shell_warn(sh, "Unknown action %s\n", argv[2]);
+		return -EINVAL;
+	}
+
+	if (ret < 0) {
+		shell_error(sh, "error: cannot %s vlan %d (%d)\n", argv[2],
+			    vlan, ret);
+	}
+	return ret;
+}
+
 SHELL_STATIC_SUBCMD_SET_CREATE(bridge_commands,
 	SHELL_CMD_ARG(addif, NULL,
 		  "Add a network interface to a bridge.\n"
@@ -218,6 +304,14 @@ SHELL_STATIC_SUBCMD_SET_CREATE(bridge_commands,
 		  "Show bridge information.\n"
 		  "'bridge show [<bridge_index>]'",
 		  cmd_bridge_show, 1, 1),
+	SHELL_CMD_ARG(fdb, NULL,
+		  "Show the MAC addresses learned by a bridge.\n"
+		  "'bridge fdb [<bridge_index>]'",
+		  cmd_bridge_fdb, 1, 1),
+	SHELL_CMD_ARG(vlan, NULL,
+		  "Allow/disallow a VLAN on a bridged interface.\n"
+		  "'bridge vlan <interface_index> {add|del} <vlan>'",
+		  cmd_bridge_vlan, 4, 0),
 	SHELL_SUBCMD_SET_END
 );
 
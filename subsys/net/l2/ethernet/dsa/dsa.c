@@ -13,6 +13,7 @@ LOG_MODULE_REGISTER(net_dsa, CONFIG_NET_DSA_LOG_LEVEL);
 
 #include <errno.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <zephyr/net/net_core.h>
 #include <zephyr/net/ethernet.h>
@@ -269,3 +270,69 @@ int dsa_switch_get_mac_table_entry(struct net_if *iface,
 
 	return api->switch_get_mac_table_entry(dev, buf, tbl_entry_idx);
 }
+
+#if defined(CONFIG_DSA_BRIDGE_FDB_OFFLOAD)
+static K_MUTEX_DEFINE(dsa_fdb_lock);
+
+int dsa_bridge_fdb_update(const struct device *dev, const uint8_t *mac,
+			  uint16_t vlan, bool add)
+{
+	static const uint8_t unused[6];
+	struct dsa_context *context = dev->data;
+	struct net_if *iface = net_if_lookup_by_dev(dev);
+	const struct ethernet_context *ctx;
+	int idx = -1;
+	int ret;
+
+	if (iface == NULL || context->dapi == NULL ||
+	    context->dapi->switch_set_mac_table_entry == NULL) {
+		return -ENOTSUP;
+	}
+
+	/* The static MAC table does not tell the VLAN of the entries */
+	if (vlan != 0) {
+		return -ENOTSUP;
+	}
+
+	ctx = net_if_l2_data(iface);
+
+	k_mutex_lock(&dsa_fdb_lock, K_FOREVER);
+
+	for (int i = 0; i < ARRAY_SIZE(context->fdb); i++) {
+		if (memcmp(context->fdb[i], mac, sizeof(context->fdb[i])) == 0) {
+			idx = i;
+			break;
+		}
+
+		if (idx < 0 && memcmp(context->fdb[i], unused,
+				      sizeof(unused)) == 0) {
+			idx = i;
+		}
+	}
+
+	if (idx < 0 || (!add && memcmp(context->fdb[idx], mac,
+				       sizeof(context->fdb[idx])) != 0)) {
+		ret = add ? -ENOSPC : -ENOENT;
+		goto out;
+	}
+
+	ret = context->dapi->switch_set_mac_table_entry(dev, mac,
+			BIT(ctx->dsa_port_idx),
+			CONFIG_DSA_BRIDGE_FDB_FIRST_ENTRY + idx,
+			add ? 0 : DSA_MAC_TABLE_ENTRY_INVALID);
+	if (ret < 0) {
+		goto out;
+	}
+
+	if (add) {
+		memcpy(context->fdb[idx], mac, sizeof(context->fdb[idx]));
+	} else {
+		memset(context->fdb[idx], 0, sizeof(context->fdb[idx]));
+	}
+
+out:
+	k_mutex_unlock(&dsa_fdb_lock);
+
+	return ret;
+}
+#endif /* CONFIG_DSA_BRIDGE_FDB_OFFLOAD */
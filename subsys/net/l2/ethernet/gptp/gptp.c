@@ -917,6 +917,8 @@ static void init_ports(void)
 	/* Only initialize the state machine once the ports are known. */
 	gptp_init_state_machine();
 
+	gptp_register_tx_timestamp_cb();
+
 	tid = k_thread_create(&gptp_thread_data, gptp_stack,
 			      K_KERNEL_STACK_SIZEOF(gptp_stack),
 			      (k_thread_entry_t)gptp_thread,
@@ -154,6 +154,43 @@ struct gptp_path_trace {
 	uint8_t path_sequence[GPTP_MAX_PATHTRACE_SIZE][GPTP_CLOCK_ID_LEN];
 };
 
+#if defined(CONFIG_NET_GPTP_USE_DEFAULT_CLOCK_UPDATE)
+/**
+ * @brief State and statistics of the servo updating the local clock.
+ */
+struct gptp_servo {
+	/** Integral term of the PI controller, in ppb. */
+	double integral;
+
+	/** Frequency correction applied on top of the rate ratio, in ppb. */
+	double freq_ppb;
+
+	/** Local time of the last sample, in ns. */
+	uint64_t last_local_time;
+
+	/** Offset from the master of the last sample, in ns. */
+	int64_t last_offset;
+
+	/** Moving average of the absolute offset, in ns. */
+	uint32_t mean_abs_offset;
+
+	/** Moving average of the offset variation between samples, in ns. */
+	uint32_t jitter;
+
+	/** Number of samples used since the local clock was last set. */
+	uint32_t samples;
+
+	/** Number of samples discarded as outliers. */
+	uint32_t outlier_count;
+
+	/** Number of times the local clock was set. */
+	uint32_t step_count;
+
+	/** Number of outliers discarded in a row. */
+	uint8_t consecutive_outliers;
+};
+#endif /* CONFIG_NET_GPTP_USE_DEFAULT_CLOCK_UPDATE */
+
 /**
  * @brief Per-time-aware system global variables.
  *
@@ -224,6 +261,11 @@ struct gptp_global_ds {
 	/** Selected port bit array. */
 	uint32_t selected_array;
 
+#if defined(CONFIG_NET_GPTP_USE_DEFAULT_CLOCK_UPDATE)
+	/** Servo of the local clock. */
+	struct gptp_servo servo;
+#endif
+
 	/** Steps removed from selected master. */
 	uint16_t master_steps_removed;
 
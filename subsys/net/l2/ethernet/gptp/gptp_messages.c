@@ -16,10 +16,13 @@ LOG_MODULE_DECLARE(net_gptp, CONFIG_NET_GPTP_LOG_LEVEL);
 
 #define NET_BUF_TIMEOUT K_MSEC(100)
 
-static struct net_if_timestamp_cb sync_timestamp_cb;
-static struct net_if_timestamp_cb pdelay_response_timestamp_cb;
-static bool sync_cb_registered;
-static bool ts_cb_registered;
+static struct net_if_timestamp_cb tx_timestamp_cb;
+
+/* Packets sent and waiting for their TX timestamp, per port. The slots
+ * hold a reference to the packets.
+ */
+static atomic_ptr_t sync_pending[CONFIG_NET_GPTP_NUM_PORTS];
+static atomic_ptr_t pdelay_resp_pending[CONFIG_NET_GPTP_NUM_PORTS];
 
 static const struct net_eth_addr gptp_multicast_eth_addr = {
 	{ 0x01, 0x80, 0xc2, 0x00, 0x00, 0x0e } };
@@ -78,66 +81,74 @@ struct gptp_hdr *gptp_get_hdr(struct net_pkt *pkt)
 	return (struct gptp_hdr *)buf->data;
 }
 
-static void gptp_sync_timestamp_callback(struct net_pkt *pkt)
+static void gptp_pdelay_response_timestamp(int port, struct net_pkt *pkt)
 {
-	int port = 0;
-	struct gptp_sync_send_state *state;
-	struct gptp_hdr *hdr;
+	struct net_pkt *follow_up;
 
-	port = gptp_get_port_number(net_pkt_iface(pkt));
-	if (port == -ENODEV) {
-		NET_DBG("No port found for ptp buffer");
+	follow_up = gptp_prepare_pdelay_follow_up(port, pkt);
+	if (!follow_up) {
+		/* Cannot handle the follow up, abort */
+		NET_ERR("Could not get buffer");
 		return;
 	}
 
-	state = &GPTP_PORT_STATE(port)->sync_send;
-
-	hdr = GPTP_HDR(pkt);
-
-	/* If this buffer is a sync, flag it to the state machine. */
-	if (hdr->message_type == GPTP_SYNC_MESSAGE) {
-		state->md_sync_timestamp_avail = true;
-
-		net_if_unregister_timestamp_cb(&sync_timestamp_cb);
-		sync_cb_registered = false;
-
-		/* The pkt was ref'ed in gptp_send_sync() */
-		net_pkt_unref(pkt);
-	}
+	gptp_send_pdelay_follow_up(port, follow_up, net_pkt_timestamp(pkt));
 }
 
-static void gptp_pdelay_response_timestamp_callback(struct net_pkt *pkt)
+/* Called by the TS thread for every timestamped packet sent. The packets
+ * waiting for their timestamp are found from the pending slots of their
+ * port, so the callback stays registered for good.
+ */
+static void gptp_tx_timestamp_callback(struct net_pkt *pkt)
 {
-	int port = 0;
-	struct net_pkt *follow_up;
-	struct gptp_hdr *hdr;
+	int port;
+	int idx;
 
 	port = gptp_get_port_number(net_pkt_iface(pkt));
 	if (port == -ENODEV) {
 		NET_DBG("No port found for ptp buffer");
-		goto out;
+		return;
 	}
 
-	hdr = GPTP_HDR(pkt);
+	idx = port - GPTP_PORT_START;
 
-	/* If this buffer is a path delay response, send the follow up. */
-	if (hdr->message_type == GPTP_PATH_DELAY_RESP_MESSAGE) {
-		follow_up = gptp_prepare_pdelay_follow_up(port, pkt);
-		if (!follow_up) {
-			/* Cannot handle the follow up, abort */
-			NET_ERR("Could not get buffer");
-			goto out;
-		}
+	/* The pending pkt was ref'ed in gptp_send_sync() or in
+	 * gptp_handle_pdelay_req().
+	 */
+	if (atomic_ptr_cas(&sync_pending[idx], pkt, NULL)) {
+		/* Flag the timestamp of the sync to the state machine. */
+		GPTP_PORT_STATE(port)->sync_send.md_sync_timestamp_avail = true;
+		net_pkt_unref(pkt);
+	} else if (atomic_ptr_cas(&pdelay_resp_pending[idx], pkt, NULL)) {
+		gptp_pdelay_response_timestamp(port, pkt);
+		net_pkt_unref(pkt);
+	}
+}
 
-		net_if_unregister_timestamp_cb(&pdelay_response_timestamp_cb);
-		ts_cb_registered = false;
+void gptp_register_tx_timestamp_cb(void)
+{
+	net_if_register_timestamp_cb(&tx_timestamp_cb, NULL, NULL,
+				     gptp_tx_timestamp_callback);
+}
 
-		gptp_send_pdelay_follow_up(port, follow_up,
-					   net_pkt_timestamp(pkt));
+/* Set the pkt waiting for its TX timestamp in a pending slot, releasing the
+ * one which never got its timestamp if any.
+ */
+static void gptp_set_pending(atomic_ptr_t *slot, struct net_pkt *pkt,
+			     const char *msg)
+{
+	struct net_pkt *old;
 
-out:
-		/* The pkt was ref'ed in gptp_handle_pdelay_req() */
-		net_pkt_unref(pkt);
+	/* TS thread will send this back to us so increment ref count so
+	 * that the packet is not removed when sending it. This will be
+	 * unref'ed by gptp_tx_timestamp_callback().
+	 */
+	net_pkt_ref(pkt);
+
+	old = atomic_ptr_set(slot, pkt);
+	if (old) {
+		NET_WARN("No TX timestamp for previous %s", msg);
+		net_pkt_unref(old);
 	}
 }
 
@@ -634,33 +645,14 @@ void gptp_handle_pdelay_req(int port, struct net_pkt *pkt)
 
 	GPTP_STATS_INC(port, rx_pdelay_req_count);
 
-	if (ts_cb_registered == true) {
-		NET_WARN("Multiple pdelay requests");
-
-		net_if_unregister_timestamp_cb(&pdelay_response_timestamp_cb);
-		net_pkt_unref(pdelay_response_timestamp_cb.pkt);
-
-		ts_cb_registered = false;
-	}
-
 	/* Prepare response and send */
 	reply = gptp_prepare_pdelay_resp(port, pkt);
 	if (!reply) {
 		return;
 	}
 
-	net_if_register_timestamp_cb(&pdelay_response_timestamp_cb,
-				     reply,
-				     net_pkt_iface(pkt),
-				     gptp_pdelay_response_timestamp_callback);
-
-	/* TS thread will send this back to us so increment ref count so that
-	 * the packet is not removed when sending it. This will be unref'ed by
-	 * timestamp callback in gptp_pdelay_response_timestamp_callback()
-	 */
-	net_pkt_ref(reply);
-
-	ts_cb_registered = true;
+	gptp_set_pending(&pdelay_resp_pending[port - GPTP_PORT_START], reply,
+			 "pdelay response");
 
 	gptp_send_pdelay_resp(port, reply, net_pkt_timestamp(pkt));
 }
@@ -816,22 +808,9 @@ void gptp_handle_signaling(int port, struct net_pkt *pkt)
 
 void gptp_send_sync(int port, struct net_pkt *pkt)
 {
-	if (!sync_cb_registered) {
-		net_if_register_timestamp_cb(&sync_timestamp_cb,
-					     pkt,
-					     net_pkt_iface(pkt),
-					     gptp_sync_timestamp_callback);
-		sync_cb_registered = true;
-	}
-
 	GPTP_STATS_INC(port, tx_sync_count);
 
-	/* TS thread will send this back to us so increment ref count
-	 * so that the packet is not removed when sending it.
-	 * This will be unref'ed by timestamp callback in
-	 * gptp_sync_timestamp_callback()
-	 */
-	net_pkt_ref(pkt);
+	gptp_set_pending(&sync_pending[port - GPTP_PORT_START], pkt, "sync");
 
 	NET_GPTP_INFO("SYNC", pkt);
 
@@ -437,6 +437,12 @@ int gptp_handle_pdelay_follow_up(int port, struct net_pkt *pkt);
  */
 void gptp_handle_signaling(int port, struct net_pkt *pkt);
 
+/**
+ * @brief Register the callback receiving the TX timestamps of the Sync
+ * and Path Delay Response messages sent.
+ */
+void gptp_register_tx_timestamp_cb(void);
+
 /* Functions to send messages. */
 
 /**
@@ -7,6 +7,7 @@
 #include <zephyr/logging/log.h>
 LOG_MODULE_DECLARE(net_gptp, CONFIG_NET_GPTP_LOG_LEVEL);
 
+#include <stdlib.h>
 #include <zephyr/drivers/ptp_clock.h>
 
 #include "gptp_messages.h"
@@ -730,20 +731,105 @@ static void gptp_mi_clk_slave_sync_compute(void)
 }
 
 #if defined(CONFIG_NET_GPTP_USE_DEFAULT_CLOCK_UPDATE)
+/* IEEE 802.1AS requires clocks to be within 100 ppm of the nominal rate */
+#define SERVO_MAX_PPB 100000.0
+
+/* Number of samples the moving averages are computed on */
+#define SERVO_AVG_SAMPLES 16
+
+/* Lower bound of the jitter used to detect the outliers */
+#define SERVO_OUTLIER_MIN_NS 50
+
+/* Outliers discarded in a row before following the offset again */
+#define SERVO_MAX_OUTLIERS 3
+
+/* Samples further apart than this do not update the servo */
+#define SERVO_MAX_INTERVAL_NS (16ULL * NSEC_PER_SEC)
+
+static uint32_t servo_avg(uint32_t avg, uint64_t value)
+{
+	value = MIN(value, UINT32_MAX);
+
+	return (int64_t)avg + ((int64_t)value - avg) / SERVO_AVG_SAMPLES;
+}
+
+bool gptp_servo_is_outlier(struct gptp_servo *servo, int64_t offset)
+{
+	uint64_t threshold;
+
+	if (CONFIG_NET_GPTP_SERVO_OUTLIER_FACTOR == 0 ||
+	    servo->samples < SERVO_AVG_SAMPLES) {
+		return false;
+	}
+
+	threshold = (uint64_t)CONFIG_NET_GPTP_SERVO_OUTLIER_FACTOR *
+		    MAX(servo->jitter, SERVO_OUTLIER_MIN_NS);
+
+	if (llabs(offset - servo->last_offset) <= threshold ||
+	    servo->consecutive_outliers >= SERVO_MAX_OUTLIERS) {
+		servo->consecutive_outliers = 0U;
+		return false;
+	}
+
+	servo->consecutive_outliers++;
+	servo->outlier_count++;
+
+	return true;
+}
+
+void gptp_servo_sample(struct gptp_servo *servo, int64_t offset,
+		       uint64_t local_time)
+{
+	uint64_t interval = local_time - servo->last_local_time;
+	double offset_ppb;
+
+	if (servo->samples > 0) {
+		servo->jitter = servo_avg(servo->jitter,
+					  llabs(offset - servo->last_offset));
+	}
+
+	servo->mean_abs_offset = servo_avg(servo->mean_abs_offset,
+					   llabs(offset));
+	servo->last_offset = offset;
+	servo->last_local_time = local_time;
+	servo->samples++;
+
+	if (servo->samples == 1 || interval == 0 ||
+	    interval > SERVO_MAX_INTERVAL_NS) {
+		return;
+	}
+
+	/* Frequency correcting the whole offset within one interval */
+	offset_ppb = (double)offset * NSEC_PER_SEC / interval;
+
+	servo->integral += offset_ppb * CONFIG_NET_GPTP_SERVO_KI / 1000;
+	servo->integral = CLAMP(servo->integral, -SERVO_MAX_PPB,
+				SERVO_MAX_PPB);
+
+	servo->freq_ppb = offset_ppb * CONFIG_NET_GPTP_SERVO_KP / 1000 +
+			  servo->integral;
+	servo->freq_ppb = CLAMP(servo->freq_ppb, -SERVO_MAX_PPB,
+				SERVO_MAX_PPB);
+}
+
 static void gptp_update_local_port_clock(void)
 {
 	struct gptp_clk_slave_sync_state *state;
 	struct gptp_global_ds *global_ds;
 	struct gptp_port_ds *port_ds;
+	struct gptp_servo *servo;
 	int port;
 	int64_t nanosecond_diff;
 	int64_t second_diff;
+	int64_t offset;
 	const struct device *clk;
 	struct net_ptp_time tm;
+	bool underflow = false;
 	unsigned int key;
 
 	state = &GPTP_STATE()->clk_slave_sync;
 	global_ds = GPTP_GLOBAL_DS();
+	servo = &global_ds->servo;
 	port = state->pss_rcv_ptr->local_port_number;
 	NET_ASSERT((port >= GPTP_PORT_START) && (port <= GPTP_PORT_END));
 
@@ -777,65 +863,70 @@ static void gptp_update_local_port_clock(void)
 		nanosecond_diff = -(int64_t)NSEC_PER_SEC + nanosecond_diff;
 	}
 
-	ptp_clock_rate_adjust(clk, port_ds->neighbor_rate_ratio);
+	offset = second_diff * NSEC_PER_SEC + nanosecond_diff;
 
-	/* If time difference is too high, set the clock value.
-	 * Otherwise, adjust it.
+	if (!gptp_servo_is_outlier(servo, offset) &&
+	    llabs(offset) <= CONFIG_NET_GPTP_SERVO_STEP_THRESHOLD) {
+		gptp_servo_sample(servo, offset,
+				  global_ds->sync_receipt_local_time);
+	}
+
+	/* The neighbor rate ratio is measured with the local clock, which
+	 * runs freq_ppb off the neighbor on purpose: that part of the
+	 * ratio is the correction of the servo, so it is applied again.
 	 */
-	if (second_diff || (second_diff == 0 &&
-			    (nanosecond_diff < -5000 ||
-			     nanosecond_diff > 5000))) {
-		bool underflow = false;
+	ptp_clock_rate_adjust(clk, port_ds->neighbor_rate_ratio *
+			      (1.0 + servo->freq_ppb / NSEC_PER_SEC));
 
-		key = irq_lock();
-		ptp_clock_get(clk, &tm);
+	if (servo->consecutive_outliers > 0 ||
+	    llabs(offset) <= CONFIG_NET_GPTP_SERVO_STEP_THRESHOLD) {
+		return;
+	}
 
-		if (second_diff < 0 && tm.second < -second_diff) {
-			NET_DBG("Do not set local clock because %lu < %ld",
-				(unsigned long int)tm.second,
-				(long int)-second_diff);
-			goto skip_clock_set;
-		}
+	/* The time difference is too high, set the clock value. */
+	key = irq_lock();
+	ptp_clock_get(clk, &tm);
 
-		tm.second += second_diff;
+	if (second_diff < 0 && tm.second < -second_diff) {
+		NET_DBG("Do not set local clock because %lu < %ld",
+			(unsigned long int)tm.second,
+			(long int)-second_diff);
+		goto skip_clock_set;
+	}
 
-		if (nanosecond_diff < 0 &&
-		    tm.nanosecond < -nanosecond_diff) {
-			underflow = true;
-		}
+	tm.second += second_diff;
 
-		tm.nanosecond += nanosecond_diff;
+	if (nanosecond_diff < 0 && tm.nanosecond < -nanosecond_diff) {
+		underflow = true;
+	}
 
-		if (underflow) {
-			tm.second--;
-			tm.nanosecond += NSEC_PER_SEC;
-		} else if (tm.nanosecond >= NSEC_PER_SEC) {
-			tm.second++;
-			tm.nanosecond -= NSEC_PER_SEC;
-		}
+	tm.nanosecond += nanosecond_diff;
 
-		/* This prints too much data normally but can be enabled to see
-		 * what time we are setting to the local clock.
-		 */
-		if (0) {
-			NET_INFO("Set local clock %lu.%lu",
-				 (unsigned long int)tm.second,
-				 (unsigned long int)tm.nanosecond);
-		}
+	if (underflow) {
+		tm.second--;
+		tm.nanosecond += NSEC_PER_SEC;
+	} else if (tm.nanosecond >= NSEC_PER_SEC) {
+		tm.second++;
+		tm.nanosecond -= NSEC_PER_SEC;
+	}
 
-		ptp_clock_set(clk, &tm);
+	/* This prints too much data normally but can be enabled to see
+	 * what time we are setting to the local clock.
+	 */
+	if (0) {
+		NET_INFO("Set local clock %lu.%lu",
+			 (unsigned long int)tm.second,
+			 (unsigned long int)tm.nanosecond);
+	}
 
-	skip_clock_set:
-		irq_unlock(key);
-	} else {
-		if (nanosecond_diff < -200) {
-			nanosecond_diff = -200;
-		} else if (nanosecond_diff > 200) {
-			nanosecond_diff = 200;
-		}
+	ptp_clock_set(clk, &tm);
 
-		ptp_clock_adjust(clk, nanosecond_diff);
-	}
+	/* Start over the servo, keeping its frequency correction */
+	servo->samples = 0U;
+	servo->step_count++;
+
+skip_clock_set:
+	irq_unlock(key);
 }
 #endif /* CONFIG_NET_GPTP_USE_DEFAULT_CLOCK_UPDATE */
 
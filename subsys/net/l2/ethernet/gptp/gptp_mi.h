@@ -69,6 +69,36 @@ void gptp_mi_state_machines(void);
  */
 uint64_t gptp_get_current_time_nanosecond(int port);
 
+#if defined(CONFIG_NET_GPTP_USE_DEFAULT_CLOCK_UPDATE)
+struct gptp_servo;
+
+/**
+ * @brief Tell if a sample of the local clock servo is an outlier.
+ *
+ * The offset of an outlier, caused for instance by a sync message delayed
+ * in a queue, varies too much from the previous one and the servo should
+ * not use it. This updates the outlier statistics of the servo.
+ *
+ * @param servo Servo of the local clock.
+ * @param offset Offset from the master, in ns.
+ *
+ * @return True if the sample is to be discarded.
+ */
+bool gptp_servo_is_outlier(struct gptp_servo *servo, int64_t offset);
+
+/**
+ * @brief Run the PI controller of the local clock servo on a sample.
+ *
+ * This updates the frequency correction and the statistics of the servo.
+ *
+ * @param servo Servo of the local clock.
+ * @param offset Offset from the master, in ns.
+ * @param local_time Local time of the sample, in ns.
+ */
+void gptp_servo_sample(struct gptp_servo *servo, int64_t offset,
+		       uint64_t local_time);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
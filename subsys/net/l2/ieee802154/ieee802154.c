@@ -42,6 +42,12 @@ LOG_MODULE_REGISTER(net_ieee802154, CONFIG_NET_L2_IEEE802154_LOG_LEVEL);
 
 NET_BUF_POOL_DEFINE(tx_frame_buf_pool, 1, IEEE802154_MTU, 8, NULL);
 
+#ifdef CONFIG_NET_L2_IEEE802154_TX_PIPELINE
+NET_BUF_POOL_DEFINE(tx_pipeline_buf_pool,
+		    CONFIG_NET_L2_IEEE802154_TX_PIPELINE_DEPTH,
+		    IEEE802154_MTU, 8, NULL);
+#endif
+
 #define PKT_TITLE    "IEEE 802.15.4 packet content:"
 #define TX_PKT_TITLE "> " PKT_TITLE
 #define RX_PKT_TITLE "< " PKT_TITLE
@@ -237,6 +243,68 @@ static enum net_verdict ieee802154_recv(struct net_if *iface, struct net_pkt *pk
 #endif /* CONFIG_NET_6LO */
 }
 
+#ifdef CONFIG_NET_L2_IEEE802154_TX_PIPELINE
+/* Radios doing CSMA-CA and ACK handling by themselves can be given the next
+ * frames before the previous ones are sent.
+ */
+static bool tx_pipeline_supported(struct net_if *iface)
+{
+	const struct ieee802154_radio_api *radio =
+		net_if_get_device(iface)->api;
+	const enum ieee802154_hw_caps caps =
+		IEEE802154_HW_CSMA | IEEE802154_HW_TX_RX_ACK;
+
+	return radio->tx_queue &&
+	       (ieee802154_get_hw_capabilities(iface) & caps) == caps;
+}
+
+static int tx_pipeline_queue(struct net_if *iface, struct net_pkt *pkt,
+			     struct net_buf *frame)
+{
+	const struct ieee802154_radio_api *radio =
+		net_if_get_device(iface)->api;
+
+	return radio->tx_queue(net_if_get_device(iface),
+			       IEEE802154_TX_MODE_CSMA_CA, pkt, frame);
+}
+
+/* Wait for the queued frames to be sent, returning the first error */
+static int tx_pipeline_flush(struct net_if *iface, int queued)
+{
+	struct ieee802154_context *ctx = net_if_l2_data(iface);
+
+	while (queued--) {
+		k_sem_take(&ctx->tx_done, K_FOREVER);
+	}
+
+	return (int)atomic_clear(&ctx->tx_status);
+}
+
+void ieee802154_tx_done(struct net_if *iface, struct net_buf *frag,
+			int status)
+{
+	struct ieee802154_context *ctx = net_if_l2_data(iface);
+
+	if (status) {
+		atomic_cas(&ctx->tx_status, 0, status);
+	}
+
+	net_buf_unref(frag);
+	k_sem_give(&ctx->tx_done);
+}
+#else
+static inline bool tx_pipeline_supported(struct net_if *iface)
+{
+	return false;
+}
+
+static inline int tx_pipeline_queue(struct net_if *iface, struct net_pkt *pkt,
+				    struct net_buf *frame)
+{
+	return -ENOTSUP;
+}
+#endif /* CONFIG_NET_L2_IEEE802154_TX_PIPELINE */
+
 static int ieee802154_send(struct net_if *iface, struct net_pkt *pkt)
 {
 	static struct net_buf *frame_buf;
@@ -302,52 +370,103 @@ static int ieee802154_send(struct net_if *iface, struct net_pkt *pkt)
 	net_capture_pkt(iface, pkt);
 
 	int len = 0;
+	int ret = 0;
 	struct ieee802154_context *ctx = net_if_l2_data(iface);
 	struct net_buf *buf = pkt->buffer;
+	struct net_buf *frame = NULL;
+	bool pipelined = tx_pipeline_supported(iface);
+	int queued = 0;
+
 	while (buf) {
-		int ret;
+#ifdef CONFIG_NET_L2_IEEE802154_TX_PIPELINE
+		if (pipelined) {
+			/* Waits for a frame to be sent if the pipeline is full */
+			frame = net_buf_alloc(&tx_pipeline_buf_pool, K_FOREVER);
+		} else {
+			frame = frame_buf;
+		}
+#else
+		frame = frame_buf;
+#endif
 
-		/* Reinitializing frame_buf */
-		net_buf_reset(frame_buf);
-		net_buf_add(frame_buf, ll_hdr_len);
+		/* Reinitializing frame */
+		net_buf_reset(frame);
+		net_buf_add(frame, ll_hdr_len);
 
 #ifdef CONFIG_NET_L2_IEEE802154_FRAGMENT
 		if (requires_fragmentation) {
-			buf = ieee802154_6lo_fragment(&f_ctx, frame_buf, true);
+			buf = ieee802154_6lo_fragment(&f_ctx, frame, true);
 		} else {
-			net_buf_add_mem(frame_buf, buf->data, buf->len);
+			net_buf_add_mem(frame, buf->data, buf->len);
 			buf = buf->frags;
 		}
 #else
 
 		if (buf->len > IEEE802154_MTU) {
 			NET_ERR("Wrong packet length: %d", buf->len);
-			return -EINVAL;
+			ret = -EINVAL;
+			break;
 		}
-		net_buf_add_mem(frame_buf, buf->data, buf->len);
+		net_buf_add_mem(frame, buf->data, buf->len);
 		buf = buf->frags;
 #endif /* CONFIG_NET_L2_IEEE802154_FRAGMENT */
 
 		if (!(send_raw || ieee802154_create_data_frame(ctx, net_pkt_lladdr_dst(pkt),
 							       net_pkt_lladdr_src(pkt),
-							       frame_buf, ll_hdr_len))) {
-			return -EINVAL;
+							       frame, ll_hdr_len))) {
+			ret = -EINVAL;
+			break;
+		}
+
+		if (pipelined) {
+			/* The radio owns the frame once it is queued */
+			len += frame->len;
+
+			ret = tx_pipeline_queue(iface, pkt, frame);
+			if (ret) {
+				len -= frame->len;
+				break;
+			}
+
+			frame = NULL;
+			queued++;
+
+			continue;
 		}
 
 		if (IS_ENABLED(CONFIG_NET_L2_IEEE802154_RADIO_CSMA_CA) &&
 		    ieee802154_get_hw_capabilities(iface) & IEEE802154_HW_CSMA) {
 			/* CSMA in hardware */
-			ret = ieee802154_tx(iface, IEEE802154_TX_MODE_CSMA_CA, pkt, frame_buf);
+			ret = ieee802154_tx(iface, IEEE802154_TX_MODE_CSMA_CA, pkt, frame);
 		} else {
 			/* Media access (direct, CSMA, ALOHA, ...) in software */
-			ret = ieee802154_radio_send(iface, pkt, frame_buf);
+			ret = ieee802154_radio_send(iface, pkt, frame);
 		}
 
 		if (ret) {
-			return ret;
+			break;
+		}
+
+		len += frame->len;
+	}
+
+#ifdef CONFIG_NET_L2_IEEE802154_TX_PIPELINE
+	if (pipelined) {
+		int status = tx_pipeline_flush(iface, queued);
+
+		/* Frame which could not be queued */
+		if (frame) {
+			net_buf_unref(frame);
 		}
 
-		len += frame_buf->len;
+		if (!ret) {
+			ret = status;
+		}
+	}
+#endif
+
+	if (ret) {
+		return ret;
 	}
 
 	net_pkt_unref(pkt);
@@ -406,6 +525,10 @@ void ieee802154_init(struct net_if *iface)
 	}
 #endif
 
+#ifdef CONFIG_NET_L2_IEEE802154_TX_PIPELINE
+	k_sem_init(&ctx->tx_done, 0, K_SEM_MAX_LIMIT);
+#endif
+
 	sys_memcpy_swap(long_addr, mac, 8);
 	memcpy(ctx->ext_addr, long_addr, 8);
 	ieee802154_filter_ieee_addr(iface, ctx->ext_addr);
@@ -435,8 +435,8 @@ static inline void fragment_remove_headers(struct net_pkt *pkt)
 			hdr_len = NET_6LO_FRAG1_HDR_LEN;
 		}
 
-		memmove(frag->data, frag->data + hdr_len, frag->len - hdr_len);
-		frag->len -= hdr_len;
+		/* The payload is left in place */
+		net_buf_pull(frag, hdr_len);
 
 		frag = frag->frags;
 	}
@@ -8,11 +8,385 @@
 LOG_MODULE_REGISTER(net_wifi_mgmt, CONFIG_NET_L2_WIFI_MGMT_LOG_LEVEL);
 
 #include <errno.h>
+#include <string.h>
 
+#include <zephyr/kernel.h>
 #include <zephyr/net/net_core.h>
 #include <zephyr/net/net_if.h>
 #include <zephyr/net/wifi_mgmt.h>
 
+#if CONFIG_NET_L2_WIFI_MGMT_SCAN_RESULTS_MAX > 0
+static struct wifi_scan_result scan_results[CONFIG_NET_L2_WIFI_MGMT_SCAN_RESULTS_MAX];
+static size_t scan_results_count;
+static struct net_if *scan_results_iface;
+static K_MUTEX_DEFINE(scan_results_lock);
+
+static void scan_results_reset(struct net_if *iface)
+{
+	k_mutex_lock(&scan_results_lock, K_FOREVER);
+
+	scan_results_count = 0;
+	scan_results_iface = iface;
+
+	k_mutex_unlock(&scan_results_lock);
+}
+
+/* Keep each BSS once, with its strongest signal, and replace the weakest
+ * BSS once the results are full.
+ */
+static void scan_results_add(struct net_if *iface,
+			     const struct wifi_scan_result *entry)
+{
+	struct wifi_scan_result *weakest = NULL;
+	struct wifi_scan_result *slot = NULL;
+
+	k_mutex_lock(&scan_results_lock, K_FOREVER);
+
+	if (iface != scan_results_iface) {
+		goto out;
+	}
+
+	for (size_t i = 0; i < scan_results_count; i++) {
+		if (entry->mac_length > 0U &&
+		    scan_results[i].mac_length == entry->mac_length &&
+		    memcmp(scan_results[i].mac, entry->mac,
+			   entry->mac_length) == 0) {
+			if (entry->rssi > scan_results[i].rssi) {
+				slot = &scan_results[i];
+			}
+
+			goto copy;
+		}
+
+		if (!weakest || scan_results[i].rssi < weakest->rssi) {
+			weakest = &scan_results[i];
+		}
+	}
+
+	if (scan_results_count < ARRAY_SIZE(scan_results)) {
+		slot = &scan_results[scan_results_count++];
+	} else if (weakest->rssi < entry->rssi) {
+		slot = weakest;
+	}
+
+copy:
+	if (slot) {
+		*slot = *entry;
+	}
+
+out:
+	k_mutex_unlock(&scan_results_lock);
+}
+
+static int scan_results_get(struct net_if *iface, struct wifi_scan_results *req)
+{
+	k_mutex_lock(&scan_results_lock, K_FOREVER);
+
+	if (iface != scan_results_iface) {
+		req->count = 0;
+	} else {
+		req->count = MIN(req->max, scan_results_count);
+		memcpy(req->results, scan_results,
+		       req->count * sizeof(struct wifi_scan_result));
+	}
+
+	k_mutex_unlock(&scan_results_lock);
+
+	return 0;
+}
+
+/* Find the strongest BSS of a network in the results of the last scan */
+static bool scan_results_find(struct net_if *iface, const uint8_t *ssid,
+			      uint8_t ssid_length, uint8_t *channel,
+			      uint8_t *bssid)
+{
+	struct wifi_scan_result *best = NULL;
+
+	k_mutex_lock(&scan_results_lock, K_FOREVER);
+
+	for (size_t i = 0; iface == scan_results_iface &&
+			   i < scan_results_count; i++) {
+		if (scan_results[i].ssid_length == ssid_length &&
+		    scan_results[i].mac_length == WIFI_MAC_ADDR_LEN &&
+		    memcmp(scan_results[i].ssid, ssid, ssid_length) == 0 &&
+		    (!best || scan_results[i].rssi > best->rssi)) {
+			best = &scan_results[i];
+		}
+	}
+
+	if (best) {
+		*channel = best->channel;
+		memcpy(bssid, best->mac, WIFI_MAC_ADDR_LEN);
+	}
+
+	k_mutex_unlock(&scan_results_lock);
+
+	return best != NULL;
+}
+#else
+static inline void scan_results_reset(struct net_if *iface)
+{
+	ARG_UNUSED(iface);
+}
+
+static inline void scan_results_add(struct net_if *iface,
+				    const struct wifi_scan_result *entry)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(entry);
+}
+
+static inline int scan_results_get(struct net_if *iface,
+				   struct wifi_scan_results *req)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(req);
+
+	return -ENOTSUP;
+}
+
+static inline bool scan_results_find(struct net_if *iface, const uint8_t *ssid,
+				     uint8_t ssid_length, uint8_t *channel,
+				     uint8_t *bssid)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(ssid);
+	ARG_UNUSED(ssid_length);
+	ARG_UNUSED(channel);
+	ARG_UNUSED(bssid);
+
+	return false;
+}
+#endif /* CONFIG_NET_L2_WIFI_MGMT_SCAN_RESULTS_MAX > 0 */
+
+#if CONFIG_NET_L2_WIFI_MGMT_RECONNECT_CACHE_SIZE > 0
+struct reconnect_entry {
+	/** Interface connected to the network, NULL if the entry is free */
+	struct net_if *iface;
+
+	/** Value of the use counter when the entry was last used */
+	uint32_t last_used;
+
+	uint8_t ssid[WIFI_SSID_MAX_LEN];
+	uint8_t ssid_length;
+
+	/** Channel and BSSID of the last connection to the network */
+	uint8_t channel;
+	uint8_t bssid[WIFI_MAC_ADDR_LEN];
+};
+
+static struct reconnect_entry reconnect_cache[CONFIG_NET_L2_WIFI_MGMT_RECONNECT_CACHE_SIZE];
+static uint32_t reconnect_counter;
+static K_MUTEX_DEFINE(reconnect_lock);
+
+/* Network of the last connection request, and whether it was given hints */
+static struct net_if *connect_iface;
+static uint8_t connect_ssid[WIFI_SSID_MAX_LEN];
+static uint8_t connect_ssid_length;
+static bool connect_hinted;
+
+static void reconnect_learn(struct k_work *work);
+
+static K_WORK_DEFINE(reconnect_learn_work, reconnect_learn);
+static struct net_if *learn_iface;
+static struct wifi_iface_status learn_status;
+
+/* Must be invoked with reconnect lock held */
+static struct reconnect_entry *reconnect_lookup(struct net_if *iface,
+						const uint8_t *ssid,
+						uint8_t ssid_length)
+{
+	for (int i = 0; i < ARRAY_SIZE(reconnect_cache); i++) {
+		if (reconnect_cache[i].iface == iface &&
+		    reconnect_cache[i].ssid_length == ssid_length &&
+		    memcmp(reconnect_cache[i].ssid, ssid, ssid_length) == 0) {
+			return &reconnect_cache[i];
+		}
+	}
+
+	return NULL;
+}
+
+static void reconnect_cache_update(struct net_if *iface,
+				   const struct wifi_iface_status *status)
+{
+	struct reconnect_entry *entry;
+
+	if (status->state != WIFI_STATE_COMPLETED || status->ssid_len == 0U ||
+	    status->ssid_len > WIFI_SSID_MAX_LEN ||
+	    status->channel > WIFI_CHANNEL_MAX) {
+		return;
+	}
+
+	k_mutex_lock(&reconnect_lock, K_FOREVER);
+
+	entry = reconnect_lookup(iface, (const uint8_t *)status->ssid,
+				 status->ssid_len);
+	if (!entry) {
+		/* Take a free entry, or else the least recently used one */
+		entry = &reconnect_cache[0];
+
+		for (int i = 0; i < ARRAY_SIZE(reconnect_cache); i++) {
+			if (!reconnect_cache[i].iface) {
+				entry = &reconnect_cache[i];
+				break;
+			}
+
+			if ((int32_t)(reconnect_cache[i].last_used -
+				      entry->last_used) < 0) {
+				entry = &reconnect_cache[i];
+			}
+		}
+
+		entry->iface = iface;
+		memcpy(entry->ssid, status->ssid, status->ssid_len);
+		entry->ssid_length = status->ssid_len;
+	}
+
+	entry->channel = status->channel;
+	memcpy(entry->bssid, status->bssid, WIFI_MAC_ADDR_LEN);
+	entry->last_used = ++reconnect_counter;
+
+	k_mutex_unlock(&reconnect_lock);
+}
+
+/* Give the channel and BSSID of the last connection to the network, if
+ * the application did not ask for a channel.
+ */
+static bool reconnect_cache_hint(struct net_if *iface,
+				 const struct wifi_connect_req_params *params,
+				 struct wifi_connect_req_params *hinted,
+				 uint8_t *bssid)
+{
+	struct reconnect_entry *entry = NULL;
+
+	k_mutex_lock(&reconnect_lock, K_FOREVER);
+
+	if (params->channel == WIFI_CHANNEL_ANY && !params->bssid) {
+		entry = reconnect_lookup(iface, params->ssid,
+					 params->ssid_length);
+	}
+
+	if (entry) {
+		*hinted = *params;
+		hinted->channel = entry->channel;
+		memcpy(bssid, entry->bssid, WIFI_MAC_ADDR_LEN);
+		hinted->bssid = bssid;
+
+		entry->last_used = ++reconnect_counter;
+	}
+
+	connect_iface = iface;
+	memcpy(connect_ssid, params->ssid, params->ssid_length);
+	connect_ssid_length = params->ssid_length;
+	connect_hinted = (entry != NULL);
+
+	k_mutex_unlock(&reconnect_lock);
+
+	return entry != NULL;
+}
+
+static void reconnect_cache_result(struct net_if *iface, int status)
+{
+	struct reconnect_entry *entry;
+
+	k_mutex_lock(&reconnect_lock, K_FOREVER);
+
+	if (connect_iface != iface) {
+		goto out;
+	}
+
+	if (status != 0) {
+		/* The BSS may have moved, the next connection scans for it */
+		entry = connect_hinted ?
+			reconnect_lookup(iface, connect_ssid,
+					 connect_ssid_length) : NULL;
+		if (entry) {
+			NET_DBG("Forgetting channel %u of failed network",
+				entry->channel);
+			entry->iface = NULL;
+		}
+	} else if (!k_work_is_pending(&reconnect_learn_work)) {
+		/* The driver is asked about the network from the system work
+		 * queue, as it may be reporting the result with its own lock
+		 * held.
+		 */
+		learn_iface = iface;
+		memcpy(learn_status.ssid, connect_ssid, connect_ssid_length);
+		learn_status.ssid_len = connect_ssid_length;
+		k_work_submit(&reconnect_learn_work);
+	}
+
+	connect_iface = NULL;
+
+out:
+	k_mutex_unlock(&reconnect_lock);
+}
+
+/* Learn the channel and BSSID of the network connected to from the driver,
+ * or else from the results of the last scan.
+ */
+static void reconnect_learn(struct k_work *work)
+{
+	struct wifi_iface_status status = { 0 };
+	struct net_wifi_mgmt_offload *off_api;
+	const struct device *dev;
+	struct net_if *iface;
+	uint8_t channel;
+
+	ARG_UNUSED(work);
+
+	k_mutex_lock(&reconnect_lock, K_FOREVER);
+	iface = learn_iface;
+	memcpy(status.ssid, learn_status.ssid, learn_status.ssid_len);
+	status.ssid_len = learn_status.ssid_len;
+	k_mutex_unlock(&reconnect_lock);
+
+	dev = net_if_get_device(iface);
+	off_api = (struct net_wifi_mgmt_offload *) dev->api;
+
+	if (off_api && off_api->iface_status &&
+	    off_api->iface_status(dev, &status) == 0) {
+		reconnect_cache_update(iface, &status);
+		return;
+	}
+
+	if (scan_results_find(iface, (const uint8_t *)status.ssid,
+			      status.ssid_len, &channel,
+			      (uint8_t *)status.bssid)) {
+		status.state = WIFI_STATE_COMPLETED;
+		status.channel = channel;
+		reconnect_cache_update(iface, &status);
+	}
+}
+#else
+static inline void reconnect_cache_update(struct net_if *iface,
+					  const struct wifi_iface_status *status)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(status);
+}
+
+static inline bool reconnect_cache_hint(struct net_if *iface,
+					const struct wifi_connect_req_params *params,
+					struct wifi_connect_req_params *hinted,
+					uint8_t *bssid)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(params);
+	ARG_UNUSED(hinted);
+	ARG_UNUSED(bssid);
+
+	return false;
+}
+
+static inline void reconnect_cache_result(struct net_if *iface, int status)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(status);
+}
+#endif /* CONFIG_NET_L2_WIFI_MGMT_RECONNECT_CACHE_SIZE > 0 */
+
 static int wifi_connect(uint32_t mgmt_request, struct net_if *iface,
 			void *data, size_t len)
 {
@@ -21,6 +395,8 @@ static int wifi_connect(uint32_t mgmt_request, struct net_if *iface,
 	const struct device *dev = net_if_get_device(iface);
 	struct net_wifi_mgmt_offload *off_api =
 		(struct net_wifi_mgmt_offload *) dev->api;
+	struct wifi_connect_req_params hinted;
+	uint8_t bssid[WIFI_MAC_ADDR_LEN];
 
 	if (off_api == NULL || off_api->connect == NULL) {
 		return -ENOTSUP;
@@ -49,6 +425,11 @@ static int wifi_connect(uint32_t mgmt_request, struct net_if *iface,
 		return -EINVAL;
 	}
 
+	if (reconnect_cache_hint(iface, params, &hinted, bssid)) {
+		NET_DBG("Hinting ch %u", hinted.channel);
+		params = &hinted;
+	}
+
 	return off_api->connect(dev, params);
 }
 
@@ -72,8 +453,12 @@ static void scan_result_cb(struct net_if *iface, int status,
 		return;
 	}
 
-	net_mgmt_event_notify_with_info(NET_EVENT_WIFI_SCAN_RESULT, iface,
-					entry, sizeof(struct wifi_scan_result));
+	scan_results_add(iface, entry);
+
+	if (IS_ENABLED(CONFIG_NET_L2_WIFI_MGMT_SCAN_RESULT_EVENTS)) {
+		net_mgmt_event_notify_with_info(NET_EVENT_WIFI_SCAN_RESULT, iface,
+						entry, sizeof(struct wifi_scan_result));
+	}
 }
 
 static int wifi_scan(uint32_t mgmt_request, struct net_if *iface,
@@ -87,11 +472,27 @@ static int wifi_scan(uint32_t mgmt_request, struct net_if *iface,
 		return -ENOTSUP;
 	}
 
+	scan_results_reset(iface);
+
 	return off_api->scan(dev, scan_result_cb);
 }
 
 NET_MGMT_REGISTER_REQUEST_HANDLER(NET_REQUEST_WIFI_SCAN, wifi_scan);
 
+static int wifi_scan_results(uint32_t mgmt_request, struct net_if *iface,
+			     void *data, size_t len)
+{
+	struct wifi_scan_results *req = data;
+
+	if (!data || len != sizeof(*req) || (req->max > 0U && !req->results)) {
+		return -EINVAL;
+	}
+
+	return scan_results_get(iface, req);
+}
+
+NET_MGMT_REGISTER_REQUEST_HANDLER(NET_REQUEST_WIFI_SCAN_RESULTS, wifi_scan_results);
+
 
 static int wifi_disconnect(uint32_t mgmt_request, struct net_if *iface,
 			   void *data, size_t len)
@@ -115,6 +516,8 @@ void wifi_mgmt_raise_connect_result_event(struct net_if *iface, int status)
 		.status = status,
 	};
 
+	reconnect_cache_result(iface, status);
+
 	net_mgmt_event_notify_with_info(NET_EVENT_WIFI_CONNECT_RESULT,
 					iface, &cnx_status,
 					sizeof(struct wifi_status));
@@ -188,6 +591,8 @@ static int wifi_iface_status(uint32_t mgmt_request, struct net_if *iface,
 		return ret;
 	}
 
+	reconnect_cache_update(iface, status);
+
 	return 0;
 }
 NET_MGMT_REGISTER_REQUEST_HANDLER(NET_REQUEST_WIFI_IFACE_STATUS, wifi_iface_status);
@@ -195,6 +600,8 @@ NET_MGMT_REGISTER_REQUEST_HANDLER(NET_REQUEST_WIFI_IFACE_STATUS, wifi_iface_stat
 void wifi_mgmt_raise_iface_status_event(struct net_if *iface,
 		struct wifi_iface_status *iface_status)
 {
+	reconnect_cache_update(iface, iface_status);
+
 	net_mgmt_event_notify_with_info(NET_EVENT_WIFI_IFACE_STATUS,
 					iface, iface_status,
 					sizeof(struct wifi_iface_status));
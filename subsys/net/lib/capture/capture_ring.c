@@ -0,0 +1,441 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_capture, CONFIG_NET_CAPTURE_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <string.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/ring_buffer.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/capture.h>
+#include <zephyr/net/ethernet.h>
+
+#if defined(CONFIG_FILE_SYSTEM)
+#include <zephyr/fs/fs.h>
+#endif
+
+#define PCAPNG_SHB_TYPE		0x0A0D0D0A
+#define PCAPNG_IDB_TYPE		0x00000001
+#define PCAPNG_EPB_TYPE		0x00000006
+#define PCAPNG_BYTE_ORDER_MAGIC	0x1A2B3C4D
+
+#define LINKTYPE_ETHERNET		1
+#define LINKTYPE_RAW			101
+#define LINKTYPE_IEEE802_15_4_NOFCS	230
+
+/* Link header, IPv4 header with options and ports looked at by the filter */
+#define FILTER_HDR_LEN (sizeof(struct net_eth_vlan_hdr) + 60 + 4)
+
+/* The blocks are written in host byte order, which the byte order magic
+ * of the section header tells the reader.
+ */
+struct pcapng_shb {
+	uint32_t type;
+	uint32_t len;
+	uint32_t magic;
+	uint16_t major;
+	uint16_t minor;
+	int64_t section_len;
+	uint32_t len_trailer;
+} __packed;
+
+struct pcapng_idb {
+	uint32_t type;
+	uint32_t len;
+	uint16_t link_type;
+	uint16_t reserved;
+	uint32_t snaplen;
+	uint32_t len_trailer;
+} __packed;
+
+/* Enhanced packet block, followed by the data padded to 32 bits and the
+ * block length.
+ */
+struct pcapng_epb {
+	uint32_t type;
+	uint32_t len;
+	uint32_t iface_id;
+	uint32_t ts_high;
+	uint32_t ts_low;
+	uint32_t cap_len;
+	uint32_t orig_len;
+} __packed;
+
+RING_BUF_DECLARE(capture_ring, CONFIG_NET_CAPTURE_RING_SIZE);
+
+/* The writers, i.e. the threads of the network stack, only serialize
+ * between themselves while copying a packet. The reader never blocks them.
+ */
+static struct k_spinlock ring_lock;
+static K_MUTEX_DEFINE(read_lock);
+
+static struct net_capture_ring_params ring_params;
+static uint16_t ring_link_type;
+static atomic_t ring_active;
+
+static atomic_t stats_saved;
+static atomic_t stats_dropped;
+static atomic_t stats_filtered;
+
+#if defined(CONFIG_FILE_SYSTEM)
+static void ring_flush(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(flush_work, ring_flush);
+static struct fs_file_t ring_file;
+static bool ring_file_open;
+
+/* Must be invoked with read lock held */
+static void ring_write_file(void)
+{
+	uint8_t *data;
+	uint32_t len;
+	ssize_t ret;
+
+	while (true) {
+		len = ring_buf_get_claim(&capture_ring, &data,
+					 CONFIG_NET_CAPTURE_RING_SIZE);
+		if (len == 0U) {
+			break;
+		}
+
+		ret = fs_write(&ring_file, data, len);
+		if (ret < 0) {
+			NET_ERR("Cannot write capture file (%d)", (int)ret);
+			(void)ring_buf_get_finish(&capture_ring, len);
+			break;
+		}
+
+		(void)ring_buf_get_finish(&capture_ring, ret);
+	}
+}
+
+static void ring_flush(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	k_mutex_lock(&read_lock, K_FOREVER);
+
+	ring_write_file();
+
+	if (atomic_get(&ring_active)) {
+		k_work_reschedule(&flush_work,
+				  K_MSEC(CONFIG_NET_CAPTURE_RING_FLUSH_PERIOD));
+	}
+
+	k_mutex_unlock(&read_lock);
+}
+#endif /* CONFIG_FILE_SYSTEM */
+
+static uint16_t capture_link_type(struct net_if *iface)
+{
+#if defined(CONFIG_NET_L2_ETHERNET)
+	if (net_if_l2(iface) == &NET_L2_GET_NAME(ETHERNET)) {
+		return LINKTYPE_ETHERNET;
+	}
+#endif
+
+#if defined(CONFIG_NET_L2_IEEE802154)
+	if (net_if_l2(iface) == &NET_L2_GET_NAME(IEEE802154)) {
+		return LINKTYPE_IEEE802_15_4_NOFCS;
+	}
+#endif
+
+	ARG_UNUSED(iface);
+
+	return LINKTYPE_RAW;
+}
+
+static bool capture_filter(struct net_if *iface, struct net_pkt *pkt)
+{
+	uint8_t hdr[FILTER_HDR_LEN];
+	sa_family_t family;
+	size_t offset = 0;
+	size_t ip_len;
+	uint8_t proto;
+	size_t len;
+
+	if (ring_params.family == AF_UNSPEC && ring_params.proto == 0U &&
+	    ring_params.port == 0U) {
+		goto filter_cb;
+	}
+
+	len = net_buf_linearize(hdr, sizeof(hdr), pkt->buffer, 0, sizeof(hdr));
+
+	if (ring_link_type == LINKTYPE_ETHERNET) {
+		struct net_eth_hdr *eth = (struct net_eth_hdr *)hdr;
+
+		if (len < sizeof(struct net_eth_hdr)) {
+			return false;
+		}
+
+		if (ntohs(eth->type) == NET_ETH_PTYPE_VLAN) {
+			offset = sizeof(struct net_eth_vlan_hdr);
+		} else {
+			offset = sizeof(struct net_eth_hdr);
+		}
+	} else if (ring_link_type != LINKTYPE_RAW) {
+		/* The IP header cannot be found in the frame */
+		return false;
+	}
+
+	if (len <= offset) {
+		return false;
+	}
+
+	if ((hdr[offset] >> 4) == 4) {
+		family = AF_INET;
+		ip_len = (hdr[offset] & 0x0f) * 4;
+		proto = hdr[offset + 9];
+	} else if ((hdr[offset] >> 4) == 6) {
+		/* Extension headers are not skipped */
+		family = AF_INET6;
+		ip_len = sizeof(struct net_ipv6_hdr);
+		proto = hdr[offset + 6];
+	} else {
+		return false;
+	}
+
+	if (len < offset + ip_len) {
+		return false;
+	}
+
+	if ((ring_params.family != AF_UNSPEC && family != ring_params.family) ||
+	    (ring_params.proto != 0U && proto != ring_params.proto)) {
+		return false;
+	}
+
+	if (ring_params.port != 0U) {
+		offset += ip_len;
+
+		if ((proto != IPPROTO_UDP && proto != IPPROTO_TCP) ||
+		    len < offset + 2 * sizeof(uint16_t)) {
+			return false;
+		}
+
+		if (sys_get_be16(&hdr[offset]) != ring_params.port &&
+		    sys_get_be16(&hdr[offset + 2]) != ring_params.port) {
+			return false;
+		}
+	}
+
+filter_cb:
+	if (ring_params.filter) {
+		return ring_params.filter(iface, pkt, ring_params.user_data);
+	}
+
+	return true;
+}
+
+void net_capture_ring_pkt(struct net_if *iface, struct net_pkt *pkt)
+{
+	static const uint8_t padding[3];
+	struct pcapng_epb epb;
+	k_spinlock_key_t key;
+	struct net_buf *buf;
+	uint32_t cap_len;
+	uint32_t pad;
+	uint64_t ts;
+
+	if (!atomic_get(&ring_active) || ring_params.iface != iface) {
+		return;
+	}
+
+	if (!capture_filter(iface, pkt)) {
+		atomic_inc(&stats_filtered);
+		return;
+	}
+
+	ts = k_ticks_to_us_floor64(k_uptime_ticks());
+
+	epb.type = PCAPNG_EPB_TYPE;
+	epb.iface_id = 0U;
+	epb.ts_high = (uint32_t)(ts >> 32);
+	epb.ts_low = (uint32_t)ts;
+	epb.orig_len = net_pkt_get_len(pkt);
+
+	cap_len = epb.orig_len;
+	if (ring_params.snaplen != 0U) {
+		cap_len = MIN(cap_len, ring_params.snaplen);
+	}
+
+	pad = ROUND_UP(cap_len, 4) - cap_len;
+
+	epb.cap_len = cap_len;
+	epb.len = sizeof(epb) + cap_len + pad + sizeof(epb.len);
+
+	key = k_spin_lock(&ring_lock);
+
+	if (ring_buf_space_get(&capture_ring) < epb.len) {
+		k_spin_unlock(&ring_lock, key);
+		atomic_inc(&stats_dropped);
+		return;
+	}
+
+	(void)ring_buf_put(&capture_ring, (uint8_t *)&epb, sizeof(epb));
+
+	for (buf = pkt->buffer; buf && cap_len > 0U; buf = buf->frags) {
+		uint32_t len = MIN(buf->len, cap_len);
+
+		(void)ring_buf_put(&capture_ring, buf->data, len);
+		cap_len -= len;
+	}
+
+	(void)ring_buf_put(&capture_ring, padding, pad);
+	(void)ring_buf_put(&capture_ring, (uint8_t *)&epb.len, sizeof(epb.len));
+
+	k_spin_unlock(&ring_lock, key);
+
+	atomic_inc(&stats_saved);
+}
+
+int net_capture_ring_start(const struct net_capture_ring_params *params)
+{
+	struct pcapng_shb shb = {
+		.type = PCAPNG_SHB_TYPE,
+		.len = sizeof(shb),
+		.magic = PCAPNG_BYTE_ORDER_MAGIC,
+		.major = 1,
+		.minor = 0,
+		.section_len = -1,
+		.len_trailer = sizeof(shb),
+	};
+	struct pcapng_idb idb = {
+		.type = PCAPNG_IDB_TYPE,
+		.len = sizeof(idb),
+		.len_trailer = sizeof(idb),
+	};
+	int ret = 0;
+
+	if (params == NULL || params->iface == NULL) {
+		return -EINVAL;
+	}
+
+	if (params->file != NULL && !IS_ENABLED(CONFIG_FILE_SYSTEM)) {
+		return -ENOTSUP;
+	}
+
+	k_mutex_lock(&read_lock, K_FOREVER);
+
+	if (atomic_get(&ring_active)) {
+		ret = -EALREADY;
+		goto out;
+	}
+
+	ring_params = *params;
+	ring_link_type = capture_link_type(params->iface);
+
+	atomic_clear(&stats_saved);
+	atomic_clear(&stats_dropped);
+	atomic_clear(&stats_filtered);
+
+	idb.link_type = ring_link_type;
+	idb.snaplen = params->snaplen;
+
+	ring_buf_reset(&capture_ring);
+	(void)ring_buf_put(&capture_ring, (uint8_t *)&shb, sizeof(shb));
+	(void)ring_buf_put(&capture_ring, (uint8_t *)&idb, sizeof(idb));
+
+#if defined(CONFIG_FILE_SYSTEM)
+	if (params->file != NULL) {
+		/* Files are not truncated when opened */
+		(void)fs_unlink(params->file);
+
+		fs_file_t_init(&ring_file);
+
+		ret = fs_open(&ring_file, params->file,
+			      FS_O_CREATE | FS_O_WRITE);
+		if (ret < 0) {
+			NET_ERR("Cannot open capture file %s (%d)",
+				params->file, ret);
+			goto out;
+		}
+
+		ring_file_open = true;
+		ring_params.file = NULL;
+
+		k_work_reschedule(&flush_work,
+				  K_MSEC(CONFIG_NET_CAPTURE_RING_FLUSH_PERIOD));
+	}
+#endif
+
+	atomic_set(&ring_active, 1);
+
+	NET_DBG("Capturing iface %d to ring, snaplen %u",
+		net_if_get_by_iface(params->iface), params->snaplen);
+
+out:
+	k_mutex_unlock(&read_lock);
+
+	return ret;
+}
+
+int net_capture_ring_stop(void)
+{
+#if defined(CONFIG_FILE_SYSTEM)
+	struct k_work_sync sync;
+#endif
+	k_spinlock_key_t key;
+
+	if (!atomic_cas(&ring_active, 1, 0)) {
+		return -EALREADY;
+	}
+
+	/* Wait for the packets being saved to the ring */
+	key = k_spin_lock(&ring_lock);
+	k_spin_unlock(&ring_lock, key);
+
+#if defined(CONFIG_FILE_SYSTEM)
+	(void)k_work_cancel_delayable_sync(&flush_work, &sync);
+
+	k_mutex_lock(&read_lock, K_FOREVER);
+
+	if (ring_file_open) {
+		ring_write_file();
+
+		(void)fs_close(&ring_file);
+		ring_file_open = false;
+	}
+
+	k_mutex_unlock(&read_lock);
+#endif
+
+	return 0;
+}
+
+int net_capture_ring_read(uint8_t *buf, size_t len)
+{
+	int ret;
+
+	k_mutex_lock(&read_lock, K_FOREVER);
+
+#if defined(CONFIG_FILE_SYSTEM)
+	if (ring_file_open) {
+		ret = -EBUSY;
+		goto out;
+	}
+#endif
+
+	ret = ring_buf_get(&capture_ring, buf, MIN(len, INT32_MAX));
+
+#if defined(CONFIG_FILE_SYSTEM)
+out:
+#endif
+	k_mutex_unlock(&read_lock);
+
+	return ret;
+}
+
+void net_capture_ring_stats_get(struct net_capture_ring_stats *stats)
+{
+	stats->saved = atomic_get(&stats_saved);
+	stats->dropped = atomic_get(&stats_dropped);
+	stats->filtered = atomic_get(&stats_filtered);
+}
@@ -0,0 +1,888 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_coap_transfer, CONFIG_COAP_LOG_LEVEL);
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/dlist.h>
+#include <zephyr/sys/util.h>
+
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/coap.h>
+#include <zephyr/net/coap_transfer.h>
+
+#define WHEEL_SLOTS CONFIG_COAP_TRANSFER_WHEEL_SLOTS
+#define WHEEL_TICK_MS CONFIG_COAP_TRANSFER_WHEEL_TICK_MS
+
+/* Header, token, Block and Size options and payload marker of a request,
+ * or options of a response, besides the path and the block itself.
+ */
+#define PACKET_OVERHEAD 32
+
+/* Time to wait for a separate response once the request was acknowledged,
+ * MAX_TRANSMIT_WAIT of RFC 7252 section 4.8.2.
+ */
+#define SEPARATE_RESPONSE_TIMEOUT_MS \
+	(CONFIG_COAP_INIT_ACK_TIMEOUT_MS * \
+	 ((2U << CONFIG_COAP_MAX_RETRANSMIT) - 1U) * 3U / 2U)
+
+/* Hashed timer wheel shared by all the transfers: a block waiting for its
+ * retransmission is kept in the slot of the tick it expires in, so that it
+ * is armed and disarmed in constant time and a single work item services
+ * all the pending requests.
+ */
+static sys_dlist_t wheel[WHEEL_SLOTS];
+static struct k_spinlock wheel_lock;
+static uint32_t wheel_tick; /* Last tick fully elapsed */
+static size_t wheel_count;
+static bool wheel_ready;
+
+static void wheel_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(wheel_work, wheel_handler);
+
+static void block_expired(struct coap_transfer_block *blk);
+
+static uint32_t block_expiry(const struct coap_transfer_block *blk)
+{
+	return blk->pending.t0 + blk->pending.timeout;
+}
+
+static void wheel_init(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&wheel_lock);
+
+	if (!wheel_ready) {
+		for (int i = 0; i < WHEEL_SLOTS; i++) {
+			sys_dlist_init(&wheel[i]);
+		}
+
+		wheel_ready = true;
+	}
+
+	k_spin_unlock(&wheel_lock, key);
+}
+
+static void wheel_remove_locked(struct coap_transfer_block *blk)
+{
+	if (sys_dnode_is_linked(&blk->node)) {
+		sys_dlist_remove(&blk->node);
+		wheel_count--;
+	}
+}
+
+static void wheel_arm(struct coap_transfer_block *blk)
+{
+	uint32_t tick = block_expiry(blk) / WHEEL_TICK_MS;
+	k_spinlock_key_t key = k_spin_lock(&wheel_lock);
+	bool start = false;
+
+	wheel_remove_locked(blk);
+
+	if (wheel_count == 0) {
+		wheel_tick = k_uptime_get_32() / WHEEL_TICK_MS - 1U;
+		start = true;
+	}
+
+	/* A tick already processed would only be seen again a revolution
+	 * later.
+	 */
+	if ((int32_t)(tick - wheel_tick) <= 0) {
+		tick = wheel_tick + 1U;
+	}
+
+	sys_dlist_append(&wheel[tick % WHEEL_SLOTS], &blk->node);
+	wheel_count++;
+
+	k_spin_unlock(&wheel_lock, key);
+
+	if (start) {
+		k_work_reschedule(&wheel_work, K_MSEC(WHEEL_TICK_MS));
+	}
+}
+
+static void wheel_disarm(struct coap_transfer_block *blk)
+{
+	k_spinlock_key_t key = k_spin_lock(&wheel_lock);
+
+	wheel_remove_locked(blk);
+
+	k_spin_unlock(&wheel_lock, key);
+}
+
+static struct coap_transfer_block *wheel_pop_expired(uint32_t now)
+{
+	int32_t ticks = (int32_t)(now / WHEEL_TICK_MS - 1U - wheel_tick);
+	struct coap_transfer_block *blk;
+
+	ticks = MIN(ticks, WHEEL_SLOTS);
+
+	for (int32_t i = 1; i <= ticks; i++) {
+		sys_dlist_t *slot = &wheel[(wheel_tick + i) % WHEEL_SLOTS];
+
+		/* Blocks expiring in a later revolution stay in the slot */
+		SYS_DLIST_FOR_EACH_CONTAINER(slot, blk, node) {
+			if ((int32_t)(block_expiry(blk) - now) <= 0) {
+				sys_dlist_remove(&blk->node);
+				wheel_count--;
+				return blk;
+			}
+		}
+	}
+
+	return NULL;
+}
+
+static void wheel_handler(struct k_work *work)
+{
+	uint32_t now = k_uptime_get_32();
+	struct coap_transfer_block *blk;
+	k_spinlock_key_t key;
+	bool more;
+
+	ARG_UNUSED(work);
+
+	do {
+		key = k_spin_lock(&wheel_lock);
+		blk = wheel_pop_expired(now);
+		k_spin_unlock(&wheel_lock, key);
+
+		if (blk) {
+			block_expired(blk);
+		}
+	} while (blk);
+
+	key = k_spin_lock(&wheel_lock);
+	wheel_tick = now / WHEEL_TICK_MS - 1U;
+	more = wheel_count > 0;
+	k_spin_unlock(&wheel_lock, key);
+
+	if (more) {
+		k_work_reschedule(&wheel_work, K_MSEC(WHEEL_TICK_MS));
+	}
+}
+
+static bool is_upload(const struct coap_transfer *xfer)
+{
+	return xfer->params.method != COAP_METHOD_GET;
+}
+
+static uint16_t block_bytes(const struct coap_transfer *xfer)
+{
+	return coap_block_size_to_bytes(xfer->params.block_size);
+}
+
+static uint8_t transfer_window(const struct coap_transfer *xfer)
+{
+	if (is_upload(xfer)) {
+		return 1U;
+	}
+
+	return CLAMP(xfer->params.window, 1, CONFIG_COAP_TRANSFER_MAX_INFLIGHT);
+}
+
+static void transfer_end(struct coap_transfer *xfer, int result)
+{
+	if (xfer->done) {
+		return;
+	}
+
+	NET_DBG("Transfer %p ended (%d), code 0x%02x", xfer, result,
+		xfer->code);
+
+	xfer->done = true;
+	xfer->result = result;
+
+	for (int i = 0; i < ARRAY_SIZE(xfer->blocks); i++) {
+		wheel_disarm(&xfer->blocks[i]);
+		xfer->blocks[i].state = COAP_TRANSFER_BLOCK_FREE;
+	}
+
+	if (xfer->params.done_cb) {
+		xfer->params.done_cb(xfer, result, xfer->code,
+				     xfer->params.user_data);
+	}
+}
+
+static int block_send(struct coap_transfer *xfer,
+		      struct coap_transfer_block *blk)
+{
+	ssize_t ret;
+
+	ret = zsock_sendto(xfer->sock, blk->buf, blk->len, 0, &xfer->addr,
+			   xfer->addrlen);
+	if (ret < 0) {
+		NET_ERR("Cannot send block %u (%d)", blk->num, -errno);
+		return -errno;
+	}
+
+	return 0;
+}
+
+static int append_path(struct coap_packet *cpkt, const char *path)
+{
+	const char *end;
+	int ret;
+
+	while (*path) {
+		end = strchr(path, '/');
+		if (!end) {
+			end = path + strlen(path);
+		}
+
+		if (end != path) {
+			ret = coap_packet_append_option(cpkt,
+							COAP_OPTION_URI_PATH,
+							(const uint8_t *)path,
+							end - path);
+			if (ret < 0) {
+				return ret;
+			}
+		}
+
+		path = *end ? end + 1 : end;
+	}
+
+	return 0;
+}
+
+static int block_upload_options(struct coap_transfer *xfer,
+				struct coap_transfer_block *blk,
+				struct coap_packet *cpkt, uint8_t *data)
+{
+	uint16_t bytes = block_bytes(xfer);
+	size_t offset = (size_t)blk->num * bytes;
+	size_t total = xfer->params.total_size;
+	int ret;
+	int len;
+
+	len = xfer->params.read_cb(xfer, offset, data, bytes,
+				   xfer->params.user_data);
+	if (len < 0) {
+		return len;
+	}
+
+	if (len > bytes) {
+		return -EINVAL;
+	}
+
+	blk->more = len == bytes && (total == 0 || offset + len < total);
+	if (!blk->more) {
+		xfer->last_num = blk->num;
+		xfer->last_known = true;
+	}
+
+	ret = coap_append_option_int(cpkt, COAP_OPTION_BLOCK1,
+				     (blk->num << 4) | (blk->more ? 0x08 : 0) |
+				     xfer->params.block_size);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (blk->num == 0U && total > 0) {
+		ret = coap_append_option_int(cpkt, COAP_OPTION_SIZE1, total);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return len;
+}
+
+static int block_request(struct coap_transfer *xfer,
+			 struct coap_transfer_block *blk, uint32_t num)
+{
+	/* Uploaded data is read at the end of the buffer, as the Block1
+	 * option depends on its length, then moved after the options.
+	 */
+	uint8_t *data = blk->buf + sizeof(blk->buf) - block_bytes(xfer);
+	struct coap_packet cpkt;
+	int len = 0;
+	int ret;
+
+	blk->num = num;
+	memcpy(blk->token, coap_next_token(), sizeof(blk->token));
+
+	ret = coap_packet_init(&cpkt, blk->buf, sizeof(blk->buf),
+			       COAP_VERSION_1, COAP_TYPE_CON,
+			       sizeof(blk->token), blk->token,
+			       xfer->params.method, coap_next_id());
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = append_path(&cpkt, xfer->params.path);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (is_upload(xfer)) {
+		len = block_upload_options(xfer, blk, &cpkt, data);
+		if (len < 0) {
+			return len;
+		}
+	} else {
+		ret = coap_append_option_int(&cpkt, COAP_OPTION_BLOCK2,
+					     (num << 4) |
+					     xfer->params.block_size);
+		if (ret < 0) {
+			return ret;
+		}
+
+		/* Ask for the size of the body in the first response */
+		if (num == 0U) {
+			ret = coap_append_option_int(&cpkt, COAP_OPTION_SIZE2,
+						     0);
+			if (ret < 0) {
+				return ret;
+			}
+		}
+	}
+
+	if (len > 0) {
+		ret = coap_packet_append_payload_marker(&cpkt);
+		if (ret < 0) {
+			return ret;
+		}
+
+		if (cpkt.offset > data - blk->buf) {
+			return -EMSGSIZE;
+		}
+
+		memmove(cpkt.data + cpkt.offset, data, len);
+		cpkt.offset += len;
+	}
+
+	blk->len = cpkt.offset;
+
+	ret = coap_pending_init(&blk->pending, &cpkt, &xfer->addr,
+				CONFIG_COAP_MAX_RETRANSMIT);
+	if (ret < 0) {
+		return ret;
+	}
+
+	(void)coap_pending_cycle(&blk->pending);
+
+	NET_DBG("Transfer %p: request block %u", xfer, num);
+
+	ret = block_send(xfer, blk);
+	if (ret < 0) {
+		return ret;
+	}
+
+	blk->state = COAP_TRANSFER_BLOCK_SENT;
+	wheel_arm(blk);
+
+	return 0;
+}
+
+static struct coap_transfer_block *block_free(struct coap_transfer *xfer)
+{
+	for (int i = 0; i < ARRAY_SIZE(xfer->blocks); i++) {
+		if (xfer->blocks[i].state == COAP_TRANSFER_BLOCK_FREE) {
+			return &xfer->blocks[i];
+		}
+	}
+
+	return NULL;
+}
+
+static int fill_window(struct coap_transfer *xfer)
+{
+	struct coap_transfer_block *blk;
+	size_t used = 0;
+	int ret;
+
+	for (int i = 0; i < ARRAY_SIZE(xfer->blocks); i++) {
+		if (xfer->blocks[i].state != COAP_TRANSFER_BLOCK_FREE) {
+			used++;
+		}
+	}
+
+	while (!xfer->done && used < transfer_window(xfer)) {
+		if (xfer->last_known && xfer->next_num > xfer->last_num) {
+			break;
+		}
+
+		/* The server may reduce the block size in its first
+		 * response, so that the number of the next blocks is only
+		 * known then.
+		 */
+		if (!is_upload(xfer) && !xfer->size_fixed &&
+		    xfer->next_num > 0U) {
+			break;
+		}
+
+		blk = block_free(xfer);
+		if (!blk) {
+			break;
+		}
+
+		ret = block_request(xfer, blk, xfer->next_num);
+		if (ret < 0) {
+			return ret;
+		}
+
+		xfer->next_num++;
+		used++;
+	}
+
+	return 0;
+}
+
+static int deliver(struct coap_transfer *xfer)
+{
+	struct coap_transfer_block *blk;
+	bool found;
+	int ret;
+
+	do {
+		found = false;
+
+		for (int i = 0; i < ARRAY_SIZE(xfer->blocks); i++) {
+			blk = &xfer->blocks[i];
+
+			if (blk->state != COAP_TRANSFER_BLOCK_RECEIVED ||
+			    blk->num != xfer->deliver_num) {
+				continue;
+			}
+
+			ret = xfer->params.data_cb(xfer, xfer->offset,
+						   blk->buf, blk->len,
+						   !blk->more,
+						   xfer->params.user_data);
+			if (ret < 0) {
+				return ret;
+			}
+
+			xfer->offset += blk->len;
+			xfer->deliver_num++;
+			blk->state = COAP_TRANSFER_BLOCK_FREE;
+
+			if (!blk->more) {
+				transfer_end(xfer, 0);
+				return 0;
+			}
+
+			found = true;
+			break;
+		}
+	} while (found);
+
+	return 0;
+}
+
+static int download_response(struct coap_transfer *xfer,
+			     struct coap_transfer_block *blk,
+			     const struct coap_packet *cpkt, uint8_t code)
+{
+	const uint8_t *payload;
+	uint16_t payload_len;
+	int block;
+	int size;
+
+	if (code != COAP_RESPONSE_CODE_CONTENT) {
+		/* Blocks requested past the end of a body of unknown size
+		 * are refused.
+		 */
+		if (xfer->last_known && blk->num > xfer->last_num) {
+			blk->state = COAP_TRANSFER_BLOCK_FREE;
+			return 0;
+		}
+
+		xfer->code = code;
+		return -EPROTO;
+	}
+
+	xfer->code = code;
+
+	payload = coap_packet_get_payload(cpkt, &payload_len);
+	if (!payload) {
+		payload_len = 0U;
+	}
+
+	block = coap_get_option_int(cpkt, COAP_OPTION_BLOCK2);
+	if (block < 0) {
+		/* The body was sent at once */
+		if (blk->num != 0U || payload_len > sizeof(blk->buf)) {
+			return -EPROTO;
+		}
+
+		blk->more = false;
+	} else {
+		if (GET_BLOCK_NUM(block) != blk->num) {
+			return -EPROTO;
+		}
+
+		if (!xfer->size_fixed) {
+			if (GET_BLOCK_SIZE(block) > xfer->params.block_size) {
+				return -EPROTO;
+			}
+
+			xfer->params.block_size = GET_BLOCK_SIZE(block);
+			xfer->size_fixed = true;
+
+			size = coap_get_option_int(cpkt, COAP_OPTION_SIZE2);
+			if (size > 0) {
+				xfer->last_num = (size - 1) / block_bytes(xfer);
+				xfer->last_known = true;
+			}
+		} else if (GET_BLOCK_SIZE(block) != xfer->params.block_size) {
+			return -EPROTO;
+		}
+
+		blk->more = GET_MORE(block);
+
+		if (payload_len > block_bytes(xfer) ||
+		    (blk->more && payload_len != block_bytes(xfer))) {
+			return -EPROTO;
+		}
+	}
+
+	/* The More flag prevails over the size given by the server */
+	if (!blk->more) {
+		xfer->last_num = blk->num;
+		xfer->last_known = true;
+	} else if (xfer->last_known && blk->num >= xfer->last_num) {
+		xfer->last_num = blk->num + 1U;
+	}
+
+	if (payload_len > 0U) {
+		memcpy(blk->buf, payload, payload_len);
+	}
+
+	blk->len = payload_len;
+	blk->state = COAP_TRANSFER_BLOCK_RECEIVED;
+
+	return deliver(xfer);
+}
+
+static int upload_response(struct coap_transfer *xfer,
+			   struct coap_transfer_block *blk,
+			   const struct coap_packet *cpkt, uint8_t code)
+{
+	uint16_t bytes = block_bytes(xfer);
+	int block;
+
+	xfer->code = code;
+
+	if ((code >> 5) != 2) {
+		return -EPROTO;
+	}
+
+	blk->state = COAP_TRANSFER_BLOCK_FREE;
+
+	if (!blk->more) {
+		transfer_end(xfer, 0);
+		return 0;
+	}
+
+	/* The server may ask for smaller blocks, see RFC 7959 figure 7 */
+	block = coap_get_option_int(cpkt, COAP_OPTION_BLOCK1);
+	if (block >= 0 && GET_BLOCK_SIZE(block) < xfer->params.block_size) {
+		xfer->params.block_size = GET_BLOCK_SIZE(block);
+		xfer->next_num = (blk->num + 1U) * bytes / block_bytes(xfer);
+	}
+
+	return 0;
+}
+
+static struct coap_transfer_block *block_find(struct coap_transfer *xfer,
+					      uint8_t type, uint16_t id,
+					      const uint8_t *token,
+					      uint8_t tkl)
+{
+	struct coap_transfer_block *blk;
+
+	for (int i = 0; i < ARRAY_SIZE(xfer->blocks); i++) {
+		blk = &xfer->blocks[i];
+
+		if (blk->state != COAP_TRANSFER_BLOCK_SENT &&
+		    blk->state != COAP_TRANSFER_BLOCK_ACKED) {
+			continue;
+		}
+
+		/* Acknowledgments and resets are matched by message ID,
+		 * separate responses by token.
+		 */
+		if (type == COAP_TYPE_ACK || type == COAP_TYPE_RESET) {
+			if (blk->state == COAP_TRANSFER_BLOCK_SENT &&
+			    blk->pending.id == id) {
+				return blk;
+			}
+		} else if (tkl == sizeof(blk->token) &&
+			   memcmp(blk->token, token, tkl) == 0) {
+			return blk;
+		}
+	}
+
+	return NULL;
+}
+
+static void send_empty_ack(struct coap_transfer *xfer, uint16_t id)
+{
+	struct coap_packet cpkt;
+	uint8_t buf[4];
+
+	if (coap_packet_init(&cpkt, buf, sizeof(buf), COAP_VERSION_1,
+			     COAP_TYPE_ACK, 0, NULL, COAP_CODE_EMPTY,
+			     id) < 0) {
+		return;
+	}
+
+	(void)zsock_sendto(xfer->sock, cpkt.data, cpkt.offset, 0,
+			   &xfer->addr, xfer->addrlen);
+}
+
+int coap_transfer_input(struct coap_transfer *xfer, uint8_t *data,
+			uint16_t len, const struct sockaddr *from)
+{
+	uint8_t token[COAP_TOKEN_MAX_LEN];
+	struct coap_transfer_block *blk;
+	struct coap_packet cpkt;
+	uint8_t type;
+	uint8_t code;
+	uint16_t id;
+	uint8_t tkl;
+	int ret;
+
+	if (from && from->sa_family != xfer->addr.sa_family) {
+		return -ENOENT;
+	}
+
+	ret = coap_packet_parse(&cpkt, data, len, NULL, 0);
+	if (ret < 0) {
+		return ret;
+	}
+
+	type = coap_header_get_type(&cpkt);
+	code = coap_header_get_code(&cpkt);
+	id = coap_header_get_id(&cpkt);
+	tkl = coap_header_get_token(&cpkt, token);
+
+	k_mutex_lock(&xfer->lock, K_FOREVER);
+
+	if (xfer->done) {
+		ret = -ENOENT;
+		goto out;
+	}
+
+	/* Confirmable responses are acknowledged, even duplicated ones */
+	if (type == COAP_TYPE_CON) {
+		send_empty_ack(xfer, id);
+	}
+
+	blk = block_find(xfer, type, id, token, tkl);
+	if (!blk) {
+		ret = -ENOENT;
+		goto out;
+	}
+
+	if (type == COAP_TYPE_RESET) {
+		transfer_end(xfer, -ECONNRESET);
+		goto out;
+	}
+
+	if (code == COAP_CODE_EMPTY) {
+		/* The response will be sent separately */
+		if (type == COAP_TYPE_ACK) {
+			blk->state = COAP_TRANSFER_BLOCK_ACKED;
+			blk->pending.t0 = k_uptime_get_32();
+			blk->pending.timeout = SEPARATE_RESPONSE_TIMEOUT_MS;
+			wheel_arm(blk);
+		}
+
+		goto out;
+	}
+
+	wheel_disarm(blk);
+
+	if (is_upload(xfer)) {
+		ret = upload_response(xfer, blk, &cpkt, code);
+	} else {
+		ret = download_response(xfer, blk, &cpkt, code);
+	}
+
+	if (ret == 0) {
+		ret = fill_window(xfer);
+	}
+
+	if (ret < 0) {
+		transfer_end(xfer, ret);
+		ret = 0;
+	}
+
+out:
+	k_mutex_unlock(&xfer->lock);
+
+	return ret;
+}
+
+static void block_expired(struct coap_transfer_block *blk)
+{
+	struct coap_transfer *xfer = blk->xfer;
+	int ret;
+
+	k_mutex_lock(&xfer->lock, K_FOREVER);
+
+	/* The block may have been answered, or armed again, meanwhile */
+	if (xfer->done || sys_dnode_is_linked(&blk->node) ||
+	    (int32_t)(block_expiry(blk) - k_uptime_get_32()) > 0) {
+		goto out;
+	}
+
+	if (blk->state == COAP_TRANSFER_BLOCK_ACKED) {
+		NET_DBG("Transfer %p: no response for block %u", xfer,
+			blk->num);
+		transfer_end(xfer, -ETIMEDOUT);
+		goto out;
+	}
+
+	if (blk->state != COAP_TRANSFER_BLOCK_SENT) {
+		goto out;
+	}
+
+	if (!coap_pending_cycle(&blk->pending)) {
+		NET_DBG("Transfer %p: block %u not acknowledged", xfer,
+			blk->num);
+		transfer_end(xfer, -ETIMEDOUT);
+		goto out;
+	}
+
+	NET_DBG("Transfer %p: retransmit block %u", xfer, blk->num);
+
+	ret = block_send(xfer, blk);
+	if (ret < 0) {
+		transfer_end(xfer, ret);
+		goto out;
+	}
+
+	wheel_arm(blk);
+
+out:
+	k_mutex_unlock(&xfer->lock);
+}
+
+int coap_transfer_start(struct coap_transfer *xfer, int sock,
+			const struct sockaddr *addr, socklen_t addrlen,
+			const struct coap_transfer_params *params)
+{
+	size_t needed;
+	int ret;
+
+	if (!xfer || !addr || !params || !params->path ||
+	    addrlen > sizeof(xfer->addr)) {
+		return -EINVAL;
+	}
+
+	switch (params->method) {
+	case COAP_METHOD_GET:
+		if (!params->data_cb) {
+			return -EINVAL;
+		}
+		break;
+	case COAP_METHOD_PUT:
+	case COAP_METHOD_POST:
+		if (!params->read_cb) {
+			return -EINVAL;
+		}
+		break;
+	default:
+		return -ENOTSUP;
+	}
+
+	if (params->block_size > COAP_BLOCK_1024) {
+		return -EINVAL;
+	}
+
+	needed = coap_block_size_to_bytes(params->block_size) +
+		 2 * strlen(params->path) + PACKET_OVERHEAD;
+	if (needed > CONFIG_COAP_TRANSFER_BUF_SIZE) {
+		NET_ERR("Block size %u too large for the buffers",
+			coap_block_size_to_bytes(params->block_size));
+		return -EMSGSIZE;
+	}
+
+	wheel_init();
+
+	memset(xfer, 0, sizeof(*xfer));
+	k_mutex_init(&xfer->lock);
+	memcpy(&xfer->params, params, sizeof(xfer->params));
+	memcpy(&xfer->addr, addr, addrlen);
+	xfer->addrlen = addrlen;
+	xfer->sock = sock;
+
+	for (int i = 0; i < ARRAY_SIZE(xfer->blocks); i++) {
+		xfer->blocks[i].xfer = xfer;
+		sys_dnode_init(&xfer->blocks[i].node);
+	}
+
+	k_mutex_lock(&xfer->lock, K_FOREVER);
+
+	ret = fill_window(xfer);
+	if (ret < 0) {
+		/* Nothing was started, the done callback is not called */
+		xfer->params.done_cb = NULL;
+		transfer_end(xfer, ret);
+	}
+
+	k_mutex_unlock(&xfer->lock);
+
+	return ret;
+}
+
+int coap_transfer_run(struct coap_transfer *xfer)
+{
+	struct zsock_pollfd fds = {
+		.fd = xfer->sock,
+		.events = ZSOCK_POLLIN,
+	};
+	struct sockaddr from;
+	socklen_t fromlen;
+	ssize_t len;
+	int ret;
+
+	while (!xfer->done) {
+		ret = zsock_poll(&fds, 1, WHEEL_TICK_MS);
+		if (ret == 0) {
+			continue;
+		}
+
+		if (ret > 0) {
+			fromlen = sizeof(from);
+			len = zsock_recvfrom(xfer->sock, xfer->recv_buf,
+					     sizeof(xfer->recv_buf), 0,
+					     &from, &fromlen);
+			if (len >= 0) {
+				(void)coap_transfer_input(xfer,
+							  xfer->recv_buf,
+							  len, &from);
+				continue;
+			}
+		}
+
+		ret = -errno;
+		if (ret == -EAGAIN || ret == -EINTR) {
+			continue;
+		}
+
+		k_mutex_lock(&xfer->lock, K_FOREVER);
+		transfer_end(xfer, ret);
+		k_mutex_unlock(&xfer->lock);
+	}
+
+	return xfer->result;
+}
+
+void coap_transfer_cancel(struct coap_transfer *xfer)
+{
+	k_mutex_lock(&xfer->lock, K_FOREVER);
+	transfer_end(xfer, -ECANCELED);
+	k_mutex_unlock(&xfer->lock);
+}
@@ -0,0 +1,210 @@
+/** @file
+ * @brief DNS answer cache
+ *
+ * Cache of the answers received by the DNS resolver, shared by all the
+ * DNS contexts.
+ */
+
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_dns_resolve, CONFIG_DNS_RESOLVER_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <string.h>
+#include <errno.h>
+
+#include <zephyr/net/dns_resolve.h>
+#include "dns_internal.h"
+
+struct dns_cache_entry {
+	/** Addresses of the answer */
+	struct sockaddr addrs[CONFIG_DNS_RESOLVER_CACHE_MAX_ADDRS];
+
+	/** Uptime (in ms) the answer expires at */
+	int64_t expiry;
+
+	/** Uptime (in ms) after which the answer is refreshed */
+	int64_t refresh;
+
+	/** Value of the use counter when the entry was last used */
+	uint32_t last_used;
+
+	/** Status of the answer, DNS_EAI_ALLDONE or the cached failure */
+	int status;
+
+	/** Query type */
+	enum dns_query_type type;
+
+	/** Number of addresses */
+	uint8_t count;
+
+	/** A query refreshing the entry is pending */
+	bool prefetching;
+
+	/** Queried name, empty if the entry is not used */
+	char query[CONFIG_DNS_RESOLVER_CACHE_NAME_LEN + 1];
+};
+
+static struct dns_cache_entry cache[CONFIG_DNS_RESOLVER_CACHE_ENTRIES];
+static uint32_t use_counter;
+static K_MUTEX_DEFINE(cache_lock);
+
+/* Must be invoked with cache lock held */
+static struct dns_cache_entry *cache_lookup(const char *query,
+					    enum dns_query_type type)
+{
+	for (int i = 0; i < ARRAY_SIZE(cache); i++) {
+		if (cache[i].type == type && cache[i].query[0] != '\0' &&
+		    strcmp(cache[i].query, query) == 0) {
+			return &cache[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Return an unused or expired entry, or else the least recently used one.
+ * Entries being refreshed are not replaced, as the pending query uses
+ * their name.
+ *
+ * Must be invoked with cache lock held
+ */
+static struct dns_cache_entry *cache_get_free(int64_t now)
+{
+	struct dns_cache_entry *lru = NULL;
+
+	for (int i = 0; i < ARRAY_SIZE(cache); i++) {
+		if (cache[i].prefetching) {
+			continue;
+		}
+
+		if (cache[i].query[0] == '\0' || cache[i].expiry <= now) {
+			return &cache[i];
+		}
+
+		if (!lru || (int32_t)(cache[i].last_used -
+				      lru->last_used) < 0) {
+			lru = &cache[i];
+		}
+	}
+
+	return lru;
+}
+
+int dns_cache_find(const char *query, enum dns_query_type type,
+		   struct sockaddr *addrs, int max_addrs, int *status,
+		   const char **prefetch)
+{
+	struct dns_cache_entry *entry;
+	int64_t now = k_uptime_get();
+	int count;
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	entry = cache_lookup(query, type);
+	if (!entry || entry->expiry <= now) {
+		count = -ENOENT;
+		goto unlock;
+	}
+
+	count = MIN(entry->count, max_addrs);
+	memcpy(addrs, entry->addrs, count * sizeof(struct sockaddr));
+	*status = entry->status;
+	entry->last_used = ++use_counter;
+
+	if (IS_ENABLED(CONFIG_DNS_RESOLVER_CACHE_PREFETCH) &&
+	    entry->status == DNS_EAI_ALLDONE && !entry->prefetching &&
+	    now >= entry->refresh) {
+		entry->prefetching = true;
+		*prefetch = entry->query;
+	}
+
+unlock:
+	k_mutex_unlock(&cache_lock);
+
+	return count;
+}
+
+void dns_cache_update(const char *query, enum dns_query_type type,
+		      int status, const struct sockaddr *addrs, int count,
+		      uint32_t ttl)
+{
+	struct dns_cache_entry *entry;
+	int64_t now = k_uptime_get();
+
+	if (strlen(query) > CONFIG_DNS_RESOLVER_CACHE_NAME_LEN) {
+		return;
+	}
+
+	if (status == DNS_EAI_ALLDONE && count > 0) {
+		ttl = MIN(ttl, CONFIG_DNS_RESOLVER_CACHE_MAX_TTL);
+	} else if (status == DNS_EAI_NODATA || status == DNS_EAI_NONAME) {
+		ttl = CONFIG_DNS_RESOLVER_CACHE_NEGATIVE_TTL;
+		count = 0;
+	} else {
+		ttl = 0U;
+	}
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	entry = cache_lookup(query, type);
+
+	if (ttl == 0U) {
+		/* Keep a cached answer if refreshing it failed, it is still
+		 * valid until it expires.
+		 */
+		if (entry) {
+			entry->prefetching = false;
+		}
+
+		goto unlock;
+	}
+
+	if (!entry) {
+		entry = cache_get_free(now);
+		if (!entry) {
+			goto unlock;
+		}
+
+		/* The name of a refresh query is the one of the entry */
+		if (entry->query != query) {
+			strcpy(entry->query, query);
+		}
+
+		entry->type = type;
+	}
+
+	count = MIN(count, CONFIG_DNS_RESOLVER_CACHE_MAX_ADDRS);
+	if (count > 0) {
+		memcpy(entry->addrs, addrs, count * sizeof(struct sockaddr));
+	}
+
+	entry->count = count;
+	entry->status = status;
+	entry->expiry = now + (int64_t)ttl * MSEC_PER_SEC;
+	entry->refresh = entry->expiry - (int64_t)ttl * MSEC_PER_SEC / 10;
+	entry->last_used = ++use_counter;
+	entry->prefetching = false;
+
+	NET_DBG("Cached %s type %d status %d (%d addresses, ttl %u)",
+		entry->query, type, status, count, ttl);
+
+unlock:
+	k_mutex_unlock(&cache_lock);
+}
+
+void dns_resolve_cache_flush(void)
+{
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	for (int i = 0; i < ARRAY_SIZE(cache); i++) {
+		cache[i].expiry = 0;
+	}
+
+	k_mutex_unlock(&cache_lock);
+}
@@ -18,3 +18,24 @@ int dns_validate_msg(struct dns_resolve_context *ctx,
 		     struct net_buf *dns_cname,
 		     uint16_t *query_hash);
 #endif
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+/* Look up the answer to a query in the cache.
+ *
+ * Returns the number of addresses copied to addrs, with the status of the
+ * answer in *status (DNS_EAI_ALLDONE, or the failure that was cached), or
+ * -ENOENT if the answer is not cached. If the entry should be refreshed,
+ * *prefetch is set to the name to query, which stays valid until the
+ * refresh query is done.
+ */
+int dns_cache_find(const char *query, enum dns_query_type type,
+		   struct sockaddr *addrs, int max_addrs, int *status,
+		   const char **prefetch);
+
+/* Store the answer to a query in the cache, ttl being in seconds. Statuses
+ * that are not cacheable only end a pending refresh of the entry.
+ */
+void dns_cache_update(const char *query, enum dns_query_type type,
+		      int status, const struct sockaddr *addrs, int count,
+		      uint32_t ttl);
+#endif
@@ -68,6 +68,9 @@ LOG_MODULE_REGISTER(net_dns_resolve, CONFIG_DNS_RESOLVER_LOG_LEVEL);
 #define DNS_IPV4_LEN		sizeof(struct in_addr)
 #define DNS_IPV6_LEN		sizeof(struct in6_addr)
 
+/* Timeout of the queries refreshing the cache in the background */
+#define DNS_PREFETCH_TIMEOUT	3000 /* ms */
+
 NET_BUF_POOL_DEFINE(dns_msg_pool, DNS_RESOLVER_BUF_CTR,
 		    DNS_RESOLVER_MAX_BUF_SIZE, 0, NULL);
 
@@ -398,6 +401,40 @@ static inline int get_cb_slot(struct dns_resolve_context *ctx)
 	return -ENOENT;
 }
 
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+/* Must be invoked with context lock held */
+static void cache_collect(struct dns_pending_query *pending_query,
+			  const struct dns_addrinfo *info, uint32_t ttl)
+{
+	pending_query->cache_ttl = MIN(pending_query->cache_ttl, ttl);
+
+	if (pending_query->cache_count < ARRAY_SIZE(pending_query->cache_addrs)) {
+		memcpy(&pending_query->cache_addrs[pending_query->cache_count],
+		       &info->ai_addr, sizeof(struct sockaddr));
+		pending_query->cache_count++;
+	}
+}
+
+/* Must be invoked with context lock held */
+static void cache_query_done(int status,
+			     struct dns_pending_query *pending_query)
+{
+	dns_cache_update(pending_query->query, pending_query->query_type,
+			 status, pending_query->cache_addrs,
+			 pending_query->cache_count, pending_query->cache_ttl);
+}
+#else
+static inline void cache_collect(struct dns_pending_query *pending_query,
+				 const struct dns_addrinfo *info, uint32_t ttl)
+{
+}
+
+static inline void cache_query_done(int status,
+				    struct dns_pending_query *pending_query)
+{
+}
+#endif /* CONFIG_DNS_RESOLVER_CACHE */
+
 /* Invoke the callback associated with a query slot, if still relevant.
  *
  * Must be invoked with context lock held.
@@ -414,6 +451,10 @@ static inline void invoke_query_callback(int status,
 	 * being released.
 	 */
 	if (pending_query->query != NULL)  {
+		if (status != DNS_EAI_INPROGRESS) {
+			cache_query_done(status, pending_query);
+		}
+
 		pending_query->cb(status, info, pending_query->user_data);
 	}
 }
@@ -472,7 +513,7 @@ int dns_validate_msg(struct dns_resolve_context *ctx,
 		     uint16_t *query_hash)
 {
 	struct dns_addrinfo info = { 0 };
-	uint32_t ttl; /* RR ttl, so far it is not passed to caller */
+	uint32_t ttl; /* RR ttl, only used by the cache */
 	uint8_t *src, *addr;
 	const char *query_name;
 	int address_size;
@@ -509,6 +550,12 @@ int dns_validate_msg(struct dns_resolve_context *ctx,
 		goto quit;
 	}
 
+	/* The name does not exist, which can be cached unlike other errors */
+	if (dns_header_rcode(dns_msg->msg) == DNS_HEADER_NAMEERROR) {
+		ret = DNS_EAI_NONAME;
+		goto quit;
+	}
+
 	ret = dns_unpack_response_header(dns_msg, *dns_id);
 	if (ret < 0) {
 		ret = DNS_EAI_FAIL;
@@ -633,6 +680,8 @@ query_known:
 			src = dns_msg->msg + dns_msg->response_position;
 			memcpy(addr, src, address_size);
 
+			cache_collect(&ctx->queries[*query_idx], &info, ttl);
+
 			invoke_query_callback(DNS_EAI_INPROGRESS, &info,
 					      &ctx->queries[*query_idx]);
 			items++;
@@ -1105,13 +1154,85 @@ static void query_timeout(struct k_work *work)
 	k_mutex_unlock(&pending_query->ctx->lock);
 }
 
-int dns_resolve_name(struct dns_resolve_context *ctx,
-		     const char *query,
-		     enum dns_query_type type,
-		     uint16_t *dns_id,
-		     dns_resolve_cb_t cb,
-		     void *user_data,
-		     int32_t timeout)
+static int resolve_name(struct dns_resolve_context *ctx,
+			const char *query,
+			enum dns_query_type type,
+			uint16_t *dns_id,
+			dns_resolve_cb_t cb,
+			void *user_data,
+			int32_t timeout,
+			bool use_cache);
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+static void prefetch_cb(enum dns_resolve_status status,
+			struct dns_addrinfo *info, void *user_data)
+{
+	/* The answer is cached by invoke_query_callback() */
+	ARG_UNUSED(status);
+	ARG_UNUSED(info);
+	ARG_UNUSED(user_data);
+}
+
+static int resolve_from_cache(struct dns_resolve_context *ctx,
+			      const char *query,
+			      enum dns_query_type type,
+			      dns_resolve_cb_t cb,
+			      void *user_data)
+{
+	struct sockaddr addrs[CONFIG_DNS_RESOLVER_CACHE_MAX_ADDRS];
+	struct dns_addrinfo info = { 0 };
+	const char *prefetch = NULL;
+	int status;
+	int count;
+	int ret;
+
+	count = dns_cache_find(query, type, addrs, ARRAY_SIZE(addrs), &status,
+			       &prefetch);
+	if (count < 0) {
+		return count;
+	}
+
+	NET_DBG("Resolved %s from the cache (status %d)", query, status);
+
+	for (int i = 0; i < count; i++) {
+		memcpy(&info.ai_addr, &addrs[i], sizeof(info.ai_addr));
+		info.ai_family = addrs[i].sa_family;
+
+		if (info.ai_family == AF_INET) {
+			info.ai_addrlen = sizeof(struct sockaddr_in);
+		} else {
+			info.ai_addrlen = sizeof(struct sockaddr_in6);
+		}
+
+		cb(DNS_EAI_INPROGRESS, &info, user_data);
+	}
+
+	cb(status, NULL, user_data);
+
+	if (prefetch) {
+		ret = resolve_name(ctx, prefetch, type, NULL, prefetch_cb, NULL,
+				   DNS_PREFETCH_TIMEOUT, false);
+		if (ret < 0) {
+			NET_DBG("Cannot refresh %s (%d)", prefetch, ret);
+
+			/* Ends the refresh of the entry */
+			dns_cache_update(prefetch, type, DNS_EAI_CANCELED,
+					 NULL, 0, 0U);
+		}
+	}
+
+	return 0;
+}
+#endif /* CONFIG_DNS_RESOLVER_CACHE */
+
+static int resolve_name(struct dns_resolve_context *ctx,
+			const char *query,
+			enum dns_query_type type,
+			uint16_t *dns_id,
+			dns_resolve_cb_t cb,
+			void *user_data,
+			int32_t timeout,
+			bool use_cache)
 {
 	k_timeout_t tout;
 	struct net_buf *dns_data = NULL;
@@ -1181,6 +1302,13 @@ int dns_resolve_name(struct dns_resolve_context *ctx,
 		return 0;
 	}
 
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+	if (use_cache && resolve_from_cache(ctx, query, type, cb,
+					    user_data) == 0) {
+		return 0;
+	}
+#endif
+
 try_resolve:
 	k_mutex_lock(&ctx->lock, K_FOREVER);
 
@@ -1202,6 +1330,10 @@ try_resolve:
 	ctx->queries[i].user_data = user_data;
 	ctx->queries[i].ctx = ctx;
 	ctx->queries[i].query_hash = 0;
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+	ctx->queries[i].cache_ttl = UINT32_MAX;
+	ctx->queries[i].cache_count = 0U;
+#endif
 
 	k_work_init_delayable(&ctx->queries[i].timer, query_timeout);
 
@@ -1324,6 +1456,18 @@ fail:
 	return ret;
 }
 
+int dns_resolve_name(struct dns_resolve_context *ctx,
+		     const char *query,
+		     enum dns_query_type type,
+		     uint16_t *dns_id,
+		     dns_resolve_cb_t cb,
+		     void *user_data,
+		     int32_t timeout)
+{
+	return resolve_name(ctx, query, type, dns_id, cb, user_data, timeout,
+			    true);
+}
+
 /* Must be invoked with context lock held */
 static int dns_resolve_close_locked(struct dns_resolve_context *ctx)
 {
@@ -1414,6 +1558,9 @@ int dns_resolve_reconfigure(struct dns_resolve_context *ctx,
 
 	err = dns_resolve_init_locked(ctx, servers, servers_sa);
 
+	/* The answers of the previous servers may not be valid anymore */
+	dns_resolve_cache_flush();
+
 unlock:
 	k_mutex_unlock(&ctx->lock);
 
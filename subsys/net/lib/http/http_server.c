@@ -0,0 +1,676 @@
+/** @file
+ * @brief HTTP server API
+ *
+ * An API for applications to serve HTTP/1.1 requests
+ */
+
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_http_server, CONFIG_NET_HTTP_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <string.h>
+#include <errno.h>
+#include <stdbool.h>
+
+#include <zephyr/fs/fs.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/http_server.h>
+
+/* The listening socket is polled along with the connections */
+BUILD_ASSERT(CONFIG_HTTP_SERVER_MAX_CONNECTIONS < CONFIG_NET_SOCKETS_POLL_MAX,
+	     "CONFIG_NET_SOCKETS_POLL_MAX too small for the connections");
+
+/* Room for the hexadecimal size of a chunk and its CRLF */
+#define CHUNK_HDR_MAX_LEN (sizeof(size_t) * 2 + 2)
+
+static int sendall(int sock, const void *buf, size_t len)
+{
+	while (len) {
+		ssize_t out_len = zsock_send(sock, buf, len, 0);
+
+		if (out_len < 0) {
+			return -errno;
+		}
+
+		buf = (const char *)buf + out_len;
+		len -= out_len;
+	}
+
+	return 0;
+}
+
+static const char *status_str(uint16_t status)
+{
+	switch (status) {
+	case 200:
+		return "OK";
+	case 204:
+		return "No Content";
+	case 400:
+		return "Bad Request";
+	case 404:
+		return "Not Found";
+	case 405:
+		return "Method Not Allowed";
+	case 413:
+		return "Payload Too Large";
+	case 414:
+		return "URI Too Long";
+	case 500:
+		return "Internal Server Error";
+	case 503:
+		return "Service Unavailable";
+	default:
+		return "";
+	}
+}
+
+static int send_headers(struct http_server_conn *conn, uint16_t status,
+			const char *content_type, size_t content_len,
+			bool chunked)
+{
+	char *buf = (char *)conn->server->send_buf;
+	size_t size = sizeof(conn->server->send_buf);
+	bool http_1_0 = conn->parser.http_major == 1U &&
+			conn->parser.http_minor == 0U;
+	int len;
+
+	if (conn->responded) {
+		return -EALREADY;
+	}
+
+	conn->responded = true;
+
+	/* HTTP/1.0 clients do not know about chunks, the end of the body is
+	 * given by closing the connection instead.
+	 */
+	if (chunked && http_1_0) {
+		conn->keep_alive = false;
+	}
+
+	conn->chunked = chunked && !http_1_0;
+
+	len = snprintk(buf, size, "HTTP/1.1 %u %s\r\n", status,
+		       status_str(status));
+
+	if (content_type) {
+		len += snprintk(buf + len, size - MIN(len, size),
+				"Content-Type: %s\r\n", content_type);
+	}
+
+	if (conn->chunked) {
+		len += snprintk(buf + len, size - MIN(len, size),
+				"Transfer-Encoding: chunked\r\n");
+	} else if (!chunked) {
+		len += snprintk(buf + len, size - MIN(len, size),
+				"Content-Length: %zu\r\n", content_len);
+	}
+
+	if (!conn->keep_alive) {
+		len += snprintk(buf + len, size - MIN(len, size),
+				"Connection: close\r\n");
+	} else if (http_1_0) {
+		len += snprintk(buf + len, size - MIN(len, size),
+				"Connection: keep-alive\r\n");
+	}
+
+	len += snprintk(buf + len, size - MIN(len, size), "\r\n");
+	if (len >= size) {
+		LOG_ERR("Headers too long (%d)", len);
+		return -ENOMEM;
+	}
+
+	return sendall(conn->sock, buf, len);
+}
+
+int http_server_send_response(struct http_server_conn *conn, uint16_t status,
+			      const char *content_type, const void *body,
+			      size_t body_len)
+{
+	int ret;
+
+	ret = send_headers(conn, status, content_type, body_len, false);
+	if (ret < 0 || conn->head || body_len == 0U) {
+		return ret;
+	}
+
+	return sendall(conn->sock, body, body_len);
+}
+
+int http_server_send_chunked(struct http_server_conn *conn, uint16_t status,
+			     const char *content_type)
+{
+	return send_headers(conn, status, content_type, 0, true);
+}
+
+int http_server_send_chunk(struct http_server_conn *conn, const void *data,
+			   size_t len)
+{
+	char hdr[CHUNK_HDR_MAX_LEN + 1];
+	int hdr_len;
+	int ret;
+
+	if (conn->head) {
+		return 0;
+	}
+
+	if (!conn->chunked) {
+		/* Raw body of a HTTP/1.0 response, ended by closing */
+		return len ? sendall(conn->sock, data, len) : 0;
+	}
+
+	hdr_len = snprintk(hdr, sizeof(hdr), "%zx\r\n", len);
+
+	ret = sendall(conn->sock, hdr, hdr_len);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (len) {
+		ret = sendall(conn->sock, data, len);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return sendall(conn->sock, "\r\n", 2);
+}
+
+#if defined(CONFIG_HTTP_SERVER_FS)
+static const char *content_type_get(const char *path)
+{
+	static const struct {
+		const char *ext;
+		const char *type;
+	} types[] = {
+		{ ".html", "text/html" },
+		{ ".htm", "text/html" },
+		{ ".css", "text/css" },
+		{ ".js", "application/javascript" },
+		{ ".json", "application/json" },
+		{ ".txt", "text/plain" },
+		{ ".png", "image/png" },
+		{ ".jpg", "image/jpeg" },
+		{ ".svg", "image/svg+xml" },
+		{ ".ico", "image/x-icon" },
+	};
+	const char *ext = strrchr(path, '.');
+
+	if (ext) {
+		for (int i = 0; i < ARRAY_SIZE(types); i++) {
+			if (strcmp(ext, types[i].ext) == 0) {
+				return types[i].type;
+			}
+		}
+	}
+
+	return "application/octet-stream";
+}
+
+int http_server_send_file(struct http_server_conn *conn, const char *path)
+{
+	uint8_t *buf = conn->server->send_buf;
+	struct fs_dirent entry;
+	struct fs_file_t file;
+	ssize_t len;
+	int ret;
+
+	ret = fs_stat(path, &entry);
+	if (ret < 0 || entry.type != FS_DIR_ENTRY_FILE) {
+		return -ENOENT;
+	}
+
+	fs_file_t_init(&file);
+
+	ret = fs_open(&file, path, FS_O_READ);
+	if (ret < 0) {
+		return -ENOENT;
+	}
+
+	ret = send_headers(conn, 200, content_type_get(path), entry.size,
+			   false);
+	if (ret < 0 || conn->head) {
+		goto out;
+	}
+
+	/* Stream the file through the send buffer, never holding more than
+	 * one buffer of it in memory.
+	 */
+	while ((len = fs_read(&file, buf, sizeof(conn->server->send_buf))) > 0) {
+		ret = sendall(conn->sock, buf, len);
+		if (ret < 0) {
+			goto out;
+		}
+	}
+
+	if (len < 0) {
+		/* Headers are sent already, the client sees a short body */
+		ret = len;
+	}
+
+out:
+	fs_close(&file);
+
+	return ret;
+}
+
+static int serve_file(struct http_server_conn *conn,
+		      const struct http_server_resource *res,
+		      const char *name, size_t name_len)
+{
+	static const char index_file[] = "index.html";
+	char path[CONFIG_HTTP_SERVER_URL_MAX_LEN + MAX_FILE_NAME + 1];
+	int len;
+	int ret;
+
+	/* Do not let requests escape the root directory */
+	for (size_t i = 0; i + 1 < name_len; i++) {
+		if (name[i] == '.' && name[i + 1] == '.') {
+			return http_server_send_response(conn, 404, NULL,
+							 NULL, 0);
+		}
+	}
+
+	len = snprintk(path, sizeof(path), "%s/%.*s%s", res->fs_root,
+		       (int)name_len, name,
+		       (name_len == 0 || name[name_len - 1] == '/') ?
+		       index_file : "");
+	if (len >= sizeof(path)) {
+		return http_server_send_response(conn, 404, NULL, NULL, 0);
+	}
+
+	ret = http_server_send_file(conn, path);
+	if (ret == -ENOENT) {
+		return http_server_send_response(conn, 404, NULL, NULL, 0);
+	}
+
+	return ret;
+}
+#else
+int http_server_send_file(struct http_server_conn *conn, const char *path)
+{
+	ARG_UNUSED(conn);
+	ARG_UNUSED(path);
+
+	return -ENOTSUP;
+}
+#endif /* CONFIG_HTTP_SERVER_FS */
+
+static const struct http_server_resource *resource_find(
+	struct http_server *server, const char *url, size_t len)
+{
+	for (size_t i = 0; i < server->resource_count; i++) {
+		const struct http_server_resource *res = &server->resources[i];
+		size_t path_len = strlen(res->path);
+
+		if (path_len > len || strncmp(res->path, url, path_len) != 0) {
+			continue;
+		}
+
+		if (path_len == len || res->path[path_len - 1] == '/') {
+			return res;
+		}
+	}
+
+	return NULL;
+}
+
+static int conn_dispatch(struct http_server_conn *conn)
+{
+	const struct http_server_resource *res;
+	struct http_server_req req;
+	size_t path_len;
+	int ret;
+
+	if (conn->overflow) {
+		conn->keep_alive = false;
+
+		return http_server_send_response(conn,
+			conn->url_len > CONFIG_HTTP_SERVER_URL_MAX_LEN ?
+			414 : 413, NULL, NULL, 0);
+	}
+
+	conn->url[conn->url_len] = '\0';
+
+	/* The query is not part of the resource path */
+	path_len = strcspn(conn->url, "?#");
+
+	res = resource_find(conn->server, conn->url, path_len);
+	if (!res) {
+		return http_server_send_response(conn, 404, NULL, NULL, 0);
+	}
+
+	if (!res->handler) {
+#if defined(CONFIG_HTTP_SERVER_FS)
+		if (res->fs_root &&
+		    (conn->parser.method == HTTP_GET ||
+		     conn->parser.method == HTTP_HEAD)) {
+			size_t root_len = strlen(res->path);
+
+			return serve_file(conn, res, conn->url + root_len,
+					  path_len - root_len);
+		}
+#endif
+		return http_server_send_response(conn, 405, NULL, NULL, 0);
+	}
+
+	req.method = conn->parser.method;
+	req.url = conn->url;
+	req.body = conn->body_len ? conn->body : NULL;
+	req.body_len = conn->body_len;
+
+	ret = res->handler(conn, &req, res->user_data);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (!conn->responded) {
+		LOG_WRN("No response to %s", conn->url);
+		return http_server_send_response(conn, 500, NULL, NULL, 0);
+	}
+
+	return 0;
+}
+
+static int on_message_begin(struct http_parser *parser)
+{
+	struct http_server_conn *conn = parser->data;
+
+	conn->url_len = 0;
+	conn->body_len = 0;
+	conn->overflow = false;
+	conn->chunked = false;
+	conn->responded = false;
+	conn->head = false;
+
+	return 0;
+}
+
+static int on_url(struct http_parser *parser, const char *at, size_t length)
+{
+	struct http_server_conn *conn = parser->data;
+
+	if (conn->url_len + length > CONFIG_HTTP_SERVER_URL_MAX_LEN) {
+		conn->url_len = CONFIG_HTTP_SERVER_URL_MAX_LEN + 1;
+		conn->overflow = true;
+		return 0;
+	}
+
+	memcpy(conn->url + conn->url_len, at, length);
+	conn->url_len += length;
+
+	return 0;
+}
+
+static int on_headers_complete(struct http_parser *parser)
+{
+	struct http_server_conn *conn = parser->data;
+
+	conn->head = parser->method == HTTP_HEAD;
+
+	return 0;
+}
+
+static int on_body(struct http_parser *parser, const char *at, size_t length)
+{
+	struct http_server_conn *conn = parser->data;
+
+	if (conn->overflow) {
+		return 0;
+	}
+
+	if (conn->body_len + length > sizeof(conn->body)) {
+		conn->overflow = true;
+		return 0;
+	}
+
+	memcpy(conn->body + conn->body_len, at, length);
+	conn->body_len += length;
+
+	return 0;
+}
+
+static int on_message_complete(struct http_parser *parser)
+{
+	struct http_server_conn *conn = parser->data;
+
+	conn->keep_alive = http_should_keep_alive(parser);
+
+	/* Stop parsing there, the request is answered before the next
+	 * pipelined one is parsed.
+	 */
+	http_parser_pause(parser, 1);
+
+	return 0;
+}
+
+static const struct http_parser_settings parser_settings = {
+	.on_message_begin = on_message_begin,
+	.on_url = on_url,
+	.on_headers_complete = on_headers_complete,
+	.on_body = on_body,
+	.on_message_complete = on_message_complete,
+};
+
+/* Returns <0 if the connection has to be closed */
+static int conn_process(struct http_server_conn *conn, const char *data,
+			size_t len)
+{
+	size_t parsed;
+	int ret;
+
+	while (len > 0) {
+		parsed = http_parser_execute(&conn->parser, &parser_settings,
+					     data, len);
+
+		if (HTTP_PARSER_ERRNO(&conn->parser) == HPE_PAUSED) {
+			http_parser_pause(&conn->parser, 0);
+
+			ret = conn_dispatch(conn);
+			if (ret < 0) {
+				return ret;
+			}
+
+			if (!conn->keep_alive) {
+				return -ECONNRESET;
+			}
+
+			data += parsed;
+			len -= parsed;
+			continue;
+		}
+
+		if (HTTP_PARSER_ERRNO(&conn->parser) != HPE_OK ||
+		    conn->parser.upgrade) {
+			LOG_DBG("Parser error %s",
+				http_errno_name(HTTP_PARSER_ERRNO(&conn->parser)));
+			conn->keep_alive = false;
+			conn->responded = false;
+			(void)http_server_send_response(conn, 400, NULL, NULL, 0);
+			return -EINVAL;
+		}
+
+		break;
+	}
+
+	return 0;
+}
+
+static void conn_close(struct http_server_conn *conn)
+{
+	LOG_DBG("Closing connection %d", conn->sock);
+
+	(void)zsock_close(conn->sock);
+	conn->sock = -1;
+}
+
+static void conn_recv(struct http_server_conn *conn)
+{
+	struct http_server *server = conn->server;
+	ssize_t len;
+
+	len = zsock_recv(conn->sock, server->recv_buf, sizeof(server->recv_buf),
+			 ZSOCK_MSG_DONTWAIT);
+	if (len < 0 && errno == EAGAIN) {
+		return;
+	}
+
+	if (len <= 0 || conn_process(conn, server->recv_buf, len) < 0) {
+		conn_close(conn);
+		return;
+	}
+
+	conn->last_activity = k_uptime_get();
+}
+
+static void server_accept(struct http_server *server)
+{
+	struct http_server_conn *conn = NULL;
+	int sock;
+
+	sock = zsock_accept(server->sock, NULL, NULL);
+	if (sock < 0) {
+		LOG_ERR("Cannot accept (%d)", -errno);
+		return;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(server->conns); i++) {
+		if (server->conns[i].sock < 0) {
+			conn = &server->conns[i];
+			break;
+		}
+	}
+
+	if (!conn) {
+		static const char busy[] = "HTTP/1.1 503 Service Unavailable\r\n"
+					   "Content-Length: 0\r\n"
+					   "Connection: close\r\n\r\n";
+
+		LOG_DBG("No free connection");
+		(void)zsock_send(sock, busy, sizeof(busy) - 1,
+				 ZSOCK_MSG_DONTWAIT);
+		(void)zsock_close(sock);
+		return;
+	}
+
+	conn->sock = sock;
+	conn->last_activity = k_uptime_get();
+	http_parser_init(&conn->parser, HTTP_REQUEST);
+	conn->parser.data = conn;
+
+	LOG_DBG("New connection %d", sock);
+}
+
+int http_server_init(struct http_server *server, const struct sockaddr *addr,
+		     socklen_t addrlen,
+		     const struct http_server_resource *resources,
+		     size_t resource_count)
+{
+	int optval = 1;
+	int ret;
+
+	server->resources = resources;
+	server->resource_count = resource_count;
+	atomic_clear(&server->stop);
+
+	for (int i = 0; i < ARRAY_SIZE(server->conns); i++) {
+		server->conns[i].server = server;
+		server->conns[i].sock = -1;
+	}
+
+	server->sock = zsock_socket(addr->sa_family, SOCK_STREAM, IPPROTO_TCP);
+	if (server->sock < 0) {
+		return -errno;
+	}
+
+	(void)zsock_setsockopt(server->sock, SOL_SOCKET, SO_REUSEADDR,
+			       &optval, sizeof(optval));
+
+	if (zsock_bind(server->sock, addr, addrlen) < 0 ||
+	    zsock_listen(server->sock, CONFIG_HTTP_SERVER_MAX_CONNECTIONS) < 0) {
+		ret = -errno;
+		(void)zsock_close(server->sock);
+		server->sock = -1;
+		return ret;
+	}
+
+	return 0;
+}
+
+int http_server_run(struct http_server *server)
+{
+	struct zsock_pollfd fds[CONFIG_HTTP_SERVER_MAX_CONNECTIONS + 1];
+	struct http_server_conn *polled[CONFIG_HTTP_SERVER_MAX_CONNECTIONS + 1];
+	int ret = 0;
+	int64_t now;
+	int count;
+
+	while (!atomic_get(&server->stop)) {
+		fds[0].fd = server->sock;
+		fds[0].events = ZSOCK_POLLIN;
+		count = 1;
+
+		now = k_uptime_get();
+
+		for (int i = 0; i < ARRAY_SIZE(server->conns); i++) {
+			struct http_server_conn *conn = &server->conns[i];
+
+			if (conn->sock < 0) {
+				continue;
+			}
+
+			if (now - conn->last_activity >=
+			    CONFIG_HTTP_SERVER_IDLE_TIMEOUT) {
+				conn_close(conn);
+				continue;
+			}
+
+			fds[count].fd = conn->sock;
+			fds[count].events = ZSOCK_POLLIN;
+			polled[count] = conn;
+			count++;
+		}
+
+		ret = zsock_poll(fds, count, CONFIG_HTTP_SERVER_POLL_PERIOD);
+		if (ret < 0) {
+			ret = -errno;
+			LOG_ERR("Cannot poll (%d)", ret);
+			break;
+		}
+
+		ret = 0;
+
+		for (int i = 1; i < count; i++) {
+			if (fds[i].revents) {
+				conn_recv(polled[i]);
+			}
+		}
+
+		if (fds[0].revents & ZSOCK_POLLIN) {
+			server_accept(server);
+		}
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(server->conns); i++) {
+		if (server->conns[i].sock >= 0) {
+			conn_close(&server->conns[i]);
+		}
+	}
+
+	(void)zsock_close(server->sock);
+	server->sock = -1;
+
+	return ret;
+}
+
+void http_server_stop(struct http_server *server)
+{
+	atomic_set(&server->stop, 1);
+}
@@ -564,14 +564,32 @@ void lwm2m_socket_del(struct lwm2m_ctx *ctx)
 	}
 }
 
+static bool notification_due(const struct observe_node *obs, const int64_t timestamp)
+{
+	return obs->event_timestamp && timestamp >= obs->event_timestamp;
+}
+
 static void check_notifications(struct lwm2m_ctx *ctx, const int64_t timestamp)
 {
 	struct observe_node *obs;
+	bool coalesce = false;
 	int rc;
 
 	lwm2m_registry_lock();
+
+	/* Once a notification is due, the ones due soon are sent along */
+	if (CONFIG_LWM2M_ENGINE_NOTIFY_COALESCE_MS > 0) {
+		SYS_SLIST_FOR_EACH_CONTAINER(&ctx->observer, obs, node) {
+			if (notification_due(obs, timestamp) && !obs->active_tx_operation) {
+				coalesce = true;
+				break;
+			}
+		}
+	}
+
 	SYS_SLIST_FOR_EACH_CONTAINER(&ctx->observer, obs, node) {
-		if (!obs->event_timestamp || timestamp < obs->event_timestamp) {
+		if (!notification_due(obs, timestamp) &&
+		    !(coalesce && engine_observe_coalesce(obs, ctx->srv_obj_inst, timestamp))) {
 			continue;
 		}
 		/* Check That There is not pending process*/
@@ -587,7 +605,7 @@ static void check_notifications(struct lwm2m_ctx *ctx, const int64_t timestamp)
 		obs->event_timestamp =
 			engine_observe_shedule_next_event(obs, ctx->srv_obj_inst, timestamp);
 		obs->last_timestamp = timestamp;
-		if (!rc) {
+		if (!rc && !coalesce) {
 			/* create at most one notification */
 			goto cleanup;
 		}
@@ -371,6 +371,20 @@ int lwm2m_notify_observer_path(struct lwm2m_obj_path *path)
 					timestamp = k_uptime_get();
 				}
 
+				/* Wait for other changes to notify them together, up
+				 * to pmax.
+				 */
+				if (CONFIG_LWM2M_ENGINE_NOTIFY_COALESCE_MS > 0) {
+					timestamp = MAX(timestamp,
+							k_uptime_get() +
+							CONFIG_LWM2M_ENGINE_NOTIFY_COALESCE_MS);
+					if (nattrs.pmax) {
+						timestamp = MIN(timestamp,
+								obs->last_timestamp +
+								MSEC_PER_SEC * nattrs.pmax);
+					}
+				}
+
 				if (!obs->event_timestamp || obs->event_timestamp > timestamp) {
 					obs->resource_update = true;
 					obs->event_timestamp = timestamp;
@@ -1442,6 +1456,24 @@ int64_t engine_observe_shedule_next_event(struct observe_node *obs, uint16_t srv
 	return t_s;
 }
 
+bool engine_observe_coalesce(struct observe_node *obs, uint16_t srv_obj_inst,
+			     const int64_t timestamp)
+{
+	struct notification_attrs attrs;
+
+	if (!obs->event_timestamp ||
+	    obs->event_timestamp > timestamp + CONFIG_LWM2M_ENGINE_NOTIFY_COALESCE_MS) {
+		return false;
+	}
+
+	if (engine_observe_attribute_list_get(&obs->path_list, &attrs, srv_obj_inst) < 0) {
+		return false;
+	}
+
+	/* Only notify earlier than due if pmin allows it */
+	return obs->last_timestamp + MSEC_PER_SEC * attrs.pmin <= timestamp;
+}
+
 struct lwm2m_obj_path_list *lwm2m_engine_get_from_list(sys_slist_t *path_list)
 {
 	sys_snode_t *path_node = sys_slist_get(path_list);
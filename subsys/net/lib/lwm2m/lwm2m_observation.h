@@ -35,6 +35,10 @@ void clear_attrs(void *ref);
 int64_t engine_observe_shedule_next_event(struct observe_node *obs, uint16_t srv_obj_inst,
 					  const int64_t timestamp);
 
+/* Whether a notification due within CONFIG_LWM2M_ENGINE_NOTIFY_COALESCE_MS can be sent now */
+bool engine_observe_coalesce(struct observe_node *obs, uint16_t srv_obj_inst,
+			     const int64_t timestamp);
+
 void remove_observer_from_list(struct lwm2m_ctx *ctx, sys_snode_t *prev_node,
 			       struct observe_node *obs);
 
@@ -25,6 +25,7 @@ static void client_reset(struct mqtt_client *client)
 	client->internal.last_activity = 0U;
 	client->internal.rx_buf_datalen = 0U;
 	client->internal.remaining_payload = 0U;
+	client->internal.inflight = 0U;
 }
 
 /** @brief Initialize tx buffer. */
@@ -236,6 +237,20 @@ static int verify_tx_state(const struct mqtt_client *client)
 	return 0;
 }
 
+/* Retransmissions keep the slot taken by the original message. */
+static bool publish_counted(const struct mqtt_publish_param *param)
+{
+	return CONFIG_MQTT_MAX_INFLIGHT > 0 && param->message.topic.qos &&
+	       !param->dup_flag;
+}
+
+static bool publish_window_full(struct mqtt_client *client,
+				const struct mqtt_publish_param *param)
+{
+	return publish_counted(param) &&
+	       client->internal.inflight >= CONFIG_MQTT_MAX_INFLIGHT;
+}
+
 int mqtt_publish(struct mqtt_client *client,
 		 const struct mqtt_publish_param *param)
 {
@@ -261,6 +276,11 @@ int mqtt_publish(struct mqtt_client *client,
 		goto error;
 	}
 
+	if (publish_window_full(client, param)) {
+		err_code = -EAGAIN;
+		goto error;
+	}
+
 	err_code = publish_encode(param, &packet);
 	if (err_code < 0) {
 		goto error;
@@ -277,6 +297,9 @@ int mqtt_publish(struct mqtt_client *client,
 	msg.msg_iovlen = ARRAY_SIZE(io_vector);
 
 	err_code = client_write_msg(client, &msg);
+	if (err_code == 0 && publish_counted(param)) {
+		client->internal.inflight++;
+	}
 
 error:
 	NET_DBG("[CID %p]:[State 0x%02x]: << result 0x%08x",
@@ -287,6 +310,101 @@ error:
 	return err_code;
 }
 
+int mqtt_publish_batch(struct mqtt_client *client,
+		       const struct mqtt_publish_param *params, size_t count)
+{
+	int err_code;
+	struct buf_ctx packet;
+	struct iovec io_vector[2 * CONFIG_MQTT_PUBLISH_BATCH_MAX];
+	struct msghdr msg;
+	uint16_t inflight;
+	size_t published = 0;
+	size_t batched;
+
+	NULL_PARAM_CHECK(client);
+	NULL_PARAM_CHECK(params);
+
+	NET_DBG("[CID %p]:[State 0x%02x]: >> Message count %zu",
+		 client, client->internal.state, count);
+
+	mqtt_mutex_lock(client);
+
+	err_code = verify_tx_state(client);
+	if (err_code < 0) {
+		goto error;
+	}
+
+	while (published < count) {
+		tx_buf_init(client, &packet);
+		inflight = client->internal.inflight;
+		batched = 0;
+
+		while (published + batched < count &&
+		       batched < CONFIG_MQTT_PUBLISH_BATCH_MAX) {
+			const struct mqtt_publish_param *param =
+						&params[published + batched];
+
+			if (publish_counted(param) &&
+			    inflight >= CONFIG_MQTT_MAX_INFLIGHT) {
+				err_code = -EAGAIN;
+				break;
+			}
+
+			/* Each header is encoded right after the previous one,
+			 * payloads are only referenced.
+			 */
+			packet.end = client->tx_buf + client->tx_buf_size;
+
+			err_code = publish_encode(param, &packet);
+			if (err_code < 0) {
+				break;
+			}
+
+			io_vector[2 * batched].iov_base = packet.cur;
+			io_vector[2 * batched].iov_len = packet.end - packet.cur;
+			io_vector[2 * batched + 1].iov_base =
+						param->message.payload.data;
+			io_vector[2 * batched + 1].iov_len =
+						param->message.payload.len;
+
+			packet.cur = packet.end;
+
+			if (publish_counted(param)) {
+				inflight++;
+			}
+
+			batched++;
+		}
+
+		/* A full transmit buffer only ends the current write. */
+		if (batched == 0 ||
+		    (err_code < 0 && err_code != -ENOMEM && err_code != -EAGAIN)) {
+			break;
+		}
+
+		memset(&msg, 0, sizeof(msg));
+
+		msg.msg_iov = io_vector;
+		msg.msg_iovlen = 2 * batched;
+
+		err_code = client_write_msg(client, &msg);
+		if (err_code < 0) {
+			break;
+		}
+
+		client->internal.inflight = inflight;
+		published += batched;
+	}
+
+error:
+	NET_DBG("[CID %p]:[State 0x%02x]: << result 0x%08x, published %zu",
+			 client, client->internal.state, err_code, published);
+
+	mqtt_mutex_unlock(client);
+
+	return published > 0 ? (int)published : err_code;
+}
+
 int mqtt_publish_qos1_ack(struct mqtt_client *client,
 			  const struct mqtt_puback_param *param)
 {
@@ -154,6 +154,19 @@ enum mqtt_state {
  */
 void event_notify(struct mqtt_client *client, const struct mqtt_evt *evt);
 
+/**@brief Releases the in-flight window slot of an acknowledged QoS 1 or QoS 2
+ *        PUBLISH message.
+ *
+ * @param[in] client Identifies the client for which the message was
+ *                   acknowledged.
+ */
+static inline void mqtt_inflight_release(struct mqtt_client *client)
+{
+	if (client->internal.inflight > 0U) {
+		client->internal.inflight--;
+	}
+}
+
 /**@brief Handles MQTT messages received from the peer.
  *
  * @param[in] client Identifies the client for which the data was received.
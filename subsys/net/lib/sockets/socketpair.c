@@ -1062,11 +1062,29 @@ static ssize_t spair_sendmsg(void *obj, const struct msghdr *msg,
 		goto out;
 	}
 
+	/* Writes may be partial when blocking, as the remote recv_q is
+	 * emptied by the reader, so each vector is written until it is
+	 * done. What was written is reported if a later write fails.
+	 */
+	len = 0;
+
 	for (size_t i = 0; i < msg->msg_iovlen; ++i) {
-		res = spair_write(spair, msg->msg_iov[i].iov_base,
-			msg->msg_iov[i].iov_len);
-		if (res == -1) {
-			goto out;
+		const uint8_t *base = msg->msg_iov[i].iov_base;
+		size_t left = msg->msg_iov[i].iov_len;
+
+		while (left > 0) {
+			res = spair_write(spair, base, left);
+			if (res == -1) {
+				if (len > 0) {
+					res = len;
+				}
+
+				goto out;
+			}
+
+			base += res;
+			left -= res;
+			len += res;
 		}
 	}
 
@@ -17,6 +17,7 @@ LOG_MODULE_REGISTER(net_sock, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <zephyr/net/net_pkt.h>
 #include <zephyr/net/socket.h>
 #include <zephyr/net/socket_types.h>
+#include <zephyr/net/bpf.h>
 #include <zephyr/syscall_handler.h>
 #include <zephyr/sys/fdtable.h>
 #include <zephyr/sys/math_extras.h>
@@ -145,6 +146,7 @@ static void zsock_flush_queue(struct net_context *ctx)
 			net_context_put(p);
 		} else {
 			NET_DBG("discarding pkt %p", p);
+			sock_rcvbuf_give(ctx, p);
 			net_pkt_unref(p);
 		}
 	}
@@ -408,6 +410,13 @@ static void zsock_received_cb(struct net_context *ctx,
 
 	net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
 
+	if (!sock_rcvbuf_take(ctx, pkt)) {
+		NET_DBG("Receive buffer of ctx %p full, dropping pkt %p",
+			ctx, pkt);
+		net_pkt_unref(pkt);
+		goto unlock;
+	}
+
 	k_fifo_put(&ctx->recv_q, pkt);
 
 unlock:
@@ -954,6 +963,91 @@ fail:
 #include <syscalls/zsock_sendmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+static bool sock_is_native(int sock, struct net_context **ctx,
+			   struct k_mutex **lock)
+{
+	const struct socket_op_vtable *vtable;
+
+	*ctx = get_sock_vtable(sock, &vtable, lock);
+
+	return *ctx != NULL && vtable == &sock_fd_op_vtable;
+}
+
+static int zsock_sendmmsg_ctx(struct net_context *ctx,
+			      struct zsock_mmsghdr *msgvec,
+			      unsigned int vlen, int flags)
+{
+	unsigned int i;
+	ssize_t ret;
+
+	for (i = 0; i < vlen; i++) {
+		ret = zsock_sendmsg_ctx(ctx, &msgvec[i].msg_hdr, flags);
+		if (ret < 0) {
+			/* Report the messages sent so far, if any */
+			return (i > 0) ? i : -1;
+		}
+
+		msgvec[i].msg_len = ret;
+	}
+
+	return i;
+}
+
+int z_impl_zsock_sendmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			  unsigned int vlen, int flags)
+{
+	struct net_context *ctx;
+	struct k_mutex *lock;
+	unsigned int i;
+	ssize_t ret;
+
+	/* Native sockets send the whole vector with the lock held once */
+	if (sock_is_native(sock, &ctx, &lock)) {
+		(void)k_mutex_lock(lock, K_FOREVER);
+		ret = zsock_sendmmsg_ctx(ctx, msgvec, vlen, flags);
+		k_mutex_unlock(lock);
+
+		return ret;
+	}
+
+	for (i = 0; i < vlen; i++) {
+		ret = z_impl_zsock_sendmsg(sock, &msgvec[i].msg_hdr, flags);
+		if (ret < 0) {
+			return (i > 0) ? i : -1;
+		}
+
+		msgvec[i].msg_len = ret;
+	}
+
+	return i;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_sendmmsg(int sock,
+					struct zsock_mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	unsigned int i;
+	ssize_t ret;
+
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_WRITE(msgvec, vlen,
+					    sizeof(*msgvec)));
+
+	/* Each message is copied from user memory in turn */
+	for (i = 0; i < vlen; i++) {
+		ret = z_vrfy_zsock_sendmsg(sock, &msgvec[i].msg_hdr, flags);
+		if (ret < 0) {
+			return (i > 0) ? i : -1;
+		}
+
+		msgvec[i].msg_len = ret;
+	}
+
+	return i;
+}
+#include <syscalls/zsock_sendmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
 static int sock_get_pkt_src_addr(struct net_pkt *pkt,
 				 enum net_ip_protocol proto,
 				 struct sockaddr *addr,
@@ -1108,16 +1202,18 @@ int zsock_wait_data(struct net_context *ctx, k_timeout_t *timeout)
 	return 0;
 }
 
-static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
-				       void *buf,
-				       size_t max_len,
-				       int flags,
-				       struct sockaddr *src_addr,
-				       socklen_t *addrlen)
+static ssize_t zsock_recv_dgram_iov(struct net_context *ctx,
+				    const struct iovec *iov,
+				    size_t iovlen,
+				    int flags,
+				    struct sockaddr *src_addr,
+				    socklen_t *addrlen,
+				    size_t *full_len)
 {
 	k_timeout_t timeout = K_FOREVER;
 	size_t recv_len = 0;
-	size_t read_len;
+	size_t read_len = 0;
+	size_t len;
 	struct net_pkt_cursor backup;
 	struct net_pkt *pkt;
 
@@ -1148,6 +1244,9 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 		pkt = k_fifo_peek_head(&ctx->recv_q);
 	} else {
 		pkt = k_fifo_get(&ctx->recv_q, timeout);
+		if (pkt) {
+			sock_rcvbuf_give(ctx, pkt);
+		}
 	}
 
 	if (!pkt) {
@@ -1199,11 +1298,16 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 	}
 
 	recv_len = net_pkt_remaining_data(pkt);
-	read_len = MIN(recv_len, max_len);
 
-	if (net_pkt_read(pkt, buf, read_len)) {
-		errno = ENOBUFS;
-		goto fail;
+	for (size_t i = 0; i < iovlen && read_len < recv_len; i++) {
+		len = MIN(recv_len - read_len, iov[i].iov_len);
+
+		if (net_pkt_read(pkt, iov[i].iov_base, len)) {
+			errno = ENOBUFS;
+			goto fail;
+		}
+
+		read_len += len;
 	}
 
 	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS) &&
@@ -1217,6 +1321,10 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 		net_pkt_cursor_restore(pkt, &backup);
 	}
 
+	if (full_len) {
+		*full_len = recv_len;
+	}
+
 	return (flags & ZSOCK_MSG_TRUNC) ? recv_len : read_len;
 
 fail:
@@ -1227,6 +1335,22 @@ fail:
 	return -1;
 }
 
+static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
+				       void *buf,
+				       size_t max_len,
+				       int flags,
+				       struct sockaddr *src_addr,
+				       socklen_t *addrlen)
+{
+	struct iovec iov = {
+		.iov_base = buf,
+		.iov_len = max_len,
+	};
+
+	return zsock_recv_dgram_iov(ctx, &iov, 1, flags, src_addr, addrlen,
+				    NULL);
+}
+
 static inline ssize_t zsock_recv_stream(struct net_context *ctx,
 					void *buf,
 					size_t max_len,
@@ -1416,6 +1540,265 @@ ssize_t z_vrfy_zsock_recvfrom(int sock, void *buf, size_t max_len, int flags,
 #include <syscalls/zsock_recvfrom_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+static int zsock_recvmmsg_ctx(struct net_context *ctx,
+			      struct zsock_mmsghdr *msgvec,
+			      unsigned int vlen, int flags)
+{
+	struct msghdr *msg;
+	size_t full_len;
+	unsigned int i;
+	ssize_t ret;
+
+	if (net_context_get_type(ctx) != SOCK_DGRAM) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	for (i = 0; i < vlen; i++) {
+		msg = &msgvec[i].msg_hdr;
+
+		ret = zsock_recv_dgram_iov(ctx, msg->msg_iov, msg->msg_iovlen,
+					   flags, msg->msg_name,
+					   msg->msg_name ? &msg->msg_namelen :
+							   NULL,
+					   &full_len);
+		if (ret < 0) {
+			/* Report the messages received so far, if any */
+			return (i > 0) ? i : -1;
+		}
+
+		msgvec[i].msg_len = ret;
+		msg->msg_flags = ((size_t)ret < full_len) ? ZSOCK_MSG_TRUNC : 0;
+
+		/* Peeking more would return the same datagram again */
+		if (flags & ZSOCK_MSG_PEEK) {
+			return 1;
+		}
+
+		/* Only wait for the first message */
+		flags |= ZSOCK_MSG_DONTWAIT;
+	}
+
+	return i;
+}
+
+int z_impl_zsock_recvmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			  unsigned int vlen, int flags)
+{
+	struct net_context *ctx;
+	struct k_mutex *lock;
+	int ret;
+
+	if (!sock_is_native(sock, &ctx, &lock)) {
+		errno = (ctx == NULL) ? EBADF : EOPNOTSUPP;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+	ret = zsock_recvmmsg_ctx(ctx, msgvec, vlen, flags);
+	k_mutex_unlock(lock);
+
+	return ret;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_recvmmsg(int sock,
+					struct zsock_mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	struct zsock_mmsghdr *msgvec_copy;
+	struct msghdr *msg;
+	unsigned int i;
+	int ret = -1;
+
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_WRITE(msgvec, vlen,
+					    sizeof(*msgvec)));
+
+	msgvec_copy = z_user_alloc_from_copy(msgvec, vlen * sizeof(*msgvec));
+	if (!msgvec_copy) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	for (i = 0; i < vlen; i++) {
+		msg = &msgvec_copy[i].msg_hdr;
+		msg->msg_iov = z_user_alloc_from_copy(msg->msg_iov,
+					msg->msg_iovlen * sizeof(struct iovec));
+		if (!msg->msg_iov) {
+			errno = ENOMEM;
+			vlen = i;
+			goto out;
+		}
+	}
+
+	/* The data is written straight to the user buffers */
+	for (i = 0; i < vlen; i++) {
+		msg = &msgvec_copy[i].msg_hdr;
+
+		for (size_t j = 0; j < msg->msg_iovlen; j++) {
+			Z_OOPS(Z_SYSCALL_MEMORY_WRITE(msg->msg_iov[j].iov_base,
+						      msg->msg_iov[j].iov_len));
+		}
+
+		Z_OOPS(msg->msg_name &&
+		       Z_SYSCALL_MEMORY_WRITE(msg->msg_name,
+					      msg->msg_namelen));
+
+		/* Ancillary data is not supported */
+		msg->msg_control = NULL;
+		msg->msg_controllen = 0;
+	}
+
+	ret = z_impl_zsock_recvmmsg(sock, msgvec_copy, vlen, flags);
+
+	for (i = 0; ret > 0 && i < ret; i++) {
+		msgvec[i].msg_len = msgvec_copy[i].msg_len;
+		msgvec[i].msg_hdr.msg_namelen = msgvec_copy[i].msg_hdr.msg_namelen;
+		msgvec[i].msg_hdr.msg_flags = msgvec_copy[i].msg_hdr.msg_flags;
+	}
+
+out:
+	for (i = 0; i < vlen; i++) {
+		k_free(msgvec_copy[i].msg_hdr.msg_iov);
+	}
+
+	k_free(msgvec_copy);
+
+	return ret;
+}
+#include <syscalls/zsock_recvmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+#if defined(CONFIG_NET_SOCKETS_RECV_ZC)
+static ssize_t zsock_recv_zc_ctx(struct net_context *ctx,
+				 struct zsock_zc_buf *zc, int flags)
+{
+	enum net_sock_type sock_type = net_context_get_type(ctx);
+	k_timeout_t timeout = K_FOREVER;
+	struct net_pkt *pkt;
+	struct net_buf *buf;
+	size_t offset;
+	int res;
+
+	if (sock_type == SOCK_STREAM) {
+		if (net_context_get_state(ctx) != NET_CONTEXT_CONNECTED) {
+			errno = ENOTCONN;
+			return -1;
+		}
+	} else if (sock_type != SOCK_DGRAM) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	} else if (!sock_is_eof(ctx) && !sock_is_error(ctx)) {
+		net_context_get_option(ctx, NET_OPT_RCVTIMEO, &timeout, NULL);
+	}
+
+	if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		res = zsock_wait_data(ctx, &timeout);
+		if (res < 0) {
+			errno = -res;
+			return -1;
+		}
+	}
+
+	pkt = k_fifo_get(&ctx->recv_q, K_NO_WAIT);
+	if (!pkt) {
+		if (sock_type == SOCK_STREAM && sock_is_error(ctx)) {
+			errno = POINTER_TO_INT(ctx->user_data);
+			return -1;
+		} else if (sock_type == SOCK_STREAM && sock_is_eof(ctx)) {
+			return 0;
+		}
+
+		errno = EAGAIN;
+		return -1;
+	}
+
+	sock_rcvbuf_give(ctx, pkt);
+
+	if (sock_type == SOCK_STREAM && net_pkt_eof(pkt)) {
+		sock_set_eof(ctx);
+	}
+
+	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS)) {
+		net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
+	}
+
+	zc->len = net_pkt_remaining_data(pkt);
+	if (zc->len == 0U) {
+		/* End of stream marker */
+		net_pkt_unref(pkt);
+		return 0;
+	}
+
+	/* The cursor is left at the end of a fragment by partial reads */
+	buf = pkt->cursor.buf;
+	offset = pkt->cursor.pos - buf->data;
+	while (offset >= buf->len) {
+		buf = buf->frags;
+		offset = 0;
+	}
+
+	zc->buf = buf;
+	zc->offset = offset;
+	zc->pkt = pkt;
+	zc->ctx = ctx;
+
+	return zc->len;
+}
+
+ssize_t zsock_recv_zc(int sock, struct zsock_zc_buf *zc, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct net_context *ctx;
+	struct k_mutex *lock;
+	ssize_t ret;
+
+	ctx = get_sock_vtable(sock, &vtable, &lock);
+	if (ctx == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable != &sock_fd_op_vtable) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+	ret = zsock_recv_zc_ctx(ctx, zc, flags);
+	k_mutex_unlock(lock);
+
+	return ret;
+}
+
+void zsock_recv_zc_release(int sock, struct zsock_zc_buf *zc)
+{
+	const struct socket_op_vtable *vtable;
+	struct net_context *ctx;
+	struct k_mutex *lock;
+
+	/* The socket might have been closed in the meantime */
+	ctx = z_get_fd_obj_and_vtable(sock,
+				      (const struct fd_op_vtable **)&vtable,
+				      &lock);
+	if (ctx == zc->ctx && vtable == &sock_fd_op_vtable &&
+	    net_context_get_type(ctx) == SOCK_STREAM) {
+		(void)k_mutex_lock(lock, K_FOREVER);
+		net_context_update_recv_wnd(ctx, zc->len);
+		k_mutex_unlock(lock);
+	}
+
+	net_pkt_unref(zc->pkt);
+	zc->pkt = NULL;
+	zc->buf = NULL;
+	zc->len = 0U;
+}
+#endif /* CONFIG_NET_SOCKETS_RECV_ZC */
+
 /* As this is limited function, we don't follow POSIX signature, with
  * "..." instead of last arg.
  */
@@ -2164,6 +2547,36 @@ int z_vrfy_zsock_setsockopt(int sock, int level, int optname,
 	kernel_optval = z_user_alloc_from_copy((const void *)optval, optlen);
 	Z_OOPS(!kernel_optval);
 
+#if defined(CONFIG_NET_SOCKETS_PACKET_FILTER)
+	/* The filter program is referenced by the option, copy it as well */
+	if (level == SOL_SOCKET && optname == SO_ATTACH_FILTER &&
+	    optlen == sizeof(struct sock_fprog)) {
+		struct sock_fprog *fprog = kernel_optval;
+		struct sock_filter *filter = NULL;
+
+		if (fprog->filter != NULL && fprog->len > 0U &&
+		    fprog->len <= CONFIG_NET_SOCKETS_PACKET_FILTER_MAX_INSNS) {
+			filter = z_user_alloc_from_copy(fprog->filter,
+							fprog->len * sizeof(*filter));
+			if (filter == NULL) {
+				k_free(kernel_optval);
+				Z_OOPS(1);
+			}
+		}
+
+		/* Invalid programs are rejected by the implementation */
+		fprog->filter = filter;
+
+		ret = z_impl_zsock_setsockopt(sock, level, optname,
+					      kernel_optval, optlen);
+
+		k_free(filter);
+		k_free(kernel_optval);
+
+		return ret;
+	}
+#endif
+
 	ret = z_impl_zsock_setsockopt(sock, level, optname,
 				      kernel_optval, optlen);
 
@@ -8,6 +8,8 @@
 #define _SOCKETS_INTERNAL_H_
 
 #include <zephyr/sys/fdtable.h>
+#include <zephyr/net/net_context.h>
+#include <zephyr/net/net_pkt.h>
 
 #define SOCK_EOF 1
 #define SOCK_NONBLOCK 2
@@ -34,6 +36,58 @@ static inline uintptr_t sock_get_flag(struct net_context *ctx, uintptr_t mask)
 
 void net_socket_update_tc_rx_time(struct net_pkt *pkt, uint32_t end_tick);
 
+#if defined(CONFIG_NET_CONTEXT_RCVBUF)
+/* Account a packet queued to recv_q against the receive buffer size of the
+ * socket, false if it does not fit. At least one packet is always accepted
+ * so that datagrams larger than the buffer are not dropped forever. Stream
+ * sockets are bounded by the TCP receive window instead.
+ */
+static inline bool sock_rcvbuf_take(struct net_context *ctx,
+				    struct net_pkt *pkt)
+{
+	size_t len = net_pkt_get_len(pkt);
+	atomic_val_t used;
+
+	if (net_context_get_type(ctx) == SOCK_STREAM) {
+		return true;
+	}
+
+	used = atomic_get(&ctx->recv_q_len);
+	if (ctx->options.rcvbuf && used && used + len > ctx->options.rcvbuf) {
+		return false;
+	}
+
+	atomic_add(&ctx->recv_q_len, len);
+
+	return true;
+}
+
+/* Release the share of the receive buffer of a packet taken off recv_q */
+static inline void sock_rcvbuf_give(struct net_context *ctx,
+				    struct net_pkt *pkt)
+{
+	if (net_context_get_type(ctx) != SOCK_STREAM) {
+		atomic_sub(&ctx->recv_q_len, net_pkt_get_len(pkt));
+	}
+}
+#else
+static inline bool sock_rcvbuf_take(struct net_context *ctx,
+				    struct net_pkt *pkt)
+{
+	ARG_UNUSED(ctx);
+	ARG_UNUSED(pkt);
+
+	return true;
+}
+
+static inline void sock_rcvbuf_give(struct net_context *ctx,
+				    struct net_pkt *pkt)
+{
+	ARG_UNUSED(ctx);
+	ARG_UNUSED(pkt);
+}
+#endif /* CONFIG_NET_CONTEXT_RCVBUF */
+
 #if defined(CONFIG_NET_SOCKETS_SOCKOPT_TLS)
 bool net_socket_is_tls(void *obj);
 #else
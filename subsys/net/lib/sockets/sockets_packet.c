@@ -21,6 +21,10 @@ LOG_MODULE_REGISTER(net_sock_packet, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <zephyr/syscall_handler.h>
 #include <zephyr/sys/fdtable.h>
 
+#if defined(CONFIG_NET_SOCKETS_PACKET_FILTER)
+#include <zephyr/net/net_pkt_filter.h>
+#endif
+
 #include "../../ip/net_stats.h"
 
 #include "sockets_internal.h"
@@ -40,6 +44,108 @@ static inline int k_fifo_wait_non_empty(struct k_fifo *fifo,
 	return k_poll(events, ARRAY_SIZE(events), timeout);
 }
 
+#if defined(CONFIG_NET_SOCKETS_PACKET_FILTER)
+struct packet_filter {
+	struct net_context *ctx;
+	uint16_t len;
+	struct sock_filter prog[CONFIG_NET_SOCKETS_PACKET_FILTER_MAX_INSNS];
+};
+
+static struct packet_filter filters[CONFIG_NET_SOCKETS_PACKET_FILTER_COUNT];
+static K_MUTEX_DEFINE(filters_lock);
+
+static struct packet_filter *filter_find(struct net_context *ctx)
+{
+	for (int i = 0; i < ARRAY_SIZE(filters); i++) {
+		if (filters[i].ctx == ctx) {
+			return &filters[i];
+		}
+	}
+
+	return NULL;
+}
+
+static void filter_detach(struct net_context *ctx)
+{
+	struct packet_filter *filter;
+
+	k_mutex_lock(&filters_lock, K_FOREVER);
+
+	filter = filter_find(ctx);
+	if (filter) {
+		filter->ctx = NULL;
+	}
+
+	k_mutex_unlock(&filters_lock);
+}
+
+/* The program is copied, then checked, so that the caller cannot change
+ * it once validated. If the check fails, the previous filter is detached.
+ */
+static int filter_attach(struct net_context *ctx, const void *optval,
+			 socklen_t optlen)
+{
+	const struct sock_fprog *fprog = optval;
+	struct packet_filter *filter;
+	int ret = 0;
+
+	if (!fprog || optlen != sizeof(*fprog) || !fprog->filter ||
+	    fprog->len == 0U ||
+	    fprog->len > CONFIG_NET_SOCKETS_PACKET_FILTER_MAX_INSNS) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&filters_lock, K_FOREVER);
+
+	filter = filter_find(ctx);
+	if (!filter) {
+		filter = filter_find(NULL);
+		if (!filter) {
+			ret = -ENOMEM;
+			goto out;
+		}
+	}
+
+	filter->len = fprog->len;
+	memcpy(filter->prog, fprog->filter,
+	       fprog->len * sizeof(struct sock_filter));
+
+	ret = npf_bpf_check(filter->prog, filter->len);
+	filter->ctx = ret < 0 ? NULL : ctx;
+
+out:
+	k_mutex_unlock(&filters_lock);
+
+	return ret;
+}
+
+/* Run the filter of the socket, if any. Returns false if the packet is to be
+ * dropped.
+ */
+static bool filter_accept(struct net_context *ctx, struct net_pkt *pkt)
+{
+	struct packet_filter *filter;
+	bool accept = true;
+	uint32_t len;
+
+	k_mutex_lock(&filters_lock, K_FOREVER);
+
+	filter = filter_find(ctx);
+	if (filter) {
+		len = npf_bpf_run(filter->prog, pkt);
+		if (len == 0U) {
+			accept = false;
+		} else if (len < net_pkt_get_len(pkt)) {
+			net_pkt_update_length(pkt, len);
+		}
+	}
+
+	k_mutex_unlock(&filters_lock);
+
+	return accept;
+}
+#endif /* CONFIG_NET_SOCKETS_PACKET_FILTER */
+
 static int zpacket_socket(int family, int type, int proto)
 {
 	struct net_context *ctx;
@@ -105,9 +211,24 @@ static void zpacket_received_cb(struct net_context *ctx,
 		return;
 	}
 
+#if defined(CONFIG_NET_SOCKETS_PACKET_FILTER)
+	if (!filter_accept(ctx, pkt)) {
+		NET_DBG("pkt %p rejected by the socket filter", pkt);
+		net_pkt_unref(pkt);
+		return;
+	}
+#endif
+
 	/* Normal packet */
 	net_pkt_set_eof(pkt, false);
 
+	if (!sock_rcvbuf_take(ctx, pkt)) {
+		NET_DBG("Receive buffer of ctx %p full, dropping pkt %p",
+			ctx, pkt);
+		net_pkt_unref(pkt);
+		return;
+	}
+
 	k_fifo_put(&ctx->recv_q, pkt);
 }
 
@@ -309,6 +430,9 @@ ssize_t zpacket_recvfrom_ctx(struct net_context *ctx, void *buf, size_t max_len,
 		pkt = k_fifo_peek_head(&ctx->recv_q);
 	} else {
 		pkt = k_fifo_get(&ctx->recv_q, timeout);
+		if (pkt) {
+			sock_rcvbuf_give(ctx, pkt);
+		}
 	}
 
 	if (!pkt) {
@@ -362,6 +486,27 @@ int zpacket_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 int zpacket_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 			const void *optval, socklen_t optlen)
 {
+#if defined(CONFIG_NET_SOCKETS_PACKET_FILTER)
+	if (level == SOL_SOCKET) {
+		int ret;
+
+		switch (optname) {
+		case SO_ATTACH_FILTER:
+			ret = filter_attach(ctx, optval, optlen);
+			if (ret < 0) {
+				errno = -ret;
+				return -1;
+			}
+
+			return 0;
+
+		case SO_DETACH_FILTER:
+			filter_detach(ctx);
+			return 0;
+		}
+	}
+#endif
+
 	return sock_fd_op_vtable.setsockopt(ctx, level, optname,
 					    optval, optlen);
 }
@@ -451,6 +596,10 @@ static int packet_sock_setsockopt_vmeth(void *obj, int level, int optname,
 
 static int packet_sock_close_vmeth(void *obj)
 {
+#if defined(CONFIG_NET_SOCKETS_PACKET_FILTER)
+	filter_detach(obj);
+#endif
+
 	return zsock_close_ctx(obj);
 }
 
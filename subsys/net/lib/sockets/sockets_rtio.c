@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_sock_rtio, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <errno.h>
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/socket_rtio.h>
+
+/* The thread polls the wakeup socket and the pending sockets */
+#define POLL_MAX CONFIG_NET_SOCKETS_POLL_MAX
+
+static K_MUTEX_DEFINE(lock);
+static sys_slist_t pending = SYS_SLIST_STATIC_INIT(&pending);
+
+/* Written to when an operation becomes pending, read by the thread */
+static int wakeup[2] = { -1, -1 };
+
+static void rtio_thread(void);
+
+K_THREAD_DEFINE(zsock_rtio, CONFIG_NET_SOCKETS_RTIO_STACK_SIZE,
+		(k_thread_entry_t)rtio_thread, NULL, NULL, NULL,
+		CONFIG_NET_SOCKETS_RTIO_PRIORITY, 0, SYS_FOREVER_MS);
+
+static int sock_rtio_do(struct zsock_rtio_iodev *iodev,
+			const struct rtio_sqe *sqe)
+{
+	ssize_t ret;
+
+	switch (sqe->op) {
+	case RTIO_OP_NOP:
+		return 0;
+	case RTIO_OP_RX:
+		ret = zsock_recv(iodev->sock, sqe->buf, sqe->buf_len,
+				 ZSOCK_MSG_DONTWAIT);
+		break;
+	case RTIO_OP_TX:
+		ret = zsock_send(iodev->sock, sqe->buf, sqe->buf_len,
+				 ZSOCK_MSG_DONTWAIT);
+		break;
+	default:
+		return -ENOTSUP;
+	}
+
+	if (ret < 0) {
+		return errno == EWOULDBLOCK ? -EAGAIN : -errno;
+	}
+
+	return ret;
+}
+
+static void sock_rtio_complete(struct rtio *r, const struct rtio_sqe *sqe,
+			       int result)
+{
+	if (result < 0) {
+		rtio_sqe_err(r, sqe, result);
+	} else {
+		rtio_sqe_ok(r, sqe, result);
+	}
+}
+
+static void sock_rtio_submit(const struct rtio_sqe *sqe, struct rtio *r)
+{
+	struct zsock_rtio_iodev *iodev = (struct zsock_rtio_iodev *)sqe->iodev;
+	int ret;
+
+	if (iodev->sqe) {
+		rtio_sqe_err(r, sqe, -EWOULDBLOCK);
+		return;
+	}
+
+	ret = sock_rtio_do(iodev, sqe);
+	if (ret != -EAGAIN) {
+		sock_rtio_complete(r, sqe, ret);
+		return;
+	}
+
+	NET_DBG("sock %d op %u pending", iodev->sock, sqe->op);
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	iodev->sqe = sqe;
+	iodev->r = r;
+	sys_slist_append(&pending, &iodev->node);
+
+	k_mutex_unlock(&lock);
+
+	(void)zsock_send(wakeup[1], "", 1, ZSOCK_MSG_DONTWAIT);
+}
+
+static const struct rtio_iodev_api sock_rtio_api = {
+	.submit = sock_rtio_submit,
+};
+
+static void rtio_thread(void)
+{
+	struct zsock_pollfd fds[POLL_MAX];
+	struct zsock_rtio_iodev *polled[POLL_MAX];
+	struct zsock_rtio_iodev *iodev;
+	char buf[8];
+	int count;
+	int ret;
+
+	while (true) {
+		fds[0].fd = wakeup[0];
+		fds[0].events = ZSOCK_POLLIN;
+		count = 1;
+
+		k_mutex_lock(&lock, K_FOREVER);
+
+		/* Operations beyond POLL_MAX wait for the first ones to end */
+		SYS_SLIST_FOR_EACH_CONTAINER(&pending, iodev, node) {
+			if (count == POLL_MAX) {
+				break;
+			}
+
+			fds[count].fd = iodev->sock;
+			fds[count].events = iodev->sqe->op == RTIO_OP_TX ?
+					    ZSOCK_POLLOUT : ZSOCK_POLLIN;
+			polled[count] = iodev;
+			count++;
+		}
+
+		k_mutex_unlock(&lock);
+
+		ret = zsock_poll(fds, count, -1);
+		if (ret < 0) {
+			NET_ERR("Cannot poll (%d)", -errno);
+			k_msleep(10);
+			continue;
+		}
+
+		if (fds[0].revents & ZSOCK_POLLIN) {
+			while (zsock_recv(wakeup[0], buf, sizeof(buf),
+					  ZSOCK_MSG_DONTWAIT) > 0) {
+			}
+		}
+
+		for (int i = 1; i < count; i++) {
+			const struct rtio_sqe *sqe;
+			struct rtio *r;
+
+			if (!fds[i].revents) {
+				continue;
+			}
+
+			iodev = polled[i];
+
+			/* Errors are reported by the operation itself */
+			ret = sock_rtio_do(iodev, iodev->sqe);
+			if (ret == -EAGAIN) {
+				continue;
+			}
+
+			k_mutex_lock(&lock, K_FOREVER);
+
+			sys_slist_find_and_remove(&pending, &iodev->node);
+			sqe = iodev->sqe;
+			r = iodev->r;
+			iodev->sqe = NULL;
+			iodev->r = NULL;
+
+			k_mutex_unlock(&lock);
+
+			/* The completion may submit the next operation */
+			sock_rtio_complete(r, sqe, ret);
+		}
+	}
+}
+
+int zsock_rtio_iodev_init(struct zsock_rtio_iodev *iodev, int sock)
+{
+	int ret = 0;
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	if (wakeup[0] < 0) {
+		ret = zsock_socketpair(AF_UNIX, SOCK_STREAM, 0, wakeup);
+		if (ret < 0) {
+			ret = -errno;
+			NET_ERR("Cannot create the wakeup sockets (%d)", ret);
+			goto out;
+		}
+
+		k_thread_start(zsock_rtio);
+	}
+
+	iodev->iodev.api = &sock_rtio_api;
+	iodev->sock = sock;
+	iodev->sqe = NULL;
+	iodev->r = NULL;
+
+out:
+	k_mutex_unlock(&lock);
+
+	return ret;
+}
@@ -47,6 +47,7 @@ LOG_MODULE_REGISTER(net_sock_tls, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <mbedtls/error.h>
 #include <mbedtls/platform.h>
 #include <mbedtls/ssl_cache.h>
+#include <mbedtls/ssl_ticket.h>
 #endif /* CONFIG_MBEDTLS */
 
 #include "sockets_internal.h"
@@ -91,14 +92,20 @@ struct dtls_timing_context {
 	uint32_t fin_ms;
 };
 
-/** TLS peer address/session ID mapping. */
+/** TLS peer/session ID mapping. */
 struct tls_session_cache {
 	/** Creation time. */
 	int64_t timestamp;
 
-	/** Peer address. */
+	/** Peer address, identifies the peer if no hostname was set. */
 	struct sockaddr peer_addr;
 
+	/** Peer hostname, NULL if not set on the socket. */
+	char *hostname;
+
+	/** Credentials the session was established with. */
+	struct sec_tag_list sec_tag_list;
+
 	/** Session buffer. */
 	uint8_t *session;
 
@@ -218,6 +225,14 @@ static struct tls_session_cache client_cache[CONFIG_NET_SOCKETS_TLS_MAX_CLIENT_S
 static mbedtls_ssl_cache_context server_cache;
 #endif
 
+#if defined(MBEDTLS_SSL_TICKET_C)
+/* Keys protecting the session tickets issued by servers, generated on the
+ * first use.
+ */
+static mbedtls_ssl_ticket_context ticket_ctx;
+static bool ticket_ctx_ready;
+#endif
+
 /* A mutex for protecting TLS context allocation. */
 static struct k_mutex context_lock;
 
@@ -227,6 +242,10 @@ static void tls_session_cache_reset(void)
 		if (client_cache[i].session != NULL) {
 			mbedtls_free(client_cache[i].session);
 		}
+
+		if (client_cache[i].hostname != NULL) {
+			mbedtls_free(client_cache[i].hostname);
+		}
 	}
 
 	(void)memset(client_cache, 0, sizeof(client_cache));
@@ -315,6 +334,10 @@ static int tls_init(const struct device *unused)
 	mbedtls_ssl_cache_init(&server_cache);
 #endif
 
+#if defined(MBEDTLS_SSL_TICKET_C)
+	mbedtls_ssl_ticket_init(&ticket_ctx);
+#endif
+
 	return 0;
 }
 
@@ -503,9 +526,49 @@ static bool peer_addr_cmp(const struct sockaddr *addr,
 	return false;
 }
 
-static int tls_session_save(const struct sockaddr *peer_addr,
+static const char *tls_session_hostname(struct tls_context *context)
+{
+#if defined(MBEDTLS_X509_CRT_PARSE_C)
+	if (context->options.is_hostname_set &&
+	    context->ssl.hostname != NULL && context->ssl.hostname[0] != '\0') {
+		return context->ssl.hostname;
+	}
+#endif
+
+	return NULL;
+}
+
+/* Client sessions are identified by the peer hostname if one was set on
+ * the socket, so that they can be resumed when the peer address changes,
+ * by the peer address otherwise, and by the credentials used.
+ */
+static bool tls_session_match(const struct tls_session_cache *entry,
+			      struct tls_context *context,
+			      const struct sockaddr *peer_addr)
+{
+	const struct sec_tag_list *tags = &context->options.sec_tag_list;
+	const char *hostname = tls_session_hostname(context);
+
+	if (entry->sec_tag_list.sec_tag_count != tags->sec_tag_count ||
+	    memcmp(entry->sec_tag_list.sec_tags, tags->sec_tags,
+		   tags->sec_tag_count * sizeof(sec_tag_t)) != 0) {
+		return false;
+	}
+
+	if (hostname != NULL) {
+		return entry->hostname != NULL &&
+		       strcmp(entry->hostname, hostname) == 0;
+	}
+
+	return entry->hostname == NULL &&
+	       peer_addr_cmp(&entry->peer_addr, peer_addr);
+}
+
+static int tls_session_save(struct tls_context *context,
+			    const struct sockaddr *peer_addr,
 			    mbedtls_ssl_session *session)
 {
+	const char *hostname = tls_session_hostname(context);
 	struct tls_session_cache *entry = NULL;
 	size_t session_len;
 	int ret;
@@ -517,8 +580,9 @@ static int tls_session_save(const struct sockaddr *peer_addr,
 				entry = &client_cache[i];
 			}
 		} else {
-			if (peer_addr_cmp(&client_cache[i].peer_addr, peer_addr)) {
-				/* Reuse old entry for given address. */
+			if (tls_session_match(&client_cache[i], context,
+					      peer_addr)) {
+				/* Reuse old entry for given peer. */
 				entry = &client_cache[i];
 				break;
 			}
@@ -539,6 +603,21 @@ static int tls_session_save(const struct sockaddr *peer_addr,
 		entry->session = NULL;
 	}
 
+	if (entry->hostname != NULL) {
+		mbedtls_free(entry->hostname);
+		entry->hostname = NULL;
+	}
+
+	if (hostname != NULL) {
+		entry->hostname = mbedtls_calloc(1, strlen(hostname) + 1);
+		if (entry->hostname == NULL) {
+			NET_ERR("Failed to allocate hostname buffer.");
+			return -ENOMEM;
+		}
+
+		strcpy(entry->hostname, hostname);
+	}
+
 	(void)mbedtls_ssl_session_save(session, NULL, 0, &session_len);
 
 	entry->session = mbedtls_calloc(1, session_len);
@@ -559,11 +638,14 @@ static int tls_session_save(const struct sockaddr *peer_addr,
 	entry->session_len = session_len;
 	entry->timestamp = k_uptime_get();
 	memcpy(&entry->peer_addr, peer_addr, sizeof(*peer_addr));
+	memcpy(&entry->sec_tag_list, &context->options.sec_tag_list,
+	       sizeof(entry->sec_tag_list));
 
 	return 0;
 }
 
-static int tls_session_get(const struct sockaddr *peer_addr,
+static int tls_session_get(struct tls_context *context,
+			   const struct sockaddr *peer_addr,
 			   mbedtls_ssl_session *session)
 {
 	struct tls_session_cache *entry = NULL;
@@ -571,7 +653,7 @@ static int tls_session_get(const struct sockaddr *peer_addr,
 
 	for (int i = 0; i < ARRAY_SIZE(client_cache); i++) {
 		if (client_cache[i].session != NULL &&
-		    peer_addr_cmp(&client_cache[i].peer_addr, peer_addr)) {
+		    tls_session_match(&client_cache[i], context, peer_addr)) {
 			entry = &client_cache[i];
 			break;
 		}
@@ -614,7 +696,7 @@ static void tls_session_store(struct tls_context *context,
 		goto exit;
 	}
 
-	ret = tls_session_save(&peer_addr, &session);
+	ret = tls_session_save(context, &peer_addr, &session);
 	if (ret < 0) {
 		NET_ERR("Failed to save session for %p", context);
 	}
@@ -638,7 +720,7 @@ static void tls_session_restore(struct tls_context *context,
 	memcpy(&peer_addr, addr, addrlen);
 	mbedtls_ssl_session_init(&session);
 
-	ret = tls_session_get(&peer_addr, &session);
+	ret = tls_session_get(context, &peer_addr, &session);
 	if (ret < 0) {
 		NET_DBG("Session not found for %p", context);
 		goto exit;
@@ -653,6 +735,40 @@ exit:
 	mbedtls_ssl_session_free(&session);
 }
 
+#if defined(MBEDTLS_SSL_TICKET_C)
+static int tls_session_ticket_setup(void)
+{
+	int ret = 0;
+
+	k_mutex_lock(&context_lock, K_FOREVER);
+
+	if (ticket_ctx_ready) {
+		goto out;
+	}
+
+	/* With MBEDTLS_HAVE_TIME, mbedTLS also rotates the keys each
+	 * ticket lifetime, still accepting the tickets of the previous key.
+	 */
+	ret = mbedtls_ssl_ticket_setup(&ticket_ctx, tls_ctr_drbg_random, NULL,
+				       MBEDTLS_CIPHER_AES_256_GCM,
+				       CONFIG_NET_SOCKETS_TLS_SESSION_TICKET_LIFETIME);
+	if (ret != 0) {
+		NET_ERR("Failed to setup session tickets, err: 0x%x.", -ret);
+		mbedtls_ssl_ticket_free(&ticket_ctx);
+		mbedtls_ssl_ticket_init(&ticket_ctx);
+		ret = -ENOMEM;
+		goto out;
+	}
+
+	ticket_ctx_ready = true;
+
+out:
+	k_mutex_unlock(&context_lock);
+
+	return ret;
+}
+#endif /* MBEDTLS_SSL_TICKET_C */
+
 static void tls_session_purge(void)
 {
 	tls_session_cache_reset();
@@ -661,6 +777,17 @@ static void tls_session_purge(void)
 	mbedtls_ssl_cache_free(&server_cache);
 	mbedtls_ssl_cache_init(&server_cache);
 #endif
+
+#if defined(MBEDTLS_SSL_TICKET_C)
+	/* New keys are generated on the next use, invalidating the tickets
+	 * issued so far.
+	 */
+	k_mutex_lock(&context_lock, K_FOREVER);
+	mbedtls_ssl_ticket_free(&ticket_ctx);
+	mbedtls_ssl_ticket_init(&ticket_ctx);
+	ticket_ctx_ready = false;
+	k_mutex_unlock(&context_lock);
+#endif
 }
 
 static inline int time_left(uint32_t start, uint32_t timeout)
@@ -1283,6 +1410,16 @@ static int tls_mbedtls_init(struct tls_context *context, bool is_server)
 	}
 #endif
 
+#if defined(MBEDTLS_SSL_TICKET_C)
+	if (is_server && context->options.cache_enabled &&
+	    tls_session_ticket_setup() == 0) {
+		mbedtls_ssl_conf_session_tickets_cb(&context->config,
+						    mbedtls_ssl_ticket_write,
+						    mbedtls_ssl_ticket_parse,
+						    &ticket_ctx);
+	}
+#endif
+
 	ret = mbedtls_ssl_setup(&context->ssl,
 				&context->config);
 	if (ret != 0) {
@@ -563,27 +563,83 @@ static int sendmsg_all(int sock, const struct msghdr *message, int flags)
 }
 #endif /* !defined(CONFIG_NET_TEST) */
 
+/* Mask or unmask data, offset being the position of the data in the
+ * payload. The masking value is XORed a word at a time once the buffer is
+ * aligned, and bytes are masked in the order they are sent.
+ */
+static void websocket_mask_payload(uint8_t *buf, size_t len,
+				   uint32_t masking_value, size_t offset)
+{
+	uint32_t mask = masking_value;
+	uint32_t word_mask;
+	int shift = offset % sizeof(uint32_t);
+
+	/* The next byte is masked with the most significant byte */
+	if (shift) {
+		mask = (mask << (8 * shift)) | (mask >> (32 - 8 * shift));
+	}
+
+	while (len > 0 && ((uintptr_t)buf & (sizeof(uint32_t) - 1))) {
+		*buf++ ^= mask >> 24;
+		mask = (mask << 8) | (mask >> 24);
+		len--;
+	}
+
+	word_mask = sys_cpu_to_be32(mask);
+
+	for (; len >= sizeof(uint32_t); len -= sizeof(uint32_t)) {
+		*(uint32_t *)buf ^= word_mask;
+		buf += sizeof(uint32_t);
+	}
+
+	while (len > 0) {
+		*buf++ ^= mask >> 24;
+		mask = (mask << 8) | (mask >> 24);
+		len--;
+	}
+}
+
+static void websocket_mask_iov(struct iovec *iov, size_t iovcnt,
+			       uint32_t masking_value)
+{
+	size_t offset = 0;
+	int i;
+
+	for (i = 0; i < iovcnt; i++) {
+		websocket_mask_payload(iov[i].iov_base, iov[i].iov_len,
+				       masking_value, offset);
+		offset += iov[i].iov_len;
+	}
+}
+
 static int websocket_prepare_and_send(struct websocket_context *ctx,
 				      uint8_t *header, size_t header_len,
-				      uint8_t *payload, size_t payload_len,
-				      int32_t timeout)
+				      const struct iovec *payload,
+				      size_t iovcnt, int32_t timeout)
 {
-	struct iovec io_vector[2];
+	struct iovec io_vector[1 + CONFIG_WEBSOCKET_SEND_IOV_MAX];
 	struct msghdr msg;
+	int i;
 
 	io_vector[0].iov_base = header;
 	io_vector[0].iov_len = header_len;
-	io_vector[1].iov_base = payload;
-	io_vector[1].iov_len = payload_len;
+
+	for (i = 0; i < iovcnt; i++) {
+		io_vector[1 + i] = payload[i];
+	}
 
 	memset(&msg, 0, sizeof(msg));
 
 	msg.msg_iov = io_vector;
-	msg.msg_iovlen = ARRAY_SIZE(io_vector);
+	msg.msg_iovlen = 1 + iovcnt;
 
 	if (HEXDUMP_SENT_PACKETS) {
 		LOG_HEXDUMP_DBG(header, header_len, "Header");
-		LOG_HEXDUMP_DBG(payload, payload_len, "Payload");
+
+		for (i = 0; i < iovcnt; i++) {
+			LOG_HEXDUMP_DBG(payload[i].iov_base,
+					payload[i].iov_len, "Payload");
+		}
 	}
 
 #if defined(CONFIG_NET_TEST)
@@ -603,23 +659,9 @@ static int websocket_prepare_and_send(struct websocket_context *ctx,
 #endif /* CONFIG_NET_TEST */
 }
 
-int websocket_send_msg(int ws_sock, const uint8_t *payload, size_t payload_len,
-		       enum websocket_opcode opcode, bool mask, bool final,
-		       int32_t timeout)
+static struct websocket_context *websocket_send_ctx(int ws_sock)
 {
 	struct websocket_context *ctx;
-	uint8_t header[MAX_HEADER_LEN], hdr_len = 2;
-	uint8_t *data_to_send = (uint8_t *)payload;
-	int ret;
-
-	if (opcode != WEBSOCKET_OPCODE_DATA_TEXT &&
-	    opcode != WEBSOCKET_OPCODE_DATA_BINARY &&
-	    opcode != WEBSOCKET_OPCODE_CONTINUE &&
-	    opcode != WEBSOCKET_OPCODE_CLOSE &&
-	    opcode != WEBSOCKET_OPCODE_PING &&
-	    opcode != WEBSOCKET_OPCODE_PONG) {
-		return -EINVAL;
-	}
 
 #if defined(CONFIG_NET_TEST)
 	/* Websocket unit test does not use socket layer but feeds
@@ -629,18 +671,27 @@ int websocket_send_msg(int ws_sock, const uint8_t *payload, size_t payload_len,
 #else
 	ctx = z_get_fd_obj(ws_sock, NULL, 0);
 	if (ctx == NULL) {
-		return -EBADF;
+		errno = EBADF;
+		return NULL;
 	}
 
 	if (!PART_OF_ARRAY(contexts, ctx)) {
-		return -ENOENT;
+		errno = ENOENT;
+		return NULL;
 	}
 #endif /* CONFIG_NET_TEST */
 
-	NET_DBG("[%p] Len %zd %s/%d/%s", ctx, payload_len, opcode2str(opcode),
-		mask, final ? "final" : "more");
+	return ctx;
+}
 
-	memset(header, 0, sizeof(header));
+/* Returns the length of the header, masking value included */
+static size_t websocket_build_header(uint8_t *header, size_t payload_len,
+				     enum websocket_opcode opcode, bool mask,
+				     bool final, uint32_t masking_value)
+{
+	size_t hdr_len = 2;
+
+	memset(header, 0, MAX_HEADER_LEN);
 
 	/* Is this the last packet? */
 	header[0] = final ? BIT(7) : 0;
@@ -673,15 +724,53 @@ int websocket_send_msg(int ws_sock, const uint8_t *payload, size_t payload_len,
 
 	/* Add masking value if needed */
 	if (mask) {
-		int i;
+		sys_put_be32(masking_value, &header[hdr_len]);
+		hdr_len += sizeof(uint32_t);
+	}
+
+	return hdr_len;
+}
+
+static bool websocket_opcode_is_valid(enum websocket_opcode opcode)
+{
+	return opcode == WEBSOCKET_OPCODE_DATA_TEXT ||
+	       opcode == WEBSOCKET_OPCODE_DATA_BINARY ||
+	       opcode == WEBSOCKET_OPCODE_CONTINUE ||
+	       opcode == WEBSOCKET_OPCODE_CLOSE ||
+	       opcode == WEBSOCKET_OPCODE_PING ||
+	       opcode == WEBSOCKET_OPCODE_PONG;
+}
+
+int websocket_send_msg(int ws_sock, const uint8_t *payload, size_t payload_len,
+		       enum websocket_opcode opcode, bool mask, bool final,
+		       int32_t timeout)
+{
+	struct websocket_context *ctx;
+	uint8_t header[MAX_HEADER_LEN];
+	uint8_t *data_to_send = (uint8_t *)payload;
+	uint32_t masking_value = 0U;
+	struct iovec iov;
+	size_t hdr_len;
+	int ret;
 
-		ctx->masking_value = sys_rand32_get();
+	if (!websocket_opcode_is_valid(opcode)) {
+		return -EINVAL;
+	}
 
-		header[hdr_len++] |= ctx->masking_value >> 24;
-		header[hdr_len++] |= ctx->masking_value >> 16;
-		header[hdr_len++] |= ctx->masking_value >> 8;
-		header[hdr_len++] |= ctx->masking_value;
+	ctx = websocket_send_ctx(ws_sock);
+	if (ctx == NULL) {
+		return -errno;
+	}
+
+	NET_DBG("[%p] Len %zd %s/%d/%s", ctx, payload_len, opcode2str(opcode),
+		mask, final ? "final" : "more");
+
+	if (mask) {
+		masking_value = sys_rand32_get();
 
+		/* The payload is const, so it is masked in a copy. Use
+		 * websocket_send_msg_iov() to mask it in place instead.
+		 */
 		data_to_send = k_malloc(payload_len);
 		if (!data_to_send) {
 			return -ENOMEM;
@@ -689,14 +778,18 @@ int websocket_send_msg(int ws_sock, const uint8_t *payload, size_t payload_len,
 
 		memcpy(data_to_send, payload, payload_len);
 
-		for (i = 0; i < payload_len; i++) {
-			data_to_send[i] ^=
-				ctx->masking_value >> (8 * (3 - i % 4));
-		}
+		websocket_mask_payload(data_to_send, payload_len,
+				       masking_value, 0);
 	}
 
-	ret = websocket_prepare_and_send(ctx, header, hdr_len,
-					 data_to_send, payload_len, timeout);
+	hdr_len = websocket_build_header(header, payload_len, opcode, mask,
+					 final, masking_value);
+
+	iov.iov_base = data_to_send;
+	iov.iov_len = payload_len;
+
+	ret = websocket_prepare_and_send(ctx, header, hdr_len, &iov, 1,
+					 timeout);
 	if (ret < 0) {
 		NET_DBG("Cannot send ws msg (%d)", -errno);
 		goto quit;
@@ -715,6 +808,62 @@ quit:
 	return ret - hdr_len;
 }
 
+int websocket_send_msg_iov(int ws_sock, struct iovec *iov, size_t iovcnt,
+			   enum websocket_opcode opcode, bool mask, bool final,
+			   int32_t timeout)
+{
+	struct websocket_context *ctx;
+	uint8_t header[MAX_HEADER_LEN];
+	uint32_t masking_value = 0U;
+	size_t payload_len = 0;
+	size_t hdr_len;
+	int ret;
+	int i;
+
+	if (!websocket_opcode_is_valid(opcode) ||
+	    iovcnt > CONFIG_WEBSOCKET_SEND_IOV_MAX) {
+		return -EINVAL;
+	}
+
+	ctx = websocket_send_ctx(ws_sock);
+	if (ctx == NULL) {
+		return -errno;
+	}
+
+	for (i = 0; i < iovcnt; i++) {
+		payload_len += iov[i].iov_len;
+	}
+
+	NET_DBG("[%p] Len %zd (%zd buffers) %s/%d/%s", ctx, payload_len,
+		iovcnt, opcode2str(opcode), mask, final ? "final" : "more");
+
+	if (mask) {
+		masking_value = sys_rand32_get();
+		websocket_mask_iov(iov, iovcnt, masking_value);
+	}
+
+	hdr_len = websocket_build_header(header, payload_len, opcode, mask,
+					 final, masking_value);
+
+	ret = websocket_prepare_and_send(ctx, header, hdr_len, iov, iovcnt,
+					 timeout);
+	if (ret < 0) {
+		NET_DBG("Cannot send ws msg (%d)", ret);
+	}
+
+	/* Masking twice gives the original data back to the caller */
+	if (mask) {
+		websocket_mask_iov(iov, iovcnt, masking_value);
+	}
+
+	/* Do no math with 0 and error codes */
+	if (ret <= 0) {
+		return ret;
+	}
+
+	return ret - hdr_len;
+}
+
 static bool websocket_parse_header(uint8_t *buf, size_t buf_len, bool *masked,
 				   uint32_t *mask_value, uint64_t *message_length,
 				   uint32_t *message_type_flag,
@@ -960,17 +1109,12 @@ int websocket_recv_msg(int ws_sock, uint8_t *buf, size_t buf_len,
 
 	/* Unmask the data */
 	if (ctx->masked) {
-		/* As we might have less than 4 received bytes, we must select
-		 * which byte from masking value to take. The mask_shift will
-		 * tell that.
+		/* As we might have less than 4 received bytes, the offset
+		 * in the message selects which byte of the masking value
+		 * is taken first.
 		 */
-		int mask_shift = (ctx->total_read - recv_len) % sizeof(uint32_t);
-		int i;
-
-		for (i = 0; i < recv_len; i++) {
-			buf[i] ^= ctx->masking_value >>
-				(8 * (3 - (i + mask_shift) % 4));
-		}
+		websocket_mask_payload(buf, recv_len, ctx->masking_value,
+				       ctx->total_read - recv_len);
 	}
 
 #if HEXDUMP_RECV_PACKETS
@@ -78,7 +78,9 @@ int zperf_get_ipv4_addr(const struct shell *sh, char *host,
 			struct in_addr *addr);
 struct sockaddr_in *zperf_get_sin(void);
 
+extern void zperf_udp_uploader_init(void);
 extern void zperf_udp_upload(const struct shell *sh,
+			     int stream_id,
 			     int sock,
 			     int port,
 			     unsigned int duration_in_ms,
@@ -86,10 +88,11 @@ extern void zperf_udp_upload(const struct shell *sh,
 			     unsigned int rate_in_kbps,
 			     struct zperf_results *results);
 
-extern void zperf_udp_receiver_init(const struct shell *sh, int port);
+extern void zperf_udp_receiver_init(const struct shell *sh, int port,
+				    bool json);
 
 extern void zperf_tcp_receiver_init(const struct shell *sh, int port);
-extern void zperf_tcp_uploader_init(struct k_fifo *tx_queue);
+extern void zperf_tcp_uploader_init(void);
 extern void zperf_tcp_upload(const struct shell *sh,
 			     int sock,
 			     unsigned int duration_in_ms,
@@ -135,7 +135,78 @@ void zperf_reset_session_stats(struct session *session)
 	session->error = 0U;
 	session->jitter = 0;
 	session->last_transit_time = 0;
+
+#if defined(CONFIG_NET_ZPERF_LATENCY_PERCENTILES)
+	session->min_transit_time = 0;
+	memset(&session->delay, 0, sizeof(session->delay));
+	memset(&session->ipdv, 0, sizeof(session->ipdv));
+#endif
+}
+
+#if defined(CONFIG_NET_ZPERF_LATENCY_PERCENTILES)
+static int histogram_bucket(uint32_t value)
+{
+	int msb;
+
+	if (value < BIT(ZPERF_HIST_LINEAR_BITS)) {
+		return value;
+	}
+
+	msb = 31 - __builtin_clz(value);
+	if (msb >= ZPERF_HIST_MAX_BITS) {
+		return ZPERF_HIST_BUCKETS - 1;
+	}
+
+	return BIT(ZPERF_HIST_LINEAR_BITS) +
+		((msb - ZPERF_HIST_LINEAR_BITS) << ZPERF_HIST_SUB_BITS) +
+		((value >> (msb - ZPERF_HIST_SUB_BITS)) &
+		 (BIT(ZPERF_HIST_SUB_BITS) - 1));
+}
+
+/* Returns the highest value counted in a bucket */
+static uint32_t histogram_bucket_max(int bucket)
+{
+	int msb, sub;
+
+	if (bucket < BIT(ZPERF_HIST_LINEAR_BITS)) {
+		return bucket;
+	}
+
+	bucket -= BIT(ZPERF_HIST_LINEAR_BITS);
+	msb = ZPERF_HIST_LINEAR_BITS + (bucket >> ZPERF_HIST_SUB_BITS);
+	sub = bucket & (BIT(ZPERF_HIST_SUB_BITS) - 1);
+
+	return BIT(msb) + ((sub + 1) << (msb - ZPERF_HIST_SUB_BITS)) - 1;
+}
+
+void zperf_histogram_add(struct zperf_histogram *hist, uint32_t value)
+{
+	hist->buckets[histogram_bucket(value)]++;
+	hist->count++;
+	hist->max = MAX(hist->max, value);
+}
+
+uint32_t zperf_histogram_percentile(const struct zperf_histogram *hist,
+				    uint32_t permille)
+{
+	uint64_t target = DIV_ROUND_UP((uint64_t)hist->count * permille, 1000U);
+	uint64_t total = 0U;
+
+	if (hist->count == 0U) {
+		return 0U;
+	}
+
+	for (int i = 0; i < ZPERF_HIST_BUCKETS; i++) {
+		total += hist->buckets[i];
+		/* The last bucket also counts the larger values */
+		if (total >= target && i < ZPERF_HIST_BUCKETS - 1) {
+			return MIN(histogram_bucket_max(i), hist->max);
+		}
+	}
+
+	return hist->max;
 }
+#endif /* CONFIG_NET_ZPERF_LATENCY_PERCENTILES */
 
 void zperf_session_init(void)
 {
@@ -33,6 +33,25 @@ enum session_proto {
 	SESSION_PROTO_END
 };
 
+#if defined(CONFIG_NET_ZPERF_LATENCY_PERCENTILES)
+/* Values below 16 us have their own bucket, the larger ones are split in
+ * 4 buckets per power of two up to 2^24 us.
+ */
+#define ZPERF_HIST_LINEAR_BITS 4
+#define ZPERF_HIST_SUB_BITS 2
+#define ZPERF_HIST_MAX_BITS 24
+#define ZPERF_HIST_BUCKETS (BIT(ZPERF_HIST_LINEAR_BITS) + \
+			    (ZPERF_HIST_MAX_BITS - ZPERF_HIST_LINEAR_BITS) * \
+			    BIT(ZPERF_HIST_SUB_BITS))
+
+/* Histogram of durations in us */
+struct zperf_histogram {
+	uint32_t count;
+	uint32_t max;
+	uint32_t buckets[ZPERF_HIST_BUCKETS];
+};
+#endif
+
 struct session {
 	/* Tuple for UDP */
 	uint16_t port;
@@ -54,6 +73,17 @@ struct session {
 	int32_t jitter;
 	int32_t last_transit_time;
 
+#if defined(CONFIG_NET_ZPERF_LATENCY_PERCENTILES)
+	/* One-way delay, relative to the lowest one of the session as the
+	 * clocks of the peers are not synchronized.
+	 */
+	int32_t min_transit_time;
+	struct zperf_histogram delay;
+
+	/* Delay variation between consecutive datagrams */
+	struct zperf_histogram ipdv;
+#endif
+
 	/* Stats packet*/
 	struct zperf_server_hdr stat;
 };
@@ -64,4 +94,10 @@ struct session *get_tcp_session(int sock);
 void zperf_session_init(void);
 void zperf_reset_session_stats(struct session *session);
 
+#if defined(CONFIG_NET_ZPERF_LATENCY_PERCENTILES)
+void zperf_histogram_add(struct zperf_histogram *hist, uint32_t value);
+uint32_t zperf_histogram_percentile(const struct zperf_histogram *hist,
+				    uint32_t permille);
+#endif
+
 #endif /* __ZPERF_SESSION_H */
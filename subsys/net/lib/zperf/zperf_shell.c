@@ -322,9 +322,16 @@ static int cmd_udp_download(const struct shell *sh, size_t argc,
 	if (IS_ENABLED(CONFIG_NET_UDP)) {
 		static bool udp_stopped = true;
 		int port, start = 0;
+		bool json = false;
 
 		do_init(sh);
 
+		if (argc >= 2 && !strcmp(argv[1], "-j")) {
+			json = true;
+			start++;
+			argc--;
+		}
+
 		if (argc >= 2) {
 			port = strtoul(argv[start + 1], NULL, 10);
 		} else {
@@ -337,7 +344,7 @@ static int cmd_udp_download(const struct shell *sh, size_t argc,
 			return -ENOEXEC;
 		}
 
-		zperf_udp_receiver_init(sh, port);
+		zperf_udp_receiver_init(sh, port, json);
 
 		k_yield();
 
@@ -499,6 +506,302 @@ static int setup_upload_sockets(const struct shell *sh,
 	return 0;
 }
 
+struct upload_options {
+	/* Number of parallel streams */
+	int streams;
+
+	/* CPU the first stream is pinned to, -1 if not pinned */
+	int cpu;
+
+	/* Print the results as JSON too */
+	bool json;
+};
+
+/* Parse the options given before the other arguments of the upload
+ * commands. Returns the number of arguments used by the options.
+ */
+static int parse_upload_options(const struct shell *sh, size_t argc,
+				char *argv[], struct upload_options *opts)
+{
+	int i = 1;
+
+	opts->streams = 1;
+	opts->cpu = -1;
+	opts->json = false;
+
+	while (i < argc && argv[i][0] == '-') {
+		if (!strcmp(argv[i], "-j")) {
+			opts->json = true;
+			i++;
+			continue;
+		}
+
+		if (i + 1 >= argc) {
+			shell_fprintf(sh, SHELL_WARNING,
+				      "Missing value of option %s\n", argv[i]);
+			return -ENOEXEC;
+		}
+
+		if (!strcmp(argv[i], "-P")) {
+			opts->streams = strtoul(argv[i + 1], NULL, 10);
+			if (opts->streams < 1 ||
+			    opts->streams > CONFIG_NET_ZPERF_MAX_STREAMS) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "Number of streams must be between "
+					      "1 and %d\n",
+					      CONFIG_NET_ZPERF_MAX_STREAMS);
+				return -ENOEXEC;
+			}
+		} else if (!strcmp(argv[i], "-a")) {
+			if (!IS_ENABLED(CONFIG_SCHED_CPU_MASK)) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "CPU pinning needs "
+					      "CONFIG_SCHED_CPU_MASK\n");
+				return -ENOEXEC;
+			}
+
+			opts->cpu = strtoul(argv[i + 1], NULL, 10);
+		} else {
+			shell_fprintf(sh, SHELL_WARNING,
+				      "Unknown option %s\n", argv[i]);
+			return -ENOEXEC;
+		}
+
+		i += 2;
+	}
+
+	return i - 1;
+}
+
+static uint32_t rate_in_kbps_get(uint64_t bytes, uint32_t time_in_us)
+{
+	if (time_in_us == 0U) {
+		return 0U;
+	}
+
+	return (uint32_t)((bytes * 8ULL * USEC_PER_SEC) /
+			  ((uint64_t)time_in_us * 1024U));
+}
+
+/* Print the results on one line for scripts, stream being -1 for the sum
+ * of all the streams.
+ */
+static void print_results_json(const struct shell *sh, bool is_udp,
+			       int stream, struct zperf_results *results)
+{
+	uint64_t client_bytes = (uint64_t)results->nb_packets_sent *
+				results->packet_size;
+
+	if (stream < 0) {
+		shell_fprintf(sh, SHELL_NORMAL, "{\"stream\":\"sum\"");
+	} else {
+		shell_fprintf(sh, SHELL_NORMAL, "{\"stream\":%d", stream);
+	}
+
+	shell_fprintf(sh, SHELL_NORMAL,
+		      ",\"proto\":\"%s\",\"client_time_us\":%u,"
+		      "\"packets_sent\":%u,\"packet_size\":%u,"
+		      "\"client_rate_kbps\":%u",
+		      is_udp ? "udp" : "tcp", results->client_time_in_us,
+		      results->nb_packets_sent, results->packet_size,
+		      rate_in_kbps_get(client_bytes,
+				       results->client_time_in_us));
+
+	if (is_udp) {
+		shell_fprintf(sh, SHELL_NORMAL,
+			      ",\"server_time_us\":%u,\"packets_rcvd\":%u,"
+			      "\"packets_lost\":%u,\"packets_outorder\":%u,"
+			      "\"jitter_us\":%u,\"server_rate_kbps\":%u",
+			      results->time_in_us, results->nb_packets_rcvd,
+			      results->nb_packets_lost,
+			      results->nb_packets_outorder,
+			      results->jitter_in_us,
+			      rate_in_kbps_get(results->nb_bytes_sent,
+					       results->time_in_us));
+	} else {
+		shell_fprintf(sh, SHELL_NORMAL, ",\"errors\":%u",
+			      results->nb_packets_errors);
+	}
+
+	shell_fprintf(sh, SHELL_NORMAL, "}\n");
+}
+
+#if CONFIG_NET_ZPERF_MAX_STREAMS > 1
+struct upload_stream {
+	struct k_thread thread;
+	const struct shell *sh;
+	int id;
+	int sock;
+	int port;
+	bool is_udp;
+	unsigned int duration_in_ms;
+	unsigned int packet_size;
+	unsigned int rate_in_kbps;
+	struct zperf_results results;
+};
+
+static struct upload_stream upload_streams[CONFIG_NET_ZPERF_MAX_STREAMS];
+static K_THREAD_STACK_ARRAY_DEFINE(upload_stream_stacks,
+				   CONFIG_NET_ZPERF_MAX_STREAMS,
+				   CONFIG_NET_ZPERF_STREAM_STACK_SIZE);
+
+static void upload_stream_thread(void *ptr1, void *ptr2, void *ptr3)
+{
+	struct upload_stream *stream = ptr1;
+
+	ARG_UNUSED(ptr2);
+	ARG_UNUSED(ptr3);
+
+	if (stream->is_udp) {
+		zperf_udp_upload(stream->sh, stream->id, stream->sock,
+				 stream->port, stream->duration_in_ms,
+				 stream->packet_size, stream->rate_in_kbps,
+				 &stream->results);
+	} else {
+		zperf_tcp_upload(stream->sh, stream->sock,
+				 stream->duration_in_ms, stream->packet_size,
+				 &stream->results);
+	}
+}
+
+static void add_results(struct zperf_results *total,
+			const struct zperf_results *results)
+{
+	total->nb_packets_sent += results->nb_packets_sent;
+	total->nb_packets_rcvd += results->nb_packets_rcvd;
+	total->nb_packets_lost += results->nb_packets_lost;
+	total->nb_packets_outorder += results->nb_packets_outorder;
+	total->nb_packets_errors += results->nb_packets_errors;
+	total->nb_bytes_sent += results->nb_bytes_sent;
+	total->time_in_us = MAX(total->time_in_us, results->time_in_us);
+	total->client_time_in_us = MAX(total->client_time_in_us,
+				       results->client_time_in_us);
+	total->jitter_in_us = MAX(total->jitter_in_us, results->jitter_in_us);
+	total->packet_size = results->packet_size;
+}
+
+static void print_upload_stats(const struct shell *sh, bool is_udp,
+			       struct zperf_results *results)
+{
+	if (is_udp) {
+		shell_udp_upload_print_stats(sh, results);
+	} else {
+		shell_tcp_upload_print_stats(sh, results);
+	}
+}
+
+/* Upload with one socket and thread per stream, all of them connected to
+ * the same peer.
+ */
+static int execute_upload_streams(const struct shell *sh,
+				  sa_family_t family,
+				  struct sockaddr *addr,
+				  socklen_t addrlen,
+				  bool is_udp,
+				  int port,
+				  unsigned int duration_in_ms,
+				  unsigned int packet_size,
+				  unsigned int rate_in_kbps,
+				  const struct upload_options *opts)
+{
+	struct zperf_results total = { };
+	struct upload_stream *stream;
+	int count = 0;
+	int ret = 0;
+	int i;
+
+	for (i = 0; i < opts->streams; i++) {
+		stream = &upload_streams[i];
+
+		stream->sock = zsock_socket(family,
+					    is_udp ? SOCK_DGRAM : SOCK_STREAM,
+					    is_udp ? IPPROTO_UDP : IPPROTO_TCP);
+		if (stream->sock < 0) {
+			shell_fprintf(sh, SHELL_WARNING,
+				      "Cannot create network socket (%d)\n",
+				      errno);
+			ret = -ENOEXEC;
+			goto out;
+		}
+
+		count++;
+
+		if (zsock_connect(stream->sock, addr, addrlen) < 0) {
+			shell_fprintf(sh, SHELL_WARNING,
+				      "Stream %d connect failed (%d)\n", i,
+				      errno);
+			ret = -ENOEXEC;
+			goto out;
+		}
+	}
+
+	shell_fprintf(sh, SHELL_NORMAL, "Streams:\t%d\n", opts->streams);
+
+	for (i = 0; i < opts->streams; i++) {
+		stream = &upload_streams[i];
+
+		stream->sh = sh;
+		stream->id = i;
+		stream->port = port;
+		stream->is_udp = is_udp;
+		stream->duration_in_ms = duration_in_ms;
+		stream->packet_size = packet_size;
+		stream->rate_in_kbps = rate_in_kbps;
+		memset(&stream->results, 0, sizeof(stream->results));
+
+		k_thread_create(&stream->thread, upload_stream_stacks[i],
+				K_THREAD_STACK_SIZEOF(upload_stream_stacks[i]),
+				upload_stream_thread, stream, NULL, NULL,
+				k_thread_priority_get(k_current_get()), 0,
+				K_FOREVER);
+
+#if defined(CONFIG_SCHED_CPU_MASK)
+		if (opts->cpu >= 0) {
+			(void)k_thread_cpu_pin(&stream->thread,
+					       (opts->cpu + i) %
+					       CONFIG_MP_NUM_CPUS);
+		}
+#endif
+	}
+
+	for (i = 0; i < opts->streams; i++) {
+		k_thread_start(&upload_streams[i].thread);
+	}
+
+	for (i = 0; i < opts->streams; i++) {
+		(void)k_thread_join(&upload_streams[i].thread, K_FOREVER);
+	}
+
+	for (i = 0; i < opts->streams; i++) {
+		stream = &upload_streams[i];
+
+		shell_fprintf(sh, SHELL_NORMAL, "-\nStream %d:\n", i);
+		print_upload_stats(sh, is_udp, &stream->results);
+		add_results(&total, &stream->results);
+	}
+
+	shell_fprintf(sh, SHELL_NORMAL, "-\nSum of %d streams:\n",
+		      opts->streams);
+	print_upload_stats(sh, is_udp, &total);
+
+	if (opts->json) {
+		for (i = 0; i < opts->streams; i++) {
+			print_results_json(sh, is_udp, i,
+					   &upload_streams[i].results);
+		}
+
+		print_results_json(sh, is_udp, -1, &total);
+	}
+
+out:
+	for (i = 0; i < count; i++) {
+		(void)zsock_close(upload_streams[i].sock);
+	}
+
+	return ret;
+}
+#endif /* CONFIG_NET_ZPERF_MAX_STREAMS > 1 */
+
 static int execute_upload(const struct shell *sh,
 			  int sock6,
 			  int sock4,
@@ -510,7 +813,8 @@ static int execute_upload(const struct shell *sh,
 			  char *argv0,
 			  unsigned int duration_in_ms,
 			  unsigned int packet_size,
-			  unsigned int rate_in_kbps)
+			  unsigned int rate_in_kbps,
+			  const struct upload_options *opts)
 {
 	struct zperf_results results = { };
 	int ret;
@@ -536,6 +840,33 @@ static int execute_upload(const struct shell *sh,
 		k_sleep(K_SECONDS(1));
 	}
 
+#if CONFIG_NET_ZPERF_MAX_STREAMS > 1
+	if (opts->streams > 1) {
+		if (sock6 >= 0) {
+			(void)zsock_close(sock6);
+		}
+
+		if (sock4 >= 0) {
+			(void)zsock_close(sock4);
+		}
+
+		if (family == AF_INET6) {
+			return execute_upload_streams(sh, family,
+						      (struct sockaddr *)ipv6,
+						      sizeof(*ipv6), is_udp,
+						      port, duration_in_ms,
+						      packet_size, rate_in_kbps,
+						      opts);
+		}
+
+		return execute_upload_streams(sh, family,
+					      (struct sockaddr *)ipv4,
+					      sizeof(*ipv4), is_udp, port,
+					      duration_in_ms, packet_size,
+					      rate_in_kbps, opts);
+	}
+#endif
+
 	if (is_udp && IS_ENABLED(CONFIG_NET_UDP)) {
 		shell_fprintf(sh, SHELL_NORMAL, "Rate:\t\t");
 		print_number(sh, rate_in_kbps, KBPS, KBPS_UNIT);
@@ -552,9 +883,13 @@ static int execute_upload(const struct shell *sh,
 				goto out;
 			}
 
-			zperf_udp_upload(sh, sock6, port, duration_in_ms,
+			zperf_udp_upload(sh, 0, sock6, port, duration_in_ms,
 					 packet_size, rate_in_kbps, &results);
 			shell_udp_upload_print_stats(sh, &results);
+
+			if (opts->json) {
+				print_results_json(sh, true, 0, &results);
+			}
 		}
 
 		if (family == AF_INET && sock4 >= 0) {
@@ -568,9 +903,13 @@ static int execute_upload(const struct shell *sh,
 				goto out;
 			}
 
-			zperf_udp_upload(sh, sock4, port, duration_in_ms,
+			zperf_udp_upload(sh, 0, sock4, port, duration_in_ms,
 					 packet_size, rate_in_kbps, &results);
 			shell_udp_upload_print_stats(sh, &results);
+
+			if (opts->json) {
+				print_results_json(sh, true, 0, &results);
+			}
 		}
 	} else {
 		if (!IS_ENABLED(CONFIG_NET_UDP)) {
@@ -603,6 +942,10 @@ static int execute_upload(const struct shell *sh,
 					 packet_size, &results);
 
 			shell_tcp_upload_print_stats(sh, &results);
+
+			if (opts->json) {
+				print_results_json(sh, false, 0, &results);
+			}
 		}
 
 		if (family == AF_INET && sock4 >= 0) {
@@ -625,6 +968,10 @@ static int execute_upload(const struct shell *sh,
 					 packet_size, &results);
 
 			shell_tcp_upload_print_stats(sh, &results);
+
+			if (opts->json) {
+				print_results_json(sh, false, 0, &results);
+			}
 		}
 	} else {
 		if (!IS_ENABLED(CONFIG_NET_TCP)) {
@@ -655,13 +1002,21 @@ static int shell_cmd_upload(const struct shell *sh, size_t argc,
 	int sock6 = -1, sock4 = -1;
 	sa_family_t family = AF_UNSPEC;
 	unsigned int duration_in_ms, packet_size, rate_in_kbps;
+	struct upload_options opts;
 	char *port_str;
 	uint16_t port;
 	bool is_udp;
-	int start = 0;
+	int start;
 
 	is_udp = proto == IPPROTO_UDP;
 
+	start = parse_upload_options(sh, argc, argv, &opts);
+	if (start < 0) {
+		return start;
+	}
+
+	argc -= start;
+
 	if (argc < 2) {
 		shell_fprintf(sh, SHELL_WARNING,
 			      "Not enough parameters.\n");
@@ -774,7 +1129,7 @@ static int shell_cmd_upload(const struct shell *sh, size_t argc,
 
 	return execute_upload(sh, sock6, sock4, family, &ipv6, &ipv4,
 			      is_udp, port, argv[start], duration_in_ms,
-			      packet_size, rate_in_kbps);
+			      packet_size, rate_in_kbps, &opts);
 }
 
 static int cmd_tcp_upload(const struct shell *sh, size_t argc, char *argv[])
@@ -798,11 +1153,19 @@ static int shell_cmd_upload2(const struct shell *sh, size_t argc,
 	uint16_t port = DEF_PORT;
 	unsigned int duration_in_ms, packet_size, rate_in_kbps;
 	sa_family_t family;
+	struct upload_options opts;
 	uint8_t is_udp;
-	int start = 0;
+	int start;
 
 	is_udp = proto == IPPROTO_UDP;
 
+	start = parse_upload_options(sh, argc, argv, &opts);
+	if (start < 0) {
+		return start;
+	}
+
+	argc -= start;
+
 	if (argc < 2) {
 		shell_fprintf(sh, SHELL_WARNING,
 			      "Not enough parameters.\n");
@@ -894,7 +1257,7 @@ static int shell_cmd_upload2(const struct shell *sh, size_t argc,
 
 	return execute_upload(sh, sock6, sock4, family, &in6_addr_dst,
 			      &in4_addr_dst, is_udp, port, argv[start],
-			      duration_in_ms, packet_size, rate_in_kbps);
+			      duration_in_ms, packet_size, rate_in_kbps, &opts);
 }
 
 static int cmd_tcp_upload2(const struct shell *sh, size_t argc,
@@ -1064,11 +1427,21 @@ static void zperf_init(const struct shell *sh)
 	shell_fprintf(sh, SHELL_NORMAL, "\n");
 
 	zperf_session_init();
+	zperf_udp_uploader_init();
+	zperf_tcp_uploader_init();
 }
 
+#define UPLOAD_OPTIONS_HELP					\
+	"-P <streams>  Number of parallel streams, up to "		\
+		STRINGIFY(CONFIG_NET_ZPERF_MAX_STREAMS) "\n"		\
+	"-a <cpu>      Pin the streams to CPUs, starting with this one\n" \
+	"-j            Print the results as JSON too\n"
+
 SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_tcp,
 	SHELL_CMD(upload, NULL,
-		  "<dest ip> <dest port> <duration> <packet size>[K]\n"
+		  "[<options>] <dest ip> <dest port> <duration> "
+							"<packet size>[K]\n"
+		  UPLOAD_OPTIONS_HELP
 		  "<dest ip>     IP destination\n"
 		  "<dest port>   port destination\n"
 		  "<duration>    of the test in seconds\n"
@@ -1078,7 +1451,9 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_tcp,
 		  "Example: tcp upload 2001:db8::2\n",
 		  cmd_tcp_upload),
 	SHELL_CMD(upload2, NULL,
-		  "v6|v4 <duration> <packet size>[K] <baud rate>[K|M]\n"
+		  "[<options>] v6|v4 <duration> <packet size>[K] "
+							"<baud rate>[K|M]\n"
+		  UPLOAD_OPTIONS_HELP
 		  "<v6|v4>:      Use either IPv6 or IPv4\n"
 		  "<duration>    Duration of the test in seconds\n"
 		  "<packet size> Size of the packet in byte or kilobyte "
@@ -1104,8 +1479,9 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_tcp,
 
 SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_udp,
 	SHELL_CMD(upload, NULL,
-		  "<dest ip> [<dest port> <duration> <packet size>[K] "
-							"<baud rate>[K|M]]\n"
+		  "[<options>] <dest ip> [<dest port> <duration> "
+					"<packet size>[K] <baud rate>[K|M]]\n"
+		  UPLOAD_OPTIONS_HELP
 		  "<dest ip>     IP destination\n"
 		  "<dest port>   port destination\n"
 		  "<duration>    of the test in seconds\n"
@@ -1116,7 +1492,9 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_udp,
 		  "Example: udp upload 2001:db8::2\n",
 		  cmd_udp_upload),
 	SHELL_CMD(upload2, NULL,
-		  "v6|v4 [<duration> <packet size>[K] <baud rate>[K|M]]\n"
+		  "[<options>] v6|v4 [<duration> <packet size>[K] "
+							"<baud rate>[K|M]]\n"
+		  UPLOAD_OPTIONS_HELP
 		  "<v6|v4>:      Use either IPv6 or IPv4\n"
 		  "<duration>    Duration of the test in seconds\n"
 		  "<packet size> Size of the packet in byte or kilobyte "
@@ -1135,7 +1513,8 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_udp,
 		  ,
 		  cmd_udp_upload2),
 	SHELL_CMD(download, NULL,
-		  "[<port>]\n"
+		  "[-j] [<port>]\n"
+		  "-j            Print the statistics as JSON too\n"
 		  "Example: udp download 5001\n",
 		  cmd_udp_download),
 	SHELL_SUBCMD_SET_END
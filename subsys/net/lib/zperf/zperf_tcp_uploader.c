@@ -18,6 +18,17 @@ LOG_MODULE_DECLARE(net_zperf, CONFIG_NET_ZPERF_LOG_LEVEL);
 
 static char sample_packet[PACKET_SIZE_MAX];
 
+void zperf_tcp_uploader_init(void)
+{
+	(void)memset(sample_packet, 'z', sizeof(sample_packet));
+
+	/* Set the "flags" field in start of the packet to be 0.
+	 * As the protocol is not properly described anywhere, it is
+	 * not certain if this is a proper thing to do.
+	 */
+	(void)memset(sample_packet, 0, sizeof(uint32_t));
+}
+
 void zperf_tcp_upload(const struct shell *sh,
 		      int sock,
 		      unsigned int duration_in_ms,
@@ -43,14 +54,6 @@ void zperf_tcp_upload(const struct shell *sh,
 	shell_fprintf(sh, SHELL_NORMAL,
 		      "New session started\n");
 
-	(void)memset(sample_packet, 'z', sizeof(sample_packet));
-
-	/* Set the "flags" field in start of the packet to be 0.
-	 * As the protocol is not properly described anywhere, it is
-	 * not certain if this is a proper thing to do.
-	 */
-	(void)memset(sample_packet, 0, sizeof(uint32_t));
-
 	do {
 		int ret = 0;
 
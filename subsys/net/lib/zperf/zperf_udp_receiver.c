@@ -43,6 +43,9 @@ static struct sockaddr_in *in4_addr_my;
 K_THREAD_STACK_DEFINE(udp_receiver_stack_area, UDP_RECEIVER_STACK_SIZE);
 struct k_thread udp_receiver_thread_data;
 
+/* Print the statistics of the sessions as JSON too */
+static bool json_output;
+
 static inline void build_reply(struct zperf_udp_datagram *hdr,
 			       struct zperf_server_hdr *stat,
 			       uint8_t *buf)
@@ -93,6 +96,69 @@ static int zperf_receiver_send_stat(const struct shell *sh,
 	return ret;
 }
 
+#if defined(CONFIG_NET_ZPERF_LATENCY_PERCENTILES)
+static void update_latency(struct session *session, int32_t transit_time)
+{
+	if (session->delay.count == 0U ||
+	    transit_time < session->min_transit_time) {
+		session->min_transit_time = transit_time;
+	}
+
+	zperf_histogram_add(&session->delay,
+			    transit_time - session->min_transit_time);
+
+	if (session->last_transit_time != 0) {
+		int32_t delta_transit = transit_time -
+			session->last_transit_time;
+
+		zperf_histogram_add(&session->ipdv, delta_transit < 0 ?
+				    -delta_transit : delta_transit);
+	}
+}
+
+static void print_histogram(const struct shell *sh, const char *name,
+			    const struct zperf_histogram *hist)
+{
+	shell_fprintf(sh, SHELL_NORMAL,
+		      " %s (us):\tp50 %u p90 %u p99 %u p99.9 %u max %u\n",
+		      name, zperf_histogram_percentile(hist, 500),
+		      zperf_histogram_percentile(hist, 900),
+		      zperf_histogram_percentile(hist, 990),
+		      zperf_histogram_percentile(hist, 999), hist->max);
+}
+
+static void print_histogram_json(const struct shell *sh, const char *name,
+				 const struct zperf_histogram *hist)
+{
+	shell_fprintf(sh, SHELL_NORMAL,
+		      ",\"%s\":{\"p50\":%u,\"p90\":%u,\"p99\":%u,"
+		      "\"p999\":%u,\"max\":%u}",
+		      name, zperf_histogram_percentile(hist, 500),
+		      zperf_histogram_percentile(hist, 900),
+		      zperf_histogram_percentile(hist, 990),
+		      zperf_histogram_percentile(hist, 999), hist->max);
+}
+#endif /* CONFIG_NET_ZPERF_LATENCY_PERCENTILES */
+
+static void print_session_json(const struct shell *sh,
+			       struct session *session, uint32_t duration,
+			       uint32_t rate_in_kbps)
+{
+	shell_fprintf(sh, SHELL_NORMAL,
+		      "{\"proto\":\"udp\",\"duration_us\":%u,"
+		      "\"packets\":%u,\"lost\":%u,\"outorder\":%u,"
+		      "\"jitter_us\":%d,\"rate_kbps\":%u",
+		      duration, session->counter, session->error,
+		      session->outorder, session->jitter, rate_in_kbps);
+
+#if defined(CONFIG_NET_ZPERF_LATENCY_PERCENTILES)
+	print_histogram_json(sh, "delay_us", &session->delay);
+	print_histogram_json(sh, "ipdv_us", &session->ipdv);
+#endif
+
+	shell_fprintf(sh, SHELL_NORMAL, "}\n");
+}
+
 static void udp_received(const struct shell *sh, int sock,
 			 const struct sockaddr *addr, uint8_t *data,
 			 size_t datalen)
@@ -210,6 +276,16 @@ static void udp_received(const struct shell *sh, int sock,
 				      " rate:\t\t\t");
 			print_number(sh, rate_in_kbps, KBPS, KBPS_UNIT);
 			shell_fprintf(sh, SHELL_NORMAL, "\n");
+
+#if defined(CONFIG_NET_ZPERF_LATENCY_PERCENTILES)
+			print_histogram(sh, "delay", &session->delay);
+			print_histogram(sh, "delay variation", &session->ipdv);
+#endif
+
+			if (json_output) {
+				print_session_json(sh, session, duration,
+						   rate_in_kbps);
+			}
 		} else {
 			/* Update counter */
 			session->counter++;
@@ -220,6 +296,11 @@ static void udp_received(const struct shell *sh, int sock,
 				k_ticks_to_us_ceil32(time),
 				ntohl(hdr->tv_sec) * USEC_PER_SEC +
 				ntohl(hdr->tv_usec));
+
+#if defined(CONFIG_NET_ZPERF_LATENCY_PERCENTILES)
+			update_latency(session, transit_time);
+#endif
+
 			if (session->last_transit_time != 0) {
 				int32_t delta_transit = transit_time -
 					session->last_transit_time;
@@ -252,6 +333,53 @@ static void udp_received(const struct shell *sh, int sock,
 	}
 }
 
+#if CONFIG_NET_ZPERF_UDP_BATCH > 1
+static uint8_t batch_bufs[CONFIG_NET_ZPERF_UDP_BATCH][UDP_RECEIVER_BUF_SIZE];
+static struct iovec batch_iov[CONFIG_NET_ZPERF_UDP_BATCH];
+static struct sockaddr batch_addrs[CONFIG_NET_ZPERF_UDP_BATCH];
+static struct zsock_mmsghdr batch_msgs[CONFIG_NET_ZPERF_UDP_BATCH];
+#endif
+
+static int receive_datagrams(const struct shell *sh, int sock, uint8_t *buf)
+{
+#if CONFIG_NET_ZPERF_UDP_BATCH > 1
+	int ret;
+
+	ARG_UNUSED(buf);
+
+	for (int i = 0; i < CONFIG_NET_ZPERF_UDP_BATCH; i++) {
+		batch_iov[i].iov_base = batch_bufs[i];
+		batch_iov[i].iov_len = sizeof(batch_bufs[i]);
+
+		batch_msgs[i].msg_hdr.msg_iov = &batch_iov[i];
+		batch_msgs[i].msg_hdr.msg_iovlen = 1;
+		batch_msgs[i].msg_hdr.msg_name = &batch_addrs[i];
+		batch_msgs[i].msg_hdr.msg_namelen = sizeof(batch_addrs[i]);
+	}
+
+	ret = zsock_recvmmsg(sock, batch_msgs, CONFIG_NET_ZPERF_UDP_BATCH, 0);
+
+	for (int i = 0; i < ret; i++) {
+		udp_received(sh, sock, &batch_addrs[i], batch_bufs[i],
+			     batch_msgs[i].msg_len);
+	}
+
+	return ret;
+#else
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	int ret;
+
+	ret = zsock_recvfrom(sock, buf, UDP_RECEIVER_BUF_SIZE, 0,
+			     &addr, &addrlen);
+	if (ret >= 0) {
+		udp_received(sh, sock, &addr, buf, ret);
+	}
+
+	return ret;
+#endif
+}
+
 void udp_receiver_thread(void *ptr1, void *ptr2, void *ptr3)
 {
 	ARG_UNUSED(ptr3);
@@ -388,9 +516,6 @@ void udp_receiver_thread(void *ptr1, void *ptr2, void *ptr3)
 		}
 
 		for (int i = 0; i < ARRAY_SIZE(fds); i++) {
-			struct sockaddr addr;
-			socklen_t addrlen = sizeof(addr);
-
 			if ((fds[i].revents & ZSOCK_POLLERR) ||
 			    (fds[i].revents & ZSOCK_POLLNVAL)) {
 				shell_fprintf(
@@ -404,8 +529,7 @@ void udp_receiver_thread(void *ptr1, void *ptr2, void *ptr3)
 				continue;
 			}
 
-			ret = zsock_recvfrom(fds[i].fd, buf, sizeof(buf), 0,
-					     &addr, &addrlen);
+			ret = receive_datagrams(sh, fds[i].fd, buf);
 			if (ret < 0) {
 				shell_fprintf(
 					sh, SHELL_WARNING,
@@ -413,8 +537,6 @@ void udp_receiver_thread(void *ptr1, void *ptr2, void *ptr3)
 					(i == SOCK_ID_IPV4) ? 4 : 6, errno);
 				goto cleanup;
 			}
-
-			udp_received(sh, fds[i].fd, &addr, buf, ret);
 		}
 	}
 
@@ -426,8 +548,11 @@ cleanup:
 	}
 }
 
-void zperf_udp_receiver_init(const struct shell *sh, int port)
+void zperf_udp_receiver_init(const struct shell *sh, int port, bool json)
 {
+	json_output = json;
+
+
 	k_thread_create(&udp_receiver_thread_data,
 			udp_receiver_stack_area,
 			K_THREAD_STACK_SIZEOF(udp_receiver_stack_area),
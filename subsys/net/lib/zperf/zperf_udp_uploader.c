@@ -14,9 +14,20 @@ LOG_MODULE_DECLARE(net_zperf, CONFIG_NET_ZPERF_LOG_LEVEL);
 #include "zperf.h"
 #include "zperf_internal.h"
 
-static uint8_t sample_packet[sizeof(struct zperf_udp_datagram) +
-			     sizeof(struct zperf_client_hdr_v1) +
-			     PACKET_SIZE_MAX];
+#define UDP_HDRS_LEN (sizeof(struct zperf_udp_datagram) + \
+		      sizeof(struct zperf_client_hdr_v1))
+
+/* Payload of the datagrams, shared by the streams. Only the part after
+ * the headers is sent.
+ */
+static uint8_t sample_packet[UDP_HDRS_LEN + PACKET_SIZE_MAX];
+
+/* Headers of the datagrams of each stream */
+static struct udp_stream {
+	uint8_t hdrs[CONFIG_NET_ZPERF_UDP_BATCH][UDP_HDRS_LEN];
+	struct iovec iov[CONFIG_NET_ZPERF_UDP_BATCH][2];
+	struct zsock_mmsghdr msgs[CONFIG_NET_ZPERF_UDP_BATCH];
+} streams[CONFIG_NET_ZPERF_MAX_STREAMS];
 
 static inline void zperf_upload_decode_stat(const struct shell *sh,
 					    const uint8_t *data,
@@ -45,7 +56,12 @@ static inline void zperf_upload_decode_stat(const struct shell *sh,
 		ntohl(UNALIGNED_GET(&stat->jitter1)) * USEC_PER_SEC;
 }
 
+static int send_datagrams(struct udp_stream *stream, int sock, int count,
+			  uint32_t id, uint32_t secs, uint32_t usecs, int port,
+			  unsigned int packet_size, unsigned int rate_in_kbps);
+
 static inline void zperf_upload_fin(const struct shell *sh,
+				    struct udp_stream *stream,
 				    int sock,
 				    uint32_t nb_packets,
 				    uint64_t end_time,
@@ -54,8 +70,6 @@ static inline void zperf_upload_fin(const struct shell *sh,
 {
 	uint8_t stats[sizeof(struct zperf_udp_datagram) +
 		      sizeof(struct zperf_server_hdr)] = { 0 };
-	struct zperf_udp_datagram *datagram;
-	struct zperf_client_hdr_v1 *hdr;
 	uint32_t secs = k_ticks_to_ms_ceil32(end_time) / 1000U;
 	uint32_t usecs = k_ticks_to_us_ceil32(end_time) - secs * USEC_PER_SEC;
 	int loop = 2;
@@ -66,31 +80,12 @@ static inline void zperf_upload_fin(const struct shell *sh,
 	};
 
 	while (ret <= 0 && loop-- > 0) {
-		datagram = (struct zperf_udp_datagram *)sample_packet;
-
-		/* Fill the packet header */
-		datagram->id = htonl(-nb_packets);
-		datagram->tv_sec = htonl(secs);
-		datagram->tv_usec = htonl(usecs);
-
-		hdr = (struct zperf_client_hdr_v1 *)(sample_packet +
-						     sizeof(*datagram));
-
-		/* According to iperf documentation (in include/Settings.hpp),
-		 * if the flags == 0, then the other values are ignored.
-		 * But even if the values in the header are ignored, try
-		 * to set there some meaningful values.
+		/* The negative id ends the session. According to iperf
+		 * documentation (in include/Settings.hpp), if the flags == 0,
+		 * then the other values of the header are ignored.
 		 */
-		hdr->flags = 0;
-		hdr->num_of_threads = htonl(1);
-		hdr->port = 0;
-		hdr->buffer_len = sizeof(sample_packet) -
-			sizeof(*datagram) - sizeof(*hdr);
-		hdr->bandwidth = 0;
-		hdr->num_of_bytes = htonl(packet_size);
-
-		/* Send the packet */
-		ret = zsock_send(sock, sample_packet, packet_size, 0);
+		ret = send_datagrams(stream, sock, 1, -nb_packets, secs, usecs,
+				     0, packet_size, 0);
 		if (ret < 0) {
 			shell_fprintf(sh, SHELL_WARNING,
 				      "Failed to send the packet (%d)\n",
@@ -136,7 +131,68 @@ static inline void zperf_upload_fin(const struct shell *sh,
 	}
 }
 
+static void fill_headers(uint8_t *buf, uint32_t id, uint32_t secs,
+			 uint32_t usecs, int port, unsigned int packet_size,
+			 unsigned int rate_in_kbps)
+{
+	struct zperf_udp_datagram *datagram;
+	struct zperf_client_hdr_v1 *hdr;
+
+	datagram = (struct zperf_udp_datagram *)buf;
+
+	datagram->id = htonl(id);
+	datagram->tv_sec = htonl(secs);
+	datagram->tv_usec = htonl(usecs);
+
+	hdr = (struct zperf_client_hdr_v1 *)(buf + sizeof(*datagram));
+	hdr->flags = 0;
+	hdr->num_of_threads = htonl(1);
+	hdr->port = htonl(port);
+	hdr->buffer_len = sizeof(sample_packet) -
+		sizeof(*datagram) - sizeof(*hdr);
+	hdr->bandwidth = htonl(rate_in_kbps);
+	hdr->num_of_bytes = htonl(packet_size);
+}
+
+/* Send count datagrams, their headers being built in the buffers of the
+ * stream. Returns the number of datagrams sent.
+ */
+static int send_datagrams(struct udp_stream *stream, int sock, int count,
+			  uint32_t id, uint32_t secs, uint32_t usecs, int port,
+			  unsigned int packet_size, unsigned int rate_in_kbps)
+{
+	size_t hdrs_len = MIN(UDP_HDRS_LEN, packet_size);
+	int ret;
+
+	for (int i = 0; i < count; i++) {
+		fill_headers(stream->hdrs[i], id + i, secs, usecs, port,
+			     packet_size, rate_in_kbps);
+
+		stream->iov[i][0].iov_base = stream->hdrs[i];
+		stream->iov[i][0].iov_len = hdrs_len;
+		stream->iov[i][1].iov_base = sample_packet + hdrs_len;
+		stream->iov[i][1].iov_len = packet_size - hdrs_len;
+
+		stream->msgs[i].msg_hdr.msg_iov = stream->iov[i];
+		stream->msgs[i].msg_hdr.msg_iovlen = ARRAY_SIZE(stream->iov[i]);
+	}
+
+	if (count > 1) {
+		return zsock_sendmmsg(sock, stream->msgs, count, 0);
+	}
+
+	ret = zsock_sendmsg(sock, &stream->msgs[0].msg_hdr, 0);
+
+	return ret < 0 ? ret : 1;
+}
+
+void zperf_udp_uploader_init(void)
+{
+	(void)memset(sample_packet, 'z', sizeof(sample_packet));
+}
+
 void zperf_udp_upload(const struct shell *sh,
+		      int stream_id,
 		      int sock,
 		      int port,
 		      unsigned int duration_in_ms,
@@ -144,7 +200,9 @@ void zperf_udp_upload(const struct shell *sh,
 		      unsigned int rate_in_kbps,
 		      struct zperf_results *results)
 {
-	uint32_t packet_duration = ((uint64_t)packet_size * 8U * USEC_PER_SEC) /
+	/* Time to send one batch of datagrams */
+	uint32_t packet_duration = ((uint64_t)packet_size * 8U * USEC_PER_SEC *
+				    CONFIG_NET_ZPERF_UDP_BATCH) /
 				   (rate_in_kbps * 1024U);
 	uint64_t duration = sys_clock_timeout_end_calc(K_MSEC(duration_in_ms));
 	int64_t print_interval = sys_clock_timeout_end_calc(K_SECONDS(1));
@@ -153,6 +211,7 @@ void zperf_udp_upload(const struct shell *sh,
 	int64_t start_time, end_time;
 	int64_t last_print_time, last_loop_time;
 	int64_t remaining, print_info;
+	struct udp_stream *stream = &streams[stream_id];
 
 	if (packet_size > PACKET_SIZE_MAX) {
 		shell_fprintf(sh, SHELL_WARNING,
@@ -181,11 +240,7 @@ void zperf_udp_upload(const struct shell *sh,
 	last_print_time = start_time;
 	last_loop_time = start_time;
 
-	(void)memset(sample_packet, 'z', sizeof(sample_packet));
-
 	do {
-		struct zperf_udp_datagram *datagram;
-		struct zperf_client_hdr_v1 *hdr;
 		uint32_t secs, usecs;
 		int64_t loop_time;
 		int32_t adjust;
@@ -218,32 +273,17 @@ void zperf_udp_upload(const struct shell *sh,
 		secs = k_ticks_to_ms_ceil32(loop_time) / 1000U;
 		usecs = k_ticks_to_us_ceil32(loop_time) - secs * USEC_PER_SEC;
 
-		/* Fill the packet header */
-		datagram = (struct zperf_udp_datagram *)sample_packet;
-
-		datagram->id = htonl(nb_packets);
-		datagram->tv_sec = htonl(secs);
-		datagram->tv_usec = htonl(usecs);
-
-		hdr = (struct zperf_client_hdr_v1 *)(sample_packet +
-						     sizeof(*datagram));
-		hdr->flags = 0;
-		hdr->num_of_threads = htonl(1);
-		hdr->port = htonl(port);
-		hdr->buffer_len = sizeof(sample_packet) -
-			sizeof(*datagram) - sizeof(*hdr);
-		hdr->bandwidth = htonl(rate_in_kbps);
-		hdr->num_of_bytes = htonl(packet_size);
-
-		/* Send the packet */
-		ret = zsock_send(sock, sample_packet, packet_size, 0);
+		/* Send the packets */
+		ret = send_datagrams(stream, sock, CONFIG_NET_ZPERF_UDP_BATCH,
+				     nb_packets, secs, usecs, port,
+				     packet_size, rate_in_kbps);
 		if (ret < 0) {
 			shell_fprintf(sh, SHELL_WARNING,
 				      "Failed to send the packet (%d)\n",
 				      errno);
 			break;
 		} else {
-			nb_packets++;
+			nb_packets += ret;
 		}
 
 		/* Print log every seconds */
@@ -274,7 +314,7 @@ void zperf_udp_upload(const struct shell *sh,
 
 	end_time = k_uptime_ticks();
 
-	zperf_upload_fin(sh, sock, nb_packets, end_time, packet_size,
+	zperf_upload_fin(sh, stream, sock, nb_packets, end_time, packet_size,
 			 results);
 
 	/* Add result coming from the client */
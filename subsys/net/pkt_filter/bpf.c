@@ -0,0 +1,414 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(npf_bpf, CONFIG_NET_PKT_FILTER_LOG_LEVEL);
+
+#include <errno.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/net_pkt_filter.h>
+
+/* Data a program runs on, either a network packet or a flat buffer */
+struct bpf_input {
+	struct net_buf *buf;
+	const uint8_t *data;
+	size_t len;
+};
+
+static bool bpf_load(const struct bpf_input *in, uint32_t off, size_t size,
+		     uint32_t *val)
+{
+	const struct net_buf *buf = in->buf;
+	uint8_t bytes[sizeof(uint32_t)];
+	const uint8_t *p;
+
+	if (off >= in->len || size > in->len - off) {
+		return false;
+	}
+
+	if (in->data) {
+		p = in->data + off;
+	} else {
+		/* Skip the fragments before the data */
+		while (off >= buf->len) {
+			off -= buf->len;
+			buf = buf->frags;
+		}
+
+		if (off + size <= buf->len) {
+			p = buf->data + off;
+		} else {
+			/* The value spans fragments */
+			for (size_t i = 0; i < size; i++) {
+				while (off >= buf->len) {
+					off -= buf->len;
+					buf = buf->frags;
+				}
+
+				bytes[i] = buf->data[off++];
+			}
+
+			p = bytes;
+		}
+	}
+
+	switch (size) {
+	case sizeof(uint32_t):
+		*val = ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+		       ((uint32_t)p[2] << 8) | p[3];
+		break;
+	case sizeof(uint16_t):
+		*val = ((uint32_t)p[0] << 8) | p[1];
+		break;
+	default:
+		*val = p[0];
+		break;
+	}
+
+	return true;
+}
+
+static size_t bpf_size(uint16_t code)
+{
+	switch (BPF_SIZE(code)) {
+	case BPF_W:
+		return sizeof(uint32_t);
+	case BPF_H:
+		return sizeof(uint16_t);
+	default:
+		return sizeof(uint8_t);
+	}
+}
+
+static uint32_t bpf_run(const struct sock_filter *prog,
+			const struct bpf_input *in)
+{
+	uint32_t mem[BPF_MEMWORDS] = { 0 };
+	const struct sock_filter *insn;
+	uint32_t a = 0U;
+	uint32_t x = 0U;
+	uint32_t val;
+
+	/* The program was checked, so it cannot jump backward nor out of
+	 * range and always ends with a return instruction.
+	 */
+	for (insn = prog; ; insn++) {
+		uint32_t k = insn->k;
+
+		switch (BPF_CLASS(insn->code)) {
+		case BPF_LD:
+			switch (BPF_MODE(insn->code)) {
+			case BPF_IMM:
+				a = k;
+				break;
+			case BPF_ABS:
+			case BPF_IND:
+				if (BPF_MODE(insn->code) == BPF_IND) {
+					if (k > UINT32_MAX - x) {
+						return 0U;
+					}
+
+					k += x;
+				}
+
+				if (!bpf_load(in, k, bpf_size(insn->code), &a)) {
+					return 0U;
+				}
+				break;
+			case BPF_MEM:
+				a = mem[k];
+				break;
+			default: /* BPF_LEN */
+				a = in->len;
+				break;
+			}
+			break;
+
+		case BPF_LDX:
+			switch (BPF_MODE(insn->code)) {
+			case BPF_IMM:
+				x = k;
+				break;
+			case BPF_MEM:
+				x = mem[k];
+				break;
+			case BPF_LEN:
+				x = in->len;
+				break;
+			default: /* BPF_MSH, header length of an IPv4 packet */
+				if (!bpf_load(in, k, sizeof(uint8_t), &val)) {
+					return 0U;
+				}
+
+				x = (val & 0xf) << 2;
+				break;
+			}
+			break;
+
+		case BPF_ST:
+			mem[k] = a;
+			break;
+
+		case BPF_STX:
+			mem[k] = x;
+			break;
+
+		case BPF_ALU:
+			val = BPF_SRC(insn->code) == BPF_X ? x : k;
+
+			switch (BPF_OP(insn->code)) {
+			case BPF_ADD:
+				a += val;
+				break;
+			case BPF_SUB:
+				a -= val;
+				break;
+			case BPF_MUL:
+				a *= val;
+				break;
+			case BPF_DIV:
+				if (val == 0U) {
+					return 0U;
+				}
+
+				a /= val;
+				break;
+			case BPF_MOD:
+				if (val == 0U) {
+					return 0U;
+				}
+
+				a %= val;
+				break;
+			case BPF_OR:
+				a |= val;
+				break;
+			case BPF_AND:
+				a &= val;
+				break;
+			case BPF_XOR:
+				a ^= val;
+				break;
+			case BPF_LSH:
+				a = val < 32U ? a << val : 0U;
+				break;
+			case BPF_RSH:
+				a = val < 32U ? a >> val : 0U;
+				break;
+			default: /* BPF_NEG */
+				a = -a;
+				break;
+			}
+			break;
+
+		case BPF_JMP:
+			val = BPF_SRC(insn->code) == BPF_X ? x : k;
+
+			switch (BPF_OP(insn->code)) {
+			case BPF_JA:
+				insn += k;
+				break;
+			case BPF_JEQ:
+				insn += (a == val) ? insn->jt : insn->jf;
+				break;
+			case BPF_JGT:
+				insn += (a > val) ? insn->jt : insn->jf;
+				break;
+			case BPF_JGE:
+				insn += (a >= val) ? insn->jt : insn->jf;
+				break;
+			default: /* BPF_JSET */
+				insn += (a & val) ? insn->jt : insn->jf;
+				break;
+			}
+			break;
+
+		case BPF_RET:
+			switch (BPF_RVAL(insn->code)) {
+			case BPF_A:
+				return a;
+			case BPF_X:
+				return x;
+			default:
+				return k;
+			}
+
+		default: /* BPF_MISC */
+			if (BPF_MISCOP(insn->code) == BPF_TAX) {
+				x = a;
+			} else {
+				a = x;
+			}
+			break;
+		}
+	}
+}
+
+static bool bpf_code_valid(uint16_t code, uint32_t k)
+{
+	if (code > UINT8_MAX) {
+		return false;
+	}
+
+	switch (BPF_CLASS(code)) {
+	case BPF_LD:
+		switch (BPF_MODE(code)) {
+		case BPF_IMM:
+		case BPF_LEN:
+			return code == (BPF_LD | BPF_W | BPF_MODE(code));
+		case BPF_ABS:
+		case BPF_IND:
+			return BPF_SIZE(code) != (BPF_H | BPF_B);
+		case BPF_MEM:
+			return code == (BPF_LD | BPF_W | BPF_MEM) &&
+			       k < BPF_MEMWORDS;
+		default:
+			return false;
+		}
+
+	case BPF_LDX:
+		switch (code) {
+		case BPF_LDX | BPF_W | BPF_IMM:
+		case BPF_LDX | BPF_W | BPF_LEN:
+		case BPF_LDX | BPF_B | BPF_MSH:
+			return true;
+		case BPF_LDX | BPF_W | BPF_MEM:
+			return k < BPF_MEMWORDS;
+		default:
+			return false;
+		}
+
+	case BPF_ST:
+	case BPF_STX:
+		return code == BPF_CLASS(code) && k < BPF_MEMWORDS;
+
+	case BPF_ALU:
+		switch (BPF_OP(code)) {
+		case BPF_NEG:
+			return BPF_SRC(code) == BPF_K;
+		case BPF_DIV:
+		case BPF_MOD:
+			/* Division by a constant 0 is rejected upfront */
+			return BPF_SRC(code) == BPF_X || k != 0U;
+		case BPF_ADD:
+		case BPF_SUB:
+		case BPF_MUL:
+		case BPF_OR:
+		case BPF_AND:
+		case BPF_XOR:
+		case BPF_LSH:
+		case BPF_RSH:
+			return true;
+		default:
+			return false;
+		}
+
+	case BPF_JMP:
+		switch (BPF_OP(code)) {
+		case BPF_JA:
+			return code == (BPF_JMP | BPF_JA);
+		case BPF_JEQ:
+		case BPF_JGT:
+		case BPF_JGE:
+		case BPF_JSET:
+			return true;
+		default:
+			return false;
+		}
+
+	case BPF_RET:
+		return code == (BPF_RET | BPF_K) || code == (BPF_RET | BPF_X) ||
+		       code == (BPF_RET | BPF_A);
+
+	default: /* BPF_MISC */
+		return code == (BPF_MISC | BPF_TAX) ||
+		       code == (BPF_MISC | BPF_TXA);
+	}
+}
+
+int npf_bpf_check(const struct sock_filter *prog, uint16_t len)
+{
+	uint16_t pc;
+
+	if (!prog || len == 0U || len > BPF_MAXINSNS) {
+		return -EINVAL;
+	}
+
+	for (pc = 0U; pc < len; pc++) {
+		const struct sock_filter *insn = &prog[pc];
+		uint32_t left = len - pc - 1U;
+
+		if (!bpf_code_valid(insn->code, insn->k)) {
+			NET_DBG("Invalid instruction 0x%04x at %u",
+				insn->code, pc);
+			return -EINVAL;
+		}
+
+		/* Only forward jumps within the program are allowed, which
+		 * guarantees that the program ends.
+		 */
+		if (BPF_CLASS(insn->code) == BPF_JMP) {
+			if (BPF_OP(insn->code) == BPF_JA ?
+			    insn->k >= left :
+			    (insn->jt >= left || insn->jf >= left)) {
+				NET_DBG("Jump out of range at %u", pc);
+				return -EINVAL;
+			}
+		}
+	}
+
+	if (BPF_CLASS(prog[len - 1U].code) != BPF_RET) {
+		NET_DBG("Program does not end with a return");
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+uint32_t npf_bpf_run(const struct sock_filter *prog, struct net_pkt *pkt)
+{
+	struct bpf_input in = {
+		.buf = pkt->buffer,
+		.len = net_pkt_get_len(pkt),
+	};
+
+	return bpf_run(prog, &in);
+}
+
+uint32_t npf_bpf_run_buf(const struct sock_filter *prog, const uint8_t *data,
+			 size_t len)
+{
+	struct bpf_input in = {
+		.data = data,
+		.len = len,
+	};
+
+	return bpf_run(prog, &in);
+}
+
+bool npf_bpf_match(struct npf_test *test, struct net_pkt *pkt)
+{
+	struct npf_test_bpf *test_bpf =
+			CONTAINER_OF(test, struct npf_test_bpf, test);
+
+	if (!test_bpf->checked) {
+		test_bpf->valid = npf_bpf_check(test_bpf->prog,
+						test_bpf->len) == 0;
+		test_bpf->checked = true;
+	}
+
+	if (!test_bpf->valid) {
+		NET_DBG("Invalid program %p never matches", test_bpf->prog);
+		return false;
+	}
+
+	return npf_bpf_run(test_bpf->prog, pkt) != 0U;
+}
+
+bool npf_bpf_unmatch(struct npf_test *test, struct net_pkt *pkt)
+{
+	return !npf_bpf_match(test, pkt);
+}
@@ -7,6 +7,7 @@
 
 #include <zephyr/pm/device.h>
 #include <zephyr/pm/device_runtime.h>
+#include <zephyr/pm/policy.h>
 #include <zephyr/sys/__assert.h>
 
 #include <zephyr/logging/log.h>
@@ -19,6 +20,204 @@ LOG_MODULE_DECLARE(pm_device, CONFIG_PM_DEVICE_LOG_LEVEL);
 #define PM_DOMAIN(_pm) NULL
 #endif
 
+#if CONFIG_PM_DEVICE_RUNTIME_WORKQ_COUNT > 0
+static struct k_work_q runtime_wqs[CONFIG_PM_DEVICE_RUNTIME_WORKQ_COUNT];
+static K_THREAD_STACK_ARRAY_DEFINE(runtime_wq_stacks,
+				   CONFIG_PM_DEVICE_RUNTIME_WORKQ_COUNT,
+				   CONFIG_PM_DEVICE_RUNTIME_WORKQ_STACK_SIZE);
+
+static int runtime_wq_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	for (size_t i = 0; i < ARRAY_SIZE(runtime_wqs); i++) {
+		k_work_queue_start(&runtime_wqs[i], runtime_wq_stacks[i],
+				   K_THREAD_STACK_SIZEOF(runtime_wq_stacks[i]),
+				   CONFIG_PM_DEVICE_RUNTIME_WORKQ_PRIORITY, NULL);
+	}
+
+	return 0;
+}
+
+SYS_INIT(runtime_wq_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+#endif /* CONFIG_PM_DEVICE_RUNTIME_WORKQ_COUNT > 0 */
+
+/**
+ * @brief Get the work queue running the asynchronous operations of a device
+ *
+ * Consecutive devices use different queues, so that they can be suspended or
+ * resumed in parallel.
+ */
+static struct k_work_q *runtime_wq(struct pm_device *pm)
+{
+#if CONFIG_PM_DEVICE_RUNTIME_WORKQ_COUNT > 0
+	return &runtime_wqs[device_handle_get(pm->dev) % ARRAY_SIZE(runtime_wqs)];
+#else
+	ARG_UNUSED(pm);
+
+	return &k_sys_work_q;
+#endif
+}
+
+/** @brief Check if an asynchronous resume is ongoing. */
+static inline bool runtime_resuming(struct pm_device *pm)
+{
+#ifdef CONFIG_PM_DEVICE_RUNTIME_ASYNC
+	return !sys_slist_is_empty(&pm->resume_cbs);
+#else
+	ARG_UNUSED(pm);
+
+	return false;
+#endif
+}
+
+/**
+ * @brief Update the CPU latency request of a device
+ *
+ * Must be called with the device lock held.
+ *
+ * @param pm Device PM info.
+ * @param active Whether the device is active.
+ */
+static void runtime_latency_update(struct pm_device *pm, bool active)
+{
+	active = active && (pm->latency_us != SYS_FOREVER_US);
+
+	if (active && !pm->latency_req_active) {
+		pm_policy_latency_request_add(&pm->latency_req, pm->latency_us);
+	} else if (active) {
+		pm_policy_latency_request_update(&pm->latency_req, pm->latency_us);
+	} else if (pm->latency_req_active) {
+		pm_policy_latency_request_remove(&pm->latency_req);
+	}
+
+	pm->latency_req_active = active;
+}
+
+/**
+ * @brief Cancel an asynchronous suspend that did not start yet
+ *
+ * Must be called with the device lock held.
+ *
+ * @param pm Device PM info.
+ *
+ * @retval true If the suspend was cancelled, the device is left active.
+ * @retval false If there was no suspend to cancel.
+ */
+static bool runtime_suspend_cancel(struct pm_device *pm)
+{
+	if ((pm->state != PM_DEVICE_STATE_SUSPENDING) ||
+	    (k_work_cancel_delayable(&pm->work) != 0)) {
+		return false;
+	}
+
+	pm->state = PM_DEVICE_STATE_ACTIVE;
+
+	/* the domain would have been put once suspended */
+	if (PM_DOMAIN(pm) != NULL) {
+		(void)pm_device_runtime_put(PM_DOMAIN(pm));
+	}
+
+	return true;
+}
+
+#ifdef CONFIG_PM_DEVICE_RUNTIME_ASYNC
+/**
+ * @brief Complete an asynchronous resume
+ *
+ * @param pm Device PM info.
+ * @param ret Result of the resume.
+ * @param domain_refs Number of references to the domain taken while resuming.
+ */
+static void runtime_resume_done(struct pm_device *pm, int ret, size_t domain_refs)
+{
+	struct pm_device_runtime_cb *cb, *tmp;
+	sys_slist_t cbs;
+	size_t waiters;
+
+	(void)k_mutex_lock(&pm->lock, K_FOREVER);
+
+	cbs = pm->resume_cbs;
+	sys_slist_init(&pm->resume_cbs);
+	waiters = sys_slist_len(&cbs);
+
+	if (ret < 0) {
+		pm->usage -= waiters;
+		waiters = 0U;
+	} else {
+		pm->state = PM_DEVICE_STATE_ACTIVE;
+		runtime_latency_update(pm, true);
+	}
+
+	/* each user of the device holds a reference to the domain */
+	if (PM_DOMAIN(pm) != NULL) {
+		for (; domain_refs > waiters; domain_refs--) {
+			(void)pm_device_runtime_put(PM_DOMAIN(pm));
+		}
+		for (; domain_refs < waiters; domain_refs++) {
+			(void)pm_device_runtime_get(PM_DOMAIN(pm));
+		}
+	}
+
+	k_condvar_broadcast(&pm->condvar);
+	k_mutex_unlock(&pm->lock);
+
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&cbs, cb, tmp, node) {
+		cb->handler(pm->dev, cb, ret);
+	}
+}
+
+static void runtime_resume_work(struct k_work *work)
+{
+	struct pm_device *pm = CONTAINER_OF(work, struct pm_device, resume_work);
+	int ret;
+
+	ret = pm->action_cb(pm->dev, PM_DEVICE_ACTION_RESUME);
+
+	runtime_resume_done(pm, ret, (PM_DOMAIN(pm) != NULL) ? 1U : 0U);
+}
+
+static void runtime_domain_resumed(const struct device *domain,
+				   struct pm_device_runtime_cb *cb, int result)
+{
+	struct pm_device *pm = CONTAINER_OF(cb, struct pm_device, domain_cb);
+
+	/* Check if powering up this device failed */
+	if ((result == 0) &&
+	    atomic_test_bit(&pm->flags, PM_DEVICE_FLAG_TURN_ON_FAILED)) {
+		(void)pm_device_runtime_put(domain);
+		result = -EAGAIN;
+	}
+
+	if (result < 0) {
+		runtime_resume_done(pm, result, 0U);
+		return;
+	}
+
+	(void)k_work_submit_to_queue(runtime_wq(pm), &pm->resume_work);
+}
+
+/**
+ * @brief Start an asynchronous resume, once the device is suspended
+ *
+ * The domain is resumed first, without blocking, then the device.
+ */
+static void runtime_resume_start(struct pm_device *pm)
+{
+	int ret;
+
+	if (PM_DOMAIN(pm) == NULL) {
+		(void)k_work_submit_to_queue(runtime_wq(pm), &pm->resume_work);
+		return;
+	}
+
+	ret = pm_device_runtime_get_async(PM_DOMAIN(pm), &pm->domain_cb);
+	if (ret < 0) {
+		runtime_resume_done(pm, ret, 0U);
+	}
+}
+#endif /* CONFIG_PM_DEVICE_RUNTIME_ASYNC */
+
 /**
  * @brief Suspend a device
  *
@@ -65,7 +264,8 @@ static int runtime_suspend(const struct device *dev, bool async)
 	if (async && !k_is_pre_kernel()) {
 		/* queue suspend */
 		pm->state = PM_DEVICE_STATE_SUSPENDING;
-		(void)k_work_schedule(&pm->work, K_NO_WAIT);
+		(void)k_work_schedule_for_queue(runtime_wq(pm), &pm->work,
+						K_MSEC(CONFIG_PM_DEVICE_RUNTIME_SUSPEND_DELAY));
 	} else {
 		/* suspend now */
 		ret = pm->action_cb(pm->dev, PM_DEVICE_ACTION_SUSPEND);
@@ -75,6 +275,7 @@ static int runtime_suspend(const struct device *dev, bool async)
 		}
 
 		pm->state = PM_DEVICE_STATE_SUSPENDED;
+		runtime_latency_update(pm, false);
 	}
 
 unlock:
@@ -88,6 +289,7 @@ unlock:
 static void runtime_suspend_work(struct k_work *work)
 {
 	int ret;
+	bool resume;
 	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
 	struct pm_device *pm = CONTAINER_OF(dwork, struct pm_device, work);
 
@@ -99,7 +301,10 @@ static void runtime_suspend_work(struct k_work *work)
 		pm->state = PM_DEVICE_STATE_ACTIVE;
 	} else {
 		pm->state = PM_DEVICE_STATE_SUSPENDED;
+		runtime_latency_update(pm, false);
 	}
+	/* asynchronous resume requested while suspending */
+	resume = runtime_resuming(pm);
 	k_condvar_broadcast(&pm->condvar);
 	k_mutex_unlock(&pm->lock);
 
@@ -111,6 +316,19 @@ static void runtime_suspend_work(struct k_work *work)
 		(void)pm_device_runtime_put(PM_DOMAIN(pm));
 	}
 
+#ifdef CONFIG_PM_DEVICE_RUNTIME_ASYNC
+	if (resume) {
+		if (ret < 0) {
+			/* device was left active */
+			runtime_resume_done(pm, 0, 0U);
+		} else {
+			runtime_resume_start(pm);
+		}
+	}
+#else
+	ARG_UNUSED(resume);
+#endif
+
 	__ASSERT(ret == 0, "Could not suspend device (%d)", ret);
 }
 
@@ -150,16 +368,18 @@ int pm_device_runtime_get(const struct device *dev)
 		}
 	}
 
-	pm->usage++;
-
 	if (!k_is_pre_kernel()) {
-		/* wait until possible async suspend is completed */
-		while (pm->state == PM_DEVICE_STATE_SUSPENDING) {
+		(void)runtime_suspend_cancel(pm);
+
+		/* wait until possible async suspend or resume is completed */
+		while ((pm->state == PM_DEVICE_STATE_SUSPENDING) || runtime_resuming(pm)) {
 			(void)k_condvar_wait(&pm->condvar, &pm->lock, K_FOREVER);
 		}
 	}
 
-	if (pm->usage > 1U) {
+	pm->usage++;
+
+	if ((pm->usage > 1U) || (pm->state == PM_DEVICE_STATE_ACTIVE)) {
 		goto unlock;
 	}
 
@@ -170,6 +390,7 @@ int pm_device_runtime_get(const struct device *dev)
 	}
 
 	pm->state = PM_DEVICE_STATE_ACTIVE;
+	runtime_latency_update(pm, true);
 
 unlock:
 	if (!k_is_pre_kernel()) {
@@ -181,6 +402,71 @@ unlock:
 	return ret;
 }
 
+#ifdef CONFIG_PM_DEVICE_RUNTIME_ASYNC
+int pm_device_runtime_get_async(const struct device *dev,
+				struct pm_device_runtime_cb *cb)
+{
+	int ret = 0;
+	bool start = false;
+	struct pm_device *pm = dev->pm;
+
+	if (pm == NULL) {
+		return -ENOTSUP;
+	}
+
+	SYS_PORT_TRACING_FUNC_ENTER(pm, device_runtime_get, dev);
+
+	/* no work queue yet, resume synchronously */
+	if (k_is_pre_kernel()) {
+		ret = pm_device_runtime_get(dev);
+		cb->handler(dev, cb, ret);
+		goto end;
+	}
+
+	(void)k_mutex_lock(&pm->lock, K_FOREVER);
+
+	if (!atomic_test_bit(&pm->flags, PM_DEVICE_FLAG_RUNTIME_ENABLED)) {
+		k_mutex_unlock(&pm->lock);
+		cb->handler(dev, cb, 0);
+		goto end;
+	}
+
+	(void)runtime_suspend_cancel(pm);
+
+	if ((pm->state == PM_DEVICE_STATE_ACTIVE) && !runtime_resuming(pm)) {
+		/* the domain is active as well, this does not block */
+		if (PM_DOMAIN(pm) != NULL) {
+			ret = pm_device_runtime_get(PM_DOMAIN(pm));
+		}
+		if (ret == 0) {
+			pm->usage++;
+		}
+		k_mutex_unlock(&pm->lock);
+		cb->handler(dev, cb, ret);
+		goto end;
+	}
+
+	/*
+	 * Resume now if suspended, once the ongoing suspend is completed
+	 * otherwise. Requests made in the meantime wait for the same resume.
+	 */
+	start = (pm->state == PM_DEVICE_STATE_SUSPENDED) && !runtime_resuming(pm);
+	pm->usage++;
+	sys_slist_append(&pm->resume_cbs, &cb->node);
+
+	k_mutex_unlock(&pm->lock);
+
+	if (start) {
+		runtime_resume_start(pm);
+	}
+
+end:
+	SYS_PORT_TRACING_FUNC_EXIT(pm, device_runtime_get, dev, ret);
+
+	return 0;
+}
+#endif /* CONFIG_PM_DEVICE_RUNTIME_ASYNC */
+
 int pm_device_runtime_put(const struct device *dev)
 {
 	int ret;
@@ -246,6 +532,10 @@ int pm_device_runtime_enable(const struct device *dev)
 	if (pm->dev == NULL) {
 		pm->dev = dev;
 		k_work_init_delayable(&pm->work, runtime_suspend_work);
+#ifdef CONFIG_PM_DEVICE_RUNTIME_ASYNC
+		k_work_init(&pm->resume_work, runtime_resume_work);
+		pm->domain_cb.handler = runtime_domain_resumed;
+#endif
 	}
 
 	if (pm->state == PM_DEVICE_STATE_ACTIVE) {
@@ -289,9 +579,11 @@ int pm_device_runtime_disable(const struct device *dev)
 		goto unlock;
 	}
 
-	/* wait until possible async suspend is completed */
+	/* wait until possible async suspend or resume is completed */
 	if (!k_is_pre_kernel()) {
-		while (pm->state == PM_DEVICE_STATE_SUSPENDING) {
+		(void)runtime_suspend_cancel(pm);
+
+		while ((pm->state == PM_DEVICE_STATE_SUSPENDING) || runtime_resuming(pm)) {
 			(void)k_condvar_wait(&pm->condvar, &pm->lock,
 					     K_FOREVER);
 		}
@@ -307,6 +599,7 @@ int pm_device_runtime_disable(const struct device *dev)
 		pm->state = PM_DEVICE_STATE_ACTIVE;
 	}
 
+	runtime_latency_update(pm, false);
 	atomic_clear_bit(&pm->flags, PM_DEVICE_FLAG_RUNTIME_ENABLED);
 
 unlock:
@@ -325,3 +618,26 @@ bool pm_device_runtime_is_enabled(const struct device *dev)
 
 	return pm && atomic_test_bit(&pm->flags, PM_DEVICE_FLAG_RUNTIME_ENABLED);
 }
+
+int pm_device_runtime_latency_set(const struct device *dev, int32_t latency_us)
+{
+	struct pm_device *pm = dev->pm;
+
+	if (pm == NULL) {
+		return -ENOTSUP;
+	}
+
+	if (!k_is_pre_kernel()) {
+		(void)k_mutex_lock(&pm->lock, K_FOREVER);
+	}
+
+	pm->latency_us = latency_us;
+	runtime_latency_update(pm, atomic_test_bit(&pm->flags, PM_DEVICE_FLAG_RUNTIME_ENABLED) &&
+				   (pm->usage > 0U));
+
+	if (!k_is_pre_kernel()) {
+		k_mutex_unlock(&pm->lock);
+	}
+
+	return 0;
+}
@@ -205,6 +205,10 @@ bool pm_system_suspend(int32_t ticks)
 {
 	uint8_t id = CURRENT_CPU;
 	k_spinlock_key_t key;
+#ifdef CONFIG_PM_POLICY_DEFAULT_PREDICT
+	bool forced = false;
+	int64_t idle_start;
+#endif
 
 	SYS_PORT_TRACING_FUNC_ENTER(pm, system_suspend, ticks);
 
@@ -212,6 +216,9 @@ bool pm_system_suspend(int32_t ticks)
 	if (z_cpus_pm_forced_state[id].state != PM_STATE_ACTIVE) {
 		z_cpus_pm_state[id] = z_cpus_pm_forced_state[id];
 		z_cpus_pm_forced_state[id].state = PM_STATE_ACTIVE;
+#ifdef CONFIG_PM_POLICY_DEFAULT_PREDICT
+		forced = true;
+#endif
 	} else {
 		const struct pm_state_info *info;
 
@@ -267,8 +274,19 @@ bool pm_system_suspend(int32_t ticks)
 	/* Enter power state */
 	pm_state_notify(true);
 	atomic_set_bit(z_post_ops_required, id);
+#ifdef CONFIG_PM_POLICY_DEFAULT_PREDICT
+	idle_start = k_uptime_ticks();
+#endif
 	state_set(&z_cpus_pm_state[id]);
 	pm_stats_stop();
+#ifdef CONFIG_PM_POLICY_DEFAULT_PREDICT
+	/* Only states selected by the policy are used for prediction */
+	if (!forced) {
+		bool hit = pm_policy_idle_update(id, k_uptime_ticks() - idle_start);
+
+		pm_stats_predict_update(z_cpus_pm_state[id].state, hit);
+	}
+#endif
 
 	/* Wake up sequence starts here */
 #if defined(CONFIG_PM_DEVICE) && !defined(CONFIG_PM_DEVICE_RUNTIME_EXCLUSIVE)
@@ -16,12 +16,16 @@ STATS_SECT_START(pm_stats)
 STATS_SECT_ENTRY32(state_count)
 STATS_SECT_ENTRY32(state_last_cycles)
 STATS_SECT_ENTRY32(state_total_cycles)
+STATS_SECT_ENTRY32(state_predict_hits)
+STATS_SECT_ENTRY32(state_predict_misses)
 STATS_SECT_END;
 
 STATS_NAME_START(pm_stats)
 STATS_NAME(pm_stats, state_count)
 STATS_NAME(pm_stats, state_last_cycles)
 STATS_NAME(pm_stats, state_total_cycles)
+STATS_NAME(pm_stats, state_predict_hits)
+STATS_NAME(pm_stats, state_predict_misses)
 STATS_NAME_END(pm_stats);
 
 static STATS_SECT_DECL(pm_stats) stats[CONFIG_MP_NUM_CPUS][PM_STATE_COUNT];
@@ -39,7 +43,7 @@ static int pm_stats_init(const struct device *dev)
 		for (uint8_t j = 0U; j < PM_STATE_COUNT; j++) {
 			snprintk(names[i][j], PM_STAT_NAME_LEN,
 				 "pm_cpu_%03d_state_%1d_stats", i, j);
-			stats_init(&(stats[i][j].s_hdr), STATS_SIZE_32, 3U,
+			stats_init(&(stats[i][j].s_hdr), STATS_SIZE_32, 5U,
 				   STATS_NAME_INIT_PARMS(pm_stats));
 			stats_register(names[i][j], &(stats[i][j].s_hdr));
 		}
@@ -69,3 +73,14 @@ void pm_stats_update(enum pm_state state)
 	STATS_INCN(stats[cpu][state], state_total_cycles, time_total);
 	STATS_SET(stats[cpu][state], state_last_cycles, time_total);
 }
+
+void pm_stats_predict_update(enum pm_state state, bool hit)
+{
+	uint8_t cpu = _current_cpu->id;
+
+	if (hit) {
+		STATS_INC(stats[cpu][state], state_predict_hits);
+	} else {
+		STATS_INC(stats[cpu][state], state_predict_misses);
+	}
+}
@@ -8,16 +8,20 @@
 #ifndef ZEPHYR_SUBSYS_PM_PM_STATS_H_
 #define ZEPHYR_SUBSYS_PM_PM_STATS_H_
 
+#include <stdbool.h>
+
 #include <zephyr/pm/state.h>
 
 #ifdef CONFIG_PM_STATS
 void pm_stats_start(void);
 void pm_stats_stop(void);
 void pm_stats_update(enum pm_state state);
+void pm_stats_predict_update(enum pm_state state, bool hit);
 #else
 static inline void pm_stats_start(void) {}
 static inline void pm_stats_stop(void) {}
 static inline void pm_stats_update(enum pm_state state) {}
+static inline void pm_stats_predict_update(enum pm_state state, bool hit) {}
 #endif /* CONFIG_PM_STATS */
 
 #endif /* ZEPHYR_SUBSYS_PM_PM_STATS_H_ */
@@ -82,14 +82,95 @@ static void update_max_latency(void)
 }
 
 #ifdef CONFIG_PM_POLICY_DEFAULT
-const struct pm_state_info *pm_policy_next_state(uint8_t cpu, int32_t ticks)
+#ifdef CONFIG_PM_POLICY_DEFAULT_PREDICT
+/** Number of idle periods kept per CPU. */
+#define IDLE_HISTORY CONFIG_PM_POLICY_DEFAULT_PREDICT_HISTORY
+/** Longest idle period recorded, keeps the variance within 64 bits. */
+#define IDLE_SAMPLE_MAX (BIT(24) - 1)
+
+/** Recent idle periods of each CPU, in ticks. */
+static struct {
+	uint32_t samples[IDLE_HISTORY];
+	uint8_t idx;
+	uint8_t count;
+	/** State returned by the last call to pm_policy_next_state(). */
+	const struct pm_state_info *selected;
+} idle_history[CONFIG_MP_NUM_CPUS];
+
+/**
+ * @brief Predict the next idle period from the recent ones.
+ *
+ * The average of the recorded idle periods is used when their standard
+ * deviation is small compared to it. Otherwise the longest periods are
+ * discarded as outliers one at a time, up to a quarter of the history.
+ *
+ * @return Predicted number of ticks, K_TICKS_FOREVER if there is no pattern.
+ */
+static int32_t idle_predict(uint8_t cpu)
+{
+	const uint32_t *samples = idle_history[cpu].samples;
+	uint32_t limit = UINT32_MAX;
+
+	if (idle_history[cpu].count < IDLE_HISTORY) {
+		return K_TICKS_FOREVER;
+	}
+
+	while (true) {
+		uint64_t sum = 0U, variance = 0U, avg;
+		uint32_t max = 0U;
+		uint8_t n = 0U;
+
+		for (uint8_t i = 0U; i < IDLE_HISTORY; i++) {
+			if (samples[i] <= limit) {
+				sum += samples[i];
+				max = MAX(max, samples[i]);
+				n++;
+			}
+		}
+
+		avg = sum / n;
+
+		for (uint8_t i = 0U; i < IDLE_HISTORY; i++) {
+			if (samples[i] <= limit) {
+				int64_t diff = (int64_t)samples[i] - (int64_t)avg;
+
+				variance += (uint64_t)(diff * diff);
+			}
+		}
+
+		variance /= n;
+
+		/* standard deviation within 1/6 of the average */
+		if ((variance * 36U) <= (avg * avg)) {
+			return (int32_t)avg;
+		}
+
+		if ((n * 4U) <= (IDLE_HISTORY * 3U)) {
+			return K_TICKS_FOREVER;
+		}
+
+		limit = max - 1U;
+	}
+}
+#endif /* CONFIG_PM_POLICY_DEFAULT_PREDICT */
+
+/**
+ * @brief Select a state that fits in the given number of ticks.
+ *
+ * @param cpu CPU index.
+ * @param ticks Number of ticks the CPU is expected to stay idle.
+ * @param deepest Select the deepest state if true, the shallowest otherwise.
+ */
+static const struct pm_state_info *state_select(uint8_t cpu, int32_t ticks,
+						bool deepest)
 {
 	uint8_t num_cpu_states;
 	const struct pm_state_info *cpu_states;
 
 	num_cpu_states = pm_state_cpu_get_all(cpu, &cpu_states);
 
-	for (int16_t i = (int16_t)num_cpu_states - 1; i >= 0; i--) {
+	for (int16_t n = 0; n < (int16_t)num_cpu_states; n++) {
+		int16_t i = deepest ? ((int16_t)num_cpu_states - 1 - n) : n;
 		const struct pm_state_info *state = &cpu_states[i];
 		uint32_t min_residency, exit_latency;
 
@@ -115,7 +196,50 @@ const struct pm_state_info *pm_policy_next_state(uint8_t cpu, int32_t ticks)
 
 	return NULL;
 }
+
+const struct pm_state_info *pm_policy_next_state(uint8_t cpu, int32_t ticks)
+{
+#ifdef CONFIG_PM_POLICY_DEFAULT_PREDICT
+	const struct pm_state_info *state = NULL;
+	int32_t predicted = idle_predict(cpu);
+
+	if ((predicted != K_TICKS_FOREVER) &&
+	    ((ticks == K_TICKS_FOREVER) || (predicted < ticks))) {
+		state = state_select(cpu, predicted, true);
+		/* Still use the shallowest state that fits the next timeout,
+		 * so that the prediction can follow longer idle periods.
+		 */
+		if (state == NULL) {
+			state = state_select(cpu, ticks, false);
+		}
+	} else {
+		state = state_select(cpu, ticks, true);
+	}
+
+	idle_history[cpu].selected = state;
+
+	return state;
+#else
+	return state_select(cpu, ticks, true);
 #endif
+}
+
+#ifdef CONFIG_PM_POLICY_DEFAULT_PREDICT
+bool pm_policy_idle_update(uint8_t cpu, int64_t idle_ticks)
+{
+	uint8_t idx = idle_history[cpu].idx;
+
+	idle_history[cpu].samples[idx] = (uint32_t)CLAMP(idle_ticks, 0, IDLE_SAMPLE_MAX);
+	idle_history[cpu].idx = (idx + 1U) % IDLE_HISTORY;
+	if (idle_history[cpu].count < IDLE_HISTORY) {
+		idle_history[cpu].count++;
+	}
+
+	return state_select(cpu, (int32_t)MIN(idle_ticks, INT32_MAX), true) ==
+	       idle_history[cpu].selected;
+}
+#endif /* CONFIG_PM_POLICY_DEFAULT_PREDICT */
+#endif /* CONFIG_PM_POLICY_DEFAULT */
 
 void pm_policy_state_lock_get(enum pm_state state, uint8_t substate_id)
 {
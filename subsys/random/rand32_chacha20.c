@@ -0,0 +1,311 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * ChaCha20 based CSPRNG.
+ *
+ * Entropy is harvested in the background into a pool, and each CPU runs
+ * its own ChaCha20 generator, so sys_csrand_get() neither waits for the
+ * entropy source nor takes a lock shared between CPUs: it only masks
+ * interrupts on the local CPU for the time of one ChaCha20 block.
+ *
+ * The generators use fast key erasure: each call derives a new generator
+ * key and a one-time output key from one block of the current key, so
+ * that a compromised state does not reveal earlier outputs. A generator
+ * mixes a new seed extracted from the pool into its key whenever the pool
+ * has been refilled since its last reseed.
+ *
+ * The pool is a ChaCha permutation based sponge. Harvested samples go
+ * through the repetition count and adaptive proportion health tests of
+ * NIST SP 800-90B, and are discarded when a test fails.
+ */
+
+#include <zephyr/init.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/entropy.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/byteorder.h>
+#include <string.h>
+
+LOG_MODULE_REGISTER(csprng_chacha20, CONFIG_LOG_DEFAULT_LEVEL);
+
+#define CHACHA_KEY_WORDS	8
+#define CHACHA_BLOCK_WORDS	16
+#define CHACHA_BLOCK_SIZE	(CHACHA_BLOCK_WORDS * sizeof(uint32_t))
+#define CHACHA_KEY_SIZE		(CHACHA_KEY_WORDS * sizeof(uint32_t))
+
+/* Bytes read from the entropy source per harvest */
+#define HARVEST_SIZE		64
+
+/*
+ * Health test cutoffs for 8-bit samples with an assumed min-entropy of
+ * one bit per sample and a false positive rate of 2^-20, from SP 800-90B
+ * sections 4.4.1 and 4.4.2.
+ */
+#define RCT_CUTOFF		21
+#define APT_WINDOW		512
+#define APT_CUTOFF		410
+
+static const struct device *const entropy_dev =
+	DEVICE_DT_GET(DT_CHOSEN(zephyr_entropy));
+
+struct chacha20_cpu {
+	uint32_t key[CHACHA_KEY_WORDS];
+	uint32_t generation;
+	bool seeded;
+};
+
+static struct chacha20_cpu cpus[CONFIG_MP_NUM_CPUS];
+
+static struct {
+	struct k_spinlock lock;
+	uint32_t state[CHACHA_BLOCK_WORDS];
+	/* Bumped each time the pool is refilled */
+	atomic_t generation;
+	/* Adaptive proportion test, carried across harvests */
+	uint8_t apt_sample;
+	uint16_t apt_count;
+	uint16_t apt_seen;
+} pool;
+
+static struct k_work_delayable harvest_work;
+
+static inline uint32_t rotl32(uint32_t x, unsigned int n)
+{
+	return (x << n) | (x >> (32 - n));
+}
+
+#define QUARTERROUND(x, a, b, c, d)				\
+	do {							\
+		x[a] += x[b]; x[d] = rotl32(x[d] ^ x[a], 16);	\
+		x[c] += x[d]; x[b] = rotl32(x[b] ^ x[c], 12);	\
+		x[a] += x[b]; x[d] = rotl32(x[d] ^ x[a], 8);	\
+		x[c] += x[d]; x[b] = rotl32(x[b] ^ x[c], 7);	\
+	} while (false)
+
+static void chacha_permute(uint32_t x[CHACHA_BLOCK_WORDS])
+{
+	for (int i = 0; i < 10; i++) {
+		QUARTERROUND(x, 0, 4, 8, 12);
+		QUARTERROUND(x, 1, 5, 9, 13);
+		QUARTERROUND(x, 2, 6, 10, 14);
+		QUARTERROUND(x, 3, 7, 11, 15);
+		QUARTERROUND(x, 0, 5, 10, 15);
+		QUARTERROUND(x, 1, 6, 11, 12);
+		QUARTERROUND(x, 2, 7, 8, 13);
+		QUARTERROUND(x, 3, 4, 9, 14);
+	}
+}
+
+/* ChaCha20 block function of RFC 8439, with a zero nonce */
+static void chacha20_block(const uint32_t key[CHACHA_KEY_WORDS],
+			   uint32_t counter, uint32_t out[CHACHA_BLOCK_WORDS])
+{
+	uint32_t x[CHACHA_BLOCK_WORDS] = {
+		0x61707865, 0x3320646e, 0x79622d32, 0x6b206574,
+		key[0], key[1], key[2], key[3],
+		key[4], key[5], key[6], key[7],
+		counter, 0, 0, 0,
+	};
+
+	memcpy(out, x, sizeof(x));
+	chacha_permute(x);
+
+	for (int i = 0; i < CHACHA_BLOCK_WORDS; i++) {
+		out[i] += x[i];
+	}
+}
+
+/* Returns false if the samples fail a health test */
+static bool health_test(const uint8_t *buf, size_t len)
+{
+	size_t run = 1;
+
+	for (size_t i = 0; i < len; i++) {
+		/* Repetition count test */
+		if (i > 0 && buf[i] == buf[i - 1]) {
+			if (++run >= RCT_CUTOFF) {
+				return false;
+			}
+		} else {
+			run = 1;
+		}
+
+		/* Adaptive proportion test */
+		if (pool.apt_seen == 0U) {
+			pool.apt_sample = buf[i];
+			pool.apt_count = 1U;
+		} else if (buf[i] == pool.apt_sample &&
+			   ++pool.apt_count >= APT_CUTOFF) {
+			pool.apt_seen = 0U;
+			return false;
+		}
+
+		if (++pool.apt_seen == APT_WINDOW) {
+			pool.apt_seen = 0U;
+		}
+	}
+
+	return true;
+}
+
+/* Absorb samples into the pool, called with the pool lock held */
+static void pool_absorb(const uint8_t *buf, size_t len)
+{
+	/* Half of the state is absorbed into, the other half is capacity */
+	for (size_t i = 0; i < len; i += CHACHA_BLOCK_SIZE / 2) {
+		for (size_t j = 0; j < CHACHA_BLOCK_WORDS / 2; j++) {
+			if (i + (j + 1) * sizeof(uint32_t) <= len) {
+				pool.state[j] ^= sys_get_le32(&buf[i + j * sizeof(uint32_t)]);
+			}
+		}
+		chacha_permute(pool.state);
+	}
+}
+
+/* Extract a seed from the pool, called with the pool lock held */
+static void pool_extract(uint32_t seed[CHACHA_KEY_WORDS])
+{
+	chacha_permute(pool.state);
+	memcpy(seed, pool.state, CHACHA_KEY_SIZE);
+	/* Forget the seed, for backtracking resistance */
+	memset(pool.state, 0, CHACHA_KEY_SIZE);
+	chacha_permute(pool.state);
+}
+
+/* Harvest entropy, returns 0 if the pool was refilled */
+static int pool_harvest(bool wait)
+{
+	uint8_t buf[HARVEST_SIZE];
+	k_spinlock_key_t key;
+	int ret;
+
+	if (wait) {
+		ret = entropy_get_entropy(entropy_dev, buf, sizeof(buf));
+	} else {
+		/* Only takes what the driver already collected */
+		ret = entropy_get_entropy_isr(entropy_dev, buf, sizeof(buf), 0);
+		ret = (ret == sizeof(buf)) ? 0 : -EAGAIN;
+	}
+
+	if (ret != 0) {
+		return ret;
+	}
+
+	key = k_spin_lock(&pool.lock);
+	if (!health_test(buf, sizeof(buf))) {
+		k_spin_unlock(&pool.lock, key);
+		LOG_WRN("entropy source health test failed");
+		ret = -EIO;
+	} else {
+		pool_absorb(buf, sizeof(buf));
+		k_spin_unlock(&pool.lock, key);
+		atomic_inc(&pool.generation);
+	}
+
+	memset(buf, 0, sizeof(buf));
+
+	return ret;
+}
+
+static void harvest_handler(struct k_work *work)
+{
+	k_timeout_t delay = K_MSEC(CONFIG_CSPRNG_CHACHA20_RESEED_INTERVAL);
+
+	/* Retry soon if the driver had nothing to give */
+	if (pool_harvest(false) == -EAGAIN) {
+		delay = K_MSEC(CONFIG_CSPRNG_CHACHA20_RESEED_INTERVAL / 16 + 1);
+	}
+
+	(void)k_work_reschedule(k_work_delayable_from_work(work), delay);
+}
+
+/* Mix a seed from the pool into a CPU generator, interrupts locked */
+static void cpu_reseed(struct chacha20_cpu *cpu, uint32_t generation)
+{
+	uint32_t seed[CHACHA_KEY_WORDS];
+	k_spinlock_key_t key = k_spin_lock(&pool.lock);
+
+	pool_extract(seed);
+	k_spin_unlock(&pool.lock, key);
+
+	for (int i = 0; i < CHACHA_KEY_WORDS; i++) {
+		cpu->key[i] ^= seed[i];
+	}
+
+	cpu->generation = generation;
+	cpu->seeded = true;
+	memset(seed, 0, sizeof(seed));
+}
+
+int z_impl_sys_csrand_get(void *dst, size_t outlen)
+{
+	uint32_t block[CHACHA_BLOCK_WORDS];
+	uint32_t out_key[CHACHA_KEY_WORDS];
+	uint8_t *p = dst;
+	struct chacha20_cpu *cpu;
+	uint32_t generation;
+	uint32_t counter = 0;
+	unsigned int key;
+
+	if (atomic_get(&pool.generation) == 0) {
+		/* Early call, before the pool could be filled */
+		if (k_is_in_isr() || pool_harvest(true) != 0) {
+			return -EIO;
+		}
+	}
+
+	key = arch_irq_lock();
+	cpu = &cpus[arch_curr_cpu()->id];
+
+	generation = atomic_get(&pool.generation);
+	if (!cpu->seeded || cpu->generation != generation) {
+		cpu_reseed(cpu, generation);
+	}
+
+	/* Fast key erasure: the first half of the block replaces the key,
+	 * the second half keys the output of this call only.
+	 */
+	chacha20_block(cpu->key, 0, block);
+	memcpy(cpu->key, block, CHACHA_KEY_SIZE);
+	arch_irq_unlock(key);
+	memcpy(out_key, &block[CHACHA_KEY_WORDS], CHACHA_KEY_SIZE);
+
+	while (outlen > 0) {
+		size_t len = MIN(outlen, CHACHA_BLOCK_SIZE);
+
+		chacha20_block(out_key, counter++, block);
+		memcpy(p, block, len);
+		p += len;
+		outlen -= len;
+	}
+
+	memset(block, 0, sizeof(block));
+	memset(out_key, 0, sizeof(out_key));
+
+	return 0;
+}
+
+/* In-tree entropy drivers will initialize in PRE_KERNEL_1; ensure that they're
+ * initialized properly before initializing ourselves.
+ */
+static int chacha20_csprng_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	if (!device_is_ready(entropy_dev)) {
+		return -ENODEV;
+	}
+
+	k_work_init_delayable(&harvest_work, harvest_handler);
+	(void)k_work_schedule(&harvest_work, K_NO_WAIT);
+
+	return 0;
+}
+
+SYS_INIT(chacha20_csprng_init, POST_KERNEL,
+	 CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
@@ -91,16 +91,53 @@ static void conex_sweep(struct rtio *r, struct rtio_concurrent_executor *exc)
 	}
 }
 
+/**
+ * Complete the sqe of a task with the given result, cancel the rest of its
+ * chain including the entry terminating it, and mark the task as complete
+ */
+static void conex_fail_task(struct rtio *r, struct rtio_concurrent_executor *exc,
+			    uint16_t task_id, const struct rtio_sqe *sqe, int result)
+{
+	rtio_cqe_submit(r, result, sqe->userdata);
+
+	while (sqe->flags & RTIO_SQE_CHAINED) {
+		sqe = rtio_spsc_next(r->sq, sqe);
+		if (sqe == NULL) {
+			break;
+		}
+		rtio_cqe_submit(r, -ECANCELED, sqe->userdata);
+	}
+
+	exc->task_status[task_id & exc->task_mask] |= CONEX_TASK_COMPLETE;
+}
+
 static void conex_resume(struct rtio *r, struct rtio_concurrent_executor *exc)
 {
+	bool canceled = false;
+
 	/* In order resume tasks */
 	for (uint16_t task_id = exc->task_out; task_id < exc->task_in; task_id++) {
 		if (exc->task_status[task_id & exc->task_mask] & CONEX_TASK_SUSPENDED) {
+			const struct rtio_sqe *sqe = exc->task_cur[task_id & exc->task_mask];
+
+			exc->task_status[task_id & exc->task_mask] &= ~CONEX_TASK_SUSPENDED;
+
+			if (sqe->flags & RTIO_SQE_CANCELED) {
+				LOG_INF("canceling suspended task %d", task_id);
+				conex_fail_task(r, exc, task_id, sqe, -ECANCELED);
+				canceled = true;
+				continue;
+			}
+
 			LOG_INF("resuming suspended task %d", task_id);
-			exc->task_status[task_id] &= ~CONEX_TASK_SUSPENDED;
-			rtio_iodev_submit(exc->task_cur[task_id], r);
+			rtio_iodev_submit(sqe, r);
 		}
 	}
+
+	/* Canceled tasks never reach an iodev, sweep them up right away */
+	if (canceled) {
+		conex_sweep(r, exc);
+	}
 }
 
 static void conex_sweep_resume(struct rtio *r, struct rtio_concurrent_executor *exc)
@@ -218,9 +255,13 @@ void rtio_concurrent_ok(struct rtio *r, const struct rtio_sqe *sqe, int result)
 	if (sqe->flags & RTIO_SQE_CHAINED) {
 		next_sqe = rtio_spsc_next(r->sq, sqe);
 
-		rtio_iodev_submit(next_sqe, r);
-
 		exc->task_cur[task_id] = next_sqe;
+
+		if (next_sqe->flags & RTIO_SQE_CANCELED) {
+			conex_fail_task(r, exc, task_id, next_sqe, -ECANCELED);
+		} else {
+			rtio_iodev_submit(next_sqe, r);
+		}
 	} else {
 		exc->task_status[task_id]  |= CONEX_TASK_COMPLETE;
 	}
@@ -240,7 +281,6 @@ void rtio_concurrent_ok(struct rtio *r, const struct rtio_sqe *sqe, int result)
  */
 void rtio_concurrent_err(struct rtio *r, const struct rtio_sqe *sqe, int result)
 {
-	struct rtio_sqe *nsqe;
 	k_spinlock_key_t key;
 	struct rtio_concurrent_executor *exc = (struct rtio_concurrent_executor *)r->executor;
 
@@ -254,23 +294,11 @@ void rtio_concurrent_err(struct rtio *r, const struct rtio_sqe *sqe, int result)
 	 */
 	key = k_spin_lock(&exc->lock);
 
-	rtio_cqe_submit(r, result, sqe->userdata);
-
 	/* Determine the task id : O(n) */
 	uint16_t task_id = conex_task_id(exc, sqe);
 
-
-	/* Fail the remaining sqe's in the chain */
-	if (sqe->flags & RTIO_SQE_CHAINED) {
-		nsqe = rtio_spsc_next(r->sq, sqe);
-		while (nsqe != NULL && nsqe->flags & RTIO_SQE_CHAINED) {
-			rtio_cqe_submit(r, -ECANCELED, nsqe->userdata);
-			nsqe = rtio_spsc_next(r->sq, nsqe);
-		}
-	}
-
-	/* Task is complete (failed) */
-	exc->task_status[task_id] |= CONEX_TASK_COMPLETE;
+	/* Fail the remaining sqe's in the chain, task is complete (failed) */
+	conex_fail_task(r, exc, task_id, sqe, result);
 
 	conex_sweep_resume(r, exc);
 
@@ -18,32 +18,73 @@ LOG_MODULE_REGISTER(rtio_executor_simple, CONFIG_RTIO_LOG_LEVEL);
  * The simple executor provides no concurrency instead
  * execution each submission chain one after the next.
  *
+ * Submitting while a submission is being executed only queues it, it is
+ * started once the executing one completes.
+ *
  * @param r RTIO context
  *
  * @retval 0 Always succeeds
  */
 int rtio_simple_submit(struct rtio *r)
 {
-	/* TODO For each submission queue entry chain,
-	 * submit the chain to the first iodev
-	 */
-	struct rtio_sqe *sqe = rtio_spsc_consume(r->sq);
+	struct rtio_simple_executor *exc = (struct rtio_simple_executor *)r->executor;
+	struct rtio_sqe *sqe = NULL;
+	k_spinlock_key_t key = k_spin_lock(&exc->lock);
+
+	if (!exc->active) {
+		sqe = rtio_spsc_consume(r->sq);
+		exc->active = (sqe != NULL);
+	}
+
+	k_spin_unlock(&exc->lock, key);
 
-	if (sqe != NULL) {
+	if (sqe == NULL) {
+		return 0;
+	}
+
+	if (sqe->flags & RTIO_SQE_CANCELED) {
+		rtio_simple_err(r, sqe, -ECANCELED);
+	} else {
 		rtio_iodev_submit(sqe, r);
 	}
 
 	return 0;
 }
 
+static void rtio_simple_next(struct rtio *r)
+{
+	struct rtio_simple_executor *exc = (struct rtio_simple_executor *)r->executor;
+	k_spinlock_key_t key = k_spin_lock(&exc->lock);
+
+	exc->active = false;
+	k_spin_unlock(&exc->lock, key);
+
+	rtio_simple_submit(r);
+}
+
 /**
  * @brief Callback from an iodev describing success
  */
 void rtio_simple_ok(struct rtio *r, const struct rtio_sqe *sqe, int result)
 {
+	struct rtio_sqe *nsqe;
+	bool chained;
+
 	rtio_cqe_submit(r, result, sqe->userdata);
+	chained = sqe->flags & RTIO_SQE_CHAINED;
 	rtio_spsc_release(r->sq);
-	rtio_simple_submit(r);
+
+	/* Canceled entries of a chain are not started */
+	if (chained) {
+		nsqe = rtio_spsc_peek(r->sq);
+		if (nsqe != NULL && (nsqe->flags & RTIO_SQE_CANCELED)) {
+			nsqe = rtio_spsc_consume(r->sq);
+			rtio_simple_err(r, nsqe, -ECANCELED);
+			return;
+		}
+	}
+
+	rtio_simple_next(r);
 }
 
 /**
@@ -58,21 +99,18 @@ void rtio_simple_err(struct rtio *r, const struct rtio_sqe *sqe, int result)
 	chained = sqe->flags & RTIO_SQE_CHAINED;
 	rtio_spsc_release(r->sq);
 
-	if (chained) {
-
+	/* Fail the remaining sqe's in the chain, including the last one */
+	while (chained) {
 		nsqe = rtio_spsc_consume(r->sq);
-		while (nsqe != NULL && nsqe->flags & RTIO_SQE_CHAINED) {
-			rtio_cqe_submit(r, -ECANCELED, nsqe->userdata);
-			rtio_spsc_release(r->sq);
-			nsqe = rtio_spsc_consume(r->sq);
+		if (nsqe == NULL) {
+			break;
 		}
 
-		if (nsqe != NULL) {
-			rtio_iodev_submit(nsqe, r);
-		}
-
-	} else {
-		/* Now we can submit the next in the queue if we aren't done */
-		rtio_simple_submit(r);
+		rtio_cqe_submit(r, -ECANCELED, nsqe->userdata);
+		chained = nsqe->flags & RTIO_SQE_CHAINED;
+		rtio_spsc_release(r->sq);
 	}
+
+	/* Now we can submit the next in the queue if we aren't done */
+	rtio_simple_next(r);
 }
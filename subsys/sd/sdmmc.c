@@ -1287,10 +1287,12 @@ int sdmmc_read_blocks(struct sd_card *card, uint8_t *rbuf,
 			k_mutex_unlock(&card->lock);
 			return -ENOBUFS;
 		}
-		rlen = sizeof(card->card_buffer) / card->block_size;
 		sector = 0;
 		buf_offset = rbuf;
 		while (sector < num_blocks) {
+			/* Use multi-block reads when the card buffer allows */
+			rlen = MIN(sizeof(card->card_buffer) / card->block_size,
+				   num_blocks - sector);
 			/* Read from disk to card buffer */
 			ret = sdmmc_read(card, card->card_buffer,
 				sector + start_block, rlen);
@@ -1463,10 +1465,12 @@ int sdmmc_write_blocks(struct sd_card *card, const uint8_t *wbuf,
 			k_mutex_unlock(&card->lock);
 			return -ENOBUFS;
 		}
-		wlen = sizeof(card->card_buffer) / card->block_size;
 		sector = 0;
 		buf_offset = wbuf;
 		while (sector < num_blocks) {
+			/* Use multi-block writes when the card buffer allows */
+			wlen = MIN(sizeof(card->card_buffer) / card->block_size,
+				   num_blocks - sector);
 			/* Copy data into card buffer */
 			memcpy(card->card_buffer, buf_offset, wlen * card->block_size);
 			/* Write card buffer to disk */
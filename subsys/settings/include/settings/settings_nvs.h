@@ -33,11 +33,33 @@ extern "C" {
 #define NVS_NAMECNT_ID 0x8000
 #define NVS_NAME_ID_OFFSET 0x4000
 
+#if defined(CONFIG_SETTINGS_NVS_NAME_INDEX)
+/* Hashes of a setting's name, used to skip reading names from NVS that
+ * cannot match.
+ */
+struct settings_nvs_name_hash {
+	uint16_t name;	/* hash of the whole name */
+	uint16_t next;	/* next entry with the same name hash, or free */
+	uint8_t root;	/* hash of the first name component */
+	uint8_t used;	/* name ID holds a setting */
+};
+#endif
+
 struct settings_nvs {
 	struct settings_store cf_store;
 	struct nvs_fs cf_nvs;
 	uint16_t last_name_id;
 	const struct device *flash_dev;
+#if defined(CONFIG_SETTINGS_NVS_NAME_INDEX)
+	/* Entry i is for name ID NVS_NAMECNT_ID + 1 + i */
+	struct settings_nvs_name_hash name_index[CONFIG_SETTINGS_NVS_NAME_INDEX_SIZE];
+	/* Entries of used name IDs by name hash */
+	uint16_t name_index_bucket[CONFIG_SETTINGS_NVS_NAME_INDEX_BUCKETS];
+	/* Entries of free name IDs */
+	uint16_t name_index_free;
+	/* All entries match the content of NVS */
+	bool name_index_valid;
+#endif
 };
 
 /* register nvs to be a source of settings */
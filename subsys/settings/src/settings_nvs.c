@@ -12,6 +12,7 @@
 #include "settings/settings_nvs.h"
 #include "settings_priv.h"
 #include <zephyr/storage/flash_map.h>
+#include <zephyr/sys/crc.h>
 
 #include <zephyr/logging/log.h>
 LOG_MODULE_DECLARE(settings, CONFIG_SETTINGS_LOG_LEVEL);
@@ -56,6 +57,136 @@ static ssize_t settings_nvs_read_fn(void *back_end, void *data, size_t len)
 	return rc;
 }
 
+#if defined(CONFIG_SETTINGS_NVS_NAME_INDEX)
+static void settings_nvs_name_hash(const char *name,
+				   struct settings_nvs_name_hash *hash)
+{
+	int root_len;
+
+	root_len = settings_name_next(name, NULL);
+
+	hash->name = crc16_ccitt(0xffff, (const uint8_t *)name, strlen(name));
+	hash->root = (uint8_t)crc16_ccitt(0xffff, (const uint8_t *)name,
+					  root_len);
+}
+
+static struct settings_nvs_name_hash *
+settings_nvs_name_index_get(struct settings_nvs *cf, uint16_t name_id)
+{
+	uint16_t i = name_id - (NVS_NAMECNT_ID + 1);
+
+	if (i >= ARRAY_SIZE(cf->name_index)) {
+		return NULL;
+	}
+
+	return &cf->name_index[i];
+}
+
+/* Lists are linked by entry index + 1, 0 ends a list */
+static void settings_nvs_name_index_unlink(struct settings_nvs *cf,
+					   uint16_t *head, uint16_t link)
+{
+	while (*head) {
+		if (*head == link) {
+			*head = cf->name_index[link - 1].next;
+			return;
+		}
+		head = &cf->name_index[*head - 1].next;
+	}
+}
+
+static uint16_t *settings_nvs_name_index_bucket(struct settings_nvs *cf,
+						uint16_t name_hash)
+{
+	return &cf->name_index_bucket[name_hash %
+				      ARRAY_SIZE(cf->name_index_bucket)];
+}
+
+/* Link the used entries by name hash, and the free ones in order of name ID
+ * so that the lowest free name ID is reused first.
+ */
+static void settings_nvs_name_index_link(struct settings_nvs *cf)
+{
+	struct settings_nvs_name_hash *hash;
+	uint16_t *head;
+	uint16_t i;
+
+	memset(cf->name_index_bucket, 0, sizeof(cf->name_index_bucket));
+	cf->name_index_free = 0U;
+
+	i = MIN(cf->last_name_id - NVS_NAMECNT_ID, ARRAY_SIZE(cf->name_index));
+	while (i--) {
+		hash = &cf->name_index[i];
+		if (hash->used) {
+			head = settings_nvs_name_index_bucket(cf, hash->name);
+		} else {
+			head = &cf->name_index_free;
+		}
+
+		hash->next = *head;
+		*head = i + 1;
+	}
+}
+
+static void settings_nvs_name_index_set(struct settings_nvs *cf,
+					uint16_t name_id, const char *name)
+{
+	struct settings_nvs_name_hash *hash;
+	uint16_t link = name_id - NVS_NAMECNT_ID;
+	uint16_t *head;
+
+	hash = settings_nvs_name_index_get(cf, name_id);
+	if (!hash) {
+		return;
+	}
+
+	/* The lists are only linked once the index is valid */
+	if (cf->name_index_valid) {
+		if (hash->used) {
+			head = settings_nvs_name_index_bucket(cf, hash->name);
+		} else {
+			head = &cf->name_index_free;
+		}
+
+		settings_nvs_name_index_unlink(cf, head, link);
+	}
+
+	if (name) {
+		settings_nvs_name_hash(name, hash);
+		hash->used = 1U;
+		head = settings_nvs_name_index_bucket(cf, hash->name);
+	} else {
+		hash->used = 0U;
+		head = &cf->name_index_free;
+	}
+
+	if (cf->name_index_valid) {
+		hash->next = *head;
+		*head = link;
+	}
+}
+
+/* Next name ID in the list at *link whose name has the given hash */
+static uint16_t settings_nvs_name_index_next(struct settings_nvs *cf,
+					     uint16_t *link, uint16_t name_hash)
+{
+	struct settings_nvs_name_hash *hash;
+	uint16_t name_id;
+
+	while (*link) {
+		name_id = NVS_NAMECNT_ID + *link;
+		hash = &cf->name_index[*link - 1];
+		*link = hash->next;
+
+		if (hash->name == name_hash) {
+			return name_id;
+		}
+	}
+
+	return NVS_NAMECNT_ID;
+}
+#endif /* CONFIG_SETTINGS_NVS_NAME_INDEX */
+
 int settings_nvs_src(struct settings_nvs *cf)
 {
 	cf->cf_store.cs_itf = &settings_nvs_itf;
@@ -82,6 +213,14 @@ static int settings_nvs_load(struct settings_store *cs,
 	char buf;
 	ssize_t rc1, rc2;
 	uint16_t name_id = NVS_NAMECNT_ID;
+#if defined(CONFIG_SETTINGS_NVS_NAME_INDEX)
+	struct settings_nvs_name_hash subtree_hash, *hash;
+	bool index_valid = cf->name_index_valid;
+
+	if (arg->subtree) {
+		settings_nvs_name_hash(arg->subtree, &subtree_hash);
+	}
+#endif
 
 	name_id = cf->last_name_id + 1;
 
@@ -92,6 +231,16 @@ static int settings_nvs_load(struct settings_store *cs,
 			break;
 		}
 
+#if defined(CONFIG_SETTINGS_NVS_NAME_INDEX)
+		hash = settings_nvs_name_index_get(cf, name_id);
+		if (index_valid && hash &&
+		    (!hash->used ||
+		     (arg->subtree && (hash->root != subtree_hash.root)))) {
+			/* No setting, or not in the subtree */
+			continue;
+		}
+#endif
+
 		/* In the NVS backend, each setting item is stored in two NVS
 		 * entries one for the setting's name and one with the
 		 * setting's value.
@@ -101,6 +250,9 @@ static int settings_nvs_load(struct settings_store *cs,
 			       &buf, sizeof(buf));
 
 		if ((rc1 <= 0) && (rc2 <= 0)) {
+#if defined(CONFIG_SETTINGS_NVS_NAME_INDEX)
+			settings_nvs_name_index_set(cf, name_id, NULL);
+#endif
 			continue;
 		}
 
@@ -117,11 +269,17 @@ static int settings_nvs_load(struct settings_store *cs,
 			}
 			nvs_delete(&cf->cf_nvs, name_id);
 			nvs_delete(&cf->cf_nvs, name_id + NVS_NAME_ID_OFFSET);
+#if defined(CONFIG_SETTINGS_NVS_NAME_INDEX)
+			settings_nvs_name_index_set(cf, name_id, NULL);
+#endif
 			continue;
 		}
 
 		/* Found a name, this might not include a trailing \0 */
 		name[rc1] = '\0';
+#if defined(CONFIG_SETTINGS_NVS_NAME_INDEX)
+		settings_nvs_name_index_set(cf, name_id, name);
+#endif
 		read_fn_arg.fs = &cf->cf_nvs;
 		read_fn_arg.id = name_id + NVS_NAME_ID_OFFSET;
 
@@ -133,6 +291,14 @@ static int settings_nvs_load(struct settings_store *cs,
 			break;
 		}
 	}
+
+#if defined(CONFIG_SETTINGS_NVS_NAME_INDEX)
+	if (!ret && !cf->name_index_valid) {
+		/* All name IDs have been read */
+		settings_nvs_name_index_link(cf);
+		cf->name_index_valid = true;
+	}
+#endif
 	return ret;
 }
 
@@ -144,11 +310,21 @@ static int settings_nvs_save(struct settings_store *cs, const char *name,
 	uint16_t name_id, write_name_id;
 	bool delete, write_name;
 	int rc = 0;
+#if defined(CONFIG_SETTINGS_NVS_NAME_INDEX)
+	struct settings_nvs_name_hash name_hash;
+	bool indexed = false;
+	uint16_t link;
+#endif
 
 	if (!name) {
 		return -EINVAL;
 	}
 
+#if defined(CONFIG_SETTINGS_NVS_NAME_INDEX)
+	settings_nvs_name_hash(name, &name_hash);
+	link = *settings_nvs_name_index_bucket(cf, name_hash.name);
+#endif
+
 	/* Find out if we are doing a delete */
 	delete = ((value == NULL) || (val_len == 0));
 
@@ -157,7 +333,21 @@ static int settings_nvs_save(struct settings_store *cs, const char *name,
 	write_name = true;
 
 	while (1) {
+#if defined(CONFIG_SETTINGS_NVS_NAME_INDEX)
+		if (indexed || (cf->name_index_valid &&
+				settings_nvs_name_index_get(cf, name_id - 1))) {
+			/* The remaining name IDs are in the index, only read
+			 * back the names with the same hash.
+			 */
+			indexed = true;
+			name_id = settings_nvs_name_index_next(cf, &link,
+							       name_hash.name);
+		} else {
+			name_id--;
+		}
+#else
 		name_id--;
+#endif
 		if (name_id == NVS_NAMECNT_ID) {
 			break;
 		}
@@ -180,6 +370,17 @@ static int settings_nvs_save(struct settings_store *cs, const char *name,
 
 		if ((delete) && (name_id == cf->last_name_id)) {
 			cf->last_name_id--;
+#if defined(CONFIG_SETTINGS_NVS_NAME_INDEX)
+			/* Also drop the free name IDs below it, so that
+			 * loading does not have to go through them.
+			 */
+			while (cf->name_index_valid &&
+			       (cf->last_name_id != NVS_NAMECNT_ID) &&
+			       settings_nvs_name_index_get(cf, cf->last_name_id) &&
+			       !settings_nvs_name_index_get(cf, cf->last_name_id)->used) {
+				cf->last_name_id--;
+			}
+#endif
 			rc = nvs_write(&cf->cf_nvs, NVS_NAMECNT_ID,
 				       &cf->last_name_id, sizeof(uint16_t));
 			if (rc < 0) {
@@ -202,6 +403,9 @@ static int settings_nvs_save(struct settings_store *cs, const char *name,
 				return rc;
 			}
 
+#if defined(CONFIG_SETTINGS_NVS_NAME_INDEX)
+			settings_nvs_name_index_set(cf, name_id, NULL);
+#endif
 			return 0;
 		}
 		write_name_id = name_id;
@@ -213,6 +417,13 @@ static int settings_nvs_save(struct settings_store *cs, const char *name,
 		return 0;
 	}
 
+#if defined(CONFIG_SETTINGS_NVS_NAME_INDEX)
+	if (write_name && cf->name_index_valid && cf->name_index_free) {
+		/* Reuse a freed name ID */
+		write_name_id = NVS_NAMECNT_ID + cf->name_index_free;
+	}
+#endif
+
 	/* No free IDs left. */
 	if (write_name_id == NVS_NAMECNT_ID + NVS_NAME_ID_OFFSET) {
 		return -ENOMEM;
@@ -231,6 +442,10 @@ static int settings_nvs_save(struct settings_store *cs, const char *name,
 		if (rc < 0) {
 			return rc;
 		}
+
+#if defined(CONFIG_SETTINGS_NVS_NAME_INDEX)
+		settings_nvs_name_index_set(cf, write_name_id, name);
+#endif
 	}
 
 	/* update the last_name_id and write to flash if required*/
@@ -263,6 +478,11 @@ int settings_nvs_backend_init(struct settings_nvs *cf)
 		return rc;
 	}
 
+#if defined(CONFIG_SETTINGS_NVS_NAME_INDEX)
+	/* Filled by the first load of all settings */
+	cf->name_index_valid = false;
+#endif
+
 	rc = nvs_read(&cf->cf_nvs, NVS_NAMECNT_ID, &last_name_id,
 		      sizeof(last_name_id));
 	if (rc < 0) {
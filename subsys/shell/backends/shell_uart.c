@@ -162,6 +162,162 @@ static void uart_callback(const struct device *dev, void *user_data)
 }
 #endif /* CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN */
 
+#ifdef CONFIG_SHELL_BACKEND_SERIAL_ASYNC
+static void async_rx_handle(const struct shell_uart *sh_uart,
+			    const uint8_t *data, size_t len)
+{
+#ifdef CONFIG_MCUMGR_SMP_SHELL
+	/* Divert bytes from shell handling if it is part of an mcumgr
+	 * frame.
+	 */
+	size_t i = smp_shell_rx_bytes(&sh_uart->ctrl_blk->smp, data, len);
+
+	data += i;
+	len -= i;
+#endif /* CONFIG_MCUMGR_SMP_SHELL */
+
+	if ((len > 0) && (ring_buf_put(sh_uart->rx_ringbuf, data, len) < len)) {
+		LOG_WRN("RX ring buffer full.");
+	}
+
+	sh_uart->ctrl_blk->handler(SHELL_TRANSPORT_EVT_RX_RDY,
+				   sh_uart->ctrl_blk->context);
+}
+
+static void async_rx_enable(const struct shell_uart *sh_uart)
+{
+	struct shell_uart_ctrl_blk *ctrl_blk = sh_uart->ctrl_blk;
+	int err;
+
+	ctrl_blk->rx_async_buf_idx = 0;
+	err = uart_rx_enable(ctrl_blk->dev, ctrl_blk->rx_async_buf[0],
+			     sizeof(ctrl_blk->rx_async_buf[0]),
+			     CONFIG_SHELL_BACKEND_SERIAL_ASYNC_RX_TIMEOUT);
+	if (err < 0) {
+		LOG_ERR("Failed to enable RX (err %d)", err);
+	}
+}
+
+/* Shall only be called by the context which has set tx_busy. */
+static void async_tx_next(const struct shell_uart *sh_uart)
+{
+	uint8_t *data;
+	uint32_t len;
+
+	while (true) {
+		len = ring_buf_get_claim(sh_uart->tx_ringbuf, &data,
+					 sh_uart->tx_ringbuf->size);
+		if (len == 0) {
+			atomic_clear(&sh_uart->ctrl_blk->tx_busy);
+
+			/* Data put to the ring buffer after the claim is not
+			 * started by the writer as it found tx_busy set.
+			 */
+			if (ring_buf_is_empty(sh_uart->tx_ringbuf) ||
+			    atomic_set(&sh_uart->ctrl_blk->tx_busy, 1) != 0) {
+				return;
+			}
+
+			continue;
+		}
+
+		if (uart_tx(sh_uart->ctrl_blk->dev, data, len,
+			    SYS_FOREVER_US) == 0) {
+			return;
+		}
+
+		/* Transfer could not be started, data is dropped. */
+		(void)ring_buf_get_finish(sh_uart->tx_ringbuf, len);
+	}
+}
+
+static void uart_async_callback(const struct device *dev,
+				struct uart_event *evt, void *user_data)
+{
+	const struct shell_uart *sh_uart = (struct shell_uart *)user_data;
+	struct shell_uart_ctrl_blk *ctrl_blk = sh_uart->ctrl_blk;
+
+	switch (evt->type) {
+	case UART_TX_DONE:
+	case UART_TX_ABORTED:
+		(void)ring_buf_get_finish(sh_uart->tx_ringbuf,
+					  evt->data.tx.len);
+		if (ctrl_blk->async_active) {
+			async_tx_next(sh_uart);
+		} else {
+			atomic_clear(&ctrl_blk->tx_busy);
+		}
+
+		ctrl_blk->handler(SHELL_TRANSPORT_EVT_TX_RDY,
+				  ctrl_blk->context);
+		break;
+	case UART_RX_RDY:
+		async_rx_handle(sh_uart,
+				&evt->data.rx.buf[evt->data.rx.offset],
+				evt->data.rx.len);
+		break;
+	case UART_RX_BUF_REQUEST:
+		ctrl_blk->rx_async_buf_idx ^= 1;
+		(void)uart_rx_buf_rsp(dev,
+				ctrl_blk->rx_async_buf[ctrl_blk->rx_async_buf_idx],
+				sizeof(ctrl_blk->rx_async_buf[0]));
+		break;
+	case UART_RX_DISABLED:
+		/* Reception stops on line errors, restart it. */
+		if (ctrl_blk->async_active) {
+			async_rx_enable(sh_uart);
+		}
+		break;
+	default:
+		break;
+	}
+}
+#endif /* CONFIG_SHELL_BACKEND_SERIAL_ASYNC */
+
+static void uart_async_init(const struct shell_uart *sh_uart)
+{
+#ifdef CONFIG_SHELL_BACKEND_SERIAL_ASYNC
+	const struct device *dev = sh_uart->ctrl_blk->dev;
+	int err;
+
+	ring_buf_reset(sh_uart->tx_ringbuf);
+	ring_buf_reset(sh_uart->rx_ringbuf);
+	sh_uart->ctrl_blk->tx_busy = 0;
+	sh_uart->ctrl_blk->async_active = true;
+
+	err = uart_callback_set(dev, uart_async_callback, (void *)sh_uart);
+	if (err < 0) {
+		LOG_ERR("Failed to set callback (err %d)", err);
+		return;
+	}
+
+	async_rx_enable(sh_uart);
+#endif
+}
+
+static void uart_async_uninit(const struct shell_uart *sh_uart)
+{
+#ifdef CONFIG_SHELL_BACKEND_SERIAL_ASYNC
+	const struct device *dev = sh_uart->ctrl_blk->dev;
+
+	sh_uart->ctrl_blk->async_active = false;
+	(void)uart_tx_abort(dev);
+	(void)uart_rx_disable(dev);
+#endif
+}
+
+static void async_write(const struct shell_uart *sh_uart, const void *data,
+			size_t length, size_t *cnt)
+{
+#ifdef CONFIG_SHELL_BACKEND_SERIAL_ASYNC
+	*cnt = ring_buf_put(sh_uart->tx_ringbuf, data, length);
+
+	if (atomic_set(&sh_uart->ctrl_blk->tx_busy, 1) == 0) {
+		async_tx_next(sh_uart);
+	}
+#endif
+}
+
 static void uart_irq_init(const struct shell_uart *sh_uart)
 {
 #ifdef CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN
@@ -206,7 +362,9 @@ static int init(const struct shell_transport *transport,
 	k_fifo_init(&sh_uart->ctrl_blk->smp.buf_ready);
 #endif
 
-	if (IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN)) {
+	if (IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_ASYNC)) {
+		uart_async_init(sh_uart);
+	} else if (IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN)) {
 		uart_irq_init(sh_uart);
 	} else {
 		k_timer_init(sh_uart->timer, timer_handler, NULL);
@@ -221,7 +379,9 @@ static int uninit(const struct shell_transport *transport)
 {
 	const struct shell_uart *sh_uart = (struct shell_uart *)transport->ctx;
 
-	if (IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN)) {
+	if (IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_ASYNC)) {
+		uart_async_uninit(sh_uart);
+	} else if (IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN)) {
 		const struct device *dev = sh_uart->ctrl_blk->dev;
 
 		uart_irq_tx_disable(dev);
@@ -266,7 +426,10 @@ static int write(const struct shell_transport *transport,
 	const struct shell_uart *sh_uart = (struct shell_uart *)transport->ctx;
 	const uint8_t *data8 = (const uint8_t *)data;
 
-	if (IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN) &&
+	if (IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_ASYNC) &&
+		!sh_uart->ctrl_blk->blocking_tx) {
+		async_write(sh_uart, data, length, cnt);
+	} else if (IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN) &&
 		!sh_uart->ctrl_blk->blocking_tx) {
 		irq_write(sh_uart, data, length, cnt);
 	} else {
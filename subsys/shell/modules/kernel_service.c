@@ -153,9 +153,11 @@ static int cmd_kernel_threads(const struct shell *shell,
 	ARG_UNUSED(argc);
 	ARG_UNUSED(argv);
 
+	shell_bulk_output_begin(shell);
 	shell_print(shell, "Scheduler: %u since last call", sys_clock_elapsed());
 	shell_print(shell, "Threads:");
 	k_thread_foreach(shell_tdata_dump, (void *)shell);
+	shell_bulk_output_end(shell);
 	return 0;
 }
 
@@ -196,6 +198,8 @@ static int cmd_kernel_stacks(const struct shell *shell,
 {
 	ARG_UNUSED(argc);
 	ARG_UNUSED(argv);
+
+	shell_bulk_output_begin(shell);
 	k_thread_foreach(shell_stack_dump, (void *)shell);
 
 	/* Placeholder logic for interrupt stack until we have better
@@ -217,6 +221,131 @@ static int cmd_kernel_stacks(const struct shell *shell,
 			      size - unused, size,
 			      ((size - unused) * 100U) / size);
 	}
+	shell_bulk_output_end(shell);
+
+	return 0;
+}
+#endif
+
+#if defined(CONFIG_THREAD_LATENCY_STATS) && defined(CONFIG_THREAD_MONITOR)
+static void shell_latency_hist_print(const struct shell *sh, const char *name,
+				     const struct k_latency_hist *hist)
+{
+	shell_print(sh, "\t%s (max %u cycles):", name, hist->max);
+
+	for (int i = 0; i < CONFIG_THREAD_LATENCY_STATS_BUCKETS; i++) {
+		if (hist->buckets[i] == 0U) {
+			continue;
+		}
+		shell_print(sh, "\t  >= %10u%s: %u", (i == 0) ? 0U : BIT(i),
+			    (i == CONFIG_THREAD_LATENCY_STATS_BUCKETS - 1) ?
+			    "+" : " ", hist->buckets[i]);
+	}
+}
+
+static void shell_latency_dump(const struct k_thread *cthread, void *user_data)
+{
+	struct k_thread *thread = (struct k_thread *)cthread;
+	const struct shell *sh = (const struct shell *)user_data;
+	struct k_thread_latency_stats stats;
+	const char *tname = k_thread_name_get(thread);
+
+	if (k_thread_latency_stats_get(thread, &stats) != 0) {
+		return;
+	}
+
+	shell_print(sh, "%p %-10s", thread, tname ? tname : "NA");
+	shell_latency_hist_print(sh, "ready to run", &stats.ready);
+	shell_latency_hist_print(sh, "run", &stats.run);
+}
+
+static int cmd_kernel_latency(const struct shell *sh,
+			      size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_print(sh, "Threads (durations in cycles):");
+	k_thread_foreach(shell_latency_dump, (void *)sh);
+
+#ifdef CONFIG_IRQ_LATENCY_STATS
+	shell_print(sh, "Interrupt handlers:");
+	for (unsigned int irq = 0; irq < CONFIG_NUM_IRQS; irq++) {
+		struct k_latency_hist hist;
+		char name[16];
+
+		if ((k_irq_latency_stats_get(irq, &hist) != 0) ||
+		    (hist.max == 0U)) {
+			continue;
+		}
+		snprintk(name, sizeof(name), "IRQ %u", irq);
+		shell_latency_hist_print(sh, name, &hist);
+	}
+#endif
+
+	return 0;
+}
+#endif
+
+#if defined(CONFIG_SYS_HEAP_PROFILE)
+static void shell_heap_hist_print(const struct shell *sh, const char *name,
+				  const uint32_t *hist)
+{
+	shell_print(sh, "\t%s:", name);
+
+	for (int i = 0; i < SYS_HEAP_PROFILE_BINS; i++) {
+		if (hist[i] == 0U) {
+			continue;
+		}
+		shell_print(sh, "\t  >= %10u%s: %u", (i == 0) ? 0U : BIT(i),
+			    (i == SYS_HEAP_PROFILE_BINS - 1) ? "+" : " ",
+			    hist[i]);
+	}
+}
+
+static int cmd_kernel_heap(const struct shell *sh,
+			   size_t argc, char **argv)
+{
+	static struct sys_heap_profile profile;
+	bool reset = (argc > 1) && (strcmp(argv[1], "reset") == 0);
+
+	STRUCT_SECTION_FOREACH(k_heap, h) {
+		k_spinlock_key_t key = k_spin_lock(&h->lock);
+
+		sys_heap_profile_get(&h->heap, &profile);
+		if (reset) {
+			sys_heap_profile_reset(&h->heap);
+		}
+		k_spin_unlock(&h->lock, key);
+
+		shell_print(sh, "Heap %p: %zu free bytes, largest free %zu, "
+			    "fragmentation %u.%u%%, %u failed allocs",
+			    h, profile.free_bytes, profile.largest_free_bytes,
+			    profile.fragmentation / 10U,
+			    profile.fragmentation % 10U,
+			    profile.failed_allocs);
+		shell_heap_hist_print(sh, "alloc sizes (bytes)",
+				      profile.size_hist);
+		shell_heap_hist_print(sh, "alloc time (cycles)",
+				      profile.alloc_cycles_hist);
+		shell_heap_hist_print(sh, "free time (cycles)",
+				      profile.free_cycles_hist);
+
+		shell_print(sh, "\tlive bytes per call site:");
+		for (int i = 0; i < ARRAY_SIZE(profile.sites); i++) {
+			if (profile.sites[i].live_count == 0U) {
+				continue;
+			}
+			shell_print(sh, "\t  0x%08lx: %zu bytes in %u blocks",
+				    (unsigned long)profile.sites[i].site,
+				    profile.sites[i].live_bytes,
+				    profile.sites[i].live_count);
+		}
+		if (profile.other_live_bytes != 0U) {
+			shell_print(sh, "\t  other     : %zu bytes",
+				    profile.other_live_bytes);
+		}
+	}
 
 	return 0;
 }
@@ -312,6 +441,14 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel_reboot,
 
 SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel,
 	SHELL_CMD(cycles, NULL, "Kernel cycles.", cmd_kernel_cycles),
+#if defined(CONFIG_SYS_HEAP_PROFILE)
+	SHELL_CMD_ARG(heap, NULL, "Heap profiles. [reset]",
+		      cmd_kernel_heap, 1, 1),
+#endif
+#if defined(CONFIG_THREAD_LATENCY_STATS) && defined(CONFIG_THREAD_MONITOR)
+	SHELL_CMD(latency, NULL, "Thread and interrupt latency histograms.",
+		  cmd_kernel_latency),
+#endif
 #if defined(CONFIG_REBOOT)
 	SHELL_CMD(reboot, &sub_kernel_reboot, "Reboot.", NULL),
 #endif
@@ -1159,33 +1159,38 @@ static void transport_evt_handler(enum shell_transport_evt evt_type, void *ctx)
 
 static void shell_log_process(const struct shell *shell)
 {
-	bool processed = false;
+	struct k_poll_signal *signal =
+		&shell->ctx->signals[SHELL_SIGNAL_RXRDY];
 	int signaled = 0;
 	int result;
 
-	do {
-		if (!IS_ENABLED(CONFIG_LOG_MODE_IMMEDIATE)) {
-			z_shell_cmd_line_erase(shell);
-
-			processed = z_shell_log_backend_process(
-					shell->log_backend);
-		}
-
-		struct k_poll_signal *signal =
-			&shell->ctx->signals[SHELL_SIGNAL_RXRDY];
-
-		z_shell_print_prompt_and_cmd(shell);
+	if (!IS_ENABLED(CONFIG_LOG_MODE_IMMEDIATE)) {
+		z_shell_cmd_line_erase(shell);
 
-		/* Arbitrary delay added to ensure that prompt is
-		 * readable and can be used to enter further commands.
+		/* Pending messages are printed in one go so that the command
+		 * line is erased and restored only once. Processing stops
+		 * early if user input is pending, the remaining messages are
+		 * handled after the input.
 		 */
-		if (shell->ctx->cmd_buff_len) {
-			k_sleep(K_MSEC(15));
+		while (z_shell_log_backend_process(shell->log_backend)) {
+			k_poll_signal_check(signal, &signaled, &result);
+			if (signaled) {
+				k_poll_signal_raise(
+				    &shell->ctx->signals[SHELL_SIGNAL_LOG_MSG],
+				    0);
+				break;
+			}
 		}
+	}
 
-		k_poll_signal_check(signal, &signaled, &result);
+	z_shell_print_prompt_and_cmd(shell);
 
-	} while (processed && !signaled);
+	/* Arbitrary delay added to ensure that prompt is
+	 * readable and can be used to enter further commands.
+	 */
+	if (shell->ctx->cmd_buff_len) {
+		k_sleep(K_MSEC(15));
+	}
 }
 
 static int instance_init(const struct shell *sh,
@@ -1477,6 +1482,15 @@ void shell_process(const struct shell *shell)
 	z_flag_processing_set(shell, false);
 }
 
+static inline bool bulk_output_active(const struct shell *sh)
+{
+#if defined(CONFIG_SHELL_BULK_OUTPUT)
+	return sh->ctx->bulk_cnt > 0;
+#else
+	return false;
+#endif
+}
+
 /* This function mustn't be used from shell context to avoid deadlock.
  * However it can be used in shell command handlers.
  */
@@ -1498,6 +1512,13 @@ void shell_vfprintf(const struct shell *sh, enum shell_vt100_color color,
 	}
 
 	k_mutex_lock(&sh->ctx->wr_mtx, K_FOREVER);
+	if (bulk_output_active(sh)) {
+		/* Command line is restored and output flushed at the end. */
+		z_shell_vfprintf(sh, color, fmt, args);
+		k_mutex_unlock(&sh->ctx->wr_mtx);
+		return;
+	}
+
 	if (!z_flag_cmd_ctx_get(sh) && !sh->ctx->bypass) {
 		z_shell_cmd_line_erase(sh);
 	}
@@ -1571,6 +1592,8 @@ void shell_hexdump(const struct shell *shell, const uint8_t *data, size_t len)
 	const uint8_t *p = data;
 	size_t line_len;
 
+	shell_bulk_output_begin(shell);
+
 	while (len) {
 		line_len = MIN(len, SHELL_HEXDUMP_BYTES_IN_LINE);
 
@@ -1579,6 +1602,60 @@ void shell_hexdump(const struct shell *shell, const uint8_t *data, size_t len)
 		len -= line_len;
 		p += line_len;
 	}
+
+	shell_bulk_output_end(shell);
+}
+
+/* Like shell_vfprintf(), these functions mustn't be used from shell context
+ * to avoid deadlock. Mutex is held by the caller for the whole bulk output.
+ */
+void shell_bulk_output_begin(const struct shell *sh)
+{
+	__ASSERT_NO_MSG(sh);
+	__ASSERT(!k_is_in_isr(), "Thread context required.");
+
+#if defined(CONFIG_SHELL_BULK_OUTPUT)
+	/* Output to a non-active shell is dropped anyway. */
+	if (state_get(sh) != SHELL_STATE_ACTIVE) {
+		return;
+	}
+
+	k_mutex_lock(&sh->ctx->wr_mtx, K_FOREVER);
+	if (sh->ctx->bulk_cnt++ > 0) {
+		return;
+	}
+
+	if (!z_flag_cmd_ctx_get(sh) && !sh->ctx->bypass) {
+		z_shell_cmd_line_erase(sh);
+	}
+
+	sh->fprintf_ctx->ctrl_blk->autoflush = false;
+#endif
+}
+
+void shell_bulk_output_end(const struct shell *sh)
+{
+	__ASSERT_NO_MSG(sh);
+
+#if defined(CONFIG_SHELL_BULK_OUTPUT)
+	/* Matching begin was skipped because the shell was not active. */
+	if ((sh->ctx->bulk_cnt == 0) ||
+	    (sh->ctx->wr_mtx.owner != k_current_get())) {
+		return;
+	}
+
+	if (--sh->ctx->bulk_cnt == 0) {
+		sh->fprintf_ctx->ctrl_blk->autoflush = true;
+
+		if ((state_get(sh) == SHELL_STATE_ACTIVE) &&
+		    !z_flag_cmd_ctx_get(sh) && !sh->ctx->bypass) {
+			z_shell_print_prompt_and_cmd(sh);
+		}
+		z_transport_buffer_flush(sh);
+	}
+
+	k_mutex_unlock(&sh->ctx->wr_mtx);
+#endif
 }
 
 int shell_prompt_change(const struct shell *shell, const char *prompt)
@@ -123,16 +123,19 @@ static void dropped(const struct log_backend *const backend, uint32_t cnt)
 	atomic_add(&log_backend->control_block->dropped_cnt, cnt);
 }
 
-static void copy_to_pbuffer(struct mpsc_pbuf_buffer *mpsc_buffer,
-			    union log_msg_generic *msg, uint32_t timeout)
+static void copy_to_pbuffer(const struct shell_log_backend *log_backend,
+			    union log_msg_generic *msg)
 {
+	struct mpsc_pbuf_buffer *mpsc_buffer = log_backend->mpsc_buffer;
 	size_t wlen;
 	union mpsc_pbuf_generic *dst;
 
 	wlen = log_msg_generic_get_wlen((union mpsc_pbuf_generic *)msg);
-	dst = mpsc_pbuf_alloc(mpsc_buffer, wlen, K_MSEC(timeout));
+	dst = mpsc_pbuf_alloc(mpsc_buffer, wlen,
+			      K_MSEC(log_backend->timeout));
 	if (!dst) {
-		/* No space to store the log */
+		/* No space to store the log, report it as dropped. */
+		atomic_inc(&log_backend->control_block->dropped_cnt);
 		return;
 	}
 
@@ -222,7 +225,6 @@ static void process(const struct log_backend *const backend,
 {
 	const struct shell *sh = (const struct shell *)backend->cb->ctx;
 	const struct shell_log_backend *log_backend = sh->log_backend;
-	struct mpsc_pbuf_buffer *mpsc_buffer = log_backend->mpsc_buffer;
 	const struct log_output *log_output = log_backend->log_output;
 	bool colors = IS_ENABLED(CONFIG_SHELL_VT100_COLORS) &&
 			z_flag_use_colors_get(sh);
@@ -233,8 +235,7 @@ static void process(const struct log_backend *const backend,
 		if (IS_ENABLED(CONFIG_LOG_MODE_IMMEDIATE)) {
 			process_log_msg(sh, log_output, msg, true, colors);
 		} else {
-			copy_to_pbuffer(mpsc_buffer, msg,
-					log_backend->timeout);
+			copy_to_pbuffer(log_backend, msg);
 
 			if (IS_ENABLED(CONFIG_MULTITHREADING)) {
 				signal =
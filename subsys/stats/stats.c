@@ -135,6 +135,8 @@ stats_init(struct stats_hdr *hdr, uint8_t size, uint16_t cnt,
 {
 	hdr->s_size = size;
 	hdr->s_cnt = cnt;
+	hdr->s_pcpu_cnt = 1;
+	hdr->s_pcpu_stride = 0;
 #ifdef CONFIG_STATS_NAMES
 	hdr->s_map = map;
 	hdr->s_map_cnt = map_cnt;
@@ -272,6 +274,70 @@ stats_init_and_reg(struct stats_hdr *shdr, uint8_t size, uint16_t cnt,
 	return 0;
 }
 
+/**
+ * Initializes and registers a per-CPU statistics section.  Only the header of
+ * the first copy is registered, the headers of the other copies are unused.
+ *
+ * @param shdr The header of the first copy of the statistics
+ * @param size The entry size of the statistics to register either 2 (16-bit),
+ *             4 (32-bit) or 8 (64-bit).
+ * @param cnt  The number of statistics entries in the statistics structure.
+ * @param map  The map of statistics entry to statistics name, only used when
+ *             STATS_NAMES is enabled.
+ * @param map_cnt The number of elements in the statistics name map.
+ * @param stride The distance in bytes between the copies.
+ * @param pcpu_cnt The number of copies, one per CPU.
+ * @param name The name of the statistics element to register with the system.
+ *
+ * @return 0 on success, non-zero error code on failure.
+ */
+int
+stats_init_and_reg_percpu(struct stats_hdr *shdr, uint8_t size, uint16_t cnt,
+			  const struct stats_name_map *map, uint16_t map_cnt,
+			  uint16_t stride, uint8_t pcpu_cnt, const char *name)
+{
+	stats_init(shdr, size, cnt, map, map_cnt);
+	shdr->s_pcpu_cnt = pcpu_cnt;
+	shdr->s_pcpu_stride = stride;
+	stats_reset(shdr);
+
+	return stats_register(name, shdr);
+}
+
+/**
+ * Reads a statistic, summing up the copies of per-CPU statistics.
+ *
+ * @param hdr The statistics header the statistic belongs to
+ * @param off The offset of the statistic from the header
+ *
+ * @return The value of the statistic.
+ */
+uint64_t
+stats_get_value(const struct stats_hdr *hdr, uint16_t off)
+{
+	const uint8_t *addr = (const uint8_t *)hdr + off;
+	uint64_t val = 0;
+	int i;
+
+	for (i = 0; i < hdr->s_pcpu_cnt; i++) {
+		switch (hdr->s_size) {
+		case sizeof(uint16_t):
+			val += *(const uint16_t *)addr;
+			break;
+		case sizeof(uint32_t):
+			val += *(const uint32_t *)addr;
+			break;
+		case sizeof(uint64_t):
+			val += *(const uint64_t *)addr;
+			break;
+		}
+
+		addr += hdr->s_pcpu_stride;
+	}
+
+	return val;
+}
+
 /**
  * Resets and zeroes the specified statistics section.
  *
@@ -280,5 +346,11 @@ stats_init_and_reg(struct stats_hdr *shdr, uint8_t size, uint16_t cnt,
 void
 stats_reset(struct stats_hdr *hdr)
 {
-	(void)memset((uint8_t *)hdr + sizeof(*hdr), 0, hdr->s_size * hdr->s_cnt);
+	uint8_t *entries = (uint8_t *)hdr + sizeof(*hdr);
+	int i;
+
+	for (i = 0; i < hdr->s_pcpu_cnt; i++) {
+		(void)memset(entries, 0, hdr->s_size * hdr->s_cnt);
+		entries += hdr->s_pcpu_stride;
+	}
 }
@@ -39,6 +39,9 @@ static int settings_direct_loader(const char *key, size_t len,
 		/* Check that loaded progress is not outdated. */
 		if (bytes_written >= ctx->bytes_written) {
 			ctx->bytes_written = bytes_written;
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+			ctx->bytes_submitted = bytes_written;
+#endif
 		} else {
 			LOG_WRN("Loaded outdated bytes_written %zu < %zu",
 				bytes_written, ctx->bytes_written);
@@ -104,7 +107,8 @@ int stream_flash_erase_page(struct stream_flash_ctx *ctx, off_t off)
 
 #endif /* CONFIG_STREAM_FLASH_ERASE */
 
-static int flash_sync(struct stream_flash_ctx *ctx)
+static int flash_program(struct stream_flash_ctx *ctx, uint8_t *buf,
+			 size_t buf_bytes)
 {
 	int rc = 0;
 	size_t write_addr = ctx->offset + ctx->bytes_written;
@@ -112,15 +116,10 @@ static int flash_sync(struct stream_flash_ctx *ctx)
 	size_t fill_length;
 	uint8_t filler;
 
-
-	if (ctx->buf_bytes == 0) {
-		return 0;
-	}
-
 	if (IS_ENABLED(CONFIG_STREAM_FLASH_ERASE)) {
 
 		rc = stream_flash_erase_page(ctx,
-					     write_addr + ctx->buf_bytes - 1);
+					     write_addr + buf_bytes - 1);
 		if (rc < 0) {
 			LOG_ERR("stream_flash_erase_page err %d offset=0x%08zx",
 				rc, write_addr);
@@ -129,17 +128,17 @@ static int flash_sync(struct stream_flash_ctx *ctx)
 	}
 
 	fill_length = flash_get_write_block_size(ctx->fdev);
-	if (ctx->buf_bytes % fill_length) {
-		fill_length -= ctx->buf_bytes % fill_length;
+	if (buf_bytes % fill_length) {
+		fill_length -= buf_bytes % fill_length;
 		filler = flash_get_parameters(ctx->fdev)->erase_value;
 
-		memset(ctx->buf + ctx->buf_bytes, filler, fill_length);
+		memset(buf + buf_bytes, filler, fill_length);
 	} else {
 		fill_length = 0;
 	}
 
-	buf_bytes_aligned = ctx->buf_bytes + fill_length;
-	rc = flash_write(ctx->fdev, write_addr, ctx->buf, buf_bytes_aligned);
+	buf_bytes_aligned = buf_bytes + fill_length;
+	rc = flash_write(ctx->fdev, write_addr, buf, buf_bytes_aligned);
 
 	if (rc != 0) {
 		LOG_ERR("flash_write error %d offset=0x%08zx", rc,
@@ -151,30 +150,177 @@ static int flash_sync(struct stream_flash_ctx *ctx)
 		/* Invert to ensure that caller is able to discover a faulty
 		 * flash_read() even if no error code is returned.
 		 */
-		for (int i = 0; i < ctx->buf_bytes; i++) {
-			ctx->buf[i] = ~ctx->buf[i];
+		for (int i = 0; i < buf_bytes; i++) {
+			buf[i] = ~buf[i];
 		}
 
-		rc = flash_read(ctx->fdev, write_addr, ctx->buf,
-				ctx->buf_bytes);
+		rc = flash_read(ctx->fdev, write_addr, buf,
+				buf_bytes);
 		if (rc != 0) {
 			LOG_ERR("flash read failed: %d", rc);
 			return rc;
 		}
 
-		rc = ctx->callback(ctx->buf, ctx->buf_bytes, write_addr);
+		rc = ctx->callback(buf, buf_bytes, write_addr);
 		if (rc != 0) {
 			LOG_ERR("callback failed: %d", rc);
 			return rc;
 		}
 	}
 
-	ctx->bytes_written += ctx->buf_bytes;
+	ctx->bytes_written += buf_bytes;
+
+	return rc;
+}
+
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+K_THREAD_STACK_DEFINE(stream_flash_stack_area,
+		      CONFIG_STREAM_FLASH_ASYNC_STACK_SIZE);
+static struct k_work_q stream_flash_wq;
+
+static void stream_flash_work_handler(struct k_work *work)
+{
+	struct stream_flash_ctx *ctx =
+		CONTAINER_OF(work, struct stream_flash_ctx, work);
+	size_t next_end;
+	int rc;
+
+	/* The buffers have been swapped, the full one is buf_alt */
+	ctx->async_rc = flash_program(ctx, ctx->buf_alt, ctx->pending_bytes);
+
+	if (IS_ENABLED(CONFIG_STREAM_FLASH_ERASE) && (ctx->async_rc == 0) &&
+	    (ctx->bytes_written < ctx->available)) {
+		/* Erase the page the next buffer ends in while it is filled */
+		next_end = MIN(ctx->bytes_written + ctx->buf_len,
+			       ctx->available) - 1;
+
+		rc = stream_flash_erase_page(ctx, ctx->offset + next_end);
+		if (rc != 0) {
+			LOG_WRN("Erase ahead failed: %d", rc);
+		}
+	}
+
+	k_sem_give(&ctx->async_done);
+}
+
+static int flash_wait(struct stream_flash_ctx *ctx)
+{
+	int rc;
+
+	k_sem_take(&ctx->async_done, K_FOREVER);
+	rc = ctx->async_rc;
+	ctx->async_rc = 0;
+
+	return rc;
+}
+
+/*
+ * Hands the write buffer over to the flash work queue, and continues with the
+ * other buffer once it is no longer being programmed.
+ */
+static int flash_submit(struct stream_flash_ctx *ctx)
+{
+	uint8_t *buf;
+	int rc;
+
+	rc = flash_wait(ctx);
+	if (rc != 0) {
+		k_sem_give(&ctx->async_done);
+		return rc;
+	}
+
+	buf = ctx->buf_alt;
+	ctx->buf_alt = ctx->buf;
+	ctx->buf = buf;
+	ctx->pending_bytes = ctx->buf_bytes;
+	ctx->bytes_submitted += ctx->buf_bytes;
 	ctx->buf_bytes = 0U;
 
+	(void)k_work_submit_to_queue(&stream_flash_wq, &ctx->work);
+
+	return 0;
+}
+
+int stream_flash_async_enable(struct stream_flash_ctx *ctx, uint8_t *buf)
+{
+	if (!ctx || !buf || !ctx->buf) {
+		return -EFAULT;
+	}
+
+	if (ctx->buf_alt || ctx->buf_bytes) {
+		return -EALREADY;
+	}
+
+	ctx->buf_alt = buf;
+	ctx->pending_bytes = 0U;
+	ctx->bytes_submitted = ctx->bytes_written;
+	ctx->async_rc = 0;
+	k_sem_init(&ctx->async_done, 1, 1);
+	k_work_init(&ctx->work, stream_flash_work_handler);
+
+	return 0;
+}
+
+static int stream_flash_wq_init(const struct device *d)
+{
+	ARG_UNUSED(d);
+
+	const struct k_work_queue_config cfg = {.name = "stream_flash"};
+
+	k_work_queue_init(&stream_flash_wq);
+
+	k_work_queue_start(&stream_flash_wq, stream_flash_stack_area,
+			   K_THREAD_STACK_SIZEOF(stream_flash_stack_area),
+			   CONFIG_STREAM_FLASH_ASYNC_PRIO, &cfg);
+
+	return 0;
+}
+
+SYS_INIT(stream_flash_wq_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+#endif /* CONFIG_STREAM_FLASH_ASYNC */
+
+static inline bool flash_is_async(struct stream_flash_ctx *ctx)
+{
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	return ctx->buf_alt != NULL;
+#else
+	return false;
+#endif
+}
+
+static int flash_sync(struct stream_flash_ctx *ctx)
+{
+	int rc;
+
+	if (ctx->buf_bytes == 0) {
+		return 0;
+	}
+
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	if (flash_is_async(ctx)) {
+		return flash_submit(ctx);
+	}
+#endif
+
+	rc = flash_program(ctx, ctx->buf, ctx->buf_bytes);
+	if (rc == 0) {
+		ctx->buf_bytes = 0U;
+	}
+
 	return rc;
 }
 
+static size_t flash_bytes_queued(struct stream_flash_ctx *ctx)
+{
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	if (flash_is_async(ctx)) {
+		return ctx->bytes_submitted + ctx->buf_bytes;
+	}
+#endif
+	return ctx->bytes_written + ctx->buf_bytes;
+}
+
+
 int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *data,
 				size_t len, bool flush)
 {
@@ -186,7 +332,7 @@ int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *dat
 		return -EFAULT;
 	}
 
-	if (ctx->bytes_written + ctx->buf_bytes + len > ctx->available) {
+	if (flash_bytes_queued(ctx) + len > ctx->available) {
 		return -ENOMEM;
 	}
 
@@ -216,6 +362,14 @@ int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *dat
 		rc = flash_sync(ctx);
 	}
 
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	if (flush && (rc == 0) && flash_is_async(ctx)) {
+		/* Flushed data has to be in flash on return */
+		rc = flash_wait(ctx);
+		k_sem_give(&ctx->async_done);
+	}
+#endif
+
 	return rc;
 }
 
@@ -296,6 +450,10 @@ int stream_flash_init(struct stream_flash_ctx *ctx, const struct device *fdev,
 				      size);
 	ctx->callback = cb;
 
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	ctx->buf_alt = NULL;
+#endif
+
 #ifdef CONFIG_STREAM_FLASH_ERASE
 	ctx->last_erased_page_start_offset = -1;
 #endif
@@ -14,9 +14,16 @@
 extern "C" {
 #endif
 
+#ifdef CONFIG_TRACING_BUFFER_PER_CPU
+/* Each CPU writes to its own buffer, only the local CPU needs locking. */
+#define TRACING_LOCK()		{ unsigned int key; key = arch_irq_lock()
+
+#define TRACING_UNLOCK()	{ arch_irq_unlock(key); } }
+#else
 #define TRACING_LOCK()		{ int key; key = irq_lock()
 
 #define TRACING_UNLOCK()	{ irq_unlock(key); } }
+#endif
 
 /**
  * @brief Check tracing enabled or not.
@@ -38,6 +45,16 @@ void tracing_buffer_handle(uint8_t *data, uint32_t length);
  */
 void tracing_packet_drop_handle(void);
 
+/**
+ * @brief Get number of dropped tracing packets.
+ *
+ * Packets are dropped when the tracing buffer is full, i.e. when the
+ * backend cannot keep up with the rate at which packets are produced.
+ *
+ * @return Number of packets dropped since tracing initialization.
+ */
+uint32_t tracing_packet_drop_num_get(void);
+
 /**
  * @brief Handle tracing command.
  *
@@ -5,9 +5,15 @@
  */
 
 #include <zephyr/sys/ring_buffer.h>
+#include <tracing_buffer.h>
+
+#ifdef CONFIG_TRACING_BUFFER_PER_CPU
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/spsc_pbuf.h>
+#endif
 
-static struct ring_buf tracing_ring_buf;
-static uint8_t tracing_buffer[CONFIG_TRACING_BUFFER_SIZE + 1];
 static uint8_t tracing_cmd_buffer[CONFIG_TRACING_CMD_BUFFER_SIZE];
 
 uint32_t tracing_cmd_buffer_alloc(uint8_t **data)
@@ -17,6 +23,233 @@ uint32_t tracing_cmd_buffer_alloc(uint8_t **data)
 	return sizeof(tracing_cmd_buffer);
 }
 
+#ifdef CONFIG_TRACING_BUFFER_PER_CPU
+
+/* Each packet starts with a timestamp used to merge packets from all CPUs.
+ * Packets from one CPU are always in order so only heads are compared.
+ */
+struct tracing_pkt_hdr {
+	uint64_t timestamp;
+};
+
+#define TRACING_PKT_HDR_LEN sizeof(struct tracing_pkt_hdr)
+#define TRACING_PKT_LEN (TRACING_PKT_HDR_LEN + CONFIG_TRACING_PACKET_MAX_SIZE)
+
+struct tracing_cpu_buffer {
+	struct spsc_pbuf *pb;
+	/* Packet being written by the CPU, NULL if none. */
+	char *pkt;
+	uint16_t pkt_len;
+	uint16_t pkt_cap;
+};
+
+static uint32_t tracing_cpu_data[CONFIG_MP_NUM_CPUS]
+			       [DIV_ROUND_UP(CONFIG_TRACING_BUFFER_SIZE,
+					     sizeof(uint32_t))];
+static struct tracing_cpu_buffer tracing_cpu_buffers[CONFIG_MP_NUM_CPUS];
+
+/* Packet claimed by the tracing thread. */
+static struct tracing_cpu_buffer *claimed_buffer;
+static uint16_t claimed_len;
+
+static inline uint64_t tracing_timestamp(void)
+{
+#ifdef CONFIG_TIMER_HAS_64BIT_CYCLE_COUNTER
+	return k_cycle_get_64();
+#else
+	return k_cycle_get_32();
+#endif
+}
+
+static inline bool tracing_timestamp_before(uint64_t a, uint64_t b)
+{
+#ifdef CONFIG_TIMER_HAS_64BIT_CYCLE_COUNTER
+	return (int64_t)(a - b) < 0;
+#else
+	return (int32_t)((uint32_t)a - (uint32_t)b) < 0;
+#endif
+}
+
+/* Must be called with interrupts locked on the current CPU. */
+static struct tracing_cpu_buffer *tracing_cpu_buffer_get(void)
+{
+	struct tracing_cpu_buffer *cb = &tracing_cpu_buffers[arch_curr_cpu()->id];
+	struct tracing_pkt_hdr hdr;
+	int len;
+
+	if (cb->pkt != NULL) {
+		return cb;
+	}
+
+	len = spsc_pbuf_alloc(cb->pb, TRACING_PKT_LEN, &cb->pkt);
+	if (len <= (int)TRACING_PKT_HDR_LEN) {
+		cb->pkt = NULL;
+		return NULL;
+	}
+
+	hdr.timestamp = tracing_timestamp();
+	memcpy(cb->pkt, &hdr, sizeof(hdr));
+	cb->pkt_len = 0;
+	cb->pkt_cap = len - TRACING_PKT_HDR_LEN;
+
+	return cb;
+}
+
+uint32_t tracing_buffer_put_claim(uint8_t **data, uint32_t size)
+{
+	struct tracing_cpu_buffer *cb = tracing_cpu_buffer_get();
+
+	if (cb == NULL) {
+		return 0;
+	}
+
+	size = MIN(size, cb->pkt_cap - cb->pkt_len);
+	*data = (uint8_t *)&cb->pkt[TRACING_PKT_HDR_LEN + cb->pkt_len];
+	cb->pkt_len += size;
+
+	return size;
+}
+
+int tracing_buffer_put_finish(uint32_t size)
+{
+	struct tracing_cpu_buffer *cb = &tracing_cpu_buffers[arch_curr_cpu()->id];
+
+	if (cb->pkt == NULL) {
+		return (size == 0) ? 0 : -EINVAL;
+	}
+
+	if (size > cb->pkt_len) {
+		return -EINVAL;
+	}
+
+	/* Allocated but not committed space is simply reused by the next
+	 * allocation so nothing needs to be done for an empty packet.
+	 */
+	if (size > 0) {
+		spsc_pbuf_commit(cb->pb, TRACING_PKT_HDR_LEN + size);
+	}
+
+	cb->pkt = NULL;
+
+	return 0;
+}
+
+uint32_t tracing_buffer_put(uint8_t *data, uint32_t size)
+{
+	uint8_t *dst;
+
+	size = tracing_buffer_put_claim(&dst, size);
+	memcpy(dst, data, size);
+	tracing_buffer_put_finish(size);
+
+	return size;
+}
+
+uint32_t tracing_buffer_get_claim(uint8_t **data, uint32_t size)
+{
+	struct tracing_pkt_hdr hdr;
+	uint64_t oldest = 0;
+	char *oldest_pkt = NULL;
+	char *pkt;
+	uint16_t len;
+
+	claimed_buffer = NULL;
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		len = spsc_pbuf_claim(tracing_cpu_buffers[i].pb, &pkt);
+		if (len == 0) {
+			continue;
+		}
+
+		memcpy(&hdr, pkt, sizeof(hdr));
+		if ((claimed_buffer == NULL) ||
+		    tracing_timestamp_before(hdr.timestamp, oldest)) {
+			claimed_buffer = &tracing_cpu_buffers[i];
+			claimed_len = len;
+			oldest = hdr.timestamp;
+			oldest_pkt = pkt;
+		}
+	}
+
+	if (claimed_buffer == NULL) {
+		return 0;
+	}
+
+	*data = (uint8_t *)&oldest_pkt[TRACING_PKT_HDR_LEN];
+
+	return MIN(size, claimed_len - TRACING_PKT_HDR_LEN);
+}
+
+/* Packets are freed as a whole, the remaining part of a packet which was
+ * not fully consumed is discarded.
+ */
+int tracing_buffer_get_finish(uint32_t size)
+{
+	if (claimed_buffer == NULL) {
+		return (size == 0) ? 0 : -EINVAL;
+	}
+
+	if (size > claimed_len - TRACING_PKT_HDR_LEN) {
+		return -EINVAL;
+	}
+
+	spsc_pbuf_free(claimed_buffer->pb, claimed_len);
+	claimed_buffer = NULL;
+
+	return 0;
+}
+
+uint32_t tracing_buffer_get(uint8_t *data, uint32_t size)
+{
+	uint8_t *src;
+
+	size = tracing_buffer_get_claim(&src, size);
+	memcpy(data, src, size);
+	tracing_buffer_get_finish(size);
+
+	return size;
+}
+
+void tracing_buffer_init(void)
+{
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		tracing_cpu_buffers[i].pb = spsc_pbuf_init(tracing_cpu_data[i],
+							  sizeof(tracing_cpu_data[i]),
+							  0);
+	}
+}
+
+/* Can only be called by the consumer (tracing thread). */
+bool tracing_buffer_is_empty(void)
+{
+	char *pkt;
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		if (spsc_pbuf_claim(tracing_cpu_buffers[i].pb, &pkt) != 0) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+uint32_t tracing_buffer_capacity_get(void)
+{
+	return CONFIG_TRACING_PACKET_MAX_SIZE;
+}
+
+uint32_t tracing_buffer_space_get(void)
+{
+	struct tracing_cpu_buffer *cb = tracing_cpu_buffer_get();
+
+	return (cb == NULL) ? 0 : (cb->pkt_cap - cb->pkt_len);
+}
+
+#else /* !CONFIG_TRACING_BUFFER_PER_CPU */
+
+static struct ring_buf tracing_ring_buf;
+static uint8_t tracing_buffer[CONFIG_TRACING_BUFFER_SIZE + 1];
+
 uint32_t tracing_buffer_put_claim(uint8_t **data, uint32_t size)
 {
 	return ring_buf_put_claim(&tracing_ring_buf, data, size);
@@ -67,3 +300,5 @@ uint32_t tracing_buffer_space_get(void)
 {
 	return ring_buf_space_get(&tracing_ring_buf);
 }
+
+#endif /* CONFIG_TRACING_BUFFER_PER_CPU */
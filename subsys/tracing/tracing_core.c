@@ -63,7 +63,11 @@ static void tracing_thread_func(void *dummy1, void *dummy2, void *dummy3)
 
 	while (true) {
 		if (tracing_buffer_is_empty()) {
-			k_sem_take(&tracing_thread_sem, K_FOREVER);
+			if (IS_ENABLED(CONFIG_TRACING_BUFFER_PER_CPU)) {
+				k_sleep(K_MSEC(CONFIG_TRACING_THREAD_WAIT_THRESHOLD));
+			} else {
+				k_sem_take(&tracing_thread_sem, K_FOREVER);
+			}
 		} else {
 			transferring_length =
 				tracing_buffer_get_claim(
@@ -123,7 +127,8 @@ SYS_INIT(tracing_init, APPLICATION, 0);
 #ifdef CONFIG_TRACING_ASYNC
 void tracing_trigger_output(bool before_put_is_empty)
 {
-	if (before_put_is_empty) {
+	/* Per-CPU buffers are polled by the tracing thread. */
+	if (!IS_ENABLED(CONFIG_TRACING_BUFFER_PER_CPU) && before_put_is_empty) {
 		k_timer_start(&tracing_thread_timer,
 			      K_MSEC(CONFIG_TRACING_THREAD_WAIT_THRESHOLD),
 			      K_NO_WAIT);
@@ -159,3 +164,8 @@ void tracing_packet_drop_handle(void)
 {
 	atomic_inc(&tracing_packet_drop_num);
 }
+
+uint32_t tracing_packet_drop_num_get(void)
+{
+	return (uint32_t)atomic_get(&tracing_packet_drop_num);
+}
@@ -10,6 +10,13 @@
 #include <tracing_buffer.h>
 #include <tracing_format_common.h>
 
+static inline bool buffer_is_empty(void)
+{
+	/* Per-CPU buffers can only be inspected by the tracing thread. */
+	return !IS_ENABLED(CONFIG_TRACING_BUFFER_PER_CPU) &&
+	       tracing_buffer_is_empty();
+}
+
 void tracing_format_string(const char *str, ...)
 {
 	va_list args;
@@ -22,7 +29,7 @@ void tracing_format_string(const char *str, ...)
 	va_start(args, str);
 
 	TRACING_LOCK();
-	before_put_is_empty = tracing_buffer_is_empty();
+	before_put_is_empty = buffer_is_empty();
 	put_success = tracing_format_string_put(str, args);
 	TRACING_UNLOCK();
 
@@ -44,7 +51,7 @@ void tracing_format_raw_data(uint8_t *data, uint32_t length)
 	}
 
 	TRACING_LOCK();
-	before_put_is_empty = tracing_buffer_is_empty();
+	before_put_is_empty = buffer_is_empty();
 	put_success = tracing_format_raw_data_put(data, length);
 	TRACING_UNLOCK();
 
@@ -64,7 +71,7 @@ void tracing_format_data(tracing_data_t *tracing_data_array, uint32_t count)
 	}
 
 	TRACING_LOCK();
-	before_put_is_empty = tracing_buffer_is_empty();
+	before_put_is_empty = buffer_is_empty();
 	put_success = tracing_format_data_put(tracing_data_array, count);
 	TRACING_UNLOCK();
 
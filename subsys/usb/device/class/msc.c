@@ -55,7 +55,10 @@ LOG_MODULE_REGISTER(usb_msc);
 
 #define THREAD_OP_READ_QUEUED		1
 #define THREAD_OP_WRITE_QUEUED		3
-#define THREAD_OP_WRITE_DONE		4
+
+/* Disk buffers, each one is read or written with a single disk access */
+#define MSC_PAGE_SIZE	(BLOCK_SIZE * CONFIG_MASS_STORAGE_BUF_SECTORS)
+#define MSC_PAGE_COUNT	CONFIG_MASS_STORAGE_BUF_COUNT
 
 #define MASS_STORAGE_IN_EP_ADDR		0x82
 #define MASS_STORAGE_OUT_EP_ADDR	0x01
@@ -105,17 +108,37 @@ static volatile int thread_op;
 static K_KERNEL_STACK_DEFINE(mass_thread_stack, CONFIG_MASS_STORAGE_STACK_SIZE);
 static struct k_thread mass_thread_data;
 static struct k_sem disk_wait_sem;
-static volatile uint32_t defered_wr_sz;
 
 /*
- * Keep block buffer larger than BLOCK_SIZE for the case
+ * Keep block buffers larger than MSC_PAGE_SIZE for the case
  * the dCBWDataTransferLength is multiple of the BLOCK_SIZE and
  * the length of the transferred data is not aligned to the BLOCK_SIZE.
  *
  * Align for cases where the underlying disk access requires word-aligned
  * addresses.
  */
-static uint8_t __aligned(4) page[BLOCK_SIZE + CONFIG_MASS_STORAGE_BULK_EP_MPS];
+static uint8_t __aligned(4) page[MSC_PAGE_COUNT][MSC_PAGE_SIZE + MAX_PACKET];
+
+/*
+ * The buffers form a ring shared by the bulk endpoint handlers and the disk
+ * thread, so that the disk is accessed while the previous buffer is
+ * transferred. pages_used counts the buffers read from the disk and not sent
+ * yet, or received and not written to the disk yet.
+ */
+static uint32_t page_len[MSC_PAGE_COUNT];
+static atomic_t pages_used;
+/* Buffer and offset used by the bulk endpoint handlers */
+static uint8_t usb_page;
+static uint32_t usb_offset;
+/* Buffer, disk address and number of bytes left to read for the disk thread */
+static uint8_t disk_page;
+static uint32_t disk_addr;
+static uint32_t disk_length;
+/* Set while the endpoint waits for a buffer from the disk thread */
+static atomic_t usb_waiting;
+/* Set once the last buffer of a write is queued */
+static volatile bool write_queued_all;
+static volatile bool disk_error;
 
 /* Initialized during mass_storage_init() */
 static uint32_t memory_size;
@@ -205,6 +228,37 @@ BUILD_ASSERT(sizeof(CONFIG_MASS_STORAGE_INQ_PRODUCT_ID) == (INQ_PRODUCT_ID_LEN +
 BUILD_ASSERT(sizeof(CONFIG_MASS_STORAGE_INQ_REVISION) == (INQ_REVISION_LEN + 1),
 	"CONFIG_MASS_STORAGE_INQ_REVISION must be 4 characters (pad with spaces)");
 
+static uint8_t next_page(uint8_t idx)
+{
+	return (idx + 1 == MSC_PAGE_COUNT) ? 0 : idx + 1;
+}
+
+static void pages_reset(uint32_t start, uint32_t len)
+{
+	usb_page = 0U;
+	usb_offset = 0U;
+	disk_page = 0U;
+	disk_addr = start;
+	disk_length = len;
+	write_queued_all = false;
+	disk_error = false;
+	atomic_set(&pages_used, 0);
+	atomic_set(&usb_waiting, 0);
+}
+
+/*
+ * Called by the endpoint handlers when no buffer is available. Returns true
+ * if one became available in the meantime, otherwise the disk thread
+ * continues once it is done with a buffer.
+ */
+static bool page_wait(atomic_val_t busy)
+{
+	atomic_set(&usb_waiting, 1);
+
+	return (atomic_get(&pages_used) != busy) &&
+	       atomic_cas(&usb_waiting, 1, 0);
+}
+
 static void msd_state_machine_reset(void)
 {
 	stage = MSC_READ_CBW;
@@ -217,6 +271,7 @@ static void msd_init(void)
 	(void)memset(page, 0, sizeof(page));
 	addr = 0U;
 	length = 0U;
+	pages_reset(0U, 0U);
 }
 
 static void sendCSW(void)
@@ -372,21 +427,40 @@ static bool readCapacity(void)
 	return write(capacity, sizeof(capacity));
 }
 
-static void thread_memory_read_done(void)
+static void memoryRead(void)
 {
 	uint32_t n;
 
+	/* the current buffer was sent, hand it back to the disk thread */
+	if (usb_offset && (usb_offset == page_len[usb_page])) {
+		usb_page = next_page(usb_page);
+		usb_offset = 0U;
+		atomic_dec(&pages_used);
+		k_sem_give(&disk_wait_sem);
+	}
+
 	n = (length > MAX_PACKET) ? MAX_PACKET : length;
 	if ((addr + n) > memory_size) {
 		n = memory_size - addr;
 		stage = MSC_ERROR;
 	}
 
+	if (n) {
+		/* wait for the disk thread to read the next buffer */
+		if (!atomic_get(&pages_used) && !page_wait(0)) {
+			LOG_DBG("Wait for disk read %d", (addr/BLOCK_SIZE));
+			return;
+		}
+
+		n = MIN(n, page_len[usb_page] - usb_offset);
+	}
+
 	if (usb_write(mass_ep_data[MSD_IN_EP_IDX].ep_addr,
-		&page[addr % BLOCK_SIZE], n, NULL) != 0) {
+		      &page[usb_page][usb_offset], n, NULL) != 0) {
 		LOG_ERR("Failed to write EP 0x%x",
 			mass_ep_data[MSD_IN_EP_IDX].ep_addr);
 	}
+	usb_offset += n;
 	addr += n;
 	length -= n;
 
@@ -399,36 +473,13 @@ static void thread_memory_read_done(void)
 	}
 }
 
-
-static void memoryRead(void)
+static void memoryReadStart(void)
 {
-	uint32_t n;
+	pages_reset(addr, MIN(length, memory_size - addr));
+	thread_op = THREAD_OP_READ_QUEUED;
+	k_sem_give(&disk_wait_sem);
 
-	n = (length > MAX_PACKET) ? MAX_PACKET : length;
-	if ((addr + n) > memory_size) {
-		n = memory_size - addr;
-		stage = MSC_ERROR;
-	}
-
-	/* we read an entire block */
-	if (!(addr % BLOCK_SIZE)) {
-		thread_op = THREAD_OP_READ_QUEUED;
-		LOG_DBG("Signal thread for %d", (addr/BLOCK_SIZE));
-		k_sem_give(&disk_wait_sem);
-		return;
-	}
-	usb_write(mass_ep_data[MSD_IN_EP_IDX].ep_addr,
-		  &page[addr % BLOCK_SIZE], n, NULL);
-	addr += n;
-	length -= n;
-
-	csw.DataResidue -= n;
-
-	if (!length || (stage != MSC_PROCESS_CBW)) {
-		csw.Status = (stage == MSC_PROCESS_CBW) ?
-			CSW_PASSED : CSW_FAILED;
-		stage = (stage == MSC_PROCESS_CBW) ? MSC_SEND_CSW : stage;
-	}
+	memoryRead();
 }
 
 static bool check_cbw_data_length(void)
@@ -570,7 +621,7 @@ static void CBWDecode(uint8_t *buf, uint16_t size)
 			if (infoTransfer()) {
 				if ((cbw.Flags & 0x80)) {
 					stage = MSC_PROCESS_CBW;
-					memoryRead();
+					memoryReadStart();
 				} else {
 					usb_ep_set_stall(
 					  mass_ep_data[MSD_OUT_EP_IDX].ep_addr);
@@ -586,6 +637,8 @@ static void CBWDecode(uint8_t *buf, uint16_t size)
 			if (infoTransfer()) {
 				if (!(cbw.Flags & 0x80)) {
 					stage = MSC_PROCESS_CBW;
+					pages_reset(addr, 0U);
+					thread_op = THREAD_OP_WRITE_QUEUED;
 				} else {
 					usb_ep_set_stall(
 					  mass_ep_data[MSD_IN_EP_IDX].ep_addr);
@@ -643,14 +696,14 @@ static void memoryVerify(uint8_t *buf, uint16_t size)
 	/* beginning of a new block -> load a whole block in RAM */
 	if (!(addr % BLOCK_SIZE)) {
 		LOG_DBG("Disk READ sector %d", addr/BLOCK_SIZE);
-		if (disk_access_read(disk_pdrv, page, addr/BLOCK_SIZE, 1)) {
+		if (disk_access_read(disk_pdrv, page[0], addr/BLOCK_SIZE, 1)) {
 			LOG_ERR("---- Disk Read Error %d", addr/BLOCK_SIZE);
 		}
 	}
 
 	/* info are in RAM -> no need to re-read memory */
 	for (n = 0U; n < size; n++) {
-		if (page[addr%BLOCK_SIZE + n] != buf[n]) {
+		if (page[0][addr%BLOCK_SIZE + n] != buf[n]) {
 			LOG_DBG("Mismatch sector %d offset %d",
 				addr/BLOCK_SIZE, n);
 			memOK = false;
@@ -669,7 +722,48 @@ static void memoryVerify(uint8_t *buf, uint16_t size)
 	}
 }
 
-static void memoryWrite(uint8_t *buf, uint16_t size)
+/*
+ * Move data received past the end of the previous buffer to the current
+ * one, once it is free.
+ */
+static void memoryWriteResume(void)
+{
+	uint8_t prev = (usb_page == 0U) ? MSC_PAGE_COUNT - 1 : usb_page - 1;
+
+	if (usb_offset) {
+		memmove(page[usb_page], &page[prev][MSC_PAGE_SIZE], usb_offset);
+	}
+}
+
+/* Returns false if no buffer is free for the next packet */
+static bool memoryWriteQueue(void)
+{
+	uint32_t overflowed_len = 0U;
+
+	if (usb_offset > MSC_PAGE_SIZE) {
+		overflowed_len = usb_offset - MSC_PAGE_SIZE;
+	}
+
+	page_len[usb_page] = usb_offset - overflowed_len;
+	write_queued_all = !length || (stage != MSC_PROCESS_CBW);
+	LOG_DBG("Disk WRITE Qd %d", (addr/BLOCK_SIZE));
+
+	usb_page = next_page(usb_page);
+	usb_offset = overflowed_len;
+	atomic_inc(&pages_used);
+	k_sem_give(&disk_wait_sem);
+
+	if ((atomic_get(&pages_used) == MSC_PAGE_COUNT) && !page_wait(MSC_PAGE_COUNT)) {
+		return false;
+	}
+
+	memoryWriteResume();
+
+	return true;
+}
+
+/* Returns false if the endpoint has to NAK until a buffer is free */
+static bool memoryWrite(uint8_t *buf, uint16_t size)
 {
 	if ((addr + size) > memory_size) {
 		size = memory_size - addr;
@@ -678,31 +772,21 @@ static void memoryWrite(uint8_t *buf, uint16_t size)
 		LOG_WRN("Stall OUT endpoint");
 	}
 
-	/* we fill an array in RAM of 1 block before writing it in memory */
-	for (int i = 0; i < size; i++) {
-		page[addr % BLOCK_SIZE + i] = buf[i];
-	}
-
-	/* if the array is filled, write it in memory */
-	if ((addr % BLOCK_SIZE) + size >= BLOCK_SIZE) {
-		if (!(disk_access_status(disk_pdrv) &
-					DISK_STATUS_WR_PROTECT)) {
-			LOG_DBG("Disk WRITE Qd %d", (addr/BLOCK_SIZE));
-			thread_op = THREAD_OP_WRITE_QUEUED;  /* write_queued */
-			defered_wr_sz = size;
-			k_sem_give(&disk_wait_sem);
-			return;
-		}
-	}
+	/* we fill a buffer in RAM before writing it in memory */
+	memcpy(&page[usb_page][usb_offset], buf, size);
+	usb_offset += size;
 
 	addr += size;
 	length -= size;
 	csw.DataResidue -= size;
 
-	if ((!length) || (stage != MSC_PROCESS_CBW)) {
-		csw.Status = (stage == MSC_ERROR) ? CSW_FAILED : CSW_PASSED;
-		sendCSW();
+	/* if the buffer is filled, the disk thread writes it in memory */
+	if ((usb_offset >= MSC_PAGE_SIZE) || !length ||
+	    (stage != MSC_PROCESS_CBW)) {
+		return memoryWriteQueue();
 	}
+
+	return true;
 }
 
 
@@ -711,6 +795,7 @@ static void mass_storage_bulk_out(uint8_t ep,
 {
 	uint32_t bytes_read = 0U;
 	uint8_t bo_buf[CONFIG_MASS_STORAGE_BULK_EP_MPS];
+	bool read_continue = true;
 
 	ARG_UNUSED(ep_status);
 
@@ -730,7 +815,7 @@ static void mass_storage_bulk_out(uint8_t ep,
 		case WRITE10:
 		case WRITE12:
 			/* LOG_DBG("> BO - PROC_CBW WR");*/
-			memoryWrite(bo_buf, bytes_read);
+			read_continue = memoryWrite(bo_buf, bytes_read);
 			break;
 		case VERIFY10:
 			LOG_DBG("> BO - PROC_CBW VER");
@@ -751,7 +836,7 @@ static void mass_storage_bulk_out(uint8_t ep,
 		break;
 	}
 
-	if (thread_op != THREAD_OP_WRITE_QUEUED) {
+	if (read_continue) {
 		usb_ep_read_continue(ep);
 	} else {
 		LOG_DBG("> BO not clearing NAKs yet");
@@ -759,28 +844,65 @@ static void mass_storage_bulk_out(uint8_t ep,
 
 }
 
-static void thread_memory_write_done(void)
+static void thread_memory_read(void)
 {
-	uint32_t size = defered_wr_sz;
-	size_t overflowed_len = (addr + size) % CONFIG_MASS_STORAGE_BULK_EP_MPS;
-
-	if (overflowed_len) {
-		memmove(page, &page[BLOCK_SIZE], overflowed_len);
-	}
+	uint32_t n;
 
-	addr += size;
-	length -= size;
-	csw.DataResidue -= size;
+	while (disk_length && (atomic_get(&pages_used) < MSC_PAGE_COUNT)) {
+		n = MIN(disk_length, MSC_PAGE_SIZE);
+		if (disk_access_read(disk_pdrv, page[disk_page],
+				     (disk_addr/BLOCK_SIZE), n/BLOCK_SIZE)) {
+			LOG_ERR("!! Disk Read Error %d !", disk_addr/BLOCK_SIZE);
+		}
 
+		page_len[disk_page] = n;
+		disk_page = next_page(disk_page);
+		disk_addr += n;
+		disk_length -= n;
+		atomic_inc(&pages_used);
 
-	if ((!length) || (stage != MSC_PROCESS_CBW)) {
-		csw.Status = (stage == MSC_ERROR) ? CSW_FAILED : CSW_PASSED;
-		sendCSW();
+		if (atomic_cas(&usb_waiting, 1, 0)) {
+			memoryRead();
+		}
 	}
+}
 
-	thread_op = THREAD_OP_WRITE_DONE;
+static void thread_memory_write(void)
+{
+	uint32_t n;
+	bool last;
+
+	while (atomic_get(&pages_used)) {
+		n = page_len[disk_page];
+		if (n && !(disk_access_status(disk_pdrv) &
+			   DISK_STATUS_WR_PROTECT)) {
+			if (disk_access_write(disk_pdrv, page[disk_page],
+					      (disk_addr/BLOCK_SIZE),
+					      n/BLOCK_SIZE)) {
+				LOG_ERR("!!!!! Disk Write Error %d !!!!!",
+					disk_addr/BLOCK_SIZE);
+				disk_error = true;
+			}
+		}
+
+		disk_page = next_page(disk_page);
+		disk_addr += n;
+
+		/* read before releasing the buffer, the endpoint handler may
+		 * queue the last one right after
+		 */
+		last = write_queued_all;
+		if ((atomic_dec(&pages_used) == 1) && last) {
+			csw.Status = ((stage == MSC_ERROR) || disk_error) ?
+				CSW_FAILED : CSW_PASSED;
+			sendCSW();
+		}
 
-	usb_ep_read_continue(mass_ep_data[MSD_OUT_EP_IDX].ep_addr);
+		if (atomic_cas(&usb_waiting, 1, 0)) {
+			memoryWriteResume();
+			usb_ep_read_continue(mass_ep_data[MSD_OUT_EP_IDX].ep_addr);
+		}
+	}
 }
 
 /**
@@ -919,21 +1041,10 @@ static void mass_thread_main(int arg1, int unused)
 
 		switch (thread_op) {
 		case THREAD_OP_READ_QUEUED:
-			if (disk_access_read(disk_pdrv,
-						page, (addr/BLOCK_SIZE), 1)) {
-				LOG_ERR("!! Disk Read Error %d !",
-					addr/BLOCK_SIZE);
-			}
-
-			thread_memory_read_done();
+			thread_memory_read();
 			break;
 		case THREAD_OP_WRITE_QUEUED:
-			if (disk_access_write(disk_pdrv,
-						page, (addr/BLOCK_SIZE), 1)) {
-				LOG_ERR("!!!!! Disk Write Error %d !!!!!",
-					addr/BLOCK_SIZE);
-			}
-			thread_memory_write_done();
+			thread_memory_write();
 			break;
 		default:
 			LOG_ERR("XXXXXX thread_op  %d ! XXXXX", thread_op);
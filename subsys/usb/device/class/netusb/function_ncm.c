@@ -0,0 +1,878 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define LOG_LEVEL CONFIG_USB_DEVICE_NETWORK_LOG_LEVEL
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(usb_ncm);
+
+/* Enable verbose debug printing extra hexdumps */
+#define VERBOSE_DEBUG	0
+
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/ethernet.h>
+#include <net_private.h>
+
+#include <zephyr/usb/usb_device.h>
+#include <zephyr/usb/class/usb_cdc.h>
+#include <usb_descriptor.h>
+
+#include "netusb.h"
+
+#define USB_CDC_SET_ETH_PKT_FILTER	0x43
+#define USB_CDC_GET_NTB_PARAMETERS	0x80
+#define USB_CDC_GET_NTB_FORMAT		0x83
+#define USB_CDC_SET_NTB_FORMAT		0x84
+#define USB_CDC_GET_NTB_INPUT_SIZE	0x85
+#define USB_CDC_SET_NTB_INPUT_SIZE	0x86
+
+#define USB_CDC_NETWORK_CONNECTION	0x00
+#define USB_CDC_CONNECTION_SPEED_CHANGE	0x2A
+
+#define NCM_INT_EP_IDX			0
+#define NCM_OUT_EP_IDX			1
+#define NCM_IN_EP_IDX			2
+
+#define NCM_NTH16_SIGNATURE		0x484D434E /* "NCMH" */
+#define NCM_NDP16_SIGNATURE		0x304D434E /* "NCM0", no CRC */
+#define NCM_NTB_FORMAT_16		BIT(0)
+/* Smallest IN NTB the host may ask for, NCM10.pdf, 6.2.7 */
+#define NCM_NTB_MIN_IN_SIZE		2048
+/* Datagrams and NDPs are aligned to 4 bytes in both directions */
+#define NCM_ALIGN			4
+/* Bound the NDP chain of a received NTB */
+#define NCM_RX_MAX_NDP			8
+
+#if defined(CONFIG_USB_DC_HAS_HS_SUPPORT)
+#define NCM_BIT_RATE			480000000U
+#else
+#define NCM_BIT_RATE			12000000U
+#endif
+
+/* NCM Transfer Header, 16-bit format */
+struct ncm_nth16 {
+	uint32_t dwSignature;
+	uint16_t wHeaderLength;
+	uint16_t wSequence;
+	uint16_t wBlockLength;
+	uint16_t wNdpIndex;
+} __packed;
+
+/* Datagram Pointer Entry, 16-bit format */
+struct ncm_dpe16 {
+	uint16_t wDatagramIndex;
+	uint16_t wDatagramLength;
+} __packed;
+
+/* NCM Datagram Pointer Table, 16-bit format */
+struct ncm_ndp16 {
+	uint32_t dwSignature;
+	uint16_t wLength;
+	uint16_t wNextNdpIndex;
+	struct ncm_dpe16 dpe[];
+} __packed;
+
+/* Response to GET_NTB_PARAMETERS, NCM10.pdf, 6.2.1 */
+struct ncm_ntb_parameters {
+	uint16_t wLength;
+	uint16_t bmNtbFormatsSupported;
+	uint32_t dwNtbInMaxSize;
+	uint16_t wNdpInDivisor;
+	uint16_t wNdpInPayloadRemainder;
+	uint16_t wNdpInAlignment;
+	uint16_t wReserved;
+	uint32_t dwNtbOutMaxSize;
+	uint16_t wNdpOutDivisor;
+	uint16_t wNdpOutPayloadRemainder;
+	uint16_t wNdpOutAlignment;
+	uint16_t wNtbOutMaxDatagrams;
+} __packed;
+
+struct ncm_notification {
+	uint8_t bmRequestType;
+	uint8_t bNotificationType;
+	uint16_t wValue;
+	uint16_t wIndex;
+	uint16_t wLength;
+} __packed;
+
+struct ncm_speed_notification {
+	struct ncm_notification hdr;
+	uint32_t DLBitRate;
+	uint32_t ULBitRate;
+} __packed;
+
+/* Transmit NTB, datagrams are added until it is handed over to the host */
+struct ncm_tx_ntb {
+	uint8_t __aligned(4) data[CONFIG_CDC_NCM_NTB_SIZE];
+	/* Offset of the next datagram */
+	size_t len;
+	uint8_t count;
+	struct ncm_dpe16 dpe[CONFIG_CDC_NCM_TX_MAX_DATAGRAMS];
+};
+
+static const struct ncm_ntb_parameters ntb_params = {
+	.wLength = sys_cpu_to_le16(sizeof(struct ncm_ntb_parameters)),
+	.bmNtbFormatsSupported = sys_cpu_to_le16(NCM_NTB_FORMAT_16),
+	.dwNtbInMaxSize = sys_cpu_to_le32(CONFIG_CDC_NCM_NTB_SIZE),
+	.wNdpInDivisor = sys_cpu_to_le16(NCM_ALIGN),
+	.wNdpInPayloadRemainder = 0,
+	.wNdpInAlignment = sys_cpu_to_le16(NCM_ALIGN),
+	.dwNtbOutMaxSize = sys_cpu_to_le32(CONFIG_CDC_NCM_NTB_SIZE),
+	.wNdpOutDivisor = sys_cpu_to_le16(NCM_ALIGN),
+	.wNdpOutPayloadRemainder = 0,
+	.wNdpOutAlignment = sys_cpu_to_le16(NCM_ALIGN),
+	.wNtbOutMaxDatagrams = 0, /* No limit */
+};
+
+/* Size of the IN NTBs, may be lowered by the host */
+static uint32_t ntb_in_size = CONFIG_CDC_NCM_NTB_SIZE;
+static uint32_t ntb_in_size_le;
+static uint16_t ntb_format_le;
+
+static struct ncm_speed_notification speed_notification;
+static struct ncm_notification connection_notification;
+
+/*
+ * Received datagrams are passed to the stack in place, each one referencing
+ * the NTB it was received in. An NTB is received into again once the stack
+ * released all its datagrams.
+ */
+static uint8_t __aligned(4)
+	rx_ntb[CONFIG_CDC_NCM_RX_NTB_COUNT][CONFIG_CDC_NCM_NTB_SIZE];
+/* References to each NTB, 0 if free */
+static atomic_t rx_ntb_refs[CONFIG_CDC_NCM_RX_NTB_COUNT];
+/* NTB index + 1 of the ongoing OUT transfer, 0 if none */
+static atomic_t rx_ntb_usb;
+/* Set while reception waits for a free NTB */
+static atomic_t rx_waiting;
+static bool rx_enabled;
+
+static void ncm_rx_pool_free(struct net_buf *buf);
+
+/* Headers only, the data is in the NTB given in the user data */
+NET_BUF_POOL_DEFINE(ncm_rx_pool, CONFIG_CDC_NCM_RX_BUF_COUNT, 0,
+		    sizeof(uint8_t), ncm_rx_pool_free);
+
+static struct ncm_tx_ntb tx_ntb[2];
+/* NTB datagrams are added to, the other one is sent while tx_busy is set */
+static uint8_t tx_fill;
+static bool tx_busy;
+static uint16_t tx_sequence;
+static K_MUTEX_DEFINE(tx_lock);
+static K_SEM_DEFINE(tx_sem, 0, 1);
+
+struct usb_cdc_ncm_config {
+#ifdef CONFIG_USB_COMPOSITE_DEVICE
+	struct usb_association_descriptor iad;
+#endif
+	struct usb_if_descriptor if0;
+	struct cdc_header_descriptor if0_header;
+	struct cdc_union_descriptor if0_union;
+	struct cdc_ecm_descriptor if0_netfun_ecm;
+	struct cdc_ncm_descriptor if0_netfun_ncm;
+	struct usb_ep_descriptor if0_int_ep;
+
+	struct usb_if_descriptor if1_0;
+
+	struct usb_if_descriptor if1_1;
+	struct usb_ep_descriptor if1_1_in_ep;
+	struct usb_ep_descriptor if1_1_out_ep;
+} __packed;
+
+USBD_CLASS_DESCR_DEFINE(primary, 0) struct usb_cdc_ncm_config cdc_ncm_cfg = {
+#ifdef CONFIG_USB_COMPOSITE_DEVICE
+	.iad = {
+		.bLength = sizeof(struct usb_association_descriptor),
+		.bDescriptorType = USB_DESC_INTERFACE_ASSOC,
+		.bFirstInterface = 0,
+		.bInterfaceCount = 0x02,
+		.bFunctionClass = USB_BCC_CDC_CONTROL,
+		.bFunctionSubClass = NCM_SUBCLASS,
+		.bFunctionProtocol = 0,
+		.iFunction = 0,
+	},
+#endif
+	/* Interface descriptor 0 */
+	/* CDC Communication interface */
+	.if0 = {
+		.bLength = sizeof(struct usb_if_descriptor),
+		.bDescriptorType = USB_DESC_INTERFACE,
+		.bInterfaceNumber = 0,
+		.bAlternateSetting = 0,
+		.bNumEndpoints = 1,
+		.bInterfaceClass = USB_BCC_CDC_CONTROL,
+		.bInterfaceSubClass = NCM_SUBCLASS,
+		.bInterfaceProtocol = 0,
+		.iInterface = 0,
+	},
+	/* Header Functional Descriptor */
+	.if0_header = {
+		.bFunctionLength = sizeof(struct cdc_header_descriptor),
+		.bDescriptorType = USB_DESC_CS_INTERFACE,
+		.bDescriptorSubtype = HEADER_FUNC_DESC,
+		.bcdCDC = sys_cpu_to_le16(USB_SRN_1_1),
+	},
+	/* Union Functional Descriptor */
+	.if0_union = {
+		.bFunctionLength = sizeof(struct cdc_union_descriptor),
+		.bDescriptorType = USB_DESC_CS_INTERFACE,
+		.bDescriptorSubtype = UNION_FUNC_DESC,
+		.bControlInterface = 0,
+		.bSubordinateInterface0 = 1,
+	},
+	/* Ethernet Networking Functional descriptor */
+	.if0_netfun_ecm = {
+		.bFunctionLength = sizeof(struct cdc_ecm_descriptor),
+		.bDescriptorType = USB_DESC_CS_INTERFACE,
+		.bDescriptorSubtype = ETHERNET_FUNC_DESC,
+		.iMACAddress = 4,
+		.bmEthernetStatistics = sys_cpu_to_le32(0), /* None */
+		.wMaxSegmentSize = sys_cpu_to_le16(NET_ETH_MAX_FRAME_SIZE),
+		.wNumberMCFilters = sys_cpu_to_le16(0), /* None */
+		.bNumberPowerFilters = 0, /* No wake up */
+	},
+	/* NCM Functional descriptor */
+	.if0_netfun_ncm = {
+		.bFunctionLength = sizeof(struct cdc_ncm_descriptor),
+		.bDescriptorType = USB_DESC_CS_INTERFACE,
+		.bDescriptorSubtype = NCM_FUNC_DESC,
+		.bcdNcmVersion = sys_cpu_to_le16(0x0100),
+		.bmNetworkCapabilities = 0, /* Only the mandatory requests */
+	},
+	/* Notification EP Descriptor */
+	.if0_int_ep = {
+		.bLength = sizeof(struct usb_ep_descriptor),
+		.bDescriptorType = USB_DESC_ENDPOINT,
+		.bEndpointAddress = CDC_NCM_INT_EP_ADDR,
+		.bmAttributes = USB_DC_EP_INTERRUPT,
+		.wMaxPacketSize =
+			sys_cpu_to_le16(
+			CONFIG_CDC_NCM_INTERRUPT_EP_MPS),
+		.bInterval = 0x09,
+	},
+
+	/* Interface descriptor 1/0 */
+	/* CDC Data Interface */
+	.if1_0 = {
+		.bLength = sizeof(struct usb_if_descriptor),
+		.bDescriptorType = USB_DESC_INTERFACE,
+		.bInterfaceNumber = 1,
+		.bAlternateSetting = 0,
+		.bNumEndpoints = 0,
+		.bInterfaceClass = USB_BCC_CDC_DATA,
+		.bInterfaceSubClass = 0,
+		.bInterfaceProtocol = NCM_DATA_PROTOCOL,
+		.iInterface = 0,
+	},
+
+	/* Interface descriptor 1/1 */
+	/* CDC Data Interface */
+	.if1_1 = {
+		.bLength = sizeof(struct usb_if_descriptor),
+		.bDescriptorType = USB_DESC_INTERFACE,
+		.bInterfaceNumber = 1,
+		.bAlternateSetting = 1,
+		.bNumEndpoints = 2,
+		.bInterfaceClass = USB_BCC_CDC_DATA,
+		.bInterfaceSubClass = 0,
+		.bInterfaceProtocol = NCM_DATA_PROTOCOL,
+		.iInterface = 0,
+	},
+	/* Data Endpoint IN */
+	.if1_1_in_ep = {
+		.bLength = sizeof(struct usb_ep_descriptor),
+		.bDescriptorType = USB_DESC_ENDPOINT,
+		.bEndpointAddress = CDC_NCM_IN_EP_ADDR,
+		.bmAttributes = USB_DC_EP_BULK,
+		.wMaxPacketSize =
+			sys_cpu_to_le16(
+			CONFIG_CDC_NCM_BULK_EP_MPS),
+		.bInterval = 0x00,
+	},
+	/* Data Endpoint OUT */
+	.if1_1_out_ep = {
+		.bLength = sizeof(struct usb_ep_descriptor),
+		.bDescriptorType = USB_DESC_ENDPOINT,
+		.bEndpointAddress = CDC_NCM_OUT_EP_ADDR,
+		.bmAttributes = USB_DC_EP_BULK,
+		.wMaxPacketSize =
+			sys_cpu_to_le16(
+			CONFIG_CDC_NCM_BULK_EP_MPS),
+		.bInterval = 0x00,
+	},
+};
+
+static uint8_t ncm_get_first_iface_number(void)
+{
+	return cdc_ncm_cfg.if0.bInterfaceNumber;
+}
+
+static struct usb_ep_cfg_data ncm_ep_data[] = {
+	{
+		/* high-level transfer mgmt */
+		.ep_cb = usb_transfer_ep_callback,
+		.ep_addr = CDC_NCM_INT_EP_ADDR
+	},
+	{
+		/* high-level transfer mgmt */
+		.ep_cb = usb_transfer_ep_callback,
+		.ep_addr = CDC_NCM_OUT_EP_ADDR
+	},
+	{
+		/* high-level transfer mgmt */
+		.ep_cb = usb_transfer_ep_callback,
+		.ep_addr = CDC_NCM_IN_EP_ADDR
+	},
+};
+
+static int ncm_class_handler(struct usb_setup_packet *setup, int32_t *len,
+			     uint8_t **data)
+{
+	uint32_t size;
+
+	LOG_DBG("len %d req_type 0x%x req 0x%x enabled %u",
+		*len, setup->bmRequestType, setup->bRequest,
+		netusb_enabled());
+
+	/*
+	 * Unlike ECM, the host reads the NTB parameters before it selects
+	 * the data interface, so requests are handled while disabled.
+	 */
+	switch (setup->bRequest) {
+	case USB_CDC_GET_NTB_PARAMETERS:
+		*data = (uint8_t *)&ntb_params;
+		*len = sizeof(ntb_params);
+		return 0;
+	case USB_CDC_GET_NTB_FORMAT:
+		ntb_format_le = sys_cpu_to_le16(0);
+		*data = (uint8_t *)&ntb_format_le;
+		*len = sizeof(ntb_format_le);
+		return 0;
+	case USB_CDC_SET_NTB_FORMAT:
+		/* Only NTB-16 is supported */
+		return (setup->wValue == 0U) ? 0 : -EINVAL;
+	case USB_CDC_GET_NTB_INPUT_SIZE:
+		ntb_in_size_le = sys_cpu_to_le32(ntb_in_size);
+		*data = (uint8_t *)&ntb_in_size_le;
+		*len = sizeof(ntb_in_size_le);
+		return 0;
+	case USB_CDC_SET_NTB_INPUT_SIZE:
+		if (*len < (int32_t)sizeof(uint32_t)) {
+			return -EINVAL;
+		}
+
+		size = sys_get_le32(*data);
+		if (size < NCM_NTB_MIN_IN_SIZE ||
+		    size > CONFIG_CDC_NCM_NTB_SIZE) {
+			LOG_WRN("Unsupported NTB input size %u", size);
+			return -EINVAL;
+		}
+
+		LOG_DBG("NTB input size %u", size);
+		ntb_in_size = size;
+		return 0;
+	case USB_CDC_SET_ETH_PKT_FILTER:
+		LOG_INF("Set Interface %u Packet Filter 0x%04x not supported",
+			setup->wIndex, setup->wValue);
+		return 0;
+	default:
+		break;
+	}
+
+	return -ENOTSUP;
+}
+
+static void ncm_int_cb(uint8_t ep, int size, void *priv)
+{
+	LOG_DBG("EP 0x%x notification sent, %d", ep, size);
+}
+
+static void ncm_notify_connected(void)
+{
+	uint16_t iface = ncm_get_first_iface_number();
+	uint8_t ep = ncm_ep_data[NCM_INT_EP_IDX].ep_addr;
+
+	speed_notification.hdr.bmRequestType = 0xA1;
+	speed_notification.hdr.bNotificationType =
+		USB_CDC_CONNECTION_SPEED_CHANGE;
+	speed_notification.hdr.wValue = 0;
+	speed_notification.hdr.wIndex = sys_cpu_to_le16(iface);
+	speed_notification.hdr.wLength = sys_cpu_to_le16(8);
+	speed_notification.DLBitRate = sys_cpu_to_le32(NCM_BIT_RATE);
+	speed_notification.ULBitRate = sys_cpu_to_le32(NCM_BIT_RATE);
+
+	connection_notification.bmRequestType = 0xA1;
+	connection_notification.bNotificationType = USB_CDC_NETWORK_CONNECTION;
+	connection_notification.wValue = sys_cpu_to_le16(1);
+	connection_notification.wIndex = sys_cpu_to_le16(iface);
+	connection_notification.wLength = 0;
+
+	/* The host reports the link as down until notified */
+	if (usb_transfer(ep, (uint8_t *)&speed_notification,
+			 sizeof(speed_notification),
+			 USB_TRANS_WRITE | USB_TRANS_NO_ZLP | USB_TRANS_QUEUE,
+			 ncm_int_cb, NULL) ||
+	    usb_transfer(ep, (uint8_t *)&connection_notification,
+			 sizeof(connection_notification),
+			 USB_TRANS_WRITE | USB_TRANS_NO_ZLP | USB_TRANS_QUEUE,
+			 ncm_int_cb, NULL)) {
+		LOG_ERR("Failed to notify the connection");
+	}
+}
+
+static void ncm_read_cb(uint8_t ep, int size, void *priv);
+
+static bool ncm_rx_ntb_available(void)
+{
+	for (int i = 0; i < ARRAY_SIZE(rx_ntb); i++) {
+		if (atomic_get(&rx_ntb_refs[i]) == 0) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Start receiving into a free NTB, if there is one */
+static void ncm_rx_start(void)
+{
+	int ret;
+
+	do {
+		if (!rx_enabled) {
+			return;
+		}
+
+		for (int i = 0; i < ARRAY_SIZE(rx_ntb); i++) {
+			if (!atomic_cas(&rx_ntb_refs[i], 0, 1)) {
+				continue;
+			}
+
+			atomic_set(&rx_ntb_usb, i + 1);
+			ret = usb_transfer(ncm_ep_data[NCM_OUT_EP_IDX].ep_addr,
+					   rx_ntb[i], sizeof(rx_ntb[i]),
+					   USB_TRANS_READ, ncm_read_cb,
+					   UINT_TO_POINTER(i));
+			if (ret) {
+				LOG_ERR("Transfer failure %d", ret);
+				atomic_set(&rx_ntb_usb, 0);
+				atomic_set(&rx_ntb_refs[i], 0);
+			}
+
+			return;
+		}
+
+		/*
+		 * All NTBs hold datagrams, the first one released starts
+		 * reception again, unless it was released before waiting
+		 * was flagged.
+		 */
+		atomic_set(&rx_waiting, 1);
+	} while (ncm_rx_ntb_available() && atomic_cas(&rx_waiting, 1, 0));
+}
+
+static void ncm_rx_ntb_release(uint8_t idx)
+{
+	if (atomic_dec(&rx_ntb_refs[idx]) != 1) {
+		return;
+	}
+
+	if (atomic_cas(&rx_waiting, 1, 0)) {
+		ncm_rx_start();
+	}
+}
+
+static void ncm_rx_pool_free(struct net_buf *buf)
+{
+	uint8_t idx = *(uint8_t *)net_buf_user_data(buf);
+
+	net_buf_destroy(buf);
+	ncm_rx_ntb_release(idx);
+}
+
+static void ncm_rx_datagram(uint8_t idx, uint8_t *data, uint16_t len)
+{
+	struct net_pkt *pkt;
+	struct net_buf *buf;
+
+	pkt = net_pkt_rx_alloc_on_iface(netusb_net_iface(), K_FOREVER);
+	if (!pkt) {
+		LOG_ERR("no memory for network packet");
+		return;
+	}
+
+	buf = net_buf_alloc_with_data(&ncm_rx_pool, data, len, K_FOREVER);
+	if (!buf) {
+		LOG_ERR("no buffer for datagram");
+		net_pkt_unref(pkt);
+		return;
+	}
+
+	*(uint8_t *)net_buf_user_data(buf) = idx;
+	atomic_inc(&rx_ntb_refs[idx]);
+	net_pkt_append_buffer(pkt, buf);
+
+	if (VERBOSE_DEBUG) {
+		net_pkt_hexdump(pkt, ">");
+	}
+
+	netusb_recv(pkt);
+}
+
+static void ncm_rx_parse(uint8_t idx, size_t size)
+{
+	uint8_t *ntb = rx_ntb[idx];
+	const struct ncm_nth16 *nth = (void *)ntb;
+	const struct ncm_ndp16 *ndp;
+	uint16_t block_len;
+	uint16_t ndp_idx;
+	uint16_t ndp_len;
+	size_t dpe_count;
+
+	if (size < sizeof(*nth) ||
+	    sys_le32_to_cpu(nth->dwSignature) != NCM_NTH16_SIGNATURE ||
+	    sys_le16_to_cpu(nth->wHeaderLength) != sizeof(*nth)) {
+		LOG_WRN("Invalid NTB header, drop");
+		return;
+	}
+
+	block_len = sys_le16_to_cpu(nth->wBlockLength);
+	if (block_len > size) {
+		LOG_WRN("Invalid NTB length %u, received %zu", block_len, size);
+		return;
+	}
+
+	ndp_idx = sys_le16_to_cpu(nth->wNdpIndex);
+
+	for (int n = 0; ndp_idx && (n < NCM_RX_MAX_NDP); n++) {
+		if ((ndp_idx % NCM_ALIGN) ||
+		    (ndp_idx + sizeof(*ndp) > block_len)) {
+			LOG_WRN("Invalid NDP index %u", ndp_idx);
+			return;
+		}
+
+		ndp = (void *)&ntb[ndp_idx];
+		ndp_len = sys_le16_to_cpu(ndp->wLength);
+		if (sys_le32_to_cpu(ndp->dwSignature) != NCM_NDP16_SIGNATURE ||
+		    ndp_len < sizeof(*ndp) || (ndp_idx + ndp_len > block_len)) {
+			LOG_WRN("Invalid NDP at %u", ndp_idx);
+			return;
+		}
+
+		dpe_count = (ndp_len - sizeof(*ndp)) / sizeof(ndp->dpe[0]);
+
+		for (size_t i = 0; i < dpe_count; i++) {
+			uint16_t dg_idx = sys_le16_to_cpu(ndp->dpe[i].wDatagramIndex);
+			uint16_t dg_len = sys_le16_to_cpu(ndp->dpe[i].wDatagramLength);
+
+			/* The table ends with a null entry */
+			if (!dg_idx || !dg_len) {
+				break;
+			}
+
+			if (dg_idx + dg_len > block_len) {
+				LOG_WRN("Invalid datagram %u/%u, drop",
+					dg_idx, dg_len);
+				continue;
+			}
+
+			ncm_rx_datagram(idx, &ntb[dg_idx], dg_len);
+		}
+
+		ndp_idx = sys_le16_to_cpu(ndp->wNextNdpIndex);
+	}
+}
+
+static void ncm_read_cb(uint8_t ep, int size, void *priv)
+{
+	uint8_t idx = POINTER_TO_UINT(priv);
+
+	/* The NTB is released by ncm_connect() once disconnected */
+	if (!atomic_cas(&rx_ntb_usb, idx + 1, 0)) {
+		return;
+	}
+
+	/* Keep the endpoint busy while the datagrams are handed over */
+	ncm_rx_start();
+
+	if (size > 0) {
+		ncm_rx_parse(idx, size);
+	}
+
+	ncm_rx_ntb_release(idx);
+}
+
+static void ncm_tx_reset(struct ncm_tx_ntb *ntb)
+{
+	ntb->len = sizeof(struct ncm_nth16);
+	ntb->count = 0U;
+}
+
+static bool ncm_tx_fits(struct ncm_tx_ntb *ntb, size_t len)
+{
+	/* Datagrams are followed by the NDP and its null entry */
+	size_t ndp_len = sizeof(struct ncm_ndp16) +
+			 (ntb->count + 2) * sizeof(struct ncm_dpe16);
+
+	return (ntb->count < ARRAY_SIZE(ntb->dpe)) &&
+	       (ROUND_UP(ntb->len + len, NCM_ALIGN) + ndp_len <= ntb_in_size);
+}
+
+/* Add the NDP after the datagrams, returns the NTB length */
+static size_t ncm_tx_finalize(struct ncm_tx_ntb *ntb)
+{
+	struct ncm_nth16 *nth = (void *)ntb->data;
+	struct ncm_ndp16 *ndp = (void *)&ntb->data[ntb->len];
+	size_t ndp_len = sizeof(*ndp) + (ntb->count + 1) * sizeof(ndp->dpe[0]);
+
+	ndp->dwSignature = sys_cpu_to_le32(NCM_NDP16_SIGNATURE);
+	ndp->wLength = sys_cpu_to_le16(ndp_len);
+	ndp->wNextNdpIndex = 0;
+	memcpy(ndp->dpe, ntb->dpe, ntb->count * sizeof(ndp->dpe[0]));
+	memset(&ndp->dpe[ntb->count], 0, sizeof(ndp->dpe[0]));
+
+	nth->dwSignature = sys_cpu_to_le32(NCM_NTH16_SIGNATURE);
+	nth->wHeaderLength = sys_cpu_to_le16(sizeof(*nth));
+	nth->wSequence = sys_cpu_to_le16(tx_sequence++);
+	nth->wBlockLength = sys_cpu_to_le16(ntb->len + ndp_len);
+	nth->wNdpIndex = sys_cpu_to_le16(ntb->len);
+
+	return ntb->len + ndp_len;
+}
+
+static void ncm_write_cb(uint8_t ep, int size, void *priv);
+
+/* Hand the NTB being filled over to the host, called with tx_lock held */
+static int ncm_tx_start(void)
+{
+	struct ncm_tx_ntb *ntb = &tx_ntb[tx_fill];
+	size_t len = ncm_tx_finalize(ntb);
+	int ret;
+
+	tx_fill ^= 1U;
+	ncm_tx_reset(&tx_ntb[tx_fill]);
+
+	tx_busy = true;
+	ret = usb_transfer(ncm_ep_data[NCM_IN_EP_IDX].ep_addr, ntb->data, len,
+			   USB_TRANS_WRITE, ncm_write_cb, NULL);
+	if (ret) {
+		LOG_ERR("Transfer failure");
+		tx_busy = false;
+	}
+
+	return ret;
+}
+
+static void ncm_write_cb(uint8_t ep, int size, void *priv)
+{
+	if (size < 0) {
+		LOG_ERR("EP 0x%x transfer failure %d", ep, size);
+	}
+
+	/* Datagrams queued meanwhile are sent right away */
+	k_mutex_lock(&tx_lock, K_FOREVER);
+
+	if (tx_ntb[tx_fill].count) {
+		(void)ncm_tx_start();
+	} else {
+		tx_busy = false;
+	}
+
+	k_mutex_unlock(&tx_lock);
+
+	k_sem_give(&tx_sem);
+}
+
+static int ncm_send(struct net_pkt *pkt)
+{
+	size_t len = net_pkt_get_len(pkt);
+	struct ncm_tx_ntb *ntb;
+	int ret = 0;
+
+	if (VERBOSE_DEBUG) {
+		net_pkt_hexdump(pkt, "<");
+	}
+
+	if (len > NET_ETH_MAX_FRAME_SIZE) {
+		LOG_WRN("Trying to send too large packet, drop");
+		return -ENOMEM;
+	}
+
+	k_mutex_lock(&tx_lock, K_FOREVER);
+
+	/*
+	 * Datagrams are added to the NTB being filled while the previous one
+	 * is sent, wait for the transfer to complete if it is full.
+	 */
+	while (!ncm_tx_fits(&tx_ntb[tx_fill], len)) {
+		k_mutex_unlock(&tx_lock);
+		k_sem_take(&tx_sem, K_FOREVER);
+		k_mutex_lock(&tx_lock, K_FOREVER);
+	}
+
+	ntb = &tx_ntb[tx_fill];
+
+	if (net_pkt_read(pkt, &ntb->data[ntb->len], len)) {
+		ret = -ENOBUFS;
+		goto out;
+	}
+
+	ntb->dpe[ntb->count].wDatagramIndex = sys_cpu_to_le16(ntb->len);
+	ntb->dpe[ntb->count].wDatagramLength = sys_cpu_to_le16(len);
+	ntb->count++;
+	ntb->len = ROUND_UP(ntb->len + len, NCM_ALIGN);
+
+	if (!tx_busy) {
+		ret = ncm_tx_start();
+	}
+
+out:
+	k_mutex_unlock(&tx_lock);
+
+	return ret;
+}
+
+static int ncm_connect(bool connected)
+{
+	atomic_val_t rx_idx;
+
+	if (connected) {
+		rx_enabled = true;
+		ncm_rx_start();
+		ncm_notify_connected();
+	} else {
+		rx_enabled = false;
+
+		/* Cancel any transfer */
+		usb_cancel_transfer(ncm_ep_data[NCM_INT_EP_IDX].ep_addr);
+		usb_cancel_transfer(ncm_ep_data[NCM_OUT_EP_IDX].ep_addr);
+		usb_cancel_transfer(ncm_ep_data[NCM_IN_EP_IDX].ep_addr);
+
+		/* Cancelled transfers do not complete */
+		rx_idx = atomic_set(&rx_ntb_usb, 0);
+		if (rx_idx) {
+			ncm_rx_ntb_release(rx_idx - 1);
+		}
+
+		k_mutex_lock(&tx_lock, K_FOREVER);
+		ncm_tx_reset(&tx_ntb[0]);
+		ncm_tx_reset(&tx_ntb[1]);
+		tx_busy = false;
+		k_mutex_unlock(&tx_lock);
+
+		k_sem_give(&tx_sem);
+	}
+
+	return 0;
+}
+
+static struct netusb_function ncm_function = {
+	.connect_media = ncm_connect,
+	.send_pkt = ncm_send,
+};
+
+static inline void ncm_status_interface(const uint8_t *desc)
+{
+	const struct usb_if_descriptor *if_desc = (void *)desc;
+	uint8_t iface_num = if_desc->bInterfaceNumber;
+	uint8_t alt_set = if_desc->bAlternateSetting;
+
+	LOG_DBG("iface %u alt_set %u", iface_num, if_desc->bAlternateSetting);
+
+	/* First interface is CDC Comm interface */
+	if (iface_num != ncm_get_first_iface_number() + 1 || !alt_set) {
+		LOG_DBG("Skip iface_num %u alt_set %u", iface_num, alt_set);
+		return;
+	}
+
+	netusb_enable(&ncm_function);
+}
+
+static void ncm_status_cb(struct usb_cfg_data *cfg,
+			  enum usb_dc_status_code status,
+			  const uint8_t *param)
+{
+	ARG_UNUSED(cfg);
+
+	/* Check the USB status and do needed action if required */
+	switch (status) {
+	case USB_DC_DISCONNECTED:
+		LOG_DBG("USB device disconnected");
+		netusb_disable();
+		break;
+
+	case USB_DC_INTERFACE:
+		LOG_DBG("USB interface selected");
+		ncm_status_interface(param);
+		break;
+
+	case USB_DC_ERROR:
+	case USB_DC_RESET:
+	case USB_DC_CONNECTED:
+	case USB_DC_CONFIGURED:
+	case USB_DC_SUSPEND:
+	case USB_DC_RESUME:
+		LOG_DBG("USB unhandled state: %d", status);
+		break;
+
+	case USB_DC_SOF:
+		break;
+
+	case USB_DC_UNKNOWN:
+	default:
+		LOG_DBG("USB unknown state: %d", status);
+		break;
+	}
+}
+
+struct usb_cdc_ncm_mac_descr {
+	uint8_t bLength;
+	uint8_t bDescriptorType;
+	uint8_t bString[USB_BSTRING_LENGTH(CONFIG_USB_DEVICE_NETWORK_NCM_MAC)];
+} __packed;
+
+USBD_STRING_DESCR_USER_DEFINE(primary) struct usb_cdc_ncm_mac_descr ncm_utf16le_mac = {
+	.bLength = USB_STRING_DESCRIPTOR_LENGTH(
+			CONFIG_USB_DEVICE_NETWORK_NCM_MAC),
+	.bDescriptorType = USB_DESC_STRING,
+	.bString = CONFIG_USB_DEVICE_NETWORK_NCM_MAC
+};
+
+static void ncm_interface_config(struct usb_desc_header *head,
+				 uint8_t bInterfaceNumber)
+{
+	int idx = usb_get_str_descriptor_idx(&ncm_utf16le_mac);
+
+	ARG_UNUSED(head);
+
+	if (idx) {
+		LOG_DBG("fixup string %d", idx);
+		cdc_ncm_cfg.if0_netfun_ecm.iMACAddress = idx;
+	}
+
+	cdc_ncm_cfg.if0.bInterfaceNumber = bInterfaceNumber;
+	cdc_ncm_cfg.if0_union.bControlInterface = bInterfaceNumber;
+	cdc_ncm_cfg.if0_union.bSubordinateInterface0 = bInterfaceNumber + 1;
+	cdc_ncm_cfg.if1_0.bInterfaceNumber = bInterfaceNumber + 1;
+	cdc_ncm_cfg.if1_1.bInterfaceNumber = bInterfaceNumber + 1;
+#ifdef CONFIG_USB_COMPOSITE_DEVICE
+	cdc_ncm_cfg.iad.bFirstInterface = bInterfaceNumber;
+#endif
+}
+
+USBD_DEFINE_CFG_DATA(cdc_ncm_config) = {
+	.usb_device_description = NULL,
+	.interface_config = ncm_interface_config,
+	.interface_descriptor = &cdc_ncm_cfg.if0,
+	.cb_usb_status = ncm_status_cb,
+	.interface = {
+		.class_handler = ncm_class_handler,
+		.custom_handler = NULL,
+		.vendor_handler = NULL,
+	},
+	.num_endpoints = ARRAY_SIZE(ncm_ep_data),
+	.endpoint = ncm_ep_data,
+};
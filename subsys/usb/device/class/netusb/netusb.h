@@ -12,6 +12,10 @@
 #define CDC_ECM_IN_EP_ADDR		0x82
 #define CDC_ECM_OUT_EP_ADDR		0x01
 
+#define CDC_NCM_INT_EP_ADDR		0x83
+#define CDC_NCM_IN_EP_ADDR		0x82
+#define CDC_NCM_OUT_EP_ADDR		0x01
+
 #define CDC_EEM_OUT_EP_ADDR		0x01
 #define CDC_EEM_IN_EP_ADDR		0x82
 
@@ -42,16 +42,22 @@ struct usb_transfer_data {
 	struct k_work work;
 	/** Transfer flags */
 	unsigned int flags;
+	/** Node in the queue of transfers waiting for their endpoint */
+	sys_snode_t node;
 };
 
 /** Max number of parallel transfers */
 static struct usb_transfer_data ut_data[CONFIG_USB_MAX_NUM_TRANSFERS];
 
+/** Queued transfers, in submission order, status -EAGAIN */
+static sys_slist_t ut_queue = SYS_SLIST_STATIC_INIT(&ut_queue);
+
 /* Transfer management */
 static struct usb_transfer_data *usb_ep_get_transfer(uint8_t ep)
 {
 	for (int i = 0; i < ARRAY_SIZE(ut_data); i++) {
-		if (ut_data[i].ep == ep && ut_data[i].status != 0) {
+		if (ut_data[i].ep == ep && ut_data[i].status != 0 &&
+		    ut_data[i].status != -EAGAIN) {
 			return &ut_data[i];
 		}
 	}
@@ -59,6 +65,57 @@ static struct usb_transfer_data *usb_ep_get_transfer(uint8_t ep)
 	return NULL;
 }
 
+static bool usb_ep_has_queued(uint8_t ep)
+{
+	struct usb_transfer_data *trans;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&ut_queue, trans, node) {
+		if (trans->ep == ep) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Must be called with interrupts locked */
+static int usb_transfer_start(struct usb_transfer_data *trans)
+{
+	trans->status = -EBUSY;
+
+	if (trans->flags & USB_TRANS_WRITE) {
+		/* start writing first chunk */
+		k_work_submit_to_queue(&USB_WORK_Q, &trans->work);
+		return 0;
+	}
+
+	/* ready to read, clear NAK */
+	return usb_dc_ep_read_continue(trans->ep);
+}
+
+/* Start the oldest transfer queued on the endpoint, if any */
+static void usb_transfer_start_queued(uint8_t ep)
+{
+	struct usb_transfer_data *trans;
+	unsigned int key;
+
+	key = irq_lock();
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&ut_queue, trans, node) {
+		if (trans->ep == ep) {
+			sys_slist_find_and_remove(&ut_queue, &trans->node);
+			LOG_DBG("Start queued transfer, ep 0x%02x", ep);
+			if (usb_transfer_start(trans)) {
+				trans->status = -EINVAL;
+				k_work_submit_to_queue(&USB_WORK_Q, &trans->work);
+			}
+			break;
+		}
+	}
+
+	irq_unlock(key);
+}
+
 bool usb_transfer_is_busy(uint8_t ep)
 {
 	struct usb_transfer_data *trans = usb_ep_get_transfer(ep);
@@ -150,6 +207,11 @@ done:
 		trans->cb = NULL;
 		k_sem_give(&trans->sem);
 
+		/* Keep the endpoint busy before handing over the data */
+		if (trans->status != -ECANCELED) {
+			usb_transfer_start_queued(ep);
+		}
+
 		/* Transfer completion callback */
 		if (trans->status != -ECANCELED) {
 			cb(ep, tsize, priv);
@@ -200,8 +262,8 @@ int usb_transfer(uint8_t ep, uint8_t *data, size_t dlen, unsigned int flags,
 	struct usb_transfer_data *trans = NULL;
 	int i, key, ret = 0;
 
-	/* Parallel transfer to same endpoint is not supported. */
-	if (usb_transfer_is_busy(ep)) {
+	/* Parallel transfers to the same endpoint are only queued on request */
+	if (!(flags & USB_TRANS_QUEUE) && usb_transfer_is_busy(ep)) {
 		return -EBUSY;
 	}
 
@@ -239,26 +301,42 @@ int usb_transfer(uint8_t ep, uint8_t *data, size_t dlen, unsigned int flags,
 	trans->cb = cb;
 	trans->flags = flags;
 	trans->priv = cb_data;
-	trans->status = -EBUSY;
 
 	if (usb_dc_ep_mps(ep) && (dlen % usb_dc_ep_mps(ep))) {
 		/* no need to send ZLP since last packet will be a short one */
 		trans->flags |= USB_TRANS_NO_ZLP;
 	}
 
-	if (flags & USB_TRANS_WRITE) {
-		/* start writing first chunk */
-		k_work_submit_to_queue(&USB_WORK_Q, &trans->work);
-	} else {
-		/* ready to read, clear NAK */
-		ret = usb_dc_ep_read_continue(ep);
+	if ((flags & USB_TRANS_QUEUE) &&
+	    (usb_transfer_is_busy(ep) || usb_ep_has_queued(ep))) {
+		/* started on completion of the previous transfers */
+		LOG_DBG("Transfer queued, ep 0x%02x", ep);
+		trans->status = -EAGAIN;
+		sys_slist_append(&ut_queue, &trans->node);
+		goto done;
 	}
 
+	ret = usb_transfer_start(trans);
+
 done:
 	irq_unlock(key);
 	return ret;
 }
 
+/* Must be called with interrupts locked */
+static void usb_cancel_queued(uint8_t ep)
+{
+	struct usb_transfer_data *trans, *next;
+
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&ut_queue, trans, next, node) {
+		if (trans->ep == ep) {
+			sys_slist_find_and_remove(&ut_queue, &trans->node);
+			trans->status = -ECANCELED;
+			k_work_submit_to_queue(&USB_WORK_Q, &trans->work);
+		}
+	}
+}
+
 void usb_cancel_transfer(uint8_t ep)
 {
 	struct usb_transfer_data *trans;
@@ -266,6 +344,8 @@ void usb_cancel_transfer(uint8_t ep)
 
 	key = irq_lock();
 
+	usb_cancel_queued(ep);
+
 	trans = usb_ep_get_transfer(ep);
 	if (!trans) {
 		goto done;
@@ -290,7 +370,11 @@ void usb_cancel_transfers(void)
 
 		key = irq_lock();
 
-		if (trans->status == -EBUSY) {
+		if (trans->status == -EAGAIN) {
+			sys_slist_find_and_remove(&ut_queue, &trans->node);
+		}
+
+		if (trans->status == -EBUSY || trans->status == -EAGAIN) {
 			trans->status = -ECANCELED;
 			k_work_submit_to_queue(&USB_WORK_Q, &trans->work);
 			LOG_DBG("Cancel transfer for ep: 0x%02x", trans->ep);
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/sys/btree.h>
+
+#define TREE_SIZE 512
+/* zephyr can't do floating-point arithmetic, so manual:
+ * max_height = log_t((TREE_SIZE + 1) / 2) = 4 edges for t = 4, and a
+ * binary search in a node takes at most log2(2t) = 3 comparisons.
+ */
+const static uint32_t max_height = 4;
+const static uint32_t max_node_cmp = 3;
+
+static struct sys_btree_node nodes[SYS_BTREE_NODES(TREE_SIZE)];
+static struct sys_btree tree;
+static uint32_t values[TREE_SIZE];
+static uint32_t n_cmp;
+
+static int value_cmp(const void *key, const void *item)
+{
+	uint32_t a = *(const uint32_t *)key;
+	uint32_t b = *(const uint32_t *)item;
+
+	n_cmp++;
+
+	return (a > b) - (a < b);
+}
+
+static uint32_t tree_height(void)
+{
+	const struct sys_btree_node *node = tree.root;
+	uint32_t height = 0;
+
+	while (!node->leaf) {
+		node = node->children[0];
+		height++;
+	}
+
+	return height;
+}
+
+/**
+ * @brief Test some operations of the B-tree are running in
+ * logarithmic time
+ *
+ * @details
+ * Test Objective:
+ * - The insert, find and remove operations of the B-tree visit at
+ * most log_t(N) nodes, and only do a binary search in each of them.
+ *
+ * Test Procedure:
+ * -# Insert TREE_SIZE items in ascending order, the worst case for
+ * node splits, and check the height of the tree.
+ * -# Count the comparisons made when looking up and removing every
+ * item, and check they stay under the worst case.
+ *
+ * @see sys_btree_insert(), sys_btree_find(), sys_btree_remove()
+ */
+ZTEST(btree_perf, test_btree_perf)
+{
+	uint32_t max_cmp = (max_height + 1) * max_node_cmp;
+
+	sys_btree_init(&tree, nodes, ARRAY_SIZE(nodes), value_cmp);
+
+	for (uint32_t i = 0; i < TREE_SIZE; i++) {
+		values[i] = i;
+		zassert_ok(sys_btree_insert(&tree, &values[i]));
+	}
+
+	zassert_true(tree_height() <= max_height, "B-tree is too high");
+
+	for (uint32_t i = 0; i < TREE_SIZE; i++) {
+		n_cmp = 0;
+		zassert_equal_ptr(sys_btree_find(&tree, &i), &values[i]);
+		zassert_true(n_cmp <= max_cmp, "Lookup took %u comparisons",
+			     n_cmp);
+	}
+
+	/* Removal may look up a second item when refilling nodes */
+	for (uint32_t i = 0; i < TREE_SIZE; i++) {
+		n_cmp = 0;
+		zassert_equal_ptr(sys_btree_remove(&tree, &i), &values[i]);
+		zassert_true(n_cmp <= 2 * max_cmp, "Removal took %u comparisons",
+			     n_cmp);
+	}
+
+	zassert_equal(sys_btree_size(&tree), 0);
+}
+
+ZTEST_SUITE(btree_perf, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/sys/htable.h>
+
+#define TABLE_SIZE 512
+#define BUCKETS 256
+/* With a good hash, chains of N / BUCKETS nodes on average rarely grow
+ * longer than a few times that.
+ */
+#define MAX_CHAIN 12
+
+struct container_node {
+	struct sys_htable_node node;
+	uint32_t key;
+};
+
+static struct container_node entries[TABLE_SIZE];
+static struct sys_htable_node *buckets[BUCKETS];
+static struct sys_htable_node *big_buckets[2 * BUCKETS];
+static struct sys_htable table;
+static uint32_t n_eq;
+
+static uint32_t key_hash(uint32_t key)
+{
+	return sys_htable_hash(SYS_HTABLE_HASH_INIT, &key, sizeof(key));
+}
+
+static bool key_eq(const struct sys_htable_node *node, const void *key)
+{
+	n_eq++;
+
+	return CONTAINER_OF(node, struct container_node, node)->key ==
+	       *(const uint32_t *)key;
+}
+
+static uint32_t max_chain(void)
+{
+	uint32_t longest = 0;
+
+	for (uint32_t i = 0; i <= table.mask; i++) {
+		uint32_t len = 0;
+
+		for (struct sys_htable_node *node = table.buckets[i];
+		     node != NULL; node = node->next) {
+			len++;
+		}
+
+		longest = MAX(longest, len);
+	}
+
+	return longest;
+}
+
+/**
+ * @brief Test some operations of the hash table are running in
+ * constant time
+ *
+ * @details
+ * Test Objective:
+ * - Lookups in the hash table only compare the keys of nodes sharing
+ * the hash, and chains stay short, compared to the N / 2 comparisons
+ * of a linear scan.
+ *
+ * Test Procedure:
+ * -# Insert TABLE_SIZE nodes with sequential keys, the usual case for
+ * addresses and identifiers, and check the longest chain.
+ * -# Count the key comparisons of successful and failed lookups.
+ * -# Move the table to twice as many buckets and check the chains
+ * get shorter and all nodes are still found.
+ *
+ * @see sys_htable_insert(), sys_htable_find(), sys_htable_rehash()
+ */
+ZTEST(htable_perf, test_htable_perf)
+{
+	uint32_t chain;
+	uint32_t key;
+
+	sys_htable_init(&table, buckets, ARRAY_SIZE(buckets));
+
+	for (uint32_t i = 0; i < TABLE_SIZE; i++) {
+		entries[i].key = i;
+		sys_htable_insert(&table, &entries[i].node, key_hash(i));
+	}
+
+	zassert_equal(sys_htable_size(&table), TABLE_SIZE);
+	chain = max_chain();
+	zassert_true(chain <= MAX_CHAIN, "Longest chain is %u", chain);
+
+	n_eq = 0;
+	for (key = 0; key < TABLE_SIZE; key++) {
+		zassert_equal_ptr(sys_htable_find(&table, key_hash(key), &key,
+						  key_eq),
+				  &entries[key].node);
+	}
+	zassert_equal(n_eq, TABLE_SIZE, "Keys compared %u times", n_eq);
+
+	n_eq = 0;
+	for (key = TABLE_SIZE; key < 2 * TABLE_SIZE; key++) {
+		zassert_is_null(sys_htable_find(&table, key_hash(key), &key,
+						key_eq));
+	}
+	zassert_equal(n_eq, 0, "Keys compared %u times", n_eq);
+
+	sys_htable_rehash(&table, big_buckets, ARRAY_SIZE(big_buckets));
+	zassert_true(max_chain() <= chain, "Chains grew when rehashing");
+
+	for (key = 0; key < TABLE_SIZE; key++) {
+		zassert_true(sys_htable_remove(&table, &entries[key].node));
+		zassert_is_null(sys_htable_find(&table, key_hash(key), &key,
+						key_eq));
+	}
+
+	zassert_equal(sys_htable_size(&table), 0);
+}
+
+ZTEST_SUITE(htable_perf, NULL, NULL, NULL, NULL, NULL);
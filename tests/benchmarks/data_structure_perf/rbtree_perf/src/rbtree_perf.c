@@ -207,4 +207,82 @@ ZTEST(rbtree_perf, test_rbtree_perf)
 	verify_rbtree_perf(root, test);
 }
 
+static struct rbnode build_nodes[TREE_SIZE];
+static struct rbnode *sorted_nodes[TREE_SIZE];
+
+static bool build_lessthan(struct rbnode *a, struct rbnode *b)
+{
+	return a < b;
+}
+
+static uint32_t walk_cycles(struct rbtree *t)
+{
+	uint32_t start = k_cycle_get_32();
+	struct rbnode *n;
+	uint32_t count = 0;
+
+	RB_FOR_EACH(t, n) {
+		count++;
+	}
+
+	zassert_equal(count, TREE_SIZE, "walked %u nodes", count);
+
+	return k_cycle_get_32() - start;
+}
+
+/**
+ * @brief Test building a rbtree from sorted nodes
+ *
+ * @details
+ * Test Objective:
+ * - A tree built with rb_build() is perfectly balanced, and building
+ * it is faster than inserting the same nodes one by one.
+ *
+ * Test Procedure:
+ * -# Insert TREE_SIZE sorted nodes one by one and walk the tree,
+ * measuring the cycles taken.
+ * -# Build a tree from the same nodes, check the height of its
+ * extreme nodes is within log2(N) + 1 and walk it.
+ * -# Print the measurements for comparison between configurations,
+ * e.g. with and without CONFIG_RBTREE_PARENT_POINTERS.
+ *
+ * @ingroup lib_rbtree_tests
+ *
+ * @see rb_build(), RB_FOR_EACH()
+ */
+ZTEST(rbtree_perf, test_rbtree_build_perf)
+{
+	struct rbtree build_tree = { .lessthan_fn = build_lessthan };
+	uint32_t insert_cyc, build_cyc, walk_cyc;
+	struct rbnode *n;
+	uint32_t height;
+
+	for (uint32_t i = 0; i < TREE_SIZE; i++) {
+		sorted_nodes[i] = &build_nodes[i];
+	}
+
+	insert_cyc = k_cycle_get_32();
+	for (uint32_t i = 0; i < TREE_SIZE; i++) {
+		rb_insert(&build_tree, &build_nodes[i]);
+	}
+	insert_cyc = k_cycle_get_32() - insert_cyc;
+	walk_cyc = walk_cycles(&build_tree);
+
+	TC_PRINT("insert: %u cycles, walk: %u cycles\n", insert_cyc, walk_cyc);
+
+	build_cyc = k_cycle_get_32();
+	rb_build(&build_tree, sorted_nodes, TREE_SIZE);
+	build_cyc = k_cycle_get_32() - build_cyc;
+	walk_cyc = walk_cycles(&build_tree);
+
+	TC_PRINT("build: %u cycles, walk: %u cycles\n", build_cyc, walk_cyc);
+
+	/* Balanced: log2(TREE_SIZE) = 9 levels below the root */
+	n = build_tree.root;
+	for (height = 0; z_rb_child(n, 0U) != NULL; height++) {
+		n = z_rb_child(n, 0U);
+	}
+	zassert_true(height <= dlog_N / 2, "built tree too high");
+}
+
 ZTEST_SUITE(rbtree_perf, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief Measure the cost of submitting work from an ISR
+ *
+ * This file contains a test that measures the time spent in k_work_submit()
+ * by an interrupt handler queueing a burst of work items, and the time from
+ * the end of that burst to the last item being handled by the system work
+ * queue.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/irq_offload.h>
+
+#include "utils.h"
+
+#define NUM_ITEMS 16
+
+static struct k_work items[NUM_ITEMS];
+static timing_t timestamp_start;
+static timing_t timestamp_end;
+static uint64_t submit_cycles;
+static int handled;
+
+K_SEM_DEFINE(WORKDONESEMA, 0, 1);
+
+static void work_handler(struct k_work *item)
+{
+	ARG_UNUSED(item);
+
+	if (++handled == NUM_ITEMS) {
+		timestamp_end = timing_counter_get();
+		k_sem_give(&WORKDONESEMA);
+	}
+}
+
+static void submit_isr(const void *unused)
+{
+	ARG_UNUSED(unused);
+
+	for (int i = 0; i < NUM_ITEMS; i++) {
+		timing_t start = timing_counter_get();
+
+		k_work_submit(&items[i]);
+		timestamp_start = timing_counter_get();
+		submit_cycles += timing_cycles_get(&start, &timestamp_start);
+	}
+}
+
+/**
+ *
+ * @brief The test main function
+ *
+ * @return 0 on success
+ */
+int int_to_work_submit(void)
+{
+	uint32_t diff;
+
+	for (int i = 0; i < NUM_ITEMS; i++) {
+		k_work_init(&items[i], work_handler);
+	}
+
+	handled = 0;
+	submit_cycles = 0;
+
+	timing_start();
+	TICK_SYNCH();
+	irq_offload(submit_isr, NULL);
+	k_sem_take(&WORKDONESEMA, K_FOREVER);
+	timing_stop();
+
+	PRINT_STATS_AVG("Average time to submit work from ISR",
+			(uint32_t)submit_cycles, NUM_ITEMS);
+
+	diff = timing_cycles_get(&timestamp_start, &timestamp_end);
+	PRINT_STATS("Time from ISR submitting work to completion of the burst",
+		    diff);
+
+	return 0;
+}
@@ -21,6 +21,7 @@ int error_count; /* track number of errors */
 extern void thread_switch_yield(void);
 extern void int_to_thread(void);
 extern void int_to_thread_evt(void);
+extern void int_to_work_submit(void);
 extern void sema_test_signal(void);
 extern void mutex_lock_unlock(void);
 extern int coop_ctx_switch(void);
@@ -50,6 +51,8 @@ void test_thread(void *arg1, void *arg2, void *arg3)
 
 	int_to_thread_evt();
 
+	int_to_work_submit();
+
 	suspend_resume();
 
 	sema_test_signal();
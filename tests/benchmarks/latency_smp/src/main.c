@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+#include <stdlib.h>
+
+/* Each worker times N_SAMPLES operations one by one, the samples of all
+ * workers are then merged to compute the percentiles.
+ */
+#define N_SAMPLES 1000
+#define STACK_SIZE 1024
+#define HEAP_BLOCK_SIZE 64
+#define NUM_CPUS CONFIG_MP_NUM_CPUS
+
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, NUM_CPUS, STACK_SIZE);
+static struct k_thread worker_threads[NUM_CPUS];
+
+static K_THREAD_STACK_DEFINE(wq_stack, STACK_SIZE);
+static struct k_work_q bench_wq;
+
+static uint32_t samples[NUM_CPUS * N_SAMPLES];
+static atomic_t ready;
+static atomic_t failures;
+
+K_SEM_DEFINE(bench_sem, 0, K_SEM_MAX_LIMIT);
+K_MUTEX_DEFINE(bench_mutex);
+K_MSGQ_DEFINE(bench_msgq, sizeof(uint32_t), NUM_CPUS, 4);
+K_MEM_SLAB_DEFINE_STATIC(bench_slab, 32, NUM_CPUS, 4);
+K_HEAP_DEFINE(bench_heap, 512 + NUM_CPUS * HEAP_BLOCK_SIZE * 2);
+
+static struct k_work works[NUM_CPUS];
+static struct k_work_sync work_syncs[NUM_CPUS];
+static struct k_timer timers[NUM_CPUS];
+
+static void sem_op(unsigned int id)
+{
+	k_sem_give(&bench_sem);
+	if (k_sem_take(&bench_sem, K_NO_WAIT) != 0) {
+		atomic_inc(&failures);
+	}
+}
+
+static void mutex_op(unsigned int id)
+{
+	(void)k_mutex_lock(&bench_mutex, K_FOREVER);
+	(void)k_mutex_unlock(&bench_mutex);
+}
+
+/* The queue holds one message per worker, and every worker takes one
+ * message after putting one, so neither call ever waits.
+ */
+static void msgq_op(unsigned int id)
+{
+	uint32_t msg = id;
+
+	if (k_msgq_put(&bench_msgq, &msg, K_NO_WAIT) != 0 ||
+	    k_msgq_get(&bench_msgq, &msg, K_NO_WAIT) != 0) {
+		atomic_inc(&failures);
+	}
+}
+
+static void mem_slab_op(unsigned int id)
+{
+	void *block;
+
+	if (k_mem_slab_alloc(&bench_slab, &block, K_NO_WAIT) != 0) {
+		atomic_inc(&failures);
+		return;
+	}
+
+	k_mem_slab_free(&bench_slab, &block);
+}
+
+static void heap_op(unsigned int id)
+{
+	void *block = k_heap_alloc(&bench_heap, HEAP_BLOCK_SIZE, K_NO_WAIT);
+
+	if (block == NULL) {
+		atomic_inc(&failures);
+		return;
+	}
+
+	k_heap_free(&bench_heap, block);
+}
+
+static void work_handler(struct k_work *work)
+{
+}
+
+/* Submission plus the round trip through the work queue thread */
+static void work_op(unsigned int id)
+{
+	if (k_work_submit_to_queue(&bench_wq, &works[id]) < 0) {
+		atomic_inc(&failures);
+	}
+
+	(void)k_work_flush(&works[id], &work_syncs[id]);
+}
+
+/* Insertion into and removal from the timeout queue */
+static void timeout_op(unsigned int id)
+{
+	k_timer_start(&timers[id], K_SECONDS(100), K_NO_WAIT);
+	k_timer_stop(&timers[id]);
+}
+
+struct bench {
+	const char *name;
+	void (*op)(unsigned int id);
+};
+
+static const struct bench benches[] = {
+	{ "sem_give_take", sem_op },
+	{ "mutex_lock_unlock", mutex_op },
+	{ "msgq_put_get", msgq_op },
+	{ "mem_slab_alloc_free", mem_slab_op },
+	{ "heap_alloc_free", heap_op },
+	{ "work_submit_flush", work_op },
+	{ "timer_start_stop", timeout_op },
+};
+
+static void worker(void *p1, void *p2, void *p3)
+{
+	unsigned int id = POINTER_TO_UINT(p1);
+	const struct bench *bench = p2;
+	unsigned int num_cpus = POINTER_TO_UINT(p3);
+	uint32_t *out = &samples[id * N_SAMPLES];
+	timing_t start, end;
+
+	/* Start all workers at once, to measure the operations under
+	 * contention.
+	 */
+	atomic_inc(&ready);
+	while (atomic_get(&ready) < num_cpus) {
+	}
+
+	for (int i = 0; i < N_SAMPLES; i++) {
+		start = timing_counter_get();
+		bench->op(id);
+		end = timing_counter_get();
+		out[i] = (uint32_t)timing_cycles_to_ns(timing_cycles_get(&start, &end));
+	}
+}
+
+static int cmp_u32(const void *a, const void *b)
+{
+	uint32_t x = *(const uint32_t *)a;
+	uint32_t y = *(const uint32_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+static void run(const struct bench *bench, unsigned int num_cpus)
+{
+	size_t count = num_cpus * N_SAMPLES;
+
+	atomic_set(&ready, 0);
+
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		k_thread_create(&worker_threads[i], worker_stacks[i],
+				STACK_SIZE, worker, UINT_TO_POINTER(i),
+				(void *)bench, UINT_TO_POINTER(num_cpus),
+				K_PRIO_COOP(1), 0, K_FOREVER);
+#ifdef CONFIG_SCHED_CPU_MASK
+		(void)k_thread_cpu_pin(&worker_threads[i], i);
+#endif
+	}
+
+	/* The worker pinned to this CPU must not start spinning before
+	 * the others are started.
+	 */
+	k_sched_lock();
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		k_thread_start(&worker_threads[i]);
+	}
+	k_sched_unlock();
+
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		k_thread_join(&worker_threads[i], K_FOREVER);
+	}
+
+	qsort(samples, count, sizeof(samples[0]), cmp_u32);
+
+	printk("RESULT,%s,%u,%u,%u,%u,%u,%u\n", bench->name, num_cpus,
+	       (uint32_t)count, samples[0], samples[count / 2],
+	       samples[(count * 99) / 100], samples[count - 1]);
+}
+
+void main(void)
+{
+	timing_init();
+	timing_start();
+
+	k_work_queue_start(&bench_wq, wq_stack, K_THREAD_STACK_SIZEOF(wq_stack),
+			   K_PRIO_COOP(0), NULL);
+
+	for (unsigned int i = 0; i < NUM_CPUS; i++) {
+		k_work_init(&works[i], work_handler);
+		k_timer_init(&timers[i], NULL, NULL);
+	}
+
+	printk("RESULT,op,cpus,samples,min_ns,p50_ns,p99_ns,max_ns\n");
+
+	for (size_t b = 0; b < ARRAY_SIZE(benches); b++) {
+		for (unsigned int n = 1; n <= NUM_CPUS; n++) {
+			run(&benches[b], n);
+		}
+	}
+
+	timing_stop();
+
+	if (atomic_get(&failures) != 0) {
+		printk("%ld operations failed\n", (long)atomic_get(&failures));
+	}
+
+	printk("fin\n");
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+
+/* This benchmark measures the string and memory routines of the C library
+ * on short and long buffers, aligned and not. Build it once per C library
+ * (and per CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE setting) to compare
+ * them.
+ */
+
+#define ITERATIONS 1000
+#define BUF_SIZE 1024
+
+static uint8_t src[BUF_SIZE + sizeof(uintptr_t)] __aligned(sizeof(uintptr_t));
+static uint8_t dst[BUF_SIZE + sizeof(uintptr_t)] __aligned(sizeof(uintptr_t));
+
+static const size_t sizes[] = { 16, 64, 256, BUF_SIZE };
+
+/* Keep the results alive, so that calls are not optimized out */
+static volatile uintptr_t sink;
+
+static void report(const char *name, size_t size, size_t offset,
+		   uint64_t cycles)
+{
+	printk("%-7s %4zu bytes: %u cycles avg (%u ns)%s\n", name, size,
+	       (uint32_t)(cycles / ITERATIONS),
+	       (uint32_t)timing_cycles_to_ns_avg(cycles, ITERATIONS),
+	       (offset != 0U) ? " unaligned" : "");
+}
+
+#define BENCH(name, size, offset, call)					\
+	do {								\
+		timing_t start, end;					\
+									\
+		start = timing_counter_get();				\
+		for (int i = 0; i < ITERATIONS; i++) {			\
+			sink = (uintptr_t)(call);			\
+		}							\
+		end = timing_counter_get();				\
+		report(name, size, offset,				\
+		       timing_cycles_get(&start, &end));		\
+	} while (false)
+
+void main(void)
+{
+	timing_init();
+	timing_start();
+
+	for (size_t i = 0; i < sizeof(src); i++) {
+		src[i] = 'a' + (i % 26);
+	}
+
+	for (size_t offset = 0; offset < 2; offset++) {
+		for (size_t i = 0; i < ARRAY_SIZE(sizes); i++) {
+			size_t size = sizes[i];
+			uint8_t *s = src + offset;
+
+			BENCH("memcpy", size, offset, memcpy(dst, s, size));
+			BENCH("memset", size, offset, memset(dst + offset, 0, size));
+
+			(void)memcpy(dst + offset, s, size);
+			BENCH("memcmp", size, offset, memcmp(dst + offset, s, size));
+			BENCH("memchr", size, offset, memchr(s, 0, size));
+
+			s[size - 1] = '\0';
+			BENCH("strlen", size, offset, strlen((char *)s));
+			s[size - 1] = 'a';
+		}
+	}
+
+	timing_stop();
+
+	printk("fin\n");
+}
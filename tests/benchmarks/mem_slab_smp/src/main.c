@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+
+/* Each worker allocates BATCH blocks and frees them again, N_ROUNDS times,
+ * so that both the cache hit path and the refill/flush path are exercised.
+ */
+#define N_ROUNDS 10000
+#define BATCH 4
+#define BLOCK_SIZE 32
+#define STACK_SIZE 1024
+
+K_MEM_SLAB_DEFINE_STATIC(bench_slab, BLOCK_SIZE,
+			 CONFIG_MP_NUM_CPUS * BATCH * 4, 4);
+
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, CONFIG_MP_NUM_CPUS,
+				   STACK_SIZE);
+static struct k_thread worker_threads[CONFIG_MP_NUM_CPUS];
+
+static void worker(void *p1, void *p2, void *p3)
+{
+	void *blocks[BATCH];
+
+	for (int i = 0; i < N_ROUNDS; i++) {
+		for (int j = 0; j < BATCH; j++) {
+			if (k_mem_slab_alloc(&bench_slab, &blocks[j],
+					     K_FOREVER) != 0) {
+				printk("alloc failed\n");
+				return;
+			}
+		}
+		for (int j = 0; j < BATCH; j++) {
+			k_mem_slab_free(&bench_slab, &blocks[j]);
+		}
+	}
+}
+
+static void run(unsigned int num_cpus)
+{
+	uint32_t start, cycles;
+	uint64_t ops = (uint64_t)num_cpus * N_ROUNDS * BATCH * 2;
+
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		k_thread_create(&worker_threads[i], worker_stacks[i],
+				STACK_SIZE, worker, NULL, NULL, NULL,
+				K_PRIO_COOP(1), 0, K_FOREVER);
+		k_thread_cpu_pin(&worker_threads[i], i);
+	}
+
+	start = k_cycle_get_32();
+
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		k_thread_start(&worker_threads[i]);
+	}
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		k_thread_join(&worker_threads[i], K_FOREVER);
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	printk("cpus %u ops %u cycles %u ops/Mcycle %u\n", num_cpus,
+	       (uint32_t)ops, cycles,
+	       (uint32_t)((ops * 1000000U) / MAX(cycles, 1U)));
+
+	if (k_mem_slab_num_used_get(&bench_slab) != 0U) {
+		printk("leaked %u blocks\n",
+		       k_mem_slab_num_used_get(&bench_slab));
+	}
+}
+
+void main(void)
+{
+	printk("mem_slab SMP benchmark, per-CPU cache %s\n",
+	       IS_ENABLED(CONFIG_MEM_SLAB_PER_CPU_CACHE) ? "on" : "off");
+
+	for (unsigned int n = 1; n <= CONFIG_MP_NUM_CPUS; n++) {
+		run(n);
+	}
+
+	printk("fin\n");
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/timeout_q.h>
+
+/* This benchmark measures the raw cost of the kernel timeout queue:
+ * it arms N_TIMEOUTS timeouts with pseudo-random durations, far enough
+ * in the future that none of them fires, then cancels them all in a
+ * different order.  Build it once per CONFIG_TIMEOUT_QUEUE_* backend
+ * to compare them.
+ */
+
+#define N_TIMEOUTS 10000
+
+/* Keep everything well past the benchmark runtime */
+#define MIN_TICKS (CONFIG_SYS_CLOCK_TICKS_PER_SEC * 60)
+#define SPREAD_TICKS (CONFIG_SYS_CLOCK_TICKS_PER_SEC * 3600)
+
+static struct _timeout timeouts[N_TIMEOUTS];
+
+static uint32_t seed = 12345;
+
+/* Small deterministic LCG, so runs are comparable */
+static uint32_t next_rand(void)
+{
+	seed = seed * 1103515245U + 12345U;
+	return seed >> 8;
+}
+
+static void dummy_fn(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+	printk("timeout fired unexpectedly\n");
+}
+
+void main(void)
+{
+	timing_t start, end;
+	uint64_t arm_cycles, cancel_cycles;
+
+	timing_init();
+	timing_start();
+
+	for (int i = 0; i < N_TIMEOUTS; i++) {
+		z_init_timeout(&timeouts[i]);
+	}
+
+	start = timing_counter_get();
+	for (int i = 0; i < N_TIMEOUTS; i++) {
+		k_ticks_t ticks = MIN_TICKS + (next_rand() % SPREAD_TICKS);
+
+		z_add_timeout(&timeouts[i], dummy_fn, K_TICKS(ticks));
+	}
+	end = timing_counter_get();
+	arm_cycles = timing_cycles_get(&start, &end);
+
+	/* Stride through the array to cancel in an order unrelated to
+	 * the arming one
+	 */
+	start = timing_counter_get();
+	for (int i = 0, j = 0; i < N_TIMEOUTS; i++) {
+		(void)z_abort_timeout(&timeouts[j]);
+		j = (j + 7919) % N_TIMEOUTS;
+	}
+	end = timing_counter_get();
+	cancel_cycles = timing_cycles_get(&start, &end);
+
+	timing_stop();
+
+	printk("arm    %d timeouts: %u cycles avg (%u ns)\n", N_TIMEOUTS,
+	       (uint32_t)(arm_cycles / N_TIMEOUTS),
+	       (uint32_t)timing_cycles_to_ns_avg(arm_cycles, N_TIMEOUTS));
+	printk("cancel %d timeouts: %u cycles avg (%u ns)\n", N_TIMEOUTS,
+	       (uint32_t)(cancel_cycles / N_TIMEOUTS),
+	       (uint32_t)timing_cycles_to_ns_avg(cancel_cycles, N_TIMEOUTS));
+	printk("fin\n");
+}
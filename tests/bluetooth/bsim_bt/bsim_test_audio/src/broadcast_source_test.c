@@ -202,6 +202,220 @@ static void test_main(void)
 	PASS("Broadcast source passed\n");
 }
 
+#if defined(CONFIG_BT_AUDIO_STREAM_PIPELINE)
+/* Frames encoded through the pipeline: the one being sent, the one being
+ * encoded and one queued towards the controller.
+ */
+#define PIPELINE_BUF_COUNT 3U
+/* Every OFFLOAD_PERIOD frame is completed asynchronously, within its SDU
+ * interval, and the frame LATE_SEQ_NUM only after its send time.
+ */
+#define OFFLOAD_PERIOD 4U
+#define OFFLOAD_DELAY_MS 2U
+#define LATE_SEQ_NUM 50U
+#define LATE_DELAY K_MSEC(15)
+
+NET_BUF_POOL_FIXED_DEFINE(pipeline_pool, PIPELINE_BUF_COUNT,
+			  BT_ISO_SDU_BUF_SIZE(CONFIG_BT_ISO_TX_MTU), 8, NULL);
+
+static struct bt_audio_pipeline pipeline;
+static struct k_work_delayable offload_work;
+static struct net_buf *offload_buf;
+static uint32_t encoded_count;
+static uint32_t skipped_count;
+static uint32_t last_seq_num;
+
+static void offload_work_handler(struct k_work *work)
+{
+	net_buf_add(offload_buf, preset_16_2_1.qos.sdu);
+	bt_audio_pipeline_frame_done(&pipeline, 0);
+}
+
+static int pipeline_encode_cb(struct bt_audio_pipeline *p,
+			      struct net_buf *buf, uint32_t seq_num,
+			      uint32_t ts)
+{
+	if (encoded_count > 0U && seq_num != last_seq_num + 1U) {
+		skipped_count += seq_num - last_seq_num - 1U;
+	}
+
+	encoded_count++;
+	last_seq_num = seq_num;
+
+	if (ts != seq_num * preset_16_2_1.qos.interval) {
+		FAIL("Invalid timestamp %u for seq_num %u\n", ts, seq_num);
+	}
+
+	if (seq_num == LATE_SEQ_NUM) {
+		offload_buf = buf;
+		k_work_schedule(&offload_work, LATE_DELAY);
+		return -EINPROGRESS;
+	}
+
+	if ((seq_num % OFFLOAD_PERIOD) == 1U) {
+		offload_buf = buf;
+		k_work_schedule(&offload_work, K_MSEC(OFFLOAD_DELAY_MS));
+		return -EINPROGRESS;
+	}
+
+	net_buf_add(buf, preset_16_2_1.qos.sdu);
+
+	return 0;
+}
+
+static const struct bt_audio_pipeline_ops pipeline_ops = {
+	.encode = pipeline_encode_cb,
+};
+
+static struct bt_audio_stream_ops pipeline_stream_ops = {
+	.started = started_cb,
+	.stopped = stopped_cb,
+};
+
+static void test_main_pipeline(void)
+{
+	struct bt_audio_broadcast_source *source;
+	struct net_buf *bufs[PIPELINE_BUF_COUNT];
+	struct bt_audio_pipeline_stats stats;
+	int err;
+
+	err = bt_enable(NULL);
+	if (err) {
+		FAIL("Bluetooth init failed (err %d)\n", err);
+		return;
+	}
+
+	printk("Bluetooth initialized\n");
+
+	(void)memset(broadcast_source_streams, 0,
+		     sizeof(broadcast_source_streams));
+
+	for (size_t i = 0; i < ARRAY_SIZE(streams); i++) {
+		streams[i] = &broadcast_source_streams[i];
+		bt_audio_stream_cb_register(streams[i], &pipeline_stream_ops);
+	}
+
+	k_work_init_delayable(&offload_work, offload_work_handler);
+
+	err = bt_audio_broadcast_source_create(streams, ARRAY_SIZE(streams),
+					       &preset_16_2_1.codec,
+					       &preset_16_2_1.qos,
+					       &source);
+	if (err != 0) {
+		FAIL("Unable to create broadcast source: %d\n", err);
+		return;
+	}
+
+	err = bt_audio_broadcast_source_start(source);
+	if (err != 0) {
+		FAIL("Unable to start broadcast source: %d\n", err);
+		return;
+	}
+
+	printk("Waiting for streams to be started\n");
+	for (size_t i = 0U; i < ARRAY_SIZE(streams); i++) {
+		k_sem_take(&sem_started, K_FOREVER);
+	}
+
+	printk("Starting pipeline\n");
+	err = bt_audio_pipeline_start(&pipeline, streams[0], &pipeline_ops,
+				      &pipeline_pool);
+	if (err != 0) {
+		FAIL("Unable to start pipeline: %d\n", err);
+		return;
+	}
+
+	err = bt_audio_pipeline_start(&pipeline, streams[0], &pipeline_ops,
+				      &pipeline_pool);
+	if (err != -EALREADY) {
+		FAIL("Pipeline started twice: %d\n", err);
+		return;
+	}
+
+	/* Keeping running for a little while */
+	k_sleep(K_SECONDS(5));
+
+	printk("Stopping pipeline\n");
+	err = bt_audio_pipeline_stop(&pipeline);
+	if (err != 0) {
+		FAIL("Unable to stop pipeline: %d\n", err);
+		return;
+	}
+
+	/* Let an offloaded frame complete, it is released by the pipeline */
+	k_sleep(K_MSEC(20));
+
+	bt_audio_pipeline_stats_get(&pipeline, &stats);
+	printk("Pipeline: %u encoded, %u sent, %u late, %u dropped, "
+	       "encode max %u us, sched max %u us\n", encoded_count,
+	       stats.sent, stats.late, stats.dropped, stats.encode_us_max,
+	       stats.sched_us_max);
+
+	/* The late frame is the only one not sent, and the sequence number
+	 * of the interval it was still being encoded in is skipped.
+	 */
+	if (stats.late != 1U || skipped_count != 1U) {
+		FAIL("%u late frames, %u sequence numbers skipped\n",
+		     stats.late, skipped_count);
+		return;
+	}
+
+	if (stats.dropped != 0U) {
+		FAIL("%u frames dropped\n", stats.dropped);
+		return;
+	}
+
+	/* Frames are sent one SDU interval after being encoded, the last one
+	 * is released when stopping.
+	 */
+	if (stats.sent + stats.late + 1U < encoded_count ||
+	    stats.sent + stats.late > encoded_count) {
+		FAIL("%u frames sent out of %u encoded\n", stats.sent,
+		     encoded_count);
+		return;
+	}
+
+	if (stats.encode_us_max < OFFLOAD_DELAY_MS * USEC_PER_MSEC) {
+		FAIL("Offloaded encoding not accounted (%u us)\n",
+		     stats.encode_us_max);
+		return;
+	}
+
+	/* All the frames have been released */
+	for (size_t i = 0U; i < PIPELINE_BUF_COUNT; i++) {
+		bufs[i] = net_buf_alloc(&pipeline_pool, K_NO_WAIT);
+		if (bufs[i] == NULL) {
+			FAIL("Pipeline buffer %zu not released\n", i);
+			return;
+		}
+	}
+
+	for (size_t i = 0U; i < PIPELINE_BUF_COUNT; i++) {
+		net_buf_unref(bufs[i]);
+	}
+
+	printk("Stopping broadcast source\n");
+	err = bt_audio_broadcast_source_stop(source);
+	if (err != 0) {
+		FAIL("Unable to stop broadcast source: %d\n", err);
+		return;
+	}
+
+	printk("Waiting for streams to be stopped\n");
+	for (size_t i = 0U; i < ARRAY_SIZE(streams); i++) {
+		k_sem_take(&sem_stopped, K_FOREVER);
+	}
+
+	err = bt_audio_broadcast_source_delete(source);
+	if (err != 0) {
+		FAIL("Unable to delete broadcast source: %d\n", err);
+		return;
+	}
+
+	PASS("Broadcast source pipeline passed\n");
+}
+#endif /* CONFIG_BT_AUDIO_STREAM_PIPELINE */
+
 static const struct bst_test_instance test_broadcast_source[] = {
 	{
 		.test_id = "broadcast_source",
@@ -209,6 +423,14 @@ static const struct bst_test_instance test_broadcast_source[] = {
 		.test_tick_f = test_tick,
 		.test_main_f = test_main
 	},
+#if defined(CONFIG_BT_AUDIO_STREAM_PIPELINE)
+	{
+		.test_id = "broadcast_source_pipeline",
+		.test_post_init_f = test_init,
+		.test_tick_f = test_tick,
+		.test_main_f = test_main_pipeline
+	},
+#endif /* CONFIG_BT_AUDIO_STREAM_PIPELINE */
 	BSTEST_END_MARKER
 };
 
@@ -8,6 +8,7 @@
 #include "mesh/mesh.h"
 #include "mesh/net.h"
 #include "mesh/rpl.h"
+#include "mesh/subnet.h"
 #include "mesh/transport.h"
 
 #define LOG_MODULE_NAME test_rpc
@@ -18,6 +19,11 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME, LOG_LEVEL_INF);
 #define WAIT_TIME 60 /*seconds*/
 #define TEST_DATA_WAITING_TIME 5 /* seconds */
 #define TEST_DATA_SIZE 20
+#define RPL_BENCH_SRC 0x1000
+#define RPL_BENCH_ROUNDS 100
+#define RPL_HASH_SRC 0x2000
+#define MSG_CACHE_SRC 0x3000
+#define MSG_CACHE_SEQ 0x100
 
 static const struct bt_mesh_test_cfg tx_cfg = {
 	.addr = 0x0001,
@@ -402,6 +408,214 @@ static void test_rx_reboot_after_defrag(void)
 	PASS();
 }
 
+static void test_rx_rpl_bench(void)
+{
+	struct bt_mesh_net_rx rx = {
+		.local_match = 1,
+	};
+	uint32_t cycles = 0;
+	uint32_t start;
+	bool accepted;
+	bool replayed;
+
+	settings_test_backend_clear();
+	bt_mesh_test_setup();
+
+	/* Fill the RPL with one entry per source. */
+	for (int i = 0; i < CONFIG_BT_MESH_CRPL; i++) {
+		rx.ctx.addr = RPL_BENCH_SRC + i;
+		rx.seq = 1;
+		ASSERT_FALSE(bt_mesh_rpl_check(&rx, NULL));
+	}
+
+	/* Receive a new message and a replay of it from every source. */
+	for (uint32_t seq = 2; seq < 2 + RPL_BENCH_ROUNDS; seq++) {
+		for (int i = 0; i < CONFIG_BT_MESH_CRPL; i++) {
+			rx.ctx.addr = RPL_BENCH_SRC + i;
+			rx.seq = seq;
+
+			start = k_cycle_get_32();
+			accepted = !bt_mesh_rpl_check(&rx, NULL);
+			replayed = bt_mesh_rpl_check(&rx, NULL);
+			cycles += k_cycle_get_32() - start;
+
+			ASSERT_TRUE(accepted, "Message from 0x%04x rejected",
+				    rx.ctx.addr);
+			ASSERT_TRUE(replayed, "Replay from 0x%04x accepted",
+				    rx.ctx.addr);
+		}
+	}
+
+	LOG_INF("RPL with %u entries: %u cycles per check", CONFIG_BT_MESH_CRPL,
+		cycles / (2 * RPL_BENCH_ROUNDS * CONFIG_BT_MESH_CRPL));
+
+	PASS();
+}
+
+static bool rpl_hash_check(uint16_t src, uint32_t seq, bool old_iv, bool update)
+{
+	struct bt_mesh_rpl *rpl = NULL;
+	struct bt_mesh_net_rx rx = {
+		.ctx.addr = src,
+		.seq = seq,
+		.old_iv = old_iv,
+		.local_match = 1,
+	};
+
+	return bt_mesh_rpl_check(&rx, update ? NULL : &rpl);
+}
+
+static void test_rx_rpl_hash(void)
+{
+	int i;
+
+	bt_mesh_test_setup();
+
+	/* All the sources share the same hash bucket. */
+	for (i = 0; i < CONFIG_BT_MESH_CRPL; i++) {
+		uint16_t src = RPL_HASH_SRC + i * CONFIG_BT_MESH_RPL_HASH_SIZE;
+
+		ASSERT_FALSE(rpl_hash_check(src, 1, false, true));
+	}
+
+	for (i = 0; i < CONFIG_BT_MESH_CRPL; i++) {
+		uint16_t src = RPL_HASH_SRC + i * CONFIG_BT_MESH_RPL_HASH_SIZE;
+
+		ASSERT_TRUE(rpl_hash_check(src, 1, false, true),
+			    "Replay from 0x%04x accepted", src);
+		ASSERT_FALSE(rpl_hash_check(src, 2, false, false),
+			     "Message from 0x%04x rejected", src);
+	}
+
+	/* The list is full. */
+	ASSERT_TRUE(rpl_hash_check(RPL_HASH_SRC - 1, 1, false, true));
+
+	/* After an IV Update, receive a message on the new IV Index from
+	 * every other source only, so that the next IV Update removes the
+	 * other sources and moves the remaining entries.
+	 */
+	bt_mesh_rpl_reset();
+
+	for (i = 0; i < CONFIG_BT_MESH_CRPL; i += 2) {
+		uint16_t src = RPL_HASH_SRC + i * CONFIG_BT_MESH_RPL_HASH_SIZE;
+
+		ASSERT_FALSE(rpl_hash_check(src, 2, false, true));
+	}
+
+	bt_mesh_rpl_reset();
+
+	for (i = 0; i < CONFIG_BT_MESH_CRPL; i++) {
+		uint16_t src = RPL_HASH_SRC + i * CONFIG_BT_MESH_RPL_HASH_SIZE;
+
+		if (i % 2) {
+			ASSERT_FALSE(rpl_hash_check(src, 1, true, false),
+				     "Removed entry for 0x%04x found", src);
+		} else {
+			ASSERT_TRUE(rpl_hash_check(src, 2, true, false),
+				    "Moved entry for 0x%04x lost", src);
+		}
+	}
+
+	/* The slots of the removed entries are reused. */
+	for (i = 1; i < CONFIG_BT_MESH_CRPL; i += 2) {
+		ASSERT_FALSE(rpl_hash_check(RPL_HASH_SRC - i, 1, false, true));
+	}
+
+	ASSERT_TRUE(rpl_hash_check(RPL_HASH_SRC - CONFIG_BT_MESH_CRPL, 1,
+				   false, true));
+
+	PASS();
+}
+
+/* Receive a Network PDU from MSG_CACHE_SRC on the advertising bearer. The
+ * TTL makes copies of the same message differ, as if relayed by different
+ * nodes, so that they are not filtered before the Network Message Cache.
+ */
+static void msg_cache_recv(uint32_t seq, uint8_t ttl)
+{
+	NET_BUF_SIMPLE_DEFINE(buf, BT_MESH_NET_MAX_PDU_LEN);
+	struct bt_mesh_msg_ctx ctx = {
+		.net_idx = 0,
+		.app_idx = BT_MESH_KEY_UNUSED,
+		.addr = rx_cfg.addr,
+		.send_ttl = ttl,
+	};
+	struct bt_mesh_net_tx tx = {
+		.sub = bt_mesh_subnet_get(0),
+		.ctx = &ctx,
+		.src = MSG_CACHE_SRC,
+	};
+	uint32_t own_seq = bt_mesh.seq;
+
+	net_buf_simple_reserve(&buf, BT_MESH_NET_HDR_LEN);
+	net_buf_simple_add_u8(&buf, TRANS_CTL_HDR(TRANS_CTL_OP_HEARTBEAT, 0));
+	(void)net_buf_simple_add(&buf, 3);
+	memset(buf.data + 1, 0, 3);
+
+	/* The sequence number is taken from the local node. */
+	bt_mesh.seq = seq;
+	ASSERT_OK(bt_mesh_net_encode(&tx, &buf, false));
+	bt_mesh.seq = own_seq;
+
+	bt_mesh_net_recv(&buf, 0, BT_MESH_NET_IF_ADV);
+}
+
+/* Whether a message has reached the transport layer since the RPL was
+ * cleared.
+ */
+static bool msg_cache_processed(uint32_t seq)
+{
+	return rpl_hash_check(MSG_CACHE_SRC, seq, false, false);
+}
+
+static void test_rx_msg_cache(void)
+{
+	int i;
+
+	bt_mesh_test_setup();
+
+	for (i = 0; i < CONFIG_BT_MESH_MSG_CACHE_SIZE; i++) {
+		msg_cache_recv(MSG_CACHE_SEQ + i, 5);
+	}
+
+	ASSERT_TRUE(msg_cache_processed(MSG_CACHE_SEQ +
+					CONFIG_BT_MESH_MSG_CACHE_SIZE - 1));
+
+	/* Copies of cached messages are dropped by the network layer. */
+	bt_mesh_rpl_clear();
+
+	for (i = 0; i < CONFIG_BT_MESH_MSG_CACHE_SIZE; i++) {
+		msg_cache_recv(MSG_CACHE_SEQ + i, 4);
+		ASSERT_FALSE(msg_cache_processed(MSG_CACHE_SEQ + i),
+			     "Copy of seq 0x%06x processed", MSG_CACHE_SEQ + i);
+	}
+
+	/* A new message replaces the oldest one in the cache. */
+	msg_cache_recv(MSG_CACHE_SEQ + CONFIG_BT_MESH_MSG_CACHE_SIZE, 5);
+	ASSERT_TRUE(msg_cache_processed(MSG_CACHE_SEQ +
+					CONFIG_BT_MESH_MSG_CACHE_SIZE));
+
+	bt_mesh_rpl_clear();
+	msg_cache_recv(MSG_CACHE_SEQ, 3);
+	ASSERT_TRUE(msg_cache_processed(MSG_CACHE_SEQ),
+		    "Copy of evicted message dropped");
+
+	/* That message replaced the next oldest one, the others remain. */
+	bt_mesh_rpl_clear();
+	msg_cache_recv(MSG_CACHE_SEQ + 1, 3);
+	ASSERT_TRUE(msg_cache_processed(MSG_CACHE_SEQ + 1),
+		    "Copy of evicted message dropped");
+
+	for (i = 3; i < CONFIG_BT_MESH_MSG_CACHE_SIZE; i++) {
+		bt_mesh_rpl_clear();
+		msg_cache_recv(MSG_CACHE_SEQ + i, 3);
+		ASSERT_FALSE(msg_cache_processed(MSG_CACHE_SEQ + i),
+			     "Copy of seq 0x%06x processed", MSG_CACHE_SEQ + i);
+	}
+
+	PASS();
+}
+
 #define TEST_CASE(role, name, description)                     \
 	{                                                      \
 		.test_id = "rpc_" #role "_" #name,             \
@@ -420,6 +634,9 @@ static const struct bst_test_instance test_rpc[] = {
 	TEST_CASE(rx, power_replay_attack,     "RPC: device under power cycle reply attack"),
 	TEST_CASE(rx, rpl_frag, "RPC: Test RPL fragmentation after double IVI Update"),
 	TEST_CASE(rx, reboot_after_defrag, "RPC: Test PRL after defrag and reboot"),
+	TEST_CASE(rx, rpl_bench, "RPC: Measure the RPL check time"),
+	TEST_CASE(rx, rpl_hash, "RPC: Test RPL lookup with colliding sources"),
+	TEST_CASE(rx, msg_cache, "RPC: Test Network Message Cache duplicates"),
 	BSTEST_END_MARKER
 };
 
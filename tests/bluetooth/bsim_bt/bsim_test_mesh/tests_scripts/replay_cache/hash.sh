@@ -0,0 +1,18 @@
+#!/usr/bin/env bash
+# Copyright 2023 The Zephyr Project Contributors
+# SPDX-License-Identifier: Apache-2.0
+
+source $(dirname "${BASH_SOURCE[0]}")/../../_mesh_test.sh
+
+# Test the RPL lookup when all the sources share a hash bucket:
+# 1. Fill the RPL, check replays are rejected and the list is full;
+# 2. Toggle the IV Index twice, renewing every other source in between, so that
+#   the other entries are removed and the remaining ones are moved;
+# 3. Check the moved entries are still found and the free slots are reused.
+RunTest mesh_replay_rpl_hash rpc_rx_rpl_hash
+
+# Test the Network Message Cache with copies of messages received with a
+# different TTL, as if relayed by different nodes:
+# 1. Copies of cached messages are dropped before the transport layer;
+# 2. New messages replace the oldest ones, copies of which are then accepted.
+RunTest mesh_replay_msg_cache rpc_rx_msg_cache
@@ -0,0 +1,12 @@
+#!/usr/bin/env bash
+# Copyright 2022 Nordic Semiconductor
+# SPDX-License-Identifier: Apache-2.0
+
+source $(dirname "${BASH_SOURCE[0]}")/../../_mesh_test.sh
+
+# Measure the time spent in the Replay Protection List check on the RX path:
+# 1. Fill the RPL with one entry for each of CONFIG_BT_MESH_CRPL sources;
+# 2. Receive a new message and a replay of it from every source, and log the
+#   average number of cycles per check.
+conf=prj_pst_conf
+RunTest mesh_replay_rpl_bench rpc_rx_rpl_bench
@@ -39,6 +39,7 @@ app=tests/bluetooth/bsim_bt/bsim_test_adv_chain compile
 app=tests/bluetooth/bsim_bt/bsim_test_gatt compile
 app=tests/bluetooth/bsim_bt/bsim_test_gatt_write compile
 app=tests/bluetooth/bsim_bt/bsim_test_l2cap compile
+app=tests/bluetooth/bsim_bt/bsim_test_l2cap conf_file=prj_tx_sched.conf compile
 app=tests/bluetooth/bsim_bt/bsim_test_l2cap_userdata compile
 app=tests/bluetooth/bsim_bt/bsim_test_iso compile
 app=tests/bluetooth/bsim_bt/bsim_test_iso conf_file=prj_vs_dp.conf \
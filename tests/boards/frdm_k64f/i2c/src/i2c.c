@@ -6,6 +6,7 @@
 
 #include <zephyr/drivers/i2c.h>
 #include <zephyr/kernel.h>
+#include <zephyr/rtio/rtio_executor_simple.h>
 #include <zephyr/ztest.h>
 
 #define FXOS8700_I2C_ADDR	0x1d
@@ -241,4 +242,61 @@ ZTEST(frdm_k64f_i2c, test_i2c_transfer_signal)
 		"i2c_transfer_signal supervisor mode");
 }
 
+I2C_IODEV_DEFINE(fxos8700_iodev, DEVICE_DT_GET(DT_NODELABEL(i2c0)),
+		 FXOS8700_I2C_ADDR);
+RTIO_EXECUTOR_SIMPLE_DEFINE(i2c_rtio_exec);
+RTIO_DEFINE(i2c_rtio, (struct rtio_executor *)&i2c_rtio_exec, 8, 8);
+
+/* Queue two register write then read transactions, each one being a chain
+ * executed from the controller interrupt.
+ */
+static int test_i2c_fxos8700_rtio(void)
+{
+	static uint8_t rtio_sample_buf[2][64];
+	struct rtio_sqe *sqe;
+	struct rtio_cqe *cqe;
+	int cnt;
+
+	TC_PRINT("fxos8700 rtio test ...\n");
+
+	fxos8700_fifo_cfg();
+
+	for (int i = 0; i < FXOS8700_XFERS; i++) {
+		for (int j = 0; j < ARRAY_SIZE(rtio_sample_buf); j++) {
+			sqe = rtio_spsc_acquire(i2c_rtio.sq);
+			rtio_sqe_prep_write(sqe, &fxos8700_iodev.iodev,
+					    RTIO_PRIO_NORM, &reg, 1, NULL);
+			sqe->flags = RTIO_SQE_CHAINED;
+
+			sqe = rtio_spsc_acquire(i2c_rtio.sq);
+			rtio_sqe_prep_read(sqe, &fxos8700_iodev.iodev,
+					   RTIO_PRIO_NORM, rtio_sample_buf[j],
+					   sizeof(rtio_sample_buf[j]),
+					   rtio_sample_buf[j]);
+			sqe->flags = 0;
+		}
+		rtio_spsc_produce_all(i2c_rtio.sq);
+
+		rtio_submit(&i2c_rtio, 2 * ARRAY_SIZE(rtio_sample_buf));
+
+		cnt = 0;
+		while ((cqe = rtio_spsc_consume(i2c_rtio.cq)) != NULL) {
+			zassert_ok(cqe->result, "expected xfer success");
+			rtio_spsc_release(i2c_rtio.cq);
+			cnt++;
+		}
+
+		zassert_equal(cnt, 2 * ARRAY_SIZE(rtio_sample_buf),
+			      "expected a completion per submission");
+	}
+
+	TC_PRINT("fxos8700 rtio test pass\n");
+	return TC_PASS;
+}
+
+ZTEST(frdm_k64f_i2c, test_i2c_rtio)
+{
+	zassert_equal(test_i2c_fxos8700_rtio(), TC_PASS, "i2c rtio");
+}
+
 ZTEST_SUITE(frdm_k64f_i2c, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,312 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/device.h>
+#include <zephyr/crypto/crypto.h>
+#include <zephyr/ztest.h>
+
+#include "mbedtls/build_info.h"
+#include "mbedtls/gcm.h"
+
+#define NONCE_LEN 12
+#define TAG_LEN 16
+
+/* Crypto driver standing in for an AES-GCM engine, see gcm_alt.overlay.
+ * Its "cipher" XORs the data with the first key byte and the nonce, and its
+ * tag sums the additional data and the plaintext, which is enough to check
+ * what the mbed TLS GCM implementation passes to the driver.
+ */
+static int fake_caps;
+static int fake_begin_count;
+static int fake_free_count;
+static struct {
+	const uint8_t *in_buf;
+	const uint8_t *out_buf;
+	uint32_t ad_len;
+} fake_last_op;
+
+static void fake_tag(const uint8_t *ad, uint32_t ad_len,
+		     const uint8_t *plain, int len, uint16_t tag_len,
+		     uint8_t *tag)
+{
+	uint8_t sum = 0U;
+
+	for (uint32_t i = 0; i < ad_len; i++) {
+		sum += ad[i];
+	}
+
+	for (int i = 0; i < len; i++) {
+		sum += plain[i];
+	}
+
+	for (uint16_t i = 0; i < tag_len; i++) {
+		tag[i] = sum + i;
+	}
+}
+
+static void fake_xor(struct cipher_ctx *ctx, struct cipher_pkt *pkt,
+		     const uint8_t *nonce)
+{
+	uint16_t nonce_len = ctx->mode_params.gcm_info.nonce_len;
+
+	for (int i = 0; i < pkt->in_len; i++) {
+		pkt->out_buf[i] = pkt->in_buf[i] ^ ctx->key.bit_stream[0] ^
+				  nonce[i % nonce_len];
+	}
+
+	pkt->out_len = pkt->in_len;
+}
+
+static int fake_gcm_encrypt(struct cipher_ctx *ctx,
+			    struct cipher_aead_pkt *apkt, uint8_t *nonce)
+{
+	uint16_t tag_len = ctx->mode_params.gcm_info.tag_len;
+	uint8_t tag[TAG_LEN];
+
+	fake_last_op.in_buf = apkt->pkt->in_buf;
+	fake_last_op.out_buf = apkt->pkt->out_buf;
+	fake_last_op.ad_len = apkt->ad_len;
+
+	fake_tag(apkt->ad, apkt->ad_len, apkt->pkt->in_buf,
+		 apkt->pkt->in_len, tag_len, tag);
+	fake_xor(ctx, apkt->pkt, nonce);
+	memcpy(apkt->tag, tag, tag_len);
+
+	return 0;
+}
+
+static int fake_gcm_decrypt(struct cipher_ctx *ctx,
+			    struct cipher_aead_pkt *apkt, uint8_t *nonce)
+{
+	uint16_t tag_len = ctx->mode_params.gcm_info.tag_len;
+	uint8_t tag[TAG_LEN];
+
+	fake_last_op.in_buf = apkt->pkt->in_buf;
+	fake_last_op.out_buf = apkt->pkt->out_buf;
+	fake_last_op.ad_len = apkt->ad_len;
+
+	fake_xor(ctx, apkt->pkt, nonce);
+	fake_tag(apkt->ad, apkt->ad_len, apkt->pkt->out_buf,
+		 apkt->pkt->out_len, tag_len, tag);
+
+	if (memcmp(tag, apkt->tag, tag_len) != 0) {
+		return -EFAULT;
+	}
+
+	return 0;
+}
+
+static int fake_query_hw_caps(const struct device *dev)
+{
+	return fake_caps;
+}
+
+static int fake_begin_session(const struct device *dev,
+			      struct cipher_ctx *ctx, enum cipher_algo algo,
+			      enum cipher_mode mode, enum cipher_op op_type)
+{
+	if (algo != CRYPTO_CIPHER_ALGO_AES || mode != CRYPTO_CIPHER_MODE_GCM ||
+	    ctx->mode_params.gcm_info.tag_len > TAG_LEN) {
+		return -EINVAL;
+	}
+
+	ctx->ops.gcm_crypt_hndlr = op_type == CRYPTO_CIPHER_OP_ENCRYPT ?
+				   fake_gcm_encrypt : fake_gcm_decrypt;
+	fake_begin_count++;
+
+	return 0;
+}
+
+static int fake_free_session(const struct device *dev,
+			     struct cipher_ctx *ctx)
+{
+	fake_free_count++;
+
+	return 0;
+}
+
+static struct crypto_driver_api fake_crypto_api = {
+	.query_hw_caps = fake_query_hw_caps,
+	.cipher_begin_session = fake_begin_session,
+	.cipher_free_session = fake_free_session,
+};
+
+DEVICE_DT_DEFINE(DT_NODELABEL(gcm_crypto), NULL, NULL, NULL, NULL,
+		 POST_KERNEL, CONFIG_CRYPTO_INIT_PRIORITY, &fake_crypto_api);
+
+static const uint8_t key[16] = {
+	0x5a, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+	0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+};
+static const uint8_t nonce[NONCE_LEN] = {
+	0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb, 0xad, 0xde, 0xca, 0xf8, 0x88,
+};
+static const uint8_t ad[] = "record header";
+static const uint8_t plain[] = "TLS record payload";
+
+static mbedtls_gcm_context gcm;
+
+static void gcm_alt_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	fake_caps = CAP_RAW_KEY | CAP_SEPARATE_IO_BUFS | CAP_SYNC_OPS;
+	fake_begin_count = 0;
+	fake_free_count = 0;
+	memset(&fake_last_op, 0, sizeof(fake_last_op));
+
+	mbedtls_gcm_init(&gcm);
+	zassert_ok(mbedtls_gcm_setkey(&gcm, MBEDTLS_CIPHER_ID_AES, key,
+				      sizeof(key) * 8U));
+}
+
+static void gcm_alt_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	mbedtls_gcm_free(&gcm);
+}
+
+static void encrypt(uint8_t *out, uint8_t *tag, size_t tag_len)
+{
+	zassert_ok(mbedtls_gcm_crypt_and_tag(&gcm, MBEDTLS_GCM_ENCRYPT,
+					     sizeof(plain), nonce,
+					     sizeof(nonce), ad, sizeof(ad),
+					     plain, out, tag_len, tag));
+}
+
+ZTEST(mbedtls_gcm_alt, test_gcm_alt_roundtrip)
+{
+	uint8_t cipher[sizeof(plain)];
+	uint8_t out[sizeof(plain)];
+	uint8_t tag[TAG_LEN];
+
+	encrypt(cipher, tag, sizeof(tag));
+	zassert_true(memcmp(cipher, plain, sizeof(plain)) != 0,
+		     "data not encrypted");
+	zassert_equal(fake_last_op.in_buf, plain);
+	zassert_equal(fake_last_op.out_buf, cipher);
+	zassert_equal(fake_last_op.ad_len, sizeof(ad));
+
+	zassert_ok(mbedtls_gcm_auth_decrypt(&gcm, sizeof(cipher), nonce,
+					    sizeof(nonce), ad, sizeof(ad),
+					    tag, sizeof(tag), cipher, out));
+	zassert_mem_equal(out, plain, sizeof(plain), "wrong plaintext");
+
+	/* One driver session per direction, kept over operations */
+	encrypt(cipher, tag, sizeof(tag));
+	zassert_equal(fake_begin_count, 2, "%d sessions", fake_begin_count);
+
+	mbedtls_gcm_free(&gcm);
+	zassert_equal(fake_free_count, 2, "%d sessions freed",
+		      fake_free_count);
+}
+
+ZTEST(mbedtls_gcm_alt, test_gcm_alt_inplace)
+{
+	uint8_t separate[sizeof(plain)];
+	uint8_t inplace[sizeof(plain)];
+	uint8_t tag[TAG_LEN];
+	uint8_t inplace_tag[TAG_LEN];
+
+	encrypt(separate, tag, sizeof(tag));
+
+	/* A driver only working in place gets the data copied to the
+	 * output buffer first.
+	 */
+	mbedtls_gcm_free(&gcm);
+	fake_caps = CAP_RAW_KEY | CAP_INPLACE_OPS | CAP_SYNC_OPS;
+	zassert_ok(mbedtls_gcm_setkey(&gcm, MBEDTLS_CIPHER_ID_AES, key,
+				      sizeof(key) * 8U));
+
+	encrypt(inplace, inplace_tag, sizeof(inplace_tag));
+	zassert_equal(fake_last_op.in_buf, inplace);
+	zassert_equal(fake_last_op.out_buf, inplace);
+	zassert_mem_equal(inplace, separate, sizeof(plain), "wrong ciphertext");
+	zassert_mem_equal(inplace_tag, tag, sizeof(tag), "wrong tag");
+}
+
+ZTEST(mbedtls_gcm_alt, test_gcm_alt_auth_failed)
+{
+	uint8_t cipher[sizeof(plain)];
+	uint8_t out[sizeof(plain)];
+	uint8_t zero[sizeof(plain)] = { 0 };
+	uint8_t tag[TAG_LEN];
+
+	encrypt(cipher, tag, sizeof(tag));
+	tag[0] ^= 0x01;
+
+	zassert_equal(mbedtls_gcm_auth_decrypt(&gcm, sizeof(cipher), nonce,
+					       sizeof(nonce), ad, sizeof(ad),
+					       tag, sizeof(tag), cipher, out),
+		      MBEDTLS_ERR_GCM_AUTH_FAILED);
+	zassert_mem_equal(out, zero, sizeof(out),
+			  "unauthenticated plaintext returned");
+}
+
+ZTEST(mbedtls_gcm_alt, test_gcm_alt_session_params)
+{
+	static const uint8_t other_key[16] = { 0xa5 };
+	uint8_t cipher[sizeof(plain)];
+	uint8_t other[sizeof(plain)];
+	uint8_t tag[TAG_LEN];
+
+	encrypt(cipher, tag, sizeof(tag));
+	zassert_equal(fake_begin_count, 1);
+
+	/* Another tag length takes another driver session */
+	encrypt(cipher, tag, 8);
+	zassert_equal(fake_begin_count, 2);
+	zassert_equal(fake_free_count, 1);
+
+	/* So does another key, which the next operations use */
+	zassert_ok(mbedtls_gcm_setkey(&gcm, MBEDTLS_CIPHER_ID_AES, other_key,
+				      sizeof(other_key) * 8U));
+	zassert_equal(fake_free_count, 2);
+
+	encrypt(other, tag, 8);
+	zassert_equal(fake_begin_count, 3);
+	zassert_true(memcmp(cipher, other, sizeof(plain)) != 0,
+		     "new key not used");
+}
+
+ZTEST(mbedtls_gcm_alt, test_gcm_alt_unsupported)
+{
+	uint8_t cipher[sizeof(plain)];
+	uint8_t tag[TAG_LEN];
+	size_t len;
+
+	zassert_equal(mbedtls_gcm_setkey(&gcm, MBEDTLS_CIPHER_ID_CAMELLIA,
+					 key, sizeof(key) * 8U),
+		      MBEDTLS_ERR_GCM_BAD_INPUT);
+	zassert_equal(mbedtls_gcm_setkey(&gcm, MBEDTLS_CIPHER_ID_AES, key, 64),
+		      MBEDTLS_ERR_GCM_BAD_INPUT);
+
+	/* The streaming operations are not offloaded */
+	zassert_equal(mbedtls_gcm_starts(&gcm, MBEDTLS_GCM_ENCRYPT, nonce,
+					 sizeof(nonce)),
+		      MBEDTLS_ERR_GCM_BAD_INPUT);
+	zassert_equal(mbedtls_gcm_update(&gcm, plain, sizeof(plain), cipher,
+					 sizeof(cipher), &len),
+		      MBEDTLS_ERR_GCM_BAD_INPUT);
+	zassert_equal(mbedtls_gcm_finish(&gcm, NULL, 0, &len, tag,
+					 sizeof(tag)),
+		      MBEDTLS_ERR_GCM_BAD_INPUT);
+
+	/* Neither are drivers without synchronous operations */
+	fake_caps = CAP_RAW_KEY | CAP_SEPARATE_IO_BUFS | CAP_ASYNC_OPS;
+	zassert_equal(mbedtls_gcm_crypt_and_tag(&gcm, MBEDTLS_GCM_ENCRYPT,
+						sizeof(plain), nonce,
+						sizeof(nonce), ad, sizeof(ad),
+						plain, cipher, sizeof(tag),
+						tag),
+		      MBEDTLS_ERR_GCM_BAD_INPUT);
+	zassert_equal(fake_begin_count, 0);
+}
+
+ZTEST_SUITE(mbedtls_gcm_alt, NULL, NULL, gcm_alt_before, gcm_alt_after,
+	    NULL);
@@ -853,10 +853,26 @@ static void add_remove_max_filters(enum can_ide id_type)
 		filter_ids[i] = add_rx_msgq(can_dev, &filter);
 	}
 
+#if CONFIG_CAN_MCAN_SHARED_FILTERS > 0
+	/* Further filters share the hardware filter elements */
+	int shared_ids[CONFIG_CAN_MCAN_SHARED_FILTERS];
+
+	for (i = 0; i < CONFIG_CAN_MCAN_SHARED_FILTERS; i++) {
+		filter.id++;
+		shared_ids[i] = add_rx_msgq(can_dev, &filter);
+	}
+#endif
+
 	filter.id++;
 	filter_id = can_add_rx_filter_msgq(can_dev, &can_msgq, &filter);
 	zassert_equal(filter_id, -ENOSPC, "added more than max filters");
 
+#if CONFIG_CAN_MCAN_SHARED_FILTERS > 0
+	for (i = 0; i < CONFIG_CAN_MCAN_SHARED_FILTERS; i++) {
+		can_remove_rx_filter(can_dev, shared_ids[i]);
+	}
+#endif
+
 	for (i = 0; i < max; i++) {
 		can_remove_rx_filter(can_dev, filter_ids[i]);
 	}
@@ -1023,6 +1039,98 @@ ZTEST(can_api, test_send_receive_wrong_id)
 	can_remove_rx_filter(can_dev, filter_id);
 }
 
+#if CONFIG_CAN_MCAN_SHARED_FILTERS > 0
+/**
+ * @brief Assert that a frame is delivered to a given number of RX callbacks.
+ *
+ * @param frame Pointer to the CAN frame to send.
+ * @param count Expected number of RX callbacks.
+ */
+static void send_expect_rx_callbacks(const struct can_frame *frame, int count)
+{
+	int err;
+
+	k_sem_reset(&rx_callback_sem);
+	send_test_frame(can_dev, frame);
+
+	for (int i = 0; i < count; i++) {
+		err = k_sem_take(&rx_callback_sem, TEST_RECEIVE_TIMEOUT);
+		zassert_equal(err, 0, "missing rx callback");
+	}
+
+	err = k_sem_take(&rx_callback_sem, TEST_RECEIVE_TIMEOUT);
+	zassert_equal(err, -EAGAIN, "unexpected rx callback");
+}
+
+/**
+ * @brief Test RX filters sharing a hardware filter element.
+ *
+ * Once all filter elements are in use, a filter is merged into the element
+ * whose mask loses the fewest bits, and frames accepted by the merged element
+ * are delivered only to the filters they match.
+ */
+ZTEST(can_api, test_shared_filter)
+{
+	struct can_filter filler = {
+		.id_type = CAN_STANDARD_IDENTIFIER,
+		.rtr = CAN_DATAFRAME,
+		.rtr_mask = 1,
+		.id_mask = CAN_STD_ID_MASK
+	};
+	/* Accepted by the merged element, but matching neither filter */
+	struct can_frame frame = test_std_frame_1;
+	int filter_id_1;
+	int filter_id_2;
+	int filter_id;
+	int max;
+	int i;
+
+	max = can_get_max_filters(can_dev, CAN_STANDARD_IDENTIFIER);
+	zassert_true(max > 0, "failed to get max filters (err %d)", max);
+
+	int filter_ids[max];
+
+	/* The filler identifiers all differ from TEST_CAN_STD_ID_2 by more bits
+	 * than TEST_CAN_STD_ID_1 does.
+	 */
+	filter_id_1 = add_rx_filter(can_dev, &test_std_filter_1, rx_std_callback_1);
+
+	for (i = 1; i < max; i++) {
+		filler.id = i;
+		filter_ids[i] = add_rx_msgq(can_dev, &filler);
+	}
+
+	filter_id_2 = can_add_rx_filter(can_dev, rx_std_callback_2,
+					(void *)&test_std_filter_2, &test_std_filter_2);
+	zassert_true(filter_id_2 >= 0, "shared filter not added (err %d)", filter_id_2);
+
+	send_expect_rx_callbacks(&test_std_frame_1, 1);
+	send_expect_rx_callbacks(&test_std_frame_2, 1);
+
+	frame.id = TEST_CAN_STD_ID_1 & ~0x3;
+	send_expect_rx_callbacks(&frame, 0);
+
+	/* The element stays in use for the shared filter */
+	can_remove_rx_filter(can_dev, filter_id_1);
+	send_expect_rx_callbacks(&test_std_frame_1, 0);
+	send_expect_rx_callbacks(&test_std_frame_2, 1);
+
+	/* Once no filter is left, the element is free again */
+	can_remove_rx_filter(can_dev, filter_id_2);
+	send_expect_rx_callbacks(&test_std_frame_2, 0);
+
+	filter_id = add_rx_filter(can_dev, &test_std_filter_2, rx_std_callback_2);
+	zassert_true(filter_id < max, "filter not added to a free element");
+	send_expect_rx_callbacks(&test_std_frame_2, 1);
+
+	can_remove_rx_filter(can_dev, filter_id);
+
+	for (i = 1; i < max; i++) {
+		can_remove_rx_filter(can_dev, filter_ids[i]);
+	}
+}
+#endif /* CONFIG_CAN_MCAN_SHARED_FILTERS > 0 */
+
 /**
  * @brief Test that frames with invalid Data Length Code (DLC) are rejected.
  */
@@ -206,6 +206,68 @@ ZTEST(disk_driver, test_write)
 	}
 }
 
+#ifdef CONFIG_DISK_ACCESS_ASYNC
+#define ASYNC_REQ_COUNT 4
+
+static K_SEM_DEFINE(async_done, 0, ASYNC_REQ_COUNT);
+
+static void async_req_cb(struct disk_access_req *req)
+{
+	k_sem_give(&async_done);
+}
+
+static void async_submit_all(struct disk_access_req *reqs, enum disk_access_op op,
+			     uint8_t *buf)
+{
+	int rc, i;
+
+	for (i = 0; i < ASYNC_REQ_COUNT; i++) {
+		reqs[i] = (struct disk_access_req) {
+			.pdrv = disk_pdrv,
+			.op = op,
+			.data_buf = buf + i * SECTOR_COUNT1 * disk_sector_size,
+			.start_sector = i * SECTOR_COUNT1,
+			.num_sector = SECTOR_COUNT1,
+			.cb = async_req_cb,
+			.result = -EINPROGRESS,
+		};
+		rc = disk_access_submit(&reqs[i]);
+		zassert_equal(rc, 0, "Failed to submit request");
+	}
+
+	for (i = 0; i < ASYNC_REQ_COUNT; i++) {
+		rc = k_sem_take(&async_done, K_SECONDS(5));
+		zassert_equal(rc, 0, "Request did not complete");
+	}
+
+	for (i = 0; i < ASYNC_REQ_COUNT; i++) {
+		zassert_equal(reqs[i].result, 0, "Request failed");
+	}
+}
+
+/* Test that adjacent queued requests, which are merged, complete correctly
+ * WARNING: this test is destructive- it will overwrite data on the disk!
+ */
+ZTEST(disk_driver, test_submit)
+{
+	static struct disk_access_req reqs[ASYNC_REQ_COUNT];
+	int i;
+
+	BUILD_ASSERT(ASYNC_REQ_COUNT * SECTOR_COUNT1 <= SECTOR_COUNT4);
+
+	for (i = 0; i < ASYNC_REQ_COUNT * SECTOR_COUNT1 * disk_sector_size; i++) {
+		scratch_buf[0][i] = (uint8_t)(i * 7);
+	}
+	async_submit_all(reqs, DISK_ACCESS_OP_WRITE, scratch_buf[0]);
+
+	memset(scratch_buf[1], 0, ASYNC_REQ_COUNT * SECTOR_COUNT1 * disk_sector_size);
+	async_submit_all(reqs, DISK_ACCESS_OP_READ, scratch_buf[1]);
+
+	zassert_mem_equal(scratch_buf[0], scratch_buf[1],
+			  ASYNC_REQ_COUNT * SECTOR_COUNT1 * disk_sector_size,
+			  "Read data did not match data written to disk");
+}
+#endif /* CONFIG_DISK_ACCESS_ASYNC */
 
 static void *disk_driver_setup(void)
 {
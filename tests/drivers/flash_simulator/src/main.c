@@ -288,6 +288,93 @@ ZTEST(flash_sim_api, test_get_erase_value)
 		      FLASH_SIMULATOR_ERASE_VALUE);
 }
 
+#ifdef CONFIG_FLASH_PAGE_LAYOUT
+ZTEST(flash_sim_api, test_page_info)
+{
+	const size_t count = TEST_SIM_FLASH_SIZE / FLASH_SIMULATOR_ERASE_UNIT;
+	struct flash_pages_info info;
+	int rc;
+
+	zassert_equal(count, flash_get_page_count(flash_dev),
+		      "Unexpected page count");
+
+	rc = flash_get_page_info_by_offs(flash_dev,
+					 3 * FLASH_SIMULATOR_ERASE_UNIT + 1,
+					 &info);
+	zassert_equal(0, rc, "flash_get_page_info_by_offs should succeed");
+	zassert_equal(3, info.index, "Unexpected page index");
+	zassert_equal(3 * FLASH_SIMULATOR_ERASE_UNIT, info.start_offset,
+		      "Unexpected page start");
+	zassert_equal(FLASH_SIMULATOR_ERASE_UNIT, info.size,
+		      "Unexpected page size");
+
+	rc = flash_get_page_info_by_idx(flash_dev, count - 1, &info);
+	zassert_equal(0, rc, "flash_get_page_info_by_idx should succeed");
+	zassert_equal((count - 1) * FLASH_SIMULATOR_ERASE_UNIT,
+		      info.start_offset, "Unexpected page start");
+
+	rc = flash_get_page_info_by_idx(flash_dev, count, &info);
+	zassert_equal(-EINVAL, rc, "Page past the end found");
+
+	rc = flash_get_page_info_by_offs(flash_dev, TEST_SIM_FLASH_SIZE, &info);
+	zassert_equal(-EINVAL, rc, "Page past the end found");
+}
+#endif
+
+#ifdef CONFIG_FLASH_ASYNC
+static K_SEM_DEFINE(async_sem, 0, 1);
+
+static void async_cb(struct flash_async_req *req)
+{
+	k_sem_give(&async_sem);
+}
+
+static int async_run(struct flash_async_req *req, enum flash_async_op op,
+		     off_t offset, void *data, size_t size)
+{
+	int rc;
+
+	req->dev = flash_dev;
+	req->op = op;
+	req->offset = offset;
+	req->data = data;
+	req->size = size;
+	req->cb = async_cb;
+
+	rc = flash_async_submit(req);
+	zassert_equal(0, rc, "flash_async_submit should succeed");
+	zassert_equal(0, k_sem_take(&async_sem, K_SECONDS(1)),
+		      "Request did not complete");
+
+	return req->result;
+}
+
+ZTEST(flash_sim_api, test_async)
+{
+	struct flash_async_req req = { 0 };
+	uint32_t data = 0xfeedbeefU;
+	uint32_t rd = 0U;
+	int rc;
+
+	rc = async_run(&req, FLASH_ASYNC_OP_ERASE, FLASH_SIMULATOR_BASE_OFFSET,
+		       NULL, FLASH_SIMULATOR_ERASE_UNIT);
+	zassert_equal(0, rc, "async erase should succeed");
+
+	rc = async_run(&req, FLASH_ASYNC_OP_WRITE, FLASH_SIMULATOR_BASE_OFFSET,
+		       &data, sizeof(data));
+	zassert_equal(0, rc, "async write should succeed");
+
+	rc = async_run(&req, FLASH_ASYNC_OP_READ, FLASH_SIMULATOR_BASE_OFFSET,
+		       &rd, sizeof(rd));
+	zassert_equal(0, rc, "async read should succeed");
+	zassert_equal(data, rd, "Unexpected read back value 0x%x", rd);
+
+	rc = async_run(&req, FLASH_ASYNC_OP_ERASE, TEST_SIM_FLASH_END,
+		       NULL, FLASH_SIMULATOR_ERASE_UNIT);
+	zassert_equal(-EINVAL, rc, "Unexpected error code (%d)", rc);
+}
+#endif /* CONFIG_FLASH_ASYNC */
+
 #include <zephyr/drivers/flash/flash_simulator.h>
 
 ZTEST(flash_sim_api, test_get_mock)
@@ -42,6 +42,10 @@ void test_i2s_dir_both_state_running_neg(void);
 void test_i2s_dir_both_state_stopping_neg(void);
 void test_i2s_dir_both_state_error_neg(void);
 
+void test_i2s_stream_configure(void);
+void test_i2s_stream_params(void);
+void test_i2s_stream_loopback(void);
+
 extern struct k_mem_slab rx_mem_slab;
 extern struct k_mem_slab tx_mem_slab;
 
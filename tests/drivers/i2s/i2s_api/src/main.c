@@ -66,6 +66,12 @@ void test_main(void)
 		ztest_unit_test(test_i2s_dir_both_state_error_neg));
 	ztest_run_test_suite(i2s_dir_both_states_test);
 
+	ztest_test_suite(i2s_stream_test,
+		ztest_unit_test(test_i2s_stream_configure),
+		ztest_unit_test(test_i2s_stream_params),
+		ztest_unit_test(test_i2s_stream_loopback));
+	ztest_run_test_suite(i2s_stream_test);
+
 	/* Now run all tests in user mode */
 	ztest_test_suite(i2s_user_loopback_test,
 		ztest_user_unit_test(test_i2s_tx_transfer_configure_0),
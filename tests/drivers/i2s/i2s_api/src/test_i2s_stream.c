@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/drivers/i2s.h>
+#include "i2s_api_test.h"
+
+#define NUM_PERIODS		4
+#define NUM_RX_PERIODS		32
+/* Periods received before the looped back data is there */
+#define NUM_RX_PERIODS_SKIP	4
+
+#define VAL_L	0x1234
+#define VAL_R	0x5678
+
+/* Duration of a period, in microseconds */
+#define PERIOD_US (SAMPLE_NO * USEC_PER_SEC / FRAME_CLK_FREQ)
+
+static const struct device *dev_i2s_rx;
+static const struct device *dev_i2s_tx;
+
+static int16_t tx_buf[NUM_PERIODS][BLOCK_SIZE / sizeof(int16_t)] __aligned(32);
+static int16_t rx_buf[NUM_PERIODS][BLOCK_SIZE / sizeof(int16_t)] __aligned(32);
+
+struct period_check {
+	void *buffer;
+	uint32_t count;
+	uint32_t first_timestamp;
+	uint32_t last_timestamp;
+	uint32_t errors;
+	uint32_t data_errors;
+};
+
+static struct period_check tx_check;
+static struct period_check rx_check;
+
+static K_SEM_DEFINE(rx_done_sem, 0, 1);
+
+/* Called from interrupt context, errors are counted and checked later */
+static void period_callback(const struct device *dev, enum i2s_dir dir,
+			    void *period, size_t size, uint32_t timestamp,
+			    void *user_data)
+{
+	struct period_check *check = user_data;
+	uint8_t *expected = (uint8_t *)check->buffer +
+			    (check->count % NUM_PERIODS) * BLOCK_SIZE;
+
+	/* The periods complete in turn, each one once */
+	if (period != expected || size != BLOCK_SIZE ||
+	    (check->count > 0 &&
+	     (int32_t)(timestamp - check->last_timestamp) < 0)) {
+		check->errors++;
+	}
+
+	if (check->count == 0) {
+		check->first_timestamp = timestamp;
+	}
+	check->last_timestamp = timestamp;
+
+	if (dir == I2S_DIR_RX) {
+		if (check->count >= NUM_RX_PERIODS_SKIP &&
+		    verify_buf_const(period, VAL_L, VAL_R) != TC_PASS) {
+			check->data_errors++;
+		}
+
+		/* Received data is consumed in place */
+		fill_buf_const(period, 0, 0);
+
+		if (check->count + 1 == NUM_RX_PERIODS) {
+			k_sem_give(&rx_done_sem);
+		}
+	}
+
+	check->count++;
+}
+
+static void stream_config_init(struct i2s_stream_config *config, void *buffer,
+			       struct period_check *check)
+{
+	memset(check, 0, sizeof(*check));
+	check->buffer = buffer;
+
+	config->buffer = buffer;
+	config->buffer_size = NUM_PERIODS * BLOCK_SIZE;
+	config->period_size = BLOCK_SIZE;
+	config->callback = period_callback;
+	config->user_data = check;
+}
+
+/** Configure I2S TX and RX transfers for the period streams. */
+void test_i2s_stream_configure(void)
+{
+	int ret;
+
+	if (IS_ENABLED(CONFIG_I2S_TEST_USE_I2S_DIR_BOTH)) {
+		TC_PRINT("Period streams are started per direction.\n");
+		ztest_test_skip();
+		return;
+	}
+
+	dev_i2s_tx = device_get_binding(I2S_DEV_NAME_TX);
+	zassert_not_null(dev_i2s_tx, "device " I2S_DEV_NAME_TX " not found");
+
+	dev_i2s_rx = device_get_binding(I2S_DEV_NAME_RX);
+	zassert_not_null(dev_i2s_rx, "device " I2S_DEV_NAME_RX " not found");
+
+	ret = configure_stream(dev_i2s_tx, I2S_DIR_TX);
+	zassert_equal(ret, TC_PASS);
+
+	ret = configure_stream(dev_i2s_rx, I2S_DIR_RX);
+	zassert_equal(ret, TC_PASS);
+}
+
+/** @brief Period stream parameters.
+ *
+ * - Invalid stream configurations are rejected.
+ * - I2S_DIR_BOTH is not supported.
+ * - Stopping a direction that is not streaming fails.
+ */
+void test_i2s_stream_params(void)
+{
+	struct i2s_stream_config config;
+	int ret;
+
+	if (IS_ENABLED(CONFIG_I2S_TEST_USE_I2S_DIR_BOTH)) {
+		ztest_test_skip();
+		return;
+	}
+
+	ret = i2s_stream_stop(dev_i2s_rx, I2S_DIR_RX);
+	if (ret == -ENOTSUP) {
+		TC_PRINT("Period streams not supported by the driver.\n");
+		ztest_test_skip();
+		return;
+	}
+	zassert_equal(ret, -EALREADY, "RX stream stopped while not running");
+
+	stream_config_init(&config, rx_buf, &rx_check);
+	ret = i2s_stream_start(dev_i2s_rx, I2S_DIR_BOTH, &config);
+	zassert_equal(ret, -ENOSYS, "I2S_DIR_BOTH stream started");
+
+	config.callback = NULL;
+	ret = i2s_stream_start(dev_i2s_rx, I2S_DIR_RX, &config);
+	zassert_equal(ret, -EINVAL, "stream started without callback");
+
+	stream_config_init(&config, rx_buf, &rx_check);
+	config.buffer_size = NUM_PERIODS * BLOCK_SIZE - 1;
+	ret = i2s_stream_start(dev_i2s_rx, I2S_DIR_RX, &config);
+	zassert_equal(ret, -EINVAL, "buffer not split into periods accepted");
+
+	/* Too few periods to be kept loaded by the DMA */
+	config.buffer_size = BLOCK_SIZE;
+	ret = i2s_stream_start(dev_i2s_rx, I2S_DIR_RX, &config);
+	zassert_equal(ret, -EINVAL, "single period buffer accepted");
+}
+
+/** @brief Period stream loopback.
+ *
+ * - The periods are reported in turn, with increasing timestamps spaced
+ *   by the period duration.
+ * - The data of the TX periods is received in the RX periods.
+ * - The streaming directions cannot be triggered or started again.
+ * - The callback is not called anymore once the streams are stopped.
+ */
+void test_i2s_stream_loopback(void)
+{
+	struct i2s_stream_config tx_config;
+	struct i2s_stream_config rx_config;
+	uint32_t interval_us;
+	uint32_t count;
+	int ret;
+
+	if (IS_ENABLED(CONFIG_I2S_TEST_USE_I2S_DIR_BOTH)) {
+		ztest_test_skip();
+		return;
+	}
+
+	for (int i = 0; i < NUM_PERIODS; i++) {
+		fill_buf_const(tx_buf[i], VAL_L, VAL_R);
+		fill_buf_const(rx_buf[i], 0, 0);
+	}
+
+	stream_config_init(&tx_config, tx_buf, &tx_check);
+	stream_config_init(&rx_config, rx_buf, &rx_check);
+	k_sem_reset(&rx_done_sem);
+
+	ret = i2s_stream_start(dev_i2s_rx, I2S_DIR_RX, &rx_config);
+	if (ret == -ENOTSUP) {
+		ztest_test_skip();
+		return;
+	}
+	zassert_equal(ret, 0, "RX stream start failed");
+
+	ret = i2s_stream_start(dev_i2s_tx, I2S_DIR_TX, &tx_config);
+	zassert_equal(ret, 0, "TX stream start failed");
+
+	ret = i2s_stream_start(dev_i2s_rx, I2S_DIR_RX, &rx_config);
+	zassert_equal(ret, -EBUSY, "RX stream started twice");
+
+	ret = i2s_trigger(dev_i2s_tx, I2S_DIR_TX, I2S_TRIGGER_STOP);
+	zassert_equal(ret, -EIO, "TX stream triggered while streaming");
+
+	ret = k_sem_take(&rx_done_sem, K_MSEC(NUM_RX_PERIODS * PERIOD_US /
+					      USEC_PER_MSEC + TIMEOUT));
+	zassert_equal(ret, 0, "RX periods not received");
+
+	ret = i2s_stream_stop(dev_i2s_rx, I2S_DIR_RX);
+	zassert_equal(ret, 0, "RX stream stop failed");
+
+	ret = i2s_stream_stop(dev_i2s_tx, I2S_DIR_TX);
+	zassert_equal(ret, 0, "TX stream stop failed");
+
+	count = rx_check.count;
+	k_msleep(4 * PERIOD_US / USEC_PER_MSEC);
+	zassert_equal(rx_check.count, count, "callback called after stop");
+
+	ret = i2s_stream_stop(dev_i2s_rx, I2S_DIR_RX);
+	zassert_equal(ret, -EALREADY, "RX stream stopped twice");
+
+	zassert_equal(tx_check.errors, 0, "TX periods out of order");
+	zassert_equal(rx_check.errors, 0, "RX periods out of order");
+	zassert_true(tx_check.count >= NUM_RX_PERIODS - NUM_PERIODS,
+		     "%u TX periods completed", tx_check.count);
+	zassert_equal(rx_check.data_errors, 0, "%u RX periods mismatch",
+		      rx_check.data_errors);
+
+	/* Timestamps spaced by the period duration, within 10% */
+	interval_us = k_cyc_to_us_floor32(rx_check.last_timestamp -
+					  rx_check.first_timestamp) /
+		      (rx_check.count - 1);
+	zassert_within(interval_us, PERIOD_US, PERIOD_US / 10,
+		       "period interval %u us", interval_us);
+}
@@ -161,12 +161,104 @@ int dummy_sensor_trigger_set(const struct device *dev,
 	return 0;
 }
 
+#ifdef CONFIG_SENSOR_STREAM
+/* Blocks hold a frame count followed by the light samples of each frame,
+ * the value of a sample being its frame index times 10 minus 20.
+ */
+static void dummy_sensor_stream_submit(const struct device *dev,
+				       const struct rtio_sqe *sqe,
+				       struct rtio *r)
+{
+	int16_t *block = (int16_t *)sqe->buf;
+
+	ARG_UNUSED(dev);
+
+	if (sqe->buf_len < (DUMMY_STREAM_FRAMES + 1) * sizeof(int16_t)) {
+		rtio_sqe_err(r, sqe, -ENOMEM);
+		return;
+	}
+
+	block[0] = DUMMY_STREAM_FRAMES;
+	for (int i = 0; i < DUMMY_STREAM_FRAMES; i++) {
+		block[i + 1] = i * 10 - 20;
+	}
+
+	rtio_sqe_ok(r, sqe, (DUMMY_STREAM_FRAMES + 1) * sizeof(int16_t));
+}
+
+static int dummy_decoder_get_frame_count(const uint8_t *buf, size_t len,
+					 uint16_t *frame_count)
+{
+	const int16_t *block = (const int16_t *)buf;
+
+	if (len < sizeof(int16_t) ||
+	    len < (block[0] + 1) * sizeof(int16_t)) {
+		return -EINVAL;
+	}
+
+	*frame_count = block[0];
+
+	return 0;
+}
+
+static int dummy_decoder_decode(const uint8_t *buf, size_t len,
+				enum sensor_channel chan,
+				uint16_t first_frame, uint16_t max_count,
+				int32_t *values, int8_t *shift)
+{
+	const int16_t *block = (const int16_t *)buf;
+	uint16_t frame_count;
+	int ret;
+
+	ret = dummy_decoder_get_frame_count(buf, len, &frame_count);
+	if (ret) {
+		return ret;
+	}
+
+	if (chan != SENSOR_CHAN_LIGHT) {
+		return -ENOTSUP;
+	}
+
+	if (first_frame >= frame_count) {
+		return 0;
+	}
+
+	max_count = MIN(max_count, frame_count - first_frame);
+	for (int i = 0; i < max_count; i++) {
+		values[i] = block[first_frame + i + 1] * (1 << 16);
+	}
+
+	*shift = 15;
+
+	return max_count;
+}
+
+static const struct sensor_decoder_api dummy_decoder = {
+	.get_frame_count = dummy_decoder_get_frame_count,
+	.decode = dummy_decoder_decode,
+};
+
+static int dummy_sensor_get_decoder(const struct device *dev,
+				    const struct sensor_decoder_api **decoder)
+{
+	ARG_UNUSED(dev);
+
+	*decoder = &dummy_decoder;
+
+	return 0;
+}
+#endif /* CONFIG_SENSOR_STREAM */
+
 static const struct sensor_driver_api dummy_sensor_api = {
 	.sample_fetch = &dummy_sensor_sample_fetch,
 	.channel_get = &dummy_sensor_channel_get,
 	.attr_set = dummy_sensor_attr_set,
 	.attr_get = dummy_sensor_attr_get,
 	.trigger_set = dummy_sensor_trigger_set,
+#ifdef CONFIG_SENSOR_STREAM
+	.get_decoder = dummy_sensor_get_decoder,
+	.stream_submit = dummy_sensor_stream_submit,
+#endif
 };
 
 static const struct sensor_driver_api dummy_sensor_no_trig_api = {
@@ -13,6 +13,7 @@
 #define DUMMY_SENSOR_NAME	"dummy_sensor"
 #define DUMMY_SENSOR_NAME_NO_TRIG	"dummy_sensor_no_trig"
 #define SENSOR_CHANNEL_NUM	5
+#define DUMMY_STREAM_FRAMES	6
 
 struct dummy_sensor_data {
 	sensor_trigger_handler_t handler;
@@ -311,4 +311,72 @@ ZTEST(sensor_api, test_sensor_unit_conversion)
 #endif
 }
 
+#ifdef CONFIG_SENSOR_STREAM
+#include <zephyr/rtio/rtio_executor_simple.h>
+
+DEVICE_DECLARE(dummy_sensor);
+SENSOR_STREAM_IODEV_DEFINE(dummy_stream_iodev, DEVICE_GET(dummy_sensor));
+
+RTIO_EXECUTOR_SIMPLE_DEFINE(stream_exec);
+RTIO_DEFINE(stream_rtio, (struct rtio_executor *)&stream_exec, 4, 4);
+
+/**
+ * @brief Test sensor streaming
+ * @details Read a block of frames through the RTIO IO device of the
+ * dummy sensor and decode it in bulk, starting from the second frame.
+ */
+ZTEST(sensor_api, test_sensor_stream)
+{
+	const struct device *dev = device_get_binding(DUMMY_SENSOR_NAME);
+	const struct sensor_decoder_api *decoder;
+	static uint8_t buf[32];
+	int32_t values[DUMMY_STREAM_FRAMES];
+	struct rtio_sqe *sqe;
+	struct rtio_cqe *cqe;
+	uint16_t frame_count;
+	int8_t shift;
+	size_t len;
+	int ret;
+
+	zassert_not_null(dev, "failed: dev is null");
+	zassert_equal(sensor_get_decoder(device_get_binding(DUMMY_SENSOR_NAME_NO_TRIG),
+					 &decoder), -ENOSYS, "decoder should be missing");
+	zassert_ok(sensor_get_decoder(dev, &decoder), "failed to get decoder");
+
+	sqe = rtio_spsc_acquire(stream_rtio.sq);
+	zassert_not_null(sqe, "Expected a valid sqe");
+	rtio_sqe_prep_read(sqe, &dummy_stream_iodev.iodev, RTIO_PRIO_NORM,
+			   buf, sizeof(buf), buf);
+	rtio_spsc_produce(stream_rtio.sq);
+
+	zassert_ok(rtio_submit(&stream_rtio, 1), "submit failed");
+
+	cqe = rtio_spsc_consume(stream_rtio.cq);
+	zassert_not_null(cqe, "Expected a valid cqe");
+	zassert_true(cqe->result > 0, "read failed");
+	zassert_equal_ptr(cqe->userdata, buf, "Expected userdata back");
+	len = cqe->result;
+	rtio_spsc_release(stream_rtio.cq);
+
+	zassert_ok(decoder->get_frame_count(buf, len, &frame_count),
+		   "malformed block");
+	zassert_equal(frame_count, DUMMY_STREAM_FRAMES, "wrong frame count");
+
+	ret = decoder->decode(buf, len, SENSOR_CHAN_LIGHT, 1,
+			      ARRAY_SIZE(values), values, &shift);
+	zassert_equal(ret, DUMMY_STREAM_FRAMES - 1, "wrong number of frames");
+	for (int i = 0; i < ret; i++) {
+		zassert_equal(values[i] / (1 << (31 - shift)), (i + 1) * 10 - 20,
+			      "the data is not match.");
+	}
+
+	zassert_equal(decoder->decode(buf, len, SENSOR_CHAN_LIGHT,
+				      DUMMY_STREAM_FRAMES, ARRAY_SIZE(values),
+				      values, &shift), 0, "frames past the end");
+	zassert_equal(decoder->decode(buf, len, SENSOR_CHAN_RED, 0,
+				      ARRAY_SIZE(values), values, &shift),
+		      -ENOTSUP, "channel should not be supported");
+}
+#endif /* CONFIG_SENSOR_STREAM */
+
 ZTEST_SUITE(sensor_api, NULL, NULL, ztest_simple_1cpu_before, ztest_simple_1cpu_after, NULL);
@@ -506,6 +506,122 @@ static int spi_async_call(struct spi_dt_spec *spec)
 }
 #endif
 
+#if CONFIG_SPI_RTIO
+#include <zephyr/rtio/rtio_executor_simple.h>
+
+#define RTIO_BENCH_ITERATIONS 100
+
+SPI_DT_IODEV_DEFINE(spi_fast_iodev, SPI_FAST_DEV, SPI_OP, 0);
+RTIO_EXECUTOR_SIMPLE_DEFINE(spi_rtio_exec);
+RTIO_DEFINE(spi_rtio, (struct rtio_executor *)&spi_rtio_exec, 4, 4);
+
+/* Submit a write followed by a read, chained in a single transaction */
+static int spi_rtio_write_read(void)
+{
+	struct rtio_sqe *sqe;
+	struct rtio_cqe *cqe;
+	int ret = 0;
+
+	sqe = rtio_spsc_acquire(spi_rtio.sq);
+	rtio_sqe_prep_write(sqe, &spi_fast_iodev.iodev, RTIO_PRIO_NORM,
+			    buffer_tx, BUF_SIZE, buffer_tx);
+	sqe->flags = RTIO_SQE_CHAINED;
+	sqe = rtio_spsc_acquire(spi_rtio.sq);
+	rtio_sqe_prep_read(sqe, &spi_fast_iodev.iodev, RTIO_PRIO_NORM,
+			   buffer_rx, BUF_SIZE, buffer_rx);
+	sqe->flags = 0;
+	rtio_spsc_produce_all(spi_rtio.sq);
+
+	rtio_submit(&spi_rtio, 2);
+
+	while ((cqe = rtio_spsc_consume(spi_rtio.cq)) != NULL) {
+		if (cqe->result < 0) {
+			ret = cqe->result;
+		}
+		rtio_spsc_release(spi_rtio.cq);
+	}
+
+	return ret;
+}
+
+static int spi_rtio_chain(struct spi_dt_spec *spec)
+{
+	struct spi_buf tx_bufs[] = {
+		{
+			.buf = buffer_tx,
+			.len = BUF_SIZE,
+		},
+		{
+			.buf = NULL,
+			.len = BUF_SIZE,
+		},
+	};
+	struct spi_buf rx_bufs[] = {
+		{
+			.buf = NULL,
+			.len = BUF_SIZE,
+		},
+		{
+			.buf = buffer_rx,
+			.len = BUF_SIZE,
+		},
+	};
+	const struct spi_buf_set tx = {
+		.buffers = tx_bufs,
+		.count = ARRAY_SIZE(tx_bufs)
+	};
+	const struct spi_buf_set rx = {
+		.buffers = rx_bufs,
+		.count = ARRAY_SIZE(rx_bufs)
+	};
+	uint32_t start;
+	uint32_t sync_cycles;
+	uint32_t rtio_cycles;
+	int ret;
+
+	LOG_INF("Start RTIO chain");
+
+	ret = spi_rtio_write_read();
+	if (ret) {
+		LOG_ERR("Code %d", ret);
+		zassert_false(ret, "SPI RTIO chain failed");
+		return ret;
+	}
+
+	/* Per transaction overhead of the same write then read transaction,
+	 * as a single blocking call and as a chain of RTIO submissions.
+	 */
+	start = k_cycle_get_32();
+	for (int i = 0; i < RTIO_BENCH_ITERATIONS; i++) {
+		ret = spi_transceive_dt(spec, &tx, &rx);
+		if (ret) {
+			break;
+		}
+	}
+	sync_cycles = (k_cycle_get_32() - start) / RTIO_BENCH_ITERATIONS;
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < RTIO_BENCH_ITERATIONS && ret == 0; i++) {
+		ret = spi_rtio_write_read();
+	}
+	rtio_cycles = (k_cycle_get_32() - start) / RTIO_BENCH_ITERATIONS;
+
+	if (ret) {
+		LOG_ERR("Code %d", ret);
+		zassert_false(ret, "SPI transfer failed");
+		return ret;
+	}
+
+	LOG_INF("Write then read of %d bytes: transceive %u us, RTIO %u us",
+		BUF_SIZE, k_cyc_to_us_floor32(sync_cycles),
+		k_cyc_to_us_floor32(rtio_cycles));
+
+	LOG_INF("Passed");
+
+	return 0;
+}
+#endif
+
 static int spi_resource_lock_test(struct spi_dt_spec *lock_spec,
 				  struct spi_dt_spec *try_spec)
 {
@@ -572,6 +688,9 @@ ZTEST(spi_loopback, test_spi_loopback)
 	    spi_rx_every_4(&spi_fast)
 #if (CONFIG_SPI_ASYNC)
 	    || spi_async_call(&spi_fast)
+#endif
+#if CONFIG_SPI_RTIO
+	    || spi_rtio_chain(&spi_fast)
 #endif
 	    ) {
 		goto end;
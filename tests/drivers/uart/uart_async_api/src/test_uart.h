@@ -15,6 +15,7 @@
 #define __TEST_UART_H__
 
 #include <zephyr/drivers/uart.h>
+#include <zephyr/drivers/uart/uart_async_rx.h>
 #include <zephyr/ztest.h>
 
 /* RX and TX pins have to be connected together*/
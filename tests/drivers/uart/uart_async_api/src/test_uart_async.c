@@ -767,6 +767,92 @@ ZTEST_USER(uart_async_long_buf, test_long_buffers)
 		      "RX_DISABLED timeout");
 }
 
+#ifdef CONFIG_UART_ASYNC_RX_HELPER
+#define RX_HELPER_BUF_LEN 16
+#define RX_HELPER_BUF_CNT 3
+
+static uint8_t rx_helper_pool[RX_HELPER_BUF_CNT *
+			      (RX_HELPER_BUF_LEN + UART_ASYNC_RX_BUF_OVERHEAD)];
+static struct uart_async_rx rx_helper;
+
+static void test_rx_helper_callback(const struct device *dev,
+				    struct uart_event *evt, void *user_data)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(user_data);
+
+	uart_async_rx_on_event(&rx_helper, evt);
+
+	switch (evt->type) {
+	case UART_TX_DONE:
+		k_sem_give(&tx_done);
+		break;
+	case UART_RX_DISABLED:
+		k_sem_give(&rx_disabled);
+		break;
+	default:
+		break;
+	}
+}
+
+static void *rx_helper_setup(void)
+{
+	const struct uart_async_rx_config config = {
+		.buffer = rx_helper_pool,
+		.length = sizeof(rx_helper_pool),
+		.buf_cnt = RX_HELPER_BUF_CNT,
+		.timeout = 10 * USEC_PER_MSEC,
+	};
+
+	uart_async_test_init();
+
+	zassert_ok(uart_async_rx_init(&rx_helper, uart_dev, &config),
+		   "Failed to initialize RX helper");
+	uart_callback_set(uart_dev, test_rx_helper_callback, NULL);
+
+	return NULL;
+}
+
+ZTEST(uart_async_rx_helper, test_rx_helper)
+{
+	uint8_t tx_buf[10];
+	uint8_t rx_buf[sizeof(tx_buf)];
+	size_t rx_len;
+	size_t len;
+	uint8_t *data;
+
+	zassert_ok(uart_async_rx_enable(&rx_helper), "Failed to enable RX");
+
+	/* Receive more data than fits in all buffers, so buffers are reused */
+	for (int i = 0; i < 2 * RX_HELPER_BUF_CNT; i++) {
+		memset(tx_buf, i, sizeof(tx_buf));
+
+		uart_tx(uart_dev, tx_buf, sizeof(tx_buf), 100 * USEC_PER_MSEC);
+		zassert_equal(k_sem_take(&tx_done, K_MSEC(100)), 0, "TX_DONE timeout");
+		k_msleep(20);
+
+		zassert_equal(uart_async_rx_pending(&rx_helper), sizeof(tx_buf),
+			      "Unexpected number of pending bytes");
+
+		rx_len = 0;
+		while ((len = uart_async_rx_data_claim(&rx_helper, &data,
+						       sizeof(rx_buf) - rx_len)) > 0) {
+			memcpy(&rx_buf[rx_len], data, len);
+			uart_async_rx_data_consume(&rx_helper, len);
+			rx_len += len;
+		}
+
+		zassert_equal(rx_len, sizeof(tx_buf), "Wrong number of bytes received");
+		zassert_equal(memcmp(tx_buf, rx_buf, sizeof(tx_buf)), 0,
+			      "Buffers not equal");
+	}
+
+	uart_async_rx_disable(&rx_helper);
+	zassert_equal(k_sem_take(&rx_disabled, K_MSEC(100)), 0,
+		      "RX_DISABLED timeout");
+}
+#endif /* CONFIG_UART_ASYNC_RX_HELPER */
+
 
 ZTEST_SUITE(uart_async_single_read, NULL, single_read_setup,
 		NULL, NULL, NULL);
@@ -794,3 +880,8 @@ ZTEST_SUITE(uart_async_write_abort, NULL, write_abort_setup,
 
 ZTEST_SUITE(uart_async_timeout, NULL, forever_timeout_setup,
 		NULL, NULL, NULL);
+
+#ifdef CONFIG_UART_ASYNC_RX_HELPER
+ZTEST_SUITE(uart_async_rx_helper, NULL, rx_helper_setup,
+		NULL, NULL, NULL);
+#endif
@@ -502,6 +502,49 @@ ZTEST(bitarray, test_bitarray_alloc_free)
 	alloc_and_free_interval();
 }
 
+/**
+ * @brief Test bitarrays allocation across allocated bundles
+ *
+ * Allocate regions spanning several bundles, where the regions
+ * starting at the first free bit overlap bits allocated in the
+ * middle bundles.
+ *
+ * @see sys_bitarray_alloc()
+ */
+ZTEST(bitarray, test_bitarray_alloc_across_bundles)
+{
+	int ret;
+	size_t offset;
+
+	SYS_BITARRAY_DEFINE(ba, 160);
+
+	/* Bitarrays have embedded spinlocks and can't on the stack. */
+	if (IS_ENABLED(CONFIG_KERNEL_COHERENCE)) {
+		ztest_test_skip();
+	}
+
+	/* Middle bundle partially allocated */
+	ret = sys_bitarray_set_region(&ba, 31, 32);
+	zassert_equal(ret, 0, "sys_bitarray_set_region() failed: %d", ret);
+
+	ret = sys_bitarray_alloc(&ba, 65, &offset);
+	zassert_equal(ret, 0, "sys_bitarray_alloc() failed: %d", ret);
+	zassert_equal(offset, 63, "sys_bitarray_alloc() offset expected %d, got %d",
+		      63, offset);
+
+	ret = sys_bitarray_clear_region(&ba, 160, 0);
+	zassert_equal(ret, 0, "sys_bitarray_clear_region() failed: %d", ret);
+
+	/* Middle bundle fully allocated */
+	ret = sys_bitarray_set_region(&ba, 32, 32);
+	zassert_equal(ret, 0, "sys_bitarray_set_region() failed: %d", ret);
+
+	ret = sys_bitarray_alloc(&ba, 80, &offset);
+	zassert_equal(ret, 0, "sys_bitarray_alloc() failed: %d", ret);
+	zassert_equal(offset, 64, "sys_bitarray_alloc() offset expected %d, got %d",
+		      64, offset);
+}
+
 ZTEST(bitarray, test_bitarray_region_set_clear)
 {
 	int ret;
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/ztest.h>
+
+/* Devices recording when they are initialized, see the
+ * vnd,device-init-test nodes of app.overlay
+ */
+struct init_test_config {
+	const struct device *supply;
+};
+
+struct init_test_data {
+	/* initialization rank, starting at 1 */
+	int order;
+	int init_calls;
+	/* the required device was initialized before this one */
+	bool supply_ready;
+};
+
+static struct k_spinlock init_lock;
+static int init_count;
+
+static int init_test_init(const struct device *dev)
+{
+	const struct init_test_config *config = dev->config;
+	struct init_test_data *data = dev->data;
+	k_spinlock_key_t key = k_spin_lock(&init_lock);
+
+	data->order = ++init_count;
+	data->init_calls++;
+	data->supply_ready = (config->supply == NULL) ||
+			     config->supply->state->initialized;
+
+	k_spin_unlock(&init_lock, key);
+
+	return 0;
+}
+
+#define INIT_TEST_DEVICE(name, prio)					\
+	static struct init_test_data name##_data;			\
+	static const struct init_test_config name##_config = {		\
+		.supply = COND_CODE_1(					\
+			DT_NODE_HAS_PROP(DT_NODELABEL(name), supply),	\
+			(DEVICE_DT_GET(DT_PHANDLE(DT_NODELABEL(name),	\
+						  supply))),		\
+			(NULL)),					\
+	};								\
+	DEVICE_DT_DEFINE(DT_NODELABEL(name), init_test_init, NULL,	\
+			 &name##_data, &name##_config, POST_KERNEL,	\
+			 prio, NULL)
+
+/* The consumer comes first in the init sequence, only its devicetree
+ * dependency orders it after the supplier.
+ */
+INIT_TEST_DEVICE(init_consumer, 80);
+INIT_TEST_DEVICE(init_supplier, 81);
+
+INIT_TEST_DEVICE(init_lazy, 82);
+INIT_TEST_DEVICE(init_lazy_supplier, 82);
+INIT_TEST_DEVICE(init_eager_consumer, 83);
+
+/**
+ * @brief Test dependency ordering of devices initialized in parallel
+ *
+ * @details A device is initialized after the devices it requires in
+ * devicetree, even when it comes first in the init sequence of the
+ * batch.
+ *
+ * @ingroup kernel_device_tests
+ */
+ZTEST(device_init, test_parallel_init_dependency)
+{
+	if (!IS_ENABLED(CONFIG_DEVICE_INIT_PARALLEL)) {
+		ztest_test_skip();
+	}
+
+	zassert_equal(init_supplier_data.init_calls, 1);
+	zassert_equal(init_consumer_data.init_calls, 1);
+	zassert_true(init_consumer_data.supply_ready,
+		     "consumer initialized before its supplier");
+	zassert_true(init_supplier_data.order < init_consumer_data.order);
+}
+
+/**
+ * @brief Test lazy device initialization through device_is_ready()
+ *
+ * @details A lazy device is not initialized at boot. The first
+ * device_is_ready() call initializes it, later ones do not.
+ *
+ * @ingroup kernel_device_tests
+ */
+ZTEST(device_init, test_lazy_init_on_ready)
+{
+	const struct device *dev = DEVICE_DT_GET(DT_NODELABEL(init_lazy));
+
+	if (!IS_ENABLED(CONFIG_DEVICE_LAZY_INIT)) {
+		ztest_test_skip();
+	}
+
+	zassert_equal(init_lazy_data.init_calls, 0,
+		      "lazy device initialized at boot");
+	zassert_false(dev->state->initialized);
+
+	zassert_true(device_is_ready(dev));
+	zassert_equal(init_lazy_data.init_calls, 1);
+
+	zassert_true(device_is_ready(dev));
+	zassert_equal(init_lazy_data.init_calls, 1,
+		      "lazy device initialized twice");
+}
+
+/**
+ * @brief Test a device requiring a lazy device
+ *
+ * @details A device initialized at boot that requires a lazy device gets
+ * it initialized first.
+ *
+ * @ingroup kernel_device_tests
+ */
+ZTEST(device_init, test_lazy_required_by_eager)
+{
+	if (!IS_ENABLED(CONFIG_DEVICE_LAZY_INIT)) {
+		ztest_test_skip();
+	}
+
+	zassert_equal(init_eager_consumer_data.init_calls, 1);
+	zassert_equal(init_lazy_supplier_data.init_calls, 1,
+		      "required lazy device not initialized");
+	zassert_true(init_eager_consumer_data.supply_ready,
+		     "device initialized before the lazy device it requires");
+	zassert_true(init_lazy_supplier_data.order <
+		     init_eager_consumer_data.order);
+	zassert_true(device_is_ready(DEVICE_DT_GET(DT_NODELABEL(init_eager_consumer))));
+}
+
+ZTEST_SUITE(device_init, NULL, NULL, NULL, NULL, NULL);
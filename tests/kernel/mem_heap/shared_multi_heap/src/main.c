@@ -132,6 +132,7 @@ static void fill_multi_heap(void)
 
 ZTEST(shared_multi_heap, test_shared_multi_heap)
 {
+	struct sys_memory_stats stats;
 	struct region_map *reg_map;
 	void *block;
 	int ret;
@@ -200,6 +201,12 @@ ZTEST(shared_multi_heap, test_shared_multi_heap)
 	zassert_equal(reg_map->p_addr, RES1_NOCACHE_ADDR, "block in the wrong memory region");
 	zassert_equal(reg_map->region.attr, SMH_REG_ATTR_NON_CACHEABLE, "wrong memory attribute");
 
+	/* Both non-cacheable blocks are accounted to the attribute */
+	ret = shared_multi_heap_stats_get(SMH_REG_ATTR_NON_CACHEABLE, &stats);
+	zassert_equal(0, ret, "failed to get statistics");
+	zassert_true(stats.allocated_bytes >= 0x200, "wrong allocated bytes");
+	zassert_true(stats.free_bytes > 0, "wrong free bytes");
+
 	/* Request a block too big */
 	block = shared_multi_heap_alloc(SMH_REG_ATTR_NON_CACHEABLE, 0x10000);
 	zassert_is_null(block, "allocated buffer too big for the region");
@@ -211,6 +218,9 @@ ZTEST(shared_multi_heap, test_shared_multi_heap)
 	/* Request a non-existent attribute */
 	block = shared_multi_heap_alloc(MAX_SHARED_MULTI_HEAP_ATTR, 0x100);
 	zassert_is_null(block, "wrong attribute accepted as valid");
+
+	ret = shared_multi_heap_stats_get(MAX_SHARED_MULTI_HEAP_ATTR, &stats);
+	zassert_equal(-EINVAL, ret, "wrong attribute accepted as valid");
 }
 
 ZTEST_SUITE(shared_multi_heap, NULL, NULL, NULL, NULL, NULL);
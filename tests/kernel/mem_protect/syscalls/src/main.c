@@ -437,6 +437,27 @@ ZTEST(syscalls, test_syscall_context)
 	k_thread_user_mode_enter(test_syscall_context_user, NULL, NULL, NULL);
 }
 
+#ifdef CONFIG_SYSCALL_BATCH
+K_SEM_DEFINE(batch_sem, 0, 10);
+
+/* Show that batched system calls run in order and return their values */
+ZTEST_USER(syscalls, test_syscall_batch)
+{
+	struct k_syscall_req reqs[] = {
+		{ .id = K_SYSCALL_K_SEM_GIVE, .args = { (uintptr_t)&batch_sem } },
+		{ .id = K_SYSCALL_K_SEM_GIVE, .args = { (uintptr_t)&batch_sem } },
+		{ .id = K_SYSCALL_K_SEM_COUNT_GET, .args = { (uintptr_t)&batch_sem } },
+	};
+
+	zassert_equal(k_syscall_batch(reqs, ARRAY_SIZE(reqs)), 0,
+		      "batch failed");
+	zassert_equal(reqs[2].ret, 2, "calls not run in order");
+	zassert_equal(k_sem_count_get(&batch_sem), 2, "bad semaphore count");
+
+	k_sem_reset(&batch_sem);
+}
+#endif
+
 K_HEAP_DEFINE(test_heap, BUF_SIZE * (4 * NR_THREADS));
 
 void *syscalls_setup(void)
@@ -444,6 +465,9 @@ void *syscalls_setup(void)
 	sprintf(kernel_string, "this is a kernel string");
 	sprintf(user_string, "this is a user string");
 	k_thread_heap_assign(k_current_get(), &test_heap);
+#ifdef CONFIG_SYSCALL_BATCH
+	k_object_access_all_grant(&batch_sem);
+#endif
 
 	return NULL;
 }
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_msgq.h"
+
+K_THREAD_STACK_DECLARE(tstack, STACK_SIZE);
+extern struct k_thread tdata;
+extern struct k_msgq msgq;
+static ZTEST_BMEM char __aligned(4) tbuffer[MSG_SIZE * MSGQ_LEN];
+static ZTEST_DMEM uint32_t data[MSGQ_LEN] = { MSG0, MSG1 };
+
+static void zero_copy_put_get(struct k_msgq *q)
+{
+	uint32_t rx_data;
+	void *slot;
+	int ret;
+
+	/**TESTPOINT: commit and release without an outstanding request */
+	zassert_equal(k_msgq_commit(q), -EINVAL);
+	zassert_equal(k_msgq_release(q), -EINVAL);
+
+	/**TESTPOINT: reserve a slot and build the message in place */
+	ret = k_msgq_reserve(q, &slot, K_NO_WAIT);
+	zassert_equal(ret, 0);
+	zassert_equal(k_msgq_num_free_get(q), MSGQ_LEN - 1);
+	zassert_equal(k_msgq_num_used_get(q), 0);
+	*(uint32_t *)slot = data[0];
+
+	/**TESTPOINT: the write side is busy while reserved */
+	zassert_equal(k_msgq_reserve(q, &slot, K_NO_WAIT), -EBUSY);
+	zassert_equal(k_msgq_put(q, &data[1], K_NO_WAIT), -EBUSY);
+	zassert_equal(k_msgq_get(q, &rx_data, K_NO_WAIT), -ENOMSG);
+
+	zassert_equal(k_msgq_commit(q), 0);
+	zassert_equal(k_msgq_num_used_get(q), 1);
+	zassert_equal(k_msgq_put(q, &data[1], K_NO_WAIT), 0);
+
+	/**TESTPOINT: the queue is full, a reservation can't be made */
+	zassert_equal(k_msgq_reserve(q, &slot, K_NO_WAIT), -ENOMSG);
+
+	/**TESTPOINT: claim the oldest message and read it in place */
+	ret = k_msgq_peek_claim(q, &slot, K_NO_WAIT);
+	zassert_equal(ret, 0);
+	zassert_equal(*(uint32_t *)slot, data[0]);
+
+	/**TESTPOINT: the read side is busy while claimed */
+	zassert_equal(k_msgq_peek_claim(q, &slot, K_NO_WAIT), -EBUSY);
+	zassert_equal(k_msgq_get(q, &rx_data, K_NO_WAIT), -EBUSY);
+
+	zassert_equal(k_msgq_release(q), 0);
+	zassert_equal(k_msgq_num_used_get(q), 1);
+
+	ret = k_msgq_get(q, &rx_data, K_NO_WAIT);
+	zassert_equal(ret, 0);
+	zassert_equal(rx_data, data[1]);
+	zassert_equal(k_msgq_peek_claim(q, &slot, K_NO_WAIT), -ENOMSG);
+}
+
+static void tThread_claim_entry(void *p1, void *p2, void *p3)
+{
+	struct k_msgq *q = p1;
+	void *slot;
+	int ret;
+
+	ret = k_msgq_peek_claim(q, &slot, TIMEOUT);
+	zassert_equal(ret, 0);
+	zassert_equal(*(uint32_t *)slot, data[0]);
+	zassert_equal(k_msgq_release(q), 0);
+}
+
+static void tThread_reserve_entry(void *p1, void *p2, void *p3)
+{
+	struct k_msgq *q = p1;
+	void *slot;
+	int ret;
+
+	ret = k_msgq_reserve(q, &slot, TIMEOUT);
+	zassert_equal(ret, 0);
+	*(uint32_t *)slot = data[1];
+	zassert_equal(k_msgq_commit(q), 0);
+}
+
+static void zero_copy_blocking(struct k_msgq *q)
+{
+	uint32_t rx_data;
+
+	/**TESTPOINT: a blocked claim is granted the next message put */
+	k_thread_create(&tdata, tstack, STACK_SIZE,
+			tThread_claim_entry, q, NULL, NULL,
+			K_PRIO_PREEMPT(0), K_USER | K_INHERIT_PERMS,
+			K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 1);
+	zassert_equal(k_msgq_put(q, &data[0], K_NO_WAIT), 0);
+	k_thread_join(&tdata, K_FOREVER);
+	zassert_equal(k_msgq_num_used_get(q), 0);
+
+	/**TESTPOINT: a blocked reservation is granted the next free slot */
+	for (int i = 0; i < MSGQ_LEN; i++) {
+		zassert_equal(k_msgq_put(q, &data[0], K_NO_WAIT), 0);
+	}
+	k_thread_create(&tdata, tstack, STACK_SIZE,
+			tThread_reserve_entry, q, NULL, NULL,
+			K_PRIO_PREEMPT(0), K_USER | K_INHERIT_PERMS,
+			K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 1);
+	zassert_equal(k_msgq_get(q, &rx_data, K_NO_WAIT), 0);
+	k_thread_join(&tdata, K_FOREVER);
+
+	zassert_equal(k_msgq_get(q, &rx_data, K_NO_WAIT), 0);
+	zassert_equal(rx_data, data[0]);
+	zassert_equal(k_msgq_get(q, &rx_data, K_NO_WAIT), 0);
+	zassert_equal(rx_data, data[1]);
+}
+
+/**
+ * @addtogroup kernel_message_queue_tests
+ * @{
+ */
+
+/**
+ * @brief Test in-place reserve/commit and claim/release
+ * @see k_msgq_reserve(), k_msgq_commit(), k_msgq_peek_claim(),
+ * k_msgq_release()
+ */
+ZTEST(msgq_api, test_msgq_zero_copy)
+{
+	k_msgq_init(&msgq, tbuffer, MSG_SIZE, MSGQ_LEN);
+
+	zero_copy_put_get(&msgq);
+}
+
+/**
+ * @brief Test blocking reservations and claims
+ * @see k_msgq_reserve(), k_msgq_commit(), k_msgq_peek_claim(),
+ * k_msgq_release()
+ */
+ZTEST(msgq_api_1cpu, test_msgq_zero_copy_blocking)
+{
+	k_msgq_init(&msgq, tbuffer, MSG_SIZE, MSGQ_LEN);
+
+	zero_copy_blocking(&msgq);
+}
+
+/**
+ * @}
+ */
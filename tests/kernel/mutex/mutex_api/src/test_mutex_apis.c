@@ -387,6 +387,77 @@ ZTEST_USER(mutex_api_1cpu, test_mutex_priority_inheritance)
 	k_msleep(TIMEOUT+1000);
 }
 
+static K_MUTEX_DEFINE(chain_a);
+static K_MUTEX_DEFINE(chain_b);
+
+static void tThread_chain_hold_a(void *p1, void *p2, void *p3)
+{
+	zassert_ok(k_mutex_lock(&chain_a, K_FOREVER));
+	k_msleep(TIMEOUT * 2);
+	zassert_ok(k_mutex_unlock(&chain_a));
+}
+
+static void tThread_chain_hold_b_wait_a(void *p1, void *p2, void *p3)
+{
+	zassert_ok(k_mutex_lock(&chain_b, K_FOREVER));
+	zassert_ok(k_mutex_lock(&chain_a, K_FOREVER));
+	zassert_ok(k_mutex_unlock(&chain_a));
+	zassert_ok(k_mutex_unlock(&chain_b));
+}
+
+static void tThread_chain_wait_b(void *p1, void *p2, void *p3)
+{
+	zassert_equal(k_mutex_lock(&chain_b, K_MSEC(TIMEOUT / 2)), -EAGAIN);
+}
+
+/**
+ * @brief Test transitive priority inheritance
+ *
+ * @details T1 (low) holds mutex A, T2 (mid) holds mutex B and waits on
+ * A, then T3 (high) waits on B.  T3's priority must reach T1 through T2,
+ * and both must drop back to T2's priority when T3 times out.
+ *
+ * @ingroup kernel_mutex_tests
+ */
+ZTEST(mutex_api_1cpu, test_mutex_priority_inheritance_chain)
+{
+	k_tid_t t1 = k_thread_create(&tdata, tstack, STACK_SIZE,
+				     tThread_chain_hold_a, NULL, NULL, NULL,
+				     K_PRIO_PREEMPT(THREAD_LOW_PRIORITY),
+				     0, K_NO_WAIT);
+	k_msleep(50);
+
+	k_tid_t t2 = k_thread_create(&tdata2, tstack2, STACK_SIZE,
+				     tThread_chain_hold_b_wait_a, NULL, NULL, NULL,
+				     K_PRIO_PREEMPT(THREAD_MID_PRIORITY),
+				     0, K_NO_WAIT);
+	k_msleep(50);
+
+	zassert_equal(k_thread_priority_get(t1), THREAD_MID_PRIORITY,
+		      "direct owner not raised");
+
+	k_tid_t t3 = k_thread_create(&tdata3, tstack3, STACK_SIZE,
+				     tThread_chain_wait_b, NULL, NULL, NULL,
+				     K_PRIO_PREEMPT(THREAD_HIGH_PRIORITY),
+				     0, K_NO_WAIT);
+	k_msleep(50);
+
+	zassert_equal(k_thread_priority_get(t2), THREAD_HIGH_PRIORITY,
+		      "direct owner not raised");
+	zassert_equal(k_thread_priority_get(t1), THREAD_HIGH_PRIORITY,
+		      "priority not passed along the chain");
+
+	k_thread_join(t3, K_FOREVER);
+
+	zassert_equal(k_thread_priority_get(t2), THREAD_MID_PRIORITY,
+		      "direct owner not restored");
+	zassert_equal(k_thread_priority_get(t1), THREAD_MID_PRIORITY,
+		      "chained owner not restored");
+
+	k_thread_join(t2, K_FOREVER);
+	k_thread_join(t1, K_FOREVER);
+}
+
 static void *mutex_api_tests_setup(void)
 {
 #ifdef CONFIG_USERSPACE
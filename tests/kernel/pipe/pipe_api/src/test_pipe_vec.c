@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief Tests for scatter-gather pipe transfers
+ * @ingroup kernel_pipe_tests
+ * @{
+ */
+
+#include <zephyr/ztest.h>
+
+#define STACK_SIZE	(1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define VEC_PIPE_LEN	16
+#define TIMEOUT		K_MSEC(100)
+
+K_PIPE_DEFINE(vec_pipe, VEC_PIPE_LEN, 4);
+static struct k_pipe vec_bufferless_pipe;
+
+static K_THREAD_STACK_DEFINE(vec_stack, STACK_SIZE);
+static struct k_thread vec_thread;
+
+static const unsigned char tx_data[] = "0123456789abcdef";
+static unsigned char rx_data[sizeof(tx_data)];
+
+static void tx_iovec_init(struct k_pipe_iovec *iov)
+{
+	/* Uneven segments, including an empty one */
+	iov[0].iov_base = (void *)&tx_data[0];
+	iov[0].iov_len = 3;
+	iov[1].iov_base = (void *)&tx_data[3];
+	iov[1].iov_len = 0;
+	iov[2].iov_base = (void *)&tx_data[3];
+	iov[2].iov_len = 9;
+	iov[3].iov_base = (void *)&tx_data[12];
+	iov[3].iov_len = 4;
+}
+
+static void rx_iovec_init(struct k_pipe_iovec *iov)
+{
+	iov[0].iov_base = &rx_data[0];
+	iov[0].iov_len = 7;
+	iov[1].iov_base = &rx_data[7];
+	iov[1].iov_len = 9;
+}
+
+/**
+ * @brief Test vectored write and read through the pipe buffer
+ *
+ * @see k_pipe_putv(), k_pipe_getv()
+ */
+ZTEST(pipe_api, test_pipe_putv_getv)
+{
+	struct k_pipe_iovec tx_iov[4];
+	struct k_pipe_iovec rx_iov[2];
+	size_t bytes;
+	int ret;
+
+	tx_iovec_init(tx_iov);
+	rx_iovec_init(rx_iov);
+	memset(rx_data, 0, sizeof(rx_data));
+
+	ret = k_pipe_putv(&vec_pipe, tx_iov, ARRAY_SIZE(tx_iov), &bytes,
+			  VEC_PIPE_LEN, K_NO_WAIT);
+	zassert_equal(ret, 0, "putv failed: %d", ret);
+	zassert_equal(bytes, VEC_PIPE_LEN);
+	zassert_equal(k_pipe_read_avail(&vec_pipe), VEC_PIPE_LEN);
+
+	ret = k_pipe_getv(&vec_pipe, rx_iov, ARRAY_SIZE(rx_iov), &bytes,
+			  VEC_PIPE_LEN, K_NO_WAIT);
+	zassert_equal(ret, 0, "getv failed: %d", ret);
+	zassert_equal(bytes, VEC_PIPE_LEN);
+	zassert_mem_equal(rx_data, tx_data, VEC_PIPE_LEN);
+
+	/**TESTPOINT: minimum transfer larger than the segments */
+	ret = k_pipe_putv(&vec_pipe, tx_iov, ARRAY_SIZE(tx_iov), &bytes,
+			  VEC_PIPE_LEN + 1, K_NO_WAIT);
+	zassert_equal(ret, -EINVAL);
+}
+
+static void tThread_getv_entry(void *p1, void *p2, void *p3)
+{
+	struct k_pipe_iovec rx_iov[2];
+	size_t bytes;
+	int ret;
+
+	rx_iovec_init(rx_iov);
+
+	ret = k_pipe_getv(&vec_bufferless_pipe, rx_iov, ARRAY_SIZE(rx_iov),
+			  &bytes, VEC_PIPE_LEN, TIMEOUT);
+	zassert_equal(ret, 0, "getv failed: %d", ret);
+	zassert_equal(bytes, VEC_PIPE_LEN);
+}
+
+/**
+ * @brief Test vectored handoff from a writer to a waiting reader
+ *
+ * The pipe has no buffer, so the waiting reader's segments can only be
+ * filled straight from the writer's segments.
+ *
+ * @see k_pipe_putv(), k_pipe_getv()
+ */
+ZTEST(pipe_api_1cpu, test_pipe_putv_getv_direct)
+{
+	struct k_pipe_iovec tx_iov[4];
+	k_tid_t tid;
+	size_t bytes;
+	int ret;
+
+	k_pipe_init(&vec_bufferless_pipe, NULL, 0);
+	tx_iovec_init(tx_iov);
+	memset(rx_data, 0, sizeof(rx_data));
+
+	tid = k_thread_create(&vec_thread, vec_stack, STACK_SIZE,
+			      tThread_getv_entry, NULL, NULL, NULL,
+			      K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(10);
+
+	ret = k_pipe_putv(&vec_bufferless_pipe, tx_iov, ARRAY_SIZE(tx_iov),
+			  &bytes, VEC_PIPE_LEN, K_NO_WAIT);
+	zassert_equal(ret, 0, "putv failed: %d", ret);
+	zassert_equal(bytes, VEC_PIPE_LEN);
+
+	k_thread_join(tid, K_FOREVER);
+	zassert_mem_equal(rx_data, tx_data, VEC_PIPE_LEN);
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief Tests for persistent poll sets
+ * @ingroup kernel_poll_tests
+ * @{
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+
+#define STACK_SIZE	(1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define NUM_SEMS	8
+
+static struct k_poll_set set;
+static struct k_sem set_sems[NUM_SEMS];
+static struct k_poll_event set_events[NUM_SEMS];
+static struct k_poll_signal set_signal;
+static struct k_poll_event signal_event;
+
+static K_THREAD_STACK_DEFINE(set_stack, STACK_SIZE);
+static struct k_thread set_thread;
+
+static void poll_set_setup(void)
+{
+	k_poll_set_init(&set);
+
+	for (int i = 0; i < NUM_SEMS; i++) {
+		k_sem_init(&set_sems[i], 0, 1);
+		k_poll_event_init(&set_events[i], K_POLL_TYPE_SEM_AVAILABLE,
+				  K_POLL_MODE_NOTIFY_ONLY, &set_sems[i]);
+		set_events[i].tag = i;
+		zassert_equal(k_poll_set_add(&set, &set_events[i]), 0);
+	}
+}
+
+static void poll_set_teardown(void)
+{
+	for (int i = 0; i < NUM_SEMS; i++) {
+		zassert_equal(k_poll_set_remove(&set, &set_events[i]), 0);
+	}
+}
+
+/**
+ * @brief Test readiness reporting of a poll set
+ *
+ * @see k_poll_set_add(), k_poll_set_wait(), k_poll_set_remove()
+ */
+ZTEST(poll_api_1cpu, test_poll_set_ready)
+{
+	struct k_poll_event *ready[NUM_SEMS];
+	int ret;
+
+	poll_set_setup();
+
+	/**TESTPOINT: nothing ready */
+	ret = k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), K_NO_WAIT);
+	zassert_equal(ret, -EAGAIN);
+
+	/**TESTPOINT: an event can't be part of two sets */
+	zassert_equal(k_poll_set_add(&set, &set_events[0]), -EBUSY);
+
+	/**TESTPOINT: only the ready events are returned, oldest first */
+	k_sem_give(&set_sems[5]);
+	k_sem_give(&set_sems[2]);
+	ret = k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), K_NO_WAIT);
+	zassert_equal(ret, 2);
+	zassert_equal(ready[0], &set_events[5]);
+	zassert_equal(ready[1], &set_events[2]);
+	zassert_equal(ready[0]->state, K_POLL_STATE_SEM_AVAILABLE);
+
+	/**TESTPOINT: polling is level-triggered */
+	zassert_equal(k_sem_take(&set_sems[5], K_NO_WAIT), 0);
+	ret = k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), K_NO_WAIT);
+	zassert_equal(ret, 1);
+	zassert_equal(ready[0], &set_events[2]);
+	zassert_equal(k_sem_take(&set_sems[2], K_NO_WAIT), 0);
+
+	/**TESTPOINT: re-armed events are signaled again */
+	k_sem_give(&set_sems[5]);
+	ret = k_poll_set_wait(&set, ready, 1, K_NO_WAIT);
+	zassert_equal(ret, 1);
+	zassert_equal(ready[0], &set_events[5]);
+	zassert_equal(k_sem_take(&set_sems[5], K_NO_WAIT), 0);
+
+	/**TESTPOINT: ready events beyond max are kept for the next call */
+	k_sem_give(&set_sems[1]);
+	k_sem_give(&set_sems[3]);
+	ret = k_poll_set_wait(&set, ready, 1, K_NO_WAIT);
+	zassert_equal(ret, 1);
+	zassert_equal(ready[0], &set_events[1]);
+	ret = k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), K_NO_WAIT);
+	zassert_equal(ret, 2);
+	zassert_equal(ready[0], &set_events[3]);
+	zassert_equal(ready[1], &set_events[1]);
+	zassert_equal(k_sem_take(&set_sems[1], K_NO_WAIT), 0);
+	zassert_equal(k_sem_take(&set_sems[3], K_NO_WAIT), 0);
+
+	/**TESTPOINT: an event added while ready is reported at once */
+	k_poll_signal_init(&set_signal);
+	k_poll_signal_raise(&set_signal, 0x1234);
+	k_poll_event_init(&signal_event, K_POLL_TYPE_SIGNAL,
+			  K_POLL_MODE_NOTIFY_ONLY, &set_signal);
+	zassert_equal(k_poll_set_add(&set, &signal_event), 0);
+	ret = k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), K_NO_WAIT);
+	zassert_equal(ret, 1);
+	zassert_equal(ready[0], &signal_event);
+	zassert_equal(ready[0]->state, K_POLL_STATE_SIGNALED);
+
+	/**TESTPOINT: removed events are not reported */
+	zassert_equal(k_poll_set_remove(&set, &signal_event), 0);
+	zassert_equal(k_poll_set_remove(&set, &signal_event), -EINVAL);
+	ret = k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), K_NO_WAIT);
+	zassert_equal(ret, -EAGAIN);
+
+	poll_set_teardown();
+
+	/**TESTPOINT: removed events can be polled again */
+	k_sem_give(&set_sems[0]);
+	set_events[0].state = K_POLL_STATE_NOT_READY;
+	zassert_equal(k_poll(&set_events[0], 1, K_NO_WAIT), 0);
+	zassert_equal(set_events[0].state, K_POLL_STATE_SEM_AVAILABLE);
+	zassert_equal(k_sem_take(&set_sems[0], K_NO_WAIT), 0);
+}
+
+static void set_giver_entry(void *p1, void *p2, void *p3)
+{
+	k_msleep(10);
+	k_sem_give(&set_sems[NUM_SEMS - 1]);
+}
+
+/**
+ * @brief Test waiting on a poll set
+ *
+ * @see k_poll_set_wait()
+ */
+ZTEST(poll_api_1cpu, test_poll_set_wait)
+{
+	struct k_poll_event *ready[NUM_SEMS];
+	k_tid_t tid;
+	int ret;
+
+	poll_set_setup();
+
+	/**TESTPOINT: waiting times out */
+	ret = k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), K_MSEC(10));
+	zassert_equal(ret, -EAGAIN);
+
+	/**TESTPOINT: a waiter is woken up by an event of the set */
+	tid = k_thread_create(&set_thread, set_stack, STACK_SIZE,
+			      set_giver_entry, NULL, NULL, NULL,
+			      K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	ret = k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), K_FOREVER);
+	zassert_equal(ret, 1);
+	zassert_equal(ready[0], &set_events[NUM_SEMS - 1]);
+	k_thread_join(tid, K_FOREVER);
+	zassert_equal(k_sem_take(&set_sems[NUM_SEMS - 1], K_NO_WAIT), 0);
+
+	poll_set_teardown();
+}
+
+/**
+ * @}
+ */
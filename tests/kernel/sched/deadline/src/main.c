@@ -213,4 +213,66 @@ ZTEST(suite_deadline, test_unqueued)
 	}
 }
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+#define CBS_BUDGET 2
+#define CBS_PERIOD 10
+
+static volatile uint32_t spin_count[2];
+
+static void spin_worker(void *p1, void *p2, void *p3)
+{
+	int idx = POINTER_TO_INT(p1);
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (1) {
+		spin_count[idx]++;
+	}
+}
+
+/* A thread that never blocks but has a bandwidth server gets
+ * throttled, letting a lower priority thread run.
+ */
+ZTEST(suite_deadline, test_cbs_throttle)
+{
+	uint32_t total;
+
+	spin_count[0] = 0;
+	spin_count[1] = 0;
+
+	/* The hog */
+	worker_tids[0] = k_thread_create(&worker_threads[0],
+			worker_stacks[0], STACK_SIZE,
+			spin_worker, INT_TO_POINTER(0), NULL, NULL,
+			K_LOWEST_APPLICATION_THREAD_PRIO - 1,
+			0, K_FOREVER);
+
+	/* Only runs when the hog doesn't */
+	worker_tids[1] = k_thread_create(&worker_threads[1],
+			worker_stacks[1], STACK_SIZE,
+			spin_worker, INT_TO_POINTER(1), NULL, NULL,
+			K_LOWEST_APPLICATION_THREAD_PRIO,
+			0, K_FOREVER);
+
+	zassert_equal(k_thread_cbs_set(worker_tids[0], CBS_PERIOD + 1,
+				       CBS_PERIOD), -EINVAL);
+	zassert_ok(k_thread_cbs_set(worker_tids[0], CBS_BUDGET, CBS_PERIOD));
+
+	k_thread_start(worker_tids[0]);
+	k_thread_start(worker_tids[1]);
+
+	k_sleep(K_TICKS(20 * CBS_PERIOD));
+
+	k_thread_abort(worker_tids[0]);
+	k_thread_abort(worker_tids[1]);
+
+	total = spin_count[0] + spin_count[1];
+	zassert_true(spin_count[0] > 0, "server thread never ran");
+	zassert_true(spin_count[1] > 0, "server thread was not throttled");
+	zassert_true(spin_count[0] < total / 2,
+		     "server thread exceeded its bandwidth");
+}
+#endif
+
 ZTEST_SUITE(suite_deadline, NULL, NULL, NULL, NULL, NULL);
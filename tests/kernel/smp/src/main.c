@@ -1020,6 +1020,50 @@ ZTEST(smp, test_smp_switch_torture)
 	}
 }
 
+#if defined(CONFIG_SCHED_THREAD_USAGE) && defined(CONFIG_SCHED_CPU_MASK)
+static void migrate_fn(void *p1, void *p2, void *p3)
+{
+	while (1) {
+		k_msleep(1);
+	}
+}
+
+/**
+ * @brief Test that thread migrations are counted
+ *
+ * @ingroup kernel_smp_tests
+ *
+ * @details Pin a thread to one CPU, let it run a while, then move it
+ * to another CPU and check its runtime stats record the migration.
+ */
+ZTEST(smp, test_thread_migration_stats)
+{
+	k_thread_runtime_stats_t stats;
+
+	k_tid_t tid = k_thread_create(&t2, t2_stack, T2_STACK_SIZE,
+				      migrate_fn, NULL, NULL, NULL,
+				      K_PRIO_PREEMPT(1), 0, K_FOREVER);
+
+	zassert_ok(k_thread_cpu_pin(tid, 0), "");
+	k_thread_start(tid);
+	k_msleep(10);
+
+	zassert_ok(k_thread_runtime_stats_get(tid, &stats), "");
+	zassert_equal(stats.migrations, 0, "pinned thread migrated");
+
+	k_thread_suspend(tid);
+	zassert_ok(k_thread_cpu_pin(tid, 1), "");
+	k_thread_resume(tid);
+	k_msleep(10);
+
+	zassert_ok(k_thread_runtime_stats_get(tid, &stats), "");
+	zassert_equal(stats.migrations, 1, "migration not counted");
+
+	k_thread_abort(tid);
+	k_thread_join(tid, K_FOREVER);
+}
+#endif
+
 static void *smp_tests_setup(void)
 {
 	/* Sleep a bit to guarantee that both CPUs enter an idle
@@ -809,6 +809,49 @@ ZTEST_USER(timer_api, test_sleep_abs)
 		     start + sleep_ticks, end, late);
 }
 
+static struct k_timer sibling_timer;
+static struct k_timer stopping_timer;
+static int sibling_expire_cnt;
+
+static void stopping_expire(struct k_timer *timer)
+{
+	k_timer_stop(&sibling_timer);
+}
+
+static void sibling_expire(struct k_timer *timer)
+{
+	sibling_expire_cnt++;
+}
+
+/**
+ * @brief Test stopping a timer from the expiry function of a timer
+ * expiring on the same tick
+ *
+ * @details The stopped timer must not expire, even though both timeouts
+ * are due when the first expiry function runs.
+ */
+ZTEST(timer_api, test_timer_stop_sibling)
+{
+	k_timer_init(&stopping_timer, stopping_expire, NULL);
+	k_timer_init(&sibling_timer, sibling_expire, NULL);
+	sibling_expire_cnt = 0;
+
+	if (IS_ENABLED(CONFIG_MULTITHREADING)) {
+		k_usleep(1); /* tick align */
+	}
+
+	k_timer_start(&stopping_timer, K_TICKS(5), K_NO_WAIT);
+	k_timer_start(&sibling_timer, K_TICKS(5), K_NO_WAIT);
+
+	busy_wait_ms(k_ticks_to_ms_ceil32(10));
+
+	zassert_equal(k_timer_status_get(&stopping_timer), 1,
+		      "Stopping timer did not expire");
+	zassert_equal(sibling_expire_cnt, 0, "Stopped timer expired");
+	zassert_equal(k_timer_status_get(&sibling_timer), 0,
+		      "Stopped timer expired");
+}
+
 static void timer_init(struct k_timer *timer, k_timer_expiry_t expiry_fn,
 		       k_timer_stop_t stop_fn)
 {
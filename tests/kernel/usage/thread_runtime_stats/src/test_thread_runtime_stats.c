@@ -70,7 +70,7 @@ ZTEST(usage_api, test_all_stats_usage)
 	k_thread_runtime_stats_t  stats4;
 	k_thread_runtime_stats_t  stats5;
 
-	priority = k_thread_priority_get(_current);
+	priority = k_thread_priority_get(k_current_get());
 	tid = k_thread_create(&helper_thread, helper_stack,
 			      K_THREAD_STACK_SIZEOF(helper_stack),
 			      helper1, NULL, NULL, NULL,
@@ -194,7 +194,7 @@ ZTEST(usage_api, test_thread_stats_enable_disable)
 	k_thread_runtime_stats_t  helper_stats3;
 	int  priority;
 
-	priority = k_thread_priority_get(_current);
+	priority = k_thread_priority_get(k_current_get());
 	tid = k_thread_create(&helper_thread, helper_stack,
 			      K_THREAD_STACK_SIZEOF(helper_stack),
 			      helper1, NULL, NULL, NULL,
@@ -396,7 +396,7 @@ ZTEST(usage_api, test_thread_stats_usage)
 	k_thread_runtime_stats_t  stats2;
 	k_thread_runtime_stats_t  stats3;
 
-	priority = k_thread_priority_get(_current);
+	priority = k_thread_priority_get(k_current_get());
 
 	/*
 	 * Verify that k_thread_runtime_stats_get() returns the expected
@@ -539,5 +539,74 @@ ZTEST(usage_api, test_thread_stats_usage)
 	k_thread_abort(tid);
 }
 
+#ifdef CONFIG_THREAD_LATENCY_STATS
+/**
+ * @brief Helper thread to test_thread_latency_stats()
+ */
+void helper_sleeper(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < 10; i++) {
+		k_sleep(K_TICKS(1));
+	}
+}
+
+static uint32_t latency_hist_total(const struct k_latency_hist *hist)
+{
+	uint32_t total = 0U;
+
+	for (int i = 0; i < CONFIG_THREAD_LATENCY_STATS_BUCKETS; i++) {
+		total += hist->buckets[i];
+	}
+
+	return total;
+}
+#endif
+
+/**
+ * @brief Test the k_thread_latency_stats_get() API
+ *
+ * 1. Verify invalid arguments are rejected.
+ * 2. Create a higher priority helper that sleeps and wakes 10 times.
+ *    - Each wakeup should be recorded in its ready-to-run histogram.
+ *    - Each run window should be recorded in its run histogram.
+ * 3. Reset the statistics.
+ *    - All histogram counts should be zero.
+ */
+ZTEST(usage_api, test_thread_latency_stats)
+{
+#ifdef CONFIG_THREAD_LATENCY_STATS
+	struct k_thread_latency_stats stats;
+	k_tid_t tid;
+	int  priority;
+	int  status;
+
+	status = k_thread_latency_stats_get(NULL, &stats);
+	zassert_true(status == -EINVAL);
+	status = k_thread_latency_stats_get(k_current_get(), NULL);
+	zassert_true(status == -EINVAL);
+
+	priority = k_thread_priority_get(k_current_get());
+	tid = k_thread_create(&helper_thread, helper_stack,
+			      K_THREAD_STACK_SIZEOF(helper_stack),
+			      helper_sleeper, NULL, NULL, NULL,
+			      priority - 1, 0, K_NO_WAIT);
+
+	zassert_true(k_thread_join(tid, K_FOREVER) == 0);
+
+	status = k_thread_latency_stats_get(tid, &stats);
+	zassert_true(status == 0);
+	zassert_true(latency_hist_total(&stats.ready) >= 10U);
+	zassert_true(latency_hist_total(&stats.run) >= 10U);
+
+	k_thread_latency_stats_reset(tid);
+	k_thread_latency_stats_get(tid, &stats);
+	zassert_true(latency_hist_total(&stats.ready) == 0U);
+	zassert_true(latency_hist_total(&stats.run) == 0U);
+	zassert_true(stats.ready.max == 0U);
+#else
+	ztest_test_skip();
+#endif
+}
+
 ZTEST_SUITE(usage_api, NULL, NULL,
 		ztest_simple_1cpu_before, ztest_simple_1cpu_after, NULL);
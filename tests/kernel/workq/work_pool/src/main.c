@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+
+#define NUM_WORKERS 3
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define WORKER_PRIORITY K_PRIO_PREEMPT(1)
+#define NUM_ITEMS 32
+
+BUILD_ASSERT(WORKER_PRIORITY < CONFIG_ZTEST_THREAD_PRIORITY,
+	     "workers must preempt the test thread");
+
+static K_THREAD_STACK_ARRAY_DEFINE(pool_stacks, NUM_WORKERS, STACK_SIZE);
+static struct k_work_q pool_workers[NUM_WORKERS];
+static struct k_work_pool pool;
+
+static struct k_work items[NUM_ITEMS];
+static k_tid_t ran_on[NUM_ITEMS];
+static atomic_t ran_count;
+
+/* Released by the test to let a blocking item complete */
+static struct k_sem rel_sem;
+
+/* Given by a blocking item once it runs */
+static struct k_sem started_sem;
+
+static struct k_work blocker[NUM_WORKERS];
+static struct k_work_sync work_sync;
+
+static void count_handler(struct k_work *work)
+{
+	size_t idx = work - items;
+
+	ran_on[idx] = k_current_get();
+	atomic_inc(&ran_count);
+}
+
+static void block_handler(struct k_work *work)
+{
+	k_sem_give(&started_sem);
+	k_sem_take(&rel_sem, K_FOREVER);
+}
+
+static bool is_worker(k_tid_t tid)
+{
+	for (int i = 0; i < NUM_WORKERS; i++) {
+		if (tid == k_work_queue_thread_get(&pool_workers[i])) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void release_blockers(int count)
+{
+	for (int i = 0; i < count; i++) {
+		k_sem_give(&rel_sem);
+	}
+}
+
+/* All items submitted to the pool run exactly once, on pool workers */
+ZTEST(work_pool, test_pool_submit)
+{
+	for (int i = 0; i < NUM_ITEMS; i++) {
+		zassert_equal(k_work_pool_submit(&pool, &items[i]), 1);
+	}
+
+	zassert_true(k_work_pool_drain(&pool, false) >= 0);
+	zassert_equal(atomic_get(&ran_count), NUM_ITEMS);
+
+	for (int i = 0; i < NUM_ITEMS; i++) {
+		zassert_true(is_worker(ran_on[i]), "item %d ran off pool", i);
+	}
+}
+
+/* Work queued behind a blocked worker is taken by an idle sibling */
+ZTEST(work_pool, test_pool_steal)
+{
+	struct k_work_q *busy = &pool_workers[0];
+
+	zassert_equal(k_work_submit_to_queue(busy, &blocker[0]), 1);
+	zassert_ok(k_sem_take(&started_sem, K_MSEC(100)));
+
+	zassert_equal(k_work_submit_to_queue(busy, &items[0]), 1);
+	(void)k_work_flush(&items[0], &work_sync);
+
+	/* Completed while the worker it was queued on is still blocked */
+	zassert_equal(atomic_get(&ran_count), 1);
+	zassert_true(is_worker(ran_on[0]));
+	zassert_not_equal(ran_on[0], k_work_queue_thread_get(busy));
+	zassert_true(k_work_is_pending(&blocker[0]));
+
+	release_blockers(1);
+	(void)k_work_flush(&blocker[0], &work_sync);
+	zassert_false(k_work_is_pending(&blocker[0]));
+}
+
+/* Queued pool work can still be cancelled */
+ZTEST(work_pool, test_pool_cancel)
+{
+	for (int i = 0; i < NUM_WORKERS; i++) {
+		zassert_equal(k_work_pool_submit(&pool, &blocker[i]), 1);
+		zassert_ok(k_sem_take(&started_sem, K_MSEC(100)));
+	}
+
+	zassert_equal(k_work_pool_submit(&pool, &items[0]), 1);
+	zassert_equal(k_work_busy_get(&items[0]), K_WORK_QUEUED);
+	zassert_equal(k_work_cancel(&items[0]), 0);
+
+	release_blockers(NUM_WORKERS);
+	zassert_true(k_work_pool_drain(&pool, false) >= 0);
+	zassert_equal(atomic_get(&ran_count), 0);
+}
+
+/* Plugging the pool rejects new submissions until it is unplugged */
+ZTEST(work_pool, test_pool_plug)
+{
+	zassert_true(k_work_pool_drain(&pool, true) >= 0);
+	zassert_equal(k_work_pool_submit(&pool, &items[0]), -EBUSY);
+
+	zassert_ok(k_work_pool_unplug(&pool));
+	zassert_equal(k_work_pool_unplug(&pool), -EALREADY);
+
+	zassert_equal(k_work_pool_submit(&pool, &items[0]), 1);
+	zassert_true(k_work_pool_drain(&pool, false) >= 0);
+	zassert_equal(atomic_get(&ran_count), 1);
+}
+
+static void work_pool_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	atomic_set(&ran_count, 0);
+	memset(ran_on, 0, sizeof(ran_on));
+	k_sem_reset(&rel_sem);
+	k_sem_reset(&started_sem);
+}
+
+static void *work_pool_setup(void)
+{
+	struct k_work_pool_config cfg = {
+		.name = "pool",
+		.pin_cpu = IS_ENABLED(CONFIG_TEST_PIN_WORKERS),
+	};
+
+	k_sem_init(&rel_sem, 0, K_SEM_MAX_LIMIT);
+	k_sem_init(&started_sem, 0, K_SEM_MAX_LIMIT);
+
+	for (int i = 0; i < NUM_ITEMS; i++) {
+		k_work_init(&items[i], count_handler);
+	}
+	for (int i = 0; i < NUM_WORKERS; i++) {
+		k_work_init(&blocker[i], block_handler);
+	}
+
+	k_work_pool_init(&pool, pool_workers, NUM_WORKERS);
+	k_work_pool_start(&pool, &pool_stacks[0][0], STACK_SIZE,
+			  WORKER_PRIORITY, &cfg);
+
+	return NULL;
+}
+
+ZTEST_SUITE(work_pool, NULL, work_pool_setup, work_pool_before, NULL, NULL);
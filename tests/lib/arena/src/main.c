@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/sys/arena.h>
+
+#define ARENA_BUF_SZ	128
+#define HEAP_SZ		1024
+#define BLOCK_SZ	256
+
+K_HEAP_DEFINE(arena_heap, HEAP_SZ);
+
+static uint8_t __aligned(8) arena_buf[ARENA_BUF_SZ];
+static struct sys_arena arena;
+
+static bool in_buf(void *p)
+{
+	return (uint8_t *)p >= arena_buf &&
+	       (uint8_t *)p < arena_buf + sizeof(arena_buf);
+}
+
+/**
+ * @brief Test allocation from a fixed buffer
+ */
+ZTEST(lib_arena, test_arena_buffer)
+{
+	void *p, *q;
+	size_t n = 0;
+
+	sys_arena_init(&arena, arena_buf, sizeof(arena_buf));
+
+	p = sys_arena_alloc(&arena, 1);
+	q = sys_arena_alloc(&arena, 1);
+	zassert_true(in_buf(p) && in_buf(q), "");
+	zassert_equal((uintptr_t)q % sizeof(void *), 0, "misaligned");
+	zassert_true(q > p, "arena did not advance");
+
+	p = sys_arena_aligned_alloc(&arena, 32, 4);
+	zassert_not_null(p, "");
+	zassert_equal((uintptr_t)p % 32, 0, "misaligned");
+
+	/* A buffer only arena fails when it is used up */
+	while (sys_arena_alloc(&arena, 8) != NULL) {
+		n++;
+	}
+	zassert_true(n > 0, "");
+	zassert_is_null(sys_arena_alloc(&arena, ARENA_BUF_SZ), "");
+
+	/* Resetting makes the whole buffer available again */
+	sys_arena_reset(&arena);
+	zassert_not_null(sys_arena_alloc(&arena, 8), "");
+}
+
+/**
+ * @brief Test rewinding to a mark
+ */
+ZTEST(lib_arena, test_arena_mark)
+{
+	struct sys_arena_mark mark;
+	void *p, *q;
+
+	sys_arena_init(&arena, arena_buf, sizeof(arena_buf));
+	zassert_not_null(sys_arena_alloc(&arena, 16), "");
+
+	sys_arena_mark(&arena, &mark);
+	p = sys_arena_alloc(&arena, 16);
+	zassert_not_null(sys_arena_alloc(&arena, 16), "");
+
+	sys_arena_reset_to(&arena, &mark);
+	q = sys_arena_alloc(&arena, 16);
+	zassert_equal(p, q, "memory after the mark was not released");
+}
+
+/**
+ * @brief Test growth blocks from a heap
+ */
+ZTEST(lib_arena, test_arena_heap)
+{
+	struct sys_arena_mark mark;
+	void *p;
+
+	sys_arena_init(&arena, arena_buf, sizeof(arena_buf));
+	sys_arena_init_heap(&arena, &arena_heap, BLOCK_SZ);
+
+	/* Overflow the buffer, then ask for more than a block */
+	sys_arena_mark(&arena, &mark);
+	zassert_true(in_buf(sys_arena_alloc(&arena, ARENA_BUF_SZ / 2)), "");
+	p = sys_arena_alloc(&arena, ARENA_BUF_SZ);
+	zassert_not_null(p, "");
+	zassert_false(in_buf(p), "");
+	p = sys_arena_alloc(&arena, BLOCK_SZ * 2);
+	zassert_not_null(p, "");
+
+	/* The heap is mostly used up by now */
+	zassert_is_null(k_heap_alloc(&arena_heap, HEAP_SZ / 2, K_NO_WAIT),
+			"");
+
+	/* Rewinding gives the growth blocks back */
+	sys_arena_reset_to(&arena, &mark);
+	p = k_heap_alloc(&arena_heap, HEAP_SZ / 2, K_NO_WAIT);
+	zassert_not_null(p, "growth blocks were not freed");
+	k_heap_free(&arena_heap, p);
+
+	zassert_true(in_buf(sys_arena_alloc(&arena, 8)), "");
+	sys_arena_reset(&arena);
+}
+
+/**
+ * @brief Test an arena backed by a heap only
+ */
+ZTEST(lib_arena, test_arena_heap_only)
+{
+	struct sys_arena heap_arena = { 0 };
+	void *p;
+
+	zassert_is_null(sys_arena_alloc(&heap_arena, 8), "");
+
+	sys_arena_init_heap(&heap_arena, &arena_heap, BLOCK_SZ);
+	for (int i = 0; i < 8; i++) {
+		zassert_not_null(sys_arena_alloc(&heap_arena, 64), "");
+	}
+
+	sys_arena_reset(&heap_arena);
+	p = k_heap_alloc(&arena_heap, HEAP_SZ / 2, K_NO_WAIT);
+	zassert_not_null(p, "growth blocks were not freed");
+	k_heap_free(&arena_heap, p);
+}
+
+ZTEST_SUITE(lib_arena, NULL, NULL, NULL, NULL, NULL);
@@ -533,6 +533,47 @@ ZTEST(test_c_lib, test_memchr)
 	zassert_is_null(memchr(str, '\0', strlen(str)), "memchr scope error");
 }
 
+/**
+ * @brief Test memory and string functions at all alignments
+ *
+ * @details Word-at-a-time implementations handle the unaligned head and the
+ * tail of the areas separately, check every combination of alignment and
+ * position of the looked up byte.
+ *
+ * @see memcmp(), memchr(), strlen().
+ */
+ZTEST(test_c_lib, test_mem_str_alignment)
+{
+	uintptr_t mem1[8], mem2[8];
+	unsigned char *buf1 = (unsigned char *)mem1;
+	unsigned char *buf2 = (unsigned char *)mem2;
+	const size_t len = sizeof(mem1) - 2 * sizeof(uintptr_t);
+
+	for (size_t off = 0; off < sizeof(uintptr_t); off++) {
+		for (size_t pos = 0; pos < len; pos++) {
+			memset(buf1, 'a', sizeof(mem1));
+			memset(buf2, 'a', sizeof(mem2));
+
+			buf1[off + pos] = 'b';
+			buf2[off + pos] = 0x80;
+			zassert_true(memcmp(buf1 + off, buf2 + off, len) < 0,
+				     "memcmp failed at %zu/%zu", off, pos);
+			zassert_equal(memcmp(buf1 + off, buf2 + off, pos), 0,
+				      "memcmp failed at %zu/%zu", off, pos);
+
+			zassert_equal_ptr(memchr(buf1 + off, 'b', len),
+					  buf1 + off + pos,
+					  "memchr failed at %zu/%zu", off, pos);
+			zassert_is_null(memchr(buf1 + off, 'b', pos),
+					"memchr failed at %zu/%zu", off, pos);
+
+			buf1[off + pos] = '\0';
+			zassert_equal(strlen((char *)buf1 + off), pos,
+				      "strlen failed at %zu/%zu", off, pos);
+		}
+	}
+}
+
 /**
  * @brief Test memcpy operation
  *
@@ -886,6 +886,30 @@ ZTEST(cbprintf_package, test_cbprintf_package_convert)
 
 }
 
+#ifdef CONFIG_CBPRINTF_PACKAGE_FMT_CACHE
+ZTEST(cbprintf_package, test_cbprintf_fmt_cache)
+{
+	long long lli = 0x1122334455667788;
+	void *vp = &lli;
+
+	/* Repeated packaging with the same format string uses the cached
+	 * argument layout which must give the same result as parsing.
+	 */
+	for (int i = 0; i < 3; i++) {
+		TEST_PACKAGING(0, "cache %d %llx %p %c", i, lli, vp, 'c');
+	}
+
+	/* Format string with more arguments than can be cached. */
+	for (int i = 0; i < 2; i++) {
+		TEST_PACKAGING(0, "%d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d "
+			       "%d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d",
+			       i, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16,
+			       17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30,
+			       31, 32);
+	}
+}
+#endif
+
 /**
  * @brief Log information about variable sizes and alignment.
  *
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/cache.h>
+#include <zephyr/sys/dma_buf.h>
+
+#define BUF_SIZE	256
+#define NUM_BUFS	4
+
+static uint8_t __aligned(64) mem[NUM_BUFS][BUF_SIZE];
+
+ZTEST(dma_buf, test_dma_buf_ownership)
+{
+	struct sys_dma_buf bufs[NUM_BUFS];
+	int ret;
+
+	for (int i = 0; i < NUM_BUFS; i++) {
+		ret = sys_dma_buf_init(&bufs[i], mem[i], BUF_SIZE, 0);
+		zassert_equal(ret, 0, "init failed: %d", ret);
+		zassert_equal(bufs[i].owner, SYS_DMA_BUF_OWNER_CPU);
+		memset(mem[i], i, BUF_SIZE);
+	}
+
+	ret = sys_dma_buf_to_device(bufs, NUM_BUFS);
+	zassert_equal(ret, 0, "hand over to device failed: %d", ret);
+
+	for (int i = 0; i < NUM_BUFS; i++) {
+		zassert_equal(bufs[i].owner, SYS_DMA_BUF_OWNER_DEVICE);
+	}
+
+	/* Already owned by the device */
+	ret = sys_dma_buf_to_device(&bufs[1], 1);
+	zassert_equal(ret, -EBUSY, "double hand over accepted: %d", ret);
+
+	ret = sys_dma_buf_to_cpu(bufs, NUM_BUFS);
+	zassert_equal(ret, 0, "hand back to CPU failed: %d", ret);
+
+	for (int i = 0; i < NUM_BUFS; i++) {
+		zassert_equal(bufs[i].owner, SYS_DMA_BUF_OWNER_CPU);
+		zassert_equal(mem[i][BUF_SIZE - 1], i, "buffer content lost");
+	}
+
+	/* A buffer already owned by the CPU fails the whole list */
+	bufs[2].owner = SYS_DMA_BUF_OWNER_DEVICE;
+	ret = sys_dma_buf_to_cpu(bufs, NUM_BUFS);
+	zassert_equal(ret, -EBUSY, "double hand back accepted: %d", ret);
+	zassert_equal(bufs[0].owner, SYS_DMA_BUF_OWNER_CPU);
+	zassert_equal(bufs[2].owner, SYS_DMA_BUF_OWNER_DEVICE);
+}
+
+ZTEST(dma_buf, test_dma_buf_unaligned)
+{
+	struct sys_dma_buf buf;
+	size_t line_size = sys_cache_data_line_size_get();
+	int ret;
+
+	if (!IS_ENABLED(CONFIG_DCACHE) || line_size <= 1) {
+		ztest_test_skip();
+	}
+
+	ret = sys_dma_buf_init(&buf, &mem[0][1], BUF_SIZE - line_size, 0);
+	zassert_equal(ret, -EINVAL, "unaligned buffer accepted");
+
+	ret = sys_dma_buf_init(&buf, &mem[0][1], BUF_SIZE - line_size,
+			       SYS_DMA_BUF_COHERENT);
+	zassert_equal(ret, 0, "coherent buffer rejected: %d", ret);
+}
+
+ZTEST(dma_buf, test_dma_buf_alloc)
+{
+	struct sys_dma_buf buf;
+	int ret;
+
+	ret = sys_dma_buf_alloc(&buf, 0);
+	zassert_equal(ret, -EINVAL, "empty buffer allocated");
+
+	ret = sys_dma_buf_alloc(&buf, 100);
+	zassert_equal(ret, 0, "allocation failed: %d", ret);
+	zassert_not_null(buf.addr);
+	zassert_true(buf.size >= 100, "buffer too small");
+	zassert_equal(buf.owner, SYS_DMA_BUF_OWNER_CPU);
+
+	ret = sys_dma_buf_to_device(&buf, 1);
+	zassert_equal(ret, 0, "hand over to device failed: %d", ret);
+
+	ret = sys_dma_buf_to_cpu(&buf, 1);
+	zassert_equal(ret, 0, "hand back to CPU failed: %d", ret);
+
+	sys_dma_buf_free(&buf);
+	zassert_is_null(buf.addr);
+}
+
+ZTEST(dma_buf, test_cache_range_batch)
+{
+	struct sys_cache_range ranges[NUM_BUFS];
+	int ret;
+
+	for (int i = 0; i < NUM_BUFS; i++) {
+		ranges[i].addr = mem[i];
+		ranges[i].size = BUF_SIZE;
+	}
+
+	ret = sys_cache_data_range_batch(ranges, NUM_BUFS, K_CACHE_WB);
+	if (IS_ENABLED(CONFIG_CACHE_MANAGEMENT) && IS_ENABLED(CONFIG_DCACHE)) {
+		zassert_equal(ret, 0, "batched write-back failed: %d", ret);
+	} else {
+		zassert_equal(ret, -ENOTSUP, "expected -ENOTSUP, got %d", ret);
+	}
+
+	ret = sys_cache_data_range_batch(ranges, 0, K_CACHE_WB);
+	zassert_equal(ret, 0, "empty batch failed: %d", ret);
+}
+
+ZTEST_SUITE(dma_buf, NULL, NULL, NULL, NULL, NULL);
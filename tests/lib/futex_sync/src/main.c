@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/sys/futex_sync.h>
+
+#define STACK_SIZE	(1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define NUM_THREADS	3
+#define THREAD_OPTIONS	(K_USER | K_INHERIT_PERMS)
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, NUM_THREADS, STACK_SIZE);
+static struct k_thread threads[NUM_THREADS];
+
+ZTEST_BMEM SYS_FMUTEX_DEFINE(mutex);
+ZTEST_BMEM SYS_RWLOCK_DEFINE(rwlock);
+ZTEST_BMEM SYS_CONDVAR_DEFINE(condvar);
+ZTEST_BMEM SYS_BARRIER_DEFINE(barrier, NUM_THREADS + 1);
+ZTEST_BMEM SYS_ONCE_DEFINE(once);
+
+static ZTEST_BMEM int shared;
+static ZTEST_BMEM atomic_t counter;
+
+static void start_threads(k_thread_entry_t entry, int num_threads)
+{
+	for (int i = 0; i < num_threads; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, entry,
+				NULL, NULL, NULL, K_PRIO_PREEMPT(0),
+				THREAD_OPTIONS, K_NO_WAIT);
+	}
+}
+
+static void join_threads(int num_threads)
+{
+	for (int i = 0; i < num_threads; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+}
+
+static void mutex_busy_entry(void *p1, void *p2, void *p3)
+{
+	zassert_equal(sys_fmutex_lock(&mutex, K_NO_WAIT), -EBUSY);
+	zassert_equal(sys_fmutex_unlock(&mutex), -EPERM);
+}
+
+static void mutex_count_entry(void *p1, void *p2, void *p3)
+{
+	int val;
+
+	for (int i = 0; i < 100; i++) {
+		zassert_equal(sys_fmutex_lock(&mutex, K_FOREVER), 0);
+		val = shared;
+		k_yield();
+		shared = val + 1;
+		zassert_equal(sys_fmutex_unlock(&mutex), 0);
+	}
+}
+
+/**
+ * @brief Test futex-based mutex
+ *
+ * @see sys_fmutex_lock(), sys_fmutex_unlock()
+ */
+ZTEST_USER(futex_sync, test_fmutex)
+{
+	zassert_equal(sys_fmutex_unlock(&mutex), -EINVAL);
+
+	/**TESTPOINT: recursive locking */
+	zassert_equal(sys_fmutex_lock(&mutex, K_NO_WAIT), 0);
+	zassert_equal(sys_fmutex_lock(&mutex, K_NO_WAIT), 0);
+
+	/**TESTPOINT: other threads can't take nor release the mutex */
+	start_threads(mutex_busy_entry, 1);
+	join_threads(1);
+
+	zassert_equal(sys_fmutex_unlock(&mutex), 0);
+	zassert_equal(sys_fmutex_unlock(&mutex), 0);
+	zassert_equal(sys_fmutex_unlock(&mutex), -EINVAL);
+
+	/**TESTPOINT: mutual exclusion under contention */
+	shared = 0;
+	start_threads(mutex_count_entry, NUM_THREADS);
+	join_threads(NUM_THREADS);
+	zassert_equal(shared, NUM_THREADS * 100);
+}
+
+static void rwlock_reader_entry(void *p1, void *p2, void *p3)
+{
+	zassert_equal(sys_rwlock_read_lock(&rwlock, K_FOREVER), 0);
+	atomic_inc(&counter);
+	zassert_equal(sys_rwlock_read_unlock(&rwlock), 0);
+}
+
+/**
+ * @brief Test futex-based read/write lock
+ *
+ * @see sys_rwlock_read_lock(), sys_rwlock_write_lock()
+ */
+ZTEST_USER(futex_sync, test_rwlock)
+{
+	zassert_equal(sys_rwlock_read_unlock(&rwlock), -EINVAL);
+	zassert_equal(sys_rwlock_write_unlock(&rwlock), -EINVAL);
+
+	/**TESTPOINT: readers share the lock, writers are excluded */
+	zassert_equal(sys_rwlock_read_lock(&rwlock, K_NO_WAIT), 0);
+	zassert_equal(sys_rwlock_read_lock(&rwlock, K_NO_WAIT), 0);
+	zassert_equal(sys_rwlock_write_lock(&rwlock, K_NO_WAIT), -EBUSY);
+	zassert_equal(sys_rwlock_write_lock(&rwlock, K_MSEC(10)), -EAGAIN);
+	zassert_equal(sys_rwlock_read_unlock(&rwlock), 0);
+	zassert_equal(sys_rwlock_read_unlock(&rwlock), 0);
+
+	/**TESTPOINT: writers exclude everyone */
+	zassert_equal(sys_rwlock_write_lock(&rwlock, K_NO_WAIT), 0);
+	zassert_equal(sys_rwlock_read_lock(&rwlock, K_NO_WAIT), -EBUSY);
+	zassert_equal(sys_rwlock_write_lock(&rwlock, K_NO_WAIT), -EBUSY);
+
+	/**TESTPOINT: readers waiting on a writer get the lock */
+	atomic_set(&counter, 0);
+	start_threads(rwlock_reader_entry, NUM_THREADS);
+	k_msleep(10);
+	zassert_equal(atomic_get(&counter), 0);
+	zassert_equal(sys_rwlock_read_unlock(&rwlock), -EINVAL);
+	zassert_equal(sys_rwlock_write_unlock(&rwlock), 0);
+	join_threads(NUM_THREADS);
+	zassert_equal(atomic_get(&counter), NUM_THREADS);
+
+	zassert_equal(sys_rwlock_write_lock(&rwlock, K_NO_WAIT), 0);
+	zassert_equal(sys_rwlock_write_unlock(&rwlock), 0);
+}
+
+static void condvar_waiter_entry(void *p1, void *p2, void *p3)
+{
+	zassert_equal(sys_fmutex_lock(&mutex, K_FOREVER), 0);
+	while (shared == 0) {
+		zassert_equal(sys_condvar_wait(&condvar, &mutex, K_FOREVER),
+			      0);
+	}
+	atomic_inc(&counter);
+	zassert_equal(sys_fmutex_unlock(&mutex), 0);
+}
+
+/**
+ * @brief Test futex-based condition variable
+ *
+ * @see sys_condvar_wait(), sys_condvar_signal(), sys_condvar_broadcast()
+ */
+ZTEST_USER(futex_sync, test_condvar)
+{
+	/**TESTPOINT: waiting requires the mutex */
+	zassert_equal(sys_condvar_wait(&condvar, &mutex, K_NO_WAIT), -EPERM);
+
+	/**TESTPOINT: waiting times out, the mutex is held again */
+	zassert_equal(sys_fmutex_lock(&mutex, K_NO_WAIT), 0);
+	zassert_equal(sys_fmutex_lock(&mutex, K_NO_WAIT), 0);
+	zassert_equal(sys_condvar_wait(&condvar, &mutex, K_MSEC(10)), -EAGAIN);
+	zassert_equal(sys_fmutex_unlock(&mutex), 0);
+	zassert_equal(sys_fmutex_unlock(&mutex), 0);
+
+	/**TESTPOINT: signaling without waiters */
+	zassert_equal(sys_condvar_signal(&condvar), 0);
+
+	/**TESTPOINT: broadcast wakes up all waiters */
+	shared = 0;
+	atomic_set(&counter, 0);
+	start_threads(condvar_waiter_entry, NUM_THREADS);
+	k_msleep(10);
+	zassert_equal(atomic_get(&counter), 0);
+
+	zassert_equal(sys_fmutex_lock(&mutex, K_FOREVER), 0);
+	shared = 1;
+	zassert_equal(sys_condvar_broadcast(&condvar), 0);
+	zassert_equal(sys_fmutex_unlock(&mutex), 0);
+
+	join_threads(NUM_THREADS);
+	zassert_equal(atomic_get(&counter), NUM_THREADS);
+}
+
+static void barrier_entry(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < 2; i++) {
+		if (sys_barrier_wait(&barrier) == 1) {
+			atomic_inc(&counter);
+		}
+	}
+}
+
+/**
+ * @brief Test futex-based barrier
+ *
+ * @see sys_barrier_wait()
+ */
+ZTEST_USER(futex_sync, test_barrier)
+{
+	int ret;
+
+	zassert_equal(sys_barrier_init(&barrier, 0), -EINVAL);
+	zassert_equal(sys_barrier_init(&barrier, NUM_THREADS + 1), 0);
+
+	/**TESTPOINT: one thread per round is the last one, the barrier
+	 * is reusable
+	 */
+	atomic_set(&counter, 0);
+	start_threads(barrier_entry, NUM_THREADS);
+	for (int i = 0; i < 2; i++) {
+		ret = sys_barrier_wait(&barrier);
+		zassert_true(ret == 0 || ret == 1);
+		if (ret == 1) {
+			atomic_inc(&counter);
+		}
+	}
+	join_threads(NUM_THREADS);
+	zassert_equal(atomic_get(&counter), 2);
+}
+
+static void once_fn(void)
+{
+	k_msleep(10);
+	atomic_inc(&counter);
+}
+
+static void once_entry(void *p1, void *p2, void *p3)
+{
+	sys_once(&once, once_fn);
+	zassert_equal(atomic_get(&counter), 1);
+}
+
+/**
+ * @brief Test futex-based once control
+ *
+ * @see sys_once()
+ */
+ZTEST_USER(futex_sync, test_once)
+{
+	atomic_set(&counter, 0);
+	start_threads(once_entry, NUM_THREADS);
+	sys_once(&once, once_fn);
+	zassert_equal(atomic_get(&counter), 1);
+	join_threads(NUM_THREADS);
+
+	sys_once(&once, once_fn);
+	zassert_equal(atomic_get(&counter), 1);
+}
+
+static void *futex_sync_setup(void)
+{
+	for (int i = 0; i < NUM_THREADS; i++) {
+		k_thread_access_grant(k_current_get(), &threads[i], stacks[i]);
+	}
+
+	return NULL;
+}
+
+ZTEST_SUITE(futex_sync, NULL, futex_sync_setup, NULL, NULL, NULL);
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/sys/sys_heap.h>
+
+#define HEAP_SZ 2048
+
+static void *heapmem[HEAP_SZ / sizeof(void *)];
+static struct sys_heap heap;
+static struct sys_heap_profile profile;
+
+/* Distinct call sites */
+static __noinline void *alloc_site_a(size_t bytes)
+{
+	return sys_heap_alloc(&heap, bytes);
+}
+
+static __noinline void *alloc_site_b(size_t bytes)
+{
+	return sys_heap_alloc(&heap, bytes);
+}
+
+static __noinline void *alloc_site_c(size_t bytes)
+{
+	return sys_heap_alloc(&heap, bytes);
+}
+
+static uint32_t hist_sum(const uint32_t *hist)
+{
+	uint32_t sum = 0;
+
+	for (int i = 0; i < SYS_HEAP_PROFILE_BINS; i++) {
+		sum += hist[i];
+	}
+
+	return sum;
+}
+
+static const struct sys_heap_profile_site *find_site(size_t live_bytes)
+{
+	for (int i = 0; i < ARRAY_SIZE(profile.sites); i++) {
+		if (profile.sites[i].live_count != 0U &&
+		    profile.sites[i].live_bytes >= live_bytes) {
+			return &profile.sites[i];
+		}
+	}
+
+	return NULL;
+}
+
+static void *heap_setup(void)
+{
+	sys_heap_init(&heap, heapmem, sizeof(heapmem));
+
+	return NULL;
+}
+
+ZTEST(lib_heap_profile, test_profile_histograms)
+{
+	void *p;
+
+	sys_heap_profile_reset(&heap);
+
+	p = alloc_site_a(1);
+	sys_heap_free(&heap, p);
+	p = alloc_site_a(100);
+	sys_heap_free(&heap, p);
+	zassert_is_null(alloc_site_a(HEAP_SZ), "");
+
+	zassert_ok(sys_heap_profile_get(&heap, &profile), "");
+	zassert_equal(profile.size_hist[0], 1, "");
+	zassert_equal(profile.size_hist[6], 1, "");
+	zassert_equal(profile.failed_allocs, 1, "");
+	zassert_equal(hist_sum(profile.size_hist), 3, "");
+	zassert_equal(hist_sum(profile.alloc_cycles_hist), 3, "");
+	zassert_equal(hist_sum(profile.free_cycles_hist), 2, "");
+
+	sys_heap_profile_reset(&heap);
+	zassert_ok(sys_heap_profile_get(&heap, &profile), "");
+	zassert_equal(hist_sum(profile.size_hist), 0, "");
+	zassert_equal(profile.failed_allocs, 0, "");
+}
+
+ZTEST(lib_heap_profile, test_profile_sites)
+{
+	const struct sys_heap_profile_site *site;
+	void *a, *b, *c;
+	size_t usable;
+
+	a = alloc_site_a(256);
+	b = alloc_site_b(64);
+	zassert_not_null(a, "");
+	zassert_not_null(b, "");
+
+	/* The profiling tag is not part of the usable memory */
+	usable = sys_heap_usable_size(&heap, b);
+	zassert_true(usable >= 64, "");
+	memset(b, 0xa5, usable);
+	zassert_true(sys_heap_validate(&heap), "");
+
+	zassert_ok(sys_heap_profile_get(&heap, &profile), "");
+	site = find_site(256);
+	zassert_not_null(site, "site a not tracked");
+	zassert_equal(site->live_count, 1, "");
+	zassert_equal(profile.other_live_bytes, 0, "");
+
+	/* Only two sites fit, the third one is lumped together */
+	c = alloc_site_c(32);
+	zassert_not_null(c, "");
+	zassert_ok(sys_heap_profile_get(&heap, &profile), "");
+	zassert_true(profile.other_live_bytes >= 32, "");
+
+	/* Growing retags the block */
+	b = sys_heap_realloc(&heap, b, 512);
+	zassert_not_null(b, "");
+	zassert_true(sys_heap_validate(&heap), "");
+
+	sys_heap_free(&heap, a);
+	sys_heap_free(&heap, b);
+	sys_heap_free(&heap, c);
+
+	zassert_ok(sys_heap_profile_get(&heap, &profile), "");
+	for (int i = 0; i < ARRAY_SIZE(profile.sites); i++) {
+		zassert_equal(profile.sites[i].live_count, 0, "");
+		zassert_equal(profile.sites[i].live_bytes, 0, "");
+	}
+	zassert_equal(profile.other_live_bytes, 0, "");
+}
+
+ZTEST(lib_heap_profile, test_profile_fragmentation)
+{
+	void *blocks[8];
+	struct sys_memory_stats stats;
+
+	zassert_ok(sys_heap_profile_get(&heap, &profile), "");
+	zassert_equal(profile.fragmentation, 0, "empty heap is fragmented");
+	zassert_equal(profile.largest_free_bytes, profile.free_bytes, "");
+
+	sys_heap_runtime_stats_get(&heap, &stats);
+	zassert_equal(profile.free_bytes, stats.free_bytes, "");
+
+	/* Free every other block to punch holes into the heap */
+	for (int i = 0; i < ARRAY_SIZE(blocks); i++) {
+		blocks[i] = sys_heap_alloc(&heap, 64);
+		zassert_not_null(blocks[i], "");
+	}
+	for (int i = 0; i < ARRAY_SIZE(blocks); i += 2) {
+		sys_heap_free(&heap, blocks[i]);
+	}
+
+	zassert_ok(sys_heap_profile_get(&heap, &profile), "");
+	zassert_true(profile.fragmentation > 0, "holes not accounted");
+	zassert_true(profile.largest_free_bytes < profile.free_bytes, "");
+
+	for (int i = 1; i < ARRAY_SIZE(blocks); i += 2) {
+		sys_heap_free(&heap, blocks[i]);
+	}
+	zassert_ok(sys_heap_profile_get(&heap, &profile), "");
+	zassert_equal(profile.fragmentation, 0, "");
+}
+
+ZTEST_SUITE(lib_heap_profile, NULL, heap_setup, NULL, NULL, NULL);
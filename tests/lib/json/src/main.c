@@ -662,4 +662,177 @@ ZTEST(lib_json_test, test_json_encode_bounds_check)
 	zassert_equal(ret, -ENOMEM, "Bounds check failed");
 }
 
+struct encode_count {
+	char *buffer;
+	size_t used;
+	int calls;
+};
+
+static int append_counted(const char *bytes, size_t len, void *data)
+{
+	struct encode_count *count = data;
+
+	memcpy(count->buffer + count->used, bytes, len);
+	count->used += len;
+	count->calls++;
+
+	return 0;
+}
+
+ZTEST(lib_json_test, test_json_encode_buffered)
+{
+	struct obj_array oa = {
+		.elements = {
+			{ .name = "Simón Bolívar", .height = 168 },
+			{ .name = "Muggsy Bogues", .height = 160 },
+			{ .name = "Pelé", .height = 173 },
+		},
+		.num_elements = 3,
+	};
+	char expected[256];
+	char encoded[256];
+	char batch[32];
+	struct encode_count count = { .buffer = encoded };
+	int ret;
+
+	ret = json_obj_encode_buf(obj_array_descr, ARRAY_SIZE(obj_array_descr),
+				  &oa, expected, sizeof(expected));
+	zassert_equal(ret, 0, "Encoding function failed");
+
+	ret = json_obj_encode_buffered(obj_array_descr,
+				       ARRAY_SIZE(obj_array_descr), &oa,
+				       append_counted, &count, batch,
+				       sizeof(batch));
+	zassert_equal(ret, 0, "Buffered encoding failed");
+	zassert_equal(count.used, strlen(expected), "Encoded size mismatch");
+	zassert_mem_equal(encoded, expected, count.used,
+			  "Encoded contents not consistent");
+	zassert_true(count.calls <= DIV_ROUND_UP(count.used, sizeof(batch)) * 2,
+		     "Output was not batched");
+}
+
+static const char stream_doc[] =
+	"{\"name\" : \"zephyr\\n\", \"tags\":[1, -2.5e3, true, false, null],"
+	" \"nested\":{\"empty\":{}, \"list\":[]}}";
+
+static const struct {
+	enum json_tokens type;
+	bool key;
+	const char *text;
+} stream_tokens[] = {
+	{ JSON_TOK_OBJECT_START, false, "{" },
+	{ JSON_TOK_STRING, true, "name" },
+	{ JSON_TOK_STRING, false, "zephyr\\n" },
+	{ JSON_TOK_STRING, true, "tags" },
+	{ JSON_TOK_ARRAY_START, false, "[" },
+	{ JSON_TOK_NUMBER, false, "1" },
+	{ JSON_TOK_NUMBER, false, "-2.5e3" },
+	{ JSON_TOK_TRUE, false, "true" },
+	{ JSON_TOK_FALSE, false, "false" },
+	{ JSON_TOK_NULL, false, "null" },
+	{ JSON_TOK_ARRAY_END, false, "]" },
+	{ JSON_TOK_STRING, true, "nested" },
+	{ JSON_TOK_OBJECT_START, false, "{" },
+	{ JSON_TOK_STRING, true, "empty" },
+	{ JSON_TOK_OBJECT_START, false, "{" },
+	{ JSON_TOK_OBJECT_END, false, "}" },
+	{ JSON_TOK_STRING, true, "list" },
+	{ JSON_TOK_ARRAY_START, false, "[" },
+	{ JSON_TOK_ARRAY_END, false, "]" },
+	{ JSON_TOK_OBJECT_END, false, "}" },
+	{ JSON_TOK_OBJECT_END, false, "}" },
+};
+
+static int stream_parse(const char *doc, size_t chunk_len, char *buf,
+			size_t buf_size, size_t *n_tokens)
+{
+	struct json_stream_token tok;
+	struct json_stream js;
+	size_t doc_len = strlen(doc);
+	size_t pos = 0;
+	size_t len;
+	int ret;
+
+	json_stream_init(&js, buf, buf_size);
+	*n_tokens = 0;
+
+	do {
+		len = MIN(chunk_len, doc_len - pos);
+		ret = json_stream_feed(&js, doc + pos, len, pos + len == doc_len);
+		if (ret < 0) {
+			return ret;
+		}
+		pos += len;
+
+		while ((ret = json_stream_next(&js, &tok)) == 0) {
+			if (*n_tokens == ARRAY_SIZE(stream_tokens) ||
+			    tok.type != stream_tokens[*n_tokens].type ||
+			    tok.key != stream_tokens[*n_tokens].key ||
+			    tok.length != strlen(stream_tokens[*n_tokens].text) ||
+			    memcmp(tok.start, stream_tokens[*n_tokens].text,
+				   tok.length) != 0) {
+				return -EBADMSG;
+			}
+			(*n_tokens)++;
+		}
+	} while (ret == -EAGAIN);
+
+	return ret;
+}
+
+ZTEST(lib_json_test, test_json_stream)
+{
+	struct json_stream_token tok;
+	struct json_stream js;
+	size_t n_tokens;
+	char buf[8];
+	int ret;
+
+	/* Whole document at once: tokens point into the input */
+	json_stream_init(&js, NULL, 0);
+	ret = json_stream_feed(&js, stream_doc, strlen(stream_doc), true);
+	zassert_equal(ret, 0, "Feeding document failed");
+	ret = json_stream_next(&js, &tok);
+	zassert_equal(ret, 0, "Getting first token failed");
+	ret = json_stream_next(&js, &tok);
+	zassert_equal(ret, 0, "Getting second token failed");
+	zassert_equal_ptr(tok.start, stream_doc + 2, "String was copied");
+
+	for (size_t chunk_len = 1; chunk_len <= sizeof(stream_doc); chunk_len++) {
+		ret = stream_parse(stream_doc, chunk_len, buf, sizeof(buf),
+				   &n_tokens);
+		zassert_equal(ret, -ENODATA, "Parsing failed with %zu byte chunks",
+			      chunk_len);
+		zassert_equal(n_tokens, ARRAY_SIZE(stream_tokens),
+			      "Token count mismatch");
+	}
+
+	/* Split tokens longer than the buffer are rejected */
+	ret = stream_parse(stream_doc, 1, buf, 4, &n_tokens);
+	zassert_equal(ret, -ENOMEM, "Buffer bounds not checked");
+}
+
+ZTEST(lib_json_test, test_json_stream_invalid)
+{
+	static const char * const docs[] = {
+		"[1,2", "{\"a\" 1}", "[1,]", "[1}", "\"abc", "tru", "[1.]",
+		"{\"a\":\"\\x\"}", "{1:2}",
+	};
+	struct json_stream_token tok;
+	struct json_stream js;
+	int ret;
+
+	for (size_t i = 0; i < ARRAY_SIZE(docs); i++) {
+		json_stream_init(&js, NULL, 0);
+		ret = json_stream_feed(&js, docs[i], strlen(docs[i]), true);
+		zassert_equal(ret, 0, "Feeding document failed");
+
+		do {
+			ret = json_stream_next(&js, &tok);
+		} while (ret == 0);
+
+		zassert_equal(ret, -EINVAL, "Invalid document %zu accepted", i);
+	}
+}
+
 ZTEST_SUITE(lib_json_test, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/sys/mpmc_queue.h>
+
+#define STACK_SIZE	(1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define NUM_PRODUCERS	2
+#define NUM_CONSUMERS	2
+#define NUM_ITEMS	1000
+#define QUEUE_SIZE	8
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, NUM_PRODUCERS + NUM_CONSUMERS,
+				   STACK_SIZE);
+static struct k_thread threads[NUM_PRODUCERS + NUM_CONSUMERS];
+
+SYS_MPMC_QUEUE_DEFINE(queue, QUEUE_SIZE);
+
+static uint32_t sums[NUM_CONSUMERS];
+
+static void *item(uintptr_t producer, uintptr_t i)
+{
+	return (void *)(i * NUM_PRODUCERS + producer + 1);
+}
+
+static void producer_entry(void *p1, void *p2, void *p3)
+{
+	uintptr_t id = POINTER_TO_UINT(p1);
+
+	for (uintptr_t i = 0; i < NUM_ITEMS; i++) {
+		while (sys_mpmc_queue_put(&queue, item(id, i)) == -ENOBUFS) {
+			k_yield();
+		}
+	}
+}
+
+static void consumer_entry(void *p1, void *p2, void *p3)
+{
+	uintptr_t id = POINTER_TO_UINT(p1);
+	uintptr_t last[NUM_PRODUCERS] = { 0 };
+	uintptr_t val;
+	void *data;
+
+	for (int i = 0; i < NUM_ITEMS * NUM_PRODUCERS / NUM_CONSUMERS; i++) {
+		zassert_equal(sys_mpmc_queue_get(&queue, &data, K_FOREVER), 0);
+
+		/* Items of a producer come out in order */
+		val = POINTER_TO_UINT(data);
+		zassert_true(val > last[(val - 1) % NUM_PRODUCERS]);
+		last[(val - 1) % NUM_PRODUCERS] = val;
+		sums[id] += val;
+	}
+}
+
+ZTEST(mpmc_queue, test_fifo)
+{
+	static struct sys_mpmc_cell cells[4];
+	struct sys_mpmc_queue q;
+	void *data;
+
+	sys_mpmc_queue_init(&q, cells, ARRAY_SIZE(cells));
+	zassert_true(sys_mpmc_queue_is_empty(&q));
+	zassert_equal(sys_mpmc_queue_try_get(&q, &data), -EAGAIN);
+
+	/* Several laps over the cells */
+	for (uintptr_t lap = 0; lap < 3; lap++) {
+		for (uintptr_t i = 0; i < ARRAY_SIZE(cells); i++) {
+			zassert_equal(sys_mpmc_queue_try_put(&q, UINT_TO_POINTER(lap + i)), 0);
+		}
+		zassert_equal(sys_mpmc_queue_try_put(&q, NULL), -ENOBUFS);
+
+		for (uintptr_t i = 0; i < ARRAY_SIZE(cells); i++) {
+			zassert_equal(sys_mpmc_queue_try_get(&q, &data), 0);
+			zassert_equal(POINTER_TO_UINT(data), lap + i);
+		}
+		zassert_true(sys_mpmc_queue_is_empty(&q));
+	}
+
+	zassert_equal(sys_mpmc_queue_get(&q, &data, K_MSEC(10)), -EAGAIN);
+}
+
+ZTEST(mpmc_queue, test_producers_consumers)
+{
+	uint32_t sum = 0;
+	uint32_t expected = 0;
+	int n = 0;
+
+	/* Consumers first, so that they block on the empty queue */
+	for (int i = 0; i < NUM_CONSUMERS; i++, n++) {
+		k_thread_create(&threads[n], stacks[n], STACK_SIZE,
+				consumer_entry, UINT_TO_POINTER(i), NULL, NULL,
+				K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	}
+
+	for (int i = 0; i < NUM_PRODUCERS; i++, n++) {
+		k_thread_create(&threads[n], stacks[n], STACK_SIZE,
+				producer_entry, UINT_TO_POINTER(i), NULL, NULL,
+				K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	}
+
+	for (int i = 0; i < n; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	for (int i = 0; i < NUM_CONSUMERS; i++) {
+		sum += sums[i];
+	}
+
+	for (uintptr_t i = 0; i < NUM_ITEMS * NUM_PRODUCERS; i++) {
+		expected += i + 1;
+	}
+
+	zassert_equal(sum, expected, "items lost or duplicated");
+	zassert_true(sys_mpmc_queue_is_empty(&queue));
+	zassert_equal(atomic_get(&queue.waiters), 0);
+}
+
+ZTEST_SUITE(mpmc_queue, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/smf.h>
+
+/*
+ * Event Test Transitions:
+ *
+ *	PARENT
+ *	|-- A --EVENT_NEXT--> B
+ *	|-- B --EVENT_NEXT--> A
+ *	|-- B --EVENT_STOP--> terminate
+ *
+ * Events are posted to a message queue and dispatched one at a time.
+ */
+
+#define TEST_OBJECT(o) ((struct test_object *)o)
+
+enum test_event {
+	EVENT_NEXT,
+	EVENT_STOP,
+	EVENT_IGNORED,
+};
+
+enum test_state {
+	STATE_PARENT,
+	STATE_A,
+	STATE_B,
+};
+
+#define TEST_TERMINATE_VALUE	-7
+
+static const struct smf_state test_states[];
+
+K_MSGQ_DEFINE(event_queue, sizeof(enum test_event), 8, 4);
+
+static struct test_object {
+	struct smf_ctx ctx;
+	uint32_t a_runs;
+	uint32_t b_runs;
+	uint32_t parent_entries;
+	uint32_t transitions;
+	const struct smf_state *last_exited;
+} test_obj;
+
+static void parent_entry(void *obj)
+{
+	TEST_OBJECT(obj)->parent_entries++;
+}
+
+static void state_a_run(void *obj)
+{
+	struct test_object *o = TEST_OBJECT(obj);
+
+	o->a_runs++;
+	if (*(const enum test_event *)o->ctx.event == EVENT_NEXT) {
+		smf_set_state(SMF_CTX(obj), &test_states[STATE_B]);
+	}
+}
+
+static void state_b_run(void *obj)
+{
+	struct test_object *o = TEST_OBJECT(obj);
+
+	o->b_runs++;
+	switch (*(const enum test_event *)o->ctx.event) {
+	case EVENT_NEXT:
+		smf_set_state(SMF_CTX(obj), &test_states[STATE_A]);
+		break;
+	case EVENT_STOP:
+		smf_set_terminate(SMF_CTX(obj), TEST_TERMINATE_VALUE);
+		break;
+	default:
+		break;
+	}
+}
+
+static void timing_cb(struct smf_ctx *ctx, const struct smf_state *state,
+		      uint32_t state_cycles, uint32_t transition_cycles)
+{
+	ARG_UNUSED(state_cycles);
+	ARG_UNUSED(transition_cycles);
+
+	TEST_OBJECT(ctx)->transitions++;
+	TEST_OBJECT(ctx)->last_exited = state;
+}
+
+static const struct smf_state test_states[] = {
+	[STATE_PARENT] = SMF_CREATE_STATE(parent_entry, NULL, NULL, NULL),
+	[STATE_A] = SMF_CREATE_STATE(NULL, state_a_run, NULL,
+				     &test_states[STATE_PARENT]),
+	[STATE_B] = SMF_CREATE_STATE(NULL, state_b_run, NULL,
+				     &test_states[STATE_PARENT]),
+};
+
+static void post(enum test_event event)
+{
+	zassert_equal(k_msgq_put(&event_queue, &event, K_NO_WAIT), 0,
+		      "Could not post event");
+}
+
+ZTEST(smf_tests, test_smf_events)
+{
+	enum test_event event;
+
+	memset(&test_obj, 0, sizeof(test_obj));
+	smf_set_initial(SMF_CTX(&test_obj), &test_states[STATE_A]);
+	smf_set_timing_cb(SMF_CTX(&test_obj), timing_cb);
+
+	zassert_equal(smf_dispatch(SMF_CTX(&test_obj), &event_queue, &event,
+				   K_NO_WAIT), -ENOMSG, "Queue not empty");
+
+	post(EVENT_IGNORED);
+	post(EVENT_NEXT);
+	post(EVENT_NEXT);
+	post(EVENT_NEXT);
+	post(EVENT_STOP);
+
+	while (smf_dispatch(SMF_CTX(&test_obj), &event_queue, &event,
+			    K_NO_WAIT) == 0) {
+		if (test_obj.ctx.terminate_val != 0) {
+			break;
+		}
+	}
+
+	zassert_equal(test_obj.ctx.terminate_val, TEST_TERMINATE_VALUE,
+		      "State machine did not terminate");
+	zassert_equal(test_obj.a_runs, 3, "Wrong number of A run actions");
+	zassert_equal(test_obj.b_runs, 2, "Wrong number of B run actions");
+	zassert_equal(test_obj.parent_entries, 1,
+		      "Shared parent entered more than once");
+	zassert_equal(test_obj.transitions, 3, "Wrong number of transitions");
+	zassert_equal(test_obj.last_exited, &test_states[STATE_A],
+		      "Wrong last exited state");
+	zassert_equal(test_obj.ctx.event, NULL, "Event left in context");
+}
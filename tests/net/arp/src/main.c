@@ -329,6 +329,7 @@ ZTEST(arp_fn_tests, test_arp)
 	struct net_eth_hdr *eth_hdr = NULL;
 	struct net_pkt *pkt;
 	struct net_pkt *pkt2;
+	struct net_pkt *coalesced_pkt;
 	struct net_if *iface;
 	struct net_if_addr *ifaddr;
 	struct net_arp_hdr *arp_hdr;
@@ -454,6 +455,31 @@ ZTEST(arp_fn_tests, test_arp)
 	zassert_equal(atomic_get(&pkt->atomic_ref), 2,
 		"ARP cache should own the original packet");
 
+	/* Another packet to the same destination is queued with the first
+	 * one while the address is being resolved.
+	 */
+	coalesced_pkt = net_pkt_alloc_with_buffer(iface,
+						  sizeof(struct net_ipv4_hdr) +
+						  len, AF_INET, 0, K_SECONDS(1));
+	zassert_not_null(coalesced_pkt, "out of mem");
+
+	ipv4 = (struct net_ipv4_hdr *)net_buf_add(coalesced_pkt->buffer,
+						  sizeof(struct net_ipv4_hdr));
+	net_ipv4_addr_copy_raw(ipv4->src, (uint8_t *)&src);
+	net_ipv4_addr_copy_raw(ipv4->dst, (uint8_t *)&dst);
+	memcpy(net_buf_add(coalesced_pkt->buffer, len), app_data, len);
+
+	pkt2 = net_arp_prepare(coalesced_pkt, &dst, NULL);
+	zassert_not_null(pkt2, "ARP pkt is empty");
+	zassert_not_equal((void *)(pkt2), (void *)(coalesced_pkt),
+			  "Pending address should not be resolved");
+	net_pkt_unref(pkt2);
+
+	zassert_equal(atomic_get(&coalesced_pkt->atomic_ref), 2,
+		      "ARP cache should own the coalesced packet");
+
+	ipv4 = NET_IPV4_HDR(pkt);
+
 	/* Then a case where target is not in the same subnet */
 	net_ipv4_addr_copy_raw(ipv4->dst, (uint8_t *)&dst_far);
 
@@ -551,6 +577,12 @@ ZTEST(arp_fn_tests, test_arp)
 	zassert_equal(atomic_get(&pkt->atomic_ref), 1,
 		      "ARP cache should no longer own the original packet");
 
+	/* The coalesced packet was sent with the pending one */
+	k_sleep(K_MSEC(10));
+	zassert_equal(atomic_get(&coalesced_pkt->atomic_ref), 1,
+		      "ARP cache should no longer own the coalesced packet");
+	net_pkt_unref(coalesced_pkt);
+
 	net_pkt_unref(pkt);
 
 	/* Then feed in ARP request */
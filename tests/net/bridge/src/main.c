@@ -217,10 +217,26 @@ static void test_iface_setup(void)
 	get_free_packet_count();
 }
 
+/*
+ * The source and destination MAC addresses are completely arbitrary
+ * except for the U/L and I/G bits. However, the index of the faked
+ * incoming interface is mixed in as well to create some variation,
+ * and to help with validation on the transmit side.
+ */
+static void set_src_addr(struct net_eth_addr *addr, struct net_if *iface)
+{
+	addr->addr[0] = 0xa2;
+	addr->addr[1] = 0x11;
+	addr->addr[2] = 0x22;
+	addr->addr[3] = net_if_get_by_iface(iface);
+	addr->addr[4] = 0x77;
+	addr->addr[5] = 0x88;
+}
+
 /*
  * Simulate a packet reception from the outside world
  */
-static void _recv_data(struct net_if *iface)
+static void _recv_data_to(struct net_if *iface, struct net_eth_addr *dst)
 {
 	struct net_pkt *pkt;
 	struct net_eth_hdr eth_hdr;
@@ -231,26 +247,18 @@ static void _recv_data(struct net_if *iface)
 					   AF_UNSPEC, 0, K_FOREVER);
 	zassert_not_null(pkt, "");
 
-	/*
-	 * The source and destination MAC addresses are completely arbitrary
-	 * except for the U/L and I/G bits. However, the index of the faked
-	 * incoming interface is mixed in as well to create some variation,
-	 * and to help with validation on the transmit side.
-	 */
-
-	eth_hdr.dst.addr[0] = 0xb2;
-	eth_hdr.dst.addr[1] = 0x11;
-	eth_hdr.dst.addr[2] = 0x22;
-	eth_hdr.dst.addr[3] = 0x33;
-	eth_hdr.dst.addr[4] = net_if_get_by_iface(iface);
-	eth_hdr.dst.addr[5] = 0x55;
+	if (dst != NULL) {
+		eth_hdr.dst = *dst;
+	} else {
+		eth_hdr.dst.addr[0] = 0xb2;
+		eth_hdr.dst.addr[1] = 0x11;
+		eth_hdr.dst.addr[2] = 0x22;
+		eth_hdr.dst.addr[3] = 0x33;
+		eth_hdr.dst.addr[4] = net_if_get_by_iface(iface);
+		eth_hdr.dst.addr[5] = 0x55;
+	}
 
-	eth_hdr.src.addr[0] = 0xa2;
-	eth_hdr.src.addr[1] = 0x11;
-	eth_hdr.src.addr[2] = 0x22;
-	eth_hdr.src.addr[3] = net_if_get_by_iface(iface);
-	eth_hdr.src.addr[4] = 0x77;
-	eth_hdr.src.addr[5] = 0x88;
+	set_src_addr(&eth_hdr.src, iface);
 
 	eth_hdr.type = htons(NET_ETH_PTYPE_ALL);
 
@@ -265,6 +273,11 @@ static void _recv_data(struct net_if *iface)
 	zassert_equal(ret, 0, "");
 }
 
+static void _recv_data(struct net_if *iface)
+{
+	_recv_data_to(iface, NULL);
+}
+
 static void test_recv_before_bridging(void)
 {
 	/* fake some packet reception */
@@ -352,6 +365,54 @@ static void test_recv_with_bridge(void)
 	check_free_packet_count();
 }
 
+struct fdb_check {
+	struct net_eth_addr addr;
+	struct net_if *iface;
+	bool found;
+};
+
+static void fdb_check_cb(struct eth_bridge *br,
+			 const struct eth_bridge_fdb_entry *entry,
+			 void *user_data)
+{
+	struct fdb_check *check = user_data;
+
+	if (memcmp(entry->addr, check->addr.addr, sizeof(entry->addr)) == 0) {
+		zassert_equal_ptr(entry->iface, check->iface, "");
+		check->found = true;
+	}
+}
+
+static void test_recv_learned(void)
+{
+	struct fdb_check check = { .iface = fake_iface[0] };
+
+	/* the source addresses were learned by test_recv_with_bridge() */
+	set_src_addr(&check.addr, fake_iface[0]);
+	eth_bridge_fdb_foreach(&test_bridge, fdb_check_cb, &check);
+	zassert_true(check.found, "");
+
+	/* a packet to fake_iface[0]'s address is only sent there */
+	_recv_data_to(fake_iface[2], &check.addr);
+	k_sleep(K_MSEC(100));
+
+	zassert_is_null(eth_fake_data[1].sent_pkt, "");
+	zassert_is_null(eth_fake_data[2].sent_pkt, "");
+	zassert_not_null(eth_fake_data[0].sent_pkt, "");
+	net_pkt_unref(eth_fake_data[0].sent_pkt);
+	eth_fake_data[0].sent_pkt = NULL;
+
+	/* and not sent anywhere if it comes from that interface */
+	_recv_data_to(fake_iface[0], &check.addr);
+	k_sleep(K_MSEC(100));
+
+	zassert_is_null(eth_fake_data[0].sent_pkt, "");
+	zassert_is_null(eth_fake_data[1].sent_pkt, "");
+	zassert_is_null(eth_fake_data[2].sent_pkt, "");
+
+	check_free_packet_count();
+}
+
 static void test_recv_after_bridging(void)
 {
 	int ret;
@@ -374,6 +435,7 @@ ZTEST(net_eth_bridge, test_net_eth_bridge)
 	test_recv_before_bridging();
 	test_setup_bridge();
 	test_recv_with_bridge();
+	test_recv_learned();
 	test_recv_after_bridging();
 }
 
@@ -438,6 +438,49 @@ ZTEST(net_buf_tests, test_net_buf_fixed_pool)
 	zassert_equal(destroy_called, 1, "Incorrect destroy callback count");
 }
 
+ZTEST(net_buf_tests, test_net_buf_alloc_batch)
+{
+	struct net_buf *bufs[12];
+	int count;
+
+	destroy_called = 0;
+
+	count = net_buf_alloc_batch(&fixed_pool, bufs, 4);
+	zassert_equal(count, 4, "Failed to get buffers");
+
+	/* Only what is left in the pool is returned */
+	count += net_buf_alloc_batch(&fixed_pool, &bufs[count],
+				     ARRAY_SIZE(bufs) - count);
+	zassert_equal(count, 10, "Wrong number of buffers");
+
+	zassert_is_null(net_buf_alloc_fixed(&fixed_pool, K_NO_WAIT),
+			"Pool should be empty");
+
+	for (int i = 0; i < count; i++) {
+		zassert_equal(bufs[i]->size, 128, "Invalid buffer size");
+		zassert_equal(bufs[i]->len, 0, "Buffer not empty");
+		zassert_equal(bufs[i]->ref, 1, "Invalid ref count");
+
+		for (int j = 0; j < i; j++) {
+			zassert_not_equal(bufs[i], bufs[j],
+					  "Buffer allocated twice");
+		}
+	}
+
+	for (int i = 0; i < count; i++) {
+		net_buf_unref(bufs[i]);
+	}
+
+	zassert_equal(destroy_called, 10, "Incorrect destroy callback count");
+
+	count = net_buf_alloc_batch(&fixed_pool, bufs, 10);
+	zassert_equal(count, 10, "Buffers were not returned to the pool");
+
+	for (int i = 0; i < count; i++) {
+		net_buf_unref(bufs[i]);
+	}
+}
+
 ZTEST(net_buf_tests, test_net_buf_var_pool)
 {
 	struct net_buf *buf1, *buf2, *buf3;
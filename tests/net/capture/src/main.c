@@ -0,0 +1,268 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/dummy.h>
+#include <zephyr/net/capture.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/ztest.h>
+
+#define PCAPNG_SHB_TYPE		0x0A0D0D0A
+#define PCAPNG_IDB_TYPE		0x00000001
+#define PCAPNG_EPB_TYPE		0x00000006
+#define PCAPNG_BYTE_ORDER_MAGIC	0x1A2B3C4D
+
+#define SHB_LEN 28
+#define IDB_LEN 20
+#define EPB_HDR_LEN 28
+#define HEADER_LEN (SHB_LEN + IDB_LEN)
+
+#define LINKTYPE_RAW 101
+
+#define TEST_PORT 5683
+#define OTHER_PORT 1234
+
+/* IPv4 and UDP headers, and 2 bytes of payload */
+#define PKT_LEN (20 + 8 + 2)
+#define EPB_LEN (EPB_HDR_LEN + ROUND_UP(PKT_LEN, 4) + 4)
+
+static struct net_if *iface;
+static uint8_t ring_data[CONFIG_NET_CAPTURE_RING_SIZE];
+
+static uint32_t get_u32(const uint8_t *buf)
+{
+	uint32_t value;
+
+	/* The blocks are in host byte order */
+	memcpy(&value, buf, sizeof(value));
+
+	return value;
+}
+
+static struct net_pkt *udp_pkt(sa_family_t family, uint16_t src_port,
+			       uint16_t dst_port)
+{
+	uint8_t data[40 + 8 + 2] = { 0 };
+	struct net_pkt *pkt;
+	size_t ip_len;
+
+	if (family == AF_INET) {
+		ip_len = 20;
+		data[0] = 0x45;
+		data[9] = IPPROTO_UDP;
+	} else {
+		ip_len = 40;
+		data[0] = 0x60;
+		data[6] = IPPROTO_UDP;
+	}
+
+	sys_put_be16(src_port, &data[ip_len]);
+	sys_put_be16(dst_port, &data[ip_len + 2]);
+	data[ip_len + 8] = 0xab;
+	data[ip_len + 9] = 0xcd;
+
+	pkt = net_pkt_alloc_with_buffer(iface, ip_len + 10, AF_UNSPEC, 0,
+					K_SECONDS(1));
+	zassert_not_null(pkt, "Out of mem");
+	zassert_ok(net_pkt_write(pkt, data, ip_len + 10));
+
+	return pkt;
+}
+
+static void capture(sa_family_t family, uint16_t src_port, uint16_t dst_port)
+{
+	struct net_pkt *pkt = udp_pkt(family, src_port, dst_port);
+
+	net_capture_pkt(iface, pkt);
+	net_pkt_unref(pkt);
+}
+
+static void start(uint32_t snaplen, sa_family_t family, uint8_t proto,
+		  uint16_t port, net_capture_filter_cb_t filter)
+{
+	struct net_capture_ring_params params = {
+		.iface = iface,
+		.snaplen = snaplen,
+		.family = family,
+		.proto = proto,
+		.port = port,
+		.filter = filter,
+	};
+
+	zassert_ok(net_capture_ring_start(&params));
+}
+
+static void expect_stats(uint32_t saved, uint32_t dropped, uint32_t filtered)
+{
+	struct net_capture_ring_stats stats;
+
+	net_capture_ring_stats_get(&stats);
+
+	zassert_equal(stats.saved, saved, "%u packets saved", stats.saved);
+	zassert_equal(stats.dropped, dropped, "%u packets dropped",
+		      stats.dropped);
+	zassert_equal(stats.filtered, filtered, "%u packets filtered",
+		      stats.filtered);
+}
+
+static void *capture_setup(void)
+{
+	iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	zassert_not_null(iface, "Interface is NULL");
+
+	return NULL;
+}
+
+static void capture_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	(void)net_capture_ring_stop();
+}
+
+ZTEST(net_capture_ring, test_ring_start_stop)
+{
+	struct net_capture_ring_params params = { 0 };
+
+	zassert_equal(net_capture_ring_start(NULL), -EINVAL);
+	zassert_equal(net_capture_ring_start(&params), -EINVAL);
+
+	params.iface = iface;
+	zassert_ok(net_capture_ring_start(&params));
+	zassert_equal(net_capture_ring_start(&params), -EALREADY);
+
+	zassert_ok(net_capture_ring_stop());
+	zassert_equal(net_capture_ring_stop(), -EALREADY);
+
+	/* Nothing is saved once stopped */
+	zassert_equal(net_capture_ring_read(ring_data, sizeof(ring_data)),
+		      HEADER_LEN);
+	capture(AF_INET, OTHER_PORT, TEST_PORT);
+	zassert_equal(net_capture_ring_read(ring_data, sizeof(ring_data)), 0);
+}
+
+ZTEST(net_capture_ring, test_ring_pcapng)
+{
+	const uint8_t *epb = &ring_data[HEADER_LEN];
+
+	start(0, AF_UNSPEC, 0, 0, NULL);
+	capture(AF_INET, OTHER_PORT, TEST_PORT);
+
+	zassert_equal(net_capture_ring_read(ring_data, sizeof(ring_data)),
+		      HEADER_LEN + EPB_LEN);
+
+	/* Section header and interface description blocks */
+	zassert_equal(get_u32(&ring_data[0]), PCAPNG_SHB_TYPE);
+	zassert_equal(get_u32(&ring_data[4]), SHB_LEN);
+	zassert_equal(get_u32(&ring_data[8]), PCAPNG_BYTE_ORDER_MAGIC);
+	zassert_equal(get_u32(&ring_data[SHB_LEN - 4]), SHB_LEN);
+
+	zassert_equal(get_u32(&ring_data[SHB_LEN]), PCAPNG_IDB_TYPE);
+	zassert_equal(get_u32(&ring_data[SHB_LEN + 4]), IDB_LEN);
+	zassert_equal(get_u32(&ring_data[SHB_LEN + 8]) & 0xffff,
+		      LINKTYPE_RAW);
+
+	/* Enhanced packet block with the data padded to 32 bits */
+	zassert_equal(get_u32(&epb[0]), PCAPNG_EPB_TYPE);
+	zassert_equal(get_u32(&epb[4]), EPB_LEN);
+	zassert_equal(get_u32(&epb[20]), PKT_LEN, "captured length");
+	zassert_equal(get_u32(&epb[24]), PKT_LEN, "original length");
+	zassert_equal(epb[EPB_HDR_LEN], 0x45);
+	zassert_equal(sys_get_be16(&epb[EPB_HDR_LEN + 22]), TEST_PORT);
+	zassert_equal(epb[EPB_HDR_LEN + PKT_LEN - 1], 0xcd);
+	zassert_equal(get_u32(&epb[EPB_LEN - 4]), EPB_LEN);
+
+	zassert_equal(net_capture_ring_read(ring_data, sizeof(ring_data)), 0);
+
+	expect_stats(1, 0, 0);
+}
+
+ZTEST(net_capture_ring, test_ring_snaplen)
+{
+	const uint8_t *epb = &ring_data[HEADER_LEN];
+
+	start(16, AF_UNSPEC, 0, 0, NULL);
+	capture(AF_INET, OTHER_PORT, TEST_PORT);
+
+	zassert_equal(net_capture_ring_read(ring_data, sizeof(ring_data)),
+		      HEADER_LEN + EPB_HDR_LEN + 16 + 4);
+
+	zassert_equal(get_u32(&ring_data[SHB_LEN + 12]), 16, "IDB snaplen");
+	zassert_equal(get_u32(&epb[20]), 16, "captured length");
+	zassert_equal(get_u32(&epb[24]), PKT_LEN, "original length");
+}
+
+ZTEST(net_capture_ring, test_ring_filter)
+{
+	start(0, AF_INET, IPPROTO_UDP, TEST_PORT, NULL);
+
+	capture(AF_INET, OTHER_PORT, TEST_PORT);
+	capture(AF_INET, TEST_PORT, OTHER_PORT);
+	capture(AF_INET, OTHER_PORT, OTHER_PORT);
+	capture(AF_INET6, OTHER_PORT, TEST_PORT);
+
+	expect_stats(2, 0, 2);
+
+	zassert_equal(net_capture_ring_read(ring_data, sizeof(ring_data)),
+		      HEADER_LEN + 2 * EPB_LEN);
+}
+
+static int filter_calls;
+
+static bool filter_every_other(struct net_if *pkt_iface, struct net_pkt *pkt,
+			       void *user_data)
+{
+	ARG_UNUSED(pkt_iface);
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(user_data);
+
+	return (filter_calls++ % 2) == 0;
+}
+
+ZTEST(net_capture_ring, test_ring_filter_cb)
+{
+	filter_calls = 0;
+
+	/* The callback is only called for the packets the port matches */
+	start(0, AF_UNSPEC, 0, TEST_PORT, filter_every_other);
+
+	capture(AF_INET, OTHER_PORT, TEST_PORT);
+	capture(AF_INET6, OTHER_PORT, TEST_PORT);
+	capture(AF_INET, OTHER_PORT, OTHER_PORT);
+
+	zassert_equal(filter_calls, 2);
+	expect_stats(1, 0, 2);
+}
+
+ZTEST(net_capture_ring, test_ring_full)
+{
+	int count = (sizeof(ring_data) - HEADER_LEN) / EPB_LEN;
+	int i;
+
+	start(0, AF_UNSPEC, 0, 0, NULL);
+
+	/* The packets are dropped, not waited for, once the ring is full */
+	for (i = 0; i <= count; i++) {
+		capture(AF_INET, OTHER_PORT, TEST_PORT);
+	}
+
+	expect_stats(count, 1, 0);
+
+	zassert_equal(net_capture_ring_read(ring_data, sizeof(ring_data)),
+		      HEADER_LEN + count * EPB_LEN);
+
+	/* Reading makes room again */
+	capture(AF_INET, OTHER_PORT, TEST_PORT);
+	expect_stats(count + 1, 1, 0);
+}
+
+ZTEST_SUITE(net_capture_ring, NULL, capture_setup, NULL, capture_after,
+	    NULL);
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "gptp_data_set.h"
+#include "gptp_mi.h"
+
+/* Samples needed before the outliers are detected */
+#define SERVO_AVG_SAMPLES 16
+
+static struct gptp_servo servo;
+
+/* Feed a sample to the servo, one second after the previous one */
+static void servo_sample(int64_t offset)
+{
+	gptp_servo_sample(&servo, offset,
+			  servo.last_local_time + NSEC_PER_SEC);
+}
+
+static void servo_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	memset(&servo, 0, sizeof(servo));
+}
+
+ZTEST(gptp_servo, test_servo_first_sample)
+{
+	/* There is no interval to compute a frequency on yet */
+	servo_sample(1000);
+
+	zassert_equal(servo.samples, 1);
+	zassert_equal(servo.last_offset, 1000);
+	zassert_equal(servo.freq_ppb, 0.0);
+}
+
+ZTEST(gptp_servo, test_servo_pi)
+{
+	servo_sample(0);
+
+	/* 1000 ns off over 1 s, the proportional part corrects 70% of it
+	 * and the integral part accumulates 30% of it at each sample.
+	 */
+	servo_sample(1000);
+	zassert_within(servo.integral, 300.0, 0.001);
+	zassert_within(servo.freq_ppb, 1000.0, 0.001);
+
+	servo_sample(1000);
+	zassert_within(servo.integral, 600.0, 0.001);
+	zassert_within(servo.freq_ppb, 1300.0, 0.001);
+
+	/* Once in sync, only the integral part remains */
+	servo_sample(0);
+	zassert_within(servo.freq_ppb, 600.0, 0.001);
+
+	servo_sample(-2000);
+	zassert_within(servo.integral, 0.0, 0.001);
+	zassert_within(servo.freq_ppb, -1400.0, 0.001);
+}
+
+ZTEST(gptp_servo, test_servo_clamp)
+{
+	servo_sample(0);
+
+	/* The correction never exceeds the 100 ppm allowed by 802.1AS */
+	servo_sample(10 * NSEC_PER_MSEC);
+	zassert_within(servo.freq_ppb, 100000.0, 0.001);
+
+	servo_sample(-10 * (int64_t)NSEC_PER_MSEC);
+	servo_sample(-10 * (int64_t)NSEC_PER_MSEC);
+	zassert_within(servo.freq_ppb, -100000.0, 0.001);
+}
+
+ZTEST(gptp_servo, test_servo_long_interval)
+{
+	servo_sample(0);
+
+	/* Samples too far apart only update the statistics */
+	gptp_servo_sample(&servo, 1000, servo.last_local_time +
+			  20ULL * NSEC_PER_SEC);
+	zassert_equal(servo.samples, 2);
+	zassert_equal(servo.freq_ppb, 0.0);
+}
+
+ZTEST(gptp_servo, test_servo_statistics)
+{
+	servo_sample(0);
+	servo_sample(160);
+	servo_sample(-160);
+
+	/* Moving averages over 16 samples */
+	zassert_equal(servo.mean_abs_offset, 19);
+	zassert_equal(servo.jitter, 10 + (320 - 10) / SERVO_AVG_SAMPLES);
+}
+
+ZTEST(gptp_servo, test_servo_outliers)
+{
+	int i;
+
+	/* Not enough samples to know the jitter yet */
+	servo_sample(0);
+	zassert_false(gptp_servo_is_outlier(&servo, 100000));
+
+	for (i = 1; i < SERVO_AVG_SAMPLES; i++) {
+		servo_sample(0);
+	}
+
+	/* No jitter, the threshold is 4 times the 50 ns minimum */
+	zassert_false(gptp_servo_is_outlier(&servo, 200));
+	zassert_true(gptp_servo_is_outlier(&servo, 201));
+	zassert_equal(servo.outlier_count, 1);
+	zassert_equal(servo.consecutive_outliers, 1);
+
+	zassert_false(gptp_servo_is_outlier(&servo, -150));
+	zassert_equal(servo.consecutive_outliers, 0);
+
+	/* After three outliers in a row the offset is followed */
+	for (i = 0; i < 3; i++) {
+		zassert_true(gptp_servo_is_outlier(&servo, 5000));
+	}
+
+	zassert_false(gptp_servo_is_outlier(&servo, 5000));
+	zassert_equal(servo.outlier_count, 4);
+	zassert_equal(servo.consecutive_outliers, 0);
+}
+
+ZTEST_SUITE(gptp_servo, NULL, NULL, servo_before, NULL, NULL);
@@ -207,15 +207,39 @@ static void eth_fake_iface_init(struct net_if *iface)
 	ethernet_init(iface);
 }
 
+/* Sends and flushes seen by the Ethernet driver while logging: 'M' for a
+ * packet followed by more, 'S' for the last one, 'F' for a flush.
+ */
+static char tx_batch_log[16];
+static int tx_batch_len;
+static bool tx_batch_logging;
+
+static void tx_batch_event(char event)
+{
+	if (tx_batch_logging && tx_batch_len < sizeof(tx_batch_log) - 1) {
+		tx_batch_log[tx_batch_len++] = event;
+	}
+}
+
 static int eth_fake_send(const struct device *dev,
 			 struct net_pkt *pkt)
 {
 	ARG_UNUSED(dev);
-	ARG_UNUSED(pkt);
+
+	tx_batch_event(net_pkt_tx_more(pkt) ? 'M' : 'S');
 
 	return 0;
 }
 
+#if defined(CONFIG_NET_TX_BATCH)
+static void eth_fake_tx_flush(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	tx_batch_event('F');
+}
+#endif
+
 static enum ethernet_hw_caps eth_fake_get_capabilities(const struct device *dev)
 {
 	return ETHERNET_PROMISC_MODE;
@@ -250,6 +274,9 @@ static struct ethernet_api eth_fake_api_funcs = {
 	.get_capabilities = eth_fake_get_capabilities,
 	.set_config = eth_fake_set_config,
 	.send = eth_fake_send,
+#if defined(CONFIG_NET_TX_BATCH)
+	.tx_flush = eth_fake_tx_flush,
+#endif
 };
 
 static int eth_fake_init(const struct device *dev)
@@ -935,4 +962,66 @@ ZTEST(net_iface, test_get_by_index_from_userspace)
 	get_by_index_from_userspace();
 }
 
+static void tx_batch_queue(int count)
+{
+	static uint8_t data[] = { 't', 'e', 's', 't', '\0' };
+	struct net_pkt *pkt;
+	int i;
+
+	memset(tx_batch_log, 0, sizeof(tx_batch_log));
+	tx_batch_len = 0;
+	tx_batch_logging = true;
+
+	/* Queue all the packets before the TX thread gets to run */
+	k_sched_lock();
+
+	for (i = 0; i < count; i++) {
+		pkt = net_pkt_alloc_with_buffer(iface4, sizeof(data),
+						AF_INET6, 0, K_NO_WAIT);
+		zassert_not_null(pkt, "Cannot allocate pkt");
+
+		net_pkt_write(pkt, data, sizeof(data));
+		net_pkt_cursor_init(pkt);
+
+		net_if_queue_tx(iface4, pkt);
+	}
+
+	k_sched_unlock();
+
+	k_msleep(WAIT_TIME);
+
+	tx_batch_logging = false;
+}
+
+ZTEST(net_iface, test_tx_batch)
+{
+	if (!IS_ENABLED(CONFIG_NET_TX_BATCH)) {
+		ztest_test_skip();
+	}
+
+	/* The driver starts the transmission once for all the packets */
+	tx_batch_queue(3);
+	zassert_equal(strcmp(tx_batch_log, "MMSF"), 0, "Sent %s",
+		      tx_batch_log);
+
+	/* A single packet is not flagged and needs no flush */
+	tx_batch_queue(1);
+	zassert_equal(strcmp(tx_batch_log, "S"), 0, "Sent %s",
+		      tx_batch_log);
+}
+
+ZTEST(net_iface, test_tx_batch_size)
+{
+	if (!IS_ENABLED(CONFIG_NET_TX_BATCH)) {
+		ztest_test_skip();
+	}
+
+	/* CONFIG_NET_TX_BATCH_SIZE packets at most are taken at once, the
+	 * transmission being started at the end of each batch.
+	 */
+	tx_batch_queue(6);
+	zassert_equal(strcmp(tx_batch_log, "MMMSFMSF"), 0, "Sent %s",
+		      tx_batch_log);
+}
+
 ZTEST_SUITE(net_iface, NULL, iface_setup, NULL, NULL, iface_teardown);
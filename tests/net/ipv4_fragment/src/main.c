@@ -0,0 +1,312 @@
+/* main.c - Application main entry point */
+
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_IPV4_LOG_LEVEL);
+
+#include <zephyr/types.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <errno.h>
+
+#include <zephyr/ztest.h>
+
+#include <zephyr/net/ethernet.h>
+#include <zephyr/net/dummy.h>
+#include <zephyr/net/buf.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_if.h>
+
+#define NET_LOG_ENABLED 1
+#include "net_private.h"
+
+#include "ipv4.h"
+#include "udp_internal.h"
+
+#define LOCAL_PORT 4242
+#define REMOTE_PORT 4000
+
+/* Length of the datagrams, UDP header included */
+#define DGRAM_LEN 100
+
+#define WAIT_TIME K_MSEC(500)
+#define NO_DATA_TIME K_MSEC(100)
+#define ALLOC_TIMEOUT K_MSEC(500)
+
+static struct in_addr my_addr = { { { 192, 0, 2, 1 } } };
+
+static struct net_if *iface;
+static struct k_sem wait_data;
+
+static int recv_count;
+static bool recv_failed;
+
+/* Datagram being fragmented, UDP header followed by the data */
+static uint8_t dgram[DGRAM_LEN];
+
+static int net_iface_dev_init(const struct device *dev)
+{
+	return 0;
+}
+
+static void net_iface_init(struct net_if *iface)
+{
+	static uint8_t mac[] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_ETHERNET);
+}
+
+static int sender_iface(const struct device *dev, struct net_pkt *pkt)
+{
+	/* Nothing is expected to be sent, ICMP errors are ignored */
+	net_pkt_unref(pkt);
+
+	return 0;
+}
+
+static struct dummy_api net_iface_api = {
+	.iface_api.init = net_iface_init,
+	.send = sender_iface,
+};
+
+#define _ETH_L2_LAYER DUMMY_L2
+#define _ETH_L2_CTX_TYPE NET_L2_GET_CTX_TYPE(DUMMY_L2)
+
+NET_DEVICE_INIT(net_ipv4_frag_test, "net_ipv4_frag_test",
+		net_iface_dev_init, NULL, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT,
+		&net_iface_api, _ETH_L2_LAYER, _ETH_L2_CTX_TYPE, 127);
+
+static enum net_verdict udp_data_received(struct net_conn *conn,
+					  struct net_pkt *pkt,
+					  union net_ip_header *ip_hdr,
+					  union net_proto_header *proto_hdr,
+					  void *user_data)
+{
+	uint8_t data[DGRAM_LEN];
+
+	NET_DBG("Data %p received", pkt);
+
+	net_pkt_cursor_init(pkt);
+
+	if (net_pkt_get_len(pkt) != sizeof(struct net_ipv4_hdr) + DGRAM_LEN ||
+	    net_pkt_skip(pkt, sizeof(struct net_ipv4_hdr)) ||
+	    net_pkt_read(pkt, data, DGRAM_LEN) ||
+	    memcmp(data, dgram, DGRAM_LEN)) {
+		recv_failed = true;
+	}
+
+	recv_count++;
+	k_sem_give(&wait_data);
+
+	net_pkt_unref(pkt);
+
+	return NET_OK;
+}
+
+static void setup_udp_handler(void)
+{
+	static struct net_conn_handle *handle;
+	struct sockaddr local_addr = { 0 };
+	int ret;
+
+	net_ipaddr_copy(&net_sin(&local_addr)->sin_addr, &my_addr);
+	local_addr.sa_family = AF_INET;
+
+	ret = net_udp_register(AF_INET, NULL, &local_addr, 0, LOCAL_PORT,
+			       NULL, udp_data_received, NULL, &handle);
+	zassert_equal(ret, 0, "Cannot register UDP handler");
+}
+
+static uint16_t ipv4_hdr_chksum(const uint8_t *hdr)
+{
+	uint32_t sum = 0U;
+	int i;
+
+	for (i = 0; i < sizeof(struct net_ipv4_hdr); i += 2) {
+		sum += ((uint16_t)hdr[i] << 8) | hdr[i + 1];
+	}
+
+	while (sum >> 16) {
+		sum = (sum & 0xffff) + (sum >> 16);
+	}
+
+	return ~sum & 0xffff;
+}
+
+/* Send the [offset, offset + len) part of dgram from 192.0.2.src */
+static void recv_frag(uint8_t src, uint16_t id, uint16_t offset,
+		      uint16_t len, bool more)
+{
+	struct net_ipv4_hdr hdr = { 0 };
+	uint16_t field = (offset / 8U) | (more ? NET_IPV4_FRAGH_MF : 0U);
+	uint16_t chksum;
+	struct net_pkt *pkt;
+	int ret;
+
+	hdr.vhl = 0x45;
+	hdr.len = htons(sizeof(hdr) + len);
+	hdr.id[0] = id >> 8;
+	hdr.id[1] = id;
+	hdr.offset[0] = field >> 8;
+	hdr.offset[1] = field;
+	hdr.ttl = 64U;
+	hdr.proto = IPPROTO_UDP;
+	hdr.src[0] = 192U;
+	hdr.src[1] = 0U;
+	hdr.src[2] = 2U;
+	hdr.src[3] = src;
+	net_ipv4_addr_copy_raw(hdr.dst, (uint8_t *)&my_addr);
+
+	chksum = ipv4_hdr_chksum((uint8_t *)&hdr);
+	hdr.chksum = htons(chksum);
+
+	pkt = net_pkt_rx_alloc_with_buffer(iface, sizeof(hdr) + len, AF_INET,
+					   0, ALLOC_TIMEOUT);
+	zassert_not_null(pkt, "Cannot allocate fragment");
+
+	ret = net_pkt_write(pkt, &hdr, sizeof(hdr));
+	zassert_equal(ret, 0, "Cannot write IPv4 header");
+
+	ret = net_pkt_write(pkt, dgram + offset, len);
+	zassert_equal(ret, 0, "Cannot write payload");
+
+	ret = net_recv_data(iface, pkt);
+	zassert_equal(ret, 0, "Cannot receive fragment");
+}
+
+static void expect_datagram(void)
+{
+	zassert_equal(k_sem_take(&wait_data, WAIT_TIME), 0,
+		      "Datagram not reassembled");
+	zassert_false(recv_failed, "Reassembled datagram is corrupted");
+}
+
+static void expect_no_datagram(void)
+{
+	zassert_not_equal(k_sem_take(&wait_data, NO_DATA_TIME), 0,
+			  "Datagram reassembled unexpectedly");
+}
+
+static void *test_setup(void)
+{
+	struct net_if_addr *ifaddr;
+	int i;
+
+	k_sem_init(&wait_data, 0, UINT_MAX);
+
+	iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	zassert_not_null(iface, "Interface is NULL");
+
+	ifaddr = net_if_ipv4_addr_add(iface, &my_addr, NET_ADDR_MANUAL, 0);
+	zassert_not_null(ifaddr, "Cannot add IPv4 address");
+
+	net_if_up(iface);
+
+	UNALIGNED_PUT(htons(REMOTE_PORT), (uint16_t *)&dgram[0]);
+	UNALIGNED_PUT(htons(LOCAL_PORT), (uint16_t *)&dgram[2]);
+	UNALIGNED_PUT(htons(DGRAM_LEN), (uint16_t *)&dgram[4]);
+
+	/* No checksum, CONFIG_NET_UDP_MISSING_CHECKSUM accepts it */
+	for (i = sizeof(struct net_udp_hdr); i < DGRAM_LEN; i++) {
+		dgram[i] = i;
+	}
+
+	setup_udp_handler();
+
+	return NULL;
+}
+
+static void test_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	k_sem_reset(&wait_data);
+	recv_count = 0;
+	recv_failed = false;
+}
+
+ZTEST(net_ipv4_fragment, test_reassembly_in_order)
+{
+	recv_frag(10, 1, 0, 32, true);
+	recv_frag(10, 1, 32, 32, true);
+	expect_no_datagram();
+
+	recv_frag(10, 1, 64, DGRAM_LEN - 64, false);
+	expect_datagram();
+}
+
+ZTEST(net_ipv4_fragment, test_reassembly_out_of_order)
+{
+	recv_frag(10, 2, 64, DGRAM_LEN - 64, false);
+	recv_frag(10, 2, 0, 32, true);
+	expect_no_datagram();
+
+	recv_frag(10, 2, 32, 32, true);
+	expect_datagram();
+}
+
+ZTEST(net_ipv4_fragment, test_reassembly_overlap)
+{
+	/* Overlapping IPv4 fragments are accepted (RFC 791) */
+	recv_frag(10, 3, 0, 48, true);
+	recv_frag(10, 3, 32, 32, true);
+	recv_frag(10, 3, 56, DGRAM_LEN - 56, false);
+	expect_datagram();
+}
+
+ZTEST(net_ipv4_fragment, test_reassembly_eviction)
+{
+	/* The fourth datagram evicts the oldest one, all slots being used */
+	recv_frag(11, 4, 0, 64, true);
+	recv_frag(12, 4, 0, 64, true);
+	recv_frag(13, 4, 0, 64, true);
+	recv_frag(14, 4, 0, 64, true);
+
+	recv_frag(12, 4, 64, DGRAM_LEN - 64, false);
+	recv_frag(13, 4, 64, DGRAM_LEN - 64, false);
+	recv_frag(14, 4, 64, DGRAM_LEN - 64, false);
+	expect_datagram();
+	expect_datagram();
+	expect_datagram();
+
+	/* The first part of the evicted one is gone */
+	recv_frag(11, 4, 64, DGRAM_LEN - 64, false);
+	expect_no_datagram();
+
+	recv_frag(11, 4, 0, 64, true);
+	expect_datagram();
+
+	zassert_equal(recv_count, 4, "Wrong number of datagrams");
+}
+
+ZTEST(net_ipv4_fragment, test_reassembly_per_source_limit)
+{
+	/* A source holds at most two slots, even when a third one is
+	 * available, so its third datagram evicts its oldest one.
+	 */
+	recv_frag(20, 5, 0, 64, true);
+	recv_frag(20, 6, 0, 64, true);
+	recv_frag(20, 7, 0, 64, true);
+
+	recv_frag(20, 6, 64, DGRAM_LEN - 64, false);
+	recv_frag(20, 7, 64, DGRAM_LEN - 64, false);
+	expect_datagram();
+	expect_datagram();
+
+	recv_frag(20, 5, 64, DGRAM_LEN - 64, false);
+	expect_no_datagram();
+
+	recv_frag(20, 5, 0, 64, true);
+	expect_datagram();
+
+	zassert_equal(recv_count, 3, "Wrong number of datagrams");
+}
+
+ZTEST_SUITE(net_ipv4_fragment, NULL, test_setup, test_before, NULL, NULL);
@@ -299,11 +299,26 @@ NET_DEVICE_INIT(eth_ipv6_net, "eth_ipv6_net",
 		&net_test_if_api, _ETH_L2_LAYER, _ETH_L2_CTX_TYPE,
 		NET_ETH_MTU);
 
+/* Source and link layer destination of the UDP packets sent on the dummy
+ * interface.
+ */
+static struct k_sem dummy_sent;
+static struct in6_addr dummy_sent_src;
+static uint8_t dummy_sent_lladdr[6];
+
 /* dummy interface for multi-interface tests */
 static int dummy_send(const struct device *dev, struct net_pkt *pkt)
 {
 	ARG_UNUSED(dev);
-	ARG_UNUSED(pkt);
+
+	if (NET_IPV6_HDR(pkt)->nexthdr == IPPROTO_UDP &&
+	    net_pkt_lladdr_dst(pkt)->len == sizeof(dummy_sent_lladdr)) {
+		net_ipv6_addr_copy_raw(dummy_sent_src.s6_addr,
+				       NET_IPV6_HDR(pkt)->src);
+		memcpy(dummy_sent_lladdr, net_pkt_lladdr_dst(pkt)->addr,
+		       sizeof(dummy_sent_lladdr));
+		k_sem_give(&dummy_sent);
+	}
 
 	return 0;
 }
@@ -504,6 +519,7 @@ static void *ipv6_setup(void)
 
 	/* The semaphore is there to wait the data to be received. */
 	k_sem_init(&wait_data, 0, UINT_MAX);
+	k_sem_init(&dummy_sent, 0, UINT_MAX);
 
 	nbr_lookup_fail();
 	add_neighbor();
@@ -1608,4 +1624,110 @@ ZTEST(net_ipv6, test_dst_is_other_iface_mcast_recv)
 	net_context_put(ctx);
 }
 
+static void path_nbr_add(struct net_if *iface, struct in6_addr *addr,
+			 uint8_t *lladdr)
+{
+	struct net_linkaddr ll = {
+		.addr = lladdr,
+		.len = 6U,
+		.type = NET_LINK_ETHERNET,
+	};
+
+	zassert_not_null(net_ipv6_nbr_add(iface, addr, &ll, false,
+					  NET_IPV6_NBR_STATE_REACHABLE),
+			 "Cannot add neighbor");
+}
+
+static void path_send_check(struct net_context *ctx, struct in6_addr *src,
+			    uint8_t *lladdr)
+{
+	int ret;
+
+	ret = net_context_send(ctx, "path", 4, NULL, K_NO_WAIT, NULL);
+	zassert_equal(ret, 4, "Cannot send (%d)", ret);
+
+	zassert_ok(k_sem_take(&dummy_sent, K_MSEC(WAIT_TIME)),
+		   "Packet not sent");
+	zassert_true(net_ipv6_addr_cmp(&dummy_sent_src, src),
+		     "Sent from %s", net_sprint_ipv6_addr(&dummy_sent_src));
+	zassert_mem_equal(dummy_sent_lladdr, lladdr, 6,
+			  "Sent to the wrong neighbor");
+}
+
+/* A connected UDP context keeps following the path to its peer when an
+ * address or a neighbor changes, whether it caches the path or not.
+ */
+ZTEST(net_ipv6, test_connected_udp_path_change)
+{
+	struct in6_addr prefix = { { { 0x20, 0x01, 0x0d, 0xb8, 0x01, 0x00, 0,
+				       0, 0, 0, 0, 0, 0, 0, 0, 0 } } };
+	struct in6_addr src1 = { { { 0x20, 0x01, 0x0d, 0xb8, 0x01, 0x00, 0, 0,
+				     0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+	struct in6_addr src2 = { { { 0x20, 0x01, 0x0d, 0xb8, 0x01, 0x00, 0, 0,
+				     0, 0, 0, 0, 0, 0, 0, 0x3 } } };
+	struct in6_addr peer = { { { 0x20, 0x01, 0x0d, 0xb8, 0x01, 0x00, 0, 0,
+				     0, 0, 0, 0, 0, 0, 0, 0x2 } } };
+	struct sockaddr_in6 peer_sa = {
+		.sin6_family = AF_INET6,
+		.sin6_port = htons(PEER_PORT),
+	};
+	uint8_t lladdr1[] = { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x21 };
+	uint8_t lladdr2[] = { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x22 };
+	struct net_if *iface;
+	struct net_if_addr *ifaddr;
+	struct net_context *ctx;
+	int ret;
+
+	iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	zassert_not_null(iface, "Interface is NULL");
+
+	k_sem_reset(&dummy_sent);
+
+	zassert_not_null(net_if_ipv6_prefix_add(iface, &prefix, 64,
+						NET_IPV6_ND_INFINITE_LIFETIME),
+			 "Cannot add prefix");
+
+	ifaddr = net_if_ipv6_addr_add(iface, &src1, NET_ADDR_MANUAL, 0);
+	zassert_not_null(ifaddr, "Cannot add address");
+
+	/* Let DAD complete */
+	k_sleep(K_MSEC(WAIT_TIME));
+	zassert_equal(ifaddr->addr_state, NET_ADDR_PREFERRED,
+		      "Address still tentative");
+
+	path_nbr_add(iface, &peer, lladdr1);
+
+	net_ctx_create(&ctx);
+	net_ipaddr_copy(&peer_sa.sin6_addr, &peer);
+	ret = net_context_connect(ctx, (struct sockaddr *)&peer_sa,
+				  sizeof(peer_sa), NULL, K_NO_WAIT, NULL);
+	zassert_ok(ret, "Cannot connect (%d)", ret);
+
+	path_send_check(ctx, &src1, lladdr1);
+	path_send_check(ctx, &src1, lladdr1);
+
+	/* The neighbor moves to another link layer address */
+	net_ipv6_nbr_rm(iface, &peer);
+	path_nbr_add(iface, &peer, lladdr2);
+
+	path_send_check(ctx, &src1, lladdr2);
+	path_send_check(ctx, &src1, lladdr2);
+
+	/* The source address is replaced */
+	ifaddr = net_if_ipv6_addr_add(iface, &src2, NET_ADDR_MANUAL, 0);
+	zassert_not_null(ifaddr, "Cannot add address");
+	k_sleep(K_MSEC(WAIT_TIME));
+	zassert_true(net_if_ipv6_addr_rm(iface, &src1),
+		     "Cannot remove address");
+
+	path_send_check(ctx, &src2, lladdr2);
+	path_send_check(ctx, &src2, lladdr2);
+
+	net_context_put(ctx);
+
+	net_ipv6_nbr_rm(iface, &peer);
+	net_if_ipv6_addr_rm(iface, &src2);
+	net_if_ipv6_prefix_rm(iface, &prefix, 64);
+}
+
 ZTEST_SUITE(net_ipv6, NULL, ipv6_setup, NULL, NULL, ipv6_teardown);
@@ -2045,4 +2045,96 @@ ZTEST(net_ipv6_fragment, test_recv_ipv6_fragment)
 	zassert_true(ret == NET_OK, "IPv6 frag2 reassembly failed");
 }
 
+static void count_reass(struct net_reass *reass, void *user_data)
+{
+	(*(int *)user_data)++;
+}
+
+static int pending_reass(void)
+{
+	int count = 0;
+
+	net_ipv6_frag_foreach(count_reass, &count);
+
+	return count;
+}
+
+/* Receive a fragment of len bytes at offset, built on ipv6_reass_frag2 */
+static enum net_verdict recv_ipv6_frag(uint32_t id, uint16_t offset,
+				       uint16_t len, bool more)
+{
+	uint8_t frag[sizeof(ipv6_reass_frag2)];
+	uint16_t field = offset | (more ? 1U : 0U);
+	struct net_ipv6_hdr ipv6_hdr;
+	struct net_pkt_cursor backup;
+	enum net_verdict verdict;
+	struct net_pkt *pkt;
+	int ret;
+
+	memcpy(frag, ipv6_reass_frag2, sizeof(frag));
+	UNALIGNED_PUT(htons(NET_IPV6_FRAGH_LEN + len), (uint16_t *)&frag[4]);
+	UNALIGNED_PUT(htons(field), (uint16_t *)&frag[42]);
+	UNALIGNED_PUT(htonl(id), (uint32_t *)&frag[44]);
+
+	pkt = net_pkt_alloc_with_buffer(iface1, sizeof(frag) + len,
+					AF_UNSPEC, 0, ALLOC_TIMEOUT);
+	zassert_not_null(pkt, "packet");
+
+	net_pkt_set_family(pkt, AF_INET6);
+	net_pkt_set_ip_hdr_len(pkt, sizeof(struct net_ipv6_hdr));
+	net_pkt_cursor_init(pkt);
+
+	memcpy(&ipv6_hdr, frag, sizeof(struct net_ipv6_hdr));
+
+	ret = net_pkt_write(pkt, frag, sizeof(struct net_ipv6_hdr) + 1);
+	zassert_true(ret == 0, "IPv6 header append failed");
+
+	net_pkt_cursor_backup(pkt, &backup);
+
+	ret = net_pkt_write(pkt, frag + sizeof(struct net_ipv6_hdr) + 1,
+			    sizeof(frag) - sizeof(struct net_ipv6_hdr) - 1);
+	zassert_true(ret == 0, "IPv6 fragment header append failed");
+
+	ret = net_pkt_memset(pkt, 0, len);
+	zassert_true(ret == 0, "IPv6 payload append failed");
+
+	net_pkt_set_ipv6_fragment_start(pkt, sizeof(struct net_ipv6_hdr));
+	net_pkt_set_overwrite(pkt, true);
+
+	net_pkt_cursor_restore(pkt, &backup);
+
+	verdict = net_ipv6_handle_fragment_hdr(pkt, &ipv6_hdr,
+					       NET_IPV6_NEXTHDR_FRAG);
+	if (verdict == NET_DROP) {
+		net_pkt_unref(pkt);
+	}
+
+	return verdict;
+}
+
+ZTEST(net_ipv6_fragment, test_recv_ipv6_fragment_overlap)
+{
+	int pending = pending_reass();
+
+	zassert_equal(recv_ipv6_frag(0x1234, 0, 64, true), NET_OK,
+		      "First fragment not accepted");
+	zassert_equal(pending_reass(), pending + 1, "No reassembly pending");
+
+	/* Overlapping fragments drop the whole datagram (RFC 5722) */
+	zassert_equal(recv_ipv6_frag(0x1234, 32, 64, true), NET_DROP,
+		      "Overlapping fragment accepted");
+	zassert_equal(pending_reass(), pending, "Reassembly not dropped");
+
+	/* Adjacent fragments are fine */
+	zassert_equal(recv_ipv6_frag(0x1235, 0, 64, true), NET_OK,
+		      "First fragment not accepted");
+	zassert_equal(recv_ipv6_frag(0x1235, 64, 64, true), NET_OK,
+		      "Adjacent fragment not accepted");
+	zassert_equal(pending_reass(), pending + 1, "No reassembly pending");
+
+	zassert_equal(recv_ipv6_frag(0x1235, 96, 64, true), NET_DROP,
+		      "Overlapping fragment accepted");
+	zassert_equal(pending_reass(), pending, "Reassembly not dropped");
+}
+
 ZTEST_SUITE(net_ipv6_fragment, NULL, test_setup, NULL, NULL, NULL);
@@ -0,0 +1,472 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+
+#include <zephyr/net/socket.h>
+#include <zephyr/net/coap.h>
+#include <zephyr/net/coap_transfer.h>
+
+#include <zephyr/ztest.h>
+
+#define SERVER_PORT 5683
+
+#define BODY_LEN 200
+#define BLOCK_SIZE COAP_BLOCK_64
+#define BLOCK_BYTES 64
+#define BLOCK_COUNT DIV_ROUND_UP(BODY_LEN, BLOCK_BYTES)
+
+#define WAIT_MS 500
+#define NO_DATA_MS 100
+/* CONFIG_COAP_INIT_ACK_TIMEOUT_MS, not randomized, plus some slack */
+#define RETRANSMIT_WAIT_MS (CONFIG_COAP_INIT_ACK_TIMEOUT_MS + 500)
+/* Timeout of the retransmission, CONFIG_COAP_MAX_RETRANSMIT being 1 */
+#define GIVE_UP_WAIT_MS (2 * CONFIG_COAP_INIT_ACK_TIMEOUT_MS + 500)
+
+/* Request received by the test server */
+struct request {
+	uint16_t id;
+	uint8_t token[COAP_TOKEN_MAX_LEN];
+	uint8_t tkl;
+	uint8_t code;
+	/* Block2 option of a GET, Block1 option otherwise */
+	int block;
+	uint8_t payload[BLOCK_BYTES];
+	uint16_t payload_len;
+};
+
+static int srv_sock = -1;
+static int cli_sock = -1;
+static struct sockaddr_in srv_addr;
+static struct sockaddr client_addr;
+static socklen_t client_addrlen;
+static uint8_t srv_buf[256];
+static uint8_t cli_buf[256];
+
+static struct coap_transfer xfer;
+
+/* Body of the resource */
+static uint8_t body[BODY_LEN];
+
+/* Body received by the client */
+static uint8_t recv_body[BODY_LEN];
+static size_t recv_len;
+static bool recv_last;
+static bool recv_in_order;
+
+static int done_result;
+static K_SEM_DEFINE(done_sem, 0, 1);
+
+static int data_cb(struct coap_transfer *xfer, size_t offset,
+		   const uint8_t *data, size_t len, bool last,
+		   void *user_data)
+{
+	if (offset != recv_len) {
+		recv_in_order = false;
+	}
+
+	if (offset + len > sizeof(recv_body)) {
+		return -EINVAL;
+	}
+
+	memcpy(recv_body + offset, data, len);
+	recv_len = offset + len;
+	recv_last = last;
+
+	return 0;
+}
+
+static int read_cb(struct coap_transfer *xfer, size_t offset, uint8_t *data,
+		   size_t len, void *user_data)
+{
+	size_t n = MIN(len, sizeof(body) - offset);
+
+	memcpy(data, body + offset, n);
+
+	return n;
+}
+
+static void done_cb(struct coap_transfer *xfer, int result, uint8_t code,
+		    void *user_data)
+{
+	done_result = result;
+	k_sem_give(&done_sem);
+}
+
+static bool server_recv(struct request *req, int timeout_ms)
+{
+	struct zsock_pollfd fds = {
+		.fd = srv_sock,
+		.events = ZSOCK_POLLIN,
+	};
+	struct coap_packet cpkt;
+	const uint8_t *payload;
+	uint16_t len;
+	ssize_t ret;
+
+	if (zsock_poll(&fds, 1, timeout_ms) <= 0) {
+		return false;
+	}
+
+	client_addrlen = sizeof(client_addr);
+	ret = zsock_recvfrom(srv_sock, srv_buf, sizeof(srv_buf), 0,
+			     &client_addr, &client_addrlen);
+	zassert_true(ret > 0, "Cannot receive request (%d)", errno);
+
+	zassert_equal(coap_packet_parse(&cpkt, srv_buf, ret, NULL, 0), 0,
+		      "Invalid request");
+	zassert_equal(coap_header_get_type(&cpkt), COAP_TYPE_CON,
+		      "Request not confirmable");
+
+	req->id = coap_header_get_id(&cpkt);
+	req->tkl = coap_header_get_token(&cpkt, req->token);
+	req->code = coap_header_get_code(&cpkt);
+	req->block = coap_get_option_int(&cpkt,
+					 req->code == COAP_METHOD_GET ?
+					 COAP_OPTION_BLOCK2 :
+					 COAP_OPTION_BLOCK1);
+	zassert_true(req->block >= 0, "No block option");
+
+	payload = coap_packet_get_payload(&cpkt, &len);
+	req->payload_len = payload ? len : 0U;
+	zassert_true(req->payload_len <= sizeof(req->payload),
+		     "Block too large");
+	if (req->payload_len > 0U) {
+		memcpy(req->payload, payload, req->payload_len);
+	}
+
+	return true;
+}
+
+static void server_send(struct coap_packet *cpkt)
+{
+	ssize_t ret;
+
+	ret = zsock_sendto(srv_sock, cpkt->data, cpkt->offset, 0,
+			   &client_addr, client_addrlen);
+	zassert_equal(ret, cpkt->offset, "Cannot send response (%d)", errno);
+}
+
+/* Piggybacked response to a Block2 request */
+static void respond_block2(const struct request *req)
+{
+	uint32_t num = GET_BLOCK_NUM(req->block);
+	size_t offset = num * BLOCK_BYTES;
+	size_t len = MIN(BLOCK_BYTES, BODY_LEN - offset);
+	bool more = offset + len < BODY_LEN;
+	struct coap_packet cpkt;
+	int ret;
+
+	ret = coap_packet_init(&cpkt, srv_buf, sizeof(srv_buf),
+			       COAP_VERSION_1, COAP_TYPE_ACK, req->tkl,
+			       req->token, COAP_RESPONSE_CODE_CONTENT,
+			       req->id);
+	zassert_equal(ret, 0, "Cannot init response");
+
+	ret = coap_append_option_int(&cpkt, COAP_OPTION_BLOCK2,
+				     (num << 4) | (more ? 0x08 : 0) |
+				     BLOCK_SIZE);
+	zassert_equal(ret, 0, "Cannot append Block2");
+
+	if (num == 0U) {
+		ret = coap_append_option_int(&cpkt, COAP_OPTION_SIZE2,
+					     BODY_LEN);
+		zassert_equal(ret, 0, "Cannot append Size2");
+	}
+
+	ret = coap_packet_append_payload_marker(&cpkt);
+	zassert_equal(ret, 0, "Cannot append payload marker");
+
+	ret = coap_packet_append_payload(&cpkt, body + offset, len);
+	zassert_equal(ret, 0, "Cannot append payload");
+
+	server_send(&cpkt);
+}
+
+/* Piggybacked response to a Block1 request */
+static void respond_block1(const struct request *req)
+{
+	struct coap_packet cpkt;
+	int ret;
+
+	ret = coap_packet_init(&cpkt, srv_buf, sizeof(srv_buf),
+			       COAP_VERSION_1, COAP_TYPE_ACK, req->tkl,
+			       req->token,
+			       GET_MORE(req->block) ?
+			       COAP_RESPONSE_CODE_CONTINUE :
+			       COAP_RESPONSE_CODE_CHANGED,
+			       req->id);
+	zassert_equal(ret, 0, "Cannot init response");
+
+	ret = coap_append_option_int(&cpkt, COAP_OPTION_BLOCK1, req->block);
+	zassert_equal(ret, 0, "Cannot append Block1");
+
+	server_send(&cpkt);
+}
+
+/* Give the response waiting on the client socket to the transfer */
+static void client_input(void)
+{
+	struct zsock_pollfd fds = {
+		.fd = cli_sock,
+		.events = ZSOCK_POLLIN,
+	};
+	struct sockaddr from;
+	socklen_t fromlen = sizeof(from);
+	ssize_t len;
+
+	zassert_equal(zsock_poll(&fds, 1, WAIT_MS), 1, "No response");
+
+	len = zsock_recvfrom(cli_sock, cli_buf, sizeof(cli_buf), 0, &from,
+			     &fromlen);
+	zassert_true(len > 0, "Cannot receive response (%d)", errno);
+
+	zassert_equal(coap_transfer_input(&xfer, cli_buf, len, &from), 0,
+		      "Response not handled");
+}
+
+static void start_transfer(enum coap_method method)
+{
+	struct coap_transfer_params params = {
+		.method = method,
+		.path = "fw/image",
+		.block_size = BLOCK_SIZE,
+		.window = BLOCK_COUNT,
+		.total_size = BODY_LEN,
+		.data_cb = data_cb,
+		.read_cb = read_cb,
+		.done_cb = done_cb,
+	};
+	int ret;
+
+	ret = coap_transfer_start(&xfer, cli_sock,
+				  (struct sockaddr *)&srv_addr,
+				  sizeof(srv_addr), &params);
+	zassert_equal(ret, 0, "Cannot start transfer (%d)", ret);
+}
+
+static void expect_download(void)
+{
+	zassert_equal(k_sem_take(&done_sem, K_MSEC(WAIT_MS)), 0,
+		      "Transfer not done");
+	zassert_equal(done_result, 0, "Transfer failed (%d)", done_result);
+	zassert_true(recv_in_order, "Blocks delivered out of order");
+	zassert_true(recv_last, "Last block not flagged");
+	zassert_equal(recv_len, BODY_LEN, "Wrong body length");
+	zassert_mem_equal(recv_body, body, BODY_LEN, "Wrong body");
+}
+
+ZTEST(coap_transfer, test_block2_in_order)
+{
+	struct request req[BLOCK_COUNT];
+	struct request extra;
+
+	start_transfer(COAP_METHOD_GET);
+
+	/* The next blocks depend on the block size of the first response */
+	zassert_true(server_recv(&req[0], WAIT_MS), "No request");
+	zassert_equal(GET_BLOCK_NUM(req[0].block), 0, "Wrong first block");
+	zassert_false(server_recv(&extra, NO_DATA_MS),
+		      "Block requested before the first response");
+
+	respond_block2(&req[0]);
+	client_input();
+
+	/* The remaining blocks are requested at once */
+	for (int i = 1; i < BLOCK_COUNT; i++) {
+		zassert_true(server_recv(&req[i], WAIT_MS), "No request");
+		zassert_equal(GET_BLOCK_NUM(req[i].block), i, "Wrong block");
+	}
+
+	zassert_false(server_recv(&extra, NO_DATA_MS),
+		      "Block requested past the end");
+
+	for (int i = 1; i < BLOCK_COUNT; i++) {
+		respond_block2(&req[i]);
+		client_input();
+	}
+
+	expect_download();
+}
+
+ZTEST(coap_transfer, test_block2_out_of_order)
+{
+	struct request req[BLOCK_COUNT];
+
+	start_transfer(COAP_METHOD_GET);
+
+	zassert_true(server_recv(&req[0], WAIT_MS), "No request");
+	respond_block2(&req[0]);
+	client_input();
+	zassert_equal(recv_len, BLOCK_BYTES, "First block not delivered");
+
+	for (int i = 1; i < BLOCK_COUNT; i++) {
+		zassert_true(server_recv(&req[i], WAIT_MS), "No request");
+	}
+
+	/* Blocks following a missing one are kept until it arrives */
+	respond_block2(&req[3]);
+	client_input();
+	zassert_equal(recv_len, BLOCK_BYTES, "Block delivered too early");
+
+	respond_block2(&req[1]);
+	client_input();
+	zassert_equal(recv_len, 2 * BLOCK_BYTES, "Block not delivered");
+
+	respond_block2(&req[2]);
+	client_input();
+
+	expect_download();
+}
+
+ZTEST(coap_transfer, test_block1_upload)
+{
+	uint8_t uploaded[BODY_LEN];
+	struct request extra;
+	struct request req;
+	size_t len = 0;
+
+	start_transfer(COAP_METHOD_PUT);
+
+	for (int i = 0; i < BLOCK_COUNT; i++) {
+		zassert_true(server_recv(&req, WAIT_MS), "No request");
+		zassert_equal(req.code, COAP_METHOD_PUT, "Wrong method");
+		zassert_equal(GET_BLOCK_NUM(req.block), i, "Wrong block");
+		zassert_equal(GET_BLOCK_SIZE(req.block), BLOCK_SIZE,
+			      "Wrong block size");
+		zassert_equal(GET_MORE(req.block), i < BLOCK_COUNT - 1,
+			      "Wrong More flag");
+		zassert_true(len + req.payload_len <= sizeof(uploaded),
+			     "Body too long");
+
+		/* Servers handle Block1 one block at a time */
+		if (i == 0) {
+			zassert_false(server_recv(&extra, NO_DATA_MS),
+				      "Blocks uploaded in parallel");
+		}
+
+		memcpy(uploaded + len, req.payload, req.payload_len);
+		len += req.payload_len;
+
+		respond_block1(&req);
+		client_input();
+	}
+
+	zassert_equal(k_sem_take(&done_sem, K_MSEC(WAIT_MS)), 0,
+		      "Transfer not done");
+	zassert_equal(done_result, 0, "Transfer failed (%d)", done_result);
+	zassert_equal(len, BODY_LEN, "Wrong body length");
+	zassert_mem_equal(uploaded, body, BODY_LEN, "Wrong body");
+}
+
+ZTEST(coap_transfer, test_retransmission)
+{
+	struct request retx;
+	struct request req;
+
+	start_transfer(COAP_METHOD_GET);
+
+	/* The request is lost, it is sent again after the ACK timeout */
+	zassert_true(server_recv(&req, WAIT_MS), "No request");
+	zassert_true(server_recv(&retx, RETRANSMIT_WAIT_MS),
+		     "Request not retransmitted");
+	zassert_equal(retx.id, req.id, "Message ID changed");
+	zassert_equal(retx.tkl, req.tkl, "Token changed");
+	zassert_mem_equal(retx.token, req.token, req.tkl, "Token changed");
+	zassert_equal(retx.block, req.block, "Block changed");
+
+	respond_block2(&retx);
+	client_input();
+
+	for (int i = 1; i < BLOCK_COUNT; i++) {
+		zassert_true(server_recv(&req, WAIT_MS), "No request");
+		respond_block2(&req);
+		client_input();
+	}
+
+	expect_download();
+}
+
+ZTEST(coap_transfer, test_timeout)
+{
+	struct request req;
+
+	start_transfer(COAP_METHOD_GET);
+
+	zassert_true(server_recv(&req, WAIT_MS), "No request");
+	zassert_true(server_recv(&req, RETRANSMIT_WAIT_MS),
+		     "Request not retransmitted");
+
+	/* The transfer gives up once the retransmission timed out */
+	zassert_equal(k_sem_take(&done_sem, K_MSEC(GIVE_UP_WAIT_MS)), 0,
+		      "Transfer not done");
+	zassert_equal(done_result, -ETIMEDOUT, "Wrong result (%d)",
+		      done_result);
+	zassert_false(server_recv(&req, NO_DATA_MS),
+		      "Request sent after the timeout");
+	zassert_equal(recv_len, 0, "Data received");
+}
+
+static void drain(int sock)
+{
+	while (zsock_recv(sock, srv_buf, sizeof(srv_buf),
+			  ZSOCK_MSG_DONTWAIT) >= 0) {
+	}
+}
+
+static void *transfer_setup(void)
+{
+	int ret;
+
+	for (int i = 0; i < BODY_LEN; i++) {
+		body[i] = i;
+	}
+
+	srv_addr.sin_family = AF_INET;
+	srv_addr.sin_port = htons(SERVER_PORT);
+	ret = zsock_inet_pton(AF_INET, "127.0.0.1", &srv_addr.sin_addr);
+	zassert_equal(ret, 1, "Cannot parse address");
+
+	srv_sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	zassert_true(srv_sock >= 0, "Cannot create server socket");
+
+	ret = zsock_bind(srv_sock, (struct sockaddr *)&srv_addr,
+			 sizeof(srv_addr));
+	zassert_equal(ret, 0, "Cannot bind server socket (%d)", errno);
+
+	cli_sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	zassert_true(cli_sock >= 0, "Cannot create client socket");
+
+	return NULL;
+}
+
+static void transfer_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	drain(srv_sock);
+	drain(cli_sock);
+
+	k_sem_reset(&done_sem);
+	done_result = 1;
+	recv_len = 0;
+	recv_last = false;
+	recv_in_order = true;
+	memset(recv_body, 0, sizeof(recv_body));
+}
+
+static void transfer_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	/* Stops the retransmissions of a failed test */
+	coap_transfer_cancel(&xfer);
+}
+
+ZTEST_SUITE(coap_transfer, NULL, transfer_setup, transfer_before,
+	    transfer_after, NULL);
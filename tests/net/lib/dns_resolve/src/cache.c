@@ -0,0 +1,268 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <errno.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/dns_resolve.h>
+
+#include "dns_internal.h"
+
+#define CACHE_NAME "cache.zephyr.test"
+#define OTHER_NAME "other.zephyr.test"
+#define THIRD_NAME "third.zephyr.test"
+
+/* Time to live given by the "server", longer than the maximum one */
+#define SERVER_TTL (CONFIG_DNS_RESOLVER_CACHE_MAX_TTL * 10)
+
+#define TTL_MS(ttl) ((ttl) * MSEC_PER_SEC)
+
+static struct sockaddr addrs[2];
+
+static void *cache_setup(void)
+{
+	struct sockaddr_in *addr;
+
+	for (int i = 0; i < ARRAY_SIZE(addrs); i++) {
+		addr = net_sin(&addrs[i]);
+		addr->sin_family = AF_INET;
+		addr->sin_addr.s4_addr[0] = 192;
+		addr->sin_addr.s4_addr[2] = 2;
+		addr->sin_addr.s4_addr[3] = 10 + i;
+	}
+
+	return NULL;
+}
+
+static void cache_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	dns_resolve_cache_flush();
+}
+
+static int cache_find(const char *name, enum dns_query_type type,
+		      struct sockaddr *found, int *status)
+{
+	const char *prefetch = NULL;
+	int count;
+
+	count = dns_cache_find(name, type, found, ARRAY_SIZE(addrs), status,
+			       &prefetch);
+	zassert_is_null(prefetch, "unexpected refresh of %s", name);
+
+	return count;
+}
+
+ZTEST(dns_cache, test_cache_answer)
+{
+	struct sockaddr found[ARRAY_SIZE(addrs)];
+	int status;
+
+	zassert_equal(cache_find(CACHE_NAME, DNS_QUERY_TYPE_A, found, &status),
+		      -ENOENT, "empty cache hit");
+
+	dns_cache_update(CACHE_NAME, DNS_QUERY_TYPE_A, DNS_EAI_ALLDONE,
+			 addrs, ARRAY_SIZE(addrs), SERVER_TTL);
+
+	zassert_equal(cache_find(CACHE_NAME, DNS_QUERY_TYPE_A, found, &status),
+		      ARRAY_SIZE(addrs));
+	zassert_equal(status, DNS_EAI_ALLDONE);
+	zassert_mem_equal(found, addrs, sizeof(addrs), "wrong addresses");
+
+	/* Answers are cached by name and query type */
+	zassert_equal(cache_find(CACHE_NAME, DNS_QUERY_TYPE_AAAA, found,
+				 &status),
+		      -ENOENT);
+	zassert_equal(cache_find(OTHER_NAME, DNS_QUERY_TYPE_A, found, &status),
+		      -ENOENT);
+
+	dns_resolve_cache_flush();
+	zassert_equal(cache_find(CACHE_NAME, DNS_QUERY_TYPE_A, found, &status),
+		      -ENOENT, "flushed answer found");
+}
+
+ZTEST(dns_cache, test_cache_max_ttl)
+{
+	struct sockaddr found[ARRAY_SIZE(addrs)];
+	int status;
+
+	if (IS_ENABLED(CONFIG_DNS_RESOLVER_CACHE_PREFETCH)) {
+		ztest_test_skip();
+	}
+
+	dns_cache_update(CACHE_NAME, DNS_QUERY_TYPE_A, DNS_EAI_ALLDONE,
+			 addrs, 1, SERVER_TTL);
+
+	k_msleep(TTL_MS(CONFIG_DNS_RESOLVER_CACHE_MAX_TTL) - 100);
+	zassert_equal(cache_find(CACHE_NAME, DNS_QUERY_TYPE_A, found, &status),
+		      1, "answer expired early");
+
+	/* The time to live of the server is capped */
+	k_msleep(200);
+	zassert_equal(cache_find(CACHE_NAME, DNS_QUERY_TYPE_A, found, &status),
+		      -ENOENT, "answer kept past the maximum time to live");
+}
+
+ZTEST(dns_cache, test_cache_negative)
+{
+	struct sockaddr found[ARRAY_SIZE(addrs)];
+	int status;
+
+	/* Names that do not exist, or have no address, are cached */
+	dns_cache_update(CACHE_NAME, DNS_QUERY_TYPE_A, DNS_EAI_NONAME,
+			 NULL, 0, 0U);
+	dns_cache_update(CACHE_NAME, DNS_QUERY_TYPE_AAAA, DNS_EAI_NODATA,
+			 NULL, 0, 0U);
+
+	/* Other failures are not */
+	dns_cache_update(OTHER_NAME, DNS_QUERY_TYPE_A, DNS_EAI_FAIL,
+			 NULL, 0, 0U);
+	dns_cache_update(OTHER_NAME, DNS_QUERY_TYPE_AAAA, DNS_EAI_CANCELED,
+			 NULL, 0, 0U);
+
+	zassert_equal(cache_find(CACHE_NAME, DNS_QUERY_TYPE_A, found, &status),
+		      0);
+	zassert_equal(status, DNS_EAI_NONAME);
+	zassert_equal(cache_find(CACHE_NAME, DNS_QUERY_TYPE_AAAA, found,
+				 &status),
+		      0);
+	zassert_equal(status, DNS_EAI_NODATA);
+
+	zassert_equal(cache_find(OTHER_NAME, DNS_QUERY_TYPE_A, found, &status),
+		      -ENOENT, "server failure cached");
+	zassert_equal(cache_find(OTHER_NAME, DNS_QUERY_TYPE_AAAA, found,
+				 &status),
+		      -ENOENT, "cancelled query cached");
+
+	k_msleep(TTL_MS(CONFIG_DNS_RESOLVER_CACHE_NEGATIVE_TTL) + 100);
+	zassert_equal(cache_find(CACHE_NAME, DNS_QUERY_TYPE_A, found, &status),
+		      -ENOENT, "failure kept past the negative time to live");
+}
+
+ZTEST(dns_cache, test_cache_lru)
+{
+	struct sockaddr found[ARRAY_SIZE(addrs)];
+	int status;
+
+	BUILD_ASSERT(CONFIG_DNS_RESOLVER_CACHE_ENTRIES == 2,
+		     "the test fills a cache of two entries");
+
+	dns_cache_update(CACHE_NAME, DNS_QUERY_TYPE_A, DNS_EAI_ALLDONE,
+			 addrs, 1, SERVER_TTL);
+	dns_cache_update(OTHER_NAME, DNS_QUERY_TYPE_A, DNS_EAI_ALLDONE,
+			 addrs, 1, SERVER_TTL);
+
+	/* Using the first answer makes the second one the oldest */
+	zassert_equal(cache_find(CACHE_NAME, DNS_QUERY_TYPE_A, found, &status),
+		      1);
+
+	dns_cache_update(THIRD_NAME, DNS_QUERY_TYPE_A, DNS_EAI_ALLDONE,
+			 addrs, 1, SERVER_TTL);
+
+	zassert_equal(cache_find(OTHER_NAME, DNS_QUERY_TYPE_A, found, &status),
+		      -ENOENT, "least recently used answer kept");
+	zassert_equal(cache_find(CACHE_NAME, DNS_QUERY_TYPE_A, found, &status),
+		      1);
+	zassert_equal(cache_find(THIRD_NAME, DNS_QUERY_TYPE_A, found, &status),
+		      1);
+}
+
+ZTEST(dns_cache, test_cache_prefetch)
+{
+	struct sockaddr found[ARRAY_SIZE(addrs)];
+	const char *prefetch = NULL;
+	int status;
+
+	if (!IS_ENABLED(CONFIG_DNS_RESOLVER_CACHE_PREFETCH)) {
+		ztest_test_skip();
+	}
+
+	dns_cache_update(CACHE_NAME, DNS_QUERY_TYPE_A, DNS_EAI_ALLDONE,
+			 addrs, 1, SERVER_TTL);
+
+	zassert_equal(dns_cache_find(CACHE_NAME, DNS_QUERY_TYPE_A, found, 1,
+				     &status, &prefetch),
+		      1);
+	zassert_is_null(prefetch, "fresh answer refreshed");
+
+	/* Within the last tenth of the time to live, the answer is still
+	 * returned and refreshed once.
+	 */
+	k_msleep(TTL_MS(CONFIG_DNS_RESOLVER_CACHE_MAX_TTL) * 95 / 100);
+
+	zassert_equal(dns_cache_find(CACHE_NAME, DNS_QUERY_TYPE_A, found, 1,
+				     &status, &prefetch),
+		      1);
+	zassert_not_null(prefetch, "answer not refreshed");
+	zassert_equal(strcmp(prefetch, CACHE_NAME), 0);
+
+	prefetch = NULL;
+	zassert_equal(dns_cache_find(CACHE_NAME, DNS_QUERY_TYPE_A, found, 1,
+				     &status, &prefetch),
+		      1);
+	zassert_is_null(prefetch, "answer refreshed twice");
+
+	/* The refreshed answer gets a new time to live */
+	dns_cache_update(CACHE_NAME, DNS_QUERY_TYPE_A, DNS_EAI_ALLDONE,
+			 &addrs[1], 1, SERVER_TTL);
+
+	k_msleep(200);
+	zassert_equal(dns_cache_find(CACHE_NAME, DNS_QUERY_TYPE_A, found, 1,
+				     &status, &prefetch),
+		      1, "refreshed answer expired");
+	zassert_mem_equal(&found[0], &addrs[1], sizeof(addrs[1]),
+			  "answer not refreshed");
+	zassert_is_null(prefetch);
+}
+
+static int resolved;
+static int resolved_status;
+
+static void cache_resolve_cb(enum dns_resolve_status status,
+			     struct dns_addrinfo *info, void *user_data)
+{
+	if (status == DNS_EAI_INPROGRESS) {
+		zassert_mem_equal(&info->ai_addr, &addrs[resolved],
+				  sizeof(struct sockaddr), "wrong address");
+		zassert_equal(info->ai_addrlen, sizeof(struct sockaddr_in));
+		resolved++;
+	} else {
+		resolved_status = status;
+	}
+}
+
+ZTEST(dns_cache, test_cache_resolve)
+{
+	uint16_t dns_id;
+
+	dns_cache_update(CACHE_NAME, DNS_QUERY_TYPE_A, DNS_EAI_ALLDONE,
+			 addrs, ARRAY_SIZE(addrs), SERVER_TTL);
+	dns_cache_update(OTHER_NAME, DNS_QUERY_TYPE_A, DNS_EAI_NONAME,
+			 NULL, 0, 0U);
+
+	/* Cached answers are given before the resolution call returns,
+	 * without any query.
+	 */
+	resolved = 0;
+	resolved_status = 0;
+	zassert_ok(dns_get_addr_info(CACHE_NAME, DNS_QUERY_TYPE_A, &dns_id,
+				     cache_resolve_cb, NULL, 500));
+	zassert_equal(resolved, ARRAY_SIZE(addrs));
+	zassert_equal(resolved_status, DNS_EAI_ALLDONE);
+
+	resolved = 0;
+	resolved_status = 0;
+	zassert_ok(dns_get_addr_info(OTHER_NAME, DNS_QUERY_TYPE_A, &dns_id,
+				     cache_resolve_cb, NULL, 500));
+	zassert_equal(resolved, 0);
+	zassert_equal(resolved_status, DNS_EAI_NONAME);
+}
+
+ZTEST_SUITE(dns_cache, NULL, cache_setup, cache_before, NULL, NULL);
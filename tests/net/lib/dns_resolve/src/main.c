@@ -432,17 +432,19 @@ ZTEST(dns_resolve, test_dns_query_ipv6_server_count)
 ZTEST(dns_resolve, test_dns_query_too_many)
 {
 	int expected_status = DNS_EAI_CANCELED;
-	int ret;
+	int ret, i;
 
 	timeout_query = true;
 
-	ret = dns_get_addr_info(NAME4,
-				DNS_QUERY_TYPE_A,
-				NULL,
-				dns_result_cb_timeout,
-				INT_TO_POINTER(expected_status),
-				DNS_TIMEOUT);
-	zassert_equal(ret, 0, "Cannot create IPv4 query");
+	for (i = 0; i < CONFIG_DNS_NUM_CONCUR_QUERIES; i++) {
+		ret = dns_get_addr_info(NAME4,
+					DNS_QUERY_TYPE_A,
+					NULL,
+					dns_result_cb_timeout,
+					INT_TO_POINTER(expected_status),
+					DNS_TIMEOUT);
+		zassert_equal(ret, 0, "Cannot create IPv4 query");
+	}
 
 	ret = dns_get_addr_info(NAME4,
 				DNS_QUERY_TYPE_A,
@@ -452,8 +454,10 @@ ZTEST(dns_resolve, test_dns_query_too_many)
 				DNS_TIMEOUT);
 	zassert_equal(ret, -EAGAIN, "Should have run out of space");
 
-	if (k_sem_take(&wait_data, WAIT_TIME)) {
-		zassert_true(false, "Timeout while waiting data");
+	for (i = 0; i < CONFIG_DNS_NUM_CONCUR_QUERIES; i++) {
+		if (k_sem_take(&wait_data, WAIT_TIME)) {
+			zassert_true(false, "Timeout while waiting data");
+		}
 	}
 
 	timeout_query = false;
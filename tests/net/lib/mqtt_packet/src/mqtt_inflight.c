@@ -0,0 +1,263 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/net/mqtt.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/ztest.h>
+
+#include "mqtt_transport.h"
+
+#define BUFFER_SIZE 128
+#define CAPTURE_SIZE 512
+
+#define TOPIC MQTT_UTF8_LITERAL("sensors")
+#define PAYLOAD "21.5"
+
+static uint8_t rx_buffer[BUFFER_SIZE];
+static uint8_t tx_buffer[BUFFER_SIZE];
+static struct mqtt_client client;
+
+/* Custom transport recording what is written, and reading what the test
+ * queued as sent by the broker.
+ */
+static int write_count;
+static uint8_t written[CAPTURE_SIZE];
+static size_t written_len;
+static uint8_t to_read[8];
+static size_t to_read_len;
+
+static void capture(const void *data, size_t len)
+{
+	zassert_true(written_len + len <= sizeof(written), "capture full");
+	memcpy(written + written_len, data, len);
+	written_len += len;
+}
+
+int mqtt_client_custom_transport_connect(struct mqtt_client *client)
+{
+	return 0;
+}
+
+int mqtt_client_custom_transport_write(struct mqtt_client *client,
+				       const uint8_t *data, uint32_t datalen)
+{
+	write_count++;
+	capture(data, datalen);
+
+	return 0;
+}
+
+int mqtt_client_custom_transport_write_msg(struct mqtt_client *client,
+					   const struct msghdr *message)
+{
+	write_count++;
+
+	for (size_t i = 0; i < message->msg_iovlen; i++) {
+		capture(message->msg_iov[i].iov_base,
+			message->msg_iov[i].iov_len);
+	}
+
+	return 0;
+}
+
+int mqtt_client_custom_transport_read(struct mqtt_client *client,
+				      uint8_t *data, uint32_t buflen,
+				      bool shall_block)
+{
+	size_t len = MIN(buflen, to_read_len);
+
+	if (len == 0) {
+		return -EAGAIN;
+	}
+
+	memcpy(data, to_read, len);
+	memmove(to_read, to_read + len, to_read_len - len);
+	to_read_len -= len;
+
+	return len;
+}
+
+int mqtt_client_custom_transport_disconnect(struct mqtt_client *client)
+{
+	return 0;
+}
+
+static void evt_handler(struct mqtt_client *const client,
+			const struct mqtt_evt *evt)
+{
+}
+
+/* Feeds a 4 bytes packet from the broker to the client */
+static void broker_send(uint8_t type, uint16_t id)
+{
+	to_read[0] = type;
+	to_read[1] = 0x02;
+	sys_put_be16(id, &to_read[2]);
+	to_read_len = 4;
+
+	zassert_ok(mqtt_input(&client), "input failed");
+	zassert_equal(to_read_len, 0, "packet not read");
+}
+
+#define PUBACK(id) broker_send(0x40, id)
+#define PUBCOMP(id) broker_send(0x70, id)
+
+static void publish_param(struct mqtt_publish_param *param, uint8_t qos,
+			  uint16_t id)
+{
+	memset(param, 0, sizeof(*param));
+	param->message.topic.topic = TOPIC;
+	param->message.topic.qos = qos;
+	param->message.payload.data = PAYLOAD;
+	param->message.payload.len = strlen(PAYLOAD);
+	param->message_id = id;
+}
+
+static int publish(uint8_t qos, uint16_t id)
+{
+	struct mqtt_publish_param param;
+
+	publish_param(&param, qos, id);
+
+	return mqtt_publish(&client, &param);
+}
+
+static void inflight_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	mqtt_client_init(&client);
+	client.client_id = (struct mqtt_utf8)MQTT_UTF8_LITERAL("zephyr");
+	client.evt_cb = evt_handler;
+	client.rx_buf = rx_buffer;
+	client.rx_buf_size = sizeof(rx_buffer);
+	client.tx_buf = tx_buffer;
+	client.tx_buf_size = sizeof(tx_buffer);
+	client.transport.type = MQTT_TRANSPORT_CUSTOM;
+
+	zassert_ok(mqtt_connect(&client), "connect failed");
+	/* CONNACK, connection accepted */
+	broker_send(0x20, 0x0000);
+
+	write_count = 0;
+	written_len = 0;
+}
+
+static void inflight_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	(void)mqtt_abort(&client);
+}
+
+ZTEST(mqtt_inflight, test_inflight_window)
+{
+	struct mqtt_publish_param param;
+
+	zassert_ok(publish(MQTT_QOS_1_AT_LEAST_ONCE, 1));
+	zassert_ok(publish(MQTT_QOS_2_EXACTLY_ONCE, 2));
+	zassert_equal(publish(MQTT_QOS_1_AT_LEAST_ONCE, 3), -EAGAIN,
+		      "window of %d messages exceeded",
+		      CONFIG_MQTT_MAX_INFLIGHT);
+	zassert_equal(write_count, 2, "rejected message written");
+
+	/* QoS 0 messages and retransmissions take no slot */
+	zassert_ok(publish(MQTT_QOS_0_AT_MOST_ONCE, 0));
+	publish_param(&param, MQTT_QOS_1_AT_LEAST_ONCE, 1);
+	param.dup_flag = 1U;
+	zassert_ok(mqtt_publish(&client, &param));
+
+	/* PUBACK and PUBCOMP release a slot each */
+	PUBACK(1);
+	zassert_ok(publish(MQTT_QOS_1_AT_LEAST_ONCE, 3));
+	zassert_equal(publish(MQTT_QOS_1_AT_LEAST_ONCE, 4), -EAGAIN);
+
+	PUBCOMP(2);
+	zassert_ok(publish(MQTT_QOS_1_AT_LEAST_ONCE, 4));
+	zassert_equal(write_count, 6);
+}
+
+ZTEST(mqtt_inflight, test_publish_batch)
+{
+	struct mqtt_publish_param params[4];
+	uint8_t expected[CAPTURE_SIZE];
+	size_t expected_len;
+
+	for (int i = 0; i < ARRAY_SIZE(params); i++) {
+		publish_param(&params[i], i % 2, i + 1);
+	}
+
+	/* Messages published one by one */
+	for (int i = 0; i < ARRAY_SIZE(params); i++) {
+		zassert_ok(mqtt_publish(&client, &params[i]));
+	}
+
+	PUBACK(2);
+	PUBACK(4);
+
+	memcpy(expected, written, written_len);
+	expected_len = written_len;
+	write_count = 0;
+	written_len = 0;
+
+	/* The same bytes go in a single write in a batch */
+	zassert_equal(mqtt_publish_batch(&client, params, ARRAY_SIZE(params)),
+		      ARRAY_SIZE(params));
+	zassert_equal(write_count, 1, "%d writes", write_count);
+	zassert_equal(written_len, expected_len);
+	zassert_mem_equal(written, expected, expected_len, "wrong batch");
+}
+
+ZTEST(mqtt_inflight, test_publish_batch_window)
+{
+	struct mqtt_publish_param params[3];
+
+	for (int i = 0; i < ARRAY_SIZE(params); i++) {
+		publish_param(&params[i], MQTT_QOS_1_AT_LEAST_ONCE, i + 1);
+	}
+
+	/* Only the messages fitting in the window are sent */
+	zassert_equal(mqtt_publish_batch(&client, params, ARRAY_SIZE(params)),
+		      CONFIG_MQTT_MAX_INFLIGHT);
+	zassert_equal(write_count, 1);
+
+	zassert_equal(mqtt_publish_batch(&client, &params[2], 1), -EAGAIN);
+	zassert_equal(write_count, 1);
+
+	PUBACK(1);
+	zassert_equal(mqtt_publish_batch(&client, &params[2], 1), 1);
+	zassert_equal(write_count, 2);
+}
+
+ZTEST(mqtt_inflight, test_publish_batch_split)
+{
+	struct mqtt_publish_param params[CONFIG_MQTT_PUBLISH_BATCH_MAX + 2];
+
+	for (int i = 0; i < ARRAY_SIZE(params); i++) {
+		publish_param(&params[i], MQTT_QOS_0_AT_MOST_ONCE, 0);
+	}
+
+	/* Batches larger than CONFIG_MQTT_PUBLISH_BATCH_MAX take more writes */
+	zassert_equal(mqtt_publish_batch(&client, params, ARRAY_SIZE(params)),
+		      ARRAY_SIZE(params));
+	zassert_equal(write_count, 2, "%d writes", write_count);
+}
+
+ZTEST(mqtt_inflight, test_publish_batch_not_connected)
+{
+	struct mqtt_publish_param param;
+
+	publish_param(&param, MQTT_QOS_1_AT_LEAST_ONCE, 1);
+
+	(void)mqtt_abort(&client);
+
+	zassert_equal(mqtt_publish_batch(&client, &param, 1), -ENOTCONN);
+	zassert_equal(write_count, 0);
+}
+
+ZTEST_SUITE(mqtt_inflight, NULL, NULL, inflight_before, inflight_after,
+	    NULL);
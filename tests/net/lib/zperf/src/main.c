@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/shell/shell_dummy.h>
+#include <zephyr/ztest.h>
+
+#include "zperf_session.h"
+
+#define ZPERF_PORT "5001"
+
+/* Run a command with the dummy backend and return its output */
+static const char *zperf_cmd(const char *cmd, int *ret)
+{
+	const struct shell *sh = shell_backend_dummy_get_ptr();
+	size_t size;
+
+	shell_backend_dummy_clear_output(sh);
+	*ret = shell_execute_cmd(sh, cmd);
+
+	return shell_backend_dummy_get_output(sh, &size);
+}
+
+static int count_matches(const char *output, const char *str)
+{
+	int count = 0;
+
+	while ((output = strstr(output, str)) != NULL) {
+		output += strlen(str);
+		count++;
+	}
+
+	return count;
+}
+
+ZTEST(zperf, test_histogram_empty)
+{
+	struct zperf_histogram hist = { 0 };
+
+	zassert_equal(zperf_histogram_percentile(&hist, 500), 0);
+	zassert_equal(zperf_histogram_percentile(&hist, 999), 0);
+}
+
+ZTEST(zperf, test_histogram_linear)
+{
+	struct zperf_histogram hist = { 0 };
+	uint32_t i;
+
+	/* Small values have a bucket each, their percentiles are exact */
+	for (i = 1; i <= 10; i++) {
+		zperf_histogram_add(&hist, i);
+	}
+
+	zassert_equal(hist.count, 10);
+	zassert_equal(hist.max, 10);
+	zassert_equal(zperf_histogram_percentile(&hist, 500), 5);
+	zassert_equal(zperf_histogram_percentile(&hist, 900), 9);
+	zassert_equal(zperf_histogram_percentile(&hist, 1000), 10);
+}
+
+ZTEST(zperf, test_histogram_buckets)
+{
+	struct zperf_histogram hist = { 0 };
+	uint32_t i;
+
+	for (i = 0; i < 99; i++) {
+		zperf_histogram_add(&hist, 100);
+	}
+
+	zperf_histogram_add(&hist, 1000);
+
+	/* 100 is counted in the 96..111 bucket, the percentile being the
+	 * highest value of the bucket, but never more than the maximum.
+	 */
+	zassert_equal(zperf_histogram_percentile(&hist, 500), 111);
+	zassert_equal(zperf_histogram_percentile(&hist, 990), 111);
+	zassert_equal(zperf_histogram_percentile(&hist, 999), 1000);
+	zassert_equal(hist.max, 1000);
+}
+
+ZTEST(zperf, test_histogram_overflow)
+{
+	struct zperf_histogram hist = { 0 };
+
+	/* The values above the last bucket are reported as the maximum */
+	zperf_histogram_add(&hist, 1);
+	zperf_histogram_add(&hist, BIT(ZPERF_HIST_MAX_BITS) + 12345);
+
+	zassert_equal(zperf_histogram_percentile(&hist, 500), 1);
+	zassert_equal(zperf_histogram_percentile(&hist, 990),
+		      BIT(ZPERF_HIST_MAX_BITS) + 12345);
+}
+
+ZTEST(zperf, test_upload_options)
+{
+	const char *output;
+	int ret;
+
+	output = zperf_cmd("zperf udp upload -P 0 127.0.0.1", &ret);
+	zassert_equal(ret, -ENOEXEC);
+	zassert_not_null(strstr(output, "Number of streams must be between"));
+
+	output = zperf_cmd("zperf udp upload -P 3 127.0.0.1", &ret);
+	zassert_equal(ret, -ENOEXEC);
+	zassert_not_null(strstr(output, "Number of streams must be between"));
+
+	output = zperf_cmd("zperf udp upload -x 1 127.0.0.1", &ret);
+	zassert_equal(ret, -ENOEXEC);
+	zassert_not_null(strstr(output, "Unknown option -x"));
+
+	output = zperf_cmd("zperf tcp upload -P", &ret);
+	zassert_equal(ret, -ENOEXEC);
+	zassert_not_null(strstr(output, "Missing value of option -P"));
+
+	if (!IS_ENABLED(CONFIG_SCHED_CPU_MASK)) {
+		output = zperf_cmd("zperf udp upload -a 0 127.0.0.1", &ret);
+		zassert_equal(ret, -ENOEXEC);
+		zassert_not_null(strstr(output, "CONFIG_SCHED_CPU_MASK"));
+	}
+}
+
+ZTEST(zperf, test_udp_upload_streams)
+{
+	const struct shell *sh = shell_backend_dummy_get_ptr();
+	const char *output;
+	size_t size;
+	int ret;
+
+	output = zperf_cmd("zperf udp download -j " ZPERF_PORT, &ret);
+	zassert_ok(ret, "Cannot start the UDP server (%s)", output);
+
+	shell_backend_dummy_clear_output(sh);
+
+	ret = shell_execute_cmd(sh, "zperf udp upload -P 2 -j 127.0.0.1 "
+				ZPERF_PORT " 1 64 100K");
+
+	/* Let the server print the results of both sessions */
+	k_msleep(500);
+
+	output = shell_backend_dummy_get_output(sh, &size);
+	zassert_ok(ret, "Upload failed (%s)", output);
+
+	zassert_not_null(strstr(output, "Streams:\t2"), "%s", output);
+
+	/* The results of each stream and their sum */
+	zassert_equal(count_matches(output, "{\"stream\":0"), 1,
+		      "%s", output);
+	zassert_equal(count_matches(output, "{\"stream\":1"), 1,
+		      "%s", output);
+	zassert_equal(count_matches(output, "{\"stream\":\"sum\""), 1,
+		      "%s", output);
+
+	/* The server sees one session per stream, with the delay
+	 * percentiles of the datagrams.
+	 */
+	zassert_equal(count_matches(output, "\"delay_us\":{\"p50\":"), 2,
+		      "%s", output);
+	zassert_equal(count_matches(output, " delay (us):\tp50 "), 2,
+		      "%s", output);
+}
+
+ZTEST_SUITE(zperf, NULL, NULL, NULL, NULL, NULL);
@@ -234,6 +234,47 @@ static int test_synchronous_event_listener(uint32_t times, bool on_iface)
 	return TC_PASS;
 }
 
+static int test_direct_event_listener(void)
+{
+	struct net_mgmt_event_callback direct_cb;
+
+	TC_PRINT("- Direct event listener\n");
+
+	/* Let the thrower be done with the previous test */
+	while (throw_times) {
+		k_msleep(THREAD_SLEEP);
+	}
+
+	with_info = true;
+	info_length_in_test = TEST_MGMT_EVENT_INFO_SIZE;
+	memcpy(info_data, info_string, strlen(info_string) + 1);
+
+	net_mgmt_init_event_callback(&direct_cb, receiver_cb,
+				     TEST_MGMT_EVENT);
+	net_mgmt_add_event_callback_direct(&direct_cb);
+
+	/* The callback must have run before the notify call returns */
+	net_mgmt_event_notify_with_info(TEST_MGMT_EVENT,
+					net_if_get_first_by_type(
+						&NET_L2_GET_NAME(DUMMY)),
+					info_data, TEST_MGMT_EVENT_INFO_SIZE);
+
+	zassert_equal(rx_event, TEST_MGMT_EVENT, "rx_event check failed");
+	zassert_equal(rx_calls, 1, "rx_calls check failed");
+
+	net_mgmt_del_event_callback(&direct_cb);
+
+	net_mgmt_event_notify(TEST_MGMT_EVENT,
+			      net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY)));
+
+	zassert_equal(rx_calls, 1, "deleted callback was called");
+
+	rx_event = rx_calls = 0U;
+	with_info = false;
+
+	return TC_PASS;
+}
+
 static void initialize_event_tests(void)
 {
 	event2throw = 0U;
@@ -352,6 +393,9 @@ ZTEST(mgmt_fn_test_suite, test_mgmt)
 
 	zassert_false(test_synchronous_event_listener(2, true),
 		      "test_synchronous_event_listener failed");
+
+	zassert_false(test_direct_event_listener(),
+		      "test_direct_event_listener failed");
 }
 
 ZTEST_SUITE(mgmt_fn_test_suite, NULL, NULL, NULL, NULL, NULL);
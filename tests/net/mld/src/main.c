@@ -550,4 +550,50 @@ ZTEST(net_mld_test_suite, test_verify_join_leave)
 	test_verify_send_report();
 }
 
+ZTEST(net_mld_test_suite, test_source_filter)
+{
+	struct net_addr sources[] = {
+		{ .family = AF_INET6, .in6_addr = peer_addr },
+	};
+	struct net_if_mcast_addr *ifmaddr;
+	int ret;
+
+	ignore_already = true;
+	test_join_group();
+
+	ifmaddr = net_if_ipv6_maddr_lookup(&mcast_addr, &iface);
+	zassert_not_null(ifmaddr, "Multicast group not found");
+
+	/* Any source is allowed by default */
+	zassert_true(net_if_mcast_source_is_allowed(ifmaddr, &peer_addr),
+		     "Source filtered");
+	zassert_true(net_if_mcast_source_is_allowed(ifmaddr, &my_addr),
+		     "Source filtered");
+
+	ret = net_ipv6_mld_set_sources(iface, &mcast_addr, true, sources,
+				       ARRAY_SIZE(sources));
+	zassert_equal(ret, 0, "Cannot set the sources (%d)", ret);
+
+	zassert_true(net_if_mcast_source_is_allowed(ifmaddr, &peer_addr),
+		     "Included source filtered");
+	zassert_false(net_if_mcast_source_is_allowed(ifmaddr, &my_addr),
+		      "Source not filtered");
+
+	ret = net_ipv6_mld_set_sources(iface, &mcast_addr, false, sources,
+				       ARRAY_SIZE(sources));
+	zassert_equal(ret, 0, "Cannot set the sources (%d)", ret);
+
+	zassert_false(net_if_mcast_source_is_allowed(ifmaddr, &peer_addr),
+		      "Excluded source not filtered");
+	zassert_true(net_if_mcast_source_is_allowed(ifmaddr, &my_addr),
+		     "Source filtered");
+
+	sources[0].family = AF_INET;
+	ret = net_ipv6_mld_set_sources(iface, &mcast_addr, true, sources,
+				       ARRAY_SIZE(sources));
+	zassert_equal(ret, -EINVAL, "Source of another family accepted");
+
+	test_leave_group();
+}
+
 ZTEST_SUITE(net_mld_test_suite, NULL, test_mld_setup, NULL, NULL, NULL);
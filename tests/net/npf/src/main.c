@@ -314,4 +314,89 @@ ZTEST(net_pkt_filter_test_suite, test_npf_address_mask)
 	test_npf_eth_mac_addr_mask();
 }
 
+#if defined(CONFIG_NET_PKT_FILTER_BPF)
+/*
+ * Example 1 in NPF_RULE() documentation, as a BPF program.
+ */
+
+static const struct sock_filter small_ip_prog[] = {
+	BPF_STMT(BPF_LD | BPF_H | BPF_ABS, 12),
+	BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, NET_ETH_PTYPE_IP, 0, 3),
+	BPF_STMT(BPF_LD | BPF_W | BPF_LEN, 0),
+	BPF_JUMP(BPF_JMP | BPF_JGT | BPF_K, 200, 1, 0),
+	BPF_STMT(BPF_RET | BPF_K, UINT32_MAX),
+	BPF_STMT(BPF_RET | BPF_K, 0),
+};
+
+static NPF_BPF_MATCH(small_ip_bpf, small_ip_prog);
+
+static NPF_RULE(small_ip_pkt_bpf, NET_OK, small_ip_bpf);
+
+ZTEST(net_pkt_filter_test_suite, test_npf_bpf_example1)
+{
+	/* install filter rules */
+	npf_insert_recv_rule(&npf_default_drop);
+	npf_insert_recv_rule(&small_ip_pkt_bpf);
+
+	test_npf_example_common();
+
+	/* remove filter rules */
+	zassert_true(npf_remove_recv_rule(&npf_default_drop), "");
+	zassert_true(npf_remove_recv_rule(&small_ip_pkt_bpf), "");
+}
+
+ZTEST(net_pkt_filter_test_suite, test_npf_bpf_buf)
+{
+	struct net_eth_hdr eth_hdr = {
+		.src = ETH_SRC_ADDR,
+		.dst = ETH_DST_ADDR,
+		.type = htons(NET_ETH_PTYPE_IP),
+	};
+	uint8_t frame[100] = { 0 };
+
+	memcpy(frame, &eth_hdr, sizeof(eth_hdr));
+	zassert_equal(npf_bpf_run_buf(small_ip_prog, frame, sizeof(frame)),
+		      UINT32_MAX, "");
+
+	/* Loads past the end reject the frame */
+	zassert_equal(npf_bpf_run_buf(small_ip_prog, frame, 13), 0, "");
+
+	eth_hdr.type = htons(NET_ETH_PTYPE_ARP);
+	memcpy(frame, &eth_hdr, sizeof(eth_hdr));
+	zassert_equal(npf_bpf_run_buf(small_ip_prog, frame, sizeof(frame)),
+		      0, "");
+}
+
+ZTEST(net_pkt_filter_test_suite, test_npf_bpf_check)
+{
+	const struct sock_filter out_of_range[] = {
+		BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0, 1, 0),
+		BPF_STMT(BPF_RET | BPF_K, 0),
+	};
+	const struct sock_filter no_return[] = {
+		BPF_STMT(BPF_LD | BPF_W | BPF_LEN, 0),
+	};
+	const struct sock_filter div_by_zero[] = {
+		BPF_STMT(BPF_ALU | BPF_DIV | BPF_K, 0),
+		BPF_STMT(BPF_RET | BPF_A, 0),
+	};
+	const struct sock_filter bad_mem[] = {
+		BPF_STMT(BPF_ST, BPF_MEMWORDS),
+		BPF_STMT(BPF_RET | BPF_K, 0),
+	};
+
+	zassert_equal(npf_bpf_check(small_ip_prog, ARRAY_SIZE(small_ip_prog)),
+		      0, "");
+	zassert_equal(npf_bpf_check(small_ip_prog, 0), -EINVAL, "");
+	zassert_equal(npf_bpf_check(out_of_range, ARRAY_SIZE(out_of_range)),
+		      -EINVAL, "");
+	zassert_equal(npf_bpf_check(no_return, ARRAY_SIZE(no_return)),
+		      -EINVAL, "");
+	zassert_equal(npf_bpf_check(div_by_zero, ARRAY_SIZE(div_by_zero)),
+		      -EINVAL, "");
+	zassert_equal(npf_bpf_check(bad_mem, ARRAY_SIZE(bad_mem)),
+		      -EINVAL, "");
+}
+#endif /* CONFIG_NET_PKT_FILTER_BPF */
+
 ZTEST_SUITE(net_pkt_filter_test_suite, NULL, test_npf_iface, NULL, NULL, NULL);
@@ -88,6 +88,12 @@ static bool feed_data; /* feed data back to IP stack */
 
 static int msg_sending;
 
+/* Interface and link layer source address of the last packet sent on
+ * my_iface when it was not fed back to the stack.
+ */
+static struct net_if *sent_iface;
+static uint8_t *sent_lladdr_src;
+
 K_SEM_DEFINE(wait_data, 0, UINT_MAX);
 
 #define WAIT_TIME K_MSEC(250)
@@ -161,6 +167,9 @@ static int tester_send(const struct device *dev, struct net_pkt *pkt)
 		test_failed = true;
 	}
 
+	sent_iface = net_pkt_iface(pkt);
+	sent_lladdr_src = net_pkt_lladdr_src(pkt)->addr;
+
 	msg_sending = 0;
 out:
 	k_sem_give(&wait_data);
@@ -544,6 +553,75 @@ static void test_route_preference(void)
 	net_route_del(entry);
 }
 
+static struct net_pkt *create_forwarded_pkt(void)
+{
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_alloc_with_buffer(peer_iface, 0, AF_INET6,
+					NET_IPV6_NEXTHDR_NONE, K_FOREVER);
+	zassert_not_null(pkt, "Cannot allocate packet");
+
+	zassert_ok(net_ipv6_create(pkt, &generic_addr, &dest_addr),
+		   "Cannot create IPv6 header");
+
+	net_pkt_cursor_init(pkt);
+	zassert_ok(net_ipv6_finalize(pkt, NET_IPV6_NEXTHDR_NONE),
+		   "Cannot finalize IPv6 header");
+
+	/* The packet was received from a host behind peer_iface */
+	net_pkt_lladdr_src(pkt)->addr = net_route_data_peer.mac_addr;
+	net_pkt_lladdr_src(pkt)->len = sizeof(struct net_eth_addr);
+
+	return pkt;
+}
+
+static void test_route_flow_forward(void)
+{
+	struct net_linkaddr *my_lladdr = net_if_get_link_addr(my_iface);
+	struct net_pkt *pkt;
+
+	if (!IS_ENABLED(CONFIG_NET_ROUTE_FLOW_CACHE)) {
+		return;
+	}
+
+	entry = net_route_add(my_iface,
+			      &dest_addr, 128,
+			      &peer_addr,
+			      NET_IPV6_ND_INFINITE_LIFETIME,
+			      NET_ROUTE_PREFERENCE_LOW);
+	zassert_not_null(entry, "Route add failed");
+
+	feed_data = false;
+
+	/* Nothing is known about the flow until the slow path forwarded it */
+	pkt = create_forwarded_pkt();
+	zassert_equal(net_route_flow_packet(pkt, &dest_addr), -ENOENT,
+		      "Unknown flow forwarded");
+
+	/* Slow path, as done by the IPv6 input when the route is found */
+	net_pkt_set_orig_iface(pkt, peer_iface);
+	net_pkt_set_iface(pkt, my_iface);
+
+	sent_iface = NULL;
+	zassert_ok(net_route_packet(pkt, &peer_addr), "Route packet failed");
+	zassert_ok(k_sem_take(&wait_data, WAIT_TIME), "Packet not sent");
+	zassert_equal_ptr(sent_iface, my_iface, "Sent on wrong interface");
+	zassert_mem_equal(sent_lladdr_src, my_lladdr->addr, my_lladdr->len,
+			  "Wrong link layer source address");
+
+	/* Fast path, the packet is still on its ingress interface */
+	pkt = create_forwarded_pkt();
+
+	sent_iface = NULL;
+	zassert_ok(net_route_flow_packet(pkt, &dest_addr),
+		   "Flow not forwarded");
+	zassert_ok(k_sem_take(&wait_data, WAIT_TIME), "Packet not sent");
+	zassert_equal_ptr(sent_iface, my_iface, "Sent on wrong interface");
+	zassert_mem_equal(sent_lladdr_src, my_lladdr->addr, my_lladdr->len,
+			  "Wrong link layer source address");
+
+	net_route_del(entry);
+}
 
 /*test case main entry*/
 ZTEST(route_test_suite, test_route)
@@ -566,6 +644,7 @@ ZTEST(route_test_suite, test_route)
 	test_route_del_many();
 	test_route_lifetime();
 	test_route_preference();
+	test_route_flow_forward();
 }
 
 ZTEST_SUITE(route_test_suite, NULL, NULL, NULL, NULL, NULL);
@@ -611,4 +611,143 @@ ZTEST(net_socket_tls, test_v6_dtls_sendmsg)
 			  (struct sockaddr *)&server_addr, sizeof(server_addr));
 }
 
+#define SESSION_HOSTNAME "server.example.com"
+
+/* Offset of the session ID length in a TLS 1.2 ClientHello record: record
+ * header, handshake header, client version and random.
+ */
+#define CLIENT_HELLO_SESSION_ID_LEN_OFFSET (5 + 4 + 2 + 32)
+
+static void test_config_session_cache(int c_sock, const char *hostname)
+{
+	sec_tag_t sec_tag_list[] = {
+		PSK_TAG
+	};
+	int cache = TLS_SESSION_CACHE_ENABLED;
+
+	zassert_equal(setsockopt(c_sock, SOL_TLS, TLS_SEC_TAG_LIST,
+				 sec_tag_list, sizeof(sec_tag_list)),
+		      0, "Failed to set PSK on client socket");
+	zassert_equal(setsockopt(c_sock, SOL_TLS, TLS_SESSION_CACHE,
+				 &cache, sizeof(cache)),
+		      0, "Failed to enable session cache");
+
+	if (hostname != NULL) {
+		zassert_equal(setsockopt(c_sock, SOL_TLS, TLS_HOSTNAME,
+					 hostname, strlen(hostname) + 1),
+			      0, "Failed to set hostname");
+	}
+}
+
+static void client_hello_entry(void *p1, void *p2, void *p3)
+{
+	int sock = POINTER_TO_INT(p1);
+	struct sockaddr *addr = p2;
+
+	/* The handshake fails when the server closes the connection */
+	(void)connect(sock, addr, sizeof(struct sockaddr_in));
+}
+
+/* Returns the length of the session ID in the ClientHello sent by a client
+ * with the given hostname to a plain TCP server, non-zero if the client
+ * offers to resume a session.
+ */
+static int client_hello_session_id_len(uint16_t port, const char *hostname)
+{
+	uint8_t hello[CLIENT_HELLO_SESSION_ID_LEN_OFFSET + 1];
+	int c_sock;
+	int s_sock;
+	int new_sock;
+	struct sockaddr_in c_saddr;
+	struct sockaddr_in s_saddr;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	int ret;
+
+	prepare_sock_tls_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, ANY_PORT,
+			    &c_sock, &c_saddr, IPPROTO_TLS_1_2);
+	prepare_sock_tcp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, port,
+			    &s_sock, &s_saddr);
+
+	test_config_session_cache(c_sock, hostname);
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	k_thread_create(&client_connect_thread, client_connect_stack,
+			K_THREAD_STACK_SIZEOF(client_connect_stack),
+			client_hello_entry, INT_TO_POINTER(c_sock), &s_saddr,
+			NULL, K_LOWEST_APPLICATION_THREAD_PRIO, 0, K_NO_WAIT);
+
+	test_accept(s_sock, &new_sock, &addr, &addrlen);
+
+	ret = recv(new_sock, hello, sizeof(hello), MSG_WAITALL);
+	zassert_equal(ret, sizeof(hello), "ClientHello not received");
+	zassert_equal(hello[0], 0x16, "Not a handshake record");
+	zassert_equal(hello[5], 0x01, "Not a ClientHello");
+
+	test_close(new_sock);
+	k_thread_join(&client_connect_thread, K_FOREVER);
+
+	test_close(s_sock);
+	test_close(c_sock);
+
+	return hello[CLIENT_HELLO_SESSION_ID_LEN_OFFSET];
+}
+
+ZTEST(net_socket_tls, test_session_resumption_hostname)
+{
+	int c_sock;
+	int s_sock;
+	int new_sock;
+	struct sockaddr_in c_saddr;
+	struct sockaddr_in s_saddr;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	int purge = 1;
+
+	if (!IS_ENABLED(CONFIG_MBEDTLS_KEY_EXCHANGE_RSA_ENABLED)) {
+		/* TLS_HOSTNAME requires X.509 certificate support */
+		ztest_test_skip();
+	}
+
+	prepare_sock_tls_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, ANY_PORT,
+			    &c_sock, &c_saddr, IPPROTO_TLS_1_2);
+	prepare_sock_tls_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT,
+			    &s_sock, &s_saddr, IPPROTO_TLS_1_2);
+
+	zassert_equal(setsockopt(c_sock, SOL_TLS, TLS_SESSION_CACHE_PURGE,
+				 &purge, sizeof(purge)),
+		      0, "Failed to purge session cache");
+
+	test_config_psk(s_sock, c_sock);
+	test_config_session_cache(c_sock, SESSION_HOSTNAME);
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	/* A full handshake stores the session of the client */
+	spawn_client_connect_thread(c_sock, (struct sockaddr *)&s_saddr);
+	test_accept(s_sock, &new_sock, &addr, &addrlen);
+	k_thread_join(&client_connect_thread, K_FOREVER);
+
+	test_close(new_sock);
+	test_close(s_sock);
+	test_close(c_sock);
+
+	/* The session is resumed with the same hostname at another peer
+	 * address, not with another hostname or without any.
+	 */
+	zassert_equal(client_hello_session_id_len(SERVER_PORT + 1,
+						  SESSION_HOSTNAME),
+		      32, "Session not resumed for the same hostname");
+	zassert_equal(client_hello_session_id_len(SERVER_PORT + 2,
+						  "other.example.com"),
+		      0, "Session resumed for another hostname");
+	zassert_equal(client_hello_session_id_len(SERVER_PORT + 3, NULL),
+		      0, "Session resumed without hostname");
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+
 ZTEST_SUITE(net_socket_tls, NULL, NULL, NULL, NULL, NULL);
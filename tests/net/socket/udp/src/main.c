@@ -1334,4 +1334,200 @@ ZTEST(net_socket_udp, test_23_v6_dgram_overflow)
 			    BUF_AND_SIZE(test_str_all_tx_bufs));
 }
 
+ZTEST(net_socket_udp, test_24_v4_recv_zc)
+{
+	int rv;
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct zsock_zc_buf zc;
+	struct net_buf *buf;
+	size_t offset, len = 0;
+
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, ANY_PORT,
+			    &client_sock, &client_addr);
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT,
+			    &server_sock, &server_addr);
+
+	rv = bind(server_sock, (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	rv = zsock_recv_zc(server_sock, &zc, MSG_DONTWAIT);
+	zassert_equal(rv, -1, "recv_zc succeeded");
+	zassert_equal(errno, EAGAIN, "incorrect errno value");
+
+	rv = sendto(client_sock, BUF_AND_SIZE(TEST_STR2), 0,
+		    (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(rv, STRLEN(TEST_STR2), "sendto failed");
+
+	rv = zsock_recv_zc(server_sock, &zc, 0);
+	zassert_equal(rv, STRLEN(TEST_STR2), "recv_zc failed");
+	zassert_equal(zc.len, STRLEN(TEST_STR2), "unexpected length");
+
+	/* Walk the lent fragments */
+	clear_buf(rx_buf);
+	for (buf = zc.buf, offset = zc.offset; buf; buf = buf->frags) {
+		memcpy(&rx_buf[len], buf->data + offset, buf->len - offset);
+		len += buf->len - offset;
+		offset = 0;
+	}
+
+	zassert_equal(len, STRLEN(TEST_STR2), "unexpected fragment length");
+	zassert_mem_equal(rx_buf, BUF_AND_SIZE(TEST_STR2), "wrong data");
+
+	zsock_recv_zc_release(server_sock, &zc);
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
+#define MMSG_COUNT 3
+
+ZTEST(net_socket_udp, test_25_v4_sendmmsg_recvmmsg)
+{
+	int rv;
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct sockaddr_in addrs[MMSG_COUNT + 1];
+	struct mmsghdr msgs[MMSG_COUNT + 1];
+	struct iovec iov[MMSG_COUNT + 1][2];
+	char bufs[MMSG_COUNT + 1][16];
+
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, ANY_PORT,
+			    &client_sock, &client_addr);
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT,
+			    &server_sock, &server_addr);
+
+	rv = bind(server_sock, (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	/* Gathered from two buffers: "test" + "The Zephyr..." */
+	memset(msgs, 0, sizeof(msgs));
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		iov[i][0].iov_base = TEST_STR_SMALL;
+		iov[i][0].iov_len = STRLEN(TEST_STR_SMALL);
+		iov[i][1].iov_base = TEST_STR2;
+		iov[i][1].iov_len = 2 * i;
+
+		msgs[i].msg_hdr.msg_name = &server_addr;
+		msgs[i].msg_hdr.msg_namelen = sizeof(server_addr);
+		msgs[i].msg_hdr.msg_iov = iov[i];
+		msgs[i].msg_hdr.msg_iovlen = 2;
+	}
+
+	rv = sendmmsg(client_sock, msgs, MMSG_COUNT, 0);
+	zassert_equal(rv, MMSG_COUNT, "sendmmsg failed");
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		zassert_equal(msgs[i].msg_len, STRLEN(TEST_STR_SMALL) + 2 * i,
+			      "unexpected sent length");
+	}
+
+	/* Scattered to two buffers, the last datagram truncated */
+	memset(msgs, 0, sizeof(msgs));
+	for (int i = 0; i < MMSG_COUNT + 1; i++) {
+		iov[i][0].iov_base = bufs[i];
+		iov[i][0].iov_len = 2;
+		iov[i][1].iov_base = &bufs[i][2];
+		iov[i][1].iov_len = STRLEN(TEST_STR_SMALL);
+
+		msgs[i].msg_hdr.msg_name = &addrs[i];
+		msgs[i].msg_hdr.msg_namelen = sizeof(addrs[i]);
+		msgs[i].msg_hdr.msg_iov = iov[i];
+		msgs[i].msg_hdr.msg_iovlen = 2;
+	}
+
+	/* Only the available datagrams are returned */
+	rv = recvmmsg(server_sock, msgs, MMSG_COUNT + 1, 0);
+	zassert_equal(rv, MMSG_COUNT, "recvmmsg failed");
+
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		size_t len = MIN(STRLEN(TEST_STR_SMALL) + 2 * i,
+				 STRLEN(TEST_STR_SMALL) + 2);
+
+		zassert_equal(msgs[i].msg_len, len, "unexpected length");
+		zassert_mem_equal(bufs[i], TEST_STR_SMALL,
+				  STRLEN(TEST_STR_SMALL), "wrong data");
+		zassert_mem_equal(&bufs[i][STRLEN(TEST_STR_SMALL)], TEST_STR2,
+				  len - STRLEN(TEST_STR_SMALL), "wrong data");
+		zassert_equal(msgs[i].msg_hdr.msg_flags,
+			      (i == 2) ? MSG_TRUNC : 0, "unexpected flags");
+		zassert_equal(msgs[i].msg_hdr.msg_namelen,
+			      sizeof(struct sockaddr_in), "unexpected addrlen");
+	}
+
+	rv = recvmmsg(server_sock, msgs, MMSG_COUNT, MSG_DONTWAIT);
+	zassert_equal(rv, -1, "recvmmsg succeeded");
+	zassert_equal(errno, EAGAIN, "incorrect errno value");
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
+ZTEST(net_socket_udp, test_26_v4_so_rcvbuf)
+{
+	int rv;
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	ssize_t sent, recved;
+	int optval = 1;
+
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, ANY_PORT,
+			    &client_sock, &client_addr);
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT,
+			    &server_sock, &server_addr);
+
+	rv = bind(server_sock, (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	/* Only one datagram fits in the receive buffer */
+	rv = setsockopt(server_sock, SOL_SOCKET, SO_RCVBUF, &optval,
+			sizeof(optval));
+	zassert_equal(rv, 0, "setsockopt failed (%d)", errno);
+
+	for (int i = 0; i < 2; i++) {
+		sent = sendto(client_sock, TEST_STR_SMALL,
+			      STRLEN(TEST_STR_SMALL), 0,
+			      (struct sockaddr *)&server_addr,
+			      sizeof(server_addr));
+		zassert_equal(sent, STRLEN(TEST_STR_SMALL), "sendto failed");
+	}
+
+	k_msleep(10);
+
+	clear_buf(rx_buf);
+	recved = recv(server_sock, rx_buf, sizeof(rx_buf), MSG_DONTWAIT);
+	zassert_equal(recved, STRLEN(TEST_STR_SMALL), "recv failed");
+	zassert_mem_equal(rx_buf, BUF_AND_SIZE(TEST_STR_SMALL), "wrong data");
+
+	/* The second datagram was dropped */
+	recved = recv(server_sock, rx_buf, sizeof(rx_buf), MSG_DONTWAIT);
+	zassert_equal(recved, -1, "recv succeeded");
+	zassert_equal(errno, EAGAIN, "incorrect errno value");
+
+	/* Reading the first one made room again */
+	sent = sendto(client_sock, TEST_STR_SMALL, STRLEN(TEST_STR_SMALL), 0,
+		      (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(sent, STRLEN(TEST_STR_SMALL), "sendto failed");
+
+	recved = recv(server_sock, rx_buf, sizeof(rx_buf), 0);
+	zassert_equal(recved, STRLEN(TEST_STR_SMALL), "recv failed");
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
 ZTEST_SUITE(net_socket_udp, NULL, NULL, NULL, NULL, NULL);
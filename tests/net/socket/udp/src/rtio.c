@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <zephyr/net/socket.h>
+#include <zephyr/net/socket_rtio.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/rtio/rtio_executor_concurrent.h>
+
+#include "../../socket_helpers.h"
+
+#define RTIO_SERVER_PORT 4343
+#define RTIO_CLIENT_PORT 4344
+
+#define STRLEN(buf) (sizeof(buf) - 1)
+
+#define TEST_STR "rtio"
+
+RTIO_EXECUTOR_CONCURRENT_DEFINE(sock_exec, 2);
+RTIO_DEFINE(sock_rtio, (struct rtio_executor *)&sock_exec, 4, 4);
+
+static int server_sock;
+static int client_sock;
+static struct zsock_rtio_iodev server_iodev;
+static struct zsock_rtio_iodev client_iodev;
+
+static void submit_rx(struct zsock_rtio_iodev *iodev, uint8_t *buf,
+		      size_t len, void *userdata)
+{
+	struct rtio_sqe *sqe = rtio_spsc_acquire(sock_rtio.sq);
+
+	zassert_not_null(sqe, "Submission queue full");
+	rtio_sqe_prep_read(sqe, &iodev->iodev, RTIO_PRIO_NORM, buf, len,
+			   userdata);
+	zassert_ok(rtio_submit(&sock_rtio, 0));
+}
+
+static void submit_tx(struct zsock_rtio_iodev *iodev, const char *str,
+		      void *userdata)
+{
+	struct rtio_sqe *sqe = rtio_spsc_acquire(sock_rtio.sq);
+
+	zassert_not_null(sqe, "Submission queue full");
+	rtio_sqe_prep_write(sqe, &iodev->iodev, RTIO_PRIO_NORM,
+			    (uint8_t *)str, strlen(str), userdata);
+	zassert_ok(rtio_submit(&sock_rtio, 0));
+}
+
+static void expect_cqe(void *userdata, int result)
+{
+	struct rtio_cqe *cqe = rtio_cqe_consume_block(&sock_rtio);
+
+	zassert_equal(cqe->userdata, userdata, "Unexpected completion");
+	zassert_equal(cqe->result, result, "Result %d, expected %d",
+		      cqe->result, result);
+
+	rtio_spsc_release(sock_rtio.cq);
+}
+
+static void expect_no_cqe(void)
+{
+	k_msleep(50);
+	zassert_is_null(rtio_cqe_consume(&sock_rtio), "Unexpected completion");
+}
+
+static void *rtio_setup(void)
+{
+	struct sockaddr_in server_addr;
+	struct sockaddr_in client_addr;
+	int ret;
+
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, RTIO_SERVER_PORT,
+			    &server_sock, &server_addr);
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, RTIO_CLIENT_PORT,
+			    &client_sock, &client_addr);
+
+	ret = bind(server_sock, (struct sockaddr *)&server_addr,
+		   sizeof(server_addr));
+	zassert_equal(ret, 0, "bind failed");
+	ret = bind(client_sock, (struct sockaddr *)&client_addr,
+		   sizeof(client_addr));
+	zassert_equal(ret, 0, "bind failed");
+
+	ret = connect(server_sock, (struct sockaddr *)&client_addr,
+		      sizeof(client_addr));
+	zassert_equal(ret, 0, "connect failed");
+	ret = connect(client_sock, (struct sockaddr *)&server_addr,
+		      sizeof(server_addr));
+	zassert_equal(ret, 0, "connect failed");
+
+	zassert_ok(zsock_rtio_iodev_init(&server_iodev, server_sock));
+	zassert_ok(zsock_rtio_iodev_init(&client_iodev, client_sock));
+
+	return NULL;
+}
+
+static void rtio_teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	(void)close(client_sock);
+	(void)close(server_sock);
+}
+
+ZTEST(net_socket_udp_rtio, test_rtio_tx_rx)
+{
+	uint8_t rx_buf[16] = { 0 };
+	int recved;
+
+	/* Sending does not block, it completes right away */
+	submit_tx(&client_iodev, TEST_STR, &client_iodev);
+	expect_cqe(&client_iodev, STRLEN(TEST_STR));
+
+	k_msleep(10);
+
+	/* So does receiving data already there */
+	submit_rx(&server_iodev, rx_buf, sizeof(rx_buf), &server_iodev);
+	expect_cqe(&server_iodev, STRLEN(TEST_STR));
+	zassert_mem_equal(rx_buf, TEST_STR, STRLEN(TEST_STR), "wrong data");
+
+	/* The other way around, through the plain socket API */
+	submit_tx(&server_iodev, TEST_STR, &server_iodev);
+	expect_cqe(&server_iodev, STRLEN(TEST_STR));
+
+	clear_buf(rx_buf);
+	recved = recv(client_sock, rx_buf, sizeof(rx_buf), 0);
+	zassert_equal(recved, STRLEN(TEST_STR), "recv failed");
+	zassert_mem_equal(rx_buf, TEST_STR, STRLEN(TEST_STR), "wrong data");
+}
+
+ZTEST(net_socket_udp_rtio, test_rtio_rx_pending)
+{
+	uint8_t rx_buf[16] = { 0 };
+	int sent;
+
+	/* Nothing to receive yet, the operation waits for data */
+	submit_rx(&server_iodev, rx_buf, sizeof(rx_buf), &server_iodev);
+	expect_no_cqe();
+
+	sent = send(client_sock, TEST_STR, STRLEN(TEST_STR), 0);
+	zassert_equal(sent, STRLEN(TEST_STR), "send failed");
+
+	expect_cqe(&server_iodev, STRLEN(TEST_STR));
+	zassert_mem_equal(rx_buf, TEST_STR, STRLEN(TEST_STR), "wrong data");
+}
+
+ZTEST(net_socket_udp_rtio, test_rtio_rx_pending_busy)
+{
+	uint8_t rx_buf[16] = { 0 };
+	uint8_t rx_buf2[16];
+	int sent;
+
+	submit_rx(&server_iodev, rx_buf, sizeof(rx_buf), rx_buf);
+	expect_no_cqe();
+
+	/* One operation at a time per socket */
+	submit_rx(&server_iodev, rx_buf2, sizeof(rx_buf2), rx_buf2);
+	expect_cqe(rx_buf2, -EWOULDBLOCK);
+
+	sent = send(client_sock, TEST_STR, STRLEN(TEST_STR), 0);
+	zassert_equal(sent, STRLEN(TEST_STR), "send failed");
+
+	expect_cqe(rx_buf, STRLEN(TEST_STR));
+	zassert_mem_equal(rx_buf, TEST_STR, STRLEN(TEST_STR), "wrong data");
+}
+
+ZTEST(net_socket_udp_rtio, test_rtio_rx_pending_several)
+{
+	uint8_t server_buf[16] = { 0 };
+	uint8_t client_buf[16] = { 0 };
+	int sent;
+
+	/* Both sockets are waited for by the same thread */
+	submit_rx(&server_iodev, server_buf, sizeof(server_buf), server_buf);
+	submit_rx(&client_iodev, client_buf, sizeof(client_buf), client_buf);
+	expect_no_cqe();
+
+	sent = send(server_sock, TEST_STR, STRLEN(TEST_STR), 0);
+	zassert_equal(sent, STRLEN(TEST_STR), "send failed");
+
+	expect_cqe(client_buf, STRLEN(TEST_STR));
+	zassert_mem_equal(client_buf, TEST_STR, STRLEN(TEST_STR),
+			  "wrong data");
+
+	sent = send(client_sock, TEST_STR, STRLEN(TEST_STR), 0);
+	zassert_equal(sent, STRLEN(TEST_STR), "send failed");
+
+	expect_cqe(server_buf, STRLEN(TEST_STR));
+	zassert_mem_equal(server_buf, TEST_STR, STRLEN(TEST_STR),
+			  "wrong data");
+}
+
+ZTEST_SUITE(net_socket_udp_rtio, NULL, rtio_setup, NULL, NULL,
+	    rtio_teardown);
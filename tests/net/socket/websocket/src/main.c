@@ -353,6 +353,38 @@ static void test_send_and_recv_lorem_ipsum(void)
 		      test_msg_len, ret);
 }
 
+static void test_send_iov_and_recv_lorem_ipsum(void)
+{
+	static struct websocket_context ctx;
+	static uint8_t buf[sizeof(lorem_ipsum)];
+	uint8_t *payload = &buf[1];
+	struct iovec iov;
+	int ret;
+
+	memset(&ctx, 0, sizeof(ctx));
+
+	ctx.tmp_buf = temp_recv_buf;
+	ctx.tmp_buf_len = sizeof(temp_recv_buf);
+
+	test_msg_len = sizeof(lorem_ipsum) - 1;
+
+	/* Start the payload at an odd address so that masking it byte after
+	 * byte and word after word are both tested.
+	 */
+	memcpy(payload, lorem_ipsum, test_msg_len);
+	iov.iov_base = payload;
+	iov.iov_len = test_msg_len;
+
+	ret = websocket_send_msg_iov(POINTER_TO_INT(&ctx), &iov, 1,
+				     WEBSOCKET_OPCODE_DATA_TEXT, true, true,
+				     SYS_FOREVER_MS);
+	zassert_equal(ret, test_msg_len,
+		      "Should have sent %zd bytes but sent %d instead",
+		      test_msg_len, ret);
+	zassert_mem_equal(payload, lorem_ipsum, test_msg_len,
+			  "Payload was not restored after masking");
+}
+
 static void test_recv_two_large_split_msg(void)
 {
 	static struct websocket_context ctx;
@@ -390,6 +422,7 @@ void test_main(void)
 			 ztest_unit_test(test_recv_whole_msg),
 			 ztest_unit_test(test_recv_two_msg),
 			 ztest_unit_test(test_send_and_recv_lorem_ipsum),
+			 ztest_unit_test(test_send_iov_and_recv_lorem_ipsum),
 			 ztest_unit_test(test_recv_two_large_split_msg)
 		);
 
@@ -1481,4 +1481,72 @@ ZTEST(net_tcp, test_server_timeout_out_of_order_data)
 	net_tcp_put(ooo_ctx);
 }
 
+#if defined(CONFIG_NET_TCP_SEND_ZC)
+NET_BUF_POOL_VAR_DEFINE(send_zc_pool, 2, 64, 0, NULL);
+
+static K_SEM_DEFINE(send_zc_sem, 0, 1);
+static int send_zc_status;
+
+static void send_zc_cb(struct net_context *context, int status,
+		       void *user_data)
+{
+	send_zc_status = status;
+	k_sem_give(&send_zc_sem);
+}
+#endif
+
+/* Test case scenario IPv4
+ *   same as test_client_ipv4, the data being sent with
+ *   net_context_send_buf(), and expect the callback once the data is
+ *   acknowledged.
+ */
+ZTEST(net_tcp, test_client_send_buf_ipv4)
+{
+#if defined(CONFIG_NET_TCP_SEND_ZC)
+	struct net_context *ctx;
+	struct net_buf *buf;
+	int ret;
+
+	t_state = T_SYN;
+	test_case_no = 1;
+	seq = ack = 0;
+
+	ret = net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	zassert_equal(ret, 0, "Failed to get net_context");
+
+	net_context_ref(ctx);
+
+	ret = net_context_connect(ctx, (struct sockaddr *)&peer_addr_s,
+				  sizeof(struct sockaddr_in),
+				  NULL,
+				  K_MSEC(100), NULL);
+	zassert_equal(ret, 0, "Failed to connect to peer");
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	buf = net_buf_alloc(&send_zc_pool, K_NO_WAIT);
+	zassert_not_null(buf, "Failed to allocate buffer");
+	net_buf_add_u8(buf, 0x41); /* "A" */
+
+	send_zc_status = 0;
+	ret = net_context_send_buf(ctx, buf, send_zc_cb, NULL);
+	zassert_equal(ret, 0, "Failed to send buffer to peer");
+
+	/* Peer will release the semaphore after it sends ACK for data */
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	zassert_equal(k_sem_take(&send_zc_sem, K_MSEC(100)), 0,
+		      "No send callback");
+	zassert_equal(send_zc_status, 1, "Wrong acknowledged length");
+
+	net_context_put(ctx);
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	k_sleep(K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY));
+#else
+	ztest_test_skip();
+#endif
+}
+
 ZTEST_SUITE(net_tcp, NULL, presetup, NULL, NULL, NULL);
@@ -0,0 +1,376 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_test, CONFIG_NET_UDP_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/dummy.h>
+#include <zephyr/ztest.h>
+
+#include "net_private.h"
+#include "ipv4.h"
+#include "udp_internal.h"
+
+#define LIST_PORT 4343
+#define PEER_PORT 1234
+
+#define WAIT_TIME K_MSEC(200)
+#define ALLOC_TIMEOUT K_SECONDS(1)
+
+static struct in_addr list_addr = { { { 192, 0, 2, 2 } } };
+static struct in_addr peer_addr = { { { 192, 0, 2, 9 } } };
+
+static struct net_if *iface;
+static struct net_conn_handle *handle;
+static struct k_sem recv_sem;
+static atomic_t recv_count;
+
+/* Who received what, in reception order */
+#define MAX_RECV 32
+
+static struct {
+	k_tid_t thread;
+	uint16_t port;
+	uint8_t seq;
+} recv_log[MAX_RECV];
+
+static enum net_verdict list_recv(struct net_conn *conn,
+				  struct net_pkt *pkt,
+				  union net_ip_header *ip_hdr,
+				  union net_proto_header *proto_hdr,
+				  void *user_data)
+{
+	int i = atomic_inc(&recv_count);
+	uint8_t seq = 0U;
+
+	net_pkt_cursor_init(pkt);
+	(void)net_pkt_skip(pkt, sizeof(struct net_ipv4_hdr) +
+			   sizeof(struct net_udp_hdr));
+	(void)net_pkt_read_u8(pkt, &seq);
+
+	if (i < MAX_RECV) {
+		recv_log[i].thread = k_current_get();
+		recv_log[i].port = ntohs(proto_hdr->udp->src_port);
+		recv_log[i].seq = seq;
+	}
+
+	k_sem_give(&recv_sem);
+
+	net_pkt_unref(pkt);
+
+	return NET_OK;
+}
+
+static struct net_pkt *udp_pkt_alloc_seq(uint16_t port, uint8_t seq)
+{
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_rx_alloc_with_buffer(iface, sizeof(seq), AF_INET,
+					   IPPROTO_UDP, ALLOC_TIMEOUT);
+	zassert_not_null(pkt, "Out of mem");
+
+	zassert_ok(net_ipv4_create(pkt, &peer_addr, &list_addr));
+	zassert_ok(net_udp_create(pkt, htons(port), htons(LIST_PORT)));
+	zassert_ok(net_pkt_write_u8(pkt, seq));
+
+	net_pkt_cursor_init(pkt);
+	net_ipv4_finalize(pkt, IPPROTO_UDP);
+
+	return pkt;
+}
+
+static struct net_pkt *udp_pkt_alloc(void)
+{
+	return udp_pkt_alloc_seq(PEER_PORT, 0U);
+}
+
+static void expect_recv(int count)
+{
+	int i;
+
+	for (i = 0; i < count; i++) {
+		zassert_ok(k_sem_take(&recv_sem, WAIT_TIME),
+			   "Packet %d not received", i);
+	}
+
+	zassert_not_equal(k_sem_take(&recv_sem, WAIT_TIME), 0,
+			  "Unexpected packet received");
+	zassert_equal(atomic_get(&recv_count), count);
+}
+
+static void *recv_list_setup(void)
+{
+	struct sockaddr local = { 0 };
+	int ret;
+
+	k_sem_init(&recv_sem, 0, UINT_MAX);
+
+	iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	zassert_not_null(iface, "Interface is NULL");
+
+	zassert_not_null(net_if_ipv4_addr_add(iface, &list_addr,
+					      NET_ADDR_MANUAL, 0),
+			 "Cannot add IPv4 address");
+
+	net_ipaddr_copy(&net_sin(&local)->sin_addr, &list_addr);
+	local.sa_family = AF_INET;
+
+	ret = net_udp_register(AF_INET, NULL, &local, 0, LIST_PORT, NULL,
+			       list_recv, NULL, &handle);
+	zassert_ok(ret, "Cannot register UDP handler");
+
+	return NULL;
+}
+
+static void recv_list_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	k_sem_reset(&recv_sem);
+	atomic_clear(&recv_count);
+	memset(recv_log, 0, sizeof(recv_log));
+}
+
+static void recv_list_teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	net_udp_unregister(handle);
+	net_if_ipv4_addr_rm(iface, &list_addr);
+}
+
+ZTEST(net_recv_list, test_recv_data_list)
+{
+	sys_slist_t list;
+	int i;
+
+	sys_slist_init(&list);
+
+	for (i = 0; i < 4; i++) {
+		sys_slist_append(&list, (sys_snode_t *)udp_pkt_alloc());
+	}
+
+	zassert_equal(net_recv_data_list(iface, &list), 4,
+		      "Wrong number of packets passed to the stack");
+	zassert_true(sys_slist_is_empty(&list), "List not consumed");
+
+	expect_recv(4);
+}
+
+ZTEST(net_recv_list, test_recv_data_list_empty_pkt)
+{
+	struct net_pkt *empty;
+	sys_slist_t list;
+
+	empty = net_pkt_rx_alloc_on_iface(iface, ALLOC_TIMEOUT);
+	zassert_not_null(empty, "Out of mem");
+
+	sys_slist_init(&list);
+	sys_slist_append(&list, (sys_snode_t *)empty);
+	sys_slist_append(&list, (sys_snode_t *)udp_pkt_alloc());
+
+	/* The packet without data is dropped */
+	zassert_equal(net_recv_data_list(iface, &list), 1);
+	zassert_true(sys_slist_is_empty(&list), "List not consumed");
+
+	expect_recv(1);
+}
+
+ZTEST(net_recv_list, test_recv_data_list_iface_down)
+{
+	struct net_pkt *pkt;
+	sys_slist_t list;
+
+	sys_slist_init(&list);
+	sys_slist_append(&list, (sys_snode_t *)udp_pkt_alloc());
+
+	zassert_equal(net_recv_data_list(NULL, &list), -EINVAL);
+	zassert_equal(net_recv_data_list(iface, NULL), -EINVAL);
+
+	net_if_down(iface);
+	zassert_equal(net_recv_data_list(iface, &list), -ENETDOWN);
+	net_if_up(iface);
+
+	/* The caller still owns the packets on error */
+	pkt = (struct net_pkt *)sys_slist_get(&list);
+	zassert_not_null(pkt, "Packet removed from the list on error");
+	net_pkt_unref(pkt);
+
+	expect_recv(0);
+}
+
+#if defined(CONFIG_NET_RX_POLL)
+#define POLL_BUDGET CONFIG_NET_RX_POLL_BUDGET
+#else
+#define POLL_BUDGET 1
+#endif
+
+/* Packets the "driver" has pending, received over several passes */
+#define POLL_PKTS (2 * POLL_BUDGET + 1)
+
+static struct net_rx_poll rx_poll;
+static int poll_pending;
+static int poll_calls;
+static int poll_max_budget;
+
+static int rx_poll_cb(struct net_rx_poll *poll, int budget)
+{
+	int count = 0;
+
+	poll_calls++;
+	poll_max_budget = MAX(poll_max_budget, budget);
+
+	while (count < budget && poll_pending > 0) {
+		net_rx_poll_recv(poll, udp_pkt_alloc());
+		poll_pending--;
+		count++;
+	}
+
+	return count;
+}
+
+ZTEST(net_recv_list, test_rx_poll)
+{
+	if (!IS_ENABLED(CONFIG_NET_RX_POLL)) {
+		ztest_test_skip();
+	}
+
+	poll_pending = POLL_PKTS;
+	poll_calls = 0;
+	poll_max_budget = 0;
+
+	net_rx_poll_init(&rx_poll, iface, rx_poll_cb);
+	net_rx_poll_schedule(&rx_poll);
+
+	/* Two full passes, then a last one receiving less than the budget
+	 * after which the driver is no longer polled.
+	 */
+	expect_recv(POLL_PKTS);
+
+	zassert_equal(poll_pending, 0);
+	zassert_equal(poll_calls, 3, "Driver polled %d times", poll_calls);
+	zassert_equal(poll_max_budget, POLL_BUDGET);
+}
+
+#if defined(CONFIG_NET_RX_STEERING)
+#define STEERING_QUEUES CONFIG_NET_RX_STEERING_QUEUES
+#else
+#define STEERING_QUEUES 1
+#endif
+
+ZTEST(net_recv_list, test_rx_steering_flow_order)
+{
+	int i;
+
+	if (!IS_ENABLED(CONFIG_NET_RX_STEERING)) {
+		ztest_test_skip();
+	}
+
+	for (i = 0; i < 8; i++) {
+		zassert_ok(net_recv_data(iface,
+					 udp_pkt_alloc_seq(PEER_PORT, i)));
+	}
+
+	expect_recv(8);
+
+	/* One flow is processed by a single thread, in order */
+	for (i = 0; i < 8; i++) {
+		zassert_equal(recv_log[i].thread, recv_log[0].thread,
+			      "Flow spread over several threads");
+		zassert_equal(recv_log[i].seq, i, "Flow reordered");
+	}
+}
+
+ZTEST(net_recv_list, test_rx_steering_flows)
+{
+	sys_slist_t list;
+	int i, j;
+
+	if (!IS_ENABLED(CONFIG_NET_RX_STEERING) || STEERING_QUEUES < 2) {
+		ztest_test_skip();
+	}
+
+	sys_slist_init(&list);
+
+	/* Two packets for each of 8 flows, through both submission paths */
+	for (i = 0; i < 8; i++) {
+		zassert_ok(net_recv_data(iface,
+					 udp_pkt_alloc_seq(PEER_PORT + i, 0)));
+		sys_slist_append(&list,
+				 (sys_snode_t *)udp_pkt_alloc_seq(PEER_PORT + i,
+								  1));
+	}
+
+	zassert_equal(net_recv_data_list(iface, &list), 8);
+
+	expect_recv(16);
+
+	for (i = 0; i < 16; i++) {
+		for (j = 0; j < 16; j++) {
+			if (recv_log[j].port == recv_log[i].port) {
+				zassert_equal(recv_log[j].thread,
+					      recv_log[i].thread,
+					      "Flow %u on several threads",
+					      recv_log[i].port);
+			}
+		}
+	}
+
+	for (i = 1; i < 16; i++) {
+		if (recv_log[i].thread != recv_log[0].thread) {
+			break;
+		}
+	}
+
+	zassert_true(i < 16, "All flows steered to a single thread");
+}
+
+ZTEST(net_recv_list, test_rx_steering_hw_queue)
+{
+	struct net_pkt *pkt;
+	k_tid_t threads[2] = { 0 };
+	int i;
+
+	if (!IS_ENABLED(CONFIG_NET_RX_STEERING) || STEERING_QUEUES < 2) {
+		ztest_test_skip();
+	}
+
+	/* The queue reported by the driver wins over the flow hash, the
+	 * packets of one flow being split over two queues.
+	 */
+	for (i = 0; i < 8; i++) {
+		pkt = udp_pkt_alloc_seq(PEER_PORT, i);
+		net_pkt_set_rx_queue(pkt, i % 2);
+		zassert_equal(net_pkt_rx_queue(pkt), i % 2);
+
+		zassert_ok(net_recv_data(iface, pkt));
+	}
+
+	expect_recv(8);
+
+	for (i = 0; i < 8; i++) {
+		int queue = recv_log[i].seq % 2;
+
+		if (threads[queue] == NULL) {
+			threads[queue] = recv_log[i].thread;
+		}
+
+		zassert_equal(recv_log[i].thread, threads[queue],
+			      "RX queue %d spread over several threads",
+			      queue);
+	}
+
+	zassert_not_equal(threads[0], threads[1],
+			  "RX queues handled by the same thread");
+}
+
+ZTEST_SUITE(net_recv_list, NULL, recv_list_setup, recv_list_before, NULL,
+	    recv_list_teardown);
@@ -848,11 +848,79 @@ void test_addr_parse(void)
 #endif
 }
 
+static uint32_t ref_chksum(uint32_t sum, const uint8_t *data, size_t len)
+{
+	size_t i;
+
+	for (i = 0; i + 1 < len; i += 2) {
+		sum += (data[i] << 8) | data[i + 1];
+	}
+
+	if (len % 2) {
+		sum += data[len - 1] << 8;
+	}
+
+	return sum;
+}
+
+void test_chksum(void)
+{
+	/* Odd sized fragments, the first one holding the IPv6 header */
+	static const size_t frag_len[] = { 51, 37, 64, 1 };
+	uint8_t data[153];
+	struct net_pkt *pkt;
+	struct net_buf *frag;
+	uint32_t sum;
+	uint16_t expected;
+	size_t offset = 0;
+	int i;
+
+	for (i = 0; i < sizeof(data); i++) {
+		data[i] = i * 7 + 0x55;
+	}
+
+	pkt = net_pkt_rx_alloc(K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate pkt");
+
+	for (i = 0; i < ARRAY_SIZE(frag_len); i++) {
+		frag = net_pkt_get_frag(pkt, K_NO_WAIT);
+		zassert_not_null(frag, "Cannot allocate frag");
+
+		net_buf_add_mem(frag, data + offset, frag_len[i]);
+		net_pkt_frag_add(pkt, frag);
+		offset += frag_len[i];
+	}
+
+	net_pkt_set_family(pkt, AF_INET6);
+	net_pkt_set_ip_hdr_len(pkt, sizeof(struct net_ipv6_hdr));
+	net_pkt_set_ipv6_ext_len(pkt, 0);
+
+	/* Pseudo header with the addresses, the length and the protocol,
+	 * then the UDP header and payload.
+	 */
+	sum = ref_chksum(0, data + 8, 2 * sizeof(struct in6_addr));
+	sum += sizeof(data) - sizeof(struct net_ipv6_hdr) + IPPROTO_UDP;
+	sum = ref_chksum(sum, data + sizeof(struct net_ipv6_hdr),
+			 sizeof(data) - sizeof(struct net_ipv6_hdr));
+
+	while (sum >> 16) {
+		sum = (sum & 0xffff) + (sum >> 16);
+	}
+
+	expected = ~((sum == 0U) ? 0xffff : htons(sum));
+
+	zassert_equal(net_calc_chksum(pkt, IPPROTO_UDP), expected,
+		      "Invalid checksum");
+
+	net_pkt_unref(pkt);
+}
+
 void test_main(void)
 {
 	ztest_test_suite(test_utils_fn,
 			 ztest_user_unit_test(test_net_addr),
-			 ztest_unit_test(test_addr_parse));
+			 ztest_unit_test(test_addr_parse),
+			 ztest_unit_test(test_chksum));
 
 	ztest_run_test_suite(test_utils_fn);
 }
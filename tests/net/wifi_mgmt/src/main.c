@@ -0,0 +1,350 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_mgmt.h>
+#include <zephyr/net/wifi_mgmt.h>
+#include <zephyr/ztest.h>
+
+/* Time for the system work queue to learn the network connected to */
+#define LEARN_WAIT K_MSEC(100)
+
+static struct net_if *wifi_iface;
+
+/* BSSs found by a scan of the fake driver */
+static struct wifi_scan_result *scan_bss;
+static size_t scan_bss_count;
+
+/* Last connection request given to the driver */
+static struct wifi_connect_req_params last_connect;
+static uint8_t last_ssid[WIFI_SSID_MAX_LEN];
+static uint8_t last_bssid[WIFI_MAC_ADDR_LEN];
+static bool last_has_bssid;
+
+/* What the driver reports as the network connected to, if anything */
+static bool status_supported;
+static uint8_t status_channel;
+static uint8_t status_bssid[WIFI_MAC_ADDR_LEN];
+
+static atomic_t scan_result_events;
+static struct net_mgmt_event_callback scan_cb;
+
+static int fake_scan(const struct device *dev, scan_result_cb_t cb)
+{
+	for (size_t i = 0; i < scan_bss_count; i++) {
+		cb(wifi_iface, 0, &scan_bss[i]);
+	}
+
+	cb(wifi_iface, 0, NULL);
+
+	return 0;
+}
+
+static int fake_connect(const struct device *dev,
+			struct wifi_connect_req_params *params)
+{
+	last_connect = *params;
+	memcpy(last_ssid, params->ssid, params->ssid_length);
+	last_connect.ssid = last_ssid;
+
+	last_has_bssid = (params->bssid != NULL);
+	if (last_has_bssid) {
+		memcpy(last_bssid, params->bssid, WIFI_MAC_ADDR_LEN);
+	}
+
+	return 0;
+}
+
+static int fake_iface_status(const struct device *dev,
+			     struct wifi_iface_status *status)
+{
+	if (!status_supported) {
+		return -ENOTSUP;
+	}
+
+	status->state = WIFI_STATE_COMPLETED;
+	memcpy(status->ssid, last_ssid, last_connect.ssid_length);
+	status->ssid_len = last_connect.ssid_length;
+	memcpy(status->bssid, status_bssid, WIFI_MAC_ADDR_LEN);
+	status->channel = status_channel;
+
+	return 0;
+}
+
+static void fake_iface_init(struct net_if *iface)
+{
+	wifi_iface = iface;
+}
+
+static const struct net_wifi_mgmt_offload fake_wifi_api = {
+	.wifi_iface.init = fake_iface_init,
+	.scan = fake_scan,
+	.connect = fake_connect,
+	.iface_status = fake_iface_status,
+};
+
+NET_DEVICE_OFFLOAD_INIT(fake_wifi, "fake_wifi", NULL, NULL, NULL, NULL,
+			CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &fake_wifi_api,
+			1500);
+
+static void scan_event_handler(struct net_mgmt_event_callback *cb,
+			       uint32_t mgmt_event, struct net_if *iface)
+{
+	if (mgmt_event == NET_EVENT_WIFI_SCAN_RESULT) {
+		atomic_inc(&scan_result_events);
+	}
+}
+
+#define BSS(_ssid, _channel, _rssi, _mac)				\
+	{								\
+		.ssid = _ssid,						\
+		.ssid_length = sizeof(_ssid) - 1,			\
+		.channel = _channel,					\
+		.rssi = _rssi,						\
+		.mac = { 0x02, 0, 0, 0, 0, _mac },			\
+		.mac_length = WIFI_MAC_ADDR_LEN,			\
+	}
+
+static void wifi_scan_bss(struct wifi_scan_result *bss, size_t count)
+{
+	scan_bss = bss;
+	scan_bss_count = count;
+
+	zassert_ok(net_mgmt(NET_REQUEST_WIFI_SCAN, wifi_iface, NULL, 0));
+}
+
+static void wifi_connect_to(const char *ssid, uint8_t channel)
+{
+	struct wifi_connect_req_params params = {
+		.ssid = (const uint8_t *)ssid,
+		.ssid_length = strlen(ssid),
+		.channel = channel,
+		.security = WIFI_SECURITY_TYPE_NONE,
+		.timeout = SYS_FOREVER_MS,
+	};
+
+	zassert_ok(net_mgmt(NET_REQUEST_WIFI_CONNECT, wifi_iface, &params,
+			    sizeof(params)));
+}
+
+/* Connect successfully, letting the L2 learn the network */
+static void connect_learn(const char *ssid)
+{
+	wifi_connect_to(ssid, WIFI_CHANNEL_ANY);
+	wifi_mgmt_raise_connect_result_event(wifi_iface, 0);
+	k_sleep(LEARN_WAIT);
+}
+
+static void expect_hint(uint8_t channel, uint8_t mac)
+{
+	zassert_equal(last_connect.channel, channel, "channel %u",
+		      last_connect.channel);
+	zassert_true(last_has_bssid, "no BSSID given");
+	zassert_equal(last_bssid[WIFI_MAC_ADDR_LEN - 1], mac);
+}
+
+static void expect_no_hint(void)
+{
+	zassert_equal(last_connect.channel, WIFI_CHANNEL_ANY);
+	zassert_false(last_has_bssid, "BSSID given");
+}
+
+static void *wifi_mgmt_setup(void)
+{
+	zassert_not_null(wifi_iface, "Interface is NULL");
+
+	net_mgmt_init_event_callback(&scan_cb, scan_event_handler,
+				     NET_EVENT_WIFI_SCAN_RESULT);
+	net_mgmt_add_event_callback(&scan_cb);
+
+	return NULL;
+}
+
+static void wifi_mgmt_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	scan_bss_count = 0;
+	status_supported = false;
+	atomic_clear(&scan_result_events);
+	memset(&last_connect, 0, sizeof(last_connect));
+	last_has_bssid = false;
+}
+
+ZTEST(wifi_mgmt, test_scan_results)
+{
+	struct wifi_scan_result bss[] = {
+		BSS("net_a", 1, -70, 1),
+		BSS("net_b", 6, -50, 2),
+		BSS("net_a", 1, -40, 1),
+		BSS("net_c", 11, -80, 3),
+		BSS("net_d", 36, -60, 4),
+		BSS("net_e", 40, -90, 5),
+	};
+	struct wifi_scan_result results[4];
+	struct wifi_scan_results req = {
+		.results = results,
+		.max = ARRAY_SIZE(results),
+	};
+	bool found[6] = { 0 };
+
+	wifi_scan_bss(bss, ARRAY_SIZE(bss));
+
+	zassert_ok(net_mgmt(NET_REQUEST_WIFI_SCAN_RESULTS, wifi_iface, &req,
+			    sizeof(req)));
+
+	/* Each BSS once, with its strongest signal, and only the strongest
+	 * BSSs are kept.
+	 */
+	zassert_equal(req.count, CONFIG_NET_L2_WIFI_MGMT_SCAN_RESULTS_MAX);
+
+	for (size_t i = 0; i < req.count; i++) {
+		int mac = results[i].mac[WIFI_MAC_ADDR_LEN - 1];
+
+		zassert_false(found[mac], "BSS %d listed twice", mac);
+		found[mac] = true;
+
+		if (mac == 1) {
+			zassert_equal(results[i].rssi, -40);
+		}
+	}
+
+	zassert_true(found[1] && found[2] && found[4], "weak BSS kept");
+
+	/* The results of another scan replace them */
+	wifi_scan_bss(&bss[3], 1);
+
+	zassert_ok(net_mgmt(NET_REQUEST_WIFI_SCAN_RESULTS, wifi_iface, &req,
+			    sizeof(req)));
+	zassert_equal(req.count, 1);
+	zassert_equal(results[0].mac[WIFI_MAC_ADDR_LEN - 1], 3);
+}
+
+ZTEST(wifi_mgmt, test_scan_results_request)
+{
+	struct wifi_scan_result bss[] = {
+		BSS("net_a", 1, -70, 1),
+		BSS("net_b", 6, -50, 2),
+	};
+	struct wifi_scan_result result;
+	struct wifi_scan_results req = {
+		.results = &result,
+		.max = 1,
+	};
+
+	wifi_scan_bss(bss, ARRAY_SIZE(bss));
+
+	zassert_ok(net_mgmt(NET_REQUEST_WIFI_SCAN_RESULTS, wifi_iface, &req,
+			    sizeof(req)));
+	zassert_equal(req.count, 1);
+
+	req.results = NULL;
+	zassert_equal(net_mgmt(NET_REQUEST_WIFI_SCAN_RESULTS, wifi_iface,
+			       &req, sizeof(req)), -EINVAL);
+
+	req.max = 0;
+	zassert_ok(net_mgmt(NET_REQUEST_WIFI_SCAN_RESULTS, wifi_iface, &req,
+			    sizeof(req)));
+	zassert_equal(req.count, 0);
+
+	zassert_equal(net_mgmt(NET_REQUEST_WIFI_SCAN_RESULTS, wifi_iface,
+			       &req, sizeof(req) - 1), -EINVAL);
+}
+
+ZTEST(wifi_mgmt, test_scan_result_events)
+{
+	struct wifi_scan_result bss[] = {
+		BSS("net_a", 1, -70, 1),
+		BSS("net_b", 6, -50, 2),
+	};
+	int expected = IS_ENABLED(CONFIG_NET_L2_WIFI_MGMT_SCAN_RESULT_EVENTS) ?
+		       ARRAY_SIZE(bss) : 0;
+
+	wifi_scan_bss(bss, ARRAY_SIZE(bss));
+	k_sleep(K_MSEC(100));
+
+	zassert_equal(atomic_get(&scan_result_events), expected,
+		      "%d scan result events", atomic_get(&scan_result_events));
+}
+
+ZTEST(wifi_mgmt, test_reconnect_from_status)
+{
+	status_supported = true;
+	status_channel = 6;
+	status_bssid[WIFI_MAC_ADDR_LEN - 1] = 0x16;
+
+	connect_learn("net_status");
+	expect_no_hint();
+
+	/* The channel and BSSID reported by the driver are given back */
+	wifi_connect_to("net_status", WIFI_CHANNEL_ANY);
+	expect_hint(6, 0x16);
+
+	/* Unless the application asks for a channel */
+	wifi_connect_to("net_status", 11);
+	zassert_equal(last_connect.channel, 11);
+	zassert_false(last_has_bssid, "BSSID given");
+}
+
+ZTEST(wifi_mgmt, test_reconnect_from_scan)
+{
+	struct wifi_scan_result bss[] = {
+		BSS("net_scan", 1, -70, 0x21),
+		BSS("net_scan", 36, -40, 0x22),
+		BSS("net_other", 6, -30, 0x23),
+	};
+
+	/* The driver does not tell, the strongest BSS scanned is used */
+	wifi_scan_bss(bss, ARRAY_SIZE(bss));
+
+	connect_learn("net_scan");
+	expect_no_hint();
+
+	wifi_connect_to("net_scan", WIFI_CHANNEL_ANY);
+	expect_hint(36, 0x22);
+}
+
+ZTEST(wifi_mgmt, test_reconnect_failed)
+{
+	status_supported = true;
+	status_channel = 1;
+	status_bssid[WIFI_MAC_ADDR_LEN - 1] = 0x31;
+
+	connect_learn("net_failed");
+
+	wifi_connect_to("net_failed", WIFI_CHANNEL_ANY);
+	expect_hint(1, 0x31);
+
+	/* A failed hinted connection forgets the network */
+	wifi_mgmt_raise_connect_result_event(wifi_iface, -ETIMEDOUT);
+
+	wifi_connect_to("net_failed", WIFI_CHANNEL_ANY);
+	expect_no_hint();
+}
+
+ZTEST(wifi_mgmt, test_reconnect_lru)
+{
+	status_supported = true;
+	status_channel = 11;
+
+	connect_learn("net_lru_a");
+	connect_learn("net_lru_b");
+	connect_learn("net_lru_c");
+
+	/* The least recently used network was replaced */
+	wifi_connect_to("net_lru_a", WIFI_CHANNEL_ANY);
+	expect_no_hint();
+
+	wifi_connect_to("net_lru_b", WIFI_CHANNEL_ANY);
+	zassert_equal(last_connect.channel, 11);
+	wifi_connect_to("net_lru_c", WIFI_CHANNEL_ANY);
+	zassert_equal(last_connect.channel, 11);
+}
+
+ZTEST_SUITE(wifi_mgmt, NULL, wifi_mgmt_setup, wifi_mgmt_before, NULL, NULL);
@@ -107,3 +107,47 @@ ZTEST(posix_apis, test_posix_mqueue)
 		      "unable to close message queue descriptor.");
 	zassert_false(mq_unlink(queue), "Not able to unlink Queue");
 }
+
+ZTEST(posix_apis, test_posix_mqueue_priority)
+{
+	static const unsigned int prios[] = { 1, 5, 0, 5, 31, 1 };
+	/* Highest priority first, oldest first within a priority */
+	static const int order[] = { 4, 1, 3, 0, 5, 2 };
+	struct mq_attr attrs = {
+		.mq_msgsize = MESSAGE_SIZE,
+		.mq_maxmsg = ARRAY_SIZE(prios),
+	};
+	char buf[MESSAGE_SIZE];
+	unsigned int prio;
+	mqd_t mqd;
+	int i;
+
+	mqd = mq_open("prio", O_RDWR | O_CREAT | O_NONBLOCK, 0777, &attrs);
+	zassert_not_equal(mqd, (mqd_t)-1, "unable to open message queue");
+
+	for (i = 0; i < ARRAY_SIZE(prios); i++) {
+		buf[0] = i;
+		zassert_false(mq_send(mqd, buf, i + 1, prios[i]),
+			      "unable to send message");
+	}
+
+	/* TESTPOINT: The queue is full and does not block */
+	zassert_equal(mq_send(mqd, buf, 1, 0), -1, "send to full queue");
+	zassert_equal(errno, EAGAIN);
+	zassert_equal(mq_send(mqd, buf, 1, MQ_PRIO_MAX), -1, "invalid priority");
+
+	for (i = 0; i < ARRAY_SIZE(order); i++) {
+		/* TESTPOINT: The length of the message is returned */
+		zassert_equal(mq_receive(mqd, buf, sizeof(buf), &prio),
+			      order[i] + 1, "wrong message length");
+		zassert_equal(buf[0], order[i], "wrong message order");
+		zassert_equal(prio, prios[order[i]], "wrong message priority");
+	}
+
+	zassert_equal(mq_receive(mqd, buf, sizeof(buf), &prio), -1,
+		      "receive from empty queue");
+	zassert_equal(errno, EAGAIN);
+
+	zassert_false(mq_close(mqd), "unable to close message queue descriptor.");
+	zassert_false(mq_unlink("prio"), "Not able to unlink Queue");
+}
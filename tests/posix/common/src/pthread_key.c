@@ -213,3 +213,37 @@ ZTEST(posix_apis, test_posix_single_thread_multiple_keys)
 	}
 	printk("\n");
 }
+
+static void *thread_key_reuse(void *p1)
+{
+	pthread_key_t new_key;
+
+	zassert_false(pthread_key_create(&key, NULL), "key creation failed");
+	zassert_false(pthread_setspecific(key, p1), "pthread_setspecific failed");
+	zassert_equal(pthread_getspecific(key), p1, "wrong value");
+	zassert_false(pthread_key_delete(key), "key deletion failed");
+
+	/* TESTPOINT: A key created after a deletion starts with NULL, even
+	 * when it reuses the storage of the deleted one.
+	 */
+	zassert_false(pthread_key_create(&new_key, NULL), "key creation failed");
+	zassert_is_null(pthread_getspecific(new_key), "stale value returned");
+	zassert_equal(pthread_setspecific(key, p1), key == new_key ? 0 : EINVAL,
+		      "deleted key still usable");
+	zassert_false(pthread_key_delete(new_key), "key deletion failed");
+
+	return NULL;
+}
+
+ZTEST(posix_apis, test_posix_key_reuse)
+{
+	pthread_attr_t attr;
+	pthread_t newthread;
+
+	zassert_false(pthread_attr_init(&attr), "Unable to create pthread object attr");
+	pthread_attr_setstack(&attr, &stackp[0][0], STACKSZ);
+
+	zassert_false(pthread_create(&newthread, &attr, thread_key_reuse, &attr),
+		      "attempt to create thread failed");
+	pthread_join(newthread, NULL);
+}
@@ -86,3 +86,48 @@ ZTEST(posix_apis, test_posix_timer)
 	zassert_equal(total_secs_timer, secs_elapsed,
 		      "POSIX timer test has failed");
 }
+
+static int thread_exp_count;
+static bool thread_in_isr;
+
+static void thread_handler(union sigval val)
+{
+	thread_in_isr |= k_is_in_isr();
+	thread_exp_count++;
+
+	/* Hold the work queue so that expirations pile up */
+	k_busy_wait(val.sival_int);
+}
+
+ZTEST(posix_apis, test_posix_timer_sigev_thread)
+{
+	struct sigevent sig = { 0 };
+	struct itimerspec value = { 0 };
+	timer_t timerid;
+	int overrun;
+
+	sig.sigev_notify = SIGEV_THREAD;
+	sig.sigev_notify_function = thread_handler;
+	/* Longer than the period */
+	sig.sigev_value.sival_int = 30 * USEC_PER_MSEC;
+
+	zassert_false(timer_create(CLOCK_MONOTONIC, &sig, &timerid),
+		      "POSIX timer create failed");
+
+	value.it_value.tv_nsec = 10 * NSEC_PER_MSEC;
+	value.it_interval.tv_nsec = 10 * NSEC_PER_MSEC;
+	zassert_false(timer_settime(timerid, 0, &value, NULL),
+		      "POSIX timer failed to start");
+
+	usleep(200 * USEC_PER_MSEC);
+	overrun = timer_getoverrun(timerid);
+	zassert_false(timer_delete(timerid), "POSIX timer delete failed");
+
+	/*TESTPOINT: Notifications run in a thread, and expirations
+	 * happening meanwhile are coalesced.
+	 */
+	zassert_false(thread_in_isr, "SIGEV_THREAD handler run from an ISR");
+	zassert_true(thread_exp_count > 0, "SIGEV_THREAD handler not called");
+	zassert_true(thread_exp_count < 200 / 10, "expirations not coalesced");
+	zassert_true(overrun > 0, "overruns not counted");
+}
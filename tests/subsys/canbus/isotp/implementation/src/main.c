@@ -411,6 +411,34 @@ ZTEST(isotp_implementation, test_buffer_allocation_wait)
 	isotp_unbind(&recv_ctx);
 }
 
+#ifdef CONFIG_ISOTP_RX_USER_BUF
+ZTEST(isotp_implementation, test_send_receive_user_buf)
+{
+	static uint8_t user_buf[sizeof(random_data)];
+	struct net_buf *buf;
+	int ret, i;
+
+	ret = isotp_bind_buf(&recv_ctx, can_dev, &rx_addr, &tx_addr, &fc_opts,
+			     user_buf, sizeof(user_buf), K_NO_WAIT);
+	zassert_equal(ret, 0, "Binding failed (%d)", ret);
+
+	for (i = 0; i < NUMBER_OF_REPETITIONS; i++) {
+		send_test_data(can_dev, random_data, sizeof(random_data));
+
+		/* The whole message is reassembled in the caller buffer */
+		ret = isotp_recv_net(&recv_ctx, &buf, K_MSEC(1000));
+		zassert_equal(ret, 0, "recv returned %d", ret);
+		zassert_equal_ptr(buf->data, user_buf, "Not received in place");
+		zassert_equal(buf->len, sizeof(random_data), "Length mismatch");
+		zassert_is_null(buf->frags, "Message is fragmented");
+		check_data(buf->data, random_data, buf->len);
+		net_buf_unref(buf);
+	}
+
+	isotp_unbind(&recv_ctx);
+}
+#endif
+
 void *isotp_implementation_setup(void)
 {
 	int ret;
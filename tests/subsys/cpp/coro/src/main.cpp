@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/cpp/coro.hpp>
+
+namespace coro = zephyr::coro;
+using zephyr::coro::task;
+
+static coro::executor exec;
+
+K_SEM_DEFINE(done, 0, 2);
+K_SEM_DEFINE(sem, 0, 1);
+K_MSGQ_DEFINE(msgq, sizeof(int), 2, 4);
+
+static struct k_poll_signal poll_sig;
+static int results[8];
+
+static task<int> twice(int x)
+{
+	co_await coro::sleep(K_MSEC(10));
+	co_return x * 2;
+}
+
+static task<> chain()
+{
+	results[0] = co_await twice(21);
+	results[1] = co_await twice(results[0]);
+	k_sem_give(&done);
+}
+
+ZTEST(cpp_coro, test_task_chain)
+{
+	zassert_equal(exec.spawn(chain()), 0);
+	zassert_ok(k_sem_take(&done, K_SECONDS(1)));
+	zassert_equal(results[0], 42);
+	zassert_equal(results[1], 84);
+}
+
+static task<> sem_waiter()
+{
+	results[0] = co_await coro::sem_take(sem, K_NO_WAIT);
+	results[1] = co_await coro::sem_take(sem, K_MSEC(10));
+	results[2] = co_await coro::sem_take(sem);
+	k_sem_give(&done);
+}
+
+ZTEST(cpp_coro, test_sem)
+{
+	zassert_equal(exec.spawn(sem_waiter()), 0);
+	k_msleep(50);
+	zassert_equal(results[0], -EBUSY);
+	zassert_equal(results[1], -EAGAIN);
+
+	k_sem_give(&sem);
+	zassert_ok(k_sem_take(&done, K_SECONDS(1)));
+	zassert_equal(results[2], 0);
+}
+
+static task<> msgq_waiter()
+{
+	int msg = 0;
+
+	results[0] = co_await coro::msgq_get(msgq, &msg);
+	results[1] = msg;
+	k_sem_give(&done);
+}
+
+ZTEST(cpp_coro, test_msgq)
+{
+	int msg = 7;
+
+	zassert_equal(exec.spawn(msgq_waiter()), 0);
+	k_msleep(10);
+	zassert_ok(k_msgq_put(&msgq, &msg, K_NO_WAIT));
+	zassert_ok(k_sem_take(&done, K_SECONDS(1)));
+	zassert_equal(results[0], 0);
+	zassert_equal(results[1], 7);
+}
+
+static task<> signal_waiter()
+{
+	int result = 0;
+
+	results[0] = co_await coro::signal_wait(poll_sig, &result);
+	results[1] = result;
+	k_sem_give(&done);
+}
+
+ZTEST(cpp_coro, test_signal)
+{
+	k_poll_signal_init(&poll_sig);
+	zassert_equal(exec.spawn(signal_waiter()), 0);
+	k_msleep(10);
+	k_poll_signal_raise(&poll_sig, 5);
+	zassert_ok(k_sem_take(&done, K_SECONDS(1)));
+	zassert_equal(results[0], 0);
+	zassert_equal(results[1], 5);
+}
+
+static task<> counter(int id)
+{
+	for (int i = 0; i < 4; i++) {
+		results[id]++;
+		co_await coro::yield();
+	}
+
+	k_sem_give(&done);
+}
+
+/* Coroutines interleave on the single work queue thread */
+ZTEST(cpp_coro, test_yield)
+{
+	zassert_equal(exec.spawn(counter(0)), 0);
+	zassert_equal(exec.spawn(counter(1)), 0);
+	zassert_ok(k_sem_take(&done, K_SECONDS(1)));
+	zassert_ok(k_sem_take(&done, K_SECONDS(1)));
+	zassert_equal(results[0], 4);
+	zassert_equal(results[1], 4);
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	memset(results, 0, sizeof(results));
+	k_sem_reset(&sem);
+	k_sem_reset(&done);
+}
+
+ZTEST_SUITE(cpp_coro, NULL, NULL, before, NULL, NULL);
@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/debug/sampling_profiler.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/shell/shell_dummy.h>
+#include <zephyr/ztest.h>
+
+#define SAMPLE_PERIOD K_MSEC(2)
+#define BUSY_TIME_US (60 * USEC_PER_MSEC)
+
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static K_THREAD_STACK_DEFINE(busy_stack, STACK_SIZE);
+static struct k_thread busy_thread;
+
+struct sample_count {
+	k_tid_t thread;
+	int thread_samples;
+	int samples;
+	bool pc_missing;
+};
+
+static void busy_entry(void *p1, void *p2, void *p3)
+{
+	k_busy_wait(BUSY_TIME_US);
+}
+
+static void sample_count(const struct sampling_profiler_sample *sample,
+			 void *user_data)
+{
+	struct sample_count *count = user_data;
+
+	count->samples++;
+
+	if (sample->thread == count->thread) {
+		count->thread_samples++;
+	}
+
+	if (sample->pc == 0) {
+		count->pc_missing = true;
+	}
+}
+
+/* Sample while a thread keeps the CPU busy, the test thread waiting */
+static void sample_busy_thread(void)
+{
+	k_tid_t tid;
+
+	zassert_ok(sampling_profiler_start(SAMPLE_PERIOD));
+
+	tid = k_thread_create(&busy_thread, busy_stack, STACK_SIZE,
+			      busy_entry, NULL, NULL, NULL,
+			      K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	k_thread_name_set(tid, "busy");
+
+	zassert_ok(k_thread_join(tid, K_FOREVER));
+
+	sampling_profiler_stop();
+}
+
+/* Run a command with the dummy backend and return its output */
+static const char *profiler_cmd(const char *cmd, int *ret)
+{
+	const struct shell *sh = shell_backend_dummy_get_ptr();
+	size_t size;
+
+	shell_backend_dummy_clear_output(sh);
+	*ret = shell_execute_cmd(sh, cmd);
+
+	return shell_backend_dummy_get_output(sh, &size);
+}
+
+static void profiler_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	sampling_profiler_stop();
+	sampling_profiler_reset();
+}
+
+ZTEST(sampling_profiler, test_start_stop)
+{
+	zassert_equal(sampling_profiler_foreach(sample_count, NULL), 0);
+
+	zassert_ok(sampling_profiler_start(SAMPLE_PERIOD));
+	zassert_equal(sampling_profiler_start(SAMPLE_PERIOD), -EALREADY);
+
+	/* The samples cannot be read while being collected */
+	zassert_equal(sampling_profiler_foreach(sample_count, NULL), -EBUSY);
+
+	sampling_profiler_stop();
+}
+
+ZTEST(sampling_profiler, test_samples)
+{
+	struct sample_count count = { .thread = &busy_thread };
+	int cnt;
+
+	sample_busy_thread();
+
+	cnt = sampling_profiler_foreach(sample_count, &count);
+	zassert_equal(cnt, count.samples);
+
+	/* One sample per period, nearly all of the busy thread */
+	zassert_within(cnt, BUSY_TIME_US / (2 * USEC_PER_MSEC), 5,
+		       "%d samples", cnt);
+	zassert_true(count.thread_samples >= cnt - 2, "%d of %d samples",
+		     count.thread_samples, cnt);
+	zassert_equal(sampling_profiler_dropped_get(), 0);
+
+	/* The interrupted code is only known on Cortex-M */
+	zassert_equal(count.pc_missing, !IS_ENABLED(CONFIG_CPU_CORTEX_M));
+
+	/* Sampling again appends to the samples */
+	sample_busy_thread();
+	zassert_true(sampling_profiler_foreach(sample_count, &count) > cnt);
+}
+
+ZTEST(sampling_profiler, test_dropped)
+{
+	int cnt;
+
+	/* The busy thread runs for more periods than there is room for */
+	for (int i = 0; i < 3; i++) {
+		sample_busy_thread();
+	}
+
+	cnt = sampling_profiler_foreach(sample_count,
+					&(struct sample_count){ 0 });
+	zassert_equal(cnt, CONFIG_SAMPLING_PROFILER_BUFFER_SIZE);
+	zassert_true(sampling_profiler_dropped_get() > 0);
+
+	sampling_profiler_reset();
+	zassert_equal(sampling_profiler_foreach(sample_count,
+						&(struct sample_count){ 0 }),
+		      0);
+	zassert_equal(sampling_profiler_dropped_get(), 0);
+}
+
+ZTEST(sampling_profiler, test_shell)
+{
+	char thread_line[32];
+	const char *output;
+	int ret;
+
+	output = profiler_cmd("profiler start 0", &ret);
+	zassert_equal(ret, -EINVAL);
+	zassert_not_null(strstr(output, "Invalid period"), "%s", output);
+
+	output = profiler_cmd("profiler start 2", &ret);
+	zassert_ok(ret);
+
+	output = profiler_cmd("profiler dump", &ret);
+	zassert_equal(ret, -EBUSY);
+	zassert_not_null(strstr(output, "Stop sampling first"), "%s", output);
+
+	output = profiler_cmd("profiler stop", &ret);
+	zassert_ok(ret);
+
+	sampling_profiler_reset();
+	sample_busy_thread();
+
+	/* Each sample gives the interrupted thread */
+	output = profiler_cmd("profiler dump", &ret);
+	zassert_ok(ret);
+
+	snprintk(thread_line, sizeof(thread_line), "sample %p ", &busy_thread);
+	zassert_not_null(strstr(output, thread_line), "%s", output);
+	zassert_not_null(strstr(output, "samples "), "%s", output);
+	zassert_not_null(strstr(output, " dropped 0"), "%s", output);
+
+	output = profiler_cmd("profiler reset", &ret);
+	zassert_ok(ret);
+
+	output = profiler_cmd("profiler dump", &ret);
+	zassert_ok(ret);
+	zassert_not_null(strstr(output, "samples 0 dropped 0"), "%s", output);
+}
+
+ZTEST_SUITE(sampling_profiler, NULL, NULL, profiler_before, NULL, NULL);
@@ -8,6 +8,7 @@
 #include <zephyr/ztest.h>
 #include <zephyr/storage/flash_map.h>
 #include <zephyr/dfu/flash_img.h>
+#include <zephyr/sys/byteorder.h>
 
 #define SLOT0_PARTITION		slot0_partition
 #define SLOT1_PARTITION		slot1_partition
@@ -40,6 +41,44 @@ ZTEST(img_util, test_init_id)
 		      "Partition ID is not set correctly");
 }
 
+ZTEST(img_util, test_init_id_at)
+{
+	struct flash_img_context ctx;
+	struct flash_pages_info page;
+	const struct flash_area *fa;
+	uint8_t data[16], temp[16];
+	int ret;
+
+	ret = flash_area_open(SLOT1_PARTITION_ID, &fa);
+	zassert_true(ret == 0, "Flash area open");
+
+	ret = flash_get_page_info_by_offs(flash_area_get_device(fa), fa->fa_off,
+					  &page);
+	zassert_true(ret == 0, "Page info");
+
+	ret = flash_img_init_id_at(&ctx, SLOT1_PARTITION_ID, 1);
+	zassert_equal(ret, -EINVAL, "Unaligned offset accepted");
+
+	ret = flash_img_init_id_at(&ctx, SLOT1_PARTITION_ID, fa->fa_size);
+	zassert_equal(ret, -EINVAL, "Offset past the area accepted");
+
+	ret = flash_img_init_id_at(&ctx, SLOT1_PARTITION_ID, page.size);
+	zassert_true(ret == 0, "Flash img init id at");
+
+	for (int i = 0; i < sizeof(data); i++) {
+		data[i] = i;
+	}
+
+	ret = flash_img_buffered_write(&ctx, data, sizeof(data), true);
+	zassert_true(ret == 0, "Write failure (%d)", ret);
+	zassert_equal(flash_img_bytes_written(&ctx), sizeof(data),
+		      "Unexpected bytes written");
+
+	ret = flash_area_read(fa, page.size, temp, sizeof(temp));
+	zassert_true(ret == 0, "Flash read failure (%d)", ret);
+	zassert_mem_equal(data, temp, sizeof(data), "Data not at offset");
+}
+
 ZTEST(img_util, test_collecting)
 {
 	const struct flash_area *fa;
@@ -165,4 +204,101 @@ ZTEST(img_util, test_check_flash)
 	flash_area_close(ctx.flash_area);
 }
 
+#ifdef CONFIG_IMG_DELTA
+#define DELTA_SRC_LEN 600
+#define DELTA_DST_LEN 700
+
+static uint8_t delta_src[DELTA_SRC_LEN];
+static uint8_t delta_dst[DELTA_DST_LEN];
+static uint8_t delta_patch[8 + 12 + 500 + 100 + 12 + 100];
+
+static uint8_t *delta_put_record(uint8_t *p, uint32_t diff, uint32_t extra,
+				 int32_t seek)
+{
+	sys_put_le32(diff, p);
+	sys_put_le32(extra, p + 4);
+	sys_put_le32((uint32_t)seek, p + 8);
+
+	return p + 12;
+}
+
+ZTEST(img_util, test_delta)
+{
+	const struct flash_area *fa;
+	struct flash_img_context ctx;
+	uint8_t *p = delta_patch;
+	uint8_t temp[50];
+	size_t i;
+	int ret;
+
+	for (i = 0; i < DELTA_SRC_LEN; i++) {
+		delta_src[i] = i * 7;
+	}
+
+	/* New image: first 500 source bytes incremented, 100 new bytes, then
+	 * source bytes 100 to 199 unchanged.
+	 */
+	for (i = 0; i < 500; i++) {
+		delta_dst[i] = delta_src[i] + 1;
+	}
+	memset(&delta_dst[500], 0xa5, 100);
+	memcpy(&delta_dst[600], &delta_src[100], 100);
+
+	memcpy(p, "ZDLT", 4);
+	sys_put_le32(DELTA_DST_LEN, p + 4);
+	p = delta_put_record(p + 8, 500, 100, -400);
+	memset(p, 1, 500);
+	memset(p + 500, 0xa5, 100);
+	p = delta_put_record(p + 600, 100, 0, 0);
+	memset(p, 0, 100);
+
+	ret = flash_area_open(SLOT0_PARTITION_ID, &fa);
+	zassert_true(ret == 0, "Flash area open failure (%d)", ret);
+	ret = flash_area_erase(fa, 0, fa->fa_size);
+	zassert_true(ret == 0, "Flash erase failure (%d)", ret);
+	ret = flash_area_write(fa, 0, delta_src, sizeof(delta_src));
+	zassert_true(ret == 0, "Flash write failure (%d)", ret);
+	flash_area_close(fa);
+
+	ret = flash_img_delta_init(&ctx, SLOT0_PARTITION_ID, SLOT0_PARTITION_ID);
+	zassert_true(ret == -EINVAL, "Delta onto its own source accepted");
+
+	ret = flash_img_delta_init(&ctx, SLOT1_PARTITION_ID, SLOT0_PARTITION_ID);
+	zassert_true(ret == 0, "Delta init failure (%d)", ret);
+	ret = flash_area_erase(ctx.flash_area, 0, ctx.flash_area->fa_size);
+	zassert_true(ret == 0, "Flash erase failure (%d)", ret);
+
+	/* Odd sized chunks split headers, records and data */
+	for (i = 0; i < sizeof(delta_patch); i += 7) {
+		ret = flash_img_delta_write(&ctx, &delta_patch[i],
+					    MIN(7, sizeof(delta_patch) - i),
+					    false);
+		zassert_true(ret == 0, "Delta write failure (%d)", ret);
+	}
+
+	ret = flash_img_delta_write(&ctx, NULL, 0, true);
+	zassert_true(ret == 0, "Delta flush failure (%d)", ret);
+	zassert_equal(flash_img_bytes_written(&ctx), DELTA_DST_LEN,
+		      "Unexpected image size");
+
+	ret = flash_area_open(SLOT1_PARTITION_ID, &fa);
+	zassert_true(ret == 0, "Flash area open failure (%d)", ret);
+
+	for (i = 0; i < DELTA_DST_LEN; i += sizeof(temp)) {
+		ret = flash_area_read(fa, i, temp, sizeof(temp));
+		zassert_true(ret == 0, "Flash read failure (%d)", ret);
+		zassert_mem_equal(temp, &delta_dst[i], sizeof(temp),
+				  "Image mismatch at %zu", i);
+	}
+
+	/* A truncated patch is reported on flush */
+	ret = flash_img_delta_init(&ctx, SLOT1_PARTITION_ID, SLOT0_PARTITION_ID);
+	zassert_true(ret == 0, "Delta init failure (%d)", ret);
+	ret = flash_img_delta_write(&ctx, delta_patch, 100, true);
+	zassert_true(ret == -EINVAL, "Truncated patch accepted (%d)", ret);
+
+	flash_area_close(fa);
+}
+#endif /* CONFIG_IMG_DELTA */
+
 ZTEST_SUITE(img_util, NULL, NULL, NULL, NULL, NULL);
@@ -142,4 +142,41 @@ ZTEST(mcuboot_interface, test_write_confirm)
 	zassert_equal(1, readout[0] & 0xff, "confirmation error");
 }
 
+#ifdef CONFIG_MCUBOOT_IMG_STATE_CACHE
+ZTEST(mcuboot_interface, test_state_cache)
+{
+	const uint32_t img_magic[4] = BOOT_MAGIC_VALUES;
+	uint8_t flag[BOOT_MAX_ALIGN];
+	const struct flash_area *fa;
+	int ret;
+
+	flag[0] = 0x01;
+	memset(&flag[1], 0xff, sizeof(flag) - 1);
+
+	ret = flash_area_open(SLOT0_PARTITION_ID, &fa);
+	if (ret) {
+		printf("Flash driver was not found!\n");
+		return;
+	}
+
+	zassert_equal(boot_erase_img_bank(SLOT0_PARTITION_ID), 0, "erase");
+	zassert_false(boot_is_img_confirmed(), "erased image is confirmed");
+
+	ret = flash_area_write(fa, fa->fa_size - 16, img_magic, 16);
+	zassert_true(ret == 0, "Write to flash");
+
+	/* set copy-done flag */
+	ret = flash_area_write(fa, fa->fa_size - 32, &flag, sizeof(flag));
+	zassert_true(ret == 0, "Write to flash");
+
+	ret = boot_write_img_confirmed();
+	zassert_equal(ret, 0, "fail (%d)", ret);
+	zassert_true(boot_is_img_confirmed(), "confirmation not seen");
+
+	/* Erasing the bank shall drop the cached confirmation */
+	zassert_equal(boot_erase_img_bank(SLOT0_PARTITION_ID), 0, "erase");
+	zassert_false(boot_is_img_confirmed(), "stale confirmation");
+}
+#endif
+
 ZTEST_SUITE(mcuboot_interface, NULL, NULL, NULL, NULL, NULL);
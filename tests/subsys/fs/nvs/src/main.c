@@ -869,3 +869,276 @@ ZTEST_F(nvs, test_nvs_cache_gc)
 	zassert_equal(num, 2, "invalid cache content after gc");
 #endif
 }
+
+/*
+ * Test that NVS lookup index is rebuilt on nvs_mount() and kept sorted by ID.
+ */
+ZTEST_F(nvs, test_nvs_index_init)
+{
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+	int err;
+	uint16_t id;
+	uint16_t data;
+
+	fixture->fs.sector_count = 3;
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_init call failure: %d", err);
+
+	zassert_equal(fixture->fs.lookup_index_count, 0, "uninitialized index");
+	zassert_true(fixture->fs.lookup_index_complete, "incomplete index");
+
+	for (id = 8; id > 0; id--) {
+		data = id;
+		err = nvs_write(&fixture->fs, id, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	}
+
+	zassert_equal(fixture->fs.lookup_index_count, 8, "index not updated after write");
+
+	memset(fixture->fs.lookup_index, 0xAA, sizeof(fixture->fs.lookup_index));
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_init call failure: %d", err);
+
+	zassert_equal(fixture->fs.lookup_index_count, 8, "invalid index after restart");
+	zassert_true(fixture->fs.lookup_index_complete, "incomplete index after restart");
+
+	for (id = 0; id < 8; id++) {
+		zassert_equal(fixture->fs.lookup_index[id].id, id + 1, "unsorted index");
+	}
+
+	err = nvs_read(&fixture->fs, 9, &data, sizeof(data));
+	zassert_equal(err, -ENOENT, "nvs_read of missing id: %d", err);
+#endif
+}
+
+/*
+ * Test that even after writing more NVS IDs than the number of NVS lookup index
+ * entries they all can be read correctly.
+ */
+ZTEST_F(nvs, test_nvs_index_overflow)
+{
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+	int err;
+	uint16_t id;
+	uint16_t data;
+
+	fixture->fs.sector_count = 3;
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_init call failure: %d", err);
+
+	for (id = 0; id < CONFIG_NVS_LOOKUP_INDEX_SIZE + 1; id++) {
+		data = id;
+		err = nvs_write(&fixture->fs, id, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	}
+
+	zassert_false(fixture->fs.lookup_index_complete, "complete index after overflow");
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_init call failure: %d", err);
+
+	zassert_false(fixture->fs.lookup_index_complete, "complete index after restart");
+
+	for (id = 0; id < CONFIG_NVS_LOOKUP_INDEX_SIZE + 1; id++) {
+		err = nvs_read(&fixture->fs, id, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_read call failure: %d", err);
+		zassert_equal(data, id, "incorrect data read");
+	}
+#endif
+}
+
+/*
+ * Test that NVS lookup index does not contain any address from gc-ed sector
+ */
+ZTEST_F(nvs, test_nvs_index_gc)
+{
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+	int err;
+	size_t i;
+	uint16_t data = 0;
+
+	fixture->fs.sector_count = 3;
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_init call failure: %d", err);
+
+	/* Fill the first sector with writes of ID 1 */
+
+	while (fixture->fs.data_wra + sizeof(data) <= fixture->fs.ate_wra) {
+		++data;
+		err = nvs_write(&fixture->fs, 1, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	}
+
+	/* Fill the second sector with writes of ID 2 */
+
+	while ((fixture->fs.ate_wra >> ADDR_SECT_SHIFT) != 2) {
+		++data;
+		err = nvs_write(&fixture->fs, 2, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	}
+
+	/*
+	 * At this point sector 0 should have been gc-ed and ID 1 copied to
+	 * sector 2. Verify that action is reflected by the index content.
+	 */
+
+	zassert_equal(fixture->fs.lookup_index_count, 2, "invalid index content after gc");
+
+	for (i = 0; i < fixture->fs.lookup_index_count; i++) {
+		zassert_not_equal(fixture->fs.lookup_index[i].addr >> ADDR_SECT_SHIFT, 0,
+				  "not invalidated index entry after gc");
+	}
+
+	err = nvs_read(&fixture->fs, 1, &data, sizeof(data));
+	zassert_equal(err, sizeof(data), "nvs_read call failure: %d", err);
+#endif
+}
+
+/*
+ * Test that the incremental gc moves the valid entries of the oldest sector
+ * and erases it, so that closing the current sector does not erase.
+ */
+ZTEST_F(nvs, test_nvs_gc_incremental)
+{
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	int err;
+	uint16_t data = 0;
+	uint16_t last_data;
+	uint32_t *flash_erase_stat;
+
+	stats_walk(fixture->sim_stats, flash_sim_erase_calls_find, &flash_erase_stat);
+
+	fixture->fs.sector_count = 3;
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_init call failure: %d", err);
+
+	/* Fill the first sector with writes of ID 1 */
+
+	while (fixture->fs.data_wra + sizeof(data) <= fixture->fs.ate_wra) {
+		++data;
+		err = nvs_write(&fixture->fs, 1, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	}
+
+	last_data = data;
+
+	/* Start the second sector, making the first one the oldest */
+
+	++data;
+	err = nvs_write(&fixture->fs, 2, &data, sizeof(data));
+	zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	zassert_equal(fixture->fs.ate_wra >> ADDR_SECT_SHIFT, 1, "sector not closed");
+
+	do {
+		err = nvs_gc_step(&fixture->fs);
+		zassert_true(err >= 0, "nvs_gc_step call failure: %d", err);
+	} while (err);
+
+	zassert_equal(fixture->fs.gc_state, NVS_GC_ERASED, "oldest sector not erased");
+
+	err = nvs_read(&fixture->fs, 1, &data, sizeof(data));
+	zassert_equal(err, sizeof(data), "nvs_read call failure: %d", err);
+	zassert_equal(data, last_data, "incorrect data read after incremental gc");
+
+	/* Fill the second sector, closing it must not erase the first one */
+
+	*flash_erase_stat = 0;
+	while ((fixture->fs.ate_wra >> ADDR_SECT_SHIFT) != 2) {
+		++data;
+		err = nvs_write(&fixture->fs, 2, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	}
+
+	zassert_equal(*flash_erase_stat, 0, "unexpected erase on sector close");
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_init call failure: %d", err);
+
+	err = nvs_read(&fixture->fs, 1, &data, sizeof(data));
+	zassert_equal(err, sizeof(data), "nvs_read call failure: %d", err);
+	zassert_equal(data, last_data, "incorrect data read after restart");
+#endif
+}
+
+/*
+ * Test that a lookup index summary is stored when a sector is opened by gc,
+ * and that the index is restored from it on nvs_mount().
+ */
+ZTEST_F(nvs, test_nvs_index_summary)
+{
+#ifdef CONFIG_NVS_LOOKUP_INDEX_SUMMARY
+	int err;
+	uint16_t id;
+	uint16_t data;
+	uint32_t addr;
+	struct nvs_ate ate;
+	bool summary_found = false;
+	struct nvs_lookup_index_entry index[8];
+
+	fixture->fs.sector_count = 3;
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_init call failure: %d", err);
+
+	for (id = 1; id <= ARRAY_SIZE(index); id++) {
+		data = id;
+		err = nvs_write(&fixture->fs, id, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	}
+
+	err = nvs_delete(&fixture->fs, 2);
+	zassert_true(err == 0, "nvs_delete call failure: %d", err);
+
+	/* Fill the first sector, the summary is stored in the second one */
+
+	data = 0;
+	while ((fixture->fs.ate_wra >> ADDR_SECT_SHIFT) != 1) {
+		++data;
+		err = nvs_write(&fixture->fs, 1, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	}
+
+	addr = (1 << ADDR_SECT_SHIFT) + fixture->fs.sector_size;
+	addr -= 3 * sizeof(struct nvs_ate);
+	while (addr > fixture->fs.ate_wra) {
+		err = flash_read(fixture->fs.flash_device, fixture->fs.offset +
+				 (addr >> ADDR_SECT_SHIFT) * fixture->fs.sector_size +
+				 (addr & ADDR_OFFS_MASK), &ate, sizeof(ate));
+		zassert_true(err == 0, "flash_read call failure: %d", err);
+
+		if ((ate.id == 0xFFFF) && (ate.part == NVS_INDEX_SUMMARY_PART)) {
+			summary_found = true;
+			break;
+		}
+		addr -= sizeof(struct nvs_ate);
+	}
+	zassert_true(summary_found, "no lookup index summary stored");
+
+	/* The deleted ID is kept in the index, pointing to its delete ate */
+	zassert_equal(fixture->fs.lookup_index_count, ARRAY_SIZE(index),
+		      "invalid index content");
+	memcpy(index, fixture->fs.lookup_index, sizeof(index));
+
+	memset(fixture->fs.lookup_index, 0xAA, sizeof(fixture->fs.lookup_index));
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_init call failure: %d", err);
+
+	zassert_true(fixture->fs.lookup_index_complete, "incomplete index after restart");
+	zassert_equal(fixture->fs.lookup_index_count, ARRAY_SIZE(index),
+		      "invalid index content after restart");
+	for (id = 0; id < ARRAY_SIZE(index); id++) {
+		zassert_equal(fixture->fs.lookup_index[id].id, index[id].id,
+			      "index not restored after restart");
+		zassert_equal(fixture->fs.lookup_index[id].addr, index[id].addr,
+			      "index not restored after restart");
+	}
+
+	err = nvs_read(&fixture->fs, 2, &data, sizeof(data));
+	zassert_equal(err, -ENOENT, "nvs_read of deleted id: %d", err);
+
+	for (id = 3; id <= ARRAY_SIZE(index); id++) {
+		err = nvs_read(&fixture->fs, id, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_read call failure: %d", err);
+		zassert_equal(data, id, "incorrect data read");
+	}
+#endif
+}
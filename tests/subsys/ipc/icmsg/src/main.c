@@ -0,0 +1,300 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/ztest.h>
+#include <zephyr/ipc/ipc_service.h>
+
+#define WAIT K_MSEC(100)
+
+#define MSG_LEN 64
+
+/* Instance B receives from the region instance A transmits in */
+#define REGION_A_ADDR DT_REG_ADDR(DT_NODELABEL(sram_a))
+#define REGION_A_SIZE DT_REG_SIZE(DT_NODELABEL(sram_a))
+#define REGION_B_ADDR DT_REG_ADDR(DT_NODELABEL(sram_b))
+#define REGION_B_SIZE DT_REG_SIZE(DT_NODELABEL(sram_b))
+
+struct test_ept {
+	struct ipc_ept ept;
+	struct ipc_ept_cfg cfg;
+	struct k_sem bound_sem;
+	struct k_sem rx_sem;
+
+	/* Last message received */
+	const void *data;
+	size_t len;
+	uint8_t msg[MSG_LEN];
+
+	/* Hold the messages received */
+	bool hold;
+	int hold_ret;
+};
+
+static struct test_ept ept_a;
+static struct test_ept ept_b;
+#ifdef CONFIG_IPC_SERVICE_BACKEND_ICMSG_MULTI_EP
+static struct test_ept ept_a1;
+static struct test_ept ept_b1;
+#endif
+
+static void bound_cb(void *priv)
+{
+	struct test_ept *ept = priv;
+
+	k_sem_give(&ept->bound_sem);
+}
+
+/* Called from the system work queue, checked by the test */
+static void received_cb(const void *data, size_t len, void *priv)
+{
+	struct test_ept *ept = priv;
+
+	ept->data = data;
+	ept->len = len;
+	memcpy(ept->msg, data, MIN(len, sizeof(ept->msg)));
+
+	if (ept->hold) {
+		ept->hold_ret = ipc_service_hold_rx_buffer(&ept->ept,
+							   (void *)data);
+	}
+
+	k_sem_give(&ept->rx_sem);
+}
+
+static void ept_register(const struct device *instance, struct test_ept *ept,
+			 const char *name)
+{
+	k_sem_init(&ept->bound_sem, 0, 1);
+	k_sem_init(&ept->rx_sem, 0, K_SEM_MAX_LIMIT);
+
+	ept->cfg.name = name;
+	ept->cfg.cb.bound = bound_cb;
+	ept->cfg.cb.received = received_cb;
+	ept->cfg.priv = ept;
+
+	zassert_ok(ipc_service_register_endpoint(instance, &ept->ept,
+						 &ept->cfg));
+}
+
+static void ept_wait_bound(struct test_ept *ept)
+{
+	zassert_ok(k_sem_take(&ept->bound_sem, K_SECONDS(1)),
+		   "endpoint %s not bound", ept->cfg.name);
+}
+
+static void send_str(struct test_ept *ept, const char *msg)
+{
+	int ret = ipc_service_send(&ept->ept, msg, strlen(msg));
+
+	zassert_ok(ret, "send failed (err %d)", ret);
+}
+
+static void expect_rx(struct test_ept *ept, const char *msg)
+{
+	zassert_ok(k_sem_take(&ept->rx_sem, WAIT), "nothing received");
+	zassert_equal(ept->len, strlen(msg));
+	zassert_mem_equal(ept->msg, msg, strlen(msg));
+}
+
+static void expect_no_rx(struct test_ept *ept)
+{
+	zassert_equal(k_sem_take(&ept->rx_sem, WAIT), -EAGAIN,
+		      "unexpected message");
+}
+
+static bool in_region(const void *data, uintptr_t addr, size_t size)
+{
+	return (uintptr_t)data >= addr && (uintptr_t)data < addr + size;
+}
+
+static void *icmsg_setup(void)
+{
+	const struct device *ipc_a = DEVICE_DT_GET(DT_NODELABEL(ipc_a));
+	const struct device *ipc_b = DEVICE_DT_GET(DT_NODELABEL(ipc_b));
+
+	ept_register(ipc_a, &ept_a, "ept0");
+	ept_register(ipc_b, &ept_b, "ept0");
+#ifdef CONFIG_IPC_SERVICE_BACKEND_ICMSG_MULTI_EP
+	ept_register(ipc_a, &ept_a1, "ept1");
+	ept_register(ipc_b, &ept_b1, "ept1");
+#endif
+
+	ept_wait_bound(&ept_a);
+	ept_wait_bound(&ept_b);
+#ifdef CONFIG_IPC_SERVICE_BACKEND_ICMSG_MULTI_EP
+	ept_wait_bound(&ept_a1);
+	ept_wait_bound(&ept_b1);
+#endif
+
+	return NULL;
+}
+
+static void icmsg_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	ept_a.hold = false;
+	ept_b.hold = false;
+	k_sem_reset(&ept_a.rx_sem);
+	k_sem_reset(&ept_b.rx_sem);
+}
+
+ZTEST(icmsg, test_send_in_place)
+{
+	send_str(&ept_a, "hello");
+	expect_rx(&ept_b, "hello");
+
+	/* Messages are passed in the shared memory, not copied out of it */
+	zassert_true(in_region(ept_b.data, REGION_A_ADDR, REGION_A_SIZE),
+		     "message copied to %p", ept_b.data);
+
+	send_str(&ept_b, "world");
+	expect_rx(&ept_a, "world");
+	zassert_true(in_region(ept_a.data, REGION_B_ADDR, REGION_B_SIZE),
+		     "message copied to %p", ept_a.data);
+
+	zassert_equal(ipc_service_send(&ept_a.ept, "", 0), -ENODATA);
+}
+
+ZTEST(icmsg, test_send_nocopy)
+{
+	uint32_t size = 16;
+	void *buf;
+	void *buf2;
+
+	zassert_ok(ipc_service_get_tx_buffer(&ept_a.ept, &buf, &size,
+					     K_NO_WAIT));
+	zassert_true(size >= 16, "%u bytes allocated", size);
+	zassert_true(in_region(buf, REGION_A_ADDR, REGION_A_SIZE),
+		     "buffer %p not in the shared memory", buf);
+
+	/* One buffer at a time */
+	zassert_equal(ipc_service_get_tx_buffer(&ept_a.ept, &buf2, &size,
+						K_NO_WAIT), -EALREADY);
+
+	/* A dropped buffer is allocated again */
+	zassert_ok(ipc_service_drop_tx_buffer(&ept_a.ept, buf));
+	zassert_equal(ipc_service_drop_tx_buffer(&ept_a.ept, buf), -EALREADY);
+
+	size = 16;
+	zassert_ok(ipc_service_get_tx_buffer(&ept_a.ept, &buf2, &size,
+					     K_NO_WAIT));
+	zassert_equal_ptr(buf2, buf);
+
+	zassert_equal(ipc_service_send_nocopy(&ept_a.ept, buf, 0), -EBADMSG);
+
+	memcpy(buf, "nocopy", 6);
+	zassert_ok(ipc_service_send_nocopy(&ept_a.ept, buf, 6));
+
+	/* Received where it was written */
+	expect_rx(&ept_b, "nocopy");
+	zassert_equal_ptr(ept_b.data, buf);
+
+	zassert_equal(ipc_service_send_nocopy(&ept_a.ept, buf, 6), -EINVAL);
+
+	/* More than an empty buffer holds */
+	size = ipc_service_get_tx_buffer_size(&ept_a.ept) + 1;
+	zassert_equal(ipc_service_get_tx_buffer(&ept_a.ept, &buf, &size,
+						K_NO_WAIT), -ENOMEM);
+	zassert_equal(size, ipc_service_get_tx_buffer_size(&ept_a.ept));
+}
+
+ZTEST(icmsg, test_hold_rx)
+{
+	const void *held;
+
+	ept_b.hold = true;
+
+	send_str(&ept_a, "one");
+	send_str(&ept_a, "two");
+
+	expect_rx(&ept_b, "one");
+	zassert_ok(ept_b.hold_ret);
+	held = ept_b.data;
+
+	/* Messages are freed in order, reception waits for the held one */
+	expect_no_rx(&ept_b);
+	zassert_mem_equal(held, "one", 3, "held message overwritten");
+
+	zassert_equal(ipc_service_hold_rx_buffer(&ept_b.ept, (void *)held),
+		      -EALREADY);
+
+	ept_b.hold = false;
+	zassert_equal(ipc_service_release_rx_buffer(&ept_b.ept, &ept_b.msg),
+		      -ENXIO);
+	zassert_ok(ipc_service_release_rx_buffer(&ept_b.ept, (void *)held));
+
+	expect_rx(&ept_b, "two");
+	zassert_equal(ipc_service_release_rx_buffer(&ept_b.ept, (void *)held),
+		      -EALREADY);
+
+	/* Only the message passed to the receive callback can be held */
+	zassert_equal(ipc_service_hold_rx_buffer(&ept_b.ept, (void *)held),
+		      -EINVAL);
+}
+
+ZTEST(icmsg, test_tx_buffer_full)
+{
+	uint8_t msg[MSG_LEN];
+	int sent = 0;
+	int ret;
+
+	memset(msg, 0xaa, sizeof(msg));
+	ept_b.hold = true;
+
+	/* Nothing is freed while the first message is held */
+	while ((ret = ipc_service_send(&ept_a.ept, msg, sizeof(msg))) >= 0) {
+		sent++;
+		zassert_true(sent < REGION_A_SIZE / MSG_LEN, "buffer not full");
+	}
+
+	zassert_equal(ret, -ENOMEM, "send failed (err %d)", ret);
+	zassert_true(sent > 1, "%d messages sent", sent);
+
+	zassert_ok(k_sem_take(&ept_b.rx_sem, WAIT));
+	ept_b.hold = false;
+	zassert_ok(ipc_service_release_rx_buffer(&ept_b.ept,
+						 (void *)ept_b.data));
+
+	/* The messages waiting are received once released */
+	for (int i = 1; i < sent; i++) {
+		zassert_ok(k_sem_take(&ept_b.rx_sem, WAIT),
+			   "message %d not received", i);
+		zassert_equal(ept_b.len, sizeof(msg));
+	}
+
+	zassert_ok(ipc_service_send(&ept_a.ept, msg, sizeof(msg)));
+	zassert_ok(k_sem_take(&ept_b.rx_sem, WAIT));
+}
+
+ZTEST(icmsg, test_multi_ep)
+{
+#ifdef CONFIG_IPC_SERVICE_BACKEND_ICMSG_MULTI_EP
+	k_sem_reset(&ept_b1.rx_sem);
+
+	/* Endpoints sharing an instance get their own messages only */
+	send_str(&ept_a1, "ept1");
+	expect_rx(&ept_b1, "ept1");
+	expect_no_rx(&ept_b);
+
+	send_str(&ept_a, "ept0");
+	expect_rx(&ept_b, "ept0");
+	expect_no_rx(&ept_b1);
+
+	/* Payloads stay word aligned after the header */
+	zassert_equal((uintptr_t)ept_b.data % sizeof(uint32_t), 0,
+		     "payload at %p", ept_b.data);
+#else
+	ztest_test_skip();
+#endif
+}
+
+ZTEST_SUITE(icmsg, NULL, icmsg_setup, icmsg_before, NULL, NULL);
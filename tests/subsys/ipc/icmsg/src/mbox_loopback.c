@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * MBOX controller calling the callback registered on the channel a signal
+ * is sent on, so that the two sides of an IPC instance run on one core.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/mbox.h>
+
+#define DT_DRV_COMPAT		vnd_mbox_loopback
+
+#define NUM_CHANNELS		2
+
+struct mbox_loopback_data {
+	mbox_callback_t cb[NUM_CHANNELS];
+	void *user_data[NUM_CHANNELS];
+	bool enabled[NUM_CHANNELS];
+};
+
+static int mbox_loopback_send(const struct device *dev, uint32_t channel,
+			      const struct mbox_msg *msg)
+{
+	struct mbox_loopback_data *data = dev->data;
+
+	if (channel >= NUM_CHANNELS) {
+		return -EINVAL;
+	}
+
+	/* Signaling only */
+	if (msg != NULL) {
+		return -EMSGSIZE;
+	}
+
+	if (data->enabled[channel] && data->cb[channel] != NULL) {
+		data->cb[channel](dev, channel, data->user_data[channel], NULL);
+	}
+
+	return 0;
+}
+
+static int mbox_loopback_register_callback(const struct device *dev,
+					   uint32_t channel,
+					   mbox_callback_t cb,
+					   void *user_data)
+{
+	struct mbox_loopback_data *data = dev->data;
+
+	if (channel >= NUM_CHANNELS) {
+		return -EINVAL;
+	}
+
+	data->cb[channel] = cb;
+	data->user_data[channel] = user_data;
+
+	return 0;
+}
+
+static int mbox_loopback_mtu_get(const struct device *dev)
+{
+	return 0;
+}
+
+static uint32_t mbox_loopback_max_channels_get(const struct device *dev)
+{
+	return NUM_CHANNELS;
+}
+
+static int mbox_loopback_set_enabled(const struct device *dev,
+				     uint32_t channel, bool enable)
+{
+	struct mbox_loopback_data *data = dev->data;
+
+	if (channel >= NUM_CHANNELS) {
+		return -EINVAL;
+	}
+
+	data->enabled[channel] = enable;
+
+	return 0;
+}
+
+static const struct mbox_driver_api mbox_loopback_api = {
+	.send = mbox_loopback_send,
+	.register_callback = mbox_loopback_register_callback,
+	.mtu_get = mbox_loopback_mtu_get,
+	.max_channels_get = mbox_loopback_max_channels_get,
+	.set_enabled = mbox_loopback_set_enabled,
+};
+
+static int mbox_loopback_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return 0;
+}
+
+static struct mbox_loopback_data mbox_loopback_data;
+
+DEVICE_DT_INST_DEFINE(0, mbox_loopback_init, NULL, &mbox_loopback_data, NULL,
+		      POST_KERNEL, CONFIG_MBOX_INIT_PRIORITY,
+		      &mbox_loopback_api);
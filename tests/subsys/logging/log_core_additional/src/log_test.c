@@ -423,6 +423,51 @@ ZTEST(test_log_core_additional, test_log_thread)
 }
 #endif
 
+#ifdef CONFIG_LOG_RATELIMIT
+static void log_storm(int cnt)
+{
+	for (int i = 0; i < cnt; i++) {
+		LOG_INF("storm %d", i);
+	}
+}
+
+/**
+ * @brief Rate limiting of a logging call site
+ *
+ * @details Messages over the burst are dropped, and their number is
+ *          reported once the interval is over
+ *
+ * @addtogroup logging
+ */
+ZTEST(test_log_core_additional, test_log_ratelimit)
+{
+	if (IS_ENABLED(CONFIG_LOG_MODE_IMMEDIATE)) {
+		ztest_test_skip();
+	}
+
+	log_setup(false);
+
+	k_msleep(CONFIG_LOG_RATELIMIT_INTERVAL_MS);
+	log_storm(3 * CONFIG_LOG_RATELIMIT_BURST);
+
+	while (log_test_process()) {
+	}
+
+	zassert_equal(backend1_cb.counter, CONFIG_LOG_RATELIMIT_BURST,
+		      "Unexpected amount of messages received by the backend.");
+
+	k_msleep(CONFIG_LOG_RATELIMIT_INTERVAL_MS);
+	log_storm(1);
+
+	while (log_test_process()) {
+	}
+
+	/* Suppressed messages report followed by the message itself */
+	zassert_equal(backend1_cb.counter, CONFIG_LOG_RATELIMIT_BURST + 2,
+		      "Unexpected amount of messages received by the backend.");
+}
+#endif
+
 static void call_log_generic(const char *fmt, ...)
 {
 	va_list ap;
@@ -0,0 +1,309 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/lorawan/lorawan.h>
+#include <zephyr/ztest.h>
+
+#define WAIT K_MSEC(1000)
+#define NO_SEND_WAIT K_MSEC(200)
+
+#define MAX_CALLS 8
+#define FRAME_SIZE 242
+
+#define PORT 2
+#define OTHER_PORT 3
+
+/* lorawan_send() calls made by the transmit queue thread */
+struct send_call {
+	uint8_t port;
+	enum lorawan_message_type type;
+	uint8_t len;
+	uint8_t data[FRAME_SIZE];
+	uint32_t time;
+};
+
+static struct send_call calls[MAX_CALLS];
+static int num_calls;
+static K_SEM_DEFINE(send_sem, 0, MAX_CALLS);
+
+/* Results returned by the next lorawan_send() calls, 0 once used up */
+static int results[MAX_CALLS];
+static int num_results;
+
+/* Payload sizes reported by the mocked stack */
+static uint8_t max_next_size;
+static uint8_t max_size;
+
+/* Payload size after a send fails with -EMSGSIZE */
+static uint8_t repack_size;
+
+/* Pending MAC commands are sent along with the next frame */
+static bool mac_cmds_pending;
+
+void lorawan_get_payload_sizes(uint8_t *max_next_payload_size,
+			       uint8_t *max_payload_size)
+{
+	*max_next_payload_size = mac_cmds_pending ? max_next_size : max_size;
+	*max_payload_size = max_size;
+}
+
+int lorawan_send(uint8_t port, uint8_t *data, uint8_t len,
+		 enum lorawan_message_type type)
+{
+	struct send_call *call;
+	int ret = 0;
+
+	zassert_true(num_calls < MAX_CALLS, "too many sends");
+
+	call = &calls[num_calls];
+	call->port = port;
+	call->type = type;
+	call->len = len;
+	memcpy(call->data, data, len);
+	call->time = k_uptime_get_32();
+
+	if (num_calls < num_results) {
+		ret = results[num_calls];
+	}
+
+	if (ret == -EMSGSIZE) {
+		max_size = repack_size;
+	} else if (ret == 0) {
+		mac_cmds_pending = false;
+	}
+
+	num_calls++;
+	k_sem_give(&send_sem);
+
+	return ret;
+}
+
+/* Queue a record of len bytes, all set to id */
+static void queue(uint8_t port, enum lorawan_message_type type, uint8_t id,
+		  uint8_t len)
+{
+	uint8_t data[CONFIG_LORAWAN_TX_QUEUE_RECORD_SIZE];
+
+	memset(data, id, len);
+	zassert_ok(lorawan_send_queued(port, data, len, type, K_NO_WAIT));
+}
+
+static void wait_calls(int count)
+{
+	for (int i = 0; i < count; i++) {
+		zassert_ok(k_sem_take(&send_sem, WAIT), "%d sends", i);
+	}
+
+	zassert_equal(k_sem_take(&send_sem, NO_SEND_WAIT), -EAGAIN,
+		      "unexpected send");
+}
+
+/* Check that a call sent the records with the ids, of len bytes each */
+static void expect_records(int call, const uint8_t *ids, int count,
+			   uint8_t len)
+{
+	const uint8_t *frame = calls[call].data;
+
+	zassert_equal(calls[call].len, count * (1 + len), "%u bytes sent",
+		      calls[call].len);
+
+	for (int i = 0; i < count; i++) {
+		zassert_equal(frame[0], len, "record %d length", i);
+
+		for (int j = 1; j <= len; j++) {
+			zassert_equal(frame[j], ids[i], "record %d data", i);
+		}
+
+		frame += 1 + len;
+	}
+}
+
+static void tx_queue_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	num_calls = 0;
+	num_results = 0;
+	max_next_size = 51;
+	max_size = 51;
+	mac_cmds_pending = false;
+	k_sem_reset(&send_sem);
+}
+
+ZTEST(lorawan_tx_queue, test_queue_args)
+{
+	uint8_t data[CONFIG_LORAWAN_TX_QUEUE_RECORD_SIZE + 1] = { 0 };
+
+	zassert_equal(lorawan_send_queued(PORT, NULL, 1,
+					  LORAWAN_MSG_UNCONFIRMED, K_NO_WAIT),
+		      -EINVAL);
+	zassert_equal(lorawan_send_queued(0, data, 1, LORAWAN_MSG_UNCONFIRMED,
+					  K_NO_WAIT), -EINVAL);
+	zassert_equal(lorawan_send_queued(PORT, data, 0,
+					  LORAWAN_MSG_UNCONFIRMED, K_NO_WAIT),
+		      -EINVAL);
+	zassert_equal(lorawan_send_queued(PORT, data, sizeof(data),
+					  LORAWAN_MSG_UNCONFIRMED, K_NO_WAIT),
+		      -EINVAL);
+
+	wait_calls(0);
+}
+
+ZTEST(lorawan_tx_queue, test_aggregate)
+{
+	const uint8_t ids[] = { 1, 2, 3 };
+
+	for (int i = 0; i < ARRAY_SIZE(ids); i++) {
+		queue(PORT, LORAWAN_MSG_UNCONFIRMED, ids[i], 10);
+	}
+
+	/* One frame, each record preceded by its length */
+	wait_calls(1);
+	zassert_equal(calls[0].port, PORT);
+	zassert_equal(calls[0].type, LORAWAN_MSG_UNCONFIRMED);
+	expect_records(0, ids, ARRAY_SIZE(ids), 10);
+}
+
+ZTEST(lorawan_tx_queue, test_port_and_type)
+{
+	/* Records for another port or message type start a new frame */
+	queue(PORT, LORAWAN_MSG_UNCONFIRMED, 1, 4);
+	queue(OTHER_PORT, LORAWAN_MSG_UNCONFIRMED, 2, 4);
+	queue(OTHER_PORT, LORAWAN_MSG_CONFIRMED, 3, 4);
+
+	wait_calls(3);
+
+	zassert_equal(calls[0].port, PORT);
+	zassert_equal(calls[1].port, OTHER_PORT);
+	zassert_equal(calls[1].type, LORAWAN_MSG_UNCONFIRMED);
+	zassert_equal(calls[2].port, OTHER_PORT);
+	zassert_equal(calls[2].type, LORAWAN_MSG_CONFIRMED);
+
+	for (int i = 0; i < 3; i++) {
+		uint8_t id = i + 1;
+
+		expect_records(i, &id, 1, 4);
+	}
+}
+
+ZTEST(lorawan_tx_queue, test_payload_size)
+{
+	const uint8_t ids[] = { 1, 2, 3 };
+
+	/* Two records fit into the payload of the datarate */
+	max_size = 25;
+
+	for (int i = 0; i < ARRAY_SIZE(ids); i++) {
+		queue(PORT, LORAWAN_MSG_UNCONFIRMED, ids[i], 10);
+	}
+
+	wait_calls(2);
+	expect_records(0, &ids[0], 2, 10);
+	expect_records(1, &ids[2], 1, 10);
+}
+
+ZTEST(lorawan_tx_queue, test_queue_full)
+{
+	const uint8_t ids[] = { 1, 2, 3, 4, 5 };
+	uint8_t data[1] = { 0 };
+
+	/*
+	 * The first record is handed to the waiting thread directly, the
+	 * others fill the queue while this cooperative thread runs.
+	 */
+	for (int i = 0; i < ARRAY_SIZE(ids); i++) {
+		queue(PORT, LORAWAN_MSG_UNCONFIRMED, ids[i], 10);
+	}
+
+	zassert_equal(lorawan_send_queued(PORT, data, sizeof(data),
+					  LORAWAN_MSG_UNCONFIRMED, K_NO_WAIT),
+		      -ENOMSG);
+
+	wait_calls(2);
+	expect_records(0, &ids[0], 4, 10);
+	expect_records(1, &ids[4], 1, 10);
+}
+
+ZTEST(lorawan_tx_queue, test_retry_backoff)
+{
+	const uint8_t id = 1;
+
+	/* Duty-cycle restricted, then busy */
+	results[0] = -ECONNREFUSED;
+	results[1] = -EBUSY;
+	num_results = 2;
+
+	queue(PORT, LORAWAN_MSG_UNCONFIRMED, id, 10);
+
+	/* The same frame is sent again, with a doubling delay */
+	wait_calls(3);
+
+	for (int i = 0; i < 3; i++) {
+		expect_records(i, &id, 1, 10);
+	}
+
+	zassert_true(calls[1].time - calls[0].time >=
+		     CONFIG_LORAWAN_TX_QUEUE_BACKOFF_MIN_MS,
+		     "first retry after %u ms", calls[1].time - calls[0].time);
+	zassert_true(calls[2].time - calls[1].time >=
+		     2 * CONFIG_LORAWAN_TX_QUEUE_BACKOFF_MIN_MS,
+		     "second retry after %u ms", calls[2].time - calls[1].time);
+}
+
+ZTEST(lorawan_tx_queue, test_repack)
+{
+	const uint8_t ids[] = { 1, 2, 3 };
+
+	/* The datarate drops when the first frame is sent */
+	results[0] = -EMSGSIZE;
+	num_results = 1;
+	repack_size = 25;
+
+	for (int i = 0; i < ARRAY_SIZE(ids); i++) {
+		queue(PORT, LORAWAN_MSG_UNCONFIRMED, ids[i], 10);
+	}
+
+	wait_calls(3);
+	expect_records(0, &ids[0], 3, 10);
+	expect_records(1, &ids[0], 2, 10);
+	expect_records(2, &ids[2], 1, 10);
+}
+
+ZTEST(lorawan_tx_queue, test_mac_commands)
+{
+	const uint8_t ids[] = { 1, 2, 3 };
+
+	/* Pending MAC commands leave room for one record in the next frame */
+	mac_cmds_pending = true;
+	max_next_size = 15;
+
+	for (int i = 0; i < ARRAY_SIZE(ids); i++) {
+		queue(PORT, LORAWAN_MSG_UNCONFIRMED, ids[i], 10);
+	}
+
+	wait_calls(2);
+	expect_records(0, &ids[0], 1, 10);
+	expect_records(1, &ids[1], 2, 10);
+}
+
+ZTEST(lorawan_tx_queue, test_oversized_record)
+{
+	const uint8_t id = 2;
+
+	/* Records exceeding the payload size are dropped */
+	max_size = 8;
+
+	queue(PORT, LORAWAN_MSG_UNCONFIRMED, 1, 10);
+	queue(PORT, LORAWAN_MSG_UNCONFIRMED, id, 5);
+
+	wait_calls(1);
+	expect_records(0, &id, 1, 5);
+}
+
+ZTEST_SUITE(lorawan_tx_queue, NULL, NULL, tx_queue_before, NULL, NULL);
@@ -271,6 +271,10 @@ void test_client_setup_ascii(void)
 {
 	int err;
 
+	if (!IS_ENABLED(CONFIG_MODBUS_ASCII_MODE)) {
+		ztest_test_skip();
+	}
+
 	client_iface = modbus_iface_get_by_name(rtu_iface_name);
 	client_param.mode = MODBUS_MODE_ASCII;
 	client_param.serial.baud = MB_TEST_BAUDRATE_HIGH;
@@ -256,7 +256,8 @@ void test_server_setup_ascii(void)
 	server_param.serial.baud = MB_TEST_BAUDRATE_HIGH;
 	server_param.serial.parity = UART_CFG_PARITY_EVEN;
 
-	if (IS_ENABLED(CONFIG_MODBUS_SERVER)) {
+	if (IS_ENABLED(CONFIG_MODBUS_SERVER) &&
+	    IS_ENABLED(CONFIG_MODBUS_ASCII_MODE)) {
 		err = modbus_init_server(server_iface, server_param);
 		zassert_equal(err, 0, "Failed to configure RTU server");
 	} else {
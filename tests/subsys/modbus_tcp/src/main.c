@@ -0,0 +1,358 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/modbus/modbus.h>
+
+#define MB_TEST_PORT		5020
+#define MB_TEST_NODE_ADDR	0x01
+
+#define MB_TEST_HREG_MAP_ADDR	100
+#define MB_TEST_INREG_MAP_ADDR	200
+#define MB_TEST_MAP_REGS	4
+
+#define MB_FC03_HREG_RD		0x03
+#define MB_FC04_INREG_RD	0x04
+#define MB_FC06_HREG_WR		0x06
+
+/* MBAP header, function code and 4 bytes of request data */
+#define MB_REQ_LEN		(MODBUS_MBAP_AND_FC_LENGTH + 4)
+
+static int server_iface;
+
+static uint16_t holding_regs[MB_TEST_MAP_REGS];
+static uint16_t input_regs[MB_TEST_MAP_REGS];
+
+static const struct modbus_reg_map holding_reg_map = {
+	.start_addr = MB_TEST_HREG_MAP_ADDR,
+	.num_regs = MB_TEST_MAP_REGS,
+	.regs = holding_regs,
+};
+
+static const struct modbus_reg_map input_reg_map = {
+	.start_addr = MB_TEST_INREG_MAP_ADDR,
+	.num_regs = MB_TEST_MAP_REGS,
+	.regs = input_regs,
+};
+
+/* Number of registers read through the callbacks */
+static int reg_rd_calls;
+
+static int holding_reg_rd(uint16_t addr, uint16_t *reg)
+{
+	reg_rd_calls++;
+	*reg = addr;
+
+	return 0;
+}
+
+static int holding_reg_wr(uint16_t addr, uint16_t reg)
+{
+	if (addr < MB_TEST_HREG_MAP_ADDR ||
+	    addr >= MB_TEST_HREG_MAP_ADDR + MB_TEST_MAP_REGS) {
+		return -ENOTSUP;
+	}
+
+	modbus_reg_map_set(&holding_reg_map, addr, reg);
+
+	return 0;
+}
+
+static int input_reg_rd(uint16_t addr, uint16_t *reg)
+{
+	reg_rd_calls++;
+	*reg = addr;
+
+	return 0;
+}
+
+static struct modbus_user_callbacks mbs_cbs = {
+	.holding_reg_rd = holding_reg_rd,
+	.holding_reg_wr = holding_reg_wr,
+	.input_reg_rd = input_reg_rd,
+	.holding_reg_map = &holding_reg_map,
+	.input_reg_map = &input_reg_map,
+};
+
+static int unused_raw_cb(const int iface, const struct modbus_adu *adu,
+			 void *user_data)
+{
+	zassert_unreachable("raw ADU callback called");
+
+	return -ENOTSUP;
+}
+
+static int mb_connect(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(MB_TEST_PORT),
+	};
+	struct timeval timeo = {
+		.tv_sec = 1,
+	};
+	int sock;
+
+	zassert_equal(zsock_inet_pton(AF_INET, CONFIG_NET_CONFIG_MY_IPV4_ADDR,
+				      &addr.sin_addr), 1);
+
+	sock = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_true(sock >= 0, "socket failed (%d)", errno);
+
+	zassert_ok(zsock_setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &timeo,
+				    sizeof(timeo)));
+	zassert_ok(zsock_connect(sock, (struct sockaddr *)&addr,
+				 sizeof(addr)), "connect failed (%d)", errno);
+
+	return sock;
+}
+
+/* Build a request with two 16-bit request fields */
+static void mb_req(uint8_t *buf, uint16_t tid, uint8_t fc, uint16_t addr,
+		   uint16_t val)
+{
+	sys_put_be16(tid, &buf[0]);
+	sys_put_be16(0, &buf[2]);
+	/* Unit ID, function code and request data */
+	sys_put_be16(1 + 1 + 4, &buf[4]);
+	buf[6] = MB_TEST_NODE_ADDR;
+	buf[7] = fc;
+	sys_put_be16(addr, &buf[8]);
+	sys_put_be16(val, &buf[10]);
+}
+
+static void mb_send(int sock, const uint8_t *buf, size_t len)
+{
+	zassert_equal(zsock_send(sock, buf, len, 0), len, "send failed");
+}
+
+static void mb_recv(int sock, uint8_t *buf, size_t len)
+{
+	while (len > 0) {
+		ssize_t n = zsock_recv(sock, buf, len, 0);
+
+		zassert_true(n > 0, "recv failed (%d, %d)", n, errno);
+		buf += n;
+		len -= n;
+	}
+}
+
+/* Receive the response to a register read and check its header */
+static void mb_recv_regs(int sock, uint16_t tid, uint8_t fc, uint16_t *regs,
+			 uint16_t num_regs)
+{
+	uint8_t rsp[MODBUS_MBAP_AND_FC_LENGTH + 1 + 2 * MB_TEST_MAP_REGS];
+	size_t len = MODBUS_MBAP_AND_FC_LENGTH + 1 + 2 * num_regs;
+
+	mb_recv(sock, rsp, len);
+
+	zassert_equal(sys_get_be16(&rsp[0]), tid, "wrong transaction ID");
+	zassert_equal(sys_get_be16(&rsp[4]), len - 6, "wrong MBAP length");
+	zassert_equal(rsp[6], MB_TEST_NODE_ADDR, "wrong unit ID");
+	zassert_equal(rsp[7], fc, "exception 0x%02x", rsp[8]);
+	zassert_equal(rsp[8], 2 * num_regs, "wrong byte count");
+
+	for (int i = 0; i < num_regs; i++) {
+		regs[i] = sys_get_be16(&rsp[9 + 2 * i]);
+	}
+}
+
+static void mb_expect_closed(int sock)
+{
+	uint8_t byte;
+
+	zassert_equal(zsock_recv(sock, &byte, sizeof(byte), 0), 0,
+		      "connection not closed");
+}
+
+static void *modbus_tcp_setup(void)
+{
+	struct modbus_iface_param param = {
+		.mode = MODBUS_MODE_RAW,
+		.server = {
+			.user_cb = &mbs_cbs,
+			.unit_id = MB_TEST_NODE_ADDR,
+		},
+		.rawcb = {
+			.raw_tx_cb = unused_raw_cb,
+		},
+	};
+
+	server_iface = modbus_iface_get_by_name("RAW_0");
+	zassert_true(server_iface >= 0, "RAW_0 interface not found");
+
+	zassert_ok(modbus_init_server(server_iface, param));
+	zassert_ok(modbus_tcp_server_start(server_iface, MB_TEST_PORT));
+
+	return NULL;
+}
+
+static void modbus_tcp_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	for (int i = 0; i < MB_TEST_MAP_REGS; i++) {
+		modbus_reg_map_set(&holding_reg_map, MB_TEST_HREG_MAP_ADDR + i,
+				   0x1000 + i);
+		modbus_reg_map_set(&input_reg_map, MB_TEST_INREG_MAP_ADDR + i,
+				   0x2000 + i);
+	}
+
+	reg_rd_calls = 0;
+}
+
+ZTEST(modbus_tcp, test_start_twice)
+{
+	zassert_equal(modbus_tcp_server_start(server_iface, MB_TEST_PORT + 1),
+		      -EALREADY);
+}
+
+ZTEST(modbus_tcp, test_reg_map_read)
+{
+	uint8_t req[MB_REQ_LEN];
+	uint16_t regs[MB_TEST_MAP_REGS];
+	int sock = mb_connect();
+
+	/* Reads within a map are answered without the read callbacks */
+	mb_req(req, 1, MB_FC03_HREG_RD, MB_TEST_HREG_MAP_ADDR,
+	       MB_TEST_MAP_REGS);
+	mb_send(sock, req, sizeof(req));
+	mb_recv_regs(sock, 1, MB_FC03_HREG_RD, regs, MB_TEST_MAP_REGS);
+
+	for (int i = 0; i < MB_TEST_MAP_REGS; i++) {
+		zassert_equal(regs[i], 0x1000 + i, "holding register %d", i);
+	}
+
+	mb_req(req, 2, MB_FC04_INREG_RD, MB_TEST_INREG_MAP_ADDR + 1, 2);
+	mb_send(sock, req, sizeof(req));
+	mb_recv_regs(sock, 2, MB_FC04_INREG_RD, regs, 2);
+
+	zassert_equal(regs[0], 0x2001);
+	zassert_equal(regs[1], 0x2002);
+	zassert_equal(reg_rd_calls, 0, "read callback called");
+
+	/* Reads not entirely within a map go through the callbacks */
+	mb_req(req, 3, MB_FC03_HREG_RD, MB_TEST_HREG_MAP_ADDR - 1, 2);
+	mb_send(sock, req, sizeof(req));
+	mb_recv_regs(sock, 3, MB_FC03_HREG_RD, regs, 2);
+
+	zassert_equal(regs[0], MB_TEST_HREG_MAP_ADDR - 1);
+	zassert_equal(regs[1], MB_TEST_HREG_MAP_ADDR);
+	zassert_equal(reg_rd_calls, 2, "%d read callback calls", reg_rd_calls);
+
+	zsock_close(sock);
+}
+
+ZTEST(modbus_tcp, test_reg_map_write)
+{
+	uint8_t req[MB_REQ_LEN];
+	uint8_t rsp[MB_REQ_LEN];
+	uint16_t regs[MB_TEST_MAP_REGS];
+	int sock = mb_connect();
+
+	/* Writes go through the write callback, the response echoes them */
+	mb_req(req, 7, MB_FC06_HREG_WR, MB_TEST_HREG_MAP_ADDR + 2, 0xbeef);
+	mb_send(sock, req, sizeof(req));
+	mb_recv(sock, rsp, sizeof(rsp));
+	zassert_mem_equal(rsp, req, sizeof(req), "wrong FC06 response");
+
+	zassert_equal(modbus_reg_map_get(&holding_reg_map,
+					 MB_TEST_HREG_MAP_ADDR + 2), 0xbeef);
+
+	mb_req(req, 8, MB_FC03_HREG_RD, MB_TEST_HREG_MAP_ADDR + 2, 1);
+	mb_send(sock, req, sizeof(req));
+	mb_recv_regs(sock, 8, MB_FC03_HREG_RD, regs, 1);
+	zassert_equal(regs[0], 0xbeef);
+
+	zsock_close(sock);
+}
+
+ZTEST(modbus_tcp, test_pipelined_requests)
+{
+	uint8_t req[3 * MB_REQ_LEN];
+	uint16_t regs[MB_TEST_MAP_REGS];
+	int sock = mb_connect();
+
+	/* Requests sent at once, the last one split across two sends */
+	mb_req(&req[0], 0x10, MB_FC03_HREG_RD, MB_TEST_HREG_MAP_ADDR, 1);
+	mb_req(&req[MB_REQ_LEN], 0x11, MB_FC04_INREG_RD,
+	       MB_TEST_INREG_MAP_ADDR, 1);
+	mb_req(&req[2 * MB_REQ_LEN], 0x12, MB_FC03_HREG_RD,
+	       MB_TEST_HREG_MAP_ADDR + 3, 1);
+
+	mb_send(sock, req, 2 * MB_REQ_LEN + 5);
+	k_msleep(50);
+	mb_send(sock, &req[2 * MB_REQ_LEN + 5], MB_REQ_LEN - 5);
+
+	/* Answered in request order */
+	mb_recv_regs(sock, 0x10, MB_FC03_HREG_RD, regs, 1);
+	zassert_equal(regs[0], 0x1000);
+	mb_recv_regs(sock, 0x11, MB_FC04_INREG_RD, regs, 1);
+	zassert_equal(regs[0], 0x2000);
+	mb_recv_regs(sock, 0x12, MB_FC03_HREG_RD, regs, 1);
+	zassert_equal(regs[0], 0x1003);
+
+	zsock_close(sock);
+}
+
+ZTEST(modbus_tcp, test_connections)
+{
+	int socks[CONFIG_MODBUS_TCP_SERVER_MAX_CONNECTIONS];
+	uint8_t req[MB_REQ_LEN];
+	uint16_t reg;
+	int extra;
+
+	for (int i = 0; i < ARRAY_SIZE(socks); i++) {
+		socks[i] = mb_connect();
+	}
+
+	/* Connections beyond the maximum are closed by the server */
+	extra = mb_connect();
+	mb_expect_closed(extra);
+	zsock_close(extra);
+
+	/* The others are all served */
+	for (int i = ARRAY_SIZE(socks) - 1; i >= 0; i--) {
+		mb_req(req, i, MB_FC03_HREG_RD, MB_TEST_HREG_MAP_ADDR + i, 1);
+		mb_send(socks[i], req, sizeof(req));
+		mb_recv_regs(socks[i], i, MB_FC03_HREG_RD, &reg, 1);
+		zassert_equal(reg, 0x1000 + i);
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(socks); i++) {
+		zsock_close(socks[i]);
+	}
+
+	/* Closed connections free their slot */
+	k_msleep(100);
+	socks[0] = mb_connect();
+	mb_req(req, 0x20, MB_FC03_HREG_RD, MB_TEST_HREG_MAP_ADDR, 1);
+	mb_send(socks[0], req, sizeof(req));
+	mb_recv_regs(socks[0], 0x20, MB_FC03_HREG_RD, &reg, 1);
+	zsock_close(socks[0]);
+}
+
+ZTEST(modbus_tcp, test_invalid_length)
+{
+	uint8_t req[MB_REQ_LEN];
+	int sock = mb_connect();
+
+	/* Frame boundaries cannot be found anymore, the connection is
+	 * dropped.
+	 */
+	mb_req(req, 1, MB_FC03_HREG_RD, MB_TEST_HREG_MAP_ADDR, 1);
+	sys_put_be16(0, &req[4]);
+	mb_send(sock, req, sizeof(req));
+	mb_expect_closed(sock);
+
+	zsock_close(sock);
+}
+
+ZTEST_SUITE(modbus_tcp, NULL, modbus_tcp_setup, modbus_tcp_before, NULL,
+	    NULL);
@@ -217,6 +217,89 @@ ZTEST(device_runtime_api, test_api)
 	zassert_equal(ret, 0);
 }
 
+#ifdef CONFIG_PM_DEVICE_RUNTIME_ASYNC
+static struct pm_device_runtime_cb resume_cbs[2];
+static K_SEM_DEFINE(resume_sem, 0, ARRAY_SIZE(resume_cbs));
+static int resume_result;
+
+static void on_resumed(const struct device *dev, struct pm_device_runtime_cb *cb,
+		       int result)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(cb);
+
+	resume_result = result;
+	k_sem_give(&resume_sem);
+}
+
+/**
+ * @brief Test the behavior of the asynchronous device runtime PM API.
+ *
+ * Scenarios tested:
+ *
+ * - asynchronous get (x2 while resume is ongoing) + put
+ * - asynchronous get while active
+ */
+ZTEST(device_runtime_api, test_api_async)
+{
+	int ret;
+	enum pm_device_state state;
+
+	for (size_t i = 0; i < ARRAY_SIZE(resume_cbs); i++) {
+		resume_cbs[i].handler = on_resumed;
+	}
+
+	/*** asynchronous get (x2 while resume is ongoing) + put ***/
+
+	test_driver_pm_async(dev);
+
+	/* usage: 0, +1, resume: yes (queued) */
+	ret = pm_device_runtime_get_async(dev, &resume_cbs[0]);
+	zassert_equal(ret, 0);
+
+	/* let resume start */
+	k_yield();
+	zassert_true(test_driver_pm_ongoing(dev));
+	zassert_equal(k_sem_take(&resume_sem, K_NO_WAIT), -EBUSY);
+
+	/* usage: 1, +1, resume: no (waits for ongoing resume) */
+	ret = pm_device_runtime_get_async(dev, &resume_cbs[1]);
+	zassert_equal(ret, 0);
+	zassert_equal(k_sem_take(&resume_sem, K_NO_WAIT), -EBUSY);
+
+	/* unblock test driver, both requests complete */
+	resume_result = -1;
+	test_driver_pm_done(dev);
+	zassert_equal(k_sem_take(&resume_sem, K_MSEC(100)), 0);
+	zassert_equal(k_sem_take(&resume_sem, K_MSEC(100)), 0);
+	zassert_equal(resume_result, 0);
+
+	(void)pm_device_state_get(dev, &state);
+	zassert_equal(state, PM_DEVICE_STATE_ACTIVE);
+
+	/*** asynchronous get while active ***/
+
+	/* usage: 2, +1, resume: no (completes immediately) */
+	ret = pm_device_runtime_get_async(dev, &resume_cbs[0]);
+	zassert_equal(ret, 0);
+	zassert_equal(k_sem_take(&resume_sem, K_NO_WAIT), 0);
+
+	/* usage: 3, -3, suspend: yes */
+	for (int i = 0; i < 3; i++) {
+		ret = pm_device_runtime_put(dev);
+		zassert_equal(ret, 0);
+	}
+
+	(void)pm_device_state_get(dev, &state);
+	zassert_equal(state, PM_DEVICE_STATE_SUSPENDED);
+}
+#else
+ZTEST(device_runtime_api, test_api_async)
+{
+	ztest_test_skip();
+}
+#endif /* CONFIG_PM_DEVICE_RUNTIME_ASYNC */
+
 static int pm_unsupported_init(const struct device *dev)
 {
 	return 0;
@@ -244,6 +244,67 @@ ZTEST(policy_api, test_pm_policy_next_state_default_latency)
 	pm_policy_latency_request_remove(&req1);
 	zassert_equal(latency_cb_call_cnt, 1);
 }
+
+#ifdef CONFIG_PM_POLICY_DEFAULT_PREDICT
+/**
+ * @brief Test the behavior of pm_policy_next_state() when idle periods are
+ * predicted and CONFIG_PM_POLICY_DEFAULT_PREDICT=y.
+ */
+ZTEST(policy_api, test_pm_policy_next_state_default_predict)
+{
+	const struct pm_state_info *next;
+
+	/* short idle periods, PM_STATE_SUSPEND_TO_RAM is not worth it */
+	for (uint8_t i = 0U; i < CONFIG_PM_POLICY_DEFAULT_PREDICT_HISTORY; i++) {
+		(void)pm_policy_idle_update(0U, k_us_to_ticks_floor32(200000));
+	}
+
+	next = pm_policy_next_state(0U, K_TICKS_FOREVER);
+	zassert_equal(next->state, PM_STATE_RUNTIME_IDLE);
+
+	/* prediction was right */
+	zassert_true(pm_policy_idle_update(0U, k_us_to_ticks_floor32(200000)));
+
+	/* next timeout is closer than the prediction */
+	next = pm_policy_next_state(0U, k_us_to_ticks_floor32(10999));
+	zassert_is_null(next);
+
+	/* idle periods too short for any state, the shallowest one that fits
+	 * the next timeout is used
+	 */
+	for (uint8_t i = 0U; i < CONFIG_PM_POLICY_DEFAULT_PREDICT_HISTORY; i++) {
+		(void)pm_policy_idle_update(0U, k_us_to_ticks_floor32(1000));
+	}
+
+	next = pm_policy_next_state(0U, K_TICKS_FOREVER);
+	zassert_equal(next->state, PM_STATE_RUNTIME_IDLE);
+
+	/* prediction was wrong, PM_STATE_SUSPEND_TO_RAM was possible */
+	zassert_false(pm_policy_idle_update(0U, k_us_to_ticks_floor32(2000000)));
+
+	/* a single outlier does not break the pattern */
+	for (uint8_t i = 0U; i < CONFIG_PM_POLICY_DEFAULT_PREDICT_HISTORY; i++) {
+		(void)pm_policy_idle_update(0U, k_us_to_ticks_floor32(200000));
+	}
+	(void)pm_policy_idle_update(0U, k_us_to_ticks_floor32(5000000));
+
+	next = pm_policy_next_state(0U, K_TICKS_FOREVER);
+	zassert_equal(next->state, PM_STATE_RUNTIME_IDLE);
+
+	/* irregular idle periods, no prediction */
+	for (uint8_t i = 0U; i < CONFIG_PM_POLICY_DEFAULT_PREDICT_HISTORY; i++) {
+		(void)pm_policy_idle_update(0U, k_us_to_ticks_floor32(100000U * (i + 1U) * (i + 1U)));
+	}
+
+	next = pm_policy_next_state(0U, K_TICKS_FOREVER);
+	zassert_equal(next->state, PM_STATE_SUSPEND_TO_RAM);
+}
+#else
+ZTEST(policy_api, test_pm_policy_next_state_default_predict)
+{
+	ztest_test_skip();
+}
+#endif /* CONFIG_PM_POLICY_DEFAULT_PREDICT */
 #else
 ZTEST(policy_api, test_pm_policy_next_state_default)
 {
@@ -259,6 +320,11 @@ ZTEST(policy_api, test_pm_policy_next_state_default_latency)
 {
 	ztest_test_skip();
 }
+
+ZTEST(policy_api, test_pm_policy_next_state_default_predict)
+{
+	ztest_test_skip();
+}
 #endif /* CONFIG_PM_POLICY_DEFAULT */
 
 #ifdef CONFIG_PM_POLICY_CUSTOM
@@ -414,6 +414,128 @@ ZTEST(rtio_api, test_rtio_multiple_chains)
 	test_rtio_multiple_chains_(&r_multi_con);
 }
 
+RTIO_EXECUTOR_SIMPLE_DEFINE(cancel_exec_simp);
+RTIO_DEFINE(r_cancel_simp, (struct rtio_executor *)&cancel_exec_simp, 4, 4);
+
+RTIO_EXECUTOR_CONCURRENT_DEFINE(cancel_exec_con, 1);
+RTIO_DEFINE(r_cancel_con, (struct rtio_executor *)&cancel_exec_con, 4, 4);
+
+struct rtio_iodev_test iodev_test_cancel;
+
+/**
+ * @brief Test canceling a request of a chain
+ *
+ * Ensures the canceled request and the rest of its chain complete with
+ * -ECANCELED while the requests before it complete normally.
+ */
+void test_rtio_cancel_(struct rtio *r)
+{
+	int res;
+	uintptr_t userdata[4] = {0, 1, 2, 3};
+	struct rtio_sqe *sqe;
+	struct rtio_sqe *cancel_sqe = NULL;
+	struct rtio_cqe *cqe;
+
+	for (int i = 0; i < 4; i++) {
+		sqe = rtio_spsc_acquire(r->sq);
+		zassert_not_null(sqe, "Expected a valid sqe");
+		rtio_sqe_prep_nop(sqe, (struct rtio_iodev *)&iodev_test_cancel, &userdata[i]);
+		sqe->flags |= RTIO_SQE_CHAINED;
+		if (i == 2) {
+			cancel_sqe = sqe;
+		}
+	}
+
+	/* Clear the last one */
+	sqe->flags = 0;
+
+	rtio_sqe_cancel(cancel_sqe);
+
+	res = rtio_submit(r, 4);
+	zassert_ok(res, "Should return ok from rtio_execute");
+
+	for (int i = 0; i < 4; i++) {
+		cqe = rtio_spsc_consume(r->cq);
+		zassert_not_null(cqe, "Expected a valid cqe");
+		zassert_equal_ptr(cqe->userdata, &userdata[i], "Expected in order completions");
+		if (i < 2) {
+			zassert_ok(cqe->result, "Result should be ok");
+		} else {
+			zassert_equal(cqe->result, -ECANCELED, "Result should be canceled");
+		}
+		rtio_spsc_release(r->cq);
+	}
+}
+
+ZTEST(rtio_api, test_rtio_cancel)
+{
+	rtio_iodev_test_init(&iodev_test_cancel);
+
+	TC_PRINT("rtio cancel simple\n");
+	test_rtio_cancel_(&r_cancel_simp);
+	TC_PRINT("rtio cancel concurrent\n");
+	test_rtio_cancel_(&r_cancel_con);
+}
+
+RTIO_EXECUTOR_SIMPLE_DEFINE(copy_exec_simp);
+RTIO_DEFINE(r_copy_simp, (struct rtio_executor *)&copy_exec_simp, 4, 4);
+
+RTIO_EXECUTOR_CONCURRENT_DEFINE(copy_exec_con, 2);
+RTIO_DEFINE(r_copy_con, (struct rtio_executor *)&copy_exec_con, 4, 4);
+
+struct rtio_iodev_test iodev_test_copy[2];
+
+/**
+ * @brief Test copying chains into the submission queue
+ */
+void test_rtio_copy_in_(struct rtio *r)
+{
+	int res;
+	uintptr_t userdata[5] = {0, 1, 2, 3, 4};
+	struct rtio_sqe sqes[5];
+	struct rtio_cqe *cqe;
+
+	for (int i = 0; i < 5; i++) {
+		rtio_sqe_prep_nop(&sqes[i], (struct rtio_iodev *)&iodev_test_copy[(i / 2) % 2],
+				  &userdata[i]);
+		if ((i % 2) == 0) {
+			sqes[i].flags |= RTIO_SQE_CHAINED;
+		}
+	}
+	sqes[4].flags = 0;
+
+	res = rtio_sqe_copy_in(r, sqes, 5);
+	zassert_equal(res, -ENOMEM, "Should not fit in the submission queue");
+	zassert_equal(rtio_spsc_consumable(r->sq), 0, "Should not queue anything");
+
+	res = rtio_sqe_copy_in(r, sqes, 2);
+	zassert_ok(res, "Should fit in the submission queue");
+	res = rtio_sqe_copy_in(r, &sqes[2], 2);
+	zassert_ok(res, "Should fit in the submission queue");
+
+	res = rtio_submit(r, 4);
+	zassert_ok(res, "Should return ok from rtio_execute");
+
+	for (int i = 0; i < 4; i++) {
+		cqe = rtio_spsc_consume(r->cq);
+		zassert_not_null(cqe, "Expected a valid cqe");
+		zassert_ok(cqe->result, "Result should be ok");
+		rtio_spsc_release(r->cq);
+	}
+}
+
+ZTEST(rtio_api, test_rtio_copy_in)
+{
+	for (int i = 0; i < 2; i++) {
+		rtio_iodev_test_init(&iodev_test_copy[i]);
+	}
+
+	TC_PRINT("rtio copy in simple\n");
+	test_rtio_copy_in_(&r_copy_simp);
+	TC_PRINT("rtio copy in concurrent\n");
+	test_rtio_copy_in_(&r_copy_con);
+}
+
 
 ZTEST_SUITE(rtio_spsc, NULL, NULL, NULL, NULL, NULL);
 ZTEST_SUITE(rtio_api, NULL, NULL, NULL, NULL, NULL);
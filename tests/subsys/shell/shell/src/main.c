@@ -344,6 +344,45 @@ ZTEST(shell, test_shell_fprintf)
 		     "Expected string to contain '%s', got '%s'", expect, buf);
 }
 
+#ifdef CONFIG_SHELL_BULK_OUTPUT
+ZTEST(shell, test_shell_bulk_output)
+{
+	const struct shell *shell;
+	const char *buf;
+	char expect[16];
+	size_t size;
+
+	shell = shell_backend_dummy_get_ptr();
+	zassert_not_null(shell, "Failed to get shell");
+
+	shell_backend_dummy_clear_output(shell);
+
+	shell_bulk_output_begin(shell);
+	for (int i = 0; i < 8; i++) {
+		shell_print(shell, "bulk %d", i);
+	}
+
+	/* Output fits in the buffer so nothing is written yet. */
+	buf = shell_backend_dummy_get_output(shell, &size);
+	zassert_false(strstr(buf, "bulk"), "Unexpected output '%s'", buf);
+
+	/* Nested calls are allowed. */
+	shell_bulk_output_begin(shell);
+	shell_print(shell, "bulk nested");
+	shell_bulk_output_end(shell);
+
+	shell_bulk_output_end(shell);
+
+	buf = shell_backend_dummy_get_output(shell, &size);
+	for (int i = 0; i < 8; i++) {
+		snprintf(expect, sizeof(expect), "bulk %d", i);
+		zassert_true(strstr(buf, expect),
+			     "Expected string to contain '%s', got '%s'", expect, buf);
+	}
+	zassert_true(strstr(buf, "bulk nested"), "Missing nested output '%s'", buf);
+}
+#endif
+
 #define RAW_ARG "aaa \"\" bbb"
 #define CMD_MAND_1_OPT_RAW_NAME cmd_mand_1_opt_raw
 
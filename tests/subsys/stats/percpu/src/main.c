@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/stats/stats.h>
+#include <zephyr/ztest.h>
+
+#define NUM_THREADS MAX(CONFIG_MP_NUM_CPUS, 2)
+#define NUM_INCS 10000
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+STATS_SECT_START(test_pcpu)
+STATS_SECT_ENTRY32(s_hits)
+STATS_SECT_ENTRY32(s_bytes)
+STATS_SECT_PERCPU_END;
+
+STATS_PERCPU_DECL(test_pcpu, test_pcpu);
+
+STATS_NAME_START(test_pcpu)
+STATS_NAME(test_pcpu, s_hits)
+STATS_NAME(test_pcpu, s_bytes)
+STATS_NAME_END(test_pcpu);
+
+#define OFF_HITS offsetof(STATS_SECT_DECL(test_pcpu), s_hits)
+#define OFF_BYTES offsetof(STATS_SECT_DECL(test_pcpu), s_bytes)
+
+static K_THREAD_STACK_ARRAY_DEFINE(inc_stacks, NUM_THREADS, STACK_SIZE);
+static struct k_thread inc_threads[NUM_THREADS];
+
+static struct stats_hdr *hdr = &test_pcpu[0].s_hdr;
+
+struct walk_sum {
+	uint64_t hits;
+	uint64_t bytes;
+};
+
+static int walk_cb(struct stats_hdr *walk_hdr, void *arg, const char *name,
+		   uint16_t off)
+{
+	struct walk_sum *sum = arg;
+
+	if (strcmp(name, "s_hits") == 0) {
+		sum->hits = stats_get_value(walk_hdr, off);
+	} else if (strcmp(name, "s_bytes") == 0) {
+		sum->bytes = stats_get_value(walk_hdr, off);
+	}
+
+	return 0;
+}
+
+static void inc_thread_fn(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < NUM_INCS; i++) {
+		STATS_PERCPU_INC(test_pcpu, s_hits);
+		STATS_PERCPU_INCN(test_pcpu, s_bytes, 4);
+
+		if ((i % 100) == 0) {
+			k_yield();
+		}
+	}
+}
+
+static void *stats_percpu_setup(void)
+{
+	zassert_ok(STATS_PERCPU_INIT_AND_REG(test_pcpu, STATS_SIZE_32,
+					     "test_pcpu"));
+
+	return NULL;
+}
+
+static void stats_percpu_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	stats_reset(hdr);
+}
+
+ZTEST(stats_percpu, test_layout)
+{
+	/* Every copy is on its own cache lines */
+	zassert_equal(sizeof(test_pcpu[0]) % CONFIG_STATS_PERCPU_ALIGN, 0,
+		      "copy of %zu bytes", sizeof(test_pcpu[0]));
+	zassert_equal((uintptr_t)&test_pcpu[0] % CONFIG_STATS_PERCPU_ALIGN,
+		      0, "copy at %p", &test_pcpu[0]);
+
+	zassert_equal(hdr->s_cnt, 2);
+	zassert_equal(hdr->s_pcpu_cnt, CONFIG_MP_NUM_CPUS);
+	zassert_equal(hdr->s_pcpu_stride, sizeof(test_pcpu[0]));
+
+	zassert_equal_ptr(stats_group_find("test_pcpu"), hdr);
+}
+
+ZTEST(stats_percpu, test_sum)
+{
+	struct walk_sum sum = { 0 };
+
+	/* The copies of all CPUs are summed up on read */
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		test_pcpu[i].s_hits = i + 1;
+		test_pcpu[i].s_bytes = 100;
+	}
+
+	zassert_equal(stats_get_value(hdr, OFF_HITS),
+		      CONFIG_MP_NUM_CPUS * (CONFIG_MP_NUM_CPUS + 1) / 2);
+	zassert_equal(stats_get_value(hdr, OFF_BYTES),
+		      CONFIG_MP_NUM_CPUS * 100);
+
+	zassert_ok(stats_walk(hdr, walk_cb, &sum));
+	zassert_equal(sum.hits, stats_get_value(hdr, OFF_HITS));
+	zassert_equal(sum.bytes, stats_get_value(hdr, OFF_BYTES));
+}
+
+ZTEST(stats_percpu, test_reset)
+{
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		test_pcpu[i].s_hits = 1;
+		test_pcpu[i].s_bytes = 1;
+	}
+
+	/* All copies are cleared */
+	stats_reset(hdr);
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		zassert_equal(test_pcpu[i].s_hits, 0, "CPU %d not cleared", i);
+		zassert_equal(test_pcpu[i].s_bytes, 0, "CPU %d not cleared", i);
+	}
+}
+
+ZTEST(stats_percpu, test_concurrent_inc)
+{
+	for (int i = 0; i < NUM_THREADS; i++) {
+		k_thread_create(&inc_threads[i], inc_stacks[i], STACK_SIZE,
+				inc_thread_fn, NULL, NULL, NULL,
+				K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+
+	for (int i = 0; i < NUM_THREADS; i++) {
+		zassert_ok(k_thread_join(&inc_threads[i], K_SECONDS(10)));
+	}
+
+	/* No increment is lost, whichever CPUs the threads ran on */
+	zassert_equal(stats_get_value(hdr, OFF_HITS), NUM_THREADS * NUM_INCS);
+	zassert_equal(stats_get_value(hdr, OFF_BYTES),
+		      NUM_THREADS * NUM_INCS * 4);
+}
+
+ZTEST_SUITE(stats_percpu, NULL, stats_percpu_setup, stats_percpu_before,
+	    NULL, NULL);
@@ -643,6 +643,191 @@ ZTEST(lib_stream_flash, test_stream_flash_progress_clear)
 #endif
 }
 
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+ZTEST(lib_stream_flash, test_stream_flash_async)
+{
+	static uint8_t buf_alt[BUF_LEN];
+	int num_pages = MAX_NUM_PAGES - 1;
+	int rc;
+
+	init_target();
+
+	rc = stream_flash_async_enable(&ctx, NULL);
+	zassert_true(rc < 0, "should fail as buffer is NULL");
+
+	rc = stream_flash_async_enable(&ctx, buf_alt);
+	zassert_equal(rc, 0, "expected success");
+
+	rc = stream_flash_async_enable(&ctx, buf_alt);
+	zassert_true(rc < 0, "should fail as already enabled");
+
+	/* Several buffers are handed over while filling the pages */
+	rc = stream_flash_buffered_write(&ctx, write_buf,
+					 (page_size * num_pages) + 128, false);
+	zassert_equal(rc, 0, "expected success");
+
+	/* Flushing waits for all pending writes */
+	rc = stream_flash_buffered_write(&ctx, NULL, 0, true);
+	zassert_equal(rc, 0, "expected success");
+	zassert_equal(stream_flash_bytes_written(&ctx),
+		      (page_size * num_pages) + 128, "wrong bytes written");
+
+	VERIFY_WRITTEN(0, (page_size * num_pages) + 128);
+
+	/* The rest of the last page is untouched */
+	VERIFY_ERASED((page_size * num_pages) + 128, page_size - 128);
+}
+
+static uint8_t async_buf[BUF_LEN];
+static K_SEM_DEFINE(async_cb_entered, 0, 1);
+static K_SEM_DEFINE(async_cb_release, 0, 1);
+static k_tid_t async_cb_thread;
+static size_t async_cb_next;
+static int async_cb_count;
+static bool async_cb_block;
+
+static int stream_flash_async_callback(uint8_t *buf, size_t len,
+				       size_t offset)
+{
+	async_cb_thread = k_current_get();
+	async_cb_count++;
+
+	zassert_equal(offset, FLASH_BASE + async_cb_next, "incorrect offset");
+	zassert_mem_equal(buf, written_pattern, len, "incorrect data");
+	async_cb_next += len;
+
+	if (async_cb_block) {
+		k_sem_give(&async_cb_entered);
+		k_sem_take(&async_cb_release, K_FOREVER);
+	}
+
+	return cb_ret;
+}
+
+static void init_async_target(void)
+{
+	int rc;
+
+	init_target();
+
+	async_cb_thread = NULL;
+	async_cb_next = 0;
+	async_cb_count = 0;
+	async_cb_block = false;
+	k_sem_reset(&async_cb_entered);
+	k_sem_reset(&async_cb_release);
+
+	rc = stream_flash_init(&ctx, fdev, buf, BUF_LEN, FLASH_BASE, 0,
+			       stream_flash_async_callback);
+	zassert_equal(rc, 0, "expected success");
+
+	rc = stream_flash_async_enable(&ctx, async_buf);
+	zassert_equal(rc, 0, "expected success");
+}
+
+ZTEST(lib_stream_flash, test_stream_flash_async_callback)
+{
+	int rc;
+
+	init_async_target();
+
+	rc = stream_flash_buffered_write(&ctx, write_buf, (3 * BUF_LEN) + 100,
+					 true);
+	zassert_equal(rc, 0, "expected success");
+
+	/* One call per buffer, in order, from the flash work queue */
+	zassert_equal(async_cb_count, 4, "expected a callback per buffer");
+	zassert_equal(async_cb_next, (3 * BUF_LEN) + 100, "wrong total length");
+	zassert_not_null(async_cb_thread, "callback not called");
+	zassert_not_equal(async_cb_thread, k_current_get(),
+			  "callback called from the writer");
+
+	VERIFY_WRITTEN(0, (3 * BUF_LEN) + 100);
+}
+
+ZTEST(lib_stream_flash, test_stream_flash_async_no_block)
+{
+	int rc;
+
+	init_async_target();
+	async_cb_block = true;
+
+	/* A full buffer is handed over and programmed in the background */
+	rc = stream_flash_buffered_write(&ctx, write_buf, BUF_LEN, false);
+	zassert_equal(rc, 0, "expected success");
+
+	rc = k_sem_take(&async_cb_entered, K_SECONDS(1));
+	zassert_equal(rc, 0, "buffer not programmed");
+
+	/* The other buffer is filled meanwhile */
+	rc = stream_flash_buffered_write(&ctx, write_buf, BUF_LEN - 1, false);
+	zassert_equal(rc, 0, "expected success");
+	zassert_equal(stream_flash_bytes_written(&ctx), 0,
+		      "write completed too early");
+
+	/* More data than fits is refused before it is in flash */
+	rc = stream_flash_buffered_write(&ctx, write_buf,
+					 ctx.available - (2 * BUF_LEN) + 2,
+					 false);
+	zassert_equal(rc, -ENOMEM, "expected failure");
+
+	async_cb_block = false;
+	k_sem_give(&async_cb_release);
+
+	rc = stream_flash_buffered_write(&ctx, NULL, 0, true);
+	zassert_equal(rc, 0, "expected success");
+	zassert_equal(stream_flash_bytes_written(&ctx), (2 * BUF_LEN) - 1,
+		      "wrong bytes written");
+
+	VERIFY_WRITTEN(0, (2 * BUF_LEN) - 1);
+	VERIFY_ERASED((2 * BUF_LEN) - 1, 1);
+}
+
+ZTEST(lib_stream_flash, test_stream_flash_async_error)
+{
+	int rc;
+
+	init_async_target();
+	cb_ret = -EFAULT;
+
+	/* The error of the background write is reported by the next call */
+	rc = stream_flash_buffered_write(&ctx, write_buf, BUF_LEN, false);
+	zassert_equal(rc, 0, "expected success");
+
+	rc = stream_flash_buffered_write(&ctx, NULL, 0, true);
+	zassert_equal(rc, -EFAULT, "expected failure");
+	zassert_equal(stream_flash_bytes_written(&ctx), 0,
+		      "failed write counted");
+
+	/* It is only reported once */
+	rc = stream_flash_buffered_write(&ctx, NULL, 0, true);
+	zassert_equal(rc, 0, "expected success");
+}
+
+#ifdef CONFIG_STREAM_FLASH_ERASE
+ZTEST(lib_stream_flash, test_stream_flash_async_erase_ahead)
+{
+	int rc;
+
+	init_async_target();
+
+	/* Data left in the second page by a previous image */
+	rc = flash_write(fdev, FLASH_BASE + page_size, write_buf, page_size);
+	zassert_equal(rc, 0, "should succeed");
+
+	/* Once the first page is written, the page the next buffer ends in
+	 * is erased before any data is written to it.
+	 */
+	rc = stream_flash_buffered_write(&ctx, write_buf, page_size, true);
+	zassert_equal(rc, 0, "expected success");
+
+	zassert_equal(ctx.last_erased_page_start_offset, FLASH_BASE + page_size,
+		      "next page not erased");
+	VERIFY_ERASED(page_size, page_size);
+}
+#endif /* CONFIG_STREAM_FLASH_ERASE */
+#endif /* CONFIG_STREAM_FLASH_ASYNC */
+
 void lib_stream_flash_before(void *data)
 {
 	zassume_true(device_is_ready(fdev), "Device is not ready");
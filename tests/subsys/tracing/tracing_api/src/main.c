@@ -59,6 +59,11 @@ static uint8_t *string_tracked[] = {
 };
 #endif
 
+#ifdef CONFIG_TRACING_BUFFER_PER_CPU
+static int order_next;
+static bool order_error;
+#endif
+
 #if defined(CONFIG_TRACING_BACKEND_UART)
 static void tracing_backends_output(
 		const struct tracing_backend *backend,
@@ -81,6 +86,16 @@ static void tracing_backends_output(
 			i++;
 		}
 	}
+#endif
+#ifdef CONFIG_TRACING_BUFFER_PER_CPU
+	if (length > 0 && data[0] == '#') {
+		/* Each packet is output separately and in order. */
+		if (length == 2 && data[1] == '0' + order_next) {
+			order_next++;
+		} else {
+			order_error = true;
+		}
+	}
 #endif
 	if (strstr(data, "tracing_format_data_testing") != NULL) {
 		data_format_found = true;
@@ -237,6 +252,32 @@ ZTEST(tracing_api, test_tracing_data_format)
 	zassert_true(raw_data_format_found == true, "Failed to check output from backend");
 }
 
+#ifdef CONFIG_TRACING_BUFFER_PER_CPU
+/**
+ * @brief Test per-CPU tracing buffers
+ *
+ * @details Put a sequence of raw packets and check that the tracing thread
+ * outputs each of them separately and in order.
+ *
+ * @ingroup tracing_api_tests
+ */
+ZTEST(tracing_api, test_tracing_per_cpu_order)
+{
+	uint8_t packet[2] = { '#' };
+
+	for (int i = 0; i < 8; i++) {
+		packet[1] = '0' + i;
+		tracing_format_raw_data(packet, sizeof(packet));
+	}
+
+	k_sleep(K_MSEC(100));
+
+	zassert_false(order_error, "Packets merged or out of order");
+	zassert_equal(order_next, 8, "Missing packets (%d received, %u dropped)",
+		      order_next, tracing_packet_drop_num_get());
+}
+#endif
+
 /**
  * @brief Test tracing APIS
  *
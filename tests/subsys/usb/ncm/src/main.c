@@ -0,0 +1,424 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/net/dummy.h>
+
+/* The NCM function is not built in, but included below to reach its
+ * NTB parser and builder. Provide the Kconfig options it depends on, with
+ * few datagrams per transmitted NTB to reach the limit.
+ */
+#define CONFIG_USB_DEVICE_NETWORK_LOG_LEVEL	LOG_LEVEL_DBG
+#define CONFIG_USB_DEVICE_NETWORK_NCM_MAC	"00005E005301"
+#define CONFIG_CDC_NCM_INTERRUPT_EP_MPS		16
+#define CONFIG_CDC_NCM_BULK_EP_MPS		64
+#define CONFIG_CDC_NCM_NTB_SIZE			2048
+#define CONFIG_CDC_NCM_RX_NTB_COUNT		2
+#define CONFIG_CDC_NCM_RX_BUF_COUNT		16
+#define CONFIG_CDC_NCM_TX_MAX_DATAGRAMS		4
+
+/* Transfers are captured instead of reaching the device controller */
+#define usb_transfer test_usb_transfer
+
+/* Include the DUT */
+#include "function_ncm.c"
+
+#define MAX_RECV 16
+#define NTH_LEN sizeof(struct ncm_nth16)
+#define NDP_LEN(count) (sizeof(struct ncm_ndp16) + \
+			((count) + 1) * sizeof(struct ncm_dpe16))
+
+/* Datagrams handed over to the stack, filled with a byte sequence
+ * starting with their seed.
+ */
+static struct {
+	uint16_t len;
+	uint8_t seed;
+	bool valid;
+} recv[MAX_RECV];
+static int recv_count;
+
+/* Last IN transfer of the NCM function */
+static uint8_t *in_data;
+static size_t in_len;
+static usb_transfer_callback in_cb;
+static int in_count;
+
+static int net_iface_dev_init(const struct device *dev)
+{
+	return 0;
+}
+
+static void net_iface_init(struct net_if *iface)
+{
+	static uint8_t mac[] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_ETHERNET);
+}
+
+static int sender_iface(const struct device *dev, struct net_pkt *pkt)
+{
+	return 0;
+}
+
+static struct dummy_api net_iface_api = {
+	.iface_api.init = net_iface_init,
+	.send = sender_iface,
+};
+
+NET_DEVICE_INIT(ncm_test, "ncm_test", net_iface_dev_init, NULL, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &net_iface_api,
+		DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2), 1500);
+
+/* netusb.c is not built, stand in for it */
+struct net_if *netusb_net_iface(void)
+{
+	return net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+}
+
+void netusb_recv(struct net_pkt *pkt)
+{
+	uint8_t data[NET_ETH_MAX_FRAME_SIZE];
+	size_t len = net_pkt_get_len(pkt);
+
+	zassert_true(recv_count < MAX_RECV, "Too many datagrams");
+	zassert_true(len > 0 && len <= sizeof(data), "Wrong length");
+	zassert_ok(net_pkt_read(pkt, data, len), "Cannot read datagram");
+
+	recv[recv_count].len = len;
+	recv[recv_count].seed = data[0];
+	recv[recv_count].valid = true;
+	for (size_t i = 0; i < len; i++) {
+		if (data[i] != (uint8_t)(data[0] + i)) {
+			recv[recv_count].valid = false;
+		}
+	}
+	recv_count++;
+
+	/* Releases the NTB */
+	net_pkt_unref(pkt);
+}
+
+void netusb_enable(const struct netusb_function *func)
+{
+}
+
+void netusb_disable(void)
+{
+}
+
+bool netusb_enabled(void)
+{
+	return true;
+}
+
+int usb_transfer(uint8_t ep, uint8_t *data, size_t dlen, unsigned int flags,
+		 usb_transfer_callback cb, void *priv)
+{
+	if (ep == CDC_NCM_IN_EP_ADDR) {
+		in_data = data;
+		in_len = dlen;
+		in_cb = cb;
+		in_count++;
+	}
+
+	return 0;
+}
+
+static void put_nth(uint16_t block_len, uint16_t ndp_idx)
+{
+	uint8_t *nth = rx_ntb[0];
+
+	sys_put_le32(NCM_NTH16_SIGNATURE, &nth[0]);
+	sys_put_le16(NTH_LEN, &nth[4]);
+	sys_put_le16(0, &nth[6]);
+	sys_put_le16(block_len, &nth[8]);
+	sys_put_le16(ndp_idx, &nth[10]);
+}
+
+/* NDP of @a count datagrams, each one given by its index and length */
+static void put_ndp(uint16_t ndp_idx, uint16_t next_idx,
+		    const uint16_t dpe[][2], size_t count)
+{
+	uint8_t *ndp = &rx_ntb[0][ndp_idx];
+
+	sys_put_le32(NCM_NDP16_SIGNATURE, &ndp[0]);
+	sys_put_le16(NDP_LEN(count), &ndp[4]);
+	sys_put_le16(next_idx, &ndp[6]);
+
+	for (size_t i = 0; i <= count; i++) {
+		sys_put_le16(i < count ? dpe[i][0] : 0, &ndp[8 + 4 * i]);
+		sys_put_le16(i < count ? dpe[i][1] : 0, &ndp[10 + 4 * i]);
+	}
+}
+
+static void put_datagram(uint16_t idx, uint16_t len, uint8_t seed)
+{
+	for (uint16_t i = 0; i < len; i++) {
+		rx_ntb[0][idx + i] = seed + i;
+	}
+}
+
+/* Parse the NTB as received in rx_ntb[0], all its datagrams are
+ * released by netusb_recv().
+ */
+static void rx_ntb_parse(size_t size)
+{
+	atomic_set(&rx_ntb_refs[0], 1);
+	ncm_rx_parse(0, size);
+	ncm_rx_ntb_release(0);
+
+	zassert_equal(atomic_get(&rx_ntb_refs[0]), 0, "NTB not released");
+}
+
+static void expect_datagram(int i, uint16_t len, uint8_t seed)
+{
+	zassert_true(i < recv_count, "Datagram %d not received", i);
+	zassert_equal(recv[i].len, len, "Wrong length of datagram %d", i);
+	zassert_equal(recv[i].seed, seed, "Wrong datagram %d", i);
+	zassert_true(recv[i].valid, "Datagram %d corrupted", i);
+}
+
+/* NTB with two datagrams, returns its length */
+static uint16_t put_valid_ntb(void)
+{
+	static const uint16_t dpe[][2] = { { 16, 60 }, { 76, 64 } };
+
+	put_datagram(16, 60, 0x10);
+	put_datagram(76, 64, 0x20);
+	put_ndp(140, 0, dpe, ARRAY_SIZE(dpe));
+	put_nth(140 + NDP_LEN(2), 140);
+
+	return 140 + NDP_LEN(2);
+}
+
+ZTEST(ncm, test_rx_ntb)
+{
+	rx_ntb_parse(put_valid_ntb());
+
+	zassert_equal(recv_count, 2, "Wrong number of datagrams");
+	expect_datagram(0, 60, 0x10);
+	expect_datagram(1, 64, 0x20);
+}
+
+ZTEST(ncm, test_rx_malformed_nth)
+{
+	uint16_t len = put_valid_ntb();
+
+	/* Shorter than the header */
+	rx_ntb_parse(NTH_LEN - 1);
+	zassert_equal(recv_count, 0, "Truncated NTB accepted");
+
+	sys_put_le32(0x12345678, &rx_ntb[0][0]);
+	rx_ntb_parse(len);
+	zassert_equal(recv_count, 0, "Wrong NTH signature accepted");
+
+	put_valid_ntb();
+	sys_put_le16(NTH_LEN + 4, &rx_ntb[0][4]);
+	rx_ntb_parse(len);
+	zassert_equal(recv_count, 0, "Wrong NTH length accepted");
+
+	/* Block length beyond the received data */
+	put_valid_ntb();
+	rx_ntb_parse(len - 1);
+	zassert_equal(recv_count, 0, "Truncated NTB accepted");
+}
+
+ZTEST(ncm, test_rx_malformed_ndp)
+{
+	uint16_t len = put_valid_ntb();
+
+	sys_put_le32(0x12345678, &rx_ntb[0][140]);
+	rx_ntb_parse(len);
+	zassert_equal(recv_count, 0, "Wrong NDP signature accepted");
+
+	/* Too short to hold its header */
+	put_valid_ntb();
+	sys_put_le16(sizeof(struct ncm_ndp16) - 1, &rx_ntb[0][144]);
+	rx_ntb_parse(len);
+	zassert_equal(recv_count, 0, "Short NDP accepted");
+
+	/* Not aligned */
+	put_valid_ntb();
+	memmove(&rx_ntb[0][142], &rx_ntb[0][140], NDP_LEN(2));
+	put_nth(142 + NDP_LEN(2), 142);
+	rx_ntb_parse(142 + NDP_LEN(2));
+	zassert_equal(recv_count, 0, "Unaligned NDP accepted");
+}
+
+ZTEST(ncm, test_rx_out_of_range)
+{
+	static const uint16_t dpe[][2] = { { 16, 60 }, { 76, 200 } };
+	uint16_t len = put_valid_ntb();
+
+	/* NDP past the end of the block */
+	put_nth(len, len);
+	rx_ntb_parse(len);
+	zassert_equal(recv_count, 0, "NDP past the block accepted");
+
+	/* NDP table running past the end of the block */
+	put_nth(len - 4, 140);
+	rx_ntb_parse(len);
+	zassert_equal(recv_count, 0, "Truncated NDP accepted");
+
+	/* Only the datagram within the block is received */
+	put_ndp(140, 0, dpe, ARRAY_SIZE(dpe));
+	put_nth(len, 140);
+	rx_ntb_parse(len);
+	zassert_equal(recv_count, 1, "Datagram past the block accepted");
+	expect_datagram(0, 60, 0x10);
+}
+
+ZTEST(ncm, test_rx_chained_ndp)
+{
+	static const uint16_t dpe0[][2] = { { 16, 60 } };
+	static const uint16_t dpe1[][2] = { { 76, 64 } };
+	uint16_t ndp1 = 140 + NDP_LEN(1);
+	uint16_t len = ndp1 + NDP_LEN(1);
+
+	put_datagram(16, 60, 0x10);
+	put_datagram(76, 64, 0x20);
+	put_ndp(140, ndp1, dpe0, 1);
+	put_ndp(ndp1, 0, dpe1, 1);
+	put_nth(len, 140);
+
+	rx_ntb_parse(len);
+	zassert_equal(recv_count, 2, "Chained NDP not followed");
+	expect_datagram(0, 60, 0x10);
+	expect_datagram(1, 64, 0x20);
+
+	/* A loop in the chain ends after NCM_RX_MAX_NDP tables */
+	recv_count = 0;
+	put_ndp(140, 140, dpe0, 1);
+	put_nth(140 + NDP_LEN(1), 140);
+
+	rx_ntb_parse(140 + NDP_LEN(1));
+	zassert_equal(recv_count, NCM_RX_MAX_NDP, "NDP loop not bounded");
+}
+
+static void tx_send(uint16_t len, uint8_t seed)
+{
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_alloc_with_buffer(netusb_net_iface(), len, AF_UNSPEC,
+					0, K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate packet");
+
+	for (uint16_t i = 0; i < len; i++) {
+		zassert_ok(net_pkt_write_u8(pkt, seed + i), "Cannot write");
+	}
+
+	net_pkt_cursor_init(pkt);
+	zassert_ok(ncm_send(pkt), "Cannot send");
+	net_pkt_unref(pkt);
+}
+
+/* Check the NTB of the last IN transfer holds the given datagrams */
+static void expect_tx_ntb(const uint16_t dg[][2], size_t count)
+{
+	uint16_t block_len = sys_get_le16(&in_data[8]);
+	uint16_t ndp_idx = sys_get_le16(&in_data[10]);
+	uint8_t *ndp = &in_data[ndp_idx];
+
+	zassert_equal(sys_get_le32(&in_data[0]), NCM_NTH16_SIGNATURE,
+		      "Wrong NTH signature");
+	zassert_equal(sys_get_le16(&in_data[4]), NTH_LEN, "Wrong NTH length");
+	zassert_equal(block_len, in_len, "Wrong block length");
+	zassert_equal(ndp_idx % NCM_ALIGN, 0, "NDP not aligned");
+	zassert_equal(sys_get_le32(&ndp[0]), NCM_NDP16_SIGNATURE,
+		      "Wrong NDP signature");
+	zassert_equal(sys_get_le16(&ndp[4]), NDP_LEN(count),
+		      "Wrong NDP length");
+	zassert_equal(ndp_idx + NDP_LEN(count), block_len,
+		      "NDP not at the end of the block");
+
+	for (size_t i = 0; i < count; i++) {
+		uint16_t idx = sys_get_le16(&ndp[8 + 4 * i]);
+		uint16_t len = sys_get_le16(&ndp[10 + 4 * i]);
+
+		zassert_equal(idx % NCM_ALIGN, 0, "Datagram not aligned");
+		zassert_equal(len, dg[i][0], "Wrong datagram length");
+		zassert_true(idx + len <= ndp_idx, "Datagram overlaps NDP");
+
+		for (uint16_t j = 0; j < len; j++) {
+			zassert_equal(in_data[idx + j], (uint8_t)(dg[i][1] + j),
+				      "Datagram %zu corrupted", i);
+		}
+	}
+
+	zassert_equal(sys_get_le32(&ndp[8 + 4 * count]), 0,
+		      "No null entry");
+}
+
+ZTEST(ncm, test_tx_aggregation)
+{
+	static const uint16_t first[][2] = { { 60, 0x10 } };
+	static const uint16_t queued[][2] = {
+		{ 61, 0x20 }, { 62, 0x30 }, { 63, 0x40 }, { 64, 0x50 },
+	};
+	uint16_t seq;
+
+	/* Sent right away while the IN endpoint is idle */
+	tx_send(first[0][0], first[0][1]);
+	zassert_equal(in_count, 1, "Datagram not sent");
+	expect_tx_ntb(first, 1);
+	seq = sys_get_le16(&in_data[6]);
+
+	/* Aggregated while the transfer is ongoing */
+	for (int i = 0; i < ARRAY_SIZE(queued); i++) {
+		tx_send(queued[i][0], queued[i][1]);
+	}
+	zassert_equal(in_count, 1, "Datagram sent while busy");
+
+	/* The NTB is full once it holds the maximum number of datagrams */
+	zassert_false(ncm_tx_fits(&tx_ntb[tx_fill], 60),
+		      "Datagram limit not enforced");
+
+	in_cb(CDC_NCM_IN_EP_ADDR, in_len, NULL);
+	zassert_equal(in_count, 2, "Aggregated NTB not sent");
+	expect_tx_ntb(queued, ARRAY_SIZE(queued));
+	zassert_equal(sys_get_le16(&in_data[6]), (uint16_t)(seq + 1),
+		      "Wrong NTB sequence");
+
+	/* Nothing left to send */
+	in_cb(CDC_NCM_IN_EP_ADDR, in_len, NULL);
+	zassert_equal(in_count, 2, "Empty NTB sent");
+	zassert_false(tx_busy, "IN endpoint still busy");
+}
+
+ZTEST(ncm, test_tx_ntb_size)
+{
+	/* Bounded by the input size the host set */
+	ntb_in_size = NCM_NTB_MIN_IN_SIZE;
+	zassert_true(ncm_tx_fits(&tx_ntb[tx_fill], NET_ETH_MAX_FRAME_SIZE),
+		     "Frame does not fit an empty NTB");
+
+	tx_ntb[tx_fill].len = NCM_NTB_MIN_IN_SIZE - NET_ETH_MAX_FRAME_SIZE;
+	zassert_false(ncm_tx_fits(&tx_ntb[tx_fill], NET_ETH_MAX_FRAME_SIZE),
+		      "NTB input size not enforced");
+}
+
+static void ncm_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	memset(rx_ntb[0], 0, sizeof(rx_ntb[0]));
+	memset(recv, 0, sizeof(recv));
+	recv_count = 0;
+
+	ncm_tx_reset(&tx_ntb[0]);
+	ncm_tx_reset(&tx_ntb[1]);
+	tx_fill = 0U;
+	tx_busy = false;
+	ntb_in_size = CONFIG_CDC_NCM_NTB_SIZE;
+	in_data = NULL;
+	in_len = 0;
+	in_cb = NULL;
+	in_count = 0;
+}
+
+ZTEST_SUITE(ncm, NULL, NULL, ncm_before, NULL, NULL);
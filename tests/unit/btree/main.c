@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/ztest.h>
+#include <zephyr/sys/btree.h>
+
+#include "../../../lib/os/btree.c"
+
+#define MAX_ITEMS 512
+
+static struct sys_btree tree;
+static struct sys_btree_node nodes[SYS_BTREE_NODES(MAX_ITEMS)];
+
+static int items[MAX_ITEMS];
+static bool in_tree[MAX_ITEMS];
+
+static int last_visited;
+static size_t n_visited;
+
+static int int_cmp(const void *key, const void *item)
+{
+	int a = *(const int *)key;
+	int b = *(const int *)item;
+
+	return (a > b) - (a < b);
+}
+
+static bool visit(void *item, void *user_data)
+{
+	int value = *(int *)item;
+
+	ARG_UNUSED(user_data);
+
+	zassert_true(value > last_visited, "Items not visited in order");
+	last_visited = value;
+	n_visited++;
+
+	return true;
+}
+
+/* Returns the number of nodes of the subtree, checking B-tree invariants */
+static size_t check_node(const struct sys_btree_node *node, int depth,
+			 int *leaf_depth, bool root)
+{
+	size_t n_nodes = 1;
+
+	zassert_true(node->count > 0 && node->count <= SYS_BTREE_MAX_ITEMS,
+		     "Bad item count");
+	zassert_true(root || node->count >= SYS_BTREE_MIN_DEGREE - 1,
+		     "Node underflow");
+
+	if (node->leaf) {
+		if (*leaf_depth < 0) {
+			*leaf_depth = depth;
+		}
+		zassert_equal(*leaf_depth, depth, "Unbalanced tree");
+		return n_nodes;
+	}
+
+	for (size_t i = 0; i <= node->count; i++) {
+		n_nodes += check_node(node->children[i], depth + 1, leaf_depth,
+				      false);
+	}
+
+	return n_nodes;
+}
+
+static void check_tree(void)
+{
+	const struct sys_btree_node *node;
+	size_t n_items = 0;
+	size_t n_nodes = 0;
+	int leaf_depth = -1;
+
+	for (size_t i = 0; i < MAX_ITEMS; i++) {
+		n_items += in_tree[i];
+	}
+	zassert_equal(sys_btree_size(&tree), n_items, "Bad tree size");
+
+	if (tree.root != NULL) {
+		n_nodes = check_node(tree.root, 0, &leaf_depth, true);
+	}
+
+	for (node = tree.free; node != NULL; node = node->children[0]) {
+		n_nodes++;
+	}
+	zassert_equal(n_nodes, ARRAY_SIZE(nodes), "Nodes leaked");
+
+	last_visited = -1;
+	n_visited = 0;
+	sys_btree_foreach(&tree, visit, NULL);
+	zassert_equal(n_visited, n_items, "Not all items visited");
+
+	for (size_t i = 0; i < MAX_ITEMS; i++) {
+		int key = items[i];
+		int below = items[i] - 1;
+		int *ge = sys_btree_find_ge(&tree, &below);
+		size_t next = i;
+
+		zassert_equal(sys_btree_find(&tree, &key) != NULL, in_tree[i],
+			      "Lookup of %d failed", key);
+
+		while (next < MAX_ITEMS && !in_tree[next]) {
+			next++;
+		}
+		zassert_equal_ptr(ge, next < MAX_ITEMS ? &items[next] : NULL,
+				  "Lower bound of %d failed", key);
+	}
+}
+
+ZTEST(btree, test_btree_ops)
+{
+	uint32_t seed = 1;
+
+	sys_btree_init(&tree, nodes, ARRAY_SIZE(nodes), int_cmp);
+
+	for (int iter = 0; iter < 20000; iter++) {
+		size_t i;
+		int key;
+
+		/* Simple LCG, good enough to shuffle operations */
+		seed = seed * 1103515245U + 12345U;
+		i = (seed >> 8) % MAX_ITEMS;
+		key = items[i];
+
+		if ((seed >> 24) % 3 != 0) {
+			zassert_equal(sys_btree_insert(&tree, &items[i]),
+				      in_tree[i] ? -EEXIST : 0, "Insert failed");
+			in_tree[i] = true;
+		} else {
+			zassert_equal_ptr(sys_btree_remove(&tree, &key),
+					  in_tree[i] ? &items[i] : NULL,
+					  "Remove failed");
+			in_tree[i] = false;
+		}
+
+		if (iter % 1000 == 0) {
+			check_tree();
+		}
+	}
+
+	check_tree();
+}
+
+ZTEST(btree, test_btree_full)
+{
+	sys_btree_init(&tree, nodes, ARRAY_SIZE(nodes), int_cmp);
+
+	/* Ascending insertion splits the rightmost nodes the most */
+	for (size_t i = 0; i < MAX_ITEMS; i++) {
+		zassert_ok(sys_btree_insert(&tree, &items[i]), "Insert failed");
+		in_tree[i] = true;
+	}
+
+	check_tree();
+	zassert_equal_ptr(sys_btree_min(&tree), &items[0], "Bad minimum");
+	zassert_equal_ptr(sys_btree_max(&tree), &items[MAX_ITEMS - 1],
+			  "Bad maximum");
+
+	for (size_t i = 0; i < MAX_ITEMS; i++) {
+		int key = items[i];
+
+		zassert_equal_ptr(sys_btree_remove(&tree, &key), &items[i],
+				  "Remove failed");
+		in_tree[i] = false;
+	}
+
+	check_tree();
+	zassert_is_null(tree.root, "Tree not empty");
+}
+
+ZTEST(btree, test_btree_no_memory)
+{
+	struct sys_btree_node one_node[1];
+	int key = items[1];
+
+	sys_btree_init(&tree, one_node, ARRAY_SIZE(one_node), int_cmp);
+
+	for (size_t i = 0; i < SYS_BTREE_MAX_ITEMS; i++) {
+		zassert_ok(sys_btree_insert(&tree, &items[i]), "Insert failed");
+	}
+
+	zassert_equal(sys_btree_insert(&tree, &items[SYS_BTREE_MAX_ITEMS]),
+		      -ENOMEM, "Node pool overflow");
+	zassert_equal(sys_btree_size(&tree), SYS_BTREE_MAX_ITEMS,
+		      "Tree modified");
+	zassert_equal_ptr(sys_btree_find(&tree, &key), &items[1],
+			  "Tree corrupted");
+}
+
+static void btree_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	for (size_t i = 0; i < MAX_ITEMS; i++) {
+		items[i] = 2 * i;
+		in_tree[i] = false;
+	}
+}
+
+ZTEST_SUITE(btree, NULL, NULL, btree_before, NULL, NULL);
@@ -50,6 +50,25 @@ ZTEST(crc, test_crc32_ieee)
 	zassert_equal(crc32_ieee(test3, sizeof(test3)), 0x20089AA4);
 }
 
+ZTEST(crc, test_crc32_ieee_update)
+{
+	uint8_t test[64];
+	uint32_t crc;
+
+	for (size_t i = 0; i < sizeof(test); i++) {
+		test[i] = i;
+	}
+
+	zassert_equal(crc32_ieee(test, sizeof(test)), 0x100ECE8C);
+
+	/* Split and misaligned updates must give the same result */
+	for (size_t split = 0; split <= sizeof(test); split++) {
+		crc = crc32_ieee_update(0, test, split);
+		crc = crc32_ieee_update(crc, test + split, sizeof(test) - split);
+		zassert_equal(crc, 0x100ECE8C, "Mismatch when split at %zu", split);
+	}
+}
+
 ZTEST(crc, test_crc16)
 {
 	uint8_t test[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
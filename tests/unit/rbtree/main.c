@@ -97,6 +97,10 @@ void check_rbnode(struct rbnode *node, int blacks_above)
 		struct rbnode *ch = z_rb_child(node, side);
 
 		if (ch) {
+#ifdef CONFIG_RBTREE_PARENT_POINTERS
+			_CHECK(ch->parent == node);
+#endif
+
 			/* Basic tree requirement */
 			if (side == 0) {
 				_CHECK(node_lessthan(ch, node));
@@ -125,6 +129,9 @@ void check_rb(void)
 
 	_CHECK(tree.root);
 	_CHECK(z_rb_is_black(tree.root));
+#ifdef CONFIG_RBTREE_PARENT_POINTERS
+	_CHECK(tree.root->parent == NULL);
+#endif
 
 	check_rbnode(tree.root, 0);
 }
@@ -174,6 +181,22 @@ void _check_tree(int size, int use_foreach)
 
 	_CHECK(ni == nwalked);
 
+#ifdef CONFIG_RBTREE_PARENT_POINTERS
+	/* Walk both ways following the parent pointers */
+	i = 0;
+	for (n = rb_get_min(&tree); n != NULL; n = rb_next(n)) {
+		_CHECK(i < nwalked && n == walked_nodes[i]);
+		i++;
+	}
+	_CHECK(i == nwalked);
+
+	for (n = rb_get_max(&tree); n != NULL; n = rb_prev(n)) {
+		i--;
+		_CHECK(i >= 0 && n == walked_nodes[i]);
+	}
+	_CHECK(i == 0);
+#endif
+
 	if (tree.root) {
 		check_rb();
 	}
@@ -277,4 +300,49 @@ ZTEST(rbtree_api, test_rb_get_minmax)
 	zassert_true(rb_get_max(&tree) == &nodes[7], "the tree is invalid");
 }
 
+/**
+ * @brief Test building a tree from sorted nodes.
+ *
+ * @details Build trees of every size from sorted nodes, check they
+ * are valid red/black trees, then keep inserting and removing nodes
+ * to check the tree stays valid.
+ *
+ * @ingroup lib_rbtree_tests
+ *
+ * @see rb_build()
+ */
+ZTEST(rbtree_api, test_rb_build)
+{
+	static struct rbnode *sorted[MAX_NODES];
+
+	for (int size = 0; size <= MAX_NODES; size += (size < 40) ? 1 : 37) {
+		(void)memset(&tree, 0, sizeof(tree));
+		tree.lessthan_fn = node_lessthan;
+		(void)memset(nodes, 0, sizeof(nodes));
+		(void)memset(node_mask, 0, sizeof(node_mask));
+
+		for (int i = 0; i < size; i++) {
+			sorted[i] = &nodes[i];
+			set_node_mask(i, 1);
+		}
+
+		rb_build(&tree, sorted, size);
+		check_tree(size);
+
+		for (int i = 0; i < 2 * size; i++) {
+			int node = next_rand_mod(size);
+
+			if (!get_node_mask(node)) {
+				rb_insert(&tree, &nodes[node]);
+				set_node_mask(node, 1);
+			} else {
+				rb_remove(&tree, &nodes[node]);
+				set_node_mask(node, 0);
+			}
+		}
+
+		check_tree(size);
+	}
+}
+
 ZTEST_SUITE(rbtree_api, NULL, NULL, NULL, NULL, NULL);